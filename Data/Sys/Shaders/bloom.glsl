@@ -0,0 +1,79 @@
+/*
+[configuration]
+
+[OptionRangeFloat]
+GUIName = Bloom threshold
+OptionName = THRESHOLD
+MinValue = 0.0
+MaxValue = 1.0
+StepAmount = 0.05
+DefaultValue = 0.6
+
+[OptionRangeFloat]
+GUIName = Bloom strength
+OptionName = STRENGTH
+MinValue = 0.0
+MaxValue = 2.0
+StepAmount = 0.05
+DefaultValue = 0.8
+
+[Pass]
+EntryPoint = BrightPass
+OutputScale = 0.5
+Input0 = ColorBuffer
+
+[Pass]
+EntryPoint = BlurHorizontal
+OutputScale = 0.25
+Input0 = PreviousPass
+
+[Pass]
+EntryPoint = BlurVertical
+OutputScale = 0.25
+Input0 = PreviousPass
+
+[Pass]
+EntryPoint = Combine
+Input0 = ColorBuffer
+Input1 = Pass2
+
+[/configuration]
+*/
+
+// Keeps the parts of the image brighter than the threshold, at half resolution.
+void BrightPass()
+{
+  float4 color = Sample();
+  float brightness = max(color.r, max(color.g, color.b));
+  float contribution = max(brightness - GetOption(THRESHOLD), 0.0) / max(brightness, 0.0001);
+  SetOutput(float4(color.rgb * contribution, 1.0));
+}
+
+// 9 tap gaussian blur, using linear filtering to read two texels with each sample
+float4 Blur(float2 direction)
+{
+  float2 step = direction * GetInvResolution();
+  float4 sum = Sample() * 0.2270270270;
+  sum += SampleLocation(GetCoordinates() + step * 1.3846153846) * 0.3162162162;
+  sum += SampleLocation(GetCoordinates() - step * 1.3846153846) * 0.3162162162;
+  sum += SampleLocation(GetCoordinates() + step * 3.2307692308) * 0.0702702703;
+  sum += SampleLocation(GetCoordinates() - step * 3.2307692308) * 0.0702702703;
+  return sum;
+}
+
+void BlurHorizontal()
+{
+  SetOutput(Blur(float2(1.0, 0.0)));
+}
+
+void BlurVertical()
+{
+  SetOutput(Blur(float2(0.0, 1.0)));
+}
+
+// Adds the blurred highlights to the full resolution image.
+void Combine()
+{
+  float4 bloom = SampleInput(1);
+  SetOutput(float4(Sample().rgb + bloom.rgb * GetOption(STRENGTH), 1.0));
+}
@@ -6,6 +6,7 @@ import android.content.DialogInterface;
 import android.content.Intent;
 import android.content.SharedPreferences;
 import android.hardware.usb.UsbManager;
+import android.os.Build;
 import android.os.Bundle;
 import android.os.Handler;
 import android.preference.PreferenceManager;
@@ -210,6 +211,11 @@ public final class EmulationActivity extends AppCompatActivity
 
 		setContentView(R.layout.activity_emulation);
 
+		// Devices which support it then run at clocks they can hold without throttling, rather
+		// than running fast for a few minutes and then dropping frames.
+		if (Build.VERSION.SDK_INT >= Build.VERSION_CODES.N)
+			getWindow().setSustainedPerformanceMode(true);
+
 		mImageView = (ImageView) findViewById(R.id.image_screenshot);
 
 		// Find or create the EmulationFragment
@@ -15,6 +15,7 @@
 #include <thread>
 
 #include "ButtonManager.h"
+#include "PerformanceHints.h"
 
 #include "Common/CPUDetect.h"
 #include "Common/CommonPaths.h"
@@ -800,13 +801,16 @@ JNIEXPORT void JNICALL Java_org_dolphinemu_dolphinemu_NativeLibrary_Run(JNIEnv*
       std::this_thread::sleep_for(std::chrono::milliseconds(WAIT_STEP));
       time_waited += WAIT_STEP;
     }
+    PerformanceHints::Init();
     while (Core::IsRunning())
     {
       guard.unlock();
-      s_update_main_frame_event.Wait();
+      s_update_main_frame_event.WaitFor(PerformanceHints::UPDATE_INTERVAL);
+      PerformanceHints::Update();
       guard.lock();
       Core::HostDispatchJobs();
     }
+    PerformanceHints::Shutdown();
   }
 
   Core::Shutdown();
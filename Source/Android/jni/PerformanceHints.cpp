@@ -0,0 +1,196 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "jni/PerformanceHints.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <dlfcn.h>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/Logging/Log.h"
+#include "Common/ThreadPlacement.h"
+#include "Common/Timer.h"
+#include "Core/HW/SystemTimers.h"
+#include "VideoCommon/DynamicResolution.h"
+
+namespace PerformanceHints
+{
+namespace
+{
+// The NDK types, which the headers of older NDKs don't have.
+struct APerformanceHintManager;
+struct APerformanceHintSession;
+struct AThermalManager;
+
+using GetManagerFunc = APerformanceHintManager* (*)();
+using CreateSessionFunc = APerformanceHintSession* (*)(APerformanceHintManager*, const int32_t*,
+                                                       size_t, int64_t);
+using ReportActualWorkDurationFunc = int (*)(APerformanceHintSession*, int64_t);
+using CloseSessionFunc = void (*)(APerformanceHintSession*);
+using AcquireThermalManagerFunc = AThermalManager* (*)();
+using ReleaseThermalManagerFunc = void (*)(AThermalManager*);
+using GetThermalHeadroomFunc = float (*)(AThermalManager*, int);
+
+constexpr u64 UPDATE_INTERVAL_US = std::chrono::microseconds(UPDATE_INTERVAL).count();
+constexpr int64_t UPDATE_INTERVAL_NS = std::chrono::nanoseconds(UPDATE_INTERVAL).count();
+
+// Android answers headroom queries made more than once a second with NaN.
+constexpr u64 THERMAL_INTERVAL_US = 1000000;
+// How far ahead the headroom is forecast, in seconds.
+constexpr int THERMAL_FORECAST = 10;
+// The device throttles at a headroom of 1. The limit of the scale goes down one step per query
+// above the upper threshold, and back up one step per query below the lower one.
+constexpr float THERMAL_SHRINK_HEADROOM = 0.9f;
+constexpr float THERMAL_GROW_HEADROOM = 0.8f;
+constexpr float MIN_SCALE_LIMIT = 0.25f;
+
+void* s_libandroid;
+
+GetManagerFunc s_get_manager;
+CreateSessionFunc s_create_session;
+ReportActualWorkDurationFunc s_report_actual_work_duration;
+CloseSessionFunc s_close_session;
+AcquireThermalManagerFunc s_acquire_thermal_manager;
+ReleaseThermalManagerFunc s_release_thermal_manager;
+GetThermalHeadroomFunc s_get_thermal_headroom;
+
+APerformanceHintSession* s_session;
+AThermalManager* s_thermal_manager;
+
+u64 s_last_update_us;
+u64 s_last_sleep_us;
+u64 s_last_thermal_us;
+
+template <typename T>
+bool LoadFunction(T* func, const char* name)
+{
+  *func = reinterpret_cast<T>(dlsym(s_libandroid, name));
+  return *func != nullptr;
+}
+
+void CreateSession()
+{
+  const std::vector<int> thread_ids = Common::GetEmulationThreadIds();
+  if (thread_ids.empty())
+    return;
+
+  APerformanceHintManager* manager = s_get_manager();
+  if (!manager)
+    return;
+
+  const std::vector<int32_t> tids(thread_ids.begin(), thread_ids.end());
+  s_session = s_create_session(manager, tids.data(), tids.size(), UPDATE_INTERVAL_NS);
+  if (s_session)
+    INFO_LOG(COMMON, "Created a performance hint session for %zu threads", tids.size());
+}
+
+void ReportWorkDuration(u64 now_us)
+{
+  const u64 sleep_us = SystemTimers::GetThrottleSleepTimeUs();
+  const u64 elapsed_us = now_us - s_last_update_us;
+  const u64 slept_us = sleep_us - s_last_sleep_us;
+  s_last_update_us = now_us;
+  s_last_sleep_us = sleep_us;
+  if (!s_session || elapsed_us == 0)
+    return;
+
+  // The threads work in a loop, not in cycles of a fixed length, so the work is reported as the
+  // fraction of the interval the CPU thread didn't spend sleeping in the throttle, scaled to the
+  // target duration of the session.
+  const double busy = 1.0 - std::min(static_cast<double>(slept_us) / elapsed_us, 1.0);
+  const int64_t work_ns = static_cast<int64_t>(busy * UPDATE_INTERVAL_NS);
+  s_report_actual_work_duration(s_session, std::max<int64_t>(work_ns, 1));
+}
+
+void UpdateScaleLimit(u64 now_us)
+{
+  if (!s_thermal_manager || now_us - s_last_thermal_us < THERMAL_INTERVAL_US)
+    return;
+  s_last_thermal_us = now_us;
+
+  const float headroom = s_get_thermal_headroom(s_thermal_manager, THERMAL_FORECAST);
+  if (std::isnan(headroom))
+    return;
+
+  const float step = 1.0f / DynamicResolution::SCALE_STEPS;
+  const float limit = DynamicResolution::GetScaleLimit();
+  float new_limit = limit;
+  if (headroom >= THERMAL_SHRINK_HEADROOM)
+    new_limit = std::max(limit - step, MIN_SCALE_LIMIT);
+  else if (headroom < THERMAL_GROW_HEADROOM)
+    new_limit = std::min(limit + step, 1.0f);
+
+  if (new_limit != limit)
+  {
+    INFO_LOG(VIDEO, "Thermal headroom %.2f, limiting the dynamic resolution to %.2f", headroom,
+             new_limit);
+    DynamicResolution::SetScaleLimit(new_limit);
+  }
+}
+}  // Anonymous namespace
+
+void Init()
+{
+  s_libandroid = dlopen("libandroid.so", RTLD_NOW);
+  if (!s_libandroid)
+    return;
+
+  if (!LoadFunction(&s_get_manager, "APerformanceHint_getManager") ||
+      !LoadFunction(&s_create_session, "APerformanceHint_createSession") ||
+      !LoadFunction(&s_report_actual_work_duration, "APerformanceHint_reportActualWorkDuration") ||
+      !LoadFunction(&s_close_session, "APerformanceHint_closeSession"))
+  {
+    s_get_manager = nullptr;
+  }
+
+  if (LoadFunction(&s_acquire_thermal_manager, "AThermal_acquireManager") &&
+      LoadFunction(&s_release_thermal_manager, "AThermal_releaseManager") &&
+      LoadFunction(&s_get_thermal_headroom, "AThermal_getThermalHeadroom"))
+  {
+    s_thermal_manager = s_acquire_thermal_manager();
+  }
+
+  s_last_update_us = Common::Timer::GetTimeUs();
+  s_last_sleep_us = SystemTimers::GetThrottleSleepTimeUs();
+  s_last_thermal_us = 0;
+}
+
+void Shutdown()
+{
+  if (s_session)
+  {
+    s_close_session(s_session);
+    s_session = nullptr;
+  }
+  if (s_thermal_manager)
+  {
+    s_release_thermal_manager(s_thermal_manager);
+    s_thermal_manager = nullptr;
+  }
+  DynamicResolution::SetScaleLimit(1.0f);
+
+  if (s_libandroid)
+  {
+    dlclose(s_libandroid);
+    s_libandroid = nullptr;
+  }
+  s_get_manager = nullptr;
+}
+
+void Update()
+{
+  const u64 now_us = Common::Timer::GetTimeUs();
+  // The host thread also wakes up for host jobs, which would make for very short intervals.
+  if (now_us - s_last_update_us < UPDATE_INTERVAL_US / 2)
+    return;
+
+  if (s_get_manager && !s_session)
+    CreateSession();
+  ReportWorkDuration(now_us);
+  UpdateScaleLimit(now_us);
+}
+}  // namespace PerformanceHints
@@ -0,0 +1,23 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <chrono>
+
+// Tells Android how busy the emulation threads are, so that it raises the clocks of their cores
+// before frames are dropped rather than after (ADPF hint sessions, Android 13 and newer), and
+// lowers the internal resolution of the dynamic resolution before the device throttles (thermal
+// headroom, Android 11 and newer). Both are looked up at runtime, and do nothing without them.
+namespace PerformanceHints
+{
+// How often Update should be called.
+constexpr std::chrono::milliseconds UPDATE_INTERVAL{250};
+
+void Init();
+void Shutdown();
+
+// Called from the host thread while the emulation is running.
+void Update();
+}  // namespace PerformanceHints
@@ -0,0 +1,117 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <array>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "Common/ChunkFile.h"
+#include "Common/CommonTypes.h"
+
+namespace
+{
+// Resembles the state of a hardware module: many small registers, some tables and a block of
+// memory, each with its own Do call.
+struct State
+{
+  State()
+  {
+    for (size_t i = 0; i < registers.size(); i++)
+      registers[i] = static_cast<u32>(i * 0x01010101);
+    for (u32 i = 0; i < 64; i++)
+      events[i] = "event" + std::to_string(i);
+    memory.resize(2 * 1024 * 1024, 0x5A);
+  }
+
+  void DoState(PointerWrap& p)
+  {
+    for (u32& reg : registers)
+      p.Do(reg);
+    p.Do(flags);
+    p.Do(counter);
+    p.Do(events);
+    p.DoMarker("Registers");
+    p.DoArray(memory.data(), static_cast<u32>(memory.size()));
+    p.DoMarker("Memory");
+  }
+
+  std::array<u32, 1024> registers;
+  bool flags = true;
+  u64 counter = 0x123456789ABCDEF;
+  std::map<u32, std::string> events;
+  std::vector<u8> memory;
+};
+
+void RunDoState(benchmark::State& state, PointerWrap::Mode mode)
+{
+  State module_state;
+
+  u8* ptr = nullptr;
+  PointerWrap measure(&ptr, PointerWrap::MODE_MEASURE);
+  module_state.DoState(measure);
+  std::vector<u8> buffer(reinterpret_cast<size_t>(ptr));
+
+  if (mode != PointerWrap::MODE_WRITE && mode != PointerWrap::MODE_MEASURE)
+  {
+    ptr = buffer.data();
+    PointerWrap p(&ptr, PointerWrap::MODE_WRITE);
+    module_state.DoState(p);
+  }
+
+  for (auto _ : state)
+  {
+    ptr = mode == PointerWrap::MODE_MEASURE ? nullptr : buffer.data();
+    PointerWrap p(&ptr, mode);
+    module_state.DoState(p);
+    benchmark::DoNotOptimize(ptr);
+  }
+
+  state.SetBytesProcessed(state.iterations() * buffer.size());
+}
+}
+
+static void BM_DoStateMeasure(benchmark::State& state)
+{
+  RunDoState(state, PointerWrap::MODE_MEASURE);
+}
+BENCHMARK(BM_DoStateMeasure);
+
+static void BM_DoStateWrite(benchmark::State& state)
+{
+  RunDoState(state, PointerWrap::MODE_WRITE);
+}
+BENCHMARK(BM_DoStateWrite);
+
+// The writer which grows its buffer, reused between saves like the rewind buffers are.
+static void BM_DoStateGrowingWrite(benchmark::State& state)
+{
+  State module_state;
+  std::vector<u8> buffer;
+
+  for (auto _ : state)
+  {
+    PointerWrap p(&buffer);
+    module_state.DoState(p);
+    p.FinishWrite();
+    benchmark::DoNotOptimize(buffer.data());
+  }
+
+  state.SetBytesProcessed(state.iterations() * buffer.size());
+}
+BENCHMARK(BM_DoStateGrowingWrite);
+
+static void BM_DoStateRead(benchmark::State& state)
+{
+  RunDoState(state, PointerWrap::MODE_READ);
+}
+BENCHMARK(BM_DoStateRead);
+
+static void BM_DoStateVerify(benchmark::State& state)
+{
+  RunDoState(state, PointerWrap::MODE_VERIFY);
+}
+BENCHMARK(BM_DoStateVerify);
@@ -0,0 +1,34 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Hash.h"
+
+// Arguments: the size of the hashed data, and the number of samples (0 hashes everything).
+static void BM_GetHash64(benchmark::State& state)
+{
+  SetHash64Function();
+
+  std::vector<u8> data(static_cast<size_t>(state.range(0)));
+  for (size_t i = 0; i < data.size(); i++)
+    data[i] = static_cast<u8>(i * 31);
+  const u32 samples = static_cast<u32>(state.range(1));
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(GetHash64(data.data(), static_cast<u32>(data.size()), samples));
+
+  if (samples == 0)
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_GetHash64)
+    ->Args({256, 0})
+    ->Args({4 * 1024, 0})
+    ->Args({256 * 1024, 0})
+    ->Args({4 * 1024 * 1024, 0})
+    ->Args({256 * 1024, 128})
+    ->Args({4 * 1024 * 1024, 128});
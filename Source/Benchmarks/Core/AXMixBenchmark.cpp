@@ -0,0 +1,85 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <array>
+
+#include <benchmark/benchmark.h>
+
+#include "Common/CommonTypes.h"
+
+// The mixing kernels of the Wii AX HLE, which mixes the most samples per voice.
+#define AX_WII
+#include "Core/HW/DSPHLE/UCodes/AXVoice.h"
+
+using namespace DSP::HLE;
+
+namespace
+{
+std::array<s16, MAX_SAMPLES_PER_FRAME> MakeSamples()
+{
+  std::array<s16, MAX_SAMPLES_PER_FRAME> samples;
+  for (size_t i = 0; i < samples.size(); i++)
+    samples[i] = static_cast<s16>(i * 1237);
+  return samples;
+}
+}
+
+// A frame of samples of one voice mixed to one output buffer, with and without volume ramping.
+static void BM_MixAdd(benchmark::State& state)
+{
+  const std::array<s16, MAX_SAMPLES_PER_FRAME> samples = MakeSamples();
+  std::array<int, MAX_SAMPLES_PER_FRAME> out{};
+  const bool ramp = state.range(0) != 0;
+
+  for (auto _ : state)
+  {
+    u16 volume[2] = {0x6000, 0x0010};
+    s16 dpop = 0;
+    MixAdd(out.data(), samples.data(), MAX_SAMPLES_PER_FRAME, volume, &dpop, ramp);
+    benchmark::DoNotOptimize(out.data());
+  }
+
+  state.SetItemsProcessed(state.iterations() * MAX_SAMPLES_PER_FRAME);
+}
+BENCHMARK(BM_MixAdd)->Arg(0)->Arg(1);
+
+// The main left, right and surround mixes of the 64 voices a frame can have.
+static void BM_MixVoices(benchmark::State& state)
+{
+  constexpr u32 NUM_VOICES = 64;
+  const std::array<s16, MAX_SAMPLES_PER_FRAME> samples = MakeSamples();
+  std::array<std::array<int, MAX_SAMPLES_PER_FRAME>, 3> out{};
+
+  for (auto _ : state)
+  {
+    for (u32 voice = 0; voice < NUM_VOICES; voice++)
+    {
+      for (auto& buffer : out)
+      {
+        u16 volume[2] = {static_cast<u16>(0x1000 + voice * 0x100), 0};
+        s16 dpop = 0;
+        MixAdd(buffer.data(), samples.data(), MAX_SAMPLES_PER_FRAME, volume, &dpop, false);
+      }
+    }
+    benchmark::DoNotOptimize(out.data());
+  }
+
+  state.SetItemsProcessed(state.iterations() * NUM_VOICES * MAX_SAMPLES_PER_FRAME);
+}
+BENCHMARK(BM_MixVoices);
+
+static void BM_LowPassFilter(benchmark::State& state)
+{
+  std::array<s16, MAX_SAMPLES_PER_FRAME> samples = MakeSamples();
+  s16 yn1 = 0;
+
+  for (auto _ : state)
+  {
+    yn1 = LowPassFilter(samples.data(), MAX_SAMPLES_PER_FRAME, yn1, 0x4000, 0x3FFF);
+    benchmark::DoNotOptimize(samples.data());
+  }
+
+  state.SetItemsProcessed(state.iterations() * MAX_SAMPLES_PER_FRAME);
+}
+BENCHMARK(BM_LowPassFilter);
@@ -0,0 +1,95 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Core/ConfigManager.h"
+#include "Core/Core.h"
+#include "Core/CoreTiming.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "UICommon/UICommon.h"
+
+namespace
+{
+class ScopeInit final
+{
+public:
+  ScopeInit() : m_profile_path(File::CreateTempDir())
+  {
+    Core::DeclareAsCPUThread();
+    UICommon::SetUserDirectory(m_profile_path);
+    Config::Init();
+    SConfig::Init();
+    PowerPC::Init(PowerPC::CORE_INTERPRETER);
+    CoreTiming::Init();
+  }
+  ~ScopeInit()
+  {
+    CoreTiming::Shutdown();
+    PowerPC::Shutdown();
+    SConfig::Shutdown();
+    Config::Shutdown();
+    Core::UndeclareAsCPUThread();
+    File::DeleteDirRecursively(m_profile_path);
+  }
+
+private:
+  std::string m_profile_path;
+};
+
+u64 s_events_ran = 0;
+
+void Callback(u64 userdata, s64 lateness)
+{
+  s_events_ran++;
+}
+}
+
+// Schedules as many events as the argument, spread over a few slices, and advances until all of
+// them ran, as if the CPU executed every slice completely.
+static void BM_ScheduleAndAdvance(benchmark::State& state)
+{
+  ScopeInit guard;
+  CoreTiming::EventType* event = CoreTiming::RegisterEvent("benchmark", Callback);
+  CoreTiming::Advance();
+
+  const u64 count = static_cast<u64>(state.range(0));
+  u32 seed = 1;
+  for (auto _ : state)
+  {
+    s_events_ran = 0;
+    for (u64 i = 0; i < count; i++)
+    {
+      seed = seed * 1103515245 + 12345;
+      CoreTiming::ScheduleEvent(1 + (seed >> 8) % 50000, event, i);
+    }
+    while (s_events_ran < count)
+    {
+      PowerPC::ppcState.downcount = 0;
+      CoreTiming::Advance();
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_ScheduleAndAdvance)->Arg(1)->Arg(16)->Arg(256);
+
+// Advancing through slices without any event due.
+static void BM_AdvanceIdle(benchmark::State& state)
+{
+  ScopeInit guard;
+  CoreTiming::Advance();
+
+  for (auto _ : state)
+  {
+    PowerPC::ppcState.downcount = 0;
+    CoreTiming::Advance();
+  }
+}
+BENCHMARK(BM_AdvanceIdle);
@@ -0,0 +1,63 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <memory>
+
+#include <benchmark/benchmark.h>
+
+#include "Common/CommonTypes.h"
+#include "Core/HW/MMIO.h"
+
+static constexpr u32 ADDRESS = 0x0C001234;
+
+static void BM_ReadConstant(benchmark::State& state)
+{
+  auto mapping = std::make_unique<MMIO::Mapping>();
+  mapping->Register(ADDRESS, MMIO::Constant<u32>(0xdeadbeef), MMIO::Nop<u32>());
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(mapping->Read<u32>(ADDRESS));
+}
+BENCHMARK(BM_ReadConstant);
+
+static void BM_ReadWriteDirect(benchmark::State& state)
+{
+  auto mapping = std::make_unique<MMIO::Mapping>();
+  u32 target = 0;
+  mapping->Register(ADDRESS, MMIO::DirectRead<u32>(&target), MMIO::DirectWrite<u32>(&target));
+
+  for (auto _ : state)
+    mapping->Write(ADDRESS, mapping->Read<u32>(ADDRESS) + 1);
+  benchmark::DoNotOptimize(target);
+}
+BENCHMARK(BM_ReadWriteDirect);
+
+static void BM_ReadWriteComplex(benchmark::State& state)
+{
+  auto mapping = std::make_unique<MMIO::Mapping>();
+  u32 target = 0;
+  mapping->Register(ADDRESS, MMIO::ComplexRead<u32>([&target](u32) { return target; }),
+                    MMIO::ComplexWrite<u32>([&target](u32, u32 val) { target = val; }));
+
+  for (auto _ : state)
+    mapping->Write(ADDRESS, mapping->Read<u32>(ADDRESS) + 1);
+  benchmark::DoNotOptimize(target);
+}
+BENCHMARK(BM_ReadWriteComplex);
+
+// 16 bit accesses to a register registered as two halves of a 32 bit value, the most common
+// layout of the hardware registers.
+static void BM_ReadSplitHalves(benchmark::State& state)
+{
+  auto mapping = std::make_unique<MMIO::Mapping>();
+  u32 target = 0x12345678;
+  mapping->Register(ADDRESS, MMIO::DirectRead<u16>(MMIO::Utils::HighPart(&target)),
+                    MMIO::DirectWrite<u16>(MMIO::Utils::HighPart(&target)));
+  mapping->Register(ADDRESS + 2, MMIO::DirectRead<u16>(MMIO::Utils::LowPart(&target)),
+                    MMIO::DirectWrite<u16>(MMIO::Utils::LowPart(&target)));
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(mapping->Read<u32>(ADDRESS));
+}
+BENCHMARK(BM_ReadSplitHalves);
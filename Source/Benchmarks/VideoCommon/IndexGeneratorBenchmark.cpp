@@ -0,0 +1,49 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/IndexGenerator.h"
+#include "VideoCommon/OpcodeDecoding.h"
+#include "VideoCommon/VideoConfig.h"
+
+// Arguments: the primitive, and whether the indices are 32 bit.
+static void BM_AddIndices(benchmark::State& state)
+{
+  constexpr u32 NUM_VERTICES = 3 * 1024;
+  g_Config.backend_info.bSupportsPrimitiveRestart = true;
+  g_Config.backend_info.bSupports32BitIndices = true;
+  g_Config.bUse32BitIndices = state.range(1) != 0;
+  IndexGenerator::Init();
+
+  // No primitive produces more than two indices per vertex.
+  std::vector<u32> buffer(2 * NUM_VERTICES);
+  const int primitive = static_cast<int>(state.range(0));
+  for (auto _ : state)
+  {
+    IndexGenerator::Start(buffer.data());
+    IndexGenerator::AddIndices(primitive, NUM_VERTICES);
+    benchmark::DoNotOptimize(buffer.data());
+  }
+
+  state.SetItemsProcessed(state.iterations() * NUM_VERTICES);
+
+  g_Config.backend_info.bSupports32BitIndices = false;
+  g_Config.bUse32BitIndices = false;
+  IndexGenerator::Init();
+}
+BENCHMARK(BM_AddIndices)->Apply([](benchmark::internal::Benchmark* benchmark) {
+  for (int primitive = OpcodeDecoder::GX_DRAW_QUADS; primitive <= OpcodeDecoder::GX_DRAW_POINTS;
+       primitive++)
+  {
+    // GX_DRAW_QUADS_2 only warns and draws quads.
+    if (primitive == OpcodeDecoder::GX_DRAW_QUADS_2)
+      continue;
+    benchmark->Args({primitive, 0});
+    benchmark->Args({primitive, 1});
+  }
+});
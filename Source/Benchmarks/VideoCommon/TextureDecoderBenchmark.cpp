@@ -0,0 +1,51 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "Common/Common.h"
+#include "Common/CommonTypes.h"
+#include "VideoCommon/TextureDecoder.h"
+
+// Arguments: the texture format, and the size of the square texture.
+static void BM_TexDecoder_Decode(benchmark::State& state)
+{
+  const TextureFormat format = static_cast<TextureFormat>(state.range(0));
+  const int size = static_cast<int>(state.range(1));
+
+  std::vector<u8> src(TexDecoder_GetTextureSizeInBytes(size, size, format));
+  u32 seed = 1;
+  for (u8& byte : src)
+  {
+    seed = seed * 1103515245 + 12345;
+    byte = static_cast<u8>(seed >> 16);
+  }
+  // Large enough for the 14 bit indices of C14X2.
+  std::vector<u8> tlut(0x4000 * 2);
+  for (size_t i = 0; i < tlut.size(); i++)
+    tlut[i] = static_cast<u8>(i * 7);
+  std::vector<u8> dst(static_cast<size_t>(size) * size * 4);
+
+  for (auto _ : state)
+  {
+    TexDecoder_Decode(dst.data(), src.data(), size, size, format, tlut.data(),
+                      TLUTFormat::RGB5A3);
+    benchmark::DoNotOptimize(dst.data());
+  }
+
+  state.SetItemsProcessed(state.iterations() * size * size);
+  state.SetBytesProcessed(state.iterations() * src.size());
+}
+BENCHMARK(BM_TexDecoder_Decode)->Apply([](benchmark::internal::Benchmark* benchmark) {
+  for (TextureFormat format :
+       {TextureFormat::I4, TextureFormat::I8, TextureFormat::IA4, TextureFormat::IA8,
+        TextureFormat::RGB565, TextureFormat::RGB5A3, TextureFormat::RGBA8, TextureFormat::C4,
+        TextureFormat::C8, TextureFormat::C14X2, TextureFormat::CMPR})
+  {
+    benchmark->Args({static_cast<int>(format), 64});
+    benchmark->Args({static_cast<int>(format), 512});
+  }
+});
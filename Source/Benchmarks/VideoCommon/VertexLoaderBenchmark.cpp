@@ -0,0 +1,136 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/CPMemory.h"
+#include "VideoCommon/DataReader.h"
+#include "VideoCommon/VertexLoader.h"
+#include "VideoCommon/VertexLoaderBase.h"
+#include "VideoCommon/VertexLoaderManager.h"
+
+namespace
+{
+constexpr int NUM_VERTICES = 4096;
+
+enum Format
+{
+  // Float positions only, as used for e.g. shadow volumes.
+  POSITION_ONLY,
+  // Direct float positions, normals and texture coordinates, and an RGBA8 color.
+  DIRECT_FLOAT,
+  // 16 bit indexed float positions and normals, 8 bit indexed short texture coordinates, the
+  // layout of most models.
+  INDEXED,
+};
+
+enum Loader
+{
+  // The software loader.
+  SOFTWARE,
+  // The loader the platform uses, the JIT one on x86-64 and AArch64.
+  PLATFORM,
+};
+
+void SetUpFormat(Format format, TVtxDesc* vtx_desc, VAT* vtx_attr)
+{
+  std::memset(vtx_desc, 0, sizeof(*vtx_desc));
+  std::memset(vtx_attr, 0, sizeof(*vtx_attr));
+  vtx_attr->g0.ByteDequant = true;
+
+  vtx_attr->g0.PosElements = 1;  // XYZ
+  vtx_attr->g0.PosFormat = FORMAT_FLOAT;
+  if (format == POSITION_ONLY)
+  {
+    vtx_desc->Position = DIRECT;
+    return;
+  }
+
+  vtx_attr->g0.NormalFormat = FORMAT_FLOAT;
+  vtx_attr->g0.Tex0CoordElements = 1;  // ST
+  if (format == DIRECT_FLOAT)
+  {
+    vtx_desc->Position = DIRECT;
+    vtx_desc->Normal = DIRECT;
+    vtx_desc->Color0 = DIRECT;
+    vtx_desc->Tex0Coord = DIRECT;
+    vtx_attr->g0.Color0Elements = 1;  // RGBA
+    vtx_attr->g0.Color0Comp = FORMAT_32B_8888;
+    vtx_attr->g0.Tex0CoordFormat = FORMAT_FLOAT;
+  }
+  else
+  {
+    vtx_desc->Position = INDEX16;
+    vtx_desc->Normal = INDEX16;
+    vtx_desc->Tex0Coord = INDEX8;
+    vtx_attr->g0.Tex0CoordFormat = FORMAT_SHORT;
+    vtx_attr->g0.Tex0Frac = 10;
+  }
+}
+
+void FillPseudoRandom(std::vector<u8>* data, u32 seed)
+{
+  for (u8& byte : *data)
+  {
+    seed = seed * 1103515245 + 12345;
+    byte = static_cast<u8>(seed >> 16);
+  }
+}
+}
+
+// Arguments: the vertex format and the loader.
+static void BM_RunVertices(benchmark::State& state)
+{
+  TVtxDesc vtx_desc;
+  VAT vtx_attr;
+  SetUpFormat(static_cast<Format>(state.range(0)), &vtx_desc, &vtx_attr);
+  std::unique_ptr<VertexLoaderBase> loader;
+  if (state.range(1) == SOFTWARE)
+    loader = std::make_unique<VertexLoader>(vtx_desc, vtx_attr);
+  else
+    loader = VertexLoaderBase::CreateVertexLoader(vtx_desc, vtx_attr);
+  state.SetLabel(loader->GetName());
+
+  // Arrays large enough for any 16 bit index, with float values which aren't denormals.
+  constexpr u32 ARRAY_STRIDE = 3 * sizeof(float);
+  std::vector<float> array(0x10000 * 3);
+  for (size_t i = 0; i < array.size(); i++)
+    array[i] = static_cast<float>(i % 1000) * 0.25f;
+  for (int i = 0; i < 12; i++)
+  {
+    VertexLoaderManager::cached_arraybases[i] = reinterpret_cast<u8*>(array.data());
+    g_main_cp_state.array_strides[i] = ARRAY_STRIDE;
+  }
+
+  std::vector<u8> input(static_cast<size_t>(NUM_VERTICES) * loader->m_VertexSize);
+  FillPseudoRandom(&input, 1);
+  if (state.range(0) == DIRECT_FLOAT)
+  {
+    // Direct floats are copied as they are, so only keep a valid exponent.
+    for (size_t i = 0; i < input.size(); i += 4)
+      input[i] &= 0x3F;
+  }
+  std::vector<u8> output(static_cast<size_t>(NUM_VERTICES) * loader->m_native_vtx_decl.stride);
+
+  for (auto _ : state)
+  {
+    DataReader src(input.data(), input.data() + input.size());
+    DataReader dst(output.data(), output.data() + output.size());
+    benchmark::DoNotOptimize(loader->RunVertices(src, dst, NUM_VERTICES));
+  }
+
+  state.SetItemsProcessed(state.iterations() * NUM_VERTICES);
+}
+BENCHMARK(BM_RunVertices)->Apply([](benchmark::internal::Benchmark* benchmark) {
+  for (int format : {POSITION_ONLY, DIRECT_FLOAT, INDEXED})
+  {
+    benchmark->Args({format, SOFTWARE});
+    benchmark->Args({format, PLATFORM});
+  }
+});
@@ -60,9 +60,14 @@ bool CubebStream::Start()
     ERROR_LOG(AUDIO, "Error getting minimum latency");
   INFO_LOG(AUDIO, "Minimum latency: %i frames", minimum_latency);
 
+  // In low latency mode, the mixer adapts its own buffering to the emulation, so ask for the
+  // smallest buffer the device supports.
+  u32 latency = std::max(BUFFER_SAMPLES, minimum_latency);
+  if (SConfig::GetInstance().m_audio_low_latency && minimum_latency != 0)
+    latency = minimum_latency;
+
   if (cubeb_stream_init(m_ctx.get(), &m_stream, "Dolphin Audio Output", nullptr, nullptr, nullptr,
-                        &params, std::max(BUFFER_SAMPLES, minimum_latency), DataCallback,
-                        StateCallback, this) != CUBEB_OK)
+                        &params, latency, DataCallback, StateCallback, this) != CUBEB_OK)
   {
     ERROR_LOG(AUDIO, "Error initializing cubeb stream");
     return false;
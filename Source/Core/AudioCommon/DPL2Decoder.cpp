@@ -12,13 +12,17 @@
 #include <cstdlib>
 #include <cstring>
 #include <functional>
-#include <numeric>
 #include <vector>
 
 #include "AudioCommon/DPL2Decoder.h"
 #include "Common/CommonTypes.h"
+#include "Common/Intrinsics.h"
 #include "Common/MathUtil.h"
 
+#ifdef _M_ARM_64
+#include <arm_neon.h>
+#endif
+
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
@@ -34,41 +38,297 @@ static float l_fwr, r_fwr, lpr_fwr, lmr_fwr;
 static std::vector<float> fwrbuf_l, fwrbuf_r;
 static float adapt_l_gain, adapt_r_gain, adapt_lpr_gain, adapt_lmr_gain;
 static std::vector<float> lf, rf, lr, rr, cf, cr;
-static float LFE_buf[256];
-static unsigned int lfe_pos;
-static std::vector<float> filter_coefs_lfe;
-static unsigned int len125;
 
-template <class T>
-static float DotProduct(int count, const T* buf, const std::vector<float>& coeffs, int offset)
+// The LFE channel is the sum of all channels through a 125 Hz lowpass FIR filter. It used to be
+// applied one sample at a time on a ring buffer; now the input of the filter for a whole call is
+// put after the last LFE_TAPS - 1 samples of the previous call, and filtered in blocks with FFT
+// convolution (overlap-save), or directly when there are too few samples for the FFT to pay off.
+static constexpr u32 LFE_TAPS = 256;
+static constexpr u32 LFE_FFT_SIZE = 512;
+static constexpr u32 LFE_FFT_BITS = 9;
+// Outputs of one FFT block, the other LFE_TAPS - 1 results wrap around.
+static constexpr u32 LFE_BLOCK_SIZE = LFE_FFT_SIZE - LFE_TAPS + 1;
+// Below this many samples, two FFTs cost more than the direct convolution.
+static constexpr u32 LFE_MIN_FFT_SAMPLES = 128;
+
+static_assert(1 << LFE_FFT_BITS == LFE_FFT_SIZE, "FFT size must match its bits");
+static_assert(LFE_TAPS % 4 == 0, "The direct filter processes 4 taps at a time");
+
+// Coefficients, reversed so y[i] is the dot product with the input from x[i - LFE_TAPS + 1].
+static std::vector<float> lfe_taps_reversed;
+// Spectrum of the filter, including the 1 / N of the inverse FFT.
+static std::vector<float> lfe_spectrum_re, lfe_spectrum_im;
+// Filter input: LFE_TAPS - 1 samples of history, then the samples of the current call.
+static std::vector<float> lfe_input;
+static std::vector<float> lfe_output;
+
+// FFT tables: the twiddle factors of the stage with butterflies of half size n are at [n, 2n).
+static std::vector<float> fft_twiddle_re, fft_twiddle_im;
+static std::vector<u16> fft_bit_reverse;
+static std::vector<float> fft_re, fft_im, fft_re2, fft_im2;
+
+#if defined(_M_X86)
+using Float4 = __m128;
+static inline Float4 Load4(const float* p)
+{
+  return _mm_loadu_ps(p);
+}
+static inline void Store4(float* p, Float4 v)
+{
+  _mm_storeu_ps(p, v);
+}
+static inline Float4 Zero4()
+{
+  return _mm_setzero_ps();
+}
+static inline Float4 Add4(Float4 a, Float4 b)
+{
+  return _mm_add_ps(a, b);
+}
+static inline Float4 Sub4(Float4 a, Float4 b)
+{
+  return _mm_sub_ps(a, b);
+}
+static inline Float4 Mul4(Float4 a, Float4 b)
+{
+  return _mm_mul_ps(a, b);
+}
+static inline float Sum4(Float4 v)
+{
+  v = _mm_add_ps(v, _mm_movehl_ps(v, v));
+  v = _mm_add_ss(v, _mm_shuffle_ps(v, v, 1));
+  return _mm_cvtss_f32(v);
+}
+#elif defined(_M_ARM_64)
+using Float4 = float32x4_t;
+static inline Float4 Load4(const float* p)
+{
+  return vld1q_f32(p);
+}
+static inline void Store4(float* p, Float4 v)
+{
+  vst1q_f32(p, v);
+}
+static inline Float4 Zero4()
+{
+  return vdupq_n_f32(0.0f);
+}
+static inline Float4 Add4(Float4 a, Float4 b)
+{
+  return vaddq_f32(a, b);
+}
+static inline Float4 Sub4(Float4 a, Float4 b)
+{
+  return vsubq_f32(a, b);
+}
+static inline Float4 Mul4(Float4 a, Float4 b)
+{
+  return vmulq_f32(a, b);
+}
+static inline float Sum4(Float4 v)
+{
+  return vaddvq_f32(v);
+}
+#else
+struct Float4
+{
+  float v[4];
+};
+static inline Float4 Load4(const float* p)
+{
+  return {{p[0], p[1], p[2], p[3]}};
+}
+static inline void Store4(float* p, Float4 v)
+{
+  std::copy(v.v, v.v + 4, p);
+}
+static inline Float4 Zero4()
+{
+  return {{0.0f, 0.0f, 0.0f, 0.0f}};
+}
+static inline Float4 Add4(Float4 a, Float4 b)
+{
+  return {{a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3]}};
+}
+static inline Float4 Sub4(Float4 a, Float4 b)
+{
+  return {{a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3]}};
+}
+static inline Float4 Mul4(Float4 a, Float4 b)
+{
+  return {{a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3]}};
+}
+static inline float Sum4(Float4 v)
+{
+  return (v.v[0] + v.v[1]) + (v.v[2] + v.v[3]);
+}
+#endif
+
+static void InitFFT()
 {
-  return std::inner_product(buf, buf + count, coeffs.begin() + offset, T(0));
+  fft_twiddle_re.resize(LFE_FFT_SIZE);
+  fft_twiddle_im.resize(LFE_FFT_SIZE);
+  for (u32 half = 1; half < LFE_FFT_SIZE; half *= 2)
+  {
+    for (u32 j = 0; j < half; j++)
+    {
+      const double angle = -M_PI * j / half;
+      fft_twiddle_re[half + j] = static_cast<float>(cos(angle));
+      fft_twiddle_im[half + j] = static_cast<float>(sin(angle));
+    }
+  }
+
+  fft_bit_reverse.resize(LFE_FFT_SIZE);
+  for (u32 i = 0; i < LFE_FFT_SIZE; i++)
+  {
+    u32 reversed = 0;
+    for (u32 bit = 0; bit < LFE_FFT_BITS; bit++)
+      reversed |= ((i >> bit) & 1) << (LFE_FFT_BITS - 1 - bit);
+    fft_bit_reverse[i] = static_cast<u16>(reversed);
+  }
+
+  fft_re.resize(LFE_FFT_SIZE);
+  fft_im.resize(LFE_FFT_SIZE);
+  fft_re2.resize(LFE_FFT_SIZE);
+  fft_im2.resize(LFE_FFT_SIZE);
 }
 
-template <class T>
-static T FIRFilter(const T* buf, int pos, int len, int count, const std::vector<float>& coeffs)
+// Forward radix 2 FFT of LFE_FFT_SIZE points, from in to out. With the real and imaginary parts
+// swapped on both sides, this is the inverse FFT without the 1 / N scale.
+static void FFT(const float* in_re, const float* in_im, float* out_re, float* out_im)
 {
-  int count1, count2;
+  for (u32 i = 0; i < LFE_FFT_SIZE; i++)
+  {
+    out_re[fft_bit_reverse[i]] = in_re[i];
+    out_im[fft_bit_reverse[i]] = in_im[i];
+  }
 
-  if (pos >= count)
+  // The first two stages have less than 4 butterflies per group, and trivial twiddle factors.
+  for (u32 i = 0; i < LFE_FFT_SIZE; i += 4)
   {
-    pos -= count;
-    count1 = count;
-    count2 = 0;
+    const float a_re = out_re[i] + out_re[i + 1], a_im = out_im[i] + out_im[i + 1];
+    const float b_re = out_re[i] - out_re[i + 1], b_im = out_im[i] - out_im[i + 1];
+    const float c_re = out_re[i + 2] + out_re[i + 3], c_im = out_im[i + 2] + out_im[i + 3];
+    const float d_re = out_re[i + 2] - out_re[i + 3], d_im = out_im[i + 2] - out_im[i + 3];
+    out_re[i] = a_re + c_re;
+    out_im[i] = a_im + c_im;
+    out_re[i + 2] = a_re - c_re;
+    out_im[i + 2] = a_im - c_im;
+    // b + d * -i and b - d * -i
+    out_re[i + 1] = b_re + d_im;
+    out_im[i + 1] = b_im - d_re;
+    out_re[i + 3] = b_re - d_im;
+    out_im[i + 3] = b_im + d_re;
   }
-  else
+
+  for (u32 half = 4; half < LFE_FFT_SIZE; half *= 2)
   {
-    count2 = pos;
-    count1 = count - pos;
-    pos = len - count1;
+    for (u32 group = 0; group < LFE_FFT_SIZE; group += half * 2)
+    {
+      for (u32 j = 0; j < half; j += 4)
+      {
+        const u32 a = group + j;
+        const u32 b = a + half;
+        const Float4 w_re = Load4(&fft_twiddle_re[half + j]);
+        const Float4 w_im = Load4(&fft_twiddle_im[half + j]);
+        const Float4 b_re = Load4(&out_re[b]);
+        const Float4 b_im = Load4(&out_im[b]);
+        const Float4 t_re = Sub4(Mul4(b_re, w_re), Mul4(b_im, w_im));
+        const Float4 t_im = Add4(Mul4(b_re, w_im), Mul4(b_im, w_re));
+        const Float4 a_re = Load4(&out_re[a]);
+        const Float4 a_im = Load4(&out_im[a]);
+        Store4(&out_re[a], Add4(a_re, t_re));
+        Store4(&out_im[a], Add4(a_im, t_im));
+        Store4(&out_re[b], Sub4(a_re, t_re));
+        Store4(&out_im[b], Sub4(a_im, t_im));
+      }
+    }
+  }
+}
+
+static void DirectLFEFilter(u32 count)
+{
+  for (u32 i = 0; i < count; i++)
+  {
+    const float* input = &lfe_input[i];
+    Float4 sum = Zero4();
+    for (u32 j = 0; j < LFE_TAPS; j += 4)
+      sum = Add4(sum, Mul4(Load4(&input[j]), Load4(&lfe_taps_reversed[j])));
+    lfe_output[i] = Sum4(sum);
   }
+}
 
-  // high part of window
-  const T* ptr = &buf[pos];
+// Filters two blocks in one FFT, as the real and imaginary parts of the input: as the filter is
+// real, the real and imaginary parts of the result are then the two filtered blocks.
+static void FFTLFEFilter(u32 count)
+{
+  const u32 input_size = count + LFE_TAPS - 1;
+  for (u32 start = 0; start < count; start += LFE_BLOCK_SIZE * 2)
+  {
+    const u32 second = start + LFE_BLOCK_SIZE;
+    for (u32 i = 0; i < LFE_FFT_SIZE; i++)
+    {
+      fft_re2[i] = start + i < input_size ? lfe_input[start + i] : 0.0f;
+      fft_im2[i] = second + i < input_size ? lfe_input[second + i] : 0.0f;
+    }
 
-  float r1 = DotProduct(count1, ptr, coeffs, 0);
-  float r2 = DotProduct(count2, buf, coeffs, count1);
-  return T(r1 + r2);
+    FFT(fft_re2.data(), fft_im2.data(), fft_re.data(), fft_im.data());
+
+    for (u32 i = 0; i < LFE_FFT_SIZE; i += 4)
+    {
+      const Float4 x_re = Load4(&fft_re[i]);
+      const Float4 x_im = Load4(&fft_im[i]);
+      const Float4 h_re = Load4(&lfe_spectrum_re[i]);
+      const Float4 h_im = Load4(&lfe_spectrum_im[i]);
+      Store4(&fft_re[i], Sub4(Mul4(x_re, h_re), Mul4(x_im, h_im)));
+      Store4(&fft_im[i], Add4(Mul4(x_re, h_im), Mul4(x_im, h_re)));
+    }
+
+    // Inverse FFT, with real and imaginary parts swapped.
+    FFT(fft_im.data(), fft_re.data(), fft_im2.data(), fft_re2.data());
+
+    for (u32 i = 0; i < LFE_BLOCK_SIZE; i++)
+    {
+      if (start + i < count)
+        lfe_output[start + i] = fft_re2[LFE_TAPS - 1 + i];
+      if (second + i < count)
+        lfe_output[second + i] = fft_im2[LFE_TAPS - 1 + i];
+    }
+  }
+}
+
+static void InitLFEFilter(const std::vector<float>& coeffs)
+{
+  // The ring buffer filter multiplied the newest sample by coeffs[0], and the sample from m
+  // samples before by coeffs[LFE_TAPS - m].
+  lfe_taps_reversed.resize(LFE_TAPS);
+  for (u32 k = 0; k < LFE_TAPS; k++)
+    lfe_taps_reversed[k] = coeffs[(k + 1) % LFE_TAPS];
+
+  InitFFT();
+  for (u32 i = 0; i < LFE_FFT_SIZE; i++)
+  {
+    fft_re2[i] =
+        i < LFE_TAPS ? lfe_taps_reversed[LFE_TAPS - 1 - i] / static_cast<float>(LFE_FFT_SIZE) : 0;
+    fft_im2[i] = 0.0f;
+  }
+  lfe_spectrum_re.resize(LFE_FFT_SIZE);
+  lfe_spectrum_im.resize(LFE_FFT_SIZE);
+  FFT(fft_re2.data(), fft_im2.data(), lfe_spectrum_re.data(), lfe_spectrum_im.data());
+
+  lfe_input.assign(LFE_TAPS - 1, 0.0f);
+}
+
+static void LFEFilter(u32 count)
+{
+  lfe_output.resize(count);
+  if (count < LFE_MIN_FFT_SAMPLES)
+    DirectLFEFilter(count);
+  else
+    FFTLFEFilter(count);
+
+  // Keep the last LFE_TAPS - 1 samples as the history of the next call.
+  lfe_input.erase(lfe_input.begin(), lfe_input.end() - (LFE_TAPS - 1));
 }
 
 /*
@@ -167,24 +427,22 @@ static void OnSeek()
   std::fill(rr.begin(), rr.end(), 0.0f);
   std::fill(cf.begin(), cf.end(), 0.0f);
   std::fill(cr.begin(), cr.end(), 0.0f);
-  lfe_pos = 0;
-  memset(LFE_buf, 0, sizeof(LFE_buf));
+  lfe_input.assign(LFE_TAPS - 1, 0.0f);
 }
 
 static void Done()
 {
   OnSeek();
 
-  filter_coefs_lfe.clear();
+  lfe_taps_reversed.clear();
 }
 
 static std::vector<float> CalculateCoefficients125HzLowpass(int rate)
 {
-  len125 = 256;
   float f = 125.0f / (rate / 2);
-  std::vector<float> coeffs = DesignFIR(len125, f, 0);
+  std::vector<float> coeffs = DesignFIR(LFE_TAPS, f, 0);
   static const float M3_01DB = 0.7071067812f;
-  for (unsigned int i = 0; i < len125; i++)
+  for (unsigned int i = 0; i < LFE_TAPS; i++)
   {
     coeffs[i] *= M3_01DB;
   }
@@ -306,11 +564,11 @@ void DPL2Decode(float* samples, int numsamples, float* out)
     rr.resize(dlbuflen);
     cf.resize(dlbuflen);
     cr.resize(dlbuflen);
-    filter_coefs_lfe = CalculateCoefficients125HzLowpass(fmt_freq);
-    lfe_pos = 0;
-    memset(LFE_buf, 0, sizeof(LFE_buf));
+    InitLFEFilter(CalculateCoefficients125HzLowpass(fmt_freq));
   }
 
+  lfe_input.reserve(LFE_TAPS - 1 + numsamples);
+
   float* in = samples;                           // Input audio data
   float* end = in + numsamples * fmt_nchannels;  // Loop end
 
@@ -336,13 +594,7 @@ void DPL2Decode(float* samples, int numsamples, float* out)
     out[cur + 0] = lf[k];
     out[cur + 1] = rf[k];
     out[cur + 2] = cf[k];
-    LFE_buf[lfe_pos] = (lf[k] + rf[k] + 2.0f * cf[k] + lr[k] + rr[k]) / 2.0f;
-    out[cur + 3] = FIRFilter(LFE_buf, lfe_pos, len125, len125, filter_coefs_lfe);
-    lfe_pos++;
-    if (lfe_pos == len125)
-    {
-      lfe_pos = 0;
-    }
+    lfe_input.push_back((lf[k] + rf[k] + 2.0f * cf[k] + lr[k] + rr[k]) / 2.0f);
     out[cur + 4] = lr[k];
     out[cur + 5] = rr[k];
     // Next sample...
@@ -354,11 +606,15 @@ void DPL2Decode(float* samples, int numsamples, float* out)
       cyc_pos += dlbuflen;
     }
   }
+
+  LFEFilter(numsamples);
+  for (int i = 0; i < numsamples; i++)
+    out[i * 6 + 3] = lfe_output[i];
 }
 
 void DPL2Reset()
 {
   olddelay = -1;
   oldfreq = 0;
-  filter_coefs_lfe.clear();
+  lfe_taps_reversed.clear();
 }
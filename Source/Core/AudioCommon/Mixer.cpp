@@ -4,6 +4,7 @@
 
 #include "AudioCommon/Mixer.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstring>
 
@@ -11,12 +12,26 @@
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
+#include "Common/Logging/Trace.h"
 #include "Common/MathUtil.h"
+#include "Common/Metrics.h"
 #include "Common/Swap.h"
 #include "Core/ConfigManager.h"
 #include "VideoCommon/VR.h"
 #include "VideoCommon/VideoConfig.h"
 
+// Low latency mode: the FIFO target level never goes below this, and shrinks by
+// LOW_LATENCY_SHRINK_FACTOR for every second without underrun.
+static constexpr float LOW_LATENCY_MIN_MS = 5.0f;
+static constexpr float LOW_LATENCY_SHRINK_FACTOR = 0.9f;
+// Low latency mode: time-stretch while the emulation speed is below the first value, until it
+// reaches the second one.
+static constexpr float LOW_LATENCY_STRETCH_START_SPEED = 0.95f;
+static constexpr float LOW_LATENCY_STRETCH_END_SPEED = 0.99f;
+
+static Metrics::Counter s_underruns("dolphin_audio_underruns_total",
+                                    "Mixes which ran out of samples before filling the buffer.");
+
 Mixer::Mixer(unsigned int BackendSampleRate)
     : m_sampleRate(BackendSampleRate), m_stretcher(BackendSampleRate)
 {
@@ -50,6 +65,8 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
   // interpolation loop.
   u32 indexR = m_indexR.load();
   u32 indexW = m_indexW.load();
+  const u32 available_at_start = (indexW - indexR) & INDEX_MASK;
+  const bool low_latency = consider_framelimit && SConfig::GetInstance().m_audio_low_latency;
 
   // render numleft sample pairs to samples[]
   // advance indexR with sample position
@@ -63,6 +80,12 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
 
     u32 low_waterwark = m_input_sample_rate * SConfig::GetInstance().iTimingVariance / 1000;
     low_waterwark = std::min(low_waterwark, MAX_SAMPLES / 2);
+    if (low_latency)
+    {
+      if (m_adaptive_watermark == 0.0f)
+        m_adaptive_watermark = static_cast<float>(low_waterwark);
+      low_waterwark = static_cast<u32>(m_adaptive_watermark);
+    }
 
     m_numLeftI = (numLeft + m_numLeftI * (CONTROL_AVG - 1)) / CONTROL_AVG;
     float offset = (m_numLeftI - low_waterwark) * CONTROL_FACTOR;
@@ -91,20 +114,44 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
   s32 lvolume = m_LVolume.load();
   s32 rvolume = m_RVolume.load();
 
+  if (ratio == 0x10000 && m_frac == 0)
+  {
+    // Same sample rate: every sample is used as is. Mix contiguous runs of the ring buffer, which
+    // the compiler can vectorize.
+    const u32 available = ((indexW - indexR) & INDEX_MASK) / 2;
+    u32 count = std::min(numSamples, available > 1 ? available - 1 : 0);
+    while (count > 0)
+    {
+      const u32 start = indexR & INDEX_MASK;
+      const u32 run = std::min(count, (MAX_SAMPLES * 2 - start) / 2);
+      const short* in = &m_buffer[start];
+      short* out = &samples[currentSample];
+      for (u32 i = 0; i < run * 2; i += 2)
+      {
+        out[i + 1] = MathUtil::Clamp(((in[i] * lvolume) >> 8) + out[i + 1], -32767, 32767);
+        out[i] = MathUtil::Clamp(((in[i + 1] * rvolume) >> 8) + out[i], -32767, 32767);
+      }
+
+      currentSample += run * 2;
+      indexR += run * 2;
+      count -= run;
+    }
+  }
+
   // TODO: consider a higher-quality resampling algorithm.
   for (; currentSample < numSamples * 2 && ((indexW - indexR) & INDEX_MASK) > 2; currentSample += 2)
   {
     u32 indexR2 = indexR + 2;  // next sample
 
-    s16 l1 = Common::swap16(m_buffer[indexR & INDEX_MASK]);   // current
-    s16 l2 = Common::swap16(m_buffer[indexR2 & INDEX_MASK]);  // next
+    s16 l1 = m_buffer[indexR & INDEX_MASK];   // current
+    s16 l2 = m_buffer[indexR2 & INDEX_MASK];  // next
     int sampleL = ((l1 << 16) + (l2 - l1) * (u16)m_frac) >> 16;
     sampleL = (sampleL * lvolume) >> 8;
     sampleL += samples[currentSample + 1];
     samples[currentSample + 1] = MathUtil::Clamp(sampleL, -32767, 32767);
 
-    s16 r1 = Common::swap16(m_buffer[(indexR + 1) & INDEX_MASK]);   // current
-    s16 r2 = Common::swap16(m_buffer[(indexR2 + 1) & INDEX_MASK]);  // next
+    s16 r1 = m_buffer[(indexR + 1) & INDEX_MASK];   // current
+    s16 r2 = m_buffer[(indexR2 + 1) & INDEX_MASK];  // next
     int sampleR = ((r1 << 16) + (r2 - r1) * (u16)m_frac) >> 16;
     sampleR = (sampleR * rvolume) >> 8;
     sampleR += samples[currentSample];
@@ -118,10 +165,17 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
   // Actual number of samples written to the buffer without padding.
   unsigned int actual_sample_count = currentSample / 2;
 
+  // An empty FIFO means there is no audio at all (e.g. while paused), not an underrun.
+  const bool underrun = available_at_start > 2 && actual_sample_count < numSamples;
+  if (underrun)
+    s_underruns.Increment();
+  if (low_latency)
+    UpdateAdaptiveWatermark(underrun, numSamples);
+
   // Padding
   short s[2];
-  s[0] = Common::swap16(m_buffer[(indexR - 1) & INDEX_MASK]);
-  s[1] = Common::swap16(m_buffer[(indexR - 2) & INDEX_MASK]);
+  s[0] = m_buffer[(indexR - 1) & INDEX_MASK];
+  s[1] = m_buffer[(indexR - 2) & INDEX_MASK];
   s[0] = (s[0] * rvolume) >> 8;
   s[1] = (s[1] * lvolume) >> 8;
   for (; currentSample < numSamples * 2; currentSample += 2)
@@ -139,19 +193,56 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
   return actual_sample_count;
 }
 
+// Executed from sound stream thread
+void Mixer::MixerFifo::UpdateAdaptiveWatermark(bool underrun, unsigned int num_samples)
+{
+  // The FIFO has to hold at least what the backend requests at once, in input samples.
+  const float input_per_output =
+      static_cast<float>(m_input_sample_rate) / static_cast<float>(m_mixer->m_sampleRate);
+  const float min_watermark = std::max(m_input_sample_rate * LOW_LATENCY_MIN_MS / 1000.0f,
+                                       num_samples * input_per_output);
+
+  if (underrun)
+  {
+    m_adaptive_watermark = std::min(std::max(m_adaptive_watermark, min_watermark) * 2.0f,
+                                    static_cast<float>(MAX_SAMPLES / 2));
+    m_samples_since_underrun = 0;
+    return;
+  }
+
+  m_samples_since_underrun += num_samples;
+  if (m_samples_since_underrun >= m_mixer->m_sampleRate)
+  {
+    m_samples_since_underrun = 0;
+    m_adaptive_watermark =
+        std::max(m_adaptive_watermark * LOW_LATENCY_SHRINK_FACTOR, min_watermark);
+  }
+}
+
 unsigned int Mixer::Mix(short* samples, unsigned int num_samples)
 {
   if (!samples)
     return 0;
 
+  TRACE_SCOPE("Mixer::Mix");
+
   memset(samples, 0, num_samples * 2 * sizeof(short));
 
-  if (SConfig::GetInstance().m_audio_stretch)
+  bool stretch = SConfig::GetInstance().m_audio_stretch;
+  if (!stretch && SConfig::GetInstance().m_audio_low_latency)
+  {
+    // The stretcher adds latency of its own, so only use it while the emulation can't keep up.
+    const float speed = m_speed.load();
+    stretch = speed > 0.0f && speed < (m_is_stretching ? LOW_LATENCY_STRETCH_END_SPEED :
+                                                         LOW_LATENCY_STRETCH_START_SPEED);
+  }
+
+  if (stretch)
   {
     unsigned int available_samples =
         std::min(m_dma_mixer.AvailableSamples(), m_streaming_mixer.AvailableSamples());
 
-    m_scratch_buffer.fill(0);
+    std::fill_n(m_scratch_buffer.begin(), available_samples * 2, 0);
 
     m_dma_mixer.Mix(m_scratch_buffer.data(), available_samples, false);
     m_streaming_mixer.Mix(m_scratch_buffer.data(), available_samples, false);
@@ -211,16 +302,31 @@ void Mixer::MixerFifo::PushSamples(const short* samples, unsigned int num_sample
 
   // AyuanX: Actual re-sampling work has been moved to sound thread
   // to alleviate the workload on main thread
-  // and we simply store raw data here to make fast mem copy
-  int over_bytes = num_samples * 4 - (MAX_SAMPLES * 2 - (indexW & INDEX_MASK)) * sizeof(short);
-  if (over_bytes > 0)
-  {
-    memcpy(&m_buffer[indexW & INDEX_MASK], samples, num_samples * 4 - over_bytes);
-    memcpy(&m_buffer[0], samples + (num_samples * 4 - over_bytes) / sizeof(short), over_bytes);
-  }
-  else
+  // and we simply store raw data here, converted to host byte order once instead of at every
+  // read of the resampler.
+  const u32 start = indexW & INDEX_MASK;
+  const u32 first_run = std::min(num_samples * 2, MAX_SAMPLES * 2 - start);
+  for (u32 i = 0; i < first_run; i++)
+    m_buffer[start + i] = Common::swap16(samples[i]);
+  for (u32 i = first_run; i < num_samples * 2; i++)
+    m_buffer[i - first_run] = Common::swap16(samples[i]);
+
+  m_indexW.fetch_add(num_samples * 2);
+}
+
+void Mixer::MixerFifo::PushMonoSamples(const short* samples, unsigned int num_samples)
+{
+  u32 indexW = m_indexW.load();
+
+  if (num_samples * 2 + ((indexW - m_indexR.load()) & INDEX_MASK) >= MAX_SAMPLES * 2)
+    return;
+
+  // indexW is always even, so a stereo pair never wraps around the end of the buffer.
+  for (u32 i = 0; i < num_samples; i++)
   {
-    memcpy(&m_buffer[indexW & INDEX_MASK], samples, num_samples * 4);
+    const u32 index = (indexW + i * 2) & INDEX_MASK;
+    m_buffer[index] = samples[i];
+    m_buffer[index + 1] = samples[i];
   }
 
   m_indexW.fetch_add(num_samples * 2);
@@ -245,19 +351,10 @@ void Mixer::PushStreamingSamples(const short* samples, unsigned int num_samples)
 void Mixer::PushWiimoteSpeakerSamples(const short* samples, unsigned int num_samples,
                                       unsigned int sample_rate)
 {
-  short samples_stereo[MAX_SAMPLES * 2];
-
   if (num_samples < MAX_SAMPLES)
   {
     m_wiimote_speaker_mixer.SetInputSampleRate(sample_rate);
-
-    for (unsigned int i = 0; i < num_samples; ++i)
-    {
-      samples_stereo[i * 2] = Common::swap16(samples[i]);
-      samples_stereo[i * 2 + 1] = Common::swap16(samples[i]);
-    }
-
-    m_wiimote_speaker_mixer.PushSamples(samples_stereo, num_samples);
+    m_wiimote_speaker_mixer.PushMonoSamples(samples, num_samples);
   }
 }
 
@@ -67,6 +67,8 @@ private:
     }
     void DoState(PointerWrap& p);
     void PushSamples(const short* samples, unsigned int num_samples);
+    // Pushes samples in host byte order, played on both channels.
+    void PushMonoSamples(const short* samples, unsigned int num_samples);
     unsigned int Mix(short* samples, unsigned int numSamples, bool consider_framelimit = true);
     void SetInputSampleRate(unsigned int rate);
     unsigned int GetInputSampleRate() const;
@@ -74,8 +76,13 @@ private:
     unsigned int AvailableSamples() const;
 
   private:
+    // Low latency mode: raises the FIFO target level after an underrun, and lowers it while
+    // there is none.
+    void UpdateAdaptiveWatermark(bool underrun, unsigned int num_samples);
+
     Mixer* m_mixer;
     unsigned m_input_sample_rate;
+    // Interleaved stereo samples, in host byte order.
     std::array<short, MAX_SAMPLES * 2> m_buffer{};
     std::atomic<u32> m_indexW{0};
     std::atomic<u32> m_indexR{0};
@@ -84,6 +91,9 @@ private:
     std::atomic<s32> m_RVolume{256};
     float m_numLeftI = 0.0f;
     u32 m_frac = 0;
+    // Target FIFO level of the low latency mode, in input samples (0 until first used).
+    float m_adaptive_watermark = 0.0f;
+    u32 m_samples_since_underrun = 0;
   };
 
   MixerFifo m_dma_mixer{this, 32000};
@@ -13,6 +13,7 @@
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Common/Thread.h"
+#include "Common/ThreadPlacement.h"
 #include "Core/ConfigManager.h"
 
 static HMODULE s_openal_dll = nullptr;
@@ -217,6 +218,7 @@ static bool IsCreativeXFi()
 void OpenALStream::SoundLoop()
 {
   Common::SetCurrentThreadName("Audio thread - openal");
+  Common::PlaceCurrentThread(Common::ThreadRole::Helper);
 
   bool float32_capable = palIsExtensionPresent("AL_EXT_float32") != 0;
   bool surround_capable = palIsExtensionPresent("AL_EXT_MCFORMATS") || IsCreativeXFi();
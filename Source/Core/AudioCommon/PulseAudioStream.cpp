@@ -8,6 +8,7 @@
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/Thread.h"
+#include "Common/ThreadPlacement.h"
 #include "Core/ConfigManager.h"
 
 namespace
@@ -47,6 +48,7 @@ void PulseAudio::Update()
 void PulseAudio::SoundLoop()
 {
   Common::SetCurrentThreadName("Audio thread - pulse");
+  Common::PlaceCurrentThread(Common::ThreadRole::Helper);
 
   if (PulseInit())
   {
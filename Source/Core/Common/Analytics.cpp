@@ -4,7 +4,9 @@
 
 #include <cmath>
 #include <cstdio>
+#include <functional>
 #include <string>
+#include <utility>
 
 #include "Common/Analytics.h"
 #include "Common/CommonTypes.h"
@@ -141,6 +143,19 @@ AnalyticsReporter::~AnalyticsReporter()
 void AnalyticsReporter::Send(AnalyticsReportBuilder&& report)
 {
 #if defined(USE_ANALYTICS) && USE_ANALYTICS
+  Enqueue([serialized = report.Consume()]() mutable { return std::move(serialized); });
+#endif
+}
+
+void AnalyticsReporter::SendDeferred(ReportFunction make_report)
+{
+#if defined(USE_ANALYTICS) && USE_ANALYTICS
+  Enqueue([make_report = std::move(make_report)] { return make_report().Consume(); });
+#endif
+}
+
+void AnalyticsReporter::Enqueue(std::function<std::string()> report)
+{
   // Put a bound on the size of the queue to avoid uncontrolled memory growth.
 #if defined(_MSC_VER) && _MSC_VER <= 1800
   const u32 QUEUE_SIZE_LIMIT = 25;
@@ -149,15 +164,17 @@ void AnalyticsReporter::Send(AnalyticsReportBuilder&& report)
 #endif
   if (m_reports_queue.Size() < QUEUE_SIZE_LIMIT)
   {
-    m_reports_queue.Push(report.Consume());
+    m_reports_queue.Push(std::move(report));
     m_reporter_event.Set();
   }
-#endif
 }
 
 void AnalyticsReporter::ThreadProc()
 {
   Common::SetCurrentThreadName("Analytics");
+  // Reports have no deadline, so building and uploading them shouldn't take time from emulation
+  // or from the shader compiler threads.
+  Common::SetCurrentThreadLowPriority();
   while (true)
   {
     m_reporter_event.Wait();
@@ -175,9 +192,9 @@ void AnalyticsReporter::ThreadProc()
 
       if (backend)
       {
-        std::string report;
+        std::function<std::string()> report;
         m_reports_queue.Pop(report);
-        backend->Send(std::move(report));
+        backend->Send(report());
       }
       else
       {
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <chrono>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -148,8 +149,16 @@ public:
 
   // For convenience.
   void Send(AnalyticsReportBuilder& report) { Send(std::move(report)); }
+
+  // Enqueues a report that is built on the reporter thread when it gets to it, so that the caller
+  // doesn't wait for it to be serialized. The function must only use data that it owns or that
+  // stays valid and isn't modified for as long as the reporter exists.
+  using ReportFunction = std::function<AnalyticsReportBuilder()>;
+  void SendDeferred(ReportFunction make_report);
+
 protected:
   void ThreadProc();
+  void Enqueue(std::function<std::string()> report);
 
   std::shared_ptr<AnalyticsReportingBackend> m_backend;
   AnalyticsReportBuilder m_base_builder;
@@ -157,7 +166,8 @@ protected:
   std::thread m_reporter_thread;
   Common::Event m_reporter_event, m_reporter_finished_event;
   Common::Flag m_reporter_stop_request;
-  FifoQueue<std::string> m_reports_queue;
+  // Produce the serialized reports, once there is a backend.
+  FifoQueue<std::function<std::string()>> m_reports_queue;
 };
 
 // Analytics backend to be used for debugging purpose, which dumps reports to
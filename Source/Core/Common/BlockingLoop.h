@@ -4,12 +4,15 @@
 
 #pragma once
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <mutex>
 #include <thread>
 
 #include "Common/Event.h"
 #include "Common/Flag.h"
+#include "Common/Thread.h"
 
 namespace Common
 {
@@ -65,7 +68,8 @@ public:
     // Wait for the worker thread to finish.
     while (!IsDone())
     {
-      m_done_event.Wait();
+      if (!SpinUntil(std::chrono::microseconds(WAIT_SPIN_US), [this] { return IsDone(); }))
+        m_done_event.Wait();
     }
 
     // As we wanted to wait for the other thread, there is likely no work remaining.
@@ -175,6 +179,21 @@ public:
         }
 
       case STATE_SLEEPING:
+        // New work usually arrives within a few microseconds, much sooner than a parked thread
+        // can be woken up again. So spin a little first, and adapt the spin time to whether
+        // this paid off the last time.
+        if (SpinUntil(m_sleep_spin_time, [this] {
+              return m_running_state.load() != STATE_SLEEPING || m_shutdown.IsSet();
+            }))
+        {
+          m_sleep_spin_time =
+              std::min(m_sleep_spin_time * 2, std::chrono::microseconds(MAX_SLEEP_SPIN_US));
+          m_new_work_event.Reset();
+          break;
+        }
+        m_sleep_spin_time =
+            std::max(m_sleep_spin_time / 2, std::chrono::microseconds(MIN_SLEEP_SPIN_US));
+
         // Just relax
         if (timeout > 0)
         {
@@ -231,6 +250,28 @@ public:
   // that we will fall back from the busy loop to sleeping.
   void AllowSleep() { m_may_sleep.Set(); }
 private:
+  // Spin times in microseconds.
+  enum : int
+  {
+    WAIT_SPIN_US = 20,
+    MIN_SLEEP_SPIN_US = 2,
+    MAX_SLEEP_SPIN_US = 100,
+  };
+
+  // Yields until pred() is true or spin_time has passed, returns the final value of pred().
+  template <class Pred>
+  static bool SpinUntil(std::chrono::microseconds spin_time, Pred pred)
+  {
+    const auto end = std::chrono::steady_clock::now() + spin_time;
+    while (!pred())
+    {
+      if (std::chrono::steady_clock::now() >= end)
+        return false;
+      YieldCPU();
+    }
+    return true;
+  }
+
   std::mutex m_wait_lock;
   std::mutex m_prepare_lock;
 
@@ -251,5 +292,8 @@ private:
 
   Flag m_may_sleep;  // If this is set, we fall back from the busy loop to an event based
                      // synchronization.
+
+  // Only accessed by the thread in Run().
+  std::chrono::microseconds m_sleep_spin_time{MIN_SLEEP_SPIN_US};
 };
 }
@@ -6,6 +6,9 @@
 #pragma once
 
 #include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
 
 enum CPUVendor
 {
@@ -29,6 +32,14 @@ struct CPUInfo
   int num_cores = 0;
   int logical_cpu_count = 0;
 
+  // The processor topology, as affinity masks of logical processors (so only the first 32 are
+  // covered). There is one mask per physical core and one per last level cache. On CPUs with
+  // several classes of cores, performance_core_mask only has the fastest ones. All of these are
+  // empty when the OS doesn't tell.
+  std::vector<u32> core_masks;
+  std::vector<u32> cache_masks;
+  u32 performance_core_mask = 0;
+
   bool bSSE = false;
   bool bSSE2 = false;
   bool bSSE3 = false;
@@ -71,6 +82,8 @@ struct CPUInfo
 private:
   // Detects the various CPU features
   void Detect();
+  // Fills in the topology from what the OS reports. Implemented in CPUTopology.cpp.
+  void DetectTopology();
 };
 
 extern CPUInfo cpu_info;
@@ -0,0 +1,164 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(__linux__)
+#include <fstream>
+#include <sstream>
+#endif
+
+#include "Common/CPUDetect.h"
+#include "Common/CommonTypes.h"
+
+// Affinity masks only cover this many logical processors.
+constexpr u32 MAX_LOGICAL_CPUS = 32;
+
+static void AddMask(std::vector<u32>* masks, u32 mask)
+{
+  if (mask != 0 && std::find(masks->begin(), masks->end(), mask) == masks->end())
+    masks->push_back(mask);
+}
+
+#ifdef _WIN32
+
+void CPUInfo::DetectTopology()
+{
+  DWORD size = 0;
+  GetLogicalProcessorInformationEx(RelationAll, nullptr, &size);
+  if (GetLastError() != ERROR_INSUFFICIENT_BUFFER)
+    return;
+
+  std::vector<u8> buffer(size);
+  if (!GetLogicalProcessorInformationEx(
+          RelationAll, reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buffer.data()),
+          &size))
+  {
+    return;
+  }
+
+  // Only the first processor group is covered, like everything else that uses affinity masks.
+  std::vector<std::pair<u32, BYTE>> cores;
+  BYTE fastest_class = 0;
+  for (DWORD offset = 0; offset < size;)
+  {
+    const auto* info =
+        reinterpret_cast<const SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buffer.data() + offset);
+    offset += info->Size;
+
+    if (info->Relationship == RelationProcessorCore && info->Processor.GroupMask[0].Group == 0)
+    {
+      const u32 mask = static_cast<u32>(info->Processor.GroupMask[0].Mask);
+      cores.emplace_back(mask, info->Processor.EfficiencyClass);
+      fastest_class = std::max(fastest_class, info->Processor.EfficiencyClass);
+      AddMask(&core_masks, mask);
+    }
+    else if (info->Relationship == RelationCache && info->Cache.Level == 3 &&
+             info->Cache.GroupMask.Group == 0)
+    {
+      AddMask(&cache_masks, static_cast<u32>(info->Cache.GroupMask.Mask));
+    }
+  }
+
+  for (const auto& core : cores)
+  {
+    if (core.second == fastest_class)
+      performance_core_mask |= core.first;
+  }
+}
+
+#elif defined(__linux__)
+
+// Parses a list of processors like "0-3,8,10-11" from sysfs.
+static u32 ReadCPUList(const std::string& path)
+{
+  std::ifstream file(path);
+  std::string list;
+  if (!std::getline(file, list))
+    return 0;
+
+  u32 mask = 0;
+  std::istringstream stream(list);
+  std::string range;
+  while (std::getline(stream, range, ','))
+  {
+    u32 first, last;
+    const int count = std::sscanf(range.c_str(), "%u-%u", &first, &last);
+    if (count < 1)
+      continue;
+    if (count == 1)
+      last = first;
+    for (u32 cpu = first; cpu <= last && cpu < MAX_LOGICAL_CPUS; cpu++)
+      mask |= 1u << cpu;
+  }
+  return mask;
+}
+
+static u64 ReadNumber(const std::string& path)
+{
+  std::ifstream file(path);
+  u64 value = 0;
+  file >> value;
+  return value;
+}
+
+void CPUInfo::DetectTopology()
+{
+  // The speed of a core is its capacity where the kernel knows it (ARM), otherwise its maximum
+  // frequency. Cores that are much slower than the fastest one are efficiency cores.
+  std::vector<std::pair<u32, u64>> cpu_speeds;
+  u64 fastest = 0;
+  for (u32 cpu = 0; cpu < MAX_LOGICAL_CPUS; cpu++)
+  {
+    const std::string dir = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+    const u32 siblings = ReadCPUList(dir + "/topology/thread_siblings_list");
+    if (siblings == 0)
+      continue;
+    AddMask(&core_masks, siblings);
+
+    // The highest cache level shared by this processor.
+    u32 cache_mask = 0;
+    u64 cache_level = 0;
+    for (u32 index = 0;; index++)
+    {
+      const std::string cache_dir = dir + "/cache/index" + std::to_string(index);
+      const u64 level = ReadNumber(cache_dir + "/level");
+      if (level == 0)
+        break;
+      if (level >= cache_level)
+      {
+        cache_level = level;
+        cache_mask = ReadCPUList(cache_dir + "/shared_cpu_list");
+      }
+    }
+    if (cache_level >= 3)
+      AddMask(&cache_masks, cache_mask);
+
+    u64 speed = ReadNumber(dir + "/cpu_capacity");
+    if (speed == 0)
+      speed = ReadNumber(dir + "/cpufreq/cpuinfo_max_freq");
+    cpu_speeds.emplace_back(cpu, speed);
+    fastest = std::max(fastest, speed);
+  }
+
+  // Boost clocks differ a little between the cores of many CPUs which only have one kind.
+  for (const auto& cpu : cpu_speeds)
+  {
+    if (cpu.second >= fastest * 4 / 5)
+      performance_core_mask |= 1u << cpu.first;
+  }
+}
+
+#else
+
+void CPUInfo::DetectTopology()
+{
+}
+
+#endif
@@ -13,6 +13,7 @@
 // - Zero backwards/forwards compatibility
 // - Serialization code for anything complex has to be manually written.
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <cstring>
@@ -70,6 +71,34 @@ public:
 
 public:
   PointerWrap(u8** ptr_, Mode mode_) : ptr(ptr_), mode(mode_) {}
+
+  // Writes to buffer, which grows as needed, so that a state can be saved without a MODE_MEASURE
+  // pass to size the buffer first. The current size of buffer is reused. FinishWrite() trims it.
+  explicit PointerWrap(std::vector<u8>* buffer)
+      : ptr(&m_write_ptr), mode(MODE_WRITE), m_buffer(buffer)
+  {
+    if (m_buffer->size() < INITIAL_BUFFER_SIZE)
+      m_buffer->resize(INITIAL_BUFFER_SIZE);
+    m_write_ptr = m_buffer->data();
+    m_buffer_end = m_write_ptr + m_buffer->size();
+  }
+
+  PointerWrap(const PointerWrap&) = delete;
+  PointerWrap& operator=(const PointerWrap&) = delete;
+
+  // Resizes the buffer of a growing writer to what was written. Returns false, leaving the buffer
+  // empty, if the mode was changed to abort the save.
+  bool FinishWrite()
+  {
+    if (mode != MODE_WRITE)
+    {
+      m_buffer->clear();
+      return false;
+    }
+    m_buffer->resize(m_write_ptr - m_buffer->data());
+    return true;
+  }
+
   void SetMode(Mode mode_) { mode = mode_; }
   Mode GetMode() const { return mode; }
   template <typename K, class V>
@@ -133,7 +162,7 @@ public:
   template <typename T>
   void Do(std::vector<T>& x)
   {
-    DoContainer(x);
+    DoContiguousContainer(x);
   }
 
   template <typename T>
@@ -151,7 +180,7 @@ public:
   template <typename T>
   void Do(std::basic_string<T>& x)
   {
-    DoContainer(x);
+    DoContiguousContainer(x);
   }
 
   template <typename T, typename U>
@@ -214,6 +243,13 @@ public:
     DoVoid((void*)&x, sizeof(x));
   }
 
+  // Like DoPOD, for count consecutive elements at once.
+  template <typename T>
+  void DoPODArray(T* x, u32 count)
+  {
+    DoVoid((void*)x, count * sizeof(T));
+  }
+
   void Do(bool& x)
   {
     // bool's size can vary depending on platform, which can
@@ -266,12 +302,49 @@ public:
   }
 
 private:
+  static constexpr size_t INITIAL_BUFFER_SIZE = 1024 * 1024;
+
   template <typename T>
   void DoContainer(T& x)
   {
     DoEachElement(x, [](PointerWrap& p, typename T::value_type& elem) { p.Do(elem); });
   }
 
+  // Elements which Do() stores as their bytes are stored in one go, in the same format.
+  template <typename T>
+  void DoContiguousContainer(T& x)
+  {
+    using Element = typename T::value_type;
+    constexpr bool stored_as_bytes =
+        std::is_trivially_copyable<Element>::value && !std::is_same<Element, bool>::value;
+    DoContiguousContainer(x, std::integral_constant<bool, stored_as_bytes>());
+  }
+
+  template <typename T>
+  void DoContiguousContainer(T& x, std::false_type)
+  {
+    DoContainer(x);
+  }
+
+  template <typename T>
+  void DoContiguousContainer(T& x, std::true_type)
+  {
+    u32 size = static_cast<u32>(x.size());
+    Do(size);
+    x.resize(size);
+    if (size != 0)
+      DoArray(&x[0], size);
+  }
+
+  // Grows the buffer of a growing writer to fit size more bytes.
+  void GrowBuffer(u32 size)
+  {
+    const size_t offset = m_write_ptr - m_buffer->data();
+    m_buffer->resize(std::max(offset + size, m_buffer->size() * 2));
+    m_write_ptr = m_buffer->data() + offset;
+    m_buffer_end = m_buffer->data() + m_buffer->size();
+  }
+
   __forceinline void DoVoid(void* data, u32 size)
   {
     switch (mode)
@@ -281,6 +354,8 @@ private:
       break;
 
     case MODE_WRITE:
+      if (m_buffer && size > static_cast<size_t>(m_buffer_end - *ptr))
+        GrowBuffer(size);
       memcpy(*ptr, data, size);
       break;
 
@@ -296,4 +371,8 @@ private:
 
     *ptr += size;
   }
+
+  std::vector<u8>* m_buffer = nullptr;
+  u8* m_write_ptr = nullptr;
+  u8* m_buffer_end = nullptr;
 };
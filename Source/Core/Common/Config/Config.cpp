@@ -3,6 +3,8 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <list>
 #include <map>
 #include <tuple>
@@ -15,6 +17,7 @@ namespace Config
 {
 static Layers s_layers;
 static std::list<ConfigChangedCallback> s_callbacks;
+static std::atomic<u32> s_config_version{1};
 
 void InvokeConfigChangedCallbacks();
 
@@ -51,6 +54,18 @@ bool LayerExists(LayerType layer)
   return s_layers.find(layer) != s_layers.end();
 }
 
+u32 GetConfigVersion()
+{
+  return s_config_version.load(std::memory_order_acquire);
+}
+
+void IncreaseConfigVersion()
+{
+  // Skip 0 when wrapping around, as it marks empty caches
+  if (s_config_version.fetch_add(1, std::memory_order_acq_rel) == UINT32_MAX)
+    s_config_version.fetch_add(1, std::memory_order_acq_rel);
+}
+
 void AddConfigChangedCallback(ConfigChangedCallback func)
 {
   s_callbacks.emplace_back(func);
@@ -58,6 +73,7 @@ void AddConfigChangedCallback(ConfigChangedCallback func)
 
 void InvokeConfigChangedCallbacks()
 {
+  IncreaseConfigVersion();
   for (const auto& callback : s_callbacks)
     callback();
 }
@@ -85,16 +101,19 @@ void Shutdown()
 {
   s_layers.clear();
   s_callbacks.clear();
+  IncreaseConfigVersion();
 }
 
 void ClearCurrentRunLayer()
 {
   s_layers[LayerType::CurrentRun] = std::make_unique<Layer>(LayerType::CurrentRun);
+  IncreaseConfigVersion();
 }
 
 void CreateVRGameLayer()
 {
   s_layers[LayerType::VRGame] = std::make_unique<Layer>(LayerType::VRGame);
+  IncreaseConfigVersion();
 }
 
 bool OverrideSectionWithSection(const std::string& sectionName, const std::string& sectionName2)
@@ -57,7 +57,21 @@ T Get(LayerType layer, const ConfigInfo<T>& info)
 template <typename T>
 T Get(const ConfigInfo<T>& info)
 {
-  return GetLayer(GetActiveLayerForConfig(info.location))->Get(info);
+  if constexpr (detail::CachedValue<T>::IS_CACHED)
+  {
+    // Read before the layers, so that a change in between makes the cached value outdated.
+    const u32 version = GetConfigVersion();
+    T value;
+    if (info.cached_value.Load(version, &value))
+      return value;
+    value = GetLayer(GetActiveLayerForConfig(info.location))->Get(info);
+    info.cached_value.Store(version, value);
+    return value;
+  }
+  else
+  {
+    return GetLayer(GetActiveLayerForConfig(info.location))->Get(info);
+  }
 }
 
 template <typename T>
@@ -4,12 +4,70 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstring>
 #include <string>
+#include <type_traits>
 
+#include "Common/CommonTypes.h"
 #include "Common/Config/Enums.h"
 
 namespace Config
 {
+// Increased whenever a value of any layer changes, or a layer is added or removed. Never 0.
+u32 GetConfigVersion();
+void IncreaseConfigVersion();
+
+namespace detail
+{
+// The value of a ConfigInfo as of a config version. Only values which fit in the same atomic
+// word as the version are cached, so that any thread can read and update the cache.
+template <typename T, typename = void>
+class CachedValue
+{
+public:
+  static constexpr bool IS_CACHED = false;
+};
+
+template <typename T>
+class CachedValue<T, std::enable_if_t<std::is_trivially_copyable<T>::value &&
+                                      sizeof(T) <= sizeof(u32)>>
+{
+public:
+  static constexpr bool IS_CACHED = true;
+
+  CachedValue() = default;
+  // A copy starts out empty, instead of copying the cache non-atomically.
+  CachedValue(const CachedValue&) {}
+  CachedValue& operator=(const CachedValue&)
+  {
+    m_word.store(0, std::memory_order_relaxed);
+    return *this;
+  }
+
+  bool Load(u32 version, T* value) const
+  {
+    const u64 word = m_word.load(std::memory_order_relaxed);
+    if (static_cast<u32>(word >> 32) != version)
+      return false;
+    const u32 bits = static_cast<u32>(word);
+    std::memcpy(value, &bits, sizeof(T));
+    return true;
+  }
+
+  void Store(u32 version, const T& value) const
+  {
+    u32 bits = 0;
+    std::memcpy(&bits, &value, sizeof(T));
+    m_word.store(static_cast<u64>(version) << 32 | bits, std::memory_order_relaxed);
+  }
+
+private:
+  // Version in the upper half, value in the lower half. Version 0 means empty.
+  mutable std::atomic<u64> m_word{0};
+};
+}
+
 struct ConfigLocation
 {
   System system;
@@ -26,5 +84,7 @@ struct ConfigInfo
 {
   ConfigLocation location;
   T default_value;
+  // Result of the last Config::Get(info).
+  detail::CachedValue<T> cached_value;
 };
 }
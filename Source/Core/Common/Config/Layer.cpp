@@ -89,6 +89,7 @@ bool Layer::DeleteKey(const ConfigLocation& location)
   m_is_dirty = true;
   bool had_value = m_map[location].has_value();
   m_map[location].reset();
+  IncreaseConfigVersion();
   return had_value;
 }
 
@@ -104,6 +105,7 @@ void Layer::DeleteAllKeys()
   {
     pair.second.reset();
   }
+  IncreaseConfigVersion();
 }
 
 Section Layer::GetSection(System system, const std::string& section)
@@ -133,6 +133,7 @@ public:
       return;
     m_is_dirty = true;
     current_value = new_value;
+    IncreaseConfigVersion();
   }
 
   Section GetSection(System system, const std::string& section);
@@ -142,7 +143,11 @@ public:
   void Load();
   void Save();
 
-  void Clear() { m_map.clear(); }
+  void Clear()
+  {
+    m_map.clear();
+    IncreaseConfigVersion();
+  }
 
   LayerType GetLayer() const;
   const LayerMap& GetLayerMap() const;
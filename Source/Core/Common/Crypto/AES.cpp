@@ -2,9 +2,19 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <array>
+#include <cstring>
+#include <memory>
+
 #include <mbedtls/aes.h>
 
+#include "Common/CPUDetect.h"
 #include "Common/Crypto/AES.h"
+#include "Common/Intrinsics.h"
+
+#if defined(_M_ARM_64) && defined(__ARM_FEATURE_CRYPTO)
+#include <arm_neon.h>
+#endif
 
 namespace Common
 {
@@ -35,5 +45,162 @@ std::vector<u8> Encrypt(const u8* key, u8* iv, const u8* src, size_t size)
 {
   return DecryptEncrypt(key, iv, src, size, Mode::Encrypt);
 }
+
+namespace
+{
+constexpr size_t BLOCK_SIZE = 16;
+constexpr int NUM_ROUNDS = 10;
+
+class ContextGeneric final : public Context
+{
+public:
+  explicit ContextGeneric(const u8* key) { mbedtls_aes_setkey_dec(&m_ctx, key, 128); }
+
+  void DecryptCBC(const u8* iv, const u8* src, u8* dst, size_t size) const override
+  {
+    std::array<u8, BLOCK_SIZE> iv_copy;
+    std::memcpy(iv_copy.data(), iv, BLOCK_SIZE);
+    // mbedtls does not modify the context when crypting, it is only non-const in its API.
+    mbedtls_aes_crypt_cbc(const_cast<mbedtls_aes_context*>(&m_ctx), MBEDTLS_AES_DECRYPT, size,
+                          iv_copy.data(), src, dst);
+  }
+
+private:
+  mbedtls_aes_context m_ctx;
+};
+
+// Gets the standard AES-128 encryption key schedule, as the bytes of the 11 round keys.
+std::array<std::array<u8, BLOCK_SIZE>, NUM_ROUNDS + 1> ExpandKey(const u8* key)
+{
+  mbedtls_aes_context ctx;
+  mbedtls_aes_setkey_enc(&ctx, key, 128);
+
+  // Both the software and the AES-NI key setup of mbedtls store the round keys in byte order
+  // (the software one as little endian words, which only matches on little endian hosts).
+  std::array<std::array<u8, BLOCK_SIZE>, NUM_ROUNDS + 1> round_keys;
+  std::memcpy(round_keys.data(), ctx.rk, sizeof(round_keys));
+  return round_keys;
+}
+
+#if defined(_M_X86_64)
+// Decrypting CBC is not serial like encrypting it, so several blocks are kept in flight to hide
+// the latency of AESDEC.
+class ContextAESNI final : public Context
+{
+public:
+  explicit ContextAESNI(const u8* key) { Init(key); }
+
+  FUNCTION_TARGET_AES
+  void DecryptCBC(const u8* iv, const u8* src, u8* dst, size_t size) const override
+  {
+    constexpr size_t PARALLEL_BLOCKS = 4;
+
+    __m128i prev = _mm_loadu_si128(reinterpret_cast<const __m128i*>(iv));
+    size_t num_blocks = size / BLOCK_SIZE;
+    const __m128i* in = reinterpret_cast<const __m128i*>(src);
+    __m128i* out = reinterpret_cast<__m128i*>(dst);
+
+    for (; num_blocks >= PARALLEL_BLOCKS; num_blocks -= PARALLEL_BLOCKS)
+    {
+      __m128i c[PARALLEL_BLOCKS];
+      __m128i x[PARALLEL_BLOCKS];
+      for (size_t i = 0; i < PARALLEL_BLOCKS; i++)
+      {
+        c[i] = _mm_loadu_si128(in + i);
+        x[i] = _mm_xor_si128(c[i], m_round_keys[0]);
+      }
+      for (int round = 1; round < NUM_ROUNDS; round++)
+      {
+        for (size_t i = 0; i < PARALLEL_BLOCKS; i++)
+          x[i] = _mm_aesdec_si128(x[i], m_round_keys[round]);
+      }
+      for (size_t i = 0; i < PARALLEL_BLOCKS; i++)
+      {
+        x[i] = _mm_aesdeclast_si128(x[i], m_round_keys[NUM_ROUNDS]);
+        _mm_storeu_si128(out + i, _mm_xor_si128(x[i], i == 0 ? prev : c[i - 1]));
+      }
+      prev = c[PARALLEL_BLOCKS - 1];
+      in += PARALLEL_BLOCKS;
+      out += PARALLEL_BLOCKS;
+    }
+
+    for (; num_blocks > 0; num_blocks--)
+    {
+      const __m128i c = _mm_loadu_si128(in++);
+      __m128i x = _mm_xor_si128(c, m_round_keys[0]);
+      for (int round = 1; round < NUM_ROUNDS; round++)
+        x = _mm_aesdec_si128(x, m_round_keys[round]);
+      x = _mm_aesdeclast_si128(x, m_round_keys[NUM_ROUNDS]);
+      _mm_storeu_si128(out++, _mm_xor_si128(x, prev));
+      prev = c;
+    }
+  }
+
+private:
+  FUNCTION_TARGET_AES
+  void Init(const u8* key)
+  {
+    // AESDEC expects the round keys of the equivalent inverse cipher: the encryption round keys
+    // in reverse order, with InvMixColumns applied to all but the first and the last.
+    const auto enc_keys = ExpandKey(key);
+    for (int round = 0; round <= NUM_ROUNDS; round++)
+    {
+      const __m128i k =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(enc_keys[NUM_ROUNDS - round].data()));
+      m_round_keys[round] = (round == 0 || round == NUM_ROUNDS) ? k : _mm_aesimc_si128(k);
+    }
+  }
+
+  __m128i m_round_keys[NUM_ROUNDS + 1];
+};
+#elif defined(_M_ARM_64) && defined(__ARM_FEATURE_CRYPTO)
+class ContextARMv8 final : public Context
+{
+public:
+  explicit ContextARMv8(const u8* key)
+  {
+    // AESD and AESIMC implement the equivalent inverse cipher, see ContextAESNI::Init.
+    const auto enc_keys = ExpandKey(key);
+    for (int round = 0; round <= NUM_ROUNDS; round++)
+    {
+      const uint8x16_t k = vld1q_u8(enc_keys[NUM_ROUNDS - round].data());
+      m_round_keys[round] = (round == 0 || round == NUM_ROUNDS) ? k : vaesimcq_u8(k);
+    }
+  }
+
+  void DecryptCBC(const u8* iv, const u8* src, u8* dst, size_t size) const override
+  {
+    uint8x16_t prev = vld1q_u8(iv);
+    for (size_t offset = 0; offset < size; offset += BLOCK_SIZE)
+    {
+      const uint8x16_t c = vld1q_u8(src + offset);
+      uint8x16_t x = c;
+      // AESD includes the round key addition that precedes each round.
+      for (int round = 0; round < NUM_ROUNDS - 1; round++)
+        x = vaesimcq_u8(vaesdq_u8(x, m_round_keys[round]));
+      x = vaesdq_u8(x, m_round_keys[NUM_ROUNDS - 1]);
+      x = veorq_u8(x, m_round_keys[NUM_ROUNDS]);
+      vst1q_u8(dst + offset, veorq_u8(x, prev));
+      prev = c;
+    }
+  }
+
+private:
+  uint8x16_t m_round_keys[NUM_ROUNDS + 1];
+};
+#endif
+}  // namespace
+
+std::unique_ptr<Context> CreateContextDecrypt(const u8* key)
+{
+#if defined(_M_X86_64)
+  if (cpu_info.bAES)
+    return std::make_unique<ContextAESNI>(key);
+#elif defined(_M_ARM_64) && defined(__ARM_FEATURE_CRYPTO)
+  if (cpu_info.bAES)
+    return std::make_unique<ContextARMv8>(key);
+#endif
+  return std::make_unique<ContextGeneric>(key);
+}
 }  // namespace AES
 }  // namespace Common
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <cstddef>
+#include <memory>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -23,5 +24,17 @@ std::vector<u8> DecryptEncrypt(const u8* key, u8* iv, const u8* src, size_t size
 // Convenience functions
 std::vector<u8> Decrypt(const u8* key, u8* iv, const u8* src, size_t size);
 std::vector<u8> Encrypt(const u8* key, u8* iv, const u8* src, size_t size);
+
+// A reusable AES-128-CBC decryption key. Uses the AES instructions of the host CPU if available.
+class Context
+{
+public:
+  virtual ~Context() = default;
+
+  // size must be a multiple of 16. The IV is not modified, and src may be the same as dst.
+  virtual void DecryptCBC(const u8* iv, const u8* src, u8* dst, size_t size) const = 0;
+};
+
+std::unique_ptr<Context> CreateContextDecrypt(const u8* key);
 }  // namespace AES
 }  // namespace Common
@@ -426,8 +426,26 @@ FSTEntry ScanDirectoryTree(const std::string& directory, bool recursive)
       continue;
     auto physical_name = directory + DIR_SEP + virtual_name;
     FSTEntry entry;
+#ifdef _WIN32
+    // The search already returned the attributes and size, which saves a stat of every file.
+    // Only reparse points need one, as stat follows them but the search doesn't.
+    u64 file_size;
+    if (ffd.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT)
+    {
+      const FileInfo file_info(physical_name);
+      entry.isDirectory = file_info.IsDirectory();
+      file_size = file_info.GetSize();
+    }
+    else
+    {
+      entry.isDirectory = (ffd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+      file_size = (static_cast<u64>(ffd.nFileSizeHigh) << 32) | ffd.nFileSizeLow;
+    }
+#else
     const FileInfo file_info(physical_name);
     entry.isDirectory = file_info.IsDirectory();
+    const u64 file_size = file_info.GetSize();
+#endif
     if (entry.isDirectory)
     {
       if (recursive)
@@ -438,14 +456,14 @@ FSTEntry ScanDirectoryTree(const std::string& directory, bool recursive)
     }
     else
     {
-      entry.size = file_info.GetSize();
+      entry.size = file_size;
     }
     entry.virtualName = virtual_name;
-    entry.physicalName = physical_name;
+    entry.physicalName = std::move(physical_name);
 
     ++parent_entry.size;
     // Push into the tree
-    parent_entry.children.push_back(entry);
+    parent_entry.children.push_back(std::move(entry));
 #ifdef _WIN32
   } while (FindNextFile(hFind, &ffd) != 0);
   FindClose(hFind);
@@ -760,6 +778,7 @@ static void RebuildUserDirectories(unsigned int dir_index)
         s_user_paths[D_MEMORYWATCHER_IDX] + MEMORYWATCHER_LOCATIONS;
     s_user_paths[F_MEMORYWATCHERSOCKET_IDX] =
         s_user_paths[D_MEMORYWATCHER_IDX] + MEMORYWATCHER_SOCKET;
+    s_user_paths[F_MEMORYWATCHERRING_IDX] = s_user_paths[D_MEMORYWATCHER_IDX] + MEMORYWATCHER_RING;
 
     // The shader cache has moved to the cache directory, so remove the old one.
     // TODO: remove that someday.
@@ -898,6 +898,11 @@ PFNDOLTEXIMAGE3DMULTISAMPLEPROC dolTexImage3DMultisample;
 PFNDOLGETMULTISAMPLEFVPROC dolGetMultisamplefv;
 PFNDOLSAMPLEMASKIPROC dolSampleMaski;
 
+// ARB_timer_query
+PFNDOLQUERYCOUNTERPROC dolQueryCounter;
+PFNDOLGETQUERYOBJECTI64VPROC dolGetQueryObjecti64v;
+PFNDOLGETQUERYOBJECTUI64VPROC dolGetQueryObjectui64v;
+
 // ARB_texture_storage
 PFNDOLTEXSTORAGE1DPROC dolTexStorage1D;
 PFNDOLTEXSTORAGE2DPROC dolTexStorage2D;
@@ -914,10 +919,18 @@ PFNDOLGETSHADERPRECISIONFORMATPROC dolGetShaderPrecisionFormat;
 PFNDOLRELEASESHADERCOMPILERPROC dolReleaseShaderCompiler;
 PFNDOLSHADERBINARYPROC dolShaderBinary;
 
+// KHR_parallel_shader_compile
+PFNDOLMAXSHADERCOMPILERTHREADSPROC dolMaxShaderCompilerThreads;
+
 // NV_primitive_restart
 PFNDOLPRIMITIVERESTARTINDEXNVPROC dolPrimitiveRestartIndexNV;
 PFNDOLPRIMITIVERESTARTNVPROC dolPrimitiveRestartNV;
 
+// NV_shading_rate_image
+PFNDOLBINDSHADINGRATEIMAGENVPROC dolBindShadingRateImageNV;
+PFNDOLSHADINGRATEIMAGEPALETTENVPROC dolShadingRateImagePaletteNV;
+PFNDOLSHADINGRATEIMAGEBARRIERNVPROC dolShadingRateImageBarrierNV;
+
 // ARB_blend_func_extended
 PFNDOLBINDFRAGDATALOCATIONINDEXEDPROC dolBindFragDataLocationIndexed;
 PFNDOLGETFRAGDATAINDEXPROC dolGetFragDataIndex;
@@ -1687,6 +1700,11 @@ const GLFunc gl_function_array[] = {
     GLFUNC_REQUIRES(glGetMultisamplefv, "GL_ARB_texture_multisample"),
     GLFUNC_REQUIRES(glSampleMaski, "GL_ARB_texture_multisample"),
 
+    // ARB_timer_query
+    GLFUNC_REQUIRES(glQueryCounter, "GL_ARB_timer_query"),
+    GLFUNC_REQUIRES(glGetQueryObjecti64v, "GL_ARB_timer_query"),
+    GLFUNC_REQUIRES(glGetQueryObjectui64v, "GL_ARB_timer_query"),
+
     // ARB_texture_storage
     GLFUNC_REQUIRES(glTexStorage1D, "GL_ARB_texture_storage !VERSION_4_2"),
     GLFUNC_REQUIRES(glTexStorage2D, "GL_ARB_texture_storage !VERSION_4_2 |VERSION_GLES_3"),
@@ -1707,10 +1725,20 @@ const GLFunc gl_function_array[] = {
     GLFUNC_REQUIRES(glReleaseShaderCompiler, "GL_ARB_ES2_compatibility |VERSION_GLES_2"),
     GLFUNC_REQUIRES(glShaderBinary, "GL_ARB_ES2_compatibility |VERSION_GLES_2"),
 
+    // KHR_parallel_shader_compile
+    GLFUNC_SUFFIX(glMaxShaderCompilerThreads, KHR, "GL_KHR_parallel_shader_compile"),
+    GLFUNC_SUFFIX(glMaxShaderCompilerThreads, ARB,
+                  "GL_ARB_parallel_shader_compile !GL_KHR_parallel_shader_compile"),
+
     // NV_primitive_restart
     GLFUNC_REQUIRES(glPrimitiveRestartIndexNV, "GL_NV_primitive_restart"),
     GLFUNC_REQUIRES(glPrimitiveRestartNV, "GL_NV_primitive_restart"),
 
+    // NV_shading_rate_image
+    GLFUNC_REQUIRES(glBindShadingRateImageNV, "GL_NV_shading_rate_image"),
+    GLFUNC_REQUIRES(glShadingRateImagePaletteNV, "GL_NV_shading_rate_image"),
+    GLFUNC_REQUIRES(glShadingRateImageBarrierNV, "GL_NV_shading_rate_image"),
+
     // ARB_blend_func_extended
     GLFUNC_REQUIRES(glBindFragDataLocationIndexed, "GL_ARB_blend_func_extended"),
     GLFUNC_REQUIRES(glGetFragDataIndex, "GL_ARB_blend_func_extended"),
@@ -16,6 +16,7 @@
 #include "Common/GL/GLExtensions/ARB_copy_image.h"
 #include "Common/GL/GLExtensions/ARB_debug_output.h"
 #include "Common/GL/GLExtensions/ARB_draw_elements_base_vertex.h"
+#include "Common/GL/GLExtensions/ARB_draw_indirect.h"
 #include "Common/GL/GLExtensions/ARB_framebuffer_object.h"
 #include "Common/GL/GLExtensions/ARB_get_program_binary.h"
 #include "Common/GL/GLExtensions/ARB_map_buffer_range.h"
@@ -29,6 +30,7 @@
 #include "Common/GL/GLExtensions/ARB_texture_multisample.h"
 #include "Common/GL/GLExtensions/ARB_texture_storage.h"
 #include "Common/GL/GLExtensions/ARB_texture_storage_multisample.h"
+#include "Common/GL/GLExtensions/ARB_timer_query.h"
 #include "Common/GL/GLExtensions/ARB_uniform_buffer_object.h"
 #include "Common/GL/GLExtensions/ARB_vertex_array_object.h"
 #include "Common/GL/GLExtensions/ARB_viewport_array.h"
@@ -36,9 +38,11 @@
 #include "Common/GL/GLExtensions/EXT_texture_filter_anisotropic.h"
 #include "Common/GL/GLExtensions/HP_occlusion_test.h"
 #include "Common/GL/GLExtensions/KHR_debug.h"
+#include "Common/GL/GLExtensions/KHR_parallel_shader_compile.h"
 #include "Common/GL/GLExtensions/NV_depth_buffer_float.h"
 #include "Common/GL/GLExtensions/NV_occlusion_query_samples.h"
 #include "Common/GL/GLExtensions/NV_primitive_restart.h"
+#include "Common/GL/GLExtensions/NV_shading_rate_image.h"
 #include "Common/GL/GLExtensions/gl_1_1.h"
 #include "Common/GL/GLExtensions/gl_1_2.h"
 #include "Common/GL/GLExtensions/gl_1_3.h"
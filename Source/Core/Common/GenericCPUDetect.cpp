@@ -8,6 +8,7 @@ CPUInfo cpu_info;
 
 CPUInfo::CPUInfo()
 {
+  DetectTopology();
 }
 
 std::string CPUInfo::Summarize()
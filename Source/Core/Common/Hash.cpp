@@ -9,8 +9,11 @@
 #include "Common/CommonFuncs.h"
 #include "Common/Intrinsics.h"
 
+#include "Common/Swap.h"
+
 #ifdef _M_ARM_64
 #include <arm_acle.h>
+#include <arm_neon.h>
 #endif
 
 static u64 (*ptrHashFunction)(const u8* src, u32 len, u32 samples) = nullptr;
@@ -612,14 +615,380 @@ u64 GetHashHiresTexture(const u8* src, u32 len, u32 samples)
 }
 #endif
 
+// XXH3, the 64 bit hash of xxHash 0.8 with the default secret and a seed of 0. The hash always
+// covers all of the data, and its inner loop runs on 256 bit (AVX2) or 128 bit (SSE2, NEON)
+// vectors, which makes hashing a whole texture cheaper than sampling it with the other hashes.
+namespace XXH3
+{
+constexpr u32 PRIME32_1 = 0x9E3779B1U;
+constexpr u32 PRIME32_2 = 0x85EBCA77U;
+constexpr u32 PRIME32_3 = 0xC2B2AE3DU;
+constexpr u64 PRIME64_1 = 0x9E3779B185EBCA87ULL;
+constexpr u64 PRIME64_2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr u64 PRIME64_3 = 0x165667B19E3779F9ULL;
+constexpr u64 PRIME64_4 = 0x85EBCA77C2B2AE63ULL;
+constexpr u64 PRIME64_5 = 0x27D4EB2F165667C5ULL;
+constexpr u64 PRIME_MX1 = 0x165667919E3779F9ULL;
+constexpr u64 PRIME_MX2 = 0x9FB21C651E98DF25ULL;
+
+constexpr size_t STRIPE_LEN = 64;
+constexpr size_t SECRET_SIZE = 192;
+constexpr size_t SECRET_CONSUME_RATE = 8;
+constexpr size_t STRIPES_PER_BLOCK = (SECRET_SIZE - STRIPE_LEN) / SECRET_CONSUME_RATE;
+constexpr size_t BLOCK_LEN = STRIPE_LEN * STRIPES_PER_BLOCK;
+
+alignas(64) constexpr u8 SECRET[SECRET_SIZE] = {
+    0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+    0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+    0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+    0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+    0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+    0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+    0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+    0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+    0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+    0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+    0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+    0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+};
+
+// The hash is defined on little endian values, which is what all of Dolphin's hosts use.
+static u32 Read32(const u8* p)
+{
+  u32 value;
+  std::memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+static u64 Read64(const u8* p)
+{
+  u64 value;
+  std::memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+// The low and high halves of the 128 bit product, xored together.
+static u64 Mul128Fold64(u64 lhs, u64 rhs)
+{
+#if defined(__SIZEOF_INT128__)
+  const unsigned __int128 product = static_cast<unsigned __int128>(lhs) * rhs;
+  return static_cast<u64>(product) ^ static_cast<u64>(product >> 64);
+#elif defined(_MSC_VER) && defined(_M_X86_64)
+  u64 high;
+  const u64 low = _umul128(lhs, rhs, &high);
+  return low ^ high;
+#else
+  const u64 lo_lo = (lhs & 0xFFFFFFFF) * (rhs & 0xFFFFFFFF);
+  const u64 hi_lo = (lhs >> 32) * (rhs & 0xFFFFFFFF);
+  const u64 lo_hi = (lhs & 0xFFFFFFFF) * (rhs >> 32);
+  const u64 hi_hi = (lhs >> 32) * (rhs >> 32);
+  const u64 cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+  const u64 upper = (hi_lo >> 32) + (cross >> 32) + hi_hi;
+  const u64 lower = (cross << 32) | (lo_lo & 0xFFFFFFFF);
+  return lower ^ upper;
+#endif
+}
+
+static u64 XXH64Avalanche(u64 h)
+{
+  h ^= h >> 33;
+  h *= PRIME64_2;
+  h ^= h >> 29;
+  h *= PRIME64_3;
+  return h ^ (h >> 32);
+}
+
+static u64 Avalanche(u64 h)
+{
+  h ^= h >> 37;
+  h *= PRIME_MX1;
+  return h ^ (h >> 32);
+}
+
+static u64 Mix16(const u8* input, const u8* secret)
+{
+  return Mul128Fold64(Read64(input) ^ Read64(secret), Read64(input + 8) ^ Read64(secret + 8));
+}
+
+static u64 Hash0To16(const u8* input, size_t len)
+{
+  if (len > 8)
+  {
+    const u64 input_lo = Read64(input) ^ (Read64(SECRET + 24) ^ Read64(SECRET + 32));
+    const u64 input_hi = Read64(input + len - 8) ^ (Read64(SECRET + 40) ^ Read64(SECRET + 48));
+    return Avalanche(len + Common::swap64(input_lo) + input_hi +
+                     Mul128Fold64(input_lo, input_hi));
+  }
+  if (len >= 4)
+  {
+    const u64 input64 = Read32(input + len - 4) + (static_cast<u64>(Read32(input)) << 32);
+    u64 h = input64 ^ (Read64(SECRET + 8) ^ Read64(SECRET + 16));
+    h ^= _rotl64(h, 49) ^ _rotl64(h, 24);
+    h *= PRIME_MX2;
+    h ^= (h >> 35) + len;
+    h *= PRIME_MX2;
+    return h ^ (h >> 28);
+  }
+  if (len > 0)
+  {
+    const u32 combined = (static_cast<u32>(input[0]) << 16) |
+                         (static_cast<u32>(input[len >> 1]) << 24) | input[len - 1] |
+                         static_cast<u32>(len << 8);
+    return XXH64Avalanche(combined ^ (Read32(SECRET) ^ Read32(SECRET + 4)));
+  }
+  return XXH64Avalanche(Read64(SECRET + 56) ^ Read64(SECRET + 64));
+}
+
+static u64 Hash17To128(const u8* input, size_t len)
+{
+  u64 acc = len * PRIME64_1;
+  if (len > 32)
+  {
+    if (len > 64)
+    {
+      if (len > 96)
+      {
+        acc += Mix16(input + 48, SECRET + 96);
+        acc += Mix16(input + len - 64, SECRET + 112);
+      }
+      acc += Mix16(input + 32, SECRET + 64);
+      acc += Mix16(input + len - 48, SECRET + 80);
+    }
+    acc += Mix16(input + 16, SECRET + 32);
+    acc += Mix16(input + len - 32, SECRET + 48);
+  }
+  acc += Mix16(input, SECRET);
+  acc += Mix16(input + len - 16, SECRET + 16);
+  return Avalanche(acc);
+}
+
+static u64 Hash129To240(const u8* input, size_t len)
+{
+  u64 acc = len * PRIME64_1;
+  for (size_t i = 0; i < 8; i++)
+    acc += Mix16(input + 16 * i, SECRET + 16 * i);
+  acc = Avalanche(acc);
+  for (size_t i = 8; i < len / 16; i++)
+    acc += Mix16(input + 16 * i, SECRET + 16 * (i - 8) + 3);
+  acc += Mix16(input + len - 16, SECRET + 136 - 17);
+  return Avalanche(acc);
+}
+
+// Accumulates stripes of 64 bytes, each with the secret advanced by SECRET_CONSUME_RATE bytes.
+using AccumulateFunction = void (*)(u64* acc, const u8* input, const u8* secret, size_t stripes);
+// Mixes the accumulators after each block.
+using ScrambleFunction = void (*)(u64* acc, const u8* secret);
+
+static void AccumulateScalar(u64* acc, const u8* input, const u8* secret, size_t stripes)
+{
+  for (size_t n = 0; n < stripes; n++)
+  {
+    const u8* stripe = input + n * STRIPE_LEN;
+    const u8* key = secret + n * SECRET_CONSUME_RATE;
+    for (size_t i = 0; i < 8; i++)
+    {
+      const u64 data = Read64(stripe + 8 * i);
+      const u64 data_key = data ^ Read64(key + 8 * i);
+      acc[i ^ 1] += data;
+      acc[i] += (data_key & 0xFFFFFFFF) * (data_key >> 32);
+    }
+  }
+}
+
+static void ScrambleScalar(u64* acc, const u8* secret)
+{
+  for (size_t i = 0; i < 8; i++)
+    acc[i] = (acc[i] ^ (acc[i] >> 47) ^ Read64(secret + 8 * i)) * PRIME32_1;
+}
+
+#if defined(_M_X86)
+
+static void AccumulateSSE2(u64* acc, const u8* input, const u8* secret, size_t stripes)
+{
+  __m128i* const acc_vec = reinterpret_cast<__m128i*>(acc);
+  for (size_t n = 0; n < stripes; n++)
+  {
+    const u8* stripe = input + n * STRIPE_LEN;
+    const u8* key = secret + n * SECRET_CONSUME_RATE;
+    for (size_t i = 0; i < 4; i++)
+    {
+      const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(stripe) + i);
+      const __m128i data_key =
+          _mm_xor_si128(data, _mm_loadu_si128(reinterpret_cast<const __m128i*>(key) + i));
+      const __m128i product =
+          _mm_mul_epu32(data_key, _mm_shuffle_epi32(data_key, _MM_SHUFFLE(0, 3, 0, 1)));
+      const __m128i data_swap = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+      acc_vec[i] = _mm_add_epi64(product, _mm_add_epi64(acc_vec[i], data_swap));
+    }
+  }
+}
+
+static void ScrambleSSE2(u64* acc, const u8* secret)
+{
+  __m128i* const acc_vec = reinterpret_cast<__m128i*>(acc);
+  const __m128i prime = _mm_set1_epi32(static_cast<int>(PRIME32_1));
+  for (size_t i = 0; i < 4; i++)
+  {
+    const __m128i data = _mm_xor_si128(acc_vec[i], _mm_srli_epi64(acc_vec[i], 47));
+    const __m128i data_key =
+        _mm_xor_si128(data, _mm_loadu_si128(reinterpret_cast<const __m128i*>(secret) + i));
+    const __m128i product_lo = _mm_mul_epu32(data_key, prime);
+    const __m128i product_hi =
+        _mm_mul_epu32(_mm_shuffle_epi32(data_key, _MM_SHUFFLE(0, 3, 0, 1)), prime);
+    acc_vec[i] = _mm_add_epi64(product_lo, _mm_slli_epi64(product_hi, 32));
+  }
+}
+
+FUNCTION_TARGET_AVX2
+static void AccumulateAVX2(u64* acc, const u8* input, const u8* secret, size_t stripes)
+{
+  __m256i* const acc_vec = reinterpret_cast<__m256i*>(acc);
+  for (size_t n = 0; n < stripes; n++)
+  {
+    const u8* stripe = input + n * STRIPE_LEN;
+    const u8* key = secret + n * SECRET_CONSUME_RATE;
+    for (size_t i = 0; i < 2; i++)
+    {
+      const __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(stripe) + i);
+      const __m256i data_key =
+          _mm256_xor_si256(data, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(key) + i));
+      const __m256i product =
+          _mm256_mul_epu32(data_key, _mm256_shuffle_epi32(data_key, _MM_SHUFFLE(0, 3, 0, 1)));
+      const __m256i data_swap = _mm256_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+      acc_vec[i] = _mm256_add_epi64(product, _mm256_add_epi64(acc_vec[i], data_swap));
+    }
+  }
+}
+
+FUNCTION_TARGET_AVX2
+static void ScrambleAVX2(u64* acc, const u8* secret)
+{
+  __m256i* const acc_vec = reinterpret_cast<__m256i*>(acc);
+  const __m256i prime = _mm256_set1_epi32(static_cast<int>(PRIME32_1));
+  for (size_t i = 0; i < 2; i++)
+  {
+    const __m256i data = _mm256_xor_si256(acc_vec[i], _mm256_srli_epi64(acc_vec[i], 47));
+    const __m256i data_key =
+        _mm256_xor_si256(data, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(secret) + i));
+    const __m256i product_lo = _mm256_mul_epu32(data_key, prime);
+    const __m256i product_hi =
+        _mm256_mul_epu32(_mm256_shuffle_epi32(data_key, _MM_SHUFFLE(0, 3, 0, 1)), prime);
+    acc_vec[i] = _mm256_add_epi64(product_lo, _mm256_slli_epi64(product_hi, 32));
+  }
+}
+
+#elif defined(_M_ARM_64)
+
+static void AccumulateNEON(u64* acc, const u8* input, const u8* secret, size_t stripes)
+{
+  for (size_t n = 0; n < stripes; n++)
+  {
+    const u8* stripe = input + n * STRIPE_LEN;
+    const u8* key = secret + n * SECRET_CONSUME_RATE;
+    for (size_t i = 0; i < 4; i++)
+    {
+      const uint64x2_t data = vreinterpretq_u64_u8(vld1q_u8(stripe + 16 * i));
+      const uint64x2_t data_key = veorq_u64(data, vreinterpretq_u64_u8(vld1q_u8(key + 16 * i)));
+      uint64x2_t sum = vaddq_u64(vld1q_u64(acc + 2 * i), vextq_u64(data, data, 1));
+      sum = vmlal_u32(sum, vmovn_u64(data_key), vshrn_n_u64(data_key, 32));
+      vst1q_u64(acc + 2 * i, sum);
+    }
+  }
+}
+
+static void ScrambleNEON(u64* acc, const u8* secret)
+{
+  const uint32x2_t prime = vdup_n_u32(PRIME32_1);
+  for (size_t i = 0; i < 4; i++)
+  {
+    uint64x2_t data = vld1q_u64(acc + 2 * i);
+    data = veorq_u64(data, vshrq_n_u64(data, 47));
+    const uint64x2_t data_key = veorq_u64(data, vreinterpretq_u64_u8(vld1q_u8(secret + 16 * i)));
+    const uint64x2_t product_hi = vshlq_n_u64(vmull_u32(vshrn_n_u64(data_key, 32), prime), 32);
+    vst1q_u64(acc + 2 * i, vmlal_u32(product_hi, vmovn_u64(data_key), prime));
+  }
+}
+
+#endif
+
+static AccumulateFunction s_accumulate = AccumulateScalar;
+static ScrambleFunction s_scramble = ScrambleScalar;
+
+static u64 HashLong(const u8* input, size_t len)
+{
+  alignas(32) u64 acc[8] = {PRIME32_3, PRIME64_1, PRIME64_2, PRIME64_3,
+                            PRIME64_4, PRIME32_2, PRIME64_5, PRIME32_1};
+
+  const size_t blocks = (len - 1) / BLOCK_LEN;
+  for (size_t n = 0; n < blocks; n++)
+  {
+    s_accumulate(acc, input + n * BLOCK_LEN, SECRET, STRIPES_PER_BLOCK);
+    s_scramble(acc, SECRET + SECRET_SIZE - STRIPE_LEN);
+  }
+
+  // The stripes of the last partial block, then the last 64 bytes, which may overlap them.
+  const size_t stripes = ((len - 1) - BLOCK_LEN * blocks) / STRIPE_LEN;
+  s_accumulate(acc, input + blocks * BLOCK_LEN, SECRET, stripes);
+  s_accumulate(acc, input + len - STRIPE_LEN, SECRET + SECRET_SIZE - STRIPE_LEN - 7, 1);
+
+  u64 result = len * PRIME64_1;
+  for (size_t i = 0; i < 4; i++)
+  {
+    const u8* key = SECRET + 11 + 16 * i;
+    result += Mul128Fold64(acc[2 * i] ^ Read64(key), acc[2 * i + 1] ^ Read64(key + 8));
+  }
+  return Avalanche(result);
+}
+
+static u64 Hash(const u8* input, size_t len)
+{
+  if (len <= 16)
+    return Hash0To16(input, len);
+  if (len <= 128)
+    return Hash17To128(input, len);
+  if (len <= 240)
+    return Hash129To240(input, len);
+  return HashLong(input, len);
+}
+
+static void SelectFunctions()
+{
+#if defined(_M_X86)
+  if (cpu_info.bAVX2)
+  {
+    s_accumulate = AccumulateAVX2;
+    s_scramble = ScrambleAVX2;
+  }
+  else
+  {
+    s_accumulate = AccumulateSSE2;
+    s_scramble = ScrambleSSE2;
+  }
+#elif defined(_M_ARM_64)
+  s_accumulate = AccumulateNEON;
+  s_scramble = ScrambleNEON;
+#endif
+}
+}  // namespace XXH3
+
+u64 GetXXH3Hash64(const u8* src, size_t len)
+{
+  return XXH3::Hash(src, len);
+}
+
 u64 GetHash64(const u8* src, u32 len, u32 samples)
 {
+  // The sampled hashes only skip data when there are fewer samples than 64 bit words.
+  if (samples == 0 || samples >= len / 8)
+    return XXH3::Hash(src, len);
   return ptrHashFunction(src, len, samples);
 }
 
 // sets the hash function used for the texture cache
 void SetHash64Function()
 {
+  XXH3::SelectFunctions();
+
 #if defined(_M_X86_64) || defined(_M_X86)
   if (cpu_info.bSSE4_2)  // sse crc32 version
   {
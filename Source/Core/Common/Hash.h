@@ -12,5 +12,9 @@ u32 HashFletcher(const u8* data_u8, size_t length);  // FAST. Length & 1 == 0.
 u32 HashAdler32(const u8* data, size_t len);         // Fairly accurate, slightly slower
 u32 HashEctor(const u8* ptr, int length);            // JUNK. DO NOT USE FOR NEW THINGS
 u64 GetHashHiresTexture(const u8* src, u32 len, u32 samples = 0);
+// Hashes all of the data with XXH3 when samples is 0, otherwise only about that many 64 bit words.
 u64 GetHash64(const u8* src, u32 len, u32 samples);
+// XXH3 of xxHash 0.8, with the default secret and a seed of 0.
+u64 GetXXH3Hash64(const u8* src, size_t len);
+// Selects the hash functions for this CPU.
 void SetHash64Function();
@@ -293,30 +293,49 @@ bool IniFile::Section::GetLines(std::vector<std::string>* lines, const bool remo
 
 // IniFile
 
+IniFile::IniFile(const IniFile& other) : sections(other.sections)
+{
+  RebuildSectionIndex();
+}
+
+IniFile& IniFile::operator=(const IniFile& other)
+{
+  if (this != &other)
+  {
+    sections = other.sections;
+    RebuildSectionIndex();
+  }
+  return *this;
+}
+
+void IniFile::RebuildSectionIndex()
+{
+  m_section_index.clear();
+  for (Section& section : sections)
+    m_section_index.emplace(section.name, &section);
+}
+
 const IniFile::Section* IniFile::GetSection(const std::string& sectionName) const
 {
-  for (const Section& sect : sections)
-    if (!strcasecmp(sect.name.c_str(), sectionName.c_str()))
-      return (&(sect));
-  return nullptr;
+  const auto it = m_section_index.find(sectionName);
+  return it != m_section_index.end() ? it->second : nullptr;
 }
 
 IniFile::Section* IniFile::GetSection(const std::string& sectionName)
 {
-  for (Section& sect : sections)
-    if (!strcasecmp(sect.name.c_str(), sectionName.c_str()))
-      return (&(sect));
-  return nullptr;
+  const auto it = m_section_index.find(sectionName);
+  return it != m_section_index.end() ? it->second : nullptr;
 }
 
 IniFile::Section* IniFile::GetOrCreateSection(const std::string& sectionName)
 {
-  Section* section = GetSection(sectionName);
-  if (!section)
-  {
-    sections.emplace_back(sectionName);
-    section = &sections.back();
-  }
+  const auto it = m_section_index.find(sectionName);
+  if (it != m_section_index.end())
+    return it->second;
+
+  sections.emplace_back(sectionName);
+  Section* section = &sections.back();
+  m_section_index.emplace(sectionName, section);
   return section;
 }
 
@@ -350,6 +369,7 @@ bool IniFile::DeleteSection(const std::string& sectionName)
   {
     if (&(*iter) == s)
     {
+      m_section_index.erase(sectionName);
       sections.erase(iter);
       return true;
     }
@@ -415,80 +435,98 @@ void IniFile::SortSections()
   sections.sort();
 }
 
-bool IniFile::Load(const std::string& filename, bool keep_current_data)
+// Parses the whole file in one pass over its contents, without copying the lines.
+void IniFile::ParseContents(const std::string& contents)
 {
-  if (!keep_current_data)
-    sections.clear();
-  // first section consists of the comments before the first real section
+  const auto is_space = [](char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; };
 
-  // Open file
-  std::ifstream in;
-  File::OpenFStream(in, filename, std::ios::in);
+  Section* current_section = nullptr;
+  const char* const contents_end = contents.data() + contents.size();
+  const char* line_begin = contents.data();
 
-  if (in.fail())
-    return false;
+  // Skips the UTF-8 BOM at the start of files. Notepad likes to add this.
+  if (contents.compare(0, 3, "\xEF\xBB\xBF") == 0)
+    line_begin += 3;
 
-  Section* current_section = nullptr;
-  bool first_line = true;
-  while (!in.eof())
+  while (line_begin < contents_end)
   {
-    std::string line;
+    const char* line_end = std::find(line_begin, contents_end, '\n');
+    const char* const next_line = line_end == contents_end ? line_end : line_end + 1;
+    // Check for CRLF eol and convert it to LF
+    if (line_end != line_begin && line_end[-1] == '\r')
+      --line_end;
 
-    if (!std::getline(in, line))
+    if (line_begin == line_end)
     {
-      if (in.eof())
-        return true;
-      else
-        return false;
+      line_begin = next_line;
+      continue;
     }
 
-    // Skips the UTF-8 BOM at the start of files. Notepad likes to add this.
-    if (first_line && line.substr(0, 3) == "\xEF\xBB\xBF")
-      line = line.substr(3);
-    first_line = false;
-
-#ifndef _WIN32
-    // Check for CRLF eol and convert it to LF
-    if (!line.empty() && line.back() == '\r')
+    if (*line_begin == '[')
     {
-      line.pop_back();
+      const char* const name_end = std::find(line_begin, line_end, ']');
+      // New section!
+      if (name_end != line_end)
+        current_section = GetOrCreateSection(std::string(line_begin + 1, name_end));
     }
-#endif
-
-    if (line.size() > 0)
+    else if (current_section)
     {
-      if (line[0] == '[')
+      // The key is what comes before the first '=', and the value what comes after it, both
+      // without surrounding spaces, and the value without surrounding quotes. See ParseLine.
+      // Comments and lines without a '=' have neither.
+      const char* const equals = std::find(line_begin, line_end, '=');
+      const bool has_key = *line_begin != '#' && equals != line_end;
+      const char* key_begin = line_begin;
+      const char* key_end = has_key ? equals : line_begin;
+      const char* value_begin = has_key ? equals + 1 : line_begin;
+      const char* value_end = has_key ? line_end : line_begin;
+      while (key_begin != key_end && is_space(*key_begin))
+        ++key_begin;
+      while (key_end != key_begin && is_space(key_end[-1]))
+        --key_end;
+      while (value_begin != value_end && is_space(*value_begin))
+        ++value_begin;
+      while (value_end != value_begin && is_space(value_end[-1]))
+        --value_end;
+      if (value_begin != value_end && *value_begin == '"' && value_end[-1] == '"')
       {
-        size_t endpos = line.find(']');
-
-        if (endpos != std::string::npos)
-        {
-          // New section!
-          std::string sub = line.substr(1, endpos - 1);
-          current_section = GetOrCreateSection(sub);
-        }
+        // A lone quote is stripped to nothing.
+        ++value_begin;
+        value_end = std::max(value_begin, value_end - 1);
+      }
+
+      // Lines starting with '$', '*' or '+' are kept verbatim.
+      // Kind of a hack, but the support for raw lines inside an
+      // INI is a hack anyway.
+      if ((key_begin == key_end && value_begin == value_end) || *line_begin == '$' ||
+          *line_begin == '+' || *line_begin == '*')
+      {
+        current_section->m_lines.emplace_back(line_begin, line_end);
       }
       else
       {
-        if (current_section)
-        {
-          std::string key, value;
-          ParseLine(line, &key, &value);
-
-          // Lines starting with '$', '*' or '+' are kept verbatim.
-          // Kind of a hack, but the support for raw lines inside an
-          // INI is a hack anyway.
-          if ((key == "" && value == "") ||
-              (line.size() >= 1 && (line[0] == '$' || line[0] == '+' || line[0] == '*')))
-            current_section->m_lines.push_back(line);
-          else
-            current_section->Set(key, value);
-        }
+        current_section->Set(std::string(key_begin, key_end),
+                             std::string(value_begin, value_end));
       }
     }
+
+    line_begin = next_line;
   }
+}
+
+bool IniFile::Load(const std::string& filename, bool keep_current_data)
+{
+  if (!keep_current_data)
+  {
+    sections.clear();
+    m_section_index.clear();
+  }
+
+  std::string contents;
+  if (!File::ReadFileToString(filename, contents))
+    return false;
 
-  in.close();
+  ParseContents(contents);
   return true;
 }
 
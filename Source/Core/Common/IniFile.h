@@ -8,6 +8,7 @@
 #include <list>
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "Common/CommonFuncs.h"
@@ -21,9 +22,38 @@ struct CaseInsensitiveStringCompare
   }
 };
 
+struct CaseInsensitiveStringHash
+{
+  size_t operator()(const std::string& s) const
+  {
+    // FNV-1a of the lowercased characters
+    size_t hash = 2166136261u;
+    for (const char c : s)
+    {
+      const char lower = c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+      hash = (hash ^ static_cast<unsigned char>(lower)) * 16777619u;
+    }
+    return hash;
+  }
+};
+
+struct CaseInsensitiveStringEqual
+{
+  bool operator()(const std::string& a, const std::string& b) const
+  {
+    return a.size() == b.size() && strcasecmp(a.c_str(), b.c_str()) == 0;
+  }
+};
+
 class IniFile
 {
 public:
+  IniFile() = default;
+  IniFile(const IniFile& other);
+  IniFile(IniFile&& other) = default;
+  IniFile& operator=(const IniFile& other);
+  IniFile& operator=(IniFile&& other) = default;
+
   class Section
   {
     friend class IniFile;
@@ -146,6 +176,13 @@ public:
   const std::list<Section>& GetSections() const { return sections; }
 private:
   std::list<Section> sections;
+  // The sections by their case-insensitive names. The nodes of the list never move, not even when
+  // it is sorted or moved, so only copies need a new index.
+  std::unordered_map<std::string, Section*, CaseInsensitiveStringHash, CaseInsensitiveStringEqual>
+      m_section_index;
+
+  void RebuildSectionIndex();
+  void ParseContents(const std::string& contents);
 
   const Section* GetSection(const std::string& section) const;
   Section* GetSection(const std::string& section);
@@ -9,6 +9,7 @@
 #include <fstream>
 #include <string>
 #include <type_traits>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/FileUtil.h"
@@ -37,6 +38,8 @@ public:
 
 // Dead simple unsorted key-value store with append functionality.
 // No random read functionality, all reading is done in OpenAndRead.
+// The file is read with a single bulk read and indexed from memory; values are passed to the
+// reader straight out of that buffer, so the reader must copy anything it wants to keep.
 // Keys and values can contain any characters, including \0.
 //
 // Suitable for caching generated shader bytecode between executions.
@@ -80,44 +83,60 @@ public:
     std::streamoff file_size = end_pos - start_pos;
 
     m_header.Init();
-    if (m_file.is_open() && ValidateHeader())
+    std::vector<u8> data;
+    if (m_file.is_open() && file_size >= static_cast<std::streamoff>(sizeof(Header)))
+    {
+      data.resize(static_cast<size_t>(file_size));
+      if (!Read(data.data(), static_cast<u32>(data.size())))
+        data.clear();
+    }
+
+    if (data.size() >= sizeof(Header) && !memcmp(&m_header, data.data(), sizeof(Header)))
     {
       // good header, read some key/value pairs
-      K key;
+      std::vector<V> misaligned_value;
+      size_t pos = sizeof(Header);
 
-      V* value = nullptr;
-      u32 value_size = 0;
-      u32 entry_number = 0;
+      for (;;)
+      {
+        u32 value_size;
+        if (data.size() - pos < sizeof(value_size))
+          break;
+        std::memcpy(&value_size, &data[pos], sizeof(value_size));
 
-      std::fstream::pos_type last_pos = m_file.tellg();
+        const size_t key_offset = pos + sizeof(value_size);
+        const size_t value_offset = key_offset + sizeof(K);
+        const size_t number_offset = value_offset + static_cast<size_t>(value_size) * sizeof(V);
+        const size_t next_pos = number_offset + sizeof(u32);
+        if (next_pos > data.size() || next_pos < pos)
+          break;
 
-      while (Read(&value_size))
-      {
-        std::streamoff next_extent = (last_pos - start_pos) + sizeof(value_size) + value_size;
-        if (next_extent > file_size)
+        u32 entry_number;
+        std::memcpy(&entry_number, &data[number_offset], sizeof(entry_number));
+        if (entry_number != m_num_entries + 1)
           break;
 
-        delete[] value;
-        value = new V[value_size];
+        K key;
+        std::memcpy(&key, &data[key_offset], sizeof(K));
 
-        // read key/value and pass to reader
-        if (Read(&key) && Read(value, value_size) && Read(&entry_number) &&
-            entry_number == m_num_entries + 1)
+        // Values are only guaranteed to be byte-aligned within the file.
+        const V* value = reinterpret_cast<const V*>(data.data() + value_offset);
+        if (reinterpret_cast<uintptr_t>(value) % alignof(V) != 0)
         {
-          reader.Read(key, value, value_size);
-        }
-        else
-        {
-          break;
+          misaligned_value.resize(value_size);
+          std::memcpy(misaligned_value.data(), value, value_size * sizeof(V));
+          value = misaligned_value.data();
         }
 
+        reader.Read(key, value, value_size);
+
         m_num_entries++;
-        last_pos = m_file.tellg();
+        pos = next_pos;
       }
-      m_file.seekp(last_pos);
-      m_file.clear();
 
-      delete[] value;
+      // Truncated or corrupt entries at the end are overwritten by the next append.
+      m_file.clear();
+      m_file.seekp(start_pos + static_cast<std::streamoff>(pos));
       return m_num_entries;
     }
 
@@ -152,14 +171,6 @@ public:
 
 private:
   void WriteHeader() { Write(&m_header); }
-  bool ValidateHeader()
-  {
-    char file_header[sizeof(Header)];
-
-    return (Read(file_header, sizeof(Header)) &&
-            !memcmp((const char*)&m_header, file_header, sizeof(Header)));
-  }
-
   template <typename D>
   bool Write(const D* data, u32 count = 1)
   {
@@ -4,6 +4,10 @@
 
 #pragma once
 
+#include <atomic>
+
+#include "Common/CommonTypes.h"
+
 namespace LogTypes
 {
 enum LOG_TYPE
@@ -89,10 +93,47 @@ void GenericLog(LogTypes::LOG_LEVELS level, LogTypes::LOG_TYPE type, const char*
 #endif  // loglevel
 #endif  // logging
 
+// The types logged from the hottest paths (MMIO, DSP, FIFO...) are compiled in up to this level,
+// so that builds can drop their log sites without losing the other logs, for example with
+// -DHOT_MAX_LOGLEVEL=LogTypes::LWARNING.
+#ifndef HOT_MAX_LOGLEVEL
+#define HOT_MAX_LOGLEVEL MAX_LOGLEVEL
+#endif
+
+static_assert(LogTypes::NUMBER_OF_LOGS <= 64, "The enabled log types must fit in a u64");
+
+namespace LogTypes
+{
+constexpr bool IsHotLogType(LOG_TYPE type)
+{
+  return type == AUDIO_INTERFACE || type == COMMANDPROCESSOR || type == DSPHLE || type == DSPLLE ||
+         type == DSP_MAIL || type == DSPINTERFACE || type == EXPANSIONINTERFACE ||
+         type == GPFIFO || type == MEMMAP || type == PIXELENGINE || type == PROCESSORINTERFACE ||
+         type == SERIALINTERFACE || type == VIDEO || type == VIDEOINTERFACE || type == WII_IPC;
+}
+
+// The most verbose level compiled in for a type. Log sites above it are removed from the build.
+constexpr LOG_LEVELS GetMaxLevel(LOG_TYPE type)
+{
+  return IsHotLogType(type) && HOT_MAX_LOGLEVEL < MAX_LOGLEVEL ? HOT_MAX_LOGLEVEL : MAX_LOGLEVEL;
+}
+}  // namespace LogTypes
+
+// Bit t of the entry of a level is set when logs of type t are enabled at that level and a
+// listener is enabled. Kept up to date by LogManager, so that disabled log sites don't evaluate
+// their arguments or call GenericLog.
+extern std::atomic<u64> g_enabled_log_types[LogTypes::LDEBUG + 1];
+
+inline bool IsLogEnabled(LogTypes::LOG_TYPE type, LogTypes::LOG_LEVELS level)
+{
+  return level <= LogTypes::LDEBUG &&
+         ((g_enabled_log_types[level].load(std::memory_order_relaxed) >> type) & 1) != 0;
+}
+
 // Let the compiler optimize this out
 #define GENERIC_LOG(t, v, ...)                                                                     \
   {                                                                                                \
-    if (v <= MAX_LOGLEVEL)                                                                         \
+    if (v <= LogTypes::GetMaxLevel(t) && IsLogEnabled(t, v))                                       \
       GenericLog(v, t, __FILE__, __LINE__, __VA_ARGS__);                                           \
   }
 
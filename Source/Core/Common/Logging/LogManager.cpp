@@ -2,11 +2,17 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <chrono>
 #include <cstdarg>
+#include <cstdio>
 #include <cstring>
+#include <memory>
 #include <mutex>
 #include <ostream>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "Common/CommonPaths.h"
 #include "Common/Config/Config.h"
@@ -15,9 +21,15 @@
 #include "Common/Logging/Log.h"
 #include "Common/Logging/LogManager.h"
 #include "Common/StringUtil.h"
+#include "Common/Thread.h"
 #include "Common/Timer.h"
 
 constexpr size_t MAX_MSGLEN = 1024;
+// Room for the time, file, line and type in front of the message
+constexpr size_t MAX_HEADERLEN = 256;
+// Messages per ring. The logger thread is woken up early once a ring is half full.
+constexpr u32 LOG_RING_SIZE = 256;
+constexpr auto LOGGER_THREAD_INTERVAL = std::chrono::milliseconds(5);
 
 const Config::ConfigInfo<bool> LOGGER_WRITE_TO_FILE{
     {Config::System::Logger, "Options", "WriteToFile"}, false};
@@ -26,6 +38,49 @@ const Config::ConfigInfo<bool> LOGGER_WRITE_TO_CONSOLE{
 const Config::ConfigInfo<bool> LOGGER_WRITE_TO_WINDOW{
     {Config::System::Logger, "Options", "WriteToWindow"}, true};
 const Config::ConfigInfo<int> LOGGER_VERBOSITY{{Config::System::Logger, "Options", "Verbosity"}, 0};
+const Config::ConfigInfo<bool> LOGGER_ASYNCHRONOUS{
+    {Config::System::Logger, "Options", "Asynchronous"}, false};
+
+std::atomic<u64> g_enabled_log_types[LogTypes::LDEBUG + 1];
+
+struct LogManager::LogRing
+{
+  struct Record
+  {
+    u64 sequence;
+    LogTypes::LOG_LEVELS level;
+    char text[MAX_HEADERLEN + MAX_MSGLEN];
+  };
+
+  std::array<Record, LOG_RING_SIZE> records;
+  // Only written by the thread which owns the ring
+  std::atomic<u32> write{0};
+  // Only written by the logger thread
+  std::atomic<u32> read{0};
+  // Cleared when the thread exits, so that the ring can be given to another thread once empty
+  std::atomic<bool> owned{true};
+};
+
+namespace
+{
+// The ring of the current thread, which belongs to the LogManager of the given generation.
+struct ThreadLogRing
+{
+  ~ThreadLogRing()
+  {
+    if (ring)
+      ring->owned = false;
+  }
+
+  std::shared_ptr<LogManager::LogRing> ring;
+  u32 generation = 0;
+};
+
+thread_local ThreadLogRing s_thread_ring;
+// Messages logged by listeners can't wait for the logger thread, as they run on it.
+thread_local bool s_is_logger_thread = false;
+std::atomic<u32> s_next_generation{1};
+}  // Anonymous namespace
 
 class FileLogListener : public LogListener
 {
@@ -152,10 +207,31 @@ LogManager::LogManager()
         Config::ConfigInfo<bool>{{Config::System::Logger, "Logs", container.m_short_name}, false});
 
   m_path_cutoff_point = DeterminePathCutOffPoint();
+
+  UpdateEnabledLogTypes();
+
+  m_async = Config::Get(LOGGER_ASYNCHRONOUS);
+  if (m_async)
+  {
+    m_generation = s_next_generation++;
+    m_running.Set();
+    m_thread = std::thread(&LogManager::LoggerThread, this);
+  }
 }
 
 LogManager::~LogManager()
 {
+  for (std::atomic<u64>& types : g_enabled_log_types)
+    types = 0;
+
+  if (m_async)
+  {
+    m_running.Clear();
+    m_drain_event.Set();
+    m_thread.join();
+    DrainRings();
+  }
+
   // The log window listener pointer is owned by the GUI code.
   delete m_listeners[LogListener::CONSOLE_LISTENER];
   delete m_listeners[LogListener::FILE_LISTENER];
@@ -192,6 +268,16 @@ void LogManager::LogWithFullPath(LogTypes::LOG_LEVELS level, LogTypes::LOG_TYPE
   char temp[MAX_MSGLEN];
   CharArrayFromFormatV(temp, MAX_MSGLEN, format, args);
 
+  if (m_async)
+  {
+    char header[MAX_HEADERLEN];
+    std::snprintf(header, sizeof(header), "%s %s:%u %c[%s]: ",
+                  Common::Timer::GetTimeFormatted().c_str(), file, line,
+                  LogTypes::LOG_LEVEL_TO_CHAR[(int)level], GetShortName(type));
+    LogAsync(level, header, temp);
+    return;
+  }
+
   std::string msg =
       StringFromFormat("%s %s:%u %c[%s]: %s\n", Common::Timer::GetTimeFormatted().c_str(), file,
                        line, LogTypes::LOG_LEVEL_TO_CHAR[(int)level], GetShortName(type), temp);
@@ -201,6 +287,111 @@ void LogManager::LogWithFullPath(LogTypes::LOG_LEVELS level, LogTypes::LOG_TYPE
       m_listeners[listener_id]->Log(level, msg.c_str());
 }
 
+void LogManager::LogAsync(LogTypes::LOG_LEVELS level, const char* header, const char* msg)
+{
+  ThreadLogRing& thread_ring = s_thread_ring;
+  if (!thread_ring.ring || thread_ring.generation != m_generation)
+  {
+    if (thread_ring.ring)
+      thread_ring.ring->owned = false;
+    thread_ring.ring = AcquireRing();
+    thread_ring.generation = m_generation;
+  }
+  LogRing& ring = *thread_ring.ring;
+
+  const u32 write = ring.write.load(std::memory_order_relaxed);
+  while (write - ring.read.load(std::memory_order_acquire) >= LOG_RING_SIZE)
+  {
+    if (s_is_logger_thread)
+      return;
+    m_drain_event.Set();
+    std::this_thread::yield();
+  }
+
+  LogRing::Record& record = ring.records[write % LOG_RING_SIZE];
+  record.sequence = m_sequence.fetch_add(1, std::memory_order_relaxed);
+  record.level = level;
+  std::snprintf(record.text, sizeof(record.text), "%s%s\n", header, msg);
+  ring.write.store(write + 1, std::memory_order_release);
+
+  if (write + 1 - ring.read.load(std::memory_order_relaxed) >= LOG_RING_SIZE / 2)
+    m_drain_event.Set();
+}
+
+std::shared_ptr<LogManager::LogRing> LogManager::AcquireRing()
+{
+  std::lock_guard<std::mutex> lk(m_rings_mutex);
+  for (const std::shared_ptr<LogRing>& ring : m_rings)
+  {
+    if (!ring->owned && ring->read.load() == ring->write.load())
+    {
+      ring->owned = true;
+      return ring;
+    }
+  }
+
+  m_rings.push_back(std::make_shared<LogRing>());
+  return m_rings.back();
+}
+
+void LogManager::LoggerThread()
+{
+  Common::SetCurrentThreadName("Logger");
+  s_is_logger_thread = true;
+
+  while (m_running.IsSet())
+  {
+    m_drain_event.WaitFor(LOGGER_THREAD_INTERVAL);
+    DrainRings();
+  }
+}
+
+void LogManager::DrainRings()
+{
+  struct PendingRecord
+  {
+    u64 sequence;
+    const LogRing::Record* record;
+  };
+
+  std::vector<std::shared_ptr<LogRing>> rings;
+  {
+    std::lock_guard<std::mutex> lk(m_rings_mutex);
+    rings = m_rings;
+  }
+
+  // The records stay in the rings until the read positions move past them below.
+  std::vector<u32> ends(rings.size());
+  std::vector<PendingRecord> pending;
+  for (size_t i = 0; i < rings.size(); ++i)
+  {
+    const LogRing& ring = *rings[i];
+    ends[i] = ring.write.load(std::memory_order_acquire);
+    for (u32 index = ring.read.load(std::memory_order_relaxed); index != ends[i]; ++index)
+    {
+      const LogRing::Record& record = ring.records[index % LOG_RING_SIZE];
+      pending.push_back({record.sequence, &record});
+    }
+  }
+  if (pending.empty())
+    return;
+
+  std::sort(pending.begin(), pending.end(),
+            [](const PendingRecord& a, const PendingRecord& b) { return a.sequence < b.sequence; });
+  {
+    std::lock_guard<std::mutex> lk(m_listeners_mutex);
+    for (const PendingRecord& entry : pending)
+    {
+      for (auto listener_id : m_listener_ids)
+        if (m_listeners[listener_id])
+          m_listeners[listener_id]->Log(entry.record->level, entry.record->text);
+    }
+  }
+
+  for (size_t i = 0; i < rings.size(); ++i)
+    rings[i]->read.store(ends[i], std::memory_order_release);
+}
+
 LogTypes::LOG_LEVELS LogManager::GetLogLevel() const
 {
   return m_level;
@@ -209,11 +400,29 @@ LogTypes::LOG_LEVELS LogManager::GetLogLevel() const
 void LogManager::SetLogLevel(LogTypes::LOG_LEVELS level)
 {
   m_level = level;
+  UpdateEnabledLogTypes();
 }
 
 void LogManager::SetEnable(LogTypes::LOG_TYPE type, bool enable)
 {
   m_log[type].m_enable = enable;
+  UpdateEnabledLogTypes();
+}
+
+void LogManager::UpdateEnabledLogTypes()
+{
+  u64 enabled_types = 0;
+  if (static_cast<bool>(m_listener_ids))
+  {
+    for (size_t i = 0; i < m_log.size(); ++i)
+    {
+      if (m_log[i].m_enable)
+        enabled_types |= u64{1} << i;
+    }
+  }
+
+  for (int level = 0; level <= LogTypes::LDEBUG; ++level)
+    g_enabled_log_types[level] = level <= m_level ? enabled_types : 0;
 }
 
 bool LogManager::IsEnabled(LogTypes::LOG_TYPE type, LogTypes::LOG_LEVELS level) const
@@ -233,12 +442,14 @@ const char* LogManager::GetFullName(LogTypes::LOG_TYPE type) const
 
 void LogManager::RegisterListener(LogListener::LISTENER id, LogListener* listener)
 {
+  std::lock_guard<std::mutex> lk(m_listeners_mutex);
   m_listeners[id] = listener;
 }
 
 void LogManager::EnableListener(LogListener::LISTENER id, bool enable)
 {
   m_listener_ids[id] = enable;
+  UpdateEnabledLogTypes();
 }
 
 bool LogManager::IsListenerEnabled(LogListener::LISTENER id) const
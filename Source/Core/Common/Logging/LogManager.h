@@ -5,9 +5,16 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <cstdarg>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #include "Common/BitSet.h"
+#include "Common/Event.h"
+#include "Common/Flag.h"
 #include "Common/Logging/Log.h"
 
 // pure virtual interface
@@ -54,6 +61,11 @@ public:
 
   void SaveSettings();
 
+  // With Options.Asynchronous, each thread formats its messages into a ring of its own, and a
+  // logger thread passes them to the listeners in the order they were logged. Logging then never
+  // waits on the listeners, unless the ring of the thread is full.
+  struct LogRing;
+
 private:
   struct LogContainer
   {
@@ -70,6 +82,13 @@ private:
   LogManager();
   ~LogManager();
 
+  // Updates g_enabled_log_types
+  void UpdateEnabledLogTypes();
+  void LogAsync(LogTypes::LOG_LEVELS level, const char* header, const char* msg);
+  std::shared_ptr<LogRing> AcquireRing();
+  void LoggerThread();
+  void DrainRings();
+
   LogManager(const LogManager&) = delete;
   LogManager& operator=(const LogManager&) = delete;
   LogManager(LogManager&&) = delete;
@@ -80,4 +99,15 @@ private:
   std::array<LogListener*, LogListener::NUMBER_OF_LISTENERS> m_listeners;
   BitSet32 m_listener_ids;
   size_t m_path_cutoff_point = 0;
+
+  bool m_async = false;
+  u32 m_generation = 0;
+  std::thread m_thread;
+  Common::Flag m_running;
+  Common::Event m_drain_event;
+  std::atomic<u64> m_sequence{0};
+  std::mutex m_rings_mutex;
+  std::vector<std::shared_ptr<LogRing>> m_rings;
+  // Held by the logger thread while it calls the listeners, so they can be unregistered safely
+  std::mutex m_listeners_mutex;
 };
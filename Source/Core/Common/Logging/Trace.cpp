@@ -0,0 +1,199 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Common/Logging/Trace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/File.h"
+#include "Common/StringUtil.h"
+
+namespace Trace
+{
+std::atomic<int> g_num_recorders{0};
+thread_local u32 Scope::s_depth = 0;
+
+// Enough for a few seconds of the busiest threads, with CoreTiming and the vertex loader recorded
+// many thousand times per second. Memory is only allocated as events are recorded.
+static constexpr size_t MAX_EVENTS_PER_THREAD = 1 << 18;
+
+namespace
+{
+struct ThreadBuffer
+{
+  std::mutex lock;
+  const char* name = nullptr;
+  u32 id = 0;
+  // Ring buffer, in the order the scopes ended, which is also the order of their end times.
+  std::vector<Event> events;
+  size_t num_recorded = 0;
+};
+}  // Anonymous namespace
+
+static std::mutex s_threads_lock;
+static std::vector<std::shared_ptr<ThreadBuffer>> s_threads;
+static u32 s_next_thread_id = 0;
+static thread_local std::shared_ptr<ThreadBuffer> s_thread_buffer;
+
+static ThreadBuffer* GetThreadBuffer()
+{
+  if (!s_thread_buffer)
+  {
+    s_thread_buffer = std::make_shared<ThreadBuffer>();
+    std::lock_guard<std::mutex> guard(s_threads_lock);
+    s_thread_buffer->id = s_next_thread_id++;
+    s_threads.push_back(s_thread_buffer);
+  }
+
+  return s_thread_buffer.get();
+}
+
+void BeginRecording()
+{
+  std::lock_guard<std::mutex> guard(s_threads_lock);
+  if (g_num_recorders.load(std::memory_order_relaxed) == 0)
+  {
+    // Forget the threads which have exited.
+    s_threads.erase(std::remove_if(s_threads.begin(), s_threads.end(),
+                                   [](const std::shared_ptr<ThreadBuffer>& buffer) {
+                                     return buffer.use_count() == 1;
+                                   }),
+                    s_threads.end());
+
+    for (const auto& buffer : s_threads)
+    {
+      std::lock_guard<std::mutex> buffer_guard(buffer->lock);
+      buffer->events.clear();
+      buffer->num_recorded = 0;
+    }
+  }
+
+  g_num_recorders.fetch_add(1, std::memory_order_relaxed);
+}
+
+void EndRecording()
+{
+  std::lock_guard<std::mutex> guard(s_threads_lock);
+  g_num_recorders.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void SetThreadName(const char* name)
+{
+  ThreadBuffer* buffer = GetThreadBuffer();
+  std::lock_guard<std::mutex> guard(buffer->lock);
+  buffer->name = name;
+}
+
+u64 GetTimestamp()
+{
+  return static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              std::chrono::steady_clock::now().time_since_epoch())
+                              .count());
+}
+
+static void Record(const Event& event)
+{
+  ThreadBuffer* buffer = GetThreadBuffer();
+  std::lock_guard<std::mutex> guard(buffer->lock);
+  if (buffer->events.size() < MAX_EVENTS_PER_THREAD)
+    buffer->events.push_back(event);
+  else
+    buffer->events[buffer->num_recorded % MAX_EVENTS_PER_THREAD] = event;
+  buffer->num_recorded++;
+}
+
+void RecordScope(const char* name, u64 start, u64 end, u32 depth)
+{
+  Record({name, start, end, depth, false});
+}
+
+void RecordInstant(const char* name)
+{
+  const u64 now = GetTimestamp();
+  Record({name, now, now, 0, true});
+}
+
+std::vector<ThreadEvents> CollectEvents(u64 since)
+{
+  std::vector<ThreadEvents> threads;
+
+  std::lock_guard<std::mutex> guard(s_threads_lock);
+  for (const auto& buffer : s_threads)
+  {
+    std::lock_guard<std::mutex> buffer_guard(buffer->lock);
+    ThreadEvents thread;
+    thread.thread_name = buffer->name ? buffer->name : StringFromFormat("Thread %u", buffer->id);
+    thread.thread_id = buffer->id;
+
+    const size_t count = buffer->events.size();
+    for (size_t i = 0; i < count; i++)
+    {
+      const Event& event = buffer->events[(buffer->num_recorded - 1 - i) % count];
+      if (event.end < since)
+        break;
+      thread.events.push_back(event);
+    }
+
+    threads.push_back(std::move(thread));
+  }
+
+  return threads;
+}
+
+bool WriteChromeTrace(const std::string& path, u64 since)
+{
+  const std::vector<ThreadEvents> threads = CollectEvents(since);
+
+  // Timestamps are in microseconds, relative to the first event.
+  u64 base_time = std::numeric_limits<u64>::max();
+  for (const ThreadEvents& thread : threads)
+  {
+    if (!thread.events.empty())
+      base_time = std::min(base_time, std::max(thread.events.back().start, since));
+  }
+
+  std::string json = "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+  for (const ThreadEvents& thread : threads)
+  {
+    json += StringFromFormat("{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 0, \"tid\": %u, "
+                             "\"args\": {\"name\": \"%s\"}},\n",
+                             thread.thread_id, thread.thread_name.c_str());
+
+    for (const Event& event : thread.events)
+    {
+      if (event.start < since)
+        continue;
+
+      if (event.instant)
+      {
+        json += StringFromFormat("{\"name\": \"%s\", \"ph\": \"i\", \"s\": \"g\", \"pid\": 0, "
+                                 "\"tid\": %u, \"ts\": %.3f},\n",
+                                 event.name, thread.thread_id, (event.start - base_time) / 1000.0);
+      }
+      else
+      {
+        json += StringFromFormat("{\"name\": \"%s\", \"ph\": \"X\", \"pid\": 0, \"tid\": %u, "
+                                 "\"ts\": %.3f, \"dur\": %.3f},\n",
+                                 event.name, thread.thread_id, (event.start - base_time) / 1000.0,
+                                 (event.end - event.start) / 1000.0);
+      }
+    }
+  }
+
+  // Replace the trailing comma.
+  if (!threads.empty())
+    json.erase(json.size() - 2);
+  json += "\n]}\n";
+
+  File::IOFile file(path, "wb");
+  return file && file.WriteBytes(json.data(), json.size());
+}
+}  // namespace Trace
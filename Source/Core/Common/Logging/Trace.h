@@ -0,0 +1,102 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+// Timeline tracing across all emulator threads. Every thread records the scopes it leaves into its
+// own ring buffer, which only costs a clock read and an uncontended lock per scope while
+// recording, and a relaxed atomic load otherwise. Recordings are exported in the Chrome trace
+// event format (chrome://tracing, or https://ui.perfetto.dev).
+
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace Trace
+{
+struct Event
+{
+  // Names are string literals, as only the pointer is recorded.
+  const char* name;
+  u64 start;
+  u64 end;
+  u32 depth;
+  bool instant;
+};
+
+struct ThreadEvents
+{
+  std::string thread_name;
+  u32 thread_id;
+  // Newest first.
+  std::vector<Event> events;
+};
+
+extern std::atomic<int> g_num_recorders;
+
+inline bool IsEnabled()
+{
+  return g_num_recorders.load(std::memory_order_relaxed) > 0;
+}
+
+// Recording runs for as long as anyone asked for it, so that the frame profiler and trace
+// captures can be used at the same time. Starting the first recording discards the old events.
+void BeginRecording();
+void EndRecording();
+
+// Names the calling thread in the trace. Names must be string literals.
+void SetThreadName(const char* name);
+
+u64 GetTimestamp();
+void RecordScope(const char* name, u64 start, u64 end, u32 depth);
+void RecordInstant(const char* name);
+
+// Copies the buffered events which ended after the given timestamp.
+std::vector<ThreadEvents> CollectEvents(u64 since = 0);
+
+bool WriteChromeTrace(const std::string& path, u64 since = 0);
+
+class Scope
+{
+public:
+  explicit Scope(const char* name) : m_name(IsEnabled() ? name : nullptr)
+  {
+    if (m_name)
+    {
+      m_depth = s_depth++;
+      m_start = GetTimestamp();
+    }
+  }
+
+  ~Scope()
+  {
+    if (m_name)
+    {
+      RecordScope(m_name, m_start, GetTimestamp(), m_depth);
+      s_depth--;
+    }
+  }
+
+  Scope(const Scope&) = delete;
+  Scope& operator=(const Scope&) = delete;
+
+private:
+  static thread_local u32 s_depth;
+
+  const char* m_name;
+  u64 m_start = 0;
+  u32 m_depth = 0;
+};
+}  // namespace Trace
+
+#define TRACE_SCOPE(name) Trace::Scope trace_scope(name)
+
+#define TRACE_INSTANT(name)                                                                        \
+  do                                                                                               \
+  {                                                                                                \
+    if (Trace::IsEnabled())                                                                        \
+      Trace::RecordInstant(name);                                                                  \
+  } while (0)
@@ -2,10 +2,18 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <atomic>
+#include <cinttypes>
 #include <fstream>
 #include <functional>
 #include <mbedtls/md5.h>
+#include <memory>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <xxhash.h>
 
 #include "Common/MD5.h"
 #include "Common/StringUtil.h"
@@ -49,4 +57,91 @@ std::string MD5Sum(const std::string& file_path, std::function<bool(int)> report
 
   return output_string;
 }
+
+// A multiple of the block sizes of the compressed formats, so every thread decompresses whole
+// blocks.
+static constexpr u64 TREE_HASH_CHUNK_SIZE = 8 * 1024 * 1024;
+static constexpr unsigned int MAX_TREE_HASH_THREADS = 8;
+
+std::string TreeHashSum(const std::string& file_path, std::function<bool(int)> report_progress)
+{
+  std::unique_ptr<DiscIO::BlobReader> file(DiscIO::CreateBlobReader(file_path));
+  if (!file)
+    return "";
+
+  const u64 game_size = file->GetDataSize();
+  const u64 chunk_count = (game_size + TREE_HASH_CHUNK_SIZE - 1) / TREE_HASH_CHUNK_SIZE;
+  const unsigned int thread_count = static_cast<unsigned int>(std::min<u64>(
+      std::clamp(std::thread::hardware_concurrency(), 1u, MAX_TREE_HASH_THREADS), chunk_count));
+
+  std::vector<u64> chunk_hashes(chunk_count);
+  std::atomic<u64> next_chunk{0};
+  std::atomic<u64> chunks_done{0};
+  std::atomic<bool> stop{false};
+  std::atomic<bool> failed{false};
+
+  // Blob readers aren't thread-safe, so each thread has its own. Chunks are handed out in
+  // order, which keeps the reads of all threads close together on the disk.
+  const auto hash_chunks = [&](DiscIO::BlobReader* reader, bool report) {
+    std::vector<u8> data(TREE_HASH_CHUNK_SIZE);
+    while (!stop)
+    {
+      const u64 chunk = next_chunk++;
+      if (chunk >= chunk_count)
+        break;
+
+      const u64 offset = chunk * TREE_HASH_CHUNK_SIZE;
+      const u64 size = std::min(TREE_HASH_CHUNK_SIZE, game_size - offset);
+      if (!reader || !reader->Read(offset, size, data.data()))
+      {
+        failed = true;
+        stop = true;
+        break;
+      }
+      chunk_hashes[chunk] = XXH64(data.data(), static_cast<size_t>(size), 0);
+
+      const u64 done = ++chunks_done;
+      if (report && !report_progress(static_cast<int>(done * 100 / chunk_count)))
+        stop = true;
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (unsigned int i = 1; i < thread_count; i++)
+  {
+    threads.emplace_back([&] {
+      std::unique_ptr<DiscIO::BlobReader> reader(DiscIO::CreateBlobReader(file_path));
+      hash_chunks(reader.get(), false);
+    });
+  }
+  // The calling thread reports the progress, as report_progress may not be thread-safe.
+  hash_chunks(file.get(), true);
+  for (std::thread& thread : threads)
+    thread.join();
+
+  if (failed || chunks_done != chunk_count || !report_progress(100))
+    return "";
+
+  // Hash the hashes as little endian, so the result doesn't depend on the host
+  std::vector<u8> hashes(chunk_count * sizeof(u64));
+  for (u64 i = 0; i < chunk_count; i++)
+  {
+    for (u64 byte = 0; byte < sizeof(u64); byte++)
+      hashes[i * sizeof(u64) + byte] = static_cast<u8>(chunk_hashes[i] >> (byte * 8));
+  }
+  return StringFromFormat("%016" PRIx64, XXH64(hashes.data(), hashes.size(), 0));
+}
+
+std::string HashSum(HashFunction function, const std::string& file_name,
+                    std::function<bool(int)> progress)
+{
+  switch (function)
+  {
+  case HashFunction::XXH64Tree:
+    return TreeHashSum(file_name, std::move(progress));
+  case HashFunction::MD5:
+  default:
+    return MD5Sum(file_name, std::move(progress));
+  }
+}
 }
\ No newline at end of file
@@ -7,7 +7,20 @@
 #include <functional>
 #include <string>
 
+#include "Common/CommonTypes.h"
+
 namespace MD5
 {
+enum class HashFunction : u8
+{
+  MD5,
+  // XXH64 of every 8 MiB of data, then XXH64 of those hashes. Unlike MD5, the chunks can be
+  // hashed on several threads.
+  XXH64Tree,
+};
+
 std::string MD5Sum(const std::string& file_name, std::function<bool(int)> progress);
-}
\ No newline at end of file
+std::string TreeHashSum(const std::string& file_name, std::function<bool(int)> progress);
+std::string HashSum(HashFunction function, const std::string& file_name,
+                    std::function<bool(int)> progress);
+}
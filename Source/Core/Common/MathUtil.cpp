@@ -8,8 +8,13 @@
 #include <numeric>
 
 #include "Common/CommonTypes.h"
+#include "Common/Intrinsics.h"
 #include "Common/MathUtil.h"
 
+#ifdef _M_ARM_64
+#include <arm_neon.h>
+#endif
+
 namespace MathUtil
 {
 u32 ClassifyDouble(double dvalue)
@@ -235,6 +240,47 @@ inline void MatrixMul(int n, const float* a, const float* b, float* result)
   }
 }
 
+// result = a * b, for 4x4 row-major matrices. Each row of the result is the sum of the rows of b,
+// weighted by the elements of the same row of a, which maps directly onto 4-wide vectors. The
+// sums are made in the same order as MatrixMul, so both give the same results. result may be a
+// or b.
+static void MatrixMul4(const float* a, const float* b, float* result)
+{
+#if defined(_M_X86)
+  const __m128 b0 = _mm_loadu_ps(b);
+  const __m128 b1 = _mm_loadu_ps(b + 4);
+  const __m128 b2 = _mm_loadu_ps(b + 8);
+  const __m128 b3 = _mm_loadu_ps(b + 12);
+  for (int i = 0; i < 4; ++i)
+  {
+    const float* row = a + i * 4;
+    __m128 sum = _mm_mul_ps(_mm_set1_ps(row[0]), b0);
+    sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(row[1]), b1));
+    sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(row[2]), b2));
+    sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(row[3]), b3));
+    _mm_storeu_ps(result + i * 4, sum);
+  }
+#elif defined(_M_ARM_64)
+  const float32x4_t b0 = vld1q_f32(b);
+  const float32x4_t b1 = vld1q_f32(b + 4);
+  const float32x4_t b2 = vld1q_f32(b + 8);
+  const float32x4_t b3 = vld1q_f32(b + 12);
+  for (int i = 0; i < 4; ++i)
+  {
+    const float* row = a + i * 4;
+    float32x4_t sum = vmulq_n_f32(b0, row[0]);
+    sum = vaddq_f32(sum, vmulq_n_f32(b1, row[1]));
+    sum = vaddq_f32(sum, vmulq_n_f32(b2, row[2]));
+    sum = vaddq_f32(sum, vmulq_n_f32(b3, row[3]));
+    vst1q_f32(result + i * 4, sum);
+  }
+#else
+  float temp[16];
+  MatrixMul(4, a, b, temp);
+  std::memcpy(result, temp, sizeof(temp));
+#endif
+}
+
 // Calculate sum of a float list
 float MathFloatVectorSum(const std::vector<float>& Vec)
 {
@@ -514,7 +560,7 @@ void Matrix44::Scale(Matrix44& mtx, const float vec[3])
 
 void Matrix44::Multiply(const Matrix44& a, const Matrix44& b, Matrix44& result)
 {
-  MatrixMul(4, a.data, b.data, result.data);
+  MatrixMul4(a.data, b.data, result.data);
 }
 
 void Matrix44::Multiply(const Matrix44& a, const float vec[3], float result[3])
@@ -539,7 +585,7 @@ void Matrix44::Multiply(const Matrix44& a, const float vec[3], float result[3])
 Matrix44 Matrix44::operator*(const Matrix44& rhs) const
 {
   Matrix44 result;
-  MatrixMul(4, rhs.data, this->data, result.data);
+  MatrixMul4(rhs.data, this->data, result.data);
   return result;
 }
 
@@ -6,6 +6,7 @@
 #include <cstdlib>
 #include <string>
 
+#include "Common/Align.h"
 #include "Common/CommonFuncs.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
@@ -19,6 +20,7 @@
 #include <stdio.h>
 #include <sys/mman.h>
 #include <sys/types.h>
+#include <unistd.h>
 #if defined __APPLE__ || defined __FreeBSD__ || defined __OpenBSD__
 #include <sys/sysctl.h>
 #elif defined __HAIKU__
@@ -181,4 +183,25 @@ size_t MemPhysical()
 #endif
 }
 
+size_t PageSize()
+{
+#ifdef _WIN32
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  return info.dwPageSize;
+#else
+  return static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+void AdviseHugePages(void* ptr, size_t size)
+{
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  const uintptr_t start = AlignUp(reinterpret_cast<uintptr_t>(ptr), HUGE_PAGE_SIZE);
+  const uintptr_t end = AlignDown(reinterpret_cast<uintptr_t>(ptr) + size, HUGE_PAGE_SIZE);
+  if (start < end && madvise(reinterpret_cast<void*>(start), end - start, MADV_HUGEPAGE) != 0)
+    WARN_LOG(COMMON, "madvise(MADV_HUGEPAGE) failed: %s", LastStrerrorString().c_str());
+#endif
+}
+
 }  // namespace Common
@@ -18,5 +18,13 @@ void ReadProtectMemory(void* ptr, size_t size);
 void WriteProtectMemory(void* ptr, size_t size, bool executable = false);
 void UnWriteProtectMemory(void* ptr, size_t size, bool allowExecute = false);
 size_t MemPhysical();
+// The granularity of the *ProtectMemory functions.
+size_t PageSize();
+
+constexpr size_t HUGE_PAGE_SIZE = 0x200000;
+// Asks for the aligned huge pages in the range to be backed by huge pages, which saves TLB misses
+// on memory accessed all over the place. Only supported with transparent huge pages on Linux,
+// elsewhere this does nothing. Shared memory needs shmem_enabled to be advise or always.
+void AdviseHugePages(void* ptr, size_t size);
 
 }  // namespace Common
@@ -0,0 +1,303 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Common/Metrics.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <mutex>
+
+#include "Common/File.h"
+#include "Common/StringUtil.h"
+#include "Common/Timer.h"
+
+namespace Metrics
+{
+namespace
+{
+struct Registry
+{
+  std::mutex mutex;
+  std::vector<Metric*> metrics;
+
+  std::vector<FrameSample> ring;
+  // Of the next sample in the ring, which is the oldest one once the ring is full.
+  size_t ring_position = 0;
+
+  File::IOFile csv;
+};
+
+// Constructed by the first metric, so it outlives all of them.
+Registry& GetRegistry()
+{
+  static Registry registry;
+  return registry;
+}
+
+void AddColumnNames(const Metric& metric, std::vector<std::string>* names)
+{
+  if (metric.GetType() == Type::Histogram)
+  {
+    names->push_back(std::string(metric.GetName()) + "_count");
+    names->push_back(std::string(metric.GetName()) + "_sum");
+  }
+  else
+  {
+    names->push_back(metric.GetName());
+  }
+}
+
+void AddValues(const Metric& metric, std::vector<double>* values)
+{
+  switch (metric.GetType())
+  {
+  case Type::Counter:
+    values->push_back(static_cast<double>(static_cast<const Counter&>(metric).GetValue()));
+    break;
+  case Type::Gauge:
+    values->push_back(static_cast<const Gauge&>(metric).GetValue());
+    break;
+  case Type::Histogram:
+  {
+    const Histogram& histogram = static_cast<const Histogram&>(metric);
+    values->push_back(static_cast<double>(histogram.GetCount()));
+    values->push_back(histogram.GetSum());
+    break;
+  }
+  }
+}
+
+const char* GetTypeName(Type type)
+{
+  switch (type)
+  {
+  case Type::Counter:
+    return "counter";
+  case Type::Gauge:
+    return "gauge";
+  case Type::Histogram:
+  default:
+    return "histogram";
+  }
+}
+
+std::vector<std::string> GetColumnNamesLocked(const Registry& registry)
+{
+  std::vector<std::string> names;
+  for (const Metric* metric : registry.metrics)
+    AddColumnNames(*metric, &names);
+  return names;
+}
+
+void WriteCSVHeader(Registry& registry)
+{
+  std::string header = "time_us";
+  for (const std::string& name : GetColumnNamesLocked(registry))
+    header += "," + name;
+  header += '\n';
+  registry.csv.WriteBytes(header.data(), header.size());
+}
+
+void WriteCSVRow(Registry& registry, const FrameSample& sample)
+{
+  std::string row = StringFromFormat("%" PRIu64, sample.time_us);
+  for (double value : sample.values)
+    row += StringFromFormat(",%.9g", value);
+  row += '\n';
+  registry.csv.WriteBytes(row.data(), row.size());
+}
+}  // Anonymous namespace
+
+Metric::Metric(Type type, const char* name, const char* help)
+    : m_type(type), m_name(name), m_help(help)
+{
+  Registry& registry = GetRegistry();
+  std::lock_guard<std::mutex> lk(registry.mutex);
+  registry.metrics.push_back(this);
+}
+
+Metric::~Metric()
+{
+  Registry& registry = GetRegistry();
+  std::lock_guard<std::mutex> lk(registry.mutex);
+  registry.metrics.erase(std::find(registry.metrics.begin(), registry.metrics.end(), this));
+}
+
+Histogram::Histogram(const char* name, const char* help, std::initializer_list<double> bounds)
+    : Metric(Type::Histogram, name, help), m_bounds(bounds),
+      m_buckets(new std::atomic<u64>[bounds.size() + 1])
+{
+  for (size_t i = 0; i <= m_bounds.size(); ++i)
+    m_buckets[i].store(0, std::memory_order_relaxed);
+}
+
+void Histogram::Observe(double value)
+{
+  const size_t bucket =
+      std::lower_bound(m_bounds.begin(), m_bounds.end(), value) - m_bounds.begin();
+  m_buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+  m_count.fetch_add(1, std::memory_order_relaxed);
+
+  double sum = m_sum.load(std::memory_order_relaxed);
+  while (!m_sum.compare_exchange_weak(sum, sum + value, std::memory_order_relaxed))
+  {
+  }
+}
+
+std::vector<u64> Histogram::GetBucketCounts() const
+{
+  std::vector<u64> counts(m_bounds.size() + 1);
+  for (size_t i = 0; i < counts.size(); ++i)
+    counts[i] = m_buckets[i].load(std::memory_order_relaxed);
+  return counts;
+}
+
+std::vector<std::string> GetColumnNames()
+{
+  Registry& registry = GetRegistry();
+  std::lock_guard<std::mutex> lk(registry.mutex);
+  return GetColumnNamesLocked(registry);
+}
+
+void SampleFrame()
+{
+  Registry& registry = GetRegistry();
+  std::lock_guard<std::mutex> lk(registry.mutex);
+
+  if (registry.ring.size() < SAMPLE_RING_SIZE)
+    registry.ring.emplace_back();
+  FrameSample& sample = registry.ring[registry.ring_position];
+  registry.ring_position = (registry.ring_position + 1) % SAMPLE_RING_SIZE;
+
+  // Reuses the storage of the sample it replaces.
+  sample.time_us = Common::Timer::GetTimeUs();
+  sample.values.clear();
+  for (const Metric* metric : registry.metrics)
+    AddValues(*metric, &sample.values);
+
+  if (registry.csv.IsOpen())
+    WriteCSVRow(registry, sample);
+}
+
+std::vector<FrameSample> GetRecentFrames()
+{
+  Registry& registry = GetRegistry();
+  std::lock_guard<std::mutex> lk(registry.mutex);
+
+  std::vector<FrameSample> samples;
+  samples.reserve(registry.ring.size());
+  const size_t start = registry.ring.size() < SAMPLE_RING_SIZE ? 0 : registry.ring_position;
+  for (size_t i = 0; i < registry.ring.size(); ++i)
+    samples.push_back(registry.ring[(start + i) % registry.ring.size()]);
+  return samples;
+}
+
+bool SetCSVPath(const std::string& path)
+{
+  Registry& registry = GetRegistry();
+  std::lock_guard<std::mutex> lk(registry.mutex);
+
+  registry.csv.Close();
+  if (path.empty())
+    return true;
+
+  if (!registry.csv.Open(path, "w"))
+    return false;
+  WriteCSVHeader(registry);
+  return true;
+}
+
+std::string FormatText()
+{
+  Registry& registry = GetRegistry();
+  std::lock_guard<std::mutex> lk(registry.mutex);
+
+  const size_t count = registry.ring.size();
+  if (count == 0)
+    return "";
+
+  const std::vector<std::string> names = GetColumnNamesLocked(registry);
+  const FrameSample& last = registry.ring[(registry.ring_position + count - 1) % count];
+  if (last.values.size() != names.size())
+    return "";
+  const FrameSample* previous =
+      count > 1 ? &registry.ring[(registry.ring_position + count - 2) % count] : nullptr;
+  if (previous && previous->values.size() != names.size())
+    previous = nullptr;
+
+  std::string text = "Metrics:\n";
+  size_t column = 0;
+  for (const Metric* metric : registry.metrics)
+  {
+    const double value = last.values[column];
+    switch (metric->GetType())
+    {
+    case Type::Counter:
+      text += StringFromFormat("%s: %.0f", names[column].c_str(), value);
+      if (previous)
+        text += StringFromFormat(" (+%.0f)", value - previous->values[column]);
+      column++;
+      break;
+    case Type::Gauge:
+      text += StringFromFormat("%s: %.6g", names[column].c_str(), value);
+      column++;
+      break;
+    case Type::Histogram:
+    {
+      const double sum = last.values[column + 1];
+      text += StringFromFormat("%s: %.0f, mean %.6g", metric->GetName(), value,
+                               value > 0.0 ? sum / value : 0.0);
+      column += 2;
+      break;
+    }
+    }
+    text += '\n';
+  }
+  return text;
+}
+
+std::string FormatPrometheus()
+{
+  Registry& registry = GetRegistry();
+  std::lock_guard<std::mutex> lk(registry.mutex);
+
+  std::string text;
+  for (const Metric* metric : registry.metrics)
+  {
+    const char* name = metric->GetName();
+    text += StringFromFormat("# HELP %s %s\n# TYPE %s %s\n", name, metric->GetHelp(), name,
+                             GetTypeName(metric->GetType()));
+
+    switch (metric->GetType())
+    {
+    case Type::Counter:
+      text += StringFromFormat("%s %" PRIu64 "\n", name,
+                               static_cast<const Counter*>(metric)->GetValue());
+      break;
+    case Type::Gauge:
+      text += StringFromFormat("%s %.9g\n", name, static_cast<const Gauge*>(metric)->GetValue());
+      break;
+    case Type::Histogram:
+    {
+      const Histogram* histogram = static_cast<const Histogram*>(metric);
+      const std::vector<u64> counts = histogram->GetBucketCounts();
+      // Prometheus buckets count everything up to their bound.
+      u64 cumulative = 0;
+      for (size_t i = 0; i < histogram->GetBounds().size(); ++i)
+      {
+        cumulative += counts[i];
+        text += StringFromFormat("%s_bucket{le=\"%.9g\"} %" PRIu64 "\n", name,
+                                 histogram->GetBounds()[i], cumulative);
+      }
+      cumulative += counts.back();
+      text += StringFromFormat("%s_bucket{le=\"+Inf\"} %" PRIu64 "\n", name, cumulative);
+      text += StringFromFormat("%s_sum %.9g\n%s_count %" PRIu64 "\n", name, histogram->GetSum(),
+                               name, cumulative);
+      break;
+    }
+    }
+  }
+  return text;
+}
+}  // namespace Metrics
@@ -0,0 +1,128 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+// Counters, gauges and histograms which the emulator updates as it runs, so that it can be
+// monitored without attaching tools. Each module keeps its metrics as static objects, which
+// register themselves when constructed and are expected to live for the whole run. Updates are
+// relaxed atomic operations without locks, cheap enough for paths such as draws and block compiles.
+//
+// Once per frame, SampleFrame copies all values into a ring of the recent frames, and into a CSV
+// file if one is open. The values can also be formatted as text for the OSD, and in the Prometheus
+// text exposition format.
+
+#pragma once
+
+#include <atomic>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace Metrics
+{
+enum class Type
+{
+  Counter,
+  Gauge,
+  Histogram,
+};
+
+class Metric
+{
+public:
+  Metric(const Metric&) = delete;
+  Metric& operator=(const Metric&) = delete;
+
+  Type GetType() const { return m_type; }
+  // Following the Prometheus conventions: snake case, with the unit as a suffix, and _total at the
+  // end of counters.
+  const char* GetName() const { return m_name; }
+  const char* GetHelp() const { return m_help; }
+
+protected:
+  Metric(Type type, const char* name, const char* help);
+  ~Metric();
+
+private:
+  Type m_type;
+  const char* m_name;
+  const char* m_help;
+};
+
+// Only goes up.
+class Counter final : public Metric
+{
+public:
+  Counter(const char* name, const char* help) : Metric(Type::Counter, name, help) {}
+
+  void Increment(u64 amount = 1) { m_value.fetch_add(amount, std::memory_order_relaxed); }
+  u64 GetValue() const { return m_value.load(std::memory_order_relaxed); }
+
+private:
+  std::atomic<u64> m_value{0};
+};
+
+class Gauge final : public Metric
+{
+public:
+  Gauge(const char* name, const char* help) : Metric(Type::Gauge, name, help) {}
+
+  void Set(double value) { m_value.store(value, std::memory_order_relaxed); }
+  double GetValue() const { return m_value.load(std::memory_order_relaxed); }
+
+private:
+  std::atomic<double> m_value{0.0};
+};
+
+class Histogram final : public Metric
+{
+public:
+  // The bounds are the inclusive upper bounds of the buckets, in increasing order. Values above
+  // the last one go to a last bucket without a bound.
+  Histogram(const char* name, const char* help, std::initializer_list<double> bounds);
+
+  void Observe(double value);
+
+  const std::vector<double>& GetBounds() const { return m_bounds; }
+  // The count of each bucket, not including the ones before it.
+  std::vector<u64> GetBucketCounts() const;
+  u64 GetCount() const { return m_count.load(std::memory_order_relaxed); }
+  double GetSum() const { return m_sum.load(std::memory_order_relaxed); }
+
+private:
+  std::vector<double> m_bounds;
+  std::unique_ptr<std::atomic<u64>[]> m_buckets;
+  std::atomic<u64> m_count{0};
+  std::atomic<double> m_sum{0.0};
+};
+
+// The values of all metrics at the end of a frame, in the order of GetColumnNames.
+struct FrameSample
+{
+  u64 time_us;
+  std::vector<double> values;
+};
+
+// Number of frames kept in the ring.
+constexpr size_t SAMPLE_RING_SIZE = 600;
+
+// A column per counter and gauge, and a _count and a _sum column per histogram.
+std::vector<std::string> GetColumnNames();
+
+// Called once per frame.
+void SampleFrame();
+// Oldest first.
+std::vector<FrameSample> GetRecentFrames();
+
+// Writes the column names, then a row per sampled frame, to the file at the path. An empty path
+// closes the file.
+bool SetCSVPath(const std::string& path);
+
+// The latest sample, with the change since the frame before it for counters.
+std::string FormatText();
+// The current values.
+std::string FormatPrometheus();
+}  // namespace Metrics
@@ -0,0 +1,72 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+// A value written by one thread and read by any number of others, which never block the writer.
+//
+// * Store(value): publishes a new value, only one thread may call it
+// * Load(): returns the last published value, retrying if it was being written meanwhile
+//
+// The value is kept in atomic words, so that reading it during a write is merely detected and
+// retried rather than a data race. T must be trivially copyable, and is best kept small.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+
+#include "Common/CommonTypes.h"
+
+namespace Common
+{
+template <typename T>
+class SeqLock final
+{
+  static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+
+public:
+  SeqLock() { Store(T{}); }
+  explicit SeqLock(const T& value) { Store(value); }
+
+  void Store(const T& value)
+  {
+    std::array<u32, WORDS> words{};
+    std::memcpy(words.data(), &value, sizeof(T));
+
+    // An odd sequence tells the readers that a write is in progress
+    const u32 sequence = m_sequence.load(std::memory_order_relaxed);
+    m_sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < WORDS; ++i)
+      m_words[i].store(words[i], std::memory_order_relaxed);
+    m_sequence.store(sequence + 2, std::memory_order_release);
+  }
+
+  T Load() const
+  {
+    std::array<u32, WORDS> words;
+    u32 before, after;
+    do
+    {
+      before = m_sequence.load(std::memory_order_acquire);
+      for (size_t i = 0; i < WORDS; ++i)
+        words[i] = m_words[i].load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      after = m_sequence.load(std::memory_order_relaxed);
+    } while ((before & 1) != 0 || before != after);
+
+    T value;
+    std::memcpy(&value, words.data(), sizeof(T));
+    return value;
+  }
+
+private:
+  static constexpr size_t WORDS = (sizeof(T) + sizeof(u32) - 1) / sizeof(u32);
+
+  std::atomic<u32> m_sequence{0};
+  std::array<std::atomic<u32>, WORDS> m_words;
+};
+
+}  // namespace Common
@@ -9,6 +9,8 @@
 #ifdef _WIN32
 #include <windows.h>
 #else
+#include <pthread.h>
+#include <sched.h>
 #include <unistd.h>
 #endif
 
@@ -61,6 +63,16 @@ void SwitchCurrentThread()
   SwitchToThread();
 }
 
+void SetCurrentThreadHighPriority()
+{
+  SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_HIGHEST);
+}
+
+void SetCurrentThreadLowPriority()
+{
+  SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_LOWEST);
+}
+
 // Sets the debugger-visible name of the current thread.
 // Uses trick documented in:
 // https://docs.microsoft.com/en-us/visualstudio/debugger/how-to-set-a-thread-name-in-native-code
@@ -129,6 +141,26 @@ void SwitchCurrentThread()
   usleep(1000 * 1);
 }
 
+void SetCurrentThreadHighPriority()
+{
+  // Real-time scheduling usually needs extra privileges. If we don't have them, the thread just
+  // keeps its normal priority.
+  sched_param param = {};
+  param.sched_priority = sched_get_priority_min(SCHED_RR);
+  pthread_setschedparam(pthread_self(), SCHED_RR, &param);
+}
+
+void SetCurrentThreadLowPriority()
+{
+  sched_param param = {};
+#ifdef SCHED_IDLE
+  pthread_setschedparam(pthread_self(), SCHED_IDLE, &param);
+#else
+  param.sched_priority = sched_get_priority_min(SCHED_OTHER);
+  pthread_setschedparam(pthread_self(), SCHED_OTHER, &param);
+#endif
+}
+
 void SetCurrentThreadName(const char* szThreadName)
 {
 #ifdef __APPLE__
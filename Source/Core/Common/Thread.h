@@ -26,6 +26,13 @@ void SetCurrentThreadAffinity(u32 mask);
 void SleepCurrentThread(int ms);
 void SwitchCurrentThread();  // On Linux, this is equal to sleep 1ms
 
+// Asks the OS to schedule the current thread ahead of normal threads, for work with hard display
+// deadlines. Best effort: this silently does nothing if the process isn't allowed to do it.
+void SetCurrentThreadHighPriority();
+// Asks the OS to only schedule the current thread when the cores have nothing else to do, for
+// background work that has no deadline.
+void SetCurrentThreadLowPriority();
+
 // Use this function during a spin-wait to make the current thread
 // relax while another thread is working. This may be more efficient
 // than using events because event functions use kernel calls.
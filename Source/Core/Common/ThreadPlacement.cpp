@@ -0,0 +1,138 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Common/ThreadPlacement.h"
+
+#include <mutex>
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "Common/CPUDetect.h"
+#include "Common/Thread.h"
+#include "Common/ThreadPool.h"
+
+namespace Common
+{
+static std::mutex s_placement_lock;
+static ThreadPlacement s_placement;
+// The OS ids of the CPU and GPU threads, 0 until they have called PlaceCurrentThread.
+static int s_cpu_thread_id = 0;
+static int s_gpu_thread_id = 0;
+
+ThreadPlacement ChooseThreadPlacement(const std::vector<u32>& core_masks,
+                                      const std::vector<u32>& cache_masks,
+                                      u32 performance_core_mask, bool dual_core)
+{
+  u32 all_cores = 0;
+  for (u32 core : core_masks)
+    all_cores |= core;
+  if (performance_core_mask == 0)
+    performance_core_mask = all_cores;
+
+  // Without cache information, all cores are assumed to share one.
+  std::vector<u32> caches = cache_masks;
+  if (caches.empty())
+    caches.push_back(all_cores);
+
+  // The performance cores under the cache that has the most of them.
+  std::vector<u32> best_cores;
+  for (u32 cache : caches)
+  {
+    std::vector<u32> cores;
+    for (u32 core : core_masks)
+    {
+      if ((core & cache) == core && (core & performance_core_mask) == core)
+        cores.push_back(core);
+    }
+    if (cores.size() > best_cores.size())
+      best_cores = std::move(cores);
+  }
+
+  const size_t needed = dual_core ? 2 : 1;
+  if (best_cores.size() < needed)
+    return {};
+
+  // The last cores are taken, as the OS tends to put interrupts and other work on the first ones.
+  ThreadPlacement placement;
+  placement.cpu_thread = best_cores[best_cores.size() - 1];
+  placement.gpu_thread = best_cores[best_cores.size() - needed];
+  placement.helpers = all_cores & ~(placement.cpu_thread | placement.gpu_thread);
+  if (placement.helpers == 0)
+    return {};
+  return placement;
+}
+
+void SetThreadPlacement(const ThreadPlacement& placement)
+{
+  {
+    std::lock_guard<std::mutex> lk(s_placement_lock);
+    s_placement = placement;
+  }
+  if (placement.helpers != 0)
+    ThreadPool::GetShared().SetAffinityMask(placement.helpers);
+}
+
+void ResetThreadPlacement()
+{
+  bool was_placed;
+  {
+    std::lock_guard<std::mutex> lk(s_placement_lock);
+    was_placed = s_placement.helpers != 0;
+    s_placement = {};
+    s_cpu_thread_id = 0;
+    s_gpu_thread_id = 0;
+  }
+  if (!was_placed)
+    return;
+
+  u32 all_cores = 0;
+  for (u32 core : cpu_info.core_masks)
+    all_cores |= core;
+  ThreadPool::GetShared().SetAffinityMask(all_cores);
+}
+
+std::vector<int> GetEmulationThreadIds()
+{
+  std::lock_guard<std::mutex> lk(s_placement_lock);
+  std::vector<int> ids;
+  if (s_cpu_thread_id != 0)
+    ids.push_back(s_cpu_thread_id);
+  if (s_gpu_thread_id != 0 && s_gpu_thread_id != s_cpu_thread_id)
+    ids.push_back(s_gpu_thread_id);
+  return ids;
+}
+
+void PlaceCurrentThread(ThreadRole role)
+{
+#ifdef __linux__
+  const int thread_id = static_cast<int>(syscall(SYS_gettid));
+#else
+  const int thread_id = 0;
+#endif
+
+  u32 mask;
+  {
+    std::lock_guard<std::mutex> lk(s_placement_lock);
+    switch (role)
+    {
+    case ThreadRole::CPU:
+      mask = s_placement.cpu_thread;
+      s_cpu_thread_id = thread_id;
+      break;
+    case ThreadRole::GPU:
+      mask = s_placement.gpu_thread;
+      s_gpu_thread_id = thread_id;
+      break;
+    default:
+      mask = s_placement.helpers;
+      break;
+    }
+  }
+  if (mask != 0)
+    SetCurrentThreadAffinity(mask);
+}
+}  // namespace Common
@@ -0,0 +1,47 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+// Decides which cores the emulation threads run on. The CPU and GPU threads exchange a lot of
+// data, so they go to two performance cores that share a last level cache, and everything else
+// (the shared thread pool, audio) goes to the remaining cores so that it doesn't preempt them.
+
+namespace Common
+{
+enum class ThreadRole
+{
+  CPU,
+  GPU,
+  Helper,
+};
+
+// Affinity masks for each role. A mask of 0 leaves the threads to the OS.
+struct ThreadPlacement
+{
+  u32 cpu_thread = 0;
+  u32 gpu_thread = 0;
+  u32 helpers = 0;
+};
+
+// Picks cores from the topology in CPUInfo. The placement is empty if there aren't enough
+// performance cores under one cache for the emulation threads plus one core for the helpers.
+ThreadPlacement ChooseThreadPlacement(const std::vector<u32>& core_masks,
+                                      const std::vector<u32>& cache_masks,
+                                      u32 performance_core_mask, bool dual_core);
+
+// Makes the placement apply to threads calling PlaceCurrentThread, and to the shared pool.
+void SetThreadPlacement(const ThreadPlacement& placement);
+void ResetThreadPlacement();
+
+void PlaceCurrentThread(ThreadRole role);
+
+// The OS thread ids of the CPU and GPU threads which have called PlaceCurrentThread since the last
+// ResetThreadPlacement, for frontends to pass to the OS in performance hints. Only known on Linux.
+std::vector<int> GetEmulationThreadIds();
+}  // namespace Common
@@ -0,0 +1,190 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Common/ThreadPool.h"
+
+#include <algorithm>
+
+#include "Common/StringUtil.h"
+#include "Common/Thread.h"
+
+namespace Common
+{
+// The pool and the index of the worker running on the current thread, if any.
+static thread_local ThreadPool* s_current_pool = nullptr;
+static thread_local size_t s_current_worker = 0;
+
+ThreadPool::ThreadPool(u32 num_workers, u32 affinity_mask)
+{
+  if (num_workers == 0)
+    num_workers = std::max(2u, std::thread::hardware_concurrency()) - 1;
+
+  std::vector<u32> cores;
+  for (u32 i = 0; i < 32; i++)
+  {
+    if (affinity_mask & (1u << i))
+      cores.push_back(i);
+  }
+
+  m_workers.reserve(num_workers);
+  for (u32 i = 0; i < num_workers; i++)
+    m_workers.push_back(std::make_unique<Worker>());
+  for (u32 i = 0; i < num_workers; i++)
+  {
+    const u32 affinity = cores.empty() ? 0 : 1u << cores[i % cores.size()];
+    m_workers[i]->thread = std::thread(&ThreadPool::WorkerLoop, this, i, affinity);
+  }
+}
+
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lk(m_sleep_lock);
+    m_shutdown = true;
+  }
+  m_wakeup.notify_all();
+  for (auto& worker : m_workers)
+    worker->thread.join();
+}
+
+ThreadPool& ThreadPool::GetShared()
+{
+  static ThreadPool pool;
+  return pool;
+}
+
+void ThreadPool::Schedule(Task task, TaskPriority priority)
+{
+  // Tasks scheduled by a task stay on the same worker while it isn't busy, which keeps their data
+  // in the same cache. Everything else is spread over the workers.
+  const size_t index = s_current_pool == this ? s_current_worker :
+                                                m_next_worker++ % m_workers.size();
+  Worker& worker = *m_workers[index];
+  {
+    std::lock_guard<std::mutex> lk(worker.lock);
+    worker.queues[static_cast<size_t>(priority)].push_back(std::move(task));
+  }
+
+  {
+    std::lock_guard<std::mutex> lk(m_sleep_lock);
+    m_pending++;
+  }
+  m_wakeup.notify_one();
+}
+
+void ThreadPool::SetAffinityMask(u32 mask)
+{
+  m_affinity_mask = mask;
+}
+
+bool ThreadPool::RunPendingTask()
+{
+  Task task;
+  if (!TakeTask(s_current_pool == this ? s_current_worker : 0, &task))
+    return false;
+
+  task();
+  return true;
+}
+
+bool ThreadPool::TakeTask(size_t index, Task* task)
+{
+  if (m_pending == 0)
+    return false;
+
+  for (size_t priority = 0; priority < NUM_PRIORITIES; priority++)
+  {
+    // The newest task of the own queue, and the oldest one of the others.
+    for (size_t i = 0; i < m_workers.size(); i++)
+    {
+      Worker& worker = *m_workers[(index + i) % m_workers.size()];
+      std::lock_guard<std::mutex> lk(worker.lock);
+      std::deque<Task>& queue = worker.queues[priority];
+      if (queue.empty())
+        continue;
+
+      if (i == 0)
+      {
+        *task = std::move(queue.back());
+        queue.pop_back();
+      }
+      else
+      {
+        *task = std::move(queue.front());
+        queue.pop_front();
+      }
+      m_pending--;
+      return true;
+    }
+  }
+  return false;
+}
+
+void ThreadPool::WorkerLoop(size_t index, u32 affinity)
+{
+  SetCurrentThreadName(StringFromFormat("Worker %zu", index).c_str());
+  if (affinity != 0)
+    SetCurrentThreadAffinity(affinity);
+
+  s_current_pool = this;
+  s_current_worker = index;
+
+  u32 affinity_mask = 0;
+  while (true)
+  {
+    Task task;
+    if (TakeTask(index, &task))
+    {
+      if (m_affinity_mask != affinity_mask)
+      {
+        affinity_mask = m_affinity_mask;
+        SetCurrentThreadAffinity(affinity_mask);
+      }
+      task();
+      continue;
+    }
+
+    // Pending tasks are still run when shutting down.
+    std::unique_lock<std::mutex> lk(m_sleep_lock);
+    m_wakeup.wait(lk, [this] { return m_shutdown || m_pending != 0; });
+    if (m_shutdown && m_pending == 0)
+      return;
+  }
+}
+
+void TaskGroup::Schedule(ThreadPool::Task task, TaskPriority priority)
+{
+  {
+    std::lock_guard<std::mutex> lk(m_lock);
+    m_remaining++;
+  }
+  m_pool.Schedule(
+      [this, task = std::move(task)] {
+        task();
+        // Wait() can't return before the lock is released, so this is the last use of the group.
+        std::lock_guard<std::mutex> lk(m_lock);
+        if (--m_remaining == 0)
+          m_done.notify_all();
+      },
+      priority);
+}
+
+void TaskGroup::Wait()
+{
+  while (true)
+  {
+    {
+      std::lock_guard<std::mutex> lk(m_lock);
+      if (m_remaining == 0)
+        return;
+    }
+    if (!m_pool.RunPendingTask())
+      break;
+  }
+
+  // The rest of the tasks are running on the workers.
+  std::unique_lock<std::mutex> lk(m_lock);
+  m_done.wait(lk, [this] { return m_remaining == 0; });
+}
+}  // namespace Common
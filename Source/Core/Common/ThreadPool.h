@@ -0,0 +1,103 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+// A pool of worker threads shared by the subsystems that have short background jobs, so that they
+// don't each start their own threads and oversubscribe the cores.
+//
+// Every worker has its own queues, and takes work from the other workers once its own queues are
+// empty. Tasks of a higher priority are always taken before tasks of a lower priority, but there
+// is no order among tasks of the same priority.
+
+namespace Common
+{
+enum class TaskPriority
+{
+  High,
+  Normal,
+  Low,
+};
+
+class ThreadPool
+{
+public:
+  using Task = std::function<void()>;
+
+  // A num_workers of 0 uses one worker per core, minus the one the emulation runs on. If
+  // affinity_mask isn't 0, each worker is pinned to one of the cores in the mask, in order.
+  explicit ThreadPool(u32 num_workers = 0, u32 affinity_mask = 0);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  // The pool all of the emulator's background tasks should go to.
+  static ThreadPool& GetShared();
+
+  u32 GetWorkerCount() const { return static_cast<u32>(m_workers.size()); }
+  void Schedule(Task task, TaskPriority priority = TaskPriority::Normal);
+
+  // Moves all workers to the cores in the mask. They switch before their next task.
+  void SetAffinityMask(u32 mask);
+
+  // Runs one pending task on the calling thread. Returns false if there was none.
+  bool RunPendingTask();
+
+private:
+  static constexpr size_t NUM_PRIORITIES = 3;
+
+  struct Worker
+  {
+    std::mutex lock;
+    std::array<std::deque<Task>, NUM_PRIORITIES> queues;
+    std::thread thread;
+  };
+
+  void WorkerLoop(size_t index, u32 affinity);
+  bool TakeTask(size_t index, Task* task);
+
+  std::vector<std::unique_ptr<Worker>> m_workers;
+  std::atomic<size_t> m_pending{0};
+  std::atomic<size_t> m_next_worker{0};
+  std::atomic<u32> m_affinity_mask{0};
+
+  std::mutex m_sleep_lock;
+  std::condition_variable m_wakeup;
+  bool m_shutdown = false;
+};
+
+// A set of tasks that can be waited for together. The thread that waits helps out by running the
+// pending tasks of the pool, so waiting from inside a task can't run out of workers.
+class TaskGroup
+{
+public:
+  explicit TaskGroup(ThreadPool& pool = ThreadPool::GetShared()) : m_pool(pool) {}
+  ~TaskGroup() { Wait(); }
+
+  TaskGroup(const TaskGroup&) = delete;
+  TaskGroup& operator=(const TaskGroup&) = delete;
+
+  void Schedule(ThreadPool::Task task, TaskPriority priority = TaskPriority::Normal);
+  void Wait();
+
+private:
+  ThreadPool& m_pool;
+  std::mutex m_lock;
+  std::condition_variable m_done;
+  u32 m_remaining = 0;
+};
+}  // namespace Common
@@ -1,16 +1,27 @@
 // This file is public domain, in case it's useful to anyone. -comex
 
 // The central server implementation.
+//
+// Every thread has its own socket bound to the same port with SO_REUSEPORT, so the kernel spreads
+// the clients over the threads by their address. The hosts are in tables sharded by their host
+// ID, which every thread can look up, as a client connecting to a host may be handled by
+// another thread than the host. Outgoing packets belong to the thread that sent them, whose index
+// is in the low bits of their request ID so that the thread receiving their ack can find them.
+// Resends and expiries are scheduled in timer wheels rather than found by scanning the tables.
 #include <arpa/inet.h>
+#include <algorithm>
 #include <cerrno>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <fcntl.h>
+#include <memory>
+#include <mutex>
 #include <netinet/in.h>
 #include <sys/socket.h>
 #include <sys/time.h>
 #include <sys/types.h>
+#include <thread>
 #include <unistd.h>
 #include <unordered_map>
 #include <utility>
@@ -19,80 +30,88 @@
 
 #define DEBUG 0
 #define NUMBER_OF_TRIES 5
+#define MAX_SHARDS 256
+
+// recvmmsg is Linux only, and only Linux spreads the datagrams to a port over all sockets bound to
+// it with SO_REUSEPORT. Elsewhere the later sockets would get everything, so one thread is used.
+#if defined(__linux__) && defined(SO_REUSEPORT)
+#define USE_SHARDS 1
+#define RECV_BATCH_SIZE 32
+#else
+#define USE_SHARDS 0
+#define RECV_BATCH_SIZE 1
+#endif
 
-static u64 currentTime;
+static const u64 tickTime = 100000;        // 100ms
+static const u64 expiryTime = 30 * 1000000;  // 30s
+static const u64 resendTime = 300000;      // 300ms, times the number of tries
 
-struct OutgoingPacketInfo
+static thread_local u64 currentTime;
+static thread_local size_t currentShard;
+
+static u64 GetCurrentTime()
 {
-  TraversalPacket packet;
-  TraversalRequestId misc;
-  sockaddr_in6 dest;
-  int tries;
-  u64 sendTime;
-};
+  timeval tv;
+  if (gettimeofday(&tv, nullptr) < 0)
+  {
+    perror("gettimeofday");
+    exit(1);
+  }
+  return (u64)tv.tv_sec * 1000000 + tv.tv_usec;
+}
 
+// Values are scheduled in the slot of the tick they are due in, and handed back once the time of
+// that tick has passed. Times further away than the wheel spans are due in its last slot, so the
+// handlers check whether the value is really due and schedule it again if not.
 template <typename T>
-struct EvictEntry
+class TimerWheel
 {
-  u64 updateTime;
-  T value;
-};
+public:
+  explicit TimerWheel(size_t slotCount) : slots(slotCount) {}
 
-template <typename V>
-struct EvictFindResult
-{
-  bool found;
-  V* value;
-};
+  void Start(u64 time) { tick = time / tickTime; }
 
-template <typename K, typename V>
-EvictFindResult<V> EvictFind(std::unordered_map<K, EvictEntry<V>>& map, const K& key,
-                             bool refresh = false)
-{
-retry:
-  const u64 expiryTime = 30 * 1000000;  // 30s
-  EvictFindResult<V> result;
-  if (map.bucket_count())
+  void Schedule(u64 time, const T& value)
   {
-    auto bucket = map.bucket(key);
-    auto it = map.begin(bucket);
-    for (; it != map.end(bucket); ++it)
-    {
-      if (currentTime - it->second.updateTime > expiryTime)
-      {
-        map.erase(it->first);
-        goto retry;
-      }
-      if (it->first == key)
-      {
-        if (refresh)
-          it->second.updateTime = currentTime;
-        result.found = true;
-        result.value = &it->second.value;
-        return result;
-      }
-    }
+    u64 slotTick = std::max(time / tickTime, tick);
+    slotTick = std::min<u64>(slotTick, tick + slots.size() - 1);
+    slots[slotTick % slots.size()].push_back(value);
   }
-#if DEBUG
-  printf("failed to find key '");
-  for (size_t i = 0; i < sizeof(key); i++)
+
+  template <typename Function>
+  void Advance(u64 time, Function function)
   {
-    printf("%02x", ((u8*)&key)[i]);
+    while (tick <= time / tickTime)
+    {
+      due.swap(slots[tick % slots.size()]);
+      // What the handlers schedule is due in the next tick at the earliest.
+      ++tick;
+      for (const T& value : due)
+        function(value);
+      due.clear();
+    }
   }
-  printf("'\n");
-#endif
-  result.found = false;
-  return result;
-}
 
-template <typename K, typename V>
-V* EvictSet(std::unordered_map<K, EvictEntry<V>>& map, const K& key)
+private:
+  std::vector<std::vector<T>> slots;
+  std::vector<T> due;
+  u64 tick = 0;
+};
+
+struct OutgoingPacketInfo
 {
-  // can't use a local_iterator to emplace...
-  auto& result = map[key];
-  result.updateTime = currentTime;
-  return &result.value;
-}
+  TraversalPacket packet;
+  TraversalRequestId misc;
+  sockaddr_in6 dest;
+  int tries;
+  u64 sendTime;
+};
+
+struct HostEntry
+{
+  u64 updateTime;
+  TraversalInetAddress address;
+};
 
 namespace std
 {
@@ -101,16 +120,40 @@ struct hash<TraversalHostId>
 {
   size_t operator()(const TraversalHostId& id) const
   {
-    auto p = (u32*)id.data();
+    u32 p[2];
+    memcpy(p, id.data(), sizeof(p));
     return p[0] ^ ((p[1] << 13) | (p[1] >> 19));
   }
 };
 }
 
-static int sock;
+struct HostTable
+{
+  std::mutex lock;
+  std::unordered_map<TraversalHostId, HostEntry> hosts;
+  // Only advanced by the thread of the same index.
+  TimerWheel<TraversalHostId> expiries{512};
+};
+
+struct Shard
+{
+  int sock = -1;
+  std::mutex lock;
+  std::unordered_map<TraversalRequestId, OutgoingPacketInfo> outgoingPackets;
+  // Only used by the thread of the shard.
+  TimerWheel<TraversalRequestId> resends{64};
+  std::vector<TraversalRequestId> newPackets;
+};
+
 static int urandomFd;
-static std::unordered_map<TraversalRequestId, OutgoingPacketInfo> outgoingPackets;
-static std::unordered_map<TraversalHostId, EvictEntry<TraversalInetAddress>> connectedClients;
+static size_t numShards = 1;
+static std::unique_ptr<Shard[]> shards;
+static std::unique_ptr<HostTable[]> hostTables;
+
+static HostTable& GetHostTable(const TraversalHostId& hostId)
+{
+  return hostTables[std::hash<TraversalHostId>()(hostId) % numShards];
+}
 
 static TraversalInetAddress MakeInetAddress(const sockaddr_in6& addr)
 {
@@ -162,8 +205,8 @@ static sockaddr_in6 MakeSinAddr(const TraversalInetAddress& addr)
 
 static void GetRandomBytes(void* output, size_t size)
 {
-  static u8 bytes[8192];
-  static size_t bytesLeft = 0;
+  static thread_local u8 bytes[8192];
+  static thread_local size_t bytesLeft = 0;
   if (bytesLeft < size)
   {
     ssize_t rv = read(urandomFd, bytes, sizeof(bytes));
@@ -188,7 +231,7 @@ static void GetRandomHostId(TraversalHostId* hostId)
 
 static const char* SenderName(sockaddr_in6* addr)
 {
-  static char buf[INET6_ADDRSTRLEN + 10];
+  static thread_local char buf[INET6_ADDRSTRLEN + 10];
   inet_ntop(PF_INET6, &addr->sin6_addr, buf, sizeof(buf));
   sprintf(buf + strlen(buf), ":%d", ntohs(addr->sin6_port));
   return buf;
@@ -200,25 +243,34 @@ static void TrySend(const void* buffer, size_t size, sockaddr_in6* addr)
   printf("-> %d %llu %s\n", ((TraversalPacket*)buffer)->type,
          (long long)((TraversalPacket*)buffer)->requestId, SenderName(addr));
 #endif
-  if ((size_t)sendto(sock, buffer, size, 0, (sockaddr*)addr, sizeof(*addr)) != size)
+  if ((size_t)sendto(shards[currentShard].sock, buffer, size, 0, (sockaddr*)addr,
+                     sizeof(*addr)) != size)
   {
     perror("sendto");
   }
 }
 
-static TraversalPacket* AllocPacket(const sockaddr_in6& dest, TraversalRequestId misc = 0)
+// The packet is sent once the current packet has been handled. The shard must not be locked.
+static void AllocPacket(const sockaddr_in6& dest, const TraversalPacket& packet,
+                        TraversalRequestId misc = 0)
 {
+  Shard& shard = shards[currentShard];
   TraversalRequestId requestId;
-  GetRandomBytes(&requestId, sizeof(requestId));
-  OutgoingPacketInfo* info = &outgoingPackets[requestId];
+  std::lock_guard<std::mutex> lock(shard.lock);
+  do
+  {
+    GetRandomBytes(&requestId, sizeof(requestId));
+    requestId = (requestId & ~(TraversalRequestId)(MAX_SHARDS - 1)) | currentShard;
+  } while (shard.outgoingPackets.count(requestId));
+
+  OutgoingPacketInfo* info = &shard.outgoingPackets[requestId];
   info->dest = dest;
   info->misc = misc;
   info->tries = 0;
   info->sendTime = currentTime;
-  TraversalPacket* result = &info->packet;
-  memset(result, 0, sizeof(*result));
-  result->requestId = requestId;
-  return result;
+  info->packet = packet;
+  info->packet.requestId = requestId;
+  shard.newPackets.push_back(requestId);
 }
 
 static void SendPacket(OutgoingPacketInfo* info)
@@ -228,41 +280,95 @@ static void SendPacket(OutgoingPacketInfo* info)
   TrySend(&info->packet, sizeof(info->packet), &info->dest);
 }
 
+static void SendNewPackets()
+{
+  Shard& shard = shards[currentShard];
+  std::lock_guard<std::mutex> lock(shard.lock);
+  for (TraversalRequestId requestId : shard.newPackets)
+  {
+    auto it = shard.outgoingPackets.find(requestId);
+    if (it == shard.outgoingPackets.end())
+      continue;
+    SendPacket(&it->second);
+    shard.resends.Schedule(currentTime + resendTime, requestId);
+  }
+  shard.newPackets.clear();
+}
+
 static void ResendPackets()
 {
+  Shard& shard = shards[currentShard];
   std::vector<std::pair<TraversalInetAddress, TraversalRequestId>> todoFailures;
-  todoFailures.clear();
-  for (auto it = outgoingPackets.begin(); it != outgoingPackets.end();)
   {
-    OutgoingPacketInfo* info = &it->second;
-    if (currentTime - info->sendTime >= (u64)(300000 * info->tries))
-    {
-      if (info->tries >= NUMBER_OF_TRIES)
+    std::lock_guard<std::mutex> lock(shard.lock);
+    shard.resends.Advance(currentTime, [&](TraversalRequestId requestId) {
+      auto it = shard.outgoingPackets.find(requestId);
+      // Acked already
+      if (it == shard.outgoingPackets.end())
+        return;
+
+      OutgoingPacketInfo* info = &it->second;
+      const u64 dueTime = info->sendTime + resendTime * info->tries;
+      if (currentTime < dueTime)
+      {
+        shard.resends.Schedule(dueTime, requestId);
+      }
+      else if (info->tries >= NUMBER_OF_TRIES)
       {
         if (info->packet.type == TraversalPacketPleaseSendPacket)
         {
           todoFailures.push_back(std::make_pair(info->packet.pleaseSendPacket.address, info->misc));
         }
-        it = outgoingPackets.erase(it);
-        continue;
+        shard.outgoingPackets.erase(it);
       }
       else
       {
         SendPacket(info);
+        shard.resends.Schedule(currentTime + resendTime * info->tries, requestId);
       }
-    }
-    ++it;
+    });
   }
 
   for (const auto& p : todoFailures)
   {
-    TraversalPacket* fail = AllocPacket(MakeSinAddr(p.first));
-    fail->type = TraversalPacketConnectFailed;
-    fail->connectFailed.requestId = p.second;
-    fail->connectFailed.reason = TraversalConnectFailedClientDidntRespond;
+    TraversalPacket fail = {};
+    fail.type = TraversalPacketConnectFailed;
+    fail.connectFailed.requestId = p.second;
+    fail.connectFailed.reason = TraversalConnectFailedClientDidntRespond;
+    AllocPacket(MakeSinAddr(p.first), fail);
   }
 }
 
+static void ExpireHosts()
+{
+  HostTable& table = hostTables[currentShard];
+  std::lock_guard<std::mutex> lock(table.lock);
+  table.expiries.Advance(currentTime, [&](const TraversalHostId& hostId) {
+    auto it = table.hosts.find(hostId);
+    if (it == table.hosts.end())
+      return;
+
+    // Pings move the expiry without rescheduling it, so it's only checked here.
+    const u64 dueTime = it->second.updateTime + expiryTime;
+    if (currentTime < dueTime)
+      table.expiries.Schedule(dueTime, hostId);
+    else
+      table.hosts.erase(it);
+  });
+}
+
+// The host table must be locked.
+static HostEntry* FindHost(HostTable& table, const TraversalHostId& hostId)
+{
+  auto it = table.hosts.find(hostId);
+  if (it == table.hosts.end())
+    return nullptr;
+  // The timer wheel may not have got to it yet.
+  if (currentTime - it->second.updateTime > expiryTime)
+    return nullptr;
+  return &it->second;
+}
+
 static void HandlePacket(TraversalPacket* packet, sockaddr_in6* addr)
 {
 #if DEBUG
@@ -273,84 +379,112 @@ static void HandlePacket(TraversalPacket* packet, sockaddr_in6* addr)
   {
   case TraversalPacketAck:
   {
-    auto it = outgoingPackets.find(packet->requestId);
-    if (it == outgoingPackets.end())
+    // Acks come from the address the packet was sent to, which the kernel may have given to
+    // another thread than the one that sent the packet.
+    const size_t owner = packet->requestId & (MAX_SHARDS - 1);
+    if (owner >= numShards)
       break;
 
-    OutgoingPacketInfo* info = &it->second;
+    Shard& shard = shards[owner];
+    OutgoingPacketInfo info;
+    {
+      std::lock_guard<std::mutex> lock(shard.lock);
+      auto it = shard.outgoingPackets.find(packet->requestId);
+      if (it == shard.outgoingPackets.end())
+        break;
+      info = it->second;
+      shard.outgoingPackets.erase(it);
+    }
 
-    if (info->packet.type == TraversalPacketPleaseSendPacket)
+    if (info.packet.type == TraversalPacketPleaseSendPacket)
     {
-      TraversalPacket* ready = AllocPacket(MakeSinAddr(info->packet.pleaseSendPacket.address));
+      TraversalPacket ready = {};
       if (packet->ack.ok)
       {
-        ready->type = TraversalPacketConnectReady;
-        ready->connectReady.requestId = info->misc;
-        ready->connectReady.address = MakeInetAddress(info->dest);
+        ready.type = TraversalPacketConnectReady;
+        ready.connectReady.requestId = info.misc;
+        ready.connectReady.address = MakeInetAddress(info.dest);
       }
       else
       {
-        ready->type = TraversalPacketConnectFailed;
-        ready->connectFailed.requestId = info->misc;
-        ready->connectFailed.reason = TraversalConnectFailedClientFailure;
+        ready.type = TraversalPacketConnectFailed;
+        ready.connectFailed.requestId = info.misc;
+        ready.connectFailed.reason = TraversalConnectFailedClientFailure;
       }
+      AllocPacket(MakeSinAddr(info.packet.pleaseSendPacket.address), ready);
     }
-
-    outgoingPackets.erase(it);
     break;
   }
   case TraversalPacketPing:
   {
-    auto r = EvictFind(connectedClients, packet->ping.hostId, true);
-    packetOk = r.found;
+    HostTable& table = GetHostTable(packet->ping.hostId);
+    std::lock_guard<std::mutex> lock(table.lock);
+    HostEntry* host = FindHost(table, packet->ping.hostId);
+    packetOk = host != nullptr;
+    if (host)
+      host->updateTime = currentTime;
     break;
   }
   case TraversalPacketHelloFromClient:
   {
     u8 ok = packet->helloFromClient.protoVersion <= TraversalProtoVersion;
-    TraversalPacket* reply = AllocPacket(*addr);
-    reply->type = TraversalPacketHelloFromServer;
-    reply->helloFromServer.ok = ok;
+    TraversalPacket reply = {};
+    reply.type = TraversalPacketHelloFromServer;
+    reply.helloFromServer.ok = ok;
     if (ok)
     {
       TraversalHostId hostId;
-      TraversalInetAddress* iaddr;
+      TraversalInetAddress iaddr = MakeInetAddress(*addr);
       // not that there is any significant change of
       // duplication, but...
-      GetRandomHostId(&hostId);
       while (true)
       {
-        auto r = EvictFind(connectedClients, hostId);
-        if (!r.found)
+        GetRandomHostId(&hostId);
+        HostTable& table = GetHostTable(hostId);
+        std::lock_guard<std::mutex> lock(table.lock);
+        if (!FindHost(table, hostId))
         {
-          iaddr = EvictSet(connectedClients, hostId);
+          table.hosts[hostId] = {currentTime, iaddr};
+          table.expiries.Schedule(currentTime + expiryTime, hostId);
           break;
         }
       }
 
-      *iaddr = MakeInetAddress(*addr);
-
-      reply->helloFromServer.yourAddress = *iaddr;
-      reply->helloFromServer.yourHostId = hostId;
+      reply.helloFromServer.yourAddress = iaddr;
+      reply.helloFromServer.yourHostId = hostId;
     }
+    AllocPacket(*addr, reply);
     break;
   }
   case TraversalPacketConnectPlease:
   {
     TraversalHostId& hostId = packet->connectPlease.hostId;
-    auto r = EvictFind(connectedClients, hostId);
-    if (!r.found)
+    bool found = false;
+    TraversalInetAddress hostAddress;
+    {
+      HostTable& table = GetHostTable(hostId);
+      std::lock_guard<std::mutex> lock(table.lock);
+      if (HostEntry* host = FindHost(table, hostId))
+      {
+        found = true;
+        hostAddress = host->address;
+      }
+    }
+
+    if (!found)
     {
-      TraversalPacket* reply = AllocPacket(*addr);
-      reply->type = TraversalPacketConnectFailed;
-      reply->connectFailed.requestId = packet->requestId;
-      reply->connectFailed.reason = TraversalConnectFailedNoSuchClient;
+      TraversalPacket reply = {};
+      reply.type = TraversalPacketConnectFailed;
+      reply.connectFailed.requestId = packet->requestId;
+      reply.connectFailed.reason = TraversalConnectFailedNoSuchClient;
+      AllocPacket(*addr, reply);
     }
     else
     {
-      TraversalPacket* please = AllocPacket(MakeSinAddr(*r.value), packet->requestId);
-      please->type = TraversalPacketPleaseSendPacket;
-      please->pleaseSendPacket.address = MakeInetAddress(*addr);
+      TraversalPacket please = {};
+      please.type = TraversalPacketPleaseSendPacket;
+      please.pleaseSendPacket.address = MakeInetAddress(*addr);
+      AllocPacket(MakeSinAddr(hostAddress), please, packet->requestId);
     }
     break;
   }
@@ -367,30 +501,31 @@ static void HandlePacket(TraversalPacket* packet, sockaddr_in6* addr)
   }
 }
 
-int main()
+static int OpenSocket()
 {
   int rv;
-
-  urandomFd = open("/dev/urandom", O_RDONLY);
-  if (urandomFd < 0)
-  {
-    perror("open /dev/urandom");
-    return 1;
-  }
-
-  sock = socket(PF_INET6, SOCK_DGRAM, 0);
+  int sock = socket(PF_INET6, SOCK_DGRAM, 0);
   if (sock == -1)
   {
     perror("socket");
-    return 1;
+    return -1;
   }
   int no = 0;
   rv = setsockopt(sock, IPPROTO_IPV6, IPV6_V6ONLY, &no, sizeof(no));
   if (rv < 0)
   {
     perror("setsockopt IPV6_V6ONLY");
-    return 1;
+    return -1;
+  }
+#if USE_SHARDS
+  int yes = 1;
+  rv = setsockopt(sock, SOL_SOCKET, SO_REUSEPORT, &yes, sizeof(yes));
+  if (rv < 0)
+  {
+    perror("setsockopt SO_REUSEPORT");
+    return -1;
   }
+#endif
   in6_addr any = IN6ADDR_ANY_INIT;
   sockaddr_in6 addr;
 #ifdef SIN6_LEN
@@ -406,49 +541,122 @@ int main()
   if (rv < 0)
   {
     perror("bind");
-    return 1;
+    return -1;
   }
 
+  // Wake up every tick to handle the timers.
   timeval tv;
   tv.tv_sec = 0;
-  tv.tv_usec = 300000;
+  tv.tv_usec = tickTime;
   rv = setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
   if (rv < 0)
   {
     perror("setsockopt SO_RCVTIMEO");
-    return 1;
+    return -1;
   }
+  return sock;
+}
+
+static void ShardThread(size_t index)
+{
+  currentShard = index;
+  Shard& shard = shards[index];
+
+  TraversalPacket packets[RECV_BATCH_SIZE];
+  sockaddr_in6 raddrs[RECV_BATCH_SIZE];
+#if USE_SHARDS
+  mmsghdr messages[RECV_BATCH_SIZE];
+  iovec iovecs[RECV_BATCH_SIZE];
+#endif
 
   while (true)
   {
-    sockaddr_in6 raddr;
-    socklen_t addrLen = sizeof(raddr);
-    TraversalPacket packet;
-    // note: switch to recvmmsg (yes, mmsg) if this becomes
-    // expensive
-    rv = recvfrom(sock, &packet, sizeof(packet), 0, (sockaddr*)&raddr, &addrLen);
-    if (gettimeofday(&tv, nullptr) < 0)
+    int received;
+    int rv;
+#if USE_SHARDS
+    for (int i = 0; i < RECV_BATCH_SIZE; i++)
     {
-      perror("gettimeofday");
-      exit(1);
+      iovecs[i] = {&packets[i], sizeof(packets[i])};
+      messages[i] = {};
+      messages[i].msg_hdr.msg_name = &raddrs[i];
+      messages[i].msg_hdr.msg_namelen = sizeof(raddrs[i]);
+      messages[i].msg_hdr.msg_iov = &iovecs[i];
+      messages[i].msg_hdr.msg_iovlen = 1;
     }
-    currentTime = (u64)tv.tv_sec * 1000000 + tv.tv_usec;
+    // Waits for the first packet, then takes whatever else is already there.
+    rv = recvmmsg(shard.sock, messages, RECV_BATCH_SIZE, MSG_WAITFORONE, nullptr);
+    received = rv;
+#else
+    socklen_t addrLen = sizeof(raddrs[0]);
+    rv = recvfrom(shard.sock, &packets[0], sizeof(packets[0]), 0, (sockaddr*)&raddrs[0], &addrLen);
+    received = rv < 0 ? rv : 1;
+#endif
+    currentTime = GetCurrentTime();
     if (rv < 0)
     {
       if (errno != EINTR && errno != EAGAIN)
       {
         perror("recvfrom");
-        return 1;
+        exit(1);
       }
     }
-    else if ((size_t)rv < sizeof(packet))
-    {
-      fprintf(stderr, "received short packet from %s\n", SenderName(&raddr));
-    }
-    else
+    for (int i = 0; i < received; i++)
     {
-      HandlePacket(&packet, &raddr);
+#if USE_SHARDS
+      size_t size = messages[i].msg_len;
+#else
+      size_t size = rv;
+#endif
+      if (size < sizeof(packets[i]))
+      {
+        fprintf(stderr, "received short packet from %s\n", SenderName(&raddrs[i]));
+      }
+      else
+      {
+        HandlePacket(&packets[i], &raddrs[i]);
+      }
     }
     ResendPackets();
+    SendNewPackets();
+    ExpireHosts();
   }
 }
+
+// Usage: traversal_server [number of threads]
+int main(int argc, char** argv)
+{
+  urandomFd = open("/dev/urandom", O_RDONLY);
+  if (urandomFd < 0)
+  {
+    perror("open /dev/urandom");
+    return 1;
+  }
+
+#if USE_SHARDS
+  numShards = std::max(1u, std::thread::hardware_concurrency());
+  if (argc > 1)
+    numShards = strtoul(argv[1], nullptr, 10);
+  if (numShards < 1 || numShards > MAX_SHARDS)
+  {
+    fprintf(stderr, "the number of threads must be between 1 and %d\n", MAX_SHARDS);
+    return 1;
+  }
+#endif
+
+  shards.reset(new Shard[numShards]);
+  hostTables.reset(new HostTable[numShards]);
+  const u64 startTime = GetCurrentTime();
+  for (size_t i = 0; i < numShards; i++)
+  {
+    shards[i].sock = OpenSocket();
+    if (shards[i].sock < 0)
+      return 1;
+    shards[i].resends.Start(startTime);
+    hostTables[i].expiries.Start(startTime);
+  }
+
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < numShards; i++)
+    threads.emplace_back(ShardThread, i);
+  ShardThread(0);
+}
@@ -4,7 +4,9 @@
 
 #pragma once
 
+#include <condition_variable>
 #include <functional>
+#include <mutex>
 #include <queue>
 #include <thread>
 
@@ -40,6 +42,13 @@ public:
     m_wakeup.Set();
   }
 
+  // Blocks until all the items placed so far have been processed.
+  void WaitForCompletion()
+  {
+    std::unique_lock<std::mutex> lg(m_lock);
+    m_idle.wait(lg, [this] { return m_items.empty() && !m_busy; });
+  }
+
 private:
   void Shutdown()
   {
@@ -64,10 +73,16 @@ private:
           std::unique_lock<std::mutex> lg(m_lock);
           if (m_items.empty())
             break;
-          item = m_items.front();
+          item = std::move(m_items.front());
           m_items.pop();
+          m_busy = true;
         }
         m_function(std::move(item));
+        {
+          std::unique_lock<std::mutex> lg(m_lock);
+          m_busy = false;
+        }
+        m_idle.notify_all();
       }
 
       if (m_shutdown.IsSet())
@@ -81,6 +96,9 @@ private:
   Common::Flag m_shutdown;
   std::mutex m_lock;
   std::queue<T> m_items;
+  // Whether an item is being processed. Protected by m_lock.
+  bool m_busy = false;
+  std::condition_variable m_idle;
 };
 
 }  // namespace Common
@@ -52,6 +52,7 @@ CPUInfo cpu_info;
 CPUInfo::CPUInfo()
 {
   Detect();
+  DetectTopology();
 }
 
 // Detects the various CPU features
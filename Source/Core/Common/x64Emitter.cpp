@@ -1490,6 +1490,65 @@ void OpArg::WriteNormalOp(XEmitter* emit, bool toRM, NormalOp op, const OpArg& o
 
 void XEmitter::WriteNormalOp(int bits, NormalOp op, const OpArg& a1, const OpArg& a2)
 {
+  // 32 and 64-bit ops on a register with a register or an immediate are by far the most common
+  // forms, so they are encoded here directly instead of going through the generic ModRM encoding
+  // of OpArg. The code is the same as that of the generic path.
+  if (a1.IsSimpleReg() && (bits == 32 || bits == 64))
+  {
+    const int reg = a1.offsetOrBaseReg;
+    const u8 rex_w = bits == 64 ? 8 : 0;
+    if (a2.IsSimpleReg())
+    {
+      // op reg, r/m
+      const int rm = a2.offsetOrBaseReg;
+      const u8 rex = 0x40 | rex_w | ((reg & 8) >> 1) | ((a2.indexReg & 8) >> 2) | ((rm & 8) >> 3);
+      if (rex != 0x40)
+        Write8(rex);
+      Write8(normalops[op].fromRm32);
+      WriteModRM(3, reg, rm);
+      return;
+    }
+
+    const NormalOpDef& def = normalops[op];
+    if (a2.scale == SCALE_IMM8 ? def.simm8 != 0xCC :
+                                 a2.scale == SCALE_IMM32 && def.imm32 != 0xCC)
+    {
+      const u8 rex = 0x40 | rex_w | ((a1.operandReg & 8) >> 1) | ((a1.indexReg & 8) >> 2) |
+                     ((reg & 8) >> 3);
+      if (rex != 0x40)
+        Write8(rex);
+
+      if (a2.scale == SCALE_IMM8 ||
+          (def.simm8 != 0xCC && static_cast<s32>(a2.offset) == static_cast<s8>(a2.offset)))
+      {
+        // op r/m, simm8
+        Write8(def.simm8);
+        WriteModRM(3, def.ext, reg);
+        Write8(static_cast<u8>(a2.offset));
+      }
+      else if (op == nrmMOV && bits != 64)
+      {
+        // mov reg, imm
+        Write8(0xB8 + (reg & 7));
+        Write32(static_cast<u32>(a2.offset));
+      }
+      else if (reg == EAX && def.eaximm32 != 0xCC)
+      {
+        // op eax, imm
+        Write8(def.eaximm32);
+        Write32(static_cast<u32>(a2.offset));
+      }
+      else
+      {
+        // op r/m, imm
+        Write8(def.imm32);
+        WriteModRM(3, def.ext, reg);
+        Write32(static_cast<u32>(a2.offset));
+      }
+      return;
+    }
+  }
+
   if (a1.IsImm())
   {
     // Booh! Can't write to an imm
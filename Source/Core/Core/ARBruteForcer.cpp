@@ -20,8 +20,13 @@
 #include <sys/stat.h>
 #endif
 
+#include <algorithm>
+#include <cinttypes>
+#include <fstream>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "Common/FileUtil.h"
 #include "Common/MsgHandler.h"
@@ -52,6 +57,7 @@ bool ch_bruteforce;
 bool ch_dont_save_settings;
 
 bool ch_screenshot_all = false;
+bool ch_hash_only = false;
 
 int original_prim_count;
 
@@ -60,6 +66,65 @@ std::vector<std::string> ch_map;
 std::string ch_title_id;
 std::string ch_code;
 
+int ch_slice = 0;
+int ch_slice_count = 1;
+
+std::string GetPositionPath()
+{
+  if (ch_slice_count <= 1)
+    return File::GetUserPath(D_SCREENSHOTS_IDX) + "position.txt";
+  return File::GetUserPath(D_SCREENSHOTS_IDX) +
+         StringFromFormat("position %d of %d.txt", ch_slice + 1, ch_slice_count);
+}
+
+static std::string GetHashCSVPath()
+{
+  if (ch_slice_count <= 1)
+    return File::GetUserPath(D_SCREENSHOTS_IDX) + ch_title_id + "/hashes.csv";
+  return File::GetUserPath(D_SCREENSHOTS_IDX) + ch_title_id +
+         StringFromFormat("/hashes %d of %d.csv", ch_slice + 1, ch_slice_count);
+}
+
+static std::string GetCSVPath(int slice)
+{
+  if (ch_slice_count <= 1)
+    return File::GetUserPath(D_SCREENSHOTS_IDX) + ch_title_id + "/bruteforce.csv";
+  return File::GetUserPath(D_SCREENSHOTS_IDX) + ch_title_id +
+         StringFromFormat("/bruteforce %d of %d.csv", slice + 1, ch_slice_count);
+}
+
+// Merges the CSV files of all the instances into bruteforce.csv, in the order of the positions.
+// The instances which haven't finished yet only contribute the rows they already wrote.
+static void MergeCSVFiles()
+{
+  std::vector<std::pair<int, std::string>> rows;
+  for (int slice = 0; slice < ch_slice_count; ++slice)
+  {
+    std::ifstream file(GetCSVPath(slice));
+    std::string line;
+    while (getline(file, line))
+    {
+      if (!line.empty())
+        rows.emplace_back(atoi(line.c_str()), line);
+    }
+  }
+
+  std::stable_sort(rows.begin(), rows.end(),
+                   [](const auto& a, const auto& b) { return a.first < b.first; });
+
+  std::ofstream merged(File::GetUserPath(D_SCREENSHOTS_IDX) + ch_title_id + "/bruteforce.csv");
+  for (const auto& row : rows)
+    merged << row.second << "\n";
+}
+
+int GetNextPosition(int position)
+{
+  const int count = std::max(ch_slice_count, 1);
+  int next = position + 1;
+  next += ((ch_slice - next) % count + count) % count;
+  return next;
+}
+
 void ARBruteForceDriver()
 {
   ch_cycles_without_snapshot++;
@@ -88,6 +153,7 @@ void ARBruteForceDriver()
     {
       original_prim_count = SConfig::GetInstance().m_OriginalPrimitiveCount;
       ch_screenshot_all = SConfig::GetInstance().m_BruteforceScreenshotAll;
+      ch_hash_only = SConfig::GetInstance().m_BruteforceHashOnly;
       ch_first_search = true;
       ch_begun = true;
       State::Load(1);
@@ -108,7 +174,7 @@ void ARBruteForceDriver()
 
     ch_next_code = false;
     ch_first_search = false;
-    ch_current_position++;
+    ch_current_position = GetNextPosition(ch_current_position);
     SaveLastPosition(ch_current_position);
     ch_cycles_without_snapshot = 0;
     if (ch_current_position >= (int)ch_map.size())
@@ -143,8 +209,7 @@ void SetupScreenshotAndWriteCSV(Renderer *render)
                        std::to_string(stats.thisFrame.numDrawCalls) + "," +
                        std::to_string(ch_take_screenshot);
   std::ofstream myfile;
-  myfile.open(File::GetUserPath(D_SCREENSHOTS_IDX) + ch_title_id + "/bruteforce.csv",
-              std::ios_base::app);
+  myfile.open(GetCSVPath(ch_slice), std::ios_base::app);
   myfile << s_sAux << "\n";
   myfile.close();
   if (ch_take_screenshot == 1)
@@ -158,7 +223,22 @@ void SetupScreenshotAndWriteCSV(Renderer *render)
       SConfig::GetInstance().SaveSettings();
       NOTICE_LOG(VR, "Saved setting, prim_count = %d", prims);
     }
-    if (ch_current_position < 0 || prims != original_prim_count || ch_screenshot_all)
+    if (ch_current_position >= 0 && ch_hash_only &&
+        (prims != original_prim_count || ch_screenshot_all))
+    {
+      // Only the original frame is saved as an image, the others only have their hash written
+      // (once the frame dumping thread computed it), which is much faster than encoding a PNG.
+      const std::string row = std::to_string(ch_current_position) + "," + addr + "," + ch_code +
+                              "," + std::to_string(prims) + "," +
+                              std::to_string(stats.thisFrame.numDrawCalls);
+      const std::string path = GetHashCSVPath();
+      render->RequestFrameHash([row, path](u64 hash) {
+        std::ofstream file(path, std::ios_base::app);
+        file << row << "," << StringFromFormat("%016" PRIx64, hash) << "\n";
+      });
+      WARN_LOG(VR, "Requested frame hash");
+    }
+    else if (ch_current_position < 0 || prims != original_prim_count || ch_screenshot_all)
     {
       std::string filename;
       if (ch_current_position < 0)
@@ -226,15 +306,15 @@ void ParseMapFile(std::string unique_id)
 void IncrementPositionTxt()
 {
   WARN_LOG(VR, "IncrementPositionTxt");
-  ch_current_position = LoadLastPosition();
-  SaveLastPosition(++ch_current_position);
+  ch_current_position = GetNextPosition(LoadLastPosition());
+  SaveLastPosition(ch_current_position);
   WARN_LOG(VR, "IncrementedPositionTxt");
 }
 
 // save last position
 void SaveLastPosition(int position)
 {
-  std::ofstream myfile(File::GetUserPath(D_SCREENSHOTS_IDX) + "position.txt");
+  std::ofstream myfile(GetPositionPath());
   if (myfile.is_open())
   {
     std::string Result;
@@ -249,7 +329,7 @@ void SaveLastPosition(int position)
 int LoadLastPosition()
 {
   std::string line;
-  std::ifstream myfile(File::GetUserPath(D_SCREENSHOTS_IDX) + "position.txt");
+  std::ifstream myfile(GetPositionPath());
   std::string aux;
 
   if (myfile.is_open())
@@ -282,6 +362,9 @@ void PostProcessCSVFile()
   std::string path_to_processed_csv =
       File::GetUserPath(D_SCREENSHOTS_IDX) + ch_title_id + "/processed.csv";
 
+  if (ch_slice_count > 1)
+    MergeCSVFiles();
+
   FindModeOfCSV(path_to_original_csv, &most_common_num_prims, &most_common_num_draw_calls);
   StripModesFromCSV(path_to_original_csv, path_to_processed_csv, most_common_num_prims,
                     most_common_num_draw_calls);
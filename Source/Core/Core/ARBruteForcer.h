@@ -27,6 +27,8 @@ extern bool ch_bruteforce;
 extern bool ch_dont_save_settings;
 
 extern bool ch_screenshot_all;
+// write a hash of the frame to hashes.csv instead of saving a screenshot
+extern bool ch_hash_only;
 
 extern int original_prim_count;
 
@@ -34,10 +36,19 @@ extern std::vector<std::string> ch_map;
 extern std::string ch_title_id;
 extern std::string ch_code;
 
+// Several instances can search the same map file at once, each testing the positions for which
+// position % ch_slice_count == ch_slice. Each one keeps its own position file and CSV file.
+extern int ch_slice;
+extern int ch_slice_count;
+
 void ARBruteForceDriver();
 void SetupScreenshotAndWriteCSV(Renderer *render);
 void ParseMapFile(std::string unique_id);
 void IncrementPositionTxt();
+// The next position after this one that this instance has to test
+int GetNextPosition(int position);
+// position.txt, or the position file of this instance when the search is split
+std::string GetPositionPath();
 void SaveLastPosition(int position);
 int LoadLastPosition();
 void PostProcessCSVFile();
@@ -54,6 +54,27 @@ static std::atomic<bool> s_use_internal_log{false};
 static const ARCode* s_current_code = nullptr;
 static bool s_disable_logging = false;
 
+// Most codes are nothing but unconditional RAM writes. These are decoded once into a list of
+// writes, which only touch memory (and the JIT's cache) when it doesn't already hold the value.
+struct CompiledWrite
+{
+  u32 address;
+  u32 value;
+  u32 size;  // in bytes
+  u32 count;
+};
+
+struct CompiledCode
+{
+  // False if the code has to go through the interpreter
+  bool only_writes = false;
+  std::vector<CompiledWrite> writes;
+};
+
+// Parallel to s_active_codes, rebuilt when the codes change
+static std::vector<CompiledCode> s_compiled_codes;
+static bool s_compiled_codes_dirty = true;
+
 // ----------------------
 // AR Remote Functions
 void ApplyCodes(const std::vector<ARCode>& codes)
@@ -67,6 +88,7 @@ void ApplyCodes(const std::vector<ARCode>& codes)
   std::copy_if(codes.begin(), codes.end(), std::back_inserter(s_active_codes),
                [](const ARCode& code) { return code.active; });
   s_active_codes.shrink_to_fit();
+  s_compiled_codes_dirty = true;
 }
 
 void AddCode(ARCode code)
@@ -79,6 +101,7 @@ void AddCode(ARCode code)
     std::lock_guard<std::mutex> guard(s_lock);
     s_disable_logging = false;
     s_active_codes.emplace_back(std::move(code));
+    s_compiled_codes_dirty = true;
   }
 }
 
@@ -897,6 +920,74 @@ static bool RunCodeLocked(const ARCode& arcode)
   return true;
 }
 
+static CompiledCode CompileCode(const ARCode& arcode)
+{
+  CompiledCode compiled;
+  for (const AREntry& entry : arcode.ops)
+  {
+    const ARAddr addr(entry.cmd_addr);
+    const u32 data = entry.value;
+
+    // Zero codes, conditional codes and codes modifying Action Replay itself are left to the
+    // interpreter, as are the other normal code subtypes.
+    if (addr == 0 || (addr >= 0x00002000 && addr < 0x00003000) || addr.type != 0 ||
+        addr.subtype != SUB_RAM_WRITE)
+    {
+      return {};
+    }
+
+    switch (addr.size)
+    {
+    case DATATYPE_8BIT:
+      compiled.writes.push_back({addr.GCAddress(), data & 0xFF, 1, (data >> 8) + 1});
+      break;
+    case DATATYPE_16BIT:
+      compiled.writes.push_back({addr.GCAddress(), data & 0xFFFF, 2, (data >> 16) + 1});
+      break;
+    default:
+      compiled.writes.push_back({addr.GCAddress(), data, 4, 1});
+      break;
+    }
+  }
+
+  compiled.only_writes = true;
+  return compiled;
+}
+
+static void RunCompiledCode(const CompiledCode& compiled)
+{
+  for (const CompiledWrite& write : compiled.writes)
+  {
+    bool changed = false;
+    for (u32 i = 0; i < write.count; ++i)
+    {
+      const u32 address = write.address + i * write.size;
+      switch (write.size)
+      {
+      case 1:
+        if (PowerPC::HostRead_U8(address) == write.value)
+          continue;
+        PowerPC::HostWrite_U8(write.value, address);
+        break;
+      case 2:
+        if (PowerPC::HostRead_U16(address) == write.value)
+          continue;
+        PowerPC::HostWrite_U16(write.value, address);
+        break;
+      default:
+        if (PowerPC::HostRead_U32(address) == write.value)
+          continue;
+        PowerPC::HostWrite_U32(write.value, address);
+        break;
+      }
+      changed = true;
+    }
+
+    if (changed)
+      JitInterface::InvalidateICache(write.address, write.count * write.size, false);
+  }
+}
+
 void RunAllActive()
 {
   // penkamaster's Action Replay culling code brute-forcing
@@ -953,13 +1044,42 @@ void RunAllActive()
   // are only atomic ops unless contested. It should be rare for this to
   // be contested.
   std::lock_guard<std::mutex> guard(s_lock);
-  s_active_codes.erase(std::remove_if(s_active_codes.begin(), s_active_codes.end(),
-                                      [](const ARCode& code) {
-                                        bool success = RunCodeLocked(code);
-                                        LogInfo("\n");
-                                        return !success;
-                                      }),
-                       s_active_codes.end());
+  if (s_compiled_codes_dirty)
+  {
+    s_compiled_codes.clear();
+    s_compiled_codes.reserve(s_active_codes.size());
+    for (const ARCode& code : s_active_codes)
+      s_compiled_codes.push_back(CompileCode(code));
+    s_compiled_codes_dirty = false;
+  }
+
+  // Codes which failed are removed. The interpreter also runs every code once after they change,
+  // so that they are logged.
+  size_t kept = 0;
+  for (size_t i = 0; i < s_active_codes.size(); ++i)
+  {
+    bool success = true;
+    if (s_disable_logging && s_compiled_codes[i].only_writes)
+    {
+      RunCompiledCode(s_compiled_codes[i]);
+    }
+    else
+    {
+      success = RunCodeLocked(s_active_codes[i]);
+      LogInfo("\n");
+    }
+
+    if (!success)
+      continue;
+    if (kept != i)
+    {
+      s_active_codes[kept] = std::move(s_active_codes[i]);
+      s_compiled_codes[kept] = std::move(s_compiled_codes[i]);
+    }
+    ++kept;
+  }
+  s_active_codes.resize(kept);
+  s_compiled_codes.resize(kept);
   s_disable_logging = true;
 }
 
@@ -111,13 +111,73 @@ void DolphinAnalytics::ReportDolphinStart(const std::string& ui_type)
   Send(builder);
 }
 
-void DolphinAnalytics::ReportGameStart()
+struct DolphinAnalytics::GameStartInfo
+{
+  std::string game_id;
+  std::string unique_id;
+
+  bool dsp_hle;
+  bool dsp_jit;
+  bool dsp_thread;
+  bool cpu_thread;
+  bool skip_idle;
+  bool fastmem;
+  bool sync_gpu;
+  std::string audio_backend;
+  bool oc_enable;
+  float oc_factor;
+  bool render_to_main;
+  // Empty without a video backend.
+  std::string video_backend;
+  VideoConfig video_config;
+
+  bool netplay;
+  bool movie;
+  bool gcadapter_detected;
+  bool has_controller;
+};
+
+DolphinAnalytics::GameStartInfo DolphinAnalytics::GetGameStartInfo()
 {
-  MakePerGameBuilder();
+  const SConfig& config = SConfig::GetInstance();
+  GameStartInfo info;
+  info.game_id = config.GetGameID();
+  info.unique_id = MakeUniqueId(info.game_id);
+
+  info.dsp_hle = config.bDSPHLE;
+  info.dsp_jit = config.m_DSPEnableJIT;
+  info.dsp_thread = config.bDSPThread;
+  info.cpu_thread = config.bCPUThread;
+  info.skip_idle = config.bSkipIdle;
+  info.fastmem = config.bFastmem;
+  info.sync_gpu = config.bSyncGPU;
+  info.audio_backend = config.sBackend;
+  info.oc_enable = config.m_OCEnable;
+  info.oc_factor = config.m_OCFactor;
+  info.render_to_main = config.bRenderToMain;
+  if (g_video_backend)
+    info.video_backend = g_video_backend->GetName();
+  info.video_config = g_Config;
+
+  info.netplay = NetPlay::IsNetPlayRunning();
+  info.movie = Movie::IsMovieActive();
+  info.gcadapter_detected = GCAdapter::IsDetected();
+  info.has_controller = Pad::GetConfig()->IsControllerControlledByGamepadDevice(0);
+  return info;
+}
 
-  Common::AnalyticsReportBuilder builder(m_per_game_builder);
-  builder.AddData("type", "game-start");
-  Send(builder);
+void DolphinAnalytics::ReportGameStart()
+{
+  // Only the state is taken here, on the thread starting the game. Building the report is left
+  // to the reporter thread.
+  auto info = std::make_shared<GameStartInfo>(GetGameStartInfo());
+  SendDeferred([this, info] {
+    MakePerGameBuilder(*info);
+
+    Common::AnalyticsReportBuilder builder(m_per_game_builder);
+    builder.AddData("type", "game-start");
+    return builder;
+  });
 }
 
 void DolphinAnalytics::MakeBaseBuilder()
@@ -193,92 +253,100 @@ static const char* GetUbershaderMode(const VideoConfig& video_config)
   return "disabled";
 }
 
-void DolphinAnalytics::MakePerGameBuilder()
+void DolphinAnalytics::MakePerGameBuilder(const GameStartInfo& info)
 {
   Common::AnalyticsReportBuilder builder(m_base_builder);
 
   // Gameid.
-  builder.AddData("gameid", SConfig::GetInstance().GetGameID());
+  builder.AddData("gameid", info.game_id);
 
   // Unique id bound to the gameid.
-  builder.AddData("id", MakeUniqueId(SConfig::GetInstance().GetGameID()));
+  builder.AddData("id", info.unique_id);
 
   // Configuration.
-  builder.AddData("cfg-dsp-hle", SConfig::GetInstance().bDSPHLE);
-  builder.AddData("cfg-dsp-jit", SConfig::GetInstance().m_DSPEnableJIT);
-  builder.AddData("cfg-dsp-thread", SConfig::GetInstance().bDSPThread);
-  builder.AddData("cfg-cpu-thread", SConfig::GetInstance().bCPUThread);
-  builder.AddData("cfg-idle-skip", SConfig::GetInstance().bSkipIdle);
-  builder.AddData("cfg-fastmem", SConfig::GetInstance().bFastmem);
-  builder.AddData("cfg-syncgpu", SConfig::GetInstance().bSyncGPU);
-  builder.AddData("cfg-audio-backend", SConfig::GetInstance().sBackend);
-  builder.AddData("cfg-oc-enable", SConfig::GetInstance().m_OCEnable);
-  builder.AddData("cfg-oc-factor", SConfig::GetInstance().m_OCFactor);
-  builder.AddData("cfg-render-to-main", SConfig::GetInstance().bRenderToMain);
-  if (g_video_backend)
+  builder.AddData("cfg-dsp-hle", info.dsp_hle);
+  builder.AddData("cfg-dsp-jit", info.dsp_jit);
+  builder.AddData("cfg-dsp-thread", info.dsp_thread);
+  builder.AddData("cfg-cpu-thread", info.cpu_thread);
+  builder.AddData("cfg-idle-skip", info.skip_idle);
+  builder.AddData("cfg-fastmem", info.fastmem);
+  builder.AddData("cfg-syncgpu", info.sync_gpu);
+  builder.AddData("cfg-audio-backend", info.audio_backend);
+  builder.AddData("cfg-oc-enable", info.oc_enable);
+  builder.AddData("cfg-oc-factor", info.oc_factor);
+  builder.AddData("cfg-render-to-main", info.render_to_main);
+  if (!info.video_backend.empty())
   {
-    builder.AddData("cfg-video-backend", g_video_backend->GetName());
+    builder.AddData("cfg-video-backend", info.video_backend);
   }
 
+  const VideoConfig& video_config = info.video_config;
+
   // Video configuration.
-  builder.AddData("cfg-gfx-multisamples", g_Config.iMultisamples);
-  builder.AddData("cfg-gfx-ssaa", g_Config.bSSAA);
-  builder.AddData("cfg-gfx-anisotropy", g_Config.iMaxAnisotropy);
-  builder.AddData("cfg-gfx-realxfb", g_Config.RealXFBEnabled());
-  builder.AddData("cfg-gfx-virtualxfb", g_Config.VirtualXFBEnabled());
-  builder.AddData("cfg-gfx-vsync", g_Config.bVSync);
-  builder.AddData("cfg-gfx-aspect-ratio", g_Config.iAspectRatio);
-  builder.AddData("cfg-gfx-efb-access", g_Config.bEFBAccessEnable);
-  builder.AddData("cfg-gfx-efb-scale", g_Config.iEFBScale);
-  builder.AddData("cfg-gfx-efb-copy-format-changes", g_Config.bEFBEmulateFormatChanges);
-  builder.AddData("cfg-gfx-efb-copy-ram", !g_Config.bSkipEFBCopyToRam);
-  builder.AddData("cfg-gfx-efb-copy-scaled", g_Config.bCopyEFBScaled);
-  builder.AddData("cfg-gfx-internal-resolution", g_Config.iInternalResolution);
-  builder.AddData("cfg-gfx-tc-samples", g_Config.iSafeTextureCache_ColorSamples);
-  builder.AddData("cfg-gfx-stereo-mode", g_Config.iStereoMode);
-  builder.AddData("cfg-gfx-per-pixel-lighting", g_Config.bEnablePixelLighting);
-  builder.AddData("cfg-gfx-ubershader-mode", GetUbershaderMode(g_Config));
-  builder.AddData("cfg-gfx-fast-depth", g_Config.bFastDepthCalc);
-  builder.AddData("cfg-gfx-vertex-rounding", g_Config.UseVertexRounding());
+  builder.AddData("cfg-gfx-multisamples", video_config.iMultisamples);
+  builder.AddData("cfg-gfx-ssaa", video_config.bSSAA);
+  builder.AddData("cfg-gfx-anisotropy", video_config.iMaxAnisotropy);
+  builder.AddData("cfg-gfx-realxfb", video_config.RealXFBEnabled());
+  builder.AddData("cfg-gfx-virtualxfb", video_config.VirtualXFBEnabled());
+  builder.AddData("cfg-gfx-vsync", video_config.bVSync);
+  builder.AddData("cfg-gfx-aspect-ratio", video_config.iAspectRatio);
+  builder.AddData("cfg-gfx-efb-access", video_config.bEFBAccessEnable);
+  builder.AddData("cfg-gfx-efb-scale", video_config.iEFBScale);
+  builder.AddData("cfg-gfx-efb-copy-format-changes", video_config.bEFBEmulateFormatChanges);
+  builder.AddData("cfg-gfx-efb-copy-ram", !video_config.bSkipEFBCopyToRam);
+  builder.AddData("cfg-gfx-efb-copy-scaled", video_config.bCopyEFBScaled);
+  builder.AddData("cfg-gfx-internal-resolution", video_config.iInternalResolution);
+  builder.AddData("cfg-gfx-tc-samples", video_config.iSafeTextureCache_ColorSamples);
+  builder.AddData("cfg-gfx-stereo-mode", video_config.iStereoMode);
+  builder.AddData("cfg-gfx-per-pixel-lighting", video_config.bEnablePixelLighting);
+  builder.AddData("cfg-gfx-ubershader-mode", GetUbershaderMode(video_config));
+  builder.AddData("cfg-gfx-fast-depth", video_config.bFastDepthCalc);
+  builder.AddData("cfg-gfx-vertex-rounding", video_config.UseVertexRounding());
 
   // GPU features.
-  if (g_Config.iAdapter < static_cast<int>(g_Config.backend_info.Adapters.size()))
+  if (video_config.iAdapter < static_cast<int>(video_config.backend_info.Adapters.size()))
   {
-    builder.AddData("gpu-adapter", g_Config.backend_info.Adapters[g_Config.iAdapter]);
+    builder.AddData("gpu-adapter", video_config.backend_info.Adapters[video_config.iAdapter]);
   }
-  else if (!g_Config.backend_info.AdapterName.empty())
+  else if (!video_config.backend_info.AdapterName.empty())
   {
-    builder.AddData("gpu-adapter", g_Config.backend_info.AdapterName);
+    builder.AddData("gpu-adapter", video_config.backend_info.AdapterName);
   }
   builder.AddData("gpu-has-exclusive-fullscreen",
-                  g_Config.backend_info.bSupportsExclusiveFullscreen);
-  builder.AddData("gpu-has-dual-source-blend", g_Config.backend_info.bSupportsDualSourceBlend);
-  builder.AddData("gpu-has-primitive-restart", g_Config.backend_info.bSupportsPrimitiveRestart);
-  builder.AddData("gpu-has-oversized-viewports", g_Config.backend_info.bSupportsOversizedViewports);
-  builder.AddData("gpu-has-geometry-shaders", g_Config.backend_info.bSupportsGeometryShaders);
-  builder.AddData("gpu-has-3d-vision", g_Config.backend_info.bSupports3DVision);
-  builder.AddData("gpu-has-early-z", g_Config.backend_info.bSupportsEarlyZ);
-  builder.AddData("gpu-has-binding-layout", g_Config.backend_info.bSupportsBindingLayout);
-  builder.AddData("gpu-has-bbox", g_Config.backend_info.bSupportsBBox);
+                  video_config.backend_info.bSupportsExclusiveFullscreen);
+  builder.AddData("gpu-has-dual-source-blend", video_config.backend_info.bSupportsDualSourceBlend);
+  builder.AddData("gpu-has-primitive-restart", video_config.backend_info.bSupportsPrimitiveRestart);
+  builder.AddData("gpu-has-oversized-viewports",
+                  video_config.backend_info.bSupportsOversizedViewports);
+  builder.AddData("gpu-has-geometry-shaders", video_config.backend_info.bSupportsGeometryShaders);
+  builder.AddData("gpu-has-3d-vision", video_config.backend_info.bSupports3DVision);
+  builder.AddData("gpu-has-early-z", video_config.backend_info.bSupportsEarlyZ);
+  builder.AddData("gpu-has-binding-layout", video_config.backend_info.bSupportsBindingLayout);
+  builder.AddData("gpu-has-bbox", video_config.backend_info.bSupportsBBox);
   builder.AddData("gpu-has-fragment-stores-and-atomics",
-                  g_Config.backend_info.bSupportsFragmentStoresAndAtomics);
-  builder.AddData("gpu-has-gs-instancing", g_Config.backend_info.bSupportsGSInstancing);
-  builder.AddData("gpu-has-post-processing", g_Config.backend_info.bSupportsPostProcessing);
-  builder.AddData("gpu-has-palette-conversion", g_Config.backend_info.bSupportsPaletteConversion);
-  builder.AddData("gpu-has-clip-control", g_Config.backend_info.bSupportsClipControl);
-  builder.AddData("gpu-has-ssaa", g_Config.backend_info.bSupportsSSAA);
+                  video_config.backend_info.bSupportsFragmentStoresAndAtomics);
+  builder.AddData("gpu-has-gs-instancing", video_config.backend_info.bSupportsGSInstancing);
+  builder.AddData("gpu-has-vs-layer-output", video_config.backend_info.bSupportsVSLayerOutput);
+  builder.AddData("gpu-has-merged-draws", video_config.backend_info.bSupportsMergedDraws);
+  builder.AddData("gpu-has-multi-draw-indirect",
+                  video_config.backend_info.bSupportsMultiDrawIndirect);
+  builder.AddData("gpu-has-32bit-indices", video_config.backend_info.bSupports32BitIndices);
+  builder.AddData("gpu-has-post-processing", video_config.backend_info.bSupportsPostProcessing);
+  builder.AddData("gpu-has-palette-conversion",
+                  video_config.backend_info.bSupportsPaletteConversion);
+  builder.AddData("gpu-has-clip-control", video_config.backend_info.bSupportsClipControl);
+  builder.AddData("gpu-has-ssaa", video_config.backend_info.bSupportsSSAA);
 
   // NetPlay / recording.
-  builder.AddData("netplay", NetPlay::IsNetPlayRunning());
-  builder.AddData("movie", Movie::IsMovieActive());
+  builder.AddData("netplay", info.netplay);
+  builder.AddData("movie", info.movie);
 
   // Controller information
   // We grab enough to tell what percentage of our users are playing with keyboard/mouse, some kind
   // of gamepad
   // or the official gamecube adapter.
-  builder.AddData("gcadapter-detected", GCAdapter::IsDetected());
-  builder.AddData("has-controller", Pad::GetConfig()->IsControllerControlledByGamepadDevice(0) ||
-                                        GCAdapter::IsDetected());
+  builder.AddData("gcadapter-detected", info.gcadapter_detected);
+  builder.AddData("has-controller", info.has_controller || info.gcadapter_detected);
 
   m_per_game_builder = builder;
 }
@@ -7,6 +7,7 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <utility>
 
 #include "Common/Analytics.h"
 
@@ -42,11 +43,22 @@ public:
     m_reporter.Send(report);
   }
 
+  void SendDeferred(Common::AnalyticsReporter::ReportFunction make_report)
+  {
+    std::lock_guard<std::mutex> lk(m_reporter_mutex);
+    m_reporter.SendDeferred(std::move(make_report));
+  }
+
 private:
+  // The state a game start report is made of, taken when the game starts.
+  struct GameStartInfo;
+
   DolphinAnalytics();
 
   void MakeBaseBuilder();
-  void MakePerGameBuilder();
+  GameStartInfo GetGameStartInfo();
+  // Called on the reporter thread.
+  void MakePerGameBuilder(const GameStartInfo& info);
 
   // Returns a unique ID derived on the global unique ID, hashed with some
   // report-specific data. This avoid correlation between different types of
@@ -62,7 +74,7 @@ private:
   Common::AnalyticsReportBuilder m_base_builder;
 
   // Builder that contains per game data and is initialized when a game start
-  // report is sent.
+  // report is built, on the reporter thread.
   Common::AnalyticsReportBuilder m_per_game_builder;
 
   std::mutex m_reporter_mutex;
@@ -12,6 +12,7 @@
 
 #include <algorithm>
 #include <array>
+#include <cinttypes>
 #include <cstring>
 #include <memory>
 #include <numeric>
@@ -20,6 +21,7 @@
 #include <unordered_set>
 #include <vector>
 
+#include <xxhash.h>
 #include <zlib.h>
 
 #include "Common/Align.h"
@@ -37,6 +39,7 @@
 #include "Core/Boot/DolReader.h"
 #include "Core/Boot/ElfReader.h"
 #include "Core/CommonTitles.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/Config/SYSCONFSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/FifoPlayer/FifoPlayer.h"
@@ -76,7 +79,7 @@ std::unique_ptr<BootParameters> BootParameters::GenerateFromFile(const std::stri
   std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
 
   static const std::unordered_set<std::string> disc_image_extensions = {
-      {".gcm", ".iso", ".tgc", ".wbfs", ".ciso", ".gcz", ".dol", ".elf"}};
+      {".gcm", ".iso", ".tgc", ".wbfs", ".ciso", ".gcz", ".dci", ".dol", ".elf"}};
   if (disc_image_extensions.find(extension) != disc_image_extensions.end() || is_drive)
   {
     std::unique_ptr<DiscIO::Volume> volume = DiscIO::CreateVolumeFromFilename(path);
@@ -138,6 +141,17 @@ static const DiscIO::Volume* SetDisc(std::unique_ptr<DiscIO::Volume> volume)
 bool CBoot::DVDRead(const DiscIO::Volume& volume, u64 dvd_offset, u32 output_address, u32 length,
                     const DiscIO::Partition& partition)
 {
+  // Read straight into emulated RAM when the whole range is in it, which is the usual case.
+  const u32 physical_address = output_address & 0x3FFFFFFF;
+  const bool in_mem1 = u64{physical_address} + length <= Memory::REALRAM_SIZE;
+  const bool in_mem2 = Memory::m_pEXRAM && (physical_address >> 28) == 0x1 &&
+                       (physical_address & 0x0FFFFFFF) + u64{length} <= Memory::EXRAM_SIZE;
+  if (length != 0 && (in_mem1 || in_mem2))
+  {
+    Memory::UnprotectRange(physical_address, length);
+    return volume.Read(dvd_offset, length, Memory::GetPointer(physical_address), partition);
+  }
+
   std::vector<u8> buffer(length);
   if (!volume.Read(dvd_offset, length, buffer.data(), partition))
     return false;
@@ -188,6 +202,35 @@ bool CBoot::LoadMapFromFilename()
   return false;
 }
 
+bool CBoot::GenerateSymbolMap()
+{
+  if (!Config::Get(Config::MAIN_GENERATE_SYMBOL_MAP))
+    return false;
+
+  // The OS globals at the start of MEM1 (like the boot time) aren't part of the code.
+  constexpr u32 HASHED_RAM_START = 0x3400;
+  const u64 hash =
+      XXH64(Memory::m_pRAM + HASHED_RAM_START, Memory::REALRAM_SIZE - HASHED_RAM_START, 0);
+  const std::string path = File::GetUserPath(D_MAPS_IDX) + "Generated" DIR_SEP +
+                           StringFromFormat("%016" PRIx64 ".map", hash);
+
+  if (File::Exists(path) && g_symbolDB.LoadMap(path))
+  {
+    g_symbolDB.FillInCallers();
+    INFO_LOG(BOOT, "Loaded the generated symbol map %s", path.c_str());
+  }
+  else
+  {
+    PPCAnalyst::FindFunctions(0x80000000, 0x80000000 + Memory::REALRAM_SIZE, &g_symbolDB);
+    File::CreateFullPath(path);
+    if (!g_symbolDB.SaveSymbolMap(path))
+      WARN_LOG(BOOT, "Failed to save the generated symbol map to %s", path.c_str());
+  }
+
+  UpdateDebugger_MapLoaded();
+  return true;
+}
+
 // If ipl.bin is not found, this function does *some* of what BS1 does:
 // loading IPL(BS2) and jumping to it.
 // It does not initialize the hardware or anything else like BS1 does.
@@ -319,6 +362,8 @@ bool CBoot::BootUp(std::unique_ptr<BootParameters> boot)
       // and eventually replace code
       if (LoadMapFromFilename())
         HLE::PatchFunctions();
+      else
+        GenerateSymbolMap();
 
       return true;
     }
@@ -361,6 +406,10 @@ bool CBoot::BootUp(std::unique_ptr<BootParameters> boot)
         UpdateDebugger_MapLoaded();
         HLE::PatchFunctions();
       }
+      else
+      {
+        GenerateSymbolMap();
+      }
       return true;
     }
 
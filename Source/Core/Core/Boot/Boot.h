@@ -92,6 +92,9 @@ public:
   // Returns true if a map file exists, false if none could be found.
   static bool FindMapFile(std::string* existing_map_file, std::string* writable_map_file);
   static bool LoadMapFromFilename();
+  // Generates the symbols of the code in MEM1 if MAIN_GENERATE_SYMBOL_MAP is set. The maps are
+  // cached by the hash of MEM1 in the Generated directory of the maps directory.
+  static bool GenerateSymbolMap();
 
 private:
   static bool DVDRead(const DiscIO::Volume& volume, u64 dvd_offset, u32 output_address, u32 length,
@@ -48,76 +48,60 @@ bool DolReader::Initialize(const std::vector<u8>& buffer)
 
   m_is_wii = false;
 
-  m_text_sections.reserve(DOL_NUM_TEXT);
   for (int i = 0; i < DOL_NUM_TEXT; ++i)
   {
     if (m_dolheader.textSize[i] != 0)
     {
-      if (buffer.size() < m_dolheader.textOffset[i] + m_dolheader.textSize[i])
+      if (buffer.size() < u64{m_dolheader.textOffset[i]} + m_dolheader.textSize[i])
         return false;
 
       const u8* text_start = &buffer[m_dolheader.textOffset[i]];
-      m_text_sections.emplace_back(text_start, &text_start[m_dolheader.textSize[i]]);
-
       for (unsigned int j = 0; !m_is_wii && j < (m_dolheader.textSize[i] / sizeof(u32)); ++j)
       {
-        u32 word = ((u32*)text_start)[j];
+        u32 word;
+        std::memcpy(&word, &text_start[j * sizeof(u32)], sizeof(u32));
         if ((word & HID4_mask) == HID4_pattern)
           m_is_wii = true;
       }
     }
-    else
-    {
-      // Make sure that m_text_sections indexes match header indexes
-      m_text_sections.emplace_back();
-    }
   }
 
-  m_data_sections.reserve(DOL_NUM_DATA);
   for (int i = 0; i < DOL_NUM_DATA; ++i)
   {
-    if (m_dolheader.dataSize[i] != 0)
-    {
-      if (buffer.size() < m_dolheader.dataOffset[i] + m_dolheader.dataSize[i])
-        return false;
-
-      const u8* data_start = &buffer[m_dolheader.dataOffset[i]];
-      m_data_sections.emplace_back(data_start, &data_start[m_dolheader.dataSize[i]]);
-    }
-    else
+    if (m_dolheader.dataSize[i] != 0 &&
+        buffer.size() < u64{m_dolheader.dataOffset[i]} + m_dolheader.dataSize[i])
     {
-      // Make sure that m_data_sections indexes match header indexes
-      m_data_sections.emplace_back();
+      return false;
     }
   }
 
   return true;
 }
 
+void DolReader::LoadSection(u32 offset, u32 address, u32 size, bool only_in_mem1) const
+{
+  if (size != 0 && !(only_in_mem1 && address + size >= Memory::REALRAM_SIZE))
+    Memory::CopyToEmu(address, &m_bytes[offset], size);
+}
+
 bool DolReader::LoadIntoMemory(bool only_in_mem1) const
 {
   if (!m_is_valid)
     return false;
 
   // load all text (code) sections
-  for (size_t i = 0; i < m_text_sections.size(); ++i)
-    if (!m_text_sections[i].empty() &&
-        !(only_in_mem1 &&
-          m_dolheader.textAddress[i] + m_text_sections[i].size() >= Memory::REALRAM_SIZE))
-    {
-      Memory::CopyToEmu(m_dolheader.textAddress[i], m_text_sections[i].data(),
-                        m_text_sections[i].size());
-    }
+  for (int i = 0; i < DOL_NUM_TEXT; ++i)
+  {
+    LoadSection(m_dolheader.textOffset[i], m_dolheader.textAddress[i], m_dolheader.textSize[i],
+                only_in_mem1);
+  }
 
   // load all data sections
-  for (size_t i = 0; i < m_data_sections.size(); ++i)
-    if (!m_data_sections[i].empty() &&
-        !(only_in_mem1 &&
-          m_dolheader.dataAddress[i] + m_data_sections[i].size() >= Memory::REALRAM_SIZE))
-    {
-      Memory::CopyToEmu(m_dolheader.dataAddress[i], m_data_sections[i].data(),
-                        m_data_sections[i].size());
-    }
+  for (int i = 0; i < DOL_NUM_DATA; ++i)
+  {
+    LoadSection(m_dolheader.dataOffset[i], m_dolheader.dataAddress[i], m_dolheader.dataSize[i],
+                only_in_mem1);
+  }
 
   return true;
 }
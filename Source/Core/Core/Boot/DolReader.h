@@ -52,12 +52,11 @@ private:
   };
   SDolHeader m_dolheader;
 
-  std::vector<std::vector<u8>> m_data_sections;
-  std::vector<std::vector<u8>> m_text_sections;
-
   bool m_is_valid;
   bool m_is_wii;
 
-  // Copy sections to internal buffers
+  // Checks that the sections are in the file, which they are copied from into emulated memory as
+  // is, without keeping another copy of them.
   bool Initialize(const std::vector<u8>& buffer);
+  void LoadSection(u32 offset, u32 address, u32 size, bool only_in_mem1) const;
 };
@@ -19,6 +19,7 @@ namespace Config
 
 const ConfigInfo<bool> GFX_VSYNC{{System::GFX, "Hardware", "VSync"}, false};
 const ConfigInfo<int> GFX_ADAPTER{{System::GFX, "Hardware", "Adapter"}, 0};
+const ConfigInfo<int> GFX_FRAME_PACING{{System::GFX, "Hardware", "FramePacing"}, 0};
 
 // Graphics.Settings
 
@@ -31,7 +32,11 @@ const ConfigInfo<bool> GFX_CROP{{System::GFX, "Settings", "Crop"}, false};
 const ConfigInfo<bool> GFX_USE_XFB{{System::GFX, "Settings", "UseXFB"}, false};
 const ConfigInfo<bool> GFX_USE_REAL_XFB{{System::GFX, "Settings", "UseRealXFB"}, false};
 const ConfigInfo<int> GFX_SAFE_TEXTURE_CACHE_COLOR_SAMPLES{
-    {System::GFX, "Settings", "SafeTextureCacheColorSamples"}, 128};
+    {System::GFX, "Settings", "SafeTextureCacheColorSamples"}, 0};
+const ConfigInfo<bool> GFX_TEXTURE_WRITE_TRACKING{{System::GFX, "Settings", "TextureWriteTracking"},
+                                                  false};
+const ConfigInfo<bool> GFX_DISPLAY_LIST_CACHE{{System::GFX, "Settings", "DisplayListCache"}, false};
+const ConfigInfo<bool> GFX_STAGE_TIMERS{{System::GFX, "Settings", "StageTimers"}, false};
 const ConfigInfo<bool> GFX_SHOW_FPS{{System::GFX, "Settings", "ShowFPS"}, false};
 const ConfigInfo<bool> GFX_SHOW_NETPLAY_PING{{System::GFX, "Settings", "ShowNetPlayPing"}, false};
 const ConfigInfo<bool> GFX_SHOW_NETPLAY_MESSAGES{{System::GFX, "Settings", "ShowNetPlayMessages"},
@@ -40,12 +45,24 @@ const ConfigInfo<bool> GFX_LOG_RENDER_TIME_TO_FILE{{System::GFX, "Settings", "Lo
                                                    false};
 const ConfigInfo<bool> GFX_OVERLAY_STATS{{System::GFX, "Settings", "OverlayStats"}, false};
 const ConfigInfo<bool> GFX_OVERLAY_PROJ_STATS{{System::GFX, "Settings", "OverlayProjStats"}, false};
+const ConfigInfo<bool> GFX_OVERLAY_FRAME_PROFILE{{System::GFX, "Settings", "OverlayFrameProfile"},
+                                                 false};
+const ConfigInfo<bool> GFX_OVERLAY_METRICS{{System::GFX, "Settings", "OverlayMetrics"}, false};
 const ConfigInfo<bool> GFX_DUMP_TEXTURES{{System::GFX, "Settings", "DumpTextures"}, false};
 const ConfigInfo<bool> GFX_HIRES_TEXTURES{{System::GFX, "Settings", "HiresTextures"}, false};
 const ConfigInfo<bool> GFX_CONVERT_HIRES_TEXTURES{{System::GFX, "Settings", "ConvertHiresTextures"},
                                                   false};
 const ConfigInfo<bool> GFX_CACHE_HIRES_TEXTURES{{System::GFX, "Settings", "CacheHiresTextures"},
                                                 false};
+const ConfigInfo<bool> GFX_ASYNC_HIRES_TEXTURES{{System::GFX, "Settings", "AsyncHiresTextures"},
+                                                false};
+const ConfigInfo<int> GFX_HIRES_TEXTURE_CACHE_SIZE{
+    {System::GFX, "Settings", "HiresTextureCacheSize"}, 0};
+const ConfigInfo<int> GFX_HIRES_TEXTURE_VRAM_BUDGET{
+    {System::GFX, "Settings", "HiresTextureVRAMBudget"}, 0};
+const ConfigInfo<int> GFX_TEXTURE_POOL_BUDGET{{System::GFX, "Settings", "TexturePoolBudget"}, 64};
+const ConfigInfo<bool> GFX_CACHE_DECODED_TEXTURES{
+    {System::GFX, "Settings", "CacheDecodedTextures"}, false};
 const ConfigInfo<bool> GFX_DUMP_EFB_TARGET{{System::GFX, "Settings", "DumpEFBTarget"}, false};
 const ConfigInfo<bool> GFX_DUMP_FRAMES_AS_IMAGES{{System::GFX, "Settings", "DumpFramesAsImages"},
                                                  false};
@@ -59,6 +76,7 @@ const ConfigInfo<bool> GFX_INTERNAL_RESOLUTION_FRAME_DUMPS{
     {System::GFX, "Settings", "InternalResolutionFrameDumps"}, false};
 const ConfigInfo<bool> GFX_ENABLE_GPU_TEXTURE_DECODING{
     {System::GFX, "Settings", "EnableGPUTextureDecoding"}, false};
+const ConfigInfo<bool> GFX_USE_32BIT_INDICES{{System::GFX, "Settings", "Use32BitIndices"}, false};
 const ConfigInfo<bool> GFX_ENABLE_PIXEL_LIGHTING{{System::GFX, "Settings", "EnablePixelLighting"},
                                                  false};
 const ConfigInfo<bool> GFX_FAST_DEPTH_CALC{{System::GFX, "Settings", "FastDepthCalc"}, true};
@@ -67,6 +85,12 @@ const ConfigInfo<bool> GFX_SSAA{{System::GFX, "Settings", "SSAA"}, false};
 const ConfigInfo<int> GFX_EFB_SCALE{{System::GFX, "Settings", "EFBScale"},
                                     static_cast<int>(SCALE_1X)};
 const ConfigInfo<int> GFX_INTERNAL_RESOLUTION{{System::GFX, "Settings", "InternalResolution"}, -2};
+const ConfigInfo<bool> GFX_DYNAMIC_RESOLUTION{{System::GFX, "Settings", "DynamicResolution"},
+                                              false};
+const ConfigInfo<float> GFX_DYNAMIC_RESOLUTION_MIN{
+    {System::GFX, "Settings", "DynamicResolutionMin"}, 0.5f};
+const ConfigInfo<float> GFX_DYNAMIC_RESOLUTION_MAX{
+    {System::GFX, "Settings", "DynamicResolutionMax"}, 1.0f};
 const ConfigInfo<bool> GFX_TEXFMT_OVERLAY_ENABLE{{System::GFX, "Settings", "TexFmtOverlayEnable"},
                                                  false};
 const ConfigInfo<bool> GFX_TEXFMT_OVERLAY_CENTER{{System::GFX, "Settings", "TexFmtOverlayCenter"},
@@ -81,6 +105,7 @@ const ConfigInfo<bool> GFX_BACKEND_MULTITHREADING{
     {System::GFX, "Settings", "BackendMultithreading"}, true};
 const ConfigInfo<int> GFX_COMMAND_BUFFER_EXECUTE_INTERVAL{
     {System::GFX, "Settings", "CommandBufferExecuteInterval"}, 100};
+const ConfigInfo<int> GFX_FRAMES_IN_FLIGHT{{System::GFX, "Settings", "FramesInFlight"}, 2};
 const ConfigInfo<bool> GFX_SHADER_CACHE{{System::GFX, "Settings", "ShaderCache"}, true};
 const ConfigInfo<bool> GFX_BACKGROUND_SHADER_COMPILING{
     {System::GFX, "Settings", "BackgroundShaderCompiling"}, false};
@@ -92,6 +117,8 @@ const ConfigInfo<int> GFX_SHADER_COMPILER_THREADS{
     {System::GFX, "Settings", "ShaderCompilerThreads"}, 1};
 const ConfigInfo<int> GFX_SHADER_PRECOMPILER_THREADS{
     {System::GFX, "Settings", "ShaderPrecompilerThreads"}, 1};
+const ConfigInfo<int> GFX_VERTEX_LOADER_THREADS{{System::GFX, "Settings", "VertexLoaderThreads"},
+                                                0};
 
 const ConfigInfo<bool> GFX_SW_ZCOMPLOC{{System::GFX, "Settings", "SWZComploc"}, true};
 const ConfigInfo<bool> GFX_SW_ZFREEZE{{System::GFX, "Settings", "SWZFreeze"}, true};
@@ -101,6 +128,8 @@ const ConfigInfo<bool> GFX_SW_DUMP_TEV_TEX_FETCHES{{System::GFX, "Settings", "SW
                                                    false};
 const ConfigInfo<int> GFX_SW_DRAW_START{{System::GFX, "Settings", "SWDrawStart"}, 0};
 const ConfigInfo<int> GFX_SW_DRAW_END{{System::GFX, "Settings", "SWDrawEnd"}, 100000};
+const ConfigInfo<int> GFX_SW_RASTERIZER_THREADS{{System::GFX, "Settings", "SWRasterizerThreads"},
+                                                -1};
 
 const ConfigInfo<bool> GFX_PREFER_GLES{{System::GFX, "Settings", "PreferGLES"}, false};
 
@@ -130,15 +159,25 @@ const ConfigInfo<int> GFX_STEREO_DEPTH_PERCENTAGE{
 // Graphics.Hacks
 
 const ConfigInfo<bool> GFX_HACK_EFB_ACCESS_ENABLE{{System::GFX, "Hacks", "EFBAccessEnable"}, true};
+const ConfigInfo<bool> GFX_HACK_ASYNC_EFB_PEEKS{{System::GFX, "Hacks", "AsyncEFBPeeks"}, false};
 const ConfigInfo<bool> GFX_HACK_BBOX_ENABLE{{System::GFX, "Hacks", "BBoxEnable"}, false};
 const ConfigInfo<bool> GFX_HACK_BBOX_PREFER_STENCIL_IMPLEMENTATION{
     {System::GFX, "Hacks", "BBoxPreferStencilImplementation"}, false};
+const ConfigInfo<bool> GFX_HACK_BBOX_ASYNC_READBACK{{System::GFX, "Hacks", "BBoxAsyncReadback"},
+                                                    false};
+const ConfigInfo<bool> GFX_HACK_PERF_QUERIES_ASYNC{{System::GFX, "Hacks", "PerfQueriesAsync"},
+                                                   false};
+const ConfigInfo<bool> GFX_HACK_MERGE_MATRIX_CHANGES{{System::GFX, "Hacks", "MergeMatrixChanges"},
+                                                     false};
 const ConfigInfo<bool> GFX_HACK_FORCE_PROGRESSIVE{{System::GFX, "Hacks", "ForceProgressive"}, true};
 const ConfigInfo<bool> GFX_HACK_EFB_COPY_ENABLE{{System::GFX, "Hacks", "EFBCopyEnable"}, true};
 const ConfigInfo<bool> GFX_HACK_EFB_COPY_CLEAR_DISABLE{
     {System::GFX, "Hacks", "EFBCopyClearDisable"}, false};
 const ConfigInfo<bool> GFX_HACK_SKIP_EFB_COPY_TO_RAM{{System::GFX, "Hacks", "EFBToTextureEnable"},
                                                      true};
+const ConfigInfo<bool> GFX_HACK_SKIP_XFB_COPY_TO_RAM{{System::GFX, "Hacks", "XFBToTextureEnable"},
+                                                     false};
+const ConfigInfo<bool> GFX_HACK_DEFER_EFB_COPIES{{System::GFX, "Hacks", "DeferEFBCopies"}, true};
 const ConfigInfo<bool> GFX_HACK_COPY_EFB_ENABLED{{System::GFX, "Hacks", "EFBScaledCopy"}, true};
 const ConfigInfo<bool> GFX_HACK_EFB_EMULATE_FORMAT_CHANGES{
     {System::GFX, "Hacks", "EFBEmulateFormatChanges"}, false};
@@ -224,6 +263,7 @@ const ConfigInfo<bool> GLOBAL_VR_FLIP_VERTICAL{{System::Main, "VR", "FlipVertica
 const ConfigInfo<bool> GLOBAL_VR_SRGB{{System::Main, "VR", "sRGB"}, false};
 const ConfigInfo<bool> GLOBAL_VR_OVERDRIVE{{System::Main, "VR", "Overdrive"}, true};
 const ConfigInfo<bool> GLOBAL_VR_HQ_DISTORTION{{System::Main, "VR", "HQDistortion"}, false};
+const ConfigInfo<int> GLOBAL_VR_FOVEATION{{System::Main, "VR", "Foveation"}, 0};
 const ConfigInfo<bool> GLOBAL_VR_DISABLE_NEAR_CLIPPING{{System::Main, "VR", "DisableNearClipping"},
                                                        true};
 const ConfigInfo<bool> GLOBAL_VR_AUTO_PAIR_VIVE_CONTROLLERS{
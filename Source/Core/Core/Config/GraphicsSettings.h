@@ -16,6 +16,7 @@ namespace Config
 
 extern const ConfigInfo<bool> GFX_VSYNC;
 extern const ConfigInfo<int> GFX_ADAPTER;
+extern const ConfigInfo<int> GFX_FRAME_PACING;
 
 // Graphics.Settings
 
@@ -26,16 +27,26 @@ extern const ConfigInfo<bool> GFX_CROP;
 extern const ConfigInfo<bool> GFX_USE_XFB;
 extern const ConfigInfo<bool> GFX_USE_REAL_XFB;
 extern const ConfigInfo<int> GFX_SAFE_TEXTURE_CACHE_COLOR_SAMPLES;
+extern const ConfigInfo<bool> GFX_TEXTURE_WRITE_TRACKING;
+extern const ConfigInfo<bool> GFX_DISPLAY_LIST_CACHE;
+extern const ConfigInfo<bool> GFX_STAGE_TIMERS;
 extern const ConfigInfo<bool> GFX_SHOW_FPS;
 extern const ConfigInfo<bool> GFX_SHOW_NETPLAY_PING;
 extern const ConfigInfo<bool> GFX_SHOW_NETPLAY_MESSAGES;
 extern const ConfigInfo<bool> GFX_LOG_RENDER_TIME_TO_FILE;
 extern const ConfigInfo<bool> GFX_OVERLAY_STATS;
 extern const ConfigInfo<bool> GFX_OVERLAY_PROJ_STATS;
+extern const ConfigInfo<bool> GFX_OVERLAY_FRAME_PROFILE;
+extern const ConfigInfo<bool> GFX_OVERLAY_METRICS;
 extern const ConfigInfo<bool> GFX_DUMP_TEXTURES;
 extern const ConfigInfo<bool> GFX_HIRES_TEXTURES;
 extern const ConfigInfo<bool> GFX_CONVERT_HIRES_TEXTURES;
 extern const ConfigInfo<bool> GFX_CACHE_HIRES_TEXTURES;
+extern const ConfigInfo<bool> GFX_ASYNC_HIRES_TEXTURES;
+extern const ConfigInfo<int> GFX_HIRES_TEXTURE_CACHE_SIZE;
+extern const ConfigInfo<int> GFX_HIRES_TEXTURE_VRAM_BUDGET;
+extern const ConfigInfo<int> GFX_TEXTURE_POOL_BUDGET;
+extern const ConfigInfo<bool> GFX_CACHE_DECODED_TEXTURES;
 extern const ConfigInfo<bool> GFX_DUMP_EFB_TARGET;
 extern const ConfigInfo<bool> GFX_DUMP_FRAMES_AS_IMAGES;
 extern const ConfigInfo<bool> GFX_FREE_LOOK;
@@ -46,12 +57,16 @@ extern const ConfigInfo<std::string> GFX_DUMP_PATH;
 extern const ConfigInfo<int> GFX_BITRATE_KBPS;
 extern const ConfigInfo<bool> GFX_INTERNAL_RESOLUTION_FRAME_DUMPS;
 extern const ConfigInfo<bool> GFX_ENABLE_GPU_TEXTURE_DECODING;
+extern const ConfigInfo<bool> GFX_USE_32BIT_INDICES;
 extern const ConfigInfo<bool> GFX_ENABLE_PIXEL_LIGHTING;
 extern const ConfigInfo<bool> GFX_FAST_DEPTH_CALC;
 extern const ConfigInfo<u32> GFX_MSAA;
 extern const ConfigInfo<bool> GFX_SSAA;
 extern const ConfigInfo<int> GFX_EFB_SCALE;
 extern const ConfigInfo<int> GFX_INTERNAL_RESOLUTION;
+extern const ConfigInfo<bool> GFX_DYNAMIC_RESOLUTION;
+extern const ConfigInfo<float> GFX_DYNAMIC_RESOLUTION_MIN;
+extern const ConfigInfo<float> GFX_DYNAMIC_RESOLUTION_MAX;
 extern const ConfigInfo<bool> GFX_TEXFMT_OVERLAY_ENABLE;
 extern const ConfigInfo<bool> GFX_TEXFMT_OVERLAY_CENTER;
 extern const ConfigInfo<bool> GFX_ENABLE_WIREFRAME;
@@ -60,12 +75,14 @@ extern const ConfigInfo<bool> GFX_BORDERLESS_FULLSCREEN;
 extern const ConfigInfo<bool> GFX_ENABLE_VALIDATION_LAYER;
 extern const ConfigInfo<bool> GFX_BACKEND_MULTITHREADING;
 extern const ConfigInfo<int> GFX_COMMAND_BUFFER_EXECUTE_INTERVAL;
+extern const ConfigInfo<int> GFX_FRAMES_IN_FLIGHT;
 extern const ConfigInfo<bool> GFX_SHADER_CACHE;
 extern const ConfigInfo<bool> GFX_BACKGROUND_SHADER_COMPILING;
 extern const ConfigInfo<bool> GFX_DISABLE_SPECIALIZED_SHADERS;
 extern const ConfigInfo<bool> GFX_PRECOMPILE_UBER_SHADERS;
 extern const ConfigInfo<int> GFX_SHADER_COMPILER_THREADS;
 extern const ConfigInfo<int> GFX_SHADER_PRECOMPILER_THREADS;
+extern const ConfigInfo<int> GFX_VERTEX_LOADER_THREADS;
 
 extern const ConfigInfo<bool> GFX_SW_ZCOMPLOC;
 extern const ConfigInfo<bool> GFX_SW_ZFREEZE;
@@ -74,6 +91,7 @@ extern const ConfigInfo<bool> GFX_SW_DUMP_TEV_STAGES;
 extern const ConfigInfo<bool> GFX_SW_DUMP_TEV_TEX_FETCHES;
 extern const ConfigInfo<int> GFX_SW_DRAW_START;
 extern const ConfigInfo<int> GFX_SW_DRAW_END;
+extern const ConfigInfo<int> GFX_SW_RASTERIZER_THREADS;
 
 extern const ConfigInfo<bool> GFX_PREFER_GLES;
 
@@ -97,12 +115,18 @@ extern const ConfigInfo<int> GFX_STEREO_DEPTH_PERCENTAGE;
 // Graphics.Hacks
 
 extern const ConfigInfo<bool> GFX_HACK_EFB_ACCESS_ENABLE;
+extern const ConfigInfo<bool> GFX_HACK_ASYNC_EFB_PEEKS;
 extern const ConfigInfo<bool> GFX_HACK_BBOX_ENABLE;
 extern const ConfigInfo<bool> GFX_HACK_BBOX_PREFER_STENCIL_IMPLEMENTATION;
+extern const ConfigInfo<bool> GFX_HACK_BBOX_ASYNC_READBACK;
+extern const ConfigInfo<bool> GFX_HACK_PERF_QUERIES_ASYNC;
+extern const ConfigInfo<bool> GFX_HACK_MERGE_MATRIX_CHANGES;
 extern const ConfigInfo<bool> GFX_HACK_FORCE_PROGRESSIVE;
 extern const ConfigInfo<bool> GFX_HACK_EFB_COPY_ENABLE;
 extern const ConfigInfo<bool> GFX_HACK_EFB_COPY_CLEAR_DISABLE;
 extern const ConfigInfo<bool> GFX_HACK_SKIP_EFB_COPY_TO_RAM;
+extern const ConfigInfo<bool> GFX_HACK_SKIP_XFB_COPY_TO_RAM;
+extern const ConfigInfo<bool> GFX_HACK_DEFER_EFB_COPIES;
 extern const ConfigInfo<bool> GFX_HACK_COPY_EFB_ENABLED;
 extern const ConfigInfo<bool> GFX_HACK_EFB_EMULATE_FORMAT_CHANGES;
 extern const ConfigInfo<bool> GFX_HACK_VERTEX_ROUDING;
@@ -166,6 +190,7 @@ extern const ConfigInfo<bool> GLOBAL_VR_FLIP_VERTICAL;
 extern const ConfigInfo<bool> GLOBAL_VR_SRGB;
 extern const ConfigInfo<bool> GLOBAL_VR_OVERDRIVE;
 extern const ConfigInfo<bool> GLOBAL_VR_HQ_DISTORTION;
+extern const ConfigInfo<int> GLOBAL_VR_FOVEATION;
 extern const ConfigInfo<bool> GLOBAL_VR_DISABLE_NEAR_CLIPPING;
 extern const ConfigInfo<bool> GLOBAL_VR_AUTO_PAIR_VIVE_CONTROLLERS;
 extern const ConfigInfo<bool> GLOBAL_VR_SHOW_HANDS;
@@ -22,6 +22,14 @@ const ConfigInfo<bool> MAIN_DSP_HLE{{System::Main, "Core", "DSPHLE"}, true};
 const ConfigInfo<int> MAIN_TIMING_VARIANCE{{System::Main, "Core", "TimingVariance"}, 40};
 const ConfigInfo<bool> MAIN_SKIP_IDLE{{System::Main, "Core", "SkipIdle"}, true};
 const ConfigInfo<bool> MAIN_CPU_THREAD{{System::Main, "Core", "CPUThread"}, true};
+#ifdef ANDROID
+// Phones with big.LITTLE cores otherwise let the scheduler move the emulation threads to the
+// little cores.
+const ConfigInfo<bool> MAIN_THREAD_PLACEMENT{{System::Main, "Core", "ThreadPlacement"}, true};
+#else
+const ConfigInfo<bool> MAIN_THREAD_PLACEMENT{{System::Main, "Core", "ThreadPlacement"}, false};
+#endif
+const ConfigInfo<bool> MAIN_HUGE_PAGES{{System::Main, "Core", "HugePages"}, false};
 const ConfigInfo<bool> MAIN_SYNC_ON_SKIP_IDLE{{System::Main, "Core", "SyncOnSkipIdle"}, true};
 const ConfigInfo<std::string> MAIN_DEFAULT_ISO{{System::Main, "Core", "DefaultISO"}, ""};
 const ConfigInfo<bool> MAIN_ENABLE_CHEATS{{System::Main, "Core", "EnableCheats"}, false};
@@ -32,6 +40,7 @@ const ConfigInfo<int> MAIN_AUDIO_LATENCY{{System::Main, "Core", "AudioLatency"},
 const ConfigInfo<bool> MAIN_AUDIO_STRETCH{{System::Main, "Core", "AudioStretch"}, false};
 const ConfigInfo<int> MAIN_AUDIO_STRETCH_LATENCY{{System::Main, "Core", "AudioStretchMaxLatency"},
                                                  80};
+const ConfigInfo<bool> MAIN_AUDIO_LOW_LATENCY{{System::Main, "Core", "AudioLowLatency"}, false};
 const ConfigInfo<std::string> MAIN_MEMCARD_A_PATH{{System::Main, "Core", "MemcardAPath"}, ""};
 const ConfigInfo<std::string> MAIN_MEMCARD_B_PATH{{System::Main, "Core", "MemcardBPath"}, ""};
 const ConfigInfo<std::string> MAIN_AGP_CART_A_PATH{{System::Main, "Core", "AgpCartAPath"}, ""};
@@ -43,6 +52,9 @@ const ConfigInfo<int> MAIN_SLOT_B{{System::Main, "Core", "SlotB"},
 const ConfigInfo<int> MAIN_SERIAL_PORT_1{{System::Main, "Core", "SerialPort1"},
                                          ExpansionInterface::EXIDEVICE_NONE};
 const ConfigInfo<std::string> MAIN_BBA_MAC{{System::Main, "Core", "BBA_MAC"}, ""};
+const ConfigInfo<bool> MAIN_BBA_BUILTIN{{System::Main, "Core", "BBA_BuiltIn"}, false};
+const ConfigInfo<std::string> MAIN_BBA_BUILTIN_DNS{{System::Main, "Core", "BBA_BuiltInDNS"},
+                                                   "8.8.8.8"};
 
 ConfigInfo<u32> GetInfoForSIDevice(u32 channel)
 {
@@ -61,6 +73,9 @@ ConfigInfo<bool> GetInfoForSimulateKonga(u32 channel)
   return {{System::Main, "Core", StringFromFormat("SimulateKonga%u", channel)}, false};
 }
 
+const ConfigInfo<bool> MAIN_ADAPTER_ALIGN_POLLS{{System::Main, "Core", "AdapterAlignPolls"},
+                                                false};
+
 const ConfigInfo<bool> MAIN_WII_SD_CARD{{System::Main, "Core", "WiiSDCard"}, false};
 const ConfigInfo<bool> MAIN_WII_SD_CARD_WRITABLE{{System::Main, "Core", "WiiSDCardWritable"}, true};
 const ConfigInfo<bool> MAIN_WII_KEYBOARD{{System::Main, "Core", "WiiKeyboard"}, false};
@@ -84,6 +99,8 @@ const ConfigInfo<bool> MAIN_LOW_DCBZ_HACK{{System::Main, "Core", "LowDCBZHack"},
 const ConfigInfo<bool> MAIN_FPRF{{System::Main, "Core", "FPRF"}, false};
 const ConfigInfo<bool> MAIN_ACCURATE_NANS{{System::Main, "Core", "AccurateNaNs"}, false};
 const ConfigInfo<float> MAIN_EMULATION_SPEED{{System::Main, "Core", "EmulationSpeed"}, 1.0f};
+const ConfigInfo<bool> MAIN_FAST_FORWARD_FRAME_SKIP{{System::Main, "Core", "FastForwardFrameSkip"},
+                                                   true};
 const ConfigInfo<float> MAIN_OVERCLOCK{{System::Main, "Core", "Overclock"}, 1.0f};
 const ConfigInfo<bool> MAIN_OVERCLOCK_ENABLE{{System::Main, "Core", "OverclockEnable"}, false};
 const ConfigInfo<std::string> MAIN_GFX_BACKEND{{System::Main, "Core", "GFXBackend"}, ""};
@@ -95,6 +112,27 @@ const ConfigInfo<bool> MAIN_CUSTOM_RTC_ENABLE{{System::Main, "Core", "EnableCust
 const ConfigInfo<u32> MAIN_CUSTOM_RTC_VALUE{{System::Main, "Core", "CustomRTCValue"}, 946684800};
 const ConfigInfo<bool> MAIN_ENABLE_SIGNATURE_CHECKS{{System::Main, "Core", "EnableSignatureChecks"},
                                                     true};
+const ConfigInfo<bool> MAIN_REWIND_ENABLE{{System::Main, "Core", "RewindEnable"}, false};
+// In milliseconds of emulated time.
+const ConfigInfo<int> MAIN_REWIND_INTERVAL{{System::Main, "Core", "RewindInterval"}, 1000};
+// In MiB, including the most recent (uncompressed) state.
+const ConfigInfo<int> MAIN_REWIND_BUFFER_SIZE{{System::Main, "Core", "RewindBufferSize"}, 384};
+const ConfigInfo<bool> MAIN_JIT_HINT_CACHE{{System::Main, "Core", "JITHintCache"}, true};
+// In polls per second, 0 polls the controllers when the emulated hardware reads them.
+const ConfigInfo<u32> MAIN_INPUT_POLLING_RATE{{System::Main, "Core", "InputPollingRate"}, 0};
+const ConfigInfo<bool> MAIN_NAND_WRITE_CACHE{{System::Main, "Core", "NANDWriteCache"}, false};
+// Only applies when determinism isn't required (no netplay or input recording).
+const ConfigInfo<bool> MAIN_IMMEDIATE_IPC_REPLIES{{System::Main, "Core", "ImmediateIPCReplies"},
+                                                  false};
+// Writes MemoryWatcher changes to a shared memory ring instead of its socket.
+const ConfigInfo<bool> MAIN_MEMORY_WATCHER_RING{{System::Main, "Core", "MemoryWatcherRing"}, false};
+// Scans for functions at boot when the game has no symbol map.
+const ConfigInfo<bool> MAIN_GENERATE_SYMBOL_MAP{{System::Main, "Core", "GenerateSymbolMap"}, false};
+// Compresses recorded FIFO logs, which older versions can't load.
+const ConfigInfo<bool> MAIN_FIFO_RECORDER_COMPRESSION{
+    {System::Main, "Core", "FifoRecorderCompression"}, false};
+const ConfigInfo<int> MAIN_METRICS_PORT{{System::Main, "Core", "MetricsPort"}, 0};
+const ConfigInfo<std::string> MAIN_METRICS_CSV_PATH{{System::Main, "Core", "MetricsCSVPath"}, ""};
 
 // Main.DSP
 
@@ -107,4 +145,9 @@ const ConfigInfo<std::string> MAIN_AUDIO_BACKEND{{System::Main, "DSP", "Backend"
                                                  AudioCommon::GetDefaultSoundBackend()};
 const ConfigInfo<int> MAIN_AUDIO_VOLUME{{System::Main, "DSP", "Volume"}, 100};
 
+// Main.Movie
+
+// Saves movies in version 2 of the DTM format, which older versions of Dolphin can't play back.
+const ConfigInfo<bool> MAIN_MOVIE_CHUNKED_INPUT{{System::Main, "Movie", "ChunkedInput"}, false};
+
 }  // namespace Config
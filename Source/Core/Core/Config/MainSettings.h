@@ -20,6 +20,8 @@ extern const ConfigInfo<bool> MAIN_DSP_HLE;
 extern const ConfigInfo<int> MAIN_TIMING_VARIANCE;
 extern const ConfigInfo<bool> MAIN_SKIP_IDLE;
 extern const ConfigInfo<bool> MAIN_CPU_THREAD;
+extern const ConfigInfo<bool> MAIN_THREAD_PLACEMENT;
+extern const ConfigInfo<bool> MAIN_HUGE_PAGES;
 extern const ConfigInfo<bool> MAIN_SYNC_ON_SKIP_IDLE;
 extern const ConfigInfo<std::string> MAIN_DEFAULT_ISO;
 extern const ConfigInfo<bool> MAIN_ENABLE_CHEATS;
@@ -29,6 +31,7 @@ extern const ConfigInfo<bool> MAIN_DPL2_DECODER;
 extern const ConfigInfo<int> MAIN_AUDIO_LATENCY;
 extern const ConfigInfo<bool> MAIN_AUDIO_STRETCH;
 extern const ConfigInfo<int> MAIN_AUDIO_STRETCH_LATENCY;
+extern const ConfigInfo<bool> MAIN_AUDIO_LOW_LATENCY;
 extern const ConfigInfo<std::string> MAIN_MEMCARD_A_PATH;
 extern const ConfigInfo<std::string> MAIN_MEMCARD_B_PATH;
 extern const ConfigInfo<std::string> MAIN_AGP_CART_A_PATH;
@@ -37,9 +40,12 @@ extern const ConfigInfo<int> MAIN_SLOT_A;
 extern const ConfigInfo<int> MAIN_SLOT_B;
 extern const ConfigInfo<int> MAIN_SERIAL_PORT_1;
 extern const ConfigInfo<std::string> MAIN_BBA_MAC;
+extern const ConfigInfo<bool> MAIN_BBA_BUILTIN;
+extern const ConfigInfo<std::string> MAIN_BBA_BUILTIN_DNS;
 ConfigInfo<u32> GetInfoForSIDevice(u32 channel);
 ConfigInfo<bool> GetInfoForAdapterRumble(u32 channel);
 ConfigInfo<bool> GetInfoForSimulateKonga(u32 channel);
+extern const ConfigInfo<bool> MAIN_ADAPTER_ALIGN_POLLS;
 extern const ConfigInfo<bool> MAIN_WII_SD_CARD;
 extern const ConfigInfo<bool> MAIN_WII_SD_CARD_WRITABLE;
 extern const ConfigInfo<bool> MAIN_WII_KEYBOARD;
@@ -59,6 +65,7 @@ extern const ConfigInfo<bool> MAIN_LOW_DCBZ_HACK;
 extern const ConfigInfo<bool> MAIN_FPRF;
 extern const ConfigInfo<bool> MAIN_ACCURATE_NANS;
 extern const ConfigInfo<float> MAIN_EMULATION_SPEED;
+extern const ConfigInfo<bool> MAIN_FAST_FORWARD_FRAME_SKIP;
 extern const ConfigInfo<float> MAIN_OVERCLOCK;
 extern const ConfigInfo<bool> MAIN_OVERCLOCK_ENABLE;
 // Should really be part of System::GFX, but again, we're stuck with past mistakes.
@@ -68,6 +75,18 @@ extern const ConfigInfo<std::string> MAIN_PERF_MAP_DIR;
 extern const ConfigInfo<bool> MAIN_CUSTOM_RTC_ENABLE;
 extern const ConfigInfo<u32> MAIN_CUSTOM_RTC_VALUE;
 extern const ConfigInfo<bool> MAIN_ENABLE_SIGNATURE_CHECKS;
+extern const ConfigInfo<bool> MAIN_REWIND_ENABLE;
+extern const ConfigInfo<int> MAIN_REWIND_INTERVAL;
+extern const ConfigInfo<int> MAIN_REWIND_BUFFER_SIZE;
+extern const ConfigInfo<bool> MAIN_JIT_HINT_CACHE;
+extern const ConfigInfo<u32> MAIN_INPUT_POLLING_RATE;
+extern const ConfigInfo<bool> MAIN_NAND_WRITE_CACHE;
+extern const ConfigInfo<bool> MAIN_IMMEDIATE_IPC_REPLIES;
+extern const ConfigInfo<bool> MAIN_MEMORY_WATCHER_RING;
+extern const ConfigInfo<bool> MAIN_GENERATE_SYMBOL_MAP;
+extern const ConfigInfo<bool> MAIN_FIFO_RECORDER_COMPRESSION;
+extern const ConfigInfo<int> MAIN_METRICS_PORT;
+extern const ConfigInfo<std::string> MAIN_METRICS_CSV_PATH;
 
 // Main.DSP
 
@@ -79,4 +98,8 @@ extern const ConfigInfo<bool> MAIN_DUMP_UCODE;
 extern const ConfigInfo<std::string> MAIN_AUDIO_BACKEND;
 extern const ConfigInfo<int> MAIN_AUDIO_VOLUME;
 
+// Main.Movie
+
+extern const ConfigInfo<bool> MAIN_MOVIE_CHUNKED_INPUT;
+
 }  // namespace Config
@@ -8,6 +8,7 @@
 #include <array>
 #include <list>
 #include <map>
+#include <mutex>
 #include <optional>
 #include <sstream>
 #include <string>
@@ -59,6 +60,30 @@ std::vector<std::string> GetGameIniFilenames(const std::string& id, std::optiona
   return filenames;
 }
 
+IniFile LoadSysGameIni(const std::string& id, std::optional<u16> revision)
+{
+  static std::mutex s_mutex;
+  static std::string s_id;
+  static std::optional<u16> s_revision;
+  static std::string s_sys_directory;
+  static IniFile s_ini;
+  static bool s_loaded = false;
+
+  std::lock_guard<std::mutex> lock(s_mutex);
+  const std::string sys_directory = File::GetSysDirectory();
+  if (!s_loaded || s_id != id || s_revision != revision || s_sys_directory != sys_directory)
+  {
+    s_ini = IniFile();
+    for (const std::string& filename : GetGameIniFilenames(id, revision))
+      s_ini.Load(sys_directory + GAMESETTINGS_DIR DIR_SEP + filename, true);
+    s_id = id;
+    s_revision = revision;
+    s_sys_directory = sys_directory;
+    s_loaded = true;
+  }
+  return s_ini;
+}
+
 using ConfigLocation = Config::ConfigLocation;
 using INIToLocationMap = std::map<std::pair<std::string, std::string>, ConfigLocation>;
 
@@ -107,7 +132,11 @@ static const INIToLocationMap& GetINIToLocationMap()
       {{"Video_Stereoscopy", "StereoSwapEyes"}, {Config::GFX_STEREO_SWAP_EYES.location}},
 
       {{"Video_Hacks", "EFBAccessEnable"}, {Config::GFX_HACK_EFB_ACCESS_ENABLE.location}},
+      {{"Video_Hacks", "AsyncEFBPeeks"}, {Config::GFX_HACK_ASYNC_EFB_PEEKS.location}},
       {{"Video_Hacks", "BBoxEnable"}, {Config::GFX_HACK_BBOX_ENABLE.location}},
+      {{"Video_Hacks", "BBoxAsyncReadback"}, {Config::GFX_HACK_BBOX_ASYNC_READBACK.location}},
+      {{"Video_Hacks", "PerfQueriesAsync"}, {Config::GFX_HACK_PERF_QUERIES_ASYNC.location}},
+      {{"Video_Hacks", "MergeMatrixChanges"}, {Config::GFX_HACK_MERGE_MATRIX_CHANGES.location}},
       {{"Video_Hacks", "ForceProgressive"}, {Config::GFX_HACK_FORCE_PROGRESSIVE.location}},
       {{"Video_Hacks", "EFBToTextureEnable"}, {Config::GFX_HACK_SKIP_EFB_COPY_TO_RAM.location}},
       {{"Video_Hacks", "EFBScaledCopy"}, {Config::GFX_EFB_SCALE.location}},
@@ -237,8 +266,7 @@ public:
     IniFile ini;
     if (layer->GetLayer() == Config::LayerType::GlobalGame)
     {
-      for (const std::string& filename : GetGameIniFilenames(m_id, m_revision))
-        ini.Load(File::GetSysDirectory() + GAMESETTINGS_DIR DIR_SEP + filename, true);
+      ini = LoadSysGameIni(m_id, m_revision);
     }
     else
     {
@@ -12,6 +12,8 @@
 
 #include "Common/CommonTypes.h"
 
+class IniFile;
+
 namespace Config
 {
 class ConfigLayerLoader;
@@ -20,6 +22,9 @@ class ConfigLayerLoader;
 namespace ConfigLoaders
 {
 std::vector<std::string> GetGameIniFilenames(const std::string& id, std::optional<u16> revision);
+// The INIs of a game in Sys/GameSettings, merged. They are only parsed again for another game, as
+// booting a game loads them many times and the Sys directory doesn't change while running.
+IniFile LoadSysGameIni(const std::string& id, std::optional<u16> revision);
 
 std::unique_ptr<Config::ConfigLayerLoader> GenerateGlobalGameConfigLoader(const std::string& id,
                                                                           u16 revision);
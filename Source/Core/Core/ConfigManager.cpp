@@ -426,6 +426,7 @@ void SConfig::SaveVRSettings(IniFile& ini)
   IniFile::Section* vr = ini.GetOrCreateSection("VR");
   vr->Set("OriginalPrimitiveCount", m_OriginalPrimitiveCount);
   vr->Set("BruteforceScreenshotAll", m_BruteforceScreenshotAll);
+  vr->Set("BruteforceHashOnly", m_BruteforceHashOnly);
 }
 
 void SConfig::SaveDisplaySettings(IniFile& ini)
@@ -518,6 +519,7 @@ void SConfig::SaveCoreSettings(IniFile& ini)
   core->Set("AudioLatency", iLatency);
   core->Set("AudioStretch", m_audio_stretch);
   core->Set("AudioStretchMaxLatency", m_audio_stretch_max_latency);
+  core->Set("AudioLowLatency", m_audio_low_latency);
   core->Set("MemcardAPath", m_strMemoryCardA);
   core->Set("MemcardBPath", m_strMemoryCardB);
   core->Set("AgpCartAPath", m_strGbaCartA);
@@ -776,6 +778,7 @@ void SConfig::LoadVRSettings(IniFile& ini)
   IniFile::Section* vr = ini.GetOrCreateSection("VR");
   vr->Get("OriginalPrimitiveCount", &m_OriginalPrimitiveCount, -1);
   vr->Get("BruteforceScreenshotAll", &m_BruteforceScreenshotAll, false);
+  vr->Get("BruteforceHashOnly", &m_BruteforceHashOnly, false);
 }
 
 void SConfig::LoadDisplaySettings(IniFile& ini)
@@ -884,6 +887,7 @@ void SConfig::LoadCoreSettings(IniFile& ini)
   core->Get("AudioLatency", &iLatency, 20);
   core->Get("AudioStretch", &m_audio_stretch, false);
   core->Get("AudioStretchMaxLatency", &m_audio_stretch_max_latency, 80);
+  core->Get("AudioLowLatency", &m_audio_low_latency, false);
   core->Get("MemcardAPath", &m_strMemoryCardA);
   core->Get("MemcardBPath", &m_strMemoryCardB);
   core->Get("AgpCartAPath", &m_strGbaCartA);
@@ -1146,6 +1150,7 @@ void SConfig::LoadDefaults()
   iLatency = 20;
   m_audio_stretch = false;
   m_audio_stretch_max_latency = 80;
+  m_audio_low_latency = false;
 
   iPosX = INT_MIN;
   iPosY = INT_MIN;
@@ -1416,10 +1421,7 @@ IniFile SConfig::LoadGameIni() const
 
 IniFile SConfig::LoadDefaultGameIni(const std::string& id, std::optional<u16> revision)
 {
-  IniFile game_ini;
-  for (const std::string& filename : ConfigLoaders::GetGameIniFilenames(id, revision))
-    game_ini.Load(File::GetSysDirectory() + GAMESETTINGS_DIR DIR_SEP + filename, true);
-  return game_ini;
+  return ConfigLoaders::LoadSysGameIni(id, revision);
 }
 
 IniFile SConfig::LoadLocalGameIni(const std::string& id, std::optional<u16> revision)
@@ -1432,9 +1434,7 @@ IniFile SConfig::LoadLocalGameIni(const std::string& id, std::optional<u16> revi
 
 IniFile SConfig::LoadGameIni(const std::string& id, std::optional<u16> revision)
 {
-  IniFile game_ini;
-  for (const std::string& filename : ConfigLoaders::GetGameIniFilenames(id, revision))
-    game_ini.Load(File::GetSysDirectory() + GAMESETTINGS_DIR DIR_SEP + filename, true);
+  IniFile game_ini = ConfigLoaders::LoadSysGameIni(id, revision);
   for (const std::string& filename : ConfigLoaders::GetGameIniFilenames(id, revision))
     game_ini.Load(File::GetUserPath(D_GAMESETTINGS_IDX) + filename, true);
   return game_ini;
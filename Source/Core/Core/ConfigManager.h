@@ -40,8 +40,6 @@ class TMDReader;
 #define BACKEND_XAUDIO2 "XAudio2"
 #define BACKEND_OPENSLES "OpenSLES"
 
-typedef std::vector<u8> SkipEntry;
-
 enum GPUDeterminismMode
 {
   GPU_DETERMINISM_AUTO,
@@ -116,6 +114,7 @@ struct SConfig
   int iLatency = 20;
   bool m_audio_stretch = false;
   int m_audio_stretch_max_latency = 80;
+  bool m_audio_low_latency = false;
 
   bool bRunCompareServer = false;
   bool bRunCompareClient = false;
@@ -150,15 +149,12 @@ struct SConfig
   float fFreeLookSensitivity;
 
   // Remove Layer
-  std::vector<SkipEntry> object_removal_codes;
   u32 skip_objects_end = 0;
   u32 skip_objects_start = 0;
 #ifdef DEBUG_OBJECTS
   u32 skip_objects_end_two = 0;
   u32 skip_objects_start_two = 0;
 #endif
-  volatile bool hide_objects_updating = true;
-  volatile bool hide_objects_done = true;
 
   // Display settings
   std::string strFullscreenResolution;
@@ -346,6 +342,7 @@ struct SConfig
   // eg. an Oculus Rift window wouldn't be suitable for normal non-VR gaming.
   bool m_special_case;
   bool m_BruteforceScreenshotAll;
+  bool m_BruteforceHashOnly;
   int m_OriginalPrimitiveCount;
 
   SConfig(const SConfig&) = delete;
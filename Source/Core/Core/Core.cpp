@@ -25,21 +25,26 @@
 #include "Common/FileUtil.h"
 #include "Common/Flag.h"
 #include "Common/Logging/LogManager.h"
+#include "Common/Logging/Trace.h"
 #include "Common/MemoryUtil.h"
+#include "Common/Metrics.h"
 #include "Common/MsgHandler.h"
 #include "Common/ScopeGuard.h"
 #include "Common/StringUtil.h"
 #include "Common/Thread.h"
+#include "Common/ThreadPlacement.h"
 #include "Common/Timer.h"
 
 #include "Core/ARBruteForcer.h"
 #include "Core/Analytics.h"
 #include "Core/BootManager.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/CoreTiming.h"
 #include "Core/DSPEmulator.h"
 #include "Core/Host.h"
 #include "Core/MemTools.h"
+#include "Core/MetricsExport.h"
 #ifdef USE_MEMORYWATCHER
 #include "Core/MemoryWatcher.h"
 #endif
@@ -62,6 +67,7 @@
 #include "Core/PatchEngine.h"
 #include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/PowerPC/Profiler.h"
 #include "Core/State.h"
 #include "Core/WiiRoot.h"
 
@@ -102,6 +108,8 @@ static Common::Timer s_vr_timer;
 static std::atomic<u32> s_drawn_frame;
 static std::atomic<u32> s_drawn_video;
 static float s_vr_fps = 0;
+static Metrics::Gauge s_speed("dolphin_emulation_speed_ratio",
+                              "Emulation speed over the last second, 1 being full speed.");
 
 static bool s_is_stopping = false;
 static bool s_hardware_initialized = false;
@@ -167,6 +175,8 @@ void FrameUpdateOnCPUThread()
 {
   if (NetPlay::IsNetPlayRunning())
     NetPlayClient::SendTimeBase();
+
+  ::State::RewindFrameUpdate();
 }
 
 // Display messages and return values
@@ -364,16 +374,20 @@ static void CPUSetInitialExecutionState()
 static void CpuThread()
 {
   DeclareAsCPUThread();
+  Profiler::RegisterCPUThread();
+  Common::PlaceCurrentThread(Common::ThreadRole::CPU);
 
   const SConfig& _CoreParameter = SConfig::GetInstance();
 
   if (_CoreParameter.bCPUThread)
   {
     Common::SetCurrentThreadName("CPU thread");
+    Trace::SetThreadName("CPU thread");
   }
   else
   {
     Common::SetCurrentThreadName("CPU-GPU thread");
+    Trace::SetThreadName("CPU-GPU thread");
     g_video_backend->Video_Prepare();
     Host_Message(WM_USER_CREATE);
   }
@@ -433,22 +447,27 @@ static void CpuThread()
 
   if (_CoreParameter.bFastmem)
     EMM::UninstallExceptionHandler();
+
+  Profiler::UnregisterCPUThread();
 }
 
 static void FifoPlayerThread()
 {
   DeclareAsCPUThread();
+  Common::PlaceCurrentThread(Common::ThreadRole::CPU);
   const SConfig& _CoreParameter = SConfig::GetInstance();
 
   if (_CoreParameter.bCPUThread)
   {
     Common::SetCurrentThreadName("FIFO player thread");
+    Trace::SetThreadName("FIFO player thread");
   }
   else
   {
     g_video_backend->Video_Prepare();
     Host_Message(WM_USER_CREATE);
     Common::SetCurrentThreadName("FIFO-GPU thread");
+    Trace::SetThreadName("FIFO-GPU thread");
   }
 
   // Enter CPU run loop. When we leave it - we are done.
@@ -489,6 +508,9 @@ static void FifoPlayerThread()
 void VRThread()
 {
   Common::SetCurrentThreadName("VR Thread");
+  // Timewarp frames have to make every HMD vsync even when the emulated frame is late, so don't
+  // let the CPU and GPU threads starve this one.
+  Common::SetCurrentThreadHighPriority();
 
   const SCoreStartupParameter& _CoreParameter = SConfig::GetInstance();
 
@@ -556,6 +578,18 @@ static void EmuThread(std::unique_ptr<BootParameters> boot)
 
   Common::SetCurrentThreadName("Emuthread - Starting");
 
+  if (Config::Get(Config::MAIN_THREAD_PLACEMENT))
+  {
+    Common::SetThreadPlacement(Common::ChooseThreadPlacement(cpu_info.core_masks,
+                                                             cpu_info.cache_masks,
+                                                             cpu_info.performance_core_mask,
+                                                             core_parameter.bCPUThread));
+  }
+  Common::ScopeGuard placement_guard{Common::ResetThreadPlacement};
+
+  MetricsExport::Init();
+  Common::ScopeGuard metrics_guard{MetricsExport::Shutdown};
+
 #if 0
   if (SConfig::GetInstance().m_OCEnable)
     DisplayMessage("WARNING: running at non-native CPU clock! Game may not be stable.", 8000);
@@ -688,6 +722,9 @@ static void EmuThread(std::unique_ptr<BootParameters> boot)
     g_controller_interface.Shutdown();
   }};
 
+  g_controller_interface.SetPollingRate(Config::Get(Config::MAIN_INPUT_POLLING_RATE));
+  Common::ScopeGuard polling_guard{[] { g_controller_interface.SetPollingRate(0); }};
+
   AudioCommon::InitSoundStream();
   Common::ScopeGuard audio_guard{AudioCommon::ShutdownSoundStream};
 
@@ -758,6 +795,7 @@ static void EmuThread(std::unique_ptr<BootParameters> boot)
     s_nonvr_thread_ready.Set();
 
     // become the GPU thread
+    Common::PlaceCurrentThread(Common::ThreadRole::GPU);
     Fifo::RunGpuLoop();
 
     // We have now exited the Video Loop
@@ -923,6 +961,26 @@ void SaveScreenShot(const std::string& name, bool wait_for_completion)
     SetState(State::Running);
 }
 
+void ToggleEventTrace()
+{
+  static bool s_tracing = false;
+  s_tracing = !s_tracing;
+  if (s_tracing)
+  {
+    Trace::BeginRecording();
+    DisplayMessage("Event trace started", 2000);
+    return;
+  }
+
+  const std::string path = File::GetUserPath(D_DUMP_IDX) + "Trace_" +
+                           SConfig::GetInstance().GetGameID() + ".json";
+  if (File::CreateFullPath(path) && Trace::WriteChromeTrace(path))
+    DisplayMessage("Event trace saved to " + path, 4000);
+  else
+    DisplayMessage("Failed to save the event trace to " + path, 4000);
+  Trace::EndRecording();
+}
+
 void RequestRefreshInfo()
 {
   s_request_refresh_info = true;
@@ -1089,6 +1147,7 @@ void UpdateTitle()
                         (VideoInterface::GetTargetRefreshRate() * ElapseTime));
 
   g_current_speed = Speed;
+  s_speed.Set(Speed / 100.0);
   g_current_fps = FPS * Speed * 0.01f;
 
   // Settings are shown the same for both extended and summary info
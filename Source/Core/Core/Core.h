@@ -60,6 +60,9 @@ State GetState();
 void SaveScreenShot(bool wait_for_completion = false);
 void SaveScreenShot(const std::string& name, bool wait_for_completion = false);
 
+// Starts recording an event trace of all threads, or saves the recording to the dump directory.
+void ToggleEventTrace();
+
 void Callback_WiimoteInterruptChannel(int _number, u16 _channelID, const void* _pData, u32 _Size);
 
 // This displays messages in a user-visible way.
@@ -15,6 +15,7 @@
 #include "Common/ChunkFile.h"
 #include "Common/FifoQueue.h"
 #include "Common/Logging/Log.h"
+#include "Common/Logging/Trace.h"
 #include "Common/StringUtil.h"
 #include "Common/Thread.h"
 
@@ -320,12 +321,19 @@ void MoveEvents()
 
 void Advance()
 {
+  TRACE_SCOPE("CoreTiming::Advance");
   MoveEvents();
 
   int cyclesExecuted = g.slice_length - DowncountToCycles(PowerPC::ppcState.downcount);
   g.global_timer += cyclesExecuted;
-  s_last_OC_factor = SConfig::GetInstance().m_OCEnable ? SConfig::GetInstance().m_OCFactor : 1.0f;
-  g.last_OC_factor_inverted = 1.0f / s_last_OC_factor;
+  const float oc_factor =
+      SConfig::GetInstance().m_OCEnable ? SConfig::GetInstance().m_OCFactor : 1.0f;
+  // Avoid a division on every slice, the factor almost never changes.
+  if (oc_factor != s_last_OC_factor)
+  {
+    s_last_OC_factor = oc_factor;
+    g.last_OC_factor_inverted = 1.0f / oc_factor;
+  }
   g.slice_length = MAX_SLICE_LENGTH;
 
   s_is_global_timer_sane = true;
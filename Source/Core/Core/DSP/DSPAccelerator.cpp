@@ -4,6 +4,8 @@
 
 #include "Core/DSP/DSPAccelerator.h"
 
+#include <algorithm>
+
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
@@ -58,7 +60,7 @@ void Accelerator::WriteD3(u16 value)
   }
 }
 
-u16 Accelerator::Read(s16* coefs)
+u16 Accelerator::Read(const s16* coefs)
 {
   if (m_reads_stopped)
     return 0x0000;
@@ -160,6 +162,102 @@ u16 Accelerator::Read(s16* coefs)
   return val;
 }
 
+u32 Accelerator::ReadSamples(const s16* coefs, s16* output, u32 count)
+{
+  u32 i = 0;
+  while (i < count)
+  {
+    if (m_reads_stopped)
+    {
+      std::fill(output + i, output + count, 0);
+      return count;
+    }
+
+    // How many samples can be read without reaching the end address, the header of the next
+    // ADPCM frame or any of the special cases of Read. The current address can't get past the
+    // address masks before reaching the end address.
+    const u32 address = m_current_address;
+    u32 run = 0;
+    switch (m_sample_format)
+    {
+    case 0x00:
+      if (address + 2 < m_end_address)
+        run = std::min({count - i, 15 - (address & 15), m_end_address - 2 - address});
+      break;
+    case 0x0A:
+    case 0x19:
+      if (address < m_end_address)
+        run = std::min(count - i, m_end_address - address);
+      break;
+    }
+
+    if (run == 0)
+    {
+      output[i++] = static_cast<s16>(Read(coefs));
+      if (m_reads_stopped || m_current_address == m_start_address)
+        return i;
+      continue;
+    }
+
+    s16* out = output + i;
+    switch (m_sample_format)
+    {
+    case 0x00:
+    {
+      const s32 scale = 1 << (m_pred_scale & 0xF);
+      const int coef_idx = (m_pred_scale >> 4) & 0x7;
+      const s32 coef1 = coefs[coef_idx * 2 + 0];
+      const s32 coef2 = coefs[coef_idx * 2 + 1];
+
+      // The nibbles come first, each byte being read once, then the predictor runs over them.
+      s32 scaled[16];
+      u8 byte = ReadMemory(address >> 1);
+      for (u32 j = 0; j < run; j++)
+      {
+        const u32 nibble_address = address + j;
+        if (j != 0 && (nibble_address & 1) == 0)
+          byte = ReadMemory(nibble_address >> 1);
+        const int nibble = (nibble_address & 1) ? (byte & 0xF) : (byte >> 4);
+        scaled[j] = scale * (nibble >= 8 ? nibble - 16 : nibble);
+      }
+
+      s32 yn1 = m_yn1;
+      s32 yn2 = m_yn2;
+      for (u32 j = 0; j < run; j++)
+      {
+        const s32 val32 = scaled[j] + ((0x400 + coef1 * yn1 + coef2 * yn2) >> 11);
+        yn2 = yn1;
+        yn1 = MathUtil::Clamp<s32>(val32, -0x7FFF, 0x7FFF);
+        out[j] = static_cast<s16>(yn1);
+      }
+      m_yn1 = static_cast<s16>(yn1);
+      m_yn2 = static_cast<s16>(yn2);
+      break;
+    }
+    case 0x0A:
+      for (u32 j = 0; j < run; j++)
+      {
+        const u32 sample_address = (address + j) * 2;
+        out[j] = static_cast<s16>((ReadMemory(sample_address) << 8) |
+                                  ReadMemory(sample_address + 1));
+      }
+      m_yn2 = run > 1 ? out[run - 2] : m_yn1;
+      m_yn1 = out[run - 1];
+      break;
+    case 0x19:
+      for (u32 j = 0; j < run; j++)
+        out[j] = static_cast<s16>(ReadMemory(address + j) << 8);
+      m_yn2 = run > 1 ? out[run - 2] : m_yn1;
+      m_yn1 = out[run - 1];
+      break;
+    }
+
+    m_current_address = address + run;
+    i += run;
+  }
+  return count;
+}
+
 void Accelerator::DoState(PointerWrap& p)
 {
   p.Do(m_start_address);
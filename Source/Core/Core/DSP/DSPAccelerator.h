@@ -15,7 +15,11 @@ class Accelerator
 public:
   virtual ~Accelerator() = default;
 
-  u16 Read(s16* coefs);
+  u16 Read(const s16* coefs);
+  // Same as count calls to Read, but decodes the samples within an ADPCM frame, and those before
+  // the end address, at once. Stops after the sample raising an end exception, so that its handler
+  // can run before the next read. Returns the number of samples written to output.
+  u32 ReadSamples(const s16* coefs, s16* output, u32 count);
   // Zelda ucode reads ARAM through 0xffd3.
   u16 ReadD3();
   void WriteD3(u16 value);
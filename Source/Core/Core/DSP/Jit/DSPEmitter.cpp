@@ -222,6 +222,7 @@ void DSPEmitter::Compile(u16 start_addr)
   */
 
   m_gpr.LoadRegs();
+  m_gpr.SetStaticRegsDirty();
 
   m_block_link_entry = GetCodePtr();
 
@@ -269,8 +270,20 @@ void DSPEmitter::Compile(u16 start_addr)
       // end of each block and in this order
       DSPJitRegCache c(m_gpr);
       HandleLoop();
+      const bool idle_skip =
+          !Host::OnThread() && Analyzer::GetCodeFlags(start_addr) & Analyzer::CODE_IDLE_SKIP;
+      if (!idle_skip)
+      {
+        // Run the next iteration of a loop starting at this block without going through the
+        // dispatcher, keeping the accumulators in their host registers.
+        m_gpr.FlushRegsForLink();
+        CMP(16, M_SDSP_pc(), Imm16(start_addr));
+        FixupBranch notLoopStart = J_CC(CC_NE);
+        WriteLinkJump(m_block_link_entry, m_block_size[start_addr]);
+        SetJumpTarget(notLoopStart);
+      }
       m_gpr.SaveRegs();
-      if (!Host::OnThread() && Analyzer::GetCodeFlags(start_addr) & Analyzer::CODE_IDLE_SKIP)
+      if (idle_skip)
       {
         MOV(16, R(EAX), Imm16(DSP_IDLE_SKIP_CYCLES));
       }
@@ -378,9 +391,9 @@ void DSPEmitter::Compile(u16 start_addr)
   JMP(m_return_dispatcher, true);
 }
 
-static void CompileCurrent()
+void DSPEmitter::CompileCurrent()
 {
-  g_dsp_jit->Compile(g_dsp.pc);
+  Compile(g_dsp.pc);
 
   bool retry = true;
 
@@ -389,21 +402,26 @@ static void CompileCurrent()
     retry = false;
     for (size_t i = 0; i < 0xffff; ++i)
     {
-      if (!g_dsp_jit->m_unresolved_jumps[i].empty())
+      if (!m_unresolved_jumps[i].empty())
       {
-        const u16 address_to_compile = g_dsp_jit->m_unresolved_jumps[i].front();
-        g_dsp_jit->Compile(address_to_compile);
-        if (!g_dsp_jit->m_unresolved_jumps[i].empty())
+        const u16 address_to_compile = m_unresolved_jumps[i].front();
+        Compile(address_to_compile);
+        if (!m_unresolved_jumps[i].empty())
           retry = true;
       }
     }
   }
 }
 
+static void CompileCurrentDSP(DSPEmitter& emitter)
+{
+  emitter.CompileCurrent();
+}
+
 const u8* DSPEmitter::CompileStub()
 {
   const u8* entryPoint = AlignCode16();
-  ABI_CallFunction(CompileCurrent);
+  ABI_CallFunctionP(CompileCurrentDSP, this);
   XOR(32, R(EAX), R(EAX));  // Return 0 cycles executed
   JMP(m_return_dispatcher);
   return entryPoint;
@@ -14,6 +14,7 @@
 #include "Common/x64Emitter.h"
 
 #include "Core/DSP/DSPCommon.h"
+#include "Core/DSP/Jit/DSPEmitterBase.h"
 #include "Core/DSP/Jit/DSPJitRegCache.h"
 
 class PointerWrap;
@@ -26,7 +27,7 @@ namespace JIT
 {
 namespace x86
 {
-class DSPEmitter : public Gen::X64CodeBlock
+class DSPEmitter final : public JIT::DSPEmitter, public Gen::X64CodeBlock
 {
 public:
   using DSPCompiledCode = u32 (*)();
@@ -35,19 +36,20 @@ public:
   static constexpr size_t MAX_BLOCKS = 0x10000;
 
   DSPEmitter();
-  ~DSPEmitter();
+  ~DSPEmitter() override;
 
-  u16 RunCycles(u16 cycles);
+  u16 RunCycles(u16 cycles) override;
 
-  void DoState(PointerWrap& p);
+  void DoState(PointerWrap& p) override;
 
   void EmitInstruction(UDSPInstruction inst);
-  void ClearIRAM();
+  void ClearIRAM() override;
   void ClearIRAMandDSPJITCodespaceReset();
 
   void CompileDispatcher();
   Block CompileStub();
   void Compile(u16 start_addr);
+  void CompileCurrent();
 
   bool FlagsNeeded() const;
 
@@ -212,6 +214,7 @@ public:
 private:
   void WriteBranchExit();
   void WriteBlockLink(u16 dest);
+  void WriteLinkJump(Block dest, u16 dest_size);
 
   void ReJitConditional(UDSPInstruction opc, void (DSPEmitter::*conditional_fn)(UDSPInstruction));
   void r_jcc(UDSPInstruction opc);
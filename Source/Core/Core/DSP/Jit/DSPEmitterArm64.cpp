@@ -0,0 +1,308 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Core/DSP/Jit/DSPEmitterArm64.h"
+
+#include <algorithm>
+#include <cstddef>
+
+#include "Common/BitSet.h"
+#include "Common/ChunkFile.h"
+#include "Common/CommonTypes.h"
+
+#include "Core/DSP/DSPAnalyzer.h"
+#include "Core/DSP/DSPCore.h"
+#include "Core/DSP/DSPHost.h"
+#include "Core/DSP/DSPMemoryMap.h"
+#include "Core/DSP/DSPTables.h"
+#include "Core/DSP/Interpreter/DSPInterpreter.h"
+
+using namespace Arm64Gen;
+
+namespace DSP
+{
+namespace JIT
+{
+namespace Arm64
+{
+constexpr size_t COMPILED_CODE_SIZE = 4194304;
+constexpr size_t MAX_BLOCK_SIZE = 250;
+constexpr u16 DSP_IDLE_SKIP_CYCLES = 0x1000;
+
+// According to the AACPS64 we need to save X19 ~ X30.
+constexpr u32 ALL_CALLEE_SAVED = 0x7FF80000;
+
+// Kept in callee saved registers, so they survive the calls into the interpreter.
+constexpr ARM64Reg STATE_REG = X19;   // &g_dsp
+constexpr ARM64Reg BLOCKS_REG = X20;  // m_blocks.data()
+constexpr ARM64Reg CYCLES_REG = X21;  // &m_cycles_left
+
+constexpr s32 OFFSET_PC = static_cast<s32>(offsetof(SDSP, pc));
+constexpr s32 OFFSET_CR = static_cast<s32>(offsetof(SDSP, cr));
+constexpr s32 OFFSET_EXCEPTIONS = static_cast<s32>(offsetof(SDSP, exceptions));
+constexpr s32 OFFSET_EXTERNAL_INTERRUPT_WAITING =
+    static_cast<s32>(offsetof(SDSP, external_interrupt_waiting));
+
+DSPEmitter::DSPEmitter() : m_blocks(MAX_BLOCKS)
+{
+  AllocCodeSpace(COMPILED_CODE_SIZE);
+
+  CompileDispatcher();
+  m_stub_entry_point = CompileStub();
+  FlushIcache();
+
+  // Clear all of the block references
+  std::fill(m_blocks.begin(), m_blocks.end(), m_stub_entry_point);
+}
+
+DSPEmitter::~DSPEmitter()
+{
+  FreeCodeSpace();
+}
+
+u16 DSPEmitter::RunCycles(u16 cycles)
+{
+  if (g_dsp.external_interrupt_waiting)
+  {
+    DSPCore_CheckExternalInterrupt();
+    DSPCore_CheckExceptions();
+    DSPCore_SetExternalInterrupt(false);
+  }
+
+  m_cycles_left = cycles;
+  auto exec_addr = reinterpret_cast<void (*)()>(const_cast<u8*>(m_enter_dispatcher));
+  exec_addr();
+
+  if (g_dsp.reset_dspjit_codespace)
+    ClearIRAMandDSPJITCodespaceReset();
+
+  return m_cycles_left;
+}
+
+void DSPEmitter::DoState(PointerWrap& p)
+{
+  p.Do(m_cycles_left);
+}
+
+void DSPEmitter::ClearIRAM()
+{
+  std::fill(m_blocks.begin(), m_blocks.begin() + DSP_IRAM_SIZE, m_stub_entry_point);
+  g_dsp.reset_dspjit_codespace = true;
+}
+
+void DSPEmitter::ClearIRAMandDSPJITCodespaceReset()
+{
+  ClearCodeSpace();
+  CompileDispatcher();
+  m_stub_entry_point = CompileStub();
+  FlushIcache();
+
+  std::fill(m_blocks.begin(), m_blocks.end(), m_stub_entry_point);
+  g_dsp.reset_dspjit_codespace = false;
+}
+
+// Leaves the block if an exception is pending.
+void DSPEmitter::CheckExceptions(u16 block_size)
+{
+  LDRB(INDEX_UNSIGNED, W0, STATE_REG, OFFSET_EXCEPTIONS);
+  FixupBranch skip_check = CBZ(W0);
+
+  // g_dsp.pc already points at the next instruction.
+  QuickCallFunction(X8, DSPCore_CheckExceptions);
+  MOVI2R(W0, block_size);
+  B(m_return_dispatcher);
+
+  SetJumpTarget(skip_check);
+}
+
+void DSPEmitter::WriteBlockExit(u16 cycles)
+{
+  MOVI2R(W0, cycles);
+  B(m_return_dispatcher);
+}
+
+// Jumps back to the entry of the current block if there are enough cycles left to execute it
+// again.
+void DSPEmitter::WriteLoopJump(Block entry, u16 block_size)
+{
+  LDRH(INDEX_UNSIGNED, W1, CYCLES_REG, 0);
+  CMP(W1, 2 * block_size);
+  FixupBranch not_enough_cycles = B(CC_LS);
+
+  SUB(W1, W1, block_size);
+  STRH(INDEX_UNSIGNED, W1, CYCLES_REG, 0);
+  B(entry);
+  SetJumpTarget(not_enough_cycles);
+}
+
+void DSPEmitter::EmitInstruction(UDSPInstruction inst)
+{
+  const DSPOPCTemplate* const op_template = GetOpTemplate(inst);
+
+  // The interpreter functions expect the PC to point past the opcode, as after dsp_fetch_code.
+  MOVI2R(W0, static_cast<u16>(m_compile_pc + 1));
+  STRH(INDEX_UNSIGNED, W0, STATE_REG, OFFSET_PC);
+
+  if (op_template->extended)
+  {
+    MOVI2R(W0, inst);
+    QuickCallFunction(X8, GetExtOpTemplate(inst)->intFunc);
+  }
+
+  MOVI2R(W0, inst);
+  QuickCallFunction(X8, op_template->intFunc);
+
+  if (op_template->extended)
+    QuickCallFunction(X8, applyWriteBackLog);
+}
+
+void DSPEmitter::Compile(u16 start_addr)
+{
+  if (IsAlmostFull())
+  {
+    // The code space can't be reset while running the generated code. Give up the remaining
+    // cycles, and let RunCycles reset it.
+    g_dsp.reset_dspjit_codespace = true;
+    m_cycles_left = 0;
+    return;
+  }
+
+  const Block entry_point = AlignCode16();
+  const bool idle_skip =
+      !Host::OnThread() && Analyzer::GetCodeFlags(start_addr) & Analyzer::CODE_IDLE_SKIP;
+
+  m_compile_pc = start_addr;
+  u16 block_size = 0;
+  bool block_exited = false;
+
+  while (m_compile_pc < start_addr + MAX_BLOCK_SIZE)
+  {
+    if (Analyzer::GetCodeFlags(m_compile_pc) & Analyzer::CODE_CHECK_INT)
+      CheckExceptions(block_size);
+
+    const UDSPInstruction inst = dsp_imem_read(m_compile_pc);
+    const DSPOPCTemplate* opcode = GetOpTemplate(inst);
+
+    EmitInstruction(inst);
+
+    block_size++;
+    m_compile_pc += opcode->size;
+
+    // Handle loop condition, only if current instruction was flagged as a loop destination
+    // by the analyzer.
+    const bool loop_end =
+        Analyzer::GetCodeFlags(static_cast<u16>(m_compile_pc - 1u)) & Analyzer::CODE_LOOP_END;
+    if (loop_end)
+      QuickCallFunction(X8, Interpreter::HandleLoop);
+
+    if (opcode->branch || loop_end)
+    {
+      LDRH(INDEX_UNSIGNED, W0, STATE_REG, OFFSET_PC);
+
+      FixupBranch no_branch;
+      if (!opcode->uncond_branch)
+      {
+        CMPI2R(W0, m_compile_pc, W1);
+        no_branch = B(CC_EQ);
+      }
+
+      if (!idle_skip)
+      {
+        CMPI2R(W0, start_addr, W1);
+        FixupBranch not_block_start = B(CC_NEQ);
+        WriteLoopJump(entry_point, block_size);
+        SetJumpTarget(not_block_start);
+      }
+      WriteBlockExit(idle_skip ? DSP_IDLE_SKIP_CYCLES : block_size);
+
+      if (opcode->uncond_branch)
+      {
+        block_exited = true;
+        break;
+      }
+      SetJumpTarget(no_branch);
+    }
+
+    // End the block if we're before an idle skip address
+    if (Analyzer::GetCodeFlags(m_compile_pc) & Analyzer::CODE_IDLE_SKIP)
+      break;
+  }
+
+  // g_dsp.pc was already updated by the last instruction.
+  if (!block_exited)
+    WriteBlockExit(idle_skip ? DSP_IDLE_SKIP_CYCLES : block_size);
+
+  FlushIcache();
+  m_blocks[start_addr] = entry_point;
+}
+
+void DSPEmitter::CompileCurrent()
+{
+  Compile(g_dsp.pc);
+}
+
+static void CompileCurrentDSP(DSPEmitter& emitter)
+{
+  emitter.CompileCurrent();
+}
+
+DSPEmitter::Block DSPEmitter::CompileStub()
+{
+  const Block entry_point = AlignCode16();
+  MOVP2R(X0, this);
+  QuickCallFunction(X8, CompileCurrentDSP);
+  MOVI2R(W0, 0);  // Return 0 cycles executed
+  B(m_return_dispatcher);
+  return entry_point;
+}
+
+void DSPEmitter::CompileDispatcher()
+{
+  m_enter_dispatcher = AlignCode16();
+  const BitSet32 registers_used(ALL_CALLEE_SAVED);
+  ABI_PushRegisters(registers_used);
+
+  MOVP2R(STATE_REG, &g_dsp);
+  MOVP2R(BLOCKS_REG, m_blocks.data());
+  MOVP2R(CYCLES_REG, &m_cycles_left);
+
+  const u8* dispatcher_loop = GetCodePtr();
+
+  FixupBranch exception_exit;
+  if (Host::OnThread())
+  {
+    LDRB(INDEX_UNSIGNED, W0, STATE_REG, OFFSET_EXTERNAL_INTERRUPT_WAITING);
+    exception_exit = CBNZ(W0);
+  }
+
+  // Check for DSP halt
+  LDRH(INDEX_UNSIGNED, W0, STATE_REG, OFFSET_CR);
+  TSTI2R(W0, CR_HALT, W1);
+  FixupBranch halt = B(CC_NEQ);
+
+  // Execute block. Cycles executed returned in W0.
+  LDRH(INDEX_UNSIGNED, W0, STATE_REG, OFFSET_PC);
+  LDR(X1, BLOCKS_REG, ArithOption(X0, true));
+  BR(X1);
+
+  m_return_dispatcher = GetCodePtr();
+
+  // Decrement cyclesLeft
+  LDRH(INDEX_UNSIGNED, W1, CYCLES_REG, 0);
+  SUBS(W1, W1, W0);
+  STRH(INDEX_UNSIGNED, W1, CYCLES_REG, 0);
+  B(CC_HI, dispatcher_loop);
+
+  // DSP gave up the remaining cycles.
+  SetJumpTarget(halt);
+  if (Host::OnThread())
+    SetJumpTarget(exception_exit);
+
+  ABI_PopRegisters(registers_used);
+  RET();
+}
+
+}  // namespace Arm64
+}  // namespace JIT
+}  // namespace DSP
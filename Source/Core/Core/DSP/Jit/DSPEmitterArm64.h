@@ -0,0 +1,70 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "Common/Arm64Emitter.h"
+#include "Common/CommonTypes.h"
+
+#include "Core/DSP/DSPCommon.h"
+#include "Core/DSP/Jit/DSPEmitterBase.h"
+
+class PointerWrap;
+
+namespace DSP
+{
+namespace JIT
+{
+namespace Arm64
+{
+// Compiles blocks of DSP code into calls of the interpreter function of each instruction. The
+// decoding and dispatching of the interpreter, the looping hardware, the exception checks and
+// idle skipping are done in the generated code, and loops within a single block run without
+// returning to the dispatcher.
+class DSPEmitter final : public JIT::DSPEmitter, public Arm64Gen::ARM64CodeBlock
+{
+public:
+  using Block = const u8*;
+
+  static constexpr size_t MAX_BLOCKS = 0x10000;
+
+  DSPEmitter();
+  ~DSPEmitter() override;
+
+  u16 RunCycles(u16 cycles) override;
+
+  void DoState(PointerWrap& p) override;
+
+  void ClearIRAM() override;
+
+  void CompileCurrent();
+
+private:
+  void ClearIRAMandDSPJITCodespaceReset();
+
+  void CompileDispatcher();
+  Block CompileStub();
+  void Compile(u16 start_addr);
+
+  void EmitInstruction(UDSPInstruction inst);
+  void CheckExceptions(u16 block_size);
+  void WriteBlockExit(u16 cycles);
+  void WriteLoopJump(Block entry, u16 block_size);
+
+  std::vector<Block> m_blocks;
+
+  u16 m_compile_pc = 0;
+  u16 m_cycles_left = 0;
+
+  const u8* m_enter_dispatcher = nullptr;
+  const u8* m_return_dispatcher = nullptr;
+  const u8* m_stub_entry_point = nullptr;
+};
+
+}  // namespace Arm64
+}  // namespace JIT
+}  // namespace DSP
@@ -0,0 +1,30 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Core/DSP/Jit/DSPEmitterBase.h"
+
+#if defined(_M_X86)
+#include "Core/DSP/Jit/DSPEmitter.h"
+#elif defined(_M_ARM_64)
+#include "Core/DSP/Jit/DSPEmitterArm64.h"
+#endif
+
+namespace DSP
+{
+namespace JIT
+{
+DSPEmitter::~DSPEmitter() = default;
+
+std::unique_ptr<DSPEmitter> CreateDSPEmitter()
+{
+#if defined(_M_X86)
+  return std::make_unique<x86::DSPEmitter>();
+#elif defined(_M_ARM_64)
+  return std::make_unique<Arm64::DSPEmitter>();
+#else
+  return nullptr;
+#endif
+}
+}  // namespace JIT
+}  // namespace DSP
@@ -0,0 +1,30 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <memory>
+
+#include "Common/CommonTypes.h"
+
+class PointerWrap;
+
+namespace DSP
+{
+namespace JIT
+{
+class DSPEmitter
+{
+public:
+  virtual ~DSPEmitter();
+
+  virtual u16 RunCycles(u16 cycles) = 0;
+  virtual void DoState(PointerWrap& p) = 0;
+  virtual void ClearIRAM() = 0;
+};
+
+// Returns the recompiler for the host architecture, or nullptr if there is none.
+std::unique_ptr<DSPEmitter> CreateDSPEmitter();
+}  // namespace JIT
+}  // namespace DSP
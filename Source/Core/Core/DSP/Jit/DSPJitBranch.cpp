@@ -107,17 +107,8 @@ void DSPEmitter::WriteBlockLink(u16 dest)
   {
     if (m_block_links[dest] != nullptr)
     {
-      m_gpr.FlushRegs();
-      // Check if we have enough cycles to execute the next block
-      MOV(64, R(RAX), ImmPtr(&m_cycles_left));
-      MOV(16, R(ECX), MatR(RAX));
-      CMP(16, R(ECX), Imm16(m_block_size[m_start_address] + m_block_size[dest]));
-      FixupBranch notEnoughCycles = J_CC(CC_BE);
-
-      SUB(16, R(ECX), Imm16(m_block_size[m_start_address]));
-      MOV(16, MatR(RAX), R(ECX));
-      JMP(m_block_links[dest], true);
-      SetJumpTarget(notEnoughCycles);
+      m_gpr.FlushRegsForLink();
+      WriteLinkJump(m_block_links[dest], m_block_size[dest]);
     }
     else
     {
@@ -128,6 +119,22 @@ void DSPEmitter::WriteBlockLink(u16 dest)
   }
 }
 
+// Jumps to the entry of a linked block if there are enough cycles left to execute it. The register
+// cache must have been flushed with FlushRegsForLink.
+void DSPEmitter::WriteLinkJump(Block dest, u16 dest_size)
+{
+  // Check if we have enough cycles to execute the next block
+  MOV(64, R(RAX), ImmPtr(&m_cycles_left));
+  MOV(16, R(ECX), MatR(RAX));
+  CMP(16, R(ECX), Imm16(m_block_size[m_start_address] + dest_size));
+  FixupBranch notEnoughCycles = J_CC(CC_BE);
+
+  SUB(16, R(ECX), Imm16(m_block_size[m_start_address]));
+  MOV(16, MatR(RAX), R(ECX));
+  JMP(dest, true);
+  SetJumpTarget(notEnoughCycles);
+}
+
 void DSPEmitter::r_jcc(const UDSPInstruction opc)
 {
   u16 dest = dsp_imem_read(m_compile_pc + 1);
@@ -391,6 +391,20 @@ void DSPJitRegCache::LoadRegs(bool emit)
   }
 }
 
+void DSPJitRegCache::FlushRegsForLink()
+{
+  FlushMemBackedRegs();
+}
+
+void DSPJitRegCache::SetStaticRegsDirty()
+{
+  for (DynamicReg& reg : m_regs)
+  {
+    if (reg.host_reg != INVALID_REG)
+      reg.dirty = true;
+  }
+}
+
 void DSPJitRegCache::SaveRegs()
 {
   FlushRegs();
@@ -110,6 +110,13 @@ public:
   void LoadRegs(bool emit = true);  // Load statically allocated regs from memory
   void SaveRegs();                  // Save statically allocated regs to memory
 
+  // Prepare state for a jump to the entry of a linked block. Statically allocated regs stay in
+  // their host regs, without being written back to memory.
+  void FlushRegsForLink();
+  // At the entry of a block which can be linked to, statically allocated regs may hold values
+  // which the linking block didn't write back to memory.
+  void SetStaticRegsDirty();
+
   void PushRegs();  // Save registers before ABI call
   void PopRegs();   // Restore registers after ABI call
 
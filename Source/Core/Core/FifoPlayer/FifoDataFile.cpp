@@ -5,18 +5,34 @@
 #include "Core/FifoPlayer/FifoDataFile.h"
 
 #include <algorithm>
+#include <cinttypes>
 #include <cstring>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include <xxhash.h>
+#include <zlib.h>
+
 #include "Common/File.h"
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
 
 enum
 {
   FILE_ID = 0x0d01f1f0,
-  VERSION_NUMBER = 4,
+  VERSION_NUMBER = 5,
   MIN_LOADER_VERSION = 1,
+  // Compressed data was added in version 5.
+  MIN_COMPRESSED_LOADER_VERSION = 5,
+};
+
+enum
+{
+  // The data starts with its compressed size as a u32, followed by the zlib stream.
+  DATA_FLAG_COMPRESSED = 1,
 };
 
 #pragma pack(push, 1)
@@ -51,7 +67,8 @@ struct FileFrameInfo
   u32 fifoEnd;
   u64 memoryUpdatesOffset;
   u32 numMemoryUpdates;
-  u8 reserved[32];
+  u8 fifoDataFlags;
+  u8 reserved[31];
 };
 static_assert(sizeof(FileFrameInfo) == 64, "FileFrameInfo should be 64 bytes");
 
@@ -62,12 +79,90 @@ struct FileMemoryUpdate
   u64 dataOffset;
   u32 dataSize;
   u8 type;
-  u8 reserved[3];
+  u8 dataFlags;
+  u8 reserved[2];
 };
 static_assert(sizeof(FileMemoryUpdate) == 24, "FileMemoryUpdate should be 24 bytes");
 
 #pragma pack(pop)
 
+struct FifoDataFile::Spool
+{
+  struct Frame
+  {
+    FileFrameInfo info;
+    std::vector<FileMemoryUpdate> memoryUpdates;
+  };
+
+  struct Data
+  {
+    u64 offset;
+    u32 size;
+    u8 flags;
+  };
+
+  ~Spool()
+  {
+    file.Close();
+    File::Delete(filename);
+  }
+
+  File::IOFile file;
+  std::string filename;
+  bool compress = false;
+  std::vector<Frame> frames;
+  // The memory update data written so far, by hash.
+  std::unordered_map<u64, Data> data;
+};
+
+// Appends the data to the file, compressed if compress is set and it gets smaller. Returns the
+// DATA_FLAGs of what was written.
+static u8 WriteData(const u8* data, size_t size, bool compress, File::IOFile& file)
+{
+  if (compress && size > sizeof(u32))
+  {
+    uLongf compressed_size = compressBound(static_cast<uLong>(size));
+    std::vector<u8> buffer(sizeof(u32) + compressed_size);
+    if (compress2(buffer.data() + sizeof(u32), &compressed_size, data, static_cast<uLong>(size),
+                  Z_BEST_SPEED) == Z_OK &&
+        sizeof(u32) + compressed_size < size)
+    {
+      const u32 stored_size = static_cast<u32>(compressed_size);
+      std::memcpy(buffer.data(), &stored_size, sizeof(u32));
+      file.WriteBytes(buffer.data(), sizeof(u32) + compressed_size);
+      return DATA_FLAG_COMPRESSED;
+    }
+  }
+
+  file.WriteBytes(data, size);
+  return 0;
+}
+
+// Reads data->size() bytes of data written by WriteData.
+static void ReadData(u64 offset, u8 flags, std::vector<u8>* data, File::IOFile& file)
+{
+  file.Seek(offset, SEEK_SET);
+  if (!(flags & DATA_FLAG_COMPRESSED))
+  {
+    file.ReadBytes(data->data(), data->size());
+    return;
+  }
+
+  u32 compressed_size = 0;
+  file.ReadBytes(&compressed_size, sizeof(u32));
+  std::vector<u8> buffer(compressed_size);
+  file.ReadBytes(buffer.data(), compressed_size);
+
+  uLongf size = static_cast<uLongf>(data->size());
+  if (uncompress(data->data(), &size, buffer.data(), compressed_size) != Z_OK ||
+      size != data->size())
+  {
+    ERROR_LOG(VIDEO, "FifoDataFile: Failed to decompress %u bytes at 0x%" PRIx64, compressed_size,
+              offset);
+    std::fill(data->begin(), data->end(), 0);
+  }
+}
+
 FifoDataFile::FifoDataFile() = default;
 
 FifoDataFile::~FifoDataFile() = default;
@@ -87,9 +182,30 @@ bool FifoDataFile::GetIsWii() const
   return GetFlag(FLAG_IS_WII);
 }
 
-void FifoDataFile::AddFrame(const FifoFrameInfo& frameInfo)
+void FifoDataFile::AddFrame(FifoFrameInfo frameInfo)
+{
+  if (m_spool)
+    SpoolFrame(frameInfo);
+  else
+    m_Frames.push_back(std::move(frameInfo));
+}
+
+u32 FifoDataFile::GetFrameCount() const
 {
-  m_Frames.push_back(frameInfo);
+  const size_t spooled_frames = m_spool ? m_spool->frames.size() : 0;
+  return static_cast<u32>(m_Frames.size() + spooled_frames);
+}
+
+bool FifoDataFile::StartSpooling(const std::string& spool_filename, bool compress)
+{
+  auto spool = std::make_unique<Spool>();
+  spool->filename = spool_filename;
+  spool->compress = compress;
+  if (!spool->file.Open(spool_filename, "w+b"))
+    return false;
+
+  m_spool = std::move(spool);
+  return true;
 }
 
 bool FifoDataFile::Save(const std::string& filename)
@@ -103,7 +219,7 @@ bool FifoDataFile::Save(const std::string& filename)
 
   // Add space for frame list
   u64 frameListOffset = file.Tell();
-  PadFile(m_Frames.size() * sizeof(FileFrameInfo), file);
+  PadFile(GetFrameCount() * sizeof(FileFrameInfo), file);
 
   u64 bpMemOffset = file.Tell();
   file.WriteArray(m_BPMem, BP_MEM_SIZE);
@@ -120,11 +236,14 @@ bool FifoDataFile::Save(const std::string& filename)
   u64 texMemOffset = file.Tell();
   file.WriteArray(m_TexMem, TEX_MEM_SIZE);
 
+  // Frames kept in memory are compressed like the spooled ones.
+  const bool compress = m_spool && m_spool->compress;
+
   // Write header
-  FileHeader header;
+  FileHeader header{};
   header.fileId = FILE_ID;
   header.file_version = VERSION_NUMBER;
-  header.min_loader_version = MIN_LOADER_VERSION;
+  header.min_loader_version = compress ? MIN_COMPRESSED_LOADER_VERSION : MIN_LOADER_VERSION;
 
   header.bpMemOffset = bpMemOffset;
   header.bpMemSize = BP_MEM_SIZE;
@@ -142,7 +261,7 @@ bool FifoDataFile::Save(const std::string& filename)
   header.texMemSize = TEX_MEM_SIZE;
 
   header.frameListOffset = frameListOffset;
-  header.frameCount = (u32)m_Frames.size();
+  header.frameCount = GetFrameCount();
 
   header.flags = m_Flags;
 
@@ -157,12 +276,14 @@ bool FifoDataFile::Save(const std::string& filename)
     // Write FIFO data
     file.Seek(0, SEEK_END);
     u64 dataOffset = file.Tell();
-    file.WriteBytes(srcFrame.fifoData.data(), srcFrame.fifoData.size());
+    const u8 fifoDataFlags =
+        WriteData(srcFrame.fifoData.data(), srcFrame.fifoData.size(), compress, file);
 
-    u64 memoryUpdatesOffset = WriteMemoryUpdates(srcFrame.memoryUpdates, file);
+    u64 memoryUpdatesOffset = WriteMemoryUpdates(srcFrame.memoryUpdates, compress, file);
 
-    FileFrameInfo dstFrame;
+    FileFrameInfo dstFrame{};
     dstFrame.fifoDataSize = static_cast<u32>(srcFrame.fifoData.size());
+    dstFrame.fifoDataFlags = fifoDataFlags;
     dstFrame.fifoDataOffset = dataOffset;
     dstFrame.fifoStart = srcFrame.fifoStart;
     dstFrame.fifoEnd = srcFrame.fifoEnd;
@@ -175,6 +296,10 @@ bool FifoDataFile::Save(const std::string& filename)
     file.WriteBytes(&dstFrame, sizeof(FileFrameInfo));
   }
 
+  const u64 spooledFrameListOffset = frameListOffset + m_Frames.size() * sizeof(FileFrameInfo);
+  if (m_spool && !SaveSpooledFrames(spooledFrameListOffset, file))
+    return false;
+
   if (!file.Close())
     return false;
 
@@ -246,13 +371,14 @@ std::unique_ptr<FifoDataFile> FifoDataFile::Load(const std::string& filename, bo
     dstFrame.fifoStart = srcFrame.fifoStart;
     dstFrame.fifoEnd = srcFrame.fifoEnd;
 
-    file.Seek(srcFrame.fifoDataOffset, SEEK_SET);
-    file.ReadBytes(dstFrame.fifoData.data(), srcFrame.fifoDataSize);
+    // Older versions left the reserved bytes uninitialized.
+    const u8 flags = header.file_version >= 5 ? srcFrame.fifoDataFlags : 0;
+    ReadData(srcFrame.fifoDataOffset, flags, &dstFrame.fifoData, file);
 
     ReadMemoryUpdates(srcFrame.memoryUpdatesOffset, srcFrame.numMemoryUpdates,
-                      dstFrame.memoryUpdates, file);
+                      header.file_version, dstFrame.memoryUpdates, file);
 
-    dataFile->AddFrame(dstFrame);
+    dataFile->AddFrame(std::move(dstFrame));
   }
 
   file.Close();
@@ -279,7 +405,7 @@ bool FifoDataFile::GetFlag(u32 flag) const
   return !!(m_Flags & flag);
 }
 
-u64 FifoDataFile::WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates,
+u64 FifoDataFile::WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates, bool compress,
                                      File::IOFile& file)
 {
   // Add space for memory update list
@@ -293,14 +419,15 @@ u64 FifoDataFile::WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates
     // Write memory
     file.Seek(0, SEEK_END);
     u64 dataOffset = file.Tell();
-    file.WriteBytes(srcUpdate.data.data(), srcUpdate.data.size());
+    const u8 dataFlags = WriteData(srcUpdate.data.data(), srcUpdate.data.size(), compress, file);
 
-    FileMemoryUpdate dstUpdate;
+    FileMemoryUpdate dstUpdate{};
     dstUpdate.address = srcUpdate.address;
     dstUpdate.dataOffset = dataOffset;
     dstUpdate.dataSize = static_cast<u32>(srcUpdate.data.size());
     dstUpdate.fifoPosition = srcUpdate.fifoPosition;
     dstUpdate.type = srcUpdate.type;
+    dstUpdate.dataFlags = dataFlags;
 
     u64 updateOffset = updateListOffset + (i * sizeof(FileMemoryUpdate));
     file.Seek(updateOffset, SEEK_SET);
@@ -310,7 +437,7 @@ u64 FifoDataFile::WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates
   return updateListOffset;
 }
 
-void FifoDataFile::ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
+void FifoDataFile::ReadMemoryUpdates(u64 fileOffset, u32 numUpdates, u32 version,
                                      std::vector<MemoryUpdate>& memUpdates, File::IOFile& file)
 {
   memUpdates.resize(numUpdates);
@@ -328,7 +455,99 @@ void FifoDataFile::ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
     dstUpdate.data.resize(srcUpdate.dataSize);
     dstUpdate.type = static_cast<MemoryUpdate::Type>(srcUpdate.type);
 
-    file.Seek(srcUpdate.dataOffset, SEEK_SET);
-    file.ReadBytes(dstUpdate.data.data(), srcUpdate.dataSize);
+    ReadData(srcUpdate.dataOffset, version >= 5 ? srcUpdate.dataFlags : 0, &dstUpdate.data, file);
   }
 }
+
+void FifoDataFile::SpoolFrame(const FifoFrameInfo& frameInfo)
+{
+  Spool& spool = *m_spool;
+  File::IOFile& file = spool.file;
+  file.Seek(0, SEEK_END);
+
+  Spool::Frame frame{};
+  frame.info.fifoDataOffset = file.Tell();
+  frame.info.fifoDataSize = static_cast<u32>(frameInfo.fifoData.size());
+  frame.info.fifoDataFlags =
+      WriteData(frameInfo.fifoData.data(), frameInfo.fifoData.size(), spool.compress, file);
+  frame.info.fifoStart = frameInfo.fifoStart;
+  frame.info.fifoEnd = frameInfo.fifoEnd;
+  frame.info.numMemoryUpdates = static_cast<u32>(frameInfo.memoryUpdates.size());
+
+  frame.memoryUpdates.reserve(frameInfo.memoryUpdates.size());
+  for (const MemoryUpdate& srcUpdate : frameInfo.memoryUpdates)
+  {
+    FileMemoryUpdate dstUpdate{};
+    dstUpdate.fifoPosition = srcUpdate.fifoPosition;
+    dstUpdate.address = srcUpdate.address;
+    dstUpdate.dataSize = static_cast<u32>(srcUpdate.data.size());
+    dstUpdate.type = srcUpdate.type;
+
+    // Games keep uploading the same textures and vertex data, often to different addresses, so
+    // updates point at the data of an earlier update with the same contents if there is one.
+    const u64 hash = XXH64(srcUpdate.data.data(), srcUpdate.data.size(), 0);
+    auto iter = spool.data.find(hash);
+    Spool::Data data;
+    if (iter != spool.data.end() && iter->second.size == dstUpdate.dataSize)
+    {
+      data = iter->second;
+    }
+    else
+    {
+      data.offset = file.Tell();
+      data.size = dstUpdate.dataSize;
+      data.flags = WriteData(srcUpdate.data.data(), srcUpdate.data.size(), spool.compress, file);
+      spool.data[hash] = data;
+    }
+    dstUpdate.dataOffset = data.offset;
+    dstUpdate.dataFlags = data.flags;
+
+    frame.memoryUpdates.push_back(dstUpdate);
+  }
+
+  spool.frames.push_back(std::move(frame));
+}
+
+bool FifoDataFile::SaveSpooledFrames(u64 frameListOffset, File::IOFile& file)
+{
+  Spool& spool = *m_spool;
+
+  // The spooled data is copied as is, so its offsets only move by where it starts in the file.
+  file.Seek(0, SEEK_END);
+  const u64 base_offset = file.Tell();
+
+  spool.file.Flush();
+  spool.file.Seek(0, SEEK_SET);
+  std::vector<u8> buffer(1024 * 1024);
+  for (u64 remaining = spool.file.GetSize(); remaining != 0;)
+  {
+    const size_t chunk_size = static_cast<size_t>(std::min<u64>(buffer.size(), remaining));
+    if (!spool.file.ReadBytes(buffer.data(), chunk_size) ||
+        !file.WriteBytes(buffer.data(), chunk_size))
+    {
+      return false;
+    }
+    remaining -= chunk_size;
+  }
+
+  for (size_t i = 0; i < spool.frames.size(); ++i)
+  {
+    const Spool::Frame& frame = spool.frames[i];
+
+    FileFrameInfo dstFrame = frame.info;
+    dstFrame.fifoDataOffset += base_offset;
+    dstFrame.memoryUpdatesOffset = file.Tell();
+    for (FileMemoryUpdate dstUpdate : frame.memoryUpdates)
+    {
+      dstUpdate.dataOffset += base_offset;
+      file.WriteBytes(&dstUpdate, sizeof(FileMemoryUpdate));
+    }
+
+    const u64 frameOffset = frameListOffset + (i * sizeof(FileFrameInfo));
+    file.Seek(frameOffset, SEEK_SET);
+    file.WriteBytes(&dstFrame, sizeof(FileFrameInfo));
+    file.Seek(0, SEEK_END);
+  }
+
+  return file.IsGood();
+}
@@ -66,14 +66,23 @@ public:
   u32* GetXFMem() { return m_XFMem; }
   u32* GetXFRegs() { return m_XFRegs; }
   u8* GetTexMem() { return m_TexMem; }
-  void AddFrame(const FifoFrameInfo& frameInfo);
+  void AddFrame(FifoFrameInfo frameInfo);
+  // Only the frames kept in memory can be accessed, not the spooled ones.
   const FifoFrameInfo& GetFrame(u32 frame) const { return m_Frames[frame]; }
-  u32 GetFrameCount() const { return static_cast<u32>(m_Frames.size()); }
+  u32 GetFrameCount() const;
   bool Save(const std::string& filename);
 
+  // Writes the frames added after this to spool_filename instead of keeping them in memory, so
+  // that long recordings don't run out of memory. Memory updates with the same data as an earlier
+  // update are only stored once, and the data is compressed if compress is set. Save() copies the
+  // spooled frames into the saved file. The spool file is deleted along with this object.
+  bool StartSpooling(const std::string& spool_filename, bool compress);
+
   static std::unique_ptr<FifoDataFile> Load(const std::string& filename, bool flagsOnly);
 
 private:
+  struct Spool;
+
   enum
   {
     FLAG_IS_WII = 1
@@ -84,10 +93,14 @@ private:
   void SetFlag(u32 flag, bool set);
   bool GetFlag(u32 flag) const;
 
-  u64 WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates, File::IOFile& file);
-  static void ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
+  u64 WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates, bool compress,
+                         File::IOFile& file);
+  static void ReadMemoryUpdates(u64 fileOffset, u32 numUpdates, u32 version,
                                 std::vector<MemoryUpdate>& memUpdates, File::IOFile& file);
 
+  void SpoolFrame(const FifoFrameInfo& frameInfo);
+  bool SaveSpooledFrames(u64 frameListOffset, File::IOFile& file);
+
   u32 m_BPMem[BP_MEM_SIZE];
   u32 m_CPMem[CP_MEM_SIZE];
   u32 m_XFMem[XF_MEM_SIZE];
@@ -98,4 +111,5 @@ private:
   u32 m_Version = 0;
 
   std::vector<FifoFrameInfo> m_Frames;
+  std::unique_ptr<Spool> m_spool;
 };
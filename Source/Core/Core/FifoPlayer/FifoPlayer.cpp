@@ -80,6 +80,7 @@ public:
     IsPlayingBackFifologWithBrokenEFBCopies = m_parent->m_File->HasBrokenEFBCopies();
 
     m_parent->m_CurrentFrame = m_parent->m_FrameRangeStart;
+    m_parent->m_CompletedPlaybacks = 0;
     m_parent->LoadMemory();
   }
 
@@ -127,7 +128,8 @@ CPU::State FifoPlayer::AdvanceFrame()
 {
   if (m_CurrentFrame >= m_FrameRangeEnd)
   {
-    if (!m_Loop)
+    ++m_CompletedPlaybacks;
+    if (m_PlaybackCount ? m_CompletedPlaybacks >= m_PlaybackCount : !m_Loop)
       return CPU::State::PowerDown;
     // If there are zero frames in the range then sleep instead of busy spinning
     if (m_FrameRangeStart >= m_FrameRangeEnd)
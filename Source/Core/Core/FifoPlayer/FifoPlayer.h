@@ -89,6 +89,11 @@ public:
   // If enabled then all memory updates happen at once before the first frame
   // Default is disabled
   void SetEarlyMemoryUpdates(bool enabled) { m_EarlyMemoryUpdates = enabled; }
+  // Number of times the frame range is played back before emulation stops.
+  // 0 (the default) loops forever or plays once, depending on bLoopFifoReplay.
+  void SetPlaybackCount(u32 count) { m_PlaybackCount = count; }
+  u32 GetPlaybackCount() const { return m_PlaybackCount; }
+  u32 GetCompletedPlaybacks() const { return m_CompletedPlaybacks; }
   // Callbacks
   void SetFileLoadedCallback(CallbackFunc callback) { m_FileLoadedCb = callback; }
   void SetFrameWrittenCallback(CallbackFunc callback) { m_FrameWrittenCb = callback; }
@@ -134,6 +139,8 @@ private:
   static bool IsHighWatermarkSet();
 
   bool m_Loop;
+  u32 m_PlaybackCount = 0;
+  u32 m_CompletedPlaybacks = 0;
 
   u32 m_CurrentFrame = 0;
   u32 m_FrameRangeStart = 0;
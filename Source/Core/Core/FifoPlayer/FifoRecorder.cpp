@@ -7,8 +7,11 @@
 #include <algorithm>
 #include <cstring>
 
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Common/Thread.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/FifoPlayer/FifoAnalyzer.h"
 #include "Core/FifoPlayer/FifoRecordAnalyzer.h"
@@ -24,7 +27,14 @@ void FifoRecorder::StartRecording(s32 numFrames, CallbackFunc finishedCb)
 
   FifoAnalyzer::Init();
 
+  // Finishes writing the frames of the previous recording before its file is replaced.
+  m_FrameWriter.Reset([this](FifoFrameInfo frame) { m_File->AddFrame(std::move(frame)); });
+
   m_File = std::make_unique<FifoDataFile>();
+  const std::string spool_path = File::GetUserPath(D_CACHE_IDX) + "FifoRecording.tmp";
+  File::CreateFullPath(spool_path);
+  if (!m_File->StartSpooling(spool_path, Config::Get(Config::MAIN_FIFO_RECORDER_COMPRESSION)))
+    WARN_LOG(VIDEO, "FifoRecorder: Failed to create %s, recording to memory", spool_path.c_str());
 
   // TODO: This, ideally, would be deallocated when done recording.
   //       However, care needs to be taken since global state
@@ -63,8 +73,9 @@ void FifoRecorder::StopRecording()
   m_RequestedRecordingEnd = true;
 }
 
-FifoDataFile* FifoRecorder::GetRecordedFile() const
+FifoDataFile* FifoRecorder::GetRecordedFile()
 {
+  m_FrameWriter.WaitForCompletion();
   return m_File.get();
 }
 
@@ -94,9 +105,8 @@ void FifoRecorder::WriteGPCommand(const u8* data, u32 size)
     {
       std::lock_guard<std::recursive_mutex> lk(m_mutex);
 
-      // Copy frame to file
-      // The file will be responsible for freeing the memory allocated for each frame's fifoData
-      m_File->AddFrame(m_CurrentFrame);
+      // Hand the frame to the writer thread, which adds it to the file
+      m_FrameWriter.EmplaceItem(std::move(m_CurrentFrame));
 
       if (m_FinishedCb && m_RequestedRecordingEnd)
         m_FinishedCb();
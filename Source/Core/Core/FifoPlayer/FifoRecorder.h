@@ -8,6 +8,7 @@
 #include <mutex>
 #include <vector>
 
+#include "Common/WorkQueueThread.h"
 #include "Core/FifoPlayer/FifoDataFile.h"
 
 class FifoRecorder
@@ -20,7 +21,8 @@ public:
   void StartRecording(s32 numFrames, CallbackFunc finishedCb);
   void StopRecording();
 
-  FifoDataFile* GetRecordedFile() const;
+  // Waits for the recorded frames to be written to the file.
+  FifoDataFile* GetRecordedFile();
   // Called from video thread
 
   // Must write one full GP command at a time
@@ -56,6 +58,8 @@ private:
   s32 m_RecordFramesRemaining = 0;
   CallbackFunc m_FinishedCb = nullptr;
   std::unique_ptr<FifoDataFile> m_File;
+  // Adds the recorded frames to m_File, which spools and compresses them.
+  Common::WorkQueueThread<FifoFrameInfo> m_FrameWriter;
 
   // Accessed only from video thread
 
@@ -15,6 +15,10 @@
 #include "Core/PowerPC/PowerPC.h"
 #include "VideoCommon/Fifo.h"
 
+#ifdef USE_GDBSTUB
+#include "Core/PowerPC/GDBStub.h"
+#endif
+
 namespace CPU
 {
 // CPU Thread execution state.
@@ -68,6 +72,8 @@ static void FlushStepSyncEventLocked()
   s_state_cpu_step_instruction = false;
 }
 
+static void RunAdjacentSystems(bool running);
+
 void Run()
 {
   std::unique_lock<std::mutex> state_lock(s_state_change_lock);
@@ -87,6 +93,18 @@ void Run()
       // If watchpoints are enabled, any instruction could be a breakpoint.
       if (PowerPC::GetMode() != PowerPC::CoreMode::Interpreter)
       {
+#ifdef USE_GDBSTUB
+        // Steps asked for by GDB are run by the interpreter, which reports them to GDB.
+        if (gdb_stepping())
+        {
+          PowerPC::CoreMode old_mode = PowerPC::GetMode();
+          PowerPC::SetMode(PowerPC::CoreMode::Interpreter);
+          while (gdb_stepping() && s_state == State::Running)
+            PowerPC::SingleStep();
+          PowerPC::SetMode(old_mode);
+        }
+#endif
+
         if (PowerPC::breakpoints.IsAddressBreakPoint(PC) || PowerPC::memchecks.HasAny())
         {
           s_state = State::Stepping;
@@ -107,6 +125,15 @@ void Run()
       break;
 
     case State::Stepping:
+#ifdef USE_GDBSTUB
+      // JIT code stops for steps asked for by GDB, which are run above.
+      if (gdb_jit_step_pending() && !s_state_paused_and_locked)
+      {
+        s_state = State::Running;
+        RunAdjacentSystems(true);
+        continue;
+      }
+#endif
       // Wait for step command.
       s_state_cpu_cvar.wait(state_lock,
                             [] { return s_state_cpu_step_instruction || !IsStepping(); });
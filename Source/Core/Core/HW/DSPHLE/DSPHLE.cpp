@@ -6,6 +6,7 @@
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
+#include "Common/Logging/Trace.h"
 #include "Common/MsgHandler.h"
 #include "Core/Core.h"
 #include "Core/HW/DSPHLE/UCodes/UCodes.h"
@@ -50,6 +51,7 @@ void DSPHLE::Shutdown()
 
 void DSPHLE::DSP_Update(int cycles)
 {
+  TRACE_SCOPE("DSPHLE::Update");
   if (m_ucode != nullptr)
     m_ucode->Update();
 }
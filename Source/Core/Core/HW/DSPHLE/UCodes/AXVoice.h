@@ -12,10 +12,12 @@
 #error AXVoice.h included without specifying version
 #endif
 
-#include <functional>
+#include <algorithm>
 #include <memory>
+#include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/Intrinsics.h"
 #include "Common/MathUtil.h"
 #include "Core/DSP/DSPAccelerator.h"
 #include "Core/HW/DSP.h"
@@ -23,6 +25,10 @@
 #include "Core/HW/DSPHLE/UCodes/AXStructs.h"
 #include "Core/HW/Memmap.h"
 
+#ifdef _M_ARM_64
+#include <arm_neon.h>
+#endif
+
 namespace DSP
 {
 namespace HLE
@@ -230,20 +236,37 @@ void AcceleratorSetup(PB_TYPE* pb)
   acc_end_reached = false;
 }
 
-// Reads a sample from the accelerator. Also handles looping and
+// Reads samples from the accelerator. Also handles looping and
 // disabling streams that reached the end (this is done by an exception raised
 // by the accelerator on real hardware).
-u16 AcceleratorGetSample()
+void AcceleratorGetSamples(s16* output, u32 count)
 {
-  // See below for explanations about acc_end_reached.
-  if (acc_end_reached)
-    return 0;
+  while (count != 0)
+  {
+    // See below for explanations about acc_end_reached.
+    if (acc_end_reached)
+    {
+      std::fill(output, output + count, 0);
+      return;
+    }
 
-  return s_accelerator->Read(acc_pb->adpcm.coefs);
+    const u32 read = s_accelerator->ReadSamples(acc_pb->adpcm.coefs, output, count);
+    output += read;
+    count -= read;
+  }
 }
 
-// Reads samples from the input callback, resamples them to <count> samples at
-// the wanted sample rate (computed from the ratio, see below).
+// Returns how many input samples ResampleAudio reads for <count> output
+// samples.
+u32 GetResampledInputCount(u32 count, u32 curr_pos, u32 ratio, int srctype)
+{
+  if (srctype != SRCTYPE_LINEAR && srctype != SRCTYPE_POLYPHASE)
+    return count;
+  return static_cast<u32>((curr_pos + static_cast<u64>(ratio) * count) >> 16);
+}
+
+// Resamples the input samples to <count> samples at the wanted sample rate
+// (computed from the ratio, see below).
 //
 // If srctype is SRCTYPE_POLYPHASE, coefficients need to be provided as well
 // (or the srctype will automatically be changed to LINEAR).
@@ -262,8 +285,8 @@ u16 AcceleratorGetSample()
 // We start getting samples not from sample 0, but 0.<curr_pos_frac>. This
 // avoids discontinuities in the audio stream, especially with very low ratios
 // which interpolate a lot of values between two "real" samples.
-u32 ResampleAudio(std::function<s16(u32)> input_callback, s16* output, u32 count, s16* last_samples,
-                  u32 curr_pos, u32 ratio, int srctype, const s16* coeffs)
+u32 ResampleAudio(const s16* input, s16* output, u32 count, s16* last_samples, u32 curr_pos,
+                  u32 ratio, int srctype, const s16* coeffs)
 {
   int read_samples_count = 0;
 
@@ -286,7 +309,7 @@ u32 ResampleAudio(std::function<s16(u32)> input_callback, s16* output, u32 count
       curr_pos += ratio;
       while (curr_pos >= 0x10000)
       {
-        temp[idx++ & 3] = input_callback(read_samples_count++);
+        temp[idx++ & 3] = input[read_samples_count++];
         curr_pos -= 0x10000;
       }
 
@@ -329,7 +352,7 @@ u32 ResampleAudio(std::function<s16(u32)> input_callback, s16* output, u32 count
       // circular buffer.
       while (curr_pos >= 0x10000)
       {
-        temp[idx++ & 3] = input_callback(read_samples_count++);
+        temp[idx++ & 3] = input[read_samples_count++];
         curr_pos -= 0x10000;
       }
 
@@ -369,7 +392,7 @@ u32 ResampleAudio(std::function<s16(u32)> input_callback, s16* output, u32 count
     // No sample rate conversion here: simply read samples from the
     // accelerator to the output buffer.
     for (u32 i = 0; i < count; ++i)
-      output[i] = input_callback(i);
+      output[i] = input[i];
 
     memcpy(last_samples, output + count - 4, 4 * sizeof(u16));
   }
@@ -385,9 +408,14 @@ void GetInputSamples(PB_TYPE& pb, s16* samples, u16 count, const s16* coeffs)
 
   if (coeffs)
     coeffs += pb.coef_select * 0x200;
-  u32 curr_pos =
-      ResampleAudio([](u32) { return AcceleratorGetSample(); }, samples, count, pb.src.last_samples,
-                    pb.src.cur_addr_frac, HILO_TO_32(pb.src.ratio), pb.src_type, coeffs);
+  // The samples are decoded in one go before resampling them.
+  static std::vector<s16> input;
+  input.resize(GetResampledInputCount(count, pb.src.cur_addr_frac, HILO_TO_32(pb.src.ratio),
+                                      pb.src_type));
+  AcceleratorGetSamples(input.data(), static_cast<u32>(input.size()));
+
+  u32 curr_pos = ResampleAudio(input.data(), samples, count, pb.src.last_samples,
+                               pb.src.cur_addr_frac, HILO_TO_32(pb.src.ratio), pb.src_type, coeffs);
   pb.src.cur_addr_frac = (curr_pos & 0xFFFF);
 
   // Update current position, YN1, YN2 and pred scale in the PB.
@@ -398,6 +426,97 @@ void GetInputSamples(PB_TYPE& pb, s16* samples, u16 count, const s16* coeffs)
   pb.adpcm.pred_scale = s_accelerator->GetPredScale();
 }
 
+// Multiply <count> samples by a 1.15 fixed point volume which changes by
+// <volume_delta> after each sample, wrapping around like the DSP does.
+// Returns the volume after the last sample.
+u16 ApplyVolume(s16* output, const s16* input, u32 count, u16 volume, u16 volume_delta)
+{
+  u32 i = 0;
+
+#if defined(_M_X86)
+  // SSE2 has no signed by unsigned 16 bit multiply, so multiply by the volume
+  // as a signed value and add input << 16 back for volumes >= 0x8000.
+  __m128i volumes = _mm_add_epi16(
+      _mm_set1_epi16(volume),
+      _mm_mullo_epi16(_mm_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7), _mm_set1_epi16(volume_delta)));
+  const __m128i volume_step = _mm_set1_epi16(static_cast<u16>(volume_delta * 8));
+  const __m128i min_sample = _mm_set1_epi16(-32767);
+  const __m128i zero = _mm_setzero_si128();
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+    const __m128i lo = _mm_mullo_epi16(samples, volumes);
+    const __m128i hi = _mm_mulhi_epi16(samples, volumes);
+    const __m128i fixup = _mm_and_si128(samples, _mm_srai_epi16(volumes, 15));
+    __m128i products0 = _mm_add_epi32(_mm_unpacklo_epi16(lo, hi), _mm_unpacklo_epi16(zero, fixup));
+    __m128i products1 = _mm_add_epi32(_mm_unpackhi_epi16(lo, hi), _mm_unpackhi_epi16(zero, fixup));
+    products0 = _mm_srai_epi32(products0, 15);
+    products1 = _mm_srai_epi32(products1, 15);
+    const __m128i result = _mm_max_epi16(_mm_packs_epi32(products0, products1), min_sample);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), result);
+    volumes = _mm_add_epi16(volumes, volume_step);
+  }
+#elif defined(_M_ARM_64)
+  static const u16 lane_index[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+  uint16x8_t volumes = vmlaq_n_u16(vdupq_n_u16(volume), vld1q_u16(lane_index), volume_delta);
+  const uint16x8_t volume_step = vdupq_n_u16(static_cast<u16>(volume_delta * 8));
+  const int16x8_t min_sample = vdupq_n_s16(-32767);
+  for (; i + 8 <= count; i += 8)
+  {
+    const int16x8_t samples = vld1q_s16(input + i);
+    int32x4_t products0 =
+        vmulq_s32(vmovl_s16(vget_low_s16(samples)),
+                  vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(volumes))));
+    int32x4_t products1 =
+        vmulq_s32(vmovl_s16(vget_high_s16(samples)),
+                  vreinterpretq_s32_u32(vmovl_u16(vget_high_u16(volumes))));
+    products0 = vshrq_n_s32(products0, 15);
+    products1 = vshrq_n_s32(products1, 15);
+    const int16x8_t result =
+        vmaxq_s16(vcombine_s16(vqmovn_s32(products0), vqmovn_s32(products1)), min_sample);
+    vst1q_s16(output + i, result);
+    volumes = vaddq_u16(volumes, volume_step);
+  }
+#endif
+
+  volume += static_cast<u16>(volume_delta * i);
+  for (; i < count; ++i)
+  {
+    output[i] = MathUtil::Clamp((s32)input[i] * volume >> 15, -32767, 32767);  // -32768 ?
+    volume += volume_delta;
+  }
+
+  return volume;
+}
+
+// Add <count> samples to a 32 bit output buffer.
+void AddSamples(int* out, const s16* input, u32 count)
+{
+  u32 i = 0;
+
+#if defined(_M_X86)
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+    __m128i* const dst = reinterpret_cast<__m128i*>(out + i);
+    const __m128i samples0 = _mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16);
+    const __m128i samples1 = _mm_srai_epi32(_mm_unpackhi_epi16(samples, samples), 16);
+    _mm_storeu_si128(dst, _mm_add_epi32(_mm_loadu_si128(dst), samples0));
+    _mm_storeu_si128(dst + 1, _mm_add_epi32(_mm_loadu_si128(dst + 1), samples1));
+  }
+#elif defined(_M_ARM_64)
+  for (; i + 8 <= count; i += 8)
+  {
+    const int16x8_t samples = vld1q_s16(input + i);
+    vst1q_s32(out + i, vaddw_s16(vld1q_s32(out + i), vget_low_s16(samples)));
+    vst1q_s32(out + i + 4, vaddw_s16(vld1q_s32(out + i + 4), vget_high_s16(samples)));
+  }
+#endif
+
+  for (; i < count; ++i)
+    out[i] += input[i];
+}
+
 // Add samples to an output buffer, with optional volume ramping.
 void MixAdd(int* out, const s16* input, u32 count, u16* pvol, s16* dpop, bool ramp)
 {
@@ -410,18 +529,13 @@ void MixAdd(int* out, const s16* input, u32 count, u16* pvol, s16* dpop, bool ra
   if (!ramp)
     volume_delta = 0;
 
-  for (u32 i = 0; i < count; ++i)
-  {
-    s64 sample = input[i];
-    sample *= volume;
-    sample >>= 15;
-    sample = MathUtil::Clamp((s32)sample, -32767, 32767);  // -32768 ?
-
-    out[i] += (s16)sample;
-    volume += volume_delta;
+  if (!count)
+    return;
 
-    *dpop = (s16)sample;
-  }
+  s16 samples[MAX_SAMPLES_PER_FRAME];
+  volume = ApplyVolume(samples, input, count, volume, volume_delta);
+  AddSamples(out, samples, count);
+  *dpop = samples[count - 1];
 }
 
 // Execute a low pass filter on the samples using one history value. Returns
@@ -447,12 +561,8 @@ void ProcessVoice(PB_TYPE& pb, const AXBuffers& buffers, u16 count, AXMixControl
   GetInputSamples(pb, samples, count, coeffs);
 
   // Apply a global volume ramp using the volume envelope parameters.
-  for (u32 i = 0; i < count; ++i)
-  {
-    samples[i] = MathUtil::Clamp(((s32)samples[i] * pb.vol_env.cur_volume) >> 15, -32767,
-                                 32767);  // -32768 ?
-    pb.vol_env.cur_volume += pb.vol_env.cur_volume_delta;
-  }
+  pb.vol_env.cur_volume = ApplyVolume(samples, samples, count, pb.vol_env.cur_volume,
+                                      static_cast<u16>(pb.vol_env.cur_volume_delta));
 
   // Optionally, execute a low pass filter
   // TODO: LPF code is currently broken, causing Super Monkey Ball sound
@@ -528,9 +638,8 @@ void ProcessVoice(PB_TYPE& pb, const AXBuffers& buffers, u16 count, AXMixControl
 
     // We use ratio 0x55555 == (5 * 65536 + 21845) / 65536 == 5.3333 which
     // is the nearest we can get to 96/18
-    u32 curr_pos = ResampleAudio([&samples](u32 i) { return samples[i]; }, wm_samples, wm_count,
-                                 pb.remote_src.last_samples, pb.remote_src.cur_addr_frac, 0x55555,
-                                 SRCTYPE_POLYPHASE, coeffs);
+    u32 curr_pos = ResampleAudio(samples, wm_samples, wm_count, pb.remote_src.last_samples,
+                                 pb.remote_src.cur_addr_frac, 0x55555, SRCTYPE_POLYPHASE, coeffs);
     pb.remote_src.cur_addr_frac = curr_pos & 0xFFFF;
 
 // Mix to main[0-3] and aux[0-3]
@@ -5,11 +5,14 @@
 #include "Core/HW/DSPHLE/UCodes/Zelda.h"
 
 #include <array>
+#include <cstdint>
 #include <map>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
+#include "Common/Intrinsics.h"
 #include "Common/Logging/Log.h"
+#include "Common/MathUtil.h"
 #include "Common/Swap.h"
 #include "Core/ARBruteForcer.h"
 #include "Core/Core.h"
@@ -19,6 +22,10 @@
 #include "Core/HW/DSPHLE/UCodes/GBA.h"
 #include "Core/HW/DSPHLE/UCodes/UCodes.h"
 
+#ifdef _M_ARM_64
+#include <arm_neon.h>
+#endif
+
 namespace DSP
 {
 namespace HLE
@@ -972,6 +979,140 @@ struct ReverbPB
 };
 #pragma pack(pop)
 
+#if defined(_M_X86)
+// Multiplies 8 samples by an unsigned volume, into 32 bit products. SSE2 has no signed by unsigned
+// 16 bit multiply, so the volume is used as a signed value, and the samples are added back to the
+// high halves for volumes >= 0x8000.
+static void MultiplyByVolume(__m128i samples, u16 vol, __m128i* products0, __m128i* products1)
+{
+  const __m128i volumes = _mm_set1_epi16(vol);
+  const __m128i lo = _mm_mullo_epi16(samples, volumes);
+  __m128i hi = _mm_mulhi_epi16(samples, volumes);
+  if (vol & 0x8000)
+    hi = _mm_add_epi16(hi, samples);
+  *products0 = _mm_unpacklo_epi16(lo, hi);
+  *products1 = _mm_unpackhi_epi16(lo, hi);
+}
+#endif
+
+void ZeldaAudioRenderer::ApplyVolumeInPlace(s16* buf, size_t count, u16 vol, int shift)
+{
+  size_t i = 0;
+#if defined(_M_X86)
+  const __m128i shift_count = _mm_cvtsi32_si128(shift);
+  for (; i + 8 <= count; i += 8)
+  {
+    __m128i products0, products1;
+    MultiplyByVolume(_mm_loadu_si128(reinterpret_cast<const __m128i*>(buf + i)), vol, &products0,
+                     &products1);
+    products0 = _mm_sra_epi32(products0, shift_count);
+    products1 = _mm_sra_epi32(products1, shift_count);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(buf + i), _mm_packs_epi32(products0, products1));
+  }
+#elif defined(_M_ARM_64)
+  const int32x4_t shift_count = vdupq_n_s32(-shift);
+  for (; i + 8 <= count; i += 8)
+  {
+    const int16x8_t samples = vld1q_s16(buf + i);
+    const int32x4_t products0 = vshlq_s32(vmulq_n_s32(vmovl_s16(vget_low_s16(samples)), vol),
+                                          shift_count);
+    const int32x4_t products1 = vshlq_s32(vmulq_n_s32(vmovl_s16(vget_high_s16(samples)), vol),
+                                          shift_count);
+    vst1q_s16(buf + i, vcombine_s16(vqmovn_s32(products0), vqmovn_s32(products1)));
+  }
+#endif
+
+  for (; i < count; ++i)
+  {
+    s32 tmp = (u32)buf[i] * (u32)vol;
+    tmp >>= shift;
+
+    buf[i] = (s16)MathUtil::Clamp(tmp, -0x8000, 0x7FFF);
+  }
+}
+
+s32 ZeldaAudioRenderer::AddBuffersWithVolumeRamp(s16* dst, const s16* src, size_t count, s32 vol,
+                                                  s32 step)
+{
+  size_t i = 0;
+#if defined(_M_X86)
+  // The integer parts of the volumes of 8 samples, then multiplied with the high half of the
+  // products.
+  __m128i volumes0 = _mm_add_epi32(_mm_set1_epi32(vol),
+                                   _mm_setr_epi32(0, step, u32(step) * 2, u32(step) * 3));
+  __m128i volumes1 = _mm_add_epi32(volumes0, _mm_set1_epi32(u32(step) * 4));
+  const __m128i volume_step = _mm_set1_epi32(u32(step) * 8);
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m128i volumes =
+        _mm_packs_epi32(_mm_srai_epi32(volumes0, 16), _mm_srai_epi32(volumes1, 16));
+    const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    __m128i* out = reinterpret_cast<__m128i*>(dst + i);
+    _mm_storeu_si128(out, _mm_add_epi16(_mm_loadu_si128(out), _mm_mulhi_epi16(volumes, samples)));
+    volumes0 = _mm_add_epi32(volumes0, volume_step);
+    volumes1 = _mm_add_epi32(volumes1, volume_step);
+  }
+#elif defined(_M_ARM_64)
+  const s32 lane_steps[4] = {0, step, s32(u32(step) * 2), s32(u32(step) * 3)};
+  int32x4_t volumes0 = vaddq_s32(vdupq_n_s32(vol), vld1q_s32(lane_steps));
+  int32x4_t volumes1 = vaddq_s32(volumes0, vdupq_n_s32(s32(u32(step) * 4)));
+  const int32x4_t volume_step = vdupq_n_s32(s32(u32(step) * 8));
+  for (; i + 8 <= count; i += 8)
+  {
+    const int16x8_t samples = vld1q_s16(src + i);
+    const int16x4_t products0 =
+        vshrn_n_s32(vmull_s16(vshrn_n_s32(volumes0, 16), vget_low_s16(samples)), 16);
+    const int16x4_t products1 =
+        vshrn_n_s32(vmull_s16(vshrn_n_s32(volumes1, 16), vget_high_s16(samples)), 16);
+    vst1q_s16(dst + i, vaddq_s16(vld1q_s16(dst + i), vcombine_s16(products0, products1)));
+    volumes0 = vaddq_s32(volumes0, volume_step);
+    volumes1 = vaddq_s32(volumes1, volume_step);
+  }
+#endif
+
+  vol = s32(u32(vol) + u32(step) * u32(i));
+  for (; i < count; ++i)
+  {
+    dst[i] += ((vol >> 16) * src[i]) >> 16;
+    vol += step;
+  }
+
+  return vol;
+}
+
+void ZeldaAudioRenderer::AddBuffersWithVolume(s16* dst, const s16* src, size_t count, u16 vol)
+{
+  size_t i = 0;
+#if defined(_M_X86)
+  for (; i + 8 <= count; i += 8)
+  {
+    __m128i products0, products1;
+    MultiplyByVolume(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)), vol, &products0,
+                     &products1);
+    const __m128i result =
+        _mm_packs_epi32(_mm_srai_epi32(products0, 15), _mm_srai_epi32(products1, 15));
+    __m128i* out = reinterpret_cast<__m128i*>(dst + i);
+    _mm_storeu_si128(out, _mm_add_epi16(_mm_loadu_si128(out), result));
+  }
+#elif defined(_M_ARM_64)
+  for (; i + 8 <= count; i += 8)
+  {
+    const int16x8_t samples = vld1q_s16(src + i);
+    const int32x4_t products0 = vmulq_n_s32(vmovl_s16(vget_low_s16(samples)), vol);
+    const int32x4_t products1 = vmulq_n_s32(vmovl_s16(vget_high_s16(samples)), vol);
+    const int16x8_t result =
+        vcombine_s16(vqshrn_n_s32(products0, 15), vqshrn_n_s32(products1, 15));
+    vst1q_s16(dst + i, vaddq_s16(vld1q_s16(dst + i), result));
+  }
+#endif
+
+  for (; i < count; ++i)
+  {
+    s32 vol_src = ((s32)src[i] * (s32)vol) >> 15;
+    dst[i] += MathUtil::Clamp(vol_src, -0x8000, 0x7FFF);
+  }
+}
+
 void ZeldaAudioRenderer::PrepareFrame()
 {
   if (m_prepared)
@@ -1081,12 +1222,30 @@ void ZeldaAudioRenderer::ApplyReverb(bool post_rendering)
         (*last8_samples_buffers[rpb_idx])[i] = buffer[0x50 + i];
 
       auto ApplyFilter = [&]() {
-        // Filter the buffer using provided coefficients.
+        // Filter the buffer using provided coefficients. Each sample only depends on samples
+        // which haven't been filtered yet, so the taps of a sample are added up at once.
+#if defined(_M_X86)
+        const __m128i coeffs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rpb.filter_coeffs));
+#elif defined(_M_ARM_64)
+        const int16x8_t coeffs = vld1q_s16(rpb.filter_coeffs);
+#endif
         for (u16 i = 0; i < 0x50; ++i)
         {
+#if defined(_M_X86)
+          __m128i sums = _mm_madd_epi16(
+              _mm_loadu_si128(reinterpret_cast<const __m128i*>(&buffer[i])), coeffs);
+          sums = _mm_add_epi32(sums, _mm_shuffle_epi32(sums, _MM_SHUFFLE(1, 0, 3, 2)));
+          sums = _mm_add_epi32(sums, _mm_shuffle_epi32(sums, _MM_SHUFFLE(2, 3, 0, 1)));
+          s32 sample = _mm_cvtsi128_si32(sums);
+#elif defined(_M_ARM_64)
+          const int16x8_t samples = vld1q_s16(&buffer[i]);
+          s32 sample = vaddvq_s32(vmlal_s16(vmull_s16(vget_low_s16(samples), vget_low_s16(coeffs)),
+                                            vget_high_s16(samples), vget_high_s16(coeffs)));
+#else
           s32 sample = 0;
           for (u16 j = 0; j < 8; ++j)
             sample += (s32)buffer[i + j] * rpb.filter_coeffs[j];
+#endif
           sample >>= 15;
           buffer[i] = MathUtil::Clamp(sample, -0x8000, 0x7FFF);
         }
@@ -1523,10 +1682,26 @@ void ZeldaAudioRenderer::Resample(VPB* vpb, const s16* src, MixingBuffer* dst)
       const s16* coeffs = &m_resampling_coeffs[coeffs_idx];
       const s16* input = &src[pos >> 12];
 
+#if defined(_M_X86)
+      // pmaddwd only wraps when adding -0x8000 * -0x8000 twice, to -0x80000000, which no other
+      // pair of products adds up to.
+      const __m128i products =
+          _mm_madd_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(coeffs)),
+                         _mm_loadl_epi64(reinterpret_cast<const __m128i*>(input)));
+      const s32 sum0 = _mm_cvtsi128_si32(products);
+      const s32 sum1 = _mm_cvtsi128_si32(_mm_srli_si128(products, 4));
+      s64 dst_sample_unclamped = (sum0 == INT32_MIN ? 0x80000000LL : sum0) +
+                                 (sum1 == INT32_MIN ? 0x80000000LL : sum1);
+      dst_sample_unclamped = (dst_sample_unclamped * 2) >> 16;
+#elif defined(_M_ARM_64)
+      s64 dst_sample_unclamped = vaddlvq_s32(vmull_s16(vld1_s16(coeffs), vld1_s16(input)));
+      dst_sample_unclamped = (dst_sample_unclamped * 2) >> 16;
+#else
       s64 dst_sample_unclamped = 0;
       for (size_t i = 0; i < 4; ++i)
         dst_sample_unclamped += (s64)2 * coeffs[i] * input[i];
       dst_sample_unclamped >>= 16;
+#endif
 
       dst_sample = (s16)MathUtil::Clamp<s64>(dst_sample_unclamped, -0x8000, 0x7FFF);
 
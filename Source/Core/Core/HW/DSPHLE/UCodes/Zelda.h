@@ -7,7 +7,6 @@
 #include <array>
 
 #include "Common/CommonTypes.h"
-#include "Common/MathUtil.h"
 #include "Core/HW/DSPHLE/UCodes/UCodes.h"
 
 namespace DSP
@@ -49,14 +48,9 @@ private:
   template <size_t N, size_t B>
   void ApplyVolumeInPlace(std::array<s16, N>* buf, u16 vol)
   {
-    for (size_t i = 0; i < N; ++i)
-    {
-      s32 tmp = (u32)(*buf)[i] * (u32)vol;
-      tmp >>= 16 - B;
-
-      (*buf)[i] = (s16)MathUtil::Clamp(tmp, -0x8000, 0x7FFF);
-    }
+    ApplyVolumeInPlace(buf->data(), N, vol, 16 - B);
   }
+  static void ApplyVolumeInPlace(s16* buf, size_t count, u16 vol, int shift);
   template <size_t N>
   void ApplyVolumeInPlace_1_15(std::array<s16, N>* buf, u16 vol)
   {
@@ -80,25 +74,13 @@ private:
     if (!vol && !step)
       return vol;
 
-    for (size_t i = 0; i < N; ++i)
-    {
-      (*dst)[i] += ((vol >> 16) * src[i]) >> 16;
-      vol += step;
-    }
-
-    return vol;
+    return AddBuffersWithVolumeRamp(dst->data(), src.data(), N, vol, step);
   }
+  static s32 AddBuffersWithVolumeRamp(s16* dst, const s16* src, size_t count, s32 vol, s32 step);
 
   // Does not use std::array because it needs to be able to process partial
   // buffers. Volume is in 1.15 format.
-  void AddBuffersWithVolume(s16* dst, const s16* src, size_t count, u16 vol)
-  {
-    while (count--)
-    {
-      s32 vol_src = ((s32)*src++ * (s32)vol) >> 15;
-      *dst++ += MathUtil::Clamp(vol_src, -0x8000, 0x7FFF);
-    }
-  }
+  static void AddBuffersWithVolume(s16* dst, const s16* src, size_t count, u16 vol);
 
   // Whether the frame needs to be prepared or not.
   bool m_prepared = false;
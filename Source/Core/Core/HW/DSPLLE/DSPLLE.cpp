@@ -13,6 +13,7 @@
 #include "Common/CommonTypes.h"
 #include "Common/Event.h"
 #include "Common/Logging/Log.h"
+#include "Common/Logging/Trace.h"
 #include "Common/MemoryUtil.h"
 #include "Common/Thread.h"
 #include "Core/ConfigManager.h"
@@ -24,6 +25,7 @@
 #include "Core/DSP/DSPHost.h"
 #include "Core/DSP/DSPTables.h"
 #include "Core/DSP/Interpreter/DSPInterpreter.h"
+#include "Core/DSP/Jit/DSPEmitterBase.h"
 #include "Core/HW/DSPLLE/DSPLLEGlobals.h"
 #include "Core/HW/Memmap.h"
 #include "Core/Host.h"
@@ -65,10 +67,7 @@ void DSPLLE::DoState(PointerWrap& p)
   p.Do(g_dsp.exceptions);
   p.Do(g_dsp.external_interrupt_waiting);
 
-  for (int i = 0; i < 4; i++)
-  {
-    p.Do(g_dsp.reg_stack[i]);
-  }
+  p.DoArray(g_dsp.reg_stack);
 
   p.Do(g_dsp.step_counter);
   p.DoArray(g_dsp.ifx_regs);
@@ -92,12 +91,14 @@ void DSPLLE::DoState(PointerWrap& p)
 void DSPLLE::DSPThread(DSPLLE* dsp_lle)
 {
   Common::SetCurrentThreadName("DSP thread");
+  Trace::SetThreadName("DSP thread");
 
   while (dsp_lle->m_is_running.IsSet())
   {
     const int cycles = static_cast<int>(dsp_lle->m_cycle_count.load());
     if (cycles > 0)
     {
+      TRACE_SCOPE("DSPLLE::RunCycles");
       std::lock_guard<std::mutex> dsp_thread_lock(dsp_lle->m_dsp_thread_mutex);
       if (g_dsp_jit)
       {
@@ -153,7 +154,7 @@ static bool FillDSPInitOptions(DSPInitOptions* opts)
     return false;
 
   opts->core_type = DSPInitOptions::CORE_INTERPRETER;
-#ifdef _M_X86
+#if defined(_M_X86) || defined(_M_ARM_64)
   if (SConfig::GetInstance().m_DSPEnableJIT)
     opts->core_type = DSPInitOptions::CORE_JIT;
 #endif
@@ -315,11 +316,13 @@ void DSPLLE::DSP_Update(int cycles)
   if (!m_is_dsp_on_thread)
   {
     // ~1/6th as many cycles as the period PPC-side.
+    TRACE_SCOPE("DSPLLE::RunCycles");
     DSPCore_RunCycles(dsp_cycles);
   }
   else
   {
     // Wait for DSP thread to complete its cycle. Note: this logic should be thought through.
+    TRACE_SCOPE("DSPLLE::WaitForDSPThread");
     s_ppc_event.Wait();
     m_cycle_count.fetch_add(dsp_cycles);
     s_dsp_event.Set();
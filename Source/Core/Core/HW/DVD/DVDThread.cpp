@@ -4,11 +4,15 @@
 
 #include "Core/HW/DVD/DVDThread.h"
 
+#include <algorithm>
 #include <cinttypes>
+#include <iterator>
+#include <list>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <set>
 #include <thread>
 #include <utility>
 #include <vector>
@@ -19,6 +23,8 @@
 #include "Common/FifoQueue.h"
 #include "Common/Flag.h"
 #include "Common/Logging/Log.h"
+#include "Common/Logging/Trace.h"
+#include "Common/Metrics.h"
 #include "Common/MsgHandler.h"
 #include "Common/Thread.h"
 #include "Common/Timer.h"
@@ -63,6 +69,36 @@ struct ReadRequest
 
 using ReadResult = std::pair<ReadRequest, std::vector<u8>>;
 
+// The DVD thread reads the disc in blocks of this size, and keeps the most recently used blocks
+// in RAM. Pending requests are merged into reads of consecutive blocks, and blocks after a
+// sequential read are read ahead, once the results of the requests have been handed over.
+static constexpr u64 CACHE_BLOCK_SIZE = 0x8000;
+static constexpr size_t CACHE_MAX_BLOCKS = 512;  // 16 MiB
+// Larger requests bypass the cache, so they don't evict everything else.
+static constexpr u32 MAX_CACHED_READ_SIZE = 0x100000;
+// The read-ahead starts at one block after the first sequential read, and doubles with every
+// following one.
+static constexpr u64 MAX_READAHEAD_BLOCKS = 32;
+static constexpr u64 MAX_BLOCKS_PER_READ = 64;
+
+// Partition and block number
+using CacheKey = std::pair<DiscIO::Partition, u64>;
+
+struct CachedBlock
+{
+  std::vector<u8> data;
+  std::list<CacheKey>::iterator lru_position;
+};
+
+// Streamed audio keeps reading small sequential chunks while the game reads its data, so sequential
+// reads are detected separately for both, and neither one breaks the read-ahead of the other.
+struct ReadAhead
+{
+  DiscIO::Partition last_read_partition;
+  u64 last_read_end = 0;
+  u64 blocks = 0;
+};
+
 static void StartDVDThread();
 static void StopDVDThread();
 
@@ -89,6 +125,23 @@ static std::map<u64, ReadResult> s_result_map;
 
 static std::unique_ptr<DiscIO::Volume> s_disc;
 
+// Only used by the DVD thread, or while it is idle.
+static std::map<CacheKey, CachedBlock> s_block_cache;
+static std::list<CacheKey> s_block_cache_lru;  // Most recently used first
+static ReadAhead s_data_readahead;
+static ReadAhead s_dtk_readahead;
+
+static Metrics::Counter s_read_bytes("dolphin_dvd_read_bytes_total",
+                                     "Bytes read from the disc image, including readahead.");
+
+static void ClearBlockCache()
+{
+  s_block_cache.clear();
+  s_block_cache_lru.clear();
+  s_data_readahead = ReadAhead();
+  s_dtk_readahead = ReadAhead();
+}
+
 void Start()
 {
   s_finish_read = CoreTiming::RegisterEvent("FinishReadDVDThread", FinishRead);
@@ -116,6 +169,7 @@ void Stop()
 {
   StopDVDThread();
   s_disc.reset();
+  ClearBlockCache();
 }
 
 static void StopDVDThread()
@@ -179,6 +233,7 @@ void SetDisc(std::unique_ptr<DiscIO::Volume> disc)
 {
   WaitUntilIdle();
   s_disc = std::move(disc);
+  ClearBlockCache();
 }
 
 bool HasDisc()
@@ -335,10 +390,170 @@ static void FinishRead(u64 id, s64 cycles_late)
                                        buffer);
 }
 
+static bool IsCacheable(const ReadRequest& request)
+{
+  return request.length != 0 && request.length <= MAX_CACHED_READ_SIZE;
+}
+
+// Reads count blocks starting at first into the cache.
+static bool ReadBlocks(const DiscIO::Partition& partition, u64 first, u64 count)
+{
+  TRACE_SCOPE("DVDThread::ReadBlocks");
+  std::vector<u8> buffer(count * CACHE_BLOCK_SIZE);
+  if (!s_disc->Read(first * CACHE_BLOCK_SIZE, buffer.size(), buffer.data(), partition))
+    return false;
+  s_read_bytes.Increment(buffer.size());
+
+  for (u64 i = 0; i < count; i++)
+  {
+    const auto block_begin = buffer.begin() + i * CACHE_BLOCK_SIZE;
+    s_block_cache_lru.push_front({partition, first + i});
+    s_block_cache.emplace(s_block_cache_lru.front(),
+                          CachedBlock{std::vector<u8>(block_begin, block_begin + CACHE_BLOCK_SIZE),
+                                      s_block_cache_lru.begin()});
+  }
+  return true;
+}
+
+// Finds the blocks needed by the requests, and those of the read-ahead, which aren't cached yet.
+static void FindMissingBlocks(const std::vector<ReadRequest>& requests, std::set<CacheKey>* needed,
+                              std::set<CacheKey>* readahead)
+{
+  for (const ReadRequest& request : requests)
+  {
+    if (!IsCacheable(request))
+      continue;
+
+    ReadAhead& state =
+        request.reply_type == DVDInterface::ReplyType::DTK ? s_dtk_readahead : s_data_readahead;
+    const bool sequential =
+        request.partition == state.last_read_partition && request.dvd_offset == state.last_read_end;
+    state.blocks =
+        sequential ? std::min(std::max<u64>(state.blocks * 2, 1), MAX_READAHEAD_BLOCKS) : 0;
+    state.last_read_partition = request.partition;
+    state.last_read_end = request.dvd_offset + request.length;
+
+    const u64 first = request.dvd_offset / CACHE_BLOCK_SIZE;
+    const u64 last = (state.last_read_end - 1) / CACHE_BLOCK_SIZE;
+    for (u64 block = first; block <= last; block++)
+    {
+      const auto it = s_block_cache.find({request.partition, block});
+      if (it != s_block_cache.end())
+        s_block_cache_lru.splice(s_block_cache_lru.begin(), s_block_cache_lru,
+                                 it->second.lru_position);
+      else
+        needed->emplace(request.partition, block);
+    }
+
+    // Only refill the read-ahead once half of it has been used, so it's done in large reads
+    // instead of one block after every request.
+    std::vector<u64> blocks;
+    for (u64 block = last + 1; block <= last + state.blocks; block++)
+    {
+      if (!s_block_cache.count({request.partition, block}))
+        blocks.push_back(block);
+    }
+    if (!blocks.empty() && blocks.size() >= std::max<u64>(state.blocks / 2, 1))
+    {
+      for (u64 block : blocks)
+        readahead->emplace(request.partition, block);
+    }
+  }
+
+  for (const CacheKey& key : *needed)
+    readahead->erase(key);
+}
+
+// Reads blocks into the cache, merging consecutive ones into one read.
+static void ReadMissingBlocks(const std::set<CacheKey>& blocks, bool needed)
+{
+  auto run_begin = blocks.begin();
+  while (run_begin != blocks.end())
+  {
+    const CacheKey& first = *run_begin;
+    auto run_end = std::next(run_begin);
+    u64 count = 1;
+    while (run_end != blocks.end() && run_end->first == first.first &&
+           run_end->second == first.second + count && count < MAX_BLOCKS_PER_READ)
+    {
+      ++run_end;
+      ++count;
+    }
+
+    if (!ReadBlocks(first.first, first.second, count) && needed)
+    {
+      // Probably the end of the disc or partition is within the run. Read the needed blocks on
+      // their own; the requests which still aren't cached are then read directly.
+      for (auto it = run_begin; it != run_end; ++it)
+        ReadBlocks(it->first, it->second, 1);
+    }
+
+    run_begin = run_end;
+  }
+}
+
+static bool ReadFromBlockCache(const ReadRequest& request, u8* buffer)
+{
+  const u64 end = request.dvd_offset + request.length;
+  for (u64 offset = request.dvd_offset; offset < end;)
+  {
+    const auto it = s_block_cache.find({request.partition, offset / CACHE_BLOCK_SIZE});
+    if (it == s_block_cache.end())
+      return false;
+
+    const u64 block_offset = offset % CACHE_BLOCK_SIZE;
+    const u64 size = std::min(CACHE_BLOCK_SIZE - block_offset, end - offset);
+    std::copy_n(it->second.data.begin() + block_offset, size,
+                buffer + (offset - request.dvd_offset));
+    offset += size;
+  }
+  return true;
+}
+
+static void ProcessRequests(std::vector<ReadRequest>& requests)
+{
+  TRACE_SCOPE("DVDThread::Read");
+  std::set<CacheKey> needed;
+  std::set<CacheKey> readahead;
+  FindMissingBlocks(requests, &needed, &readahead);
+  ReadMissingBlocks(needed, true);
+
+  for (ReadRequest& request : requests)
+  {
+    FileMonitor::Log(*s_disc, request.partition, request.dvd_offset);
+
+    std::vector<u8> buffer(request.length);
+    if (!IsCacheable(request) || !ReadFromBlockCache(request, buffer.data()))
+    {
+      if (s_disc->Read(request.dvd_offset, request.length, buffer.data(), request.partition))
+        s_read_bytes.Increment(request.length);
+      else
+        buffer.resize(0);
+    }
+
+    request.realtime_done_us = Common::Timer::GetTimeUs();
+
+    s_result_queue.Push(ReadResult(std::move(request), std::move(buffer)));
+    s_result_queue_expanded.Set();
+  }
+
+  // The emulated software never waits for the read-ahead, streamed audio in particular.
+  ReadMissingBlocks(readahead, false);
+
+  // Blocks are only evicted now, so the ones needed by the requests stayed in the cache.
+  while (s_block_cache.size() > CACHE_MAX_BLOCKS)
+  {
+    s_block_cache.erase(s_block_cache_lru.back());
+    s_block_cache_lru.pop_back();
+  }
+}
+
 static void DVDThread()
 {
   Common::SetCurrentThreadName("DVD thread");
+  Trace::SetThreadName("DVD thread");
 
+  std::vector<ReadRequest> requests;
   while (true)
   {
     s_request_queue_expanded.Wait();
@@ -346,19 +561,18 @@ static void DVDThread()
     if (s_dvd_thread_exiting.IsSet())
       return;
 
+    // Every request which has been popped must have its result pushed before exiting, as
+    // WaitUntilIdle only waits for the request queue to be empty.
     ReadRequest request;
     while (s_request_queue.Pop(request))
     {
-      FileMonitor::Log(*s_disc, request.partition, request.dvd_offset);
-
-      std::vector<u8> buffer(request.length);
-      if (!s_disc->Read(request.dvd_offset, request.length, buffer.data(), request.partition))
-        buffer.resize(0);
-
-      request.realtime_done_us = Common::Timer::GetTimeUs();
+      do
+      {
+        requests.push_back(std::move(request));
+      } while (s_request_queue.Pop(request));
 
-      s_result_queue.Push(ReadResult(std::move(request), std::move(buffer)));
-      s_result_queue_expanded.Set();
+      ProcessRequests(requests);
+      requests.clear();
 
       if (s_dvd_thread_exiting.IsSet())
         return;
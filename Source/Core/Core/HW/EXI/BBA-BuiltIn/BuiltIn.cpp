@@ -0,0 +1,1161 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Core/HW/EXI/BBA-BuiltIn/BuiltIn.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#ifdef _WIN32
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include "Common/Logging/Log.h"
+#include "Common/StringUtil.h"
+#include "Common/Timer.h"
+#include "Core/Config/MainSettings.h"
+
+namespace ExpansionInterface
+{
+namespace
+{
+using Socket = BuiltInNetworkInterface::Socket;
+
+#ifdef _WIN32
+const Socket INVALID_SOCKET_HANDLE = INVALID_SOCKET;
+#else
+const Socket INVALID_SOCKET_HANDLE = -1;
+#endif
+
+#ifdef MSG_NOSIGNAL
+constexpr int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+constexpr int SEND_FLAGS = 0;
+#endif
+
+constexpr u16 ETHERTYPE_IPV4 = 0x0800;
+constexpr u16 ETHERTYPE_ARP = 0x0806;
+constexpr u8 IP_PROTOCOL_TCP = 6;
+constexpr u8 IP_PROTOCOL_UDP = 17;
+
+constexpr u8 TCP_FIN = 0x01;
+constexpr u8 TCP_SYN = 0x02;
+constexpr u8 TCP_RST = 0x04;
+constexpr u8 TCP_PSH = 0x08;
+constexpr u8 TCP_ACK = 0x10;
+
+constexpr u32 ETHERNET_HEADER_SIZE = 14;
+constexpr u32 ARP_PACKET_SIZE = 28;
+constexpr u32 IPV4_HEADER_SIZE = 20;
+constexpr u32 UDP_HEADER_SIZE = 8;
+constexpr u32 TCP_HEADER_SIZE = 20;
+constexpr u32 MIN_FRAME_SIZE = 60;
+constexpr u32 MTU = 1500;
+constexpr u16 TCP_MSS = MTU - IPV4_HEADER_SIZE - TCP_HEADER_SIZE;
+constexpr u32 UDP_MAX_PAYLOAD = MTU - IPV4_HEADER_SIZE - UDP_HEADER_SIZE;
+
+constexpr u32 DHCP_MESSAGE_SIZE = 240;
+constexpr u32 DHCP_MAGIC = 0x63825363;
+constexpr u8 DHCP_DISCOVER = 1;
+constexpr u8 DHCP_OFFER = 2;
+constexpr u8 DHCP_REQUEST = 3;
+constexpr u8 DHCP_ACK = 5;
+constexpr u32 DHCP_LEASE_SECONDS = 24 * 60 * 60;
+
+// The network QEMU's user mode networking uses too. Connections to the router go to the host.
+constexpr u32 ROUTER_IP = 0x0a000202;
+constexpr u32 GUEST_IP = 0x0a00020f;
+constexpr u32 NETMASK = 0xffffff00;
+constexpr u32 BROADCAST_IP = 0xffffffff;
+constexpr u8 ROUTER_MAC[] = {0x02, 0x00, 0x0a, 0x00, 0x02, 0x02};
+constexpr u8 BROADCAST_MAC[] = {0xff, 0xff, 0xff, 0xff, 0xff, 0xff};
+
+// Received from the guest and not sent to the host yet, this is also the window advertised.
+constexpr u32 TCP_TO_HOST_BUFFER = 0xffff;
+// Sent to the guest and not acknowledged yet, so that the receive ring doesn't overflow.
+constexpr u32 TCP_MAX_IN_FLIGHT = 16 * TCP_MSS;
+constexpr u32 TCP_RETRANSMIT_MS = 500;
+constexpr u32 TCP_MAX_RETRANSMISSIONS = 10;
+constexpr u32 UDP_IDLE_MS = 2 * 60 * 1000;
+// Also the resolution of the retransmission timers.
+constexpr int POLL_TIMEOUT_MS = 100;
+
+u16 Read16(const u8* data)
+{
+  return static_cast<u16>(data[0] << 8 | data[1]);
+}
+
+u32 Read32(const u8* data)
+{
+  return static_cast<u32>(data[0]) << 24 | data[1] << 16 | data[2] << 8 | data[3];
+}
+
+void Write16(u8* data, u16 value)
+{
+  data[0] = static_cast<u8>(value >> 8);
+  data[1] = static_cast<u8>(value);
+}
+
+void Write32(u8* data, u32 value)
+{
+  Write16(data, static_cast<u16>(value >> 16));
+  Write16(data + 2, static_cast<u16>(value));
+}
+
+u32 ChecksumAdd(u32 sum, const u8* data, u32 size)
+{
+  for (u32 i = 0; i + 1 < size; i += 2)
+    sum += Read16(data + i);
+  if (size & 1)
+    sum += data[size - 1] << 8;
+  return sum;
+}
+
+u16 ChecksumFinish(u32 sum)
+{
+  while (sum >> 16)
+    sum = (sum & 0xffff) + (sum >> 16);
+  return static_cast<u16>(~sum);
+}
+
+// The checksum of a TCP or UDP header and payload, which covers an IPv4 pseudo header too.
+u16 TransportChecksum(u32 src_ip, u32 dst_ip, u8 protocol, const u8* data, u32 size)
+{
+  u8 pseudo_header[12];
+  Write32(pseudo_header, src_ip);
+  Write32(pseudo_header + 4, dst_ip);
+  pseudo_header[8] = 0;
+  pseudo_header[9] = protocol;
+  Write16(pseudo_header + 10, static_cast<u16>(size));
+  const u32 sum = ChecksumAdd(0, pseudo_header, sizeof(pseudo_header));
+  return ChecksumFinish(ChecksumAdd(sum, data, size));
+}
+
+u64 MakeTCPKey(u32 remote_ip, u16 remote_port, u16 guest_port)
+{
+  return static_cast<u64>(remote_ip) << 32 | static_cast<u32>(remote_port) << 16 | guest_port;
+}
+
+sockaddr_in MakeAddress(u32 ip, u16 port)
+{
+  sockaddr_in address = {};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(ip);
+  address.sin_port = htons(port);
+  return address;
+}
+
+int GetSocketError()
+{
+#ifdef _WIN32
+  return WSAGetLastError();
+#else
+  return errno;
+#endif
+}
+
+bool WouldBlock(int error)
+{
+#ifdef _WIN32
+  return error == WSAEWOULDBLOCK;
+#else
+  return error == EAGAIN || error == EWOULDBLOCK;
+#endif
+}
+
+bool ConnectInProgress(int error)
+{
+#ifdef _WIN32
+  return error == WSAEWOULDBLOCK;
+#else
+  return error == EINPROGRESS;
+#endif
+}
+
+void CloseSocket(Socket socket)
+{
+#ifdef _WIN32
+  closesocket(socket);
+#else
+  close(socket);
+#endif
+}
+
+Socket OpenSocket(int type)
+{
+  Socket result = socket(AF_INET, type, 0);
+  if (result == INVALID_SOCKET_HANDLE)
+    return result;
+
+#ifdef _WIN32
+  u_long non_blocking = 1;
+  const bool success = ioctlsocket(result, FIONBIO, &non_blocking) == 0;
+#else
+  const int flags = fcntl(result, F_GETFL, 0);
+  const bool success = flags != -1 && fcntl(result, F_SETFL, flags | O_NONBLOCK) == 0;
+#endif
+#ifdef SO_NOSIGPIPE
+  const int no_sigpipe = 1;
+  setsockopt(result, SOL_SOCKET, SO_NOSIGPIPE, &no_sigpipe, sizeof(no_sigpipe));
+#endif
+
+  if (!success)
+  {
+    CloseSocket(result);
+    return INVALID_SOCKET_HANDLE;
+  }
+  return result;
+}
+
+int Poll(pollfd* fds, size_t count, int timeout_ms)
+{
+#ifdef _WIN32
+  return WSAPoll(fds, static_cast<ULONG>(count), timeout_ms);
+#else
+  return poll(fds, static_cast<nfds_t>(count), timeout_ms);
+#endif
+}
+}  // namespace
+
+BuiltInNetworkInterface::BuiltInNetworkInterface(CEXIETHERNET* eth_ref)
+    : NetworkInterface(eth_ref), m_wake_socket(INVALID_SOCKET_HANDLE)
+{
+}
+
+BuiltInNetworkInterface::~BuiltInNetworkInterface()
+{
+  Deactivate();
+}
+
+bool BuiltInNetworkInterface::Activate()
+{
+  if (IsActivated())
+    return true;
+
+#ifdef _WIN32
+  WSADATA wsa_data;
+  if (WSAStartup(MAKEWORD(2, 2), &wsa_data) != 0)
+  {
+    ERROR_LOG(SP1, "WSAStartup failed, unable to init BBA");
+    return false;
+  }
+#endif
+
+  const std::string dns = Config::Get(Config::MAIN_BBA_BUILTIN_DNS);
+  in_addr dns_address;
+  bool success = inet_pton(AF_INET, dns.c_str(), &dns_address) == 1;
+  if (success)
+    m_dns_ip = ntohl(dns_address.s_addr);
+  else
+    ERROR_LOG(SP1, "Invalid DNS server %s, unable to init BBA", dns.c_str());
+
+  // The wake-up socket is bound to the loopback and connected to itself.
+  if (success)
+  {
+    sockaddr_in address = MakeAddress(INADDR_LOOPBACK, 0);
+    socklen_t address_size = sizeof(address);
+    sockaddr* address_ptr = reinterpret_cast<sockaddr*>(&address);
+    m_wake_socket = OpenSocket(SOCK_DGRAM);
+    success = m_wake_socket != INVALID_SOCKET_HANDLE &&
+              bind(m_wake_socket, address_ptr, address_size) == 0 &&
+              getsockname(m_wake_socket, address_ptr, &address_size) == 0 &&
+              connect(m_wake_socket, address_ptr, address_size) == 0;
+    if (!success)
+      ERROR_LOG(SP1, "Couldn't create a loopback socket, unable to init BBA");
+  }
+
+  if (!success)
+  {
+    if (m_wake_socket != INVALID_SOCKET_HANDLE)
+      CloseSocket(m_wake_socket);
+    m_wake_socket = INVALID_SOCKET_HANDLE;
+#ifdef _WIN32
+    WSACleanup();
+#endif
+    return false;
+  }
+
+  m_next_isn = Common::Timer::GetTimeMs() * 1000;
+  m_shutdown.Clear();
+  m_active = true;
+
+  INFO_LOG(SP1, "BBA initialized with the built-in network");
+  return RecvInit();
+}
+
+void BuiltInNetworkInterface::Deactivate()
+{
+  if (!IsActivated())
+    return;
+
+  m_recv_enabled.Clear();
+  m_shutdown.Set();
+  const char wake = 0;
+  send(m_wake_socket, &wake, 1, 0);
+  if (m_thread.joinable())
+    m_thread.join();
+
+  for (auto& entry : m_tcp_connections)
+    CloseSocket(entry.second.socket);
+  m_tcp_connections.clear();
+  for (auto& entry : m_udp_sockets)
+    CloseSocket(entry.second.socket);
+  m_udp_sockets.clear();
+  m_guest_frames.Clear();
+
+  CloseSocket(m_wake_socket);
+  m_wake_socket = INVALID_SOCKET_HANDLE;
+#ifdef _WIN32
+  WSACleanup();
+#endif
+  m_active = false;
+}
+
+bool BuiltInNetworkInterface::IsActivated()
+{
+  return m_active;
+}
+
+bool BuiltInNetworkInterface::SendFrame(const u8* frame, u32 size)
+{
+  DEBUG_LOG(SP1, "SendFrame %x\n%s", size, ArrayToString(frame, size, 0x10).c_str());
+
+  m_guest_frames.Push(std::vector<u8>(frame, frame + size));
+  const char wake = 0;
+  send(m_wake_socket, &wake, 1, 0);
+
+  m_eth_ref->SendComplete();
+  return true;
+}
+
+bool BuiltInNetworkInterface::RecvInit()
+{
+  m_thread = std::thread(NetworkThread, this);
+  return true;
+}
+
+void BuiltInNetworkInterface::RecvStart()
+{
+  m_recv_enabled.Set();
+}
+
+void BuiltInNetworkInterface::RecvStop()
+{
+  m_recv_enabled.Clear();
+}
+
+void BuiltInNetworkInterface::NetworkThread(BuiltInNetworkInterface* self)
+{
+  self->m_ring_position = self->m_eth_ref->mRecvRingWrite.load(std::memory_order_relaxed);
+  std::vector<u8> frame;
+  while (!self->m_shutdown.IsSet())
+  {
+    const u32 start = self->m_ring_position;
+
+    self->PollSockets(POLL_TIMEOUT_MS);
+    while (self->m_guest_frames.Pop(frame))
+      self->HandleGuestFrame(frame);
+
+    for (auto iter = self->m_tcp_connections.begin(); iter != self->m_tcp_connections.end();)
+    {
+      const u64 key = iter->first;
+      const bool alive = self->RetransmitTCP(iter->second);
+      ++iter;
+      if (!alive)
+        self->CloseTCPConnection(key, true);
+    }
+    self->ExpireUDPSockets();
+
+    // Everything from one iteration is handed over at once.
+    if (self->m_ring_position != start)
+      self->m_eth_ref->RecvRingPublish(self->m_ring_position);
+  }
+}
+
+void BuiltInNetworkInterface::PollSockets(int timeout_ms)
+{
+  struct PollTarget
+  {
+    bool tcp;
+    u64 key;
+  };
+
+  std::vector<pollfd> fds;
+  std::vector<PollTarget> targets;
+  fds.push_back({m_wake_socket, POLLIN, 0});
+  targets.push_back({false, 0});
+
+  for (const auto& entry : m_tcp_connections)
+  {
+    const TCPConnection& connection = entry.second;
+    short events = 0;
+    if (!connection.connected)
+    {
+      events = POLLOUT;
+    }
+    else
+    {
+      if (!connection.to_host.empty())
+        events |= POLLOUT;
+      if (!connection.host_eof && !connection.syn_unacked &&
+          connection.unacked.size() < std::min<u32>(connection.guest_window, TCP_MAX_IN_FLIGHT))
+      {
+        events |= POLLIN;
+      }
+    }
+
+    // Sockets which are shut down report hangups all the time.
+    if (events != 0)
+    {
+      fds.push_back({connection.socket, events, 0});
+      targets.push_back({true, entry.first});
+    }
+  }
+
+  for (const auto& entry : m_udp_sockets)
+  {
+    fds.push_back({entry.second.socket, POLLIN, 0});
+    targets.push_back({false, entry.first});
+  }
+
+  if (Poll(fds.data(), fds.size(), timeout_ms) <= 0)
+    return;
+
+  if (fds[0].revents)
+  {
+    char buffer[64];
+    while (recv(m_wake_socket, buffer, static_cast<int>(sizeof(buffer)), 0) > 0)
+    {
+    }
+  }
+
+  for (size_t i = 1; i < fds.size(); ++i)
+  {
+    if (!fds[i].revents)
+      continue;
+
+    if (targets[i].tcp)
+      HandleTCPSocket(targets[i].key, fds[i].revents);
+    else
+      HandleUDPSocket(static_cast<u16>(targets[i].key));
+  }
+}
+
+void BuiltInNetworkInterface::HandleGuestFrame(const std::vector<u8>& frame)
+{
+  if (frame.size() < ETHERNET_HEADER_SIZE)
+    return;
+
+  const u8* data = frame.data();
+  const u32 size = static_cast<u32>(frame.size());
+  std::memcpy(m_guest_mac, data + 6, sizeof(m_guest_mac));
+  m_guest_mac_known = true;
+
+  switch (Read16(data + 12))
+  {
+  case ETHERTYPE_ARP:
+    HandleARP(data + ETHERNET_HEADER_SIZE, size - ETHERNET_HEADER_SIZE);
+    break;
+  case ETHERTYPE_IPV4:
+    HandleIPv4(data + ETHERNET_HEADER_SIZE, size - ETHERNET_HEADER_SIZE);
+    break;
+  default:
+    DEBUG_LOG(SP1, "Dropping a frame of type %04x", Read16(data + 12));
+    break;
+  }
+}
+
+void BuiltInNetworkInterface::HandleARP(const u8* packet, u32 size)
+{
+  // Only requests for IPv4 addresses on Ethernet.
+  if (size < ARP_PACKET_SIZE || Read16(packet) != 1 || Read16(packet + 2) != ETHERTYPE_IPV4 ||
+      Read16(packet + 6) != 1)
+  {
+    return;
+  }
+
+  // Everything but the guest is behind the router. The guest probing for its own address has to
+  // stay unanswered, or it thinks the address is taken.
+  const u32 sender_ip = Read32(packet + 14);
+  const u32 target_ip = Read32(packet + 24);
+  if (target_ip == GUEST_IP || target_ip == sender_ip)
+    return;
+
+  u8* frame = BeginFrame();
+  if (!frame)
+    return;
+
+  std::memcpy(frame, packet + 8, 6);
+  std::memcpy(frame + 6, ROUTER_MAC, 6);
+  Write16(frame + 12, ETHERTYPE_ARP);
+
+  u8* reply = frame + ETHERNET_HEADER_SIZE;
+  std::memcpy(reply, packet, 6);
+  Write16(reply + 6, 2);
+  std::memcpy(reply + 8, ROUTER_MAC, 6);
+  Write32(reply + 14, target_ip);
+  std::memcpy(reply + 18, packet + 8, 6);
+  Write32(reply + 24, sender_ip);
+  EndFrame(ETHERNET_HEADER_SIZE + ARP_PACKET_SIZE);
+}
+
+void BuiltInNetworkInterface::HandleIPv4(const u8* packet, u32 size)
+{
+  if (size < IPV4_HEADER_SIZE || (packet[0] >> 4) != 4)
+    return;
+
+  const u32 header_size = (packet[0] & 0xf) * 4;
+  const u32 total_size = Read16(packet + 2);
+  if (header_size < IPV4_HEADER_SIZE || total_size < header_size || total_size > size)
+    return;
+
+  // The guest doesn't send more than the MTU, so fragments aren't reassembled.
+  if (Read16(packet + 6) & 0x3fff)
+  {
+    DEBUG_LOG(SP1, "Dropping an IPv4 fragment");
+    return;
+  }
+
+  const u32 src_ip = Read32(packet + 12);
+  const u32 dst_ip = Read32(packet + 16);
+  const u8* payload = packet + header_size;
+  const u32 payload_size = total_size - header_size;
+  switch (packet[9])
+  {
+  case IP_PROTOCOL_TCP:
+    HandleTCP(src_ip, dst_ip, payload, payload_size);
+    break;
+  case IP_PROTOCOL_UDP:
+    HandleUDP(src_ip, dst_ip, payload, payload_size);
+    break;
+  default:
+    DEBUG_LOG(SP1, "Dropping an IPv4 packet of protocol %u", packet[9]);
+    break;
+  }
+}
+
+void BuiltInNetworkInterface::HandleDHCP(const u8* message, u32 size)
+{
+  if (size < DHCP_MESSAGE_SIZE || message[0] != 1 || Read32(message + 236) != DHCP_MAGIC)
+    return;
+
+  u8 type = 0;
+  for (u32 i = DHCP_MESSAGE_SIZE; i < size && message[i] != 0xff;)
+  {
+    // Padding
+    if (message[i] == 0)
+    {
+      ++i;
+      continue;
+    }
+    if (i + 1 >= size || i + 2 + message[i + 1] > size)
+      break;
+    if (message[i] == 53 && message[i + 1] == 1)
+      type = message[i + 2];
+    i += 2 + message[i + 1];
+  }
+
+  u8 reply_type;
+  if (type == DHCP_DISCOVER)
+    reply_type = DHCP_OFFER;
+  else if (type == DHCP_REQUEST)
+    reply_type = DHCP_ACK;
+  else
+    return;
+
+  u8* frame = BeginFrame();
+  if (!frame)
+    return;
+
+  u8* reply = frame + ETHERNET_HEADER_SIZE + IPV4_HEADER_SIZE + UDP_HEADER_SIZE;
+  std::memset(reply, 0, DHCP_MESSAGE_SIZE);
+  reply[0] = 2;
+  std::memcpy(reply + 1, message + 1, 2);
+  // Transaction ID, then flags
+  std::memcpy(reply + 4, message + 4, 4);
+  std::memcpy(reply + 10, message + 10, 2);
+  Write32(reply + 16, GUEST_IP);
+  Write32(reply + 20, ROUTER_IP);
+  // Client hardware address
+  std::memcpy(reply + 28, message + 28, 16);
+  Write32(reply + 236, DHCP_MAGIC);
+
+  u8* option = reply + DHCP_MESSAGE_SIZE;
+  const auto add_option = [&option](u8 code, u32 value) {
+    option[0] = code;
+    option[1] = 4;
+    Write32(option + 2, value);
+    option += 6;
+  };
+  option[0] = 53;
+  option[1] = 1;
+  option[2] = reply_type;
+  option += 3;
+  // Server identifier, lease time, subnet mask, router and DNS server.
+  add_option(54, ROUTER_IP);
+  add_option(51, DHCP_LEASE_SECONDS);
+  add_option(1, NETMASK);
+  add_option(3, ROUTER_IP);
+  add_option(6, ROUTER_IP);
+  *option++ = 0xff;
+
+  FinishUDPFrame(frame, true, ROUTER_IP, 67, BROADCAST_IP, 68, static_cast<u32>(option - reply));
+}
+
+void BuiltInNetworkInterface::HandleUDP(u32 src_ip, u32 dst_ip, const u8* datagram, u32 size)
+{
+  if (size < UDP_HEADER_SIZE)
+    return;
+
+  const u16 src_port = Read16(datagram);
+  const u16 dst_port = Read16(datagram + 2);
+  const u32 length = Read16(datagram + 4);
+  if (length < UDP_HEADER_SIZE || length > size)
+    return;
+
+  if (dst_port == 67)
+  {
+    HandleDHCP(datagram + UDP_HEADER_SIZE, length - UDP_HEADER_SIZE);
+    return;
+  }
+
+  // Broadcasts and multicasts stay on the network.
+  if (src_ip != GUEST_IP || (dst_ip | NETMASK) == BROADCAST_IP || (dst_ip >> 28) == 0xe)
+    return;
+
+  const bool to_dns = dst_ip == ROUTER_IP && dst_port == 53;
+  u32 host_ip = dst_ip;
+  if (to_dns)
+    host_ip = m_dns_ip;
+  else if (dst_ip == ROUTER_IP)
+    host_ip = INADDR_LOOPBACK;
+
+  auto iter = m_udp_sockets.find(src_port);
+  if (iter == m_udp_sockets.end())
+  {
+    const Socket socket = OpenSocket(SOCK_DGRAM);
+    if (socket == INVALID_SOCKET_HANDLE)
+    {
+      ERROR_LOG(SP1, "Couldn't open a UDP socket, err=%d", GetSocketError());
+      return;
+    }
+    iter = m_udp_sockets.emplace(src_port, UDPSocket{socket}).first;
+  }
+
+  UDPSocket& udp_socket = iter->second;
+  udp_socket.dns_via_router |= to_dns;
+  udp_socket.last_use_ms = Common::Timer::GetTimeMs();
+
+  const sockaddr_in address = MakeAddress(host_ip, dst_port);
+  const socklen_t address_size = sizeof(address);
+  if (sendto(udp_socket.socket, reinterpret_cast<const char*>(datagram + UDP_HEADER_SIZE),
+             static_cast<int>(length - UDP_HEADER_SIZE), SEND_FLAGS,
+             reinterpret_cast<const sockaddr*>(&address), address_size) < 0)
+  {
+    DEBUG_LOG(SP1, "sendto failed, err=%d", GetSocketError());
+  }
+}
+
+void BuiltInNetworkInterface::HandleUDPSocket(u16 guest_port)
+{
+  const auto iter = m_udp_sockets.find(guest_port);
+  if (iter == m_udp_sockets.end())
+    return;
+
+  const UDPSocket& udp_socket = iter->second;
+  u8 discard[UDP_MAX_PAYLOAD];
+  for (u32 i = 0; i < BBA_RECV_BATCH; ++i)
+  {
+    // The datagram is received right into the frame.
+    u8* frame = BeginFrame();
+    u8* data = frame ? frame + ETHERNET_HEADER_SIZE + IPV4_HEADER_SIZE + UDP_HEADER_SIZE : discard;
+
+    sockaddr_in address;
+    socklen_t address_size = sizeof(address);
+    const int size = recvfrom(udp_socket.socket, reinterpret_cast<char*>(data), UDP_MAX_PAYLOAD, 0,
+                              reinterpret_cast<sockaddr*>(&address), &address_size);
+    if (size < 0)
+      break;
+    if (!frame)
+      continue;
+
+    u32 src_ip = ntohl(address.sin_addr.s_addr);
+    const u16 src_port = ntohs(address.sin_port);
+    if (udp_socket.dns_via_router && src_ip == m_dns_ip && src_port == 53)
+      src_ip = ROUTER_IP;
+    else if (src_ip == INADDR_LOOPBACK)
+      src_ip = ROUTER_IP;
+    FinishUDPFrame(frame, false, src_ip, src_port, GUEST_IP, guest_port, static_cast<u32>(size));
+  }
+}
+
+void BuiltInNetworkInterface::ExpireUDPSockets()
+{
+  const u32 now = Common::Timer::GetTimeMs();
+  for (auto iter = m_udp_sockets.begin(); iter != m_udp_sockets.end();)
+  {
+    if (now - iter->second.last_use_ms > UDP_IDLE_MS)
+    {
+      CloseSocket(iter->second.socket);
+      iter = m_udp_sockets.erase(iter);
+    }
+    else
+    {
+      ++iter;
+    }
+  }
+}
+
+void BuiltInNetworkInterface::HandleTCP(u32 src_ip, u32 dst_ip, const u8* segment, u32 size)
+{
+  if (size < TCP_HEADER_SIZE || src_ip != GUEST_IP)
+    return;
+
+  const u16 src_port = Read16(segment);
+  const u16 dst_port = Read16(segment + 2);
+  const u32 seq = Read32(segment + 4);
+  const u32 ack = Read32(segment + 8);
+  const u32 header_size = (segment[12] >> 4) * 4;
+  const u8 flags = segment[13];
+  const u16 window = Read16(segment + 14);
+  if (header_size < TCP_HEADER_SIZE || header_size > size)
+    return;
+  const u8* payload = segment + header_size;
+  const u32 payload_size = size - header_size;
+
+  const u64 key = MakeTCPKey(dst_ip, dst_port, src_port);
+  const auto iter = m_tcp_connections.find(key);
+  if (flags & TCP_RST)
+  {
+    CloseTCPConnection(key, false);
+    return;
+  }
+
+  if (flags & TCP_SYN)
+  {
+    if (iter == m_tcp_connections.end())
+    {
+      OpenTCPConnection(dst_ip, dst_port, src_port, seq, window, segment + TCP_HEADER_SIZE,
+                        header_size - TCP_HEADER_SIZE);
+    }
+    else if (iter->second.syn_unacked)
+    {
+      // The SYN-ACK got lost.
+      SendTCP(iter->second, TCP_SYN | TCP_ACK, iter->second.unacked_seq, nullptr, 0);
+    }
+    return;
+  }
+
+  if (iter == m_tcp_connections.end())
+  {
+    const u32 segment_length = payload_size + ((flags & TCP_FIN) ? 1 : 0);
+    SendTCPReset(dst_ip, dst_port, src_port, ack, seq + segment_length);
+    return;
+  }
+
+  // The guest can't have gotten a SYN-ACK yet.
+  TCPConnection& connection = iter->second;
+  if (!connection.connected)
+    return;
+
+  if (flags & TCP_ACK)
+  {
+    u32 acked = ack - connection.unacked_seq;
+    if (acked != 0 && acked <= connection.NextSeq() - connection.unacked_seq)
+    {
+      connection.unacked_seq = ack;
+      if (connection.syn_unacked)
+      {
+        connection.syn_unacked = false;
+        --acked;
+      }
+      const u32 acked_data = std::min(acked, connection.sent_size);
+      connection.unacked.erase(connection.unacked.begin(), connection.unacked.begin() + acked_data);
+      connection.sent_size -= acked_data;
+      if (acked != acked_data)
+        connection.fin_acked = true;
+      connection.last_send_ms = Common::Timer::GetTimeMs();
+      connection.retransmissions = 0;
+    }
+    connection.guest_window = window;
+  }
+
+  if (payload_size != 0 || (flags & TCP_FIN))
+  {
+    // Whatever the guest sends again is skipped, and what doesn't fit in the buffer is dropped.
+    const u32 offset = connection.guest_next_seq - seq;
+    if (static_cast<s32>(offset) >= 0 && offset <= payload_size && !connection.guest_fin)
+    {
+      const u32 room = TCP_TO_HOST_BUFFER - static_cast<u32>(connection.to_host.size());
+      const u32 accepted = std::min(payload_size - offset, room);
+      connection.to_host.insert(connection.to_host.end(), payload + offset,
+                                payload + offset + accepted);
+      connection.guest_next_seq += accepted;
+      if ((flags & TCP_FIN) && offset + accepted == payload_size)
+      {
+        connection.guest_fin = true;
+        ++connection.guest_next_seq;
+      }
+      FlushToHost(connection);
+    }
+
+    SendTCP(connection, TCP_ACK, connection.NextSeq(), nullptr, 0);
+  }
+
+  // The window may have grown.
+  SendTCPData(connection, connection.sent_size);
+  SendTCPFinIfDone(connection);
+  if (connection.guest_fin && connection.fin_acked && connection.to_host.empty())
+    CloseTCPConnection(key, false);
+}
+
+void BuiltInNetworkInterface::OpenTCPConnection(u32 dst_ip, u16 dst_port, u16 src_port, u32 seq,
+                                                u16 window, const u8* options, u32 options_size)
+{
+  const u32 host_ip = dst_ip == ROUTER_IP ? INADDR_LOOPBACK : dst_ip;
+  const Socket socket = OpenSocket(SOCK_STREAM);
+  if (socket == INVALID_SOCKET_HANDLE)
+  {
+    ERROR_LOG(SP1, "Couldn't open a TCP socket, err=%d", GetSocketError());
+    SendTCPReset(dst_ip, dst_port, src_port, 0, seq + 1);
+    return;
+  }
+
+  // Nothing else is on the network.
+  const sockaddr_in address = MakeAddress(host_ip, dst_port);
+  const socklen_t address_size = sizeof(address);
+  if (((dst_ip & NETMASK) == (GUEST_IP & NETMASK) && dst_ip != ROUTER_IP) ||
+      (connect(socket, reinterpret_cast<const sockaddr*>(&address), address_size) != 0 &&
+       !ConnectInProgress(GetSocketError())))
+  {
+    CloseSocket(socket);
+    SendTCPReset(dst_ip, dst_port, src_port, 0, seq + 1);
+    return;
+  }
+
+  TCPConnection connection;
+  connection.remote_ip = dst_ip;
+  connection.remote_port = dst_port;
+  connection.guest_port = src_port;
+  connection.socket = socket;
+  connection.guest_next_seq = seq + 1;
+  connection.unacked_seq = m_next_isn;
+  connection.guest_window = window;
+  m_next_isn += 0x10000;
+
+  for (u32 i = 0; i < options_size;)
+  {
+    // End of options, and padding
+    if (options[i] == 0)
+      break;
+    if (options[i] == 1)
+    {
+      ++i;
+      continue;
+    }
+    if (i + 1 >= options_size || options[i + 1] < 2 || i + options[i + 1] > options_size)
+      break;
+    if (options[i] == 2 && options[i + 1] == 4)
+      connection.guest_mss = std::min<u16>(Read16(options + i + 2), TCP_MSS);
+    i += options[i + 1];
+  }
+
+  m_tcp_connections.emplace(MakeTCPKey(dst_ip, dst_port, src_port), std::move(connection));
+}
+
+void BuiltInNetworkInterface::HandleTCPSocket(u64 key, short revents)
+{
+  const auto iter = m_tcp_connections.find(key);
+  if (iter == m_tcp_connections.end())
+    return;
+
+  TCPConnection& connection = iter->second;
+  if (!connection.connected)
+  {
+    int error = 0;
+    socklen_t error_size = sizeof(error);
+    getsockopt(connection.socket, SOL_SOCKET, SO_ERROR, reinterpret_cast<char*>(&error),
+               &error_size);
+    if (error != 0)
+    {
+      CloseTCPConnection(key, true);
+      return;
+    }
+
+    connection.connected = true;
+    connection.syn_unacked = true;
+    connection.last_send_ms = Common::Timer::GetTimeMs();
+    SendTCP(connection, TCP_SYN | TCP_ACK, connection.unacked_seq, nullptr, 0);
+    return;
+  }
+
+  if (revents & POLLERR)
+  {
+    CloseTCPConnection(key, true);
+    return;
+  }
+
+  if (revents & POLLOUT)
+  {
+    // Tell the guest once there is room again.
+    const bool window_closed =
+        TCP_TO_HOST_BUFFER - connection.to_host.size() < connection.guest_mss;
+    FlushToHost(connection);
+    if (window_closed && TCP_TO_HOST_BUFFER - connection.to_host.size() >= connection.guest_mss)
+      SendTCP(connection, TCP_ACK, connection.NextSeq(), nullptr, 0);
+  }
+
+  const u32 window = std::min<u32>(connection.guest_window, TCP_MAX_IN_FLIGHT);
+  const u32 old_size = static_cast<u32>(connection.unacked.size());
+  if ((revents & (POLLIN | POLLHUP)) && !connection.host_eof && !connection.syn_unacked &&
+      old_size < window)
+  {
+    connection.unacked.resize(window);
+    const int received =
+        recv(connection.socket, reinterpret_cast<char*>(&connection.unacked[old_size]),
+             static_cast<int>(window - old_size), 0);
+    connection.unacked.resize(old_size + std::max(received, 0));
+    if (received > 0)
+    {
+      SendTCPData(connection, connection.sent_size);
+    }
+    else if (received == 0)
+    {
+      connection.host_eof = true;
+    }
+    else if (!WouldBlock(GetSocketError()))
+    {
+      CloseTCPConnection(key, true);
+      return;
+    }
+  }
+
+  SendTCPFinIfDone(connection);
+  if (connection.guest_fin && connection.fin_acked && connection.to_host.empty())
+    CloseTCPConnection(key, false);
+}
+
+void BuiltInNetworkInterface::FlushToHost(TCPConnection& connection)
+{
+  while (!connection.to_host.empty())
+  {
+    const int sent =
+        send(connection.socket, reinterpret_cast<const char*>(connection.to_host.data()),
+             static_cast<int>(connection.to_host.size()), SEND_FLAGS);
+    if (sent <= 0)
+      break;
+    connection.to_host.erase(connection.to_host.begin(), connection.to_host.begin() + sent);
+  }
+
+  if (connection.guest_fin && connection.to_host.empty())
+  {
+#ifdef _WIN32
+    shutdown(connection.socket, SD_SEND);
+#else
+    shutdown(connection.socket, SHUT_WR);
+#endif
+  }
+}
+
+void BuiltInNetworkInterface::SendTCPData(TCPConnection& connection, u32 offset)
+{
+  const u32 window = std::min<u32>(connection.guest_window, TCP_MAX_IN_FLIGHT);
+  const u32 end = std::min(static_cast<u32>(connection.unacked.size()), window);
+  if (offset < end && connection.sent_size == 0)
+    connection.last_send_ms = Common::Timer::GetTimeMs();
+
+  while (offset < end)
+  {
+    const u32 size = std::min<u32>(end - offset, connection.guest_mss);
+    if (!SendTCP(connection, TCP_ACK | TCP_PSH, connection.unacked_seq + offset,
+                 &connection.unacked[offset], size))
+    {
+      break;
+    }
+    offset += size;
+    connection.sent_size = std::max(connection.sent_size, offset);
+  }
+}
+
+void BuiltInNetworkInterface::SendTCPFinIfDone(TCPConnection& connection)
+{
+  if (!connection.host_eof || connection.fin_sent || !connection.unacked.empty() ||
+      connection.syn_unacked)
+  {
+    return;
+  }
+
+  if (SendTCP(connection, TCP_FIN | TCP_ACK, connection.unacked_seq, nullptr, 0))
+  {
+    connection.fin_sent = true;
+    connection.last_send_ms = Common::Timer::GetTimeMs();
+  }
+}
+
+bool BuiltInNetworkInterface::RetransmitTCP(TCPConnection& connection)
+{
+  if (!connection.connected)
+    return true;
+
+  SendTCPFinIfDone(connection);
+  if (connection.NextSeq() == connection.unacked_seq)
+    return true;
+
+  const u32 now = Common::Timer::GetTimeMs();
+  if (now - connection.last_send_ms < TCP_RETRANSMIT_MS)
+    return true;
+  if (++connection.retransmissions > TCP_MAX_RETRANSMISSIONS)
+    return false;
+
+  connection.last_send_ms = now;
+  if (connection.syn_unacked)
+  {
+    SendTCP(connection, TCP_SYN | TCP_ACK, connection.unacked_seq, nullptr, 0);
+  }
+  else if (!connection.unacked.empty())
+  {
+    SendTCPData(connection, 0);
+  }
+  else
+  {
+    SendTCP(connection, TCP_FIN | TCP_ACK, connection.unacked_seq, nullptr, 0);
+  }
+  return true;
+}
+
+void BuiltInNetworkInterface::CloseTCPConnection(u64 key, bool reset)
+{
+  const auto iter = m_tcp_connections.find(key);
+  if (iter == m_tcp_connections.end())
+    return;
+
+  if (reset)
+    SendTCP(iter->second, TCP_RST | TCP_ACK, iter->second.NextSeq(), nullptr, 0);
+  CloseSocket(iter->second.socket);
+  m_tcp_connections.erase(iter);
+}
+
+u8* BuiltInNetworkInterface::BeginFrame()
+{
+  // Like a real network, frames nobody is listening for are lost.
+  if (!m_recv_enabled.IsSet())
+    return nullptr;
+
+  CEXIETHERNET::RecvSlot* slot = m_eth_ref->RecvRingSlot(m_ring_position);
+  if (!slot)
+  {
+    WARN_LOG(SP1, "Receive ring full, dropping a frame");
+    return nullptr;
+  }
+  return slot->data;
+}
+
+void BuiltInNetworkInterface::EndFrame(u32 size)
+{
+  CEXIETHERNET::RecvSlot* slot = &m_eth_ref->mRecvRing[m_ring_position % BBA_RECV_RING_SLOTS];
+  if (size < MIN_FRAME_SIZE)
+  {
+    std::memset(slot->data + size, 0, MIN_FRAME_SIZE - size);
+    size = MIN_FRAME_SIZE;
+  }
+
+  DEBUG_LOG(SP1, "Received %u bytes:\n %s", size, ArrayToString(slot->data, size, 0x10).c_str());
+  slot->length = size;
+  ++m_ring_position;
+}
+
+u8* BuiltInNetworkInterface::WriteIPv4Header(u8* frame, bool broadcast, u32 src_ip, u32 dst_ip,
+                                             u8 protocol, u32 payload_size)
+{
+  std::memcpy(frame, broadcast || !m_guest_mac_known ? BROADCAST_MAC : m_guest_mac, 6);
+  std::memcpy(frame + 6, ROUTER_MAC, 6);
+  Write16(frame + 12, ETHERTYPE_IPV4);
+
+  u8* header = frame + ETHERNET_HEADER_SIZE;
+  header[0] = 0x45;
+  header[1] = 0;
+  Write16(header + 2, static_cast<u16>(IPV4_HEADER_SIZE + payload_size));
+  Write16(header + 4, m_ip_id++);
+  // Don't fragment
+  Write16(header + 6, 0x4000);
+  header[8] = 64;
+  header[9] = protocol;
+  Write16(header + 10, 0);
+  Write32(header + 12, src_ip);
+  Write32(header + 16, dst_ip);
+  Write16(header + 10, ChecksumFinish(ChecksumAdd(0, header, IPV4_HEADER_SIZE)));
+  return header + IPV4_HEADER_SIZE;
+}
+
+void BuiltInNetworkInterface::FinishUDPFrame(u8* frame, bool broadcast, u32 src_ip, u16 src_port,
+                                             u32 dst_ip, u16 dst_port, u32 size)
+{
+  u8* header =
+      WriteIPv4Header(frame, broadcast, src_ip, dst_ip, IP_PROTOCOL_UDP, UDP_HEADER_SIZE + size);
+  Write16(header, src_port);
+  Write16(header + 2, dst_port);
+  Write16(header + 4, static_cast<u16>(UDP_HEADER_SIZE + size));
+  Write16(header + 6, 0);
+  // A checksum of zero means there is none.
+  const u16 checksum =
+      TransportChecksum(src_ip, dst_ip, IP_PROTOCOL_UDP, header, UDP_HEADER_SIZE + size);
+  Write16(header + 6, checksum != 0 ? checksum : 0xffff);
+  EndFrame(ETHERNET_HEADER_SIZE + IPV4_HEADER_SIZE + UDP_HEADER_SIZE + size);
+}
+
+bool BuiltInNetworkInterface::SendTCP(const TCPConnection& connection, u8 flags, u32 seq,
+                                      const u8* data, u32 size)
+{
+  u8* frame = BeginFrame();
+  if (!frame)
+    return false;
+
+  // SYNs carry the MSS.
+  const u32 header_size = TCP_HEADER_SIZE + ((flags & TCP_SYN) ? 4 : 0);
+  u8* header = WriteIPv4Header(frame, false, connection.remote_ip, GUEST_IP, IP_PROTOCOL_TCP,
+                               header_size + size);
+  Write16(header, connection.remote_port);
+  Write16(header + 2, connection.guest_port);
+  Write32(header + 4, seq);
+  Write32(header + 8, connection.guest_next_seq);
+  header[12] = static_cast<u8>((header_size / 4) << 4);
+  header[13] = flags;
+  Write16(header + 14, static_cast<u16>(TCP_TO_HOST_BUFFER - connection.to_host.size()));
+  Write16(header + 16, 0);
+  Write16(header + 18, 0);
+  if (flags & TCP_SYN)
+  {
+    header[20] = 2;
+    header[21] = 4;
+    Write16(header + 22, TCP_MSS);
+  }
+  if (size != 0)
+    std::memcpy(header + header_size, data, size);
+  Write16(header + 16, TransportChecksum(connection.remote_ip, GUEST_IP, IP_PROTOCOL_TCP, header,
+                                         header_size + size));
+
+  EndFrame(ETHERNET_HEADER_SIZE + IPV4_HEADER_SIZE + header_size + size);
+  return true;
+}
+
+void BuiltInNetworkInterface::SendTCPReset(u32 remote_ip, u16 remote_port, u16 guest_port, u32 seq,
+                                           u32 ack)
+{
+  TCPConnection connection;
+  connection.remote_ip = remote_ip;
+  connection.remote_port = remote_port;
+  connection.guest_port = guest_port;
+  connection.guest_next_seq = ack;
+  SendTCP(connection, TCP_RST | TCP_ACK, seq, nullptr, 0);
+}
+}  // namespace ExpansionInterface
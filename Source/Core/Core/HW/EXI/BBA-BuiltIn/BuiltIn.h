@@ -0,0 +1,149 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <map>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <WinSock2.h>
+#endif
+
+#include "Common/CommonTypes.h"
+#include "Common/FifoQueue.h"
+#include "Common/Flag.h"
+#include "Core/HW/EXI/EXI_DeviceEthernet.h"
+
+namespace ExpansionInterface
+{
+// A network of its own for the BBA, which needs no TAP device, drivers or privileges on the host.
+// A router answers ARP and DHCP, and forwards the TCP connections and UDP datagrams of the guest
+// through host sockets, translating the addresses like a NAT. DNS queries to the router go to the
+// configured DNS server. Only connections from the guest are forwarded, and ICMP is dropped.
+//
+// SendFrame queues the frames of the guest for a network thread, which does everything else: it
+// polls the host sockets, and writes the frames to the guest straight into the receive ring.
+class BuiltInNetworkInterface final : public CEXIETHERNET::NetworkInterface
+{
+public:
+  explicit BuiltInNetworkInterface(CEXIETHERNET* eth_ref);
+  ~BuiltInNetworkInterface() override;
+
+  bool Activate() override;
+  void Deactivate() override;
+  bool IsActivated() override;
+  bool SendFrame(const u8* frame, u32 size) override;
+  bool RecvInit() override;
+  void RecvStart() override;
+  void RecvStop() override;
+
+#ifdef _WIN32
+  using Socket = SOCKET;
+#else
+  using Socket = int;
+#endif
+
+private:
+  struct TCPConnection
+  {
+    u32 remote_ip;
+    u16 remote_port;
+    u16 guest_port;
+    Socket socket;
+
+    // Whether the host socket has connected, and the guest got a SYN-ACK.
+    bool connected = false;
+    bool syn_unacked = false;
+    // Sequence numbers of the next byte expected from the guest, and of the oldest one sent to the
+    // guest which it hasn't acknowledged yet.
+    u32 guest_next_seq = 0;
+    u32 unacked_seq = 0;
+    // Received from the host and not acknowledged by the guest yet, kept for retransmissions.
+    // Only the first sent_size bytes have been sent so far.
+    std::vector<u8> unacked;
+    u32 sent_size = 0;
+    // Received from the guest, waiting for the host socket to accept it.
+    std::vector<u8> to_host;
+    u16 guest_window = 0;
+    u16 guest_mss = 536;
+
+    bool host_eof = false;
+    bool fin_sent = false;
+    bool fin_acked = false;
+    bool guest_fin = false;
+    u32 last_send_ms = 0;
+    u32 retransmissions = 0;
+
+    // The sequence number of the next segment sent to the guest.
+    u32 NextSeq() const
+    {
+      return unacked_seq + (syn_unacked ? 1 : 0) + sent_size + (fin_sent && !fin_acked ? 1 : 0);
+    }
+  };
+
+  struct UDPSocket
+  {
+    Socket socket;
+    // Queries sent to the router are forwarded to the DNS server, so its replies come back from
+    // the router.
+    bool dns_via_router = false;
+    u32 last_use_ms = 0;
+  };
+
+  static void NetworkThread(BuiltInNetworkInterface* self);
+  void PollSockets(int timeout_ms);
+
+  void HandleGuestFrame(const std::vector<u8>& frame);
+  void HandleARP(const u8* packet, u32 size);
+  void HandleIPv4(const u8* packet, u32 size);
+  void HandleDHCP(const u8* message, u32 size);
+  void HandleUDP(u32 src_ip, u32 dst_ip, const u8* datagram, u32 size);
+  void HandleTCP(u32 src_ip, u32 dst_ip, const u8* segment, u32 size);
+
+  void HandleTCPSocket(u64 key, short revents);
+  void HandleUDPSocket(u16 guest_port);
+  void OpenTCPConnection(u32 dst_ip, u16 dst_port, u16 src_port, u32 seq, u16 window,
+                         const u8* options, u32 options_size);
+  void FlushToHost(TCPConnection& connection);
+  void SendTCPData(TCPConnection& connection, u32 offset);
+  void SendTCPFinIfDone(TCPConnection& connection);
+  // Returns false if the guest doesn't acknowledge anything anymore.
+  bool RetransmitTCP(TCPConnection& connection);
+  void CloseTCPConnection(u64 key, bool reset);
+  void ExpireUDPSockets();
+
+  // Frames to the guest are written straight into the slots of the receive ring, then handed over
+  // once per iteration of the network thread. Returns nullptr if the frame has to be dropped.
+  u8* BeginFrame();
+  void EndFrame(u32 size);
+  u8* WriteIPv4Header(u8* frame, bool broadcast, u32 src_ip, u32 dst_ip, u8 protocol,
+                      u32 payload_size);
+  // Writes the headers around the size bytes of payload already in the frame, and ends it.
+  void FinishUDPFrame(u8* frame, bool broadcast, u32 src_ip, u16 src_port, u32 dst_ip,
+                      u16 dst_port, u32 size);
+  bool SendTCP(const TCPConnection& connection, u8 flags, u32 seq, const u8* data, u32 size);
+  void SendTCPReset(u32 remote_ip, u16 remote_port, u16 guest_port, u32 seq, u32 ack);
+
+  bool m_active = false;
+  u32 m_dns_ip = 0;
+  u8 m_guest_mac[6];
+  bool m_guest_mac_known = false;
+  u16 m_ip_id = 0;
+  u32 m_next_isn = 0;
+
+  std::map<u64, TCPConnection> m_tcp_connections;
+  std::map<u16, UDPSocket> m_udp_sockets;
+
+  // Woken up by SendFrame with a datagram sent to itself.
+  Socket m_wake_socket;
+  Common::FifoQueue<std::vector<u8>, false> m_guest_frames;
+  u32 m_ring_position = 0;
+
+  std::thread m_thread;
+  Common::Flag m_recv_enabled;
+  Common::Flag m_shutdown;
+};
+}  // namespace ExpansionInterface
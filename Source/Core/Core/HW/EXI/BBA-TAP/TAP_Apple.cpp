@@ -2,6 +2,7 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <cerrno>
 #include <fcntl.h>
 #include <unistd.h>
 
@@ -12,7 +13,7 @@
 
 namespace ExpansionInterface
 {
-bool CEXIETHERNET::Activate()
+bool CEXIETHERNET::TAPNetworkInterface::Activate()
 {
   if (IsActivated())
     return true;
@@ -20,7 +21,7 @@ bool CEXIETHERNET::Activate()
   // Assumes TunTap OS X is installed, and /dev/tun0 is not in use
   // and readable / writable by the logged-in user
 
-  if ((fd = open("/dev/tap0", O_RDWR)) < 0)
+  if ((fd = open("/dev/tap0", O_RDWR | O_NONBLOCK)) < 0)
   {
     ERROR_LOG(SP1, "Couldn't open /dev/tap0, unable to init BBA");
     return false;
@@ -30,7 +31,7 @@ bool CEXIETHERNET::Activate()
   return RecvInit();
 }
 
-void CEXIETHERNET::Deactivate()
+void CEXIETHERNET::TAPNetworkInterface::Deactivate()
 {
   close(fd);
   fd = -1;
@@ -41,12 +42,12 @@ void CEXIETHERNET::Deactivate()
     readThread.join();
 }
 
-bool CEXIETHERNET::IsActivated()
+bool CEXIETHERNET::TAPNetworkInterface::IsActivated()
 {
   return fd != -1;
 }
 
-bool CEXIETHERNET::SendFrame(const u8* frame, u32 size)
+bool CEXIETHERNET::TAPNetworkInterface::SendFrame(const u8* frame, u32 size)
 {
   INFO_LOG(SP1, "SendFrame %x\n%s", size, ArrayToString(frame, size, 0x10).c_str());
 
@@ -58,13 +59,16 @@ bool CEXIETHERNET::SendFrame(const u8* frame, u32 size)
   }
   else
   {
-    SendComplete();
+    m_eth_ref->SendComplete();
     return true;
   }
 }
 
-static void ReadThreadHandler(CEXIETHERNET* self)
+void CEXIETHERNET::TAPNetworkInterface::ReadThreadHandler(TAPNetworkInterface* self)
 {
+  // Frames that don't fit in the ring are read here to drop them.
+  u8 discard[BBA_RECV_SIZE];
+  u32 position = self->m_eth_ref->mRecvRingWrite.load(std::memory_order_relaxed);
   while (!self->readThreadShutdown.IsSet())
   {
     fd_set rfds;
@@ -77,33 +81,49 @@ static void ReadThreadHandler(CEXIETHERNET* self)
     if (select(self->fd + 1, &rfds, nullptr, nullptr, &timeout) <= 0)
       continue;
 
-    int readBytes = read(self->fd, self->mRecvBuffer.get(), BBA_RECV_SIZE);
-    if (readBytes < 0)
+    // The fd is non-blocking, so read all the frames that are queued and hand them over at once.
+    const u32 start = position;
+    for (u32 i = 0; i < BBA_RECV_BATCH; ++i)
     {
-      ERROR_LOG(SP1, "Failed to read from BBA, err=%d", readBytes);
-    }
-    else if (self->readEnabled.IsSet())
-    {
-      INFO_LOG(SP1, "Read data: %s",
-               ArrayToString(self->mRecvBuffer.get(), readBytes, 0x10).c_str());
-      self->mRecvBufferLength = readBytes;
-      self->RecvHandlePacket();
+      CEXIETHERNET::RecvSlot* slot = self->m_eth_ref->RecvRingSlot(position);
+      const int readBytes = read(self->fd, slot ? slot->data : discard, BBA_RECV_SIZE);
+      if (readBytes <= 0)
+      {
+        if (readBytes < 0 && errno != EAGAIN && errno != EWOULDBLOCK)
+          ERROR_LOG(SP1, "Failed to read from BBA, err=%d", errno);
+        break;
+      }
+
+      if (!self->readEnabled.IsSet())
+        continue;
+      if (!slot)
+      {
+        WARN_LOG(SP1, "Receive ring full, dropping a frame");
+        continue;
+      }
+
+      INFO_LOG(SP1, "Read data: %s", ArrayToString(slot->data, readBytes, 0x10).c_str());
+      slot->length = readBytes;
+      ++position;
     }
+
+    if (position != start)
+      self->m_eth_ref->RecvRingPublish(position);
   }
 }
 
-bool CEXIETHERNET::RecvInit()
+bool CEXIETHERNET::TAPNetworkInterface::RecvInit()
 {
   readThread = std::thread(ReadThreadHandler, this);
   return true;
 }
 
-void CEXIETHERNET::RecvStart()
+void CEXIETHERNET::TAPNetworkInterface::RecvStart()
 {
   readEnabled.Set();
 }
 
-void CEXIETHERNET::RecvStop()
+void CEXIETHERNET::TAPNetworkInterface::RecvStop()
 {
   readEnabled.Clear();
 }
@@ -2,6 +2,7 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <cerrno>
 #include <cstring>
 
 #ifndef _WIN32
@@ -28,7 +29,7 @@ namespace ExpansionInterface
 #define NOTIMPLEMENTED(Name)                                                                       \
   NOTICE_LOG(SP1, "CEXIETHERNET::%s not implemented for your UNIX", Name);
 
-bool CEXIETHERNET::Activate()
+bool CEXIETHERNET::TAPNetworkInterface::Activate()
 {
 #ifdef __linux__
   if (IsActivated())
@@ -37,7 +38,7 @@ bool CEXIETHERNET::Activate()
   // Assumes that there is a TAP device named "Dolphin" preconfigured for
   // bridge/NAT/whatever the user wants it configured.
 
-  if ((fd = open("/dev/net/tun", O_RDWR)) < 0)
+  if ((fd = open("/dev/net/tun", O_RDWR | O_NONBLOCK)) < 0)
   {
     ERROR_LOG(SP1, "Couldn't open /dev/net/tun, unable to init BBA");
     return false;
@@ -78,7 +79,7 @@ bool CEXIETHERNET::Activate()
 #endif
 }
 
-void CEXIETHERNET::Deactivate()
+void CEXIETHERNET::TAPNetworkInterface::Deactivate()
 {
 #ifdef __linux__
   close(fd);
@@ -93,7 +94,7 @@ void CEXIETHERNET::Deactivate()
 #endif
 }
 
-bool CEXIETHERNET::IsActivated()
+bool CEXIETHERNET::TAPNetworkInterface::IsActivated()
 {
 #ifdef __linux__
   return fd != -1 ? true : false;
@@ -102,7 +103,7 @@ bool CEXIETHERNET::IsActivated()
 #endif
 }
 
-bool CEXIETHERNET::SendFrame(const u8* frame, u32 size)
+bool CEXIETHERNET::TAPNetworkInterface::SendFrame(const u8* frame, u32 size)
 {
 #ifdef __linux__
   DEBUG_LOG(SP1, "SendFrame %x\n%s", size, ArrayToString(frame, size, 0x10).c_str());
@@ -115,7 +116,7 @@ bool CEXIETHERNET::SendFrame(const u8* frame, u32 size)
   }
   else
   {
-    SendComplete();
+    m_eth_ref->SendComplete();
     return true;
   }
 #else
@@ -125,8 +126,11 @@ bool CEXIETHERNET::SendFrame(const u8* frame, u32 size)
 }
 
 #ifdef __linux__
-static void ReadThreadHandler(CEXIETHERNET* self)
+void CEXIETHERNET::TAPNetworkInterface::ReadThreadHandler(TAPNetworkInterface* self)
 {
+  // Frames that don't fit in the ring are read here to drop them.
+  u8 discard[BBA_RECV_SIZE];
+  u32 position = self->m_eth_ref->mRecvRingWrite.load(std::memory_order_relaxed);
   while (!self->readThreadShutdown.IsSet())
   {
     fd_set rfds;
@@ -139,23 +143,39 @@ static void ReadThreadHandler(CEXIETHERNET* self)
     if (select(self->fd + 1, &rfds, nullptr, nullptr, &timeout) <= 0)
       continue;
 
-    int readBytes = read(self->fd, self->mRecvBuffer.get(), BBA_RECV_SIZE);
-    if (readBytes < 0)
+    // The fd is non-blocking, so read all the frames that are queued and hand them over at once.
+    const u32 start = position;
+    for (u32 i = 0; i < BBA_RECV_BATCH; ++i)
     {
-      ERROR_LOG(SP1, "Failed to read from BBA, err=%d", readBytes);
-    }
-    else if (self->readEnabled.IsSet())
-    {
-      DEBUG_LOG(SP1, "Read data: %s",
-                ArrayToString(self->mRecvBuffer.get(), readBytes, 0x10).c_str());
-      self->mRecvBufferLength = readBytes;
-      self->RecvHandlePacket();
+      CEXIETHERNET::RecvSlot* slot = self->m_eth_ref->RecvRingSlot(position);
+      const int readBytes = read(self->fd, slot ? slot->data : discard, BBA_RECV_SIZE);
+      if (readBytes <= 0)
+      {
+        if (readBytes < 0 && errno != EAGAIN && errno != EWOULDBLOCK)
+          ERROR_LOG(SP1, "Failed to read from BBA, err=%d", errno);
+        break;
+      }
+
+      if (!self->readEnabled.IsSet())
+        continue;
+      if (!slot)
+      {
+        WARN_LOG(SP1, "Receive ring full, dropping a frame");
+        continue;
+      }
+
+      DEBUG_LOG(SP1, "Read data: %s", ArrayToString(slot->data, readBytes, 0x10).c_str());
+      slot->length = readBytes;
+      ++position;
     }
+
+    if (position != start)
+      self->m_eth_ref->RecvRingPublish(position);
   }
 }
 #endif
 
-bool CEXIETHERNET::RecvInit()
+bool CEXIETHERNET::TAPNetworkInterface::RecvInit()
 {
 #ifdef __linux__
   readThread = std::thread(ReadThreadHandler, this);
@@ -166,7 +186,7 @@ bool CEXIETHERNET::RecvInit()
 #endif
 }
 
-void CEXIETHERNET::RecvStart()
+void CEXIETHERNET::TAPNetworkInterface::RecvStart()
 {
 #ifdef __linux__
   readEnabled.Set();
@@ -175,7 +195,7 @@ void CEXIETHERNET::RecvStart()
 #endif
 }
 
-void CEXIETHERNET::RecvStop()
+void CEXIETHERNET::TAPNetworkInterface::RecvStop()
 {
 #ifdef __linux__
   readEnabled.Clear();
@@ -7,6 +7,7 @@
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Common/StringUtil.h"
+#include "Common/Thread.h"
 #include "Core/HW/EXI/EXI_Device.h"
 #include "Core/HW/EXI/EXI_DeviceEthernet.h"
 
@@ -167,7 +168,7 @@ bool OpenTAP(HANDLE& adapter, const std::basic_string<TCHAR>& device_guid)
 
 namespace ExpansionInterface
 {
-bool CEXIETHERNET::Activate()
+bool CEXIETHERNET::TAPNetworkInterface::Activate()
 {
   if (IsActivated())
     return true;
@@ -224,16 +225,21 @@ bool CEXIETHERNET::Activate()
   }
 
   /* initialize read/write events */
-  mReadOverlapped.hEvent = CreateEvent(nullptr, TRUE, FALSE, nullptr);
+  for (OVERLAPPED& overlapped : mReadOverlapped)
+  {
+    overlapped.hEvent = CreateEvent(nullptr, TRUE, FALSE, nullptr);
+    if (overlapped.hEvent == nullptr)
+      return false;
+  }
   mWriteOverlapped.hEvent = CreateEvent(nullptr, TRUE, FALSE, nullptr);
-  if (mReadOverlapped.hEvent == nullptr || mWriteOverlapped.hEvent == nullptr)
+  if (mWriteOverlapped.hEvent == nullptr)
     return false;
 
   mWriteBuffer.reserve(1518);
   return RecvInit();
 }
 
-void CEXIETHERNET::Deactivate()
+void CEXIETHERNET::TAPNetworkInterface::Deactivate()
 {
   if (!IsActivated())
     return;
@@ -250,7 +256,8 @@ void CEXIETHERNET::Deactivate()
     readThread.join();
 
   // Clean-up handles
-  CloseHandle(mReadOverlapped.hEvent);
+  for (OVERLAPPED& overlapped : mReadOverlapped)
+    CloseHandle(overlapped.hEvent);
   CloseHandle(mWriteOverlapped.hEvent);
   CloseHandle(mHAdapter);
   mHAdapter = INVALID_HANDLE_VALUE;
@@ -258,58 +265,80 @@ void CEXIETHERNET::Deactivate()
   memset(&mWriteOverlapped, 0, sizeof(mWriteOverlapped));
 }
 
-bool CEXIETHERNET::IsActivated()
+bool CEXIETHERNET::TAPNetworkInterface::IsActivated()
 {
   return mHAdapter != INVALID_HANDLE_VALUE;
 }
 
-static void ReadThreadHandler(CEXIETHERNET* self)
+void CEXIETHERNET::TAPNetworkInterface::ReadThreadHandler(TAPNetworkInterface* self)
 {
+  // Reads are queued into the next free slots of the ring, up to a batch of them, so the driver
+  // can complete one while the previous frames are handed over. It completes them in the order
+  // they were queued, so a read which fails or whose frame is dropped still takes up its slot.
+  u32 position = self->m_eth_ref->mRecvRingWrite.load(std::memory_order_relaxed);
+  u32 queued = 0;
+  DWORD transferred;
   while (!self->readThreadShutdown.IsSet())
   {
-    DWORD transferred;
-
-    // Read from TAP into internal buffer.
-    if (ReadFile(self->mHAdapter, self->mRecvBuffer.get(), BBA_RECV_SIZE, &transferred,
-                 &self->mReadOverlapped))
-    {
-      // Returning immediately is not likely to happen, but if so, reset the event state manually.
-      ResetEvent(self->mReadOverlapped.hEvent);
-    }
-    else
+    while (queued < BBA_RECV_BATCH)
     {
-      // IO should be pending.
-      if (GetLastError() != ERROR_IO_PENDING)
+      CEXIETHERNET::RecvSlot* slot = self->m_eth_ref->RecvRingSlot(position + queued);
+      if (!slot)
+        break;
+
+      OVERLAPPED* overlapped = &self->mReadOverlapped[(position + queued) % BBA_RECV_BATCH];
+      if (!ReadFile(self->mHAdapter, slot->data, BBA_RECV_SIZE, nullptr, overlapped) &&
+          GetLastError() != ERROR_IO_PENDING)
       {
         ERROR_LOG(SP1, "ReadFile failed (err=0x%X)", GetLastError());
-        continue;
+        break;
       }
+      ++queued;
+    }
 
-      // Block until the read completes.
-      if (!GetOverlappedResult(self->mHAdapter, &self->mReadOverlapped, &transferred, TRUE))
-      {
-        // If CancelIO was called, we should exit (the flag will be set).
-        if (GetLastError() == ERROR_OPERATION_ABORTED)
-          continue;
+    // The ring is full, wait for the CPU thread to drain it.
+    if (queued == 0)
+    {
+      Common::SleepCurrentThread(1);
+      continue;
+    }
 
-        // Something else went wrong.
+    // Block until the oldest read completes.
+    CEXIETHERNET::RecvSlot* slot = &self->m_eth_ref->mRecvRing[position % BBA_RECV_RING_SLOTS];
+    if (GetOverlappedResult(self->mHAdapter, &self->mReadOverlapped[position % BBA_RECV_BATCH],
+                            &transferred, TRUE))
+    {
+      DEBUG_LOG(SP1, "Received %u bytes:\n %s", transferred,
+                ArrayToString(slot->data, transferred, 0x10).c_str());
+    }
+    else
+    {
+      // If CancelIO was called, we should exit (the flag will be set).
+      if (GetLastError() != ERROR_OPERATION_ABORTED)
         ERROR_LOG(SP1, "GetOverlappedResult failed (err=0x%X)", GetLastError());
-        continue;
-      }
+      transferred = 0;
     }
+    slot->length = self->readEnabled.IsSet() ? transferred : 0;
+    ++position;
+    --queued;
 
-    // Copy to BBA buffer, and fire interrupt if enabled.
-    DEBUG_LOG(SP1, "Received %u bytes:\n %s", transferred,
-              ArrayToString(self->mRecvBuffer.get(), transferred, 0x10).c_str());
-    if (self->readEnabled.IsSet())
+    // Hand the frames over once there is no other one already waiting.
+    if (queued == 0 ||
+        !HasOverlappedIoCompleted(&self->mReadOverlapped[position % BBA_RECV_BATCH]))
     {
-      self->mRecvBufferLength = transferred;
-      self->RecvHandlePacket();
+      self->m_eth_ref->RecvRingPublish(position);
     }
   }
+
+  // The cancelled reads still own their slots until they complete.
+  for (; queued != 0; --queued, ++position)
+  {
+    GetOverlappedResult(self->mHAdapter, &self->mReadOverlapped[position % BBA_RECV_BATCH],
+                        &transferred, TRUE);
+  }
 }
 
-bool CEXIETHERNET::SendFrame(const u8* frame, u32 size)
+bool CEXIETHERNET::TAPNetworkInterface::SendFrame(const u8* frame, u32 size)
 {
   DEBUG_LOG(SP1, "SendFrame %u bytes:\n%s", size, ArrayToString(frame, size, 0x10).c_str());
 
@@ -345,22 +374,22 @@ bool CEXIETHERNET::SendFrame(const u8* frame, u32 size)
   }
 
   // Always report the packet as being sent successfully, even though it might be a lie
-  SendComplete();
+  m_eth_ref->SendComplete();
   return true;
 }
 
-bool CEXIETHERNET::RecvInit()
+bool CEXIETHERNET::TAPNetworkInterface::RecvInit()
 {
   readThread = std::thread(ReadThreadHandler, this);
   return true;
 }
 
-void CEXIETHERNET::RecvStart()
+void CEXIETHERNET::TAPNetworkInterface::RecvStart()
 {
   readEnabled.Set();
 }
 
-void CEXIETHERNET::RecvStop()
+void CEXIETHERNET::TAPNetworkInterface::RecvStop()
 {
   readEnabled.Clear();
 }
@@ -5,6 +5,7 @@
 #include "Core/HW/EXI/EXI_Device.h"
 
 #include <memory>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Core/HW/EXI/EXI_DeviceAD16.h"
@@ -48,21 +49,18 @@ void IEXIDevice::ImmReadWrite(u32& data, u32 size)
 
 void IEXIDevice::DMAWrite(u32 address, u32 size)
 {
-  while (size--)
-  {
-    u8 byte = Memory::Read_U8(address++);
+  std::vector<u8> buffer(size);
+  Memory::CopyFromEmu(buffer.data(), address, size);
+  for (u8& byte : buffer)
     TransferByte(byte);
-  }
 }
 
 void IEXIDevice::DMARead(u32 address, u32 size)
 {
-  while (size--)
-  {
-    u8 byte = 0;
+  std::vector<u8> buffer(size);
+  for (u8& byte : buffer)
     TransferByte(byte);
-    Memory::Write_U8(byte, address++);
-  }
+  Memory::CopyToEmu(address, buffer.data(), size);
 }
 
 IEXIDevice* IEXIDevice::FindDevice(TEXIDevices device_type, int custom_index)
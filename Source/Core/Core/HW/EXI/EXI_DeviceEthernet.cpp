@@ -11,8 +11,10 @@
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/Network.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/CoreTiming.h"
+#include "Core/HW/EXI/BBA-BuiltIn/BuiltIn.h"
 #include "Core/HW/EXI/EXI.h"
 #include "Core/HW/Memmap.h"
 
@@ -22,13 +24,24 @@ namespace ExpansionInterface
 // Multiple parts of this implementation depend on Dolphin
 // being compiled for a little endian host.
 
+static CoreTiming::EventType* s_et_recv_drain;
+
+void CEXIETHERNET::Init()
+{
+  s_et_recv_drain = CoreTiming::RegisterEvent("BBARecvDrain", RecvDrainCallback);
+}
+
+void CEXIETHERNET::Shutdown()
+{
+  s_et_recv_drain = nullptr;
+}
+
 CEXIETHERNET::CEXIETHERNET()
 {
   tx_fifo = std::make_unique<u8[]>(BBA_TXFIFO_SIZE);
   mBbaMem = std::make_unique<u8[]>(BBA_MEM_SIZE);
 
-  mRecvBuffer = std::make_unique<u8[]>(BBA_RECV_SIZE);
-  mRecvBufferLength = 0;
+  mRecvRing = std::make_unique<RecvSlot[]>(BBA_RECV_RING_SLOTS);
 
   MXHardReset();
 
@@ -49,6 +62,21 @@ CEXIETHERNET::CEXIETHERNET()
   // HACK: .. fully established 100BASE-T link
   mBbaMem[BBA_NWAYS] = NWAYS_LS100 | NWAYS_LPNWAY | NWAYS_100TXF | NWAYS_ANCLPT;
 
+  if (Config::Get(Config::MAIN_BBA_BUILTIN))
+    m_network_interface = std::make_unique<BuiltInNetworkInterface>(this);
+  else
+    m_network_interface = std::make_unique<TAPNetworkInterface>(this);
+}
+
+CEXIETHERNET::~CEXIETHERNET()
+{
+  // Stops the threads producing into the ring before it goes away.
+  m_network_interface.reset();
+}
+
+CEXIETHERNET::TAPNetworkInterface::TAPNetworkInterface(CEXIETHERNET* eth_ref)
+    : NetworkInterface(eth_ref)
+{
 #if defined(_WIN32)
   mHAdapter = INVALID_HANDLE_VALUE;
   memset(&mReadOverlapped, 0, sizeof(mReadOverlapped));
@@ -59,7 +87,7 @@ CEXIETHERNET::CEXIETHERNET()
 #endif
 }
 
-CEXIETHERNET::~CEXIETHERNET()
+CEXIETHERNET::TAPNetworkInterface::~TAPNetworkInterface()
 {
   Deactivate();
 }
@@ -312,7 +340,7 @@ void CEXIETHERNET::MXCommandHandler(u32 data, u32 size)
     {
       INFO_LOG(SP1, "Software reset");
       // MXSoftReset();
-      Activate();
+      m_network_interface->Activate();
     }
 
     if ((mBbaMem[BBA_NCRA] & NCRA_SR) ^ (data & NCRA_SR))
@@ -320,9 +348,9 @@ void CEXIETHERNET::MXCommandHandler(u32 data, u32 size)
       DEBUG_LOG(SP1, "%s rx", (data & NCRA_SR) ? "start" : "stop");
 
       if (data & NCRA_SR)
-        RecvStart();
+        m_network_interface->RecvStart();
       else
-        RecvStop();
+        m_network_interface->RecvStop();
     }
 
     // Only start transfer if there isn't one currently running
@@ -395,7 +423,7 @@ void CEXIETHERNET::DirectFIFOWrite(const u8* data, u32 size)
 
 void CEXIETHERNET::SendFromDirectFIFO()
 {
-  SendFrame(tx_fifo.get(), *(u16*)&mBbaMem[BBA_TXFIFOCNT]);
+  m_network_interface->SendFrame(tx_fifo.get(), *(u16*)&mBbaMem[BBA_TXFIFOCNT]);
 }
 
 void CEXIETHERNET::SendFromPacketBuffer()
@@ -441,7 +469,7 @@ inline u8 CEXIETHERNET::HashIndex(const u8* dest_eth_addr)
   return crc >> 26;
 }
 
-inline bool CEXIETHERNET::RecvMACFilter()
+inline bool CEXIETHERNET::RecvMACFilter(const u8* frame)
 {
   static u8 const broadcast[] = {0xff, 0xff, 0xff, 0xff, 0xff, 0xff};
 
@@ -450,11 +478,11 @@ inline bool CEXIETHERNET::RecvMACFilter()
     return true;
 
   // Unicast?
-  if ((mRecvBuffer[0] & 0x01) == 0)
+  if ((frame[0] & 0x01) == 0)
   {
-    return memcmp(mRecvBuffer.get(), &mBbaMem[BBA_NAFR_PAR0], 6) == 0;
+    return memcmp(frame, &mBbaMem[BBA_NAFR_PAR0], 6) == 0;
   }
-  else if (memcmp(mRecvBuffer.get(), broadcast, 6) == 0)
+  else if (memcmp(frame, broadcast, 6) == 0)
   {
     // Accept broadcast?
     return !!(mBbaMem[BBA_NCRB] & NCRB_AB);
@@ -467,7 +495,7 @@ inline bool CEXIETHERNET::RecvMACFilter()
   else
   {
     // Lookup the dest eth address in the hashmap
-    u16 index = HashIndex(mRecvBuffer.get());
+    u16 index = HashIndex(frame);
     return !!(mBbaMem[BBA_NAFR_MAR0 + index / 8] & (1 << (index % 8)));
   }
 }
@@ -482,9 +510,49 @@ inline void CEXIETHERNET::inc_rwp()
     (*rwp)++;
 }
 
+CEXIETHERNET::RecvSlot* CEXIETHERNET::RecvRingSlot(u32 position)
+{
+  if (position - mRecvRingRead.load(std::memory_order_acquire) >= BBA_RECV_RING_SLOTS)
+    return nullptr;
+  return &mRecvRing[position % BBA_RECV_RING_SLOTS];
+}
+
+void CEXIETHERNET::RecvRingPublish(u32 position)
+{
+  mRecvRingWrite.store(position, std::memory_order_release);
+
+  // One event drains everything published before it runs, so only schedule one if there is none
+  // pending. The drain clears the flag before looking at the write position, so frames published
+  // after that are either seen by it or schedule another event.
+  if (!mRecvDrainScheduled.exchange(true))
+    CoreTiming::ScheduleEvent(0, s_et_recv_drain, 0, CoreTiming::FromThread::NON_CPU);
+}
+
+void CEXIETHERNET::RecvDrainCallback(u64 userdata, s64 cycles_late)
+{
+  CEXIETHERNET* self = static_cast<CEXIETHERNET*>(ExpansionInterface::FindDevice(EXIDEVICE_ETH));
+  if (self)
+    self->RecvRingDrain();
+}
+
+void CEXIETHERNET::RecvRingDrain()
+{
+  mRecvDrainScheduled.store(false);
+
+  const u32 end = mRecvRingWrite.load(std::memory_order_acquire);
+  u32 position = mRecvRingRead.load(std::memory_order_relaxed);
+  for (; position != end; ++position)
+  {
+    const RecvSlot& slot = mRecvRing[position % BBA_RECV_RING_SLOTS];
+    if (slot.length != 0)
+      RecvHandlePacket(slot.data, slot.length);
+    mRecvRingRead.store(position + 1, std::memory_order_release);
+  }
+}
+
 // This function is on the critical path for receiving data.
 // Be very careful about calling into the logger and other slow things
-bool CEXIETHERNET::RecvHandlePacket()
+bool CEXIETHERNET::RecvHandlePacket(const u8* frame, u32 length)
 {
   u8* write_ptr;
   u8* end_ptr;
@@ -493,12 +561,11 @@ bool CEXIETHERNET::RecvHandlePacket()
   u32 status = 0;
   u16 rwp_initial = page_ptr(BBA_RWP);
 
-  if (!RecvMACFilter())
+  if (!RecvMACFilter(frame))
     goto wait_for_next;
 
 #ifdef BBA_TRACK_PAGE_PTRS
-  INFO_LOG(SP1, "RecvHandlePacket %x\n%s", mRecvBufferLength,
-           ArrayToString(mRecvBuffer, mRecvBufferLength, 0x100).c_str());
+  INFO_LOG(SP1, "RecvHandlePacket %x\n%s", length, ArrayToString(frame, length, 0x100).c_str());
 
   INFO_LOG(SP1, "%x %x %x %x", page_ptr(BBA_BP), page_ptr(BBA_RRP), page_ptr(BBA_RWP),
            page_ptr(BBA_RHBP));
@@ -511,9 +578,9 @@ bool CEXIETHERNET::RecvHandlePacket()
   descriptor = (Descriptor*)write_ptr;
   write_ptr += 4;
 
-  for (u32 i = 0, off = 4; i < mRecvBufferLength; ++i, ++off)
+  for (u32 i = 0, off = 4; i < length; ++i, ++off)
   {
-    *write_ptr++ = mRecvBuffer[i];
+    *write_ptr++ = frame[i];
 
     if (off == 0xff)
     {
@@ -544,7 +611,7 @@ bool CEXIETHERNET::RecvHandlePacket()
   }
 
   // Align up to next page
-  if ((mRecvBufferLength + 4) % 256)
+  if ((length + 4) % 256)
     inc_rwp();
 
 #ifdef BBA_TRACK_PAGE_PTRS
@@ -553,7 +620,7 @@ bool CEXIETHERNET::RecvHandlePacket()
 #endif
 
   // Is the current frame multicast?
-  if (mRecvBuffer[0] & 0x01)
+  if (frame[0] & 0x01)
     status |= DESC_MF;
 
   if (status & DESC_BF)
@@ -568,7 +635,7 @@ bool CEXIETHERNET::RecvHandlePacket()
     }
   }
 
-  descriptor->set(*(u16*)&mBbaMem[BBA_RWP], 4 + mRecvBufferLength, status);
+  descriptor->set(*(u16*)&mBbaMem[BBA_RWP], 4 + length, status);
 
   mBbaMem[BBA_LRPS] = status;
 
@@ -578,7 +645,7 @@ bool CEXIETHERNET::RecvHandlePacket()
     mBbaMem[BBA_IR] |= INT_R;
 
     exi_status.interrupt |= exi_status.TRANSFER;
-    ExpansionInterface::ScheduleUpdateInterrupts(CoreTiming::FromThread::NON_CPU, 0);
+    ExpansionInterface::ScheduleUpdateInterrupts(CoreTiming::FromThread::CPU, 0);
   }
   else
   {
@@ -588,7 +655,7 @@ bool CEXIETHERNET::RecvHandlePacket()
 
 wait_for_next:
   if (mBbaMem[BBA_NCRA] & NCRA_SR)
-    RecvStart();
+    m_network_interface->RecvStart();
 
   return true;
 }
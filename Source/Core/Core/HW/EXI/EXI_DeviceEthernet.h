@@ -4,7 +4,9 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
+#include <memory>
 #include <thread>
 #include <vector>
 
@@ -195,6 +197,10 @@ enum RecvStatus
 };
 
 #define BBA_RECV_SIZE 0x800
+// Received frames waiting for the CPU thread.
+#define BBA_RECV_RING_SLOTS 32
+// Reads the TAP backends keep queued at once.
+#define BBA_RECV_BATCH 8
 
 class CEXIETHERNET : public IEXIDevice
 {
@@ -210,6 +216,9 @@ public:
   void DMARead(u32 addr, u32 size) override;
   void DoState(PointerWrap& p) override;
 
+  static void Init();
+  static void Shutdown();
+
   // private:
   struct
   {
@@ -304,40 +313,92 @@ public:
   void SendFromPacketBuffer();
   void SendComplete();
   u8 HashIndex(const u8* dest_eth_addr);
-  bool RecvMACFilter();
+  bool RecvMACFilter(const u8* frame);
   void inc_rwp();
-  bool RecvHandlePacket();
+  bool RecvHandlePacket(const u8* frame, u32 length);
 
   std::unique_ptr<u8[]> mBbaMem;
   std::unique_ptr<u8[]> tx_fifo;
 
-  // TAP interface
-  bool Activate();
-  void Deactivate();
-  bool IsActivated();
-  bool SendFrame(const u8* frame, u32 size);
-  bool RecvInit();
-  void RecvStart();
-  void RecvStop();
+  // The read thread reads frames straight into the slots of a ring, which the CPU thread drains
+  // from a CoreTiming event. There is a single producer and a single consumer, so the ring needs
+  // no lock: a slot belongs to the read thread until the write position moves past it, and to the
+  // CPU thread until the read position does. Positions count slots and wrap around with u32.
+  struct RecvSlot
+  {
+    // Zero for a read whose frame is dropped.
+    u32 length;
+    u8 data[BBA_RECV_SIZE];
+  };
 
-  std::unique_ptr<u8[]> mRecvBuffer;
-  u32 mRecvBufferLength;
+  // The slot at the position, or nullptr if it is still waiting for the CPU thread.
+  RecvSlot* RecvRingSlot(u32 position);
+  // Hands the slots up to the position over to the CPU thread. Called by the read thread.
+  void RecvRingPublish(u32 position);
+  void RecvRingDrain();
+  static void RecvDrainCallback(u64 userdata, s64 cycles_late);
+
+  std::unique_ptr<RecvSlot[]> mRecvRing;
+  std::atomic<u32> mRecvRingRead{0};
+  std::atomic<u32> mRecvRingWrite{0};
+  std::atomic<bool> mRecvDrainScheduled{false};
+
+  // Where the frames go on the host. SendFrame is called on the CPU thread, and received frames
+  // are handed over through the ring.
+  class NetworkInterface
+  {
+  public:
+    explicit NetworkInterface(CEXIETHERNET* eth_ref) : m_eth_ref(eth_ref) {}
+    virtual ~NetworkInterface() = default;
+
+    virtual bool Activate() = 0;
+    virtual void Deactivate() = 0;
+    virtual bool IsActivated() = 0;
+    virtual bool SendFrame(const u8* frame, u32 size) = 0;
+    virtual bool RecvInit() = 0;
+    virtual void RecvStart() = 0;
+    virtual void RecvStop() = 0;
+
+  protected:
+    CEXIETHERNET* m_eth_ref;
+  };
+
+  // Bridges the frames to a TAP device of the host.
+  class TAPNetworkInterface : public NetworkInterface
+  {
+  public:
+    explicit TAPNetworkInterface(CEXIETHERNET* eth_ref);
+    ~TAPNetworkInterface() override;
+
+    bool Activate() override;
+    void Deactivate() override;
+    bool IsActivated() override;
+    bool SendFrame(const u8* frame, u32 size) override;
+    bool RecvInit() override;
+    void RecvStart() override;
+    void RecvStop() override;
+
+  private:
+    static void ReadThreadHandler(TAPNetworkInterface* self);
 
 #if defined(_WIN32)
-  HANDLE mHAdapter;
-  OVERLAPPED mReadOverlapped;
-  OVERLAPPED mWriteOverlapped;
-  std::vector<u8> mWriteBuffer;
-  bool mWritePending;
+    HANDLE mHAdapter;
+    std::array<OVERLAPPED, BBA_RECV_BATCH> mReadOverlapped;
+    OVERLAPPED mWriteOverlapped;
+    std::vector<u8> mWriteBuffer;
+    bool mWritePending;
 #elif defined(__linux__) || defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__)
-  int fd;
+    int fd;
 #endif
 
-#if defined(WIN32) || defined(__linux__) || defined(__APPLE__) || defined(__FreeBSD__) ||          \
+#if defined(WIN32) || defined(__linux__) || defined(__APPLE__) || defined(__FreeBSD__) ||        \
     defined(__OpenBSD__)
-  std::thread readThread;
-  Common::Flag readEnabled;
-  Common::Flag readThreadShutdown;
+    std::thread readThread;
+    Common::Flag readEnabled;
+    Common::Flag readThreadShutdown;
 #endif
+  };
+
+  std::unique_ptr<NetworkInterface> m_network_interface;
 };
 }  // namespace ExpansionInterface
@@ -4,6 +4,7 @@
 
 #include "Core/HW/EXI/EXI_DeviceIPL.h"
 
+#include <algorithm>
 #include <cstring>
 #include <string>
 
@@ -22,6 +23,7 @@
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
+#include "Core/HW/Memmap.h"
 #include "Core/HW/Sram.h"
 #include "Core/HW/SystemTimers.h"
 #include "Core/Movie.h"
@@ -380,21 +382,7 @@ void CEXIIPL::TransferByte(u8& _uByte)
           // At the moment, we pre-decrypt the whole thing and
           // ignore the "enabled" bit - see CEXIIPL::CEXIIPL
           _uByte = m_pIPL[position];
-
-          if ((position >= 0x001AFF00) && (position <= 0x001FF474) && !m_FontsLoaded)
-          {
-            if (position >= 0x001FCF00)
-            {
-              PanicAlertT("Error: Trying to access Windows-1252 fonts but they are not loaded. "
-                          "Games may not show fonts correctly, or crash.");
-            }
-            else
-            {
-              PanicAlertT("Error: Trying to access Shift JIS fonts but they are not loaded. "
-                          "Games may not show fonts correctly, or crash.");
-            }
-            m_FontsLoaded = true;  // Don't be a nag :p
-          }
+          CheckFontAccess(position, 1);
         }
       }
       else
@@ -411,6 +399,68 @@ void CEXIIPL::TransferByte(u8& _uByte)
   m_uPosition++;
 }
 
+// ROM reads, which include the fonts and the IPL itself, are copied all at once instead of
+// going through TransferByte for every byte.
+void CEXIIPL::DMARead(u32 address, u32 size)
+{
+  if (m_uPosition <= 3 || IsWriteCommand() || !IsROMRegion(CommandRegion()) ||
+      (m_uAddress >> 6) >= ROM_SIZE)
+  {
+    IEXIDevice::DMARead(address, size);
+    return;
+  }
+
+  const u32 position = ((m_uAddress >> 6) & ROM_MASK) + m_uRWOffset;
+  if (position > ROM_SIZE || size > ROM_SIZE - position)
+  {
+    IEXIDevice::DMARead(address, size);
+    return;
+  }
+
+  Memory::CopyToEmu(address, m_pIPL + position, size);
+  CheckFontAccess(position, size);
+  m_uRWOffset += size;
+  m_uPosition += size;
+}
+
+bool CEXIIPL::IsROMRegion(u32 region)
+{
+  switch (region)
+  {
+  case REGION_RTC:
+  case REGION_SRAM:
+  case REGION_UART:
+  case REGION_EUART:
+  case REGION_EUART_UNK:
+  case REGION_UART_UNK:
+  case REGION_BARNACLE:
+    return false;
+  default:
+    return true;
+  }
+}
+
+void CEXIIPL::CheckFontAccess(u32 position, u32 size)
+{
+  constexpr u32 FONTS_START = 0x001AFF00;
+  constexpr u32 FONTS_END = 0x001FF474;
+  constexpr u32 WINDOWS_1252_FONT_START = 0x001FCF00;
+  if (m_FontsLoaded || position > FONTS_END || position + size <= FONTS_START)
+    return;
+
+  if (std::max(position, FONTS_START) >= WINDOWS_1252_FONT_START)
+  {
+    PanicAlertT("Error: Trying to access Windows-1252 fonts but they are not loaded. "
+                "Games may not show fonts correctly, or crash.");
+  }
+  else
+  {
+    PanicAlertT("Error: Trying to access Shift JIS fonts but they are not loaded. "
+                "Games may not show fonts correctly, or crash.");
+  }
+  m_FontsLoaded = true;  // Don't be a nag :p
+}
+
 u32 CEXIIPL::GetEmulatedTime(u32 epoch)
 {
   u64 ltime = 0;
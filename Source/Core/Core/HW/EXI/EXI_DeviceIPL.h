@@ -20,6 +20,7 @@ public:
 
   void SetCS(int _iCS) override;
   bool IsPresent() const override;
+  void DMARead(u32 address, u32 size) override;
   void DoState(PointerWrap& p) override;
 
 #if defined(_MSC_VER) && _MSC_VER <= 1800
@@ -76,6 +77,10 @@ private:
   void UpdateRTC();
 
   void TransferByte(u8& _uByte) override;
+  // Whether reads of the region come from the ROM, as for any region that isn't a register.
+  static bool IsROMRegion(u32 region);
+  // Warns once when a read of size bytes at position touches fonts which aren't loaded.
+  void CheckFontAccess(u32 position, u32 size);
   bool IsWriteCommand() const { return !!(m_uAddress & (1 << 31)); }
   u32 CommandRegion() const { return (m_uAddress & ~(1 << 31)) >> 8; }
   bool LoadFileToIPL(const std::string& filename, u32 offset);
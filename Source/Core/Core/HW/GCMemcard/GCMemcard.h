@@ -291,6 +291,9 @@ public:
   std::vector<u16> m_used_blocks;
   int UsesBlock(u16 blocknum);
   bool m_dirty;
+  // Which blocks of m_save_data were written since it was loaded or flushed. Empty if unknown,
+  // in which case the whole file is rewritten.
+  std::vector<bool> m_dirty_blocks;
   std::string m_filename;
 };
 
@@ -76,11 +76,8 @@ int GCMemcardDirectory::LoadGCI(const std::string& file_name, bool current_game_
       return NO_INDEX;
     }
 
-    if (m_game_id == BE32(gci.m_gci_header.Gamecode))
-    {
-      gci.LoadSaveBlocks();
-    }
-    else
+    // The save data is only read once the game accesses it (see SaveAreaRW).
+    if (m_game_id != BE32(gci.m_gci_header.Gamecode))
     {
       if (current_game_only)
       {
@@ -320,6 +317,13 @@ s32 GCMemcardDirectory::Write(u32 dest_address, s32 length, const u8* src_addres
   }
 
   memcpy(m_last_block_address + offset, src_address, length);
+  if (block >= MC_FST_BLOCKS && m_last_block_save != -1)
+  {
+    GCIFile& save = m_saves[m_last_block_save];
+    save.m_dirty = true;
+    if (!save.m_dirty_blocks.empty())
+      save.m_dirty_blocks[m_last_block_index] = true;
+  }
 
   l.unlock();
   if (extra)
@@ -410,6 +414,7 @@ inline void GCMemcardDirectory::SyncSaves()
           INFO_LOG(EXPANSIONINTERFACE, "Save moved from 0x%x to 0x%x", old_start, new_start);
           m_saves[i].m_used_blocks.clear();
           m_saves[i].m_save_data.clear();
+          m_saves[i].m_dirty_blocks.clear();
         }
         if (m_saves[i].m_used_blocks.size() == 0)
         {
@@ -423,6 +428,7 @@ inline void GCMemcardDirectory::SyncSaves()
                BE32(m_saves[i].m_gci_header.Gamecode));
       *(u32*)&(m_saves[i].m_gci_header.Gamecode) = 0xFFFFFFFF;
       m_saves[i].m_save_data.clear();
+      m_saves[i].m_dirty_blocks.clear();
       m_saves[i].m_used_blocks.clear();
       m_saves[i].m_dirty = true;
     }
@@ -430,6 +436,7 @@ inline void GCMemcardDirectory::SyncSaves()
 }
 inline s32 GCMemcardDirectory::SaveAreaRW(u32 block, bool writing)
 {
+  m_last_block_save = -1;
   for (u16 i = 0; i < m_saves.size(); ++i)
   {
     if (BE32(m_saves[i].m_gci_header.Gamecode) != 0xFFFFFFFF)
@@ -455,10 +462,14 @@ inline s32 GCMemcardDirectory::SaveAreaRW(u32 block, bool writing)
         if (writing)
         {
           m_saves[i].m_dirty = true;
+          if (!m_saves[i].m_dirty_blocks.empty())
+            m_saves[i].m_dirty_blocks[idx] = true;
         }
 
         m_last_block = block;
         m_last_block_address = m_saves[i].m_save_data[idx].block;
+        m_last_block_save = i;
+        m_last_block_index = idx;
         return m_last_block;
       }
     }
@@ -557,14 +568,20 @@ void GCMemcardDirectory::FlushToFile()
                         default_save_name.c_str());
           m_saves[i].m_filename = default_save_name;
         }
-        File::IOFile gci(m_saves[i].m_filename, "wb");
-        if (gci)
+        if (WriteDirtyBlocks(m_saves[i]))
+        {
+          m_saves[i].m_dirty_blocks.assign(m_saves[i].m_save_data.size(), false);
+          Core::DisplayMessage(
+              StringFromFormat("Wrote save contents to %s", m_saves[i].m_filename.c_str()), 4000);
+        }
+        else if (File::IOFile gci{m_saves[i].m_filename, "wb"})
         {
           gci.WriteBytes(&m_saves[i].m_gci_header, DENTRY_SIZE);
           gci.WriteBytes(m_saves[i].m_save_data.data(), BLOCK_SIZE * m_saves[i].m_save_data.size());
 
           if (gci.IsGood())
           {
+            m_saves[i].m_dirty_blocks.assign(m_saves[i].m_save_data.size(), false);
             Core::DisplayMessage(
                 StringFromFormat("Wrote save contents to %s", m_saves[i].m_filename.c_str()), 4000);
           }
@@ -589,6 +606,7 @@ void GCMemcardDirectory::FlushToFile()
         File::Rename(old_name, deleted_name);
         m_saves[i].m_filename.clear();
         m_saves[i].m_save_data.clear();
+        m_saves[i].m_dirty_blocks.clear();
         m_saves[i].m_used_blocks.clear();
       }
     }
@@ -604,6 +622,7 @@ void GCMemcardDirectory::FlushToFile()
       INFO_LOG(EXPANSIONINTERFACE, "Flushing savedata to disk for %s",
                m_saves[i].m_filename.c_str());
       m_saves[i].m_save_data.clear();
+      m_saves[i].m_dirty_blocks.clear();
     }
   }
 #if _WRITE_MC_HEADER
@@ -614,11 +633,59 @@ void GCMemcardDirectory::FlushToFile()
 #endif
 }
 
+bool GCMemcardDirectory::WriteDirtyBlocks(const GCIFile& save) const
+{
+  // Only an existing file with the same layout can be updated in place.
+  const size_t num_blocks = save.m_save_data.size();
+  if (save.m_dirty_blocks.size() != num_blocks ||
+      File::GetSize(save.m_filename) != DENTRY_SIZE + num_blocks * BLOCK_SIZE)
+  {
+    return false;
+  }
+
+  File::IOFile gci(save.m_filename, "r+b");
+  if (!gci || !gci.WriteBytes(&save.m_gci_header, DENTRY_SIZE))
+    return false;
+
+  size_t first = 0;
+  while (first < num_blocks)
+  {
+    if (!save.m_dirty_blocks[first])
+    {
+      ++first;
+      continue;
+    }
+
+    size_t end = first + 1;
+    while (end < num_blocks && save.m_dirty_blocks[end])
+      ++end;
+    gci.Seek(DENTRY_SIZE + first * BLOCK_SIZE, SEEK_SET);
+    if (!gci.WriteBytes(&save.m_save_data[first], (end - first) * BLOCK_SIZE))
+      return false;
+    first = end;
+  }
+
+  return gci.IsGood();
+}
+
 void GCMemcardDirectory::DoState(PointerWrap& p)
 {
   std::unique_lock<std::mutex> l(m_write_mutex);
   m_last_block = -1;
   m_last_block_address = nullptr;
+  m_last_block_save = -1;
+
+  // The running game's saves are kept in savestates even if it didn't access them yet, so that
+  // loading the state doesn't pick up the changes made to the files in the meantime.
+  if (p.GetMode() != PointerWrap::MODE_READ)
+  {
+    for (GCIFile& save : m_saves)
+    {
+      if (BE32(save.m_gci_header.Gamecode) == m_game_id)
+        save.LoadSaveBlocks();
+    }
+  }
+
   p.Do(m_save_directory);
   p.DoPOD<Header>(m_hdr);
   p.DoPOD<Directory>(m_dir1);
@@ -655,6 +722,7 @@ bool GCIFile::LoadSaveBlocks()
       m_save_data.clear();
       return false;
     }
+    m_dirty_blocks.assign(num_blocks, false);
   }
   return true;
 }
@@ -677,10 +745,7 @@ void GCIFile::DoState(PointerWrap& p)
   int num_blocks = (int)m_save_data.size();
   p.Do(num_blocks);
   m_save_data.resize(num_blocks);
-  for (auto itr = m_save_data.begin(); itr != m_save_data.end(); ++itr)
-  {
-    p.DoPOD<GCMBlock>(*itr);
-  }
+  p.DoPODArray(m_save_data.data(), num_blocks);
   p.Do(m_used_blocks);
 }
 
@@ -43,10 +43,14 @@ private:
   s32 DirectoryWrite(u32 dest_address, u32 length, const u8* src_address);
   inline void SyncSaves();
   bool SetUsedBlocks(int save_index);
+  bool WriteDirtyBlocks(const GCIFile& save) const;
 
   u32 m_game_id;
   s32 m_last_block;
   u8* m_last_block_address;
+  // The save and the index in it of m_last_block, when it is in the save area.
+  int m_last_block_save = -1;
+  int m_last_block_index = -1;
 
   Header m_hdr;
   Directory m_dir1, m_dir2;
@@ -4,12 +4,15 @@
 
 #include "Core/HW/GCMemcard/GCMemcardRaw.h"
 
+#include <algorithm>
 #include <chrono>
 #include <cstring>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
+#include <utility>
+#include <vector>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
@@ -58,6 +61,7 @@ MemoryCard::MemoryCard(const std::string& filename, int card_index, u16 size_mbi
   // Class members (including inherited ones) have now been initialized, so
   // it's safe to startup the flush thread (which reads them).
   m_flush_buffer = std::make_unique<u8[]>(m_memory_card_size);
+  m_dirty_blocks.resize((m_memory_card_size + BLOCK_SIZE - 1) / BLOCK_SIZE);
   m_flush_thread = std::thread(&MemoryCard::FlushThread, this);
 }
 
@@ -100,6 +104,8 @@ void MemoryCard::FlushThread()
     // Opening the file is purposefully done each iteration to ensure the
     // file doesn't disappear out from under us after the first check.
     File::IOFile file(m_filename, "r+b");
+    // Only the blocks which changed are written, unless the file must be written anew.
+    bool write_all = !file || file.GetSize() != m_memory_card_size;
 
     if (!file)
     {
@@ -127,11 +133,36 @@ void MemoryCard::FlushThread()
       return;
     }
 
+    // Ranges of blocks to write, copied at once so that they are consistent with each other.
+    std::vector<std::pair<u32, u32>> ranges;
     {
       std::unique_lock<std::mutex> l(m_flush_mutex);
-      memcpy(&m_flush_buffer[0], &m_memcard_data[0], m_memory_card_size);
+      const u32 num_blocks = static_cast<u32>(m_dirty_blocks.size());
+      u32 first = 0;
+      while (first < num_blocks)
+      {
+        if (!write_all && !m_dirty_blocks[first])
+        {
+          ++first;
+          continue;
+        }
+
+        u32 end = first + 1;
+        while (end < num_blocks && (write_all || m_dirty_blocks[end]))
+          ++end;
+        const u32 offset = first * BLOCK_SIZE;
+        const u32 size = std::min(end * BLOCK_SIZE, m_memory_card_size) - offset;
+        memcpy(&m_flush_buffer[offset], &m_memcard_data[offset], size);
+        ranges.emplace_back(offset, size);
+        first = end;
+      }
+      m_dirty_blocks.assign(num_blocks, false);
+    }
+    for (const auto& range : ranges)
+    {
+      file.Seek(range.first, SEEK_SET);
+      file.WriteBytes(&m_flush_buffer[range.first], range.second);
     }
-    file.WriteBytes(&m_flush_buffer[0], m_memory_card_size);
 
     if (!do_exit)
     {
@@ -175,11 +206,23 @@ s32 MemoryCard::Write(u32 dest_address, s32 length, const u8* src_address)
   {
     std::unique_lock<std::mutex> l(m_flush_mutex);
     memcpy(&m_memcard_data[dest_address], src_address, length);
+    MarkDirty(dest_address, length);
   }
   MakeDirty();
   return length;
 }
 
+void MemoryCard::MarkDirty(u32 address, u32 length)
+{
+  if (length == 0)
+    return;
+
+  const u32 last_block = std::min<u32>((address + length - 1) / BLOCK_SIZE,
+                                       static_cast<u32>(m_dirty_blocks.size()) - 1);
+  for (u32 block = address / BLOCK_SIZE; block <= last_block; ++block)
+    m_dirty_blocks[block] = true;
+}
+
 void MemoryCard::ClearBlock(u32 address)
 {
   if (address & (BLOCK_SIZE - 1) || !IsAddressInBounds(address))
@@ -191,6 +234,7 @@ void MemoryCard::ClearBlock(u32 address)
   {
     std::unique_lock<std::mutex> l(m_flush_mutex);
     memset(&m_memcard_data[address], 0xFF, BLOCK_SIZE);
+    MarkDirty(address, BLOCK_SIZE);
   }
   MakeDirty();
 }
@@ -200,6 +244,7 @@ void MemoryCard::ClearAll()
   {
     std::unique_lock<std::mutex> l(m_flush_mutex);
     memset(&m_memcard_data[0], 0xFF, m_memory_card_size);
+    m_dirty_blocks.assign(m_dirty_blocks.size(), true);
   }
   MakeDirty();
 }
@@ -209,4 +254,11 @@ void MemoryCard::DoState(PointerWrap& p)
   p.Do(m_card_index);
   p.Do(m_memory_card_size);
   p.DoArray(&m_memcard_data[0], m_memory_card_size);
+
+  // The whole card may differ from the file now, as the full image used to be written.
+  if (p.GetMode() == PointerWrap::MODE_READ)
+  {
+    std::unique_lock<std::mutex> l(m_flush_mutex);
+    m_dirty_blocks.assign(m_dirty_blocks.size(), true);
+  }
 }
@@ -10,15 +10,21 @@
 #include "Core/HW/Memmap.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstring>
 #include <memory>
+#include <vector>
 
+#include "Common/Align.h"
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
 #include "Common/Logging/Log.h"
 #include "Common/MemArena.h"
+#include "Common/MemoryUtil.h"
 #include "Common/Swap.h"
 #include "Core/ARBruteForcer.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/HW/AudioInterface.h"
@@ -47,6 +53,8 @@ u8* logical_base = nullptr;
 
 // The MemArena class
 static MemArena g_arena;
+// Whether the views of RAM ask for huge pages, see Common::AdviseHugePages.
+static bool s_huge_pages = false;
 // ==============
 
 // STATE_TO_SAVE
@@ -115,6 +123,7 @@ struct LogicalMemoryView
 {
   void* mapped_pointer;
   u32 mapped_size;
+  u32 shm_position;
 };
 
 // Dolphin allocates memory to represent four regions:
@@ -166,6 +175,32 @@ static PhysicalMemoryRegion physical_regions[] = {
 
 static std::vector<LogicalMemoryView> logical_mapped_entries;
 
+// Dirty page tracking state. Pages are indexed by their position in the shared memory segment, so
+// that all views of a page share one entry. A protected page stores the value of s_write_counter
+// from when it was protected, which is later than any write to it. The counter is never reset, so
+// that tokens handed out before tracking was disabled are still older than every page.
+static constexpr u64 PAGE_UNPROTECTED = UINT64_MAX;
+static bool s_dirty_tracking = false;
+static size_t s_dirty_page_size = 0;
+static std::vector<u64> s_page_stamps;
+static u64 s_write_counter = 0;
+static u64 s_clear_token = 0;  // for IsDirty and ClearDirtyPages
+// Faults can come from any thread that touches emulated memory (e.g. the GPU thread writing EFB
+// copies), and the fault handler can't safely block, so this is a spin lock.
+static std::atomic_flag s_dirty_lock = ATOMIC_FLAG_INIT;
+
+class DirtyLockGuard
+{
+public:
+  DirtyLockGuard()
+  {
+    while (s_dirty_lock.test_and_set(std::memory_order_acquire))
+    {
+    }
+  }
+  ~DirtyLockGuard() { s_dirty_lock.clear(std::memory_order_release); }
+};
+
 void Init()
 {
   bool wii = SConfig::GetInstance().bWii;
@@ -183,11 +218,16 @@ void Init()
     flags |= PhysicalMemoryRegion::WII_ONLY;
   if (bFakeVMEM)
     flags |= PhysicalMemoryRegion::FAKE_VMEM;
+  // A huge page can only back a view when the view and its offset in the shared memory segment
+  // are both aligned to the huge page size.
+  s_huge_pages = Config::Get(Config::MAIN_HUGE_PAGES);
   u32 mem_size = 0;
   for (PhysicalMemoryRegion& region : physical_regions)
   {
     if ((flags & region.flags) != region.flags)
       continue;
+    if (s_huge_pages)
+      mem_size = Common::AlignUp(mem_size, Common::HUGE_PAGE_SIZE);
     region.shm_position = mem_size;
     mem_size += region.size;
   }
@@ -207,6 +247,8 @@ void Init()
       PanicAlert("MemoryMap_Setup: Failed finding a memory base.");
       exit(0);
     }
+    if (s_huge_pages)
+      Common::AdviseHugePages(*region.out_pointer, region.size);
   }
 
 #ifndef _ARCH_32
@@ -224,8 +266,44 @@ void Init()
   m_IsInitialized = true;
 }
 
+static void SetViewProtection(u8* view, u32 view_shm_position, u32 view_size, u32 position,
+                              u32 size, bool write_protect)
+{
+  const u32 start = std::max(position, view_shm_position);
+  const u32 end = std::min(position + size, view_shm_position + view_size);
+  if (start >= end)
+    return;
+
+  u8* const pointer = view + (start - view_shm_position);
+  if (write_protect)
+    Common::WriteProtectMemory(pointer, end - start);
+  else
+    Common::UnWriteProtectMemory(pointer, end - start);
+}
+
+// Changes the protection of a range of the shared memory segment in every view of it.
+static void SetSHMProtection(u32 position, u32 size, bool write_protect)
+{
+  for (const PhysicalMemoryRegion& region : physical_regions)
+  {
+    if (*region.out_pointer)
+    {
+      SetViewProtection(*region.out_pointer, region.shm_position, region.size, position, size,
+                        write_protect);
+    }
+  }
+  for (const LogicalMemoryView& entry : logical_mapped_entries)
+  {
+    SetViewProtection(static_cast<u8*>(entry.mapped_pointer), entry.shm_position,
+                      entry.mapped_size, position, size, write_protect);
+  }
+}
+
 void UpdateLogicalMemory(const PowerPC::BatTable& dbat_table)
 {
+  // The fault handler walks the views.
+  DirtyLockGuard lock;
+
   for (auto& entry : logical_mapped_entries)
   {
     g_arena.ReleaseView(entry.mapped_pointer, entry.mapped_size);
@@ -236,21 +314,34 @@ void UpdateLogicalMemory(const PowerPC::BatTable& dbat_table)
     if (dbat_table[i] & PowerPC::BAT_PHYSICAL_BIT)
     {
       u32 logical_address = i << PowerPC::BAT_INDEX_SHIFT;
-      // TODO: Merge adjacent mappings to make this faster.
-      u32 logical_size = PowerPC::BAT_PAGE_SIZE;
       u32 translated_address = dbat_table[i] & PowerPC::BAT_RESULT_MASK;
+
+      // Map the following pages which map to the following physical pages with the same view,
+      // which turns the thousands of pages of the usual BATs into a handful of views.
+      u32 num_pages = 1;
+      while (i + num_pages < dbat_table.size() &&
+             (dbat_table[i + num_pages] & PowerPC::BAT_PHYSICAL_BIT) &&
+             (dbat_table[i + num_pages] & PowerPC::BAT_RESULT_MASK) ==
+                 translated_address + num_pages * PowerPC::BAT_PAGE_SIZE)
+      {
+        num_pages++;
+      }
+      i += num_pages - 1;
+
+      u64 logical_size = static_cast<u64>(num_pages) * PowerPC::BAT_PAGE_SIZE;
       for (const auto& physical_region : physical_regions)
       {
-        u32 mapping_address = physical_region.physical_address;
-        u32 mapping_end = mapping_address + physical_region.size;
-        u32 intersection_start = std::max(mapping_address, translated_address);
-        u32 intersection_end = std::min(mapping_end, translated_address + logical_size);
+        u64 mapping_address = physical_region.physical_address;
+        u64 mapping_end = mapping_address + physical_region.size;
+        u64 intersection_start = std::max<u64>(mapping_address, translated_address);
+        u64 intersection_end = std::min<u64>(mapping_end, translated_address + logical_size);
         if (intersection_start < intersection_end)
         {
           // Found an overlapping region; map it.
-          u32 position = physical_region.shm_position + intersection_start - mapping_address;
-          u8* base = logical_base + logical_address + intersection_start - translated_address;
-          u32 mapped_size = intersection_end - intersection_start;
+          u32 position =
+              static_cast<u32>(physical_region.shm_position + intersection_start - mapping_address);
+          u8* base = logical_base + logical_address + (intersection_start - translated_address);
+          u32 mapped_size = static_cast<u32>(intersection_end - intersection_start);
 
           void* mapped_pointer = g_arena.CreateView(position, mapped_size, base);
           if (!mapped_pointer)
@@ -258,13 +349,222 @@ void UpdateLogicalMemory(const PowerPC::BatTable& dbat_table)
             PanicAlert("MemoryMap_Setup: Failed finding a memory base.");
             exit(0);
           }
-          logical_mapped_entries.push_back({mapped_pointer, mapped_size});
+          logical_mapped_entries.push_back({mapped_pointer, mapped_size, position});
+          if (s_huge_pages)
+            Common::AdviseHugePages(mapped_pointer, mapped_size);
+
+          // New views start out writable, so the clean pages have to be protected in them.
+          if (s_dirty_tracking)
+          {
+            for (u32 page = position; page < position + mapped_size; page += s_dirty_page_size)
+            {
+              if (s_page_stamps[page / s_dirty_page_size] != PAGE_UNPROTECTED)
+              {
+                SetViewProtection(static_cast<u8*>(mapped_pointer), position, mapped_size, page,
+                                  static_cast<u32>(s_dirty_page_size), true);
+              }
+            }
+          }
         }
       }
     }
   }
 }
 
+static u32 GetSHMSize()
+{
+  u32 size = 0;
+  for (const PhysicalMemoryRegion& region : physical_regions)
+  {
+    if (*region.out_pointer)
+      size = std::max(size, region.shm_position + region.size);
+  }
+  return size;
+}
+
+bool EnableDirtyPageTracking(bool enable)
+{
+#if defined(__APPLE__) || defined(_M_GENERIC)
+  // The Mach exception port only covers the CPU thread, and generic builds have no fault handler.
+  if (enable)
+    return false;
+#else
+  if (enable && !SConfig::GetInstance().bFastmem)
+    return false;
+#endif
+
+  DirtyLockGuard lock;
+  if (enable == s_dirty_tracking)
+    return true;
+
+  const u32 shm_size = GetSHMSize();
+  if (enable)
+  {
+    s_dirty_page_size = Common::PageSize();
+    s_clear_token = ++s_write_counter;
+    s_page_stamps.assign((shm_size + s_dirty_page_size - 1) / s_dirty_page_size, s_clear_token);
+    SetSHMProtection(0, shm_size, true);
+  }
+  else
+  {
+    SetSHMProtection(0, shm_size, false);
+    std::vector<u64>().swap(s_page_stamps);
+  }
+  s_dirty_tracking = enable;
+  return true;
+}
+
+bool IsDirtyPageTrackingEnabled()
+{
+  return s_dirty_tracking;
+}
+
+size_t GetDirtyPageSize()
+{
+  return s_dirty_page_size;
+}
+
+// Translates a physical range to the pages of the shared memory segment it covers.
+static bool GetPageRange(u32 address, u32 size, size_t* first_page, size_t* end_page)
+{
+  for (const PhysicalMemoryRegion& region : physical_regions)
+  {
+    if (!*region.out_pointer || address < region.physical_address ||
+        address - region.physical_address >= region.size)
+    {
+      continue;
+    }
+
+    const u32 start = region.shm_position + (address - region.physical_address);
+    const u32 end = start + std::min(size, region.size - (address - region.physical_address));
+    *first_page = start / s_dirty_page_size;
+    *end_page = (end + s_dirty_page_size - 1) / s_dirty_page_size;
+    return true;
+  }
+
+  // Not backed by memory that is tracked.
+  return false;
+}
+
+bool IsDirty(u32 address, u32 size)
+{
+  return IsModifiedSince(address, size, s_clear_token);
+}
+
+void ClearDirtyPages()
+{
+  DirtyLockGuard lock;
+  if (!s_dirty_tracking)
+    return;
+
+  const u64 stamp = ++s_write_counter;
+  for (u64& page_stamp : s_page_stamps)
+  {
+    if (page_stamp == PAGE_UNPROTECTED)
+      page_stamp = stamp;
+  }
+  s_clear_token = stamp;
+  SetSHMProtection(0, GetSHMSize(), true);
+}
+
+u64 ProtectRange(u32 address, u32 size)
+{
+  DirtyLockGuard lock;
+  size_t first_page, end_page;
+  if (!s_dirty_tracking || size == 0 || !GetPageRange(address, size, &first_page, &end_page))
+    return 0;
+
+  const u64 stamp = ++s_write_counter;
+  size_t run_start = end_page;
+  for (size_t page = first_page; page <= end_page; page++)
+  {
+    // Protect runs of unprotected pages at once, to keep the number of calls down.
+    if (page != end_page && s_page_stamps[page] == PAGE_UNPROTECTED)
+    {
+      s_page_stamps[page] = stamp;
+      if (run_start == end_page)
+        run_start = page;
+    }
+    else if (run_start != end_page)
+    {
+      SetSHMProtection(static_cast<u32>(run_start * s_dirty_page_size),
+                       static_cast<u32>((page - run_start) * s_dirty_page_size), true);
+      run_start = end_page;
+    }
+  }
+  return stamp;
+}
+
+void UnprotectRange(u32 address, u32 size)
+{
+  DirtyLockGuard lock;
+  size_t first_page, end_page;
+  if (!s_dirty_tracking || size == 0 || !GetPageRange(address, size, &first_page, &end_page))
+    return;
+
+  std::fill(s_page_stamps.begin() + first_page, s_page_stamps.begin() + end_page,
+            PAGE_UNPROTECTED);
+  SetSHMProtection(static_cast<u32>(first_page * s_dirty_page_size),
+                   static_cast<u32>((end_page - first_page) * s_dirty_page_size), false);
+}
+
+bool IsModifiedSince(u32 address, u32 size, u64 token)
+{
+  DirtyLockGuard lock;
+  size_t first_page, end_page;
+  if (!s_dirty_tracking || token == 0 || !GetPageRange(address, size, &first_page, &end_page))
+    return true;
+
+  for (size_t page = first_page; page < end_page; page++)
+  {
+    if (s_page_stamps[page] > token)
+      return true;
+  }
+  return false;
+}
+
+bool HandleDirtyPageFault(uintptr_t fault_address)
+{
+  if (!s_dirty_tracking)
+    return false;
+
+  DirtyLockGuard lock;
+  u32 position = 0;
+  bool found = false;
+  for (const PhysicalMemoryRegion& region : physical_regions)
+  {
+    const uintptr_t base = reinterpret_cast<uintptr_t>(*region.out_pointer);
+    if (base && fault_address >= base && fault_address - base < region.size)
+    {
+      position = region.shm_position + static_cast<u32>(fault_address - base);
+      found = true;
+      break;
+    }
+  }
+  for (auto entry = logical_mapped_entries.begin(); !found && entry != logical_mapped_entries.end();
+       ++entry)
+  {
+    const uintptr_t base = reinterpret_cast<uintptr_t>(entry->mapped_pointer);
+    if (fault_address >= base && fault_address - base < entry->mapped_size)
+    {
+      position = entry->shm_position + static_cast<u32>(fault_address - base);
+      found = true;
+    }
+  }
+  if (!found)
+    return false;
+
+  const size_t page = position / s_dirty_page_size;
+  // Another thread may have unprotected the page since this one faulted.
+  if (s_page_stamps[page] != PAGE_UNPROTECTED)
+  {
+    s_page_stamps[page] = PAGE_UNPROTECTED;
+    SetSHMProtection(static_cast<u32>(page * s_dirty_page_size),
+                     static_cast<u32>(s_dirty_page_size), false);
+  }
+  return true;
+}
+
 void DoState(PointerWrap& p)
 {
   bool wii = SConfig::GetInstance().bWii;
@@ -281,6 +581,7 @@ void DoState(PointerWrap& p)
 
 void Shutdown()
 {
+  EnableDirtyPageTracking(false);
   m_IsInitialized = false;
   u32 flags = 0;
   if (SConfig::GetInstance().bWii)
@@ -318,7 +619,7 @@ void Clear()
     memset(m_pEXRAM, 0, EXRAM_SIZE);
 }
 
-static inline u8* GetPointerForRange(u32 address, size_t size)
+u8* GetPointerForRange(u32 address, size_t size)
 {
   // Make sure we don't have a range spanning 2 separate banks
   if (size >= EXRAM_SIZE)
@@ -68,10 +68,38 @@ void UpdateLogicalMemory(const PowerPC::BatTable& dbat_table);
 
 void Clear();
 
+// Dirty page tracking. While it is enabled, every clean page of emulated memory is write protected
+// in all of its views, and the first write to it (from any thread) goes through the fault handler,
+// which marks the page as dirty and unprotects it. This lets users such as incremental savestates
+// only look at the memory that changed since the last ClearDirtyPages.
+// Needs the fault handler in MemTools, so it can only be enabled when fastmem is.
+bool EnableDirtyPageTracking(bool enable);
+bool IsDirtyPageTrackingEnabled();
+size_t GetDirtyPageSize();
+// Returns whether any page in the given physical range was written to. Always true when tracking
+// is disabled.
+bool IsDirty(u32 address, u32 size);
+// Marks every page as clean again and write protects it.
+void ClearDirtyPages();
+// Write protects the pages of a physical range which aren't yet, without affecting other users of
+// the tracking. Returns a token for IsModifiedSince, or 0 if the range can't be tracked. Users who
+// only care about a few ranges (like the texture cache) can use this instead of ClearDirtyPages,
+// and leave all other pages unprotected once they have been written to.
+u64 ProtectRange(u32 address, u32 size);
+// Returns whether the range may have been written to since ProtectRange returned token.
+bool IsModifiedSince(u32 address, u32 size, u64 token);
+// Marks a range as written and unprotects it. Has to be called before the kernel writes into
+// emulated memory (e.g. fread into a RAM pointer), as that fails instead of faulting.
+void UnprotectRange(u32 address, u32 size);
+// Called by the fault handler. Returns true if the fault was caused by dirty page tracking.
+bool HandleDirtyPageFault(uintptr_t fault_address);
+
 // Routines to access physically addressed memory, designed for use by
 // emulated hardware outside the CPU. Use "Device_" prefix.
 std::string GetString(u32 em_address, size_t size = 0);
 u8* GetPointer(u32 address);
+// Returns nullptr if the range is invalid or spans two banks of memory.
+u8* GetPointerForRange(u32 address, size_t size);
 void CopyFromEmu(void* data, u32 address, size_t size);
 void CopyToEmu(u32 address, const void* data, size_t size);
 void Memset(u32 address, u8 value, size_t size);
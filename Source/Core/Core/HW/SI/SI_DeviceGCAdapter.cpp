@@ -7,6 +7,7 @@
 #include <cstring>
 
 #include "Common/CommonTypes.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/HW/GCPad.h"
@@ -22,6 +23,7 @@ CSIDevice_GCAdapter::CSIDevice_GCAdapter(SIDevices device, int device_number)
   const int pad_num = NetPlay_InGamePadToLocalPad(m_device_number);
   if (pad_num < 4)
     m_simulate_konga = SConfig::GetInstance().m_AdapterKonga[pad_num];
+  m_align_polls = Config::Get(Config::MAIN_ADAPTER_ALIGN_POLLS);
 }
 
 GCPadStatus CSIDevice_GCAdapter::GetPadStatus()
@@ -32,6 +34,8 @@ GCPadStatus CSIDevice_GCAdapter::GetPadStatus()
   // the remote controllers receive their status there as well
   if (!NetPlay::IsNetPlayRunning())
   {
+    if (m_align_polls)
+      GCAdapter::WaitForNextPayload();
     pad_status = GCAdapter::Input(m_device_number);
   }
 
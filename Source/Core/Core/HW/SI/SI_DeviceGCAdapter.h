@@ -17,5 +17,9 @@ public:
 
   GCPadStatus GetPadStatus() override;
   int RunBuffer(u8* buffer, int length) override;
+
+private:
+  // Whether to wait for the adapter's next payload when it is about to arrive.
+  bool m_align_polls;
 };
 }  // namespace SerialInterface
@@ -162,12 +162,28 @@ GCPadStatus CSIDevice_GCController::GetPadStatus()
 // [00?SYXBA] [1LRZUDRL] [x] [y] [cx] [cy] [l] [r]
 //  |\_ ERR_LATCH (error latched - check SISR)
 //  |_ ERR_STATUS (error on last GetData or SendCmd?)
+static bool IsSamePadStatus(const GCPadStatus& a, const GCPadStatus& b)
+{
+  return a.button == b.button && a.stickX == b.stickX && a.stickY == b.stickY &&
+         a.substickX == b.substickX && a.substickY == b.substickY &&
+         a.triggerLeft == b.triggerLeft && a.triggerRight == b.triggerRight &&
+         a.analogA == b.analogA && a.analogB == b.analogB && a.err == b.err;
+}
+
 bool CSIDevice_GCController::GetData(u32& hi, u32& low)
 {
   GCPadStatus pad_status = GetPadStatus();
   if (HandleButtonCombos(pad_status) == COMBO_ORIGIN)
     pad_status.button |= PAD_GET_ORIGIN;
 
+  if (m_encoded_data_valid && m_encoded_data.mode == m_mode &&
+      IsSamePadStatus(m_encoded_data.pad_status, pad_status))
+  {
+    hi = m_encoded_data.hi;
+    low = m_encoded_data.low;
+    return true;
+  }
+
   hi = MapPadStatus(pad_status);
 
   // Low bits are packed differently per mode
@@ -221,6 +237,8 @@ bool CSIDevice_GCController::GetData(u32& hi, u32& low)
   if (m_simulate_konga)
     hi &= ~0x20FFFFFF;
 
+  m_encoded_data = {pad_status, m_mode, hi, low};
+  m_encoded_data_valid = true;
   return true;
 }
 
@@ -86,6 +86,18 @@ protected:
   // Set this if we want to simulate the "TaruKonga" DK Bongo controller
   bool m_simulate_konga = false;
 
+  // Last response of GetData, with what it was encoded from. Games poll many times for each
+  // change of the input, so the response is only encoded again when one of these changed.
+  struct EncodedData
+  {
+    GCPadStatus pad_status;
+    u8 mode;
+    u32 hi;
+    u32 low;
+  };
+  EncodedData m_encoded_data{};
+  bool m_encoded_data_valid = false;
+
 public:
   // Constructor
   CSIDevice_GCController(SIDevices device, int device_number);
@@ -45,13 +45,16 @@ IPC_HLE_PERIOD: For the Wii Remote this is the call schedule:
 
 #include "Core/HW/SystemTimers.h"
 
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
 #include <cmath>
 #include <cstdlib>
+#include <thread>
 
 #include "Common/Atomic.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
-#include "Common/Thread.h"
 #include "Common/Timer.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
@@ -95,6 +98,8 @@ static int s_audio_dma_period;
 // we can just increase this number.
 static int s_ipc_hle_period;
 
+static std::atomic<u64> s_throttle_sleep_us{0};
+
 // Custom RTC
 static s64 s_localtime_rtc_offset = 0;
 
@@ -186,6 +191,11 @@ s64 GetLocalTimeRTCOffset()
   return s_localtime_rtc_offset;
 }
 
+u64 GetThrottleSleepTimeUs()
+{
+  return s_throttle_sleep_us.load(std::memory_order_relaxed);
+}
+
 static void PatchEngineCallback(u64 userdata, s64 cycles_late)
 {
   // We have 2 periods, a 1000 cycle error period and the VI period.
@@ -216,9 +226,12 @@ static void ThrottleCallback(u64 last_time, s64 cyclesLate)
   // Allow the GPU thread to sleep. Setting this flag here limits the wakeups to 1 kHz.
   Fifo::GpuMaySleep();
 
-  u32 time = Common::Timer::GetTimeMs();
+  // The times are in microseconds, so that the sleeps don't round every millisecond of emulated
+  // time to a whole host millisecond. Frames then reach the renderer at even intervals, which
+  // matters for the frame pacer and for variable refresh rate displays.
+  const u64 time = Common::Timer::GetTimeUs();
 
-  int diff = (u32)last_time - time;
+  const s64 diff = static_cast<s64>(last_time - time);
   const SConfig& config = SConfig::GetInstance();
   bool frame_limiter = config.m_EmulationSpeed > 0.0f && !Core::GetIsThrottlerTempDisabled();
   u32 next_event = GetTicksPerSecond() / 1000;
@@ -226,17 +239,20 @@ static void ThrottleCallback(u64 last_time, s64 cyclesLate)
   {
     if (config.m_EmulationSpeed != 1.0f)
       next_event = u32(next_event * config.m_EmulationSpeed);
-    const int max_fallback = config.iTimingVariance;
-    if (abs(diff) > max_fallback)
+    const s64 max_fallback = static_cast<s64>(config.iTimingVariance) * 1000;
+    if (std::abs(diff) > max_fallback)
     {
-      DEBUG_LOG(COMMON, "system too %s, %d ms skipped", diff < 0 ? "slow" : "fast",
-                abs(diff) - max_fallback);
+      DEBUG_LOG(COMMON, "system too %s, %" PRId64 " us skipped", diff < 0 ? "slow" : "fast",
+                std::abs(diff) - max_fallback);
       last_time = time - max_fallback;
     }
     else if (diff > 0)
-      Common::SleepCurrentThread(diff);
+    {
+      std::this_thread::sleep_for(std::chrono::microseconds(diff));
+      s_throttle_sleep_us.fetch_add(Common::Timer::GetTimeUs() - time, std::memory_order_relaxed);
+    }
   }
-  CoreTiming::ScheduleEvent(next_event - cyclesLate, et_Throttle, last_time + 1);
+  CoreTiming::ScheduleEvent(next_event - cyclesLate, et_Throttle, last_time + 1000);
 }
 
 // split from Init to break a circular dependency between VideoInterface::Init and
@@ -299,7 +315,7 @@ void Init()
   CoreTiming::ScheduleEvent(VideoInterface::GetTicksPerHalfLine(), et_VI);
   CoreTiming::ScheduleEvent(0, et_DSP);
   CoreTiming::ScheduleEvent(s_audio_dma_period, et_AudioDMA);
-  CoreTiming::ScheduleEvent(0, et_Throttle, Common::Timer::GetTimeMs());
+  CoreTiming::ScheduleEvent(0, et_Throttle, Common::Timer::GetTimeUs());
 
   CoreTiming::ScheduleEvent(VideoInterface::GetTicksPerField(), et_PatchEngine);
 
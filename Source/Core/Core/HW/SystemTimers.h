@@ -53,4 +53,8 @@ void TimeBaseSet();
 u64 GetFakeTimeBase();
 // Custom RTC
 s64 GetLocalTimeRTCOffset();
+
+// The total time the CPU thread has slept to limit the emulation speed, in microseconds. The time
+// it was busy, which frontends can report to the OS as a performance hint, is what's left.
+u64 GetThrottleSleepTimeUs();
 }
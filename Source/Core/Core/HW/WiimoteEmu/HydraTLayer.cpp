@@ -58,7 +58,8 @@ void GetAcceleration(int index, bool sideways, bool has_extension,
     // more than 60 degrees
     // because the Wii doesn't return IR results when pitching up or down 60 degrees or more.
     // We need to force it to return IR results by pretending it is only pitched 59 degrees.
-    if (g_vr_has_ir && g_vr_ir_x > -1 && g_vr_ir_x < 1 && g_vr_ir_y > -1 && g_vr_ir_y < 1)
+    float ir_x, ir_y, ir_z;
+    if (VR_GetIRPointer(&ir_x, &ir_y, &ir_z) && ir_x > -1 && ir_x < 1 && ir_y > -1 && ir_y < 1)
     {
       float pitch = RADIANS_TO_DEGREES(asin(-y));
       float roll = atan2(z, x);
@@ -2,7 +2,8 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
-#include <memory>
+#include <algorithm>
+#include <array>
 
 #include "AudioCommon/AudioCommon.h"
 #include "Common/CommonTypes.h"
@@ -48,13 +49,28 @@ static s32 av_clip(s32 a, s32 amin, s32 amax)
     return a;
 }
 
-static s16 adpcm_yamaha_expand_nibble(ADPCMState& s, u8 nibble)
+static s16 adpcm_yamaha_expand_nibble(s32& predictor, s32& step, u8 nibble)
 {
-  s.predictor += (s.step * yamaha_difflookup[nibble]) / 8;
-  s.predictor = av_clip16(s.predictor);
-  s.step = (s.step * yamaha_indexscale[nibble]) >> 8;
-  s.step = av_clip(s.step, 127, 24576);
-  return s.predictor;
+  predictor += (step * yamaha_difflookup[nibble]) / 8;
+  predictor = av_clip16(predictor);
+  step = (step * yamaha_indexscale[nibble]) >> 8;
+  step = av_clip(step, 127, 24576);
+  return predictor;
+}
+
+// Decodes a whole speaker report at once, with the decoder state kept in locals. Every sample
+// depends on the previous one, so this can't be split across SIMD lanes.
+static void adpcm_yamaha_decode(ADPCMState& s, const u8* data, u32 size, s16* samples)
+{
+  s32 predictor = s.predictor;
+  s32 step = s.step;
+  for (u32 i = 0; i < size; ++i)
+  {
+    samples[i * 2] = adpcm_yamaha_expand_nibble(predictor, step, data[i] >> 4);
+    samples[i * 2 + 1] = adpcm_yamaha_expand_nibble(predictor, step, data[i] & 0xf);
+  }
+  s.predictor = predictor;
+  s.step = step;
 }
 
 #ifdef WIIMOTE_SPEAKER_DUMP
@@ -75,8 +91,8 @@ void Wiimote::SpeakerData(const wm_speaker_data* sd)
   if (m_reg_speaker.volume == 0 || m_reg_speaker.sample_rate == 0 || sd->length == 0)
     return;
 
-  // TODO consider using static max size instead of new
-  std::unique_ptr<s16[]> samples(new s16[sd->length * 2]);
+  std::array<s16, sizeof(sd->data) * 2> samples;
+  const u32 length = std::min<u32>(sd->length, sizeof(sd->data));
 
   unsigned int sample_rate_dividend, sample_length;
   u8 volume_divisor;
@@ -84,7 +100,7 @@ void Wiimote::SpeakerData(const wm_speaker_data* sd)
   if (m_reg_speaker.format == 0x40)
   {
     // 8 bit PCM
-    for (int i = 0; i < sd->length; ++i)
+    for (u32 i = 0; i < length; ++i)
     {
       samples[i] = ((s16)(s8)sd->data[i]) << 8;
     }
@@ -92,16 +108,12 @@ void Wiimote::SpeakerData(const wm_speaker_data* sd)
     // Following details from http://wiibrew.org/wiki/Wiimote#Speaker
     sample_rate_dividend = 12000000;
     volume_divisor = 0xff;
-    sample_length = (unsigned int)sd->length;
+    sample_length = length;
   }
   else if (m_reg_speaker.format == 0x00)
   {
     // 4 bit Yamaha ADPCM (same as dreamcast)
-    for (int i = 0; i < sd->length; ++i)
-    {
-      samples[i * 2] = adpcm_yamaha_expand_nibble(m_adpcm_state, (sd->data[i] >> 4) & 0xf);
-      samples[i * 2 + 1] = adpcm_yamaha_expand_nibble(m_adpcm_state, sd->data[i] & 0xf);
-    }
+    adpcm_yamaha_decode(m_adpcm_state, sd->data, length, samples.data());
 
     // Following details from http://wiibrew.org/wiki/Wiimote#Speaker
     sample_rate_dividend = 6000000;
@@ -109,7 +121,7 @@ void Wiimote::SpeakerData(const wm_speaker_data* sd)
     // 0 - 127
     // TODO: does it go beyond 127 for format == 0x40?
     volume_divisor = 0x7F;
-    sample_length = (unsigned int)sd->length * 2;
+    sample_length = length * 2;
   }
   else
   {
@@ -133,7 +145,7 @@ void Wiimote::SpeakerData(const wm_speaker_data* sd)
   g_sound_stream->GetMixer()->SetWiimoteSpeakerVolume(left_volume, right_volume);
 
   // ADPCM sample rate is thought to be x2.(3000 x2 = 6000).
-  g_sound_stream->GetMixer()->PushWiimoteSpeakerSamples(samples.get(), sample_length,
+  g_sound_stream->GetMixer()->PushWiimoteSpeakerSamples(samples.data(), sample_length,
                                                         sample_rate * 2);
 
 #ifdef WIIMOTE_SPEAKER_DUMP
@@ -147,7 +159,7 @@ void Wiimote::SpeakerData(const wm_speaker_data* sd)
     File::OpenFStream(ofile, "rmtdump.bin", ofile.binary | ofile.out);
     wav.Start("rmtdump.wav", 6000);
   }
-  wav.AddMonoSamples(samples.get(), sd->length * 2);
+  wav.AddMonoSamples(samples.data(), sd->length * 2);
   if (ofile.good())
   {
     for (int i = 0; i < sd->length; i++)
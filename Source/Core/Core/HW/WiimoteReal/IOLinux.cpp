@@ -242,7 +242,8 @@ int WiimoteLinux::IORead(u8* buf)
     {
       ERROR_LOG(WIIMOTE, "Unable to read from wakeup pipe.");
     }
-    return -1;
+    // Still read a pending input report, otherwise a steady stream of writes (speaker data)
+    // would keep the input reports from ever being read.
   }
 
   if (!FD_ISSET(m_int_sock, &fds))
@@ -59,6 +59,7 @@ void Wiimote::Shutdown()
   StopThread();
   ClearReadQueue();
   m_write_reports.Clear();
+  m_write_batch.clear();
 }
 
 // to be called from CPU thread
@@ -224,28 +225,59 @@ void Wiimote::Read()
   }
 }
 
-bool Wiimote::Write()
+// Output reports which only set a state of the Wiimote, without asking for an acknowledgement,
+// so that a later report of the same type makes them redundant.
+static bool IsStateReport(const Report& rpt)
 {
-  // nothing written, but this is not an error
-  if (m_write_reports.Empty())
-    return true;
-
-  Report const& rpt = m_write_reports.Front();
+  if (rpt.size() < 3 || (rpt[2] & 0x2) != 0)
+    return false;
+  return rpt[1] == RT_RUMBLE || rpt[1] == RT_LEDS || rpt[1] == RT_REPORT_MODE;
+}
 
-  if (SConfig::GetInstance().iBBDumpPort > 0 && m_index == WIIMOTE_BALANCE_BOARD)
+bool Wiimote::Write()
+{
+  // Take all the reports queued since the last write, dropping the state reports which were
+  // overwritten before they could be sent.
+  Report queued;
+  while (m_write_reports.Pop(queued))
   {
-    static sf::UdpSocket Socket;
-    Socket.send((char*)rpt.data(), rpt.size(), sf::IpAddress::LocalHost,
-                SConfig::GetInstance().iBBDumpPort);
+    if (IsStateReport(queued))
+    {
+      auto superseded =
+          std::find_if(m_write_batch.begin(), m_write_batch.end(), [&queued](const Report& rpt) {
+            return rpt[1] == queued[1] && IsStateReport(rpt);
+          });
+      if (superseded != m_write_batch.end())
+        m_write_batch.erase(superseded);
+    }
+    m_write_batch.push_back(std::move(queued));
   }
-  int ret = IOWrite(rpt.data(), rpt.size());
 
-  m_write_reports.Pop();
+  // Send everything up to and including the next speaker data report. Games stream speaker data
+  // as fast as the Wiimote takes it, so the input reports must get read in between.
+  while (!m_write_batch.empty())
+  {
+    const Report& rpt = m_write_batch.front();
+
+    if (SConfig::GetInstance().iBBDumpPort > 0 && m_index == WIIMOTE_BALANCE_BOARD)
+    {
+      static sf::UdpSocket Socket;
+      Socket.send((char*)rpt.data(), rpt.size(), sf::IpAddress::LocalHost,
+                  SConfig::GetInstance().iBBDumpPort);
+    }
+    if (IOWrite(rpt.data(), rpt.size()) == 0)
+      return false;
+
+    const bool speaker_data = rpt.size() >= 2 && rpt[1] == RT_WRITE_SPEAKER_DATA;
+    m_write_batch.pop_front();
+    if (speaker_data)
+      break;
+  }
 
-  if (!m_write_reports.Empty())
+  if (!m_write_batch.empty())
     IOWakeup();
 
-  return ret != 0;
+  return true;
 }
 
 bool Wiimote::IsBalanceBoard()
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <atomic>
+#include <deque>
 #include <mutex>
 #include <string>
 #include <thread>
@@ -114,6 +115,8 @@ private:
 
   Common::FifoQueue<Report> m_read_reports;
   Common::FifoQueue<Report> m_write_reports;
+  // Reports taken from m_write_reports but not sent yet. Only used by the Wiimote's thread.
+  std::deque<Report> m_write_batch;
 };
 
 class WiimoteScannerBackend
@@ -5,10 +5,15 @@
 // HideObjectEngine
 // Supports the removal of objects/effects from the rendering loop
 
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <utility>
+
 #include "Common/StringUtil.h"
 #include "Core/HideObjectEngine.h"
 #include "Core/ConfigManager.h"
-#include "Core/Core.h"
 
 namespace HideObjectEngine
 {
@@ -18,6 +23,50 @@ std::vector<std::string> HideObjectTypeStrings = {
 
 static std::vector<HideObject> HideObjectCodes;
 
+// The codes applied last. Readers keep their own reference to them, and only take the lock to
+// fetch the new ones when the version changed.
+static std::mutex s_active_codes_lock;
+static std::shared_ptr<const ObjectRemovalCodes> s_active_codes;
+static std::atomic<u32> s_active_codes_version{0};
+
+static constexpr size_t CODE_PREFIX_SIZE = sizeof(u32);
+
+static u32 ReadPrefix(const u8* data)
+{
+  u32 prefix;
+  std::memcpy(&prefix, data, CODE_PREFIX_SIZE);
+  return prefix;
+}
+
+void ObjectRemovalCodes::Add(std::vector<u8> code)
+{
+  if (code.size() < CODE_PREFIX_SIZE)
+    m_short_codes.push_back(std::move(code));
+  else
+    m_codes.emplace(ReadPrefix(code.data()), std::move(code));
+}
+
+bool ObjectRemovalCodes::Matches(const u8* data, size_t size) const
+{
+  for (const std::vector<u8>& code : m_short_codes)
+  {
+    if (code.size() <= size && !std::memcmp(data, code.data(), code.size()))
+      return true;
+  }
+
+  if (size < CODE_PREFIX_SIZE)
+    return false;
+
+  auto range = m_codes.equal_range(ReadPrefix(data));
+  for (auto iter = range.first; iter != range.second; ++iter)
+  {
+    const std::vector<u8>& code = iter->second;
+    if (code.size() <= size && !std::memcmp(data, code.data(), code.size()))
+      return true;
+  }
+  return false;
+}
+
 void LoadHideObjectSection(const std::string& section, std::vector<HideObject>& HideObjectects,
                            IniFile& globalIni, IniFile& localIni)
 {
@@ -112,16 +161,7 @@ void LoadHideObjects()
 
 void ApplyHideObjects(const std::vector<HideObject>& HideObjectects)
 {
-  // Make the rendering code skip over checking skip entries
-  SConfig::GetInstance().hide_objects_updating = true;
-
-  // Wait until the next time the next time the rendering thread finishes checking the skip entries.
-  if (Core::IsRunning())
-    while (SConfig::GetInstance().hide_objects_done == false)
-    {
-    }
-
-  SConfig::GetInstance().object_removal_codes.clear();
+  auto codes = std::make_shared<ObjectRemovalCodes>();
 
   for (const HideObject& HideObjectect : HideObjectects)
   {
@@ -131,7 +171,7 @@ void ApplyHideObjects(const std::vector<HideObject>& HideObjectects)
       {
         u64 value_add_lower = entry.value_lower;
         u64 value_add_upper = entry.value_upper;
-        SkipEntry skipEntry;
+        std::vector<u8> skipEntry;
         int size = GetHideObjectTypeCharLength(entry.type) >> 1;
 
         if (size > 8)
@@ -149,11 +189,31 @@ void ApplyHideObjects(const std::vector<HideObject>& HideObjectects)
           skipEntry.push_back((0xFF & (value_add_lower >> ((j - 1) * 8))));
         }
 
-        SConfig::GetInstance().object_removal_codes.push_back(skipEntry);
+        codes->Add(std::move(skipEntry));
       }
     }
   }
-  SConfig::GetInstance().hide_objects_updating = false;
+
+  // The rendering thread keeps matching against the previous codes until its next draw.
+  std::lock_guard<std::mutex> lk(s_active_codes_lock);
+  s_active_codes = codes->IsEmpty() ? nullptr : std::move(codes);
+  s_active_codes_version++;
+}
+
+bool IsObjectHidden(const u8* data, size_t size)
+{
+  thread_local std::shared_ptr<const ObjectRemovalCodes> codes;
+  thread_local u32 version = 0;
+
+  const u32 active_version = s_active_codes_version.load(std::memory_order_acquire);
+  if (version != active_version)
+  {
+    std::lock_guard<std::mutex> lk(s_active_codes_lock);
+    codes = s_active_codes;
+    version = s_active_codes_version.load(std::memory_order_relaxed);
+  }
+
+  return codes && codes->Matches(data, size);
 }
 
 void ApplyFrameHideObjects()
@@ -4,6 +4,12 @@
 
 #pragma once
 
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
 class IniFile;
 
 namespace HideObjectEngine
@@ -50,6 +56,22 @@ struct HideObject
   bool user_defined;  // False if this code is shipped with Dolphin.
 };
 
+// The bytes of the active codes, indexed by their first four bytes so that vertex data is only
+// compared against the codes sharing its prefix.
+class ObjectRemovalCodes
+{
+public:
+  void Add(std::vector<u8> code);
+  bool IsEmpty() const { return m_codes.empty() && m_short_codes.empty(); }
+  // Returns true if the data starts with one of the codes.
+  bool Matches(const u8* data, size_t size) const;
+
+private:
+  std::unordered_multimap<u32, std::vector<u8>> m_codes;
+  // Codes shorter than a prefix
+  std::vector<std::vector<u8>> m_short_codes;
+};
+
 void LoadHideObjectSection(const std::string& section, std::vector<HideObject>& patches,
                            IniFile& globalIni, IniFile& localIni);
 void LoadHideObjects();
@@ -57,6 +79,10 @@ void ApplyHideObjects(const std::vector<HideObject>& HideObjectects);
 void ApplyFrameHideObjects();
 void Shutdown();
 
+// Returns true if vertex data matches one of the applied codes, and shouldn't be drawn.
+// Cheap when no code changed since the previous call on the same thread.
+bool IsObjectHidden(const u8* data, size_t size);
+
 inline int GetHideObjectTypeCharLength(HideObjectType type)
 {
   return (type + 1) << 1;
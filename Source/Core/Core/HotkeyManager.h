@@ -28,6 +28,7 @@ enum Hotkey
   HK_RESET,
   HK_FULLSCREEN,
   HK_SCREENSHOT,
+  HK_TOGGLE_EVENT_TRACE,
   HK_EXIT,
 
   HK_VOLUME_DOWN,
@@ -149,6 +150,7 @@ enum Hotkey
   HK_UNDO_SAVE_STATE,
   HK_SAVE_STATE_FILE,
   HK_LOAD_STATE_FILE,
+  HK_REWIND,
 
   VR_PERMANENT_CAMERA_FORWARD,
   VR_PERMANENT_CAMERA_BACKWARD,
@@ -198,6 +198,9 @@ public:
   virtual void UpdateWantDeterminism(bool new_want_determinism) {}
   virtual DeviceType GetDeviceType() const { return m_device_type; }
   virtual bool IsOpened() const { return m_is_active; }
+  // Whether the replies of this device must take as long as on hardware. Those of the others may
+  // be sent as soon as the PPC can take them when determinism isn't needed (see ExecuteIPCCommand).
+  virtual bool HasReplyTiming() const { return true; }
   static IPCCommandResult GetDefaultReply(s32 return_value);
   static IPCCommandResult GetNoReply();
 
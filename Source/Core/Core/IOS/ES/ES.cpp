@@ -25,6 +25,7 @@
 #include "Core/ConfigManager.h"
 #include "Core/HW/Memmap.h"
 #include "Core/IOS/ES/Formats.h"
+#include "Core/IOS/FS/FileIO.h"
 #include "Core/IOS/IOSC.h"
 #include "Core/ec_wii.h"
 
@@ -645,6 +646,7 @@ s32 ES::DIVerify(const IOS::ES::TMDReader& tmd, const IOS::ES::TicketReader& tic
     // XXX: We are supposed to verify the TMD and ticket here, but cannot because
     // this may cause issues with custom/patched games.
 
+    NotifyNANDChanged();
     File::IOFile tmd_file(tmd_path, "wb");
     const std::vector<u8>& tmd_bytes = tmd.GetBytes();
     if (!tmd_file.WriteBytes(tmd_bytes.data(), tmd_bytes.size()))
@@ -888,6 +890,43 @@ ReturnCode ES::VerifyContainer(VerifyContainerType type, VerifyMode mode,
   if (!IsIssuerCorrect(type, issuer_cert))
     return ES_EINVAL;
 
+  const auto update_cert_store = [&] {
+    ReturnCode store_ret = WriteNewCertToStore(issuer_cert);
+    if (store_ret != IPC_SUCCESS)
+    {
+      ERROR_LOG(IOS_ES, "VerifyContainer: Writing the issuer cert failed with return code %d",
+                store_ret);
+    }
+
+    store_ret = WriteNewCertToStore(ca_cert);
+    if (store_ret != IPC_SUCCESS)
+    {
+      ERROR_LOG(IOS_ES, "VerifyContainer: Writing the CA cert failed with return code %d",
+                store_ret);
+    }
+    return store_ret;
+  };
+
+  // The same TMDs and tickets get verified on every launch, each time with three RSA operations.
+  // The result only depends on the blob and the certs, unless the blob must also be imported.
+  std::array<u8, 20> container_hash;
+  {
+    mbedtls_sha1_context context;
+    mbedtls_sha1_init(&context);
+    mbedtls_sha1_starts(&context);
+    const u8 type_byte = static_cast<u8>(type);
+    mbedtls_sha1_update(&context, &type_byte, sizeof(type_byte));
+    for (const std::vector<u8>* bytes :
+         {&signed_blob.GetBytes(), &issuer_cert.GetBytes(), &ca_cert.GetBytes()})
+    {
+      mbedtls_sha1_update(&context, bytes->data(), bytes->size());
+    }
+    mbedtls_sha1_finish(&context, container_hash.data());
+    mbedtls_sha1_free(&context);
+  }
+  if (!iosc_handle && m_verified_containers.count(container_hash) != 0)
+    return mode == VerifyMode::UpdateCertStore ? update_cert_store() : IPC_SUCCESS;
+
   // Verify the whole cert chain using IOSC.
   // IOS assumes that the CA cert will always be signed by the root certificate,
   // and that the issuer is signed by the CA.
@@ -926,17 +965,10 @@ ReturnCode ES::VerifyContainer(VerifyContainerType type, VerifyMode mode,
   ret = iosc.VerifyPublicKeySign(sha1, issuer_handle, signature.data(), PID_ES);
   if (ret != IPC_SUCCESS)
     return ret;
+  m_verified_containers.insert(container_hash);
 
   if (mode == VerifyMode::UpdateCertStore)
-  {
-    ret = WriteNewCertToStore(issuer_cert);
-    if (ret != IPC_SUCCESS)
-      ERROR_LOG(IOS_ES, "VerifyContainer: Writing the issuer cert failed with return code %d", ret);
-
-    ret = WriteNewCertToStore(ca_cert);
-    if (ret != IPC_SUCCESS)
-      ERROR_LOG(IOS_ES, "VerifyContainer: Writing the CA cert failed with return code %d", ret);
-  }
+    ret = update_cert_store();
 
   // Import the signed blob to iosc_handle (if a handle was passed to us).
   if (ret == IPC_SUCCESS && iosc_handle)
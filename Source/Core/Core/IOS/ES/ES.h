@@ -6,6 +6,7 @@
 
 #include <array>
 #include <map>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -49,6 +50,7 @@ public:
   ReturnCode Open(const OpenRequest& request) override;
   ReturnCode Close(u32 fd) override;
   IPCCommandResult IOCtlV(const IOCtlVRequest& request) override;
+  bool HasReplyTiming() const override { return false; }
 
   struct TitleImportExportContext
   {
@@ -334,6 +336,8 @@ private:
   // Finish stale imports and clear the import directory.
   void FinishStaleImport(u64 title_id);
   void FinishAllStaleImports();
+  // Drops the cached TMDs and tickets if the NAND changed since they were read.
+  void UpdateTitleCache() const;
 
   std::string GetContentPath(u64 title_id, const IOS::ES::Content& content,
                              const IOS::ES::SharedContentMap& map = IOS::ES::SharedContentMap{
@@ -355,6 +359,14 @@ private:
 
   ContextArray m_contexts;
   TitleContext m_title_context{};
+
+  // The TMDs and tickets of installed titles, as last read from the NAND. They are all dropped
+  // whenever GetNANDChangeCount() no longer matches.
+  mutable std::map<u64, IOS::ES::TMDReader> m_tmd_cache;
+  mutable std::map<u64, IOS::ES::TicketReader> m_ticket_cache;
+  mutable u32 m_title_cache_nand_changes = 0;
+  // SHA1s of the containers (with their issuer and CA certs) for which VerifyContainer succeeded.
+  std::set<std::array<u8, 20>> m_verified_containers;
 };
 }  // namespace Device
 }  // namespace HLE
@@ -20,6 +20,7 @@
 #include "Common/StringUtil.h"
 #include "Core/IOS/ES/ES.h"
 #include "Core/IOS/ES/Formats.h"
+#include "Core/IOS/FS/FileIO.h"
 
 namespace IOS
 {
@@ -45,12 +46,31 @@ IOS::ES::TMDReader ES::FindImportTMD(u64 title_id) const
   return FindTMD(title_id, Common::GetImportTitlePath(title_id) + "/content/title.tmd");
 }
 
+void ES::UpdateTitleCache() const
+{
+  const u32 nand_changes = GetNANDChangeCount();
+  if (nand_changes == m_title_cache_nand_changes)
+    return;
+
+  m_tmd_cache.clear();
+  m_ticket_cache.clear();
+  m_title_cache_nand_changes = nand_changes;
+}
+
 IOS::ES::TMDReader ES::FindInstalledTMD(u64 title_id) const
 {
-  return FindTMD(title_id, Common::GetTMDFileName(title_id, Common::FROM_SESSION_ROOT));
+  UpdateTitleCache();
+  const auto iterator = m_tmd_cache.find(title_id);
+  if (iterator != m_tmd_cache.end())
+    return iterator->second;
+
+  IOS::ES::TMDReader tmd =
+      FindTMD(title_id, Common::GetTMDFileName(title_id, Common::FROM_SESSION_ROOT));
+  m_tmd_cache.emplace(title_id, tmd);
+  return tmd;
 }
 
-IOS::ES::TicketReader ES::FindSignedTicket(u64 title_id) const
+static IOS::ES::TicketReader FindTicket(u64 title_id)
 {
   const std::string path = Common::GetTicketFileName(title_id, Common::FROM_SESSION_ROOT);
   File::IOFile ticket_file(path, "rb");
@@ -64,6 +84,18 @@ IOS::ES::TicketReader ES::FindSignedTicket(u64 title_id) const
   return IOS::ES::TicketReader{std::move(signed_ticket)};
 }
 
+IOS::ES::TicketReader ES::FindSignedTicket(u64 title_id) const
+{
+  UpdateTitleCache();
+  const auto iterator = m_ticket_cache.find(title_id);
+  if (iterator != m_ticket_cache.end())
+    return iterator->second;
+
+  IOS::ES::TicketReader ticket = FindTicket(title_id);
+  m_ticket_cache.emplace(title_id, ticket);
+  return ticket;
+}
+
 static bool IsValidPartOfTitleID(const std::string& string)
 {
   if (string.length() != 8)
@@ -201,6 +233,7 @@ std::vector<std::array<u8, 20>> ES::GetSharedContents() const
 
 bool ES::InitImport(u64 title_id)
 {
+  NotifyNANDChanged();
   const std::string content_dir = Common::GetTitleContentPath(title_id, Common::FROM_SESSION_ROOT);
   const std::string data_dir = Common::GetTitleDataPath(title_id, Common::FROM_SESSION_ROOT);
   for (const auto& dir : {content_dir, data_dir})
@@ -232,6 +265,7 @@ bool ES::InitImport(u64 title_id)
 
 bool ES::FinishImport(const IOS::ES::TMDReader& tmd)
 {
+  NotifyNANDChanged();
   const u64 title_id = tmd.GetTitleId();
   const std::string import_content_dir = Common::GetImportTitlePath(title_id) + "/content";
 
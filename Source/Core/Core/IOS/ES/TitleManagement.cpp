@@ -21,6 +21,7 @@
 #include "Core/CommonTitles.h"
 #include "Core/HW/Memmap.h"
 #include "Core/IOS/ES/Formats.h"
+#include "Core/IOS/FS/FileIO.h"
 #include "Core/ec_wii.h"
 
 namespace IOS
@@ -35,6 +36,7 @@ static ReturnCode WriteTicket(const IOS::ES::TicketReader& ticket)
 
   const std::string ticket_path = Common::GetTicketFileName(title_id, Common::FROM_SESSION_ROOT);
   File::CreateFullPath(ticket_path);
+  NotifyNANDChanged();
 
   File::IOFile ticket_file(ticket_path, "wb");
   if (!ticket_file)
@@ -352,11 +354,11 @@ ReturnCode ES::ImportContentEnd(Context& context, u32 content_fd)
   if (!context.title_import_export.valid || !context.title_import_export.content.valid)
     return ES_EINVAL;
 
-  std::vector<u8> decrypted_data(context.title_import_export.content.buffer.size());
+  // The content is decrypted in place, as its encrypted data isn't needed anymore.
+  std::vector<u8>& decrypted_data = context.title_import_export.content.buffer;
   const ReturnCode decrypt_ret = m_ios.GetIOSC().Decrypt(
       context.title_import_export.key_handle, context.title_import_export.content.iv.data(),
-      context.title_import_export.content.buffer.data(),
-      context.title_import_export.content.buffer.size(), decrypted_data.data(), PID_ES);
+      decrypted_data.data(), decrypted_data.size(), decrypted_data.data(), PID_ES);
   if (decrypt_ret != IPC_SUCCESS)
     return decrypt_ret;
 
@@ -500,6 +502,7 @@ ReturnCode ES::DeleteTitle(u64 title_id)
   if (!File::IsDirectory(title_dir))
     return FS_ENOENT;
 
+  NotifyNANDChanged();
   if (!File::DeleteDirRecursively(title_dir))
   {
     ERROR_LOG(IOS_ES, "DeleteTitle: Failed to delete title directory: %s", title_dir.c_str());
@@ -534,6 +537,7 @@ ReturnCode ES::DeleteTicket(const u8* ticket_view)
 
   const std::vector<u8>& new_ticket = ticket.GetBytes();
   const std::string ticket_path = Common::GetTicketFileName(title_id, Common::FROM_SESSION_ROOT);
+  NotifyNANDChanged();
   {
     File::IOFile ticket_file(ticket_path, "wb");
     if (!ticket_file || !ticket_file.WriteBytes(new_ticket.data(), new_ticket.size()))
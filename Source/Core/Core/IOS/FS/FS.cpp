@@ -45,6 +45,8 @@ FS::FS(Kernel& ios, const std::string& device_name) : Device(ios, device_name)
 
 void FS::DoState(PointerWrap& p)
 {
+  // The state only captures the host files, so they must include the changes still cached.
+  FlushNANDWriteCache();
   DoStateShared(p);
 
   // handle /tmp
@@ -161,6 +163,7 @@ static u64 ComputeTotalFileSize(const File::FSTEntry& parentEntry)
 
 IPCCommandResult FS::IOCtl(const IOCtlRequest& request)
 {
+  WaitForNANDWriteBack();
   Memory::Memset(request.buffer_out, 0, request.buffer_out_size);
 
   switch (request.request)
@@ -191,6 +194,7 @@ IPCCommandResult FS::IOCtl(const IOCtlRequest& request)
 
 IPCCommandResult FS::IOCtlV(const IOCtlVRequest& request)
 {
+  WaitForNANDWriteBack();
   switch (request.request)
   {
   case IOCTLV_READ_DIR:
@@ -395,6 +399,8 @@ IPCCommandResult FS::DeleteFile(const IOCtlRequest& request)
 
   std::string Filename = BuildFilename(wii_path);
   Offset += 64;
+  FlushNANDWriteCache();
+  NotifyNANDChanged();
   if (File::Delete(Filename))
   {
     INFO_LOG(IOS_FILEIO, "FS: DeleteFile %s", Filename.c_str());
@@ -434,6 +440,8 @@ IPCCommandResult FS::RenameFile(const IOCtlRequest& request)
 
   std::string FilenameRename = BuildFilename(wii_path_rename);
   Offset += 64;
+  FlushNANDWriteCache();
+  NotifyNANDChanged();
 
   // try to make the basis directory
   File::CreateFullPath(FilenameRename);
@@ -503,6 +511,7 @@ IPCCommandResult FS::CreateFile(const IOCtlRequest& request)
 
   // create the file
   File::CreateFullPath(Filename);  // just to be sure
+  NotifyNANDChanged();
   bool Result = File::CreateEmptyFile(Filename);
   if (!Result)
   {
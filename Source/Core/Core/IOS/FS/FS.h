@@ -39,6 +39,7 @@ public:
   ReturnCode Open(const OpenRequest& request) override;
   IPCCommandResult IOCtl(const IOCtlRequest& request) override;
   IPCCommandResult IOCtlV(const IOCtlVRequest& request) override;
+  bool HasReplyTiming() const override { return false; }
 
 private:
   enum
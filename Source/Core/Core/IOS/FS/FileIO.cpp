@@ -4,11 +4,16 @@
 
 #include "Core/IOS/FS/FileIO.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cinttypes>
 #include <cstdio>
+#include <cstring>
 #include <map>
 #include <memory>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "Common/Assert.h"
 #include "Common/ChunkFile.h"
@@ -16,7 +21,9 @@
 #include "Common/File.h"
 #include "Common/FileUtil.h"
 #include "Common/NandPaths.h"
+#include "Common/WorkQueueThread.h"
 #include "Core/CommonTitles.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/HW/Memmap.h"
 #include "Core/IOS/IOS.h"
 
@@ -24,7 +31,147 @@ namespace IOS
 {
 namespace HLE
 {
-static std::map<std::string, std::weak_ptr<File::IOFile>> openFiles;
+// Larger files (such as the System Menu's 20 MiB cdb.vff) are accessed on the host directly.
+static constexpr u64 MAX_CACHED_FILE_SIZE = 4 * 1024 * 1024;
+
+using WriteBack = std::pair<std::string, std::vector<u8>>;
+static Common::WorkQueueThread<WriteBack> s_write_back_thread;
+static bool s_write_back_thread_started = false;
+
+static std::atomic<u32> s_nand_changes{0};
+
+void NotifyNANDChanged()
+{
+  s_nand_changes.fetch_add(1, std::memory_order_release);
+}
+
+u32 GetNANDChangeCount()
+{
+  return s_nand_changes.load(std::memory_order_acquire);
+}
+
+static void WriteBackFile(WriteBack write_back)
+{
+  File::IOFile file(write_back.first, "wb");
+  if (!file.WriteBytes(write_back.second.data(), write_back.second.size()))
+    ERROR_LOG(IOS_FILEIO, "Failed to write back %s", write_back.first.c_str());
+  // What was read meanwhile is older than the file now.
+  NotifyNANDChanged();
+}
+
+// A file opened through FileIO, shared by all the handles to it (see FileIO::OpenFile).
+class NANDFile
+{
+public:
+  NANDFile(const std::string& host_path, bool cache);
+  ~NANDFile();
+
+  bool IsOpen() const { return m_cached || m_file.IsOpen(); }
+  u64 GetSize() const { return m_cached ? m_data.size() : m_file.GetSize(); }
+
+  // Returns the number of bytes read, or -1 on error.
+  s64 Read(u32 offset, u32 address, u32 size);
+  bool Write(u32 offset, u32 address, u32 size);
+
+  // Queues the cached contents to be written back, if they changed.
+  void Flush();
+
+private:
+  std::string m_host_path;
+  File::IOFile m_file;
+  bool m_cached = false;
+  bool m_dirty = false;
+  std::vector<u8> m_data;
+};
+
+NANDFile::NANDFile(const std::string& host_path, bool cache) : m_host_path(host_path)
+{
+  // All files are opened read/write. Actual access rights will be controlled per handle by the
+  // read/write functions of FileIO
+  m_file.Open(host_path, "r+b");
+  if (!cache || !m_file.IsOpen() || m_file.GetSize() > MAX_CACHED_FILE_SIZE)
+    return;
+
+  m_data.resize(m_file.GetSize());
+  if (!m_file.ReadBytes(m_data.data(), m_data.size()))
+  {
+    m_data.clear();
+    return;
+  }
+  m_file.Close();
+  m_cached = true;
+
+  if (!s_write_back_thread_started)
+  {
+    s_write_back_thread.Reset(WriteBackFile);
+    s_write_back_thread_started = true;
+  }
+}
+
+NANDFile::~NANDFile()
+{
+  if (m_cached && m_dirty)
+    s_write_back_thread.EmplaceItem(m_host_path, std::move(m_data));
+}
+
+s64 NANDFile::Read(u32 offset, u32 address, u32 size)
+{
+  Memory::UnprotectRange(address, size);
+  if (m_cached)
+  {
+    if (offset >= m_data.size())
+      return 0;
+    size = std::min<u32>(size, static_cast<u32>(m_data.size() - offset));
+    std::memcpy(Memory::GetPointer(address), m_data.data() + offset, size);
+    return size;
+  }
+
+  m_file.Seek(offset, SEEK_SET);  // File might be opened twice, need to seek before we read
+  const size_t bytes_read = fread(Memory::GetPointer(address), 1, size, m_file.GetHandle());
+  if (bytes_read != size && ferror(m_file.GetHandle()))
+    return -1;
+  return static_cast<s64>(bytes_read);
+}
+
+bool NANDFile::Write(u32 offset, u32 address, u32 size)
+{
+  if (m_cached)
+  {
+    if (offset + size > m_data.size())
+      m_data.resize(offset + size);
+    Memory::CopyFromEmu(m_data.data() + offset, address, size);
+    m_dirty = true;
+    return true;
+  }
+
+  m_file.Seek(offset, SEEK_SET);  // File might be opened twice, need to seek before we write
+  return m_file.WriteBytes(Memory::GetPointer(address), size);
+}
+
+void NANDFile::Flush()
+{
+  if (!m_cached || !m_dirty)
+    return;
+  s_write_back_thread.EmplaceItem(m_host_path, m_data);
+  m_dirty = false;
+}
+
+static std::map<std::string, std::weak_ptr<NANDFile>> openFiles;
+
+void WaitForNANDWriteBack()
+{
+  s_write_back_thread.WaitForCompletion();
+}
+
+void FlushNANDWriteCache()
+{
+  for (const auto& entry : openFiles)
+  {
+    if (const std::shared_ptr<NANDFile> file = entry.second.lock())
+      file->Flush();
+  }
+  WaitForNANDWriteBack();
+}
 
 // This is used by several of the FileIO and /dev/fs functions
 std::string BuildFilename(const std::string& wii_path)
@@ -145,18 +292,19 @@ void FileIO::OpenFile()
   {
     std::string path = m_name;
     // This code will be called when all references to the shared pointer below have been removed.
-    auto deleter = [path](File::IOFile* ptr) {
-      delete ptr;             // IOFile's deconstructor closes the file.
+    auto deleter = [path](NANDFile* ptr) {
+      delete ptr;             // NANDFile's deconstructor closes the file, or queues its write-back.
       openFiles.erase(path);  // erase the weak pointer from the list of open files.
     };
 
-    // All files are opened read/write. Actual access rights will be controlled per handle by the
-    // read/write functions below
-    m_file = std::shared_ptr<File::IOFile>(new File::IOFile(m_filepath, "r+b"),
-                                           deleter);  // Use the custom deleter from above.
+    // The file may have been closed with its last changes still to be written back.
+    WaitForNANDWriteBack();
+    m_file = std::shared_ptr<NANDFile>(
+        new NANDFile(m_filepath, Config::Get(Config::MAIN_NAND_WRITE_CACHE)),
+        deleter);  // Use the custom deleter from above.
 
     // Store a weak pointer to our newly opened file in the cache.
-    openFiles[path] = std::weak_ptr<File::IOFile>(m_file);
+    openFiles[path] = std::weak_ptr<NANDFile>(m_file);
   }
 }
 
@@ -220,12 +368,10 @@ IPCCommandResult FileIO::Read(const ReadWriteRequest& request)
 
   DEBUG_LOG(IOS_FILEIO, "Read 0x%x bytes to 0x%08x from %s", request.size, request.buffer,
             m_name.c_str());
-  m_file->Seek(m_SeekPos, SEEK_SET);  // File might be opened twice, need to seek before we read
-  const u32 number_of_bytes_read = static_cast<u32>(
-      fread(Memory::GetPointer(request.buffer), 1, requested_read_length, m_file->GetHandle()));
-
-  if (number_of_bytes_read != requested_read_length && ferror(m_file->GetHandle()))
+  const s64 read_result = m_file->Read(m_SeekPos, request.buffer, requested_read_length);
+  if (read_result < 0)
     return GetDefaultReply(FS_EACCESS);
+  const u32 number_of_bytes_read = static_cast<u32>(read_result);
 
   // IOS returns the number of bytes read and adds that value to the seek position,
   // instead of adding the *requested* read length.
@@ -248,9 +394,8 @@ IPCCommandResult FileIO::Write(const ReadWriteRequest& request)
     {
       DEBUG_LOG(IOS_FILEIO, "FileIO: Write 0x%04x bytes from 0x%08x to %s", request.size,
                 request.buffer, m_name.c_str());
-      m_file->Seek(m_SeekPos,
-                   SEEK_SET);  // File might be opened twice, need to seek before we write
-      if (m_file->WriteBytes(Memory::GetPointer(request.buffer), request.size))
+      NotifyNANDChanged();
+      if (m_file->Write(m_SeekPos, request.buffer, request.size))
       {
         return_value = request.size;
         m_SeekPos += request.size;
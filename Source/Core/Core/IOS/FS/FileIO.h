@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 
 #include "Common/ChunkFile.h"
@@ -13,11 +14,6 @@
 
 class PointerWrap;
 
-namespace File
-{
-class IOFile;
-}
-
 namespace IOS
 {
 namespace HLE
@@ -25,6 +21,19 @@ namespace HLE
 std::string BuildFilename(const std::string& wii_path);
 void CreateVirtualFATFilesystem();
 
+// With the NAND write cache, the files opened through FileIO are kept in memory, and written to
+// the host in the background when closed. These make the host files up to date again:
+// WaitForNANDWriteBack for the closed files, FlushNANDWriteCache for the open ones too.
+void WaitForNANDWriteBack();
+void FlushNANDWriteCache();
+
+// Counts the changes made to the NAND files, by FS requests or by IOS itself, so that what is
+// cached from them (see ES::FindInstalledTMD) can tell when it may be out of date.
+void NotifyNANDChanged();
+u32 GetNANDChangeCount();
+
+class NANDFile;
+
 namespace Device
 {
 class FileIO : public Device
@@ -38,6 +47,7 @@ public:
   IPCCommandResult Read(const ReadWriteRequest& request) override;
   IPCCommandResult Write(const ReadWriteRequest& request) override;
   IPCCommandResult IOCtl(const IOCtlRequest& request) override;
+  bool HasReplyTiming() const override { return false; }
   void PrepareForState(PointerWrap::Mode mode) override;
   void DoState(PointerWrap& p) override;
 
@@ -76,7 +86,7 @@ private:
   u32 m_SeekPos = 0;
 
   std::string m_filepath;
-  std::shared_ptr<File::IOFile> m_file;
+  std::shared_ptr<NANDFile> m_file;
 };
 }  // namespace Device
 }  // namespace HLE
@@ -22,6 +22,7 @@
 #include "Core/Boot/DolReader.h"
 #include "Core/Boot/ElfReader.h"
 #include "Core/CommonTitles.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
@@ -198,9 +199,12 @@ Kernel::~Kernel()
 
   {
     std::lock_guard<std::mutex> lock(m_device_map_mutex);
+    m_fs.reset();
+    m_es.reset();
     m_device_map.clear();
   }
 
+  WaitForNANDWriteBack();
   if (m_is_responsible_for_nand_root)
     Core::ShutdownWiiRoot();
 }
@@ -244,12 +248,12 @@ u32 Kernel::GetVersion() const
 
 std::shared_ptr<Device::FS> Kernel::GetFS()
 {
-  return std::static_pointer_cast<Device::FS>(m_device_map.at("/dev/fs"));
+  return m_fs;
 }
 
 std::shared_ptr<Device::ES> Kernel::GetES()
 {
-  return std::static_pointer_cast<Device::ES>(m_device_map.at("/dev/es"));
+  return m_es;
 }
 
 // Since we don't have actual processes, we keep track of only the PPC's UID/GID.
@@ -369,8 +373,10 @@ void Kernel::AddDevice(std::unique_ptr<Device::Device> device)
 void Kernel::AddCoreDevices()
 {
   std::lock_guard<std::mutex> lock(m_device_map_mutex);
-  AddDevice(std::make_unique<Device::FS>(*this, "/dev/fs"));
-  AddDevice(std::make_unique<Device::ES>(*this, "/dev/es"));
+  m_fs = std::make_shared<Device::FS>(*this, "/dev/fs");
+  m_device_map[m_fs->GetDeviceName()] = m_fs;
+  m_es = std::make_shared<Device::ES>(*this, "/dev/es");
+  m_device_map[m_es->GetDeviceName()] = m_es;
 }
 
 void Kernel::AddStaticDevices()
@@ -442,18 +448,17 @@ s32 Kernel::OpenDevice(OpenRequest& request)
   }
   request.fd = new_fd;
 
+  const std::string& path = request.path;
   std::shared_ptr<Device::Device> device;
-  if (request.path.find("/dev/usb/oh0/") == 0 && !GetDeviceByName(request.path))
+  if (path.compare(0, 5, "/dev/") == 0)
   {
-    device = std::make_shared<Device::OH0Device>(*this, request.path);
+    device = GetDeviceByName(path);
+    if (!device && path.compare(0, 13, "/dev/usb/oh0/") == 0)
+      device = std::make_shared<Device::OH0Device>(*this, path);
   }
-  else if (request.path.find("/dev/") == 0)
+  else if (!path.empty() && path[0] == '/')
   {
-    device = GetDeviceByName(request.path);
-  }
-  else if (request.path.find('/') == 0)
-  {
-    device = std::make_shared<Device::FileIO>(*this, request.path);
+    device = std::make_shared<Device::FileIO>(*this, path);
   }
 
   if (!device)
@@ -478,17 +483,25 @@ IPCCommandResult Kernel::HandleIPCCommand(const Request& request)
     return Device::Device::GetDefaultReply(new_fd);
   }
 
-  const auto device = (request.fd < IPC_MAX_FDS) ? m_fdmap[request.fd] : nullptr;
+  // The fd table owns the devices, so dispatching doesn't need a reference of its own.
+  Device::Device* const device = (request.fd < IPC_MAX_FDS) ? m_fdmap[request.fd].get() : nullptr;
   if (!device)
     return Device::Device::GetDefaultReply(IPC_EINVAL);
 
+  // Except where the device could be destroyed before the command returns: closing releases the
+  // fd, and ES ioctlvs can reload IOS, which destroys this kernel with all its devices.
+  std::shared_ptr<Device::Device> reference;
+  if (request.command == IPC_CMD_CLOSE)
+    reference = std::move(m_fdmap[request.fd]);
+  else if (request.command == IPC_CMD_IOCTLV && device == m_es.get())
+    reference = m_es;
+
   IPCCommandResult ret;
   u64 wall_time_before = Common::Timer::GetTimeUs();
 
   switch (request.command)
   {
   case IPC_CMD_CLOSE:
-    m_fdmap[request.fd].reset();
     ret = Device::Device::GetDefaultReply(device->Close(request.fd));
     break;
   case IPC_CMD_READ:
@@ -523,9 +536,29 @@ IPCCommandResult Kernel::HandleIPCCommand(const Request& request)
   return ret;
 }
 
+bool Kernel::CanReplyImmediately(const Request& request) const
+{
+  if (request.command == IPC_CMD_OPEN || request.fd >= IPC_MAX_FDS)
+    return false;
+  const Device::Device* device = m_fdmap[request.fd].get();
+  return device && !device->HasReplyTiming() && !Core::WantsDeterminism() &&
+         Config::Get(Config::MAIN_IMMEDIATE_IPC_REPLIES);
+}
+
+static void WriteIPCReply(const Request& request, const s32 return_value)
+{
+  Memory::Write_U32(static_cast<u32>(return_value), request.address + 4);
+  // IOS writes back the command that was responded to in the FD field.
+  Memory::Write_U32(request.command, request.address + 8);
+  // IOS also overwrites the command type with the reply type.
+  Memory::Write_U32(IPC_REPLY, request.address);
+}
+
 void Kernel::ExecuteIPCCommand(const u32 address)
 {
   Request request{address};
+  // Checked first, as closing a device releases its fd.
+  const bool reply_immediately = CanReplyImmediately(request);
   IPCCommandResult result = HandleIPCCommand(request);
 
   if (!result.send_reply)
@@ -533,6 +566,18 @@ void Kernel::ExecuteIPCCommand(const u32 address)
 
   // Ensure replies happen in order
   const s64 ticks_until_last_reply = m_last_reply_time - CoreTiming::GetTicks();
+
+  // Menus and channels boot through thousands of tiny FS and ES requests, which the PPC sends one
+  // after the other. Queuing the reply right away lets UpdateIPC send it as soon as the PPC has
+  // taken the acknowledgement, instead of after an arbitrary delay and a CoreTiming event.
+  if (reply_immediately && ticks_until_last_reply <= 0)
+  {
+    WriteIPCReply(request, result.return_value);
+    m_reply_queue.push_back(request.address);
+    m_last_reply_time = CoreTiming::GetTicks();
+    return;
+  }
+
   if (ticks_until_last_reply > 0)
     result.reply_delay_ticks += ticks_until_last_reply;
   m_last_reply_time = CoreTiming::GetTicks() + result.reply_delay_ticks;
@@ -550,11 +595,7 @@ void Kernel::EnqueueIPCRequest(u32 address)
 void Kernel::EnqueueIPCReply(const Request& request, const s32 return_value, int cycles_in_future,
                              CoreTiming::FromThread from)
 {
-  Memory::Write_U32(static_cast<u32>(return_value), request.address + 4);
-  // IOS writes back the command that was responded to in the FD field.
-  Memory::Write_U32(request.command, request.address + 8);
-  // IOS also overwrites the command type with the reply type.
-  Memory::Write_U32(IPC_REPLY, request.address);
+  WriteIPCReply(request, return_value);
   CoreTiming::ScheduleEvent(cycles_in_future, s_event_enqueue, request.address, from);
 }
 
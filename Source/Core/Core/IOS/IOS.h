@@ -119,6 +119,7 @@ protected:
 
   void ExecuteIPCCommand(u32 address);
   IPCCommandResult HandleIPCCommand(const Request& request);
+  bool CanReplyImmediately(const Request& request) const;
   void EnqueueIPCAcknowledgement(u32 address, int cycles_in_future = 0);
 
   void AddDevice(std::unique_ptr<Device::Device> device);
@@ -133,6 +134,9 @@ protected:
   static constexpr u8 IPC_MAX_FDS = 0x18;
   std::map<std::string, std::shared_ptr<Device::Device>> m_device_map;
   std::mutex m_device_map_mutex;
+  // Resolved once, as they are looked up all the time.
+  std::shared_ptr<Device::FS> m_fs;
+  std::shared_ptr<Device::ES> m_es;
   // TODO: make this fdmap per process.
   std::array<std::shared_ptr<Device::Device>, IPC_MAX_FDS> m_fdmap;
 
@@ -6,7 +6,9 @@
 
 #include <array>
 #include <cstring>
+#include <map>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include <mbedtls/md.h>
@@ -39,6 +41,42 @@ static constexpr mbedtls_x509_crt_profile mbedtls_x509_crt_profile_wii = {
     0,         /* No RSA min key size */
 };
 
+// Sessions are only resumed for the same host and the same verification setting, as resuming one
+// skips the verification of the server certificate.
+static std::map<std::string, mbedtls_ssl_session> s_sessions;
+
+static std::string GetSessionKey(const WII_SSL& ssl)
+{
+  return ssl.hostname + (ssl.verify_peer ? "/verify" : "/noverify");
+}
+
+void NetSSL::SaveSession(WII_SSL& ssl)
+{
+  if (ssl.hostname.empty())
+    return;
+
+  auto result = s_sessions.emplace(GetSessionKey(ssl), mbedtls_ssl_session{});
+  mbedtls_ssl_session& session = result.first->second;
+  if (!result.second)
+    mbedtls_ssl_session_free(&session);
+  mbedtls_ssl_session_init(&session);
+  if (mbedtls_ssl_get_session(&ssl.ctx, &session) != 0)
+  {
+    mbedtls_ssl_session_free(&session);
+    s_sessions.erase(result.first);
+  }
+}
+
+static void ResumeSession(WII_SSL& ssl)
+{
+  if (ssl.hostname.empty())
+    return;
+
+  const auto iterator = s_sessions.find(GetSessionKey(ssl));
+  if (iterator != s_sessions.end())
+    mbedtls_ssl_set_session(&ssl.ctx, &iterator->second);
+}
+
 NetSSL::NetSSL(Kernel& ios, const std::string& device_name) : Device(ios, device_name)
 {
   for (WII_SSL& ssl : _SSL)
@@ -70,6 +108,10 @@ NetSSL::~NetSSL()
       ssl.active = false;
     }
   }
+
+  for (auto& entry : s_sessions)
+    mbedtls_ssl_session_free(&entry.second);
+  s_sessions.clear();
 }
 
 int NetSSL::GetSSLFreeID() const
@@ -218,9 +260,12 @@ IPCCommandResult NetSSL::IOCtlV(const IOCtlVRequest& request)
       mbedtls_ssl_conf_max_version(&ssl->config, MBEDTLS_SSL_MAJOR_VERSION_3,
                                    MBEDTLS_SSL_MINOR_VERSION_2);
       mbedtls_ssl_conf_cert_profile(&ssl->config, &mbedtls_x509_crt_profile_wii);
-      mbedtls_ssl_set_session(&ssl->ctx, &ssl->session);
+#ifdef MBEDTLS_SSL_SESSION_TICKETS
+      mbedtls_ssl_conf_session_tickets(&ssl->config, MBEDTLS_SSL_SESSION_TICKETS_ENABLED);
+#endif
 
-      if (SConfig::GetInstance().m_SSLVerifyCert && verifyOption)
+      ssl->verify_peer = SConfig::GetInstance().m_SSLVerifyCert && verifyOption;
+      if (ssl->verify_peer)
         mbedtls_ssl_conf_authmode(&ssl->config, MBEDTLS_SSL_VERIFY_REQUIRED);
       else
         mbedtls_ssl_conf_authmode(&ssl->config, MBEDTLS_SSL_VERIFY_NONE);
@@ -439,6 +484,7 @@ IPCCommandResult NetSSL::IOCtlV(const IOCtlVRequest& request)
     {
       WII_SSL* ssl = &_SSL[sslID];
       mbedtls_ssl_setup(&ssl->ctx, &ssl->config);
+      ResumeSession(*ssl);
       ssl->sockfd = Memory::Read_U32(BufferOut2);
       WiiSockMan& sm = WiiSockMan::GetInstance();
       ssl->hostfd = sm.GetHostSocket(ssl->sockfd);
@@ -83,6 +83,7 @@ struct WII_SSL
   int sockfd;
   int hostfd;
   std::string hostname;
+  bool verify_peer;
   bool active;
 };
 
@@ -100,6 +101,10 @@ public:
 
   int GetSSLFreeID() const;
 
+  // Keeps the session negotiated by a successful handshake, so that the next connection to the
+  // same host can resume it (with its session ticket, where the server gave one).
+  static void SaveSession(WII_SSL& ssl);
+
   static WII_SSL _SSL[NET_SSL_MAXINSTANCES];
 
 private:
@@ -6,14 +6,12 @@
 #include "Core/IOS/Network/Socket.h"
 
 #include <algorithm>
+#include <limits>
 #include <mbedtls/error.h>
 #ifndef _WIN32
 #include <arpa/inet.h>
 #include <unistd.h>
 #endif
-#ifdef __HAIKU__
-#include <sys/select.h>
-#endif
 
 #include "Common/File.h"
 #include "Common/FileUtil.h"
@@ -203,11 +201,61 @@ s32 WiiSocket::FCntl(u32 cmd, u32 arg)
   return ret;
 }
 
+short WiiSocket::GetWaitEvents(const sockop& op)
+{
+  if (op.is_ssl)
+  {
+    switch (op.ssl_type)
+    {
+    case IOCTLV_NET_SSL_READ:
+      return POLLIN;
+    case IOCTLV_NET_SSL_WRITE:
+      return POLLOUT;
+    default:
+      // The handshake (and anything else mbedtls does) may wait for either direction.
+      return POLLIN | POLLOUT;
+    }
+  }
+
+  switch (op.net_type)
+  {
+  case IOCTL_SO_ACCEPT:
+  case IOCTLV_SO_RECVFROM:
+    return POLLIN;
+  case IOCTL_SO_CONNECT:
+  case IOCTLV_SO_SENDTO:
+    return POLLOUT;
+  default:
+    return POLLIN | POLLOUT;
+  }
+}
+
+short WiiSocket::GetWaitEvents() const
+{
+  short events = 0;
+  for (const sockop& op : pending_sockops)
+  {
+    if (op.waiting)
+      events |= GetWaitEvents(op);
+  }
+  return events;
+}
+
 void WiiSocket::Update(bool read, bool write, bool except)
 {
   auto it = pending_sockops.begin();
   while (it != pending_sockops.end())
   {
+    if (it->waiting && !except)
+    {
+      const short events = GetWaitEvents(*it);
+      if (!(read && (events & POLLIN)) && !(write && (events & POLLOUT)))
+      {
+        ++it;
+        continue;
+      }
+    }
+
     s32 ReturnValue = 0;
     bool forceNonBlock = false;
     IPCCommandType ct = it->request.command;
@@ -338,6 +386,7 @@ void WiiSocket::Update(bool read, bool write, bool except)
             switch (ret)
             {
             case 0:
+              Device::NetSSL::SaveSession(Device::NetSSL::_SSL[sslID]);
               WriteReturnValue(SSL_OK, BufferIn);
               break;
             case MBEDTLS_ERR_SSL_WANT_READ:
@@ -596,6 +645,7 @@ void WiiSocket::Update(bool read, bool write, bool except)
     }
     else
     {
+      it->waiting = true;
       ++it;
     }
   }
@@ -681,50 +731,59 @@ s32 WiiSockMan::DeleteSocket(s32 s)
 
 void WiiSockMan::Update()
 {
-  s32 nfds = 0;
-  fd_set read_fds, write_fds, except_fds;
-  struct timeval t = {0, 0};
-  FD_ZERO(&read_fds);
-  FD_ZERO(&write_fds);
-  FD_ZERO(&except_fds);
+  // Only the sockets with pending operations are looked at, and only those with operations which
+  // would block are polled, for the events these operations wait for. Games and online services
+  // keep many sockets open, most of them idle or waiting to receive at any given time.
+  constexpr size_t NOT_POLLED = std::numeric_limits<size_t>::max();
+  m_updated_sockets.clear();
+  m_poll_fds.clear();
 
   auto socket_iter = WiiSockets.begin();
-  auto end_socks = WiiSockets.end();
-
-  while (socket_iter != end_socks)
+  while (socket_iter != WiiSockets.end())
   {
     WiiSocket& sock = socket_iter->second;
-    if (sock.IsValid())
-    {
-      FD_SET(sock.fd, &read_fds);
-      FD_SET(sock.fd, &write_fds);
-      FD_SET(sock.fd, &except_fds);
-      nfds = std::max(nfds, sock.fd + 1);
-      ++socket_iter;
-    }
-    else
+    if (!sock.IsValid())
     {
       // Good time to clean up invalid sockets.
       socket_iter = WiiSockets.erase(socket_iter);
+      continue;
     }
-  }
-  s32 ret = select(nfds, &read_fds, &write_fds, &except_fds, &t);
 
-  if (ret >= 0)
-  {
-    for (auto& pair : WiiSockets)
+    if (!sock.pending_sockops.empty())
     {
-      WiiSocket& sock = pair.second;
-      sock.Update(FD_ISSET(sock.fd, &read_fds) != 0, FD_ISSET(sock.fd, &write_fds) != 0,
-                  FD_ISSET(sock.fd, &except_fds) != 0);
+      const short events = sock.GetWaitEvents();
+      if (events == 0)
+      {
+        m_updated_sockets.emplace_back(&sock, NOT_POLLED);
+      }
+      else
+      {
+        m_updated_sockets.emplace_back(&sock, m_poll_fds.size());
+        pollfd_t poll_fd{};
+        poll_fd.fd = sock.fd;
+        poll_fd.events = events;
+        m_poll_fds.push_back(poll_fd);
+      }
     }
+    ++socket_iter;
   }
-  else
+
+  if (m_updated_sockets.empty())
+    return;
+
+  if (!m_poll_fds.empty() &&
+      poll(m_poll_fds.data(), static_cast<unsigned long>(m_poll_fds.size()), 0) < 0)
   {
-    for (auto& elem : WiiSockets)
-    {
-      elem.second.Update(false, false, false);
-    }
+    for (pollfd_t& poll_fd : m_poll_fds)
+      poll_fd.revents = 0;
+  }
+
+  // Accepting a connection adds a socket, but the WiiSocket pointers stay valid.
+  for (const auto& entry : m_updated_sockets)
+  {
+    const short revents = entry.second != NOT_POLLED ? m_poll_fds[entry.second].revents : 0;
+    entry.first->Update((revents & POLLIN) != 0, (revents & POLLOUT) != 0,
+                        (revents & (POLLERR | POLLHUP | POLLNVAL)) != 0);
   }
 }
 
@@ -47,6 +47,7 @@ typedef struct pollfd pollfd_t;
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
@@ -177,6 +178,8 @@ class WiiSocket
   {
     Request request;
     bool is_ssl;
+    // Set once the operation would block. It is then only retried when the socket is ready for it.
+    bool waiting = false;
     union
     {
       NET_IOCTL net_type;
@@ -199,6 +202,9 @@ private:
   void DoSock(Request request, NET_IOCTL type);
   void DoSock(Request request, SSL_IOCTL type);
   void Update(bool read, bool write, bool except);
+  // The poll events the waiting operations need, 0 if there are none.
+  short GetWaitEvents() const;
+  static short GetWaitEvents(const sockop& op);
   bool IsValid() const { return fd >= 0; }
 public:
   WiiSocket() : fd(-1), nonBlock(false) {}
@@ -255,6 +261,11 @@ private:
 
   std::unordered_map<s32, WiiSocket> WiiSockets;
   s32 errno_last;
+
+  // Reused by Update: the sockets with pending operations, and the index of their entry in
+  // m_poll_fds if they have any waiting ones.
+  std::vector<std::pair<WiiSocket*, size_t>> m_updated_sockets;
+  std::vector<pollfd_t> m_poll_fds;
 };
 }  // namespace HLE
 }  // namespace IOS
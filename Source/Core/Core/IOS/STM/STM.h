@@ -48,6 +48,7 @@ class STMImmediate final : public Device
 public:
   using Device::Device;
   IPCCommandResult IOCtl(const IOCtlRequest& request) override;
+  bool HasReplyTiming() const override { return false; }
 };
 
 // The /dev/stm/eventhook
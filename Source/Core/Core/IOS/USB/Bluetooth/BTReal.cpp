@@ -85,6 +85,7 @@ BluetoothReal::~BluetoothReal()
     // libusb_handle_events() may block the libusb thread indefinitely, so we need to
     // call libusb_close() first then immediately stop the thread in StopTransferThread.
     StopTransferThread();
+    FreeTransfers();
     libusb_unref_device(m_device);
   }
 
@@ -163,6 +164,7 @@ ReturnCode BluetoothReal::Close(u32 fd)
   {
     libusb_release_interface(m_handle, 0);
     StopTransferThread();
+    FreeTransfers();
     libusb_unref_device(m_device);
     m_handle = nullptr;
   }
@@ -186,7 +188,7 @@ IPCCommandResult BluetoothReal::IOCtlV(const IOCtlVRequest& request)
   // HCI commands to the Bluetooth adapter
   case USB::IOCTLV_USBV0_CTRLMSG:
   {
-    std::lock_guard<std::mutex> lk(m_transfers_mutex);
+    std::unique_lock<std::mutex> lk(m_transfers_mutex);
     auto cmd = std::make_unique<USB::V0CtrlMessage>(m_ios, request);
     const u16 opcode = Common::swap16(Memory::Read_U16(cmd->data_address));
     if (opcode == HCI_CMD_READ_BUFFER_SIZE)
@@ -210,18 +212,20 @@ IPCCommandResult BluetoothReal::IOCtlV(const IOCtlVRequest& request)
       else
         m_link_keys.erase(delete_cmd.bdaddr);
     }
-    auto buffer = std::make_unique<u8[]>(cmd->length + LIBUSB_CONTROL_SETUP_SIZE);
-    libusb_fill_control_setup(buffer.get(), cmd->request_type, cmd->request, cmd->value, cmd->index,
-                              cmd->length);
-    Memory::CopyFromEmu(buffer.get() + LIBUSB_CONTROL_SETUP_SIZE, cmd->data_address, cmd->length);
-    libusb_transfer* transfer = libusb_alloc_transfer(0);
-    transfer->flags |= LIBUSB_TRANSFER_FREE_TRANSFER;
-    libusb_fill_control_transfer(transfer, m_handle, buffer.get(), nullptr, this, 0);
+    std::vector<u8> buffer;
+    libusb_transfer* transfer = AcquireTransfer(&buffer);
+    buffer.resize(cmd->length + LIBUSB_CONTROL_SETUP_SIZE);
+    libusb_fill_control_setup(buffer.data(), cmd->request_type, cmd->request, cmd->value,
+                              cmd->index, cmd->length);
+    Memory::CopyFromEmu(buffer.data() + LIBUSB_CONTROL_SETUP_SIZE, cmd->data_address, cmd->length);
+    libusb_fill_control_transfer(transfer, m_handle, buffer.data(), nullptr, this, 0);
     transfer->callback = [](libusb_transfer* tr) {
       static_cast<BluetoothReal*>(tr->user_data)->HandleCtrlTransfer(tr);
     };
     PendingTransfer pending_transfer{std::move(cmd), std::move(buffer)};
     m_current_transfers.emplace(transfer, std::move(pending_transfer));
+    // Don't keep the completion handlers of the other transfers waiting during the submission.
+    lk.unlock();
     libusb_submit_transfer(transfer);
     break;
   }
@@ -229,7 +233,7 @@ IPCCommandResult BluetoothReal::IOCtlV(const IOCtlVRequest& request)
   case USB::IOCTLV_USBV0_BLKMSG:
   case USB::IOCTLV_USBV0_INTRMSG:
   {
-    std::lock_guard<std::mutex> lk(m_transfers_mutex);
+    std::unique_lock<std::mutex> lk(m_transfers_mutex);
     auto cmd = std::make_unique<USB::V0IntrMessage>(m_ios, request);
     if (request.request == USB::IOCTLV_USBV0_INTRMSG)
     {
@@ -256,15 +260,26 @@ IPCCommandResult BluetoothReal::IOCtlV(const IOCtlVRequest& request)
         return GetNoReply();
       }
     }
-    auto buffer = cmd->MakeBuffer(cmd->length);
-    libusb_transfer* transfer = libusb_alloc_transfer(0);
-    transfer->buffer = buffer.get();
+    std::vector<u8> buffer;
+    libusb_transfer* transfer = AcquireTransfer(&buffer);
+    if (cmd->endpoint & LIBUSB_ENDPOINT_IN)
+    {
+      // Received data is copied when the transfer completes, as emulated memory may be
+      // write-protected for dirty page tracking, and the host can't write into it then.
+      buffer.resize(cmd->length);
+      transfer->buffer = buffer.data();
+    }
+    else
+    {
+      // Sent straight from emulated memory, which the game leaves alone until the reply.
+      buffer.clear();
+      transfer->buffer = Memory::GetPointer(cmd->data_address);
+    }
     transfer->callback = [](libusb_transfer* tr) {
       static_cast<BluetoothReal*>(tr->user_data)->HandleBulkOrIntrTransfer(tr);
     };
     transfer->dev_handle = m_handle;
     transfer->endpoint = cmd->endpoint;
-    transfer->flags |= LIBUSB_TRANSFER_FREE_TRANSFER;
     transfer->length = cmd->length;
     transfer->timeout = TIMEOUT;
     transfer->type = request.request == USB::IOCTLV_USBV0_BLKMSG ? LIBUSB_TRANSFER_TYPE_BULK :
@@ -272,6 +287,7 @@ IPCCommandResult BluetoothReal::IOCtlV(const IOCtlVRequest& request)
     transfer->user_data = this;
     PendingTransfer pending_transfer{std::move(cmd), std::move(buffer)};
     m_current_transfers.emplace(transfer, std::move(pending_transfer));
+    lk.unlock();
     libusb_submit_transfer(transfer);
     break;
   }
@@ -589,6 +605,36 @@ bool BluetoothReal::OpenDevice(libusb_device* device)
   return true;
 }
 
+// Must be called with m_transfers_mutex held.
+libusb_transfer* BluetoothReal::AcquireTransfer(std::vector<u8>* buffer)
+{
+  if (m_free_transfers.empty())
+    return libusb_alloc_transfer(0);
+
+  FreeTransfer& free_transfer = m_free_transfers.back();
+  libusb_transfer* transfer = free_transfer.transfer;
+  *buffer = std::move(free_transfer.buffer);
+  m_free_transfers.pop_back();
+  return transfer;
+}
+
+// Must be called with m_transfers_mutex held.
+void BluetoothReal::ReleaseTransfer(libusb_transfer* transfer)
+{
+  auto iter = m_current_transfers.find(transfer);
+  m_free_transfers.push_back({transfer, std::move(iter->second.buffer)});
+  m_current_transfers.erase(iter);
+}
+
+// Transfers which are still pending are not freed, as libusb may still reference them.
+void BluetoothReal::FreeTransfers()
+{
+  std::lock_guard<std::mutex> lk(m_transfers_mutex);
+  for (FreeTransfer& free_transfer : m_free_transfers)
+    libusb_free_transfer(free_transfer.transfer);
+  m_free_transfers.clear();
+}
+
 void BluetoothReal::StartTransferThread()
 {
   if (m_thread_running.IsSet())
@@ -640,7 +686,7 @@ void BluetoothReal::HandleCtrlTransfer(libusb_transfer* tr)
   command->FillBuffer(libusb_control_transfer_get_data(tr), tr->actual_length);
   m_ios.EnqueueIPCReply(command->ios_request, tr->actual_length, 0,
                         CoreTiming::FromThread::NON_CPU);
-  m_current_transfers.erase(tr);
+  ReleaseTransfer(tr);
 }
 
 void BluetoothReal::HandleBulkOrIntrTransfer(libusb_transfer* tr)
@@ -686,10 +732,11 @@ void BluetoothReal::HandleBulkOrIntrTransfer(libusb_transfer* tr)
   }
 
   const auto& command = m_current_transfers.at(tr).command;
-  command->FillBuffer(tr->buffer, tr->actual_length);
+  if (tr->endpoint & LIBUSB_ENDPOINT_IN)
+    command->FillBuffer(tr->buffer, tr->actual_length);
   m_ios.EnqueueIPCReply(command->ios_request, tr->actual_length, 0,
                         CoreTiming::FromThread::NON_CPU);
-  m_current_transfers.erase(tr);
+  ReleaseTransfer(tr);
 }
 }  // namespace Device
 }  // namespace HLE
@@ -12,6 +12,7 @@
 #include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/Flag.h"
@@ -84,14 +85,22 @@ private:
   std::mutex m_transfers_mutex;
   struct PendingTransfer
   {
-    PendingTransfer(std::unique_ptr<USB::TransferCommand> command_, std::unique_ptr<u8[]> buffer_)
+    PendingTransfer(std::unique_ptr<USB::TransferCommand> command_, std::vector<u8> buffer_)
         : command(std::move(command_)), buffer(std::move(buffer_))
     {
     }
     std::unique_ptr<USB::TransferCommand> command;
-    std::unique_ptr<u8[]> buffer;
+    // Empty for outgoing bulk and interrupt transfers, which are sent from emulated memory.
+    std::vector<u8> buffer;
   };
   std::map<libusb_transfer*, PendingTransfer> m_current_transfers;
+  // Finished transfers, kept with their buffer to be reused by the next requests.
+  struct FreeTransfer
+  {
+    libusb_transfer* transfer;
+    std::vector<u8> buffer;
+  };
+  std::vector<FreeTransfer> m_free_transfers;
 
   // Set when we received a command to which we need to fake a reply
   Common::Flag m_fake_read_buffer_size_reply;
@@ -123,6 +132,10 @@ private:
   void LoadLinkKeys();
   void SaveLinkKeys();
 
+  libusb_transfer* AcquireTransfer(std::vector<u8>* buffer);
+  void ReleaseTransfer(libusb_transfer* transfer);
+  void FreeTransfers();
+
   bool OpenDevice(libusb_device* device);
   void StartTransferThread();
   void StopTransferThread();
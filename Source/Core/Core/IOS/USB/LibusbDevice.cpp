@@ -217,16 +217,18 @@ int LibusbDevice::SubmitTransfer(std::unique_ptr<CtrlMessage> cmd)
   }
   }
 
-  const size_t size = cmd->length + LIBUSB_CONTROL_SETUP_SIZE;
-  auto buffer = std::make_unique<u8[]>(size);
-  libusb_fill_control_setup(buffer.get(), cmd->request_type, cmd->request, cmd->value, cmd->index,
-                            cmd->length);
-  Memory::CopyFromEmu(buffer.get() + LIBUSB_CONTROL_SETUP_SIZE, cmd->data_address, cmd->length);
-  libusb_transfer* transfer = libusb_alloc_transfer(0);
-  transfer->flags |= LIBUSB_TRANSFER_FREE_TRANSFER;
-  libusb_fill_control_transfer(transfer, m_handle, buffer.release(), CtrlTransferCallback, this, 0);
-  m_transfer_endpoints[0].AddTransfer(std::move(cmd), transfer);
-  return libusb_submit_transfer(transfer);
+  std::unique_ptr<Transfer> transfer = AcquireTransfer(std::move(cmd));
+  const CtrlMessage& message = static_cast<const CtrlMessage&>(*transfer->command);
+  const size_t size = message.length + LIBUSB_CONTROL_SETUP_SIZE;
+  if (transfer->buffer.size() < size)
+    transfer->buffer.resize(size);
+  u8* buffer = transfer->buffer.data();
+  libusb_fill_control_setup(buffer, message.request_type, message.request, message.value,
+                            message.index, message.length);
+  Memory::CopyFromEmu(buffer + LIBUSB_CONTROL_SETUP_SIZE, message.data_address, message.length);
+  libusb_fill_control_transfer(transfer->transfer, m_handle, buffer, CtrlTransferCallback,
+                               transfer.get(), 0);
+  return SubmitTransfer(0, std::move(transfer));
 }
 
 int LibusbDevice::SubmitTransfer(std::unique_ptr<BulkMessage> cmd)
@@ -234,13 +236,13 @@ int LibusbDevice::SubmitTransfer(std::unique_ptr<BulkMessage> cmd)
   if (!m_device_attached)
     return LIBUSB_ERROR_NOT_FOUND;
 
-  libusb_transfer* transfer = libusb_alloc_transfer(0);
-  libusb_fill_bulk_transfer(transfer, m_handle, cmd->endpoint,
-                            cmd->MakeBuffer(cmd->length).release(), cmd->length, TransferCallback,
-                            this, 0);
-  transfer->flags |= LIBUSB_TRANSFER_FREE_TRANSFER;
-  m_transfer_endpoints[transfer->endpoint].AddTransfer(std::move(cmd), transfer);
-  return libusb_submit_transfer(transfer);
+  const u8 endpoint = cmd->endpoint;
+  const u32 length = cmd->length;
+  std::unique_ptr<Transfer> transfer = AcquireTransfer(std::move(cmd));
+  libusb_fill_bulk_transfer(transfer->transfer, m_handle, endpoint,
+                            GetTransferBuffer(transfer.get(), endpoint, length), length,
+                            TransferCallback, transfer.get(), 0);
+  return SubmitTransfer(endpoint, std::move(transfer));
 }
 
 int LibusbDevice::SubmitTransfer(std::unique_ptr<IntrMessage> cmd)
@@ -248,13 +250,13 @@ int LibusbDevice::SubmitTransfer(std::unique_ptr<IntrMessage> cmd)
   if (!m_device_attached)
     return LIBUSB_ERROR_NOT_FOUND;
 
-  libusb_transfer* transfer = libusb_alloc_transfer(0);
-  libusb_fill_interrupt_transfer(transfer, m_handle, cmd->endpoint,
-                                 cmd->MakeBuffer(cmd->length).release(), cmd->length,
-                                 TransferCallback, this, 0);
-  transfer->flags |= LIBUSB_TRANSFER_FREE_TRANSFER;
-  m_transfer_endpoints[transfer->endpoint].AddTransfer(std::move(cmd), transfer);
-  return libusb_submit_transfer(transfer);
+  const u8 endpoint = cmd->endpoint;
+  const u32 length = cmd->length;
+  std::unique_ptr<Transfer> transfer = AcquireTransfer(std::move(cmd));
+  libusb_fill_interrupt_transfer(transfer->transfer, m_handle, endpoint,
+                                 GetTransferBuffer(transfer.get(), endpoint, length), length,
+                                 TransferCallback, transfer.get(), 0);
+  return SubmitTransfer(endpoint, std::move(transfer));
 }
 
 int LibusbDevice::SubmitTransfer(std::unique_ptr<IsoMessage> cmd)
@@ -262,28 +264,102 @@ int LibusbDevice::SubmitTransfer(std::unique_ptr<IsoMessage> cmd)
   if (!m_device_attached)
     return LIBUSB_ERROR_NOT_FOUND;
 
-  libusb_transfer* transfer = libusb_alloc_transfer(cmd->num_packets);
-  transfer->buffer = cmd->MakeBuffer(cmd->length).release();
-  transfer->callback = TransferCallback;
-  transfer->dev_handle = m_handle;
-  transfer->endpoint = cmd->endpoint;
-  transfer->flags |= LIBUSB_TRANSFER_FREE_TRANSFER;
-  for (size_t i = 0; i < cmd->num_packets; ++i)
-    transfer->iso_packet_desc[i].length = cmd->packet_sizes[i];
-  transfer->length = cmd->length;
-  transfer->num_iso_packets = cmd->num_packets;
-  transfer->timeout = 0;
-  transfer->type = LIBUSB_TRANSFER_TYPE_ISOCHRONOUS;
-  transfer->user_data = this;
-  m_transfer_endpoints[transfer->endpoint].AddTransfer(std::move(cmd), transfer);
-  return libusb_submit_transfer(transfer);
+  const int num_packets = cmd->num_packets;
+  std::unique_ptr<Transfer> transfer = AcquireTransfer(std::move(cmd), num_packets);
+  const IsoMessage& message = static_cast<const IsoMessage&>(*transfer->command);
+  libusb_transfer* iso_transfer = transfer->transfer;
+  iso_transfer->buffer = GetTransferBuffer(transfer.get(), message.endpoint, message.length);
+  iso_transfer->callback = TransferCallback;
+  iso_transfer->dev_handle = m_handle;
+  iso_transfer->endpoint = message.endpoint;
+  for (size_t i = 0; i < message.num_packets; ++i)
+    iso_transfer->iso_packet_desc[i].length = message.packet_sizes[i];
+  iso_transfer->length = message.length;
+  iso_transfer->num_iso_packets = num_packets;
+  iso_transfer->timeout = 0;
+  iso_transfer->type = LIBUSB_TRANSFER_TYPE_ISOCHRONOUS;
+  iso_transfer->user_data = transfer.get();
+  return SubmitTransfer(message.endpoint, std::move(transfer));
+}
+
+LibusbDevice::Transfer::Transfer(LibusbDevice* device_, int iso_packets)
+    : device(device_), transfer(libusb_alloc_transfer(iso_packets))
+{
+}
+
+LibusbDevice::Transfer::~Transfer()
+{
+  libusb_free_transfer(transfer);
+}
+
+std::unique_ptr<LibusbDevice::Transfer>
+LibusbDevice::AcquireTransfer(std::unique_ptr<TransferCommand> command, int iso_packets)
+{
+  std::unique_ptr<Transfer> transfer;
+  if (iso_packets == 0)
+  {
+    std::lock_guard<std::mutex> lk{m_transfer_pool_mutex};
+    if (!m_transfer_pool.empty())
+    {
+      transfer = std::move(m_transfer_pool.back());
+      m_transfer_pool.pop_back();
+    }
+  }
+  if (!transfer)
+    transfer = std::make_unique<Transfer>(this, iso_packets);
+
+  transfer->command = std::move(command);
+  transfer->direct = false;
+  return transfer;
+}
+
+void LibusbDevice::ReleaseTransfer(std::unique_ptr<Transfer> transfer)
+{
+  if (transfer->transfer->num_iso_packets != 0)
+    return;
+
+  transfer->command.reset();
+  std::lock_guard<std::mutex> lk{m_transfer_pool_mutex};
+  m_transfer_pool.push_back(std::move(transfer));
+}
+
+u8* LibusbDevice::GetTransferBuffer(Transfer* transfer, u8 endpoint, u32 size)
+{
+  const u32 address = transfer->command->data_address;
+  if ((endpoint & LIBUSB_ENDPOINT_IN) == 0 && size != 0)
+  {
+    u8* pointer = Memory::GetPointerForRange(address, size);
+    if (pointer)
+    {
+      transfer->direct = true;
+      return pointer;
+    }
+  }
+
+  if (transfer->buffer.size() < size)
+    transfer->buffer.resize(size);
+  if ((endpoint & LIBUSB_ENDPOINT_IN) == 0)
+    Memory::CopyFromEmu(transfer->buffer.data(), address, size);
+  return transfer->buffer.data();
+}
+
+int LibusbDevice::SubmitTransfer(u8 endpoint, std::unique_ptr<Transfer> transfer)
+{
+  libusb_transfer* libusb_transfer = transfer->transfer;
+  TransferEndpoint& transfer_endpoint = m_transfer_endpoints[endpoint];
+  transfer_endpoint.AddTransfer(std::move(transfer));
+  const int ret = libusb_submit_transfer(libusb_transfer);
+  if (ret < 0)
+    transfer_endpoint.RemoveTransfer(libusb_transfer);
+  return ret;
 }
 
 void LibusbDevice::CtrlTransferCallback(libusb_transfer* transfer)
 {
-  auto* device = static_cast<LibusbDevice*>(transfer->user_data);
-  device->m_transfer_endpoints[0].HandleTransfer(transfer, [&](const auto& cmd) {
-    cmd.FillBuffer(libusb_control_transfer_get_data(transfer), transfer->actual_length);
+  auto* device = static_cast<Transfer*>(transfer->user_data)->device;
+  device->m_transfer_endpoints[0].HandleTransfer(transfer, [&](const Transfer& pending) {
+    pending.command->FillBuffer(libusb_control_transfer_get_data(transfer),
+                                transfer->actual_length);
     // The return code is the total transfer length -- *including* the setup packet.
     return transfer->length;
   });
@@ -291,14 +367,19 @@ void LibusbDevice::CtrlTransferCallback(libusb_transfer* transfer)
 
 void LibusbDevice::TransferCallback(libusb_transfer* transfer)
 {
-  auto* device = static_cast<LibusbDevice*>(transfer->user_data);
-  device->m_transfer_endpoints[transfer->endpoint].HandleTransfer(transfer, [&](const auto& cmd) {
+  auto* device = static_cast<Transfer*>(transfer->user_data)->device;
+  TransferEndpoint& endpoint = device->m_transfer_endpoints[transfer->endpoint];
+  endpoint.HandleTransfer(transfer, [&](const Transfer& pending) {
+    // Data sent to the device doesn't need to be copied back.
+    const bool copy = (transfer->endpoint & LIBUSB_ENDPOINT_IN) != 0;
+    const TransferCommand& cmd = *pending.command;
     switch (transfer->type)
     {
     case LIBUSB_TRANSFER_TYPE_ISOCHRONOUS:
     {
       auto& iso_msg = static_cast<const IsoMessage&>(cmd);
-      cmd.FillBuffer(transfer->buffer, iso_msg.length);
+      if (copy)
+        cmd.FillBuffer(transfer->buffer, iso_msg.length);
       for (size_t i = 0; i < iso_msg.num_packets; ++i)
         iso_msg.SetPacketReturnValue(i, transfer->iso_packet_desc[i].actual_length);
       // Note: isochronous transfers *must* return 0 as the return value. Anything else
@@ -306,7 +387,8 @@ void LibusbDevice::TransferCallback(libusb_transfer* transfer)
       return static_cast<s32>(IPC_SUCCESS);
     }
     default:
-      cmd.FillBuffer(transfer->buffer, transfer->actual_length);
+      if (copy)
+        cmd.FillBuffer(transfer->buffer, transfer->actual_length);
       return static_cast<s32>(transfer->actual_length);
     }
   });
@@ -319,15 +401,27 @@ static const std::map<u8, const char*> s_transfer_types = {
     {LIBUSB_TRANSFER_TYPE_INTERRUPT, "Interrupt"},
 };
 
-void LibusbDevice::TransferEndpoint::AddTransfer(std::unique_ptr<TransferCommand> command,
-                                                 libusb_transfer* transfer)
+void LibusbDevice::TransferEndpoint::AddTransfer(std::unique_ptr<Transfer> transfer)
 {
   std::lock_guard<std::mutex> lk{m_transfers_mutex};
-  m_transfers.emplace(transfer, std::move(command));
+  libusb_transfer* key = transfer->transfer;
+  m_transfers.emplace(key, std::move(transfer));
+}
+
+void LibusbDevice::TransferEndpoint::RemoveTransfer(libusb_transfer* transfer)
+{
+  std::lock_guard<std::mutex> lk{m_transfers_mutex};
+  const auto iterator = m_transfers.find(transfer);
+  if (iterator == m_transfers.end())
+    return;
+
+  LibusbDevice* device = iterator->second->device;
+  device->ReleaseTransfer(std::move(iterator->second));
+  m_transfers.erase(iterator);
 }
 
 void LibusbDevice::TransferEndpoint::HandleTransfer(libusb_transfer* transfer,
-                                                    std::function<s32(const TransferCommand&)> fn)
+                                                    std::function<s32(const Transfer&)> fn)
 {
   std::lock_guard<std::mutex> lk{m_transfers_mutex};
   const auto iterator = m_transfers.find(transfer);
@@ -337,14 +431,14 @@ void LibusbDevice::TransferEndpoint::HandleTransfer(libusb_transfer* transfer,
     return;
   }
 
-  const std::unique_ptr<u8[]> buffer(transfer->buffer);
-  const auto& cmd = *iterator->second.get();
-  const auto* device = static_cast<LibusbDevice*>(transfer->user_data);
+  const Transfer& pending = *iterator->second;
+  const auto& cmd = *pending.command;
+  LibusbDevice* device = pending.device;
   s32 return_value = 0;
   switch (transfer->status)
   {
   case LIBUSB_TRANSFER_COMPLETED:
-    return_value = fn(cmd);
+    return_value = fn(pending);
     break;
   case LIBUSB_TRANSFER_ERROR:
   case LIBUSB_TRANSFER_CANCELLED:
@@ -361,7 +455,8 @@ void LibusbDevice::TransferEndpoint::HandleTransfer(libusb_transfer* transfer,
     break;
   }
   cmd.OnTransferComplete(return_value);
-  m_transfers.erase(transfer);
+  device->ReleaseTransfer(std::move(iterator->second));
+  m_transfers.erase(iterator);
 }
 
 void LibusbDevice::TransferEndpoint::CancelTransfers()
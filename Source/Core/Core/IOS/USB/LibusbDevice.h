@@ -73,21 +73,49 @@ private:
   libusb_device* m_device = nullptr;
   libusb_device_handle* m_handle = nullptr;
 
+  // Transfers and their host buffers are reused by the following requests, except those with
+  // isochronous packets.
+  struct Transfer
+  {
+    Transfer(LibusbDevice* device_, int iso_packets);
+    ~Transfer();
+
+    LibusbDevice* device;
+    libusb_transfer* transfer;
+    std::unique_ptr<TransferCommand> command;
+    std::vector<u8> buffer;
+    // Whether the transfer reads the emulated memory directly, instead of the buffer.
+    bool direct = false;
+  };
+
   class TransferEndpoint final
   {
   public:
-    void AddTransfer(std::unique_ptr<TransferCommand> command, libusb_transfer* transfer);
-    void HandleTransfer(libusb_transfer* tr, std::function<s32(const TransferCommand&)> function);
+    void AddTransfer(std::unique_ptr<Transfer> transfer);
+    void RemoveTransfer(libusb_transfer* transfer);
+    void HandleTransfer(libusb_transfer* tr, std::function<s32(const Transfer&)> function);
     void CancelTransfers();
 
   private:
     std::mutex m_transfers_mutex;
-    std::map<libusb_transfer*, std::unique_ptr<TransferCommand>> m_transfers;
+    std::map<libusb_transfer*, std::unique_ptr<Transfer>> m_transfers;
   };
   std::map<u8, TransferEndpoint> m_transfer_endpoints;
   static void CtrlTransferCallback(libusb_transfer* transfer);
   static void TransferCallback(libusb_transfer* transfer);
 
+  std::unique_ptr<Transfer> AcquireTransfer(std::unique_ptr<TransferCommand> command,
+                                            int iso_packets = 0);
+  void ReleaseTransfer(std::unique_ptr<Transfer> transfer);
+  // Data sent to the device is read straight from the emulated memory. Received data goes through
+  // the buffer of the transfer: the kernel can't write to pages protected for dirty page tracking,
+  // and they may be protected again by another thread while the transfer is in flight.
+  u8* GetTransferBuffer(Transfer* transfer, u8 endpoint, u32 size);
+  int SubmitTransfer(u8 endpoint, std::unique_ptr<Transfer> transfer);
+
+  std::mutex m_transfer_pool_mutex;
+  std::vector<std::unique_ptr<Transfer>> m_transfer_pool;
+
   int AttachInterface(u8 interface);
   int DetachInterface();
 };
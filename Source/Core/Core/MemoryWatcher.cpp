@@ -2,21 +2,61 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
 #include <fstream>
 #include <iostream>
 #include <memory>
+#include <new>
+#include <set>
 #include <sstream>
+#include <sys/mman.h>
 #include <unistd.h>
 
+#include "Common/CommonTypes.h"
 #include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+#include "Common/Swap.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/CoreTiming.h"
 #include "Core/HW/Memmap.h"
 #include "Core/HW/SystemTimers.h"
 #include "Core/MemoryWatcher.h"
+#include "Core/Movie.h"
+
+static_assert(sizeof(MemoryWatcher::RingHeader) == 64, "RingHeader should be 64 bytes");
+static_assert(sizeof(MemoryWatcher::RingRecord) == 24, "RingRecord should be 24 bytes");
+static_assert((MemoryWatcher::RING_CAPACITY & (MemoryWatcher::RING_CAPACITY - 1)) == 0,
+              "The ring capacity should be a power of two");
 
 static std::unique_ptr<MemoryWatcher> s_memory_watcher;
 static CoreTiming::EventType* s_event;
 static const int MW_RATE = 600;  // Steps per second
+// Watched words this close to each other are compared as one block
+static const u32 MW_BLOCK_GAP = 64;
+
+// Like Memory::GetPointer, but without an alert for words outside of RAM, which read as 0
+static const u8* GetHostPointer(u32 address)
+{
+  address &= 0x3FFFFFFF;
+  if (address <= Memory::REALRAM_SIZE - sizeof(u32))
+    return Memory::m_pRAM + address;
+
+  if (Memory::m_pEXRAM && (address >> 28) == 0x1 &&
+      (address & 0x0FFFFFFF) <= Memory::EXRAM_SIZE - sizeof(u32))
+  {
+    return Memory::m_pEXRAM + (address & Memory::EXRAM_MASK);
+  }
+
+  return nullptr;
+}
+
+static u32 ReadWord(u32 address)
+{
+  const u8* host = GetHostPointer(address);
+  return host ? Common::swap32(host) : 0;
+}
 
 static void MWCallback(u64 userdata, s64 cyclesLate)
 {
@@ -42,18 +82,25 @@ MemoryWatcher::MemoryWatcher()
   m_running = false;
   if (!LoadAddresses(File::GetUserPath(F_MEMORYWATCHERLOCATIONS_IDX)))
     return;
-  if (!OpenSocket(File::GetUserPath(F_MEMORYWATCHERSOCKET_IDX)))
+  if (Config::Get(Config::MAIN_MEMORY_WATCHER_RING))
+  {
+    if (!OpenRing(File::GetUserPath(F_MEMORYWATCHERRING_IDX)))
+      return;
+  }
+  else if (!OpenSocket(File::GetUserPath(F_MEMORYWATCHERSOCKET_IDX)))
+  {
     return;
+  }
   m_running = true;
 }
 
 MemoryWatcher::~MemoryWatcher()
 {
-  if (!m_running)
-    return;
-
   m_running = false;
-  close(m_fd);
+  if (m_fd >= 0)
+    close(m_fd);
+  if (m_ring)
+    munmap(m_ring, m_ring_size);
 }
 
 bool MemoryWatcher::LoadAddresses(const std::string& path)
@@ -62,23 +109,35 @@ bool MemoryWatcher::LoadAddresses(const std::string& path)
   if (!locations)
     return false;
 
+  std::set<std::string> lines;
   std::string line;
-  while (std::getline(locations, line))
-    ParseLine(line);
+  for (u32 line_number = 0; std::getline(locations, line); ++line_number)
+  {
+    if (lines.insert(line).second)
+      ParseLine(line, line_number);
+  }
 
-  return m_values.size() > 0;
+  return m_watches.size() > 0;
 }
 
-void MemoryWatcher::ParseLine(const std::string& line)
+void MemoryWatcher::ParseLine(const std::string& line, u32 line_number)
 {
-  m_values[line] = 0;
-  m_addresses[line] = std::vector<u32>();
+  Watch watch;
+  watch.line = line;
+  watch.line_number = line_number;
 
   std::stringstream offsets(line);
   offsets >> std::hex;
   u32 offset;
   while (offsets >> offset)
-    m_addresses[line].push_back(offset);
+    watch.offsets.push_back(offset);
+
+  if (watch.offsets.empty())
+    return;
+
+  watch.addresses.resize(watch.offsets.size());
+  watch.values.resize(watch.offsets.size());
+  m_watches.push_back(std::move(watch));
 }
 
 bool MemoryWatcher::OpenSocket(const std::string& path)
@@ -91,12 +150,88 @@ bool MemoryWatcher::OpenSocket(const std::string& path)
   return m_fd >= 0;
 }
 
-u32 MemoryWatcher::ChasePointer(const std::string& line)
+bool MemoryWatcher::OpenRing(const std::string& path)
+{
+  File::CreateFullPath(path);
+  const int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0)
+  {
+    ERROR_LOG(CORE, "Failed to create the memory watcher ring %s", path.c_str());
+    return false;
+  }
+
+  m_ring_size = sizeof(RingHeader) + sizeof(RingRecord) * RING_CAPACITY;
+  void* ring = MAP_FAILED;
+  if (ftruncate(fd, static_cast<off_t>(m_ring_size)) == 0)
+    ring = mmap(nullptr, m_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  // The mapping outlives the descriptor.
+  close(fd);
+  if (ring == MAP_FAILED)
+  {
+    ERROR_LOG(CORE, "Failed to map the memory watcher ring %s", path.c_str());
+    return false;
+  }
+
+  m_ring = ring;
+  RingHeader* header = new (m_ring) RingHeader;
+  header->version = RING_VERSION;
+  header->record_size = sizeof(RingRecord);
+  header->capacity = RING_CAPACITY;
+  header->write_count.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  header->magic = RING_MAGIC;
+  return true;
+}
+
+// Follows the pointer chain from the given level on, and returns whether any address in it moved.
+bool MemoryWatcher::ChasePointer(Watch& watch, size_t level)
 {
-  u32 value = 0;
-  for (u32 offset : m_addresses[line])
-    value = Memory::Read_U32(value + offset);
-  return value;
+  bool moved = false;
+  for (size_t i = level; i < watch.offsets.size(); ++i)
+  {
+    const u32 address = (i == 0 ? 0 : watch.values[i - 1]) + watch.offsets[i];
+    moved |= address != watch.addresses[i];
+    watch.addresses[i] = address;
+    watch.values[i] = ReadWord(address);
+  }
+  return moved;
+}
+
+void MemoryWatcher::BuildBlocks()
+{
+  std::vector<Block::Reader> readers;
+  for (size_t i = 0; i < m_watches.size(); ++i)
+  {
+    const Watch& watch = m_watches[i];
+    for (size_t level = 0; level < watch.addresses.size(); ++level)
+    {
+      if (GetHostPointer(watch.addresses[level]))
+        readers.push_back({watch.addresses[level], i, level});
+    }
+  }
+  std::sort(readers.begin(), readers.end(),
+            [](const Block::Reader& a, const Block::Reader& b) { return a.address < b.address; });
+
+  m_blocks.clear();
+  u32 block_end = 0;
+  for (const Block::Reader& reader : readers)
+  {
+    const u8* host = GetHostPointer(reader.address);
+    // Mirrors of RAM don't have to be contiguous in host memory.
+    if (m_blocks.empty() || reader.address > block_end + MW_BLOCK_GAP ||
+        host - m_blocks.back().host != reader.address - m_blocks.back().address)
+    {
+      m_blocks.push_back({reader.address, host, {}, {}});
+      block_end = reader.address;
+    }
+    block_end = std::max<u32>(block_end, reader.address + sizeof(u32));
+    m_blocks.back().readers.push_back(reader);
+    m_blocks.back().contents.resize(block_end - m_blocks.back().address);
+  }
+
+  for (Block& block : m_blocks)
+    std::memcpy(block.contents.data(), block.host, block.contents.size());
+  m_blocks_dirty = false;
 }
 
 std::string MemoryWatcher::ComposeMessage(const std::string& line, u32 value)
@@ -106,24 +241,92 @@ std::string MemoryWatcher::ComposeMessage(const std::string& line, u32 value)
   return message_stream.str();
 }
 
+void MemoryWatcher::WriteRecord(const Watch& watch)
+{
+  RingHeader* header = static_cast<RingHeader*>(m_ring);
+  RingRecord* records = reinterpret_cast<RingRecord*>(header + 1);
+
+  // Only this thread writes, so the count can't change under us.
+  const u64 count = header->write_count.load(std::memory_order_relaxed);
+  RingRecord& record = records[count & (RING_CAPACITY - 1)];
+  record.address = watch.addresses.back();
+  record.size = sizeof(u32);
+  record.value = watch.value;
+  record.line = watch.line_number;
+  record.frame = Movie::GetCurrentFrame();
+  header->write_count.store(count + 1, std::memory_order_release);
+}
+
+void MemoryWatcher::SendChanges()
+{
+  for (size_t index : m_changed_watches)
+  {
+    Watch& watch = m_watches[index];
+    watch.changed = false;
+    if (watch.values.back() == watch.value)
+      continue;
+
+    watch.value = watch.values.back();
+    if (m_ring)
+    {
+      WriteRecord(watch);
+      continue;
+    }
+
+    std::string message = ComposeMessage(watch.line, watch.value);
+    sendto(m_fd, message.c_str(), message.size() + 1, 0, reinterpret_cast<sockaddr*>(&m_addr),
+           sizeof(m_addr));
+  }
+  m_changed_watches.clear();
+}
+
 void MemoryWatcher::Step()
 {
   if (!m_running)
     return;
 
-  for (auto& entry : m_values)
+  // The first step follows every chain.
+  if (m_blocks_dirty && m_blocks.empty())
   {
-    std::string address = entry.first;
-    u32& current_value = entry.second;
+    for (size_t i = 0; i < m_watches.size(); ++i)
+    {
+      ChasePointer(m_watches[i], 0);
+      m_changed_watches.push_back(i);
+    }
+    SendChanges();
+    BuildBlocks();
+    return;
+  }
+
+  for (Block& block : m_blocks)
+  {
+    if (std::memcmp(block.host, block.contents.data(), block.contents.size()) == 0)
+      continue;
 
-    u32 new_value = ChasePointer(address);
-    if (new_value != current_value)
+    for (const Block::Reader& reader : block.readers)
     {
-      // Update the value
-      current_value = new_value;
-      std::string message = ComposeMessage(address, new_value);
-      sendto(m_fd, message.c_str(), message.size() + 1, 0, reinterpret_cast<sockaddr*>(&m_addr),
-             sizeof(m_addr));
+      Watch& watch = m_watches[reader.watch];
+      // The chain may have been followed elsewhere earlier in this step.
+      if (watch.addresses[reader.level] != reader.address)
+        continue;
+
+      const u32 offset = reader.address - block.address;
+      if (std::memcmp(block.host + offset, block.contents.data() + offset, sizeof(u32)) == 0)
+        continue;
+
+      watch.values[reader.level] = Common::swap32(block.host + offset);
+      if (ChasePointer(watch, reader.level + 1))
+        m_blocks_dirty = true;
+      if (!watch.changed)
+      {
+        watch.changed = true;
+        m_changed_watches.push_back(reader.watch);
+      }
     }
+    std::memcpy(block.contents.data(), block.host, block.contents.size());
   }
+
+  SendChanges();
+  if (m_blocks_dirty)
+    BuildBlocks();
 }
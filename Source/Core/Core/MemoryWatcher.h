@@ -4,11 +4,15 @@
 
 #pragma once
 
-#include <map>
+#include <atomic>
+#include <string>
 #include <sys/socket.h>
 #include <sys/un.h>
+#include <utility>
 #include <vector>
 
+#include "Common/CommonTypes.h"
+
 // MemoryWatcher reads a file containing in-game memory addresses and outputs
 // changes to those memory addresses to a unix domain socket as the game runs.
 //
@@ -17,9 +21,50 @@
 // "ABCD EF" will watch the address at (*0xABCD) + 0xEF.
 // The output to the socket is two lines. The first is the address from the
 // input file, and the second is the new value in hex.
+//
+// With Core.MemoryWatcherRing set, changes are instead written as binary
+// records to a ring in a shared file mapping, which tools can map and read
+// without any syscall. The file starts with a RingHeader, followed by the
+// records. To read it, load write_count (with acquire ordering), copy the
+// records up to it which haven't been read yet (record n is at n % capacity),
+// then load write_count again: any record n for which n + capacity is not
+// greater than that count may have been overwritten while being copied, and
+// has to be dropped.
+//
+// Rather than following every pointer on each step, the watched words are
+// grouped in blocks of memory which are compared with their contents from the
+// previous step, and only the words in blocks which changed are looked at.
+// The rest of a pointer chain is only followed again when a pointer in it
+// changes. (Page protection can't be used for this, as JIT fastmem writes
+// don't go through it and its faults are already used for backpatching.)
 class MemoryWatcher final
 {
 public:
+  static constexpr u32 RING_MAGIC = 0x5257444D;  // "MDWR"
+  static constexpr u32 RING_VERSION = 1;
+  static constexpr u32 RING_CAPACITY = 64 * 1024;
+
+  // Everything in the ring is in host byte order.
+  struct RingHeader
+  {
+    u32 magic;  // Written last, once the rest of the header is valid
+    u32 version;
+    u32 record_size;
+    u32 capacity;  // Number of records, a power of two
+    // Records written so far, incremented after each record is
+    std::atomic<u64> write_count;
+    u8 padding[40];
+  };
+
+  struct RingRecord
+  {
+    u32 address;  // Of the value, at the end of the pointer chain
+    u32 size;     // Of the value in bytes
+    u32 value;
+    u32 line;  // Line of the watch in the locations file, from 0
+    u64 frame;
+  };
+
   MemoryWatcher();
   ~MemoryWatcher();
   void Step();
@@ -28,20 +73,56 @@ public:
   static void Shutdown();
 
 private:
+  struct Watch
+  {
+    std::string line;  // Address as stored in the file
+    u32 line_number;
+    std::vector<u32> offsets;
+    // Address read at each level of the pointer chain, and the word read there
+    std::vector<u32> addresses;
+    std::vector<u32> values;
+    u32 value = 0;  // Last value sent
+    bool changed = false;
+  };
+
+  // Watched words close enough to each other to be compared together
+  struct Block
+  {
+    u32 address;
+    const u8* host;
+    std::vector<u8> contents;
+    // Address, watch index and chain level of each word read in the block
+    struct Reader
+    {
+      u32 address;
+      size_t watch;
+      size_t level;
+    };
+    std::vector<Reader> readers;
+  };
+
   bool LoadAddresses(const std::string& path);
   bool OpenSocket(const std::string& path);
+  bool OpenRing(const std::string& path);
 
-  void ParseLine(const std::string& line);
-  u32 ChasePointer(const std::string& line);
+  void ParseLine(const std::string& line, u32 line_number);
+  bool ChasePointer(Watch& watch, size_t level);
+  void BuildBlocks();
+  void SendChanges();
   std::string ComposeMessage(const std::string& line, u32 value);
+  void WriteRecord(const Watch& watch);
 
   bool m_running;
 
-  int m_fd;
+  int m_fd = -1;
   sockaddr_un m_addr;
 
-  // Address as stored in the file -> list of offsets to follow
-  std::map<std::string, std::vector<u32>> m_addresses;
-  // Address as stored in the file -> current value
-  std::map<std::string, u32> m_values;
+  void* m_ring = nullptr;
+  size_t m_ring_size = 0;
+
+  std::vector<Watch> m_watches;
+  std::vector<Block> m_blocks;
+  // Set when a pointer changed, so that the blocks no longer match what is watched
+  bool m_blocks_dirty = true;
+  std::vector<size_t> m_changed_watches;
 };
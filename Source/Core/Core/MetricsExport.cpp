@@ -0,0 +1,124 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Core/MetricsExport.h"
+
+#include <string>
+#include <thread>
+
+#include <SFML/Network.hpp>
+
+#include "Common/Flag.h"
+#include "Common/Logging/Log.h"
+#include "Common/Metrics.h"
+#include "Common/StringUtil.h"
+#include "Common/Thread.h"
+#include "Core/Config/MainSettings.h"
+
+namespace MetricsExport
+{
+// How long the server waits for a connection or a request before checking whether to stop.
+static const sf::Time POLL_TIMEOUT = sf::milliseconds(100);
+// Scrapers send short requests; anything longer isn't one.
+static constexpr size_t MAX_REQUEST_SIZE = 4096;
+
+static std::thread s_server_thread;
+static Common::Flag s_server_running;
+
+static std::string BuildResponse(const std::string& request)
+{
+  if (StringBeginsWith(request, "GET /metrics ") || StringBeginsWith(request, "GET /metrics?"))
+  {
+    const std::string body = Metrics::FormatPrometheus();
+    return StringFromFormat("HTTP/1.0 200 OK\r\n"
+                            "Content-Type: text/plain; version=0.0.4\r\n"
+                            "Content-Length: %zu\r\n"
+                            "Connection: close\r\n\r\n",
+                            body.size()) +
+           body;
+  }
+
+  return "HTTP/1.0 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+}
+
+static void HandleClient(sf::TcpSocket& client)
+{
+  sf::SocketSelector selector;
+  selector.add(client);
+
+  // Only the request line matters, so stop reading at the end of the headers.
+  std::string request;
+  while (s_server_running.IsSet() && request.find("\r\n\r\n") == std::string::npos &&
+         request.size() < MAX_REQUEST_SIZE)
+  {
+    if (!selector.wait(POLL_TIMEOUT))
+      continue;
+
+    char buffer[512];
+    size_t received = 0;
+    if (client.receive(buffer, sizeof(buffer), received) != sf::Socket::Done)
+      return;
+    request.append(buffer, received);
+  }
+
+  if (!s_server_running.IsSet())
+    return;
+
+  const std::string response = BuildResponse(request);
+  client.send(response.data(), response.size());
+}
+
+static void ServerThread(u16 port)
+{
+  Common::SetCurrentThreadName("Metrics Server");
+
+  sf::TcpListener listener;
+  if (listener.listen(port) != sf::Socket::Done)
+  {
+    ERROR_LOG(COMMON, "Metrics: failed to listen on TCP port %u", port);
+    return;
+  }
+  NOTICE_LOG(COMMON, "Metrics: serving /metrics on TCP port %u", port);
+
+  sf::SocketSelector selector;
+  selector.add(listener);
+  while (s_server_running.IsSet())
+  {
+    if (!selector.wait(POLL_TIMEOUT))
+      continue;
+
+    sf::TcpSocket client;
+    if (listener.accept(client) == sf::Socket::Done)
+    {
+      HandleClient(client);
+      client.disconnect();
+    }
+  }
+}
+
+void Init()
+{
+  const std::string& csv_path = Config::Get(Config::MAIN_METRICS_CSV_PATH);
+  if (!csv_path.empty() && !Metrics::SetCSVPath(csv_path))
+    ERROR_LOG(COMMON, "Metrics: failed to open %s", csv_path.c_str());
+
+  const int port = Config::Get(Config::MAIN_METRICS_PORT);
+  if (port <= 0 || port > 0xffff)
+    return;
+
+  s_server_running.Set();
+  s_server_thread = std::thread(ServerThread, static_cast<u16>(port));
+}
+
+void Shutdown()
+{
+  if (s_server_thread.joinable())
+  {
+    s_server_running.Clear();
+    s_server_thread.join();
+  }
+
+  Metrics::SetCSVPath("");
+}
+}  // namespace MetricsExport
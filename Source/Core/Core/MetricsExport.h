@@ -0,0 +1,15 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+// Exports the metrics of Common/Metrics.h while the emulation runs: over HTTP at /metrics, in the
+// Prometheus text format, if Core.MetricsPort is set, and as a CSV row per frame to
+// Core.MetricsCSVPath if it is set.
+
+#pragma once
+
+namespace MetricsExport
+{
+void Init();
+void Shutdown();
+}  // namespace MetricsExport
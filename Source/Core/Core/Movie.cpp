@@ -48,6 +48,7 @@
 #include "Core/HW/WiimoteEmu/WiimoteEmu.h"
 #include "Core/IOS/USB/Bluetooth/BTEmu.h"
 #include "Core/IOS/USB/Bluetooth/WiimoteDevice.h"
+#include "Core/MovieFile.h"
 #include "Core/NetPlayProto.h"
 #include "Core/State.h"
 
@@ -76,6 +77,10 @@ static u8 s_controllers = 0;
 static ControllerState s_padState;
 static DTMHeader tmpHeader;
 static std::vector<u8> s_temp_input;
+// Where chunks of the recorded input start, for chunked movies
+static std::vector<DTMChunkStart> s_chunk_starts;
+// Streams the input of a chunked movie during playback, instead of s_temp_input
+static std::unique_ptr<DTMInputReader> s_input_reader;
 static u64 s_currentByte = 0;
 static u64 s_currentFrame = 0, s_totalFrames = 0;  // VI
 static u64 s_currentLagCount = 0;
@@ -104,6 +109,7 @@ static std::string s_InputDisplay[8];
 
 static GCManipFunction s_gc_manip_func;
 static WiiManipFunction s_wii_manip_func;
+static PlaybackEndedFunction s_playback_ended_func;
 
 static std::string s_current_file_name;
 
@@ -113,6 +119,66 @@ static bool IsMovieHeader(u8 magic[4])
   return magic[0] == 'D' && magic[1] == 'T' && magic[2] == 'M' && magic[3] == 0x1A;
 }
 
+static bool IsSupportedVersion(u8 version)
+{
+  return version == 0 || version == DTM_VERSION_CHUNKED;
+}
+
+static u64 GetInputSize()
+{
+  return s_input_reader ? s_input_reader->GetInputSize() : s_temp_input.size();
+}
+
+static bool ReadInput(u64 offset, void* data, size_t size)
+{
+  if (s_input_reader)
+    return s_input_reader->Read(offset, static_cast<u8*>(data), size);
+
+  if (offset > s_temp_input.size() || size > s_temp_input.size() - offset)
+    return false;
+  std::memcpy(data, s_temp_input.data() + offset, size);
+  return true;
+}
+
+static std::vector<DTMChunkStart> GetKnownChunkStarts(const DTMInputReader& reader)
+{
+  std::vector<DTMChunkStart> starts;
+  for (const DTMChunkEntry& entry : reader.GetChunks())
+  {
+    if (entry.start.frame != DTM_UNKNOWN_FRAME)
+      starts.push_back(entry.start);
+  }
+  return starts;
+}
+
+// Recording appends to s_temp_input, so a streamed movie has to be loaded fully first.
+static bool LoadAllInput()
+{
+  if (!s_input_reader)
+    return true;
+
+  s_chunk_starts = GetKnownChunkStarts(*s_input_reader);
+  s_temp_input.resize(static_cast<size_t>(s_input_reader->GetInputSize()));
+  const bool success = s_input_reader->Read(0, s_temp_input.data(), s_temp_input.size());
+  s_input_reader.reset();
+  return success;
+}
+
+// Starts a new chunk at the current input boundary, once the last one is large enough.
+static void UpdateChunkStarts()
+{
+  // The input after the current byte is being recorded over.
+  while (!s_chunk_starts.empty() && s_chunk_starts.back().input_offset >= s_currentByte)
+    s_chunk_starts.pop_back();
+
+  if (s_chunk_starts.empty() ||
+      s_currentByte - s_chunk_starts.back().input_offset >= DTM_CHUNK_SIZE)
+  {
+    s_chunk_starts.push_back(
+        {s_currentByte, s_currentFrame, s_currentInputCount, s_currentLagCount});
+  }
+}
+
 static std::array<u8, 20> ConvertGitRevisionToBytes(const std::string& revision)
 {
   std::array<u8, 20> revision_bytes{};
@@ -578,6 +644,8 @@ bool BeginRecordingInput(int controllers)
     s_playMode = MODE_RECORDING;
     s_author = SConfig::GetInstance().m_strMovieAuthor;
     s_temp_input.clear();
+    s_chunk_starts.clear();
+    s_input_reader.reset();
 
     s_currentByte = 0;
 
@@ -842,6 +910,7 @@ void RecordInput(GCPadStatus* PadStatus, int controllerID)
 
   CheckPadStatus(PadStatus, controllerID);
 
+  UpdateChunkStarts();
   s_temp_input.resize(s_currentByte + sizeof(ControllerState));
   memcpy(&s_temp_input[s_currentByte], &s_padState, sizeof(ControllerState));
   s_currentByte += sizeof(ControllerState);
@@ -863,6 +932,7 @@ void RecordWiimote(int wiimote, u8* data, u8 size)
     return;
 
   InputUpdate();
+  UpdateChunkStarts();
   s_temp_input.resize(s_currentByte + size + 1);
   s_temp_input[s_currentByte++] = size;
   memcpy(&s_temp_input[s_currentByte], data, size);
@@ -910,12 +980,23 @@ bool PlayInput(const std::string& filename)
   if (!recording_file.ReadArray(&tmpHeader, 1))
     return false;
 
-  if (!IsMovieHeader(tmpHeader.filetype))
+  if (!IsMovieHeader(tmpHeader.filetype) || !IsSupportedVersion(tmpHeader.version))
   {
     PanicAlertT("Invalid recording file");
     return false;
   }
 
+  std::unique_ptr<DTMInputReader> input_reader;
+  if (tmpHeader.version == DTM_VERSION_CHUNKED)
+  {
+    input_reader = DTMInputReader::Open(filename, tmpHeader);
+    if (!input_reader)
+    {
+      PanicAlertT("Invalid recording file");
+      return false;
+    }
+  }
+
   ReadHeader();
   s_totalFrames = tmpHeader.frameCount;
   s_totalLagCount = tmpHeader.lagCount;
@@ -932,8 +1013,18 @@ bool PlayInput(const std::string& filename)
 
   Core::UpdateWantDeterminism();
 
-  s_temp_input.resize(recording_file.GetSize() - 256);
-  recording_file.ReadBytes(s_temp_input.data(), s_temp_input.size());
+  // Only the original format is read fully, chunked input is streamed from the file.
+  s_input_reader = std::move(input_reader);
+  s_chunk_starts.clear();
+  if (s_input_reader)
+  {
+    s_temp_input.clear();
+  }
+  else
+  {
+    s_temp_input.resize(recording_file.GetSize() - 256);
+    recording_file.ReadBytes(s_temp_input.data(), s_temp_input.size());
+  }
   s_currentByte = 0;
   recording_file.Close();
 
@@ -976,7 +1067,12 @@ void LoadInput(const std::string& filename)
 
   t_record.ReadArray(&tmpHeader, 1);
 
-  if (!IsMovieHeader(tmpHeader.filetype))
+  std::unique_ptr<DTMInputReader> state_reader;
+  if (IsMovieHeader(tmpHeader.filetype) && tmpHeader.version == DTM_VERSION_CHUNKED)
+    state_reader = DTMInputReader::Open(filename, tmpHeader);
+
+  if (!IsMovieHeader(tmpHeader.filetype) || !IsSupportedVersion(tmpHeader.version) ||
+      (tmpHeader.version == DTM_VERSION_CHUNKED && !state_reader))
   {
     PanicAlertT("Savestate movie %s is corrupted, movie recording stopping...", filename.c_str());
     EndPlayInput(false);
@@ -995,7 +1091,12 @@ void LoadInput(const std::string& filename)
   if (SConfig::GetInstance().bWii)
     ChangeWiiPads(true);
 
-  u64 totalSavedBytes = t_record.GetSize() - 256;
+  const auto read_saved_input = [&](u64 offset, u8* data, size_t size) {
+    if (state_reader)
+      return state_reader->Read(offset, data, size);
+    return t_record.Seek(sizeof(DTMHeader) + offset, SEEK_SET) && t_record.ReadBytes(data, size);
+  };
+  u64 totalSavedBytes = state_reader ? state_reader->GetInputSize() : t_record.GetSize() - 256;
 
   bool afterEnd = false;
   // This can only happen if the user manually deletes data from the dtm.
@@ -1008,42 +1109,64 @@ void LoadInput(const std::string& filename)
     afterEnd = true;
   }
 
-  if (!s_bReadOnly || s_temp_input.empty())
+  if (!s_bReadOnly || GetInputSize() == 0)
   {
     s_totalFrames = tmpHeader.frameCount;
     s_totalLagCount = tmpHeader.lagCount;
     s_totalInputCount = tmpHeader.inputCount;
     s_totalTickCount = s_tickCountAtLastInput = tmpHeader.tickCount;
 
+    // The savestate's movie can be overwritten by the next savestate, so it isn't streamed.
+    s_input_reader.reset();
+    s_chunk_starts.clear();
+    if (state_reader)
+      s_chunk_starts = GetKnownChunkStarts(*state_reader);
     s_temp_input.resize(static_cast<size_t>(totalSavedBytes));
-    t_record.ReadBytes(s_temp_input.data(), s_temp_input.size());
+    read_saved_input(0, s_temp_input.data(), s_temp_input.size());
   }
   else if (s_currentByte > 0)
   {
     if (s_currentByte > totalSavedBytes)
     {
     }
-    else if (s_currentByte > s_temp_input.size())
+    else if (s_currentByte > GetInputSize())
     {
       afterEnd = true;
       PanicAlertT("Warning: You loaded a save that's after the end of the current movie. (byte %u "
                   "> %zu) (input %u > %u). You should load another save before continuing, or load "
                   "this state with read-only mode off.",
-                  (u32)s_currentByte + 256, s_temp_input.size() + 256, (u32)s_currentInputCount,
+                  (u32)s_currentByte + 256, static_cast<size_t>(GetInputSize()) + 256,
+                  (u32)s_currentInputCount,
                   (u32)s_totalInputCount);
     }
-    else if (s_currentByte > 0 && !s_temp_input.empty())
+    else if (s_currentByte > 0 && GetInputSize() != 0)
     {
-      // verify identical from movie start to the save's current frame
-      std::vector<u8> movInput(s_currentByte);
-      t_record.ReadArray(movInput.data(), movInput.size());
+      // verify identical from movie start to the save's current frame, a chunk at a time
+      u64 mismatch_index = s_currentByte;
+      std::vector<u8> movInput(DTM_CHUNK_SIZE);
+      std::vector<u8> curInput(DTM_CHUNK_SIZE);
+      for (u64 offset = 0; offset < s_currentByte; offset += DTM_CHUNK_SIZE)
+      {
+        const size_t size =
+            static_cast<size_t>(std::min<u64>(DTM_CHUNK_SIZE, s_currentByte - offset));
+        if (!read_saved_input(offset, movInput.data(), size) ||
+            !ReadInput(offset, curInput.data(), size))
+        {
+          mismatch_index = offset;
+          break;
+        }
 
-      const auto result = std::mismatch(movInput.begin(), movInput.end(), s_temp_input.begin());
+        const auto result =
+            std::mismatch(movInput.begin(), movInput.begin() + size, curInput.begin());
+        if (result.first != movInput.begin() + size)
+        {
+          mismatch_index = offset + std::distance(movInput.begin(), result.first);
+          break;
+        }
+      }
 
-      if (result.first != movInput.end())
+      if (mismatch_index != s_currentByte)
       {
-        const ptrdiff_t mismatch_index = std::distance(movInput.begin(), result.first);
-
         // this is a "you did something wrong" alert for the user's benefit.
         // we'll try to say what's going on in excruciating detail, otherwise the user might not
         // believe us.
@@ -1057,17 +1180,17 @@ void LoadInput(const std::string& filename)
                       "read-only mode off. Otherwise you'll probably get a desync.",
                       byte_offset, byte_offset);
 
-          std::copy(movInput.begin(), movInput.end(), s_temp_input.begin());
+          LoadAllInput();
+          read_saved_input(0, s_temp_input.data(), static_cast<size_t>(s_currentByte));
         }
         else
         {
-          const ptrdiff_t frame = mismatch_index / sizeof(ControllerState);
-          ControllerState curPadState;
-          memcpy(&curPadState, &s_temp_input[frame * sizeof(ControllerState)],
-                 sizeof(ControllerState));
-          ControllerState movPadState;
-          memcpy(&movPadState, &s_temp_input[frame * sizeof(ControllerState)],
-                 sizeof(ControllerState));
+          const ptrdiff_t frame = static_cast<ptrdiff_t>(mismatch_index / sizeof(ControllerState));
+          ControllerState curPadState = {};
+          ReadInput(frame * sizeof(ControllerState), &curPadState, sizeof(ControllerState));
+          ControllerState movPadState = {};
+          read_saved_input(frame * sizeof(ControllerState), reinterpret_cast<u8*>(&movPadState),
+                           sizeof(ControllerState));
           PanicAlertT(
               "Warning: You loaded a save whose movie mismatches on frame %td. You should load "
               "another save before continuing, or load this state with read-only mode off. "
@@ -1132,7 +1255,7 @@ void LoadInput(const std::string& filename)
 // NOTE: CPU Thread
 static void CheckInputEnd()
 {
-  if (s_currentByte >= s_temp_input.size() ||
+  if (s_currentByte >= GetInputSize() ||
       (CoreTiming::GetTicks() > s_totalTickCount && !IsRecordingInputFromSaveState()))
   {
     EndPlayInput(!s_bReadOnly);
@@ -1144,24 +1267,32 @@ void PlayController(GCPadStatus* PadStatus, int controllerID)
 {
   // Correct playback is entirely dependent on the emulator polling the controllers
   // in the same order done during recording
-  if (!IsPlayingInput() || !IsUsingPad(controllerID) || s_temp_input.empty())
+  if (!IsPlayingInput() || !IsUsingPad(controllerID) || GetInputSize() == 0)
     return;
 
-  if (s_currentByte + sizeof(ControllerState) > s_temp_input.size())
+  if (s_currentByte + sizeof(ControllerState) > GetInputSize())
   {
     PanicAlertT("Premature movie end in PlayController. %u + %zu > %zu", (u32)s_currentByte,
-                sizeof(ControllerState), s_temp_input.size());
+                sizeof(ControllerState), static_cast<size_t>(GetInputSize()));
     EndPlayInput(!s_bReadOnly);
     return;
   }
 
+  ControllerState pad_state;
+  if (!ReadInput(s_currentByte, &pad_state, sizeof(ControllerState)))
+  {
+    PanicAlertT("Failed to read the movie input at byte %u.", (u32)s_currentByte);
+    EndPlayInput(false);
+    return;
+  }
+
   // dtm files don't save the mic button or error bit. not sure if they're actually used, but better
   // safe than sorry
   signed char e = PadStatus->err;
   memset(PadStatus, 0, sizeof(GCPadStatus));
   PadStatus->err = e;
 
-  memcpy(&s_padState, &s_temp_input[s_currentByte], sizeof(ControllerState));
+  s_padState = pad_state;
   s_currentByte += sizeof(ControllerState);
 
   PadStatus->triggerLeft = s_padState.TriggerL;
@@ -1245,20 +1376,26 @@ void PlayController(GCPadStatus* PadStatus, int controllerID)
 bool PlayWiimote(int wiimote, u8* data, const WiimoteEmu::ReportFeatures& rptf, int ext,
                  const wiimote_key key)
 {
-  if (!IsPlayingInput() || !IsUsingWiimote(wiimote) || s_temp_input.empty())
+  if (!IsPlayingInput() || !IsUsingWiimote(wiimote) || GetInputSize() == 0)
     return false;
 
-  if (s_currentByte > s_temp_input.size())
+  if (s_currentByte > GetInputSize())
   {
     PanicAlertT("Premature movie end in PlayWiimote. %u > %zu", (u32)s_currentByte,
-                s_temp_input.size());
+                static_cast<size_t>(GetInputSize()));
     EndPlayInput(!s_bReadOnly);
     return false;
   }
 
   u8 size = rptf.size;
 
-  u8 sizeInMovie = s_temp_input[s_currentByte];
+  u8 sizeInMovie = 0;
+  if (!ReadInput(s_currentByte, &sizeInMovie, 1))
+  {
+    PanicAlertT("Failed to read the movie input at byte %u.", (u32)s_currentByte);
+    EndPlayInput(false);
+    return false;
+  }
 
   if (size != sizeInMovie)
   {
@@ -1274,15 +1411,20 @@ bool PlayWiimote(int wiimote, u8* data, const WiimoteEmu::ReportFeatures& rptf,
 
   s_currentByte++;
 
-  if (s_currentByte + size > s_temp_input.size())
+  if (s_currentByte + size > GetInputSize())
   {
     PanicAlertT("Premature movie end in PlayWiimote. %u + %d > %zu", (u32)s_currentByte, size,
-                s_temp_input.size());
+                static_cast<size_t>(GetInputSize()));
     EndPlayInput(!s_bReadOnly);
     return false;
   }
 
-  memcpy(data, &s_temp_input[s_currentByte], size);
+  if (!ReadInput(s_currentByte, data, size))
+  {
+    PanicAlertT("Failed to read the movie input at byte %u.", (u32)s_currentByte);
+    EndPlayInput(false);
+    return false;
+  }
   s_currentByte += size;
 
   s_currentInputCount++;
@@ -1299,6 +1441,8 @@ void EndPlayInput(bool cont)
     // If !IsMovieActive(), changing s_playMode requires calling UpdateWantDeterminism
     _assert_(IsMovieActive());
 
+    if (!LoadAllInput())
+      PanicAlertT("Failed to read the movie input, the recording will be incomplete.");
     s_playMode = MODE_RECORDING;
     Core::DisplayMessage("Reached movie end. Resuming recording.", 2000);
   }
@@ -1324,6 +1468,9 @@ void EndPlayInput(bool cont)
       if (was_running && !SConfig::GetInstance().m_PauseMovie)
         CPU::EnableStepping(false);
     });
+
+    if (s_playback_ended_func)
+      s_playback_ended_func();
   }
 }
 
@@ -1369,9 +1516,33 @@ void SaveRecording(const std::string& filename)
   header.uniqueID = 0;
   // header.audioEmulator;
 
-  save_record.WriteArray(&header, 1);
-
-  bool success = save_record.WriteBytes(s_temp_input.data(), s_temp_input.size());
+  // This is called by the savestate thread while the CPU thread plays the movie back, so a
+  // streamed movie is read through a reader of its own.
+  std::unique_ptr<DTMInputReader> input_reader =
+      s_input_reader ? s_input_reader->Clone() : nullptr;
+  const u64 input_size = GetInputSize();
+  const DTMInputReadFunction read_input = [&input_reader](u64 offset, u8* data, size_t size) {
+    return input_reader ? input_reader->Read(offset, data, size) : ReadInput(offset, data, size);
+  };
+
+  bool success;
+  if (Config::Get(Config::MAIN_MOVIE_CHUNKED_INPUT))
+  {
+    success = WriteChunkedDTM(save_record, header, input_size,
+                              input_reader ? GetKnownChunkStarts(*input_reader) : s_chunk_starts,
+                              read_input);
+  }
+  else
+  {
+    success = save_record.WriteArray(&header, 1);
+    std::vector<u8> block(DTM_CHUNK_SIZE);
+    for (u64 offset = 0; success && offset < input_size; offset += block.size())
+    {
+      const size_t size = static_cast<size_t>(std::min<u64>(block.size(), input_size - offset));
+      success =
+          read_input(offset, block.data(), size) && save_record.WriteBytes(block.data(), size);
+    }
+  }
 
   if (success && s_bRecordingFromSaveState)
   {
@@ -1393,6 +1564,10 @@ void SetWiiInputManip(WiiManipFunction func)
 {
   s_wii_manip_func = std::move(func);
 }
+void SetPlaybackEndedCallback(PlaybackEndedFunction func)
+{
+  s_playback_ended_func = std::move(func);
+}
 
 // NOTE: CPU Thread
 void CallGCInputManip(GCPadStatus* PadStatus, int controllerID)
@@ -1525,5 +1700,7 @@ void Shutdown()
 {
   s_currentInputCount = s_totalInputCount = s_totalFrames = s_tickCountAtLastInput = 0;
   s_temp_input.clear();
+  s_chunk_starts.clear();
+  s_input_reader.reset();
 }
 };
@@ -104,7 +104,9 @@ struct DTMHeader
   u32 DSPiromHash;
   u32 DSPcoefHash;
   u64 tickCount;     // Number of ticks in the recording
-  u8 reserved2[11];  // Make heading 256 bytes, just because we can
+  u8 version;        // 0 for the original format, DTM_VERSION_CHUNKED for chunked input
+  u64 indexOffset;   // File offset of the chunk index, if the input is chunked
+  u8 reserved2[2];   // Make heading 256 bytes, just because we can
 };
 static_assert(sizeof(DTMHeader) == 256, "DTMHeader should be 256 bytes");
 
@@ -185,4 +187,9 @@ void SetWiiInputManip(WiiManipFunction);
 void CallGCInputManip(GCPadStatus* PadStatus, int controllerID);
 void CallWiiInputManip(u8* core, WiimoteEmu::ReportFeatures rptf, int controllerID, int ext,
                        const wiimote_key key);
+
+// Called when playback stops without continuing as a recording, at the end of the movie or after
+// a desync. Usually runs on the CPU thread, with the CPU stopped.
+using PlaybackEndedFunction = std::function<void()>;
+void SetPlaybackEndedCallback(PlaybackEndedFunction);
 }
@@ -0,0 +1,279 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Core/MovieFile.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <lzo/lzo1x.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/File.h"
+#include "Common/Hash.h"
+#include "Common/Logging/Log.h"
+#include "Core/Movie.h"
+
+namespace Movie
+{
+// Drops the chunk starts past the end of the input or out of order, and splits what's left in
+// chunks of DTM_MAX_CHUNK_SIZE bytes at most.
+static std::vector<DTMChunkStart> GetChunkStarts(u64 input_size,
+                                                 const std::vector<DTMChunkStart>& known_starts)
+{
+  std::vector<DTMChunkStart> starts;
+  if (input_size == 0)
+    return starts;
+
+  // Nothing is known about the input between the last start and end.
+  const auto split_until = [&starts](u64 end) {
+    while (end - starts.back().input_offset > DTM_MAX_CHUNK_SIZE)
+      starts.push_back({starts.back().input_offset + DTM_CHUNK_SIZE, DTM_UNKNOWN_FRAME, 0, 0});
+  };
+
+  starts.push_back({0, DTM_UNKNOWN_FRAME, 0, 0});
+  for (const DTMChunkStart& start : known_starts)
+  {
+    if (start.input_offset == 0)
+    {
+      starts.front() = start;
+      continue;
+    }
+    if (start.input_offset >= input_size || start.input_offset <= starts.back().input_offset)
+      continue;
+
+    split_until(start.input_offset);
+    starts.push_back(start);
+  }
+  split_until(input_size);
+  return starts;
+}
+
+bool WriteChunkedDTM(File::IOFile& file, DTMHeader header, u64 input_size,
+                     const std::vector<DTMChunkStart>& chunk_starts,
+                     const DTMInputReadFunction& read_input)
+{
+  if (lzo_init() != LZO_E_OK)
+    return false;
+
+  // The header is written again once the index offset is known.
+  if (!file.Seek(0, SEEK_SET) || !file.WriteArray(&header, 1))
+    return false;
+
+  const std::vector<DTMChunkStart> starts = GetChunkStarts(input_size, chunk_starts);
+  std::vector<DTMChunkEntry> entries;
+  entries.reserve(starts.size());
+
+  std::vector<u8> chunk_data(DTM_MAX_CHUNK_SIZE);
+  std::vector<u8> compressed_data(DTM_MAX_CHUNK_SIZE + DTM_MAX_CHUNK_SIZE / 16 + 64 + 3);
+  std::vector<u8> work_memory(LZO1X_1_MEM_COMPRESS);
+  for (size_t i = 0; i < starts.size(); i++)
+  {
+    const u64 end = i + 1 < starts.size() ? starts[i + 1].input_offset : input_size;
+    const u32 size = static_cast<u32>(end - starts[i].input_offset);
+    if (!read_input(starts[i].input_offset, chunk_data.data(), size))
+      return false;
+
+    lzo_uint compressed_size = 0;
+    if (lzo1x_1_compress(chunk_data.data(), size, compressed_data.data(), &compressed_size,
+                         work_memory.data()) != LZO_E_OK)
+    {
+      return false;
+    }
+
+    DTMChunkEntry entry;
+    entry.start = starts[i];
+    entry.file_offset = file.Tell();
+    entry.checksum = HashAdler32(chunk_data.data(), size);
+
+    // Chunks which don't shrink are stored as is.
+    const bool stored = compressed_size >= size;
+    entry.compressed_size = stored ? size : static_cast<u32>(compressed_size);
+    if (!file.WriteBytes(stored ? chunk_data.data() : compressed_data.data(),
+                         entry.compressed_size))
+    {
+      return false;
+    }
+    entries.push_back(entry);
+  }
+
+  header.version = DTM_VERSION_CHUNKED;
+  header.indexOffset = file.Tell();
+  const DTMIndexHeader index_header{input_size, static_cast<u64>(entries.size())};
+  if (!file.WriteArray(&index_header, 1) || !file.WriteArray(entries.data(), entries.size()))
+    return false;
+
+  return file.Seek(0, SEEK_SET) && file.WriteArray(&header, 1) && file.Seek(0, SEEK_END);
+}
+
+DTMInputReader::DTMInputReader(File::IOFile file, std::string filename)
+    : m_file(std::move(file)), m_filename(std::move(filename))
+{
+}
+
+std::unique_ptr<DTMInputReader> DTMInputReader::Open(const std::string& filename,
+                                                     const DTMHeader& header)
+{
+  if (header.version != DTM_VERSION_CHUNKED || lzo_init() != LZO_E_OK)
+    return nullptr;
+
+  File::IOFile file(filename, "rb");
+  DTMIndexHeader index_header;
+  if (!file.Seek(header.indexOffset, SEEK_SET) || !file.ReadArray(&index_header, 1) ||
+      index_header.num_chunks > file.GetSize() / sizeof(DTMChunkEntry))
+  {
+    ERROR_LOG(CORE, "Movie %s has no valid chunk index", filename.c_str());
+    return nullptr;
+  }
+
+  std::unique_ptr<DTMInputReader> reader(new DTMInputReader(std::move(file), filename));
+  reader->m_input_size = index_header.input_size;
+  reader->m_chunks.resize(static_cast<size_t>(index_header.num_chunks));
+  if (!reader->m_file.ReadArray(reader->m_chunks.data(), reader->m_chunks.size()))
+  {
+    ERROR_LOG(CORE, "Movie %s has a truncated chunk index", filename.c_str());
+    return nullptr;
+  }
+
+  // Validate the index once, so that reads don't have to.
+  for (size_t i = 0; i < reader->m_chunks.size(); i++)
+  {
+    const DTMChunkEntry& entry = reader->m_chunks[i];
+    const u64 start = entry.start.input_offset;
+    const u64 end = reader->GetChunkEnd(i);
+    const bool ordered = i == 0 ? start == 0 : start > reader->m_chunks[i - 1].start.input_offset;
+    if (!ordered || end <= start || end - start > DTM_MAX_CHUNK_SIZE ||
+        entry.compressed_size > end - start)
+    {
+      ERROR_LOG(CORE, "Movie %s has an invalid entry for chunk %zu", filename.c_str(), i);
+      return nullptr;
+    }
+
+    if (entry.start.frame != DTM_UNKNOWN_FRAME)
+      reader->m_frame_chunks.push_back(i);
+  }
+  if (reader->m_input_size != 0 && reader->m_chunks.empty())
+    return nullptr;
+
+  reader->m_compressed_buffer.resize(DTM_MAX_CHUNK_SIZE);
+  return reader;
+}
+
+DTMChunkStart DTMInputReader::FindChunkForFrame(u64 frame) const
+{
+  auto iter = std::upper_bound(
+      m_frame_chunks.begin(), m_frame_chunks.end(), frame,
+      [this](u64 value, size_t index) { return value < m_chunks[index].start.frame; });
+  if (iter == m_frame_chunks.begin())
+    return {0, 0, 0, 0};
+  return m_chunks[*(iter - 1)].start;
+}
+
+bool DTMInputReader::Read(u64 offset, u8* data, size_t size)
+{
+  while (size > 0)
+  {
+    if (offset >= m_input_size)
+      return false;
+
+    const size_t index = FindChunk(offset);
+    if (index != m_cached_chunk && !LoadChunk(index))
+      return false;
+
+    const u64 offset_in_chunk = offset - m_chunks[index].start.input_offset;
+    const size_t copy_size =
+        static_cast<size_t>(std::min<u64>(size, m_chunk_data.size() - offset_in_chunk));
+    std::memcpy(data, m_chunk_data.data() + offset_in_chunk, copy_size);
+    offset += copy_size;
+    data += copy_size;
+    size -= copy_size;
+  }
+  return true;
+}
+
+std::unique_ptr<DTMInputReader> DTMInputReader::Clone() const
+{
+  File::IOFile file(m_filename, "rb");
+  if (!file)
+    return nullptr;
+
+  std::unique_ptr<DTMInputReader> reader(new DTMInputReader(std::move(file), m_filename));
+  reader->m_input_size = m_input_size;
+  reader->m_chunks = m_chunks;
+  reader->m_frame_chunks = m_frame_chunks;
+  reader->m_compressed_buffer.resize(DTM_MAX_CHUNK_SIZE);
+  return reader;
+}
+
+size_t DTMInputReader::FindChunk(u64 offset) const
+{
+  // Playback reads sequentially, so this is nearly always the cached chunk or the next one.
+  if (m_cached_chunk < m_chunks.size())
+  {
+    if (offset >= m_chunks[m_cached_chunk].start.input_offset &&
+        offset < GetChunkEnd(m_cached_chunk))
+    {
+      return m_cached_chunk;
+    }
+    if (m_cached_chunk + 1 < m_chunks.size() && offset >= GetChunkEnd(m_cached_chunk) &&
+        offset < GetChunkEnd(m_cached_chunk + 1))
+    {
+      return m_cached_chunk + 1;
+    }
+  }
+
+  auto iter = std::upper_bound(
+      m_chunks.begin(), m_chunks.end(), offset,
+      [](u64 value, const DTMChunkEntry& entry) { return value < entry.start.input_offset; });
+  return static_cast<size_t>(std::distance(m_chunks.begin(), iter)) - 1;
+}
+
+u64 DTMInputReader::GetChunkEnd(size_t index) const
+{
+  return index + 1 < m_chunks.size() ? m_chunks[index + 1].start.input_offset : m_input_size;
+}
+
+bool DTMInputReader::LoadChunk(size_t index)
+{
+  const DTMChunkEntry& entry = m_chunks[index];
+  const size_t size = static_cast<size_t>(GetChunkEnd(index) - entry.start.input_offset);
+  m_cached_chunk = SIZE_MAX;
+  m_chunk_data.resize(size);
+
+  const bool stored = entry.compressed_size == size;
+  u8* const read_buffer = stored ? m_chunk_data.data() : m_compressed_buffer.data();
+  if (!m_file.Seek(entry.file_offset, SEEK_SET) ||
+      !m_file.ReadBytes(read_buffer, entry.compressed_size))
+  {
+    ERROR_LOG(CORE, "Movie %s is truncated", m_filename.c_str());
+    m_file.Clear();
+    return false;
+  }
+
+  if (!stored)
+  {
+    lzo_uint out_size = size;
+    if (lzo1x_decompress_safe(m_compressed_buffer.data(), entry.compressed_size,
+                              m_chunk_data.data(), &out_size, nullptr) != LZO_E_OK ||
+        out_size != size)
+    {
+      ERROR_LOG(CORE, "Failed to decompress chunk %zu of movie %s", index, m_filename.c_str());
+      return false;
+    }
+  }
+
+  if (HashAdler32(m_chunk_data.data(), size) != entry.checksum)
+  {
+    ERROR_LOG(CORE, "Chunk %zu of movie %s is corrupt", index, m_filename.c_str());
+    return false;
+  }
+
+  m_cached_chunk = index;
+  return true;
+}
+}  // namespace Movie
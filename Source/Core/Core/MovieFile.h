@@ -0,0 +1,111 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+// Version 2 of the DTM format stores the input log in chunks, each compressed with LZO on its own,
+// followed by an index of the chunks. The header is the same as in the original format, with the
+// version and the offset of the index in the space that used to be reserved.
+//
+// Chunks start on input boundaries where possible, and their index entries record the frame,
+// input and lag counts at that point. Playback then only keeps the current chunk in memory, and
+// both the chunk holding a byte of input and the chunk of a frame are found with a binary search.
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/File.h"
+
+namespace Movie
+{
+struct DTMHeader;
+
+static constexpr u8 DTM_VERSION_CHUNKED = 2;
+
+// A new chunk is started at the first input boundary after this many bytes of input.
+static constexpr u32 DTM_CHUNK_SIZE = 64 * 1024;
+// Input whose boundaries aren't known (such as input loaded from an original DTM) is split into
+// chunks of DTM_CHUNK_SIZE bytes, so no chunk is larger than this.
+static constexpr u32 DTM_MAX_CHUNK_SIZE = 2 * DTM_CHUNK_SIZE;
+
+// The frame of chunks which don't start on a known input boundary
+static constexpr u64 DTM_UNKNOWN_FRAME = UINT64_C(0xFFFFFFFFFFFFFFFF);
+
+#pragma pack(push, 1)
+struct DTMChunkStart
+{
+  u64 input_offset;  // Offset of the chunk in the uncompressed input
+  u64 frame;         // VI count, or DTM_UNKNOWN_FRAME
+  u64 input_count;
+  u64 lag_count;
+};
+
+struct DTMChunkEntry  // 48 bytes
+{
+  DTMChunkStart start;
+  u64 file_offset;
+  // Equal to the uncompressed size if the chunk is stored without compression
+  u32 compressed_size;
+  u32 checksum;  // Adler-32 of the uncompressed chunk
+};
+static_assert(sizeof(DTMChunkEntry) == 48, "DTMChunkEntry should be 48 bytes");
+
+struct DTMIndexHeader
+{
+  u64 input_size;
+  u64 num_chunks;
+};
+#pragma pack(pop)
+
+// Reads size bytes of input starting at offset.
+using DTMInputReadFunction = std::function<bool(u64 offset, u8* data, size_t size)>;
+
+// Writes a version 2 movie with the given header, whose version and index offset are filled in.
+// The input is read through read_input, and split at the given chunk starts where they fit.
+bool WriteChunkedDTM(File::IOFile& file, DTMHeader header, u64 input_size,
+                     const std::vector<DTMChunkStart>& chunk_starts,
+                     const DTMInputReadFunction& read_input);
+
+class DTMInputReader
+{
+public:
+  // Opens the input of a version 2 movie, whose header has already been read.
+  static std::unique_ptr<DTMInputReader> Open(const std::string& filename,
+                                              const DTMHeader& header);
+
+  u64 GetInputSize() const { return m_input_size; }
+  const std::vector<DTMChunkEntry>& GetChunks() const { return m_chunks; }
+
+  // Returns the start of the last chunk beginning at or before the frame, to seek to the input of
+  // that frame without reading what comes before it.
+  DTMChunkStart FindChunkForFrame(u64 frame) const;
+
+  // Decompresses chunks as needed, caching the last one.
+  bool Read(u64 offset, u8* data, size_t size);
+
+  // Returns a reader of the same movie, with its own file handle and cache.
+  std::unique_ptr<DTMInputReader> Clone() const;
+
+private:
+  DTMInputReader(File::IOFile file, std::string filename);
+
+  size_t FindChunk(u64 offset) const;
+  u64 GetChunkEnd(size_t index) const;
+  bool LoadChunk(size_t index);
+
+  File::IOFile m_file;
+  std::string m_filename;
+  u64 m_input_size = 0;
+  std::vector<DTMChunkEntry> m_chunks;
+  // Indices of the chunks which start at a known frame
+  std::vector<size_t> m_frame_chunks;
+
+  size_t m_cached_chunk = SIZE_MAX;
+  std::vector<u8> m_chunk_data;
+  std::vector<u8> m_compressed_buffer;
+};
+}  // namespace Movie
@@ -7,11 +7,15 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstring>
+#include <deque>
 #include <fstream>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <sstream>
 #include <thread>
+#include <utility>
+#include <vector>
 
 #include <mbedtls/md5.h>
 
@@ -322,35 +326,30 @@ unsigned int NetPlayClient::OnData(sf::Packet& packet)
   break;
 
   case NP_MSG_PAD_DATA:
-  {
-    PadMapping map = 0;
-    GCPadStatus pad;
-    packet >> map >> pad.button >> pad.analogA >> pad.analogB >> pad.stickX >> pad.stickY >>
-        pad.substickX >> pad.substickY >> pad.triggerLeft >> pad.triggerRight;
+    OnPadData(packet);
+    break;
 
-    // Trusting server for good map value (>=0 && <4)
-    // add to pad buffer
-    m_pad_buffer.at(map).Push(pad);
-    m_gc_pad_event.Set();
+  case NP_MSG_PAD_DATA_REDUNDANT:
+  {
+    // inputs of the previous game may still be received, and the ones of the next game before
+    // NP_MSG_START_GAME, since this channel isn't ordered with the reliable one
+    u32 game;
+    packet >> game;
+    if (game == m_current_game)
+      OnPadData(packet);
   }
   break;
 
   case NP_MSG_WIIMOTE_DATA:
-  {
-    PadMapping map = 0;
-    NetWiimote nw;
-    u8 size;
-    packet >> map >> size;
-
-    nw.resize(size);
-
-    for (unsigned int i = 0; i < size; ++i)
-      packet >> nw[i];
+    OnWiimoteData(packet);
+    break;
 
-    // Trusting server for good map value (>=0 && <4)
-    // add to Wiimote buffer
-    m_wiimote_buffer.at(map).Push(nw);
-    m_wii_pad_event.Set();
+  case NP_MSG_WIIMOTE_DATA_REDUNDANT:
+  {
+    u32 game;
+    packet >> game;
+    if (game == m_current_game)
+      OnWiimoteData(packet);
   }
   break;
 
@@ -434,6 +433,15 @@ unsigned int NetPlayClient::OnData(sf::Packet& packet)
       g_netplay_initial_rtc = time_low | ((u64)time_high << 32);
     }
 
+    // the inputs of the new game come after this message on the reliable channel
+    for (size_t i = 0; i < 4; ++i)
+    {
+      m_pad_sequence[i].next_receive = 0;
+      m_pad_sequence[i].received.clear();
+      m_wiimote_sequence[i].next_receive = 0;
+      m_wiimote_sequence[i].received.clear();
+    }
+
     m_dialog->OnMsgStartGame();
   }
   break;
@@ -512,9 +520,11 @@ unsigned int NetPlayClient::OnData(sf::Packet& packet)
   case NP_MSG_COMPUTE_MD5:
   {
     std::string file_identifier;
+    u8 hash_function;
     packet >> file_identifier;
+    packet >> hash_function;
 
-    ComputeMD5(file_identifier);
+    ComputeMD5(file_identifier, static_cast<MD5::HashFunction>(hash_function));
   }
   break;
 
@@ -566,6 +576,84 @@ unsigned int NetPlayClient::OnData(sf::Packet& packet)
   return 0;
 }
 
+// Pushes the inputs of a pad in order, skipping the ones which were already received.
+template <typename T>
+static bool ReceiveInput(u32 sequence, T input, std::map<u32, T>* received, u32* next_receive,
+                         Common::FifoQueue<T>* buffer)
+{
+  if (sequence < *next_receive)
+    return false;
+
+  received->emplace(sequence, std::move(input));
+
+  bool pushed = false;
+  while (!received->empty() && received->begin()->first == *next_receive)
+  {
+    buffer->Push(std::move(received->begin()->second));
+    received->erase(received->begin());
+    ++*next_receive;
+    pushed = true;
+  }
+  return pushed;
+}
+
+// called from ---NETPLAY--- thread
+void NetPlayClient::OnPadData(sf::Packet& packet)
+{
+  u32 count;
+  packet >> count;
+
+  bool pushed = false;
+  for (u32 i = 0; i < count; ++i)
+  {
+    PadMapping map = 0;
+    u32 sequence;
+    GCPadStatus pad;
+    packet >> map >> sequence >> pad.button >> pad.analogA >> pad.analogB >> pad.stickX >>
+        pad.stickY >> pad.substickX >> pad.substickY >> pad.triggerLeft >> pad.triggerRight;
+
+    // Trusting server for good map value (>=0 && <4)
+    // add to pad buffer
+    InputSequence<GCPadStatus>& pad_sequence = m_pad_sequence.at(map);
+    pushed |= ReceiveInput(sequence, std::move(pad), &pad_sequence.received,
+                           &pad_sequence.next_receive, &m_pad_buffer[map]);
+  }
+
+  if (pushed)
+    m_gc_pad_event.Set();
+}
+
+// called from ---NETPLAY--- thread
+void NetPlayClient::OnWiimoteData(sf::Packet& packet)
+{
+  u32 count;
+  packet >> count;
+
+  bool pushed = false;
+  for (u32 i = 0; i < count; ++i)
+  {
+    PadMapping map = 0;
+    u32 sequence;
+    NetWiimote nw;
+    u8 size;
+    packet >> map >> sequence >> size;
+
+    nw.resize(size);
+
+    for (unsigned int j = 0; j < size; ++j)
+      packet >> nw[j];
+
+    // Trusting server for good map value (>=0 && <4)
+    // add to Wiimote buffer
+    InputSequence<NetWiimote>& wiimote_sequence = m_wiimote_sequence.at(map);
+    pushed |= ReceiveInput(sequence, std::move(nw), &wiimote_sequence.received,
+                           &wiimote_sequence.next_receive, &m_wiimote_buffer[map]);
+  }
+
+  if (pushed)
+    m_wii_pad_event.Set();
+}
+
 void NetPlayClient::Send(const sf::Packet& packet)
 {
   ENetPacket* epac =
@@ -573,6 +661,16 @@ void NetPlayClient::Send(const sf::Packet& packet)
   enet_peer_send(m_server, 0, epac);
 }
 
+void NetPlayClient::SendUnreliable(const sf::Packet& packet)
+{
+  // the traversal host only has one channel, and the reliable copy is enough there
+  if (m_server->channelCount <= UNRELIABLE_CHANNEL)
+    return;
+
+  ENetPacket* epac = enet_packet_create(packet.getData(), packet.getDataSize(), 0);
+  enet_peer_send(m_server, UNRELIABLE_CHANNEL, epac);
+}
+
 void NetPlayClient::DisplayPlayersPing()
 {
   if (!g_ActiveConfig.bShowNetPlayPing)
@@ -629,6 +727,15 @@ void NetPlayClient::SendAsync(sf::Packet&& packet)
   ENetUtil::WakeupThread(m_client);
 }
 
+void NetPlayClient::SendAsyncUnreliable(sf::Packet&& packet)
+{
+  {
+    std::lock_guard<std::recursive_mutex> lkq(m_crit.async_queue_write);
+    m_async_unreliable_queue.Push(std::move(packet));
+  }
+  ENetUtil::WakeupThread(m_client);
+}
+
 // called from ---NETPLAY--- thread
 void NetPlayClient::ThreadFunc()
 {
@@ -644,6 +751,11 @@ void NetPlayClient::ThreadFunc()
       Send(m_async_queue.Front());
       m_async_queue.Pop();
     }
+    while (!m_async_unreliable_queue.Empty())
+    {
+      SendUnreliable(m_async_unreliable_queue.Front());
+      m_async_unreliable_queue.Pop();
+    }
     if (net > 0)
     {
       sf::Packet rpac;
@@ -746,31 +858,91 @@ void NetPlayClient::SendChatMessage(const std::string& msg)
   SendAsync(std::move(packet));
 }
 
+static void WritePadState(sf::Packet& packet, int in_game_pad, u32 sequence,
+                          const GCPadStatus& pad)
+{
+  packet << static_cast<PadMapping>(in_game_pad) << sequence;
+  packet << pad.button << pad.analogA << pad.analogB << pad.stickX << pad.stickY << pad.substickX
+         << pad.substickY << pad.triggerLeft << pad.triggerRight;
+}
+
+static void WriteWiimoteState(sf::Packet& packet, int in_game_pad, u32 sequence,
+                              const NetWiimote& nw)
+{
+  packet << static_cast<PadMapping>(in_game_pad) << sequence;
+  packet << static_cast<u8>(nw.size());
+  for (auto it : nw)
+  {
+    packet << it;
+  }
+}
+
+// Numbers the inputs and remembers the last ones, which are repeated in the unreliable packets.
+template <typename T>
+static u32 NextSequence(std::deque<std::pair<u32, T>>* sent, u32* next_send, const T& input)
+{
+  const u32 sequence = (*next_send)++;
+  sent->emplace_back(sequence, input);
+  if (sent->size() > REDUNDANT_INPUTS)
+    sent->pop_front();
+  return sequence;
+}
+
 // called from ---CPU--- thread
-void NetPlayClient::SendPadState(const int in_game_pad, const GCPadStatus& pad)
+void NetPlayClient::SendPadStates(const std::vector<std::pair<int, GCPadStatus>>& states)
 {
   sf::Packet packet;
   packet << static_cast<MessageId>(NP_MSG_PAD_DATA);
-  packet << static_cast<PadMapping>(in_game_pad);
-  packet << pad.button << pad.analogA << pad.analogB << pad.stickX << pad.stickY << pad.substickX
-         << pad.substickY << pad.triggerLeft << pad.triggerRight;
+  packet << static_cast<u32>(states.size());
+  for (const auto& state : states)
+  {
+    InputSequence<GCPadStatus>& pad_sequence = m_pad_sequence[state.first];
+    const u32 sequence = NextSequence(&pad_sequence.sent, &pad_sequence.next_send, state.second);
+    WritePadState(packet, state.first, sequence, state.second);
+  }
 
   SendAsync(std::move(packet));
+
+  // Only the local pads have sent inputs, and they can't change while the game is running.
+  u32 redundant_count = 0;
+  for (const InputSequence<GCPadStatus>& pad_sequence : m_pad_sequence)
+    redundant_count += static_cast<u32>(pad_sequence.sent.size());
+
+  sf::Packet redundant;
+  redundant << static_cast<MessageId>(NP_MSG_PAD_DATA_REDUNDANT);
+  redundant << m_current_game << redundant_count;
+  for (size_t in_game_pad = 0; in_game_pad < m_pad_sequence.size(); ++in_game_pad)
+  {
+    for (const auto& sent : m_pad_sequence[in_game_pad].sent)
+      WritePadState(redundant, static_cast<int>(in_game_pad), sent.first, sent.second);
+  }
+
+  SendAsyncUnreliable(std::move(redundant));
 }
 
 // called from ---CPU--- thread
-void NetPlayClient::SendWiimoteState(const int in_game_pad, const NetWiimote& nw)
+void NetPlayClient::SendWiimoteStates(const int in_game_pad, const std::vector<NetWiimote>& states)
 {
+  InputSequence<NetWiimote>& wiimote_sequence = m_wiimote_sequence[in_game_pad];
+
   sf::Packet packet;
   packet << static_cast<MessageId>(NP_MSG_WIIMOTE_DATA);
-  packet << static_cast<PadMapping>(in_game_pad);
-  packet << static_cast<u8>(nw.size());
-  for (auto it : nw)
+  packet << static_cast<u32>(states.size());
+  for (const NetWiimote& nw : states)
   {
-    packet << it;
+    const u32 sequence = NextSequence(&wiimote_sequence.sent, &wiimote_sequence.next_send, nw);
+    WriteWiimoteState(packet, in_game_pad, sequence, nw);
   }
 
   SendAsync(std::move(packet));
+
+  sf::Packet redundant;
+  redundant << static_cast<MessageId>(NP_MSG_WIIMOTE_DATA_REDUNDANT);
+  redundant << m_current_game << static_cast<u32>(wiimote_sequence.sent.size());
+  for (const auto& sent : wiimote_sequence.sent)
+    WriteWiimoteState(redundant, in_game_pad, sent.first, sent.second);
+
+  SendAsyncUnreliable(std::move(redundant));
 }
 
 // called from ---GUI--- thread
@@ -811,6 +983,14 @@ bool NetPlayClient::StartGame(const std::string& path)
 
   ClearBuffers();
 
+  for (size_t i = 0; i < 4; ++i)
+  {
+    m_pad_sequence[i].next_send = 0;
+    m_pad_sequence[i].sent.clear();
+    m_wiimote_sequence[i].next_send = 0;
+    m_wiimote_sequence[i].sent.clear();
+  }
+
   if (m_dialog->IsRecording())
   {
     if (Movie::IsReadOnly())
@@ -968,6 +1148,7 @@ bool NetPlayClient::GetNetPads(const int pad_nb, GCPadStatus* pad_status)
   // clients.
   if (IsFirstInGamePad(pad_nb))
   {
+    std::vector<std::pair<int, GCPadStatus>> states;
     const int num_local_pads = NumLocalPads();
     for (int local_pad = 0; local_pad < num_local_pads; local_pad++)
     {
@@ -991,10 +1172,13 @@ bool NetPlayClient::GetNetPads(const int pad_nb, GCPadStatus* pad_status)
         // add to buffer
         m_pad_buffer[ingame_pad].Push(*pad_status);
 
-        // send
-        SendPadState(ingame_pad, *pad_status);
+        states.emplace_back(ingame_pad, *pad_status);
       }
     }
+
+    // send the states of all local pads at once
+    if (!states.empty())
+      SendPadStates(states);
   }
 
   // Now, we either use the data pushed earlier, or wait for the
@@ -1035,15 +1219,18 @@ bool NetPlayClient::WiimoteUpdate(int _number, u8* data, const u8 size, u8 repor
     if (m_wiimote_map[_number] == m_local_player->pid)
     {
       nw.assign(data, data + size);
+      std::vector<NetWiimote> states;
       do
       {
         // add to buffer
         m_wiimote_buffer[_number].Push(nw);
 
-        SendWiimoteState(_number, nw);
+        states.push_back(nw);
       } while (m_wiimote_buffer[_number].Size() <=
                m_target_buffer_size * 200 /
                    120);  // TODO: add a seperate setting for wiimote buffer?
+
+      SendWiimoteStates(_number, states);
     }
 
   }  // unlock players
@@ -1218,7 +1405,8 @@ bool NetPlayClient::DoAllPlayersHaveGame()
                      });
 }
 
-void NetPlayClient::ComputeMD5(const std::string& file_identifier)
+void NetPlayClient::ComputeMD5(const std::string& file_identifier,
+                               MD5::HashFunction hash_function)
 {
   if (m_should_compute_MD5)
     return;
@@ -1241,8 +1429,8 @@ void NetPlayClient::ComputeMD5(const std::string& file_identifier)
     return;
   }
 
-  m_MD5_thread = std::thread([this, file]() {
-    std::string sum = MD5::MD5Sum(file, [&](int progress) {
+  m_MD5_thread = std::thread([this, file, hash_function]() {
+    std::string sum = MD5::HashSum(hash_function, file, [&](int progress) {
       sf::Packet packet;
       packet << static_cast<MessageId>(NP_MSG_MD5_PROGRESS);
       packet << progress;
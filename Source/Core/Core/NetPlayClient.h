@@ -6,6 +6,7 @@
 
 #include <SFML/Network/Packet.hpp>
 #include <array>
+#include <deque>
 #include <map>
 #include <mutex>
 #include <string>
@@ -14,6 +15,7 @@
 #include "Common/CommonTypes.h"
 #include "Common/Event.h"
 #include "Common/FifoQueue.h"
+#include "Common/MD5.h"
 #include "Common/TraversalClient.h"
 #include "Core/NetPlayProto.h"
 #include "InputCommon/GCPadStatus.h"
@@ -110,10 +112,26 @@ protected:
   } m_crit;
 
   Common::FifoQueue<sf::Packet, false> m_async_queue;
+  Common::FifoQueue<sf::Packet, false> m_async_unreliable_queue;
 
   std::array<Common::FifoQueue<GCPadStatus>, 4> m_pad_buffer;
   std::array<Common::FifoQueue<NetWiimote>, 4> m_wiimote_buffer;
 
+  // Inputs of an in-game pad are numbered, so that the copies received through the reliable and
+  // the unreliable channel can be put in order and only the first one of each is used.
+  template <typename T>
+  struct InputSequence
+  {
+    // ---CPU--- thread, reset when the game is started
+    u32 next_send = 0;
+    std::deque<std::pair<u32, T>> sent;
+    // ---NETPLAY--- thread, reset when NP_MSG_START_GAME is received
+    u32 next_receive = 0;
+    std::map<u32, T> received;
+  };
+  std::array<InputSequence<GCPadStatus>, 4> m_pad_sequence;
+  std::array<InputSequence<NetWiimote>, 4> m_wiimote_sequence;
+
   NetPlayUI* m_dialog = nullptr;
 
   ENetHost* m_client = nullptr;
@@ -152,13 +170,17 @@ private:
   void SendStopGamePacket();
 
   void UpdateDevices();
-  void SendPadState(int in_game_pad, const GCPadStatus& np);
-  void SendWiimoteState(int in_game_pad, const NetWiimote& nw);
+  void SendPadStates(const std::vector<std::pair<int, GCPadStatus>>& states);
+  void SendWiimoteStates(int in_game_pad, const std::vector<NetWiimote>& states);
+  void OnPadData(sf::Packet& packet);
+  void OnWiimoteData(sf::Packet& packet);
   unsigned int OnData(sf::Packet& packet);
   void Send(const sf::Packet& packet);
+  void SendUnreliable(const sf::Packet& packet);
+  void SendAsyncUnreliable(sf::Packet&& packet);
   void Disconnect();
   bool Connect();
-  void ComputeMD5(const std::string& file_identifier);
+  void ComputeMD5(const std::string& file_identifier, MD5::HashFunction hash_function);
   void DisplayPlayersPing();
   u32 GetPlayersMaxPing() const;
 
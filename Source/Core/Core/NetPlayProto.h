@@ -5,6 +5,7 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
 #include <vector>
 #include "Common/CommonTypes.h"
 #include "Core/HW/EXI/EXI_Device.h"
@@ -60,9 +61,11 @@ enum
   NP_MSG_PAD_DATA = 0x60,
   NP_MSG_PAD_MAPPING = 0x61,
   NP_MSG_PAD_BUFFER = 0x62,
+  NP_MSG_PAD_DATA_REDUNDANT = 0x63,
 
   NP_MSG_WIIMOTE_DATA = 0x70,
   NP_MSG_WIIMOTE_MAPPING = 0x71,
+  NP_MSG_WIIMOTE_DATA_REDUNDANT = 0x72,
 
   NP_MSG_START_GAME = 0xA0,
   NP_MSG_CHANGE_GAME = 0xA1,
@@ -103,6 +106,12 @@ using FrameNum = u32;
 using PadMapping = s8;
 using PadMappingArray = std::array<PadMapping, 4>;
 
+// Each input is sent reliably on channel 0, in order with the other messages. The last
+// REDUNDANT_INPUTS inputs of each pad are also repeated unreliably on this channel, so that a lost
+// packet doesn't stall the other players until ENet resends it.
+constexpr u8 UNRELIABLE_CHANNEL = 1;
+constexpr size_t REDUNDANT_INPUTS = 4;
+
 namespace NetPlay
 {
 bool IsNetPlayRunning();
@@ -512,62 +512,88 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
   break;
 
   case NP_MSG_PAD_DATA:
+  case NP_MSG_PAD_DATA_REDUNDANT:
   {
     // if this is pad data from the last game still being received, ignore it
     if (player.current_game != m_current_game)
       break;
 
-    PadMapping map = 0;
-    GCPadStatus pad;
-    packet >> map >> pad.button >> pad.analogA >> pad.analogB >> pad.stickX >> pad.stickY >>
-        pad.substickX >> pad.substickY >> pad.triggerLeft >> pad.triggerRight;
-
-    // If the data is not from the correct player,
-    // then disconnect them.
-    if (m_pad_map.at(map) != player.pid)
+    if (mid == NP_MSG_PAD_DATA_REDUNDANT)
     {
-      return 1;
+      u32 game;
+      packet >> game;
+      if (game != m_current_game)
+        break;
     }
 
-    // Relay to clients
-    sf::Packet spac;
-    spac << (MessageId)NP_MSG_PAD_DATA;
-    spac << map << pad.button << pad.analogA << pad.analogB << pad.stickX << pad.stickY
-         << pad.substickX << pad.substickY << pad.triggerLeft << pad.triggerRight;
+    u32 count;
+    packet >> count;
+    for (u32 i = 0; i < count; ++i)
+    {
+      PadMapping map = 0;
+      u32 sequence;
+      GCPadStatus pad;
+      packet >> map >> sequence >> pad.button >> pad.analogA >> pad.analogB >> pad.stickX >>
+          pad.stickY >> pad.substickX >> pad.substickY >> pad.triggerLeft >> pad.triggerRight;
+
+      // If the data is not from the correct player,
+      // then disconnect them.
+      if (m_pad_map.at(map) != player.pid)
+      {
+        return 1;
+      }
+    }
 
-    SendToClients(spac, player.pid);
+    // Relay to clients, the packet is passed on unchanged
+    if (mid == NP_MSG_PAD_DATA)
+      SendToClients(packet, player.pid);
+    else
+      SendUnreliableToClients(packet, player.pid);
   }
   break;
 
   case NP_MSG_WIIMOTE_DATA:
+  case NP_MSG_WIIMOTE_DATA_REDUNDANT:
   {
     // if this is Wiimote data from the last game still being received, ignore it
     if (player.current_game != m_current_game)
       break;
 
-    PadMapping map = 0;
-    u8 size;
-    packet >> map >> size;
-    std::vector<u8> data(size);
-    for (size_t i = 0; i < data.size(); ++i)
-      packet >> data[i];
+    if (mid == NP_MSG_WIIMOTE_DATA_REDUNDANT)
+    {
+      u32 game;
+      packet >> game;
+      if (game != m_current_game)
+        break;
+    }
 
-    // If the data is not from the correct player,
-    // then disconnect them.
-    if (m_wiimote_map.at(map) != player.pid)
+    u32 count;
+    packet >> count;
+    for (u32 i = 0; i < count; ++i)
     {
-      return 1;
+      PadMapping map = 0;
+      u32 sequence;
+      u8 size;
+      packet >> map >> sequence >> size;
+      for (u8 j = 0; j < size; ++j)
+      {
+        u8 byte;
+        packet >> byte;
+      }
+
+      // If the data is not from the correct player,
+      // then disconnect them.
+      if (m_wiimote_map.at(map) != player.pid)
+      {
+        return 1;
+      }
     }
 
     // relay to clients
-    sf::Packet spac;
-    spac << (MessageId)NP_MSG_WIIMOTE_DATA;
-    spac << map;
-    spac << size;
-    for (const u8& byte : data)
-      spac << byte;
-
-    SendToClients(spac, player.pid);
+    if (mid == NP_MSG_WIIMOTE_DATA)
+      SendToClients(packet, player.pid);
+    else
+      SendUnreliableToClients(packet, player.pid);
   }
   break;
 
@@ -762,11 +788,13 @@ bool NetPlayServer::ChangeGame(const std::string& game)
 }
 
 // called from ---GUI--- thread
-bool NetPlayServer::ComputeMD5(const std::string& file_identifier)
+bool NetPlayServer::ComputeMD5(const std::string& file_identifier,
+                               MD5::HashFunction hash_function)
 {
   sf::Packet spac;
   spac << static_cast<MessageId>(NP_MSG_COMPUTE_MD5);
   spac << file_identifier;
+  spac << static_cast<u8>(hash_function);
 
   SendAsyncToClients(std::move(spac));
 
@@ -847,6 +875,21 @@ void NetPlayServer::SendToClients(const sf::Packet& packet, const PlayerId skip_
   }
 }
 
+// called from ---NETPLAY--- thread
+void NetPlayServer::SendUnreliableToClients(const sf::Packet& packet, const PlayerId skip_pid)
+{
+  for (auto& p : m_players)
+  {
+    // the traversal host only has one channel, and the reliable copy is enough there
+    if (p.second.pid && p.second.pid != skip_pid &&
+        p.second.socket->channelCount > UNRELIABLE_CHANNEL)
+    {
+      ENetPacket* epac = enet_packet_create(packet.getData(), packet.getDataSize(), 0);
+      enet_peer_send(p.second.socket, UNRELIABLE_CHANNEL, epac);
+    }
+  }
+}
+
 void NetPlayServer::Send(ENetPeer* socket, const sf::Packet& packet)
 {
   ENetPacket* epac =
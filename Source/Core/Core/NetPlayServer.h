@@ -13,6 +13,7 @@
 #include <unordered_map>
 #include <unordered_set>
 #include "Common/FifoQueue.h"
+#include "Common/MD5.h"
 #include "Common/Timer.h"
 #include "Common/TraversalClient.h"
 #include "Core/NetPlayProto.h"
@@ -32,7 +33,7 @@ public:
   ~NetPlayServer();
 
   bool ChangeGame(const std::string& game);
-  bool ComputeMD5(const std::string& file_identifier);
+  bool ComputeMD5(const std::string& file_identifier, MD5::HashFunction hash_function);
   bool AbortMD5();
   void SendChatMessage(const std::string& msg);
 
@@ -75,6 +76,7 @@ private:
   };
 
   void SendToClients(const sf::Packet& packet, const PlayerId skip_pid = 0);
+  void SendUnreliableToClients(const sf::Packet& packet, const PlayerId skip_pid);
   void Send(ENetPeer* socket, const sf::Packet& packet);
   unsigned int OnConnect(ENetPeer* socket);
   unsigned int OnDisconnect(const Client& player);
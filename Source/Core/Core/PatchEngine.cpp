@@ -9,6 +9,7 @@
 #include "Core/PatchEngine.h"
 
 #include <algorithm>
+#include <cstring>
 #include <map>
 #include <set>
 #include <string>
@@ -17,11 +18,14 @@
 #include "Common/Assert.h"
 #include "Common/IniFile.h"
 #include "Common/StringUtil.h"
+#include "Common/Swap.h"
 
 #include "Core/ActionReplay.h"
 #include "Core/ConfigManager.h"
 #include "Core/GeckoCode.h"
 #include "Core/GeckoCodeConfig.h"
+#include "Core/HW/Memmap.h"
+#include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/PowerPC.h"
 
 namespace PatchEngine
@@ -30,7 +34,23 @@ const char* PatchTypeStrings[] = {
     "byte", "word", "dword",
 };
 
+// An entry of an active OnFrame patch, with the host pointer it was last written through.
+struct FrameWrite
+{
+  u32 address;
+  u32 value;
+  u32 size;
+  // The DBAT entry the host pointer was found with, as it is only valid as long as the entry is.
+  u32 bat_entry;
+  u8* host_pointer;
+};
+
+// Instructions are invalidated in blocks of this many bytes.
+static constexpr u32 INVALIDATE_BLOCK_SIZE = 32;
+
 static std::vector<Patch> onFrame;
+static std::vector<FrameWrite> s_frame_writes;
+static std::vector<u32> s_changed_blocks;
 static std::map<u32, int> speedHacks;
 
 void LoadPatchSection(const std::string& section, std::vector<Patch>& patches, IniFile& globalIni,
@@ -152,6 +172,19 @@ void LoadPatches()
   IniFile localIni = SConfig::GetInstance().LoadLocalGameIni();
 
   LoadPatchSection("OnFrame", onFrame, globalIni, localIni);
+  for (const Patch& patch : onFrame)
+  {
+    if (!patch.active)
+      continue;
+
+    for (const PatchEntry& entry : patch.entries)
+    {
+      if (entry.type > PATCH_32BIT)
+        continue;
+      const u32 size = 1u << entry.type;
+      s_frame_writes.push_back({entry.address, entry.value, size, 0, nullptr});
+    }
+  }
   ActionReplay::LoadAndApplyCodes(globalIni, localIni);
 
   Gecko::SetActiveCodes(Gecko::LoadCodes(globalIni, localIni));
@@ -159,34 +192,144 @@ void LoadPatches()
   LoadSpeedhacks("Speedhacks", merged);
 }
 
-static void ApplyPatches(const std::vector<Patch>& patches)
+// Finds the RAM the address is mapped to by the DBATs, or returns nullptr if it isn't.
+static u8* GetHostPointer(u32 address, u32 size, u32 bat_entry)
+{
+  if (!(bat_entry & PowerPC::BAT_PHYSICAL_BIT) ||
+      (address & (PowerPC::BAT_PAGE_SIZE - 1)) + size > PowerPC::BAT_PAGE_SIZE)
+  {
+    return nullptr;
+  }
+
+  const u32 physical_address =
+      (bat_entry & PowerPC::BAT_RESULT_MASK) | (address & (PowerPC::BAT_PAGE_SIZE - 1));
+  if (physical_address + size <= Memory::REALRAM_SIZE)
+    return Memory::m_pRAM + physical_address;
+  if (Memory::m_pEXRAM && (physical_address >> 28) == 0x1 &&
+      (physical_address & 0x0FFFFFFF) + size <= Memory::EXRAM_SIZE)
+  {
+    return Memory::m_pEXRAM + (physical_address & 0x0FFFFFFF);
+  }
+  return nullptr;
+}
+
+static u32 ReadBigEndian(const u8* pointer, u32 size)
+{
+  switch (size)
+  {
+  case 1:
+    return *pointer;
+  case 2:
+  {
+    u16 value;
+    std::memcpy(&value, pointer, sizeof(value));
+    return Common::swap16(value);
+  }
+  default:
+  {
+    u32 value;
+    std::memcpy(&value, pointer, sizeof(value));
+    return Common::swap32(value);
+  }
+  }
+}
+
+static void WriteBigEndian(u8* pointer, u32 size, u32 value)
 {
-  for (const Patch& patch : patches)
+  switch (size)
   {
-    if (patch.active)
+  case 1:
+    *pointer = static_cast<u8>(value);
+    break;
+  case 2:
+  {
+    const u16 swapped = Common::swap16(static_cast<u16>(value));
+    std::memcpy(pointer, &swapped, sizeof(swapped));
+    break;
+  }
+  default:
+  {
+    const u32 swapped = Common::swap32(value);
+    std::memcpy(pointer, &swapped, sizeof(swapped));
+    break;
+  }
+  }
+}
+
+// Writes the value unless memory already holds it, and returns whether it was written.
+static bool ApplyFrameWrite(FrameWrite& write)
+{
+  const u32 bat_entry = PowerPC::dbat_table[write.address >> PowerPC::BAT_INDEX_SHIFT];
+  if (bat_entry != write.bat_entry || !write.host_pointer)
+  {
+    write.bat_entry = bat_entry;
+    write.host_pointer = GetHostPointer(write.address, write.size, bat_entry);
+  }
+
+  if (write.host_pointer)
+  {
+    if (ReadBigEndian(write.host_pointer, write.size) == write.value)
+      return false;
+    WriteBigEndian(write.host_pointer, write.size, write.value);
+    return true;
+  }
+
+  // Not mapped to RAM by the DBATs, so translate it every time.
+  switch (write.size)
+  {
+  case 1:
+    if (PowerPC::HostRead_U8(write.address) == static_cast<u8>(write.value))
+      return false;
+    PowerPC::HostWrite_U8(static_cast<u8>(write.value), write.address);
+    break;
+  case 2:
+    if (PowerPC::HostRead_U16(write.address) == static_cast<u16>(write.value))
+      return false;
+    PowerPC::HostWrite_U16(static_cast<u16>(write.value), write.address);
+    break;
+  default:
+    if (PowerPC::HostRead_U32(write.address) == write.value)
+      return false;
+    PowerPC::HostWrite_U32(write.value, write.address);
+    break;
+  }
+  return true;
+}
+
+static void ApplyFrameWrites()
+{
+  s_changed_blocks.clear();
+  for (FrameWrite& write : s_frame_writes)
+  {
+    if (!ApplyFrameWrite(write))
+      continue;
+
+    const u32 first_block = write.address & ~(INVALIDATE_BLOCK_SIZE - 1);
+    const u32 last_block = (write.address + write.size - 1) & ~(INVALIDATE_BLOCK_SIZE - 1);
+    s_changed_blocks.push_back(first_block);
+    if (last_block != first_block)
+      s_changed_blocks.push_back(last_block);
+  }
+  if (s_changed_blocks.empty())
+    return;
+
+  // Patches written to code have to reach compiled blocks, so the changed blocks are invalidated
+  // once, merging the adjacent ones into a single range.
+  std::sort(s_changed_blocks.begin(), s_changed_blocks.end());
+  s_changed_blocks.erase(std::unique(s_changed_blocks.begin(), s_changed_blocks.end()),
+                         s_changed_blocks.end());
+  u32 range_start = s_changed_blocks.front();
+  u32 range_end = range_start + INVALIDATE_BLOCK_SIZE;
+  for (size_t i = 1; i < s_changed_blocks.size(); ++i)
+  {
+    if (s_changed_blocks[i] != range_end)
     {
-      for (const PatchEntry& entry : patch.entries)
-      {
-        u32 addr = entry.address;
-        u32 value = entry.value;
-        switch (entry.type)
-        {
-        case PATCH_8BIT:
-          PowerPC::HostWrite_U8((u8)value, addr);
-          break;
-        case PATCH_16BIT:
-          PowerPC::HostWrite_U16((u16)value, addr);
-          break;
-        case PATCH_32BIT:
-          PowerPC::HostWrite_U32(value, addr);
-          break;
-        default:
-          // unknown patchtype
-          break;
-        }
-      }
+      JitInterface::InvalidateICache(range_start, range_end - range_start, false);
+      range_start = s_changed_blocks[i];
     }
+    range_end = s_changed_blocks[i] + INVALIDATE_BLOCK_SIZE;
   }
+  JitInterface::InvalidateICache(range_start, range_end - range_start, false);
 }
 
 // Requires MSR.DR, MSR.IR
@@ -228,7 +371,7 @@ bool ApplyFramePatches()
     return false;
   }
 
-  ApplyPatches(onFrame);
+  ApplyFrameWrites();
 
   // Run the Gecko code handler
   Gecko::RunCodeHandler();
@@ -240,6 +383,7 @@ bool ApplyFramePatches()
 void Shutdown()
 {
   onFrame.clear();
+  s_frame_writes.clear();
   speedHacks.clear();
   ActionReplay::ApplyCodes({});
   Gecko::Shutdown();
@@ -4,6 +4,8 @@
 
 #include "Core/PowerPC/CachedInterpreter/CachedInterpreter.h"
 
+#include <array>
+
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Core/ConfigManager.h"
@@ -11,10 +13,15 @@
 #include "Core/HLE/HLE.h"
 #include "Core/HW/CPU.h"
 #include "Core/PowerPC/Gekko.h"
+#include "Core/PowerPC/Interpreter/Interpreter.h"
 #include "Core/PowerPC/Jit64Common/Jit64Base.h"
 #include "Core/PowerPC/PPCAnalyst.h"
 #include "Core/PowerPC/PowerPC.h"
 
+// Runs two instructions with a single dispatch. The second one is the data of the next
+// Instruction, which is skipped.
+using FusedCallback = void (*)(UGeckoInstruction first, UGeckoInstruction second);
+
 struct CachedInterpreter::Instruction
 {
   typedef void (*CommonCallback)(UGeckoInstruction);
@@ -31,20 +38,55 @@ struct CachedInterpreter::Instruction
   {
   }
 
+  Instruction(const FusedCallback c, UGeckoInstruction i)
+      : fused_callback(c), data(i.hex), type(INSTRUCTION_TYPE_FUSED)
+  {
+  }
+
   union
   {
     const CommonCallback common_callback;
     const ConditionalCallback conditional_callback;
+    const FusedCallback fused_callback;
   };
   u32 data;
+  // The order matches the dispatch table of ExecuteOneBlock.
   enum
   {
     INSTRUCTION_ABORT,
     INSTRUCTION_TYPE_COMMON,
     INSTRUCTION_TYPE_CONDITIONAL,
+    INSTRUCTION_TYPE_FUSED,
   } type;
 };
 
+template <Interpreter::Instruction first, Interpreter::Instruction second>
+static void RunFused(UGeckoInstruction first_inst, UGeckoInstruction second_inst)
+{
+  first(first_inst);
+  second(second_inst);
+}
+
+struct FusedPair
+{
+  Interpreter::Instruction first;
+  Interpreter::Instruction second;
+  FusedCallback callback;
+};
+
+// Pairs of instructions which are commonly found next to each other.
+static const std::array<FusedPair, 8> s_fused_pairs = {{
+    {Interpreter::cmp, Interpreter::bcx, RunFused<Interpreter::cmp, Interpreter::bcx>},
+    {Interpreter::cmpi, Interpreter::bcx, RunFused<Interpreter::cmpi, Interpreter::bcx>},
+    {Interpreter::cmpl, Interpreter::bcx, RunFused<Interpreter::cmpl, Interpreter::bcx>},
+    {Interpreter::cmpli, Interpreter::bcx, RunFused<Interpreter::cmpli, Interpreter::bcx>},
+    {Interpreter::lwz, Interpreter::addi, RunFused<Interpreter::lwz, Interpreter::addi>},
+    {Interpreter::addi, Interpreter::lwz, RunFused<Interpreter::addi, Interpreter::lwz>},
+    {Interpreter::lwz, Interpreter::lwz, RunFused<Interpreter::lwz, Interpreter::lwz>},
+    {Interpreter::rlwinmx, Interpreter::rlwinmx,
+     RunFused<Interpreter::rlwinmx, Interpreter::rlwinmx>},
+}};
+
 CachedInterpreter::CachedInterpreter() : code_buffer(32000)
 {
 }
@@ -86,24 +128,61 @@ void CachedInterpreter::ExecuteOneBlock()
 
   const Instruction* code = reinterpret_cast<const Instruction*>(normal_entry);
 
-  for (; code->type != Instruction::INSTRUCTION_ABORT; ++code)
+#if defined(__GNUC__)
+  // Threaded dispatch: every handler jumps to the next one by itself, which gives each of these
+  // indirect jumps its own history in the branch predictor.
+  static const void* const handlers[] = {&&abort, &&common, &&conditional, &&fused};
+#define DISPATCH() goto* handlers[code->type]
+
+  DISPATCH();
+
+common:
+  code->common_callback(UGeckoInstruction(code->data));
+  ++code;
+  DISPATCH();
+
+conditional:
+  if (code->conditional_callback(code->data))
+    return;
+  ++code;
+  DISPATCH();
+
+fused:
+  code->fused_callback(UGeckoInstruction(code[0].data), UGeckoInstruction(code[1].data));
+  code += 2;
+  DISPATCH();
+
+abort:
+  return;
+#undef DISPATCH
+#else
+  while (code->type != Instruction::INSTRUCTION_ABORT)
   {
     switch (code->type)
     {
     case Instruction::INSTRUCTION_TYPE_COMMON:
       code->common_callback(UGeckoInstruction(code->data));
+      ++code;
       break;
 
     case Instruction::INSTRUCTION_TYPE_CONDITIONAL:
       if (code->conditional_callback(code->data))
         return;
+      ++code;
+      break;
+
+    case Instruction::INSTRUCTION_TYPE_FUSED:
+      code->fused_callback(UGeckoInstruction(code[0].data), UGeckoInstruction(code[1].data));
+      code += 2;
       break;
 
     default:
       ERROR_LOG(POWERPC, "Unknown CachedInterpreter Instruction: %d", code->type);
+      ++code;
       break;
     }
   }
+#endif
 }
 
 void CachedInterpreter::Run()
@@ -169,6 +248,28 @@ static bool CheckDSI(u32 data)
   return false;
 }
 
+// Returns the superinstruction for the given instructions, if both can run together without
+// any of the checks in between them.
+static FusedCallback GetFusedCallback(const PPCAnalyst::CodeOp& first,
+                                      const PPCAnalyst::CodeOp& second, bool memcheck)
+{
+  if (second.skip || (second.opinfo->flags & FL_USE_FPU) ||
+      (memcheck && ((first.opinfo->flags | second.opinfo->flags) & FL_LOADSTORE)) ||
+      HLE::GetFirstFunctionIndex(second.address) != 0)
+  {
+    return nullptr;
+  }
+
+  const Interpreter::Instruction first_op = GetInterpreterOp(first.inst);
+  const Interpreter::Instruction second_op = GetInterpreterOp(second.inst);
+  for (const FusedPair& pair : s_fused_pairs)
+  {
+    if (pair.first == first_op && pair.second == second_op)
+      return pair.callback;
+  }
+  return nullptr;
+}
+
 void CachedInterpreter::Jit(u32 address)
 {
   if (m_code.size() >= CODE_SIZE / sizeof(Instruction) - 0x1000 ||
@@ -239,6 +340,27 @@ void CachedInterpreter::Jit(u32 address)
         js.firstFPInstructionFound = true;
       }
 
+      const FusedCallback fused =
+          !endblock && !check_fpu && i + 1 < code_block.m_num_instructions ?
+              GetFusedCallback(ops[i], ops[i + 1], jo.memcheck) :
+              nullptr;
+      if (fused)
+      {
+        const PPCAnalyst::CodeOp& second = ops[i + 1];
+        const bool second_endblock = (second.opinfo->flags & FL_ENDBLOCK) != 0;
+        js.downcountAmount += second.opinfo->numCycles;
+
+        // Neither cmp nor the other first instructions read PC.
+        if (second_endblock)
+          m_code.emplace_back(WritePC, second.address);
+        m_code.emplace_back(fused, ops[i].inst);
+        m_code.emplace_back(GetInterpreterOp(second.inst), second.inst);
+        if (second_endblock)
+          m_code.emplace_back(EndBlock, js.downcountAmount);
+        i++;
+        continue;
+      }
+
       if (endblock || memcheck)
         m_code.emplace_back(WritePC, ops[i].address);
       m_code.emplace_back(GetInterpreterOp(ops[i].inst), ops[i].inst);
@@ -25,6 +25,7 @@
 #include "Core/Host.h"
 #include "Core/PowerPC/GDBStub.h"
 #include "Core/PowerPC/Gekko.h"
+#include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/PPCCache.h"
 #include "Core/PowerPC/PowerPC.h"
 
@@ -35,6 +36,7 @@
 #define GDB_STUB_END '#'
 #define GDB_STUB_ACK '+'
 #define GDB_STUB_NAK '-'
+#define GDB_STUB_ESCAPE '}'
 
 static int tmpsock = -1;
 static int sock = -1;
@@ -42,9 +44,17 @@ static int sock = -1;
 static u8 cmd_bfr[GDB_BFR_MAX];
 static u32 cmd_len;
 
+// Data received from gdb but not read yet, so that packets aren't received a byte at a time
+static u8 recv_bfr[GDB_BFR_MAX];
+static u32 recv_pos = 0;
+static u32 recv_len = 0;
+
 static u32 sig = 0;
 static u32 send_signal = 0;
 static u32 step_break = 0;
+// Set when a step is asked for at a breakpoint hit in JIT code. The instruction at the breakpoint
+// has already been reported, so the next check, by the interpreter, lets it run.
+static u32 jit_step = 0;
 
 typedef struct
 {
@@ -104,17 +114,40 @@ static void hex2mem(u8* dst, u8* src, u32 len)
 
 static u8 gdb_read_byte()
 {
-  ssize_t res;
-  u8 c = '+';
+  if (recv_pos == recv_len)
+  {
+    recv_pos = 0;
+    recv_len = 0;
 
-  res = recv(sock, &c, 1, MSG_WAITALL);
-  if (res != 1)
+    ssize_t res = recv(sock, recv_bfr, sizeof recv_bfr, 0);
+    if (res <= 0)
+    {
+      ERROR_LOG(GDB_STUB, "recv failed : %ld", res);
+      gdb_deinit();
+      return '+';
+    }
+    recv_len = static_cast<u32>(res);
+  }
+
+  return recv_bfr[recv_pos++];
+}
+
+// Returns the host memory of [addr, addr + len) if it is all in RAM, without the alert
+// Memory::GetPointer shows for other addresses.
+static u8* gdb_get_ram(u32 addr, u32 len)
+{
+  addr &= 0x3FFFFFFF;
+  if (addr < Memory::REALRAM_SIZE && len <= Memory::REALRAM_SIZE - addr)
+    return Memory::m_pRAM + addr;
+
+  if (Memory::m_pEXRAM && (addr >> 28) == 0x1)
   {
-    ERROR_LOG(GDB_STUB, "recv failed : %ld", res);
-    gdb_deinit();
+    addr &= 0x0FFFFFFF;
+    if (addr < Memory::EXRAM_SIZE && len <= Memory::EXRAM_SIZE - addr)
+      return Memory::m_pEXRAM + addr;
   }
 
-  return c;
+  return nullptr;
 }
 
 static u8 gdb_calc_chksum()
@@ -192,6 +225,8 @@ static void gdb_bp_remove(u32 type, u32 addr, u32 len)
     if (p != nullptr)
     {
       DEBUG_LOG(GDB_STUB, "gdb: removed a breakpoint: %08x bytes at %08x", len, addr);
+      if (type == GDB_BP_TYPE_X)
+        PowerPC::breakpoints.Remove(addr);
       p->active = 0;
       memset(p, 0, sizeof(gdb_bp_t));
     }
@@ -295,6 +330,9 @@ static void gdb_read_command()
 
 static int gdb_data_available()
 {
+  if (recv_pos < recv_len)
+    return 1;
+
   struct timeval t;
   fd_set _fds, *fds = &_fds;
 
@@ -315,7 +353,7 @@ static int gdb_data_available()
   return 0;
 }
 
-static void gdb_reply(const char* reply)
+static void gdb_reply(const u8* reply, u32 len)
 {
   u8 chk;
   u32 left;
@@ -327,9 +365,12 @@ static void gdb_reply(const char* reply)
 
   memset(cmd_bfr, 0, sizeof cmd_bfr);
 
-  cmd_len = strlen(reply);
+  cmd_len = len;
   if (cmd_len + 4 > sizeof cmd_bfr)
+  {
     ERROR_LOG(GDB_STUB, "cmd_bfr overflow in gdb_reply");
+    cmd_len = sizeof cmd_bfr - 4;
+  }
 
   memcpy(cmd_bfr + 1, reply, cmd_len);
 
@@ -358,6 +399,11 @@ static void gdb_reply(const char* reply)
   }
 }
 
+static void gdb_reply(const char* reply)
+{
+  gdb_reply(reinterpret_cast<const u8*>(reply), static_cast<u32>(strlen(reply)));
+}
+
 static void gdb_handle_query()
 {
   DEBUG_LOG(GDB_STUB, "gdb: query '%s'", cmd_bfr + 1);
@@ -366,6 +412,12 @@ static void gdb_handle_query()
   {
     return gdb_reply("T0");
   }
+  if (!strncmp((const char*)(cmd_bfr + 1), "Supported", 9))
+  {
+    char reply[64];
+    snprintf(reply, sizeof reply, "PacketSize=%x;binary-upload+", GDB_BFR_MAX - 4);
+    return gdb_reply(reply);
+  }
 
   gdb_reply("");
 }
@@ -595,9 +647,9 @@ static void gdb_read_mem()
     len = (len << 4) | hex2char(cmd_bfr[i++]);
   DEBUG_LOG(GDB_STUB, "gdb: read memory: %08x bytes from %08x", len, addr);
 
-  if (len * 2 > sizeof reply)
-    gdb_reply("E01");
-  u8* data = Memory::GetPointer(addr);
+  if (len * 2 >= sizeof reply)
+    return gdb_reply("E01");
+  u8* data = gdb_get_ram(addr, len);
   if (!data)
     return gdb_reply("E0");
   mem2hex(reply, data, len);
@@ -605,6 +657,49 @@ static void gdb_read_mem()
   gdb_reply((char*)reply);
 }
 
+// Same as 'm', with the memory sent as binary instead of hex
+static void gdb_read_mem_binary()
+{
+  static u8 reply[GDB_BFR_MAX - 4];
+  u32 addr, len;
+  u32 i;
+
+  i = 1;
+  addr = 0;
+  while (cmd_bfr[i] != ',')
+    addr = (addr << 4) | hex2char(cmd_bfr[i++]);
+  i++;
+
+  len = 0;
+  while (i < cmd_len)
+    len = (len << 4) | hex2char(cmd_bfr[i++]);
+  DEBUG_LOG(GDB_STUB, "gdb: read binary memory: %08x bytes from %08x", len, addr);
+
+  // Escaping can double the size of the data.
+  if (len * 2 + 1 > sizeof reply)
+    return gdb_reply("E01");
+  const u8* data = gdb_get_ram(addr, len);
+  if (!data)
+    return gdb_reply("E0");
+
+  u32 reply_len = 0;
+  reply[reply_len++] = 'b';
+  for (i = 0; i < len; i++)
+  {
+    const u8 c = data[i];
+    if (c == GDB_STUB_START || c == GDB_STUB_END || c == GDB_STUB_ESCAPE || c == '*')
+    {
+      reply[reply_len++] = GDB_STUB_ESCAPE;
+      reply[reply_len++] = c ^ 0x20;
+    }
+    else
+    {
+      reply[reply_len++] = c;
+    }
+  }
+  gdb_reply(reply, reply_len);
+}
+
 static void gdb_write_mem()
 {
   u32 addr, len;
@@ -621,10 +716,53 @@ static void gdb_write_mem()
     len = (len << 4) | hex2char(cmd_bfr[i++]);
   DEBUG_LOG(GDB_STUB, "gdb: write memory: %08x bytes to %08x", len, addr);
 
-  u8* dst = Memory::GetPointer(addr);
+  if (i + 1 + len * 2 > cmd_len)
+    return gdb_reply("E01");
+  u8* dst = gdb_get_ram(addr, len);
   if (!dst)
     return gdb_reply("E00");
   hex2mem(dst, cmd_bfr + i + 1, len);
+  JitInterface::InvalidateICache(addr, len, true);
+  gdb_reply("OK");
+}
+
+// Same as 'M', with the data in binary instead of hex
+static void gdb_write_mem_binary()
+{
+  u32 addr, len;
+  u32 i;
+
+  i = 1;
+  addr = 0;
+  while (cmd_bfr[i] != ',')
+    addr = (addr << 4) | hex2char(cmd_bfr[i++]);
+  i++;
+
+  len = 0;
+  while (cmd_bfr[i] != ':')
+    len = (len << 4) | hex2char(cmd_bfr[i++]);
+  i++;
+  DEBUG_LOG(GDB_STUB, "gdb: write binary memory: %08x bytes to %08x", len, addr);
+
+  u8* dst = gdb_get_ram(addr, len);
+  if (!dst)
+    return gdb_reply("E00");
+
+  // Unescaping never makes the data longer, so it is done in place.
+  u8* data = cmd_bfr + i;
+  u32 data_len = 0;
+  for (; i < cmd_len; i++)
+  {
+    u8 c = cmd_bfr[i];
+    if (c == GDB_STUB_ESCAPE && i + 1 < cmd_len)
+      c = cmd_bfr[++i] ^ 0x20;
+    data[data_len++] = c;
+  }
+  if (data_len != len)
+    return gdb_reply("E01");
+
+  memcpy(dst, data, len);
+  JitInterface::InvalidateICache(addr, len, true);
   gdb_reply("OK");
 }
 
@@ -656,6 +794,10 @@ bool gdb_add_bp(u32 type, u32 addr, u32 len)
   bp->addr = addr;
   bp->len = len;
 
+  // So that the JIT checks for the breakpoint at its address, which runs no slower elsewhere
+  if (type == GDB_BP_TYPE_X)
+    PowerPC::breakpoints.Add(addr, false);
+
   DEBUG_LOG(GDB_STUB, "gdb: added %d breakpoint: %08x bytes at %08x", type, bp->len, bp->addr);
   return true;
 }
@@ -782,6 +924,14 @@ void gdb_handle_exception()
       PowerPC::ppcState.iCache.Reset();
       Host_UpdateDisasmDialog();
       break;
+    case 'x':
+      gdb_read_mem_binary();
+      break;
+    case 'X':
+      gdb_write_mem_binary();
+      PowerPC::ppcState.iCache.Reset();
+      Host_UpdateDisasmDialog();
+      break;
     case 's':
       gdb_step();
       return;
@@ -857,6 +1007,8 @@ static void gdb_init_generic(int domain, const sockaddr* server_addr, socklen_t
 
   memset(bp_x, 0, sizeof bp_x);
   memset(bp_r, 0, sizeof bp_r);
+  recv_pos = recv_len = 0;
+  jit_step = 0;
   memset(bp_w, 0, sizeof bp_w);
   memset(bp_a, 0, sizeof bp_a);
 
@@ -929,6 +1081,12 @@ int gdb_bp_x(u32 addr)
   if (sock == -1)
     return 0;
 
+  if (jit_step)
+  {
+    jit_step = 0;
+    return 0;
+  }
+
   if (step_break)
   {
     step_break = 0;
@@ -940,6 +1098,31 @@ int gdb_bp_x(u32 addr)
   return gdb_bp_check(addr, GDB_BP_TYPE_X);
 }
 
+bool gdb_jit_breakpoint(u32 addr)
+{
+  if (sock == -1 || !gdb_bp_check(addr, GDB_BP_TYPE_X))
+    return false;
+
+  Host_UpdateDisasmDialog();
+  gdb_signal(SIGTRAP);
+  gdb_handle_exception();
+
+  if (!step_break)
+    return false;
+  jit_step = 1;
+  return true;
+}
+
+bool gdb_stepping()
+{
+  return sock != -1 && (step_break || jit_step);
+}
+
+bool gdb_jit_step_pending()
+{
+  return sock != -1 && jit_step;
+}
+
 int gdb_bp_r(u32 addr)
 {
   if (sock == -1)
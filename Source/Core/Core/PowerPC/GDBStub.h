@@ -32,6 +32,13 @@ void gdb_handle_exception();
 int gdb_signal(u32 signal);
 
 int gdb_bp_x(u32 addr);
+// Called by JIT code at addresses with a breakpoint. Returns whether the CPU has to stop, for
+// the interpreter to run a step asked for meanwhile.
+bool gdb_jit_breakpoint(u32 addr);
+// Whether GDB asked for a step which hasn't been reported yet
+bool gdb_stepping();
+// Whether the CPU was stopped after gdb_jit_breakpoint, and the step hasn't started yet
+bool gdb_jit_step_pending();
 int gdb_bp_r(u32 addr);
 int gdb_bp_w(u32 addr);
 int gdb_bp_a(u32 addr);
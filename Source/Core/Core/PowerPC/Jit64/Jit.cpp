@@ -4,6 +4,7 @@
 
 #include "Core/PowerPC/Jit64/Jit.h"
 
+#include <algorithm>
 #include <map>
 #include <string>
 
@@ -13,12 +14,15 @@
 #endif
 
 #include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
 #include "Common/File.h"
 #include "Common/Logging/Log.h"
+#include "Common/Logging/Trace.h"
 #include "Common/MemoryUtil.h"
 #include "Common/PerformanceCounter.h"
 #include "Common/StringUtil.h"
 #include "Common/x64ABI.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
 #include "Core/HLE/HLE.h"
@@ -41,6 +45,13 @@
 using namespace Gen;
 using namespace PowerPC;
 
+// Amount of near code freed at a time once the code space wraps around.
+constexpr size_t CODE_EVICTION_CHUNK = CODE_SIZE / 16;
+// Minimum free near code required before compiling a block; matches IsAlmostFull().
+constexpr ptrdiff_t CODE_EVICTION_MARGIN = 0x10000;
+// Number of runs after which a block is compiled again in the hot code.
+constexpr u32 HOT_BLOCK_THRESHOLD = 1000;
+
 // Dolphin's PowerPC->x86_64 JIT dynamic recompiler
 // Written mostly by ector (hrydgard)
 // Features:
@@ -226,11 +237,16 @@ void Jit64::Init()
   const size_t trampolines_size = jo.memcheck ? TRAMPOLINE_CODE_SIZE_MMU : TRAMPOLINE_CODE_SIZE;
   const size_t farcode_size = jo.memcheck ? FARCODE_SIZE_MMU : FARCODE_SIZE;
   const size_t constpool_size = m_const_pool.CONST_POOL_SIZE;
-  AllocCodeSpace(CODE_SIZE + routines_size + trampolines_size + farcode_size + constpool_size);
+  AllocCodeSpace(CODE_SIZE + HOT_CODE_SIZE + routines_size + trampolines_size + farcode_size +
+                 constpool_size);
+  if (Config::Get(Config::MAIN_HUGE_PAGES))
+    Common::AdviseHugePages(region, total_region_size);
+  AddChildCodeSpace(&m_hot_code, HOT_CODE_SIZE);
   AddChildCodeSpace(&asm_routines, routines_size);
   AddChildCodeSpace(&trampolines, trampolines_size);
   AddChildCodeSpace(&m_far_code, farcode_size);
   m_const_pool.Init(AllocChildCodeSpace(constpool_size), constpool_size);
+  m_evicted_code_end = region + region_size;
 
   // BLR optimization has the same consequences as block linking, as well as
   // depending on the fault handler to be safe in the event of excessive BL.
@@ -262,10 +278,35 @@ void Jit64::ClearCache()
   blocks.Clear();
   trampolines.ClearCodeSpace();
   m_far_code.ClearCodeSpace();
+  m_hot_code.ClearCodeSpace();
   m_const_pool.Clear();
   ClearCodeSpace();
   Clear();
   UpdateMemoryOptions();
+  m_evicted_code_end = region + region_size;
+}
+
+void Jit64::EvictOldestBlocks()
+{
+  // Instead of flushing everything when the near code space fills up, wrap around and use it as a
+  // ring buffer. The oldest blocks are evicted one chunk at a time just ahead of the write
+  // pointer, and every block linking into them is unlinked first. This is safe here because the
+  // dispatcher resets the stack before calling Jit(), so no host code of a block is live.
+  if (IsAlmostFull())
+  {
+    ResetCodePtr();
+    m_evicted_code_end = region;
+  }
+
+  if (m_evicted_code_end - GetCodePtr() >= CODE_EVICTION_MARGIN)
+    return;
+
+  u8* const region_end = region + region_size;
+  u8* const evict_end =
+      m_evicted_code_end + std::min<size_t>(CODE_EVICTION_CHUNK, region_end - m_evicted_code_end);
+  blocks.EraseHostCodeRange(m_evicted_code_end, evict_end);
+  EraseBackPatchInfo(m_evicted_code_end, evict_end);
+  m_evicted_code_end = evict_end;
 }
 
 void Jit64::Shutdown()
@@ -280,6 +321,7 @@ void Jit64::Shutdown()
 
 void Jit64::FallBackToInterpreter(UGeckoInstruction inst)
 {
+  FlushGatherPipeWrites();
   gpr.Flush();
   fpr.Flush();
   if (js.op->opinfo->flags & FL_ENDBLOCK)
@@ -349,6 +391,26 @@ static void ImHere()
   been_here[PC] = 1;
 }
 
+bool Jit64::IsConstantAddressStore(const PPCAnalyst::CodeOp& op)
+{
+  switch (op.inst.OPCD)
+  {
+  case 36:  // stw
+  case 37:  // stwu
+  case 38:  // stb
+  case 39:  // stbu
+  case 44:  // sth
+  case 45:  // sthu
+  case 52:  // stfs
+  case 53:  // stfsu
+  case 54:  // stfd
+  case 55:  // stfdu
+    return !jo.memcheck && (op.inst.RA == 0 || gpr.R(op.inst.RA).IsImm());
+  default:
+    return false;
+  }
+}
+
 bool Jit64::Cleanup()
 {
   bool did_something = false;
@@ -566,6 +628,8 @@ void Jit64::Trace()
 
 void Jit64::Jit(u32 em_address)
 {
+  TRACE_SCOPE("Jit64::Jit");
+
   if (m_cleanup_after_stackfault)
   {
     ClearCache();
@@ -576,11 +640,15 @@ void Jit64::Jit(u32 em_address)
 #endif
   }
 
-  if (IsAlmostFull() || m_far_code.IsAlmostFull() || trampolines.IsAlmostFull() ||
+  if (m_far_code.IsAlmostFull() || trampolines.IsAlmostFull() ||
       SConfig::GetInstance().bJITNoBlockCache)
   {
     ClearCache();
   }
+  else
+  {
+    EvictOldestBlocks();
+  }
 
   int blockSize = code_buffer.GetSize();
 
@@ -624,8 +692,25 @@ void Jit64::Jit(u32 em_address)
     return;
   }
 
+  ApplyHints(&code_buffer);
+
   JitBlock* b = blocks.AllocateBlock(em_address);
+
+  // Blocks which became hot are compiled again in their own region, in the order they became
+  // hot, so the blocks of hot loops and call chains end up next to each other instead of being
+  // scattered through the near code in compile order.
+  const bool hot = js.hotBlockAddresses.count(em_address) != 0 && !m_hot_code.IsAlmostFull();
+  u8* const near_code = GetWritableCodePtr();
+  if (hot)
+    SetCodePtr(m_hot_code.GetWritableCodePtr());
+
   DoJit(em_address, &code_buffer, b, nextPC);
+
+  if (hot)
+  {
+    m_hot_code.SetCodePtr(GetWritableCodePtr());
+    SetCodePtr(near_code);
+  }
   blocks.FinalizeBlock(*b, jo.enableBlocklink, code_block.m_physical_addresses);
 }
 
@@ -635,6 +720,7 @@ const u8* Jit64::DoJit(u32 em_address, PPCAnalyst::CodeBuffer* code_buf, JitBloc
   js.isLastInstruction = false;
   js.blockStart = em_address;
   js.fifoBytesSinceCheck = 0;
+  js.fifoBytesUnflushed = 0;
   js.mustCheckFifo = false;
   js.curBlock = b;
   js.numLoadStoreInst = 0;
@@ -664,6 +750,26 @@ const u8* Jit64::DoJit(u32 em_address, PPCAnalyst::CodeBuffer* code_buf, JitBloc
     ABI_PopRegistersAndAdjustStack({}, 0);
   }
 
+  // Count the runs of cold blocks, and have them compiled again as hot blocks once they ran often
+  // enough. Nothing of the block ran yet at this point.
+  if (!m_hot_code.IsInSpace(start) && !m_hot_code.IsAlmostFull())
+  {
+    b->hot_countdown = HOT_BLOCK_THRESHOLD;
+    MOV(64, R(RSCRATCH), ImmPtr(&b->hot_countdown));
+    SUB(32, MatR(RSCRATCH), Imm8(1));
+    FixupBranch became_hot = J_CC(CC_Z, true);
+
+    SwitchToFarCode();
+    SetJumpTarget(became_hot);
+    MOV(32, PPCSTATE(pc), Imm32(js.blockStart));
+    ABI_PushRegistersAndAdjustStack({}, 0);
+    ABI_CallFunctionC(JitInterface::CompileExceptionCheck,
+                      static_cast<u32>(JitInterface::ExceptionType::HotBlock));
+    ABI_PopRegistersAndAdjustStack({}, 0);
+    JMP(asm_routines.dispatcherNoCheck, true);
+    SwitchToNearCode();
+  }
+
   // Conditionally add profiling code.
   if (Profiler::g_ProfileBlocks)
   {
@@ -754,9 +860,15 @@ const u8* Jit64::DoJit(u32 em_address, PPCAnalyst::CodeBuffer* code_buf, JitBloc
     bool gatherPipeIntCheck =
         js.fifoWriteAddresses.find(ops[i].address) != js.fifoWriteAddresses.end();
 
+    // A run of gather pipe writes goes on through stores to constant addresses, but anything else
+    // might read the gather pipe pointer or leave the block.
+    if (gatherPipeIntCheck || !IsConstantAddressStore(ops[i]))
+      FlushGatherPipeWrites();
+
     // Gather pipe writes using an immediate address are explicitly tracked.
     if (jo.optimizeGatherPipe && (js.fifoBytesSinceCheck >= 32 || js.mustCheckFifo))
     {
+      FlushGatherPipeWrites();
       js.fifoBytesSinceCheck = 0;
       js.mustCheckFifo = false;
       BitSet32 registersInUse = CallerSavedRegistersInUse();
@@ -798,6 +910,7 @@ const u8* Jit64::DoJit(u32 em_address, PPCAnalyst::CodeBuffer* code_buf, JitBloc
     u32 function = HLE::GetFirstFunctionIndex(ops[i].address);
     if (function != 0)
     {
+      FlushGatherPipeWrites();
       int type = HLE::GetFunctionTypeByIndex(function);
       if (type == HLE::HLE_HOOK_START || type == HLE::HLE_HOOK_REPLACE)
       {
@@ -821,6 +934,7 @@ const u8* Jit64::DoJit(u32 em_address, PPCAnalyst::CodeBuffer* code_buf, JitBloc
       if ((opinfo->flags & FL_USE_FPU) && !js.firstFPInstructionFound)
       {
         // This instruction uses FPU - needs to add FP exception bailout
+        FlushGatherPipeWrites();
         TEST(32, PPCSTATE(msr), Imm32(1 << 13));  // Test FP enabled bit
         FixupBranch b1 = J_CC(CC_Z, true);
 
@@ -839,13 +953,14 @@ const u8* Jit64::DoJit(u32 em_address, PPCAnalyst::CodeBuffer* code_buf, JitBloc
         js.firstFPInstructionFound = true;
       }
 
-      if (SConfig::GetInstance().bEnableDebugging &&
-          breakpoints.IsAddressBreakPoint(ops[i].address) && !CPU::IsStepping())
+      // Breakpoints are only set with debugging enabled or through GDB.
+      if (breakpoints.IsAddressBreakPoint(ops[i].address) && !CPU::IsStepping())
       {
         // Turn off block linking if there are breakpoints so that the Step Over command does not
         // link this block.
         jo.enableBlocklink = false;
 
+        FlushGatherPipeWrites();
         gpr.Flush();
         fpr.Flush();
 
@@ -950,6 +1065,8 @@ const u8* Jit64::DoJit(u32 em_address, PPCAnalyst::CodeBuffer* code_buf, JitBloc
     js.skipInstructions = 0;
   }
 
+  FlushGatherPipeWrites();
+
   if (code_block.m_broken)
   {
     gpr.Flush();
@@ -75,6 +75,9 @@ public:
   void WriteExternalExceptionExit();
   void WriteRfiExitDestInRSCRATCH();
   bool Cleanup();
+  // Whether the op is a store which keeps a run of gather pipe writes going, see
+  // EmuCodeBlock::UnsafeWriteGatherPipe.
+  bool IsConstantAddressStore(const PPCAnalyst::CodeOp& op);
 
   void GenerateConstantOverflow(bool overflow);
   void GenerateConstantOverflow(s64 val);
@@ -237,6 +240,8 @@ private:
   void AllocStack();
   void FreeStack();
 
+  void EvictOldestBlocks();
+
   GPRRegCache gpr{*this};
   FPURegCache fpr{*this};
 
@@ -248,4 +253,8 @@ private:
   bool m_enable_blr_optimization;
   bool m_cleanup_after_stackfault;
   u8* m_stack;
+
+  // Near code between the write pointer and this address is free. Once the near code space has
+  // been filled, this trails just ahead of the write pointer, see EvictOldestBlocks().
+  u8* m_evicted_code_end = nullptr;
 };
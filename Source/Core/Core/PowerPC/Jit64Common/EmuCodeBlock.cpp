@@ -11,6 +11,7 @@
 #include "Common/CPUDetect.h"
 #include "Common/Intrinsics.h"
 #include "Common/MathUtil.h"
+#include "Core/HW/GPFifo.h"
 #include "Core/HW/MMIO.h"
 #include "Core/HW/Memmap.h"
 #include "Core/PowerPC/Gekko.h"
@@ -205,26 +206,25 @@ bool EmuCodeBlock::UnsafeLoadToReg(X64Reg reg_value, OpArg opAddress, int access
 
 void EmuCodeBlock::UnsafeWriteGatherPipe(int accessSize)
 {
-  // No need to protect these, they don't touch any state
-  // question - should we inline them instead? Pro: Lose a CALL   Con: Code bloat
-  switch (accessSize)
-  {
-  case 8:
-    CALL(g_jit->GetAsmRoutines()->fifoDirectWrite8);
-    break;
-  case 16:
-    CALL(g_jit->GetAsmRoutines()->fifoDirectWrite16);
-    break;
-  case 32:
-    CALL(g_jit->GetAsmRoutines()->fifoDirectWrite32);
-    break;
-  case 64:
-    CALL(g_jit->GetAsmRoutines()->fifoDirectWrite64);
-    break;
-  }
+  // Value in RSCRATCH. The pointer is only advanced by FlushGatherPipeWrites, once for a run of
+  // writes, so each write goes after the ones before it in the run.
+  MOV(64, R(RSCRATCH2), ImmPtr(&GPFifo::g_gather_pipe_ptr));
+  MOV(64, R(RSCRATCH2), MatR(RSCRATCH2));
+  SwapAndStore(accessSize, MDisp(RSCRATCH2, g_jit->js.fifoBytesUnflushed), RSCRATCH);
+  g_jit->js.fifoBytesUnflushed += accessSize >> 3;
   g_jit->js.fifoBytesSinceCheck += accessSize >> 3;
 }
 
+void EmuCodeBlock::FlushGatherPipeWrites()
+{
+  if (g_jit->js.fifoBytesUnflushed == 0)
+    return;
+
+  MOV(64, R(RSCRATCH2), ImmPtr(&GPFifo::g_gather_pipe_ptr));
+  ADD(64, MatR(RSCRATCH2), Imm8(g_jit->js.fifoBytesUnflushed));
+  g_jit->js.fifoBytesUnflushed = 0;
+}
+
 // Visitor that generates code to read a MMIO value.
 template <typename T>
 class MMIOReadCodeGenerator : public MMIO::ReadHandlingMethodVisitor<T>
@@ -333,6 +333,111 @@ void EmuCodeBlock::MMIOLoadToReg(MMIO::Mapping* mmio, Gen::X64Reg reg_value,
   }
 }
 
+// Visitor that generates code to write a MMIO value.
+template <typename T>
+class MMIOWriteCodeGenerator : public MMIO::WriteHandlingMethodVisitor<T>
+{
+public:
+  MMIOWriteCodeGenerator(Gen::X64CodeBlock* code, BitSet32 registers_in_use,
+                         const Gen::OpArg& value, u32 address)
+      : m_code(code), m_registers_in_use(registers_in_use), m_value(value), m_address(address)
+  {
+  }
+
+  void VisitNop() override {}
+  void VisitDirect(T* addr, u32 mask) override { WriteToAddrMask(8 * sizeof(T), addr, mask); }
+  void VisitComplex(const std::function<void(u32, T)>* lambda) override
+  {
+    CallLambda(8 * sizeof(T), lambda);
+  }
+
+private:
+  // Generates code to zero extend the value to the given register, masked if needed.
+  void MoveValueToReg(int sbits, Gen::X64Reg reg, u32 mask)
+  {
+    u32 all_ones = (1ULL << sbits) - 1;
+    if (m_value.IsImm())
+    {
+      m_code->MOV(32, R(reg), Imm32(m_value.AsImm32().Imm32() & all_ones & mask));
+      return;
+    }
+
+    if (sbits == 32)
+    {
+      if (!m_value.IsSimpleReg(reg))
+        m_code->MOV(32, R(reg), m_value);
+    }
+    else
+    {
+      m_code->MOVZX(32, sbits, reg, m_value);
+    }
+    if ((all_ones & mask) != all_ones)
+      m_code->AND(32, R(reg), Imm32(mask));
+  }
+
+  void WriteToAddrMask(int sbits, T* ptr, u32 mask)
+  {
+    u32 all_ones = (1ULL << sbits) - 1;
+    m_code->MOV(64, R(RSCRATCH2), ImmPtr(ptr));
+    if (m_value.IsImm())
+    {
+      const u32 value = m_value.AsImm32().Imm32() & mask;
+      m_code->MOV(sbits, MatR(RSCRATCH2),
+                  sbits == 8 ? Imm8(value) : sbits == 16 ? Imm16(value) : Imm32(value));
+    }
+    else if ((all_ones & mask) == all_ones && m_value.IsSimpleReg())
+    {
+      m_code->MOV(sbits, MatR(RSCRATCH2), m_value);
+    }
+    else
+    {
+      MoveValueToReg(sbits, RSCRATCH, mask);
+      m_code->MOV(sbits, MatR(RSCRATCH2), R(RSCRATCH));
+    }
+  }
+
+  void CallLambda(int sbits, const std::function<void(u32, T)>* lambda)
+  {
+    m_code->ABI_PushRegistersAndAdjustStack(m_registers_in_use, 0);
+    // The value can be in ABI_PARAM1 or ABI_PARAM2, so it has to be moved first.
+    MoveValueToReg(sbits, ABI_PARAM3, 0xFFFFFFFF);
+    m_code->ABI_CallFunctionPC(&Gen::XEmitter::CallLambdaTrampoline<void, u32, T>, lambda,
+                               m_address);
+    m_code->ABI_PopRegistersAndAdjustStack(m_registers_in_use, 0);
+  }
+
+  Gen::X64CodeBlock* m_code;
+  BitSet32 m_registers_in_use;
+  Gen::OpArg m_value;
+  u32 m_address;
+};
+
+void EmuCodeBlock::MMIOWriteRegToAddr(MMIO::Mapping* mmio, const Gen::OpArg& value,
+                                      BitSet32 registers_in_use, u32 address, int access_size)
+{
+  switch (access_size)
+  {
+  case 8:
+  {
+    MMIOWriteCodeGenerator<u8> gen(this, registers_in_use, value, address);
+    mmio->GetHandlerForWrite<u8>(address).Visit(gen);
+    break;
+  }
+  case 16:
+  {
+    MMIOWriteCodeGenerator<u16> gen(this, registers_in_use, value, address);
+    mmio->GetHandlerForWrite<u16>(address).Visit(gen);
+    break;
+  }
+  case 32:
+  {
+    MMIOWriteCodeGenerator<u32> gen(this, registers_in_use, value, address);
+    mmio->GetHandlerForWrite<u32>(address).Visit(gen);
+    break;
+  }
+  }
+}
+
 void EmuCodeBlock::SafeLoadToReg(X64Reg reg_value, const Gen::OpArg& opAddress, int accessSize,
                                  s32 offset, BitSet32 registersInUse, bool signExtend, int flags)
 {
@@ -633,8 +738,22 @@ bool EmuCodeBlock::WriteToConstAddress(int accessSize, OpArg arg, u32 address,
     WriteToConstRamAddress(accessSize, arg, address);
     return false;
   }
+  else if (accessSize != 64 && PowerPC::IsOptimizableMMIOAccess(address, accessSize))
+  {
+    const u32 mmio_address = PowerPC::IsOptimizableMMIOAccess(address, accessSize);
+    FlushGatherPipeWrites();
+
+    // Helps external systems know which instruction triggered the write
+    MOV(32, PPCSTATE(pc), Imm32(g_jit->js.compilerPC));
+
+    // The address was translated through the BATs and is a MMIO register, so this can't fault.
+    MMIOWriteRegToAddr(Memory::mmio_mapping.get(), arg, registersInUse, mmio_address, accessSize);
+    return false;
+  }
   else
   {
+    FlushGatherPipeWrites();
+
     // Helps external systems know which instruction triggered the write
     MOV(32, PPCSTATE(pc), Imm32(g_jit->js.compilerPC));
 
@@ -1143,3 +1262,22 @@ void EmuCodeBlock::Clear()
   m_back_patch_info.clear();
   m_exception_handler_at_loc.clear();
 }
+
+void EmuCodeBlock::EraseBackPatchInfo(const u8* begin, const u8* end)
+{
+  for (auto it = m_back_patch_info.begin(); it != m_back_patch_info.end();)
+  {
+    if (it->first >= begin && it->first < end)
+      it = m_back_patch_info.erase(it);
+    else
+      ++it;
+  }
+
+  for (auto it = m_exception_handler_at_loc.begin(); it != m_exception_handler_at_loc.end();)
+  {
+    if (it->first >= begin && it->first < end)
+      it = m_exception_handler_at_loc.erase(it);
+    else
+      ++it;
+  }
+}
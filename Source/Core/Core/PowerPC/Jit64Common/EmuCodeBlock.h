@@ -61,12 +61,17 @@ public:
 
   bool UnsafeLoadToReg(Gen::X64Reg reg_value, Gen::OpArg opAddress, int accessSize, s32 offset,
                        bool signExtend, Gen::MovInfo* info = nullptr);
+  // Writes RSCRATCH to the gather pipe, which has to be followed by FlushGatherPipeWrites before
+  // anything else can see GPFifo::g_gather_pipe_ptr.
   void UnsafeWriteGatherPipe(int accessSize);
+  void FlushGatherPipeWrites();
 
   // Generate a load/write from the MMIO handler for a given address. Only
   // call for known addresses in MMIO range (MMIO::IsMMIOAddress).
   void MMIOLoadToReg(MMIO::Mapping* mmio, Gen::X64Reg reg_value, BitSet32 registers_in_use,
                      u32 address, int access_size, bool sign_extend);
+  void MMIOWriteRegToAddr(MMIO::Mapping* mmio, const Gen::OpArg& value, BitSet32 registers_in_use,
+                          u32 address, int access_size);
 
   enum SafeLoadStoreFlags
   {
@@ -122,6 +127,8 @@ public:
   void ConvertDoubleToSingle(Gen::X64Reg dst, Gen::X64Reg src);
   void SetFPRF(Gen::X64Reg xmm);
   void Clear();
+  // Drops the backpatch information of near code in [begin, end) before it is overwritten.
+  void EraseBackPatchInfo(const u8* begin, const u8* end);
 
 protected:
   ConstantPool m_const_pool;
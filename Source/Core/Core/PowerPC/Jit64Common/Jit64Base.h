@@ -36,6 +36,7 @@ constexpr Gen::X64Reg RMEM = Gen::RBX;
 constexpr Gen::X64Reg RPPCSTATE = Gen::RBP;
 
 constexpr size_t CODE_SIZE = 1024 * 1024 * 32;
+constexpr size_t HOT_CODE_SIZE = 1024 * 1024 * 8;
 
 class Jitx86Base : public JitBase, public QuantizedMemoryRoutines
 {
@@ -43,6 +44,8 @@ protected:
   bool BackPatch(u32 emAddress, SContext* ctx);
   JitBlockCache blocks{*this};
   TrampolineCache trampolines;
+  // Near code of the hot blocks, next to each other in the order they became hot.
+  Gen::X64CodeBlock m_hot_code;
 
 public:
   JitBlockCache* GetBlockCache() override { return &blocks; }
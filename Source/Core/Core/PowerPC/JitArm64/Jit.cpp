@@ -4,15 +4,21 @@
 
 #include "Core/PowerPC/JitArm64/Jit.h"
 
+#include <algorithm>
 #include <cstdio>
+#include <vector>
 
 #include "Common/Arm64Emitter.h"
 #include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
 #include "Common/Logging/Log.h"
+#include "Common/Logging/Trace.h"
 #include "Common/MathUtil.h"
+#include "Common/MemoryUtil.h"
 #include "Common/PerformanceCounter.h"
 #include "Common/StringUtil.h"
 
+#include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
@@ -31,6 +37,11 @@ constexpr size_t CODE_SIZE = 1024 * 1024 * 32;
 constexpr size_t FARCODE_SIZE = 1024 * 1024 * 16;
 constexpr size_t FARCODE_SIZE_MMU = 1024 * 1024 * 48;
 
+// Amount of near code freed at a time once the code space wraps around.
+constexpr size_t CODE_EVICTION_CHUNK = CODE_SIZE / 16;
+// Minimum free near code required before compiling a block; matches IsAlmostFull().
+constexpr ptrdiff_t CODE_EVICTION_MARGIN = 0x10000;
+
 constexpr size_t STACK_SIZE = 2 * 1024 * 1024;
 constexpr size_t SAFE_STACK_SIZE = 512 * 1024;
 constexpr size_t GUARD_SIZE = 0x10000;  // two guards - bottom (permanent) and middle (see above)
@@ -42,6 +53,8 @@ void JitArm64::Init()
 
   size_t child_code_size = SConfig::GetInstance().bMMU ? FARCODE_SIZE_MMU : FARCODE_SIZE;
   AllocCodeSpace(CODE_SIZE + child_code_size);
+  if (Config::Get(Config::MAIN_HUGE_PAGES))
+    Common::AdviseHugePages(region, total_region_size);
   AddChildCodeSpace(&farcode, child_code_size);
   jo.enableBlocklink = true;
   jo.optimizeGatherPipe = true;
@@ -63,6 +76,8 @@ void JitArm64::Init()
 
   AllocStack();
   GenerateAsm();
+  m_block_code_start = GetWritableCodePtr();
+  m_evicted_code_end = region + region_size;
 }
 
 bool JitArm64::HandleFault(uintptr_t access_address, SContext* ctx)
@@ -123,6 +138,32 @@ void JitArm64::ClearCache()
   UpdateMemoryOptions();
 
   GenerateAsm();
+  m_block_code_start = GetWritableCodePtr();
+  m_evicted_code_end = region + region_size;
+}
+
+void JitArm64::EvictOldestBlocks()
+{
+  // Instead of flushing everything when the near code space fills up, wrap around to the first
+  // block and use it as a ring buffer. The oldest blocks are evicted one chunk at a time just
+  // ahead of the write pointer, and every block linking into them is unlinked first. The
+  // dispatcher resets the stack before calling Jit(), so no host code of a block is live here.
+  if (IsAlmostFull())
+  {
+    SetCodePtr(m_block_code_start);
+    m_evicted_code_end = m_block_code_start;
+  }
+
+  if (m_evicted_code_end - GetCodePtr() >= CODE_EVICTION_MARGIN)
+    return;
+
+  u8* const region_end = region + region_size;
+  u8* const evict_end =
+      m_evicted_code_end + std::min<size_t>(CODE_EVICTION_CHUNK, region_end - m_evicted_code_end);
+  blocks.EraseHostCodeRange(m_evicted_code_end, evict_end);
+  m_fault_to_handler.erase(m_fault_to_handler.lower_bound(m_evicted_code_end),
+                           m_fault_to_handler.lower_bound(evict_end));
+  m_evicted_code_end = evict_end;
 }
 
 void JitArm64::Shutdown()
@@ -533,6 +574,8 @@ void JitArm64::SingleStep()
 
 void JitArm64::Jit(u32)
 {
+  TRACE_SCOPE("JitArm64::Jit");
+
   if (m_cleanup_after_stackfault)
   {
     ClearCache();
@@ -543,10 +586,14 @@ void JitArm64::Jit(u32)
 #endif
   }
 
-  if (IsAlmostFull() || farcode.IsAlmostFull() || SConfig::GetInstance().bJITNoBlockCache)
+  if (farcode.IsAlmostFull() || SConfig::GetInstance().bJITNoBlockCache)
   {
     ClearCache();
   }
+  else
+  {
+    EvictOldestBlocks();
+  }
 
   int blockSize = code_buffer.GetSize();
   u32 em_address = PowerPC::ppcState.pc;
@@ -572,6 +619,8 @@ void JitArm64::Jit(u32)
     return;
   }
 
+  ApplyHints(&code_buffer);
+
   JitBlock* b = blocks.AllocateBlock(em_address);
   DoJit(em_address, &code_buffer, b, nextPC);
   blocks.FinalizeBlock(*b, jo.enableBlocklink, code_block.m_physical_addresses);
@@ -587,7 +636,7 @@ void JitArm64::DoJit(u32 em_address, PPCAnalyst::CodeBuffer* code_buf, JitBlock*
 
   js.isLastInstruction = false;
   js.firstFPInstructionFound = false;
-  js.assumeNoPairedQuantize = false;
+  js.constantGqr.clear();
   js.blockStart = em_address;
   js.fifoBytesSinceCheck = 0;
   js.mustCheckFifo = false;
@@ -619,27 +668,43 @@ void JitArm64::DoJit(u32 em_address, PPCAnalyst::CodeBuffer* code_buf, JitBlock*
     BeginTimeProfile(b);
   }
 
-  if (code_block.m_gqr_used.Count() == 1 &&
+  // Assume that the GQRs which are used but not set in the block don't change often at runtime,
+  // so that the quantized loads and stores can be specialized for their values.
+  const BitSet8 gqr_static = code_block.m_gqr_used & ~code_block.m_gqr_modified;
+  if (gqr_static &&
       js.pairedQuantizeAddresses.find(js.blockStart) == js.pairedQuantizeAddresses.end())
   {
-    int gqr = *code_block.m_gqr_used.begin();
-    if (!code_block.m_gqr_modified[gqr] && !GQR(gqr))
+    std::vector<FixupBranch> fails;
+    for (int gqr : gqr_static)
     {
+      const u32 value = GQR(gqr);
       LDR(INDEX_UNSIGNED, W0, PPC_REG, PPCSTATE_OFF(spr[SPR_GQR0]) + gqr * 4);
-      FixupBranch no_fail = CBZ(W0);
-      FixupBranch fail = B();
-      SwitchToFarCode();
-      SetJumpTarget(fail);
-      MOVI2R(DISPATCHER_PC, js.blockStart);
-      STR(INDEX_UNSIGNED, DISPATCHER_PC, PPC_REG, PPCSTATE_OFF(pc));
-      MOVI2R(W0, static_cast<u32>(JitInterface::ExceptionType::PairedQuantize));
-      MOVP2R(X1, &JitInterface::CompileExceptionCheck);
-      BLR(X1);
-      B(dispatcher);
-      SwitchToNearCode();
-      SetJumpTarget(no_fail);
-      js.assumeNoPairedQuantize = true;
+      FixupBranch pass;
+      if (value == 0)
+      {
+        pass = CBZ(W0);
+      }
+      else
+      {
+        MOVI2R(W1, value);
+        CMP(W0, W1);
+        pass = B(CC_EQ);
+      }
+      fails.push_back(B());
+      SetJumpTarget(pass);
+      js.constantGqr[gqr] = value;
     }
+
+    SwitchToFarCode();
+    for (const FixupBranch& fail : fails)
+      SetJumpTarget(fail);
+    MOVI2R(DISPATCHER_PC, js.blockStart);
+    STR(INDEX_UNSIGNED, DISPATCHER_PC, PPC_REG, PPCSTATE_OFF(pc));
+    MOVI2R(W0, static_cast<u32>(JitInterface::ExceptionType::PairedQuantize));
+    MOVP2R(X1, &JitInterface::CompileExceptionCheck);
+    BLR(X1);
+    B(dispatcher);
+    SwitchToNearCode();
   }
 
   gpr.Start(js.gpa);
@@ -766,6 +831,21 @@ void JitArm64::DoJit(u32 em_address, PPCAnalyst::CodeBuffer* code_buf, JitBlock*
         js.firstFPInstructionFound = true;
       }
 
+      // Instructions can be merged with the next one, so its registers count as used as well.
+      BitSet32 gprs_used = ops[i].regsIn | ops[i].regsOut;
+      BitSet32 fprs_used = ops[i].fregsIn;
+      if (ops[i].fregOut >= 0)
+        fprs_used[ops[i].fregOut] = true;
+      if (i + 1 < code_block.m_num_instructions)
+      {
+        gprs_used |= ops[i + 1].regsIn | ops[i + 1].regsOut;
+        fprs_used |= ops[i + 1].fregsIn;
+        if (ops[i + 1].fregOut >= 0)
+          fprs_used[ops[i + 1].fregOut] = true;
+      }
+      gpr.SetLiveness(gprs_used, ops[i].gprInUse);
+      fpr.SetLiveness(fprs_used, ops[i].fprInUse);
+
       CompileInstruction(ops[i]);
       if (!CanMergeNextInstructions(1) || js.op[1].opinfo->type != OPTYPE_INTEGER)
         FlushCarry();
@@ -169,6 +169,8 @@ private:
   {
     u32 length;
     const u8* slowmem_code;
+    // The guest instruction doing the access.
+    u32 pc;
   };
 
   static void InitializeInstructionTables();
@@ -204,6 +206,7 @@ private:
 
   void DoDownCount();
   void Cleanup();
+  void EvictOldestBlocks();
   void ResetStack();
   void AllocStack();
   void FreeStack();
@@ -255,4 +258,9 @@ private:
   u8* m_stack_base = nullptr;
   u8* m_stack_pointer = nullptr;
   u8* m_saved_stack_pointer = nullptr;
+
+  // Block code starts after the dispatcher. Near code between the write pointer and
+  // m_evicted_code_end is free, see EvictOldestBlocks().
+  u8* m_block_code_start = nullptr;
+  u8* m_evicted_code_end = nullptr;
 };
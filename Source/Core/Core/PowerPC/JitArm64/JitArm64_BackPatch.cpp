@@ -154,6 +154,7 @@ void JitArm64::EmitBackpatchRoutine(u32 flags, bool fastmem, bool do_farcode, AR
       handler.flags = flags;
 
       FastmemArea* fastmem_area = &m_fault_to_handler[fastmem_start];
+      fastmem_area->pc = js.compilerPC;
       auto handler_loc_iter = m_handler_to_loc.find(handler);
 
       if (handler_loc_iter == m_handler_to_loc.end())
@@ -309,7 +310,8 @@ bool JitArm64::HandleFastmemFault(uintptr_t access_address, SContext* ctx)
   if ((const u8*)ctx->CTX_PC - slow_handler_iter->first > slow_handler_iter->second.length)
     return false;
 
-  ARM64XEmitter emitter((u8*)slow_handler_iter->first);
+  const u8* fastmem_start = slow_handler_iter->first;
+  ARM64XEmitter emitter(const_cast<u8*>(fastmem_start));
 
   emitter.BL(slow_handler_iter->second.slowmem_code);
 
@@ -317,9 +319,10 @@ bool JitArm64::HandleFastmemFault(uintptr_t access_address, SContext* ctx)
   for (u32 i = 0; i < num_insts_max; ++i)
     emitter.HINT(HINT_NOP);
 
+  RecordFastmemFallback(slow_handler_iter->second.pc);
   m_fault_to_handler.erase(slow_handler_iter);
 
   emitter.FlushIcache();
-  ctx->CTX_PC = (u64)slow_handler_iter->first;
+  ctx->CTX_PC = reinterpret_cast<u64>(fastmem_start);
   return true;
 }
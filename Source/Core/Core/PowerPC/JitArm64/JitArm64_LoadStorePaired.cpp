@@ -34,6 +34,11 @@ void JitArm64::psq_l(UGeckoInstruction inst)
   bool update = inst.OPCD == 57;
   s32 offset = inst.SIMM_12;
 
+  // Loads use the upper half of the GQR.
+  auto it = js.constantGqr.find(inst.I);
+  const bool gqr_is_constant = it != js.constantGqr.end();
+  const u32 gqr_value = gqr_is_constant ? it->second >> 16 : 0;
+
   gpr.Lock(W0, W1, W2, W30);
   fpr.Lock(Q0, Q1);
 
@@ -61,7 +66,7 @@ void JitArm64::psq_l(UGeckoInstruction inst)
     MOV(arm_addr, addr_reg);
   }
 
-  if (js.assumeNoPairedQuantize)
+  if (gqr_is_constant && (gqr_value & 0x7) == QUANTIZE_FLOAT)
   {
     VS = fpr.RW(inst.RS, REG_REG_SINGLE);
     if (!inst.W)
@@ -77,12 +82,22 @@ void JitArm64::psq_l(UGeckoInstruction inst)
   }
   else
   {
-    LDR(INDEX_UNSIGNED, scale_reg, PPC_REG, PPCSTATE_OFF(spr[SPR_GQR0 + inst.I]));
-    UBFM(type_reg, scale_reg, 16, 18);   // Type
-    UBFM(scale_reg, scale_reg, 24, 29);  // Scale
+    const u8** routines = inst.W ? singleLoadQuantized : pairedLoadQuantized;
+    if (gqr_is_constant)
+    {
+      // The type and scale are known, so call the routine for them directly.
+      MOVI2R(scale_reg, (gqr_value >> 8) & 0x3F);
+      MOVP2R(X30, routines[gqr_value & 0x7]);
+    }
+    else
+    {
+      LDR(INDEX_UNSIGNED, scale_reg, PPC_REG, PPCSTATE_OFF(spr[SPR_GQR0 + inst.I]));
+      UBFM(type_reg, scale_reg, 16, 18);   // Type
+      UBFM(scale_reg, scale_reg, 24, 29);  // Scale
 
-    MOVP2R(X30, inst.W ? singleLoadQuantized : pairedLoadQuantized);
-    LDR(X30, X30, ArithOption(EncodeRegTo64(type_reg), true));
+      MOVP2R(X30, routines);
+      LDR(X30, X30, ArithOption(EncodeRegTo64(type_reg), true));
+    }
     BLR(X30);
 
     VS = fpr.RW(inst.RS, REG_REG_SINGLE);
@@ -116,6 +131,11 @@ void JitArm64::psq_st(UGeckoInstruction inst)
   bool update = inst.OPCD == 61;
   s32 offset = inst.SIMM_12;
 
+  // Stores use the lower half of the GQR.
+  auto it = js.constantGqr.find(inst.I);
+  const bool gqr_is_constant = it != js.constantGqr.end();
+  const u32 gqr_value = gqr_is_constant ? it->second & 0xFFFF : 0;
+
   gpr.Lock(W0, W1, W2, W30);
   fpr.Lock(Q0, Q1);
 
@@ -153,7 +173,7 @@ void JitArm64::psq_st(UGeckoInstruction inst)
     MOV(arm_addr, addr_reg);
   }
 
-  if (js.assumeNoPairedQuantize)
+  if (gqr_is_constant && (gqr_value & 0x7) == QUANTIZE_FLOAT)
   {
     u32 flags = BackPatchInfo::FLAG_STORE;
 
@@ -179,9 +199,16 @@ void JitArm64::psq_st(UGeckoInstruction inst)
         m_float_emit.FCVTN(32, D0, VS);
     }
 
-    LDR(INDEX_UNSIGNED, scale_reg, PPC_REG, PPCSTATE_OFF(spr[SPR_GQR0 + inst.I]));
-    UBFM(type_reg, scale_reg, 0, 2);    // Type
-    UBFM(scale_reg, scale_reg, 8, 13);  // Scale
+    if (gqr_is_constant)
+    {
+      MOVI2R(scale_reg, (gqr_value >> 8) & 0x3F);
+    }
+    else
+    {
+      LDR(INDEX_UNSIGNED, scale_reg, PPC_REG, PPCSTATE_OFF(spr[SPR_GQR0 + inst.I]));
+      UBFM(type_reg, scale_reg, 0, 2);    // Type
+      UBFM(scale_reg, scale_reg, 8, 13);  // Scale
+    }
 
     // Inline address check
     // FIXME: This doesn't correctly account for the BAT configuration.
@@ -192,8 +219,15 @@ void JitArm64::psq_st(UGeckoInstruction inst)
     SwitchToFarCode();
     SetJumpTarget(fail);
     // Slow
-    MOVP2R(X30, &pairedStoreQuantized[16 + inst.W * 8]);
-    LDR(EncodeRegTo64(type_reg), X30, ArithOption(EncodeRegTo64(type_reg), true));
+    if (gqr_is_constant)
+    {
+      MOVP2R(EncodeRegTo64(type_reg), pairedStoreQuantized[16 + inst.W * 8 + (gqr_value & 0x7)]);
+    }
+    else
+    {
+      MOVP2R(X30, &pairedStoreQuantized[16 + inst.W * 8]);
+      LDR(EncodeRegTo64(type_reg), X30, ArithOption(EncodeRegTo64(type_reg), true));
+    }
 
     ABI_PushRegisters(gprs_in_use);
     m_float_emit.ABI_PushRegisters(fprs_in_use, X30);
@@ -205,9 +239,17 @@ void JitArm64::psq_st(UGeckoInstruction inst)
     SetJumpTarget(pass);
 
     // Fast
-    MOVP2R(X30, &pairedStoreQuantized[inst.W * 8]);
-    LDR(EncodeRegTo64(type_reg), X30, ArithOption(EncodeRegTo64(type_reg), true));
-    BLR(EncodeRegTo64(type_reg));
+    if (gqr_is_constant)
+    {
+      MOVP2R(X30, pairedStoreQuantized[inst.W * 8 + (gqr_value & 0x7)]);
+      BLR(X30);
+    }
+    else
+    {
+      MOVP2R(X30, &pairedStoreQuantized[inst.W * 8]);
+      LDR(EncodeRegTo64(type_reg), X30, ArithOption(EncodeRegTo64(type_reg), true));
+      BLR(EncodeRegTo64(type_reg));
+    }
 
     SetJumpTarget(continue1);
   }
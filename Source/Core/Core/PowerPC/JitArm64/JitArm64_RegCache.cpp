@@ -24,6 +24,12 @@ void Arm64RegCache::Init(ARM64XEmitter* emitter)
   GetAllocationOrder();
 }
 
+void Arm64RegCache::Start(PPCAnalyst::BlockRegStats& stats)
+{
+  m_reg_stats = &stats;
+  SetLiveness(BitSet32(~0U), BitSet32(~0U));
+}
+
 ARM64Reg Arm64RegCache::GetReg()
 {
   // If we have no registers left, dump the most stale register first
@@ -72,19 +78,33 @@ void Arm64RegCache::UnlockRegister(ARM64Reg host_reg)
 
 void Arm64RegCache::FlushMostStaleRegister()
 {
+  // Among the registers the current instruction doesn't use, those the rest of the block doesn't
+  // need go first, then clean ones, which don't need a store and only cost a load if needed again.
+  // Within each of these, and for all other registers, the most stale one goes.
   size_t most_stale_preg = 0;
-  u32 most_stale_amount = 0;
+  u64 best_score = 0;
 
   for (size_t i = 0; i < m_guest_registers.size(); ++i)
   {
     const auto& reg = m_guest_registers[i];
     const u32 last_used = reg.GetLastUsed();
 
-    if (last_used > most_stale_amount &&
-        (reg.GetType() != REG_NOTLOADED && reg.GetType() != REG_IMM))
+    if (last_used == 0 || reg.GetType() == REG_NOTLOADED || reg.GetType() == REG_IMM)
+      continue;
+
+    u64 score = last_used;
+    if (i < 32 && !m_used_now[i])
+    {
+      if (!m_used_later[i])
+        score |= u64(2) << 32;
+      else if (!reg.IsDirty())
+        score |= u64(1) << 32;
+    }
+
+    if (score > best_score)
     {
       most_stale_preg = i;
-      most_stale_amount = last_used;
+      best_score = score;
     }
   }
 
@@ -101,10 +121,6 @@ Arm64GPRCache::Arm64GPRCache() : Arm64RegCache(GUEST_GPR_COUNT + GUEST_CR_COUNT)
 {
 }
 
-void Arm64GPRCache::Start(PPCAnalyst::BlockRegStats& stats)
-{
-}
-
 bool Arm64GPRCache::IsCalleeSaved(ARM64Reg reg)
 {
   static constexpr std::array<ARM64Reg, 11> callee_regs{{
@@ -9,6 +9,7 @@
 #include <vector>
 
 #include "Common/Arm64Emitter.h"
+#include "Common/BitSet.h"
 #include "Common/CommonTypes.h"
 #include "Core/PowerPC/Gekko.h"
 #include "Core/PowerPC/PPCAnalyst.h"
@@ -55,7 +56,10 @@ enum FlushMode
 class OpArg
 {
 public:
-  OpArg() : m_type(REG_NOTLOADED), m_reg(INVALID_REG), m_value(0), m_last_used(0) {}
+  OpArg()
+      : m_type(REG_NOTLOADED), m_reg(INVALID_REG), m_value(0), m_last_used(0), m_dirty(false)
+  {
+  }
   RegType GetType() const { return m_type; }
   ARM64Reg GetReg() const { return m_reg; }
   u32 GetImm() const { return m_value; }
@@ -124,7 +128,15 @@ public:
 
   void Init(ARM64XEmitter* emitter);
 
-  virtual void Start(PPCAnalyst::BlockRegStats& stats) {}
+  virtual void Start(PPCAnalyst::BlockRegStats& stats);
+
+  // The guest registers the instruction being compiled uses, and those that the rest of the block
+  // still needs. When running out of host registers, they decide which guest register to flush.
+  void SetLiveness(BitSet32 used_now, BitSet32 used_later)
+  {
+    m_used_now = used_now;
+    m_used_later = used_later;
+  }
   // Flushes the register cache in different ways depending on the mode
   virtual void Flush(FlushMode mode, PPCAnalyst::CodeOp* op) = 0;
 
@@ -201,6 +213,10 @@ protected:
 
   // Register stats for the current block
   PPCAnalyst::BlockRegStats* m_reg_stats;
+
+  // See SetLiveness. Only covers the first 32 guest registers, the others count as used.
+  BitSet32 m_used_now;
+  BitSet32 m_used_later;
 };
 
 class Arm64GPRCache : public Arm64RegCache
@@ -208,7 +224,6 @@ class Arm64GPRCache : public Arm64RegCache
 public:
   Arm64GPRCache();
   ~Arm64GPRCache() {}
-  void Start(PPCAnalyst::BlockRegStats& stats) override;
 
   // Flushes the register cache in different ways depending on the mode
   void Flush(FlushMode mode, PPCAnalyst::CodeOp* op = nullptr) override;
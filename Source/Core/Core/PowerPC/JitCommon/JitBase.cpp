@@ -4,10 +4,17 @@
 
 #include "Core/PowerPC/JitCommon/JitBase.h"
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 #include "Common/CommonTypes.h"
+#include "Common/Logging/Log.h"
 #include "Core/ConfigManager.h"
 #include "Core/HW/CPU.h"
+#include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/PPCAnalyst.h"
+#include "Core/PowerPC/PPCSymbolDB.h"
 #include "Core/PowerPC/PowerPC.h"
 
 JitBase* g_jit;
@@ -43,8 +50,51 @@ bool JitBase::CanMergeNextInstructions(int count) const
   return true;
 }
 
+void JitBase::ApplyHints(const PPCAnalyst::CodeBuffer* code_buf)
+{
+  for (const JitHintCache::Hint& hint :
+       hint_cache.GetHints(code_buf->codebuffer, code_block.m_num_instructions))
+  {
+    switch (hint.type)
+    {
+    case JitInterface::ExceptionType::FIFOWrite:
+      js.fifoWriteAddresses.insert(hint.address);
+      break;
+    case JitInterface::ExceptionType::PairedQuantize:
+      js.pairedQuantizeAddresses.insert(hint.address);
+      break;
+    case JitInterface::ExceptionType::SpeculativeConstants:
+      js.noSpeculativeConstantsAddresses.insert(hint.address);
+      break;
+    case JitInterface::ExceptionType::HotBlock:
+      js.hotBlockAddresses.insert(hint.address);
+      break;
+    }
+  }
+}
+
+void JitBase::LogFastmemFallbacks() const
+{
+  if (m_fastmem_fallbacks.empty())
+    return;
+
+  std::vector<std::pair<u32, u32>> fallbacks(m_fastmem_fallbacks.begin(),
+                                             m_fastmem_fallbacks.end());
+  std::sort(fallbacks.begin(), fallbacks.end(),
+            [](const auto& a, const auto& b) { return a.second > b.second; });
+
+  NOTICE_LOG(DYNA_REC, "Fastmem fell back to slowmem at %zu instructions:", fallbacks.size());
+  for (size_t i = 0; i < std::min<size_t>(fallbacks.size(), 32); i++)
+  {
+    NOTICE_LOG(DYNA_REC, "  %08x %6u %s", fallbacks[i].first, fallbacks[i].second,
+               g_symbolDB.GetDescription(fallbacks[i].first).c_str());
+  }
+}
+
 void JitBase::UpdateMemoryOptions()
 {
+  // Constant addresses near a watchpoint are handled by IsOptimizable*, and fastmem faults on the
+  // pages overlapping one (see UpdateBATs), so the JIT only needs the checks after accesses.
   bool any_watchpoints = PowerPC::memchecks.HasAny();
   jo.fastmem = SConfig::GetInstance().bFastmem && (UReg_MSR(MSR).DR || !any_watchpoints);
   jo.memcheck = SConfig::GetInstance().bMMU || any_watchpoints;
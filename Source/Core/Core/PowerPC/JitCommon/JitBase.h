@@ -18,6 +18,7 @@
 #include "Core/PowerPC/CPUCoreBase.h"
 #include "Core/PowerPC/JitCommon/JitAsmCommon.h"
 #include "Core/PowerPC/JitCommon/JitCache.h"
+#include "Core/PowerPC/JitCommon/JitHintCache.h"
 #include "Core/PowerPC/PPCAnalyst.h"
 
 // Use these to control the instruction selection
@@ -74,7 +75,6 @@ protected:
     int revertGprLoad;
     int revertFprLoad;
 
-    bool assumeNoPairedQuantize;
     std::map<u8, u32> constantGqr;
     bool firstFPInstructionFound;
     bool isLastInstruction;
@@ -87,6 +87,9 @@ protected:
 
     bool mustCheckFifo;
     int fifoBytesSinceCheck;
+    // Bytes written to the gather pipe by the current run of stores, which aren't added to
+    // GPFifo::g_gather_pipe_ptr yet (Jit64 only).
+    int fifoBytesUnflushed;
 
     PPCAnalyst::BlockStats st;
     PPCAnalyst::BlockRegStats gpa;
@@ -99,6 +102,8 @@ protected:
     std::unordered_set<u32> fifoWriteAddresses;
     std::unordered_set<u32> pairedQuantizeAddresses;
     std::unordered_set<u32> noSpeculativeConstantsAddresses;
+    // Start addresses of the blocks which ran often enough to be compiled as hot blocks.
+    std::unordered_set<u32> hotBlockAddresses;
   };
 
   PPCAnalyst::CodeBlock code_block;
@@ -108,10 +113,14 @@ protected:
 
   void UpdateMemoryOptions();
 
+  // Adds the hints of the previous boots for the analyzed block to the exception addresses.
+  void ApplyHints(const PPCAnalyst::CodeBuffer* code_buf);
+
 public:
   // This should probably be removed from public:
   JitOptions jo;
   JitState js;
+  JitHintCache hint_cache;
 
   JitBase();
   ~JitBase() override;
@@ -125,6 +134,15 @@ public:
 
   virtual bool HandleFault(uintptr_t access_address, SContext* ctx) = 0;
   virtual bool HandleStackFault() { return false; }
+
+  // Called by the backpatchers when a fastmem access faulted and was patched to use slowmem.
+  void RecordFastmemFallback(u32 guest_pc) { m_fastmem_fallbacks[guest_pc]++; }
+  // Logs the guest instructions which fell back to slowmem most often.
+  void LogFastmemFallbacks() const;
+
+private:
+  // guest PC -> number of backpatched accesses, kept across cache clears
+  std::map<u32, u32> m_fastmem_fallbacks;
 };
 
 void JitTrampoline(u32 em_address);
@@ -19,11 +19,13 @@
 
 #include "Common/CommonTypes.h"
 #include "Common/JitRegister.h"
+#include "Common/Metrics.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/PowerPC/JitCommon/JitBase.h"
 #include "Core/PowerPC/PPCSymbolDB.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/PowerPC/Profiler.h"
 
 #ifdef _WIN32
 #include <windows.h>
@@ -31,6 +33,9 @@
 
 using namespace Gen;
 
+static Metrics::Counter s_blocks_compiled("dolphin_jit_blocks_compiled_total",
+                                          "Blocks compiled by the JIT.");
+
 bool JitBlock::OverlapsPhysicalRange(u32 address, u32 length) const
 {
   return physical_addresses.lower_bound(address) !=
@@ -62,6 +67,7 @@ void JitBaseBlockCache::Clear()
 #if defined(_DEBUG) || defined(DEBUGFAST)
   Core::DisplayMessage("Clearing code cache.", 3000);
 #endif
+  Profiler::ResolveSamples(*this);
   m_jit.js.fifoWriteAddresses.clear();
   m_jit.js.pairedQuantizeAddresses.clear();
   for (auto& e : block_map)
@@ -109,6 +115,8 @@ JitBlock* JitBaseBlockCache::AllocateBlock(u32 em_address)
 void JitBaseBlockCache::FinalizeBlock(JitBlock& block, bool block_link,
                                       const std::set<u32>& physical_addresses)
 {
+  s_blocks_compiled.Increment();
+
   size_t index = FastLookupIndexForAddress(block.effectiveAddress);
   fast_block_map[index] = &block;
   block.fast_block_map_index = index;
@@ -215,6 +223,7 @@ void JitBaseBlockCache::InvalidateICache(u32 address, u32 length, bool forced)
       {
         m_jit.js.fifoWriteAddresses.erase(i);
         m_jit.js.pairedQuantizeAddresses.erase(i);
+        m_jit.js.hotBlockAddresses.erase(i);
       }
     }
   }
@@ -269,6 +278,34 @@ void JitBaseBlockCache::ErasePhysicalRange(u32 address, u32 length)
   }
 }
 
+void JitBaseBlockCache::EraseHostCodeRange(const u8* begin, const u8* end)
+{
+  u32 range_mask = ~(BLOCK_RANGE_MAP_ELEMENTS - 1);
+  auto iter = block_map.begin();
+  while (iter != block_map.end())
+  {
+    JitBlock& block = iter->second;
+    if (block.checkedEntry >= end || block.checkedEntry + block.codeSize <= begin)
+    {
+      iter++;
+      continue;
+    }
+
+    // The valid_block bits are left set; they only make the next invalidation of this range
+    // take the slow path. Empty macro blocks are leaked the same way ErasePhysicalRange does.
+    for (u32 addr : block.physical_addresses)
+    {
+      auto range = block_range_map.find(addr & range_mask);
+      if (range != block_range_map.end())
+        range->second.erase(&block);
+    }
+
+    // Unlinks all blocks jumping into the victim, so nothing can reach the old code.
+    DestroyBlock(block);
+    iter = block_map.erase(iter);
+  }
+}
+
 u32* JitBaseBlockCache::GetBlockBitSet() const
 {
   return valid_block.m_valid_block.get();
@@ -74,6 +74,9 @@ struct JitBlock
     u64 ticStop;
   } profile_data = {};
 
+  // Runs left until the block is compiled again as a hot block (Jit64).
+  u32 hot_countdown = 0;
+
   // This tracks the position if this block within the fast block cache.
   // We allow each block to have only one map entry.
   size_t fast_block_map_index;
@@ -150,6 +153,10 @@ public:
   void InvalidateICache(u32 address, u32 length, bool forced);
   void ErasePhysicalRange(u32 address, u32 length);
 
+  // Destroys all blocks whose host code overlaps [begin, end), so that this part of the code
+  // space can be reused without clearing the whole cache.
+  void EraseHostCodeRange(const u8* begin, const u8* end);
+
   u32* GetBlockBitSet() const;
 
 protected:
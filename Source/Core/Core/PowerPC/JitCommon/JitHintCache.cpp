@@ -0,0 +1,114 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Core/PowerPC/JitCommon/JitHintCache.h"
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/Hash.h"
+#include "Common/LinearDiskCache.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/ConfigManager.h"
+#include "Core/PowerPC/JitInterface.h"
+#include "Core/PowerPC/PPCAnalyst.h"
+#include "Core/PowerPC/PowerPC.h"
+
+// Number of instructions from the address of a hint which must be unchanged for the hint to apply.
+// Hints are either at the start of a block or at a store, so this covers enough of the
+// surrounding code to tell a different function (or overlay) at the same address apart.
+static constexpr u32 HASHED_INSTRUCTIONS = 8;
+
+static u32 HashCode(u32 address)
+{
+  std::array<u32, HASHED_INSTRUCTIONS> code;
+  for (u32 i = 0; i < HASHED_INSTRUCTIONS; i++)
+  {
+    const u32 inst_address = address + i * 4;
+    code[i] =
+        PowerPC::HostIsRAMAddress(inst_address) ? PowerPC::HostRead_Instruction(inst_address) : 0;
+  }
+  return HashAdler32(reinterpret_cast<const u8*>(code.data()), sizeof(code));
+}
+
+class JitHintCache::Reader : public LinearDiskCacheReader<Key, u8>
+{
+public:
+  explicit Reader(std::unordered_multimap<u32, Key>& hints) : m_hints(hints) {}
+  void Read(const Key& key, const u8* value, u32 value_size) override
+  {
+    m_hints.emplace(key.address, key);
+  }
+
+private:
+  std::unordered_multimap<u32, Key>& m_hints;
+};
+
+bool JitHintCache::UpdateGame()
+{
+  const std::string& game_id = SConfig::GetInstance().GetGameID();
+  if (game_id == m_game_id)
+    return m_enabled;
+
+  m_game_id = game_id;
+  m_hints.clear();
+  m_disk_cache.Sync();
+  m_disk_cache.Close();
+
+  m_enabled = !game_id.empty() && Config::Get(Config::MAIN_JIT_HINT_CACHE);
+  if (!m_enabled)
+    return false;
+
+  const std::string cache_dir = File::GetUserPath(D_CACHE_IDX);
+  if (!File::Exists(cache_dir))
+    File::CreateDir(cache_dir);
+
+  Reader reader(m_hints);
+  m_disk_cache.OpenAndRead(cache_dir + "jit-hints-" + game_id + ".cache", reader);
+  return true;
+}
+
+std::vector<JitHintCache::Hint> JitHintCache::GetHints(const PPCAnalyst::CodeOp* ops, u32 count)
+{
+  std::vector<Hint> hints;
+  if (!UpdateGame() || m_hints.empty())
+    return hints;
+
+  for (u32 i = 0; i < count; i++)
+  {
+    const u32 address = ops[i].address;
+    auto range = m_hints.equal_range(address);
+    if (range.first == range.second)
+      continue;
+
+    const u32 code_hash = HashCode(address);
+    for (auto iter = range.first; iter != range.second; ++iter)
+    {
+      if (iter->second.code_hash == code_hash)
+        hints.push_back({static_cast<JitInterface::ExceptionType>(iter->second.type), address});
+    }
+  }
+
+  return hints;
+}
+
+void JitHintCache::AddHint(JitInterface::ExceptionType type, u32 address)
+{
+  if (!UpdateGame())
+    return;
+
+  const Key key{address, static_cast<u32>(type), HashCode(address)};
+  auto range = m_hints.equal_range(address);
+  for (auto iter = range.first; iter != range.second; ++iter)
+  {
+    if (iter->second.type == key.type && iter->second.code_hash == key.code_hash)
+      return;
+  }
+
+  m_hints.emplace(address, key);
+  m_disk_cache.Append(key, nullptr, 0);
+}
@@ -0,0 +1,60 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/LinearDiskCache.h"
+#include "Core/PowerPC/JitInterface.h"
+
+namespace PPCAnalyst
+{
+struct CodeOp;
+}
+
+// Remembers, per game, the addresses at which a guess of the JIT turned out wrong at runtime (see
+// JitInterface::CompileExceptionCheck). Every block containing one of them is compiled twice:
+// once with the guess, and again after it failed. With the hints of the previous boots, these
+// blocks are compiled right the first time.
+//
+// Compiled code itself can't be cached, as it embeds host addresses (far code, trampolines, the
+// asm routines) and the values of guest registers at compile time.
+class JitHintCache
+{
+public:
+  struct Hint
+  {
+    JitInterface::ExceptionType type;
+    u32 address;
+  };
+
+  // Returns the hints for the given instructions, if the code starting at their address is still
+  // the code they were recorded for.
+  std::vector<Hint> GetHints(const PPCAnalyst::CodeOp* ops, u32 count);
+
+  void AddHint(JitInterface::ExceptionType type, u32 address);
+
+private:
+  struct Key
+  {
+    u32 address;
+    u32 type;
+    u32 code_hash;
+  };
+
+  class Reader;
+
+  // Opens the hints of the running game, if it changed since the last call.
+  bool UpdateGame();
+
+  std::string m_game_id;
+  bool m_enabled = false;
+  LinearDiskCache<Key, u8> m_disk_cache;
+  // address -> hint
+  std::unordered_multimap<u32, Key> m_hints;
+};
@@ -234,6 +234,9 @@ void CompileExceptionCheck(ExceptionType type)
   case ExceptionType::SpeculativeConstants:
     exception_addresses = &g_jit->js.noSpeculativeConstantsAddresses;
     break;
+  case ExceptionType::HotBlock:
+    exception_addresses = &g_jit->js.hotBlockAddresses;
+    break;
   }
 
   if (PC != 0 && (exception_addresses->find(PC)) == (exception_addresses->end()))
@@ -246,6 +249,7 @@ void CompileExceptionCheck(ExceptionType type)
         return;
     }
     exception_addresses->insert(PC);
+    g_jit->hint_cache.AddHint(type, PC);
 
     // Invalidate the JIT block so that it gets recompiled with the external exception check
     // included.
@@ -257,6 +261,7 @@ void Shutdown()
 {
   if (g_jit)
   {
+    g_jit->LogFastmemFallbacks();
     g_jit->Shutdown();
     delete g_jit;
     g_jit = nullptr;
@@ -428,6 +428,26 @@ TryReadInstResult TryReadInstruction(u32 address)
   return TryReadInstResult{true, from_bat, hex, address};
 }
 
+TryReadInstResult HostTryReadInstruction(const u32 address)
+{
+  if (!HostIsInstructionRAMAddress(address))
+    return TryReadInstResult{false, false, 0, 0};
+
+  u32 physical_address = address;
+  bool from_bat = true;
+  if (UReg_MSR(MSR).IR)
+  {
+    auto tlb_addr = TranslateAddress<FLAG_OPCODE_NO_EXCEPTION>(address);
+    if (!tlb_addr.Success())
+      return TryReadInstResult{false, false, 0, 0};
+    physical_address = tlb_addr.address;
+    from_bat = tlb_addr.result == TranslateAddressResult::BAT_TRANSLATED;
+  }
+
+  const u32 hex = ReadFromHardware<FLAG_OPCODE_NO_EXCEPTION, u32, true>(physical_address);
+  return TryReadInstResult{true, from_bat, hex, physical_address};
+}
+
 u32 HostRead_Instruction(const u32 address)
 {
   UGeckoInstruction inst = HostRead_U32(address);
@@ -625,20 +645,28 @@ std::string HostGetString(u32 address, size_t size)
   return s;
 }
 
-bool IsOptimizableRAMAddress(const u32 address)
+// Whether a memcheck covers part of an access which the JIT would otherwise emit without checks.
+// The JIT cache is cleared whenever memchecks change (through DBATUpdated), so this only has to
+// hold for the memchecks which exist at compile time.
+static bool OverlapsMemcheck(u32 address, size_t size)
 {
-  if (PowerPC::memchecks.HasAny())
-    return false;
+  return PowerPC::memchecks.HasAny() && PowerPC::memchecks.GetMemCheck(address, size) != nullptr;
+}
 
+bool IsOptimizableRAMAddress(const u32 address)
+{
   if (!UReg_MSR(MSR).DR)
     return false;
 
   // TODO: This API needs to take an access size
   //
   // We store whether an access can be optimized to an unchecked access
-  // in dbat_table.
+  // in dbat_table. Pages overlapping a memcheck don't have BAT_PHYSICAL_BIT set, so watchpoints
+  // only slow down the accesses near them. Look at the page of the last byte of the largest
+  // access too, as it may be the next one.
   u32 bat_result = dbat_table[address >> BAT_INDEX_SHIFT];
-  return (bat_result & BAT_PHYSICAL_BIT) != 0;
+  u32 last_bat_result = dbat_table[(address + 7) >> BAT_INDEX_SHIFT];
+  return (bat_result & last_bat_result & BAT_PHYSICAL_BIT) != 0;
 }
 
 template <XCheckTLBFlag flag>
@@ -777,7 +805,7 @@ void ClearCacheLine(u32 address)
 
 u32 IsOptimizableMMIOAccess(u32 address, u32 accessSize)
 {
-  if (PowerPC::memchecks.HasAny())
+  if (OverlapsMemcheck(address, accessSize >> 3))
     return 0;
 
   if (!UReg_MSR(MSR).DR)
@@ -799,7 +827,7 @@ u32 IsOptimizableMMIOAccess(u32 address, u32 accessSize)
 
 bool IsOptimizableGatherPipeWrite(u32 address)
 {
-  if (PowerPC::memchecks.HasAny())
+  if (OverlapsMemcheck(address, sizeof(u64)))
     return false;
 
   if (!UReg_MSR(MSR).DR)
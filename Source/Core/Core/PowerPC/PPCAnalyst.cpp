@@ -5,14 +5,18 @@
 #include "Core/PowerPC/PPCAnalyst.h"
 
 #include <algorithm>
+#include <atomic>
+#include <functional>
 #include <map>
 #include <queue>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
+#include "Common/MathUtil.h"
 #include "Common/StringUtil.h"
 #include "Core/ConfigManager.h"
 #include "Core/PowerPC/PPCSymbolDB.h"
@@ -45,8 +49,18 @@ CONSTEXPR(int, CODEBUFFER_SIZE, 32000);
 // 0 does not perform block merging
 CONSTEXPR(u32, BRANCH_FOLLOWING_THRESHOLD, 2);
 
+// Calls of leaf functions up to this many instructions (without the blr) are inlined, and don't
+// count against BRANCH_FOLLOWING_THRESHOLD.
+CONSTEXPR(u32, LEAF_FUNCTION_MAX_SIZE, 8);
+CONSTEXPR(u32, MAX_INLINED_LEAF_FUNCTIONS, 4);
+
 CONSTEXPR(u32, INVALID_BRANCH_TARGET, 0xFFFFFFFF);
 
+// FindFunctions scans memory for branches in regions of this many bytes, on up to
+// MAX_SCAN_THREADS threads.
+CONSTEXPR(u32, SCAN_REGION_SIZE, 0x100000);
+CONSTEXPR(unsigned int, MAX_SCAN_THREADS, 8);
+
 CodeBuffer::CodeBuffer(int size)
 {
   codebuffer = new PPCAnalyst::CodeOp[size];
@@ -119,7 +133,8 @@ bool AnalyzeFunction(u32 startAddr, Symbol& func, int max_size)
         func.flags |= FFLAG_STRAIGHT;
       return true;
     }
-    const PowerPC::TryReadInstResult read_result = PowerPC::TryReadInstruction(addr);
+    // Doesn't touch the iCache, as functions are analyzed on several threads.
+    const PowerPC::TryReadInstResult read_result = PowerPC::HostTryReadInstruction(addr);
     const UGeckoInstruction instr = read_result.hex;
     if (read_result.valid && PPCTables::IsValidInstruction(instr))
     {
@@ -223,6 +238,44 @@ static void AnalyzeFunction2(Symbol* func)
   func->flags = flags;
 }
 
+static bool IsUnconditionalReturn(UGeckoInstruction inst)
+{
+  return inst.OPCD == 19 && inst.SUBOP10 == 16 && !inst.LK &&
+         (inst.BO & BO_DONT_DECREMENT_FLAG) && (inst.BO & BO_DONT_CHECK_CONDITION);
+}
+
+// Whether the function at the address is a short run of instructions ending in an unconditional
+// blr, without any other branch, any access to LR or a stack frame. The LR set by a call to it is
+// then still the return address at the blr, so the call and the return can be followed without
+// having to check LR at runtime.
+static bool IsSmallLeafFunction(u32 address)
+{
+  for (u32 i = 0; i <= LEAF_FUNCTION_MAX_SIZE; i++)
+  {
+    const auto result = PowerPC::TryReadInstruction(address + i * 4);
+    if (!result.valid)
+      return false;
+
+    const UGeckoInstruction inst = result.hex;
+    if (IsUnconditionalReturn(inst))
+      return true;
+
+    const GekkoOPInfo* opinfo = GetOpInfo(inst);
+    if (!opinfo || (opinfo->flags & FL_ENDBLOCK))
+      return false;
+
+    // mfspr/mtspr LR
+    const u32 spr = (inst.SPRU << 5) | (inst.SPRL & 0x1F);
+    if (inst.OPCD == 31 && (inst.SUBOP10 == 339 || inst.SUBOP10 == 467) && spr == SPR_LR)
+      return false;
+
+    // stwu r1, stwux r1
+    if (inst.RA == 1 && (inst.OPCD == 37 || (inst.OPCD == 31 && inst.SUBOP10 == 183)))
+      return false;
+  }
+  return false;
+}
+
 static bool CanSwapAdjacentOps(const CodeOp& a, const CodeOp& b)
 {
   const GekkoOPInfo* a_info = a.opinfo;
@@ -286,35 +339,73 @@ static bool CanSwapAdjacentOps(const CodeOp& a, const CodeOp& b)
 // called by another function. Therefore, let's scan the
 // entire space for bl operations and find what functions
 // get called.
-static void FindFunctionsFromBranches(u32 startAddr, u32 endAddr, SymbolDB* func_db)
+// Calls func for every index below count, spread across threads.
+static void ParallelFor(size_t count, const std::function<void(size_t)>& func)
 {
-  for (u32 addr = startAddr; addr < endAddr; addr += 4)
-  {
-    const PowerPC::TryReadInstResult read_result = PowerPC::TryReadInstruction(addr);
-    const UGeckoInstruction instr = read_result.hex;
+  std::atomic<size_t> next{0};
+  const auto run = [&] {
+    for (size_t i = next++; i < count; i = next++)
+      func(i);
+  };
+
+  const unsigned int thread_count = static_cast<unsigned int>(std::min<size_t>(
+      MathUtil::Clamp(std::thread::hardware_concurrency(), 1u, MAX_SCAN_THREADS), count));
+  std::vector<std::thread> threads;
+  for (unsigned int i = 1; i < thread_count; ++i)
+    threads.emplace_back(run);
+  run();
+  for (std::thread& thread : threads)
+    thread.join();
+}
 
-    if (read_result.valid && PPCTables::IsValidInstruction(instr))
+static void FindFunctionsFromBranches(u32 startAddr, u32 endAddr, PPCSymbolDB* func_db)
+{
+  // Scanning for branches and analyzing their targets only read memory, so both are done on
+  // several threads. The functions are added at the end, which gives the same database as adding
+  // each one when its first branch is found.
+  const size_t region_count =
+      static_cast<size_t>((u64{endAddr} - startAddr + SCAN_REGION_SIZE - 1) / SCAN_REGION_SIZE);
+  std::vector<std::vector<u32>> region_targets(region_count);
+  ParallelFor(region_count, [&](size_t region) {
+    const u32 region_start = startAddr + static_cast<u32>(region * SCAN_REGION_SIZE);
+    const u32 region_end = static_cast<u32>(
+        std::min<u64>(u64{region_start} + SCAN_REGION_SIZE, u64{endAddr}));
+    for (u32 addr = region_start; addr < region_end; addr += 4)
     {
-      switch (instr.OPCD)
-      {
-      case 18:  // branch instruction
+      const PowerPC::TryReadInstResult read_result = PowerPC::HostTryReadInstruction(addr);
+      const UGeckoInstruction instr = read_result.hex;
+
+      // bl
+      if (read_result.valid && PPCTables::IsValidInstruction(instr) && instr.OPCD == 18 &&
+          instr.LK)
       {
-        if (instr.LK)  // bl
-        {
-          u32 target = SignExt26(instr.LI << 2);
-          if (!instr.AA)
-            target += addr;
-          if (PowerPC::HostIsRAMAddress(target))
-          {
-            func_db->AddFunction(target);
-          }
-        }
-      }
-      break;
-      default:
-        break;
+        u32 target = SignExt26(instr.LI << 2);
+        if (!instr.AA)
+          target += addr;
+        if (PowerPC::HostIsRAMAddress(target))
+          region_targets[region].push_back(target);
       }
     }
+  });
+
+  std::vector<u32> targets;
+  for (const std::vector<u32>& region : region_targets)
+    targets.insert(targets.end(), region.begin(), region.end());
+  std::sort(targets.begin(), targets.end());
+  targets.erase(std::unique(targets.begin(), targets.end()), targets.end());
+  targets.erase(std::remove_if(targets.begin(), targets.end(),
+                               [func_db](u32 target) { return func_db->Symbols().count(target); }),
+                targets.end());
+
+  std::vector<Symbol> functions(targets.size());
+  std::vector<u8> analyzed(targets.size());
+  ParallelFor(targets.size(), [&](size_t i) {
+    analyzed[i] = AnalyzeFunction(targets[i], functions[i]);
+  });
+  for (size_t i = 0; i < targets.size(); ++i)
+  {
+    if (analyzed[i])
+      func_db->AddAnalyzedFunction(std::move(functions[i]));
   }
 }
 
@@ -688,6 +779,70 @@ void PPCAnalyzer::SetInstructionStats(CodeBlock* block, CodeOp* code, const Gekk
   }
 }
 
+// Games commonly spin on a flag in memory or a hardware register until an interrupt handler, the
+// GPU or a DMA changes it. If nothing in the loop has an effect other than recomputing the same
+// values from memory, running it again can't change anything until the next scheduled event, so
+// the JITs jump straight there instead. This generalizes the fixed lwz/cmpwi/beq pattern in the
+// JIT load instructions.
+void PPCAnalyzer::FindBusyWaitLoop(const CodeBlock* block, CodeOp* code, u32 instructions) const
+{
+  // Registers read before the loop has written them; writing them later carries a value over to
+  // the next iteration, making every iteration different.
+  BitSet32 loop_inputs;
+  BitSet32 written_regs;
+  u8 written_cr_fields = 0;
+
+  for (u32 i = 0; i < instructions; i++)
+  {
+    const CodeOp& op = code[i];
+    const UGeckoInstruction inst = op.inst;
+
+    if (op.opinfo->type == OPTYPE_BRANCH)
+    {
+      // Only plain b and bc, which must not touch LR or CTR.
+      if ((inst.OPCD != 16 && inst.OPCD != 18) || inst.LK)
+        return;
+      if (inst.OPCD == 16 && (inst.BO & BO_DONT_DECREMENT_FLAG) == 0)
+        return;
+
+      u32 destination;
+      if (inst.OPCD == 18)
+        destination = SignExt26(inst.LI << 2) + (inst.AA ? 0 : op.address);
+      else
+        destination = SignExt16(inst.BD << 2) + (inst.AA ? 0 : op.address);
+      if (destination != block->m_address)
+        return;
+
+      // The condition has to be computed inside the loop, too.
+      if (inst.OPCD == 16 && (inst.BO & BO_DONT_CHECK_CONDITION) == 0 &&
+          !(written_cr_fields & (1 << (inst.BI >> 2))))
+      {
+        return;
+      }
+
+      code[i].branchIsIdleLoop = true;
+      return;
+    }
+
+    if (op.opinfo->type != OPTYPE_INTEGER && op.opinfo->type != OPTYPE_LOAD)
+      return;
+    if (op.opinfo->flags & (FL_EVIL | FL_ENDBLOCK | FL_READ_CA))
+      return;
+
+    loop_inputs |= op.regsIn & ~written_regs;
+    if (op.regsOut & loop_inputs)
+      return;
+    written_regs |= op.regsOut;
+
+    if ((op.opinfo->flags & FL_SET_CRn) ||
+        ((op.opinfo->flags & FL_RC_BIT) && (inst.hex & 1)) || (op.opinfo->flags & FL_SET_CR0))
+    {
+      const u32 field = (op.opinfo->flags & FL_SET_CRn) ? inst.CRFD : 0;
+      written_cr_fields |= 1 << field;
+    }
+  }
+}
+
 u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, u32 blockSize)
 {
   // Clear block stats
@@ -715,7 +870,10 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, u32
   bool found_exit = false;
   bool found_call = false;
   size_t caller = 0;
+  // Whether the pending call is an inlined leaf function.
+  bool found_leaf_call = false;
   u32 numFollows = 0;
+  u32 num_inlined_leaves = 0;
   u32 num_inst = 0;
 
   for (u32 i = 0; i < blockSize; ++i)
@@ -745,15 +903,34 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, u32
     SetInstructionStats(block, &code[i], opinfo, i);
 
     bool follow = false;
+    bool follow_leaf = false;
     u32 destination = 0;
 
     bool conditional_continue = false;
 
+    if (HasOption(OPTION_BRANCH_FOLLOW) && inst.OPCD == 18 && inst.LK && blockSize > 1 &&
+        num_inlined_leaves < MAX_INLINED_LEAF_FUNCTIONS)
+    {
+      // bl to a small leaf function: inline it, along with its return.
+      const u32 target = SignExt26(inst.LI << 2) + (inst.AA ? 0 : address);
+      if (target != block->m_address && IsSmallLeafFunction(target))
+      {
+        follow = true;
+        follow_leaf = true;
+        destination = target;
+        found_call = true;
+        found_leaf_call = true;
+        caller = i;
+        num_inlined_leaves++;
+      }
+    }
+
     // TODO: Find the optimal value for BRANCH_FOLLOWING_THRESHOLD.
     //       If it is small, the performance will be down.
     //       If it is big, the size of generated code will be big and
     //       cache clearning will happen many times.
-    if (HasOption(OPTION_BRANCH_FOLLOW) && numFollows < BRANCH_FOLLOWING_THRESHOLD)
+    if (!follow && HasOption(OPTION_BRANCH_FOLLOW) &&
+        (numFollows < BRANCH_FOLLOWING_THRESHOLD || found_leaf_call))
     {
       if (inst.OPCD == 18 && blockSize > 1)
       {
@@ -765,6 +942,7 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, u32
         if (inst.LK)
         {
           found_call = true;
+          found_leaf_call = false;
           caller = i;
         }
       }
@@ -777,11 +955,11 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, u32
         if (inst.LK)
         {
           found_call = true;
+          found_leaf_call = false;
           caller = i;
         }
       }
-      else if (inst.OPCD == 19 && inst.SUBOP10 == 16 && !inst.LK && found_call &&
-               (inst.BO & BO_DONT_DECREMENT_FLAG) && (inst.BO & BO_DONT_CHECK_CONDITION))
+      else if (IsUnconditionalReturn(inst) && found_call)
       {
         // bclrx with unconditional branch = return
         // Follow it if we can propagate the LR value of the last CALL instruction.
@@ -790,8 +968,10 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, u32
         // the LR value on the stack as there are no spare registers. So we'd need
         // to check all store instruction to not alias with the stack.
         follow = true;
+        follow_leaf = found_leaf_call;
         destination = code[caller].address + 4;
         found_call = false;
+        found_leaf_call = false;
         code[i].skip = true;
 
         // Skip the RET, so also don't generate the stack entry for the BLR optimization.
@@ -806,6 +986,7 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, u32
           // We give up to follow the return address
           // because we have to check the register usage.
           found_call = false;
+          found_leaf_call = false;
         }
       }
     }
@@ -840,7 +1021,8 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, u32
     if (follow)
     {
       // Follow the unconditional branch.
-      numFollows++;
+      if (!follow_leaf)
+        numFollows++;
       address = destination;
     }
     else
@@ -857,6 +1039,7 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, u32
         // If we skip any conditional branch, we can't garantee to get the matching CALL/RET pair.
         // So we stop inling the RET here and let the BLR optitmization handle this case.
         found_call = false;
+        found_leaf_call = false;
       }
     }
   }
@@ -872,6 +1055,9 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, u32
     block->m_broken = true;
   }
 
+  if (SConfig::GetInstance().bSkipIdle)
+    FindBusyWaitLoop(block, code, num_inst);
+
   // Scan for flag dependencies; assume the next block (or any branch that can leave the block)
   // wants flags, to be safe.
   bool wantsCR0 = true, wantsCR1 = true, wantsFPRF = true, wantsCA = true;
@@ -43,6 +43,9 @@ struct CodeOp  // 16B
   bool outputCA;
   bool canEndBlock;
   bool skipLRStack;
+  // the branch jumps back to the start of a loop that only polls memory until something else
+  // (an interrupt, the GPU, DMA, ...) changes it, so it can skip ahead to the next event
+  bool branchIsIdleLoop;
   bool skip;  // followed BL-s for example
   // which registers are still needed after this instruction in this block
   BitSet32 fprInUse;
@@ -177,6 +180,7 @@ private:
   void ReorderInstructionsCore(u32 instructions, CodeOp* code, bool reverse, ReorderType type);
   void ReorderInstructions(u32 instructions, CodeOp* code);
   void SetInstructionStats(CodeBlock* block, CodeOp* code, const GekkoOPInfo* opinfo, u32 index);
+  void FindBusyWaitLoop(const CodeBlock* block, CodeOp* code, u32 instructions) const;
 
   // Options
   u32 m_options;
@@ -41,6 +41,15 @@ Symbol* PPCSymbolDB::AddFunction(u32 start_addr)
   if (!PPCAnalyst::AnalyzeFunction(start_addr, symbol))
     return nullptr;
 
+  return AddAnalyzedFunction(std::move(symbol));
+}
+
+Symbol* PPCSymbolDB::AddAnalyzedFunction(Symbol symbol)
+{
+  const u32 start_addr = symbol.address;
+  if (functions.find(start_addr) != functions.end())
+    return nullptr;
+
   functions[start_addr] = std::move(symbol);
   Symbol* ptr = &functions[start_addr];
   ptr->type = Symbol::Type::Function;
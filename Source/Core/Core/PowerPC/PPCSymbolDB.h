@@ -23,6 +23,8 @@ public:
   ~PPCSymbolDB();
 
   Symbol* AddFunction(u32 start_addr) override;
+  // Adds a function analyzed with PPCAnalyst::AnalyzeFunction, unless it's already there
+  Symbol* AddAnalyzedFunction(Symbol symbol);
   void AddKnownSymbol(u32 startAddr, u32 size, const std::string& name,
                       Symbol::Type type = Symbol::Type::Function);
 
@@ -21,6 +21,9 @@
 #include "Core/HW/SystemTimers.h"
 #include "Core/Host.h"
 #include "Core/PowerPC/CPUCoreBase.h"
+#ifdef USE_GDBSTUB
+#include "Core/PowerPC/GDBStub.h"
+#endif
 #include "Core/PowerPC/Interpreter/Interpreter.h"
 #include "Core/PowerPC/JitInterface.h"
 
@@ -548,6 +551,15 @@ void CheckExternalExceptions()
 
 void CheckBreakPoints()
 {
+#ifdef USE_GDBSTUB
+  // Breakpoints set by GDB are handled by it without stopping the CPU, unless it asks for a step.
+  if (gdb_active() && gdb_jit_breakpoint(PC))
+  {
+    CPU::Break();
+    return;
+  }
+#endif
+
   if (PowerPC::breakpoints.IsAddressBreakPoint(PC))
   {
     CPU::Break();
@@ -241,6 +241,9 @@ struct TryReadInstResult
   u32 physical_address;
 };
 TryReadInstResult TryReadInstruction(u32 address);
+// Reads RAM without going through the iCache or updating the TLB, so unlike TryReadInstruction it
+// can be called from other threads while the CPU is paused.
+TryReadInstResult HostTryReadInstruction(u32 address);
 
 u8 Read_U8(u32 address);
 u16 Read_U16(u32 address);
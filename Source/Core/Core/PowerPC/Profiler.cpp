@@ -4,9 +4,38 @@
 
 #include "Core/PowerPC/Profiler.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cinttypes>
+#include <chrono>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <signal.h>
+#include <ucontext.h>
+#endif
+
+#include "Common/CommonTypes.h"
+#include "Common/File.h"
+#include "Common/Flag.h"
+#include "Common/Logging/Log.h"
+#include "Common/Logging/Trace.h"
 #include "Common/PerformanceCounter.h"
+#include "Common/StringUtil.h"
+#include "Common/Thread.h"
+#include "Core/Core.h"
+#include "Core/PowerPC/JitCommon/JitBase.h"
+#include "Core/PowerPC/JitCommon/JitCache.h"
 #include "Core/PowerPC/JitInterface.h"
+#include "Core/PowerPC/PPCSymbolDB.h"
+#include "Core/PowerPC/PowerPC.h"
 
 namespace Profiler
 {
@@ -17,4 +46,251 @@ void WriteProfileResults(const std::string& filename)
   JitInterface::WriteProfileResults(filename);
 }
 
+namespace
+{
+struct RawSample
+{
+  u64 time;
+  uintptr_t host_pc;
+  u32 guest_pc;
+};
+
+struct Sample
+{
+  u64 time;
+  u32 guest_address;
+  bool in_block;
+};
+}  // Anonymous namespace
+
+static constexpr auto SAMPLE_INTERVAL = std::chrono::milliseconds(1);
+// About 17 minutes at one sample per millisecond.
+static constexpr u32 MAX_SAMPLES = 1 << 20;
+
+// Written by the sampled thread (or the sampler thread on Windows), read by ResolveSamples.
+static std::unique_ptr<RawSample[]> s_raw_samples;
+static std::atomic<u32> s_raw_sample_count{0};
+static u32 s_resolved_sample_count = 0;
+static std::vector<Sample> s_samples;
+
+static Common::Flag s_sampling;
+static std::thread s_sampler_thread;
+
+static std::mutex s_cpu_thread_lock;
+static bool s_cpu_thread_registered = false;
+#ifdef _WIN32
+static HANDLE s_cpu_thread;
+#elif defined(__linux__)
+static pthread_t s_cpu_thread;
+static struct sigaction s_old_sigprof_action;
+#endif
+
+static void RecordSample(uintptr_t host_pc)
+{
+  const u32 index = s_raw_sample_count.load(std::memory_order_relaxed);
+  if (index >= MAX_SAMPLES)
+    return;
+
+  s_raw_samples[index] = {Trace::GetTimestamp(), host_pc, PowerPC::ppcState.pc};
+  s_raw_sample_count.store(index + 1, std::memory_order_release);
+}
+
+#if defined(__linux__)
+static void SampleSignalHandler(int, siginfo_t*, void* raw_context)
+{
+  const ucontext_t* context = static_cast<const ucontext_t*>(raw_context);
+#if _M_X86_64
+  RecordSample(static_cast<uintptr_t>(context->uc_mcontext.gregs[REG_RIP]));
+#elif _M_ARM_64
+  RecordSample(static_cast<uintptr_t>(context->uc_mcontext.pc));
+#else
+  RecordSample(0);
+#endif
+}
+#endif
+
+void RegisterCPUThread()
+{
+  std::lock_guard<std::mutex> guard(s_cpu_thread_lock);
+#ifdef _WIN32
+  if (!DuplicateHandle(GetCurrentProcess(), GetCurrentThread(), GetCurrentProcess(),
+                       &s_cpu_thread, THREAD_SUSPEND_RESUME | THREAD_GET_CONTEXT, FALSE, 0))
+  {
+    return;
+  }
+#elif defined(__linux__)
+  s_cpu_thread = pthread_self();
+#endif
+  s_cpu_thread_registered = true;
+}
+
+void UnregisterCPUThread()
+{
+  std::lock_guard<std::mutex> guard(s_cpu_thread_lock);
+  if (!s_cpu_thread_registered)
+    return;
+
+#ifdef _WIN32
+  CloseHandle(s_cpu_thread);
+#endif
+  s_cpu_thread_registered = false;
+}
+
+static void SampleCPUThread()
+{
+  std::lock_guard<std::mutex> guard(s_cpu_thread_lock);
+  if (!s_cpu_thread_registered)
+    return;
+
+#ifdef _WIN32
+  if (SuspendThread(s_cpu_thread) == static_cast<DWORD>(-1))
+    return;
+
+  CONTEXT context{};
+  context.ContextFlags = CONTEXT_CONTROL;
+  if (GetThreadContext(s_cpu_thread, &context))
+    RecordSample(static_cast<uintptr_t>(context.Rip));
+  ResumeThread(s_cpu_thread);
+#elif defined(__linux__)
+  pthread_kill(s_cpu_thread, SIGPROF);
+#endif
+}
+
+static void SamplerThread()
+{
+  Common::SetCurrentThreadName("Sampling profiler");
+  while (s_sampling.IsSet())
+  {
+    SampleCPUThread();
+    std::this_thread::sleep_for(SAMPLE_INTERVAL);
+  }
+}
+
+bool IsSampling()
+{
+  return s_sampling.IsSet();
+}
+
+bool StartSampling()
+{
+#if defined(_WIN32) || defined(__linux__)
+  if (s_sampling.IsSet())
+    return false;
+
+  if (!s_raw_samples)
+    s_raw_samples = std::make_unique<RawSample[]>(MAX_SAMPLES);
+  // The CPU thread resolves samples when it clears its blocks.
+  Core::RunAsCPUThread([] {
+    s_raw_sample_count.store(0);
+    s_resolved_sample_count = 0;
+    s_samples.clear();
+  });
+
+#ifdef __linux__
+  struct sigaction action{};
+  action.sa_sigaction = &SampleSignalHandler;
+  action.sa_flags = SA_SIGINFO | SA_RESTART;
+  sigemptyset(&action.sa_mask);
+  if (sigaction(SIGPROF, &action, &s_old_sigprof_action) != 0)
+    return false;
+#endif
+
+  s_sampling.Set();
+  s_sampler_thread = std::thread(SamplerThread);
+  return true;
+#else
+  ERROR_LOG(POWERPC, "Sampling the CPU thread isn't supported on this platform");
+  return false;
+#endif
+}
+
+void ResolveSamples(JitBaseBlockCache& block_cache)
+{
+  const u32 count = s_raw_sample_count.load(std::memory_order_acquire);
+  if (count == s_resolved_sample_count)
+    return;
+
+  struct BlockRange
+  {
+    uintptr_t start;
+    uintptr_t end;
+    u32 address;
+  };
+  std::vector<BlockRange> ranges;
+  block_cache.RunOnBlocks([&ranges](const JitBlock& block) {
+    const uintptr_t start = reinterpret_cast<uintptr_t>(block.checkedEntry);
+    ranges.push_back({start, start + block.codeSize, block.effectiveAddress});
+  });
+  std::sort(ranges.begin(), ranges.end(),
+            [](const BlockRange& a, const BlockRange& b) { return a.start < b.start; });
+
+  for (u32 i = s_resolved_sample_count; i < count; i++)
+  {
+    const RawSample& raw = s_raw_samples[i];
+    auto iter = std::upper_bound(
+        ranges.begin(), ranges.end(), raw.host_pc,
+        [](uintptr_t host_pc, const BlockRange& range) { return host_pc < range.start; });
+    if (iter != ranges.begin() && raw.host_pc < (--iter)->end)
+      s_samples.push_back({raw.time, iter->address, true});
+    else
+      s_samples.push_back({raw.time, raw.guest_pc, false});
+  }
+  s_resolved_sample_count = count;
+}
+
+static std::string GetSymbolName(u32 address)
+{
+  const Symbol* symbol = g_symbolDB.GetSymbolFromAddr(address);
+  if (!symbol)
+    return StringFromFormat("fn_%08x", address);
+  return StringFromFormat("%s+0x%x", symbol->name.c_str(), address - symbol->address);
+}
+
+bool StopSampling(const std::string& filename)
+{
+  if (!s_sampling.TestAndClear())
+    return false;
+
+  s_sampler_thread.join();
+#ifdef __linux__
+  sigaction(SIGPROF, &s_old_sigprof_action, nullptr);
+#endif
+
+  Core::RunAsCPUThread([] {
+    if (g_jit)
+      ResolveSamples(*g_jit->GetBlockCache());
+
+    // Without a JIT, everything is attributed to the guest PC.
+    const u32 count = s_raw_sample_count.load();
+    for (u32 i = s_resolved_sample_count; i < count; i++)
+    {
+      const RawSample& raw = s_raw_samples[i];
+      s_samples.push_back({raw.time, raw.guest_pc, false});
+    }
+    s_resolved_sample_count = count;
+  });
+
+  File::IOFile f(filename, "w");
+  if (!f)
+    return false;
+
+  const u64 period =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(SAMPLE_INTERVAL).count();
+  for (const Sample& sample : s_samples)
+  {
+    std::string text = StringFromFormat("dolphin-cpu 0 %" PRIu64 ".%09" PRIu64 ": %" PRIu64
+                                        " cpu-clock:\n",
+                                        sample.time / 1000000000, sample.time % 1000000000, period);
+    if (!sample.in_block)
+      text += "\t0 [host code] (dolphin)\n";
+    text += StringFromFormat("\t%x %s (guest)\n\n", sample.guest_address,
+                             GetSymbolName(sample.guest_address).c_str());
+    f.WriteBytes(text.data(), text.size());
+  }
+
+  NOTICE_LOG(POWERPC, "Wrote %zu samples of the CPU thread to %s", s_samples.size(),
+             filename.c_str());
+  s_samples.clear();
+  return f.IsGood();
+}
 }  // namespace
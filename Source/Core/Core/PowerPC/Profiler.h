@@ -10,6 +10,8 @@
 
 #include "Common/CommonTypes.h"
 
+class JitBaseBlockCache;
+
 struct BlockStat
 {
   BlockStat(u32 _addr, u64 c, u64 ticks, u64 run, u32 size)
@@ -37,4 +39,19 @@ namespace Profiler
 extern bool g_ProfileBlocks;
 
 void WriteProfileResults(const std::string& filename);
+
+// Sampling of the host code run by the CPU thread. Each sample is attributed to the JIT block
+// containing the host address, or to the guest PC if it is outside of any block (dispatcher,
+// interpreter, hardware emulation), and written in the text format of "perf script", for
+// flame graphs or any other tool reading it.
+void RegisterCPUThread();
+void UnregisterCPUThread();
+
+bool IsSampling();
+bool StartSampling();
+bool StopSampling(const std::string& filename);
+
+// Attributes the samples taken so far, while their blocks still exist. Called on the CPU thread
+// (or while it is paused) before the blocks are cleared.
+void ResolveSamples(JitBaseBlockCache& block_cache);
 }
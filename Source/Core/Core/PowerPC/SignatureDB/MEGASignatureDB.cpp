@@ -4,16 +4,21 @@
 
 #include "Core/PowerPC/SignatureDB/MEGASignatureDB.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <cstdlib>
 #include <fstream>
 #include <limits>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <utility>
+#include <vector>
 
 #include "Common/FileUtil.h"
 #include "Common/Logging/Log.h"
+#include "Common/MathUtil.h"
 #include "Common/StringUtil.h"
 
 #include "Core/PowerPC/PPCSymbolDB.h"
@@ -23,6 +28,15 @@ namespace
 {
 constexpr size_t INSTRUCTION_HEXSTRING_LENGTH = 8;
 
+// Symbols are matched in batches of this many, spread across up to MAX_APPLY_THREADS threads.
+constexpr size_t APPLY_BATCH_SIZE = 256;
+constexpr unsigned int MAX_APPLY_THREADS = 8;
+
+u64 GetIndexKey(u32 size, u32 first_instruction)
+{
+  return (static_cast<u64>(size) << 32) | first_instruction;
+}
+
 bool GetCode(MEGASignature* sig, std::istringstream* iss)
 {
   std::string code;
@@ -123,6 +137,7 @@ MEGASignatureDB::~MEGASignatureDB() = default;
 void MEGASignatureDB::Clear()
 {
   m_signatures.clear();
+  m_index.clear();
 }
 
 bool MEGASignatureDB::Load(const std::string& file_path)
@@ -139,8 +154,10 @@ bool MEGASignatureDB::Load(const std::string& file_path)
     std::istringstream iss(line);
     MEGASignature sig;
 
-    if (GetCode(&sig, &iss) && GetName(&sig, &iss) && GetRefs(&sig, &iss))
+    if (GetCode(&sig, &iss) && GetName(&sig, &iss) && GetRefs(&sig, &iss) && !sig.code.empty())
     {
+      const u32 size = static_cast<u32>(sig.code.size() * sizeof(u32));
+      m_index[GetIndexKey(size, sig.code[0])].push_back(m_signatures.size());
       m_signatures.push_back(std::move(sig));
     }
     else
@@ -157,21 +174,87 @@ bool MEGASignatureDB::Save(const std::string& file_path) const
   return false;
 }
 
+size_t MEGASignatureDB::FindSignature(u32 address, u32 size) const
+{
+  static const std::vector<size_t> s_no_signatures;
+  const auto get_candidates = [this, size](u32 first_instruction) -> const std::vector<size_t>& {
+    const auto iter = m_index.find(GetIndexKey(size, first_instruction));
+    return iter != m_index.end() ? iter->second : s_no_signatures;
+  };
+
+  if (size == 0 || size % sizeof(u32) != 0)
+    return m_signatures.size();
+
+  // Both lists are in file order, so merging them keeps the first matching signature the same as
+  // when comparing all of them.
+  const u32 first_instruction = PowerPC::HostRead_U32(address);
+  const std::vector<size_t>& exact = get_candidates(first_instruction);
+  const std::vector<size_t>& wildcard =
+      first_instruction != 0 ? get_candidates(0) : s_no_signatures;
+  auto exact_iter = exact.begin();
+  auto wildcard_iter = wildcard.begin();
+  while (exact_iter != exact.end() || wildcard_iter != wildcard.end())
+  {
+    size_t index;
+    if (wildcard_iter == wildcard.end() ||
+        (exact_iter != exact.end() && *exact_iter < *wildcard_iter))
+    {
+      index = *exact_iter++;
+    }
+    else
+    {
+      index = *wildcard_iter++;
+    }
+
+    if (Compare(address, size, m_signatures[index]))
+      return index;
+  }
+  return m_signatures.size();
+}
+
 void MEGASignatureDB::Apply(PPCSymbolDB* symbol_db) const
 {
+  std::vector<Symbol*> symbols;
   for (auto& it : symbol_db->AccessSymbols())
-  {
-    auto& symbol = it.second;
-    for (const auto& sig : m_signatures)
+    symbols.push_back(&it.second);
+
+  // Only reading emulated memory, which doesn't change as the CPU isn't running meanwhile.
+  std::vector<size_t> matches(symbols.size(), m_signatures.size());
+  std::atomic<size_t> next_batch{0};
+  const auto find_signatures = [&] {
+    while (true)
     {
-      if (Compare(symbol.address, symbol.size, sig))
-      {
-        symbol.name = sig.name;
-        INFO_LOG(OSHLE, "Found %s at %08x (size: %08x)!", sig.name.c_str(), symbol.address,
-                 symbol.size);
+      const size_t start = next_batch++ * APPLY_BATCH_SIZE;
+      if (start >= symbols.size())
         break;
-      }
+
+      const size_t end = std::min(start + APPLY_BATCH_SIZE, symbols.size());
+      for (size_t i = start; i < end; ++i)
+        matches[i] = FindSignature(symbols[i]->address, symbols[i]->size);
     }
+  };
+
+  const size_t batch_count = (symbols.size() + APPLY_BATCH_SIZE - 1) / APPLY_BATCH_SIZE;
+  const unsigned int thread_count = static_cast<unsigned int>(std::min<size_t>(
+      MathUtil::Clamp(std::thread::hardware_concurrency(), 1u, MAX_APPLY_THREADS), batch_count));
+  std::vector<std::thread> threads;
+  for (unsigned int i = 1; i < thread_count; ++i)
+    threads.emplace_back(find_signatures);
+  find_signatures();
+  for (std::thread& thread : threads)
+    thread.join();
+
+  // Renaming and logging are done in order, as before.
+  for (size_t i = 0; i < symbols.size(); ++i)
+  {
+    if (matches[i] == m_signatures.size())
+      continue;
+
+    Symbol& symbol = *symbols[i];
+    const MEGASignature& sig = m_signatures[matches[i]];
+    symbol.name = sig.name;
+    INFO_LOG(OSHLE, "Found %s at %08x (size: %08x)!", sig.name.c_str(), symbol.address,
+             symbol.size);
   }
   symbol_db->Index();
 }
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -53,5 +54,11 @@ public:
   bool Add(u32 startAddr, u32 size, const std::string& name) override;
 
 private:
+  // Returns the index of the first signature matching the function, or m_signatures.size().
+  size_t FindSignature(u32 address, u32 size) const;
+
   std::vector<MEGASignature> m_signatures;
+  // Indices of the signatures by size and first instruction, in order, so that a function is only
+  // compared with the few signatures it could match. Signatures starting with a wildcard use 0.
+  std::unordered_map<u64, std::vector<size_t>> m_index;
 };
@@ -4,6 +4,10 @@
 
 #include "Core/State.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <deque>
 #include <lzo/lzo1x.h>
 #include <map>
 #include <mutex>
@@ -14,6 +18,7 @@
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
 #include "Common/Event.h"
 #include "Common/File.h"
 #include "Common/FileUtil.h"
@@ -25,11 +30,13 @@
 #include "Common/Version.h"
 
 #include "Core/ARBruteForcer.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
 #include "Core/GeckoCode.h"
 #include "Core/HW/HW.h"
+#include "Core/HW/SystemTimers.h"
 #include "Core/HW/Wiimote.h"
 #include "Core/Host.h"
 #include "Core/Movie.h"
@@ -54,12 +61,9 @@ static const u32 IN_LEN = 128 * 1024u;
 
 static const u32 OUT_LEN = IN_LEN + (IN_LEN / 16) + 64 + 3;
 
-static unsigned char __LZO_MMODEL out[OUT_LEN];
-
-#define HEAP_ALLOC(var, size)                                                                      \
-  lzo_align_t __LZO_MMODEL var[((size) + (sizeof(lzo_align_t) - 1)) / sizeof(lzo_align_t)]
-
-static HEAP_ALLOC(wrkmem, LZO1X_1_MEM_COMPRESS);
+// Every IN_LEN chunk of a state is compressed on its own, so batches of chunks are (de)compressed
+// on all cores while the file is written or read in order.
+static const u32 CHUNKS_PER_THREAD = 4;
 
 static std::string g_last_filename;
 
@@ -80,8 +84,27 @@ static Common::Event g_compressAndDumpStateSyncEvent;
 
 static std::thread g_save_thread;
 
+// Rewind history. Only the most recent state is kept whole; every older one is stored as a delta
+// that turns the state after it back into it, so that the oldest one can be dropped at any time.
+struct RewindDelta
+{
+  u64 size;
+  // A list of (u32 page index, u32 encoded size, encoded XOR of the page) records.
+  std::vector<u8> pages;
+};
+static std::vector<u8> s_rewind_latest;
+// The buffer of the state before the latest, reused to write the next one without allocating.
+static std::vector<u8> s_rewind_spare;
+static std::deque<RewindDelta> s_rewind_deltas;
+static size_t s_rewind_deltas_size = 0;
+static std::mutex s_rewind_mutex;
+static std::atomic<bool> s_rewind_capture_pending{false};
+static std::atomic<u64> s_rewind_last_capture_ticks{0};
+// Incremented whenever the history is rewound or cleared, to drop captures queued before that.
+static std::atomic<u32> s_rewind_generation{0};
+
 // Don't forget to increase this after doing changes on the savestate system
-static const u32 STATE_VERSION = 92;  // Last changed in PR 6173
+static const u32 STATE_VERSION = 93;  // Last changed for the XF dirty slot masks
 
 // Maps savestate versions to Dolphin versions.
 // Versions after 42 don't need to be added to this list,
@@ -225,16 +248,9 @@ void LoadFromBuffer(std::vector<u8>& buffer)
 void SaveToBuffer(std::vector<u8>& buffer)
 {
   Core::RunAsCPUThread([&] {
-    u8* ptr = nullptr;
-    PointerWrap p(&ptr, PointerWrap::MODE_MEASURE);
-
-    DoState(p);
-    const size_t buffer_size = reinterpret_cast<size_t>(ptr);
-    buffer.resize(buffer_size);
-
-    ptr = &buffer[0];
-    p.SetMode(PointerWrap::MODE_WRITE);
+    PointerWrap p(&buffer);
     DoState(p);
+    p.FinishWrite();
   });
 }
 
@@ -247,6 +263,238 @@ void VerifyBuffer(std::vector<u8>& buffer)
   });
 }
 
+// The bulk of a state is MEM1/MEM2 and other memories, most of which stay the same over a few
+// seconds, so states are compared page by page, and changed pages are stored as the run length
+// encoded XOR of the two versions.
+constexpr size_t REWIND_PAGE_SIZE = 0x1000;
+
+template <typename T>
+static void AppendValue(std::vector<u8>* out, T value)
+{
+  const size_t pos = out->size();
+  out->resize(pos + sizeof(T));
+  std::memcpy(out->data() + pos, &value, sizeof(T));
+}
+
+template <typename T>
+static T ReadValue(const u8** ptr)
+{
+  T value;
+  std::memcpy(&value, *ptr, sizeof(T));
+  *ptr += sizeof(T);
+  return value;
+}
+
+// Encodes data as (u16 zero run, u16 literal count, literals) groups.
+static void EncodeXORPage(const u8* data, size_t size, std::vector<u8>* out)
+{
+  size_t i = 0;
+  while (i < size)
+  {
+    const size_t zeros_start = i;
+    while (i < size && data[i] == 0)
+      i++;
+    const size_t literals_start = i;
+    while (i < size)
+    {
+      if (data[i] != 0)
+      {
+        i++;
+        continue;
+      }
+
+      // Short zero runs aren't worth starting a new group for.
+      size_t zeros_end = i;
+      while (zeros_end < size && data[zeros_end] == 0)
+        zeros_end++;
+      if (zeros_end == size || zeros_end - i >= 4)
+        break;
+      i = zeros_end;
+    }
+
+    AppendValue<u16>(out, static_cast<u16>(literals_start - zeros_start));
+    AppendValue<u16>(out, static_cast<u16>(i - literals_start));
+    out->insert(out->end(), data + literals_start, data + i);
+  }
+}
+
+static void ApplyXORPage(const u8* encoded, const u8* encoded_end, u8* data)
+{
+  while (encoded < encoded_end)
+  {
+    data += ReadValue<u16>(&encoded);
+    const u16 literals = ReadValue<u16>(&encoded);
+    for (u16 i = 0; i < literals; i++)
+      *data++ ^= *encoded++;
+  }
+}
+
+// Creates the delta that turns newer into older.
+static RewindDelta CreateRewindDelta(const std::vector<u8>& older, const std::vector<u8>& newer)
+{
+  RewindDelta delta;
+  delta.size = older.size();
+
+  std::vector<u8> xor_page(REWIND_PAGE_SIZE);
+  for (size_t offset = 0; offset < older.size(); offset += REWIND_PAGE_SIZE)
+  {
+    const size_t page_size = std::min(REWIND_PAGE_SIZE, older.size() - offset);
+    // Where newer is shorter, it is treated as if it was padded with zeroes.
+    const size_t newer_size =
+        offset < newer.size() ? std::min(page_size, newer.size() - offset) : 0;
+    if (newer_size == page_size && !std::memcmp(&older[offset], &newer[offset], page_size))
+      continue;
+
+    for (size_t i = 0; i < page_size; i++)
+      xor_page[i] = older[offset + i] ^ (i < newer_size ? newer[offset + i] : 0);
+
+    AppendValue<u32>(&delta.pages, static_cast<u32>(offset / REWIND_PAGE_SIZE));
+    const size_t size_pos = delta.pages.size();
+    AppendValue<u32>(&delta.pages, 0);
+    EncodeXORPage(xor_page.data(), page_size, &delta.pages);
+    const u32 encoded_size = static_cast<u32>(delta.pages.size() - size_pos - sizeof(u32));
+    std::memcpy(&delta.pages[size_pos], &encoded_size, sizeof(u32));
+  }
+
+  delta.pages.shrink_to_fit();
+  return delta;
+}
+
+static void ApplyRewindDelta(const RewindDelta& delta, std::vector<u8>* state)
+{
+  state->resize(delta.size, 0);
+
+  const u8* ptr = delta.pages.data();
+  const u8* const end = ptr + delta.pages.size();
+  while (ptr < end)
+  {
+    const u32 page = ReadValue<u32>(&ptr);
+    const u32 encoded_size = ReadValue<u32>(&ptr);
+    ApplyXORPage(ptr, ptr + encoded_size, state->data() + page * REWIND_PAGE_SIZE);
+    ptr += encoded_size;
+  }
+}
+
+// Runs on the host thread.
+static void CaptureRewindState(u32 generation)
+{
+  std::lock_guard<std::mutex> lk(s_rewind_mutex);
+  s_rewind_capture_pending.store(false);
+  if (generation != s_rewind_generation.load())
+    return;
+
+  std::vector<u8> state = std::move(s_rewind_spare);
+  SaveToBuffer(state);
+  if (state.empty())
+    return;
+
+  if (!s_rewind_latest.empty())
+  {
+    s_rewind_deltas.push_back(CreateRewindDelta(s_rewind_latest, state));
+    s_rewind_deltas_size += s_rewind_deltas.back().pages.size();
+  }
+  s_rewind_spare = std::move(s_rewind_latest);
+  s_rewind_latest = std::move(state);
+
+  const size_t budget = static_cast<size_t>(Config::Get(Config::MAIN_REWIND_BUFFER_SIZE)) << 20;
+  while (!s_rewind_deltas.empty() && s_rewind_latest.size() + s_rewind_deltas_size > budget)
+  {
+    s_rewind_deltas_size -= s_rewind_deltas.front().pages.size();
+    s_rewind_deltas.pop_front();
+  }
+}
+
+void RewindFrameUpdate()
+{
+  if (!Config::Get(Config::MAIN_REWIND_ENABLE) || NetPlay::IsNetPlayRunning() ||
+      Movie::IsMovieActive())
+  {
+    return;
+  }
+
+  const u64 ticks = CoreTiming::GetTicks();
+  const u64 last_capture_ticks = s_rewind_last_capture_ticks.load();
+  const u64 interval = static_cast<u64>(SystemTimers::GetTicksPerSecond()) *
+                       std::max(Config::Get(Config::MAIN_REWIND_INTERVAL), 1) / 1000;
+  // The timer can go backwards when a state is loaded.
+  if (ticks >= last_capture_ticks && ticks - last_capture_ticks < interval)
+    return;
+
+  if (s_rewind_capture_pending.exchange(true))
+    return;
+
+  s_rewind_last_capture_ticks.store(ticks);
+  // States can only be taken between CPU slices, so this has to be done from outside.
+  const u32 generation = s_rewind_generation.load();
+  Core::QueueHostJob([generation] { CaptureRewindState(generation); });
+}
+
+void Rewind()
+{
+  if (Movie::IsMovieActive())
+  {
+    Core::DisplayMessage("Rewinding is disabled during movie playback and recording", 2000);
+    return;
+  }
+
+  std::lock_guard<std::mutex> lk(s_rewind_mutex);
+  if (s_rewind_latest.empty())
+  {
+    Core::DisplayMessage("There is nothing to rewind to", 2000);
+    return;
+  }
+
+  LoadFromBuffer(s_rewind_latest);
+  s_rewind_generation++;
+  Core::RunAsCPUThread([] { s_rewind_last_capture_ticks.store(CoreTiming::GetTicks()); });
+
+  // Go one step back, so that the next rewind continues from there. The oldest state is kept.
+  if (!s_rewind_deltas.empty())
+  {
+    ApplyRewindDelta(s_rewind_deltas.back(), &s_rewind_latest);
+    s_rewind_deltas_size -= s_rewind_deltas.back().pages.size();
+    s_rewind_deltas.pop_back();
+  }
+
+  Core::DisplayMessage(
+      StringFromFormat("Rewound, %zu more steps available", s_rewind_deltas.size() + 1), 1000);
+}
+
+void ClearRewindHistory()
+{
+  std::lock_guard<std::mutex> lk(s_rewind_mutex);
+  std::vector<u8>().swap(s_rewind_latest);
+  std::vector<u8>().swap(s_rewind_spare);
+  s_rewind_deltas.clear();
+  s_rewind_deltas_size = 0;
+  s_rewind_last_capture_ticks.store(0);
+  s_rewind_generation++;
+}
+
+static u32 GetCompressionThreadCount()
+{
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+// Calls func(index, thread) for every index in [0, count), spread over num_threads threads.
+template <typename Func>
+static void ParallelFor(size_t count, u32 num_threads, Func func)
+{
+  num_threads = static_cast<u32>(std::min<size_t>(num_threads, count));
+  std::vector<std::thread> threads;
+  for (u32 thread = 1; thread < num_threads; thread++)
+  {
+    threads.emplace_back([&, thread] {
+      for (size_t i = thread; i < count; i += num_threads)
+        func(i, thread);
+    });
+  }
+  for (size_t i = 0; i < count; i += num_threads)
+    func(i, 0);
+  for (std::thread& thread : threads)
+    thread.join();
+}
+
 // return state number not in map
 static int GetEmptySlot(std::map<double, int> m)
 {
@@ -362,32 +610,37 @@ static void CompressAndDumpState(CompressAndDumpState_args save_args)
 
   if (header.size != 0)  // non-zero header size means the state is compressed
   {
-    lzo_uint i = 0;
-    while (true)
+    const u32 num_threads = GetCompressionThreadCount();
+    const size_t batch_size = num_threads * CHUNKS_PER_THREAD;
+    std::vector<std::vector<lzo_align_t>> work_memory(
+        num_threads, std::vector<lzo_align_t>((LZO1X_1_MEM_COMPRESS + sizeof(lzo_align_t) - 1) /
+                                              sizeof(lzo_align_t)));
+    std::vector<std::vector<u8>> out_buffers(batch_size, std::vector<u8>(OUT_LEN));
+    std::vector<lzo_uint> out_lengths(batch_size);
+
+    // A chunk shorter than IN_LEN marks the end, so a final empty chunk is written if the size is
+    // a multiple of IN_LEN.
+    const size_t num_chunks = buffer_size / IN_LEN + 1;
+    for (size_t batch_start = 0; batch_start < num_chunks; batch_start += batch_size)
     {
-      lzo_uint32 cur_len = 0;
-      lzo_uint out_len = 0;
+      const size_t batch_count = std::min(batch_size, num_chunks - batch_start);
+      ParallelFor(batch_count, num_threads, [&](size_t i, u32 thread) {
+        const size_t offset = (batch_start + i) * IN_LEN;
+        const lzo_uint cur_len = std::min<size_t>(IN_LEN, buffer_size - offset);
+        if (lzo1x_1_compress(buffer_data + offset, cur_len, out_buffers[i].data(), &out_lengths[i],
+                             work_memory[thread].data()) != LZO_E_OK)
+        {
+          PanicAlertT("Internal LZO Error - compression failed");
+        }
+      });
 
-      if ((i + IN_LEN) >= buffer_size)
+      for (size_t i = 0; i < batch_count; i++)
       {
-        cur_len = (lzo_uint32)(buffer_size - i);
+        // The size of the data to write is 'out_len'
+        const lzo_uint32 out_len = static_cast<lzo_uint32>(out_lengths[i]);
+        f.WriteArray(&out_len, 1);
+        f.WriteBytes(out_buffers[i].data(), out_len);
       }
-      else
-      {
-        cur_len = IN_LEN;
-      }
-
-      if (lzo1x_1_compress(buffer_data + i, cur_len, out, &out_len, wrkmem) != LZO_E_OK)
-        PanicAlertT("Internal LZO Error - compression failed");
-
-      // The size of the data to write is 'out_len'
-      f.WriteArray((lzo_uint32*)&out_len, 1);
-      f.WriteBytes(out, out_len);
-
-      if (cur_len != IN_LEN)
-        break;
-
-      i += cur_len;
     }
   }
   else  // uncompressed
@@ -402,22 +655,15 @@ static void CompressAndDumpState(CompressAndDumpState_args save_args)
 void SaveAs(const std::string& filename, bool wait)
 {
   Core::RunAsCPUThread([&] {
-    // Measure the size of the buffer.
-    u8* ptr = nullptr;
-    PointerWrap p(&ptr, PointerWrap::MODE_MEASURE);
-    DoState(p);
-    const size_t buffer_size = reinterpret_cast<size_t>(ptr);
-
-    // Then actually do the write.
+    bool written;
     {
       std::lock_guard<std::mutex> lk(g_cs_current_buffer);
-      g_current_buffer.resize(buffer_size);
-      ptr = &g_current_buffer[0];
-      p.SetMode(PointerWrap::MODE_WRITE);
+      PointerWrap p(&g_current_buffer);
       DoState(p);
+      written = p.FinishWrite();
     }
 
-    if (p.GetMode() == PointerWrap::MODE_WRITE)
+    if (written)
     {
       Core::DisplayMessage("Saving State...", 1000);
 
@@ -497,27 +743,50 @@ static void LoadFileStateData(const std::string& filename, std::vector<u8>& ret_
 
     buffer.resize(header.size);
 
-    lzo_uint i = 0;
-    while (true)
+    const u32 num_threads = GetCompressionThreadCount();
+    const size_t batch_size = num_threads * CHUNKS_PER_THREAD;
+    std::vector<std::vector<u8>> in_buffers(batch_size, std::vector<u8>(OUT_LEN));
+    std::vector<int> results(batch_size);
+
+    // Every chunk but the last one decompresses to exactly IN_LEN bytes.
+    const size_t num_chunks = header.size / IN_LEN + 1;
+    bool end_of_file = false;
+    for (size_t batch_start = 0; batch_start < num_chunks && !end_of_file;
+         batch_start += batch_size)
     {
-      lzo_uint32 cur_len = 0;  // number of bytes to read
-      lzo_uint new_len = 0;    // number of bytes to write
+      size_t batch_count = 0;
+      while (batch_count < std::min(batch_size, num_chunks - batch_start))
+      {
+        lzo_uint32 cur_len = 0;  // number of bytes to read
+        if (!f.ReadArray(&cur_len, 1) || cur_len > OUT_LEN)
+        {
+          end_of_file = true;
+          break;
+        }
+        in_buffers[batch_count].resize(cur_len);
+        f.ReadBytes(in_buffers[batch_count].data(), cur_len);
+        batch_count++;
+      }
 
-      if (!f.ReadArray(&cur_len, 1))
-        break;
+      ParallelFor(batch_count, num_threads, [&](size_t i, u32) {
+        const size_t offset = (batch_start + i) * IN_LEN;
+        lzo_uint new_len = std::min<size_t>(IN_LEN, header.size - offset);
+        results[i] = lzo1x_decompress_safe(in_buffers[i].data(), in_buffers[i].size(),
+                                           buffer.data() + offset, &new_len, nullptr);
+      });
 
-      f.ReadBytes(out, cur_len);
-      const int res = lzo1x_decompress(out, cur_len, &buffer[i], &new_len, nullptr);
-      if (res != LZO_E_OK)
+      for (size_t i = 0; i < batch_count; i++)
       {
-        // This doesn't seem to happen anymore.
-        PanicAlertT("Internal LZO Error - decompression failed (%d) (%li, %li) \n"
-                    "Try loading the state again",
-                    res, i, new_len);
-        return;
+        if (results[i] != LZO_E_OK)
+        {
+          // This doesn't seem to happen anymore.
+          PanicAlertT("Internal LZO Error - decompression failed (%d) (%li, %li) \n"
+                      "Try loading the state again",
+                      results[i], static_cast<long>((batch_start + i) * IN_LEN),
+                      static_cast<long>(in_buffers[i].size()));
+          return;
+        }
       }
-
-      i += new_len;
     }
   }
   else  // uncompressed
@@ -566,11 +835,7 @@ void LoadAs(const std::string& filename)
     bool loadedSuccessfully = false;
     std::string version_created_by;
 
-    // brackets here are so buffer gets freed ASAP
     {
-      std::vector<u8> buffer;
-      LoadFileStateData(filename, buffer);
-
       // load from memory during culling code bruteforcing, because we are loading state tens of
       // thousands of times.
       if (ARBruteForcer::ch_bruteforce && !g_bruteforce_buffer.empty() &&
@@ -685,6 +950,8 @@ void Shutdown()
     std::lock_guard<std::mutex> lk(g_cs_undo_load_buffer);
     std::vector<u8>().swap(g_undo_load_buffer);
   }
+
+  ClearRewindHistory();
 }
 
 static std::string MakeStateFilename(int number)
@@ -53,6 +53,13 @@ void SaveToBuffer(std::vector<u8>& buffer);
 void LoadFromBuffer(std::vector<u8>& buffer);
 void VerifyBuffer(std::vector<u8>& buffer);
 
+// Rewinding keeps a history of states, captured every MAIN_REWIND_INTERVAL of emulated time while
+// MAIN_REWIND_ENABLE is set. Rewind() loads the most recent one, and every further call goes one
+// step further back. RewindFrameUpdate must be called on the CPU thread, once per frame.
+void RewindFrameUpdate();
+void Rewind();
+void ClearRewindHistory();
+
 void LoadLastSaved(int i = 1);
 void SaveFirstSaved();
 void UndoSaveState();
@@ -15,6 +15,7 @@
 
 #include "DiscIO/Blob.h"
 #include "DiscIO/CISOBlob.h"
+#include "DiscIO/ChunkedBlob.h"
 #include "DiscIO/CompressedBlob.h"
 #include "DiscIO/DirectoryBlob.h"
 #include "DiscIO/DriveBlob.h"
@@ -196,6 +197,8 @@ std::unique_ptr<BlobReader> CreateBlobReader(const std::string& filename)
   {
   case CISO_MAGIC:
     return CISOFileReader::Create(std::move(file));
+  case CHUNKED_MAGIC:
+    return ChunkedBlobReader::Create(std::move(file), filename);
   case GCZ_MAGIC:
     return CompressedBlobReader::Create(std::move(file), filename);
   case TGC_MAGIC:
@@ -34,7 +34,8 @@ enum class BlobType
   GCZ,
   CISO,
   WBFS,
-  TGC
+  TGC,
+  CHUNKED
 };
 
 class BlobReader
@@ -168,5 +169,8 @@ bool CompressFileToBlob(const std::string& infile_path, const std::string& outfi
                         void* arg = nullptr);
 bool DecompressBlobToFile(const std::string& infile_path, const std::string& outfile_path,
                           CompressCB callback = nullptr, void* arg = nullptr);
+bool ConvertToChunkedBlob(const std::string& infile_path, const std::string& outfile_path,
+                          u32 sub_type = 0, int chunk_size = 0x8000, CompressCB callback = nullptr,
+                          void* arg = nullptr);
 
 }  // namespace
@@ -0,0 +1,255 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "DiscIO/ChunkedBlob.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <lzo/lzo1x.h>
+#include <zlib.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/File.h"
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+#include "Common/MsgHandler.h"
+#include "Common/StringUtil.h"
+#include "DiscIO/Blob.h"
+
+namespace DiscIO
+{
+ChunkedBlobReader::ChunkedBlobReader(File::IOFile file, const std::string& filename)
+    : m_file(std::move(file)), m_file_name(filename)
+{
+  m_file_size = m_file.GetSize();
+  m_file.Seek(0, SEEK_SET);
+  m_file.ReadArray(&m_header, 1);
+
+  SetSectorSize(m_header.chunk_size);
+
+  m_entries.resize(m_header.num_chunks);
+  m_file.ReadArray(m_entries.data(), m_header.num_chunks);
+
+  // LZO may expand incompressible data slightly, but such chunks are always stored as is.
+  m_compressed_buffer.resize(m_header.chunk_size);
+}
+
+std::unique_ptr<ChunkedBlobReader> ChunkedBlobReader::Create(File::IOFile file,
+                                                             const std::string& filename)
+{
+  ChunkedBlobHeader header;
+  if (!file.Seek(0, SEEK_SET) || !file.ReadArray(&header, 1) || header.magic != CHUNKED_MAGIC)
+    return nullptr;
+
+  if (header.version != CHUNKED_VERSION || header.chunk_size == 0 ||
+      header.num_chunks != (header.data_size + header.chunk_size - 1) / header.chunk_size)
+  {
+    ERROR_LOG(DISCIO, "Unsupported chunked disc image \"%s\"", filename.c_str());
+    return nullptr;
+  }
+
+  if (header.compression == ChunkedCompression::LZO && lzo_init() != LZO_E_OK)
+    return nullptr;
+
+  return std::unique_ptr<ChunkedBlobReader>(new ChunkedBlobReader(std::move(file), filename));
+}
+
+bool ChunkedBlobReader::GetBlock(u64 block_num, u8* out_ptr)
+{
+  if (block_num >= m_entries.size())
+    return false;
+
+  const ChunkedBlobEntry& entry = m_entries[block_num];
+  if (entry.compressed_size > m_header.chunk_size)
+  {
+    NOTICE_LOG(DISCIO, "The disc image \"%s\" is corrupt.", m_file_name.c_str());
+    return false;
+  }
+
+  u8* const read_buffer =
+      (entry.flags & CHUNKED_FLAG_STORED) ? out_ptr : m_compressed_buffer.data();
+  if (!m_file.Seek(entry.offset, SEEK_SET) ||
+      !m_file.ReadBytes(read_buffer, entry.compressed_size))
+  {
+    NOTICE_LOG(DISCIO, "The disc image \"%s\" is truncated, some of the data is missing.",
+               m_file_name.c_str());
+    m_file.Clear();
+    return false;
+  }
+
+  if (entry.flags & CHUNKED_FLAG_STORED)
+  {
+    // The last chunk may be shorter than the others.
+    std::fill(out_ptr + entry.compressed_size, out_ptr + m_header.chunk_size, 0);
+    return true;
+  }
+
+  switch (m_header.compression)
+  {
+  case ChunkedCompression::LZO:
+  {
+    lzo_uint out_size = m_header.chunk_size;
+    const int result = lzo1x_decompress_safe(m_compressed_buffer.data(), entry.compressed_size,
+                                             out_ptr, &out_size, nullptr);
+    if (result == LZO_E_OK && out_size == m_header.chunk_size)
+      return true;
+    break;
+  }
+
+  case ChunkedCompression::Zlib:
+  {
+    uLongf out_size = m_header.chunk_size;
+    const int result =
+        uncompress(out_ptr, &out_size, m_compressed_buffer.data(), entry.compressed_size);
+    if (result == Z_OK && out_size == m_header.chunk_size)
+      return true;
+    break;
+  }
+
+  case ChunkedCompression::None:
+  default:
+    break;
+  }
+
+  NOTICE_LOG(DISCIO, "Failed to decompress chunk %" PRIu64 " of \"%s\"", block_num,
+             m_file_name.c_str());
+  return false;
+}
+
+bool ConvertToChunkedBlob(const std::string& infile_path, const std::string& outfile_path,
+                          u32 sub_type, int chunk_size, CompressCB callback, void* arg)
+{
+  std::unique_ptr<BlobReader> reader = CreateBlobReader(infile_path);
+  if (!reader)
+  {
+    PanicAlertT("Failed to open the input file \"%s\".", infile_path.c_str());
+    return false;
+  }
+
+  if (reader->GetBlobType() == BlobType::CHUNKED)
+  {
+    PanicAlertT("\"%s\" is already compressed! Cannot compress it further.", infile_path.c_str());
+    return false;
+  }
+
+  if (lzo_init() != LZO_E_OK)
+  {
+    PanicAlertT("Internal LZO Error - lzo_init() failed");
+    return false;
+  }
+
+  File::IOFile outfile(outfile_path, "wb");
+  if (!outfile)
+  {
+    PanicAlertT("Failed to open the output file \"%s\".\n"
+                "Check that you have permissions to write the target folder and that the media can "
+                "be written.",
+                outfile_path.c_str());
+    return false;
+  }
+
+  callback(GetStringT("Files opened, ready to compress."), 0, arg);
+
+  ChunkedBlobHeader header;
+  header.magic = CHUNKED_MAGIC;
+  header.version = CHUNKED_VERSION;
+  header.sub_type = sub_type;
+  header.compression = ChunkedCompression::LZO;
+  header.data_size = reader->GetDataSize();
+  header.chunk_size = chunk_size;
+  header.num_chunks = static_cast<u32>((header.data_size + chunk_size - 1) / chunk_size);
+
+  std::vector<ChunkedBlobEntry> entries(header.num_chunks);
+  std::vector<u8> in_buf(chunk_size);
+  // Worst case expansion of LZO1X, see the LZO FAQ.
+  std::vector<u8> out_buf(chunk_size + chunk_size / 16 + 64 + 3);
+  std::vector<u8> work_mem(LZO1X_1_MEM_COMPRESS);
+
+  // The header and chunk table are written at the end, once all offsets are known.
+  u64 position = sizeof(ChunkedBlobHeader) + sizeof(ChunkedBlobEntry) * header.num_chunks;
+  outfile.Seek(position, SEEK_SET);
+
+  const u32 progress_monitor = std::max<u32>(1, header.num_chunks / 1000);
+  bool success = true;
+
+  for (u32 i = 0; i < header.num_chunks; i++)
+  {
+    if (i % progress_monitor == 0)
+    {
+      const u64 in_position = static_cast<u64>(i) * chunk_size;
+      const int ratio = in_position ? static_cast<int>(100 * position / in_position) : 0;
+      const std::string text =
+          StringFromFormat(GetStringT("%i of %i blocks. Compression ratio %i%%").c_str(), i,
+                           header.num_chunks, ratio);
+      if (!callback(text, static_cast<float>(i) / header.num_chunks, arg))
+      {
+        success = false;
+        break;
+      }
+    }
+
+    const u64 offset = static_cast<u64>(i) * chunk_size;
+    const u32 read_size = static_cast<u32>(std::min<u64>(chunk_size, header.data_size - offset));
+    if (!reader->Read(offset, read_size, in_buf.data()))
+    {
+      PanicAlertT("Failed to read from the input file \"%s\".", infile_path.c_str());
+      success = false;
+      break;
+    }
+    std::fill(in_buf.begin() + read_size, in_buf.end(), 0);
+
+    lzo_uint compressed_size = out_buf.size();
+    const int result = lzo1x_1_compress(in_buf.data(), chunk_size, out_buf.data(),
+                                        &compressed_size, work_mem.data());
+
+    ChunkedBlobEntry& entry = entries[i];
+    entry.offset = position;
+    const u8* write_buf;
+    if (result == LZO_E_OK && compressed_size < read_size)
+    {
+      write_buf = out_buf.data();
+      entry.compressed_size = static_cast<u32>(compressed_size);
+      entry.flags = 0;
+    }
+    else
+    {
+      write_buf = in_buf.data();
+      entry.compressed_size = read_size;
+      entry.flags = CHUNKED_FLAG_STORED;
+    }
+
+    if (!outfile.WriteBytes(write_buf, entry.compressed_size))
+    {
+      PanicAlertT("Failed to write the output file \"%s\".\n"
+                  "Check that you have enough space available on the target drive.",
+                  outfile_path.c_str());
+      success = false;
+      break;
+    }
+
+    position += entry.compressed_size;
+  }
+
+  if (!success)
+  {
+    // Remove the incomplete output file.
+    outfile.Close();
+    File::Delete(outfile_path);
+    return false;
+  }
+
+  outfile.Seek(0, SEEK_SET);
+  outfile.WriteArray(&header, 1);
+  outfile.WriteArray(entries.data(), header.num_chunks);
+
+  callback(GetStringT("Done compressing disc image."), 1.0f, arg);
+  return true;
+}
+
+}  // namespace
@@ -0,0 +1,78 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+// Chunked disc images store the disc in fixed-size chunks, each compressed on its own, with a
+// table of chunk offsets up front so that any chunk can be read with a single seek. Unlike GCZ,
+// the compression method is recorded in the header, so that faster codecs than zlib can be used.
+// LZO is the default, as decompressing it is several times cheaper than inflating zlib data.
+//
+// To create new chunked images, use ConvertToChunkedBlob.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/File.h"
+#include "DiscIO/Blob.h"
+
+namespace DiscIO
+{
+static constexpr u32 CHUNKED_MAGIC = 0x4B484344;  // "DCHK" (byteswapped to little endian)
+static constexpr u32 CHUNKED_VERSION = 1;
+
+enum class ChunkedCompression : u32
+{
+  None = 0,
+  Zlib = 1,
+  LZO = 2,
+};
+
+struct ChunkedBlobHeader  // 32 bytes
+{
+  u32 magic;
+  u32 version;
+  u32 sub_type;  // 0 = GC, 1 = Wii, same as GCZ
+  ChunkedCompression compression;
+  u64 data_size;
+  u32 chunk_size;
+  u32 num_chunks;
+};
+
+struct ChunkedBlobEntry  // 16 bytes
+{
+  u64 offset;
+  u32 compressed_size;
+  u32 flags;
+};
+
+// The chunk is stored without compression, because compressing it didn't save any space.
+static constexpr u32 CHUNKED_FLAG_STORED = 1;
+
+class ChunkedBlobReader : public SectorReader
+{
+public:
+  static std::unique_ptr<ChunkedBlobReader> Create(File::IOFile file,
+                                                   const std::string& filename);
+
+  const ChunkedBlobHeader& GetHeader() const { return m_header; }
+  BlobType GetBlobType() const override { return BlobType::CHUNKED; }
+  u64 GetDataSize() const override { return m_header.data_size; }
+  u64 GetRawSize() const override { return m_file_size; }
+  bool GetBlock(u64 block_num, u8* out_ptr) override;
+
+private:
+  ChunkedBlobReader(File::IOFile file, const std::string& filename);
+
+  ChunkedBlobHeader m_header;
+  std::vector<ChunkedBlobEntry> m_entries;
+  File::IOFile m_file;
+  u64 m_file_size;
+  std::vector<u8> m_compressed_buffer;
+  std::string m_file_name;
+};
+
+}  // namespace
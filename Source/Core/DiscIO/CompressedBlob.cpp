@@ -8,11 +8,14 @@
 #endif
 
 #include <algorithm>
+#include <chrono>
 #include <cinttypes>
+#include <condition_variable>
 #include <cstdio>
 #include <cstring>
 #include <memory>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 #include <zlib.h>
@@ -24,6 +27,8 @@
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Common/StringUtil.h"
+#include "Common/Thread.h"
+#include "Common/ThreadPool.h"
 #include "DiscIO/Blob.h"
 #include "DiscIO/CompressedBlob.h"
 #include "DiscIO/DiscScrubber.h"
@@ -32,6 +37,12 @@ namespace DiscIO
 {
 bool IsGCZBlob(File::IOFile& file);
 
+// How many blocks each compression thread gets per batch in CompressFileToBlob.
+enum
+{
+  COMPRESS_BLOCKS_PER_WORKER = 16
+};
+
 CompressedBlobReader::CompressedBlobReader(File::IOFile file, const std::string& filename)
     : m_file(std::move(file)), m_file_name(filename)
 {
@@ -70,6 +81,15 @@ std::unique_ptr<CompressedBlobReader> CompressedBlobReader::Create(File::IOFile
 
 CompressedBlobReader::~CompressedBlobReader()
 {
+  if (m_read_ahead_thread.joinable())
+  {
+    {
+      std::lock_guard<std::mutex> lk(m_read_ahead_lock);
+      m_read_ahead_exit = true;
+    }
+    m_read_ahead_wakeup.notify_one();
+    m_read_ahead_thread.join();
+  }
 }
 
 // IMPORTANT: Calling this function invalidates all earlier pointers gotten from this function.
@@ -86,6 +106,99 @@ u64 CompressedBlobReader::GetBlockCompressedSize(u64 block_num) const
 }
 
 bool CompressedBlobReader::GetBlock(u64 block_num, u8* out_ptr)
+{
+  bool found = false;
+  if (m_read_ahead_thread.joinable())
+  {
+    std::unique_lock<std::mutex> lk(m_read_ahead_lock);
+
+    // If the worker is already on this block, waiting is cheaper than decompressing it twice.
+    m_read_ahead_done.wait(lk, [&] { return m_read_ahead_current != block_num; });
+
+    auto it = m_read_ahead_blocks.find(block_num);
+    if (it != m_read_ahead_blocks.end())
+    {
+      std::copy(it->second.begin(), it->second.end(), out_ptr);
+      m_read_ahead_blocks.erase(it);
+      found = true;
+    }
+  }
+
+  if (!found && !ReadBlock(m_file, m_zlib_buffer, block_num, out_ptr))
+    return false;
+
+  // The DVD thread mostly streams files, so a read of the block following the previous one is a
+  // good hint that the next few blocks will be needed soon.
+  if (block_num == m_last_block_num + 1)
+    ReadAhead(block_num + 1);
+  m_last_block_num = block_num;
+  return true;
+}
+
+void CompressedBlobReader::ReadAhead(u64 first_block_num)
+{
+  if (!m_read_ahead_thread.joinable())
+  {
+    // Started lazily, so that readers which are only used to scan a few headers (e.g. for the
+    // game list) don't spawn a thread.
+    if (!m_read_ahead_file.Open(m_file_name, "rb"))
+      return;
+    m_read_ahead_thread = std::thread(&CompressedBlobReader::ReadAheadThread, this);
+  }
+
+  const u64 end_block_num =
+      std::min<u64>(first_block_num + READ_AHEAD_BLOCKS, m_header.num_blocks);
+
+  std::lock_guard<std::mutex> lk(m_read_ahead_lock);
+
+  // Only keep the blocks of the current window, anything else is left over from an earlier seek.
+  m_read_ahead_blocks.erase(m_read_ahead_blocks.begin(),
+                            m_read_ahead_blocks.lower_bound(first_block_num));
+  m_read_ahead_blocks.erase(m_read_ahead_blocks.lower_bound(end_block_num),
+                            m_read_ahead_blocks.end());
+
+  m_read_ahead_queue.clear();
+  for (u64 i = first_block_num; i < end_block_num; ++i)
+  {
+    if (i != m_read_ahead_current && !m_read_ahead_blocks.count(i))
+      m_read_ahead_queue.push_back(i);
+  }
+  if (!m_read_ahead_queue.empty())
+    m_read_ahead_wakeup.notify_one();
+}
+
+void CompressedBlobReader::ReadAheadThread()
+{
+  Common::SetCurrentThreadName("GCZ read-ahead");
+
+  std::vector<u8> zlib_buffer(m_zlib_buffer.size());
+  std::vector<u8> block(m_header.block_size);
+
+  std::unique_lock<std::mutex> lk(m_read_ahead_lock);
+  for (;;)
+  {
+    m_read_ahead_wakeup.wait(lk,
+                             [&] { return m_read_ahead_exit || !m_read_ahead_queue.empty(); });
+    if (m_read_ahead_exit)
+      return;
+
+    m_read_ahead_current = m_read_ahead_queue.front();
+    m_read_ahead_queue.pop_front();
+
+    lk.unlock();
+    const bool success =
+        ReadBlock(m_read_ahead_file, zlib_buffer, m_read_ahead_current, block.data());
+    lk.lock();
+
+    if (success)
+      m_read_ahead_blocks[m_read_ahead_current] = block;
+    m_read_ahead_current = NO_BLOCK;
+    m_read_ahead_done.notify_all();
+  }
+}
+
+bool CompressedBlobReader::ReadBlock(File::IOFile& file, std::vector<u8>& zlib_buffer,
+                                     u64 block_num, u8* out_ptr) const
 {
   bool uncompressed = false;
   u32 comp_block_size = (u32)GetBlockCompressedSize(block_num);
@@ -100,19 +213,19 @@ bool CompressedBlobReader::GetBlock(u64 block_num, u8* out_ptr)
   }
 
   // clear unused part of zlib buffer. maybe this can be deleted when it works fully.
-  memset(&m_zlib_buffer[comp_block_size], 0, m_zlib_buffer.size() - comp_block_size);
+  memset(&zlib_buffer[comp_block_size], 0, zlib_buffer.size() - comp_block_size);
 
-  m_file.Seek(offset, SEEK_SET);
-  if (!m_file.ReadBytes(m_zlib_buffer.data(), comp_block_size))
+  file.Seek(offset, SEEK_SET);
+  if (!file.ReadBytes(zlib_buffer.data(), comp_block_size))
   {
     NOTICE_LOG(DISCIO, "The disc image \"%s\" is truncated, some of the data is missing.",
                 m_file_name.c_str());
-    m_file.Clear();
+    file.Clear();
     return false;
   }
 
   // First, check hash.
-  u32 block_hash = HashAdler32(m_zlib_buffer.data(), comp_block_size);
+  u32 block_hash = HashAdler32(zlib_buffer.data(), comp_block_size);
   if (block_hash != m_hashes[block_num])
     NOTICE_LOG(DISCIO, "The disc image \"%s\" is corrupt.\n"
                 "Hash of block %" PRIu64 " is %08x instead of %08x.",
@@ -121,12 +234,12 @@ bool CompressedBlobReader::GetBlock(u64 block_num, u8* out_ptr)
 
 	if (uncompressed)
 	{
-		std::copy(m_zlib_buffer.begin(), m_zlib_buffer.begin() + comp_block_size, out_ptr);
+		std::copy(zlib_buffer.begin(), zlib_buffer.begin() + comp_block_size, out_ptr);
 	}
 	else
 	{
 		z_stream z = {};
-		z.next_in  = m_zlib_buffer.data();
+		z.next_in  = zlib_buffer.data();
 		z.avail_in = comp_block_size;
 		if (z.avail_in > m_header.block_size)
 		{
@@ -194,9 +307,27 @@ bool CompressFileToBlob(const std::string& infile_path, const std::string& outfi
     scrubbing = true;
   }
 
-  z_stream z = {};
-  if (deflateInit(&z, 9) != Z_OK)
-    return false;
+  // Blocks are read and written in order on this thread, and compressed in between by this thread
+  // and the shared thread pool. Every worker has its own deflate stream and compresses every
+  // num_workers-th block of the batch.
+  const u32 num_workers = Common::ThreadPool::GetShared().GetWorkerCount() + 1;
+  const u32 batch_size = num_workers * COMPRESS_BLOCKS_PER_WORKER;
+
+  std::vector<z_stream> streams(num_workers);
+  for (z_stream& z : streams)
+  {
+    z = {};
+    if (deflateInit(&z, 9) != Z_OK)
+    {
+      for (z_stream& initialized : streams)
+      {
+        if (&initialized == &z)
+          break;
+        deflateEnd(&initialized);
+      }
+      return false;
+    }
+  }
 
   callback(GetStringT("Files opened, ready to compress."), 0, arg);
 
@@ -211,8 +342,38 @@ bool CompressFileToBlob(const std::string& infile_path, const std::string& outfi
 
   std::vector<u64> offsets(header.num_blocks);
   std::vector<u32> hashes(header.num_blocks);
-  std::vector<u8> out_buf(block_size);
-  std::vector<u8> in_buf(block_size);
+
+  struct CompressionJob
+  {
+    std::vector<u8> in_buf;
+    std::vector<u8> out_buf;
+    int comp_size;
+    bool stored;
+    bool failed;
+  };
+  std::vector<CompressionJob> jobs(batch_size);
+  for (CompressionJob& job : jobs)
+  {
+    job.in_buf.resize(block_size);
+    job.out_buf.resize(block_size);
+  }
+
+  const auto compress_block = [block_size](z_stream& z, CompressionJob& job) {
+    job.failed = deflateReset(&z) != Z_OK;
+    if (job.failed)
+      return;
+
+    z.next_in = job.in_buf.data();
+    z.avail_in = block_size;
+    z.next_out = job.out_buf.data();
+    z.avail_out = block_size;
+
+    int status = deflate(&z, Z_FINISH);
+    job.comp_size = block_size - z.avail_out;
+
+    // let's store uncompressed if it doesn't pay off
+    job.stored = (status != Z_STREAM_END) || (z.avail_out < 10);
+  };
 
   // seek past the header (we will write it at the end)
   outfile.Seek(sizeof(CompressedBlobHeader), SEEK_CUR);
@@ -227,20 +388,27 @@ bool CompressFileToBlob(const std::string& infile_path, const std::string& outfi
   int num_stored = 0;
   int progress_monitor = std::max<int>(1, header.num_blocks / 1000);
   bool success = true;
+  const auto start_time = std::chrono::steady_clock::now();
 
-  for (u32 i = 0; i < header.num_blocks; i++)
+  for (u32 batch_start = 0; batch_start < header.num_blocks; batch_start += batch_size)
   {
-    if (i % progress_monitor == 0)
+    const u32 batch_end = std::min(batch_start + batch_size, header.num_blocks);
+
+    if (batch_start / progress_monitor != batch_end / progress_monitor || batch_start == 0)
     {
       const u64 inpos = infile.Tell();
       int ratio = 0;
       if (inpos != 0)
         ratio = (int)(100 * position / inpos);
 
-      std::string temp =
-          StringFromFormat(GetStringT("%i of %i blocks. Compression ratio %i%%").c_str(), i,
-                           header.num_blocks, ratio);
-      bool was_cancelled = !callback(temp, (float)i / (float)header.num_blocks, arg);
+      const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_time;
+      const double mib_per_second =
+          elapsed.count() > 0 ? inpos / elapsed.count() / (1024 * 1024) : 0.0;
+
+      std::string temp = StringFromFormat(
+          GetStringT("%i of %i blocks. Compression ratio %i%%. %.1f MiB/s").c_str(), batch_start,
+          header.num_blocks, ratio, mib_per_second);
+      bool was_cancelled = !callback(temp, (float)batch_start / (float)header.num_blocks, arg);
       if (was_cancelled)
       {
         success = false;
@@ -248,64 +416,78 @@ bool CompressFileToBlob(const std::string& infile_path, const std::string& outfi
       }
     }
 
-    offsets[i] = position;
-
-    size_t read_bytes;
-    if (scrubbing)
-      read_bytes = disc_scrubber.GetNextBlock(infile, in_buf.data());
-    else
-      infile.ReadArray(in_buf.data(), header.block_size, &read_bytes);
-    if (read_bytes < header.block_size)
-      std::fill(in_buf.begin() + read_bytes, in_buf.begin() + header.block_size, 0);
-
-    int retval = deflateReset(&z);
-    z.next_in = in_buf.data();
-    z.avail_in = header.block_size;
-    z.next_out = out_buf.data();
-    z.avail_out = block_size;
-
-    if (retval != Z_OK)
+    for (u32 i = batch_start; i < batch_end; i++)
     {
-      ERROR_LOG(DISCIO, "Deflate failed");
-      success = false;
-      break;
+      CompressionJob& job = jobs[i - batch_start];
+      size_t read_bytes;
+      if (scrubbing)
+        read_bytes = disc_scrubber.GetNextBlock(infile, job.in_buf.data());
+      else
+        infile.ReadArray(job.in_buf.data(), header.block_size, &read_bytes);
+      if (read_bytes < header.block_size)
+        std::fill(job.in_buf.begin() + read_bytes, job.in_buf.begin() + header.block_size, 0);
     }
 
-    int status = deflate(&z, Z_FINISH);
-    int comp_size = block_size - z.avail_out;
-
-    u8* write_buf;
-    int write_size;
-    if ((status != Z_STREAM_END) || (z.avail_out < 10))
+    const u32 batch_count = batch_end - batch_start;
+    const u32 batch_workers = std::min(num_workers, batch_count);
+    Common::TaskGroup workers;
+    for (u32 worker = 1; worker < batch_workers; worker++)
     {
-      // PanicAlert("%i %i Store %i", i*block_size, position, comp_size);
-      // let's store uncompressed
-      write_buf = in_buf.data();
-      offsets[i] |= 0x8000000000000000ULL;
-      write_size = block_size;
-      num_stored++;
-    }
-    else
-    {
-      // let's store compressed
-      // PanicAlert("Comp %i to %i", block_size, comp_size);
-      write_buf = out_buf.data();
-      write_size = comp_size;
-      num_compressed++;
+      workers.Schedule(
+          [&, worker] {
+            for (u32 j = worker; j < batch_count; j += batch_workers)
+              compress_block(streams[worker], jobs[j]);
+          },
+          Common::TaskPriority::Low);
     }
+    for (u32 j = 0; j < batch_count; j += batch_workers)
+      compress_block(streams[0], jobs[j]);
+    workers.Wait();
 
-    if (!outfile.WriteBytes(write_buf, write_size))
+    for (u32 i = batch_start; i < batch_end; i++)
     {
-      PanicAlertT("Failed to write the output file \"%s\".\n"
-                  "Check that you have enough space available on the target drive.",
-                  outfile_path.c_str());
-      success = false;
-      break;
-    }
+      CompressionJob& job = jobs[i - batch_start];
+      if (job.failed)
+      {
+        ERROR_LOG(DISCIO, "Deflate failed");
+        success = false;
+        break;
+      }
 
-    position += write_size;
+      offsets[i] = position;
 
-    hashes[i] = HashAdler32(write_buf, write_size);
+      u8* write_buf;
+      int write_size;
+      if (job.stored)
+      {
+        write_buf = job.in_buf.data();
+        offsets[i] |= 0x8000000000000000ULL;
+        write_size = block_size;
+        num_stored++;
+      }
+      else
+      {
+        write_buf = job.out_buf.data();
+        write_size = job.comp_size;
+        num_compressed++;
+      }
+
+      if (!outfile.WriteBytes(write_buf, write_size))
+      {
+        PanicAlertT("Failed to write the output file \"%s\".\n"
+                    "Check that you have enough space available on the target drive.",
+                    outfile_path.c_str());
+        success = false;
+        break;
+      }
+
+      position += write_size;
+
+      hashes[i] = HashAdler32(write_buf, write_size);
+    }
+
+    if (!success)
+      break;
   }
 
   header.compressed_data_size = position;
@@ -326,7 +508,8 @@ bool CompressFileToBlob(const std::string& infile_path, const std::string& outfi
   }
 
   // Cleanup
-  deflateEnd(&z);
+  for (z_stream& z : streams)
+    deflateEnd(&z);
 
   if (success)
   {
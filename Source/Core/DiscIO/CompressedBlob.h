@@ -13,8 +13,14 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <deque>
+#include <limits>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -57,6 +63,16 @@ public:
 private:
   CompressedBlobReader(File::IOFile file, const std::string& filename);
 
+  bool ReadBlock(File::IOFile& file, std::vector<u8>& zlib_buffer, u64 block_num,
+                 u8* out_ptr) const;
+
+  // Sequential reads queue the following blocks to be decompressed on a worker thread.
+  void ReadAhead(u64 first_block_num);
+  void ReadAheadThread();
+
+  static constexpr u32 READ_AHEAD_BLOCKS = 8;
+  static constexpr u64 NO_BLOCK = std::numeric_limits<u64>::max();
+
   CompressedBlobHeader m_header;
   std::vector<u64> m_block_pointers;
   std::vector<u32> m_hashes;
@@ -65,6 +81,18 @@ private:
   u64 m_file_size;
   std::vector<u8> m_zlib_buffer;
   std::string m_file_name;
+  u64 m_last_block_num = NO_BLOCK;
+
+  // The read-ahead thread uses its own file handle, so it never has to seek m_file.
+  File::IOFile m_read_ahead_file;
+  std::thread m_read_ahead_thread;
+  std::mutex m_read_ahead_lock;
+  std::condition_variable m_read_ahead_wakeup;
+  std::condition_variable m_read_ahead_done;
+  std::deque<u64> m_read_ahead_queue;
+  std::map<u64, std::vector<u8>> m_read_ahead_blocks;
+  u64 m_read_ahead_current = NO_BLOCK;
+  bool m_read_ahead_exit = false;
 };
 
 }  // namespace
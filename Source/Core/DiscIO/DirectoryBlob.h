@@ -5,22 +5,24 @@
 #pragma once
 
 #include <cstddef>
+#include <list>
 #include <map>
 #include <memory>
 #include <optional>
 #include <set>
 #include <string>
+#include <utility>
 #include <variant>
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/File.h"
 #include "Common/FileUtil.h"
 #include "DiscIO/Blob.h"
 
 namespace File
 {
 struct FSTEntry;
-class IOFile;
 }
 
 namespace DiscIO
@@ -30,6 +32,20 @@ enum class PartitionType : u32;
 // Returns true if the path is inside a DirectoryBlob and doesn't represent the DirectoryBlob itself
 bool ShouldHideFromGameList(const std::string& volume_path);
 
+// Keeps the most recently read host files open. Games tend to read a file in several parts,
+// and opening a file can take longer than reading from it, especially on a network share.
+class OpenFileCache
+{
+public:
+  File::IOFile* Open(const std::string& path);
+
+private:
+  static constexpr size_t MAX_OPEN_FILES = 16;
+
+  // Most recently used first
+  std::list<std::pair<std::string, File::IOFile>> m_files;
+};
+
 class DiscContent
 {
 public:
@@ -44,7 +60,7 @@ public:
   u64 GetOffset() const;
   u64 GetEndOffset() const;
   u64 GetSize() const;
-  bool Read(u64* offset, u64* length, u8** buffer) const;
+  bool Read(u64* offset, u64* length, u8** buffer, OpenFileCache* open_files) const;
 
   bool operator==(const DiscContent& other) const { return GetEndOffset() == other.GetEndOffset(); }
   bool operator!=(const DiscContent& other) const { return !(*this == other); }
@@ -75,6 +91,8 @@ public:
 
 private:
   std::set<DiscContent> m_contents;
+  // Reads aren't thread-safe anyway (see BlobReader::Read)
+  mutable OpenFileCache m_open_files;
 };
 
 class DirectoryBlobPartition
@@ -6,11 +6,16 @@
 
 #include <algorithm>
 #include <cinttypes>
+#include <condition_variable>
 #include <locale>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/StringUtil.h"
+#include "Common/ThreadPool.h"
 #include "DiscIO/Enums.h"
 #include "DiscIO/Filesystem.h"
 #include "DiscIO/Volume.h"
@@ -119,10 +124,37 @@ bool ExportFile(const Volume& volume, const Partition& partition, const std::str
   return ExportFile(volume, partition, file_system->FindFileInfo(path).get(), export_filename);
 }
 
-void ExportDirectory(const Volume& volume, const Partition partition, const FileInfo& directory,
-                     bool recursive, const std::string& filesystem_path,
-                     const std::string& export_folder,
-                     const std::function<bool(const std::string& path)>& update_progress)
+namespace
+{
+// Files are read in chunks of this size, and written while the next chunks are read as long as
+// no more than MAX_BYTES_IN_FLIGHT are waiting to be written.
+constexpr u64 EXPORT_CHUNK_SIZE = 0x800000;
+constexpr u64 MAX_BYTES_IN_FLIGHT = 0x4000000;
+
+struct ExportedFile
+{
+  std::string path;
+  std::string export_path;
+  u64 offset;
+  u64 size;
+};
+
+// A file being written to by the writer tasks. Its chunks can arrive in any order.
+struct OpenFile
+{
+  explicit OpenFile(const std::string& path) : export_path(path), file(path, "wb") {}
+
+  std::string export_path;
+  std::mutex lock;
+  File::IOFile file;
+  bool failed = false;
+};
+
+// Creates the directories, and lists the files in them. Returns false if cancelled.
+bool ListDirectory(const FileInfo& directory, bool recursive, const std::string& filesystem_path,
+                   const std::string& export_folder,
+                   const std::function<bool(const std::string& path)>& update_progress,
+                   std::vector<ExportedFile>* files)
 {
   File::CreateFullPath(export_folder + '/');
 
@@ -132,23 +164,122 @@ void ExportDirectory(const Volume& volume, const Partition partition, const File
     const std::string path = filesystem_path + name;
     const std::string export_path = export_folder + '/' + name;
 
-    if (update_progress(path))
-      return;
+    if (!file_info.IsDirectory())
+    {
+      files->push_back({path, export_path, file_info.GetOffset(), file_info.GetSize()});
+    }
+    else
+    {
+      // The progress of files is updated as they are read.
+      if (update_progress(path))
+        return false;
 
-    DEBUG_LOG(DISCIO, "%s", export_path.c_str());
+      DEBUG_LOG(DISCIO, "%s", export_path.c_str());
 
-    if (!file_info.IsDirectory())
+      if (recursive &&
+          !ListDirectory(file_info, recursive, path, export_path, update_progress, files))
+      {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+}  // Anonymous namespace
+
+void ExportDirectory(const Volume& volume, const Partition partition, const FileInfo& directory,
+                     bool recursive, const std::string& filesystem_path,
+                     const std::string& export_folder,
+                     const std::function<bool(const std::string& path)>& update_progress)
+{
+  std::vector<ExportedFile> files;
+  if (!ListDirectory(directory, recursive, filesystem_path, export_folder, update_progress, &files))
+    return;
+
+  // Reading in the order of the disc seeks the least, and lets neighbouring files share the
+  // decrypted clusters cached by the volume instead of decrypting them again for each file.
+  std::stable_sort(files.begin(), files.end(), [](const ExportedFile& a, const ExportedFile& b) {
+    return a.offset < b.offset;
+  });
+
+  // This thread reads, as the volume can't be read from several threads, and calls
+  // update_progress. The writes go to the shared thread pool.
+  std::mutex in_flight_lock;
+  std::condition_variable in_flight_changed;
+  u64 bytes_in_flight = 0;
+
+  Common::TaskGroup writers;
+  for (const ExportedFile& exported : files)
+  {
+    if (update_progress(exported.path))
+      break;
+
+    DEBUG_LOG(DISCIO, "%s", exported.export_path.c_str());
+
+    if (File::Exists(exported.export_path))
     {
-      if (File::Exists(export_path))
-        NOTICE_LOG(DISCIO, "%s already exists", export_path.c_str());
-      else if (!ExportFile(volume, partition, &file_info, export_path))
-        ERROR_LOG(DISCIO, "Could not export %s", export_path.c_str());
+      NOTICE_LOG(DISCIO, "%s already exists", exported.export_path.c_str());
+      continue;
     }
-    else if (recursive)
+
+    auto open_file = std::make_shared<OpenFile>(exported.export_path);
+    if (!open_file->file)
+    {
+      ERROR_LOG(DISCIO, "Could not export %s", exported.export_path.c_str());
+      continue;
+    }
+
+    for (u64 position = 0; position < exported.size; position += EXPORT_CHUNK_SIZE)
     {
-      ExportDirectory(volume, partition, file_info, recursive, path, export_path, update_progress);
+      const u64 chunk_size = std::min(exported.size - position, EXPORT_CHUNK_SIZE);
+      {
+        // Pending writes are run here too, as the pool has no workers on single core hosts.
+        std::unique_lock<std::mutex> lk(in_flight_lock);
+        while (bytes_in_flight != 0 && bytes_in_flight + chunk_size > MAX_BYTES_IN_FLIGHT)
+        {
+          lk.unlock();
+          const bool ran_task = Common::ThreadPool::GetShared().RunPendingTask();
+          lk.lock();
+          if (!ran_task && bytes_in_flight != 0 &&
+              bytes_in_flight + chunk_size > MAX_BYTES_IN_FLIGHT)
+          {
+            in_flight_changed.wait(lk);
+          }
+        }
+        bytes_in_flight += chunk_size;
+      }
+
+      auto chunk = std::make_shared<std::vector<u8>>(static_cast<size_t>(chunk_size));
+      if (!volume.Read(exported.offset + position, chunk_size, chunk->data(), partition))
+      {
+        ERROR_LOG(DISCIO, "Could not export %s", exported.export_path.c_str());
+        std::lock_guard<std::mutex> lk(in_flight_lock);
+        bytes_in_flight -= chunk_size;
+        break;
+      }
+
+      writers.Schedule(
+          [&, open_file, chunk, position] {
+            {
+              std::lock_guard<std::mutex> lk(open_file->lock);
+              if (!open_file->failed && (!open_file->file.Seek(position, SEEK_SET) ||
+                                         !open_file->file.WriteBytes(chunk->data(), chunk->size())))
+              {
+                ERROR_LOG(DISCIO, "Could not export %s", open_file->export_path.c_str());
+                open_file->failed = true;
+              }
+            }
+            {
+              std::lock_guard<std::mutex> lk(in_flight_lock);
+              bytes_in_flight -= chunk->size();
+            }
+            in_flight_changed.notify_one();
+          },
+          Common::TaskPriority::Low);
     }
   }
+  writers.Wait();
 }
 
 bool ExportWiiUnencryptedHeader(const Volume& volume, const std::string& export_filename)
@@ -2,17 +2,103 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdio>
 #include <memory>
 #include <string>
 #include <utility>
 
+#ifdef _WIN32
+#include <io.h>
+#include <windows.h>
+#else
+#include <unistd.h>
+#if !defined(__ANDROID__) && !defined(__HAIKU__)
+#include <aio.h>
+#define HAVE_POSIX_AIO 1
+#endif
+#endif
+
 #include "DiscIO/FileBlob.h"
 
 namespace DiscIO
 {
+// Reads larger than this are split into chunks which are all in flight at the same time. On
+// spinning disks and network shares, this hides much of the latency of each request.
+static constexpr u64 CHUNK_SIZE = 0x20000;
+
+#ifdef _WIN32
+// Reads at an offset instead of the file pointer. When the handle was opened for overlapped
+// I/O, this only starts the read, which must then be finished with FinishRead. Otherwise, the
+// event is ignored and the read is done when this returns.
+static bool StartRead(HANDLE handle, HANDLE event, OVERLAPPED* overlapped, u64 offset, u64 size,
+                      u8* out_ptr)
+{
+  *overlapped = {};
+  overlapped->Offset = static_cast<DWORD>(offset);
+  overlapped->OffsetHigh = static_cast<DWORD>(offset >> 32);
+  overlapped->hEvent = event;
+  return ReadFile(handle, out_ptr, static_cast<DWORD>(size), nullptr, overlapped) ||
+         GetLastError() == ERROR_IO_PENDING;
+}
+
+static bool FinishRead(HANDLE handle, OVERLAPPED* overlapped, u64 size)
+{
+  DWORD bytes_read;
+  return GetOverlappedResult(handle, overlapped, &bytes_read, TRUE) && bytes_read == size;
+}
+#else
+static bool ReadAt(int fd, u64 offset, u64 size, u8* out_ptr)
+{
+  while (size > 0)
+  {
+    const ssize_t result = pread(fd, out_ptr, size, static_cast<off_t>(offset));
+    if (result < 0 && errno == EINTR)
+      continue;
+    if (result <= 0)
+      return false;
+
+    offset += result;
+    size -= result;
+    out_ptr += result;
+  }
+  return true;
+}
+#endif
+
 PlainFileReader::PlainFileReader(File::IOFile file) : m_file(std::move(file))
 {
   m_size = m_file.GetSize();
+
+#ifdef _WIN32
+  const HANDLE handle = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(m_file.GetHandle())));
+  const HANDLE overlapped_handle = ReOpenFile(handle, GENERIC_READ,
+                                              FILE_SHARE_READ | FILE_SHARE_WRITE,
+                                              FILE_FLAG_OVERLAPPED);
+  if (overlapped_handle != INVALID_HANDLE_VALUE)
+  {
+    m_overlapped_handle = overlapped_handle;
+    for (void*& event : m_events)
+      event = CreateEvent(nullptr, TRUE, FALSE, nullptr);
+  }
+#endif
+}
+
+PlainFileReader::~PlainFileReader()
+{
+#ifdef _WIN32
+  if (m_overlapped_handle)
+  {
+    for (void* event : m_events)
+    {
+      if (event)
+        CloseHandle(event);
+    }
+    CloseHandle(m_overlapped_handle);
+  }
+#endif
 }
 
 std::unique_ptr<PlainFileReader> PlainFileReader::Create(File::IOFile file)
@@ -25,15 +111,112 @@ std::unique_ptr<PlainFileReader> PlainFileReader::Create(File::IOFile file)
 
 bool PlainFileReader::Read(u64 offset, u64 nbytes, u8* out_ptr)
 {
-  if (m_file.Seek(offset, SEEK_SET) && m_file.ReadBytes(out_ptr, nbytes))
+  if (m_size < 0 || offset > static_cast<u64>(m_size) || nbytes > m_size - offset)
+    return false;
+
+  while (nbytes > 0)
   {
-    return true;
+    const u64 chunks = std::min<u64>((nbytes + CHUNK_SIZE - 1) / CHUNK_SIZE, MAX_READS_IN_FLIGHT);
+    const u64 size = std::min(nbytes, chunks * CHUNK_SIZE);
+    if (!ReadChunks(offset, size, out_ptr))
+      return false;
+
+    offset += size;
+    nbytes -= size;
+    out_ptr += size;
   }
-  else
+  return true;
+}
+
+bool PlainFileReader::ReadChunks(u64 offset, u64 nbytes, u8* out_ptr)
+{
+  const size_t chunks = static_cast<size_t>((nbytes + CHUNK_SIZE - 1) / CHUNK_SIZE);
+
+#ifdef _WIN32
+  if (!m_overlapped_handle || chunks == 1 ||
+      std::find(m_events.begin(), m_events.end(), nullptr) != m_events.end())
   {
-    m_file.Clear();
-    return false;
+    const HANDLE handle = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(m_file.GetHandle())));
+    OVERLAPPED overlapped;
+    return StartRead(handle, nullptr, &overlapped, offset, nbytes, out_ptr) &&
+           FinishRead(handle, &overlapped, nbytes);
+  }
+
+  std::array<OVERLAPPED, MAX_READS_IN_FLIGHT> overlapped;
+  size_t started = 0;
+  bool success = true;
+  for (; started < chunks; started++)
+  {
+    const u64 chunk_offset = started * CHUNK_SIZE;
+    if (!StartRead(m_overlapped_handle, m_events[started], &overlapped[started],
+                   offset + chunk_offset, std::min(CHUNK_SIZE, nbytes - chunk_offset),
+                   out_ptr + chunk_offset))
+    {
+      success = false;
+      break;
+    }
   }
+
+  // Even after a failure, the reads which were started must finish before their buffer and
+  // OVERLAPPED go away.
+  for (size_t i = 0; i < started; i++)
+  {
+    const u64 chunk_offset = i * CHUNK_SIZE;
+    const u64 chunk_size = std::min(CHUNK_SIZE, nbytes - chunk_offset);
+    success &= FinishRead(m_overlapped_handle, &overlapped[i], chunk_size);
+  }
+  return success;
+#else
+  const int fd = fileno(m_file.GetHandle());
+
+#ifdef HAVE_POSIX_AIO
+  if (chunks > 1)
+  {
+    std::array<aiocb, MAX_READS_IN_FLIGHT> control_blocks = {};
+    std::array<aiocb*, MAX_READS_IN_FLIGHT> list;
+    for (size_t i = 0; i < chunks; i++)
+    {
+      const u64 chunk_offset = i * CHUNK_SIZE;
+      aiocb& control_block = control_blocks[i];
+      control_block.aio_fildes = fd;
+      control_block.aio_offset = static_cast<off_t>(offset + chunk_offset);
+      control_block.aio_buf = out_ptr + chunk_offset;
+      control_block.aio_nbytes = std::min(CHUNK_SIZE, nbytes - chunk_offset);
+      control_block.aio_lio_opcode = LIO_READ;
+      list[i] = &control_block;
+    }
+
+    // With LIO_WAIT, this may still return early if it is interrupted by a signal, so wait for
+    // every read which is still in progress.
+    lio_listio(LIO_WAIT, list.data(), static_cast<int>(chunks), nullptr);
+
+    bool success = true;
+    for (size_t i = 0; i < chunks; i++)
+    {
+      aiocb& control_block = control_blocks[i];
+      int error;
+      while ((error = aio_error(&control_block)) == EINPROGRESS)
+      {
+        const aiocb* const wait_list[] = {&control_block};
+        aio_suspend(wait_list, 1, nullptr);
+      }
+
+      // A chunk which failed to start, or was only read in part, is read synchronously.
+      const ssize_t result = aio_return(&control_block);
+      const u64 done = error == 0 && result > 0 ? static_cast<u64>(result) : 0;
+      if (done < control_block.aio_nbytes)
+      {
+        u8* const buffer = static_cast<u8*>(const_cast<void*>(control_block.aio_buf));
+        success &= ReadAt(fd, control_block.aio_offset + done, control_block.aio_nbytes - done,
+                          buffer + done);
+      }
+    }
+    return success;
+  }
+#endif
+
+  return ReadAt(fd, offset, nbytes, out_ptr);
+#endif
 }
 
 }  // namespace
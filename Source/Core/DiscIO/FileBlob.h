@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <array>
 #include <cstdio>
 #include <memory>
 #include <string>
@@ -18,6 +19,7 @@ class PlainFileReader : public BlobReader
 {
 public:
   static std::unique_ptr<PlainFileReader> Create(File::IOFile file);
+  ~PlainFileReader();
 
   BlobType GetBlobType() const override { return BlobType::PLAIN; }
   u64 GetDataSize() const override { return m_size; }
@@ -25,10 +27,22 @@ public:
   bool Read(u64 offset, u64 nbytes, u8* out_ptr) override;
 
 private:
+  static constexpr size_t MAX_READS_IN_FLIGHT = 16;
+
   PlainFileReader(File::IOFile file);
 
+  // Reads up to MAX_READS_IN_FLIGHT chunks at once. Uses positional reads rather than seeking,
+  // as all the chunks are read from the same file.
+  bool ReadChunks(u64 offset, u64 nbytes, u8* out_ptr);
+
   File::IOFile m_file;
   s64 m_size;
+
+#ifdef _WIN32
+  // A second handle to the file, opened for overlapped I/O, and an event for each read in flight.
+  void* m_overlapped_handle = nullptr;
+  std::array<void*, MAX_READS_IN_FLIGHT> m_events{};
+#endif
 };
 
 }  // namespace
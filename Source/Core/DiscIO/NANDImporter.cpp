@@ -9,6 +9,7 @@
 #include <cinttypes>
 #include <cstring>
 
+#include "Common/Align.h"
 #include "Common/Crypto/AES.h"
 #include "Common/File.h"
 #include "Common/FileUtil.h"
@@ -16,6 +17,7 @@
 #include "Common/MsgHandler.h"
 #include "Common/StringUtil.h"
 #include "Common/Swap.h"
+#include "Common/ThreadPool.h"
 #include "Core/IOS/ES/Formats.h"
 
 namespace DiscIO
@@ -40,8 +42,19 @@ void NANDImporter::ImportNANDBin(const std::string& path_to_bin,
   if (nand_root.back() == '/')
     m_nand_root_length++;
 
+  constexpr size_t NAND_AES_KEY_OFFSET = 0x158;
+  m_aes_context = Common::AES::CreateContextDecrypt(&m_nand_keys[NAND_AES_KEY_OFFSET]);
+
   FindSuperblock();
-  ProcessEntry(0, nand_root);
+  {
+    // Directories are created in order, as the files in them are scheduled.
+    Common::TaskGroup file_tasks;
+    m_file_tasks = &file_tasks;
+    ProcessEntry(0, nand_root);
+    file_tasks.Wait();
+    m_file_tasks = nullptr;
+  }
+  m_update_callback();
   ExportKeys(nand_root);
   ExtractCertificates(nand_root);
 }
@@ -65,15 +78,27 @@ bool NANDImporter::ReadNANDBin(const std::string& path_to_bin,
 
   m_nand.resize(NAND_SIZE);
 
-  for (size_t i = 0; i < NAND_TOTAL_BLOCKS; i++)
+  // Read in chunks of blocks, as reading every block and skipping its ECC data one by one takes
+  // as many system calls as there are blocks.
+  constexpr size_t BLOCKS_PER_CHUNK = 1000;
+  std::vector<u8> chunk((NAND_BLOCK_SIZE + NAND_ECC_BLOCK_SIZE) * BLOCKS_PER_CHUNK);
+  for (size_t i = 0; i < NAND_TOTAL_BLOCKS; i += BLOCKS_PER_CHUNK)
   {
-    // Instead of updating on every cycle, we only update every 1000 cycles for a balance between
-    // not updating fast enough vs updating too fast
-    if (i % 1000 == 0)
-      m_update_callback();
+    m_update_callback();
 
-    file.ReadBytes(&m_nand[i * NAND_BLOCK_SIZE], NAND_BLOCK_SIZE);
-    file.Seek(NAND_ECC_BLOCK_SIZE, SEEK_CUR);  // We don't care about the ECC blocks
+    const size_t num_blocks = std::min(BLOCKS_PER_CHUNK, NAND_TOTAL_BLOCKS - i);
+    if (!file.ReadBytes(chunk.data(), (NAND_BLOCK_SIZE + NAND_ECC_BLOCK_SIZE) * num_blocks))
+    {
+      PanicAlertT("Could not read the NAND backup.");
+      return false;
+    }
+
+    // We don't care about the ECC blocks
+    for (size_t j = 0; j < num_blocks; j++)
+    {
+      std::copy_n(&chunk[(NAND_BLOCK_SIZE + NAND_ECC_BLOCK_SIZE) * j], NAND_BLOCK_SIZE,
+                  &m_nand[(i + j) * NAND_BLOCK_SIZE]);
+    }
   }
 
   m_nand_keys.resize(NAND_KEYS_SIZE);
@@ -170,30 +195,38 @@ void NANDImporter::ProcessDirectory(const NANDFSTEntry& entry, const std::string
 
 void NANDImporter::ProcessFile(const NANDFSTEntry& entry, const std::string& parent_path)
 {
-  constexpr size_t NAND_AES_KEY_OFFSET = 0x158;
-  constexpr size_t NAND_FAT_BLOCK_SIZE = 0x4000;
-
   m_update_callback();
   INFO_LOG(DISCIO, "File: %s", FormatDebugString(entry).c_str());
 
-  const std::string path = GetPath(entry, parent_path);
-  File::IOFile file(path, "wb");
-  std::array<u8, 16> key{};
-  std::copy(&m_nand_keys[NAND_AES_KEY_OFFSET], &m_nand_keys[NAND_AES_KEY_OFFSET + key.size()],
-            key.begin());
+  m_file_tasks->Schedule(
+      [this, entry, path = GetPath(entry, parent_path)] { ExtractFile(entry, path); });
+}
+
+void NANDImporter::ExtractFile(const NANDFSTEntry& entry, const std::string& path) const
+{
+  constexpr size_t NAND_FAT_BLOCK_SIZE = 0x4000;
+
+  const u32 file_size = Common::swap32(entry.size);
+  std::vector<u8> data(Common::AlignUp(file_size, NAND_FAT_BLOCK_SIZE));
   u16 sub = Common::swap16(entry.sub);
-  u32 remaining_bytes = Common::swap32(entry.size);
 
-  while (remaining_bytes > 0)
+  // Every block is encrypted on its own, with an IV of zero.
+  const std::array<u8, 16> iv{};
+  for (size_t offset = 0; offset < data.size(); offset += NAND_FAT_BLOCK_SIZE)
   {
-    std::array<u8, 16> iv{};
-    std::vector<u8> block = Common::AES::Decrypt(
-        key.data(), iv.data(), &m_nand[NAND_FAT_BLOCK_SIZE * sub], NAND_FAT_BLOCK_SIZE);
-    u32 size = remaining_bytes < NAND_FAT_BLOCK_SIZE ? remaining_bytes : NAND_FAT_BLOCK_SIZE;
-    file.WriteBytes(block.data(), size);
-    remaining_bytes -= size;
+    if (NAND_FAT_BLOCK_SIZE * (sub + 1) > m_nand_fat_offset)
+    {
+      ERROR_LOG(DISCIO, "Invalid block 0x%04x in %s", sub, path.c_str());
+      return;
+    }
+    m_aes_context->DecryptCBC(iv.data(), &m_nand[NAND_FAT_BLOCK_SIZE * sub], &data[offset],
+                              NAND_FAT_BLOCK_SIZE);
     sub = Common::swap16(&m_nand[m_nand_fat_offset + 2 * sub]);
   }
+
+  File::IOFile file(path, "wb");
+  if (!file.WriteBytes(data.data(), file_size))
+    ERROR_LOG(DISCIO, "Unable to write to file %s", path.c_str());
 }
 
 bool NANDImporter::ExtractCertificates(const std::string& nand_root)
@@ -5,11 +5,21 @@
 #pragma once
 
 #include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "Common/CommonTypes.h"
 
+namespace Common
+{
+class TaskGroup;
+namespace AES
+{
+class Context;
+}
+}
+
 namespace DiscIO
 {
 class NANDImporter final
@@ -48,6 +58,7 @@ private:
   std::string FormatDebugString(const NANDFSTEntry& entry);
   void ProcessEntry(u16 entry_number, const std::string& parent_path);
   void ProcessFile(const NANDFSTEntry& entry, const std::string& parent_path);
+  void ExtractFile(const NANDFSTEntry& entry, const std::string& path) const;
   void ProcessDirectory(const NANDFSTEntry& entry, const std::string& parent_path);
   void ExportKeys(const std::string& nand_root);
 
@@ -57,5 +68,9 @@ private:
   size_t m_nand_fst_offset = 0;
   std::function<void()> m_update_callback;
   size_t m_nand_root_length = 0;
+
+  // Files are decrypted and written by the thread pool, while the file system is walked.
+  std::unique_ptr<Common::AES::Context> m_aes_context;
+  Common::TaskGroup* m_file_tasks = nullptr;
 };
 }
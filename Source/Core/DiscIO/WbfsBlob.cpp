@@ -118,16 +118,17 @@ bool WbfsFileReader::Read(u64 offset, u64 nbytes, u8* out_ptr)
   while (nbytes)
   {
     u64 read_size;
-    File::IOFile& data_file = SeekToCluster(offset, &read_size);
-    if (read_size == 0)
+    FileEntry* file_entry = SeekToCluster(offset, nbytes, &read_size);
+    if (!file_entry)
       return false;
-    read_size = std::min(read_size, nbytes);
 
-    if (!data_file.ReadBytes(out_ptr, read_size))
+    if (!file_entry->file.ReadBytes(out_ptr, read_size))
     {
-      data_file.Clear();
+      file_entry->file.Clear();
+      file_entry->position = UINT64_MAX;
       return false;
     }
+    file_entry->position += read_size;
 
     out_ptr += read_size;
     nbytes -= read_size;
@@ -137,7 +138,8 @@ bool WbfsFileReader::Read(u64 offset, u64 nbytes, u8* out_ptr)
   return true;
 }
 
-File::IOFile& WbfsFileReader::SeekToCluster(u64 offset, u64* available)
+WbfsFileReader::FileEntry* WbfsFileReader::SeekToCluster(u64 offset, u64 max_size,
+                                                          u64* available)
 {
   u64 base_cluster = (offset >> m_header.wbfs_sector_shift);
   if (base_cluster < m_blocks_per_disc)
@@ -150,24 +152,38 @@ File::IOFile& WbfsFileReader::SeekToCluster(u64 offset, u64* available)
     {
       if (final_address < (file_entry.base_address + file_entry.size))
       {
-        file_entry.file.Seek(final_address - file_entry.base_address, SEEK_SET);
-        if (available)
+        const u64 position = final_address - file_entry.base_address;
+        if (file_entry.position != position)
         {
-          u64 till_end_of_file = file_entry.size - (final_address - file_entry.base_address);
-          u64 till_end_of_sector = m_wbfs_sector_size - cluster_offset;
-          *available = std::min(till_end_of_file, till_end_of_sector);
+          if (!file_entry.file.Seek(position, SEEK_SET))
+          {
+            file_entry.position = UINT64_MAX;
+            break;
+          }
+          file_entry.position = position;
         }
 
-        return file_entry.file;
+        // Clusters after this one which the table has right after it on the disk can be read
+        // in the same go.
+        u64 till_end_of_sector = m_wbfs_sector_size - cluster_offset;
+        u64 cluster = base_cluster + 1;
+        while (till_end_of_sector < max_size && cluster < m_blocks_per_disc &&
+               m_wlba_table[cluster] == m_wlba_table[cluster - 1] + 1)
+        {
+          till_end_of_sector += m_wbfs_sector_size;
+          cluster++;
+        }
+
+        const u64 till_end_of_file = file_entry.size - position;
+        *available = std::min({till_end_of_file, till_end_of_sector, max_size});
+        return &file_entry;
       }
     }
   }
 
   PanicAlert("Read beyond end of disc");
-  if (available)
-    *available = 0;
-  m_files[0].file.Seek(0, SEEK_SET);
-  return m_files[0].file;
+  *available = 0;
+  return nullptr;
 }
 
 std::unique_ptr<WbfsFileReader> WbfsFileReader::Create(File::IOFile file, const std::string& path)
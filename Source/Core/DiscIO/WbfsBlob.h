@@ -39,7 +39,6 @@ private:
   bool AddFileToList(File::IOFile file);
   bool ReadHeader();
 
-  File::IOFile& SeekToCluster(u64 offset, u64* available);
   bool IsGood() { return m_good; }
   struct FileEntry
   {
@@ -51,8 +50,15 @@ private:
     File::IOFile file;
     u64 base_address;
     u64 size;
+    // Where the next read from the file starts, so that sequential reads don't seek, which would
+    // throw away the buffer of the file. UINT64_MAX if unknown.
+    u64 position = UINT64_MAX;
   };
 
+  // Seeks the file that has the data at offset, and returns how much of the data is there in one
+  // piece, up to max_size. This goes across WBFS clusters that follow each other in the file too.
+  FileEntry* SeekToCluster(u64 offset, u64 max_size, u64* available);
+
   std::vector<FileEntry> m_files;
 
   u64 m_size;
@@ -0,0 +1,149 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "DolphinNoGUI/FifoBenchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <mutex>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/File.h"
+#include "Common/StringUtil.h"
+#include "Core/FifoPlayer/FifoPlayer.h"
+#include "VideoCommon/RenderBase.h"
+
+namespace FifoBenchmark
+{
+using Clock = std::chrono::steady_clock;
+
+static std::mutex s_lock;
+static Result s_result;
+static Clock::time_point s_last_frame_time;
+static bool s_measuring = false;
+
+static void OnFrameWritten()
+{
+  const Clock::time_point now = Clock::now();
+  FifoPlayer& player = FifoPlayer::GetInstance();
+
+  std::lock_guard<std::mutex> lk(s_lock);
+
+  // The first playback is only there to warm up the caches.
+  const bool measure = player.GetCompletedPlaybacks() > 0;
+  if (measure && s_measuring)
+  {
+    s_result.cpu_frame_times.push_back(
+        std::chrono::duration<double, std::milli>(now - s_last_frame_time).count());
+  }
+  s_last_frame_time = now;
+
+  if (g_renderer)
+  {
+    if (!g_renderer->IsGPUFrameTimingEnabled())
+      g_renderer->SetGPUFrameTimingEnabled(true);
+
+    std::vector<double> gpu_times = g_renderer->TakeGPUFrameTimes();
+    if (s_measuring)
+      s_result.gpu_frame_times.insert(s_result.gpu_frame_times.end(), gpu_times.begin(),
+                                      gpu_times.end());
+  }
+
+  s_measuring = measure;
+}
+
+void Start(const std::string& file, u32 playbacks)
+{
+  std::lock_guard<std::mutex> lk(s_lock);
+  s_result = {};
+  s_result.file = file;
+  s_result.playbacks = playbacks;
+  s_measuring = false;
+
+  FifoPlayer& player = FifoPlayer::GetInstance();
+  player.SetPlaybackCount(playbacks + 1);
+  player.SetFrameWrittenCallback(OnFrameWritten);
+}
+
+Result Finish()
+{
+  FifoPlayer& player = FifoPlayer::GetInstance();
+  player.SetFrameWrittenCallback(nullptr);
+  player.SetPlaybackCount(0);
+
+  std::lock_guard<std::mutex> lk(s_lock);
+  if (g_renderer)
+  {
+    std::vector<double> gpu_times = g_renderer->TakeGPUFrameTimes();
+    if (s_measuring)
+      s_result.gpu_frame_times.insert(s_result.gpu_frame_times.end(), gpu_times.begin(),
+                                      gpu_times.end());
+    g_renderer->SetGPUFrameTimingEnabled(false);
+  }
+
+  return std::move(s_result);
+}
+
+static std::string EscapeJSON(const std::string& str)
+{
+  std::string escaped;
+  for (char c : str)
+  {
+    if (c == '"' || c == '\\')
+      escaped += '\\';
+    if (static_cast<unsigned char>(c) < 0x20)
+      escaped += StringFromFormat("\\u%04x", c);
+    else
+      escaped += c;
+  }
+  return escaped;
+}
+
+static std::string FormatStatistics(std::vector<double> times)
+{
+  if (times.empty())
+    return "null";
+
+  std::sort(times.begin(), times.end());
+  const auto percentile = [&times](double p) {
+    const size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * times.size()));
+    return times[std::max<size_t>(rank, 1) - 1];
+  };
+  const double mean = std::accumulate(times.begin(), times.end(), 0.0) / times.size();
+
+  return StringFromFormat("{\"frames\": %zu, \"mean\": %.4f, \"min\": %.4f, \"p50\": %.4f, "
+                          "\"p90\": %.4f, \"p95\": %.4f, \"p99\": %.4f, \"max\": %.4f}",
+                          times.size(), mean, times.front(), percentile(50), percentile(90),
+                          percentile(95), percentile(99), times.back());
+}
+
+bool WriteReport(const std::string& path, const std::string& video_backend,
+                 const std::vector<Result>& results)
+{
+  std::string json = "{\n";
+  json += StringFromFormat("  \"video_backend\": \"%s\",\n", EscapeJSON(video_backend).c_str());
+  json += "  \"results\": [";
+  for (size_t i = 0; i < results.size(); i++)
+  {
+    const Result& result = results[i];
+    json += i ? ",\n" : "\n";
+    json += "    {\n";
+    json += StringFromFormat("      \"file\": \"%s\",\n", EscapeJSON(result.file).c_str());
+    json += StringFromFormat("      \"playbacks\": %u,\n", result.playbacks);
+    json += StringFromFormat("      \"cpu_ms\": %s,\n",
+                             FormatStatistics(result.cpu_frame_times).c_str());
+    json +=
+        StringFromFormat("      \"gpu_ms\": %s\n", FormatStatistics(result.gpu_frame_times).c_str());
+    json += "    }";
+  }
+  json += "\n  ]\n}\n";
+
+  File::IOFile file(path, "wb");
+  return file && file.WriteBytes(json.data(), json.size());
+}
+}
@@ -0,0 +1,36 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+// Plays fifo logs back as a renderer benchmark. Each log is played once to warm up the shader
+// and texture caches, then the requested number of times while the time of every frame is
+// recorded, both on the CPU thread (time between frames being submitted) and on the GPU (from
+// timestamp queries, on backends which support them).
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace FifoBenchmark
+{
+struct Result
+{
+  std::string file;
+  u32 playbacks = 0;
+  std::vector<double> cpu_frame_times;  // milliseconds
+  std::vector<double> gpu_frame_times;  // milliseconds, empty if unsupported
+};
+
+// Sets up FifoPlayer for the next log. Must be called before booting it.
+void Start(const std::string& file, u32 playbacks);
+
+// Collects the timings of the log being played back. Must be called before emulation is stopped,
+// so that the renderer can still report the last frames.
+Result Finish();
+
+bool WriteReport(const std::string& path, const std::string& video_backend,
+                 const std::vector<Result>& results);
+}
@@ -3,13 +3,16 @@
 // Refer to the license.txt file included.
 
 #include <OptionParser.h>
+#include <algorithm>
 #include <cstddef>
 #include <cstdio>
 #include <cstring>
+#include <functional>
 #include <signal.h>
 #include <string>
 #include <thread>
 #include <unistd.h>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/Event.h"
@@ -27,9 +30,14 @@
 #include "Core/IOS/STM/STM.h"
 #include "Core/State.h"
 
+#include "DolphinNoGUI/FifoBenchmark.h"
+#include "DolphinNoGUI/MovieVerifier.h"
+
 #include "UICommon/CommandLineParse.h"
+#include "UICommon/TexturePackConverter.h"
 #include "UICommon/UICommon.h"
 
+#include "VideoCommon/HiresTextures.h"
 #include "VideoCommon/RenderBase.h"
 #include "VideoCommon/VR.h"
 #include "VideoCommon/VideoBackendBase.h"
@@ -309,11 +317,10 @@ class PlatformX11 : public Platform
             last_window_width = event.xconfigure.width;
             last_window_height = event.xconfigure.height;
 
-            // We call Renderer::ChangeSurface here to indicate the size has changed,
-            // but pass the same window handle. This is needed for the Vulkan backend,
-            // otherwise it cannot tell that the window has been resized on some drivers.
+            // This is needed for the Vulkan backend, otherwise it cannot tell that the window
+            // has been resized on some drivers.
             if (g_renderer)
-              g_renderer->ChangeSurface(s_window_handle);
+              g_renderer->ResizeSurface();
           }
         }
         break;
@@ -359,14 +366,163 @@ static Platform* GetPlatform()
   return nullptr;
 }
 
+// Runs emulation until it stops. before_stop is called while the core is still running.
+static bool BootAndRun(std::unique_ptr<BootParameters> boot,
+                       const std::function<void()>& before_stop = {})
+{
+  s_running.Set();
+  if (!BootManager::BootCore(std::move(boot)))
+  {
+    fprintf(stderr, "Could not boot the specified file\n");
+    return false;
+  }
+
+  while (!Core::IsRunning() && s_running.IsSet())
+  {
+    Core::HostDispatchJobs();
+    updateMainFrameEvent.Wait();
+  }
+
+  if (s_running.IsSet())
+    platform->MainLoop();
+  if (before_stop)
+    before_stop();
+  Core::Stop();
+
+  Core::Shutdown();
+  return true;
+}
+
+static int RunFifoBenchmark(const std::vector<std::string>& files, u32 playbacks,
+                            const std::string& output_path)
+{
+  // Nothing should hold back playback other than the time the frames take to render.
+  SConfig::GetInstance().m_EmulationSpeed = 0.0f;
+
+  std::vector<FifoBenchmark::Result> results;
+  for (const std::string& file : files)
+  {
+    if (s_shutdown_requested.IsSet())
+      break;
+
+    fprintf(stderr, "Benchmarking %s (%u playbacks)\n", file.c_str(), playbacks);
+    FifoBenchmark::Start(file, playbacks);
+    if (!BootAndRun(BootParameters::GenerateFromFile(file),
+                    [&results] { results.push_back(FifoBenchmark::Finish()); }))
+    {
+      FifoBenchmark::Finish();
+      return 1;
+    }
+  }
+
+  if (!FifoBenchmark::WriteReport(output_path, SConfig::GetInstance().m_strVideoBackend, results))
+  {
+    fprintf(stderr, "Could not write the benchmark report to %s\n", output_path.c_str());
+    return 1;
+  }
+
+  return 0;
+}
+
+static int RunMovieVerification(std::unique_ptr<BootParameters> boot, const std::string& movie,
+                                bool use_null_backend, const std::string& expected_ram_hash)
+{
+  if (!MovieVerifier::Start(movie, use_null_backend))
+  {
+    fprintf(stderr, "Could not play the movie %s\n", movie.c_str());
+    return 1;
+  }
+
+  MovieVerifier::Result result;
+  if (!BootAndRun(std::move(boot), [&result] { result = MovieVerifier::Finish(); }))
+  {
+    MovieVerifier::Finish();
+    return 1;
+  }
+
+  return MovieVerifier::Report(result, expected_ram_hash) ? 0 : 1;
+}
+
+static int ConvertTexturePack(const std::string& game_id)
+{
+  const std::string texture_directory = HiresTexture::GetTextureDirectory(game_id);
+  const std::string output_path = texture_directory + ".dtp";
+  fprintf(stderr, "Converting %s to %s\n", texture_directory.c_str(), output_path.c_str());
+
+  int last_percent = -1;
+  const bool success = UICommon::ConvertTexturePack(
+      texture_directory, output_path, [&last_percent](const std::string& text, float progress) {
+        const int percent = static_cast<int>(progress * 100);
+        if (percent != last_percent)
+          fprintf(stderr, "[%3d%%] %s\n", percent, text.c_str());
+        last_percent = percent;
+        return true;
+      });
+
+  return success ? 0 : 1;
+}
+
 int main(int argc, char* argv[])
 {
   auto parser = CommandLineParse::CreateParser(CommandLineParse::ParserOptions::OmitGUIOptions);
+  parser->add_option("--fifo_benchmark")
+      .action("store")
+      .metavar("<output.json>")
+      .type("string")
+      .help("Play back the given fifo logs as a benchmark and write frame timings to a JSON file");
+  parser->add_option("--fifo_playbacks")
+      .action("store")
+      .type("int")
+      .set_default(5)
+      .help("Number of timed playbacks of each fifo log, after one warm-up playback (default 5)");
+  parser->add_option("--verify_movie")
+      .action("store")
+      .metavar("<movie.dtm>")
+      .type("string")
+      .help("Play the movie as fast as possible without output, then report whether it synced");
+  parser->add_option("--movie_ram_hash")
+      .action("store")
+      .metavar("<hash>")
+      .type("string")
+      .help("RAM hash which --verify_movie expects at the end of the movie");
+  parser->add_option("--convert_texture_pack")
+      .action("store")
+      .metavar("<game id>")
+      .type("string")
+      .help("Bake the custom textures of the given game into a texture pack, then exit");
   optparse::Values& options = CommandLineParse::ParseArguments(parser.get(), argc, argv);
   std::vector<std::string> args = parser->args();
 
+  const bool fifo_benchmark = options.is_set("fifo_benchmark");
+  if (fifo_benchmark && args.empty())
+  {
+    fprintf(stderr, "No fifo logs given to benchmark\n");
+    parser->print_help();
+    return 1;
+  }
+
+  std::string user_directory;
+  if (options.is_set("user"))
+  {
+    user_directory = static_cast<const char*>(options.get("user"));
+  }
+
+  if (options.is_set("convert_texture_pack"))
+  {
+    UICommon::SetUserDirectory(user_directory);
+    UICommon::Init();
+    const int result =
+        ConvertTexturePack(static_cast<const char*>(options.get("convert_texture_pack")));
+    UICommon::Shutdown();
+    return result;
+  }
+
   std::unique_ptr<BootParameters> boot;
-  if (options.is_set("exec"))
+  if (fifo_benchmark)
+  {
+    // The logs are booted one by one below.
+  }
+  else if (options.is_set("exec"))
   {
     boot = BootParameters::GenerateFromFile(static_cast<const char*>(options.get("exec")));
   }
@@ -393,12 +549,6 @@ int main(int argc, char* argv[])
     return 0;
   }
 
-  std::string user_directory;
-  if (options.is_set("user"))
-  {
-    user_directory = static_cast<const char*>(options.get("user"));
-  }
-
   platform = GetPlatform();
   if (!platform)
   {
@@ -425,27 +575,32 @@ int main(int argc, char* argv[])
 
   DolphinAnalytics::Instance()->ReportDolphinStart("nogui");
 
-  if (!BootManager::BootCore(std::move(boot)))
+  int result = 0;
+  if (options.is_set("verify_movie"))
   {
-    fprintf(stderr, "Could not boot the specified file\n");
-    return 1;
+    const std::string video_backend = static_cast<const char*>(options.get("video_backend"));
+    std::string expected_ram_hash;
+    if (options.is_set("movie_ram_hash"))
+      expected_ram_hash = static_cast<const char*>(options.get("movie_ram_hash"));
+    result = RunMovieVerification(std::move(boot),
+                                  static_cast<const char*>(options.get("verify_movie")),
+                                  video_backend.empty(), expected_ram_hash);
   }
-
-  while (!Core::IsRunning() && s_running.IsSet())
+  else if (fifo_benchmark)
   {
-    Core::HostDispatchJobs();
-    updateMainFrameEvent.Wait();
+    const int playbacks = static_cast<int>(options.get("fifo_playbacks"));
+    result = RunFifoBenchmark(args, static_cast<u32>(std::max(playbacks, 1)),
+                              static_cast<const char*>(options.get("fifo_benchmark")));
+  }
+  else if (!BootAndRun(std::move(boot)))
+  {
+    return 1;
   }
 
-  if (s_running.IsSet())
-    platform->MainLoop();
-  Core::Stop();
-
-  Core::Shutdown();
   platform->Shutdown();
   UICommon::Shutdown();
 
   delete platform;
 
-  return 0;
+  return result;
 }
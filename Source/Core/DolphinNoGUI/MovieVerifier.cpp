@@ -0,0 +1,128 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "DolphinNoGUI/MovieVerifier.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cinttypes>
+#include <cstdio>
+#include <mutex>
+#include <string>
+
+#include "Common/CommonTypes.h"
+#include "Common/Hash.h"
+#include "Common/MsgHandler.h"
+#include "Common/StringUtil.h"
+#include "Core/ConfigManager.h"
+#include "Core/HW/Memmap.h"
+#include "Core/Host.h"
+#include "Core/Movie.h"
+
+namespace MovieVerifier
+{
+static std::mutex s_lock;
+static Result s_result;
+
+static bool AlertHandler(const char* caption, const char* text, bool yes_no, MsgType style)
+{
+  fprintf(stderr, "%s: %s\n", caption, text);
+  if (style == MsgType::Warning || style == MsgType::Critical)
+  {
+    std::lock_guard<std::mutex> lk(s_lock);
+    s_result.alerts++;
+  }
+
+  // Nobody is there to answer
+  return false;
+}
+
+static void UpdateCounts()
+{
+  s_result.frame = Movie::GetCurrentFrame();
+  s_result.total_frames = Movie::GetTotalFrames();
+  s_result.input_count = Movie::GetCurrentInputCount();
+  s_result.total_input_count = Movie::GetTotalInputCount();
+}
+
+static void OnPlaybackEnded()
+{
+  std::lock_guard<std::mutex> lk(s_lock);
+  if (s_result.ended)
+    return;
+
+  s_result.ended = true;
+  UpdateCounts();
+
+  // This runs on the CPU thread with the CPU stopped, so memory is in its final state.
+  if (Memory::IsInitialized())
+  {
+    s_result.ram_hash =
+        StringFromFormat("%08x", HashAdler32(Memory::m_pRAM, Memory::REALRAM_SIZE));
+    if (SConfig::GetInstance().bWii && Memory::m_pEXRAM)
+      s_result.ram_hash +=
+          StringFromFormat("%08x", HashAdler32(Memory::m_pEXRAM, Memory::EXRAM_SIZE));
+  }
+
+  Host_Message(WM_USER_STOP);
+}
+
+bool Start(const std::string& movie, bool use_null_backend)
+{
+  {
+    std::lock_guard<std::mutex> lk(s_lock);
+    s_result = {};
+    s_result.movie = movie;
+  }
+
+  // None of these change what is emulated, only how fast and what is output.
+  SConfig& config = SConfig::GetInstance();
+  if (use_null_backend)
+    config.m_strVideoBackend = "Null";
+  config.sBackend = BACKEND_NULLSOUND;
+  config.m_EmulationSpeed = 0.0f;
+  config.m_DumpFrames = false;
+  config.m_PauseMovie = false;
+
+  RegisterMsgAlertHandler(AlertHandler);
+  SetEnableAlert(true);
+
+  // Read-only, so that running out of input ends playback instead of recording
+  Movie::SetReadOnly(true);
+  Movie::SetPlaybackEndedCallback(OnPlaybackEnded);
+  return Movie::PlayInput(movie);
+}
+
+Result Finish()
+{
+  Movie::SetPlaybackEndedCallback(nullptr);
+
+  std::lock_guard<std::mutex> lk(s_lock);
+  if (!s_result.ended)
+    UpdateCounts();
+  return s_result;
+}
+
+bool Report(const Result& result, const std::string& expected_ram_hash)
+{
+  // Lag frames after the last input don't need to be played for the input to have synced.
+  bool passed = result.ended && result.alerts == 0 && !result.ram_hash.empty() &&
+                result.input_count >= result.total_input_count;
+  if (!expected_ram_hash.empty())
+  {
+    std::string expected = expected_ram_hash;
+    std::transform(expected.begin(), expected.end(), expected.begin(), ::tolower);
+    passed = passed && expected == result.ram_hash;
+  }
+
+  printf("Movie: %s\n", result.movie.c_str());
+  printf("Frames: %" PRIu64 " / %" PRIu64 "\n", result.frame, result.total_frames);
+  printf("Inputs: %" PRIu64 " / %" PRIu64 "\n", result.input_count, result.total_input_count);
+  printf("Alerts: %u\n", result.alerts);
+  if (!result.ram_hash.empty())
+    printf("RAM hash: %s\n", result.ram_hash.c_str());
+  printf("Result: %s\n", passed ? "passed" : "failed");
+  return passed;
+}
+}
@@ -0,0 +1,45 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+// Plays a movie back as fast as the CPU allows to check that it still syncs. The Null video
+// backend is used unless another one is chosen, which turns EFB copies and XFB presentation into
+// no-ops, along with no audio output and no speed limit. Settings which affect emulation,
+// including the EFB and XFB options saved in the movie, are left as they are, so that playback
+// stays deterministic. Games which read the EFB or EFB copies back from RAM don't render the same
+// with the Null backend, so their movies need to be verified with a real one.
+//
+// The movie passes if all of its input is played without an alert (desyncs are reported through
+// panic alerts) and, if an expected hash is given, RAM hashes to it when playback ends.
+
+#pragma once
+
+#include <string>
+
+#include "Common/CommonTypes.h"
+
+namespace MovieVerifier
+{
+struct Result
+{
+  std::string movie;
+  bool ended = false;  // Playback stopped on its own, rather than emulation being stopped
+  u32 alerts = 0;
+  u64 frame = 0;
+  u64 total_frames = 0;
+  u64 input_count = 0;
+  u64 total_input_count = 0;
+  // Adler-32 of MEM1 in hex, followed by that of MEM2 on Wii. Empty if playback didn't end.
+  std::string ram_hash;
+};
+
+// Configures the core for verification and starts playing the movie. Must be called before
+// booting the game.
+bool Start(const std::string& movie, bool use_null_backend);
+
+// Must be called before emulation is stopped, so that an unfinished playback can be reported.
+Result Finish();
+
+// Prints the result, and returns whether the movie passed.
+bool Report(const Result& result, const std::string& expected_ram_hash);
+}
@@ -47,11 +47,16 @@ void AdvancedWidget::CreateWidgets()
       new GraphicsBool(tr("Texture Format Overlay"), Config::GFX_TEXFMT_OVERLAY_ENABLE);
   m_enable_api_validation =
       new GraphicsBool(tr("Enable API Validation Layers"), Config::GFX_ENABLE_VALIDATION_LAYER);
+  m_show_frame_profile =
+      new GraphicsBool(tr("Show Frame Profile"), Config::GFX_OVERLAY_FRAME_PROFILE);
+  m_show_metrics = new GraphicsBool(tr("Show Metrics"), Config::GFX_OVERLAY_METRICS);
 
   debugging_layout->addWidget(m_enable_wireframe, 0, 0);
   debugging_layout->addWidget(m_show_statistics, 0, 1);
   debugging_layout->addWidget(m_enable_format_overlay, 1, 0);
   debugging_layout->addWidget(m_enable_api_validation, 1, 1);
+  debugging_layout->addWidget(m_show_frame_profile, 2, 0);
+  debugging_layout->addWidget(m_show_metrics, 2, 1);
 
   // Utility
   auto* utility_box = new QGroupBox(tr("Utility"));
@@ -144,6 +149,14 @@ void AdvancedWidget::AddDescriptions()
   static const char* TR_VALIDATION_LAYER_DESCRIPTION =
       QT_TR_NOOP("Enables validation of API calls made by the video backend, which may assist in "
                  "debugging graphical issues.\n\nIf unsure, leave this unchecked.");
+  static const char* TR_FRAME_PROFILE_DESCRIPTION =
+      QT_TR_NOOP("Show where the time of each frame went on the video threads. Turning this off "
+                 "saves the recorded frames to User/Dump/ as a Chrome trace.\n\nIf unsure, leave "
+                 "this unchecked.");
+  static const char* TR_METRICS_DESCRIPTION =
+      QT_TR_NOOP("Show the counters the emulator keeps for monitoring, such as draw calls, shader "
+                 "compiles and audio underruns, with their change over the last frame.\n\nIf "
+                 "unsure, leave this unchecked.");
   static const char* TR_DUMP_TEXTURE_DESCRIPTION =
       QT_TR_NOOP("Dump decoded game textures to User/Dump/Textures/<game_id>/.\n\nIf unsure, leave "
                  "this unchecked.");
@@ -194,6 +207,8 @@ void AdvancedWidget::AddDescriptions()
   AddDescription(m_show_statistics, TR_SHOW_STATS_DESCRIPTION);
   AddDescription(m_enable_format_overlay, TR_TEXTURE_FORMAT_DECRIPTION);
   AddDescription(m_enable_api_validation, TR_VALIDATION_LAYER_DESCRIPTION);
+  AddDescription(m_show_frame_profile, TR_FRAME_PROFILE_DESCRIPTION);
+  AddDescription(m_show_metrics, TR_METRICS_DESCRIPTION);
   AddDescription(m_dump_textures, TR_DUMP_TEXTURE_DESCRIPTION);
   AddDescription(m_load_custom_textures, TR_LOAD_CUSTOM_TEXTURE_DESCRIPTION);
   AddDescription(m_prefetch_custom_textures, TR_CACHE_CUSTOM_TEXTURE_DESCRIPTION);
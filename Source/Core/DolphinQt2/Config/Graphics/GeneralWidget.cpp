@@ -53,6 +53,8 @@ void GeneralWidget::CreateWidgets()
                          Config::GFX_ASPECT_RATIO);
   m_adapter_combo = new GraphicsChoice({}, Config::GFX_ADAPTER);
   m_enable_vsync = new GraphicsBool(tr("V-Sync"), Config::GFX_VSYNC);
+  m_frame_pacing_combo = new GraphicsChoice(
+      {tr("Off"), tr("Fixed Refresh Rate"), tr("Variable Refresh Rate")}, Config::GFX_FRAME_PACING);
   m_enable_fullscreen = new QCheckBox(tr("Use Fullscreen"));
 
   m_video_box->setLayout(m_video_layout);
@@ -86,6 +88,9 @@ void GeneralWidget::CreateWidgets()
   m_video_layout->addWidget(m_enable_vsync, 4, 0);
   m_video_layout->addWidget(m_enable_fullscreen, 4, 1);
 
+  m_video_layout->addWidget(new QLabel(tr("Frame Pacing:")), 5, 0);
+  m_video_layout->addWidget(m_frame_pacing_combo, 5, 1);
+
   // Other
   auto* m_options_box = new QGroupBox(tr("Other"));
   auto* m_options_layout = new QGridLayout();
@@ -284,6 +289,11 @@ void GeneralWidget::AddDescriptions()
   static const char* TR_VSYNC_DESCRIPTION =
       QT_TR_NOOP("Wait for vertical blanks in order to reduce tearing.\nDecreases performance if "
                  "emulation speed is below 100%.\n\nIf unsure, leave this unchecked.");
+  static const char* TR_FRAME_PACING_DESCRIPTION = QT_TR_NOOP(
+      "Spaces out the frames shown by the time that passed between them in the game, which "
+      "removes the stutter of frames arriving unevenly.\nFixed Refresh Rate: For V-Sync on a "
+      "regular display.\nVariable Refresh Rate: For G-Sync and FreeSync displays. Uses a little "
+      "more CPU time to wait precisely.\n\nIf unsure, select Off.");
   static const char* TR_SHOW_FPS_DESCRIPTION =
       QT_TR_NOOP("Show the number of frames rendered per second as a measure of "
                  "emulation speed.\n\nIf unsure, leave this unchecked.");
@@ -309,6 +319,7 @@ void GeneralWidget::AddDescriptions()
   AddDescription(m_render_main_window, TR_RENDER_TO_MAINWINDOW_DESCRIPTION);
   AddDescription(m_aspect_combo, TR_ASPECT_RATIO_DESCRIPTION);
   AddDescription(m_enable_vsync, TR_VSYNC_DESCRIPTION);
+  AddDescription(m_frame_pacing_combo, TR_FRAME_PACING_DESCRIPTION);
   AddDescription(m_show_fps, TR_SHOW_FPS_DESCRIPTION);
   AddDescription(m_show_ping, TR_SHOW_NETPLAY_PING_DESCRIPTION);
   AddDescription(m_log_render_time, TR_LOG_RENDERTIME_DESCRIPTION);
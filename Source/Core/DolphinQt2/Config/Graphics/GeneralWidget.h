@@ -42,6 +42,7 @@ private:
   QComboBox* m_adapter_combo;
   QComboBox* m_aspect_combo;
   QCheckBox* m_enable_vsync;
+  QComboBox* m_frame_pacing_combo;
   QCheckBox* m_enable_fullscreen;
 
   // Options
@@ -75,6 +75,10 @@ void HacksWidget::CreateWidgets()
   xfb_layout->addWidget(m_disable_xfb, 0, 0);
   xfb_layout->addWidget(m_virtual_xfb, 0, 1);
   xfb_layout->addWidget(m_real_xfb, 0, 2);
+
+  m_store_xfb_copies = new GraphicsBool(tr("Store XFB Copies to Texture Only"),
+                                        Config::GFX_HACK_SKIP_XFB_COPY_TO_RAM);
+  xfb_layout->addWidget(m_store_xfb_copies, 1, 0);
   // Other
   auto* other_box = new QGroupBox(tr("Other"));
   auto* other_layout = new QGridLayout();
@@ -102,6 +106,7 @@ void HacksWidget::CreateWidgets()
 void HacksWidget::ConnectWidgets()
 {
   connect(m_disable_xfb, &QCheckBox::toggled, this, &HacksWidget::OnXFBToggled);
+  connect(m_real_xfb, &QRadioButton::toggled, this, &HacksWidget::OnXFBToggled);
   connect(m_accuracy, &QSlider::valueChanged, [this](int) { SaveSettings(); });
 }
 
@@ -109,6 +114,7 @@ void HacksWidget::OnXFBToggled()
 {
   m_real_xfb->setEnabled(!m_disable_xfb->isChecked());
   m_virtual_xfb->setEnabled(!m_disable_xfb->isChecked());
+  m_store_xfb_copies->setEnabled(!m_disable_xfb->isChecked() && m_real_xfb->isChecked());
 }
 
 void HacksWidget::LoadSettings()
@@ -194,6 +200,12 @@ void HacksWidget::AddDescriptions()
                  "high-resolution rendering but is necessary to emulate a number of games "
                  "properly.\n\nIf unsure, check virtual XFB emulation instead.");
 
+  static const char* TR_STORE_XFB_TO_TEXTURE_DESCRIPTION = QT_TR_NOOP(
+      "Keeps real XFB copies on the GPU at the internal resolution instead of reading them back "
+      "to RAM, and presents them directly. The XFB is only read from RAM after the CPU has "
+      "written to it.\nGreatly speeds up real XFB emulation, but breaks games which read the XFB "
+      "back.\n\nIf unsure, leave this unchecked.");
+
   static const char* TR_GPU_DECODING_DESCRIPTION =
       QT_TR_NOOP("Enables texture decoding using the GPU instead of the CPU. This may result in "
                  "performance gains in some scenarios, or on systems where the CPU is the "
@@ -218,6 +230,7 @@ void HacksWidget::AddDescriptions()
   AddDescription(m_disable_xfb, TR_DISABLE_XFB_DESCRIPTION);
   AddDescription(m_virtual_xfb, TR_VIRTUAL_XFB_DESCRIPTION);
   AddDescription(m_real_xfb, TR_REAL_XFB_DESCRIPTION);
+  AddDescription(m_store_xfb_copies, TR_STORE_XFB_TO_TEXTURE_DESCRIPTION);
   AddDescription(m_gpu_texture_decoding, TR_GPU_DECODING_DESCRIPTION);
   AddDescription(m_fast_depth_calculation, TR_FAST_DEPTH_CALC_DESCRIPTION);
   AddDescription(m_disable_bounding_box, TR_DISABLE_BOUNDINGBOX_DESCRIPTION);
@@ -36,6 +36,7 @@ private:
   QCheckBox* m_disable_xfb;
   QRadioButton* m_virtual_xfb;
   QRadioButton* m_real_xfb;
+  QCheckBox* m_store_xfb_copies;
 
   // Other
   QCheckBox* m_fast_depth_calculation;
@@ -99,8 +99,11 @@ QWidget* InfoWidget::CreateBannerGraphic()
   QWidget* widget = new QWidget();
   QHBoxLayout* layout = new QHBoxLayout();
 
+  // Show the banner at its native size, rather than the size it has in the game list
+  QPixmap pixmap = m_game.GetBanner();
+  pixmap.setDevicePixelRatio(1);
   QLabel* banner = new QLabel();
-  banner->setPixmap(m_game.GetBanner());
+  banner->setPixmap(pixmap);
   QPushButton* save = new QPushButton(tr("Save as..."));
   connect(save, &QPushButton::clicked, this, &InfoWidget::SaveBanner);
 
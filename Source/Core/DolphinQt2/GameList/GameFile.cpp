@@ -2,6 +2,8 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <algorithm>
+
 #include <QDir>
 #include <QFileInfo>
 #include <QImage>
@@ -23,6 +25,16 @@
 #include "DolphinQt2/Resources.h"
 #include "DolphinQt2/Settings.h"
 
+static const QSize GAMECUBE_BANNER_SIZE(96, 32);
+static const QSize GRID_BANNER_SIZE(144, 48);
+
+// GameCube banners are 96x32, but Wii banners are 192x64.
+static int GetBannerScale(const QImage& banner)
+{
+  return std::max(1, std::max(banner.width() / GAMECUBE_BANNER_SIZE.width(),
+                              banner.height() / GAMECUBE_BANNER_SIZE.height()));
+}
+
 QList<DiscIO::Language> GameFile::GetAvailableLanguages() const
 {
   return m_long_names.keys();
@@ -76,16 +88,41 @@ void GameFile::ReadBanner(const DiscIO::Volume& volume)
 {
   int width, height;
   std::vector<u32> buffer = volume.GetBanner(&width, &height);
-  QImage banner(width, height, QImage::Format_RGB888);
-  for (int i = 0; i < width * height; i++)
+  if (width <= 0 || height <= 0 || buffer.size() < static_cast<size_t>(width * height))
+    return;
+
+  // The buffer holds 0x00RRGGBB pixels, which only miss their alpha to be QRgb values.
+  QImage banner(width, height, QImage::Format_RGB32);
+  for (int y = 0; y < height; y++)
   {
-    int x = i % width, y = i / width;
-    banner.setPixel(x, y, qRgb((buffer[i] & 0xFF0000) >> 16, (buffer[i] & 0x00FF00) >> 8,
-                               (buffer[i] & 0x0000FF) >> 0));
+    QRgb* line = reinterpret_cast<QRgb*>(banner.scanLine(y));
+    for (int x = 0; x < width; x++)
+      line[x] = 0xFF000000 | buffer[y * width + x];
   }
 
-  if (!banner.isNull())
-    m_banner = QPixmap::fromImage(banner);
+  m_banner = banner;
+  m_grid_banner = banner.scaled(GRID_BANNER_SIZE * GetBannerScale(banner), Qt::KeepAspectRatio,
+                                Qt::SmoothTransformation);
+}
+
+QPixmap GameFile::GetBanner() const
+{
+  if (m_banner_pixmap.isNull() && !m_banner.isNull())
+  {
+    m_banner_pixmap = QPixmap::fromImage(m_banner);
+    m_banner_pixmap.setDevicePixelRatio(GetBannerScale(m_banner));
+  }
+  return m_banner_pixmap;
+}
+
+QPixmap GameFile::GetGridBanner() const
+{
+  if (m_grid_banner_pixmap.isNull() && !m_grid_banner.isNull())
+  {
+    m_grid_banner_pixmap = QPixmap::fromImage(m_grid_banner);
+    m_grid_banner_pixmap.setDevicePixelRatio(GetBannerScale(m_banner));
+  }
+  return m_grid_banner_pixmap;
 }
 
 bool GameFile::LoadFileInfo(const QString& path)
@@ -444,6 +481,7 @@ QDataStream& operator<<(QDataStream& out, const GameFile& file)
   out << file.m_rating;
   out << file.m_apploader_date;
   out << file.m_banner;
+  out << file.m_grid_banner;
 
   return out;
 }
@@ -474,6 +512,7 @@ QDataStream& operator>>(QDataStream& in, GameFile& file)
   in >> file.m_rating;
   in >> file.m_apploader_date;
   in >> file.m_banner;
+  in >> file.m_grid_banner;
 
   file.m_valid = true;
 
@@ -6,6 +6,7 @@
 
 #include <QDateTime>
 #include <QFile>
+#include <QImage>
 #include <QMap>
 #include <QPixmap>
 #include <QString>
@@ -46,7 +47,9 @@ public:
   QString GetUniqueID() const;
   u8 GetDiscNumber() const { return m_disc_number; }
   u64 GetRawSize() const { return m_raw_size; }
-  QPixmap GetBanner() const { return m_banner; }
+  QPixmap GetBanner() const;
+  // The banner pre-scaled to the size of the grid view
+  QPixmap GetGridBanner() const;
   QString GetIssues() const { return m_issues; }
   int GetRating() const { return m_rating; }
   QString GetApploaderDate() const { return m_apploader_date; }
@@ -111,7 +114,12 @@ private:
   DiscIO::Country m_country;
   DiscIO::BlobType m_blob_type;
   u64 m_raw_size = 0;
-  QPixmap m_banner;
+  // Banners are decoded and scaled on the thread loading the game, as images. They only become
+  // pixmaps (on first use, in the GUI thread) when they are displayed.
+  QImage m_banner;
+  QImage m_grid_banner;
+  mutable QPixmap m_banner_pixmap;
+  mutable QPixmap m_grid_banner_pixmap;
   QString m_issues;
   int m_rating = 0;
   QString m_apploader_date;
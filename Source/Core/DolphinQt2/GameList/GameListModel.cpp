@@ -64,9 +64,11 @@ QVariant GameListModel::data(const QModelIndex& index, int role) const
       // TODO: use custom banners from rom directory like DolphinWX?
       QPixmap banner = game->GetBanner();
       if (banner.isNull())
+      {
         banner = Resources::GetMisc(Resources::BANNER_MISSING);
-      banner.setDevicePixelRatio(std::max(banner.width() / GAMECUBE_BANNER_SIZE.width(),
-                                          banner.height() / GAMECUBE_BANNER_SIZE.height()));
+        banner.setDevicePixelRatio(std::max(banner.width() / GAMECUBE_BANNER_SIZE.width(),
+                                            banner.height() / GAMECUBE_BANNER_SIZE.height()));
+      }
       return banner;
     }
     break;
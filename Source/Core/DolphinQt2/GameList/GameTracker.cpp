@@ -14,8 +14,9 @@
 
 static const QStringList game_filters{
     QStringLiteral("*.gcm"),  QStringLiteral("*.iso"), QStringLiteral("*.tgc"),
-    QStringLiteral("*.ciso"), QStringLiteral("*.gcz"), QStringLiteral("*.wbfs"),
-    QStringLiteral("*.wad"),  QStringLiteral("*.elf"), QStringLiteral("*.dol")};
+    QStringLiteral("*.ciso"), QStringLiteral("*.gcz"), QStringLiteral("*.dci"),
+    QStringLiteral("*.wbfs"), QStringLiteral("*.wad"), QStringLiteral("*.elf"),
+    QStringLiteral("*.dol")};
 
 GameTracker::GameTracker(QObject* parent) : QFileSystemWatcher(parent)
 {
@@ -25,7 +26,21 @@ GameTracker::GameTracker(QObject* parent) : QFileSystemWatcher(parent)
 
   cache.Load();
 
-  m_load_thread.Reset([this](const QString& path) { LoadGame(path); });
+  for (auto& load_thread : m_load_threads)
+  {
+    load_thread.Reset([this](const QString& path) {
+      LoadGame(path);
+      if (--m_pending_loads == 0 && m_cache_changed.exchange(false))
+        cache.Save();
+    });
+  }
+}
+
+void GameTracker::QueueLoad(const QString& path)
+{
+  ++m_pending_loads;
+  m_load_threads[m_next_load_thread].EmplaceItem(path);
+  m_next_load_thread = (m_next_load_thread + 1) % m_load_threads.size();
 }
 
 void GameTracker::AddDirectory(const QString& dir)
@@ -58,10 +73,19 @@ void GameTracker::RemoveDirectory(const QString& dir)
 
 void GameTracker::UpdateDirectory(const QString& dir)
 {
+  // Every file tracked for this directory, minus those still in it
+  QSet<QString> missing_files;
+  for (auto it = m_tracked_files.cbegin(); it != m_tracked_files.cend(); ++it)
+  {
+    if (it.value().contains(dir))
+      missing_files.insert(it.key());
+  }
+
   QDirIterator it(dir, game_filters, QDir::NoFilter, QDirIterator::Subdirectories);
   while (it.hasNext())
   {
     QString path = QFileInfo(it.next()).canonicalFilePath();
+    missing_files.remove(path);
 
     if (m_tracked_files.contains(path))
     {
@@ -73,11 +97,11 @@ void GameTracker::UpdateDirectory(const QString& dir)
     {
       addPath(path);
       m_tracked_files[path] = QSet<QString>{dir};
-      m_load_thread.EmplaceItem(path);
+      QueueLoad(path);
     }
   }
 
-  for (const auto& missing : FindMissingFiles(dir))
+  for (const auto& missing : missing_files)
   {
     auto& tracked_file = m_tracked_files[missing];
 
@@ -90,28 +114,6 @@ void GameTracker::UpdateDirectory(const QString& dir)
   }
 }
 
-QSet<QString> GameTracker::FindMissingFiles(const QString& dir)
-{
-  QDirIterator it(dir, game_filters, QDir::NoFilter, QDirIterator::Subdirectories);
-
-  QSet<QString> missing_files;
-
-  for (const auto& key : m_tracked_files.keys())
-  {
-    if (m_tracked_files[key].contains(dir))
-      missing_files.insert(key);
-  }
-
-  while (it.hasNext())
-  {
-    QString path = QFileInfo(it.next()).canonicalFilePath();
-    if (m_tracked_files.contains(path))
-      missing_files.remove(path);
-  }
-
-  return missing_files;
-}
-
 void GameTracker::UpdateFile(const QString& file)
 {
   if (QFileInfo(file).exists())
@@ -119,7 +121,7 @@ void GameTracker::UpdateFile(const QString& file)
     GameRemoved(file);
     addPath(file);
 
-    m_load_thread.EmplaceItem(file);
+    QueueLoad(file);
   }
   else if (removePath(file))
   {
@@ -134,9 +136,10 @@ void GameTracker::LoadGame(const QString& path)
   {
     if (cache.IsCached(path))
     {
-      const QDateTime last_modified = QFileInfo(path).lastModified();
+      const QFileInfo info(path);
       auto cached_file = cache.GetFile(path);
-      if (cached_file.GetLastModified() >= last_modified)
+      if (cached_file.GetLastModified() >= info.lastModified() &&
+          cached_file.GetFileSize() == info.size())
       {
         emit GameLoaded(QSharedPointer<GameFile>::create(cached_file));
         return;
@@ -148,7 +151,7 @@ void GameTracker::LoadGame(const QString& path)
     {
       emit GameLoaded(game);
       cache.Update(*game);
-      cache.Save();
+      m_cache_changed = true;
     }
   }
 }
@@ -10,6 +10,10 @@
 #include <QSharedPointer>
 #include <QString>
 
+#include <array>
+#include <atomic>
+#include <cstddef>
+
 #include "Common/WorkQueueThread.h"
 #include "DolphinQt2/GameList/GameFile.h"
 #include "DolphinQt2/GameList/GameFileCache.h"
@@ -32,15 +36,22 @@ signals:
   void GameRemoved(const QString& path);
 
 private:
+  void QueueLoad(const QString& path);
   void LoadGame(const QString& path);
   void UpdateDirectory(const QString& dir);
   void UpdateFile(const QString& path);
-  QSet<QString> FindMissingFiles(const QString& dir);
+
+  // Opening a volume for its metadata mostly waits for the disk, so a few can be read at once.
+  static constexpr size_t NUM_LOAD_THREADS = 4;
 
   // game path -> directories that track it
   QMap<QString, QSet<QString>> m_tracked_files;
-  Common::WorkQueueThread<QString> m_load_thread;
   GameFileCache cache;
+  // The cache is saved once all the queued games are loaded, not after each of them.
+  std::atomic<int> m_pending_loads{0};
+  std::atomic<bool> m_cache_changed{false};
+  std::array<Common::WorkQueueThread<QString>, NUM_LOAD_THREADS> m_load_threads;
+  size_t m_next_load_thread = 0;
 };
 
 Q_DECLARE_METATYPE(QSharedPointer<GameFile>)
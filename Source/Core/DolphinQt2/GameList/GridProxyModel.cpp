@@ -25,6 +25,12 @@ QVariant GridProxyModel::data(const QModelIndex& i, int role) const
   }
   else if (role == Qt::DecorationRole)
   {
+    GameListModel* glm = qobject_cast<GameListModel*>(sourceModel());
+    QPixmap banner = glm->GetGameFile(source_index.row())->GetGridBanner();
+    if (!banner.isNull())
+      return banner;
+
+    // Games without a banner show a placeholder, which isn't pre-scaled.
     auto pixmap = sourceModel()
                       ->data(sourceModel()->index(source_index.row(), GameListModel::COL_BANNER),
                              Qt::DecorationRole)
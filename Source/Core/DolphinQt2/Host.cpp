@@ -8,6 +8,7 @@
 #include "Common/Common.h"
 #include "Core/Host.h"
 #include "DolphinQt2/Host.h"
+#include "VideoCommon/RenderBase.h"
 
 Host::Host() = default;
 
@@ -24,7 +25,8 @@ void* Host::GetRenderHandle()
 
 void Host::SetRenderHandle(void* handle)
 {
-  m_render_handle = handle;
+  if (m_render_handle.exchange(handle) != handle && g_renderer)
+    g_renderer->ChangeSurface(handle);
 }
 
 bool Host::GetRenderFocus()
@@ -47,6 +49,12 @@ void Host::SetRenderFullscreen(bool fullscreen)
   m_render_fullscreen = fullscreen;
 }
 
+void Host::ResizeSurface()
+{
+  if (g_renderer)
+    g_renderer->ResizeSurface();
+}
+
 void Host_Message(int id)
 {
   if (id == WM_USER_STOP)
@@ -10,6 +10,8 @@
 // Singleton that talks to the Core via the interface defined in Core/Host.h.
 // Because Host_* calls might come from different threads than the MainWindow,
 // the Host class communicates with it via signals/slots only.
+// The render surface belongs to the GPU thread: the render widget's handle, size, focus and
+// fullscreen state are handed to it through atomics and flags, so the UI never waits for it.
 
 // Many of the Host_* functions are ignored, and some shouldn't exist.
 class Host final : public QObject
@@ -26,6 +28,7 @@ public:
   void SetRenderHandle(void* handle);
   void SetRenderFocus(bool focus);
   void SetRenderFullscreen(bool fullscreen);
+  void ResizeSurface();
 
 signals:
   void RequestTitle(const QString& title);
@@ -35,7 +38,7 @@ signals:
 private:
   Host();
 
-  std::atomic<void*> m_render_handle;
-  std::atomic<bool> m_render_focus;
-  std::atomic<bool> m_render_fullscreen;
+  std::atomic<void*> m_render_handle{nullptr};
+  std::atomic<bool> m_render_focus{false};
+  std::atomic<bool> m_render_fullscreen{false};
 };
@@ -156,6 +156,10 @@ void HotkeyScheduler::Run()
       if (IsHotkey(HK_SCREENSHOT))
         emit ScreenShotHotkey();
 
+      // Event trace
+      if (IsHotkey(HK_TOGGLE_EVENT_TRACE))
+        Core::ToggleEventTrace();
+
       // Exit
       if (IsHotkey(HK_EXIT))
         emit ExitHotkey();
@@ -370,5 +374,8 @@ void HotkeyScheduler::Run()
 
     if (IsHotkey(HK_UNDO_SAVE_STATE))
       State::UndoSaveState();
+
+    if (IsHotkey(HK_REWIND))
+      State::Rewind();
   }
 }
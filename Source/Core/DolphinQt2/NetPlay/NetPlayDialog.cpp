@@ -59,6 +59,7 @@ void NetPlayDialog::CreateMainLayout()
   m_main_layout = new QGridLayout;
   m_game_button = new QPushButton;
   m_md5_box = new QComboBox;
+  m_fast_hash_box = new QCheckBox(tr("Fast hash"));
   m_start_button = new QPushButton(tr("Start"));
   m_buffer_size_box = new QSpinBox;
   m_save_sd_box = new QCheckBox(tr("Write save/SD data"));
@@ -74,8 +75,16 @@ void NetPlayDialog::CreateMainLayout()
        {tr("MD5 Check:"), tr("Current game"), tr("Other game"), tr("SD card")})
     m_md5_box->addItem(text);
 
+  m_fast_hash_box->setToolTip(
+      tr("Compares a hash which is computed on several threads instead of MD5. This is much "
+         "faster, but the result can't be compared with MD5 checksums of other sources."));
+
+  auto* md5_layout = new QHBoxLayout;
+  md5_layout->addWidget(m_md5_box);
+  md5_layout->addWidget(m_fast_hash_box);
+
   m_main_layout->addWidget(m_game_button, 0, 0);
-  m_main_layout->addWidget(m_md5_box, 0, 1);
+  m_main_layout->addLayout(md5_layout, 0, 1);
   m_main_layout->addWidget(m_chat_box, 1, 0);
   m_main_layout->addWidget(m_players_box, 1, 1);
 
@@ -272,7 +281,9 @@ void NetPlayDialog::OnMD5Combo(int index)
     break;
   }
 
-  Settings::Instance().GetNetPlayServer()->ComputeMD5(identifier);
+  Settings::Instance().GetNetPlayServer()->ComputeMD5(
+      identifier, m_fast_hash_box->isChecked() ? MD5::HashFunction::XXH64Tree :
+                                                 MD5::HashFunction::MD5);
 }
 
 void NetPlayDialog::reject()
@@ -312,6 +323,7 @@ void NetPlayDialog::show(std::string nickname, bool use_traversal)
   m_kick_button->setHidden(!is_hosting);
   m_assign_ports_button->setHidden(!is_hosting);
   m_md5_box->setHidden(!is_hosting);
+  m_fast_hash_box->setHidden(!is_hosting);
   m_room_box->setHidden(!is_hosting);
   m_hostcode_label->setHidden(!is_hosting);
   m_hostcode_action_button->setHidden(!is_hosting);
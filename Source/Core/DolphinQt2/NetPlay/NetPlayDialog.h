@@ -90,6 +90,7 @@ private:
   // Other
   QPushButton* m_game_button;
   QComboBox* m_md5_box;
+  QCheckBox* m_fast_hash_box;
   QPushButton* m_start_button;
   QLabel* m_buffer_label;
   QSpinBox* m_buffer_size_box;
@@ -63,6 +63,9 @@ bool RenderWidget::event(QEvent* event)
   case QEvent::WinIdChange:
     emit HandleChanged((void*)winId());
     break;
+  case QEvent::Resize:
+    Host::GetInstance()->ResizeSurface();
+    break;
   case QEvent::WindowActivate:
     Host::GetInstance()->SetRenderFocus(true);
     break;
@@ -71,6 +71,7 @@ void AudioPane::CreateWidgets()
   m_backend_label = new QLabel(tr("Audio Backend:"));
   m_backend_combo = new QComboBox();
   m_dolby_pro_logic = new QCheckBox(tr("Dolby Pro Logic II Decoder"));
+  m_low_latency = new QCheckBox(tr("Low Latency Mode"));
 
   if (m_latency_control_supported)
   {
@@ -84,11 +85,14 @@ void AudioPane::CreateWidgets()
 
   m_dolby_pro_logic->setToolTip(
       tr("Enables Dolby Pro Logic II emulation using 5.1 surround. Certain backends only."));
+  m_low_latency->setToolTip(tr("Keeps the audio buffering as low as the emulation speed allows, "
+                               "and stretches the audio only when the emulation slows down."));
 
   backend_layout->addRow(m_backend_label, m_backend_combo);
   if (m_latency_control_supported)
     backend_layout->addRow(m_latency_label, m_latency_spin);
   backend_layout->addRow(m_dolby_pro_logic);
+  backend_layout->addRow(m_low_latency);
 
   auto* stretching_box = new QGroupBox(tr("Audio Stretching Settings"));
   auto* stretching_layout = new QGridLayout;
@@ -134,6 +138,7 @@ void AudioPane::ConnectWidgets()
   }
   connect(m_stretching_buffer_slider, &QSlider::valueChanged, this, &AudioPane::SaveSettings);
   connect(m_dolby_pro_logic, &QCheckBox::toggled, this, &AudioPane::SaveSettings);
+  connect(m_low_latency, &QCheckBox::toggled, this, &AudioPane::SaveSettings);
   connect(m_stretching_enable, &QCheckBox::toggled, this, &AudioPane::SaveSettings);
   connect(m_dsp_hle, &QRadioButton::toggled, this, &AudioPane::SaveSettings);
   connect(m_dsp_lle, &QRadioButton::toggled, this, &AudioPane::SaveSettings);
@@ -171,6 +176,7 @@ void AudioPane::LoadSettings()
 
   // DPL2
   m_dolby_pro_logic->setChecked(SConfig::GetInstance().bDPL2Decoder);
+  m_low_latency->setChecked(SConfig::GetInstance().m_audio_low_latency);
 
   // Latency
   if (m_latency_control_supported)
@@ -211,6 +217,7 @@ void AudioPane::SaveSettings()
 
   // DPL2
   SConfig::GetInstance().bDPL2Decoder = m_dolby_pro_logic->isChecked();
+  SConfig::GetInstance().m_audio_low_latency = m_low_latency->isChecked();
 
   // Latency
   if (m_latency_control_supported)
@@ -248,6 +255,7 @@ void AudioPane::OnEmulationStateChanged(bool running)
   m_dsp_lle->setEnabled(!running);
   m_dsp_interpreter->setEnabled(!running);
   m_dolby_pro_logic->setEnabled(!running);
+  m_low_latency->setEnabled(!running);
   m_backend_label->setEnabled(!running);
   m_backend_combo->setEnabled(!running);
   if (m_latency_control_supported)
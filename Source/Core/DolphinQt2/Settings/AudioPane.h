@@ -50,6 +50,7 @@ private:
   QLabel* m_backend_label;
   QComboBox* m_backend_combo;
   QCheckBox* m_dolby_pro_logic;
+  QCheckBox* m_low_latency;
   QLabel* m_latency_label;
   QSpinBox* m_latency_spin;
 
@@ -40,6 +40,7 @@ void AudioConfigPane::InitializeGUI()
       new wxRadioBox(this, wxID_ANY, _("DSP Emulation Engine"), wxDefaultPosition, wxDefaultSize,
                      m_dsp_engine_strings, 0, wxRA_SPECIFY_ROWS);
   m_dpl2_decoder_checkbox = new wxCheckBox(this, wxID_ANY, _("Dolby Pro Logic II Decoder"));
+  m_low_latency_checkbox = new wxCheckBox(this, wxID_ANY, _("Low Latency Mode"));
   m_volume_slider = new DolphinSlider(this, wxID_ANY, 0, 0, 100, wxDefaultPosition, wxDefaultSize,
                                       wxSL_VERTICAL | wxSL_INVERSE);
   m_volume_text = new wxStaticText(this, wxID_ANY, "");
@@ -66,6 +67,9 @@ void AudioConfigPane::InitializeGUI()
   }
   m_dpl2_decoder_checkbox->SetToolTip(
       _("Enables Dolby Pro Logic II emulation using 5.1 surround. Certain backends only."));
+  m_low_latency_checkbox->SetToolTip(
+      _("Keeps the audio buffering as low as the emulation speed allows, "
+        "and stretches the audio only when the emulation slows down."));
   m_stretch_checkbox->SetToolTip(_("Enables stretching of the audio to match emulation speed."));
   m_stretch_slider->SetToolTip(_("Size of stretch buffer in milliseconds. "
                                  "Values too low may cause audio crackling."));
@@ -91,6 +95,8 @@ void AudioConfigPane::InitializeGUI()
     backend_grid_sizer->Add(m_audio_latency_spinctrl, wxGBPosition(2, 1), wxDefaultSpan,
                             wxALIGN_CENTER_VERTICAL);
   }
+  backend_grid_sizer->Add(m_low_latency_checkbox, wxGBPosition(3, 0), wxGBSpan(1, 2),
+                          wxALIGN_CENTER_VERTICAL);
 
   wxStaticBoxSizer* const backend_static_box_sizer =
       new wxStaticBoxSizer(wxVERTICAL, this, _("Backend Settings"));
@@ -150,6 +156,7 @@ void AudioConfigPane::LoadGUIValues()
   m_volume_slider->SetValue(SConfig::GetInstance().m_Volume);
   m_volume_text->SetLabel(wxString::Format("%d %%", SConfig::GetInstance().m_Volume));
   m_dpl2_decoder_checkbox->SetValue(startup_params.bDPL2Decoder);
+  m_low_latency_checkbox->SetValue(startup_params.m_audio_low_latency);
   if (m_latency_control_supported)
   {
     m_audio_latency_spinctrl->SetValue(startup_params.iLatency);
@@ -187,6 +194,10 @@ void AudioConfigPane::BindEvents()
                                 this);
   m_dpl2_decoder_checkbox->Bind(wxEVT_UPDATE_UI, &WxEventUtils::OnEnableIfCoreNotRunning);
 
+  m_low_latency_checkbox->Bind(wxEVT_CHECKBOX, &AudioConfigPane::OnLowLatencyCheckBoxChanged,
+                               this);
+  m_low_latency_checkbox->Bind(wxEVT_UPDATE_UI, &WxEventUtils::OnEnableIfCoreNotRunning);
+
   m_volume_slider->Bind(wxEVT_SLIDER, &AudioConfigPane::OnVolumeSliderChanged, this);
 
   m_audio_backend_choice->Bind(wxEVT_CHOICE, &AudioConfigPane::OnAudioBackendChanged, this);
@@ -215,6 +226,11 @@ void AudioConfigPane::OnDPL2DecoderCheckBoxChanged(wxCommandEvent&)
   SConfig::GetInstance().bDPL2Decoder = m_dpl2_decoder_checkbox->IsChecked();
 }
 
+void AudioConfigPane::OnLowLatencyCheckBoxChanged(wxCommandEvent&)
+{
+  SConfig::GetInstance().m_audio_low_latency = m_low_latency_checkbox->IsChecked();
+}
+
 void AudioConfigPane::OnVolumeSliderChanged(wxCommandEvent& event)
 {
   SConfig::GetInstance().m_Volume = m_volume_slider->GetValue();
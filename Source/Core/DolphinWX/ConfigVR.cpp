@@ -180,6 +180,11 @@ static wxString overdrive_desc =
 static wxString hqdistortion_desc =
     wxTRANSLATE("\"High-quality sampling of distortion buffer for anti-aliasing\".\n\nIf unsure, "
                 "leave this unchecked.");
+static wxString foveation_desc =
+    wxTRANSLATE("Shades the edges of each eye at a lower resolution than the centre, which the "
+                "lenses blur anyway. High lowers the resolution closer to the centre.\nNeeds an "
+                "NVIDIA GPU with variable rate shading and the OpenGL backend.\n\nIf unsure, "
+                "select Off.");
 static wxString hudontop_desc =
     wxTRANSLATE("Always draw the HUD on top of everything else.\nUse this when you can't see the "
                 "HUD because the world is covering it up.\n\nIf unsure, leave this unchecked.");
@@ -498,6 +503,16 @@ void CConfigVR::CreateGUIControls()
                        sizeof(mirror_choices) / sizeof(*mirror_choices), mirror_choices);
       szr_vr->Add(choice_style, 1, 0, 0);
       choice_style->Select(vconfig.iMirrorStyle);
+
+      const wxString foveation_choices[] = {wxTRANSLATE("Off"), wxTRANSLATE("Low"),
+                                            wxTRANSLATE("High")};
+      szr_vr->Add(new wxStaticText(page_vr, wxID_ANY, wxTRANSLATE("Foveated Rendering:")), 1,
+                  wxALIGN_CENTER_VERTICAL, 0);
+      wxChoice* const choice_foveation =
+          CreateChoice(page_vr, Config::GLOBAL_VR_FOVEATION, wxGetTranslation(foveation_desc),
+                       sizeof(foveation_choices) / sizeof(*foveation_choices), foveation_choices);
+      szr_vr->Add(choice_foveation, 1, 0, 0);
+      choice_foveation->Select(vconfig.iFoveation);
     }
     {
       // szr_vr->Add(CreateCheckBox(page_vr, wxTRANSLATE("Enable VR"),
@@ -136,6 +136,20 @@ void CCodeWindow::OnProfilerMenu(wxCommandEvent& event)
     Profiler::g_ProfileBlocks = GetParentMenuBar()->IsChecked(IDM_PROFILE_BLOCKS);
     Core::SetState(Core::State::Running);
     break;
+  case IDM_SAMPLE_CPU_THREAD:
+    if (GetParentMenuBar()->IsChecked(IDM_SAMPLE_CPU_THREAD))
+    {
+      if (!Profiler::StartSampling())
+        GetParentMenuBar()->Check(IDM_SAMPLE_CPU_THREAD, false);
+    }
+    else
+    {
+      std::string filename = File::GetUserPath(D_DUMP_IDX) + "Debug/samples.perf";
+      File::CreateFullPath(filename);
+      if (Profiler::StopSampling(filename))
+        Core::DisplayMessage("CPU thread samples saved to " + filename, 4000);
+    }
+    break;
   case IDM_WRITE_PROFILE:
     if (Core::GetState() == Core::State::Running)
       Core::SetState(Core::State::Paused);
@@ -261,6 +261,7 @@ EVT_MENU(IDM_DEBUGGER, CFrame::OnDebugger)
 EVT_MENU(IDM_BRUTEFORCE0, CFrame::OnBruteForce)
 EVT_MENU(IDM_BRUTEFORCE1, CFrame::OnBruteForce)
 EVT_MENU(IDM_BRUTEFORCE_ALL, CFrame::OnBruteForce)
+EVT_MENU(IDM_BRUTEFORCE_HASH, CFrame::OnBruteForce)
 
 // Other
 EVT_ACTIVATE(CFrame::OnActive)
@@ -1386,6 +1387,8 @@ void CFrame::ParseHotkeys()
   // Screenshot hotkey
   if (IsHotkey(HK_SCREENSHOT))
     Core::SaveScreenShot();
+  if (IsHotkey(HK_TOGGLE_EVENT_TRACE))
+    Core::ToggleEventTrace();
   if (ShouldQuit || IsHotkey(HK_EXIT))
     wxPostEvent(this, wxCommandEvent(wxEVT_MENU, wxID_EXIT));
   if (IsHotkey(HK_VOLUME_DOWN))
@@ -2009,6 +2012,8 @@ void CFrame::ParseHotkeys()
     State::UndoLoadState();
   if (IsHotkey(HK_UNDO_SAVE_STATE))
     State::UndoSaveState();
+  if (IsHotkey(HK_REWIND))
+    State::Rewind();
 }
 
 void CFrame::HandleFrameSkipHotkeys()
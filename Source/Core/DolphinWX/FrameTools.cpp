@@ -628,11 +628,10 @@ void CFrame::OnRenderParentResize(wxSizeEvent& event)
     m_log_window->Refresh();
     m_log_window->Update();
 
-    // We call Renderer::ChangeSurface here to indicate the size has changed,
-    // but pass the same window handle. This is needed for the Vulkan backend,
-    // otherwise it cannot tell that the window has been resized on some drivers.
+    // This is needed for the Vulkan backend, otherwise it cannot tell that the window has been
+    // resized on some drivers.
     if (g_renderer)
-      g_renderer->ChangeSurface(GetRenderHandle());
+      g_renderer->ResizeSurface();
   }
   event.Skip();
 }
@@ -1737,6 +1736,14 @@ void CFrame::OnBruteForce(wxCommandEvent& event)
 
     return;
   }
+  if (event.GetId() == IDM_BRUTEFORCE_HASH)
+  {
+    SConfig::GetInstance().m_BruteforceHashOnly = !SConfig::GetInstance().m_BruteforceHashOnly;
+    ARBruteForcer::ch_hash_only = SConfig::GetInstance().m_BruteforceHashOnly;
+    SConfig::GetInstance().SaveSettings();
+
+    return;
+  }
   if (ARBruteForcer::ch_bruteforce)
     return;
   NOTICE_LOG(VR, "OnBruteForce");
@@ -130,6 +130,7 @@ enum
   IDM_BRUTEFORCE0,
   IDM_BRUTEFORCE1,
   IDM_BRUTEFORCE_ALL,
+  IDM_BRUTEFORCE_HASH,
   IDM_CONNECT_WIIMOTE1,
   IDM_CONNECT_WIIMOTE2,
   IDM_CONNECT_WIIMOTE3,
@@ -270,6 +271,7 @@ enum
 
   // Profiler
   IDM_PROFILE_BLOCKS,
+  IDM_SAMPLE_CPU_THREAD,
   IDM_WRITE_PROFILE,
   // --------------------------------------------------------------
 
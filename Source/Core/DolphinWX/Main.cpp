@@ -220,6 +220,21 @@ void DolphinApp::ParseCommandLine()
       PanicAlert("Valid option not specified in -bruteforce command.\nPlease use only a single hex "
                  "digit: e.g. -bruteforce 1");
     }
+    if (options.is_set("bruteforce-slice"))
+    {
+      const std::string slice = static_cast<const char*>(options.get("bruteforce-slice"));
+      int k, n;
+      if (sscanf(slice.c_str(), "%d/%d", &k, &n) == 2 && n >= 1 && k >= 1 && k <= n)
+      {
+        ARBruteForcer::ch_slice = k - 1;
+        ARBruteForcer::ch_slice_count = n;
+      }
+      else
+      {
+        PanicAlert("Valid option not specified in -bruteforce-slice command.\nPlease use the "
+                   "instance number and the number of instances: e.g. -bruteforce-slice 1/4");
+      }
+    }
   }
 
   m_confirm_stop = options.is_set("confirm");
@@ -319,20 +334,8 @@ void DolphinApp::AfterInit()
 
   if (ARBruteForcer::ch_bruteforce)
   {
-    std::string line;
-    std::ifstream myfile(File::GetUserPath(D_SCREENSHOTS_IDX) + "position.txt");
-    std::string aux;
-
-    if (myfile.is_open())
-    {
-      while (getline(myfile, line))
-      {
-        aux = line;
-      }
-      myfile.close();
-    }
-
-    if (atoi(aux.c_str()) != -1)
+    if (!File::Exists(ARBruteForcer::GetPositionPath()) ||
+        ARBruteForcer::LoadLastPosition() != -1)
     {
       main_frame->BootGame("");
     }
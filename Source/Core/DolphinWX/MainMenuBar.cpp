@@ -275,9 +275,11 @@ wxMenu* MainMenuBar::CreateToolsMenu() const
   bruteforceMenu->AppendCheckItem(IDM_BRUTEFORCE1, _("return 1"));
   bruteforceMenu->AppendSeparator();
   bruteforceMenu->AppendCheckItem(IDM_BRUTEFORCE_ALL, _("Screenshot All"));
+  bruteforceMenu->AppendCheckItem(IDM_BRUTEFORCE_HASH, _("Hash Frames Instead of Screenshots"));
   bruteforceMenu->Enable(IDM_BRUTEFORCE0, !ARBruteForcer::ch_bruteforce);
   bruteforceMenu->Enable(IDM_BRUTEFORCE1, !ARBruteForcer::ch_bruteforce);
   bruteforceMenu->Check(IDM_BRUTEFORCE_ALL, SConfig::GetInstance().m_BruteforceScreenshotAll);
+  bruteforceMenu->Check(IDM_BRUTEFORCE_HASH, SConfig::GetInstance().m_BruteforceHashOnly);
 
   tools_menu->AppendSeparator();
   tools_menu->AppendSubMenu(wiimote_menu, _("Connect Wii Remotes"));
@@ -539,6 +541,7 @@ wxMenu* MainMenuBar::CreateProfilerMenu() const
   auto* const profiler_menu = new wxMenu;
   // i18n: "Profile" is used as a verb, not a noun.
   profiler_menu->AppendCheckItem(IDM_PROFILE_BLOCKS, _("&Profile Blocks"));
+  profiler_menu->AppendCheckItem(IDM_SAMPLE_CPU_THREAD, _("&Sample CPU Thread"));
   profiler_menu->AppendSeparator();
   profiler_menu->Append(IDM_WRITE_PROFILE, _("&Write to profile.txt, Show"));
 
@@ -135,7 +135,13 @@ wxSizer* NetPlayDialog::CreateTopGUI(wxWindow* parent)
     m_MD5_choice->Append(_("SD card"));
     m_MD5_choice->SetSelection(0);
 
+    m_fast_hash_checkbox = new wxCheckBox(parent, wxID_ANY, _("Fast hash"));
+    m_fast_hash_checkbox->SetToolTip(
+        _("Compares a hash which is computed on several threads instead of MD5. This is much "
+          "faster, but the result can't be compared with MD5 checksums of other sources."));
+
     top_szr->Add(m_MD5_choice, 0, wxALIGN_CENTER_VERTICAL);
+    top_szr->Add(m_fast_hash_checkbox, 0, wxALIGN_CENTER_VERTICAL | wxLEFT, FromDIP(5));
   }
 
   return top_szr;
@@ -675,7 +681,9 @@ void NetPlayDialog::OnMD5ComputeRequested(wxCommandEvent&)
     return;
   }
 
-  netplay_server->ComputeMD5(file_identifier);
+  netplay_server->ComputeMD5(file_identifier, m_fast_hash_checkbox->IsChecked() ?
+                                                  MD5::HashFunction::XXH64Tree :
+                                                  MD5::HashFunction::MD5);
 }
 
 void NetPlayDialog::ShowMD5Dialog(const std::string& file_identifier)
@@ -153,6 +153,7 @@ private:
   wxChoice* m_host_type_choice;
   wxButton* m_host_copy_btn;
   wxChoice* m_MD5_choice = nullptr;
+  wxCheckBox* m_fast_hash_checkbox = nullptr;
   MD5Dialog* m_MD5_dialog = nullptr;
   bool m_host_copy_btn_is_retry;
   bool m_is_hosting;
@@ -186,6 +186,11 @@ static wxString pixel_lighting_desc = wxTRANSLATE(
     "Calculates lighting of 3D objects per-pixel rather than per-vertex, smoothing out the "
     "appearance of lit polygons and making individual triangles less noticeable.\nRarely causes "
     "slowdowns or graphical issues.\n\nIf unsure, leave this unchecked.");
+static wxString dynamic_resolution_desc = wxTRANSLATE(
+    "Lowers the internal resolution while the GPU takes longer than the refresh rate allows for "
+    "a frame, and raises it again once it catches up. Needs a backend which can time frames on "
+    "the GPU (OpenGL or Vulkan).\nThe resolution can drop to half of the selected one.\n\nIf "
+    "unsure, leave this unchecked.");
 static wxString fast_depth_calc_desc =
     wxTRANSLATE("Use a less accurate algorithm to calculate depth values.\nCauses issues in a few "
                 "games, but can give a decent speedup depending on the game and/or your GPU.\n\nIf "
@@ -261,6 +266,14 @@ static wxString log_render_time_to_file_desc =
                 "unsure, leave this unchecked.");
 static wxString show_stats_desc =
     wxTRANSLATE("Show various rendering statistics.\n\nIf unsure, leave this unchecked.");
+static wxString frame_profile_desc =
+    wxTRANSLATE("Show where the time of each frame went on the video threads. Turning this off "
+                "saves the recorded frames to User/Dump/ as a Chrome trace.\n\nIf unsure, leave "
+                "this unchecked.");
+static wxString metrics_desc =
+    wxTRANSLATE("Show the counters the emulator keeps for monitoring, such as draw calls, shader "
+                "compiles and audio underruns, with their change over the last frame.\n\nIf "
+                "unsure, leave this unchecked.");
 static wxString show_netplay_messages_desc =
     wxTRANSLATE("When playing on NetPlay, show chat messages, buffer changes and "
                 "desync alerts.\n\nIf unsure, leave this unchecked.");
@@ -278,6 +291,11 @@ static wxString xfb_real_desc =
     wxTRANSLATE("Emulate XFBs accurately.\nSlows down emulation a lot and prohibits "
                 "high-resolution rendering but is necessary to emulate a number of games "
                 "properly.\n\nIf unsure, check virtual XFB emulation instead.");
+static wxString xfb_to_texture_desc = wxTRANSLATE(
+    "Keeps real XFB copies on the GPU at the internal resolution instead of reading them back to "
+    "RAM, and presents them directly. The XFB is only read from RAM after the CPU has written to "
+    "it.\nGreatly speeds up real XFB emulation, but breaks games which read the XFB back.\n\nIf "
+    "unsure, leave this unchecked.");
 static wxString dump_textures_desc =
     wxTRANSLATE("Dump decoded game textures to User/Dump/Textures/<game_id>/.\n\nIf unsure, leave "
                 "this unchecked.");
@@ -738,6 +756,9 @@ VideoConfigDiag::VideoConfigDiag(wxWindow* parent, const std::string& title)
                                Config::GFX_DISABLE_FOG));
     cb_szr->Add(CreateCheckBox(page_enh, _("Force 24-Bit Color"), wxGetTranslation(true_color_desc),
                                Config::GFX_ENHANCE_FORCE_TRUE_COLOR));
+    cb_szr->Add(CreateCheckBox(page_enh, _("Dynamic Resolution"),
+                               wxGetTranslation(dynamic_resolution_desc),
+                               Config::GFX_DYNAMIC_RESOLUTION));
     szr_enh->Add(cb_szr, wxGBPosition(row, 0), wxGBSpan(1, 3));
     row += 1;
 
@@ -949,8 +970,14 @@ VideoConfigDiag::VideoConfigDiag(wxWindow* parent, const std::string& title)
       szr->Add(virtual_xfb, 0, wxALIGN_CENTER_VERTICAL | wxLEFT, space5);
       szr->Add(real_xfb, 0, wxALIGN_CENTER_VERTICAL | wxLEFT, space5);
 
+      xfb_to_texture = CreateCheckBox(page_hacks, _("Store XFB Copies to Texture Only"),
+                                      wxGetTranslation(xfb_to_texture_desc),
+                                      Config::GFX_HACK_SKIP_XFB_COPY_TO_RAM);
+
       group_xfb->Add(szr, 1, wxEXPAND | wxLEFT | wxRIGHT, space5);
       group_xfb->AddSpacer(space5);
+      group_xfb->Add(xfb_to_texture, 0, wxLEFT | wxRIGHT, space5);
+      group_xfb->AddSpacer(space5);
 
       szr_hacks->AddSpacer(space5);
       szr_hacks->Add(group_xfb, 0, wxEXPAND | wxLEFT | wxRIGHT, space5);
@@ -1006,6 +1033,11 @@ VideoConfigDiag::VideoConfigDiag(wxWindow* parent, const std::string& title)
       szr_debug->Add(CreateCheckBox(page_advanced, _("Enable API Validation Layers"),
                                     wxGetTranslation(validation_layer_desc),
                                     Config::GFX_ENABLE_VALIDATION_LAYER));
+      szr_debug->Add(CreateCheckBox(page_advanced, _("Show Frame Profile"),
+                                    wxGetTranslation(frame_profile_desc),
+                                    Config::GFX_OVERLAY_FRAME_PROFILE));
+      szr_debug->Add(CreateCheckBox(page_advanced, _("Show Metrics"),
+                                    wxGetTranslation(metrics_desc), Config::GFX_OVERLAY_METRICS));
 
       wxStaticBoxSizer* const group_debug =
           new wxStaticBoxSizer(wxVERTICAL, page_advanced, _("Debugging"));
@@ -1262,6 +1294,7 @@ void VideoConfigDiag::OnUpdateUI(wxUpdateUIEvent& ev)
   // XFB
   virtual_xfb->Enable(vconfig.bUseXFB);
   real_xfb->Enable(vconfig.bUseXFB);
+  xfb_to_texture->Enable(vconfig.RealXFBEnabled());
 
   // custom textures
   cache_hires_textures->Enable(vconfig.bHiresTextures);
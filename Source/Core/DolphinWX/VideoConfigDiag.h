@@ -228,6 +228,7 @@ protected:
 
   SettingRadioButton* virtual_xfb;
   SettingRadioButton* real_xfb;
+  SettingCheckBox* xfb_to_texture;
 
   SettingCheckBox* cache_hires_textures;
 
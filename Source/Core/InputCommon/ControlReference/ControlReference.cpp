@@ -32,7 +32,11 @@ void ControlReference::UpdateReference(const ciface::Core::DeviceContainer& devi
 {
   ControlFinder finder(devices, default_device, IsInput());
   if (m_parsed_expression)
+  {
     m_parsed_expression->UpdateReferences(finder);
+    if (IsInput())
+      m_compiled_expression = CompiledExpression(*m_parsed_expression);
+  }
 }
 
 int ControlReference::BoundCount() const
@@ -57,6 +61,11 @@ void ControlReference::SetExpression(std::string expr)
 {
   m_expression = std::move(expr);
   std::tie(m_parse_status, m_parsed_expression) = ParseExpression(m_expression);
+  // nothing is bound until UpdateReference
+  if (m_parsed_expression && IsInput())
+    m_compiled_expression = CompiledExpression(*m_parsed_expression);
+  else
+    m_compiled_expression = CompiledExpression();
 }
 
 ControlReference::ControlReference() : range(1), m_parsed_expression(nullptr)
@@ -91,7 +100,7 @@ bool OutputReference::IsInput() const
 ControlState InputReference::State(const ControlState ignore)
 {
   if (m_parsed_expression && InputGateOn())
-    return m_parsed_expression->GetValue() * range;
+    return m_compiled_expression.GetValue() * range;
   return 0.0;
 }
 
@@ -138,7 +147,7 @@ ciface::Core::Device::Control* InputReference::Detect(const unsigned int ms,
 
   while (time < ms)
   {
-    device->UpdateInput();
+    device->Poll();
     i = device->Inputs().begin();
     for (std::vector<bool>::iterator state = states.begin(); i != e; ++i, ++state)
     {
@@ -229,6 +229,10 @@ public:
     m_device = finder.FindDevice(qualifier);
     control = finder.FindControl(qualifier);
   }
+  void Compile(std::vector<Instruction>* program) const override
+  {
+    program->push_back({Instruction::Op::Input, control ? control->ToInput() : nullptr});
+  }
   operator std::string() const override { return "`" + static_cast<std::string>(qualifier) + "`"; }
 };
 
@@ -282,6 +286,26 @@ public:
     rhs->UpdateReferences(finder);
   }
 
+  void Compile(std::vector<Instruction>* program) const override
+  {
+    lhs->Compile(program);
+    rhs->Compile(program);
+    switch (op)
+    {
+    case TOK_AND:
+      program->push_back({Instruction::Op::And, nullptr});
+      break;
+    case TOK_OR:
+      program->push_back({Instruction::Op::Or, nullptr});
+      break;
+    case TOK_ADD:
+      program->push_back({Instruction::Op::Add, nullptr});
+      break;
+    default:
+      assert(false);
+    }
+  }
+
   operator std::string() const override
   {
     return OpName(op) + "(" + (std::string)(*lhs) + ", " + (std::string)(*rhs) + ")";
@@ -326,6 +350,18 @@ public:
 
   int CountNumControls() const override { return inner->CountNumControls(); }
   void UpdateReferences(ControlFinder& finder) override { inner->UpdateReferences(finder); }
+  void Compile(std::vector<Instruction>* program) const override
+  {
+    inner->Compile(program);
+    switch (op)
+    {
+    case TOK_NOT:
+      program->push_back({Instruction::Op::Not, nullptr});
+      break;
+    default:
+      assert(false);
+    }
+  }
   operator std::string() const override { return OpName(op) + "(" + (std::string)(*inner) + ")"; }
 };
 
@@ -359,6 +395,12 @@ public:
     m_rhs->UpdateReferences(finder);
   }
 
+  // The active child only depends on the references
+  void Compile(std::vector<Instruction>* program) const override
+  {
+    GetActiveChild()->Compile(program);
+  }
+
 private:
   const std::unique_ptr<Expression>& GetActiveChild() const
   {
@@ -369,6 +411,65 @@ private:
   std::unique_ptr<Expression> m_rhs;
 };
 
+CompiledExpression::CompiledExpression(const Expression& expression)
+{
+  expression.Compile(&m_program);
+
+  size_t depth = 0;
+  for (const Instruction& instruction : m_program)
+  {
+    if (instruction.op == Instruction::Op::Input)
+      m_stack_size = std::max(m_stack_size, ++depth);
+    else if (instruction.op != Instruction::Op::Not)
+      --depth;
+  }
+}
+
+ControlState CompiledExpression::GetValue() const
+{
+  if (m_program.empty())
+    return 0.0;
+
+  // Expressions are rarely nested deeper than this, and this can be called from several threads
+  constexpr size_t INLINE_STACK_SIZE = 16;
+  ControlState inline_stack[INLINE_STACK_SIZE];
+  std::vector<ControlState> heap_stack;
+  ControlState* stack = inline_stack;
+  if (m_stack_size > INLINE_STACK_SIZE)
+  {
+    heap_stack.resize(m_stack_size);
+    stack = heap_stack.data();
+  }
+
+  ControlState* top = stack - 1;
+  for (const Instruction& instruction : m_program)
+  {
+    switch (instruction.op)
+    {
+    case Instruction::Op::Input:
+      *++top = instruction.input ? instruction.input->GetState() : 0.0;
+      break;
+    case Instruction::Op::Not:
+      *top = 1.0 - *top;
+      break;
+    case Instruction::Op::And:
+      top[-1] = std::min(top[-1], top[0]);
+      --top;
+      break;
+    case Instruction::Op::Or:
+      top[-1] = std::max(top[-1], top[0]);
+      --top;
+      break;
+    case Instruction::Op::Add:
+      top[-1] = std::min(top[-1] + top[0], 1.0);
+      --top;
+      break;
+    }
+  }
+
+  return *top;
+}
+
 std::shared_ptr<Device> ControlFinder::FindDevice(ControlQualifier qualifier) const
 {
   if (qualifier.has_device)
@@ -7,6 +7,7 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 #include "InputCommon/ControllerInterface/Device.h"
 
 namespace ciface
@@ -47,6 +48,22 @@ private:
   bool is_input;
 };
 
+// One step of an input expression in postfix order, see CompiledExpression.
+struct Instruction
+{
+  enum class Op
+  {
+    Input,  // pushes the state of input, or 0 if it is unbound
+    Not,
+    And,
+    Or,
+    Add,
+  };
+
+  Op op;
+  Core::Device::Input* input;
+};
+
 class Expression
 {
 public:
@@ -55,9 +72,25 @@ public:
   virtual void SetValue(ControlState state) = 0;
   virtual int CountNumControls() const = 0;
   virtual void UpdateReferences(ControlFinder& finder) = 0;
+  // Appends the instructions computing GetValue with the current references.
+  virtual void Compile(std::vector<Instruction>* program) const = 0;
   virtual operator std::string() const = 0;
 };
 
+// An input expression lowered to a flat program, with the inputs resolved, so that it can be
+// evaluated without walking the tree. It has to be compiled again after UpdateReferences.
+class CompiledExpression
+{
+public:
+  CompiledExpression() = default;
+  explicit CompiledExpression(const Expression& expression);
+  ControlState GetValue() const;
+
+private:
+  std::vector<Instruction> m_program;
+  size_t m_stack_size = 0;
+};
+
 enum class ParseStatus
 {
   Successful,
@@ -2,9 +2,11 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <chrono>
 #include <mutex>
 
 #include "Common/Logging/Log.h"
+#include "Common/Thread.h"
 #include "InputCommon/ControllerInterface/ControllerInterface.h"
 
 #ifdef CIFACE_USE_OSVR
@@ -145,6 +147,8 @@ void ControllerInterface::Shutdown()
   if (!m_is_init)
     return;
 
+  SetPollingRate(0);
+
   {
     std::lock_guard<std::mutex> lk(m_devices_mutex);
 
@@ -235,12 +239,57 @@ void ControllerInterface::RemoveDevice(std::function<bool(const ciface::Core::De
 //
 void ControllerInterface::UpdateInput()
 {
+  // The input thread publishes the states by itself
+  if (m_input_thread_running.IsSet())
+    return;
+
   // Don't block the UI or CPU thread (to avoid a short but noticeable frame drop)
   if (m_devices_mutex.try_lock())
   {
     std::lock_guard<std::mutex> lk(m_devices_mutex, std::adopt_lock);
     for (const auto& d : m_devices)
-      d->UpdateInput();
+      d->Poll();
+  }
+}
+
+//
+// SetPollingRate
+//
+// Start or stop the input thread
+//
+void ControllerInterface::SetPollingRate(u32 rate)
+{
+  if (m_input_thread_running.TestAndClear())
+    m_input_thread.join();
+
+  if (rate == 0)
+    return;
+
+  m_input_thread_running.Set();
+  m_input_thread = std::thread(&ControllerInterface::InputThread, this, rate);
+}
+
+void ControllerInterface::InputThread(u32 rate)
+{
+  Common::SetCurrentThreadName("Input thread");
+
+  const auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+      std::chrono::duration<double>(1.0 / rate));
+  auto next_poll = std::chrono::steady_clock::now();
+  while (m_input_thread_running.IsSet())
+  {
+    {
+      std::lock_guard<std::mutex> lk(m_devices_mutex);
+      for (const auto& d : m_devices)
+        d->Poll();
+    }
+
+    // Skip the polls which were missed rather than polling in a burst
+    next_poll += period;
+    const auto now = std::chrono::steady_clock::now();
+    if (next_poll < now)
+      next_poll = now;
+    std::this_thread::sleep_until(next_poll);
   }
 }
 
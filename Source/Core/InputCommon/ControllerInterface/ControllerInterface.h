@@ -9,9 +9,11 @@
 #include <map>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/Flag.h"
 #include "InputCommon/ControllerInterface/Device.h"
 
 // enable disable sources
@@ -55,14 +57,21 @@ public:
   void RemoveDevice(std::function<bool(const ciface::Core::Device*)> callback);
   bool IsInit() const { return m_is_init; }
   void UpdateInput();
+  // Polls the devices on a thread of their own, that many times per second, instead of in
+  // UpdateInput. Slow backends then don't delay the threads reading the inputs. 0 stops it.
+  void SetPollingRate(u32 rate);
 
   void RegisterHotplugCallback(std::function<void(void)> callback);
   void InvokeHotplugCallbacks() const;
 
 private:
+  void InputThread(u32 rate);
+
   std::vector<std::function<void()>> m_hotplug_callbacks;
   bool m_is_init;
   void* m_hwnd;
+  std::thread m_input_thread;
+  Common::Flag m_input_thread_running;
 };
 
 extern ControllerInterface g_controller_interface;
@@ -37,7 +37,15 @@ Device::~Device()
 
 void Device::AddInput(Device::Input* const i)
 {
-  m_inputs.push_back(i);
+  m_inputs.push_back(new PolledInput(i));
+}
+
+void Device::Poll()
+{
+  std::lock_guard<std::mutex> lk(m_poll_mutex);
+  UpdateInput();
+  for (Input* input : m_inputs)
+    static_cast<PolledInput*>(input)->Update();
 }
 
 void Device::AddOutput(Device::Output* const o)
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -99,6 +100,9 @@ public:
   virtual std::string GetName() const = 0;
   virtual std::string GetSource() const = 0;
   virtual void UpdateInput() {}
+  // Calls UpdateInput and publishes the new states of the inputs. Threads reading the inputs
+  // never wait for a poll, which can be done by another thread.
+  void Poll();
   virtual bool IsValid() const { return true; }
   const std::vector<Input*>& Inputs() const { return m_inputs; }
   const std::vector<Output*>& Outputs() const { return m_outputs; }
@@ -134,7 +138,36 @@ protected:
   }
 
 private:
+  // Wraps the inputs of the backend, which read the device state of the last UpdateInput, and
+  // returns their states as of the last Poll instead.
+  class PolledInput final : public Input
+  {
+  public:
+    explicit PolledInput(Input* input) : m_input(input) {}
+    ~PolledInput() { delete m_input; }
+    std::string GetName() const override { return m_input->GetName(); }
+    bool IsDetectable() override { return m_input->IsDetectable(); }
+    ControlState GetState() const override { return m_state.load(std::memory_order_relaxed); }
+    ControlState GetGatedState() override
+    {
+      return m_gated_state.load(std::memory_order_relaxed);
+    }
+    u32 GetStates() const override { return m_input->GetStates(); }
+    void Update()
+    {
+      m_state.store(m_input->GetState(), std::memory_order_relaxed);
+      m_gated_state.store(m_input->GetGatedState(), std::memory_order_relaxed);
+    }
+
+  private:
+    Input* const m_input;
+    std::atomic<ControlState> m_state{0.0};
+    std::atomic<ControlState> m_gated_state{0.0};
+  };
+
   int m_id;
+  std::mutex m_poll_mutex;
+  // PolledInput
   std::vector<Input*> m_inputs;
   std::vector<Output*> m_outputs;
 };
@@ -3,6 +3,8 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <libusb.h>
 #include <mutex>
 
@@ -36,8 +38,14 @@ static u8 s_controller_type[SerialInterface::MAX_SI_CHANNELS] = {
 static u8 s_controller_rumble[4];
 
 static std::mutex s_mutex;
+static std::condition_variable s_payload_received;
 static u8 s_controller_payload[37];
 static u8 s_controller_payload_swap[37];
+// When the current payload was received, and the average time between two payloads
+// (zero until known). s_payload_count is increased for each of them.
+static std::chrono::steady_clock::time_point s_controller_payload_time;
+static std::chrono::microseconds s_payload_interval{0};
+static u64 s_payload_count = 0;
 
 static std::atomic<int> s_controller_payload_size = {0};
 
@@ -69,19 +77,44 @@ static u8 s_endpoint_out = 0;
 
 static u64 s_last_init = 0;
 
+// Longest time WaitForNextPayload may block the CPU thread for.
+static constexpr std::chrono::microseconds MAX_PAYLOAD_WAIT{2000};
+
 static void Read()
 {
+  {
+    std::lock_guard<std::mutex> lk(s_mutex);
+    s_payload_interval = std::chrono::microseconds{0};
+    s_payload_count = 0;
+  }
+
   int payload_size = 0;
   while (s_adapter_thread_running.IsSet())
   {
     libusb_interrupt_transfer(s_handle, s_endpoint_in, s_controller_payload_swap,
                               sizeof(s_controller_payload_swap), &payload_size, 16);
+    const auto now = std::chrono::steady_clock::now();
 
     {
       std::lock_guard<std::mutex> lk(s_mutex);
       std::swap(s_controller_payload_swap, s_controller_payload);
       s_controller_payload_size.store(payload_size);
+      if (payload_size > 0)
+      {
+        // Averaged, to smooth out the jitter of the host's USB stack.
+        const auto interval =
+            std::chrono::duration_cast<std::chrono::microseconds>(now - s_controller_payload_time);
+        if (s_payload_count > 0)
+        {
+          s_payload_interval = s_payload_interval.count() == 0 ?
+                                   interval :
+                                   (s_payload_interval * 7 + interval) / 8;
+        }
+        s_controller_payload_time = now;
+        s_payload_count++;
+      }
     }
+    s_payload_received.notify_all();
 
     Common::YieldCPU();
   }
@@ -394,6 +427,29 @@ static void Reset()
   NOTICE_LOG(SERIALINTERFACE, "GC Adapter detached");
 }
 
+void WaitForNextPayload()
+{
+  if (s_handle == nullptr || !s_detected)
+    return;
+
+  std::unique_lock<std::mutex> lk(s_mutex);
+  if (s_payload_interval.count() == 0)
+    return;
+
+  // The adapter reports at its own rate, so the payload read by a poll is on average half an
+  // interval old. When the next one is due within half an interval, waiting for it halves that.
+  const auto now = std::chrono::steady_clock::now();
+  const auto next_payload = s_controller_payload_time + s_payload_interval;
+  if (next_payload - now > std::min(s_payload_interval / 2, MAX_PAYLOAD_WAIT))
+    return;
+
+  const auto deadline =
+      std::min(std::max(next_payload, now) + s_payload_interval / 4, now + MAX_PAYLOAD_WAIT);
+  const u64 payload_count = s_payload_count;
+  s_payload_received.wait_until(lk, deadline,
+                                [payload_count] { return s_payload_count != payload_count; });
+}
+
 GCPadStatus Input(int chan)
 {
   if (!UseAdapter())
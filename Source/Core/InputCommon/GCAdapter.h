@@ -24,6 +24,9 @@ void Shutdown();
 void SetAdapterCallback(std::function<void(void)> func);
 void StartScanThread();
 void StopScanThread();
+// Waits (briefly) for the adapter's next payload if it is about to arrive, for the following
+// Input calls to return it.
+void WaitForNextPayload();
 GCPadStatus Input(int chan);
 void Output(int chan, u8 rumble_command);
 bool IsDetected();
@@ -263,6 +263,11 @@ void StopScanThread()
     s_adapter_detect_thread.join();
 }
 
+void WaitForNextPayload()
+{
+  // The payloads are read through Java, without keeping track of when they arrive.
+}
+
 GCPadStatus Input(int chan)
 {
   if (!UseAdapter() || !s_detected || !s_fd)
@@ -115,6 +115,11 @@ std::unique_ptr<optparse::OptionParser> CreateParser(ParserOptions options)
   parser->add_option("--force-d3d11").action("store_true").help("Force use of Direct3D 11 backend");
   parser->add_option("--force-opengl").action("store_true").help("Force use of OpenGL backend");
   parser->add_option("--bruteforce").action("store").help("Return value for brute forcing Action Replay culling codes (needs save state 1 and map file)");
+  parser->add_option("--bruteforce-slice")
+      .action("store")
+      .metavar("<K/N>")
+      .help("Only brute force every Nth function, starting with the Kth, to split the search "
+            "between N instances");
 
   return parser;
 }
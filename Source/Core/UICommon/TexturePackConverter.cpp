@@ -0,0 +1,107 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "UICommon/TexturePackConverter.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+#include "Common/MsgHandler.h"
+#include "VideoCommon/HiresTextures.h"
+#include "VideoCommon/TexturePack.h"
+#include "VideoCommon/VideoConfig.h"
+
+namespace UICommon
+{
+bool ConvertTexturePack(const std::string& texture_directory, const std::string& output_path,
+                        const TexturePackCallback& callback)
+{
+  const std::unordered_map<std::string, std::string> texture_map =
+      HiresTexture::FindTextureFiles(texture_directory);
+
+  // Mipmaps are stored together with their base texture.
+  std::vector<std::string> names;
+  for (const auto& entry : texture_map)
+  {
+    if (entry.first.find("_mip") == std::string::npos)
+      names.push_back(entry.first);
+  }
+  std::sort(names.begin(), names.end());
+
+  if (names.empty())
+  {
+    PanicAlertT("No custom textures were found in \"%s\".", texture_directory.c_str());
+    return false;
+  }
+
+  std::unique_ptr<TexturePack::PackWriter> writer = TexturePack::PackWriter::Create(output_path);
+  if (!writer)
+  {
+    PanicAlertT("Failed to open the output file \"%s\".\n"
+                "Check that you have permissions to write the target folder and that the media can "
+                "be written.",
+                output_path.c_str());
+    return false;
+  }
+
+  // Compressed DDS textures are only kept compressed if the backend supports them. Whether it does
+  // is checked when the pack is loaded instead, so that one pack works with every backend.
+  g_Config.backend_info.bSupportsST3CTextures = true;
+  g_Config.backend_info.bSupportsBPTCTextures = true;
+  UpdateActiveConfig();
+
+  bool success = true;
+  for (size_t i = 0; i < names.size(); i++)
+  {
+    if (callback && !callback(names[i], static_cast<float>(i) / names.size()))
+    {
+      success = false;
+      break;
+    }
+
+    std::unique_ptr<HiresTexture> texture =
+        HiresTexture::LoadFromFiles(texture_map, names[i], 0, 0);
+    if (!texture)
+    {
+      WARN_LOG(VIDEO, "Skipping custom texture %s, it failed to load", names[i].c_str());
+      continue;
+    }
+
+    if (!writer->AddTexture(names[i], texture->m_levels))
+    {
+      PanicAlertT("Failed to write the output file \"%s\".\n"
+                  "Check that you have enough space available on the target drive.",
+                  output_path.c_str());
+      success = false;
+      break;
+    }
+  }
+
+  if (success && !writer->Finish())
+  {
+    PanicAlertT("Failed to write the output file \"%s\".\n"
+                "Check that you have enough space available on the target drive.",
+                output_path.c_str());
+    success = false;
+  }
+
+  if (!success)
+  {
+    // Remove the incomplete output file.
+    writer.reset();
+    File::Delete(output_path);
+    return false;
+  }
+
+  if (callback)
+    callback(GetStringT("Done converting texture pack."), 1.0f);
+  return true;
+}
+}
@@ -0,0 +1,21 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <functional>
+#include <string>
+
+namespace UICommon
+{
+// Called with the name of the texture which is converted next and the progress from 0 to 1.
+// Returning false cancels the conversion.
+using TexturePackCallback = std::function<bool(const std::string& text, float progress)>;
+
+// Bakes the custom textures in texture_directory into a texture pack, see VideoCommon/TexturePack.h.
+// Saved as HiresTexture::GetTexturePackPath, the pack is loaded instead of the directory.
+// Must not be called while emulation is running.
+bool ConvertTexturePack(const std::string& texture_directory, const std::string& output_path,
+                        const TexturePackCallback& callback = nullptr);
+}
@@ -75,12 +75,13 @@ int BBox::Get(int index)
   int data = 0;
   D3D::context->CopyResource(s_bbox_staging_buffer, s_bbox_buffer);
   D3D11_MAPPED_SUBRESOURCE map;
-  HRESULT hr = D3D::context->Map(s_bbox_staging_buffer, 0, D3D11_MAP_READ, 0, &map);
+  ID3D11DeviceContext* const immediate_context = D3D::GetImmediateContext();
+  HRESULT hr = immediate_context->Map(s_bbox_staging_buffer, 0, D3D11_MAP_READ, 0, &map);
   if (SUCCEEDED(hr))
   {
     data = ((s32*)map.pData)[index];
   }
-  D3D::context->Unmap(s_bbox_staging_buffer, 0);
+  immediate_context->Unmap(s_bbox_staging_buffer, 0);
   return data;
 }
 };
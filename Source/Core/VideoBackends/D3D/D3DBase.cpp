@@ -5,11 +5,17 @@
 // Carl: TODO: Actually merge the QUAD BUFFERED 3D mode in D3D from "Merge pull request #5697 from Armada651/quad-buffer"
 
 #include <algorithm>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
 
+#include "Common/BlockingLoop.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Common/StringUtil.h"
+#include "Common/Thread.h"
 #include "Core/Config/GraphicsSettings.h"
 #include "Core/ConfigManager.h"
 #include "VideoBackends/D3D/D3DBase.h"
@@ -65,6 +71,125 @@ unsigned int xres, yres;
 
 bool bFrameInProgress = false;
 
+// Only differs from context when recording on a deferred context.
+static ID3D11DeviceContext* immediate_context = nullptr;
+
+struct PendingSubmission
+{
+  ID3D11CommandList* command_list;
+  bool present;
+  UINT sync_interval;
+  UINT present_flags;
+};
+static std::thread s_submit_thread;
+static std::unique_ptr<Common::BlockingLoop> s_submit_loop;
+static std::deque<PendingSubmission> s_pending_submissions;
+static std::mutex s_pending_submission_lock;
+static u64 s_command_list_generation = 0;
+
+static void SubmitThreadFunc()
+{
+  Common::SetCurrentThreadName("D3D11 submission thread");
+  s_submit_loop->Run([]() {
+    PendingSubmission submission;
+    {
+      std::lock_guard<std::mutex> guard(s_pending_submission_lock);
+      if (s_pending_submissions.empty())
+      {
+        s_submit_loop->AllowSleep();
+        return;
+      }
+
+      submission = s_pending_submissions.front();
+      s_pending_submissions.pop_front();
+    }
+
+    if (submission.command_list)
+    {
+      immediate_context->ExecuteCommandList(submission.command_list, FALSE);
+      submission.command_list->Release();
+    }
+
+    if (submission.present)
+      swapchain->Present(submission.sync_interval, submission.present_flags);
+  });
+}
+
+// Only worth it when the driver builds the command lists itself, the runtime's emulation of
+// command lists just replays the calls on the immediate context.
+static bool ShouldUseDeferredContext()
+{
+  // The VR runtimes submit and present on the immediate context themselves.
+  if (!g_ActiveConfig.bBackendMultithreading || g_has_hmd)
+    return false;
+
+  D3D11_FEATURE_DATA_THREADING threading = {};
+  return SUCCEEDED(device->CheckFeatureSupport(D3D11_FEATURE_THREADING, &threading,
+                                               sizeof(threading))) &&
+         threading.DriverCommandLists;
+}
+
+static void CreateDeferredContext()
+{
+  ID3D11DeviceContext* deferred_context;
+  if (FAILED(device->CreateDeferredContext(0, &deferred_context)))
+  {
+    WARN_LOG(VIDEO, "Failed to create deferred context, using the immediate context.");
+    return;
+  }
+
+  SetDebugObjectName(deferred_context, "deferred device context");
+  context = deferred_context;
+  s_command_list_generation = 0;
+
+  s_submit_loop = std::make_unique<Common::BlockingLoop>();
+  s_submit_loop->Prepare();
+  s_submit_thread = std::thread(SubmitThreadFunc);
+  INFO_LOG(VIDEO, "Recording commands on a deferred context.");
+}
+
+static void DestroyDeferredContext()
+{
+  FlushCommandList();
+  s_submit_loop->Wait();
+  s_submit_loop->Stop();
+  s_submit_thread.join();
+  s_submit_loop.reset();
+
+  // Releasing the deferred context drops its references to the bound resources.
+  SAFE_RELEASE(context);
+  context = immediate_context;
+}
+
+static void WaitForSubmitThread()
+{
+  if (IsUsingDeferredContext())
+    s_submit_loop->Wait();
+}
+
+static void QueueSubmission(ID3D11CommandList* command_list, bool present, UINT sync_interval,
+                            UINT present_flags)
+{
+  {
+    std::lock_guard<std::mutex> guard(s_pending_submission_lock);
+    s_pending_submissions.push_back({command_list, present, sync_interval, present_flags});
+  }
+  s_submit_loop->Wakeup();
+}
+
+// Returns nullptr if the command list could not be created, the commands are lost in that case.
+static ID3D11CommandList* FinishCommandList()
+{
+  // Keep the state, StateManager assumes that nothing changes behind its back.
+  ID3D11CommandList* command_list = nullptr;
+  HRESULT hr = context->FinishCommandList(TRUE, &command_list);
+  if (FAILED(hr))
+    ERROR_LOG(VIDEO, "FinishCommandList failed: 0x%08X", hr);
+
+  s_command_list_generation++;
+  return command_list;
+}
+
 HRESULT LoadDXGI()
 {
   if (dxgi_dll_ref++ > 0)
@@ -561,6 +686,10 @@ HRESULT Create(HWND wnd)
                MB_OK | MB_ICONERROR);
 
   SetDebugObjectName(context, "device context");
+  immediate_context = context;
+  if (ShouldUseDeferredContext())
+    CreateDeferredContext();
+
   SAFE_RELEASE(factory);
   SAFE_RELEASE(output);
   SAFE_RELEASE(adapter);
@@ -605,6 +734,9 @@ HRESULT Create(HWND wnd)
 
 void Close()
 {
+  if (IsUsingDeferredContext())
+    DestroyDeferredContext();
+
   // we can't release the swapchain while in fullscreen.
   swapchain->SetFullscreenState(false, nullptr);
 
@@ -616,6 +748,7 @@ void Close()
   context->Flush();  // immediately destroy device objects
 
   SAFE_RELEASE(context);
+  immediate_context = nullptr;
   SAFE_RELEASE(device1);
   ULONG references = device->Release();
 
@@ -728,6 +861,13 @@ u32 GetMaxTextureSize(D3D_FEATURE_LEVEL feature_level)
 
 void Reset()
 {
+  // The deferred context and the queued command lists reference the back buffer as well.
+  if (IsUsingDeferredContext())
+  {
+    context->OMSetRenderTargets(0, nullptr, nullptr);
+    GetImmediateContext();
+  }
+
   // release all back buffer references
   SAFE_RELEASE(backbuf);
 
@@ -795,11 +935,45 @@ void Present()
   //  present_flags |= DXGI_PRESENT_STEREO_TEMPORARY_MONO;
 
   // TODO: Is 1 the correct value for vsyncing?
-  swapchain->Present((UINT)g_ActiveConfig.IsVSync(), present_flags);
+  const UINT sync_interval = (UINT)g_ActiveConfig.IsVSync();
+  if (!IsUsingDeferredContext())
+  {
+    swapchain->Present(sync_interval, present_flags);
+    return;
+  }
+
+  // Let the submission thread finish the previous frame before queueing this one, so that we
+  // record at most one frame ahead of it.
+  s_submit_loop->Wait();
+  QueueSubmission(FinishCommandList(), true, sync_interval, present_flags);
+}
+
+bool IsUsingDeferredContext()
+{
+  return context != immediate_context;
+}
+
+void FlushCommandList()
+{
+  if (IsUsingDeferredContext())
+    QueueSubmission(FinishCommandList(), false, 0, 0);
+}
+
+u64 GetCommandListGeneration()
+{
+  return s_command_list_generation;
+}
+
+ID3D11DeviceContext* GetImmediateContext()
+{
+  FlushCommandList();
+  WaitForSubmitThread();
+  return immediate_context;
 }
 
 HRESULT SetFullscreenState(bool enable_fullscreen)
 {
+  WaitForSubmitThread();
   return swapchain->SetFullscreenState(enable_fullscreen, nullptr);
 }
 
@@ -66,6 +66,20 @@ extern IDXGISwapChain* swapchain;
 extern HWND hWnd;
 extern bool bFrameInProgress;
 
+// When the driver supports command lists and backend multithreading is enabled, context is a
+// deferred context. The commands recorded on it are executed on the immediate context by a
+// submission thread, which also presents the frames.
+bool IsUsingDeferredContext();
+// Queues the commands recorded so far for execution. Does nothing on the immediate context.
+void FlushCommandList();
+// Incremented whenever a command list is finished. A dynamic resource has to be mapped with
+// D3D11_MAP_WRITE_DISCARD once in each command list before it can be mapped with NO_OVERWRITE.
+u64 GetCommandListGeneration();
+// Executes all recorded commands and waits for the submission thread to go idle, then returns
+// the immediate context, for what deferred contexts can't do: reading back resources and
+// query results. The returned context must not be used after recording new commands.
+ID3D11DeviceContext* GetImmediateContext();
+
 void Reset();
 bool BeginFrame();
 void EndFrame();
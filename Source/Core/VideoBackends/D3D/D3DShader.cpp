@@ -7,12 +7,14 @@
 
 #include "Common/FileUtil.h"
 #include "Common/Logging/Log.h"
+#include "Common/Logging/Trace.h"
 #include "Common/MsgHandler.h"
 #include "Common/StringUtil.h"
 #include "Core/ARBruteForcer.h"
 #include "Core/Core.h"
 #include "VideoBackends/D3D/D3DBase.h"
 #include "VideoBackends/D3D/D3DShader.h"
+#include "VideoCommon/Statistics.h"
 #include "VideoCommon/VideoConfig.h"
 
 namespace DX11
@@ -33,6 +35,8 @@ ID3D11VertexShader* CreateVertexShaderFromByteCode(const void* bytecode, size_t
 // code->bytecode
 bool CompileVertexShader(const std::string& code, D3DBlob** blob)
 {
+  TRACE_SCOPE("D3D::CompileVertexShader");
+  g_shader_compiles.Increment();
   ID3D10Blob* shaderBuffer = nullptr;
   ID3D10Blob* errorBuffer = nullptr;
 
@@ -92,6 +96,8 @@ ID3D11GeometryShader* CreateGeometryShaderFromByteCode(const void* bytecode, siz
 bool CompileGeometryShader(const std::string& code, D3DBlob** blob,
                            const D3D_SHADER_MACRO* pDefines)
 {
+  TRACE_SCOPE("D3D::CompileGeometryShader");
+  g_shader_compiles.Increment();
   ID3D10Blob* shaderBuffer = nullptr;
   ID3D10Blob* errorBuffer = nullptr;
 
@@ -151,6 +157,8 @@ ID3D11PixelShader* CreatePixelShaderFromByteCode(const void* bytecode, size_t le
 // code->bytecode
 bool CompilePixelShader(const std::string& code, D3DBlob** blob, const D3D_SHADER_MACRO* pDefines)
 {
+  TRACE_SCOPE("D3D::CompilePixelShader");
+  g_shader_compiles.Increment();
   ID3D10Blob* shaderBuffer = nullptr;
   ID3D10Blob* errorBuffer = nullptr;
 
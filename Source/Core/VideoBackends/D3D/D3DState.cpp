@@ -170,10 +170,12 @@ void StateManager::Apply()
       m_current.vertexBufferOffset = m_pending.vertexBufferOffset;
     }
 
-    if (m_current.indexBuffer != m_pending.indexBuffer)
+    if (m_current.indexBuffer != m_pending.indexBuffer ||
+        m_current.indexBufferFormat != m_pending.indexBufferFormat)
     {
-      D3D::context->IASetIndexBuffer(m_pending.indexBuffer, DXGI_FORMAT_R16_UINT, 0);
+      D3D::context->IASetIndexBuffer(m_pending.indexBuffer, m_pending.indexBufferFormat, 0);
       m_current.indexBuffer = m_pending.indexBuffer;
+      m_current.indexBufferFormat = m_pending.indexBufferFormat;
     }
 
     if (m_current.topology != m_pending.topology)
@@ -267,9 +269,8 @@ void StateManager::SetTextureByMask(u32 textureSlotMask, ID3D11ShaderResourceVie
 
 ID3D11SamplerState* StateCache::Get(SamplerState state)
 {
-  auto it = m_sampler.find(state.hex);
-  if (it != m_sampler.end())
-    return it->second;
+  if (ID3D11SamplerState* const* cached = m_sampler.Find(state))
+    return *cached;
 
   D3D11_SAMPLER_DESC sampdc = CD3D11_SAMPLER_DESC(CD3D11_DEFAULT());
   if (state.mipmap_filter == SamplerState::Filter::Linear)
@@ -315,15 +316,14 @@ ID3D11SamplerState* StateCache::Get(SamplerState state)
     PanicAlert("Fail %s %d\n", __FILE__, __LINE__);
 
   D3D::SetDebugObjectName(res, "sampler state used to emulate the GX pipeline");
-  m_sampler.emplace(state.hex, res);
+  m_sampler.Insert(state, res);
   return res;
 }
 
 ID3D11BlendState* StateCache::Get(BlendingState state)
 {
-  auto it = m_blend.find(state.hex);
-  if (it != m_blend.end())
-    return it->second;
+  if (ID3D11BlendState* const* cached = m_blend.Find(state))
+    return *cached;
 
   if (state.logicopenable && D3D::device1)
   {
@@ -351,7 +351,7 @@ ID3D11BlendState* StateCache::Get(BlendingState state)
     if (SUCCEEDED(hr))
     {
       D3D::SetDebugObjectName(res, "blend state used to emulate the GX pipeline");
-      m_blend.emplace(state.hex, res);
+      m_blend.Insert(state, res);
       return res;
     }
   }
@@ -397,15 +397,14 @@ ID3D11BlendState* StateCache::Get(BlendingState state)
     PanicAlert("Failed to create blend state at %s %d\n", __FILE__, __LINE__);
 
   D3D::SetDebugObjectName(res, "blend state used to emulate the GX pipeline");
-  m_blend.emplace(state.hex, res);
+  m_blend.Insert(state, res);
   return res;
 }
 
 ID3D11RasterizerState* StateCache::Get(RasterizationState state)
 {
-  auto it = m_raster.find(state.hex);
-  if (it != m_raster.end())
-    return it->second;
+  if (ID3D11RasterizerState* const* cached = m_raster.Find(state))
+    return *cached;
 
   static constexpr std::array<D3D11_CULL_MODE, 4> cull_modes = {
       {D3D11_CULL_NONE, D3D11_CULL_BACK, D3D11_CULL_FRONT, D3D11_CULL_BACK}};
@@ -422,7 +421,7 @@ ID3D11RasterizerState* StateCache::Get(RasterizationState state)
     PanicAlert("Failed to create rasterizer state at %s %d\n", __FILE__, __LINE__);
 
   D3D::SetDebugObjectName(res, "rasterizer state used to emulate the GX pipeline");
-  m_raster.emplace(state.hex, res);
+  m_raster.Insert(state, res);
   return res;
 }
 
@@ -432,9 +431,8 @@ ID3D11DepthStencilState* StateCache::Get(DepthState state)
   if (VertexShaderManager::m_layer_on_top)
     state.func = ZMode::ALWAYS;
 
-  auto it = m_depth.find(state.hex);
-  if (it != m_depth.end())
-    return it->second;
+  if (ID3D11DepthStencilState* const* cached = m_depth.Find(state))
+    return *cached;
 
   D3D11_DEPTH_STENCIL_DESC depthdc = CD3D11_DEPTH_STENCIL_DESC(CD3D11_DEFAULT());
 
@@ -473,36 +471,24 @@ ID3D11DepthStencilState* StateCache::Get(DepthState state)
   else
     PanicAlert("Failed to create depth state at %s %d\n", __FILE__, __LINE__);
 
-  m_depth.emplace(state.hex, res);
+  m_depth.Insert(state, res);
 
   return res;
 }
 
 void StateCache::Clear()
 {
-  for (auto it : m_depth)
-  {
-    SAFE_RELEASE(it.second);
-  }
-  m_depth.clear();
+  m_depth.ForEach([](ID3D11DepthStencilState*& object) { SAFE_RELEASE(object); });
+  m_depth.Clear();
 
-  for (auto it : m_raster)
-  {
-    SAFE_RELEASE(it.second);
-  }
-  m_raster.clear();
+  m_raster.ForEach([](ID3D11RasterizerState*& object) { SAFE_RELEASE(object); });
+  m_raster.Clear();
 
-  for (auto it : m_blend)
-  {
-    SAFE_RELEASE(it.second);
-  }
-  m_blend.clear();
+  m_blend.ForEach([](ID3D11BlendState*& object) { SAFE_RELEASE(object); });
+  m_blend.Clear();
 
-  for (auto it : m_sampler)
-  {
-    SAFE_RELEASE(it.second);
-  }
-  m_sampler.clear();
+  m_sampler.ForEach([](ID3D11SamplerState*& object) { SAFE_RELEASE(object); });
+  m_sampler.Clear();
 }
 
 D3D11_PRIMITIVE_TOPOLOGY StateCache::GetPrimitiveTopology(PrimitiveType primitive)
@@ -7,12 +7,12 @@
 #include <array>
 #include <cstddef>
 #include <stack>
-#include <unordered_map>
 
 #include "Common/BitField.h"
 #include "Common/CommonTypes.h"
 #include "VideoBackends/D3D/D3DBase.h"
 #include "VideoCommon/RenderState.h"
+#include "VideoCommon/RenderStateCache.h"
 
 struct ID3D11BlendState;
 struct ID3D11DepthStencilState;
@@ -37,10 +37,10 @@ public:
   static D3D11_PRIMITIVE_TOPOLOGY GetPrimitiveTopology(PrimitiveType primitive);
 
 private:
-  std::unordered_map<u32, ID3D11DepthStencilState*> m_depth;
-  std::unordered_map<u32, ID3D11RasterizerState*> m_raster;
-  std::unordered_map<u32, ID3D11BlendState*> m_blend;
-  std::unordered_map<SamplerState::StorageType, ID3D11SamplerState*> m_sampler;
+  RenderStateCache<DepthState, ID3D11DepthStencilState*> m_depth;
+  RenderStateCache<RasterizationState, ID3D11RasterizerState*> m_raster;
+  RenderStateCache<BlendingState, ID3D11BlendState*> m_blend;
+  RenderStateCache<SamplerState, ID3D11SamplerState*> m_sampler;
 };
 
 namespace D3D
@@ -129,12 +129,13 @@ public:
     m_pending.vertexBufferOffset = offset;
   }
 
-  void SetIndexBuffer(ID3D11Buffer* buffer)
+  void SetIndexBuffer(ID3D11Buffer* buffer, DXGI_FORMAT format = DXGI_FORMAT_R16_UINT)
   {
-    if (m_current.indexBuffer != buffer)
+    if (m_current.indexBuffer != buffer || m_current.indexBufferFormat != format)
       m_dirtyFlags |= DirtyFlag_IndexBuffer;
 
     m_pending.indexBuffer = buffer;
+    m_pending.indexBufferFormat = format;
   }
 
   void SetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY topology)
@@ -247,6 +248,7 @@ private:
     ID3D11Buffer* geometryConstants;
     ID3D11Buffer* vertexBuffer;
     ID3D11Buffer* indexBuffer;
+    DXGI_FORMAT indexBufferFormat;
     u32 vertexBufferStride;
     u32 vertexBufferOffset;
     D3D11_PRIMITIVE_TOPOLOGY topology;
@@ -39,11 +39,12 @@ public:
   int AppendData(void* data, unsigned int size, unsigned int vertex_size)
   {
     D3D11_MAPPED_SUBRESOURCE map;
-    if (offset + size >= max_size)
+    if (offset + size >= max_size || NeedsDiscard())
     {
       // wrap buffer around and notify observers
       offset = 0;
       context->Map(buf, 0, D3D11_MAP_WRITE_DISCARD, 0, &map);
+      command_list_generation = GetCommandListGeneration();
 
       for (bool* observer : observers)
         *observer = true;
@@ -66,12 +67,13 @@ public:
 
     D3D11_MAPPED_SUBRESOURCE map;
     unsigned int aligned_offset = Common::AlignUp(offset, vertex_size);
-    if (aligned_offset + size > max_size)
+    if (aligned_offset + size > max_size || NeedsDiscard())
     {
       // wrap buffer around and notify observers
       offset = 0;
       aligned_offset = 0;
       context->Map(buf, 0, D3D11_MAP_WRITE_DISCARD, 0, &map);
+      command_list_generation = GetCommandListGeneration();
 
       for (bool* observer : observers)
         *observer = true;
@@ -90,9 +92,14 @@ public:
   void AddWrapObserver(bool* observer) { observers.push_back(observer); }
   inline ID3D11Buffer*& GetBuffer() { return buf; }
 private:
+  // Deferred contexts have to discard the buffer once in each command list, which loses its
+  // contents, so the first map in each command list is treated like a wraparound.
+  bool NeedsDiscard() const { return command_list_generation != GetCommandListGeneration(); }
+
   ID3D11Buffer* buf = nullptr;
   unsigned int offset = 0;
   unsigned int max_size;
+  u64 command_list_generation = 0;
 
   std::list<bool*> observers;
 };
@@ -120,7 +120,8 @@ bool DXTexture::Save(const std::string& filename, unsigned int level)
 
   // Map the staging texture to client memory, and encode it as a .png image.
   D3D11_MAPPED_SUBRESOURCE map;
-  hr = D3D::context->Map(staging_texture, 0, D3D11_MAP_READ, 0, &map);
+  ID3D11DeviceContext* const immediate_context = D3D::GetImmediateContext();
+  hr = immediate_context->Map(staging_texture, 0, D3D11_MAP_READ, 0, &map);
   if (FAILED(hr))
   {
     WARN_LOG(VIDEO, "Failed to map texture dumping readback texture: %X", static_cast<u32>(hr));
@@ -130,7 +131,7 @@ bool DXTexture::Save(const std::string& filename, unsigned int level)
 
   bool encode_result =
       TextureToPng(reinterpret_cast<u8*>(map.pData), map.RowPitch, filename, mip_width, mip_height);
-  D3D::context->Unmap(staging_texture, 0);
+  immediate_context->Unmap(staging_texture, 0);
   staging_texture->Release();
 
   return encode_result;
@@ -151,7 +151,8 @@ void PSTextureEncoder::Encode(u8* dst, const EFBCopyParams& params, u32 native_w
 
     // Transfer staging buffer to GameCube/Wii RAM
     D3D11_MAPPED_SUBRESOURCE map = {0};
-    hr = D3D::context->Map(m_outStage, 0, D3D11_MAP_READ, 0, &map);
+    ID3D11DeviceContext* const immediate_context = D3D::GetImmediateContext();
+    hr = immediate_context->Map(m_outStage, 0, D3D11_MAP_READ, 0, &map);
     CHECK(SUCCEEDED(hr), "map staging buffer (0x%x)", hr);
 
     u8* src = (u8*)map.pData;
@@ -163,7 +164,7 @@ void PSTextureEncoder::Encode(u8* dst, const EFBCopyParams& params, u32 native_w
       src += map.RowPitch;
     }
 
-    D3D::context->Unmap(m_outStage, 0);
+    immediate_context->Unmap(m_outStage, 0);
   }
 
   // Restore API
@@ -3,7 +3,6 @@
 // Refer to the license.txt file included.
 
 #include "VideoBackends/D3D/PerfQuery.h"
-#include "Common/CommonFuncs.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "VideoBackends/D3D/D3DBase.h"
@@ -69,8 +68,8 @@ void PerfQuery::DisableQuery(PerfQueryGroup type)
 
 void PerfQuery::ResetQuery()
 {
-  m_query_count = 0;
-  std::fill_n(m_results, ArraySize(m_results), 0);
+  if (ResetResults())
+    m_query_count = 0;
 }
 
 u32 PerfQuery::GetQueryResult(PerfQueryType type)
@@ -78,13 +77,13 @@ u32 PerfQuery::GetQueryResult(PerfQueryType type)
   u32 result = 0;
 
   if (type == PQ_ZCOMP_INPUT_ZCOMPLOC || type == PQ_ZCOMP_OUTPUT_ZCOMPLOC)
-    result = m_results[PQG_ZCOMP_ZCOMPLOC];
+    result = GetResult(PQG_ZCOMP_ZCOMPLOC);
   else if (type == PQ_ZCOMP_INPUT || type == PQ_ZCOMP_OUTPUT)
-    result = m_results[PQG_ZCOMP];
+    result = GetResult(PQG_ZCOMP);
   else if (type == PQ_BLEND_INPUT)
-    result = m_results[PQG_ZCOMP] + m_results[PQG_ZCOMP_ZCOMPLOC];
+    result = GetResult(PQG_ZCOMP) + GetResult(PQG_ZCOMP_ZCOMPLOC);
   else if (type == PQ_EFB_COPY_CLOCKS)
-    result = m_results[PQG_EFB_COPY_CLOCKS];
+    result = GetResult(PQG_EFB_COPY_CLOCKS);
 
   return result;
 }
@@ -95,17 +94,18 @@ void PerfQuery::FlushOne()
 
   UINT64 result = 0;
   HRESULT hr = S_FALSE;
+  ID3D11DeviceContext* const immediate_context = D3D::GetImmediateContext();
   while (hr != S_OK)
   {
     // TODO: Might cause us to be stuck in an infinite loop!
-    hr = D3D::context->GetData(entry.query, &result, sizeof(result), 0);
+    hr = immediate_context->GetData(entry.query, &result, sizeof(result), 0);
   }
 
   // NOTE: Reported pixel metrics should be referenced to native resolution
   // TODO: Dropping the lower 2 bits from this count should be closer to actual
   // hardware behavior when drawing triangles.
-  m_results[entry.query_type] += (u32)(result * EFB_WIDTH / g_renderer->GetTargetWidth() *
-                                       EFB_HEIGHT / g_renderer->GetTargetHeight());
+  AddResult(entry.query_type, (u32)(result * EFB_WIDTH / g_renderer->GetTargetWidth() *
+                                    EFB_HEIGHT / g_renderer->GetTargetHeight()));
 
   m_query_read_pos = (m_query_read_pos + 1) % m_query_buffer.size();
   --m_query_count;
@@ -118,21 +118,27 @@ void PerfQuery::FlushResults()
     FlushOne();
 }
 
+void PerfQuery::PollResults()
+{
+  WeakFlush();
+}
+
 void PerfQuery::WeakFlush()
 {
+  ID3D11DeviceContext* const immediate_context = D3D::GetImmediateContext();
   while (!IsFlushed())
   {
     auto& entry = m_query_buffer[m_query_read_pos];
 
     UINT64 result = 0;
-    HRESULT hr =
-        D3D::context->GetData(entry.query, &result, sizeof(result), D3D11_ASYNC_GETDATA_DONOTFLUSH);
+    HRESULT hr = immediate_context->GetData(entry.query, &result, sizeof(result),
+                                            D3D11_ASYNC_GETDATA_DONOTFLUSH);
 
     if (hr == S_OK)
     {
       // NOTE: Reported pixel metrics should be referenced to native resolution
-      m_results[entry.query_type] += (u32)(result * EFB_WIDTH / g_renderer->GetTargetWidth() *
-                                           EFB_HEIGHT / g_renderer->GetTargetHeight());
+      AddResult(entry.query_type, (u32)(result * EFB_WIDTH / g_renderer->GetTargetWidth() *
+                                        EFB_HEIGHT / g_renderer->GetTargetHeight()));
 
       m_query_read_pos = (m_query_read_pos + 1) % m_query_buffer.size();
       --m_query_count;
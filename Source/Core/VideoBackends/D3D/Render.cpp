@@ -90,6 +90,12 @@ static ID3D11DepthStencilState* s_reset_depth_state = nullptr;
 static ID3D11RasterizerState* s_reset_rast_state = nullptr;
 
 static ID3D11Texture2D* s_screenshot_texture = nullptr;
+// The frame in s_screenshot_texture is read back one frame after the copy, when the GPU is done
+// with it, rather than stalling on Map() right away.
+static bool s_screenshot_pending = false;
+static unsigned int s_screenshot_width = 0;
+static unsigned int s_screenshot_height = 0;
+static AVIDump::Frame s_screenshot_state;
 static D3DTexture2D* s_3d_vision_texture = nullptr;
 
 static GXPipelineState s_gx_state;
@@ -174,6 +180,7 @@ static void SetupDeviceObjects()
   D3D::SetDebugObjectName(s_reset_rast_state, "rasterizer state for Renderer::ResetAPIState");
 
   s_screenshot_texture = nullptr;
+  s_screenshot_pending = false;
 }
 
 // Kill off all device objects
@@ -308,12 +315,30 @@ Renderer::~Renderer()
   }
   g_first_rift_frame = true;
 
+  FlushFrameDump();
   TeardownDeviceObjects();
   D3D::EndFrame();
   D3D::Present();
   D3D::Close();
 }
 
+void Renderer::FlushFrameDump()
+{
+  if (!s_screenshot_pending)
+    return;
+
+  s_screenshot_pending = false;
+  D3D11_MAPPED_SUBRESOURCE map;
+  ID3D11DeviceContext* const immediate_context = D3D::GetImmediateContext();
+  if (FAILED(immediate_context->Map(s_screenshot_texture, 0, D3D11_MAP_READ, 0, &map)))
+    return;
+
+  // DumpFrameData copies the frame, so the texture can be unmapped right away.
+  DumpFrameData(reinterpret_cast<const u8*>(map.pData), s_screenshot_width, s_screenshot_height,
+                map.RowPitch, s_screenshot_state);
+  immediate_context->Unmap(s_screenshot_texture, 0);
+}
+
 void Renderer::RenderText(const std::string& text, int left, int top, u32 color)
 {
   D3D::font.DrawTextScaled((float)(left + 1), (float)(top + 1), 20.f, 0.0f, color & 0xFF000000,
@@ -460,7 +485,8 @@ u32 Renderer::AccessEFB(EFBAccessType type, u32 x, u32 y, u32 poke_data)
   D3D11_BOX box = CD3D11_BOX(0, 0, 0, 1, 1, 1);
   D3D::context->CopySubresourceRegion(staging_tex, 0, 0, 0, 0, read_tex->GetTex(), 0, &box);
   D3D11_MAPPED_SUBRESOURCE map;
-  CHECK(D3D::context->Map(staging_tex, 0, D3D11_MAP_READ, 0, &map) == S_OK,
+  ID3D11DeviceContext* const immediate_context = D3D::GetImmediateContext();
+  CHECK(immediate_context->Map(staging_tex, 0, D3D11_MAP_READ, 0, &map) == S_OK,
         "Map staging buffer failed");
 
   // Convert the framebuffer data to the format the game is expecting to receive.
@@ -515,7 +541,7 @@ u32 Renderer::AccessEFB(EFBAccessType type, u32 x, u32 y, u32 poke_data)
     }
   }
 
-  D3D::context->Unmap(staging_tex, 0);
+  immediate_context->Unmap(staging_tex, 0);
   return ret;
 }
 
@@ -810,7 +836,7 @@ void Renderer::SwapImpl(u32 xfbAddr, u32 fbWidth, u32 fbStride, u32 fbHeight,
   // activate linear filtering for the buffer copies
   D3D::SetLinearCopySampler();
 
-  if (g_ActiveConfig.bUseXFB && g_ActiveConfig.bUseRealXFB)
+  if (g_ActiveConfig.bUseXFB && FramebufferManager::IsRealXFBSource())
   {
     // TODO: Television should be used to render Virtual XFB mode as well.
     D3D11_VIEWPORT vp = CD3D11_VIEWPORT((float)targetRc.left, (float)targetRc.top,
@@ -1140,26 +1166,21 @@ void Renderer::SwapImpl(u32 xfbAddr, u32 fbWidth, u32 fbStride, u32 fbHeight,
 
 // Dump frames
 #if defined(HAVE_FFMPEG)
+  // The FlushFrameDump call here is necessary even after frame dumping is stopped, so that the
+  // last frame isn't left in the screenshot texture for the next screenshot.
+  FlushFrameDump();
   if (IsFrameDumping())
   {
     if (!s_screenshot_texture)
       CreateScreenshotTexture();
 
     D3D11_BOX source_box = GetScreenshotSourceBox(targetRc);
-    unsigned int source_width = source_box.right - source_box.left;
-    unsigned int source_height = source_box.bottom - source_box.top;
+    s_screenshot_width = source_box.right - source_box.left;
+    s_screenshot_height = source_box.bottom - source_box.top;
     D3D::context->CopySubresourceRegion(s_screenshot_texture, 0, 0, 0, 0,
                                         D3D::GetBackBuffer()->GetTex(), 0, &source_box);
-
-    D3D11_MAPPED_SUBRESOURCE map;
-    D3D::context->Map(s_screenshot_texture, 0, D3D11_MAP_READ, 0, &map);
-
-    AVIDump::Frame state = AVIDump::FetchState(ticks);
-    DumpFrameData(reinterpret_cast<const u8*>(map.pData), source_width, source_height, map.RowPitch,
-                  state);
-    FinishFrameData();
-
-    D3D::context->Unmap(s_screenshot_texture, 0);
+    s_screenshot_state = AVIDump::FetchState(ticks);
+    s_screenshot_pending = true;
   }
 #endif
 
@@ -1249,7 +1270,11 @@ void Renderer::SwapImpl(u32 xfbAddr, u32 fbWidth, u32 fbStride, u32 fbHeight,
 
   // Flip/present backbuffer to frontbuffer here
   if (!g_has_hmd)
+  {
+    m_frame_pacer.WaitForPresent(ticks);
     D3D::Present();
+    m_frame_pacer.EndPresent();
+  }
 
   VR_NewVRFrame();
 
@@ -1266,6 +1291,7 @@ void Renderer::SwapImpl(u32 xfbAddr, u32 fbWidth, u32 fbStride, u32 fbHeight,
     if (window_resized || fs_changed)
     {
       // TODO: Aren't we still holding a reference to the back buffer right now?
+      FlushFrameDump();
       D3D::Reset();
       SAFE_RELEASE(s_screenshot_texture);
       SAFE_RELEASE(s_3d_vision_texture);
@@ -60,5 +60,9 @@ public:
 
   void BlitScreen(TargetRectangle src, TargetRectangle dst, D3DTexture2D* src_texture,
                          u32 src_width, u32 src_height, float Gamma);
+
+private:
+  // Dumps the frame copied to the screenshot texture by the previous SwapImpl, if any.
+  void FlushFrameDump();
 };
 }
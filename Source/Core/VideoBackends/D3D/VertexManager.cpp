@@ -29,7 +29,7 @@
 namespace DX11
 {
 // TODO: Find sensible values for these two
-const u32 MAX_IBUFFER_SIZE = VertexManager::MAXIBUFFERSIZE * sizeof(u16) * 8;
+const u32 MAX_IBUFFER_SIZE = VertexManager::MAXIBUFFERSIZE * sizeof(u32) * 8;
 const u32 MAX_VBUFFER_SIZE = VertexManager::MAXVBUFFERSIZE;
 const u32 MAX_BUFFER_SIZE = MAX_IBUFFER_SIZE + MAX_VBUFFER_SIZE;
 
@@ -89,7 +89,7 @@ void VertexManager::PrepareDrawBuffers(u32 stride)
   D3D11_MAPPED_SUBRESOURCE map;
 
   u32 vertexBufferSize = u32(m_cur_buffer_pointer - m_base_buffer_pointer);
-  u32 indexBufferSize = IndexGenerator::GetIndexLen() * sizeof(u16);
+  u32 indexBufferSize = IndexGenerator::GetIndexLen() * IndexGenerator::GetIndexSize();
   u32 totalBufferSize = vertexBufferSize + indexBufferSize;
 
   u32 cursor = m_bufferCursor;
@@ -99,8 +99,11 @@ void VertexManager::PrepareDrawBuffers(u32 stride)
     cursor += stride - padding;
   }
 
+  // Deferred contexts have to discard the buffer once in each command list before it can be
+  // mapped with NO_OVERWRITE.
   D3D11_MAP MapType = D3D11_MAP_WRITE_NO_OVERWRITE;
-  if (cursor + totalBufferSize >= MAX_BUFFER_SIZE)
+  if (cursor + totalBufferSize >= MAX_BUFFER_SIZE ||
+      m_command_list_generation != D3D::GetCommandListGeneration())
   {
     // Wrap around
     m_currentBuffer = (m_currentBuffer + 1) % MAX_BUFFER_COUNT;
@@ -110,6 +113,7 @@ void VertexManager::PrepareDrawBuffers(u32 stride)
 
   m_vertexDrawOffset = cursor;
   m_indexDrawOffset = cursor + vertexBufferSize;
+  m_command_list_generation = D3D::GetCommandListGeneration();
 
   D3D::context->Map(m_buffers[m_currentBuffer], 0, MapType, 0, &map);
   u8* mappedData = reinterpret_cast<u8*>(map.pData);
@@ -191,10 +195,12 @@ void VertexManager::Draw(u32 stride)
   u32 indices = IndexGenerator::GetIndexLen();
 
   D3D::stateman->SetVertexBuffer(m_buffers[m_currentBuffer], stride, 0);
-  D3D::stateman->SetIndexBuffer(m_buffers[m_currentBuffer]);
+  const DXGI_FORMAT index_format =
+      IndexGenerator::GetIndexSize() == sizeof(u32) ? DXGI_FORMAT_R32_UINT : DXGI_FORMAT_R16_UINT;
+  D3D::stateman->SetIndexBuffer(m_buffers[m_currentBuffer], index_format);
 
   u32 baseVertex = m_vertexDrawOffset / stride;
-  u32 startIndex = m_indexDrawOffset / sizeof(u16);
+  u32 startIndex = m_indexDrawOffset / IndexGenerator::GetIndexSize();
 
   D3D::stateman->Apply();
   D3D::context->DrawIndexed(indices, startIndex, baseVertex);
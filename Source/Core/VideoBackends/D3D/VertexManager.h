@@ -42,7 +42,7 @@ public:
 
 protected:
   void ResetBuffer(u32 stride) override;
-  u16* GetIndexBuffer() { return &LocalIBuffer[0]; }
+  u32* GetIndexBuffer() { return &LocalIBuffer[0]; }
 private:
   void PrepareDrawBuffers(u32 stride);
   void Draw(u32 stride);
@@ -53,6 +53,7 @@ private:
   u32 m_indexDrawOffset;
   u32 m_currentBuffer;
   u32 m_bufferCursor;
+  u64 m_command_list_generation = 0;
 
   enum
   {
@@ -61,7 +62,8 @@ private:
   ID3D11Buffer* m_buffers[MAX_BUFFER_COUNT];
 
   std::vector<u8> LocalVBuffer;
-  std::vector<u16> LocalIBuffer;
+  // Large enough for both 16-bit and 32-bit indices.
+  std::vector<u32> LocalIBuffer;
 
   std::vector<u8> LocalVReplayBuffer;
   std::vector<u16> LocalIReplayBuffer;
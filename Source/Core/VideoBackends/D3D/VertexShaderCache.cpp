@@ -293,6 +293,7 @@ bool VertexShaderCache::SetShader(D3DVertexFormat* vertex_format)
     return SetUberShader(vertex_format);
 
   VertexShaderUid uid = GetVertexShaderUid();
+  ClearUnusedVertexShaderUidBits(APIType::D3D, &uid);
   if (last_entry && uid == last_uid)
   {
     if (last_entry->pending)
@@ -346,7 +346,8 @@ void XFBEncoder::Encode(u8* dst, u32 width, u32 height, const EFBRectangle& srcR
   // Transfer staging buffer to GameCube/Wii RAM
 
   D3D11_MAPPED_SUBRESOURCE map = {0};
-  hr = D3D::context->Map(m_outStage, 0, D3D11_MAP_READ, 0, &map);
+  ID3D11DeviceContext* const immediate_context = D3D::GetImmediateContext();
+  hr = immediate_context->Map(m_outStage, 0, D3D11_MAP_READ, 0, &map);
   CHECK(SUCCEEDED(hr), "map staging buffer");
 
   u8* src = (u8*)map.pData;
@@ -357,7 +358,7 @@ void XFBEncoder::Encode(u8* dst, u32 width, u32 height, const EFBRectangle& srcR
     src += map.RowPitch;
   }
 
-  D3D::context->Unmap(m_outStage, 0);
+  immediate_context->Unmap(m_outStage, 0);
 
   // Restore API
   g_renderer->RestoreAPIState();
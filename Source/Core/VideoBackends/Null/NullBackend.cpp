@@ -47,6 +47,10 @@ void VideoBackend::InitBackendInfo()
   g_Config.backend_info.bSupportsGPUTextureDecoding = false;
   g_Config.backend_info.bSupportsST3CTextures = false;
   g_Config.backend_info.bSupportsBPTCTextures = false;
+  g_Config.backend_info.bSupportsVSLayerOutput = false;
+  g_Config.backend_info.bSupportsMergedDraws = false;
+  g_Config.backend_info.bSupportsMultiDrawIndirect = false;
+  g_Config.backend_info.bSupports32BitIndices = false;
 
   // aamodes: We only support 1 sample, so no MSAA
   g_Config.backend_info.Adapters.clear();
@@ -5,6 +5,7 @@
 #include "VideoBackends/Null/ShaderCache.h"
 
 #include "VideoCommon/Debugger.h"
+#include "VideoCommon/StageTimers.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/VideoCommon.h"
 
@@ -35,6 +36,7 @@ void ShaderCache<Uid>::Clear()
 template <typename Uid>
 bool ShaderCache<Uid>::SetShader(PrimitiveType primitive_type)
 {
+  StageTimers::Scope stage_scope(StageTimers::Stage::ShaderGeneration);
   Uid uid = GetUid(primitive_type, APIType::OpenGL);
 
   // Check if the shader is already set
@@ -27,6 +27,7 @@
 #include "VideoBackends/OGL/TextureConverter.h"
 #include "VideoBackends/OGL/VROGL.h"
 
+#include "VideoCommon/Foveation.h"
 #include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/VR.h"
 #include "VideoCommon/VertexShaderGen.h"
@@ -38,6 +39,7 @@ int FramebufferManager::m_targetWidth;
 int FramebufferManager::m_targetHeight;
 int FramebufferManager::m_msaaSamples;
 bool FramebufferManager::m_enable_stencil_buffer;
+GLuint FramebufferManager::m_shading_rate_image;
 
 GLenum FramebufferManager::m_textureType;
 std::vector<GLuint> FramebufferManager::m_efbFramebuffer;
@@ -226,6 +228,10 @@ FramebufferManager::FramebufferManager(int targetWidth, int targetHeight, int ms
 
   VR_StartFramebuffer(m_targetWidth, m_targetHeight);
 
+  m_shading_rate_image = 0;
+  if (Foveation::IsEnabled() && g_ogl_config.bSupportsShadingRateImage)
+    CreateShadingRateImage();
+
   // EFB framebuffer is currently bound, make sure to clear it before use.
   glViewport(0, 0, m_targetWidth, m_targetHeight);
   glScissor(0, 0, m_targetWidth, m_targetHeight);
@@ -476,6 +482,56 @@ FramebufferManager::~FramebufferManager()
   m_EfbPokes_VBO = 0;
   m_EfbPokes_VAO = 0;
   m_EfbPokes.Destroy();
+
+  if (m_shading_rate_image != 0)
+  {
+    SetFoveationEnabled(false);
+    glDeleteTextures(1, &m_shading_rate_image);
+    m_shading_rate_image = 0;
+  }
+}
+
+void FramebufferManager::CreateShadingRateImage()
+{
+  GLint texel_width = 16;
+  GLint texel_height = 16;
+  glGetIntegerv(GL_SHADING_RATE_IMAGE_TEXEL_WIDTH_NV, &texel_width);
+  glGetIntegerv(GL_SHADING_RATE_IMAGE_TEXEL_HEIGHT_NV, &texel_height);
+  const u32 width = (m_targetWidth + texel_width - 1) / texel_width;
+  const u32 height = (m_targetHeight + texel_height - 1) / texel_height;
+  const std::vector<u8> map =
+      Foveation::GenerateRateMap(width, height, m_EFBLayers, g_ActiveConfig.iFoveation);
+
+  // The layer of each primitive picks the layer of the image, so each eye has its own map.
+  glActiveTexture(GL_TEXTURE9);
+  glGenTextures(1, &m_shading_rate_image);
+  glBindTexture(GL_TEXTURE_2D_ARRAY, m_shading_rate_image);
+  glTexStorage3D(GL_TEXTURE_2D_ARRAY, 1, GL_R8UI, width, height, m_EFBLayers);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0, width, height, m_EFBLayers, GL_RED_INTEGER,
+                  GL_UNSIGNED_BYTE, map.data());
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+  // Only viewport 0 is used for rendering the EFB.
+  static const GLenum palette[Foveation::NUM_RATES] = {
+      GL_SHADING_RATE_1_INVOCATION_PER_PIXEL_NV, GL_SHADING_RATE_1_INVOCATION_PER_2X2_PIXELS_NV,
+      GL_SHADING_RATE_1_INVOCATION_PER_4X4_PIXELS_NV};
+  glShadingRateImagePaletteNV(0, 0, Foveation::NUM_RATES, palette);
+  glBindShadingRateImageNV(m_shading_rate_image);
+
+  INFO_LOG(VIDEO, "Foveated rendering with %ux%u tiles of %dx%d pixels", width, height,
+           texel_width, texel_height);
+}
+
+void FramebufferManager::SetFoveationEnabled(bool enabled)
+{
+  if (m_shading_rate_image == 0)
+    return;
+
+  if (enabled)
+    glEnable(GL_SHADING_RATE_IMAGE_NV);
+  else
+    glDisable(GL_SHADING_RATE_IMAGE_NV);
 }
 
 GLuint FramebufferManager::GetEFBColorTexture(const EFBRectangle& sourceRc)
@@ -108,6 +108,10 @@ public:
 
   static void SwapAsyncFrontBuffers();
 
+  // Shades the VR eye buffers with the foveation map, when the GPU supports it.
+  // Only game draws to the EFB are foveated, so this is turned off for the utility draws.
+  static void SetFoveationEnabled(bool enabled);
+
   static GLuint m_eyeFramebuffer[2];
   static GLuint m_frontBuffer[2];
   static bool m_stereo3d;
@@ -122,6 +126,7 @@ private:
                                                  unsigned int target_height,
                                                  unsigned int layers) override;
   std::pair<u32, u32> GetTargetSize() const override;
+  void CreateShadingRateImage();
 
   void CopyToRealXFB(u32 xfbAddr, u32 fbStride, u32 fbHeight, const EFBRectangle& sourceRc,
                      float Gamma) override;
@@ -140,6 +145,9 @@ private:
 
   static bool m_enable_stencil_buffer;
 
+  // Foveation map of the EFB layers, an index into the shading rate palette for each tile
+  static GLuint m_shading_rate_image;
+
   // Only used in MSAA mode, TODO: try to avoid them
   static std::vector<GLuint> m_resolvedFramebuffer;
   static GLuint m_resolvedColorTexture;
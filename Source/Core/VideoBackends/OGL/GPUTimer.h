@@ -4,11 +4,10 @@
 
 #pragma once
 
-#include "Common/GL/GLExtensions/GLExtensions.h"
+#include <array>
 
-#ifndef GL_TIME_ELAPSED
-#define GL_TIME_ELAPSED 0x88BF
-#endif
+#include "Common/CommonTypes.h"
+#include "Common/GL/GLExtensions/GLExtensions.h"
 
 namespace OGL
 {
@@ -102,4 +101,75 @@ private:
   bool m_started = false;
   bool m_has_result = false;
 };
+
+/*
+ * Measures the GPU time of whole frames with timestamp queries. Unlike GPUTimer, this never
+ * stalls: a frame's time can only be popped once the GPU has finished it, a few frames later.
+ * If the GPU falls too far behind, the oldest frames are dropped instead of waited for.
+ *
+ * Timestamps don't interfere with GL_TIME_ELAPSED, so this can be used alongside GPUTimer.
+ * Requires GL_ARB_timer_query.
+ */
+class GPUFrameTimer final
+{
+public:
+  GPUFrameTimer() { glGenQueries(static_cast<GLsizei>(m_queries.size()), m_queries.data()); }
+  ~GPUFrameTimer() { glDeleteQueries(static_cast<GLsizei>(m_queries.size()), m_queries.data()); }
+  static bool IsSupported() { return GLExtensions::Supports("GL_ARB_timer_query"); }
+  void BeginFrame()
+  {
+    if (m_pending == NUM_FRAMES)
+    {
+      m_first = (m_first + 1) % NUM_FRAMES;
+      m_pending--;
+    }
+
+    glQueryCounter(m_queries[m_next * 2], GL_TIMESTAMP);
+    m_in_frame = true;
+  }
+
+  void EndFrame()
+  {
+    if (!m_in_frame)
+      return;
+
+    glQueryCounter(m_queries[m_next * 2 + 1], GL_TIMESTAMP);
+    m_next = (m_next + 1) % NUM_FRAMES;
+    m_pending++;
+    m_in_frame = false;
+  }
+
+  // Gets the time of the oldest frame the GPU has finished, if any.
+  bool PopFrameTime(double* milliseconds)
+  {
+    if (m_pending == 0)
+      return false;
+
+    GLuint available = GL_FALSE;
+    glGetQueryObjectuiv(m_queries[m_first * 2 + 1], GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available)
+      return false;
+
+    GLuint64 begin = 0, end = 0;
+    glGetQueryObjectui64v(m_queries[m_first * 2], GL_QUERY_RESULT, &begin);
+    glGetQueryObjectui64v(m_queries[m_first * 2 + 1], GL_QUERY_RESULT, &end);
+    *milliseconds = static_cast<double>(end - begin) / 1000000.0;
+
+    m_first = (m_first + 1) % NUM_FRAMES;
+    m_pending--;
+    return true;
+  }
+
+private:
+  enum
+  {
+    NUM_FRAMES = 8
+  };
+
+  std::array<GLuint, NUM_FRAMES * 2> m_queries;
+  u32 m_first = 0;
+  u32 m_next = 0;
+  u32 m_pending = 0;
+  bool m_in_frame = false;
+};
 }  // namespace OGL
@@ -2,6 +2,8 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <cstring>
+
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
 #include "Common/GL/GLInterfaceBase.h"
@@ -11,9 +13,11 @@
 #include "VideoBackends/OGL/OGLTexture.h"
 #include "VideoBackends/OGL/Render.h"
 #include "VideoBackends/OGL/SamplerCache.h"
+#include "VideoBackends/OGL/StreamBuffer.h"
 #include "VideoBackends/OGL/TextureCache.h"
 
 #include "VideoCommon/ImageWrite.h"
+#include "VideoCommon/Statistics.h"
 #include "VideoCommon/TextureConfig.h"
 
 namespace OGL
@@ -223,6 +227,21 @@ void OGLTexture::Load(u32 level, u32 width, u32 height, u32 row_length, const u8
   glActiveTexture(GL_TEXTURE9);
   glBindTexture(GL_TEXTURE_2D_ARRAY, m_texId);
 
+  // Copy the data into the upload buffer, and pass its offset instead of the pointer.
+  StreamBuffer* upload_buffer = TextureCache::GetInstance()->GetTextureUploadBuffer();
+  const bool use_upload_buffer =
+      upload_buffer && buffer_size <= TextureCache::MAX_TEXTURE_UPLOAD_SIZE;
+  if (use_upload_buffer)
+  {
+    const u32 upload_size = static_cast<u32>(buffer_size);
+    auto mapping = upload_buffer->Map(upload_size, 16);
+    std::memcpy(mapping.first, buffer, buffer_size);
+    upload_buffer->Unmap(upload_size);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, upload_buffer->m_buffer);
+    buffer = reinterpret_cast<const u8*>(static_cast<uintptr_t>(mapping.second));
+    ADDSTAT(stats.thisFrame.bytesTextureStreamed, upload_size);
+  }
+
   if (row_length != width)
     glPixelStorei(GL_UNPACK_ROW_LENGTH, row_length);
 
@@ -258,6 +277,8 @@ void OGLTexture::Load(u32 level, u32 width, u32 height, u32 row_length, const u8
 
   if (row_length != width)
     glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+  if (use_upload_buffer)
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
 
   SetStage();
 }
@@ -4,7 +4,6 @@
 
 #include <memory>
 
-#include "Common/CommonFuncs.h"
 #include "Common/CommonTypes.h"
 #include "Common/GL/GLInterfaceBase.h"
 #include "Common/GL/GLUtil.h"
@@ -55,8 +54,8 @@ void PerfQuery::FlushResults()
 
 void PerfQuery::ResetQuery()
 {
-  m_query_count = 0;
-  std::fill_n(m_results, ArraySize(m_results), 0);
+  if (ResetResults())
+    m_query_count = 0;
 }
 
 u32 PerfQuery::GetQueryResult(PerfQueryType type)
@@ -65,19 +64,19 @@ u32 PerfQuery::GetQueryResult(PerfQueryType type)
 
   if (type == PQ_ZCOMP_INPUT_ZCOMPLOC || type == PQ_ZCOMP_OUTPUT_ZCOMPLOC)
   {
-    result = m_results[PQG_ZCOMP_ZCOMPLOC];
+    result = GetResult(PQG_ZCOMP_ZCOMPLOC);
   }
   else if (type == PQ_ZCOMP_INPUT || type == PQ_ZCOMP_OUTPUT)
   {
-    result = m_results[PQG_ZCOMP];
+    result = GetResult(PQG_ZCOMP);
   }
   else if (type == PQ_BLEND_INPUT)
   {
-    result = m_results[PQG_ZCOMP] + m_results[PQG_ZCOMP_ZCOMPLOC];
+    result = GetResult(PQG_ZCOMP) + GetResult(PQG_ZCOMP_ZCOMPLOC);
   }
   else if (type == PQ_EFB_COPY_CLOCKS)
   {
-    result = m_results[PQG_EFB_COPY_CLOCKS];
+    result = GetResult(PQG_EFB_COPY_CLOCKS);
   }
 
   return result;
@@ -165,7 +164,7 @@ void PerfQueryGL::FlushOne()
   if (g_ActiveConfig.iMultisamples > 1)
     result /= g_ActiveConfig.iMultisamples;
 
-  m_results[entry.query_type] += result;
+  AddResult(entry.query_type, result);
 
   m_query_read_pos = (m_query_read_pos + 1) % m_query_buffer.size();
   --m_query_count;
@@ -178,6 +177,11 @@ void PerfQueryGL::FlushResults()
     FlushOne();
 }
 
+void PerfQueryGL::PollResults()
+{
+  WeakFlush();
+}
+
 PerfQueryGLESNV::PerfQueryGLESNV()
 {
   for (ActiveQuery& query : m_query_buffer)
@@ -252,8 +256,9 @@ void PerfQueryGLESNV::FlushOne()
   // NOTE: Reported pixel metrics should be referenced to native resolution
   // TODO: Dropping the lower 2 bits from this count should be closer to actual
   // hardware behavior when drawing triangles.
-  m_results[entry.query_type] += static_cast<u64>(result) * EFB_WIDTH * EFB_HEIGHT /
-                                 (g_renderer->GetTargetWidth() * g_renderer->GetTargetHeight());
+  AddResult(entry.query_type,
+            static_cast<u32>(static_cast<u64>(result) * EFB_WIDTH * EFB_HEIGHT /
+                             (g_renderer->GetTargetWidth() * g_renderer->GetTargetHeight())));
 
   m_query_read_pos = (m_query_read_pos + 1) % m_query_buffer.size();
   --m_query_count;
@@ -266,4 +271,9 @@ void PerfQueryGLESNV::FlushResults()
     FlushOne();
 }
 
+void PerfQueryGLESNV::PollResults()
+{
+  WeakFlush();
+}
+
 }  // namespace
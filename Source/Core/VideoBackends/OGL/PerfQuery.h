@@ -56,6 +56,7 @@ public:
   void EnableQuery(PerfQueryGroup type) override;
   void DisableQuery(PerfQueryGroup type) override;
   void FlushResults() override;
+  void PollResults() override;
 
 private:
   void WeakFlush();
@@ -74,6 +75,7 @@ public:
   void EnableQuery(PerfQueryGroup type) override;
   void DisableQuery(PerfQueryGroup type) override;
   void FlushResults() override;
+  void PollResults() override;
 
 private:
   void WeakFlush();
@@ -4,6 +4,10 @@
 
 #include "VideoBackends/OGL/PostProcessing.h"
 
+#include <algorithm>
+#include <string>
+#include <vector>
+
 #include "Common/CommonTypes.h"
 #include "Common/GL/GLUtil.h"
 #include "Common/Logging/Log.h"
@@ -20,12 +24,17 @@
 
 namespace OGL
 {
+using RenderPass = PostProcessingShaderConfiguration::RenderPass;
+static constexpr u32 MAX_INPUTS = PostProcessingShaderConfiguration::MAX_PASS_INPUTS;
+
 static const char s_vertex_shader[] = "out vec2 uv0;\n"
+                                      "out vec2 uv1;\n"
                                       "uniform vec4 src_rect;\n"
                                       "void main(void) {\n"
                                       "	vec2 rawpos = vec2(gl_VertexID&1, gl_VertexID&2);\n"
                                       "	gl_Position = vec4(rawpos*2.0-1.0, 0.0, 1.0);\n"
                                       "	uv0 = rawpos * src_rect.zw + src_rect.xy;\n"
+                                      "	uv1 = rawpos;\n"
                                       "}\n";
 
 OpenGLPostProcessing::OpenGLPostProcessing() : m_initialized(false)
@@ -35,7 +44,8 @@ OpenGLPostProcessing::OpenGLPostProcessing() : m_initialized(false)
 
 OpenGLPostProcessing::~OpenGLPostProcessing()
 {
-  m_shader.Destroy();
+  DestroyPrograms();
+  DestroyTargets();
 }
 
 void OpenGLPostProcessing::BlitFromTexture(TargetRectangle src, TargetRectangle dst,
@@ -44,83 +54,149 @@ void OpenGLPostProcessing::BlitFromTexture(TargetRectangle src, TargetRectangle
 {
   ApplyShader();
 
-  glViewport(dst.left, dst.bottom, dst.GetWidth(), dst.GetHeight());
-
   OpenGL_BindAttributelessVAO();
 
-  m_shader.Bind();
-
-  glUniform4f(m_uniform_resolution, (float)src_width, (float)src_height, 1.0f / (float)src_width,
-              1.0f / (float)src_height);
-  glUniform4f(m_uniform_src_rect, src.left / (float)src_width, src.bottom / (float)src_height,
-              src.GetWidth() / (float)src_width, src.GetHeight() / (float)src_height);
-  glUniform1ui(m_uniform_time, (GLuint)m_timer.GetTimeElapsed());
-  glUniform1i(m_uniform_layer, layer);
-
   if (m_config.IsDirty())
   {
+    for (PassProgram& program : m_programs)
+      UploadOptions(&program);
     for (auto& it : m_config.GetOptions())
+      it.second.m_dirty = false;
+    m_config.SetDirty(false);
+  }
+
+  // Earlier passes render to the intermediate targets, and the last one to the framebuffer bound
+  // by the caller.
+  GLint output_framebuffer = 0;
+  if (m_programs.size() > 1)
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &output_framebuffer);
+
+  const std::vector<RenderPass>& passes = m_config.GetPasses();
+  for (size_t i = 0; i < m_programs.size(); i++)
+  {
+    const RenderPass& pass = passes[i];
+    const PassProgram& program = m_programs[i];
+    if (i + 1 == m_programs.size())
     {
-      if (it.second.m_dirty)
+      if (m_programs.size() > 1)
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, output_framebuffer);
+      glViewport(dst.left, dst.bottom, dst.GetWidth(), dst.GetHeight());
+    }
+    else
+    {
+      IntermediateTarget* target = &m_targets[pass.m_output_target];
+      ResizeTarget(target, std::max(static_cast<int>(dst.GetWidth() * pass.m_output_scale), 1),
+                   std::max(static_cast<int>(dst.GetHeight() * pass.m_output_scale), 1));
+      glBindFramebuffer(GL_DRAW_FRAMEBUFFER, target->framebuffer);
+      glViewport(0, 0, target->width, target->height);
+    }
+
+    float input_resolution[MAX_INPUTS][4] = {};
+    float input_rect[MAX_INPUTS][4] = {};
+    GLint input_layer[MAX_INPUTS] = {};
+    for (size_t j = 0; j < pass.m_inputs.size(); j++)
+    {
+      GLuint texture = src_texture;
+      float width = static_cast<float>(src_width);
+      float height = static_cast<float>(src_height);
+      if (pass.m_inputs[j].m_type == RenderPass::INPUT_COLOR_BUFFER)
+      {
+        input_rect[j][0] = src.left / width;
+        input_rect[j][1] = src.bottom / height;
+        input_rect[j][2] = src.GetWidth() / width;
+        input_rect[j][3] = src.GetHeight() / height;
+        input_layer[j] = layer;
+      }
+      else
       {
-        switch (it.second.m_type)
-        {
-        case PostProcessingShaderConfiguration::ConfigurationOption::OptionType::OPTION_BOOL:
-          glUniform1i(m_uniform_bindings[it.first], it.second.m_bool_value);
-          break;
-        case PostProcessingShaderConfiguration::ConfigurationOption::OptionType::OPTION_INTEGER:
-          switch (it.second.m_integer_values.size())
-          {
-          case 1:
-            glUniform1i(m_uniform_bindings[it.first], it.second.m_integer_values[0]);
-            break;
-          case 2:
-            glUniform2i(m_uniform_bindings[it.first], it.second.m_integer_values[0],
-                        it.second.m_integer_values[1]);
-            break;
-          case 3:
-            glUniform3i(m_uniform_bindings[it.first], it.second.m_integer_values[0],
-                        it.second.m_integer_values[1], it.second.m_integer_values[2]);
-            break;
-          case 4:
-            glUniform4i(m_uniform_bindings[it.first], it.second.m_integer_values[0],
-                        it.second.m_integer_values[1], it.second.m_integer_values[2],
-                        it.second.m_integer_values[3]);
-            break;
-          }
-          break;
-        case PostProcessingShaderConfiguration::ConfigurationOption::OptionType::OPTION_FLOAT:
-          switch (it.second.m_float_values.size())
-          {
-          case 1:
-            glUniform1f(m_uniform_bindings[it.first], it.second.m_float_values[0]);
-            break;
-          case 2:
-            glUniform2f(m_uniform_bindings[it.first], it.second.m_float_values[0],
-                        it.second.m_float_values[1]);
-            break;
-          case 3:
-            glUniform3f(m_uniform_bindings[it.first], it.second.m_float_values[0],
-                        it.second.m_float_values[1], it.second.m_float_values[2]);
-            break;
-          case 4:
-            glUniform4f(m_uniform_bindings[it.first], it.second.m_float_values[0],
-                        it.second.m_float_values[1], it.second.m_float_values[2],
-                        it.second.m_float_values[3]);
-            break;
-          }
-          break;
-        }
-        it.second.m_dirty = false;
+        // Intermediate targets are drawn in full, and only hold the layer being drawn.
+        const IntermediateTarget& source =
+            m_targets[passes[pass.m_inputs[j].m_pass_index].m_output_target];
+        texture = source.texture;
+        width = static_cast<float>(source.width);
+        height = static_cast<float>(source.height);
+        input_rect[j][2] = 1.0f;
+        input_rect[j][3] = 1.0f;
       }
+      input_resolution[j][0] = width;
+      input_resolution[j][1] = height;
+      input_resolution[j][2] = 1.0f / width;
+      input_resolution[j][3] = 1.0f / height;
+
+      glActiveTexture(GL_TEXTURE9 + static_cast<GLenum>(j));
+      glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
+      g_sampler_cache->BindLinearSampler(9 + static_cast<int>(j));
     }
-    m_config.SetDirty(false);
+
+    program.shader.Bind();
+
+    // The unsuffixed uniforms describe the first input.
+    glUniform4fv(program.uniform_resolution, 1, input_resolution[0]);
+    glUniform4fv(program.uniform_src_rect, 1, input_rect[0]);
+    glUniform1ui(program.uniform_time, (GLuint)m_timer.GetTimeElapsed());
+    glUniform1i(program.uniform_layer, layer);
+    glUniform4fv(program.uniform_input_resolution, MAX_INPUTS, input_resolution[0]);
+    glUniform4fv(program.uniform_input_rect, MAX_INPUTS, input_rect[0]);
+    glUniform1iv(program.uniform_input_layer, MAX_INPUTS, input_layer);
+
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
   }
+}
 
-  glActiveTexture(GL_TEXTURE9);
-  glBindTexture(GL_TEXTURE_2D_ARRAY, src_texture);
-  g_sampler_cache->BindLinearSampler(9);
-  glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+void OpenGLPostProcessing::UploadOptions(PassProgram* program)
+{
+  program->shader.Bind();
+  for (const auto& it : m_config.GetOptions())
+  {
+    if (!it.second.m_dirty)
+      continue;
+
+    const GLuint location = program->uniform_bindings[it.first];
+    switch (it.second.m_type)
+    {
+    case PostProcessingShaderConfiguration::ConfigurationOption::OptionType::OPTION_BOOL:
+      glUniform1i(location, it.second.m_bool_value);
+      break;
+    case PostProcessingShaderConfiguration::ConfigurationOption::OptionType::OPTION_INTEGER:
+      switch (it.second.m_integer_values.size())
+      {
+      case 1:
+        glUniform1i(location, it.second.m_integer_values[0]);
+        break;
+      case 2:
+        glUniform2i(location, it.second.m_integer_values[0], it.second.m_integer_values[1]);
+        break;
+      case 3:
+        glUniform3i(location, it.second.m_integer_values[0], it.second.m_integer_values[1],
+                    it.second.m_integer_values[2]);
+        break;
+      case 4:
+        glUniform4i(location, it.second.m_integer_values[0], it.second.m_integer_values[1],
+                    it.second.m_integer_values[2], it.second.m_integer_values[3]);
+        break;
+      }
+      break;
+    case PostProcessingShaderConfiguration::ConfigurationOption::OptionType::OPTION_FLOAT:
+      switch (it.second.m_float_values.size())
+      {
+      case 1:
+        glUniform1f(location, it.second.m_float_values[0]);
+        break;
+      case 2:
+        glUniform2f(location, it.second.m_float_values[0], it.second.m_float_values[1]);
+        break;
+      case 3:
+        glUniform3f(location, it.second.m_float_values[0], it.second.m_float_values[1],
+                    it.second.m_float_values[2]);
+        break;
+      case 4:
+        glUniform4f(location, it.second.m_float_values[0], it.second.m_float_values[1],
+                    it.second.m_float_values[2], it.second.m_float_values[3]);
+        break;
+      }
+      break;
+    }
+  }
 }
 
 void OpenGLPostProcessing::ApplyShader()
@@ -129,35 +205,101 @@ void OpenGLPostProcessing::ApplyShader()
   if (m_initialized && m_config.GetShader() == g_ActiveConfig.sPostProcessingShader)
     return;
 
-  m_shader.Destroy();
-  m_uniform_bindings.clear();
-
-  // load shader code
-  std::string main_code = m_config.LoadShader();
-  std::string options_code = LoadShaderOptions();
-  std::string code = m_glsl_header + options_code + main_code;
+  DestroyPrograms();
 
-  // and compile it
-  if (!ProgramShaderCache::CompileShader(m_shader, s_vertex_shader, code))
+  // load shader code, and compile a program for each pass
+  std::string code = m_config.LoadShader();
+  if (!CompilePrograms(code))
   {
     ERROR_LOG(VIDEO, "Failed to compile post-processing shader %s", m_config.GetShader().c_str());
     Config::SetCurrent(Config::GFX_ENHANCE_POST_SHADER, std::string(""));
     code = m_config.LoadShader();
-    ProgramShaderCache::CompileShader(m_shader, s_vertex_shader, code);
+    CompilePrograms(code);
   }
 
-  // read uniform locations
-  m_uniform_resolution = glGetUniformLocation(m_shader.glprogid, "resolution");
-  m_uniform_time = glGetUniformLocation(m_shader.glprogid, "time");
-  m_uniform_src_rect = glGetUniformLocation(m_shader.glprogid, "src_rect");
-  m_uniform_layer = glGetUniformLocation(m_shader.glprogid, "layer");
+  // The targets are sized on the first blit.
+  DestroyTargets();
+  m_targets.resize(m_config.GetIntermediateTargetCount());
+  m_initialized = true;
+}
 
-  for (const auto& it : m_config.GetOptions())
+bool OpenGLPostProcessing::CompilePrograms(const std::string& code)
+{
+  const std::string common_code = m_glsl_header + LoadShaderOptions() + code;
+  for (const RenderPass& pass : m_config.GetPasses())
+  {
+    std::string pass_code = common_code;
+    if (pass.m_entry_point != "main")
+      pass_code += StringFromFormat("\nvoid main()\n{\n\t%s();\n}\n", pass.m_entry_point.c_str());
+
+    PassProgram program;
+    if (!ProgramShaderCache::CompileShader(program.shader, s_vertex_shader, pass_code))
+    {
+      program.shader.Destroy();
+      DestroyPrograms();
+      return false;
+    }
+
+    // read uniform locations
+    const GLuint id = program.shader.glprogid;
+    program.uniform_resolution = glGetUniformLocation(id, "resolution");
+    program.uniform_time = glGetUniformLocation(id, "time");
+    program.uniform_src_rect = glGetUniformLocation(id, "src_rect");
+    program.uniform_layer = glGetUniformLocation(id, "layer");
+    program.uniform_input_resolution = glGetUniformLocation(id, "input_resolution");
+    program.uniform_input_rect = glGetUniformLocation(id, "input_rect");
+    program.uniform_input_layer = glGetUniformLocation(id, "input_layer");
+
+    for (const auto& it : m_config.GetOptions())
+    {
+      std::string glsl_name = "options." + it.first;
+      program.uniform_bindings[it.first] = glGetUniformLocation(id, glsl_name.c_str());
+    }
+    m_programs.push_back(std::move(program));
+  }
+  return true;
+}
+
+void OpenGLPostProcessing::DestroyPrograms()
+{
+  for (PassProgram& program : m_programs)
+    program.shader.Destroy();
+  m_programs.clear();
+}
+
+void OpenGLPostProcessing::DestroyTargets()
+{
+  for (IntermediateTarget& target : m_targets)
   {
-    std::string glsl_name = "options." + it.first;
-    m_uniform_bindings[it.first] = glGetUniformLocation(m_shader.glprogid, glsl_name.c_str());
+    if (target.texture == 0)
+      continue;
+    glDeleteFramebuffers(1, &target.framebuffer);
+    glDeleteTextures(1, &target.texture);
   }
-  m_initialized = true;
+  m_targets.clear();
+}
+
+void OpenGLPostProcessing::ResizeTarget(IntermediateTarget* target, int width, int height)
+{
+  if (target->texture != 0 && target->width == width && target->height == height)
+    return;
+
+  if (target->texture == 0)
+  {
+    glGenTextures(1, &target->texture);
+    glGenFramebuffers(1, &target->framebuffer);
+  }
+  target->width = width;
+  target->height = height;
+
+  glActiveTexture(GL_TEXTURE9);
+  glBindTexture(GL_TEXTURE_2D_ARRAY, target->texture);
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, 0);
+  glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, width, height, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+               nullptr);
+
+  glBindFramebuffer(GL_DRAW_FRAMEBUFFER, target->framebuffer);
+  glFramebufferTextureLayer(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, target->texture, 0, 0);
 }
 
 void OpenGLPostProcessing::CreateHeader()
@@ -168,27 +310,39 @@ void OpenGLPostProcessing::CreateHeader()
       // Texture sampler
       "SAMPLER_BINDING(8) uniform sampler2D samp8;\n"
       "SAMPLER_BINDING(9) uniform sampler2DArray samp9;\n"
+      // Other inputs of the pass
+      "SAMPLER_BINDING(10) uniform sampler2DArray samp10;\n"
+      "SAMPLER_BINDING(11) uniform sampler2DArray samp11;\n"
+      "SAMPLER_BINDING(12) uniform sampler2DArray samp12;\n"
 
       // Output variable
       "out float4 ocol0;\n"
       // Input coordinates
       "in float2 uv0;\n"
+      // Output coordinates, 0 to 1
+      "in float2 uv1;\n"
       // Resolution
       "uniform float4 resolution;\n"
       // Time
       "uniform uint time;\n"
       // Layer
       "uniform int layer;\n"
+      // Size, area read and layer of each input
+      "uniform float4 input_resolution[4];\n"
+      "uniform float4 input_rect[4];\n"
+      "uniform int input_layer[4];\n"
 
       // Interfacing functions
+      // Sample, SampleLocation, SampleOffset, GetResolution and GetCoordinates read the first
+      // input of the pass, which is the color buffer for single pass shaders.
       "float4 Sample()\n"
       "{\n"
-      "\treturn texture(samp9, float3(uv0, layer));\n"
+      "\treturn texture(samp9, float3(uv0, input_layer[0]));\n"
       "}\n"
 
       "float4 SampleLocation(float2 location)\n"
       "{\n"
-      "\treturn texture(samp9, float3(location, layer));\n"
+      "\treturn texture(samp9, float3(location, input_layer[0]));\n"
       "}\n"
 
       "float4 SampleLayer(int layer)\n"
@@ -196,7 +350,39 @@ void OpenGLPostProcessing::CreateHeader()
       "\treturn texture(samp9, float3(uv0, layer));\n"
       "}\n"
 
-      "#define SampleOffset(offset) textureOffset(samp9, float3(uv0, layer), offset)\n"
+      "#define SampleOffset(offset) textureOffset(samp9, float3(uv0, input_layer[0]), offset)\n"
+
+      "float2 GetInputCoordinates(int input)\n"
+      "{\n"
+      "\treturn uv1 * input_rect[input].zw + input_rect[input].xy;\n"
+      "}\n"
+
+      "float4 SampleInputLocation(int input, float2 location)\n"
+      "{\n"
+      "\tfloat3 coords = float3(location, input_layer[input]);\n"
+      "\tif (input == 1)\n"
+      "\t\treturn texture(samp10, coords);\n"
+      "\telse if (input == 2)\n"
+      "\t\treturn texture(samp11, coords);\n"
+      "\telse if (input == 3)\n"
+      "\t\treturn texture(samp12, coords);\n"
+      "\treturn texture(samp9, coords);\n"
+      "}\n"
+
+      "float4 SampleInput(int input)\n"
+      "{\n"
+      "\treturn SampleInputLocation(input, GetInputCoordinates(input));\n"
+      "}\n"
+
+      "float2 GetInputResolution(int input)\n"
+      "{\n"
+      "\treturn input_resolution[input].xy;\n"
+      "}\n"
+
+      "float2 GetInputInvResolution(int input)\n"
+      "{\n"
+      "\treturn input_resolution[input].zw;\n"
+      "}\n"
 
       "float4 SampleFontLocation(float2 location)\n"
       "{\n"
@@ -239,7 +425,6 @@ void OpenGLPostProcessing::CreateHeader()
 
 std::string OpenGLPostProcessing::LoadShaderOptions()
 {
-  m_uniform_bindings.clear();
   if (m_config.GetOptions().empty())
     return "";
 
@@ -270,8 +455,6 @@ std::string OpenGLPostProcessing::LoadShaderOptions()
       else
         glsl_options += StringFromFormat("float%d %s;\n", count, it.first.c_str());
     }
-
-    m_uniform_bindings[it.first] = 0;
   }
 
   glsl_options += "};\n";
@@ -6,6 +6,7 @@
 
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "Common/GL/GLUtil.h"
 
@@ -27,18 +28,41 @@ public:
   void ApplyShader();
 
 private:
+  // The program of a pass, compiled with its entry point as main()
+  struct PassProgram
+  {
+    SHADER shader;
+    GLuint uniform_resolution;
+    GLuint uniform_src_rect;
+    GLuint uniform_time;
+    GLuint uniform_layer;
+    GLuint uniform_input_resolution;
+    GLuint uniform_input_rect;
+    GLuint uniform_input_layer;
+    std::unordered_map<std::string, GLuint> uniform_bindings;
+  };
+
+  // Single layer texture holding the output of a pass, shared by the passes of the same scale
+  struct IntermediateTarget
+  {
+    GLuint texture = 0;
+    GLuint framebuffer = 0;
+    int width = 0;
+    int height = 0;
+  };
+
   bool m_initialized;
-  SHADER m_shader;
-  GLuint m_uniform_resolution;
-  GLuint m_uniform_src_rect;
-  GLuint m_uniform_time;
-  GLuint m_uniform_layer;
+  std::vector<PassProgram> m_programs;
+  std::vector<IntermediateTarget> m_targets;
   std::string m_glsl_header;
 
-  std::unordered_map<std::string, GLuint> m_uniform_bindings;
-
   void CreateHeader();
   std::string LoadShaderOptions();
+  bool CompilePrograms(const std::string& code);
+  void DestroyPrograms();
+  void DestroyTargets();
+  void ResizeTarget(IntermediateTarget* target, int width, int height);
+  void UploadOptions(PassProgram* program);
 };
 
 }  // namespace
@@ -4,6 +4,8 @@
 
 #include "VideoBackends/OGL/ProgramShaderCache.h"
 
+#include <algorithm>
+#include <cinttypes>
 #include <limits>
 #include <memory>
 #include <string>
@@ -12,7 +14,9 @@
 #include "Common/CommonTypes.h"
 #include "Common/FileUtil.h"
 #include "Common/GL/GLInterfaceBase.h"
+#include "Common/Hash.h"
 #include "Common/Logging/Log.h"
+#include "Common/Logging/Trace.h"
 #include "Common/MsgHandler.h"
 #include "Common/StringUtil.h"
 #include "Common/Timer.h"
@@ -44,11 +48,14 @@ static constexpr u32 INVALID_VAO = std::numeric_limits<u32>::max();
 
 std::unique_ptr<ProgramShaderCache::SharedContextAsyncShaderCompiler>
     ProgramShaderCache::s_async_compiler;
+std::vector<ProgramShaderCache::ParallelCompile> ProgramShaderCache::s_parallel_compiles;
 u32 ProgramShaderCache::s_ubo_buffer_size;
 s32 ProgramShaderCache::s_ubo_align;
 u32 ProgramShaderCache::s_last_VAO = INVALID_VAO;
 
 static std::unique_ptr<StreamBuffer> s_buffer;
+// The end of the last constants upload in s_buffer.
+static u32 s_ubo_stream_end = 0;
 static int num_failures = 0;
 
 static LinearDiskCache<SHADERUID, u8> s_program_disk_cache;
@@ -114,7 +121,7 @@ void SHADER::SetProgramVariables()
       glUniformBlockBinding(glprogid, UBERBlock_id, 4);
 
     // Bind Texture Samplers
-    for (int a = 0; a <= 9; ++a)
+    for (int a = 0; a <= 12; ++a)
     {
       std::string name = StringFromFormat(a < 8 ? "samp[%d]" : "samp%d", a);
 
@@ -189,37 +196,46 @@ void SHADER::DestroyShaders()
 
 void ProgramShaderCache::UploadConstants(bool force_upload)
 {
-  if (PixelShaderManager::dirty || VertexShaderManager::dirty || GeometryShaderManager::dirty ||
-      force_upload)
+  if (!PixelShaderManager::dirty && !VertexShaderManager::dirty && !GeometryShaderManager::dirty &&
+      !force_upload)
   {
-    auto buffer = s_buffer->Map(s_ubo_buffer_size, s_ubo_align);
-
-    memcpy(buffer.first, &PixelShaderManager::constants, sizeof(PixelShaderConstants));
-
-    memcpy(buffer.first + Common::AlignUp(sizeof(PixelShaderConstants), s_ubo_align),
-           &VertexShaderManager::constants, sizeof(VertexShaderConstants));
-
-    memcpy(buffer.first + Common::AlignUp(sizeof(PixelShaderConstants), s_ubo_align) +
-               Common::AlignUp(sizeof(VertexShaderConstants), s_ubo_align),
-           &GeometryShaderManager::constants, sizeof(GeometryShaderConstants));
-
-    s_buffer->Unmap(s_ubo_buffer_size);
-    glBindBufferRange(GL_UNIFORM_BUFFER, 1, s_buffer->m_buffer, buffer.second,
-                      sizeof(PixelShaderConstants));
-    glBindBufferRange(GL_UNIFORM_BUFFER, 2, s_buffer->m_buffer,
-                      buffer.second + Common::AlignUp(sizeof(PixelShaderConstants), s_ubo_align),
-                      sizeof(VertexShaderConstants));
-    glBindBufferRange(GL_UNIFORM_BUFFER, 3, s_buffer->m_buffer,
-                      buffer.second + Common::AlignUp(sizeof(PixelShaderConstants), s_ubo_align) +
-                          Common::AlignUp(sizeof(VertexShaderConstants), s_ubo_align),
-                      sizeof(GeometryShaderConstants));
+    return;
+  }
 
-    PixelShaderManager::dirty = false;
-    VertexShaderManager::dirty = false;
-    GeometryShaderManager::dirty = false;
+  auto buffer = s_buffer->Map(s_ubo_buffer_size, s_ubo_align);
 
-    ADDSTAT(stats.thisFrame.bytesUniformStreamed, s_ubo_buffer_size);
+  // Only the blocks that changed are streamed, the others stay bound to their last copy. That
+  // copy is overwritten once the buffer wraps around (or is orphaned, or always uploaded from the
+  // start), so everything is uploaded again then.
+  if (force_upload || buffer.second < s_ubo_stream_end)
+  {
+    PixelShaderManager::dirty = true;
+    VertexShaderManager::dirty = true;
+    GeometryShaderManager::dirty = true;
   }
+
+  u32 used_size = 0;
+  const auto upload_block = [&](GLuint index, const void* data, u32 size) {
+    memcpy(buffer.first + used_size, data, size);
+    glBindBufferRange(GL_UNIFORM_BUFFER, index, s_buffer->m_buffer, buffer.second + used_size,
+                      size);
+    used_size += static_cast<u32>(Common::AlignUp(size, s_ubo_align));
+  };
+  if (PixelShaderManager::dirty)
+    upload_block(1, &PixelShaderManager::constants, sizeof(PixelShaderConstants));
+  if (VertexShaderManager::dirty)
+    upload_block(2, &VertexShaderManager::constants, sizeof(VertexShaderConstants));
+  if (GeometryShaderManager::dirty)
+    upload_block(3, &GeometryShaderManager::constants, sizeof(GeometryShaderConstants));
+
+  s_buffer->Unmap(used_size);
+  s_ubo_stream_end = buffer.second + used_size;
+
+  PixelShaderManager::dirty = false;
+  VertexShaderManager::dirty = false;
+  GeometryShaderManager::dirty = false;
+
+  ADDSTAT(stats.thisFrame.bytesUniformStreamed, used_size);
 }
 
 SHADER* ProgramShaderCache::SetShader(PrimitiveType primitive_type,
@@ -234,6 +250,7 @@ SHADER* ProgramShaderCache::SetShader(PrimitiveType primitive_type,
   uid.vuid = GetVertexShaderUid();
   uid.guid = GetGeometryShaderUid(primitive_type);
   ClearUnusedPixelShaderUidBits(APIType::OpenGL, &uid.puid);
+  ClearUnusedVertexShaderUidBits(APIType::OpenGL, &uid.vuid);
 
   // Check if the shader is already set
   if (last_entry && uid == last_uid)
@@ -265,14 +282,15 @@ SHADER* ProgramShaderCache::SetShader(PrimitiveType primitive_type,
 
   // Can we background compile this shader? Requires background shader compiling to be enabled,
   // and all ubershaders to have been successfully compiled.
-  if (g_ActiveConfig.CanBackgroundCompileShaders() && !ubershaders.empty() && s_async_compiler)
+  const bool background_compile =
+      g_ActiveConfig.CanBackgroundCompileShaders() && !ubershaders.empty();
+  if (background_compile && s_async_compiler)
   {
     newentry.pending = true;
     s_async_compiler->QueueWorkItem(s_async_compiler->CreateWorkItem<ShaderCompileWorkItem>(uid));
     return SetUberShader(primitive_type, vertex_format);
   }
 
-  // Synchronous shader compiling.
   ShaderHostConfig host_config = ShaderHostConfig::GetCurrent();
   ShaderCode vcode = GenerateVertexShaderCode(APIType::OpenGL, host_config, uid.vuid.GetUidData());
   ShaderCode pcode = GeneratePixelShaderCode(APIType::OpenGL, host_config, uid.puid.GetUidData());
@@ -281,6 +299,17 @@ SHADER* ProgramShaderCache::SetShader(PrimitiveType primitive_type,
       !uid.guid.GetUidData()->IsPassthrough())
     gcode = GenerateGeometryShaderCode(APIType::OpenGL, host_config, uid.guid.GetUidData());
 
+  // Without shared contexts, the compiler threads of the driver can still compile in the
+  // background. RetrieveAsyncShaders picks the program up once it is done.
+  if (background_compile && g_ogl_config.bSupportsParallelShaderCompile)
+  {
+    newentry.pending = true;
+    BeginCompileShader(newentry.shader, vcode.GetBuffer(), pcode.GetBuffer(), gcode.GetBuffer());
+    s_parallel_compiles.push_back({uid, vcode.GetBuffer(), pcode.GetBuffer(), gcode.GetBuffer()});
+    return SetUberShader(primitive_type, vertex_format);
+  }
+
+  // Synchronous shader compiling.
   if (!CompileShader(newentry.shader, vcode.GetBuffer(), pcode.GetBuffer(), gcode.GetBuffer()))
     return nullptr;
 
@@ -297,6 +326,8 @@ SHADER* ProgramShaderCache::SetShader(PrimitiveType primitive_type,
 SHADER* ProgramShaderCache::SetUberShader(PrimitiveType primitive_type,
                                           const GLVertexFormat* vertex_format)
 {
+  INCSTAT(stats.thisFrame.numUberShaderDraws);
+
   UBERSHADERUID uid;
   std::memset(&uid, 0, sizeof(uid));
   uid.puid = UberShader::GetPixelShaderUid();
@@ -362,6 +393,29 @@ SHADER* ProgramShaderCache::SetUberShader(PrimitiveType primitive_type,
 bool ProgramShaderCache::CompileShader(SHADER& shader, const std::string& vcode,
                                        const std::string& pcode, const std::string& gcode)
 {
+  TRACE_SCOPE("OGL::CompileShader");
+
+  BeginCompileShader(shader, vcode, pcode, gcode);
+  return FinishCompileShader(shader, vcode, pcode, gcode);
+}
+
+static GLuint BeginCompileSingleShader(GLenum type, const std::string& header,
+                                       const std::string& code)
+{
+  GLuint result = glCreateShader(type);
+
+  const char* src[] = {header.c_str(), code.c_str()};
+
+  glShaderSource(result, 2, src, nullptr);
+  glCompileShader(result);
+  return result;
+}
+
+void ProgramShaderCache::BeginCompileShader(SHADER& shader, const std::string& vcode,
+                                            const std::string& pcode, const std::string& gcode)
+{
+  g_shader_compiles.Increment();
+
 #if defined(_DEBUG) || defined(DEBUGFAST)
   if (g_ActiveConfig.iLog & CONF_SAVESHADERS)
   {
@@ -382,19 +436,14 @@ bool ProgramShaderCache::CompileShader(SHADER& shader, const std::string& vcode,
   }
 #endif
 
-  shader.vsid = CompileSingleShader(GL_VERTEX_SHADER, vcode);
-  shader.psid = CompileSingleShader(GL_FRAGMENT_SHADER, pcode);
+  // Nothing is checked until the program is finished, as that would wait for the driver.
+  shader.vsid = BeginCompileSingleShader(GL_VERTEX_SHADER, s_glsl_header, vcode);
+  shader.psid = BeginCompileSingleShader(GL_FRAGMENT_SHADER, s_glsl_header, pcode);
 
   // Optional geometry shader
   shader.gsid = 0;
   if (!gcode.empty())
-    shader.gsid = CompileSingleShader(GL_GEOMETRY_SHADER, gcode);
-
-  if (!shader.vsid || !shader.psid || (!gcode.empty() && !shader.gsid))
-  {
-    shader.Destroy();
-    return false;
-  }
+    shader.gsid = BeginCompileSingleShader(GL_GEOMETRY_SHADER, s_glsl_header, gcode);
 
   // Create and link the program.
   shader.glprogid = glCreateProgram();
@@ -410,8 +459,17 @@ bool ProgramShaderCache::CompileShader(SHADER& shader, const std::string& vcode,
   shader.SetProgramBindings(false);
 
   glLinkProgram(shader.glprogid);
+}
 
-  if (!CheckProgramLinkResult(shader.glprogid, vcode, pcode, gcode))
+bool ProgramShaderCache::FinishCompileShader(SHADER& shader, const std::string& vcode,
+                                             const std::string& pcode, const std::string& gcode)
+{
+  const bool vs_compiled = CheckShaderCompileResult(shader.vsid, GL_VERTEX_SHADER, vcode);
+  const bool ps_compiled = CheckShaderCompileResult(shader.psid, GL_FRAGMENT_SHADER, pcode);
+  const bool gs_compiled =
+      !shader.gsid || CheckShaderCompileResult(shader.gsid, GL_GEOMETRY_SHADER, gcode);
+  if (!vs_compiled || !ps_compiled || !gs_compiled ||
+      !CheckProgramLinkResult(shader.glprogid, vcode, pcode, gcode))
   {
     // Don't try to use this shader
     shader.Destroy();
@@ -460,14 +518,17 @@ bool ProgramShaderCache::CompileComputeShader(SHADER& shader, const std::string&
   return true;
 }
 
-GLuint ProgramShaderCache::CompileSingleShader(GLenum type, const std::string& code)
+bool ProgramShaderCache::IsCompileComplete(const SHADER& shader)
 {
-  GLuint result = glCreateShader(type);
-
-  const char* src[] = {s_glsl_header.c_str(), code.c_str()};
+  GLint complete = GL_TRUE;
+  if (g_ogl_config.bSupportsParallelShaderCompile)
+    glGetProgramiv(shader.glprogid, GL_COMPLETION_STATUS_KHR, &complete);
+  return complete == GL_TRUE;
+}
 
-  glShaderSource(result, 2, src, nullptr);
-  glCompileShader(result);
+GLuint ProgramShaderCache::CompileSingleShader(GLenum type, const std::string& code)
+{
+  GLuint result = BeginCompileSingleShader(type, s_glsl_header, code);
 
   if (!CheckShaderCompileResult(result, type, code))
   {
@@ -595,6 +656,7 @@ void ProgramShaderCache::Init()
   // So multiply by four to get how many floats we have from vec4s
   // Then once more to get bytes
   s_buffer = StreamBuffer::Create(GL_UNIFORM_BUFFER, UBO_LENGTH);
+  s_ubo_stream_end = 0;
 
   // The GPU shader code appears to be context-specific on Mesa/i965.
   // This means that if we compiled the ubershaders asynchronously, they will be recompiled
@@ -618,6 +680,8 @@ void ProgramShaderCache::Init()
   {
     if (s_async_compiler)
       s_async_compiler->ResizeWorkerThreads(g_ActiveConfig.GetShaderPrecompilerThreads());
+    if (g_ogl_config.bSupportsParallelShaderCompile)
+      glMaxShaderCompilerThreads(g_ActiveConfig.GetShaderPrecompilerThreads());
     PrecompileUberShaders();
   }
 
@@ -628,12 +692,29 @@ void ProgramShaderCache::Init()
     if (!s_async_compiler->HasWorkerThreads())
       s_async_compiler.reset();
   }
+
+  // The threads of the driver count as shader compiler threads too, when there are no workers.
+  if (g_ogl_config.bSupportsParallelShaderCompile)
+    glMaxShaderCompilerThreads(g_ActiveConfig.GetShaderCompilerThreads());
 }
 
 void ProgramShaderCache::RetrieveAsyncShaders()
 {
   if (s_async_compiler)
     s_async_compiler->RetrieveWorkItems();
+
+  // Only the programs the driver is done with are taken, so this never waits.
+  const auto end = std::remove_if(
+      s_parallel_compiles.begin(), s_parallel_compiles.end(), [](const ParallelCompile& compile) {
+        PCacheEntry& entry = pshaders[compile.uid];
+        if (!IsCompileComplete(entry.shader))
+          return false;
+
+        FinishCompileShader(entry.shader, compile.vcode, compile.pcode, compile.gcode);
+        entry.pending = false;
+        return true;
+      });
+  s_parallel_compiles.erase(end, s_parallel_compiles.end());
 }
 
 void ProgramShaderCache::Reload()
@@ -744,6 +825,18 @@ bool ProgramShaderCache::CreateCacheEntryFromBinary(PCacheEntry* entry, const u8
   return true;
 }
 
+// Program binaries only load on the driver and GPU that created them. A cache file for each of
+// them keeps the binaries of one from being thrown away when switching to another, and the ones of
+// an old driver version from failing to load forever.
+static std::string GetProgramBinaryCacheType(const char* type)
+{
+  const std::string driver = StringFromFormat("%s\n%s\n%s", g_ogl_config.gl_vendor,
+                                              g_ogl_config.gl_renderer, g_ogl_config.gl_version);
+  const u64 hash = GetHash64(reinterpret_cast<const u8*>(driver.data()),
+                             static_cast<u32>(driver.size()), 0);
+  return StringFromFormat("%s-%016" PRIx64, type, hash);
+}
+
 void ProgramShaderCache::LoadProgramBinaries()
 {
   GLint Supported;
@@ -757,14 +850,14 @@ void ProgramShaderCache::LoadProgramBinaries()
   else
   {
     // Load game-specific shaders.
-    std::string cache_filename =
-        GetDiskShaderCacheFileName(APIType::OpenGL, "ProgramBinaries", true, true);
+    std::string cache_filename = GetDiskShaderCacheFileName(
+        APIType::OpenGL, GetProgramBinaryCacheType("ProgramBinaries").c_str(), true, true);
     ProgramShaderCacheInserter<SHADERUID> inserter(pshaders);
     s_program_disk_cache.OpenAndRead(cache_filename, inserter);
 
     // Load global ubershaders.
-    cache_filename =
-        GetDiskShaderCacheFileName(APIType::OpenGL, "UberProgramBinaries", false, true);
+    cache_filename = GetDiskShaderCacheFileName(
+        APIType::OpenGL, GetProgramBinaryCacheType("UberProgramBinaries").c_str(), false, true);
     ProgramShaderCacheInserter<UBERSHADERUID> uber_inserter(ubershaders);
     s_uber_program_disk_cache.OpenAndRead(cache_filename, uber_inserter);
   }
@@ -829,6 +922,9 @@ void ProgramShaderCache::DestroyShaders()
 {
   glUseProgram(0);
 
+  // Their programs are destroyed with the other entries.
+  s_parallel_compiles.clear();
+
   for (auto& entry : pshaders)
     entry.second.Destroy();
   pshaders.clear();
@@ -886,6 +982,14 @@ void ProgramShaderCache::CreateHeader()
     }
   }
 
+  std::string vs_layer_string = "";
+  if (g_ActiveConfig.backend_info.bSupportsVSLayerOutput)
+  {
+    vs_layer_string = GLExtensions::Supports("GL_ARB_shader_viewport_layer_array") ?
+                          "#extension GL_ARB_shader_viewport_layer_array : enable" :
+                          "#extension GL_AMD_vertex_shader_layer : enable";
+  }
+
   s_glsl_header = StringFromFormat(
       "%s\n"
       "%s\n"  // ubo
@@ -903,6 +1007,8 @@ void ProgramShaderCache::CreateHeader()
       "%s\n"  // ES texture buffer
       "%s\n"  // ES dual source blend
       "%s\n"  // shader image load store
+      "%s\n"  // vertex shader layer output
+      "%s\n"  // draw parameters
 
       // Precision defines for GLSL ES
       "%s\n"
@@ -977,7 +1083,12 @@ void ProgramShaderCache::CreateHeader()
               ((!is_glsles && v < GLSL_430) || (is_glsles && v < GLSLES_310)) ?
           "#extension GL_ARB_shader_image_load_store : enable" :
           "",
-      is_glsles ? "precision highp float;" : "", is_glsles ? "precision highp int;" : "",
+      vs_layer_string.c_str(),
+      g_ActiveConfig.backend_info.bSupportsMultiDrawIndirect ?
+          "#extension GL_ARB_shader_draw_parameters : enable" :
+          "",
+      is_glsles ? "precision highp float;" : "",
+      is_glsles ? "precision highp int;" : "",
       is_glsles ? "precision highp sampler2DArray;" : "",
       (is_glsles && g_ActiveConfig.backend_info.bSupportsPaletteConversion) ?
           "precision highp usamplerBuffer;" :
@@ -990,6 +1101,28 @@ void ProgramShaderCache::PrecompileUberShaders()
 {
   bool success = true;
 
+  // Without workers, the driver compiles a batch of ubershaders at once if it can.
+  struct PendingUberShader
+  {
+    PCacheEntry* entry;
+    ShaderCode vcode;
+    ShaderCode pcode;
+    ShaderCode gcode;
+  };
+  constexpr size_t MAX_PENDING_UBERSHADERS = 64;
+  std::vector<PendingUberShader> pending;
+  const auto finish_pending = [&] {
+    for (PendingUberShader& shader : pending)
+    {
+      if (!FinishCompileShader(shader.entry->shader, shader.vcode.GetBuffer(),
+                               shader.pcode.GetBuffer(), shader.gcode.GetBuffer()))
+      {
+        success = false;
+      }
+    }
+    pending.clear();
+  };
+
   UberShader::EnumerateVertexShaderUids([&](const UberShader::VertexShaderUid& vuid) {
     UberShader::EnumeratePixelShaderUids([&](const UberShader::PixelShaderUid& puid) {
       // UIDs must have compatible texgens, a mismatching combination will never be queried.
@@ -1036,15 +1169,18 @@ void ProgramShaderCache::PrecompileUberShaders()
 
         // Always background compile, even when it's not supported.
         // This way hopefully the driver can still compile the shaders in parallel.
-        if (!CompileShader(entry.shader, vcode.GetBuffer(), pcode.GetBuffer(), gcode.GetBuffer()))
+        BeginCompileShader(entry.shader, vcode.GetBuffer(), pcode.GetBuffer(), gcode.GetBuffer());
+        pending.push_back({&entry, std::move(vcode), std::move(pcode), std::move(gcode)});
+        // Stop compiling shaders if any of them fail, no point continuing.
+        if (!g_ogl_config.bSupportsParallelShaderCompile ||
+            pending.size() >= MAX_PENDING_UBERSHADERS)
         {
-          // Stop compiling shaders if any of them fail, no point continuing.
-          success = false;
-          return;
+          finish_pending();
         }
       });
     });
   });
+  finish_pending();
 
   if (s_async_compiler)
   {
@@ -5,7 +5,9 @@
 #pragma once
 
 #include <memory>
+#include <string>
 #include <tuple>
+#include <vector>
 
 #include "Common/GL/GLUtil.h"
 #include "Common/LinearDiskCache.h"
@@ -102,6 +104,13 @@ public:
 
   static bool CompileShader(SHADER& shader, const std::string& vcode, const std::string& pcode,
                             const std::string& gcode = "");
+  // CompileShader in two steps, which lets drivers with KHR_parallel_shader_compile work on many
+  // programs at once. Finishing waits for the driver, unless IsCompileComplete returned true.
+  static void BeginCompileShader(SHADER& shader, const std::string& vcode,
+                                 const std::string& pcode, const std::string& gcode = "");
+  static bool FinishCompileShader(SHADER& shader, const std::string& vcode,
+                                  const std::string& pcode, const std::string& gcode = "");
+  static bool IsCompileComplete(const SHADER& shader);
   static bool CompileComputeShader(SHADER& shader, const std::string& code);
   static GLuint CompileSingleShader(GLenum type, const std::string& code);
   static bool CheckShaderCompileResult(GLuint id, GLenum type, const std::string& code);
@@ -188,6 +197,15 @@ private:
     SHADER m_program;
   };
 
+  // A program the driver compiles in the background, with its code for reporting errors.
+  struct ParallelCompile
+  {
+    SHADERUID uid;
+    std::string vcode;
+    std::string pcode;
+    std::string gcode;
+  };
+
   typedef std::map<SHADERUID, PCacheEntry> PCache;
   typedef std::map<UBERSHADERUID, PCacheEntry> UberPCache;
 
@@ -208,6 +226,7 @@ private:
   static UBERSHADERUID last_uber_uid;
 
   static std::unique_ptr<SharedContextAsyncShaderCompiler> s_async_compiler;
+  static std::vector<ParallelCompile> s_parallel_compiles;
   static u32 s_ubo_buffer_size;
   static s32 s_ubo_align;
   static u32 s_last_VAO;
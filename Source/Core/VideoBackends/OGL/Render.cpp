@@ -31,6 +31,7 @@
 
 #include "VideoBackends/OGL/BoundingBox.h"
 #include "VideoBackends/OGL/FramebufferManager.h"
+#include "VideoBackends/OGL/GPUTimer.h"
 #include "VideoBackends/OGL/OGLTexture.h"
 #include "VideoBackends/OGL/PostProcessing.h"
 #include "VideoBackends/OGL/ProgramShaderCache.h"
@@ -511,6 +512,10 @@ Renderer::Renderer()
   g_ogl_config.bSupportsImageLoadStore = GLExtensions::Supports("GL_ARB_shader_image_load_store");
   g_ogl_config.bSupportsConservativeDepth = GLExtensions::Supports("GL_ARB_conservative_depth");
   g_ogl_config.bSupportsAniso = GLExtensions::Supports("GL_EXT_texture_filter_anisotropic");
+  g_ogl_config.bSupportsShadingRateImage = GLExtensions::Supports("GL_NV_shading_rate_image");
+  g_ogl_config.bSupportsParallelShaderCompile =
+      GLExtensions::Supports("GL_KHR_parallel_shader_compile") ||
+      GLExtensions::Supports("GL_ARB_parallel_shader_compile");
   g_Config.backend_info.bSupportsComputeShaders = GLExtensions::Supports("GL_ARB_compute_shader");
   g_Config.backend_info.bSupportsST3CTextures =
       GLExtensions::Supports("GL_EXT_texture_compression_s3tc");
@@ -661,6 +666,17 @@ Renderer::Renderer()
   g_Config.backend_info.bSupportsEarlyZ =
       g_ogl_config.bSupportsImageLoadStore || g_ogl_config.bSupportsConservativeDepth;
 
+  // Lines and points still need the geometry shader to be expanded, also in stereo.
+  g_Config.backend_info.bSupportsVSLayerOutput =
+      g_Config.backend_info.bSupportsGeometryShaders &&
+      (GLExtensions::Supports("GL_ARB_shader_viewport_layer_array") ||
+       GLExtensions::Supports("GL_AMD_vertex_shader_layer"));
+
+  // Merged draws only need a multi-draw if the shaders can tell its commands apart.
+  g_Config.backend_info.bSupportsMultiDrawIndirect =
+      g_ogl_config.bSupportsGLBaseVertex && GLExtensions::Supports("VERSION_4_3") &&
+      GLExtensions::Supports("GL_ARB_shader_draw_parameters");
+
   glGetIntegerv(GL_MAX_SAMPLES, &g_ogl_config.max_samples);
   if (g_ogl_config.max_samples < 1 || !g_ogl_config.bSupportsMSAA)
     g_ogl_config.max_samples = 1;
@@ -729,7 +745,7 @@ Renderer::Renderer()
     NOTICE_LOG(VR, "begin searching GL");
   }
 
-  WARN_LOG(VIDEO, "Missing OGL Extensions: %s%s%s%s%s%s%s%s%s%s%s%s%s%s",
+  WARN_LOG(VIDEO, "Missing OGL Extensions: %s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s",
            g_ActiveConfig.backend_info.bSupportsDualSourceBlend ? "" : "DualSourceBlend ",
            g_ActiveConfig.backend_info.bSupportsPrimitiveRestart ? "" : "PrimitiveRestart ",
            g_ActiveConfig.backend_info.bSupportsEarlyZ ? "" : "EarlyZ ",
@@ -742,7 +758,9 @@ Renderer::Renderer()
            g_ActiveConfig.backend_info.bSupportsGSInstancing ? "" : "GSInstancing ",
            g_ActiveConfig.backend_info.bSupportsClipControl ? "" : "ClipControl ",
            g_ogl_config.bSupportsCopySubImage ? "" : "CopyImageSubData ",
-           g_ActiveConfig.backend_info.bSupportsDepthClamp ? "" : "DepthClamp ");
+           g_ActiveConfig.backend_info.bSupportsDepthClamp ? "" : "DepthClamp ",
+           g_ActiveConfig.backend_info.bSupportsVSLayerOutput ? "" : "VSLayerOutput ",
+           g_ActiveConfig.backend_info.bSupportsMultiDrawIndirect ? "" : "MultiDrawIndirect ");
 
   s_last_multisamples = g_ActiveConfig.iMultisamples;
   s_MSAASamples = s_last_multisamples;
@@ -790,8 +808,12 @@ Renderer::Renderer()
   glBlendColor(0, 0, 0, 0.5f);
   glClearDepthf(1.0f);
 
+  IndexGenerator::Init();
   if (g_ActiveConfig.backend_info.bSupportsPrimitiveRestart)
   {
+    // The restart index is the largest value of the index type.
+    const GLuint restart_index =
+        IndexGenerator::GetIndexSize() == sizeof(u32) ? UINT32_MAX : UINT16_MAX;
     if (GLInterface->GetMode() == GLInterfaceMode::MODE_OPENGLES3)
     {
       glEnable(GL_PRIMITIVE_RESTART_FIXED_INDEX);
@@ -801,16 +823,15 @@ Renderer::Renderer()
       if (GLExtensions::Version() >= 310)
       {
         glEnable(GL_PRIMITIVE_RESTART);
-        glPrimitiveRestartIndex(65535);
+        glPrimitiveRestartIndex(restart_index);
       }
       else
       {
         glEnableClientState(GL_PRIMITIVE_RESTART_NV);
-        glPrimitiveRestartIndexNV(65535);
+        glPrimitiveRestartIndexNV(restart_index);
       }
     }
   }
-  IndexGenerator::Init();
 
   UpdateActiveConfig();
   ClearEFBCache();
@@ -852,6 +873,7 @@ void Renderer::Shutdown()
   }
   g_first_rift_frame = true;
 
+  m_frame_timer.reset();
   g_framebuffer_manager.reset();
 
   UpdateActiveConfig();
@@ -1455,6 +1477,25 @@ void Renderer::AsyncTimewarpDraw()
 }
 
 // This function has the final picture. We adjust the aspect ratio here.
+// A frame's GPU time is measured from one swap to the next.
+void Renderer::UpdateGPUFrameTimer()
+{
+  if (!IsMeasuringGPUFrameTime() || !GPUFrameTimer::IsSupported())
+  {
+    m_frame_timer.reset();
+    return;
+  }
+
+  if (!m_frame_timer)
+    m_frame_timer = std::make_unique<GPUFrameTimer>();
+
+  m_frame_timer->EndFrame();
+  double milliseconds;
+  while (m_frame_timer->PopFrameTime(&milliseconds))
+    AddGPUFrameTime(milliseconds);
+  m_frame_timer->BeginFrame();
+}
+
 void Renderer::SwapImpl(u32 xfbAddr, u32 fbWidth, u32 fbStride, u32 fbHeight,
                         const EFBRectangle& rc, u64 ticks, float Gamma)
 {
@@ -1562,7 +1603,7 @@ void Renderer::SwapImpl(u32 xfbAddr, u32 fbWidth, u32 fbStride, u32 fbHeight,
 
         TargetRectangle drawRc;
 
-        if (g_ActiveConfig.bUseRealXFB)
+        if (FramebufferManager::IsRealXFBSource())
         {
           drawRc = flipped_trc;
         }
@@ -1840,7 +1881,7 @@ void Renderer::SwapImpl(u32 xfbAddr, u32 fbWidth, u32 fbStride, u32 fbHeight,
       sourceRc.top = xfbSource->sourceRc.top;
       sourceRc.bottom = xfbSource->sourceRc.bottom;
 
-      if (g_ActiveConfig.bUseRealXFB)
+      if (FramebufferManager::IsRealXFBSource())
       {
         drawRc = flipped_trc;
         sourceRc.right -= fbStride - fbWidth;
@@ -2009,9 +2050,15 @@ void Renderer::SwapImpl(u32 xfbAddr, u32 fbWidth, u32 fbStride, u32 fbHeight,
   }
 #endif
 
+  UpdateGPUFrameTimer();
+
   // Copy the rendered frame to the real window
   if (!(g_has_hmd && g_ActiveConfig.bEnableVR))
+  {
+    m_frame_pacer.WaitForPresent(ticks);
     GLInterface->Swap();
+    m_frame_pacer.EndPresent();
+  }
 
   VR_NewVRFrame();
 
@@ -2132,7 +2179,7 @@ void Renderer::DrawFrame(GLuint framebuffer, const TargetRectangle& target_rc,
 {
   if (g_ActiveConfig.bUseXFB)
   {
-    if (g_ActiveConfig.bUseRealXFB)
+    if (FramebufferManager::IsRealXFBSource())
       DrawRealXFB(framebuffer, target_rc, xfb_sources, xfb_count, fb_width, fb_stride, fb_height);
     else
       DrawVirtualXFB(framebuffer, target_rc, xfb_addr, xfb_sources, xfb_count, fb_width, fb_stride,
@@ -2236,13 +2283,16 @@ void Renderer::FlushFrameDump()
   if (!m_last_frame_exported)
     return;
 
-  FinishFrameData();
+  // DumpFrameData copies the frame, so the buffer can be unmapped right away.
   glBindBuffer(GL_PIXEL_PACK_BUFFER, m_frame_dumping_pbo[0]);
-  m_frame_pbo_is_mapped[0] = true;
   void* data = glMapBufferRange(
       GL_PIXEL_PACK_BUFFER, 0, m_last_frame_width[0] * m_last_frame_height[0] * 4, GL_MAP_READ_BIT);
-  DumpFrameData(reinterpret_cast<u8*>(data), m_last_frame_width[0], m_last_frame_height[0],
-                m_last_frame_width[0] * 4, m_last_frame_state, true);
+  if (data)
+  {
+    DumpFrameData(reinterpret_cast<u8*>(data), m_last_frame_width[0], m_last_frame_height[0],
+                  m_last_frame_width[0] * 4, m_last_frame_state, true);
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+  }
   glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
   m_last_frame_exported = false;
 }
@@ -2258,13 +2308,9 @@ void Renderer::DumpFrame(const TargetRectangle& flipped_trc, u64 ticks)
   {
     FlushFrameDump();
     std::swap(m_frame_dumping_pbo[0], m_frame_dumping_pbo[1]);
-    std::swap(m_frame_pbo_is_mapped[0], m_frame_pbo_is_mapped[1]);
     std::swap(m_last_frame_width[0], m_last_frame_width[1]);
     std::swap(m_last_frame_height[0], m_last_frame_height[1]);
     glBindBuffer(GL_PIXEL_PACK_BUFFER, m_frame_dumping_pbo[0]);
-    if (m_frame_pbo_is_mapped[0])
-      glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
-    m_frame_pbo_is_mapped[0] = false;
   }
 
   if (flipped_trc.GetWidth() != m_last_frame_width[0] ||
@@ -2384,6 +2430,7 @@ void Renderer::ResetAPIState()
   }
   glDepthMask(GL_FALSE);
   glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+  FramebufferManager::SetFoveationEnabled(false);
 }
 
 void Renderer::RestoreAPIState()
@@ -2413,6 +2460,7 @@ void Renderer::RestoreAPIState()
     glEnable(GL_DEPTH_CLAMP);
   else
     glDisable(GL_DEPTH_CLAMP);
+  FramebufferManager::SetFoveationEnabled(true);
 }
 
 void Renderer::SetRasterizationState(const RasterizationState& state)
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <array>
+#include <memory>
 #include <string>
 
 #include "Common/GL/GLUtil.h"
@@ -14,6 +15,8 @@ struct XFBSourceBase;
 
 namespace OGL
 {
+class GPUFrameTimer;
+
 void ClearEFBCache();
 
 enum GLSL_VERSION
@@ -58,6 +61,8 @@ struct VideoConfig
   bool bSupportsConservativeDepth;
   bool bSupportsImageLoadStore;
   bool bSupportsAniso;
+  bool bSupportsShadingRateImage;
+  bool bSupportsParallelShaderCompile;
   bool bSupportsBitfield;
 
   const char* gl_vendor;
@@ -130,6 +135,8 @@ private:
   void BlitScreen(TargetRectangle src, TargetRectangle dst, GLuint src_texture, int src_width,
                   int src_height);
 
+  void UpdateGPUFrameTimer();
+
   void FlushFrameDump();
   void DumpFrame(const TargetRectangle& flipped_trc, u64 ticks);
   void DumpFrameUsingFBO(const EFBRectangle& source_rc, u32 xfb_addr,
@@ -146,10 +153,11 @@ private:
 
   // avi dumping state to delay one frame
   std::array<u32, 2> m_frame_dumping_pbo = {};
-  std::array<bool, 2> m_frame_pbo_is_mapped = {};
   std::array<int, 2> m_last_frame_width = {};
   std::array<int, 2> m_last_frame_height = {};
   bool m_last_frame_exported = false;
   AVIDump::Frame m_last_frame_state;
+
+  std::unique_ptr<GPUFrameTimer> m_frame_timer;
 };
 }
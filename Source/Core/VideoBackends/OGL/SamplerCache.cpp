@@ -51,18 +51,21 @@ void SamplerCache::SetSamplerState(u32 stage, const SamplerState& state)
   if (m_active_samplers[stage].first == state && m_active_samplers[stage].second != 0)
     return;
 
-  auto it = m_cache.find(state);
-  if (it == m_cache.end())
+  GLuint sampler;
+  if (const GLuint* cached = m_cache.Find(state))
+  {
+    sampler = *cached;
+  }
+  else
   {
-    GLuint sampler;
     glGenSamplers(1, &sampler);
     SetParameters(sampler, state);
-    it = m_cache.emplace(state, sampler).first;
+    m_cache.Insert(state, sampler);
   }
 
   m_active_samplers[stage].first = state;
-  m_active_samplers[stage].second = it->second;
-  glBindSampler(stage, it->second);
+  m_active_samplers[stage].second = sampler;
+  glBindSampler(stage, sampler);
 }
 
 void SamplerCache::InvalidateBinding(u32 stage)
@@ -111,10 +114,9 @@ void SamplerCache::SetParameters(GLuint sampler_id, const SamplerState& params)
 
 void SamplerCache::Clear()
 {
-  for (auto& p : m_cache)
-    glDeleteSamplers(1, &p.second);
+  m_cache.ForEach([](GLuint& sampler) { glDeleteSamplers(1, &sampler); });
   for (auto& p : m_active_samplers)
     p.second = 0;
-  m_cache.clear();
+  m_cache.Clear();
 }
 }
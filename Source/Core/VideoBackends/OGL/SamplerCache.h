@@ -5,12 +5,12 @@
 #pragma once
 
 #include <array>
-#include <map>
 #include <memory>
 
 #include "Common/CommonTypes.h"
 #include "Common/GL/GLUtil.h"
 #include "VideoBackends/OGL/Render.h"
+#include "VideoCommon/RenderStateCache.h"
 
 namespace OGL
 {
@@ -35,7 +35,7 @@ public:
 private:
   static void SetParameters(GLuint sampler_id, const SamplerState& params);
 
-  std::map<SamplerState, GLuint> m_cache;
+  RenderStateCache<SamplerState, GLuint> m_cache;
   std::array<std::pair<SamplerState, GLuint>, 8> m_active_samplers{};
 
   GLuint m_point_sampler;
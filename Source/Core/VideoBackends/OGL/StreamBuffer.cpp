@@ -8,11 +8,13 @@
 #include "Common/CommonFuncs.h"
 #include "Common/GL/GLUtil.h"
 #include "Common/MemoryUtil.h"
+#include "Common/MsgHandler.h"
 
 #include "VideoBackends/OGL/Render.h"
 
 #include "VideoCommon/DriverDetails.h"
 #include "VideoCommon/OnScreenDisplay.h"
+#include "VideoCommon/StreamRingAllocator.h"
 
 namespace OGL
 {
@@ -25,12 +27,8 @@ static u32 GenBuffer()
 }
 
 StreamBuffer::StreamBuffer(u32 type, u32 size)
-    : m_buffer(GenBuffer()), m_buffertype(type), m_size(ROUND_UP_POW2(size)),
-      m_bit_per_slot(IntLog2(ROUND_UP_POW2(size) / SYNC_POINTS))
+    : m_buffer(GenBuffer()), m_buffertype(type), m_size(ROUND_UP_POW2(size))
 {
-  m_iterator = 0;
-  m_used_iterator = 0;
-  m_free_iterator = 0;
 }
 
 StreamBuffer::~StreamBuffer()
@@ -40,92 +38,67 @@ StreamBuffer::~StreamBuffer()
 
 /* Shared synchronization code for ring buffers
  *
- * The next three functions are to create/delete/use the OpenGL synchronization.
  * ARB_sync (OpenGL 3.2) is used and required.
  *
- * To reduce overhead, the complete buffer is splitted up into SYNC_POINTS chunks.
- * For each of this chunks, there is a fence which checks if this chunk is still in use.
+ * The offsets are handed out by a StreamRingAllocator. We assume that this buffer is accessed by
+ * the GPU between the Unmap and Map function, so a fence created on mapping covers everything
+ * written before. To reduce overhead, fences are only created for every 1/SYNC_POINTS of the
+ * buffer which has been written, or when we run out of space.
  *
- * As our API allows to alloc more memory then it has to use, we have to catch how much is already
- * written.
- *
- * m_iterator      - writing position
- * m_free_iterator - last position checked if free
- * m_used_iterator - last position known to be written
- *
- * So on alloc, we have to wait for all slots between m_free_iterator and m_iterator (and set
- * m_free_iterator to m_iterator afterwards).
- *
- * We also assume that this buffer is accessed by the GPU between the Unmap and Map function,
- * so we may create the fences on the start of mapping.
- * Some here, new fences for the chunks between m_used_iterator and m_iterator (also update
- * m_used_iterator).
- *
- * As ring buffers have an ugly behavior on rollover, have fun to read this code ;)
+ * Fences which have already been signaled are retired on every mapping without waiting, so
+ * usually the CPU only waits for the GPU when it is a whole buffer ahead.
  */
-
-void StreamBuffer::CreateFences()
-{
-  for (int i = 0; i < SYNC_POINTS; i++)
-  {
-    m_fences[i] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
-  }
-}
-void StreamBuffer::DeleteFences()
+class SyncedStreamBuffer : public StreamBuffer
 {
-  for (int i = Slot(m_free_iterator) + 1; i < SYNC_POINTS; i++)
+protected:
+  SyncedStreamBuffer(u32 type, u32 size)
+      : StreamBuffer(type, size), m_ring(m_size, WaitForSync, DeleteSync)
   {
-    glDeleteSync(m_fences[i]);
   }
-  for (int i = 0; i < Slot(m_iterator); i++)
-  {
-    glDeleteSync(m_fences[i]);
-  }
-}
-void StreamBuffer::AllocMemory(u32 size)
-{
-  // insert waiting slots for used memory
-  for (int i = Slot(m_used_iterator); i < Slot(m_iterator); i++)
-  {
-    m_fences[i] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
-  }
-  m_used_iterator = m_iterator;
 
-  // wait for new slots to end of buffer
-  for (int i = Slot(m_free_iterator) + 1; i <= Slot(m_iterator + size) && i < SYNC_POINTS; i++)
+  // Returns the offset of size bytes which the GPU is done with.
+  u32 AllocMemory(u32 size, u32 stride)
   {
-    glClientWaitSync(m_fences[i], GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
-    glDeleteSync(m_fences[i]);
-  }
+    if (m_ring.NeedsFence() && m_ring.GetUnfencedBytes() >= m_size / SYNC_POINTS)
+      m_ring.AddFence(glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
 
-  // If we allocate a large amount of memory (A), commit a smaller amount, then allocate memory
-  // smaller than allocation A, we will have already waited for these fences in A, but not used
-  // the space. In this case, don't set m_free_iterator to a position before that which we know
-  // is safe to use, which would result in waiting on the same fence(s) next time.
-  if ((m_iterator + size) > m_free_iterator)
-    m_free_iterator = m_iterator + size;
-
-  // if buffer is full
-  if (m_iterator + size >= m_size)
-  {
-    // insert waiting slots in unused space at the end of the buffer
-    for (int i = Slot(m_used_iterator); i < SYNC_POINTS; i++)
+    m_ring.RetireSignaledFences(IsSyncSignaled);
+    if (!m_ring.Reserve(size, stride, true, false))
     {
-      m_fences[i] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+      // Everything written so far must be fenced for the allocator to be able to wait for it.
+      if (m_ring.NeedsFence())
+        m_ring.AddFence(glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+      if (!m_ring.Reserve(size, stride))
+        PanicAlert("Failed to allocate %u bytes from a %u byte stream buffer", size, m_size);
     }
 
-    // move to the start
-    m_used_iterator = m_iterator = 0;  // offset 0 is always aligned
+    return static_cast<u32>(m_ring.GetCurrentOffset());
+  }
 
-    // wait for space at the start
-    for (int i = 0; i <= Slot(m_iterator + size); i++)
-    {
-      glClientWaitSync(m_fences[i], GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
-      glDeleteSync(m_fences[i]);
-    }
-    m_free_iterator = m_iterator + size;
+  void CommitMemory(u32 used_size) { m_ring.Commit(used_size); }
+  u32 GetCurrentOffset() const { return static_cast<u32>(m_ring.GetCurrentOffset()); }
+
+private:
+#if defined(_MSC_VER) && _MSC_VER <= 1800
+#define SYNC_POINTS ((u32)16)
+#else
+  static constexpr u32 SYNC_POINTS = 16;
+#endif
+
+  static void WaitForSync(const GLsync& sync)
+  {
+    glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+  }
+  static void DeleteSync(const GLsync& sync) { glDeleteSync(sync); }
+  static bool IsSyncSignaled(const GLsync& sync)
+  {
+    GLint status = GL_UNSIGNALED;
+    glGetSynciv(sync, GL_SYNC_STATUS, 1, nullptr, &status);
+    return status == GL_SIGNALED;
   }
-}
+
+  StreamRingAllocator<GLsync> m_ring;
+};
 
 /* The usual way to stream data to the GPU.
  * Described here: https://www.opengl.org/wiki/Buffer_Object_Streaming#Unsynchronized_buffer_mapping
@@ -144,8 +117,13 @@ public:
   }
 
   ~MapAndOrphan() {}
-  std::pair<u8*, u32> Map(u32 size) override
+  std::pair<u8*, u32> Map(u32 size, u32 stride) override
   {
+    u32 padding = m_iterator % stride;
+    if (padding)
+    {
+      m_iterator += stride - padding;
+    }
     if (m_iterator + size >= m_size)
     {
       glBufferData(m_buffertype, m_size, nullptr, GL_STREAM_DRAW);
@@ -163,6 +141,9 @@ public:
     glUnmapBuffer(m_buffertype);
     m_iterator += used_size;
   }
+
+private:
+  u32 m_iterator = 0;
 };
 
 /* A modified streaming way without reallocation
@@ -172,31 +153,29 @@ public:
  * Else this fifo may overflow.
  * So we had traded orphan vs syncing.
  */
-class MapAndSync : public StreamBuffer
+class MapAndSync : public SyncedStreamBuffer
 {
 public:
-  MapAndSync(u32 type, u32 size) : StreamBuffer(type, size)
+  MapAndSync(u32 type, u32 size) : SyncedStreamBuffer(type, size)
   {
-    CreateFences();
     glBindBuffer(m_buffertype, m_buffer);
     glBufferData(m_buffertype, m_size, nullptr, GL_STREAM_DRAW);
   }
 
-  ~MapAndSync() { DeleteFences(); }
-  std::pair<u8*, u32> Map(u32 size) override
+  std::pair<u8*, u32> Map(u32 size, u32 stride) override
   {
-    AllocMemory(size);
-    u8* pointer = (u8*)glMapBufferRange(m_buffertype, m_iterator, size,
+    u32 offset = AllocMemory(size, stride);
+    u8* pointer = (u8*)glMapBufferRange(m_buffertype, offset, size,
                                         GL_MAP_WRITE_BIT | GL_MAP_FLUSH_EXPLICIT_BIT |
                                             GL_MAP_UNSYNCHRONIZED_BIT);
-    return std::make_pair(pointer, m_iterator);
+    return std::make_pair(pointer, offset);
   }
 
   void Unmap(u32 used_size) override
   {
     glFlushMappedBufferRange(m_buffertype, 0, used_size);
     glUnmapBuffer(m_buffertype);
-    m_iterator += used_size;
+    CommitMemory(used_size);
   }
 };
 
@@ -213,13 +192,12 @@ public:
  *
  * As persistently mapped buffer can't use orphaning, we also have to sync.
  */
-class BufferStorage : public StreamBuffer
+class BufferStorage : public SyncedStreamBuffer
 {
 public:
   BufferStorage(u32 type, u32 size, bool _coherent = false)
-      : StreamBuffer(type, size), coherent(_coherent)
+      : SyncedStreamBuffer(type, size), coherent(_coherent)
   {
-    CreateFences();
     glBindBuffer(m_buffertype, m_buffer);
 
     // PERSISTANT_BIT to make sure that the buffer can be used while mapped
@@ -235,22 +213,21 @@ public:
 
   ~BufferStorage()
   {
-    DeleteFences();
     glUnmapBuffer(m_buffertype);
     glBindBuffer(m_buffertype, 0);
   }
 
-  std::pair<u8*, u32> Map(u32 size) override
+  std::pair<u8*, u32> Map(u32 size, u32 stride) override
   {
-    AllocMemory(size);
-    return std::make_pair(m_pointer + m_iterator, m_iterator);
+    u32 offset = AllocMemory(size, stride);
+    return std::make_pair(m_pointer + offset, offset);
   }
 
   void Unmap(u32 used_size) override
   {
     if (!coherent)
-      glFlushMappedBufferRange(m_buffertype, m_iterator, used_size);
-    m_iterator += used_size;
+      glFlushMappedBufferRange(m_buffertype, GetCurrentOffset(), used_size);
+    CommitMemory(used_size);
   }
 
   u8* m_pointer;
@@ -264,12 +241,11 @@ public:
  * This one uses AMD_pinned_memory which is available on all AMD GPUs.
  * OpenGL 4.4 drivers should use BufferStorage.
  */
-class PinnedMemory : public StreamBuffer
+class PinnedMemory : public SyncedStreamBuffer
 {
 public:
-  PinnedMemory(u32 type, u32 size) : StreamBuffer(type, size)
+  PinnedMemory(u32 type, u32 size) : SyncedStreamBuffer(type, size)
   {
-    CreateFences();
     m_pointer = static_cast<u8*>(Common::AllocateAlignedMemory(
         Common::AlignUp(m_size, ALIGN_PINNED_MEMORY), ALIGN_PINNED_MEMORY));
     glBindBuffer(GL_EXTERNAL_VIRTUAL_MEMORY_BUFFER_AMD, m_buffer);
@@ -281,20 +257,19 @@ public:
 
   ~PinnedMemory()
   {
-    DeleteFences();
     glBindBuffer(m_buffertype, 0);
     glFinish();  // ogl pipeline must be flushed, else this buffer can be in use
     Common::FreeAlignedMemory(m_pointer);
     m_pointer = nullptr;
   }
 
-  std::pair<u8*, u32> Map(u32 size) override
+  std::pair<u8*, u32> Map(u32 size, u32 stride) override
   {
-    AllocMemory(size);
-    return std::make_pair(m_pointer + m_iterator, m_iterator);
+    u32 offset = AllocMemory(size, stride);
+    return std::make_pair(m_pointer + offset, offset);
   }
 
-  void Unmap(u32 used_size) override { m_iterator += used_size; }
+  void Unmap(u32 used_size) override { CommitMemory(used_size); }
   u8* m_pointer;
   static const u32 ALIGN_PINNED_MEMORY = 4096;
 };
@@ -315,7 +290,7 @@ public:
   }
 
   ~BufferSubData() { delete[] m_pointer; }
-  std::pair<u8*, u32> Map(u32 size) override { return std::make_pair(m_pointer, 0); }
+  std::pair<u8*, u32> Map(u32 size, u32 stride) override { return std::make_pair(m_pointer, 0); }
   void Unmap(u32 used_size) override { glBufferSubData(m_buffertype, 0, used_size, m_pointer); }
   u8* m_pointer;
 };
@@ -335,7 +310,7 @@ public:
   }
 
   ~BufferData() { delete[] m_pointer; }
-  std::pair<u8*, u32> Map(u32 size) override { return std::make_pair(m_pointer, 0); }
+  std::pair<u8*, u32> Map(u32 size, u32 stride) override { return std::make_pair(m_pointer, 0); }
   void Unmap(u32 used_size) override
   {
     glBufferData(m_buffertype, used_size, m_pointer, GL_STREAM_DRAW);
@@ -4,7 +4,6 @@
 
 #pragma once
 
-#include <array>
 #include <memory>
 #include <utility>
 
@@ -27,43 +26,16 @@ public:
    * Mapping invalidates the current buffer content,
    * so it isn't allowed to access the old content any more.
    */
-  virtual std::pair<u8*, u32> Map(u32 size) = 0;
+  virtual std::pair<u8*, u32> Map(u32 size, u32 stride) = 0;
   virtual void Unmap(u32 used_size) = 0;
 
-  std::pair<u8*, u32> Map(u32 size, u32 stride)
-  {
-    u32 padding = m_iterator % stride;
-    if (padding)
-    {
-      m_iterator += stride - padding;
-    }
-    return Map(size);
-  }
-
+  std::pair<u8*, u32> Map(u32 size) { return Map(size, 1); }
   const u32 m_buffer;
 
 protected:
   StreamBuffer(u32 type, u32 size);
-  void CreateFences();
-  void DeleteFences();
-  void AllocMemory(u32 size);
 
   const u32 m_buffertype;
   const u32 m_size;
-
-  u32 m_iterator;
-  u32 m_used_iterator;
-  u32 m_free_iterator;
-
-private:
-#if defined(_MSC_VER) && _MSC_VER <= 1800
-#define SYNC_POINTS ((int)16)
-#else
-  static constexpr int SYNC_POINTS = 16;
-#endif
-  int Slot(u32 x) const { return x >> m_bit_per_slot; }
-  const int m_bit_per_slot;
-
-  std::array<GLsync, SYNC_POINTS> m_fences{};
 };
 }
@@ -43,13 +43,24 @@ void TextureCache::CopyEFB(u8* dst, const EFBCopyParams& params, u32 native_widt
                            const EFBRectangle& src_rect, bool scale_by_half)
 {
   TextureConverter::EncodeToRamFromTexture(dst, params, native_width, bytes_per_row, num_blocks_y,
-                                           memory_stride, src_rect, scale_by_half);
+                                           memory_stride, src_rect, scale_by_half,
+                                           IsDeferringEFBCopies());
+}
+
+void TextureCache::FlushPendingEFBCopies()
+{
+  TextureConverter::FlushPendingEncodes();
 }
 
 TextureCache::TextureCache()
 {
   CompileShaders();
 
+  m_texture_upload_buffer =
+      StreamBuffer::Create(GL_PIXEL_UNPACK_BUFFER, TEXTURE_UPLOAD_BUFFER_SIZE);
+  // The buffer must not stay bound, as other uploads read from client memory.
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
   if (g_ActiveConfig.backend_info.bSupportsPaletteConversion)
   {
     s32 buffer_size_mb = (g_ActiveConfig.backend_info.bSupportsGPUTextureDecoding ? 32 : 1);
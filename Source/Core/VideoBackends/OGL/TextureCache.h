@@ -38,6 +38,13 @@ public:
   const SHADER& GetColorCopyProgram() const;
   GLuint GetColorCopyPositionUniform() const;
 
+  // Texture uploads go through this buffer instead of client memory, so the driver doesn't have
+  // to allocate staging memory for every upload. Uploads larger than MAX_TEXTURE_UPLOAD_SIZE
+  // bypass it.
+  static constexpr u32 TEXTURE_UPLOAD_BUFFER_SIZE = 32 * 1024 * 1024;
+  static constexpr u32 MAX_TEXTURE_UPLOAD_SIZE = TEXTURE_UPLOAD_BUFFER_SIZE / 4;
+  StreamBuffer* GetTextureUploadBuffer() const { return m_texture_upload_buffer.get(); }
+
 private:
   struct PaletteShader
   {
@@ -70,6 +77,9 @@ private:
   void CopyEFBToCacheEntry(TCacheEntry* entry, bool is_depth_copy, const EFBRectangle& src_rect,
                            bool scale_by_half, unsigned int cbuf_id, const float* colmat) override;
 
+  bool SupportsDeferredEFBCopies() const override { return true; }
+  void FlushPendingEFBCopies() override;
+
   bool CompileShaders() override;
   void DeleteShaders() override;
 
@@ -94,6 +104,7 @@ private:
   std::array<PaletteShader, 3> m_palette_shaders;
   std::unique_ptr<StreamBuffer> m_palette_stream_buffer;
   GLuint m_palette_resolv_texture = 0;
+  std::unique_ptr<StreamBuffer> m_texture_upload_buffer;
 
   std::map<std::pair<u32, u32>, TextureDecodingProgramInfo> m_texture_decoding_program_info;
   std::array<GLuint, TextureConversionShader::BUFFER_FORMAT_COUNT> m_texture_decoding_buffer_views;
@@ -7,6 +7,7 @@
 #include "VideoBackends/OGL/TextureConverter.h"
 
 #include <string>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/FileUtil.h"
@@ -55,6 +56,21 @@ static std::map<EFBCopyParams, EncodingProgram> s_encoding_programs;
 
 static GLuint s_PBO = 0;  // for readback with different strides
 
+// Deferred encodes each keep their own PBO until they are read back. Mapping it waits for the
+// readback, so the first one flushed waits for all of them.
+struct PendingEncode
+{
+  GLuint pbo;
+  u8* dest_ptr;
+  u32 line_size;
+  u32 height;
+  u32 stride;
+};
+static std::vector<PendingEncode> s_pending_encodes;
+static std::vector<GLuint> s_free_pbos;
+// Games rarely make more copies than this between two sync points.
+static constexpr size_t MAX_PENDING_ENCODES = 64;
+
 static void CreatePrograms()
 {
   /* TODO: Accuracy Improvements
@@ -200,6 +216,13 @@ void Shutdown()
   glDeleteBuffers(1, &s_PBO);
   glDeleteFramebuffers(2, s_texConvFrameBuffer);
 
+  for (const PendingEncode& encode : s_pending_encodes)
+    glDeleteBuffers(1, &encode.pbo);
+  s_pending_encodes.clear();
+  if (!s_free_pbos.empty())
+    glDeleteBuffers(static_cast<GLsizei>(s_free_pbos.size()), s_free_pbos.data());
+  s_free_pbos.clear();
+
   s_rgbToYuyvProgram.Destroy();
   s_yuyvToRgbProgram.Destroy();
 
@@ -216,9 +239,49 @@ void Shutdown()
 
 // dst_line_size, writeStride in bytes
 
+static void ReadFromPBO(GLuint pbo, u8* destAddr, u32 dst_line_size, u32 dstHeight,
+                        u32 writeStride)
+{
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo);
+  u8* data = (u8*)glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, dst_line_size * dstHeight,
+                                   GL_MAP_READ_BIT);
+
+  if (dst_line_size == writeStride)
+  {
+    memcpy(destAddr, data, dst_line_size * dstHeight);
+  }
+  else
+  {
+    for (size_t i = 0; i < dstHeight; ++i)
+    {
+      memcpy(destAddr, data, dst_line_size);
+      data += dst_line_size;
+      destAddr += writeStride;
+    }
+  }
+
+  glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+
+void FlushPendingEncodes()
+{
+  for (const PendingEncode& encode : s_pending_encodes)
+  {
+    ReadFromPBO(encode.pbo, encode.dest_ptr, encode.line_size, encode.height, encode.stride);
+    s_free_pbos.push_back(encode.pbo);
+  }
+  s_pending_encodes.clear();
+}
+
 static void EncodeToRamUsingShader(GLuint srcTexture, u8* destAddr, u32 dst_line_size,
-                                   u32 dstHeight, u32 writeStride, bool linearFilter)
+                                   u32 dstHeight, u32 writeStride, bool linearFilter,
+                                   bool deferred = false)
 {
+  // Older copies have to be written first.
+  if (!deferred || s_pending_encodes.size() >= MAX_PENDING_ENCODES)
+    FlushPendingEncodes();
+
   // switch to texture converter frame buffer
   // attach render buffer as color destination
   FramebufferManager::SetFramebuffer(s_texConvFrameBuffer[0]);
@@ -244,36 +307,41 @@ static void EncodeToRamUsingShader(GLuint srcTexture, u8* destAddr, u32 dst_line
 
   int dstSize = dst_line_size * dstHeight;
 
+  GLuint pbo = s_PBO;
+  if (deferred)
+  {
+    if (s_free_pbos.empty())
+    {
+      glGenBuffers(1, &pbo);
+    }
+    else
+    {
+      pbo = s_free_pbos.back();
+      s_free_pbos.pop_back();
+    }
+  }
+
   // When the dst_line_size and writeStride are the same, we could use glReadPixels directly to RAM.
   // But instead we always copy the data via a PBO, because macOS inexplicably prefers this (most
   // noticeably in the Super Mario Sunshine transition).
-  glBindBuffer(GL_PIXEL_PACK_BUFFER, s_PBO);
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo);
   glBufferData(GL_PIXEL_PACK_BUFFER, dstSize, nullptr, GL_STREAM_READ);
   glReadPixels(0, 0, (GLsizei)(dst_line_size / 4), (GLsizei)dstHeight, GL_BGRA, GL_UNSIGNED_BYTE,
                nullptr);
-  u8* pbo = (u8*)glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, dstSize, GL_MAP_READ_BIT);
 
-  if (dst_line_size == writeStride)
-  {
-    memcpy(destAddr, pbo, dst_line_size * dstHeight);
-  }
-  else
+  if (deferred)
   {
-    for (size_t i = 0; i < dstHeight; ++i)
-    {
-      memcpy(destAddr, pbo, dst_line_size);
-      pbo += dst_line_size;
-      destAddr += writeStride;
-    }
+    s_pending_encodes.push_back({pbo, destAddr, dst_line_size, dstHeight, writeStride});
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    return;
   }
 
-  glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
-  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+  ReadFromPBO(pbo, destAddr, dst_line_size, dstHeight, writeStride);
 }
 
 void EncodeToRamFromTexture(u8* dest_ptr, const EFBCopyParams& params, u32 native_width,
                             u32 bytes_per_row, u32 num_blocks_y, u32 memory_stride,
-                            const EFBRectangle& src_rect, bool scale_by_half)
+                            const EFBRectangle& src_rect, bool scale_by_half, bool deferred)
 {
   g_renderer->ResetAPIState();
 
@@ -288,7 +356,7 @@ void EncodeToRamFromTexture(u8* dest_ptr, const EFBCopyParams& params, u32 nativ
                                   FramebufferManager::ResolveAndGetRenderTarget(src_rect);
 
   EncodeToRamUsingShader(read_texture, dest_ptr, bytes_per_row, num_blocks_y, memory_stride,
-                         scale_by_half && !params.depth);
+                         scale_by_half && !params.depth, deferred);
 
   FramebufferManager::SetFramebuffer(0);
   g_renderer->RestoreAPIState();
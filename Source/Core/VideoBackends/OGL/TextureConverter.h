@@ -26,9 +26,11 @@ void EncodeToRamYUYV(GLuint srcTexture, const TargetRectangle& sourceRc, u8* des
 void DecodeToTexture(u32 xfbAddr, int srcWidth, int srcHeight, GLuint destTexture);
 
 // returns size of the encoded data (in bytes)
+// Deferred encodes are only written to dest_ptr by FlushPendingEncodes().
 void EncodeToRamFromTexture(u8* dest_ptr, const EFBCopyParams& params, u32 native_width,
                             u32 bytes_per_row, u32 num_blocks_y, u32 memory_stride,
-                            const EFBRectangle& src_rect, bool scale_by_half);
+                            const EFBRectangle& src_rect, bool scale_by_half, bool deferred);
+void FlushPendingEncodes();
 }
 
 }  // namespace OGL
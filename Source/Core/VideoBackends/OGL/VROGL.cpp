@@ -911,6 +911,7 @@ void VR_PresentHMDFrame()
     g_older_tracking_time = g_old_tracking_time;
     g_old_tracking_time = g_last_tracking_time;
     g_last_tracking_time = Common::Timer::GetTimeMs() / 1000.0;
+    VR_UpdateWiimotePoses();
 
     if (g_ActiveConfig.iMirrorPlayer != VR_PLAYER_NONE &&
         g_ActiveConfig.iMirrorStyle != VR_MIRROR_DISABLED)
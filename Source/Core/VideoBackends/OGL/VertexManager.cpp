@@ -31,9 +31,21 @@ namespace OGL
 // This are the initially requested size for the buffers expressed in bytes
 const u32 MAX_IBUFFER_SIZE = 2 * 1024 * 1024;
 const u32 MAX_VBUFFER_SIZE = 32 * 1024 * 1024;
+const u32 MAX_INDIRECT_BUFFER_SIZE = 256 * 1024;
+
+// Layout of the commands read by glMultiDrawElementsIndirect.
+struct DrawElementsIndirectCommand
+{
+  GLuint count;
+  GLuint instance_count;
+  GLuint first_index;
+  GLint base_vertex;
+  GLuint base_instance;
+};
 
 static std::unique_ptr<StreamBuffer> s_vertexBuffer;
 static std::unique_ptr<StreamBuffer> s_indexBuffer;
+static std::unique_ptr<StreamBuffer> s_indirectBuffer;
 static size_t s_baseVertex;
 static size_t s_index_offset;
 
@@ -54,12 +66,16 @@ void VertexManager::CreateDeviceObjects()
 
   s_indexBuffer = StreamBuffer::Create(GL_ELEMENT_ARRAY_BUFFER, MAX_IBUFFER_SIZE);
   m_index_buffers = s_indexBuffer->m_buffer;
+
+  if (g_ActiveConfig.backend_info.bSupportsMultiDrawIndirect)
+    s_indirectBuffer = StreamBuffer::Create(GL_DRAW_INDIRECT_BUFFER, MAX_INDIRECT_BUFFER_SIZE);
 }
 
 void VertexManager::DestroyDeviceObjects()
 {
   s_vertexBuffer.reset();
   s_indexBuffer.reset();
+  s_indirectBuffer.reset();
 }
 
 GLuint VertexManager::GetVertexBufferHandle() const
@@ -75,7 +91,7 @@ GLuint VertexManager::GetIndexBufferHandle() const
 void VertexManager::PrepareDrawBuffers(u32 stride)
 {
   u32 vertex_data_size = IndexGenerator::GetNumVerts() * stride;
-  u32 index_data_size = IndexGenerator::GetIndexLen() * sizeof(u16);
+  u32 index_data_size = IndexGenerator::GetIndexLen() * IndexGenerator::GetIndexSize();
 
   s_vertexBuffer->Unmap(vertex_data_size);
   s_indexBuffer->Unmap(index_data_size);
@@ -84,6 +100,12 @@ void VertexManager::PrepareDrawBuffers(u32 stride)
   ADDSTAT(stats.thisFrame.bytesIndexStreamed, index_data_size);
 }
 
+u32 VertexManager::GetVertexIDBase() const
+{
+  // gl_VertexID includes the base vertex, which is 0 when it isn't supported.
+  return static_cast<u32>(s_baseVertex);
+}
+
 void VertexManager::ResetBuffer(u32 stride)
 {
   if (m_cull_all)
@@ -101,7 +123,8 @@ void VertexManager::ResetBuffer(u32 stride)
     m_end_buffer_pointer = buffer.first + MAXVBUFFERSIZE;
     s_baseVertex = buffer.second / stride;
 
-    buffer = s_indexBuffer->Map(MAXIBUFFERSIZE * sizeof(u16));
+    buffer = s_indexBuffer->Map(MAXIBUFFERSIZE * IndexGenerator::GetIndexSize(),
+                                IndexGenerator::GetIndexSize());
     IndexGenerator::Start((u16*)buffer.first);
     s_index_offset = buffer.second;
   }
@@ -129,20 +152,73 @@ void VertexManager::Draw(u32 stride)
     break;
   }
 
-  if (g_ogl_config.bSupportsGLBaseVertex)
+  const GLenum index_type =
+      IndexGenerator::GetIndexSize() == sizeof(u32) ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT;
+
+  // Draws with different position matrices were merged, draw them with one command each.
+  if (s_indirectBuffer && !GetPosMatrixChanges().empty())
+  {
+    DrawMerged(primitive_mode, index_type);
+    return;
+  }
+
+  // With instanced stereo, the vertex shader selects the layer from the instance index.
+  if (g_ActiveConfig.UseInstancedStereo())
   {
-    glDrawRangeElementsBaseVertex(primitive_mode, 0, max_index, index_size, GL_UNSIGNED_SHORT,
+    if (g_ogl_config.bSupportsGLBaseVertex)
+    {
+      glDrawElementsInstancedBaseVertex(primitive_mode, index_size, index_type,
+                                        (u8*)nullptr + s_index_offset, 2, (GLint)s_baseVertex);
+    }
+    else
+    {
+      glDrawElementsInstanced(primitive_mode, index_size, index_type,
+                              (u8*)nullptr + s_index_offset, 2);
+    }
+  }
+  else if (g_ogl_config.bSupportsGLBaseVertex)
+  {
+    glDrawRangeElementsBaseVertex(primitive_mode, 0, max_index, index_size, index_type,
                                   (u8*)nullptr + s_index_offset, (GLint)s_baseVertex);
   }
   else
   {
-    glDrawRangeElements(primitive_mode, 0, max_index, index_size, GL_UNSIGNED_SHORT,
+    glDrawRangeElements(primitive_mode, 0, max_index, index_size, index_type,
                         (u8*)nullptr + s_index_offset);
   }
 
   INCSTAT(stats.thisFrame.numDrawCalls);
 }
 
+void VertexManager::DrawMerged(GLenum primitive_mode, GLenum index_type)
+{
+  const std::vector<PosMatrixChange>& changes = GetPosMatrixChanges();
+  const u32 num_commands = static_cast<u32>(changes.size());
+  const u32 commands_size = num_commands * sizeof(DrawElementsIndirectCommand);
+  const u32 first_index = static_cast<u32>(s_index_offset / IndexGenerator::GetIndexSize());
+  const u32 index_count = IndexGenerator::GetIndexLen();
+
+  auto buffer = s_indirectBuffer->Map(commands_size, sizeof(DrawElementsIndirectCommand));
+  auto* commands = reinterpret_cast<DrawElementsIndirectCommand*>(buffer.first);
+  for (u32 i = 0; i < num_commands; i++)
+  {
+    // The vertex shader picks the matrix of the command from gl_DrawIDARB.
+    const u32 end = i + 1 < num_commands ? changes[i + 1].first_index : index_count;
+    commands[i].count = end - changes[i].first_index;
+    commands[i].instance_count = g_ActiveConfig.UseInstancedStereo() ? 2 : 1;
+    commands[i].first_index = first_index + changes[i].first_index;
+    commands[i].base_vertex = static_cast<GLint>(s_baseVertex);
+    commands[i].base_instance = 0;
+  }
+  s_indirectBuffer->Unmap(commands_size);
+
+  glBindBuffer(GL_DRAW_INDIRECT_BUFFER, s_indirectBuffer->m_buffer);
+  glMultiDrawElementsIndirect(primitive_mode, index_type, (u8*)nullptr + buffer.second,
+                              num_commands, 0);
+
+  INCSTAT(stats.thisFrame.numDrawCalls);
+}
+
 void VertexManager::vFlush()
 {
   if (VertexShaderManager::m_layer_on_top)
@@ -40,11 +40,14 @@ public:
   GLuint GetVertexBufferHandle() const;
   GLuint GetIndexBufferHandle() const;
 
+  u32 GetVertexIDBase() const override;
+
 protected:
   void ResetBuffer(u32 stride) override;
 
 private:
   void Draw(u32 stride);
+  void DrawMerged(GLenum primitive_mode, GLenum index_type);
   void vFlush() override;
   void vFlush3D(bool useDstAlpha);
   void PrepareDrawBuffers(u32 stride);
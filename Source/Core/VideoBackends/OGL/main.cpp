@@ -105,6 +105,10 @@ void VideoBackend::InitBackendInfo()
   g_Config.backend_info.bSupportsDepthClamp = true;
   g_Config.backend_info.bSupportsST3CTextures = false;
   g_Config.backend_info.bSupportsBPTCTextures = false;
+  g_Config.backend_info.bSupportsVSLayerOutput = false;
+  g_Config.backend_info.bSupportsMergedDraws = true;
+  g_Config.backend_info.bSupportsMultiDrawIndirect = false;
+  g_Config.backend_info.bSupports32BitIndices = true;
 
   g_Config.backend_info.Adapters.clear();
 
@@ -11,9 +11,13 @@ struct OutputVertexData;
 namespace Rasterizer
 {
 void Init();
+void Shutdown();
 
 void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v1,
                            const OutputVertexData* v2);
+// Draws the triangles given since the last call. The state they are drawn with must not change
+// in between.
+void Flush();
 
 void SetTevReg(int reg, int comp, s16 color);
 
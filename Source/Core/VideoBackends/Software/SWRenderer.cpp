@@ -135,7 +135,6 @@ void SWRenderer::SwapImpl(u32 xfbAddr, u32 fbWidth, u32 fbStride, u32 fbHeight,
   {
     AVIDump::Frame state = AVIDump::FetchState(ticks);
     DumpFrameData(GetCurrentColorTexture(), fbWidth, fbHeight, fbWidth * 4, state);
-    FinishFrameData();
   }
 
   OSD::DoCallbacks(OSD::CallbackType::OnFrame);
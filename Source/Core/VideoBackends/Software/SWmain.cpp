@@ -123,6 +123,10 @@ void VideoSoftware::InitBackendInfo()
   g_Config.backend_info.bSupportsGPUTextureDecoding = false;
   g_Config.backend_info.bSupportsST3CTextures = false;
   g_Config.backend_info.bSupportsBPTCTextures = false;
+  g_Config.backend_info.bSupportsVSLayerOutput = false;
+  g_Config.backend_info.bSupportsMergedDraws = false;
+  g_Config.backend_info.bSupportsMultiDrawIndirect = false;
+  g_Config.backend_info.bSupports32BitIndices = false;
 
   // aamodes
   g_Config.backend_info.AAModes = {1};
@@ -170,6 +174,7 @@ void VideoSoftware::Video_Cleanup()
 
   SWRenderer::Shutdown();
   DebugUtil::Shutdown();
+  Rasterizer::Shutdown();
   // The following calls are NOT Thread Safe
   // And need to be called from the video thread
   SWRenderer::Shutdown();
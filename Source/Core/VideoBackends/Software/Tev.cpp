@@ -2,10 +2,13 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <cmath>
+#include <iterator>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
+#include "Common/Intrinsics.h"
 #include "VideoBackends/Software/DebugUtil.h"
 #include "VideoBackends/Software/EfbInterface.h"
 #include "VideoBackends/Software/Tev.h"
@@ -157,6 +160,42 @@ void Tev::Init()
   m_ScaleRShiftLUT[1] = 0;
   m_ScaleRShiftLUT[2] = 0;
   m_ScaleRShiftLUT[3] = 1;
+
+  ResetCounters();
+}
+
+void Tev::ResetCounters()
+{
+  m_pixels_in = 0;
+  m_pixels_out = 0;
+  std::fill(std::begin(m_perf_pixels), std::end(m_perf_pixels), 0);
+  m_bounding_box[BoundingBox::LEFT] = 0xffff;
+  m_bounding_box[BoundingBox::RIGHT] = 0;
+  m_bounding_box[BoundingBox::TOP] = 0xffff;
+  m_bounding_box[BoundingBox::BOTTOM] = 0;
+}
+
+void Tev::FlushCounters()
+{
+  ADDSTAT(stats.thisFrame.tevPixelsIn, m_pixels_in);
+  ADDSTAT(stats.thisFrame.tevPixelsOut, m_pixels_out);
+
+  for (int i = 0; i < PQ_NUM_MEMBERS; i++)
+  {
+    if (m_perf_pixels[i] != 0)
+      EfbInterface::AddPerfCounterPixels(static_cast<PerfQueryType>(i), m_perf_pixels[i]);
+  }
+
+  BoundingBox::coords[BoundingBox::LEFT] =
+      std::min(m_bounding_box[BoundingBox::LEFT], BoundingBox::coords[BoundingBox::LEFT]);
+  BoundingBox::coords[BoundingBox::RIGHT] =
+      std::max(m_bounding_box[BoundingBox::RIGHT], BoundingBox::coords[BoundingBox::RIGHT]);
+  BoundingBox::coords[BoundingBox::TOP] =
+      std::min(m_bounding_box[BoundingBox::TOP], BoundingBox::coords[BoundingBox::TOP]);
+  BoundingBox::coords[BoundingBox::BOTTOM] =
+      std::max(m_bounding_box[BoundingBox::BOTTOM], BoundingBox::coords[BoundingBox::BOTTOM]);
+
+  ResetCounters();
 }
 
 static inline s16 Clamp255(s16 in)
@@ -223,6 +262,38 @@ void Tev::SetRasColor(int colorChan, int swaptable)
 
 void Tev::DrawColorRegular(const TevStageCombiner::ColorCombiner& cc, const InputRegType inputs[4])
 {
+#if defined(_M_X86)
+  // The components are computed in the lanes of a vector, in the order of Reg. The alpha lane
+  // is computed with zero inputs, and isn't stored.
+  const u16 c_blu = inputs[BLU_C].c + (inputs[BLU_C].c >> 7);
+  const u16 c_grn = inputs[GRN_C].c + (inputs[GRN_C].c >> 7);
+  const u16 c_red = inputs[RED_C].c + (inputs[RED_C].c >> 7);
+
+  // a * (256 - c) + b * c, with a and b interleaved to multiply and add them at once
+  const __m128i ab = _mm_setr_epi16(0, 0, inputs[BLU_C].a, inputs[BLU_C].b, inputs[GRN_C].a,
+                                    inputs[GRN_C].b, inputs[RED_C].a, inputs[RED_C].b);
+  const __m128i weights =
+      _mm_setr_epi16(0, 0, 256 - c_blu, c_blu, 256 - c_grn, c_grn, 256 - c_red, c_red);
+  const __m128i lshift = _mm_cvtsi32_si128(m_ScaleLShiftLUT[cc.shift]);
+
+  __m128i temp = _mm_sll_epi32(_mm_madd_epi16(ab, weights), lshift);
+  temp = _mm_add_epi32(temp, _mm_set1_epi32((cc.shift == 3) ? 0 : (cc.op == 1) ? 127 : 128));
+  temp = _mm_srai_epi32(temp, 8);
+  if (cc.op)
+    temp = _mm_sub_epi32(_mm_setzero_si128(), temp);
+
+  const __m128i d = _mm_setr_epi32(0, inputs[BLU_C].d, inputs[GRN_C].d, inputs[RED_C].d);
+  __m128i result = _mm_sll_epi32(_mm_add_epi32(d, _mm_set1_epi32(m_BiasLUT[cc.bias])), lshift);
+  result = _mm_add_epi32(result, temp);
+  result = _mm_sra_epi32(result, _mm_cvtsi32_si128(m_ScaleRShiftLUT[cc.shift]));
+
+  // The results are within 16 bits, so the saturation doesn't change them
+  s16 results[8];
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(results), _mm_packs_epi32(result, result));
+  Reg[cc.dest][BLU_C] = results[BLU_C];
+  Reg[cc.dest][GRN_C] = results[GRN_C];
+  Reg[cc.dest][RED_C] = results[RED_C];
+#else
   for (int i = 0; i < 3; i++)
   {
     const InputRegType& InputReg = inputs[BLU_C + i];
@@ -240,6 +311,7 @@ void Tev::DrawColorRegular(const TevStageCombiner::ColorCombiner& cc, const Inpu
 
     Reg[cc.dest][BLU_C + i] = result;
   }
+#endif
 }
 
 void Tev::DrawColorCompare(const TevStageCombiner::ColorCombiner& cc, const InputRegType inputs[4])
@@ -567,7 +639,7 @@ void Tev::Draw()
   _assert_(Position[0] >= 0 && Position[0] < EFB_WIDTH);
   _assert_(Position[1] >= 0 && Position[1] < EFB_HEIGHT);
 
-  INCSTAT(stats.thisFrame.tevPixelsIn);
+  m_pixels_in++;
 
   // initial color values
   for (int i = 0; i < 4; i++)
@@ -832,23 +904,21 @@ void Tev::Draw()
   if (late_ztest && bpmem.zmode.testenable)
   {
     // TODO: Check against hw if these values get incremented even if depth testing is disabled
-    EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_INPUT);
+    IncPerfCounter(PQ_ZCOMP_INPUT);
 
     if (!EfbInterface::ZCompare(Position[0], Position[1], Position[2]))
       return;
 
-    EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_OUTPUT);
+    IncPerfCounter(PQ_ZCOMP_OUTPUT);
   }
 
   // branchless bounding box update
-  BoundingBox::coords[BoundingBox::LEFT] =
-      std::min((u16)Position[0], BoundingBox::coords[BoundingBox::LEFT]);
-  BoundingBox::coords[BoundingBox::RIGHT] =
-      std::max((u16)Position[0], BoundingBox::coords[BoundingBox::RIGHT]);
-  BoundingBox::coords[BoundingBox::TOP] =
-      std::min((u16)Position[1], BoundingBox::coords[BoundingBox::TOP]);
-  BoundingBox::coords[BoundingBox::BOTTOM] =
-      std::max((u16)Position[1], BoundingBox::coords[BoundingBox::BOTTOM]);
+  m_bounding_box[BoundingBox::LEFT] = std::min((u16)Position[0], m_bounding_box[BoundingBox::LEFT]);
+  m_bounding_box[BoundingBox::RIGHT] =
+      std::max((u16)Position[0], m_bounding_box[BoundingBox::RIGHT]);
+  m_bounding_box[BoundingBox::TOP] = std::min((u16)Position[1], m_bounding_box[BoundingBox::TOP]);
+  m_bounding_box[BoundingBox::BOTTOM] =
+      std::max((u16)Position[1], m_bounding_box[BoundingBox::BOTTOM]);
 
 #if ALLOW_TEV_DUMPS
   if (g_ActiveConfig.bDumpTevStages)
@@ -870,8 +940,8 @@ void Tev::Draw()
   }
 #endif
 
-  INCSTAT(stats.thisFrame.tevPixelsOut);
-  EfbInterface::IncPerfCounterQuadCount(PQ_BLEND_INPUT);
+  m_pixels_out++;
+  IncPerfCounter(PQ_BLEND_INPUT);
 
   EfbInterface::BlendTev(Position[0], Position[1], output);
 }
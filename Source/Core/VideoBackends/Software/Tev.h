@@ -4,7 +4,9 @@
 
 #pragma once
 
+#include "Common/CommonTypes.h"
 #include "VideoCommon/BPMemory.h"
+#include "VideoCommon/PerfQueryBase.h"
 
 class Tev
 {
@@ -66,6 +68,15 @@ class Tev
 
   void Indirect(unsigned int stageNum, s32 s, s32 t);
 
+  // Totals of the pixels drawn since the last FlushCounters(). They are kept per instance, so
+  // that instances drawing on different threads don't share any state.
+  u32 m_pixels_in;
+  u32 m_pixels_out;
+  u32 m_perf_pixels[PQ_NUM_MEMBERS];
+  u16 m_bounding_box[4];
+
+  void ResetCounters();
+
 public:
   s32 Position[3];
   u8 Color[2][4];  // must be RGBA for correct swap table ordering
@@ -88,4 +99,9 @@ public:
   void Draw();
 
   void SetRegColor(int reg, int comp, s16 color);
+
+  void IncPerfCounter(PerfQueryType type) { ++m_perf_pixels[type]; }
+  // Adds the counts of the pixels drawn to the statistics, the performance counters and the
+  // bounding box. Must be called on the GPU thread, while no other instance is drawing.
+  void FlushCounters();
 };
@@ -6,14 +6,20 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 
 #include "Common/CommonTypes.h"
+#include "Common/Intrinsics.h"
 #include "Core/HW/Memmap.h"
 
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/SamplerCommon.h"
 #include "VideoCommon/TextureDecoder.h"
 
+#ifdef _M_ARM_64
+#include <arm_neon.h>
+#endif
+
 #define ALLOW_MIPMAP 1
 
 namespace TextureSampler
@@ -43,20 +49,60 @@ static inline void WrapCoord(int* coordp, int wrapMode, int imageSize)
   *coordp = coord;
 }
 
-static inline void SetTexel(const u8* inTexel, u32* outTexel, u32 fract)
+// Sums the texels multiplied by their weights, and shifts the sums right by the given amount.
+// The four components are computed in the lanes of a vector. Everything is an integer, so the
+// results are the same as the scalar code. The weights must be below 32768.
+template <int N>
+static inline void BlendTexels(const u8 (&texels)[N][4], const u16 (&weights)[N], int shift,
+                               u8* sample)
 {
-  outTexel[0] = inTexel[0] * fract;
-  outTexel[1] = inTexel[1] * fract;
-  outTexel[2] = inTexel[2] * fract;
-  outTexel[3] = inTexel[3] * fract;
-}
+  static_assert(N % 2 == 0, "Texels are blended in pairs");
 
-static inline void AddTexel(const u8* inTexel, u32* outTexel, u32 fract)
-{
-  outTexel[0] += inTexel[0] * fract;
-  outTexel[1] += inTexel[1] * fract;
-  outTexel[2] += inTexel[2] * fract;
-  outTexel[3] += inTexel[3] * fract;
+#if defined(_M_X86)
+  __m128i sum = _mm_setzero_si128();
+  for (int i = 0; i < N; i += 2)
+  {
+    u32 texel0, texel1;
+    std::memcpy(&texel0, texels[i], sizeof(u32));
+    std::memcpy(&texel1, texels[i + 1], sizeof(u32));
+
+    // Interleave the components of the two texels as 16 bits, to multiply and add them at once
+    const __m128i pair = _mm_unpacklo_epi8(
+        _mm_unpacklo_epi8(_mm_cvtsi32_si128(texel0), _mm_cvtsi32_si128(texel1)),
+        _mm_setzero_si128());
+    const __m128i pair_weights = _mm_set1_epi32(weights[i] | (weights[i + 1] << 16));
+    sum = _mm_add_epi32(sum, _mm_madd_epi16(pair, pair_weights));
+  }
+
+  sum = _mm_srl_epi32(sum, _mm_cvtsi32_si128(shift));
+  sum = _mm_packs_epi32(sum, sum);
+  const u32 result = _mm_cvtsi128_si32(_mm_packus_epi16(sum, sum));
+  std::memcpy(sample, &result, sizeof(u32));
+#elif defined(_M_ARM_64)
+  uint32x4_t sum = vdupq_n_u32(0);
+  for (int i = 0; i < N; i++)
+  {
+    u32 texel;
+    std::memcpy(&texel, texels[i], sizeof(u32));
+    const uint16x4_t components = vget_low_u16(vmovl_u8(vcreate_u8(texel)));
+    sum = vmlal_n_u16(sum, components, weights[i]);
+  }
+
+  sum = vshlq_u32(sum, vdupq_n_s32(-shift));
+  const uint16x4_t narrow = vmovn_u32(sum);
+  const uint8x8_t result = vmovn_u16(vcombine_u16(narrow, narrow));
+  vst1_lane_u32(reinterpret_cast<uint32_t*>(sample), vreinterpret_u32_u8(result), 0);
+#else
+  u32 sum[4] = {};
+  for (int i = 0; i < N; i++)
+  {
+    for (int comp = 0; comp < 4; comp++)
+      sum[comp] += texels[i][comp] * weights[i];
+  }
+
+  for (int comp = 0; comp < 4; comp++)
+    sample[comp] = (u8)(sum[comp] >> shift);
+#endif
 }
 
 void Sample(s32 s, s32 t, s32 lod, bool linear, u8 texmap, u8* sample)
@@ -82,19 +128,13 @@ void Sample(s32 s, s32 t, s32 lod, bool linear, u8 texmap, u8* sample)
 
   if (mipLinear)
   {
-    u8 sampledTex[4];
-    u32 texel[4];
+    u8 sampledTex[2][4];
 
-    SampleMip(s, t, baseMip, linear, texmap, sampledTex);
-    SetTexel(sampledTex, texel, (16 - lodFract));
+    SampleMip(s, t, baseMip, linear, texmap, sampledTex[0]);
+    SampleMip(s, t, baseMip + 1, linear, texmap, sampledTex[1]);
 
-    SampleMip(s, t, baseMip + 1, linear, texmap, sampledTex);
-    AddTexel(sampledTex, texel, lodFract);
-
-    sample[0] = (u8)(texel[0] >> 4);
-    sample[1] = (u8)(texel[1] >> 4);
-    sample[2] = (u8)(texel[2] >> 4);
-    sample[3] = (u8)(texel[3] >> 4);
+    const u16 weights[2] = {static_cast<u16>(16 - lodFract), static_cast<u16>(lodFract)};
+    BlendTexels(sampledTex, weights, 4, sample);
   }
   else
 #endif
@@ -180,8 +220,7 @@ void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample)
     int imageTPlus1 = imageT + 1;
     const int fractT = t & 0x7f;
 
-    u8 sampledTex[4];
-    u32 texel[4];
+    u8 sampledTex[4][4];
 
     WrapCoord(&imageS, tm0.wrap_s, imageWidth);
     WrapCoord(&imageT, tm0.wrap_t, imageHeight);
@@ -190,45 +229,32 @@ void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample)
 
     if (!(texfmt == TextureFormat::RGBA8 && texUnit.texImage1[subTexmap].image_type))
     {
-      TexDecoder_DecodeTexel(sampledTex, imageSrc, imageS, imageT, imageWidth, texfmt, tlut,
-                             tlutfmt);
-      SetTexel(sampledTex, texel, (128 - fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexel(sampledTex, imageSrc, imageSPlus1, imageT, imageWidth, texfmt, tlut,
+      TexDecoder_DecodeTexel(sampledTex[0], imageSrc, imageS, imageT, imageWidth, texfmt, tlut,
                              tlutfmt);
-      AddTexel(sampledTex, texel, (fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexel(sampledTex, imageSrc, imageS, imageTPlus1, imageWidth, texfmt, tlut,
-                             tlutfmt);
-      AddTexel(sampledTex, texel, (128 - fractS) * (fractT));
-
-      TexDecoder_DecodeTexel(sampledTex, imageSrc, imageSPlus1, imageTPlus1, imageWidth, texfmt,
+      TexDecoder_DecodeTexel(sampledTex[1], imageSrc, imageSPlus1, imageT, imageWidth, texfmt,
+                             tlut, tlutfmt);
+      TexDecoder_DecodeTexel(sampledTex[2], imageSrc, imageS, imageTPlus1, imageWidth, texfmt,
                              tlut, tlutfmt);
-      AddTexel(sampledTex, texel, (fractS) * (fractT));
+      TexDecoder_DecodeTexel(sampledTex[3], imageSrc, imageSPlus1, imageTPlus1, imageWidth,
+                             texfmt, tlut, tlutfmt);
     }
     else
     {
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, imageSrc, imageSrcOdd, imageS, imageT,
+      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex[0], imageSrc, imageSrcOdd, imageS, imageT,
                                           imageWidth);
-      SetTexel(sampledTex, texel, (128 - fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, imageSrc, imageSrcOdd, imageSPlus1, imageT,
-                                          imageWidth);
-      AddTexel(sampledTex, texel, (fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, imageSrc, imageSrcOdd, imageS, imageTPlus1,
-                                          imageWidth);
-      AddTexel(sampledTex, texel, (128 - fractS) * (fractT));
-
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, imageSrc, imageSrcOdd, imageSPlus1,
+      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex[1], imageSrc, imageSrcOdd, imageSPlus1,
+                                          imageT, imageWidth);
+      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex[2], imageSrc, imageSrcOdd, imageS,
+                                          imageTPlus1, imageWidth);
+      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex[3], imageSrc, imageSrcOdd, imageSPlus1,
                                           imageTPlus1, imageWidth);
-      AddTexel(sampledTex, texel, (fractS) * (fractT));
     }
 
-    sample[0] = (u8)(texel[0] >> 14);
-    sample[1] = (u8)(texel[1] >> 14);
-    sample[2] = (u8)(texel[2] >> 14);
-    sample[3] = (u8)(texel[3] >> 14);
+    const u16 weights[4] = {static_cast<u16>((128 - fractS) * (128 - fractT)),
+                            static_cast<u16>(fractS * (128 - fractT)),
+                            static_cast<u16>((128 - fractS) * fractT),
+                            static_cast<u16>(fractS * fractT)};
+    BlendTexels(sampledTex, weights, 14, sample);
   }
   else
   {
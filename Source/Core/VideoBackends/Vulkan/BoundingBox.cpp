@@ -2,6 +2,7 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <functional>
 #include <vector>
 
 #include "Common/Assert.h"
@@ -17,6 +18,8 @@
 #include "VideoBackends/Vulkan/Util.h"
 #include "VideoBackends/Vulkan/VulkanContext.h"
 
+#include "VideoCommon/VideoConfig.h"
+
 namespace Vulkan
 {
 BoundingBox::BoundingBox()
@@ -25,6 +28,9 @@ BoundingBox::BoundingBox()
 
 BoundingBox::~BoundingBox()
 {
+  if (m_async_readback_buffer)
+    g_command_buffer_mgr->RemoveFencePointCallback(this);
+
   if (m_gpu_buffer != VK_NULL_HANDLE)
   {
     vkDestroyBuffer(g_vulkan_context->GetDevice(), m_gpu_buffer, nullptr);
@@ -46,6 +52,11 @@ bool BoundingBox::Initialize()
   if (!CreateReadbackBuffer())
     return false;
 
+  // The completion of asynchronous readbacks is tracked through the command buffer fences.
+  g_command_buffer_mgr->AddFencePointCallback(
+      this, [](VkCommandBuffer, VkFence) {},
+      std::bind(&BoundingBox::OnCommandBufferExecuted, this, std::placeholders::_1));
+
   return true;
 }
 
@@ -112,6 +123,7 @@ void BoundingBox::Invalidate()
     return;
 
   m_valid = false;
+  m_drawn_since_async_readback = true;
 }
 
 s32 BoundingBox::Get(size_t index)
@@ -119,7 +131,13 @@ s32 BoundingBox::Get(size_t index)
   _assert_(index < NUM_VALUES);
 
   if (!m_valid)
-    Readback();
+  {
+    // There's nothing to return until the first readback, so that one has to wait.
+    if (g_ActiveConfig.bBBoxAsyncReadback && m_has_read_back)
+      ReadbackAsync();
+    else
+      Readback();
+  }
 
   s32 value;
   m_readback_buffer->Read(index * sizeof(s32), &value, sizeof(value), false);
@@ -207,14 +225,19 @@ bool BoundingBox::CreateReadbackBuffer()
 {
   m_readback_buffer = StagingBuffer::Create(STAGING_BUFFER_TYPE_READBACK, BUFFER_SIZE,
                                             VK_BUFFER_USAGE_TRANSFER_DST_BIT);
+  m_async_readback_buffer = StagingBuffer::Create(STAGING_BUFFER_TYPE_READBACK, BUFFER_SIZE,
+                                                  VK_BUFFER_USAGE_TRANSFER_DST_BIT);
 
-  if (!m_readback_buffer || !m_readback_buffer->Map())
+  if (!m_readback_buffer || !m_readback_buffer->Map() || !m_async_readback_buffer ||
+      !m_async_readback_buffer->Map())
+  {
     return false;
+  }
 
   return true;
 }
 
-void BoundingBox::Readback()
+void BoundingBox::CopyToReadbackBuffer(StagingBuffer* buffer)
 {
   // Can't be done within a render pass.
   StateTracker::GetInstance()->EndRenderPass();
@@ -224,22 +247,26 @@ void BoundingBox::Readback()
       g_command_buffer_mgr->GetCurrentCommandBuffer(), m_gpu_buffer,
       VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT, 0,
       BUFFER_SIZE, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
-  m_readback_buffer->PrepareForGPUWrite(g_command_buffer_mgr->GetCurrentCommandBuffer(),
-                                        VK_ACCESS_TRANSFER_WRITE_BIT,
-                                        VK_PIPELINE_STAGE_TRANSFER_BIT);
+  buffer->PrepareForGPUWrite(g_command_buffer_mgr->GetCurrentCommandBuffer(),
+                             VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
 
   // Copy from GPU -> readback buffer.
   VkBufferCopy region = {0, 0, BUFFER_SIZE};
   vkCmdCopyBuffer(g_command_buffer_mgr->GetCurrentCommandBuffer(), m_gpu_buffer,
-                  m_readback_buffer->GetBuffer(), 1, &region);
+                  buffer->GetBuffer(), 1, &region);
 
   // Restore GPU buffer access.
   Util::BufferMemoryBarrier(g_command_buffer_mgr->GetCurrentCommandBuffer(), m_gpu_buffer,
                             VK_ACCESS_TRANSFER_READ_BIT,
                             VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT, 0, BUFFER_SIZE,
                             VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT);
-  m_readback_buffer->FlushGPUCache(g_command_buffer_mgr->GetCurrentCommandBuffer(),
-                                   VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
+  buffer->FlushGPUCache(g_command_buffer_mgr->GetCurrentCommandBuffer(),
+                        VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
+}
+
+void BoundingBox::Readback()
+{
+  CopyToReadbackBuffer(m_readback_buffer.get());
 
   // Wait until these commands complete.
   Util::ExecuteCurrentCommandsAndRestoreState(false, true);
@@ -247,6 +274,61 @@ void BoundingBox::Readback()
   // Cache is now valid.
   m_readback_buffer->InvalidateCPUCache();
   m_valid = true;
+  m_has_read_back = true;
+}
+
+void BoundingBox::ReadbackAsync()
+{
+  if (m_async_readback_pending)
+  {
+    if (!IsAsyncReadbackComplete())
+      return;
+
+    // Values the game has written since are newer than the ones read back.
+    m_async_readback_buffer->InvalidateCPUCache();
+    for (size_t i = 0; i < NUM_VALUES; i++)
+    {
+      if (m_values_dirty[i])
+        continue;
+
+      s32 value;
+      m_async_readback_buffer->Read(i * sizeof(s32), &value, sizeof(value), false);
+      m_readback_buffer->Write(i * sizeof(s32), &value, sizeof(value), false);
+    }
+    m_async_readback_pending = false;
+
+    // Without any draws after the copy, the values are exact and no new copy is needed.
+    if (!m_drawn_since_async_readback)
+    {
+      m_valid = true;
+      return;
+    }
+  }
+
+  CopyToReadbackBuffer(m_async_readback_buffer.get());
+  m_async_readback_fence = g_command_buffer_mgr->GetCurrentCommandBufferFence();
+  m_async_readback_pending = true;
+  m_async_readback_complete = false;
+  m_drawn_since_async_readback = false;
+
+  // Submit in the background, so that the values are ready as soon as possible.
+  Util::ExecuteCurrentCommandsAndRestoreState(true, false);
+}
+
+bool BoundingBox::IsAsyncReadbackComplete() const
+{
+  if (m_async_readback_complete)
+    return true;
+
+  // The fence of the current command buffer hasn't been submitted, and can't be polled.
+  return m_async_readback_fence != g_command_buffer_mgr->GetCurrentCommandBufferFence() &&
+         vkGetFenceStatus(g_vulkan_context->GetDevice(), m_async_readback_fence) == VK_SUCCESS;
+}
+
+void BoundingBox::OnCommandBufferExecuted(VkFence fence)
+{
+  if (m_async_readback_pending && fence == m_async_readback_fence)
+    m_async_readback_complete = true;
 }
 
 }  // namespace Vulkan
@@ -36,8 +36,15 @@ public:
 private:
   bool CreateGPUBuffer();
   bool CreateReadbackBuffer();
+  void CopyToReadbackBuffer(StagingBuffer* buffer);
   void Readback();
 
+  // Records a copy of the GPU buffer without waiting for it, and picks up the previous copy once
+  // the GPU has finished with it. Until then, Get() keeps returning the last values read back.
+  void ReadbackAsync();
+  bool IsAsyncReadbackComplete() const;
+  void OnCommandBufferExecuted(VkFence fence);
+
   VkBuffer m_gpu_buffer = VK_NULL_HANDLE;
   VkDeviceMemory m_gpu_memory = VK_NULL_HANDLE;
 
@@ -47,6 +54,14 @@ private:
   std::unique_ptr<StagingBuffer> m_readback_buffer;
   std::array<bool, NUM_VALUES> m_values_dirty = {};
   bool m_valid = true;
+
+  std::unique_ptr<StagingBuffer> m_async_readback_buffer;
+  VkFence m_async_readback_fence = VK_NULL_HANDLE;
+  bool m_async_readback_pending = false;
+  bool m_async_readback_complete = false;
+  // Set when the game draws after the pending copy was recorded, so its values may be stale.
+  bool m_drawn_since_async_readback = false;
+  bool m_has_read_back = false;
 };
 
 }  // namespace Vulkan
@@ -10,12 +10,22 @@
 #include "Common/MsgHandler.h"
 
 #include "VideoBackends/Vulkan/CommandBufferManager.h"
+#include "VideoBackends/Vulkan/SwapChain.h"
 #include "VideoBackends/Vulkan/VulkanContext.h"
 
 namespace Vulkan
 {
-CommandBufferManager::CommandBufferManager(bool use_threaded_submission)
-    : m_submit_semaphore(1, 1), m_use_threaded_submission(use_threaded_submission)
+static size_t ClampNumCommandBuffers(size_t count)
+{
+  return std::min(std::max(count, MIN_COMMAND_BUFFERS), MAX_COMMAND_BUFFERS);
+}
+
+CommandBufferManager::CommandBufferManager(bool use_threaded_submission,
+                                           size_t num_command_buffers)
+    : m_frame_resources(ClampNumCommandBuffers(num_command_buffers)),
+      m_submit_slots(m_frame_resources.size() - 1),
+      m_submit_semaphore(static_cast<int>(m_submit_slots), static_cast<int>(m_submit_slots)),
+      m_use_threaded_submission(use_threaded_submission)
 {
 }
 
@@ -25,7 +35,7 @@ CommandBufferManager::~CommandBufferManager()
   if (m_use_threaded_submission)
   {
     // Wait for all command buffers to be consumed by the worker thread.
-    m_submit_semaphore.Wait();
+    WaitForWorkerThreadIdle();
     m_submit_loop->Stop();
     m_submit_thread.join();
   }
@@ -77,6 +87,24 @@ bool CommandBufferManager::CreateCommandBuffers()
       return false;
     }
 
+    buffer_info.commandBufferCount = 1;
+    res = vkAllocateCommandBuffers(device, &buffer_info, &resources.present_command_buffer);
+    if (res != VK_SUCCESS)
+    {
+      LOG_VULKAN_ERROR(res, "vkAllocateCommandBuffers failed: ");
+      return false;
+    }
+
+    VkSemaphoreCreateInfo semaphore_info = {VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO, nullptr, 0};
+    if ((res = vkCreateSemaphore(device, &semaphore_info, nullptr,
+                                 &resources.image_available_semaphore)) != VK_SUCCESS ||
+        (res = vkCreateSemaphore(device, &semaphore_info, nullptr,
+                                 &resources.rendering_finished_semaphore)) != VK_SUCCESS)
+    {
+      LOG_VULKAN_ERROR(res, "vkCreateSemaphore failed: ");
+      return false;
+    }
+
     VkFenceCreateInfo fence_info = {VK_STRUCTURE_TYPE_FENCE_CREATE_INFO, nullptr,
                                     VK_FENCE_CREATE_SIGNALED_BIT};
 
@@ -135,6 +163,21 @@ void CommandBufferManager::DestroyCommandBuffers()
       vkDestroyDescriptorPool(device, resources.descriptor_pool, nullptr);
       resources.descriptor_pool = VK_NULL_HANDLE;
     }
+    if (resources.image_available_semaphore != VK_NULL_HANDLE)
+    {
+      vkDestroySemaphore(device, resources.image_available_semaphore, nullptr);
+      resources.image_available_semaphore = VK_NULL_HANDLE;
+    }
+    if (resources.rendering_finished_semaphore != VK_NULL_HANDLE)
+    {
+      vkDestroySemaphore(device, resources.rendering_finished_semaphore, nullptr);
+      resources.rendering_finished_semaphore = VK_NULL_HANDLE;
+    }
+    if (resources.present_command_buffer != VK_NULL_HANDLE)
+    {
+      vkFreeCommandBuffers(device, resources.command_pool, 1, &resources.present_command_buffer);
+      resources.present_command_buffer = VK_NULL_HANDLE;
+    }
     if (resources.command_buffers[0] != VK_NULL_HANDLE)
     {
       vkFreeCommandBuffers(device, resources.command_pool,
@@ -188,8 +231,7 @@ bool CommandBufferManager::CreateSubmitThread()
         m_pending_submits.pop_front();
       }
 
-      SubmitCommandBuffer(submit.index, submit.wait_semaphore, submit.signal_semaphore,
-                          submit.present_swap_chain, submit.present_image_index);
+      SubmitCommandBuffer(submit.index, submit.present_swap_chain, submit.present_image_index);
     });
   });
 
@@ -206,9 +248,16 @@ void CommandBufferManager::PrepareToSubmitCommandBuffer()
 
 void CommandBufferManager::WaitForWorkerThreadIdle()
 {
-  // Drain the semaphore, then allow another request in the future.
-  m_submit_semaphore.Wait();
-  m_submit_semaphore.Post();
+  DrainPendingSubmits(0);
+}
+
+void CommandBufferManager::DrainPendingSubmits(size_t held_slots)
+{
+  // Drain the rest of the semaphore, then allow other requests in the future.
+  for (size_t i = held_slots; i < m_submit_slots; i++)
+    m_submit_semaphore.Wait();
+  for (size_t i = held_slots; i < m_submit_slots; i++)
+    m_submit_semaphore.Post();
 }
 
 void CommandBufferManager::WaitForGPUIdle()
@@ -245,10 +294,7 @@ void CommandBufferManager::WaitForFence(VkFence fence)
 }
 
 void CommandBufferManager::SubmitCommandBuffer(bool submit_on_worker_thread,
-                                               VkSemaphore wait_semaphore,
-                                               VkSemaphore signal_semaphore,
-                                               VkSwapchainKHR present_swap_chain,
-                                               uint32_t present_image_index)
+                                               SwapChain* present_swap_chain)
 {
   FrameResources& resources = m_frame_resources[m_current_frame];
 
@@ -271,14 +317,20 @@ void CommandBufferManager::SubmitCommandBuffer(bool submit_on_worker_thread,
   // This command buffer now has commands, so can't be re-used without waiting.
   resources.needs_fence_wait = true;
 
+  // Without deferred acquisition, the image has been acquired by this thread, which may acquire
+  // another before the worker presents this one.
+  const uint32_t present_image_index =
+      present_swap_chain && !present_swap_chain->IsAcquireDeferred() ?
+          present_swap_chain->GetCurrentImageIndex() :
+          0xFFFFFFFF;
+
   // Submitting off-thread?
   if (m_use_threaded_submission && submit_on_worker_thread)
   {
     // Push to the pending submit queue.
     {
       std::lock_guard<std::mutex> guard(m_pending_submit_lock);
-      m_pending_submits.push_back({m_current_frame, wait_semaphore, signal_semaphore,
-                                   present_swap_chain, present_image_index});
+      m_pending_submits.push_back({m_current_frame, present_swap_chain, present_image_index});
     }
 
     // Wake up the worker thread for a single iteration.
@@ -286,18 +338,28 @@ void CommandBufferManager::SubmitCommandBuffer(bool submit_on_worker_thread,
   }
   else
   {
+    // The worker thread may still have earlier command buffers to submit, which must go first.
+    // The caller holds one slot of the semaphore already.
+    if (m_use_threaded_submission)
+      DrainPendingSubmits(1);
+
     // Pass through to normal submission path.
-    SubmitCommandBuffer(m_current_frame, wait_semaphore, signal_semaphore, present_swap_chain,
-                        present_image_index);
+    SubmitCommandBuffer(m_current_frame, present_swap_chain, present_image_index);
   }
 }
 
-void CommandBufferManager::SubmitCommandBuffer(size_t index, VkSemaphore wait_semaphore,
-                                               VkSemaphore signal_semaphore,
-                                               VkSwapchainKHR present_swap_chain,
+void CommandBufferManager::SubmitCommandBuffer(size_t index, SwapChain* present_swap_chain,
                                                uint32_t present_image_index)
 {
   FrameResources& resources = m_frame_resources[index];
+  const bool deferred_acquire = present_swap_chain && present_swap_chain->IsAcquireDeferred();
+  VkSemaphore wait_semaphore = VK_NULL_HANDLE;
+  VkSemaphore signal_semaphore = VK_NULL_HANDLE;
+  if (present_swap_chain && !deferred_acquire)
+  {
+    wait_semaphore = resources.image_available_semaphore;
+    signal_semaphore = resources.rendering_finished_semaphore;
+  }
 
   // This may be executed on the worker thread, so don't modify any state of the manager class.
   uint32_t wait_bits = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
@@ -330,42 +392,105 @@ void CommandBufferManager::SubmitCommandBuffer(size_t index, VkSemaphore wait_se
     submit_info.pSignalSemaphores = &signal_semaphore;
   }
 
-  VkResult res =
-      vkQueueSubmit(g_vulkan_context->GetGraphicsQueue(), 1, &submit_info, resources.fence);
+  // With deferred acquisition, the fence is signaled by the present command buffer instead, which
+  // also covers everything submitted before it.
+  VkResult res = vkQueueSubmit(g_vulkan_context->GetGraphicsQueue(), 1, &submit_info,
+                               deferred_acquire ? VK_NULL_HANDLE : resources.fence);
   if (res != VK_SUCCESS)
   {
     LOG_VULKAN_ERROR(res, "vkQueueSubmit failed: ");
     PanicAlert("Failed to submit command buffer.");
   }
 
-  // Do we have a swap chain to present?
-  if (present_swap_chain != VK_NULL_HANDLE)
+  // The frame is queued already, so the GPU works on it while this thread waits for an image.
+  if (deferred_acquire)
   {
-    // Should have a signal semaphore.
-    _assert_(signal_semaphore != VK_NULL_HANDLE);
-    VkPresentInfoKHR present_info = {VK_STRUCTURE_TYPE_PRESENT_INFO_KHR,
-                                     nullptr,
-                                     1,
-                                     &signal_semaphore,
-                                     1,
-                                     &present_swap_chain,
-                                     &present_image_index,
-                                     nullptr};
-
-    res = vkQueuePresentKHR(g_vulkan_context->GetPresentQueue(), &present_info);
-    if (res != VK_SUCCESS)
+    if (RecordPresentCommandBuffer(index, present_swap_chain))
+    {
+      present_image_index = present_swap_chain->GetCurrentImageIndex();
+    }
+    else
     {
-      // VK_ERROR_OUT_OF_DATE_KHR is not fatal, just means we need to recreate our swap chain.
-      if (res != VK_ERROR_OUT_OF_DATE_KHR && res != VK_SUBOPTIMAL_KHR)
-        LOG_VULKAN_ERROR(res, "vkQueuePresentKHR failed: ");
+      // Nothing to present to, but the fence still has to be signaled.
+      res = vkQueueSubmit(g_vulkan_context->GetGraphicsQueue(), 0, nullptr, resources.fence);
+      if (res != VK_SUCCESS)
+        LOG_VULKAN_ERROR(res, "vkQueueSubmit failed: ");
       m_present_failed_flag.Set();
+      present_swap_chain = nullptr;
     }
   }
 
+  // Do we have a swap chain to present?
+  if (present_swap_chain)
+    PresentImage(index, present_swap_chain, present_image_index);
+
   // Command buffer has been queued, so permit the next one.
   m_submit_semaphore.Post();
 }
 
+bool CommandBufferManager::RecordPresentCommandBuffer(size_t index, SwapChain* swap_chain)
+{
+  FrameResources& resources = m_frame_resources[index];
+  VkResult res = swap_chain->AcquireNextImage(resources.image_available_semaphore);
+  if (res != VK_SUCCESS && res != VK_SUBOPTIMAL_KHR)
+    return false;
+
+  // A suboptimal image can still be presented, but the swap chain should be recreated.
+  if (res == VK_SUBOPTIMAL_KHR)
+    m_present_failed_flag.Set();
+
+  VkCommandBufferBeginInfo begin_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO, nullptr,
+                                         VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT, nullptr};
+  res = vkBeginCommandBuffer(resources.present_command_buffer, &begin_info);
+  if (res != VK_SUCCESS)
+    LOG_VULKAN_ERROR(res, "vkBeginCommandBuffer failed: ");
+  swap_chain->RecordPresentCopy(resources.present_command_buffer);
+  res = vkEndCommandBuffer(resources.present_command_buffer);
+  if (res != VK_SUCCESS)
+    LOG_VULKAN_ERROR(res, "vkEndCommandBuffer failed: ");
+
+  uint32_t wait_bits = VK_PIPELINE_STAGE_TRANSFER_BIT;
+  VkSubmitInfo submit_info = {VK_STRUCTURE_TYPE_SUBMIT_INFO,
+                              nullptr,
+                              1,
+                              &resources.image_available_semaphore,
+                              &wait_bits,
+                              1,
+                              &resources.present_command_buffer,
+                              1,
+                              &resources.rendering_finished_semaphore};
+  res = vkQueueSubmit(g_vulkan_context->GetGraphicsQueue(), 1, &submit_info, resources.fence);
+  if (res != VK_SUCCESS)
+  {
+    LOG_VULKAN_ERROR(res, "vkQueueSubmit failed: ");
+    PanicAlert("Failed to submit command buffer.");
+  }
+
+  return true;
+}
+
+void CommandBufferManager::PresentImage(size_t index, SwapChain* swap_chain, uint32_t image_index)
+{
+  VkSwapchainKHR vk_swap_chain = swap_chain->GetSwapChain();
+  VkPresentInfoKHR present_info = {VK_STRUCTURE_TYPE_PRESENT_INFO_KHR,
+                                   nullptr,
+                                   1,
+                                   &m_frame_resources[index].rendering_finished_semaphore,
+                                   1,
+                                   &vk_swap_chain,
+                                   &image_index,
+                                   nullptr};
+
+  VkResult res = vkQueuePresentKHR(g_vulkan_context->GetPresentQueue(), &present_info);
+  if (res != VK_SUCCESS)
+  {
+    // VK_ERROR_OUT_OF_DATE_KHR is not fatal, just means we need to recreate our swap chain.
+    if (res != VK_ERROR_OUT_OF_DATE_KHR && res != VK_SUBOPTIMAL_KHR)
+      LOG_VULKAN_ERROR(res, "vkQueuePresentKHR failed: ");
+    m_present_failed_flag.Set();
+  }
+}
+
 void CommandBufferManager::OnCommandBufferExecuted(size_t index)
 {
   FrameResources& resources = m_frame_resources[index];
@@ -383,7 +508,7 @@ void CommandBufferManager::OnCommandBufferExecuted(size_t index)
 void CommandBufferManager::ActivateCommandBuffer()
 {
   // Move to the next command buffer.
-  m_current_frame = (m_current_frame + 1) % NUM_COMMAND_BUFFERS;
+  m_current_frame = (m_current_frame + 1) % m_frame_resources.size();
   FrameResources& resources = m_frame_resources[m_current_frame];
 
   // Wait for the GPU to finish with all resources for this command buffer.
@@ -481,6 +606,13 @@ void CommandBufferManager::DeferImageViewDestruction(VkImageView object)
       [object]() { vkDestroyImageView(g_vulkan_context->GetDevice(), object, nullptr); });
 }
 
+void CommandBufferManager::DeferSwapChainDestruction(VkSwapchainKHR object)
+{
+  FrameResources& resources = m_frame_resources[m_current_frame];
+  resources.cleanup_resources.push_back(
+      [object]() { vkDestroySwapchainKHR(g_vulkan_context->GetDevice(), object, nullptr); });
+}
+
 void CommandBufferManager::AddFencePointCallback(
     const void* key, const CommandBufferQueuedCallback& queued_callback,
     const CommandBufferExecutedCallback& executed_callback)
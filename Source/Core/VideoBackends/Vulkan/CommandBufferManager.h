@@ -26,10 +26,14 @@
 
 namespace Vulkan
 {
+class SwapChain;
+
 class CommandBufferManager
 {
 public:
-  explicit CommandBufferManager(bool use_threaded_submission);
+  // num_command_buffers is clamped to [MIN_COMMAND_BUFFERS, MAX_COMMAND_BUFFERS]. Up to one less
+  // than that many command buffers can be waiting for the worker thread.
+  CommandBufferManager(bool use_threaded_submission, size_t num_command_buffers);
   ~CommandBufferManager();
 
   bool Initialize();
@@ -55,6 +59,14 @@ public:
   // Gets the fence that will be signaled when the currently executing command buffer is
   // queued and executed. Do not wait for this fence before the buffer is executed.
   VkFence GetCurrentCommandBufferFence() const { return m_frame_resources[m_current_frame].fence; }
+
+  // Semaphore to acquire a swap chain image with, when the swap chain can't defer acquisition to
+  // the worker thread. It is waited for when the current command buffer is submitted.
+  VkSemaphore GetCurrentImageAvailableSemaphore() const
+  {
+    return m_frame_resources[m_current_frame].image_available_semaphore;
+  }
+
   // Ensure the worker thread has submitted the previous frame's command buffer.
   void PrepareToSubmitCommandBuffer();
 
@@ -69,11 +81,12 @@ public:
   // Also invokes callbacks for completion.
   void WaitForFence(VkFence fence);
 
-  void SubmitCommandBuffer(bool submit_on_worker_thread,
-                           VkSemaphore wait_semaphore = VK_NULL_HANDLE,
-                           VkSemaphore signal_semaphore = VK_NULL_HANDLE,
-                           VkSwapchainKHR present_swap_chain = VK_NULL_HANDLE,
-                           uint32_t present_image_index = 0xFFFFFFFF);
+  // Submits the current command buffer, then presents present_swap_chain if there is one. When
+  // the swap chain defers acquisition, the image is acquired after the submit, and the frame copied
+  // to it in a separate command buffer, so a worker thread blocked by the display doesn't hold up
+  // the GPU thread. Otherwise, the image must already have been acquired with the semaphore from
+  // GetCurrentImageAvailableSemaphore.
+  void SubmitCommandBuffer(bool submit_on_worker_thread, SwapChain* present_swap_chain = nullptr);
 
   void ActivateCommandBuffer();
 
@@ -89,6 +102,7 @@ public:
   void DeferFramebufferDestruction(VkFramebuffer object);
   void DeferImageDestruction(VkImage object);
   void DeferImageViewDestruction(VkImageView object);
+  void DeferSwapChainDestruction(VkSwapchainKHR object);
 
   // Instruct the manager to fire the specified callback when a fence is flagged to be signaled.
   // This happens when command buffers are executed, and can be tested if signaled, which means
@@ -107,8 +121,14 @@ private:
 
   bool CreateSubmitThread();
 
-  void SubmitCommandBuffer(size_t index, VkSemaphore wait_semaphore, VkSemaphore signal_semaphore,
-                           VkSwapchainKHR present_swap_chain, uint32_t present_image_index);
+  void SubmitCommandBuffer(size_t index, SwapChain* present_swap_chain,
+                           uint32_t present_image_index);
+  bool RecordPresentCommandBuffer(size_t index, SwapChain* swap_chain);
+  void PresentImage(size_t index, SwapChain* swap_chain, uint32_t image_index);
+
+  // Waits for the worker thread to submit everything queued, when the caller already holds
+  // held_slots of the submit semaphore.
+  void DrainPendingSubmits(size_t held_slots);
 
   void OnCommandBufferExecuted(size_t index);
 
@@ -117,6 +137,10 @@ private:
     // [0] - Init (upload) command buffer, [1] - draw command buffer
     VkCommandPool command_pool;
     std::array<VkCommandBuffer, 2> command_buffers;
+    // Copies the frame to the swap chain image, recorded by the worker thread once it's acquired
+    VkCommandBuffer present_command_buffer;
+    VkSemaphore image_available_semaphore;
+    VkSemaphore rendering_finished_semaphore;
     VkDescriptorPool descriptor_pool;
     VkFence fence;
     bool init_command_buffer_used;
@@ -125,7 +149,7 @@ private:
     std::vector<std::function<void()>> cleanup_resources;
   };
 
-  std::array<FrameResources, NUM_COMMAND_BUFFERS> m_frame_resources = {};
+  std::vector<FrameResources> m_frame_resources;
   size_t m_current_frame;
 
   // callbacks when a fence point is set
@@ -133,16 +157,16 @@ private:
       m_fence_point_callbacks;
 
   // Threaded command buffer execution
-  // Semaphore determines when a command buffer can be queued
+  // Semaphore determines when a command buffer can be queued, with one slot per command buffer
+  // which may wait for the worker thread
+  size_t m_submit_slots;
   Common::Semaphore m_submit_semaphore;
   std::thread m_submit_thread;
   std::unique_ptr<Common::BlockingLoop> m_submit_loop;
   struct PendingCommandBufferSubmit
   {
     size_t index;
-    VkSemaphore wait_semaphore;
-    VkSemaphore signal_semaphore;
-    VkSwapchainKHR present_swap_chain;
+    SwapChain* present_swap_chain;
     uint32_t present_image_index;
   };
   std::deque<PendingCommandBufferSubmit> m_pending_submits;
@@ -12,16 +12,19 @@
 
 namespace Vulkan
 {
-// Number of command buffers. Having two allows one buffer to be
-// executed whilst another is being built.
+// Range of the number of command buffers. Having two allows one buffer to be
+// executed whilst another is being built, more let the GPU thread run further ahead
+// of the submit thread and the GPU.
 
 #if defined(_MSC_VER) && _MSC_VER <= 1800
 enum
 {
-  NUM_COMMAND_BUFFERS = 2
+  MIN_COMMAND_BUFFERS = 2,
+  MAX_COMMAND_BUFFERS = 4
 };
 #else
-constexpr size_t NUM_COMMAND_BUFFERS = 2;
+constexpr size_t MIN_COMMAND_BUFFERS = 2;
+constexpr size_t MAX_COMMAND_BUFFERS = 4;
 #endif
 
 // Staging buffer usage - optimize for uploads or readbacks
@@ -709,6 +709,9 @@ void FramebufferManager::DestroyConversionShaders()
 
 u32 FramebufferManager::PeekEFBColor(u32 x, u32 y)
 {
+  m_color_peeked = true;
+  if (m_color_readback_texture_pending)
+    CompleteAsyncReadbacks();
   if (!m_color_readback_texture_valid && !PopulateColorReadbackTexture())
     return 0;
 
@@ -717,7 +720,7 @@ u32 FramebufferManager::PeekEFBColor(u32 x, u32 y)
   return value;
 }
 
-bool FramebufferManager::PopulateColorReadbackTexture()
+bool FramebufferManager::PopulateColorReadbackTexture(bool wait)
 {
   // Can't be in our normal render pass.
   StateTracker::GetInstance()->EndRenderPass();
@@ -776,19 +779,29 @@ bool FramebufferManager::PopulateColorReadbackTexture()
                                     VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
   }
 
-  // Wait until the copy is complete.
-  Util::ExecuteCurrentCommandsAndRestoreState(false, true);
-
   // Map to host memory.
   if (!m_color_readback_texture->IsMapped() && !m_color_readback_texture->Map())
     return false;
 
+  if (!wait)
+  {
+    m_color_readback_texture_pending = true;
+    m_readback_fence = g_command_buffer_mgr->GetCurrentCommandBufferFence();
+    return true;
+  }
+
+  // Wait until the copy is complete.
+  Util::ExecuteCurrentCommandsAndRestoreState(false, true);
+
   m_color_readback_texture_valid = true;
   return true;
 }
 
 float FramebufferManager::PeekEFBDepth(u32 x, u32 y)
 {
+  m_depth_peeked = true;
+  if (m_depth_readback_texture_pending)
+    CompleteAsyncReadbacks();
   if (!m_depth_readback_texture_valid && !PopulateDepthReadbackTexture())
     return 0.0f;
 
@@ -797,7 +810,7 @@ float FramebufferManager::PeekEFBDepth(u32 x, u32 y)
   return value;
 }
 
-bool FramebufferManager::PopulateDepthReadbackTexture()
+bool FramebufferManager::PopulateDepthReadbackTexture(bool wait)
 {
   // Can't be in our normal render pass.
   StateTracker::GetInstance()->EndRenderPass();
@@ -860,21 +873,74 @@ bool FramebufferManager::PopulateDepthReadbackTexture()
                                     VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
   }
 
-  // Wait until the copy is complete.
-  Util::ExecuteCurrentCommandsAndRestoreState(false, true);
-
   // Map to host memory.
   if (!m_depth_readback_texture->IsMapped() && !m_depth_readback_texture->Map())
     return false;
 
+  if (!wait)
+  {
+    m_depth_readback_texture_pending = true;
+    m_readback_fence = g_command_buffer_mgr->GetCurrentCommandBufferFence();
+    return true;
+  }
+
+  // Wait until the copy is complete.
+  Util::ExecuteCurrentCommandsAndRestoreState(false, true);
+
   m_depth_readback_texture_valid = true;
   return true;
 }
 
+void FramebufferManager::CompleteAsyncReadbacks()
+{
+  // The readbacks were submitted at the end of the previous frame, so this rarely has to wait.
+  // If the command buffer was re-used since, it has already been waited for.
+  g_command_buffer_mgr->WaitForFence(m_readback_fence);
+
+  if (m_color_readback_texture_pending)
+  {
+    m_color_readback_texture->InvalidateCPUCache();
+    m_color_readback_texture_pending = false;
+    m_color_readback_texture_valid = true;
+  }
+  if (m_depth_readback_texture_pending)
+  {
+    m_depth_readback_texture->InvalidateCPUCache();
+    m_depth_readback_texture_pending = false;
+    m_depth_readback_texture_valid = true;
+  }
+}
+
 void FramebufferManager::InvalidatePeekCache()
+{
+  // Asynchronous peeks keep using the previous frame's EFB until the end of this frame.
+  if (g_ActiveConfig.bAsyncEFBPeeks)
+    return;
+
+  m_color_readback_texture_valid = false;
+  m_depth_readback_texture_valid = false;
+  m_color_readback_texture_pending = false;
+  m_depth_readback_texture_pending = false;
+}
+
+void FramebufferManager::ReadbackEFBAsync()
 {
   m_color_readback_texture_valid = false;
   m_depth_readback_texture_valid = false;
+  m_color_readback_texture_pending = false;
+  m_depth_readback_texture_pending = false;
+
+  // Games which stop peeking fall back to populating the cache on demand.
+  if (g_ActiveConfig.bAsyncEFBPeeks)
+  {
+    if (m_color_peeked)
+      PopulateColorReadbackTexture(false);
+    if (m_depth_peeked)
+      PopulateDepthReadbackTexture(false);
+  }
+
+  m_color_peeked = false;
+  m_depth_peeked = false;
 }
 
 bool FramebufferManager::CreateReadbackRenderPasses()
@@ -1063,9 +1129,11 @@ void FramebufferManager::DestroyReadbackTextures()
   m_color_copy_texture.reset();
   m_color_readback_texture.reset();
   m_color_readback_texture_valid = false;
+  m_color_readback_texture_pending = false;
   m_depth_copy_texture.reset();
   m_depth_readback_texture.reset();
   m_depth_readback_texture_valid = false;
+  m_depth_readback_texture_pending = false;
 }
 
 bool FramebufferManager::CreateReadbackFramebuffer()
@@ -77,6 +77,9 @@ public:
   u32 PeekEFBColor(u32 x, u32 y);
   float PeekEFBDepth(u32 x, u32 y);
   void InvalidatePeekCache();
+  // With bAsyncEFBPeeks, reads back the EFB at the end of each frame in which it was peeked
+  // without waiting for it, and the next frame's peeks use this copy.
+  void ReadbackEFBAsync();
 
   // Writes a value to the framebuffer. This will never block, and writes will be batched.
   void PokeEFBColor(u32 x, u32 y, u32 color);
@@ -113,8 +116,9 @@ private:
   bool CompilePokeShaders();
   void DestroyPokeShaders();
 
-  bool PopulateColorReadbackTexture();
-  bool PopulateDepthReadbackTexture();
+  bool PopulateColorReadbackTexture(bool wait = true);
+  bool PopulateDepthReadbackTexture(bool wait = true);
+  void CompleteAsyncReadbacks();
 
   void CreatePokeVertices(std::vector<EFBPokeVertex>* destination_list, u32 x, u32 y, float z,
                           u32 color);
@@ -151,6 +155,12 @@ private:
   std::unique_ptr<StagingTexture2D> m_depth_readback_texture;
   bool m_color_readback_texture_valid = false;
   bool m_depth_readback_texture_valid = false;
+  // Asynchronous readbacks are complete once m_readback_fence is signaled.
+  bool m_color_readback_texture_pending = false;
+  bool m_depth_readback_texture_pending = false;
+  VkFence m_readback_fence = VK_NULL_HANDLE;
+  bool m_color_peeked = false;
+  bool m_depth_peeked = false;
 
   // EFB poke drawing setup
   std::unique_ptr<VertexFormat> m_poke_vertex_format;
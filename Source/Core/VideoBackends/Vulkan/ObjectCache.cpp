@@ -78,12 +78,11 @@ bool ObjectCache::Initialize()
 
 void ObjectCache::ClearSamplerCache()
 {
-  for (const auto& it : m_sampler_cache)
-  {
-    if (it.second != VK_NULL_HANDLE)
-      vkDestroySampler(g_vulkan_context->GetDevice(), it.second, nullptr);
-  }
-  m_sampler_cache.clear();
+  m_sampler_cache.ForEach([](VkSampler sampler) {
+    if (sampler != VK_NULL_HANDLE)
+      vkDestroySampler(g_vulkan_context->GetDevice(), sampler, nullptr);
+  });
+  m_sampler_cache.Clear();
 }
 
 void ObjectCache::DestroySamplers()
@@ -308,9 +307,8 @@ bool ObjectCache::CreateStaticSamplers()
 
 VkSampler ObjectCache::GetSampler(const SamplerState& info)
 {
-  auto iter = m_sampler_cache.find(info);
-  if (iter != m_sampler_cache.end())
-    return iter->second;
+  if (const VkSampler* cached = m_sampler_cache.Find(info))
+    return *cached;
 
   static constexpr std::array<VkFilter, 4> filters = {{VK_FILTER_NEAREST, VK_FILTER_LINEAR}};
   static constexpr std::array<VkSamplerMipmapMode, 2> mipmap_modes = {
@@ -355,7 +353,7 @@ VkSampler ObjectCache::GetSampler(const SamplerState& info)
     LOG_VULKAN_ERROR(res, "vkCreateSampler failed: ");
 
   // Store it even if it failed
-  m_sampler_cache.emplace(info, sampler);
+  m_sampler_cache.Insert(info, sampler);
   return sampler;
 }
 }
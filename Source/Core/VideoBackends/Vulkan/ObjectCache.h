@@ -6,7 +6,6 @@
 
 #include <array>
 #include <cstddef>
-#include <map>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -20,6 +19,7 @@
 #include "VideoCommon/GeometryShaderGen.h"
 #include "VideoCommon/PixelShaderGen.h"
 #include "VideoCommon/RenderState.h"
+#include "VideoCommon/RenderStateCache.h"
 #include "VideoCommon/VertexShaderGen.h"
 
 namespace Vulkan
@@ -92,7 +92,7 @@ private:
   VkSampler m_point_sampler = VK_NULL_HANDLE;
   VkSampler m_linear_sampler = VK_NULL_HANDLE;
 
-  std::map<SamplerState, VkSampler> m_sampler_cache;
+  RenderStateCache<SamplerState, VkSampler> m_sampler_cache;
 
   // Dummy image for samplers that are unbound
   std::unique_ptr<Texture2D> m_dummy_texture;
@@ -112,9 +112,12 @@ void PerfQuery::DisableQuery(PerfQueryGroup type)
 
 void PerfQuery::ResetQuery()
 {
+  // Pending queries kept past the reset are reset as they are read back.
+  if (!ResetResults())
+    return;
+
   m_query_count = 0;
   m_query_read_pos = 0;
-  std::fill_n(m_results, ArraySize(m_results), 0);
 
   // Reset entire query pool, ensuring all queries are ready to write to.
   StateTracker::GetInstance()->EndRenderPass();
@@ -135,19 +138,19 @@ u32 PerfQuery::GetQueryResult(PerfQueryType type)
 
   if (type == PQ_ZCOMP_INPUT_ZCOMPLOC || type == PQ_ZCOMP_OUTPUT_ZCOMPLOC)
   {
-    result = m_results[PQG_ZCOMP_ZCOMPLOC];
+    result = GetResult(PQG_ZCOMP_ZCOMPLOC);
   }
   else if (type == PQ_ZCOMP_INPUT || type == PQ_ZCOMP_OUTPUT)
   {
-    result = m_results[PQG_ZCOMP];
+    result = GetResult(PQG_ZCOMP);
   }
   else if (type == PQ_BLEND_INPUT)
   {
-    result = m_results[PQG_ZCOMP] + m_results[PQG_ZCOMP_ZCOMPLOC];
+    result = GetResult(PQG_ZCOMP) + GetResult(PQG_ZCOMP_ZCOMPLOC);
   }
   else if (type == PQ_EFB_COPY_CLOCKS)
   {
-    result = m_results[PQG_EFB_COPY_CLOCKS];
+    result = GetResult(PQG_EFB_COPY_CLOCKS);
   }
 
   return result / 4;
@@ -159,6 +162,11 @@ void PerfQuery::FlushResults()
     BlockingPartialFlush();
 }
 
+void PerfQuery::PollResults()
+{
+  NonBlockingPartialFlush();
+}
+
 bool PerfQuery::IsFlushed() const
 {
   return m_query_count == 0;
@@ -333,9 +341,9 @@ void PerfQuery::ProcessResults(u32 start_index, u32 query_count)
     DEBUG_LOG(VIDEO, "  query result %u", result);
 
     // NOTE: Reported pixel metrics should be referenced to native resolution
-    m_results[entry.query_type] +=
-        static_cast<u32>(static_cast<u64>(result) * EFB_WIDTH / g_renderer->GetTargetWidth() *
-                         EFB_HEIGHT / g_renderer->GetTargetHeight());
+    AddResult(static_cast<PerfQueryGroup>(entry.query_type),
+              static_cast<u32>(static_cast<u64>(result) * EFB_WIDTH / g_renderer->GetTargetWidth() *
+                               EFB_HEIGHT / g_renderer->GetTargetHeight()));
   }
 
   m_query_read_pos = (m_query_read_pos + query_count) % PERF_QUERY_BUFFER_SIZE;
@@ -31,6 +31,7 @@ public:
   u32 GetQueryResult(PerfQueryType type) override;
   void FlushResults() override;
   bool IsFlushed() const override;
+  void PollResults() override;
 
 private:
   struct ActiveQuery
@@ -6,6 +6,7 @@
 #include <sstream>
 
 #include "Common/Assert.h"
+#include "Common/Logging/Log.h"
 #include "Common/StringUtil.h"
 
 #include "VideoBackends/Vulkan/CommandBufferManager.h"
@@ -253,8 +254,19 @@ bool VulkanPostProcessing::RecompileShader()
 
   // Generate GLSL and compile the new shader.
   std::string main_code = m_config.LoadShader();
+  if (m_config.IsMultiPass())
+  {
+    // The passes need intermediate targets, which only the OpenGL backend has so far.
+    ERROR_LOG(VIDEO, "Multi-pass post-processing shader %s isn't supported by this backend",
+              m_config.GetShader().c_str());
+    return false;
+  }
+
   std::string options_code = GetGLSLUniformBlock();
   std::string code = options_code + POSTPROCESSING_SHADER_HEADER + main_code;
+  const std::string& entry_point = m_config.GetPasses().front().m_entry_point;
+  if (entry_point != "main")
+    code += StringFromFormat("\nvoid main()\n{\n  %s();\n}\n", entry_point.c_str());
   m_fragment_shader = Util::CompileAndCreateFragmentShader(code);
   if (m_fragment_shader == VK_NULL_HANDLE)
   {
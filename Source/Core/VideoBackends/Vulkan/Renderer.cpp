@@ -34,6 +34,7 @@
 #include "VideoCommon/BPFunctions.h"
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/DriverDetails.h"
+#include "VideoCommon/Fifo.h"
 #include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/PixelEngine.h"
 #include "VideoCommon/PixelShaderManager.h"
@@ -65,8 +66,8 @@ Renderer::~Renderer()
     EndFrameDumping();
 
   DestroyFrameDumpResources();
+  DestroyTimestampQueryPool();
   DestroyShaders();
-  DestroySemaphores();
 }
 
 Renderer* Renderer::GetInstance()
@@ -78,12 +79,6 @@ bool Renderer::Initialize()
 {
   BindEFBToStateTracker();
 
-  if (!CreateSemaphores())
-  {
-    PanicAlert("Failed to create semaphores.");
-    return false;
-  }
-
   if (!CompileShaders())
   {
     PanicAlert("Failed to compile shaders.");
@@ -130,44 +125,6 @@ bool Renderer::Initialize()
   return true;
 }
 
-bool Renderer::CreateSemaphores()
-{
-  // Create two semaphores, one that is triggered when the swapchain buffer is ready, another after
-  // submit and before present
-  VkSemaphoreCreateInfo semaphore_info = {
-      VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,  // VkStructureType          sType
-      nullptr,                                  // const void*              pNext
-      0                                         // VkSemaphoreCreateFlags   flags
-  };
-
-  VkResult res;
-  if ((res = vkCreateSemaphore(g_vulkan_context->GetDevice(), &semaphore_info, nullptr,
-                               &m_image_available_semaphore)) != VK_SUCCESS ||
-      (res = vkCreateSemaphore(g_vulkan_context->GetDevice(), &semaphore_info, nullptr,
-                               &m_rendering_finished_semaphore)) != VK_SUCCESS)
-  {
-    LOG_VULKAN_ERROR(res, "vkCreateSemaphore failed: ");
-    return false;
-  }
-
-  return true;
-}
-
-void Renderer::DestroySemaphores()
-{
-  if (m_image_available_semaphore)
-  {
-    vkDestroySemaphore(g_vulkan_context->GetDevice(), m_image_available_semaphore, nullptr);
-    m_image_available_semaphore = VK_NULL_HANDLE;
-  }
-
-  if (m_rendering_finished_semaphore)
-  {
-    vkDestroySemaphore(g_vulkan_context->GetDevice(), m_rendering_finished_semaphore, nullptr);
-    m_rendering_finished_semaphore = VK_NULL_HANDLE;
-  }
-}
-
 void Renderer::RenderText(const std::string& text, int left, int top, u32 color)
 {
   u32 backbuffer_width = m_swap_chain->GetWidth();
@@ -330,6 +287,98 @@ void Renderer::BeginFrame()
   StateTracker::GetInstance()->InvalidateDescriptorSets();
   StateTracker::GetInstance()->InvalidateConstants();
   StateTracker::GetInstance()->SetPendingRebind();
+
+  BeginGPUFrameTimer();
+}
+
+bool Renderer::CreateTimestampQueryPool()
+{
+  VkQueryPoolCreateInfo info = {
+      VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,  // VkStructureType                  sType
+      nullptr,                                   // const void*                      pNext
+      0,                                         // VkQueryPoolCreateFlags           flags
+      VK_QUERY_TYPE_TIMESTAMP,                   // VkQueryType                      queryType
+      TIMED_FRAMES * 2,                          // uint32_t                         queryCount
+      0  // VkQueryPipelineStatisticFlags    pipelineStatistics;
+  };
+
+  VkResult res =
+      vkCreateQueryPool(g_vulkan_context->GetDevice(), &info, nullptr, &m_timestamp_query_pool);
+  if (res != VK_SUCCESS)
+  {
+    LOG_VULKAN_ERROR(res, "vkCreateQueryPool failed: ");
+    m_timestamp_query_pool = VK_NULL_HANDLE;
+    return false;
+  }
+
+  return true;
+}
+
+void Renderer::DestroyTimestampQueryPool()
+{
+  if (m_timestamp_query_pool == VK_NULL_HANDLE)
+    return;
+
+  vkDestroyQueryPool(g_vulkan_context->GetDevice(), m_timestamp_query_pool, nullptr);
+  m_timestamp_query_pool = VK_NULL_HANDLE;
+}
+
+void Renderer::BeginGPUFrameTimer()
+{
+  m_timing_frame = false;
+  if (!IsMeasuringGPUFrameTime() ||
+      !g_vulkan_context->GetDeviceLimits().timestampComputeAndGraphics)
+  {
+    m_pending_timed_frames = 0;
+    m_first_timed_frame = m_next_timed_frame;
+    return;
+  }
+
+  // The pool is kept once created, as command buffers in flight may still reference it.
+  if (m_timestamp_query_pool == VK_NULL_HANDLE && !CreateTimestampQueryPool())
+    return;
+
+  // Collect every frame the GPU has finished. Each frame's queries are only read as a pair.
+  const double period_ms =
+      static_cast<double>(g_vulkan_context->GetDeviceLimits().timestampPeriod) / 1000000.0;
+  while (m_pending_timed_frames > 0)
+  {
+    std::array<u64, 2> timestamps;
+    VkResult res = vkGetQueryPoolResults(
+        g_vulkan_context->GetDevice(), m_timestamp_query_pool, m_first_timed_frame * 2, 2,
+        sizeof(timestamps), timestamps.data(), sizeof(u64), VK_QUERY_RESULT_64_BIT);
+    if (res != VK_SUCCESS)
+      break;
+
+    AddGPUFrameTime(static_cast<double>(timestamps[1] - timestamps[0]) * period_ms);
+    m_first_timed_frame = (m_first_timed_frame + 1) % TIMED_FRAMES;
+    m_pending_timed_frames--;
+  }
+
+  if (m_pending_timed_frames == TIMED_FRAMES)
+  {
+    m_first_timed_frame = (m_first_timed_frame + 1) % TIMED_FRAMES;
+    m_pending_timed_frames--;
+  }
+
+  VkCommandBuffer command_buffer = g_command_buffer_mgr->GetCurrentCommandBuffer();
+  vkCmdResetQueryPool(command_buffer, m_timestamp_query_pool, m_next_timed_frame * 2, 2);
+  vkCmdWriteTimestamp(command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, m_timestamp_query_pool,
+                      m_next_timed_frame * 2);
+  m_timing_frame = true;
+}
+
+void Renderer::EndGPUFrameTimer()
+{
+  if (!m_timing_frame)
+    return;
+
+  vkCmdWriteTimestamp(g_command_buffer_mgr->GetCurrentCommandBuffer(),
+                      VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, m_timestamp_query_pool,
+                      m_next_timed_frame * 2 + 1);
+  m_next_timed_frame = (m_next_timed_frame + 1) % TIMED_FRAMES;
+  m_pending_timed_frames++;
+  m_timing_frame = false;
 }
 
 void Renderer::ClearScreen(const EFBRectangle& rc, bool color_enable, bool alpha_enable,
@@ -492,7 +541,9 @@ void Renderer::ReinterpretPixelData(unsigned int convtype)
 
 void Renderer::AsyncTimewarpDraw()
 {
-  // TODO: D3D12 Asynchronous Timewarp
+  // TODO: Vulkan Asynchronous Timewarp. There is no HMD path in this backend yet; stereo is
+  // rendered in a single pass to a layered EFB (one layer per eye, selected by the geometry
+  // shader), so both eyes already share one recording of each draw.
 }
 
 void Renderer::SwapImpl(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height,
@@ -501,8 +552,10 @@ void Renderer::SwapImpl(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height
   // Pending/batched EFB pokes should be included in the final image.
   FramebufferManager::GetInstance()->FlushEFBPokes();
 
-  // Check that we actually have an image to render in XFB-on modes.
-  if ((!m_xfb_written && !g_ActiveConfig.RealXFBEnabled()) || !fb_width || !fb_height)
+  // Check that we actually have an image to render in XFB-on modes, and that the frame isn't
+  // skipped.
+  if (Fifo::WillSkipCurrentFrame() || (!m_xfb_written && !g_ActiveConfig.RealXFBEnabled()) ||
+      !fb_width || !fb_height)
   {
     Core::Callback_VideoCopiedToXFB(false);
     return;
@@ -520,6 +573,10 @@ void Renderer::SwapImpl(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height
   StateTracker::GetInstance()->EndRenderPass();
   StateTracker::GetInstance()->OnEndFrame();
 
+  // Read back the finished frame for the next frame's EFB peeks, before the command buffer is
+  // submitted below.
+  FramebufferManager::GetInstance()->ReadbackEFBAsync();
+
   // There are a few variables which can alter the final window draw rectangle, and some of them
   // are determined by guest state. Currently, the only way to catch these is to update every frame.
   UpdateDrawRectangle();
@@ -558,18 +615,20 @@ void Renderer::SwapImpl(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height
   if (m_swap_chain)
   {
     DrawScreen(scaled_efb_rect, xfb_addr, xfb_sources, xfb_count, fb_width, fb_stride, fb_height);
-
-    // Submit the current command buffer, signaling rendering finished semaphore when it's done
-    // Because this final command buffer is rendering to the swap chain, we need to wait for
-    // the available semaphore to be signaled before executing the buffer. This final submission
-    // can happen off-thread in the background while we're preparing the next frame.
-    g_command_buffer_mgr->SubmitCommandBuffer(
-        true, m_image_available_semaphore, m_rendering_finished_semaphore,
-        m_swap_chain->GetSwapChain(), m_swap_chain->GetCurrentImageIndex());
+    EndGPUFrameTimer();
+
+    // Submit the current command buffer, and present it to the swap chain. This final submission,
+    // and with deferred acquisition waiting for the swap chain image, can happen off-thread in the
+    // background while we're preparing the next frame.
+    // The present is queued along with it, so that is what the frame pacer times.
+    m_frame_pacer.WaitForPresent(ticks);
+    g_command_buffer_mgr->SubmitCommandBuffer(true, m_swap_chain.get());
+    m_frame_pacer.EndPresent();
   }
   else
   {
     // No swap chain, just execute command buffer.
+    EndGPUFrameTimer();
     g_command_buffer_mgr->SubmitCommandBuffer(true);
   }
 
@@ -655,7 +714,7 @@ void Renderer::DrawFrame(VkRenderPass render_pass, const TargetRectangle& target
 {
   if (!g_ActiveConfig.bUseXFB)
     DrawEFB(render_pass, target_rect, scaled_efb_rect);
-  else if (!g_ActiveConfig.bUseRealXFB)
+  else if (!FramebufferManager::IsRealXFBSource())
     DrawVirtualXFB(render_pass, target_rect, xfb_addr, xfb_sources, xfb_count, fb_width, fb_stride,
                    fb_height);
   else
@@ -727,17 +786,17 @@ void Renderer::DrawScreen(const TargetRectangle& scaled_efb_rect, u32 xfb_addr,
                           const XFBSourceBase* const* xfb_sources, u32 xfb_count, u32 fb_width,
                           u32 fb_stride, u32 fb_height)
 {
-  VkResult res;
-  if (!g_command_buffer_mgr->CheckLastPresentFail())
-  {
-    // Grab the next image from the swap chain in preparation for drawing the window.
-    res = m_swap_chain->AcquireNextImage(m_image_available_semaphore);
-  }
-  else
+  VkResult res = VK_SUCCESS;
+  if (g_command_buffer_mgr->CheckLastPresentFail())
   {
     // If the last present failed, we need to recreate the swap chain.
     res = VK_ERROR_OUT_OF_DATE_KHR;
   }
+  else if (!m_swap_chain->IsAcquireDeferred())
+  {
+    // Grab the next image from the swap chain in preparation for drawing the window.
+    res = m_swap_chain->AcquireNextImage(g_command_buffer_mgr->GetCurrentImageAvailableSemaphore());
+  }
 
   if (res == VK_SUBOPTIMAL_KHR || res == VK_ERROR_OUT_OF_DATE_KHR)
   {
@@ -751,16 +810,21 @@ void Renderer::DrawScreen(const TargetRectangle& scaled_efb_rect, u32 xfb_addr,
     m_swap_chain->ResizeSwapChain();
     BeginFrame();
     g_command_buffer_mgr->PrepareToSubmitCommandBuffer();
-    res = m_swap_chain->AcquireNextImage(m_image_available_semaphore);
+    res = m_swap_chain->IsAcquireDeferred() ?
+              VK_SUCCESS :
+              m_swap_chain->AcquireNextImage(
+                  g_command_buffer_mgr->GetCurrentImageAvailableSemaphore());
   }
   if (res != VK_SUCCESS)
     PanicAlert("Failed to grab image from swap chain");
 
   // Transition from undefined (or present src, but it can be substituted) to
   // color attachment ready for writing. These transitions must occur outside
-  // a render pass, unless the render pass declares a self-dependency.
+  // a render pass, unless the render pass declares a self-dependency. The offscreen image of
+  // deferred acquisition keeps its layout, so that the barrier waits for the last frame's copy.
   Texture2D* backbuffer = m_swap_chain->GetCurrentTexture();
-  backbuffer->OverrideImageLayout(VK_IMAGE_LAYOUT_UNDEFINED);
+  if (!m_swap_chain->IsAcquireDeferred())
+    backbuffer->OverrideImageLayout(VK_IMAGE_LAYOUT_UNDEFINED);
   backbuffer->TransitionToLayout(g_command_buffer_mgr->GetCurrentCommandBuffer(),
                                  VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
 
@@ -791,9 +855,11 @@ void Renderer::DrawScreen(const TargetRectangle& scaled_efb_rect, u32 xfb_addr,
   vkCmdEndRenderPass(g_command_buffer_mgr->GetCurrentCommandBuffer());
 
   // Transition the backbuffer to PRESENT_SRC to ensure all commands drawing
-  // to it have finished before present.
+  // to it have finished before present, or before it's copied to the swap chain image.
   backbuffer->TransitionToLayout(g_command_buffer_mgr->GetCurrentCommandBuffer(),
-                                 VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
+                                 m_swap_chain->IsAcquireDeferred() ?
+                                     VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL :
+                                     VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
 }
 
 bool Renderer::DrawFrameDump(const TargetRectangle& scaled_efb_rect, u32 xfb_addr,
@@ -907,13 +973,8 @@ void Renderer::WriteFrameDumpImage(size_t index)
 
 StagingTexture2D* Renderer::PrepareFrameDumpImage(u32 width, u32 height, u64 ticks)
 {
-  // Ensure the last frame that was sent to the frame dump has completed encoding before we send
-  // the next image to it.
-  FinishFrameData();
-
-  // If the last image hasn't been written to the frame dump yet, write it now.
-  // This is necessary so that the worker thread is no more than one frame behind, and the pointer
-  // (which is actually the buffer) is safe for us to re-use next time.
+  // If the last image hasn't been written to the frame dump yet, write it now. DumpFrameData
+  // copies it, so the readback texture is safe for us to re-use afterwards.
   if (m_frame_dump_images[m_current_frame_dump_image].pending)
     WriteFrameDumpImage(m_current_frame_dump_image);
 
@@ -1082,6 +1143,22 @@ void Renderer::CheckForTargetResize(u32 fb_width, u32 fb_stride, u32 fb_height)
 
 void Renderer::CheckForSurfaceChange()
 {
+  // A resize keeps the surface, so the swap chain is recreated from the old one without waiting
+  // for the GPU. Only the frames queued for the worker thread have to be submitted first, as it
+  // acquires and presents the images.
+  if (m_surface_resized.TestAndClear() && !m_surface_needs_change.IsSet())
+  {
+    if (m_swap_chain)
+    {
+      INFO_LOG(VIDEO, "Detected window resize.");
+      g_command_buffer_mgr->WaitForWorkerThreadIdle();
+      g_command_buffer_mgr->CheckLastPresentFail();
+      m_swap_chain->ResizeSwapChain();
+      OnSwapChainResized();
+    }
+    return;
+  }
+
   if (!m_surface_needs_change.IsSet())
     return;
 
@@ -1173,7 +1250,8 @@ void Renderer::CheckForConfigChanges()
   TextureCache::GetInstance()->OnConfigChanged(g_ActiveConfig);
 
   // Handle settings that can cause the target rectangle to change.
-  if (efb_scale_changed || aspect_changed || use_xfb_changed || use_realxfb_changed)
+  if (efb_scale_changed || aspect_changed || use_xfb_changed || use_realxfb_changed ||
+      HasDynamicResolutionChanged())
   {
     if (CalculateTargetSize())
       ResizeEFBTextures();
@@ -1318,8 +1396,9 @@ void Renderer::ResetSamplerStates()
     StateTracker::GetInstance()->SetSampler(i, g_object_cache->GetPointSampler());
   }
 
-  // Invalidate all sampler objects (some will be unused now).
+  // Invalidate all sampler objects (some will be unused now), and the descriptor sets using them.
   g_object_cache->ClearSamplerCache();
+  StateTracker::GetInstance()->InvalidateDescriptorSets();
 }
 
 void Renderer::SetInterlacingMode()
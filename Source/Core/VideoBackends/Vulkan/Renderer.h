@@ -69,11 +69,15 @@ public:
   void ChangeSurface(void* new_surface_handle) override;
 
 private:
-  bool CreateSemaphores();
-  void DestroySemaphores();
 
   void BeginFrame();
 
+  // GPU frame timing, with timestamps written at the start and end of each frame's commands.
+  bool CreateTimestampQueryPool();
+  void DestroyTimestampQueryPool();
+  void BeginGPUFrameTimer();
+  void EndGPUFrameTimer();
+
   void CheckForTargetResize(u32 fb_width, u32 fb_stride, u32 fb_height);
   void CheckForSurfaceChange();
   void CheckForConfigChanges();
@@ -145,8 +149,6 @@ private:
   bool ResizeFrameDumpBuffer(u32 new_width, u32 new_height);
   void DestroyFrameDumpResources();
 
-  VkSemaphore m_image_available_semaphore = VK_NULL_HANDLE;
-  VkSemaphore m_rendering_finished_semaphore = VK_NULL_HANDLE;
 
   std::unique_ptr<SwapChain> m_swap_chain;
   std::unique_ptr<BoundingBox> m_bounding_box;
@@ -174,5 +176,14 @@ private:
   std::array<FrameDumpImage, FRAME_DUMP_BUFFERED_FRAMES> m_frame_dump_images;
   size_t m_current_frame_dump_image = FRAME_DUMP_BUFFERED_FRAMES - 1;
   bool m_frame_dumping_active = false;
+
+  // Timestamp queries for GPU frame timing, two per frame. Results are read back once they're
+  // available, and the oldest frame is dropped if the GPU falls behind by TIMED_FRAMES.
+  static const u32 TIMED_FRAMES = 8;
+  VkQueryPool m_timestamp_query_pool = VK_NULL_HANDLE;
+  u32 m_first_timed_frame = 0;
+  u32 m_next_timed_frame = 0;
+  u32 m_pending_timed_frames = 0;
+  bool m_timing_frame = false;
 };
 }
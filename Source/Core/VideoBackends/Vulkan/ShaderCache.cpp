@@ -717,6 +717,10 @@ void ShaderCache::LoadShaderCaches()
   m_uber_ps_cache.disk_cache.OpenAndRead(
       GetDiskShaderCacheFileName(APIType::Vulkan, "UberPS", false, true), uber_ps_reader);
 
+  // Identical sources generate identical SPIR-V whatever the game or the host config.
+  ShaderCompiler::OpenSourceCache(
+      GetDiskShaderCacheFileName(APIType::Vulkan, "SPIRV", false, false));
+
   SETSTAT(stats.numPixelShadersCreated, static_cast<int>(m_ps_cache.shader_map.size()));
   SETSTAT(stats.numPixelShadersAlive, static_cast<int>(m_ps_cache.shader_map.size()));
   SETSTAT(stats.numVertexShadersCreated, static_cast<int>(m_vs_cache.shader_map.size()));
@@ -746,6 +750,7 @@ void ShaderCache::DestroyShaderCaches()
 
   DestroyShaderCache(m_uber_vs_cache);
   DestroyShaderCache(m_uber_ps_cache);
+  ShaderCompiler::CloseSourceCache();
 
   SETSTAT(stats.numPixelShadersCreated, 0);
   SETSTAT(stats.numPixelShadersAlive, 0);
@@ -1189,6 +1194,21 @@ void ShaderCache::CreateDummyPipeline(const UberShader::VertexShaderUid& vuid,
 
 void ShaderCache::PrecompileUberShaders()
 {
+  SetPrecompilingShaders(true);
+
+  // The dummy pipelines need the ubershaders, so compile those on the worker threads first.
+  auto QueueUberShader = [this](const auto& uid) {
+    if (GetUberShaderCache(uid).shader_map.count(uid))
+      return;
+
+    using Uid = std::decay_t<decltype(uid)>;
+    m_async_shader_compiler->QueueWorkItem(
+        m_async_shader_compiler->CreateWorkItem<UberShaderCompilerWorkItem<Uid>>(uid));
+  };
+  UberShader::EnumerateVertexShaderUids(QueueUberShader);
+  UberShader::EnumeratePixelShaderUids(QueueUberShader);
+  WaitForBackgroundCompilesToComplete();
+
   UberShader::EnumerateVertexShaderUids([&](const UberShader::VertexShaderUid& vuid) {
     UberShader::EnumeratePixelShaderUids([&](const UberShader::PixelShaderUid& puid) {
       // UIDs must have compatible texgens, a mismatching combination will never be queried.
@@ -1207,7 +1227,18 @@ void ShaderCache::PrecompileUberShaders()
   WaitForBackgroundCompilesToComplete();
 
   // Switch to the runtime/background thread config.
-  m_async_shader_compiler->ResizeWorkerThreads(g_ActiveConfig.GetShaderCompilerThreads());
+  SetPrecompilingShaders(false);
+}
+
+void ShaderCache::SetPrecompilingShaders(bool precompiling)
+{
+  // Never drop below the runtime thread count, otherwise queued background compiles would stall
+  // when the precompiler thread count is configured as zero.
+  u32 num_threads = g_ActiveConfig.GetShaderCompilerThreads();
+  if (precompiling)
+    num_threads = std::max(num_threads, g_ActiveConfig.GetShaderPrecompilerThreads());
+
+  m_async_shader_compiler->ResizeWorkerThreads(num_threads);
 }
 
 void ShaderCache::WaitForBackgroundCompilesToComplete()
@@ -1329,6 +1360,53 @@ void ShaderCache::PixelShaderCompilerWorkItem::Retrieve()
                                                static_cast<u32>(m_spirv.size()));
 }
 
+static bool CompileUberShader(const UberShader::VertexShaderUid& uid,
+                              ShaderCompiler::SPIRVCodeVector* spirv)
+{
+  ShaderCode code = UberShader::GenVertexShader(APIType::Vulkan, ShaderHostConfig::GetCurrent(),
+                                                uid.GetUidData());
+  return ShaderCompiler::CompileVertexShader(spirv, code.GetBuffer().c_str(),
+                                             code.GetBuffer().length());
+}
+
+static bool CompileUberShader(const UberShader::PixelShaderUid& uid,
+                              ShaderCompiler::SPIRVCodeVector* spirv)
+{
+  ShaderCode code =
+      UberShader::GenPixelShader(APIType::Vulkan, ShaderHostConfig::GetCurrent(), uid.GetUidData());
+  return ShaderCompiler::CompileFragmentShader(spirv, code.GetBuffer().c_str(),
+                                               code.GetBuffer().length());
+}
+
+template <typename Uid>
+bool ShaderCache::UberShaderCompilerWorkItem<Uid>::Compile()
+{
+  if (!CompileUberShader(m_uid, &m_spirv))
+    return true;
+
+  m_module = Util::CreateShaderModule(m_spirv.data(), m_spirv.size());
+  return true;
+}
+
+template <typename Uid>
+void ShaderCache::UberShaderCompilerWorkItem<Uid>::Retrieve()
+{
+  auto& cache = g_shader_cache->GetUberShaderCache(m_uid);
+
+  // The main thread may have also compiled this shader.
+  if (cache.shader_map.count(m_uid))
+  {
+    if (m_module != VK_NULL_HANDLE)
+      vkDestroyShaderModule(g_vulkan_context->GetDevice(), m_module, nullptr);
+    return;
+  }
+
+  // We still insert null entries to prevent further compilation attempts.
+  cache.shader_map.emplace(m_uid, std::make_pair(m_module, false));
+  if (m_module != VK_NULL_HANDLE)
+    cache.disk_cache.Append(m_uid, m_spirv.data(), static_cast<u32>(m_spirv.size()));
+}
+
 bool ShaderCache::PipelineCompilerWorkItem::Compile()
 {
   m_pipeline = g_shader_cache->CreatePipeline(m_info);
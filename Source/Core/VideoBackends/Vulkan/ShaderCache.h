@@ -148,6 +148,9 @@ public:
   VkShaderModule GetPassthroughGeometryShader() const { return m_passthrough_geometry_shader; }
   void PrecompileUberShaders();
   void WaitForBackgroundCompilesToComplete();
+
+  // Resizes the background compiler to the precompile (boot) or runtime thread count.
+  void SetPrecompilingShaders(bool precompiling);
   void RetrieveAsyncShaders();
 
 private:
@@ -177,6 +180,16 @@ private:
   ShaderModuleCache<PixelShaderUid> m_ps_cache;
   ShaderModuleCache<UberShader::VertexShaderUid> m_uber_vs_cache;
   ShaderModuleCache<UberShader::PixelShaderUid> m_uber_ps_cache;
+  ShaderModuleCache<UberShader::VertexShaderUid>& GetUberShaderCache(
+      const UberShader::VertexShaderUid&)
+  {
+    return m_uber_vs_cache;
+  }
+  ShaderModuleCache<UberShader::PixelShaderUid>& GetUberShaderCache(
+      const UberShader::PixelShaderUid&)
+  {
+    return m_uber_ps_cache;
+  }
 
   std::unordered_map<PipelineInfo, std::pair<VkPipeline, bool>, PipelineInfoHash>
       m_pipeline_objects;
@@ -218,6 +231,19 @@ private:
     ShaderCompiler::SPIRVCodeVector m_spirv;
     VkShaderModule m_module = VK_NULL_HANDLE;
   };
+  template <typename Uid>
+  class UberShaderCompilerWorkItem : public VideoCommon::AsyncShaderCompiler::WorkItem
+  {
+  public:
+    explicit UberShaderCompilerWorkItem(const Uid& uid) : m_uid(uid) {}
+    bool Compile() override;
+    void Retrieve() override;
+
+  private:
+    Uid m_uid;
+    ShaderCompiler::SPIRVCodeVector m_spirv;
+    VkShaderModule m_module = VK_NULL_HANDLE;
+  };
   class PipelineCompilerWorkItem : public VideoCommon::AsyncShaderCompiler::WorkItem
   {
   public:
@@ -9,8 +9,11 @@
 #include <cstdlib>
 #include <cstring>
 #include <fstream>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <tuple>
 
 // glslang includes
 #include "GlslangToSpv.h"
@@ -18,12 +21,18 @@
 #include "disassemble.h"
 
 #include "Common/FileUtil.h"
+#include "Common/LinearDiskCache.h"
 #include "Common/Logging/Log.h"
+#include "Common/Logging/Trace.h"
 #include "Common/MsgHandler.h"
 #include "Common/StringUtil.h"
 
+#include "VideoCommon/Statistics.h"
 #include "VideoCommon/VideoConfig.h"
 
+// xxhash.h defines restrict away, so it has to come after the glslang headers.
+#include <xxhash.h>
+
 namespace Vulkan
 {
 namespace ShaderCompiler
@@ -39,6 +48,10 @@ static bool CompileShaderToSPV(SPIRVCodeVector* out_code, EShLanguage stage,
                                const char* stage_filename, const char* source_code,
                                size_t source_code_length, const char* header, size_t header_length);
 
+// Looks up or stores the SPIR-V for a shader in the source cache.
+static bool GetCachedSPV(SPIRVCodeVector* out_code, EShLanguage stage, const std::string& source);
+static void CacheSPV(const SPIRVCodeVector& code, EShLanguage stage, const std::string& source);
+
 // Copy GLSL source code to a SPIRVCodeVector, for use with VK_NV_glsl_shader.
 static void CopyGLSLToSPVVector(SPIRVCodeVector* out_code, const char* stage_filename,
                                 const char* source_code, size_t source_code_length,
@@ -107,6 +120,8 @@ bool CompileShaderToSPV(SPIRVCodeVector* out_code, EShLanguage stage, const char
                         const char* source_code, size_t source_code_length, const char* header,
                         size_t header_length)
 {
+  TRACE_SCOPE("Vulkan::CompileShaderToSPV");
+  g_shader_compiles.Increment();
   if (!InitializeGlslang())
     return false;
 
@@ -119,17 +134,14 @@ bool CompileShaderToSPV(SPIRVCodeVector* out_code, EShLanguage stage, const char
   int default_version = 450;
 
   std::string full_source_code;
-  const char* pass_source_code = source_code;
-  int pass_source_code_length = static_cast<int>(source_code_length);
-  if (header_length > 0)
-  {
-    full_source_code.reserve(header_length + source_code_length);
-    full_source_code.append(header, header_length);
-    full_source_code.append(source_code, source_code_length);
-    pass_source_code = full_source_code.c_str();
-    pass_source_code_length = static_cast<int>(full_source_code.length());
-  }
+  full_source_code.reserve(header_length + source_code_length);
+  full_source_code.append(header, header_length);
+  full_source_code.append(source_code, source_code_length);
+  if (GetCachedSPV(out_code, stage, full_source_code))
+    return true;
 
+  const char* pass_source_code = full_source_code.c_str();
+  int pass_source_code_length = static_cast<int>(full_source_code.length());
   shader->setStringsWithLengths(&pass_source_code, &pass_source_code_length, 1);
 
   auto DumpBadShader = [&](const char* msg) {
@@ -223,9 +235,90 @@ bool CompileShaderToSPV(SPIRVCodeVector* out_code, EShLanguage stage, const char
     }
   }
 
+  CacheSPV(*out_code, stage, full_source_code);
   return true;
 }
 
+namespace
+{
+struct SourceCacheKey
+{
+  u64 hash;
+  u32 length;
+  u32 stage;
+
+  bool operator<(const SourceCacheKey& rhs) const
+  {
+    return std::tie(hash, length, stage) < std::tie(rhs.hash, rhs.length, rhs.stage);
+  }
+};
+}
+
+static std::mutex s_source_cache_lock;
+static bool s_source_cache_open = false;
+static std::map<SourceCacheKey, SPIRVCodeVector> s_source_cache;
+static LinearDiskCache<SourceCacheKey, SPIRVCodeType> s_source_disk_cache;
+
+static SourceCacheKey GetSourceCacheKey(EShLanguage stage, const std::string& source)
+{
+  return {XXH64(source.data(), source.size(), 0), static_cast<u32>(source.size()),
+          static_cast<u32>(stage)};
+}
+
+bool GetCachedSPV(SPIRVCodeVector* out_code, EShLanguage stage, const std::string& source)
+{
+  std::lock_guard<std::mutex> guard(s_source_cache_lock);
+  if (!s_source_cache_open)
+    return false;
+
+  auto iter = s_source_cache.find(GetSourceCacheKey(stage, source));
+  if (iter == s_source_cache.end())
+    return false;
+
+  *out_code = iter->second;
+  return true;
+}
+
+void CacheSPV(const SPIRVCodeVector& code, EShLanguage stage, const std::string& source)
+{
+  std::lock_guard<std::mutex> guard(s_source_cache_lock);
+  if (!s_source_cache_open)
+    return;
+
+  const SourceCacheKey key = GetSourceCacheKey(stage, source);
+  if (s_source_cache.emplace(key, code).second)
+    s_source_disk_cache.Append(key, code.data(), static_cast<u32>(code.size()));
+}
+
+void OpenSourceCache(const std::string& filename)
+{
+  class SourceCacheReader : public LinearDiskCacheReader<SourceCacheKey, SPIRVCodeType>
+  {
+  public:
+    void Read(const SourceCacheKey& key, const SPIRVCodeType* value, u32 value_size) override
+    {
+      s_source_cache.emplace(key, SPIRVCodeVector(value, value + value_size));
+    }
+  };
+
+  std::lock_guard<std::mutex> guard(s_source_cache_lock);
+  SourceCacheReader reader;
+  s_source_disk_cache.OpenAndRead(filename, reader);
+  s_source_cache_open = true;
+}
+
+void CloseSourceCache()
+{
+  std::lock_guard<std::mutex> guard(s_source_cache_lock);
+  if (!s_source_cache_open)
+    return;
+
+  s_source_disk_cache.Sync();
+  s_source_disk_cache.Close();
+  s_source_cache.clear();
+  s_source_cache_open = false;
+}
+
 void CopyGLSLToSPVVector(SPIRVCodeVector* out_code, const char* stage_filename,
                          const char* source_code, size_t source_code_length, const char* header,
                          size_t header_length)
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <cstddef>
+#include <string>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -33,5 +34,11 @@ bool CompileFragmentShader(SPIRVCodeVector* out_code, const char* source_code,
 bool CompileComputeShader(SPIRVCodeVector* out_code, const char* source_code,
                           size_t source_code_length);
 
+// Compiled SPIR-V is also cached by a hash of the GLSL source, so that identical shaders are not
+// compiled twice when they have different UIDs, or after a host config change has invalidated
+// the UID caches. The compile functions are thread-safe while the cache is open.
+void OpenSourceCache(const std::string& filename);
+void CloseSourceCache();
+
 }  // namespace ShaderCompiler
 }  // namespace Vulkan
@@ -99,10 +99,17 @@ void StagingTexture2D::WriteTexels(u32 x, u32 y, u32 width, u32 height, const vo
 void StagingTexture2D::CopyFromImage(VkCommandBuffer command_buffer, VkImage image,
                                      VkImageAspectFlags src_aspect, u32 x, u32 y, u32 width,
                                      u32 height, u32 level, u32 layer)
+{
+  CopyFromImage(command_buffer, image, src_aspect, x, y, width, height, level, layer, x, y);
+}
+
+void StagingTexture2D::CopyFromImage(VkCommandBuffer command_buffer, VkImage image,
+                                     VkImageAspectFlags src_aspect, u32 x, u32 y, u32 width,
+                                     u32 height, u32 level, u32 layer, u32 dst_x, u32 dst_y)
 {
   // Issue the image->buffer copy.
   VkBufferImageCopy image_copy = {
-      y * m_row_stride + x * m_texel_size,            // VkDeviceSize             bufferOffset
+      dst_y * m_row_stride + dst_x * m_texel_size,    // VkDeviceSize             bufferOffset
       m_width,                                        // uint32_t                 bufferRowLength
       0,                                              // uint32_t                 bufferImageHeight
       {src_aspect, level, layer, 1},                  // VkImageSubresourceLayers imageSubresource
@@ -113,7 +120,7 @@ void StagingTexture2D::CopyFromImage(VkCommandBuffer command_buffer, VkImage ima
                          &image_copy);
 
   // Flush CPU and GPU caches if not coherent mapping.
-  VkDeviceSize buffer_flush_offset = y * m_row_stride;
+  VkDeviceSize buffer_flush_offset = dst_y * m_row_stride;
   VkDeviceSize buffer_flush_size = height * m_row_stride;
   FlushGPUCache(command_buffer, VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
                 buffer_flush_offset, buffer_flush_size);
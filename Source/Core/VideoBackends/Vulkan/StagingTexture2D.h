@@ -38,6 +38,10 @@ public:
   // Results are not ready until command_buffer has been executed.
   void CopyFromImage(VkCommandBuffer command_buffer, VkImage image, VkImageAspectFlags src_aspect,
                      u32 x, u32 y, u32 width, u32 height, u32 level, u32 layer);
+  // Same as above, but stores the texels at dst_x, dst_y instead of x, y.
+  void CopyFromImage(VkCommandBuffer command_buffer, VkImage image, VkImageAspectFlags src_aspect,
+                     u32 x, u32 y, u32 width, u32 height, u32 level, u32 layer, u32 dst_x,
+                     u32 dst_y);
 
   // Assumes that image is in TRANSFER_DST layout.
   // Buffer is not safe for re-use until after command_buffer has been executed.
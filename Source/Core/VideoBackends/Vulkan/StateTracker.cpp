@@ -4,6 +4,7 @@
 
 #include "VideoBackends/Vulkan/StateTracker.h"
 
+#include <algorithm>
 #include <cstring>
 
 #include "Common/Align.h"
@@ -121,24 +122,52 @@ void StateTracker::ReloadPipelineUIDCache()
       this_ptr->PrecachePipelineUID(key);
     }
 
+  private:
+    StateTracker* this_ptr;
+  };
+  class UberPipelineInserter final : public LinearDiskCacheReader<SerializedUberPipelineUID, u32>
+  {
+  public:
+    explicit UberPipelineInserter(StateTracker* this_ptr_) : this_ptr(this_ptr_) {}
+    void Read(const SerializedUberPipelineUID& key, const u32* value, u32 value_size)
+    {
+      this_ptr->PrecacheUberPipelineUID(key);
+    }
+
   private:
     StateTracker* this_ptr;
   };
 
   m_uid_cache.Sync();
   m_uid_cache.Close();
+  m_uber_uid_cache.Sync();
+  m_uber_uid_cache.Close();
 
   // UID caches don't contain any host state, so use a single uid cache per gameid.
   std::string filename = GetDiskShaderCacheFileName(APIType::Vulkan, "PipelineUID", true, false);
+  std::string uber_filename =
+      GetDiskShaderCacheFileName(APIType::Vulkan, "UberPipelineUID", true, false);
   if (g_ActiveConfig.bShaderCache)
   {
+    // The UID cache is appended in first-use order, so the pipelines a game needs earliest are
+    // queued first. Nothing is drawn until this completes, so use every precompiler thread.
+    if (g_ActiveConfig.bBackgroundShaderCompiling)
+      g_shader_cache->SetPrecompilingShaders(true);
+
+    // The ubershader pipelines go first, as they are the ones needed to draw at all.
+    UberPipelineInserter uber_inserter(this);
+    m_uber_uid_cache.OpenAndRead(uber_filename, uber_inserter);
+
     PipelineInserter inserter(this);
     m_uid_cache.OpenAndRead(filename, inserter);
   }
 
   // If we were using background compilation, ensure everything is ready before continuing.
   if (g_ActiveConfig.bBackgroundShaderCompiling)
+  {
     g_shader_cache->WaitForBackgroundCompilesToComplete();
+    g_shader_cache->SetPrecompilingShaders(false);
+  }
 }
 
 void StateTracker::AppendToPipelineUIDCache(const PipelineInfo& info)
@@ -213,6 +242,64 @@ bool StateTracker::PrecachePipelineUID(const SerializedPipelineUID& uid)
   return true;
 }
 
+void StateTracker::AppendToUberPipelineUIDCache(const PipelineInfo& info,
+                                                const UberShader::VertexShaderUid& vs_uid,
+                                                const UberShader::PixelShaderUid& ps_uid)
+{
+  SerializedUberPipelineUID sinfo;
+  sinfo.blend_state_bits = info.blend_state.hex;
+  sinfo.rasterizer_state_bits = info.rasterization_state.hex;
+  sinfo.depth_state_bits = info.depth_state.hex;
+  sinfo.vertex_decl = info.vertex_format->GetVertexDeclaration();
+  sinfo.vs_uid = vs_uid;
+  sinfo.gs_uid = m_gs_uid;
+  sinfo.ps_uid = ps_uid;
+
+  u32 dummy_value = 0;
+  m_uber_uid_cache.Append(sinfo, &dummy_value, 1);
+}
+
+bool StateTracker::PrecacheUberPipelineUID(const SerializedUberPipelineUID& uid)
+{
+  PipelineInfo pinfo = {};
+
+  // The declaration was already converted to the ubershader vertex format when it was stored.
+  pinfo.vertex_format =
+      static_cast<VertexFormat*>(VertexLoaderManager::GetOrCreateMatchingFormat(uid.vertex_decl));
+  pinfo.pipeline_layout =
+      g_ActiveConfig.bBBoxEnable && g_ActiveConfig.BBoxUseFragmentShaderImplementation() ?
+          g_object_cache->GetPipelineLayout(PIPELINE_LAYOUT_BBOX) :
+          g_object_cache->GetPipelineLayout(PIPELINE_LAYOUT_STANDARD);
+  pinfo.vs = g_shader_cache->GetVertexUberShaderForUid(uid.vs_uid);
+  pinfo.ps = g_shader_cache->GetPixelUberShaderForUid(uid.ps_uid);
+  if (pinfo.vs == VK_NULL_HANDLE || pinfo.ps == VK_NULL_HANDLE)
+  {
+    WARN_LOG(VIDEO, "Failed to get ubershaders from cached UID.");
+    return false;
+  }
+  if (g_vulkan_context->SupportsGeometryShaders() && !uid.gs_uid.GetUidData()->IsPassthrough())
+  {
+    pinfo.gs = g_shader_cache->GetGeometryShaderForUid(uid.gs_uid);
+    if (pinfo.gs == VK_NULL_HANDLE)
+    {
+      WARN_LOG(VIDEO, "Failed to get geometry shader from cached UID.");
+      return false;
+    }
+  }
+  pinfo.render_pass = m_load_render_pass;
+  pinfo.rasterization_state.hex = uid.rasterizer_state_bits;
+  pinfo.depth_state.hex = uid.depth_state_bits;
+  pinfo.blend_state.hex = uid.blend_state_bits;
+  pinfo.multisampling_state.hex = m_pipeline_state.multisampling_state.hex;
+
+  if (g_ActiveConfig.bBackgroundShaderCompiling)
+    g_shader_cache->GetPipelineWithCacheResultAsync(pinfo);
+  else if (g_shader_cache->GetPipeline(pinfo) == VK_NULL_HANDLE)
+    WARN_LOG(VIDEO, "Failed to get pipeline from cached UID.");
+
+  return true;
+}
+
 void StateTracker::SetVertexBuffer(VkBuffer buffer, VkDeviceSize offset)
 {
   if (m_vertex_buffer == buffer && m_vertex_buffer_offset == offset)
@@ -308,6 +395,7 @@ bool StateTracker::CheckForShaderChanges()
   VertexShaderUid vs_uid = GetVertexShaderUid();
   PixelShaderUid ps_uid = GetPixelShaderUid();
   ClearUnusedPixelShaderUidBits(APIType::Vulkan, &ps_uid);
+  ClearUnusedVertexShaderUidBits(APIType::Vulkan, &vs_uid);
 
   bool changed = false;
   bool use_ubershaders = g_ActiveConfig.bDisableSpecializedShaders;
@@ -647,11 +735,26 @@ void StateTracker::UnbindTexture(VkImageView view)
     if (it.imageView == view)
       it.imageView = g_object_cache->GetDummyImageView();
   }
+
+  // The handle can be reused by a new view, which must not find the sets of this one.
+  for (auto it = m_sampler_descriptor_sets.begin(); it != m_sampler_descriptor_sets.end();)
+  {
+    if (std::any_of(it->first.begin(), it->first.end(),
+                    [view](const VkDescriptorImageInfo& info) { return info.imageView == view; }))
+    {
+      it = m_sampler_descriptor_sets.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
 }
 
 void StateTracker::InvalidateDescriptorSets()
 {
   m_descriptor_sets.fill(VK_NULL_HANDLE);
+  m_sampler_descriptor_sets.clear();
   m_dirty_flags |= DIRTY_FLAG_ALL_DESCRIPTOR_SETS;
 
   // Defer SSBO descriptor update until bbox is actually enabled.
@@ -959,14 +1062,22 @@ VkPipeline StateTracker::GetPipelineAndCacheUID()
     uber_info.ps = g_shader_cache->GetPixelUberShaderForUid(uber_puid);
 
     auto uber_result = g_shader_cache->GetPipelineWithCacheResult(uber_info);
+    if (!uber_result.second && g_ActiveConfig.bShaderCache)
+      AppendToUberPipelineUIDCache(uber_info, uber_vuid, uber_puid);
+
     return uber_result.first;
   }
   else
   {
     // Add to the UID cache if it is a new pipeline.
     auto result = g_shader_cache->GetPipelineWithCacheResult(m_pipeline_state);
-    if (!result.second && !m_using_ubershaders && g_ActiveConfig.bShaderCache)
-      AppendToPipelineUIDCache(m_pipeline_state);
+    if (!result.second && g_ActiveConfig.bShaderCache)
+    {
+      if (m_using_ubershaders)
+        AppendToUberPipelineUIDCache(m_pipeline_state, m_uber_vs_uid, m_uber_ps_uid);
+      else
+        AppendToPipelineUIDCache(m_pipeline_state);
+    }
 
     return result.first;
   }
@@ -1031,6 +1142,28 @@ void StateTracker::UpdatePipelineVertexFormat()
   m_dirty_flags |= DIRTY_FLAG_PIPELINE;
 }
 
+size_t StateTracker::SamplerBindingsHash::operator()(const SamplerBindings& bindings) const
+{
+  // The handles are pointers or unique 64-bit values, the layout is always the same.
+  u64 hash = 0;
+  for (const VkDescriptorImageInfo& info : bindings)
+  {
+    hash = (hash ^ reinterpret_cast<u64>(info.imageView)) * 0x9E3779B97F4A7C15ULL;
+    hash = (hash ^ reinterpret_cast<u64>(info.sampler)) * 0x9E3779B97F4A7C15ULL;
+  }
+  return static_cast<size_t>(hash ^ (hash >> 32));
+}
+
+bool StateTracker::SamplerBindingsEqual::operator()(const SamplerBindings& lhs,
+                                                    const SamplerBindings& rhs) const
+{
+  return std::equal(lhs.begin(), lhs.end(), rhs.begin(),
+                    [](const VkDescriptorImageInfo& a, const VkDescriptorImageInfo& b) {
+                      return a.imageView == b.imageView && a.sampler == b.sampler &&
+                             a.imageLayout == b.imageLayout;
+                    });
+}
+
 bool StateTracker::UpdateDescriptorSet()
 {
   const size_t MAX_DESCRIPTOR_WRITES = NUM_UBO_DESCRIPTOR_SET_BINDINGS +  // UBO
@@ -1069,22 +1202,32 @@ bool StateTracker::UpdateDescriptorSet()
   if (m_dirty_flags & DIRTY_FLAG_PS_SAMPLERS ||
       m_descriptor_sets[DESCRIPTOR_SET_BIND_POINT_PIXEL_SHADER_SAMPLERS] == VK_NULL_HANDLE)
   {
-    VkDescriptorSetLayout layout =
-        g_object_cache->GetDescriptorSetLayout(DESCRIPTOR_SET_LAYOUT_PIXEL_SHADER_SAMPLERS);
-    VkDescriptorSet set = g_command_buffer_mgr->AllocateDescriptorSet(layout);
-    if (set == VK_NULL_HANDLE)
-      return false;
+    VkDescriptorSet set;
+    auto cached = m_sampler_descriptor_sets.find(m_bindings.ps_samplers);
+    if (cached != m_sampler_descriptor_sets.end())
+    {
+      set = cached->second;
+    }
+    else
+    {
+      VkDescriptorSetLayout layout =
+          g_object_cache->GetDescriptorSetLayout(DESCRIPTOR_SET_LAYOUT_PIXEL_SHADER_SAMPLERS);
+      set = g_command_buffer_mgr->AllocateDescriptorSet(layout);
+      if (set == VK_NULL_HANDLE)
+        return false;
 
-    writes[num_writes++] = {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-                            nullptr,
-                            set,
-                            0,
-                            0,
-                            static_cast<u32>(NUM_PIXEL_SHADER_SAMPLERS),
-                            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-                            m_bindings.ps_samplers.data(),
-                            nullptr,
-                            nullptr};
+      writes[num_writes++] = {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                              nullptr,
+                              set,
+                              0,
+                              0,
+                              static_cast<u32>(NUM_PIXEL_SHADER_SAMPLERS),
+                              VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                              m_bindings.ps_samplers.data(),
+                              nullptr,
+                              nullptr};
+      m_sampler_descriptor_sets.emplace(m_bindings.ps_samplers, set);
+    }
 
     m_descriptor_sets[DESCRIPTOR_SET_BIND_POINT_PIXEL_SHADER_SAMPLERS] = set;
     m_dirty_flags |= DIRTY_FLAG_DESCRIPTOR_SET_BINDING;
@@ -7,6 +7,7 @@
 #include <array>
 #include <cstddef>
 #include <memory>
+#include <unordered_map>
 
 #include "Common/CommonTypes.h"
 #include "Common/LinearDiskCache.h"
@@ -75,7 +76,8 @@ public:
   void UnbindTexture(VkImageView view);
 
   // When executing a command buffer, we want to recreate the descriptor set, as it will
-  // now be in a different pool for the new command buffer.
+  // now be in a different pool for the new command buffer. This also forgets the sampler
+  // descriptor sets reused within the command buffer, so call it when samplers are destroyed.
   void InvalidateDescriptorSets();
 
   // Same with the uniforms, as the current storage will belong to the previous command buffer.
@@ -100,6 +102,10 @@ public:
 
   bool Bind(bool rebind_all = false);
 
+  // True if the last bound pipeline used ubershaders, either by config or while the
+  // specialized pipeline is still compiling in the background.
+  bool IsUsingUberShaders() const { return m_using_ubershaders; }
+
   // CPU Access Tracking
   // Call after a draw call is made.
   void OnDraw();
@@ -136,6 +142,21 @@ private:
     PixelShaderUid ps_uid;
   };
 
+  // The ubershader pipeline for a set of render states, which is what we draw with while the
+  // specialized pipeline is compiled in the background. These are cached separately so that
+  // they can be created before the first draw which needs them, as creating a pipeline for the
+  // ubershaders is not any faster than for the specialized shaders.
+  struct SerializedUberPipelineUID
+  {
+    u32 rasterizer_state_bits;
+    u32 depth_state_bits;
+    u32 blend_state_bits;
+    PortableVertexDeclaration vertex_decl;
+    UberShader::VertexShaderUid vs_uid;
+    GeometryShaderUid gs_uid;
+    UberShader::PixelShaderUid ps_uid;
+  };
+
   // Number of descriptor sets for game draws.
   enum
   {
@@ -172,6 +193,12 @@ private:
   // Precaches a pipeline based on the UID information.
   bool PrecachePipelineUID(const SerializedPipelineUID& uid);
 
+  // Same as above, for pipelines using the ubershaders with the specified UIDs.
+  void AppendToUberPipelineUIDCache(const PipelineInfo& info,
+                                    const UberShader::VertexShaderUid& vs_uid,
+                                    const UberShader::PixelShaderUid& ps_uid);
+  bool PrecacheUberPipelineUID(const SerializedUberPipelineUID& uid);
+
   // Check that the specified viewport is within the render area.
   // If not, ends the render pass if it is a clear render pass.
   bool IsViewportWithinRenderArea() const;
@@ -230,6 +257,21 @@ private:
 
     VkDescriptorBufferInfo ps_ssbo = {};
   } m_bindings;
+
+  // Sampler descriptor sets already written in the current command buffer, by their contents.
+  // Games switch between a few texture combinations per frame, which can then be bound again
+  // instead of allocating and writing a new set from the pool for every change.
+  using SamplerBindings = std::array<VkDescriptorImageInfo, NUM_PIXEL_SHADER_SAMPLERS>;
+  struct SamplerBindingsHash
+  {
+    size_t operator()(const SamplerBindings& bindings) const;
+  };
+  struct SamplerBindingsEqual
+  {
+    bool operator()(const SamplerBindings& lhs, const SamplerBindings& rhs) const;
+  };
+  std::unordered_map<SamplerBindings, VkDescriptorSet, SamplerBindingsHash, SamplerBindingsEqual>
+      m_sampler_descriptor_sets;
   u32 m_num_active_descriptor_sets = 0;
   size_t m_uniform_buffer_reserve_size = 0;
 
@@ -259,5 +301,6 @@ private:
   // on-demand. If all goes well, it should hit the shader and Vulkan pipeline cache, therefore
   // loading should be reasonably efficient.
   LinearDiskCache<SerializedPipelineUID, u32> m_uid_cache;
+  LinearDiskCache<SerializedUberPipelineUID, u32> m_uber_uid_cache;
 };
 }
@@ -312,13 +312,18 @@ bool SwapChain::CreateSwapChain()
   if (!(surface_capabilities.supportedTransforms & VK_SURFACE_TRANSFORM_IDENTITY_BIT_KHR))
     transform = surface_capabilities.currentTransform;
 
-  // Select swap chain flags, we only need a colour attachment
+  // Select swap chain flags, we need a colour attachment, and a copy destination to defer
+  // acquiring images
   VkImageUsageFlags image_usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
   if (!(surface_capabilities.supportedUsageFlags & VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT))
   {
     ERROR_LOG(VIDEO, "Vulkan: Swap chain does not support usage as color attachment");
     return false;
   }
+  m_supports_transfer_dst =
+      (surface_capabilities.supportedUsageFlags & VK_IMAGE_USAGE_TRANSFER_DST_BIT) != 0;
+  if (m_supports_transfer_dst)
+    image_usage |= VK_IMAGE_USAGE_TRANSFER_DST_BIT;
 
   // Select the number of image layers for Quad-Buffered stereoscopy
   uint32_t image_layers = g_ActiveConfig.iStereoMode == STEREO_QUADBUFFER ? 2 : 1;
@@ -365,10 +370,10 @@ bool SwapChain::CreateSwapChain()
     return false;
   }
 
-  // Now destroy the old swap chain, since it's been recreated.
-  // We can do this immediately since all work should have been completed before calling resize.
+  // The old swap chain is retired now, but frames in flight may still present its images, so it
+  // is destroyed once the GPU is done with them instead of waiting for the GPU here.
   if (old_swap_chain != VK_NULL_HANDLE)
-    vkDestroySwapchainKHR(g_vulkan_context->GetDevice(), old_swap_chain, nullptr);
+    g_command_buffer_mgr->DeferSwapChainDestruction(old_swap_chain);
 
   m_width = size.width;
   m_height = size.height;
@@ -427,19 +432,92 @@ bool SwapChain::SetupSwapChainImages()
     m_swap_chain_images.emplace_back(std::move(image));
   }
 
-  return true;
+  return !m_supports_transfer_dst || CreateOffscreenImage();
 }
 
 void SwapChain::DestroySwapChainImages()
 {
+  DestroyOffscreenImage();
   for (const auto& it : m_swap_chain_images)
   {
-    // Images themselves are cleaned up by the swap chain object
-    vkDestroyFramebuffer(g_vulkan_context->GetDevice(), it.framebuffer, nullptr);
+    // Images themselves are cleaned up by the swap chain object. The framebuffers may still be
+    // used by frames in flight when resizing.
+    g_command_buffer_mgr->DeferFramebufferDestruction(it.framebuffer);
   }
   m_swap_chain_images.clear();
 }
 
+bool SwapChain::CreateOffscreenImage()
+{
+  std::unique_ptr<Texture2D> texture = Texture2D::Create(
+      m_width, m_height, 1, m_layers, m_surface_format.format, VK_SAMPLE_COUNT_1_BIT,
+      m_layers > 1 ? VK_IMAGE_VIEW_TYPE_2D_ARRAY : VK_IMAGE_VIEW_TYPE_2D, VK_IMAGE_TILING_OPTIMAL,
+      VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT);
+  if (!texture)
+  {
+    // Drawing straight to the swap chain images still works.
+    WARN_LOG(VIDEO, "Vulkan: Failed to create offscreen image, acquiring on the GPU thread");
+    return true;
+  }
+
+  VkImageView view = texture->GetView();
+  VkFramebufferCreateInfo framebuffer_info = {
+      VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO, nullptr, 0, m_render_pass, 1, &view, m_width,
+      m_height, m_layers};
+  VkResult res = vkCreateFramebuffer(g_vulkan_context->GetDevice(), &framebuffer_info, nullptr,
+                                     &m_offscreen_framebuffer);
+  if (res != VK_SUCCESS)
+  {
+    LOG_VULKAN_ERROR(res, "vkCreateFramebuffer failed: ");
+    return false;
+  }
+
+  m_offscreen_texture = std::move(texture);
+  return true;
+}
+
+void SwapChain::DestroyOffscreenImage()
+{
+  // The last frame may still be copied from, so the destruction waits for the GPU.
+  if (m_offscreen_framebuffer != VK_NULL_HANDLE)
+  {
+    g_command_buffer_mgr->DeferFramebufferDestruction(m_offscreen_framebuffer);
+    m_offscreen_framebuffer = VK_NULL_HANDLE;
+  }
+  m_offscreen_texture.reset();
+}
+
+void SwapChain::RecordPresentCopy(VkCommandBuffer command_buffer)
+{
+  const VkImageSubresourceRange range = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, m_layers};
+  VkImageMemoryBarrier barrier = {VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+                                  nullptr,
+                                  0,
+                                  VK_ACCESS_TRANSFER_WRITE_BIT,
+                                  VK_IMAGE_LAYOUT_UNDEFINED,
+                                  VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                  VK_QUEUE_FAMILY_IGNORED,
+                                  VK_QUEUE_FAMILY_IGNORED,
+                                  GetCurrentImage(),
+                                  range};
+  vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                       VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+  const VkImageSubresourceLayers layers = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, m_layers};
+  const VkImageCopy region = {layers, {0, 0, 0}, layers, {0, 0, 0}, {m_width, m_height, 1}};
+  vkCmdCopyImage(command_buffer, m_offscreen_texture->GetImage(),
+                 VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, GetCurrentImage(),
+                 VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+
+  barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+  barrier.dstAccessMask = 0;
+  barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+  barrier.newLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+  vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                       VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, 0, nullptr, 1,
+                       &barrier);
+}
+
 void SwapChain::DestroySwapChain()
 {
   if (m_swap_chain == VK_NULL_HANDLE)
@@ -510,7 +588,7 @@ bool SwapChain::RecreateSurface(void* native_handle)
     return false;
 
   // Finally re-create the swap chain
-  if (!CreateSwapChain() || !SetupSwapChainImages() || !CreateRenderPass())
+  if (!CreateSwapChain() || !CreateRenderPass() || !SetupSwapChainImages())
     return false;
 
   return true;
@@ -42,17 +42,32 @@ public:
   {
     return m_swap_chain_images[m_current_swap_chain_image_index].image;
   }
+
+  // When the swap chain images can be copied to, the frame is drawn to an offscreen image
+  // instead, and images are acquired by CommandBufferManager's worker thread, right before it
+  // copies the frame. AcquireNextImage and the current image must then only be used there.
+  bool IsAcquireDeferred() const { return m_offscreen_texture != nullptr; }
+
+  // The image to draw the frame to
   Texture2D* GetCurrentTexture() const
   {
+    if (m_offscreen_texture)
+      return m_offscreen_texture.get();
     return m_swap_chain_images[m_current_swap_chain_image_index].texture.get();
   }
   VkFramebuffer GetCurrentFramebuffer() const
   {
+    if (m_offscreen_texture)
+      return m_offscreen_framebuffer;
     return m_swap_chain_images[m_current_swap_chain_image_index].framebuffer;
   }
 
   VkResult AcquireNextImage(VkSemaphore available_semaphore);
 
+  // Copies the offscreen image, in TRANSFER_SRC_OPTIMAL layout, to the current image, and leaves
+  // that ready to present.
+  void RecordPresentCopy(VkCommandBuffer command_buffer);
+
   bool RecreateSurface(void* native_handle);
   bool ResizeSwapChain();
   bool RecreateSwapChain();
@@ -73,6 +88,9 @@ private:
   bool SetupSwapChainImages();
   void DestroySwapChainImages();
 
+  bool CreateOffscreenImage();
+  void DestroyOffscreenImage();
+
   void DestroySurface();
 
   struct SwapChainImage
@@ -95,6 +113,10 @@ private:
   VkSwapchainKHR m_swap_chain = VK_NULL_HANDLE;
   std::vector<SwapChainImage> m_swap_chain_images;
   u32 m_current_swap_chain_image_index = 0;
+  bool m_supports_transfer_dst = false;
+
+  std::unique_ptr<Texture2D> m_offscreen_texture;
+  VkFramebuffer m_offscreen_framebuffer = VK_NULL_HANDLE;
 
   VkRenderPass m_render_pass = VK_NULL_HANDLE;
 
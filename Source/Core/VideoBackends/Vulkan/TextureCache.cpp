@@ -146,12 +146,17 @@ void TextureCache::CopyEFB(u8* dst, const EFBCopyParams& params, u32 native_widt
 
   m_texture_converter->EncodeTextureToMemory(src_texture->GetView(), dst, params, native_width,
                                              bytes_per_row, num_blocks_y, memory_stride, src_rect,
-                                             scale_by_half);
+                                             scale_by_half, IsDeferringEFBCopies());
 
   // Transition back to original state
   src_texture->TransitionToLayout(g_command_buffer_mgr->GetCurrentCommandBuffer(), original_layout);
 }
 
+void TextureCache::FlushPendingEFBCopies()
+{
+  m_texture_converter->FlushPendingEncodes();
+}
+
 bool TextureCache::SupportsGPUTextureDecode(TextureFormat format, TLUTFormat palette_format)
 {
   return m_texture_converter->SupportsTextureDecoding(format, palette_format);
@@ -57,6 +57,9 @@ private:
   void CopyEFBToCacheEntry(TCacheEntry* entry, bool is_depth_copy, const EFBRectangle& src_rect,
                            bool scale_by_half, unsigned int cbuf_id, const float* colmat) override;
 
+  bool SupportsDeferredEFBCopies() const override { return true; }
+  void FlushPendingEFBCopies() override;
+
   VkRenderPass m_render_pass = VK_NULL_HANDLE;
 
   std::unique_ptr<StreamBuffer> m_texture_upload_buffer;
@@ -221,7 +221,8 @@ void TextureConverter::ConvertTexture(TextureCacheBase::TCacheEntry* dst_entry,
 void TextureConverter::EncodeTextureToMemory(VkImageView src_texture, u8* dest_ptr,
                                              const EFBCopyParams& params, u32 native_width,
                                              u32 bytes_per_row, u32 num_blocks_y, u32 memory_stride,
-                                             const EFBRectangle& src_rect, bool scale_by_half)
+                                             const EFBRectangle& src_rect, bool scale_by_half,
+                                             bool deferred)
 {
   VkShaderModule shader = GetEncodingShader(params);
   if (shader == VK_NULL_HANDLE)
@@ -256,6 +257,11 @@ void TextureConverter::EncodeTextureToMemory(VkImageView src_texture, u8* dest_p
 
   u32 render_width = bytes_per_row / sizeof(u32);
   u32 render_height = num_blocks_y;
+
+  // Older copies have to be written first, and the download texture must have room for this one.
+  if (!deferred || m_pending_encode_rows + render_height > ENCODING_TEXTURE_HEIGHT)
+    FlushPendingEncodes();
+
   Util::SetViewportAndScissor(g_command_buffer_mgr->GetCurrentCommandBuffer(), 0, 0, render_width,
                               render_height);
 
@@ -267,6 +273,18 @@ void TextureConverter::EncodeTextureToMemory(VkImageView src_texture, u8* dest_p
   // Transition the image before copying
   m_encoding_render_texture->TransitionToLayout(g_command_buffer_mgr->GetCurrentCommandBuffer(),
                                                 VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+
+  if (deferred)
+  {
+    const u32 row = m_pending_encode_rows;
+    m_encoding_download_texture->CopyFromImage(
+        g_command_buffer_mgr->GetCurrentCommandBuffer(), m_encoding_render_texture->GetImage(),
+        VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, render_width, render_height, 0, 0, 0, row);
+    m_pending_encodes.push_back({dest_ptr, row, render_width, render_height, memory_stride});
+    m_pending_encode_rows += render_height;
+    return;
+  }
+
   m_encoding_download_texture->CopyFromImage(
       g_command_buffer_mgr->GetCurrentCommandBuffer(), m_encoding_render_texture->GetImage(),
       VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, render_width, render_height, 0, 0);
@@ -279,10 +297,33 @@ void TextureConverter::EncodeTextureToMemory(VkImageView src_texture, u8* dest_p
                                           memory_stride);
 }
 
+void TextureConverter::FlushPendingEncodes()
+{
+  if (m_pending_encodes.empty())
+    return;
+
+  // Block until the GPU has finished copying all of them to the staging texture.
+  Util::ExecuteCurrentCommandsAndRestoreState(false, true);
+
+  for (const PendingEncode& encode : m_pending_encodes)
+  {
+    const u32 stride = m_encoding_download_texture->GetRowStride();
+    m_encoding_download_texture->InvalidateCPUCache(encode.row * stride, encode.height * stride);
+    m_encoding_download_texture->ReadTexels(0, encode.row, encode.width, encode.height,
+                                            encode.dest_ptr, encode.memory_stride);
+  }
+
+  m_pending_encodes.clear();
+  m_pending_encode_rows = 0;
+}
+
 void TextureConverter::EncodeTextureToMemoryYUYV(void* dst_ptr, u32 dst_width, u32 dst_stride,
                                                  u32 dst_height, Texture2D* src_texture,
                                                  const MathUtil::Rectangle<int>& src_rect)
 {
+  // The download texture is shared with the deferred encodes.
+  FlushPendingEncodes();
+
   StateTracker::GetInstance()->EndRenderPass();
 
   // Borrow framebuffer from EFB2RAM encoder.
@@ -8,6 +8,7 @@
 #include <map>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "VideoBackends/Vulkan/StreamBuffer.h"
@@ -36,10 +37,15 @@ public:
                       const void* palette, TLUTFormat palette_format);
 
   // Uses an encoding shader to copy src_texture to dest_ptr.
-  // NOTE: Executes the current command buffer.
+  // NOTE: Executes the current command buffer, unless deferred is set. Deferred copies are only
+  // written to dest_ptr by FlushPendingEncodes().
   void EncodeTextureToMemory(VkImageView src_texture, u8* dest_ptr, const EFBCopyParams& params,
                              u32 native_width, u32 bytes_per_row, u32 num_blocks_y,
-                             u32 memory_stride, const EFBRectangle& src_rect, bool scale_by_half);
+                             u32 memory_stride, const EFBRectangle& src_rect, bool scale_by_half,
+                             bool deferred = false);
+
+  // Waits for all deferred encodes with a single submission, and writes them to memory.
+  void FlushPendingEncodes();
 
   // Encodes texture to guest memory in XFB (YUYV) format.
   void EncodeTextureToMemoryYUYV(void* dst_ptr, u32 dst_width, u32 dst_stride, u32 dst_height,
@@ -110,6 +116,18 @@ private:
   VkFramebuffer m_encoding_render_framebuffer = VK_NULL_HANDLE;
   std::unique_ptr<StagingTexture2D> m_encoding_download_texture;
 
+  // Deferred encodes are stored below each other in the download texture.
+  struct PendingEncode
+  {
+    u8* dest_ptr;
+    u32 row;
+    u32 width;
+    u32 height;
+    u32 memory_stride;
+  };
+  std::vector<PendingEncode> m_pending_encodes;
+  u32 m_pending_encode_rows = 0;
+
   // Texture decoding - GX format in memory->RGBA8
   struct TextureDecodingPipeline
   {
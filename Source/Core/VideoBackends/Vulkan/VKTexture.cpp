@@ -22,6 +22,7 @@
 #include "VideoBackends/Vulkan/VulkanContext.h"
 
 #include "VideoCommon/ImageWrite.h"
+#include "VideoCommon/Statistics.h"
 #include "VideoCommon/TextureConfig.h"
 
 namespace Vulkan
@@ -321,6 +322,7 @@ void VKTexture::Load(u32 level, u32 width, u32 height, u32 row_length, const u8*
     upload_buffer_offset = stream_buffer->GetCurrentOffset();
     std::memcpy(stream_buffer->GetCurrentHostPointer(), buffer, upload_size);
     stream_buffer->CommitMemory(upload_size);
+    ADDSTAT(stats.thisFrame.bytesTextureStreamed, static_cast<int>(upload_size));
   }
   else
   {
@@ -35,8 +35,8 @@ namespace Vulkan
 // TODO: Clean up this mess
 CONSTEXPR(size_t, INITIAL_VERTEX_BUFFER_SIZE, VertexManager::MAXVBUFFERSIZE * 2);
 CONSTEXPR(size_t, MAX_VERTEX_BUFFER_SIZE, VertexManager::MAXVBUFFERSIZE * 16);
-CONSTEXPR(size_t, INITIAL_INDEX_BUFFER_SIZE, VertexManager::MAXIBUFFERSIZE * sizeof(u16) * 2);
-CONSTEXPR(size_t, MAX_INDEX_BUFFER_SIZE, VertexManager::MAXIBUFFERSIZE * sizeof(u16) * 16);
+CONSTEXPR(size_t, INITIAL_INDEX_BUFFER_SIZE, VertexManager::MAXIBUFFERSIZE * sizeof(u32) * 2);
+CONSTEXPR(size_t, MAX_INDEX_BUFFER_SIZE, VertexManager::MAXIBUFFERSIZE * sizeof(u32) * 16);
 
 VertexManager::VertexManager()
     : m_cpu_vertex_buffer(MAXVBUFFERSIZE), m_cpu_index_buffer(MAXIBUFFERSIZE)
@@ -78,7 +78,7 @@ VertexManager::CreateNativeVertexFormat(const PortableVertexDeclaration& vtx_dec
 void VertexManager::PrepareDrawBuffers(u32 stride)
 {
   size_t vertex_data_size = IndexGenerator::GetNumVerts() * stride;
-  size_t index_data_size = IndexGenerator::GetIndexLen() * sizeof(u16);
+  size_t index_data_size = IndexGenerator::GetIndexLen() * IndexGenerator::GetIndexSize();
 
   m_vertex_stream_buffer->CommitMemory(vertex_data_size);
   m_index_stream_buffer->CommitMemory(index_data_size);
@@ -87,8 +87,9 @@ void VertexManager::PrepareDrawBuffers(u32 stride)
   ADDSTAT(stats.thisFrame.bytesIndexStreamed, static_cast<int>(index_data_size));
 
   StateTracker::GetInstance()->SetVertexBuffer(m_vertex_stream_buffer->GetBuffer(), 0);
-  StateTracker::GetInstance()->SetIndexBuffer(m_index_stream_buffer->GetBuffer(), 0,
-                                              VK_INDEX_TYPE_UINT16);
+  StateTracker::GetInstance()->SetIndexBuffer(
+      m_index_stream_buffer->GetBuffer(), 0,
+      IndexGenerator::GetIndexSize() == sizeof(u32) ? VK_INDEX_TYPE_UINT32 : VK_INDEX_TYPE_UINT16);
 }
 
 void VertexManager::ResetBuffer(u32 stride)
@@ -103,8 +104,10 @@ void VertexManager::ResetBuffer(u32 stride)
   }
 
   // Attempt to allocate from buffers
+  const u32 index_size = IndexGenerator::GetIndexSize();
   bool has_vbuffer_allocation = m_vertex_stream_buffer->ReserveMemory(MAXVBUFFERSIZE, stride);
-  bool has_ibuffer_allocation = m_index_stream_buffer->ReserveMemory(MAXIBUFFERSIZE, sizeof(u16));
+  bool has_ibuffer_allocation =
+      m_index_stream_buffer->ReserveMemory(MAXIBUFFERSIZE * index_size, index_size);
   if (!has_vbuffer_allocation || !has_ibuffer_allocation)
   {
     // Flush any pending commands first, so that we can wait on the fences
@@ -115,7 +118,10 @@ void VertexManager::ResetBuffer(u32 stride)
     if (!has_vbuffer_allocation)
       has_vbuffer_allocation = m_vertex_stream_buffer->ReserveMemory(MAXVBUFFERSIZE, stride);
     if (!has_ibuffer_allocation)
-      has_ibuffer_allocation = m_index_stream_buffer->ReserveMemory(MAXIBUFFERSIZE, sizeof(u16));
+    {
+      has_ibuffer_allocation =
+          m_index_stream_buffer->ReserveMemory(MAXIBUFFERSIZE * index_size, index_size);
+    }
 
     // If we still failed, that means the allocation was too large and will never succeed, so panic
     if (!has_vbuffer_allocation || !has_ibuffer_allocation)
@@ -126,13 +132,13 @@ void VertexManager::ResetBuffer(u32 stride)
   m_base_buffer_pointer = m_vertex_stream_buffer->GetHostPointer();
   m_end_buffer_pointer = m_vertex_stream_buffer->GetCurrentHostPointer() + MAXVBUFFERSIZE;
   m_cur_buffer_pointer = m_vertex_stream_buffer->GetCurrentHostPointer();
-  IndexGenerator::Start(reinterpret_cast<u16*>(m_index_stream_buffer->GetCurrentHostPointer()));
+  IndexGenerator::Start(m_index_stream_buffer->GetCurrentHostPointer());
 
   // Update base indices
   m_current_draw_base_vertex =
       static_cast<u32>(m_vertex_stream_buffer->GetCurrentOffset() / stride);
   m_current_draw_base_index =
-      static_cast<u32>(m_index_stream_buffer->GetCurrentOffset() / sizeof(u16));
+      static_cast<u32>(m_index_stream_buffer->GetCurrentOffset() / index_size);
 }
 
 void VertexManager::vFlush()
@@ -187,6 +193,8 @@ void VertexManager::vFlush()
   vkCmdDrawIndexed(g_command_buffer_mgr->GetCurrentCommandBuffer(), index_count, 1,
                    m_current_draw_base_index, m_current_draw_base_vertex, 0);
 
+  if (StateTracker::GetInstance()->IsUsingUberShaders())
+    INCSTAT(stats.thisFrame.numUberShaderDraws);
   StateTracker::GetInstance()->OnDraw();
 }
 
@@ -27,6 +27,9 @@ public:
   std::unique_ptr<NativeVertexFormat>
   CreateNativeVertexFormat(const PortableVertexDeclaration& vtx_decl) override;
 
+  // gl_VertexIndex includes the vertex offset of the draw.
+  u32 GetVertexIDBase() const override { return m_current_draw_base_vertex; }
+
 protected:
   void PrepareDrawBuffers(u32 stride);
   void ResetBuffer(u32 stride) override;
@@ -35,7 +38,7 @@ private:
   void vFlush() override;
 
   std::vector<u8> m_cpu_vertex_buffer;
-  std::vector<u16> m_cpu_index_buffer;
+  std::vector<u32> m_cpu_index_buffer;
 
   std::unique_ptr<StreamBuffer> m_vertex_stream_buffer;
   std::unique_ptr<StreamBuffer> m_index_stream_buffer;
@@ -238,6 +238,8 @@ void VulkanContext::PopulateBackendInfo(VideoConfig* config)
   config->backend_info.bSupportsDynamicSamplerIndexing = true;        // Assumed support.
   config->backend_info.bSupportsInternalResolutionFrameDumps = true;  // Assumed support.
   config->backend_info.bSupportsPostProcessing = true;                // Assumed support.
+  config->backend_info.bSupportsMergedDraws = true;                   // Assumed support.
+  config->backend_info.bSupports32BitIndices = true;                  // Assumed support.
   config->backend_info.bSupportsDualSourceBlend = false;              // Dependent on features.
   config->backend_info.bSupportsGeometryShaders = false;              // Dependent on features.
   config->backend_info.bSupportsGSInstancing = false;                 // Dependent on features.
@@ -247,6 +249,8 @@ void VulkanContext::PopulateBackendInfo(VideoConfig* config)
   config->backend_info.bSupportsDepthClamp = false;                   // Dependent on features.
   config->backend_info.bSupportsST3CTextures = false;                 // Dependent on features.
   config->backend_info.bSupportsBPTCTextures = false;                 // Dependent on features.
+  config->backend_info.bSupportsVSLayerOutput = false;                // No shader compiler support.
+  config->backend_info.bSupportsMultiDrawIndirect = false;            // Not implemented.
   config->backend_info.bSupportsReversedDepthRange = false;  // No support yet due to driver bugs.
 }
 
@@ -2,6 +2,7 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <vector>
 
 #include "Common/Logging/LogManager.h"
@@ -200,7 +201,8 @@ bool VideoBackend::Initialize(void* window_handle)
   }
 
   // Create command buffers. We do this separately because the other classes depend on it.
-  g_command_buffer_mgr = std::make_unique<CommandBufferManager>(g_Config.bBackendMultithreading);
+  g_command_buffer_mgr = std::make_unique<CommandBufferManager>(
+      g_Config.bBackendMultithreading, static_cast<size_t>(std::max(g_Config.iFramesInFlight, 0)));
   if (!g_command_buffer_mgr->Initialize())
   {
     PanicAlert("Failed to create Vulkan command buffers");
@@ -52,6 +52,24 @@ static int s_file_index = 0;
 static int s_savestate_index = 0;
 static int s_last_savestate_index = 0;
 
+// Encoders don't all take planar YUV 4:2:0, so fall back to the first format the encoder accepts
+// and swscale can write. Hardware frame formats are skipped, as the frames are in system memory.
+static AVPixelFormat GetEncoderPixelFormat(const AVCodec* codec)
+{
+  if (!codec->pix_fmts)
+    return AV_PIX_FMT_YUV420P;
+
+  AVPixelFormat fallback = AV_PIX_FMT_NONE;
+  for (const AVPixelFormat* format = codec->pix_fmts; *format != AV_PIX_FMT_NONE; ++format)
+  {
+    if (*format == AV_PIX_FMT_YUV420P)
+      return *format;
+    if (fallback == AV_PIX_FMT_NONE && sws_isSupportedOutput(*format))
+      fallback = *format;
+  }
+  return fallback != AV_PIX_FMT_NONE ? fallback : AV_PIX_FMT_YUV420P;
+}
+
 static void InitAVCodec()
 {
   static bool first_run = true;
@@ -147,19 +165,22 @@ bool AVIDump::CreateVideoFile()
   const std::string& codec_name = g_Config.bUseFFV1 ? "ffv1" : g_Config.sDumpCodec;
 
   AVCodecID codec_id = output_format->video_codec;
+  const AVCodec* codec = nullptr;
 
   if (!codec_name.empty())
   {
+    // Either the name of an encoder, such as h264_nvenc, h264_qsv or h264_amf to encode on the
+    // GPU, or the name of a codec, for which the default encoder is used.
+    codec = avcodec_find_encoder_by_name(codec_name.c_str());
     const AVCodecDescriptor* codec_desc = avcodec_descriptor_get_by_name(codec_name.c_str());
     if (codec_desc)
       codec_id = codec_desc->id;
-    else
+    else if (!codec)
       WARN_LOG(VIDEO, "Invalid codec %s", codec_name.c_str());
   }
 
-  const AVCodec* codec = nullptr;
-
-  codec = avcodec_find_encoder(codec_id);
+  if (!codec)
+    codec = avcodec_find_encoder(codec_id);
   s_codec_context = avcodec_alloc_context3(codec);
   if (!codec || !s_codec_context)
   {
@@ -178,7 +199,7 @@ bool AVIDump::CreateVideoFile()
   s_codec_context->time_base.num = 1;
   s_codec_context->time_base.den = VideoInterface::GetTargetRefreshRate();
   s_codec_context->gop_size = 12;
-  s_codec_context->pix_fmt = g_Config.bUseFFV1 ? AV_PIX_FMT_BGRA : AV_PIX_FMT_YUV420P;
+  s_codec_context->pix_fmt = g_Config.bUseFFV1 ? AV_PIX_FMT_BGRA : GetEncoderPixelFormat(codec);
 
   if (output_format->flags & AVFMT_GLOBALHEADER)
     s_codec_context->flags |= CODEC_FLAG_GLOBAL_HEADER;
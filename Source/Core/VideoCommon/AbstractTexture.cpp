@@ -39,6 +39,20 @@ size_t AbstractTexture::CalculateHostTextureLevelPitch(AbstractTextureFormat for
   }
 }
 
+size_t AbstractTexture::CalculateHostTextureSize(const TextureConfig& config)
+{
+  const bool compressed = IsCompressedHostTextureFormat(config.format);
+  size_t size = 0;
+  for (u32 level = 0; level < config.levels; level++)
+  {
+    const u32 width = std::max(1u, config.width >> level);
+    const u32 height = std::max(1u, config.height >> level);
+    const u32 rows = compressed ? std::max(1u, (height + 3) / 4) : height;
+    size += CalculateHostTextureLevelPitch(config.format, width) * rows;
+  }
+  return size * config.layers;
+}
+
 const TextureConfig& AbstractTexture::GetConfig() const
 {
   return m_config;
@@ -27,6 +27,8 @@ public:
 
   static bool IsCompressedHostTextureFormat(AbstractTextureFormat format);
   static size_t CalculateHostTextureLevelPitch(AbstractTextureFormat format, u32 row_length);
+  // Size of all levels and layers of a texture, ignoring any padding the driver adds.
+  static size_t CalculateHostTextureSize(const TextureConfig& config);
 
   const TextureConfig& GetConfig() const;
 
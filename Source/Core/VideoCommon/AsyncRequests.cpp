@@ -4,8 +4,10 @@
 
 #include <mutex>
 
+#include "Common/Logging/Trace.h"
 #include "VideoCommon/AsyncRequests.h"
 #include "VideoCommon/Fifo.h"
+#include "VideoCommon/FrameSkip.h"
 #include "VideoCommon/RenderBase.h"
 #include "VideoCommon/VideoBackendBase.h"
 #include "VideoCommon/VideoCommon.h"
@@ -16,12 +18,16 @@ AsyncRequests::AsyncRequests() : m_enable(false), m_passthrough(true)
 {
 }
 
-void AsyncRequests::PullEventsInternal()
+const u8* AsyncRequests::PullEventsInternal(const u8* fifo_position)
 {
   std::unique_lock<std::mutex> lock(m_mutex);
   m_empty.Set();
 
-  while (!m_queue.empty())
+  const auto is_due = [fifo_position](const Event& event) {
+    return !event.fifo_fence || event.fifo_fence <= fifo_position;
+  };
+
+  while (!m_queue.empty() && is_due(m_queue.front()))
   {
     Event e = m_queue.front();
 
@@ -45,7 +51,8 @@ void AsyncRequests::PullEventsInternal()
         m_merged_efb_pokes.push_back(d);
 
         m_queue.pop();
-      } while (!m_queue.empty() && m_queue.front().type == first_event.type);
+      } while (!m_queue.empty() && m_queue.front().type == first_event.type &&
+               is_due(m_queue.front()));
 
       lock.unlock();
       g_renderer->PokeEFB(t, m_merged_efb_pokes.data(), m_merged_efb_pokes.size());
@@ -60,11 +67,18 @@ void AsyncRequests::PullEventsInternal()
     m_queue.pop();
   }
 
+  if (!m_queue.empty())
+  {
+    m_empty.Clear();
+    return m_queue.front().fifo_fence;
+  }
+
   if (m_wake_me_up_again)
   {
     m_wake_me_up_again = false;
     m_cond.notify_all();
   }
+  return nullptr;
 }
 
 void AsyncRequests::PushEvent(const AsyncRequests::Event& event, bool blocking)
@@ -84,10 +98,12 @@ void AsyncRequests::PushEvent(const AsyncRequests::Event& event, bool blocking)
     return;
 
   m_queue.push(event);
+  m_queue.back().fifo_fence = Fifo::GetPreprocessedFifoEnd();
 
   Fifo::RunGpu();
   if (blocking)
   {
+    TRACE_SCOPE("AsyncRequests::WaitForGpu");
     m_cond.wait(lock, [this] { return m_queue.empty(); });
   }
 }
@@ -127,11 +143,13 @@ void AsyncRequests::HandleEvent(const AsyncRequests::Event& e)
   break;
 
   case Event::EFB_PEEK_COLOR:
+    FrameSkip::OnDrawResultRead();
     *e.efb_peek.data =
         g_renderer->AccessEFB(EFBAccessType::PeekColor, e.efb_peek.x, e.efb_peek.y, 0);
     break;
 
   case Event::EFB_PEEK_Z:
+    FrameSkip::OnDrawResultRead();
     *e.efb_peek.data = g_renderer->AccessEFB(EFBAccessType::PeekZ, e.efb_peek.x, e.efb_peek.y, 0);
     break;
 
@@ -141,12 +159,19 @@ void AsyncRequests::HandleEvent(const AsyncRequests::Event& e)
     break;
 
   case Event::BBOX_READ:
+    FrameSkip::OnDrawResultRead();
     *e.bbox.data = g_renderer->BBoxRead(e.bbox.index);
     break;
 
   case Event::PERF_QUERY:
+    FrameSkip::OnDrawResultRead();
     g_perf_query->FlushResults();
     break;
+
+  case Event::PERF_QUERY_POLL:
+    FrameSkip::OnDrawResultRead();
+    g_perf_query->PollResults();
+    break;
   }
 }
 
@@ -28,8 +28,13 @@ public:
       SWAP_EVENT,
       BBOX_READ,
       PERF_QUERY,
+      PERF_QUERY_POLL,
     } type;
     u64 time;
+    // In deterministic GPU thread mode, the end of the FIFO data the CPU thread had preprocessed
+    // when the event was pushed. The GPU thread handles the event once it has decoded that far.
+    // Set by PushEvent.
+    const u8* fifo_fence;
 
     union
     {
@@ -69,10 +74,13 @@ public:
 
   AsyncRequests();
 
-  void PullEvents()
+  // Handles the events whose fence is at or before fifo_position, or all of them outside of
+  // deterministic GPU thread mode. Returns the fence of the first event left, or nullptr.
+  const u8* PullEvents(const u8* fifo_position = nullptr)
   {
     if (!m_empty.IsSet())
-      PullEventsInternal();
+      return PullEventsInternal(fifo_position);
+    return nullptr;
   }
   void PushEvent(const Event& event, bool blocking = false);
   void SetEnable(bool enable);
@@ -80,7 +88,7 @@ public:
 
   static AsyncRequests* GetInstance() { return &s_singleton; }
 private:
-  void PullEventsInternal();
+  const u8* PullEventsInternal(const u8* fifo_position);
   void HandleEvent(const Event& e);
 
   static AsyncRequests s_singleton;
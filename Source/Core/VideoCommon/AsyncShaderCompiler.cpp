@@ -6,6 +6,7 @@
 #include <thread>
 #include "Common/Assert.h"
 #include "Common/Logging/Log.h"
+#include "Common/Logging/Trace.h"
 
 namespace VideoCommon
 {
@@ -206,6 +207,7 @@ void AsyncShaderCompiler::WorkerThreadEntryPoint(void* param)
 
 void AsyncShaderCompiler::WorkerThreadRun()
 {
+  Trace::SetThreadName("Shader compiler worker");
   std::unique_lock<std::mutex> pending_lock(m_pending_work_lock);
   while (!m_exit_flag.IsSet())
   {
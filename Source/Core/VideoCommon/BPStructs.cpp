@@ -8,6 +8,7 @@
 #include <cstring>
 #include <string>
 
+#include "Common/Align.h"
 #include "Common/Logging/Log.h"
 #include "Common/StringUtil.h"
 #include "Common/Thread.h"
@@ -19,6 +20,7 @@
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/BoundingBox.h"
 #include "VideoCommon/Fifo.h"
+#include "VideoCommon/FrameSkip.h"
 #include "VideoCommon/GeometryShaderManager.h"
 #include "VideoCommon/PerfQueryBase.h"
 #include "VideoCommon/PixelEngine.h"
@@ -26,6 +28,7 @@
 #include "VideoCommon/RenderBase.h"
 #include "VideoCommon/TextureCacheBase.h"
 #include "VideoCommon/TextureDecoder.h"
+#include "VideoCommon/TextureHashPrefetcher.h"
 #include "VideoCommon/VR.h"
 #include "VideoCommon/VertexShaderManager.h"
 #include "VideoCommon/VideoBackendBase.h"
@@ -44,6 +47,52 @@ void BPInit()
   bpmem.bpMask = 0xFFFFFF;
 }
 
+// Properties of the registers, looked up by register number on every write.
+// always_execute: Writes have an effect even when they don't change the value.
+// store_only: The value only configures later commands (EFB copies, TMEM loads) or isn't
+//             emulated, so the primitives queued so far don't need to be flushed.
+struct BPRegisterTable
+{
+  constexpr BPRegisterTable() : always_execute(), store_only()
+  {
+    always_execute[BPMEM_TRIGGER_EFB_COPY] = true;
+    always_execute[BPMEM_CLEARBBOX1] = true;
+    always_execute[BPMEM_CLEARBBOX2] = true;
+    always_execute[BPMEM_SETDRAWDONE] = true;
+    always_execute[BPMEM_PE_TOKEN_ID] = true;
+    always_execute[BPMEM_PE_TOKEN_INT_ID] = true;
+    always_execute[BPMEM_LOADTLUT0] = true;
+    always_execute[BPMEM_LOADTLUT1] = true;
+    always_execute[BPMEM_TEXINVALIDATE] = true;
+    always_execute[BPMEM_PRELOAD_MODE] = true;
+    always_execute[BPMEM_CLEAR_PIXEL_PERF] = true;
+
+    store_only[BPMEM_FIELDMASK] = true;
+    store_only[BPMEM_FIELDMODE] = true;
+    store_only[BPMEM_EFB_TL] = true;
+    store_only[BPMEM_EFB_BR] = true;
+    store_only[BPMEM_EFB_ADDR] = true;
+    store_only[BPMEM_MIPMAP_STRIDE] = true;
+    store_only[BPMEM_COPYYSCALE] = true;
+    store_only[BPMEM_CLEAR_AR] = true;
+    store_only[BPMEM_CLEAR_GB] = true;
+    store_only[BPMEM_CLEAR_Z] = true;
+    store_only[BPMEM_COPYFILTER0] = true;
+    store_only[BPMEM_COPYFILTER1] = true;
+    store_only[BPMEM_BP_MASK] = true;
+    store_only[BPMEM_IND_IMASK] = true;
+    store_only[BPMEM_REVBITS] = true;
+    store_only[BPMEM_PRELOAD_ADDR] = true;
+    store_only[BPMEM_PRELOAD_TMEMEVEN] = true;
+    store_only[BPMEM_PRELOAD_TMEMODD] = true;
+    store_only[BPMEM_LOADTLUT0] = true;
+  }
+
+  bool always_execute[256];
+  bool store_only[256];
+};
+static constexpr BPRegisterTable s_bp_register_table;
+
 static void BPWritten(const BPCmd& bp)
 {
   /*
@@ -70,17 +119,16 @@ static void BPWritten(const BPCmd& bp)
   // check for invalid state, else unneeded configuration are built
   g_video_backend->CheckInvalidState();
 
-  if (((s32*)&bpmem)[bp.address] == bp.newvalue)
+  if (((s32*)&bpmem)[bp.address] == bp.newvalue &&
+      !s_bp_register_table.always_execute[bp.address])
   {
-    if (!(bp.address == BPMEM_TRIGGER_EFB_COPY || bp.address == BPMEM_CLEARBBOX1 ||
-          bp.address == BPMEM_CLEARBBOX2 || bp.address == BPMEM_SETDRAWDONE ||
-          bp.address == BPMEM_PE_TOKEN_ID || bp.address == BPMEM_PE_TOKEN_INT_ID ||
-          bp.address == BPMEM_LOADTLUT0 || bp.address == BPMEM_LOADTLUT1 ||
-          bp.address == BPMEM_TEXINVALIDATE || bp.address == BPMEM_PRELOAD_MODE ||
-          bp.address == BPMEM_CLEAR_PIXEL_PERF))
-    {
-      return;
-    }
+    return;
+  }
+
+  if (s_bp_register_table.store_only[bp.address])
+  {
+    ((u32*)&bpmem)[bp.address] = bp.newvalue;
+    return;
   }
 
   FlushPipeline();
@@ -178,6 +226,7 @@ static void BPWritten(const BPCmd& bp)
     switch (bp.newvalue & 0xFF)
     {
     case 0x02:
+      g_texture_cache->FlushEFBCopies();
       if (!Fifo::UseDeterministicGPUThread())
         PixelEngine::SetFinish();  // may generate interrupt
       DEBUG_LOG(VIDEO, "GXSetDrawDone SetPEFinish (value: 0x%02X)", (bp.newvalue & 0xFFFF));
@@ -189,11 +238,13 @@ static void BPWritten(const BPCmd& bp)
     }
     return;
   case BPMEM_PE_TOKEN_ID:  // Pixel Engine Token ID
+    g_texture_cache->FlushEFBCopies();
     if (!Fifo::UseDeterministicGPUThread())
       PixelEngine::SetToken(static_cast<u16>(bp.newvalue & 0xFFFF), false);
     DEBUG_LOG(VIDEO, "SetPEToken 0x%04x", (bp.newvalue & 0xFFFF));
     return;
   case BPMEM_PE_TOKEN_INT_ID:  // Pixel Engine Interrupt Token ID
+    g_texture_cache->FlushEFBCopies();
     if (!Fifo::UseDeterministicGPUThread())
       PixelEngine::SetToken(static_cast<u16>(bp.newvalue & 0xFFFF), true);
     DEBUG_LOG(VIDEO, "SetPEToken + INT 0x%04x", (bp.newvalue & 0xFFFF));
@@ -264,6 +315,7 @@ static void BPWritten(const BPCmd& bp)
       // (Zbuffer uses 24-bit Format)
       if (g_ActiveConfig.bEFBCopyEnable)
       {
+        FrameSkip::OnEFBCopyToTexture();
         bool is_depth_copy = bpmem.zcontrol.pixel_format == PEControl::Z24;
         g_texture_cache->CopyRenderTargetToTexture(destAddr, PE_copy.tp_realFormat(), destStride,
                                                    is_depth_copy, gameSrcRect, ourSrcRect, !!PE_copy.intensity_fmt,
@@ -299,6 +351,8 @@ static void BPWritten(const BPCmd& bp)
                        "fbStride: %u | fbHeight: %u",
                 destAddr, gameSrcRect.left, gameSrcRect.top, gameSrcRect.right, gameSrcRect.bottom,
                 bpmem.copyTexSrcWH.x + 1, destStride, height);
+      // The XFB copy may be written to RAM, so it must not be overwritten by older EFB copies.
+      g_texture_cache->FlushEFBCopies();
       g_renderer->RenderToXFB(destAddr, gameSrcRect, destStride, height, s_gammaLUT[PE_copy.gamma]);
       g_new_frame_just_rendered = true;
       g_first_pass = g_first_pass_vs_constants = true;
@@ -333,6 +387,7 @@ static void BPWritten(const BPCmd& bp)
     if (!SConfig::GetInstance().bWii)
       addr = addr & 0x01FFFFFF;
 
+    g_texture_cache->FlushEFBCopies(addr, tlutXferCount);
     Memory::CopyFromEmu(texMem + tlutTMemAddr, addr, tlutXferCount);
 
     if (g_bRecordFifoData)
@@ -528,6 +583,9 @@ static void BPWritten(const BPCmd& bp)
       u32 bytes_read = 0;
       u32 tmem_addr_even = tmem_cfg.preload_tmem_even * TMEM_LINE_SIZE;
 
+      g_texture_cache->FlushEFBCopies(src_addr, tmem_cfg.preload_tile_info.count *
+                                                    TMEM_LINE_SIZE * 2);
+
       if (tmem_cfg.preload_tile_info.type != 3)
       {
         bytes_read = tmem_cfg.preload_tile_info.count * TMEM_LINE_SIZE;
@@ -725,6 +783,26 @@ void LoadBPReg(u32 value0)
   BPWritten(bp);
 }
 
+// The preprocessor runs ahead of the GPU thread, so it keeps its own copy of the texture registers
+// it needs to find the textures that are about to be used.
+static TexImage0 s_preprocess_tex_image0[8];
+static TexImage1 s_preprocess_tex_image1[8];
+
+static void PrefetchTextureHash(u32 stage, u32 image_base)
+{
+  if (s_preprocess_tex_image1[stage].image_type != 0)
+    return;
+
+  const TexImage0& image0 = s_preprocess_tex_image0[stage];
+  const TextureFormat format = static_cast<TextureFormat>(image0.format);
+  const u32 width = Common::AlignUp(static_cast<u32>(image0.width + 1),
+                                    TexDecoder_GetBlockWidthInTexels(format));
+  const u32 height = Common::AlignUp(static_cast<u32>(image0.height + 1),
+                                     TexDecoder_GetBlockHeightInTexels(format));
+  TextureHashPrefetcher::Prefetch(image_base << 5,
+                                  TexDecoder_GetTextureSizeInBytes(width, height, format));
+}
+
 void LoadBPRegPreprocess(u32 value0)
 {
   int regNum = value0 >> 24;
@@ -732,6 +810,36 @@ void LoadBPRegPreprocess(u32 value0)
   u32 newval = value0 & 0xffffff;
   switch (regNum)
   {
+  case BPMEM_TX_SETIMAGE0:
+  case BPMEM_TX_SETIMAGE0 + 1:
+  case BPMEM_TX_SETIMAGE0 + 2:
+  case BPMEM_TX_SETIMAGE0 + 3:
+  case BPMEM_TX_SETIMAGE0_4:
+  case BPMEM_TX_SETIMAGE0_4 + 1:
+  case BPMEM_TX_SETIMAGE0_4 + 2:
+  case BPMEM_TX_SETIMAGE0_4 + 3:
+    s_preprocess_tex_image0[(regNum & 3) | ((regNum & 0x20) >> 3)].hex = newval;
+    break;
+  case BPMEM_TX_SETIMAGE1:
+  case BPMEM_TX_SETIMAGE1 + 1:
+  case BPMEM_TX_SETIMAGE1 + 2:
+  case BPMEM_TX_SETIMAGE1 + 3:
+  case BPMEM_TX_SETIMAGE1_4:
+  case BPMEM_TX_SETIMAGE1_4 + 1:
+  case BPMEM_TX_SETIMAGE1_4 + 2:
+  case BPMEM_TX_SETIMAGE1_4 + 3:
+    s_preprocess_tex_image1[(regNum & 3) | ((regNum & 0x20) >> 3)].hex = newval;
+    break;
+  case BPMEM_TX_SETIMAGE3:
+  case BPMEM_TX_SETIMAGE3 + 1:
+  case BPMEM_TX_SETIMAGE3 + 2:
+  case BPMEM_TX_SETIMAGE3 + 3:
+  case BPMEM_TX_SETIMAGE3_4:
+  case BPMEM_TX_SETIMAGE3_4 + 1:
+  case BPMEM_TX_SETIMAGE3_4 + 2:
+  case BPMEM_TX_SETIMAGE3_4 + 3:
+    PrefetchTextureHash((regNum & 3) | ((regNum & 0x20) >> 3), newval);
+    break;
   case BPMEM_SETDRAWDONE:
     if ((newval & 0xff) == 0x02)
       PixelEngine::SetFinish();
@@ -13,6 +13,9 @@ using float4 = std::array<float, 4>;
 using uint4 = std::array<u32, 4>;
 using int4 = std::array<s32, 4>;
 
+// Number of position matrix changes which can be merged into a single draw.
+constexpr u32 MAX_POSMTX_BATCH = 16;
+
 struct PixelShaderConstants
 {
   std::array<int4, 4> colors;
@@ -73,6 +76,12 @@ struct VertexShaderConstants
 
   // .x - texMtxInfo, .y - postMtxInfo, [0..1].z = color, [0..1].w = alpha
   std::array<uint4, 8> xfmem_pack1;
+
+  // Position matrix index changes merged into this draw, see VertexManagerBase.
+  // .x - first vertex using the matrix, .y - PosNormalMtxIdx
+  std::array<int4, MAX_POSMTX_BATCH> posmtxbatch;
+  // .x - number of entries used, .y - vertex ID of the first vertex in the buffer
+  int4 posmtxbatchinfo;
 };
 
 struct GeometryShaderConstants
@@ -0,0 +1,162 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoCommon/DisplayListCache.h"
+
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+#include "Common/Hash.h"
+#include "Core/HW/Memmap.h"
+#include "VideoCommon/Fifo.h"
+#include "VideoCommon/VertexLoaderBase.h"
+#include "VideoCommon/VertexLoaderManager.h"
+#include "VideoCommon/VideoConfig.h"
+
+namespace DisplayListCache
+{
+namespace
+{
+// Number of frames a display list which isn't called survives.
+constexpr u32 MAX_AGE = 60;
+// Upper bound of the decoded vertices kept for all display lists.
+constexpr size_t MAX_CACHED_BYTES = 64 * 1024 * 1024;
+
+struct Draw
+{
+  const VertexLoaderBase* loader;
+  int count;
+  std::vector<u8> vertices;
+  // The zfreeze position cache the vertex loader left behind.
+  float position_cache[3][4];
+  u32 position_matrix_index[4];
+};
+
+struct DisplayList
+{
+  u64 write_token = 0;
+  u64 hash = 0;
+  u32 last_frame = 0;
+  // Keyed by the offset of the draw's vertex data in the list.
+  std::unordered_map<u32, Draw> draws;
+};
+
+std::unordered_map<u64, DisplayList> s_lists;
+size_t s_cached_bytes = 0;
+u32 s_frame = 0;
+
+DisplayList* s_current_list = nullptr;
+const u8* s_current_data = nullptr;
+
+u64 MakeKey(u32 address, u32 size)
+{
+  return (static_cast<u64>(address) << 32) | size;
+}
+
+void ClearDraws(DisplayList* list)
+{
+  for (const auto& draw : list->draws)
+    s_cached_bytes -= draw.second.vertices.size();
+  list->draws.clear();
+}
+}
+
+void BeginDisplayList(u32 address, u32 size, const u8* data)
+{
+  s_current_list = nullptr;
+
+  // With the deterministic GPU thread, lists are copied out of RAM when they are preprocessed,
+  // so the write tracking doesn't tell whether the copy changed.
+  if (!g_ActiveConfig.bDisplayListCache || Fifo::UseDeterministicGPUThread())
+    return;
+
+  DisplayList& list = s_lists[MakeKey(address, size)];
+  if (list.write_token == 0 || Memory::IsModifiedSince(address, size, list.write_token))
+  {
+    // Protect the range before hashing it, so writes during the hash are noticed next time.
+    list.write_token = Memory::ProtectRange(address, size);
+    const u64 hash = GetHash64(data, size, 0);
+    if (hash != list.hash)
+    {
+      ClearDraws(&list);
+      list.hash = hash;
+    }
+  }
+
+  list.last_frame = s_frame;
+  s_current_list = &list;
+  s_current_data = data;
+}
+
+void EndDisplayList()
+{
+  s_current_list = nullptr;
+  s_current_data = nullptr;
+}
+
+int LoadDraw(const u8* src, const VertexLoaderBase* loader, u8* dst)
+{
+  if (!s_current_list)
+    return -1;
+
+  const auto iter = s_current_list->draws.find(static_cast<u32>(src - s_current_data));
+  if (iter == s_current_list->draws.end() || iter->second.loader != loader)
+    return -1;
+
+  const Draw& draw = iter->second;
+  std::memcpy(dst, draw.vertices.data(), draw.vertices.size());
+  std::memcpy(VertexLoaderManager::position_cache, draw.position_cache,
+              sizeof(draw.position_cache));
+  std::memcpy(VertexLoaderManager::position_matrix_index, draw.position_matrix_index,
+              sizeof(draw.position_matrix_index));
+  return draw.count;
+}
+
+void StoreDraw(const u8* src, const VertexLoaderBase* loader, const u8* dst, int count)
+{
+  // Draws of less than three vertices only partially overwrite the position cache, so what the
+  // cache holds afterwards also depends on the draws before them.
+  if (!s_current_list || count < 3 || loader->HasIndexedAttributes())
+    return;
+
+  const size_t size = static_cast<size_t>(count) * loader->m_native_vtx_decl.stride;
+  if (s_cached_bytes + size > MAX_CACHED_BYTES)
+    return;
+
+  Draw& draw = s_current_list->draws[static_cast<u32>(src - s_current_data)];
+  s_cached_bytes += size - draw.vertices.size();
+  draw.loader = loader;
+  draw.count = count;
+  draw.vertices.assign(dst, dst + size);
+  std::memcpy(draw.position_cache, VertexLoaderManager::position_cache,
+              sizeof(draw.position_cache));
+  std::memcpy(draw.position_matrix_index, VertexLoaderManager::position_matrix_index,
+              sizeof(draw.position_matrix_index));
+}
+
+void Cleanup()
+{
+  s_frame++;
+  for (auto iter = s_lists.begin(); iter != s_lists.end();)
+  {
+    if (s_frame - iter->second.last_frame > MAX_AGE)
+    {
+      ClearDraws(&iter->second);
+      iter = s_lists.erase(iter);
+    }
+    else
+    {
+      ++iter;
+    }
+  }
+}
+
+void Clear()
+{
+  EndDisplayList();
+  s_lists.clear();
+  s_cached_bytes = 0;
+}
+}
@@ -0,0 +1,32 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include "Common/CommonTypes.h"
+
+class VertexLoaderBase;
+
+// Keeps the decoded vertices of the draws in display lists, so that calling the same list again
+// copies them instead of running the vertex loader. A list is identified by its address and size,
+// and its draws are reused while its memory is unmodified, checked with the memory write tracking
+// when it is enabled and with a hash of the list otherwise. Only draws without indexed attributes
+// are kept, as those would also depend on the contents of the vertex arrays.
+namespace DisplayListCache
+{
+// Called by the opcode decoder around the interpretation of a display list, on the GPU thread.
+void BeginDisplayList(u32 address, u32 size, const u8* data);
+void EndDisplayList();
+
+// Copies the cached vertices of the draw starting at src in the current display list to dst,
+// and returns the number of vertices, or -1 if the draw isn't cached for this loader.
+int LoadDraw(const u8* src, const VertexLoaderBase* loader, u8* dst);
+// Keeps the count vertices the loader has just decoded from src to dst.
+void StoreDraw(const u8* src, const VertexLoaderBase* loader, const u8* dst, int count);
+
+// Drops the lists that haven't been called for a while. Called once per frame.
+void Cleanup();
+// Drops everything, e.g. when the vertex loaders are destroyed.
+void Clear();
+}
@@ -0,0 +1,87 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoCommon/DynamicResolution.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Common/MathUtil.h"
+
+// Frames averaged for each decision
+static constexpr u32 WINDOW_FRAMES = 8;
+
+// Windows ignored after a change. Frame times arrive a few frames late, and the first frames
+// after a resize pay for recreating the framebuffers.
+static constexpr u32 SETTLE_WINDOWS = 2;
+
+// Fraction of the frame budget the GPU should use, leaving room for the compositor and the
+// variance between frames.
+static constexpr double TARGET_LOAD = 0.9;
+
+// The scale only grows while the GPU is below this fraction of the budget, so that it doesn't
+// bounce between two steps.
+static constexpr double GROW_LOAD = 0.75;
+
+std::atomic<float> DynamicResolution::s_scale_limit{1.0f};
+
+bool DynamicResolution::AddFrameTime(double milliseconds, double budget, float min_scale,
+                                     float max_scale)
+{
+  m_total_time += milliseconds;
+  if (++m_frame_count < WINDOW_FRAMES)
+    return false;
+
+  const double average = m_total_time / m_frame_count;
+  m_total_time = 0.0;
+  m_frame_count = 0;
+  if (m_ignored_windows > 0)
+  {
+    m_ignored_windows--;
+    return false;
+  }
+
+  const int min_steps = std::max(static_cast<int>(std::lround(min_scale * SCALE_STEPS)), 1);
+  max_scale = std::min(max_scale, GetScaleLimit());
+  const int max_steps = std::max(static_cast<int>(std::lround(max_scale * SCALE_STEPS)), min_steps);
+
+  int steps = m_steps;
+  if (average > budget * TARGET_LOAD)
+  {
+    // The GPU time follows the pixel count, which goes with the square of the scale.
+    const double ideal = m_steps * std::sqrt(budget * TARGET_LOAD / average);
+    steps = std::min(static_cast<int>(ideal), m_steps - 1);
+  }
+  else if (average < budget * GROW_LOAD * m_steps * m_steps / ((m_steps + 1) * (m_steps + 1)))
+  {
+    // Only grow when the next step would still be under the growing threshold.
+    steps = m_steps + 1;
+  }
+
+  steps = MathUtil::Clamp(steps, min_steps, max_steps);
+  if (steps == m_steps)
+    return false;
+
+  m_steps = steps;
+  m_ignored_windows = SETTLE_WINDOWS;
+  return true;
+}
+
+void DynamicResolution::Reset()
+{
+  m_total_time = 0.0;
+  m_frame_count = 0;
+  m_ignored_windows = 0;
+  m_steps = SCALE_STEPS;
+}
+
+void DynamicResolution::SetScaleLimit(float limit)
+{
+  s_scale_limit.store(limit, std::memory_order_relaxed);
+}
+
+float DynamicResolution::GetScaleLimit()
+{
+  return s_scale_limit.load(std::memory_order_relaxed);
+}
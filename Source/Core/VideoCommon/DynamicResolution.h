@@ -0,0 +1,47 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+// Scales the internal resolution with the GPU time of frames, so that a GPU which can't keep up
+// renders at a lower resolution rather than dropping frames.
+//
+// The frame times are averaged over a few frames, and compared to the time available for a
+// frame. Frames over budget shrink the scale by as much as needed at once, since the GPU time
+// follows the pixel count, while frames well under budget grow it one step at a time. After a
+// change, the frames measured before the new size took effect are ignored.
+
+#pragma once
+
+#include <atomic>
+
+#include "Common/CommonTypes.h"
+
+class DynamicResolution
+{
+public:
+  // The scale is a multiple of 1 / SCALE_STEPS, which keeps the EFB from being resized for every
+  // small change in the frame time.
+  static constexpr int SCALE_STEPS = 16;
+
+  // Adds the GPU time of a frame, and the time available for it, in milliseconds.
+  // Returns true when the scale has changed.
+  bool AddFrameTime(double milliseconds, double budget, float min_scale, float max_scale);
+
+  int GetScaleSteps() const { return m_steps; }
+  float GetScale() const { return static_cast<float>(m_steps) / SCALE_STEPS; }
+  void Reset();
+
+  // An upper bound on the scale from outside of the video backend, e.g. by frontends which lower
+  // it when the device is about to throttle. It applies on top of the configured maximum, but
+  // doesn't go under the configured minimum. Can be called from any thread.
+  static void SetScaleLimit(float limit);
+  static float GetScaleLimit();
+
+private:
+  static std::atomic<float> s_scale_limit;
+
+  double m_total_time = 0.0;
+  u32 m_frame_count = 0;
+  u32 m_ignored_windows = 0;
+  int m_steps = SCALE_STEPS;
+};
@@ -7,12 +7,17 @@
 
 #include "Common/CommonTypes.h"
 #include "Common/FileUtil.h"
+#include "Common/Metrics.h"
 #include "Common/Timer.h"
 #include "VideoCommon/FPSCounter.h"
 #include "VideoCommon/VideoConfig.h"
 
 static constexpr u64 FPS_REFRESH_INTERVAL = 250000;
 
+static Metrics::Histogram s_frame_time("dolphin_video_frame_time_seconds",
+                                       "Host time between presented frames.",
+                                       {0.008, 0.017, 0.025, 0.034, 0.05, 0.1, 0.25});
+
 FPSCounter::FPSCounter()
 {
   m_last_time = Common::Timer::GetTimeUs();
@@ -32,6 +37,7 @@ void FPSCounter::Update()
   u64 diff = time - m_last_time;
   if (g_ActiveConfig.bLogRenderTimeToFile)
     LogRenderTimeToFile(diff);
+  s_frame_time.Observe(diff / 1000000.0);
 
   m_frame_counter++;
   m_time_since_update += diff;
@@ -13,6 +13,7 @@
 #include "Common/ChunkFile.h"
 #include "Common/Event.h"
 #include "Common/FPURoundMode.h"
+#include "Common/Logging/Trace.h"
 #include "Common/MemoryUtil.h"
 #include "Common/MsgHandler.h"
 
@@ -28,6 +29,7 @@
 #include "VideoCommon/CommandProcessor.h"
 #include "VideoCommon/DataReader.h"
 #include "VideoCommon/OpcodeDecoding.h"
+#include "VideoCommon/TextureCacheBase.h"
 #include "VideoCommon/VR.h"
 #include "VideoCommon/VertexLoaderManager.h"
 #include "VideoCommon/VertexManagerBase.h"
@@ -66,6 +68,9 @@ static u8* s_video_buffer_read_ptr;
 static std::atomic<u8*> s_video_buffer_write_ptr;
 static std::atomic<u8*> s_video_buffer_seen_ptr;
 static u8* s_video_buffer_pp_read_ptr;
+// Bumped whenever the contents of s_video_buffer are moved, so that anything holding pointers into
+// already-consumed data (such as the VR opcode replay log) can tell they no longer point at it.
+static u32 s_video_buffer_generation;
 // The read_ptr is always owned by the GPU thread.  In normal mode, so is the
 // write_ptr, despite it being atomic.  In deterministic GPU thread mode,
 // things get a bit more complicated:
@@ -183,7 +188,10 @@ void SyncGPU(SyncGPUReason reason, bool may_move_read_ptr)
 {
   if (s_use_deterministic_gpu_thread)
   {
-    s_gpu_mainloop.Wait();
+    {
+      TRACE_SCOPE("Fifo::SyncGPU");
+      s_gpu_mainloop.Wait();
+    }
     if (!s_gpu_mainloop.IsRunning())
       return;
 
@@ -203,6 +211,7 @@ void SyncGPU(SyncGPUReason reason, bool may_move_read_ptr)
       size_t size = write_ptr - s_video_buffer_pp_read_ptr;
 
       memmove(s_video_buffer, s_video_buffer_pp_read_ptr, size);
+      ++s_video_buffer_generation;
       // This change always decreases the pointers.  We write seen_ptr
       // after write_ptr here, and read it before in RunGpuLoop, so
       // 'write_ptr > seen_ptr' there cannot become spuriously true.
@@ -214,6 +223,11 @@ void SyncGPU(SyncGPUReason reason, bool may_move_read_ptr)
   }
 }
 
+u32 GetVideoBufferGeneration()
+{
+  return s_video_buffer_generation;
+}
+
 void PushFifoAuxBuffer(const void* ptr, size_t size)
 {
   if (size > (size_t)(s_fifo_aux_data + FIFO_SIZE - s_fifo_aux_write_ptr))
@@ -256,6 +270,7 @@ static void ReadDataFromFifo(u32 readPtr)
       return;
     }
     memmove(s_video_buffer, s_video_buffer_read_ptr, existing_len);
+    ++s_video_buffer_generation;
     s_video_buffer_write_ptr = s_video_buffer + existing_len;
     s_video_buffer_read_ptr = s_video_buffer;
   }
@@ -272,7 +287,7 @@ static void ReadDataFromFifoOnCPU(u32 readPtr)
   if (len > (size_t)(s_video_buffer + FIFO_SIZE - write_ptr))
   {
     // We can't wrap around while the GPU is working on the data.
-    // This should be very rare due to the reset in SyncGPU.
+    // This happens about once per FIFO_SIZE of data, fewer if SyncGPU resets the buffer before.
     SyncGPU(SyncGPUReason::Wraparound);
     if (!s_gpu_mainloop.IsRunning())
     {
@@ -312,6 +327,7 @@ static void ReadDataFromFifoOnCPU(u32 readPtr)
 
 void ResetVideoBuffer()
 {
+  ++s_video_buffer_generation;
   s_video_buffer_read_ptr = s_video_buffer;
   s_video_buffer_write_ptr = s_video_buffer;
   s_video_buffer_seen_ptr = s_video_buffer;
@@ -324,6 +340,7 @@ void ResetVideoBuffer()
 // Purpose: Keep the Core HW updated about the CPU-GPU distance
 void RunGpuLoop()
 {
+  Trace::SetThreadName("GPU thread");
   AsyncRequests::GetInstance()->SetEnable(true);
   AsyncRequests::GetInstance()->SetPassthrough(false);
 
@@ -333,20 +350,33 @@ void RunGpuLoop()
 
         g_video_backend->PeekMessages();
 
-        // Do nothing while paused
+        // Do nothing while paused. The CPU thread may access memory now, e.g. to save a state,
+        // so deferred EFB copies are written first.
         if (!s_emu_running_state.IsSet())
+        {
+          if (g_texture_cache)
+            g_texture_cache->FlushEFBCopies();
           return;
+        }
 
+        TRACE_SCOPE("Fifo::RunGpuLoop");
         if (s_use_deterministic_gpu_thread)
         {
-          AsyncRequests::GetInstance()->PullEvents();
-
-          // All the fifo/CP stuff is on the CPU.  We just need to run the opcode decoder.
-          u8* seen_ptr = s_video_buffer_seen_ptr;
-          u8* write_ptr = s_video_buffer_write_ptr;
-          // See comment in SyncGPU
-          if (write_ptr > seen_ptr)
+          // All the fifo/CP stuff is on the CPU.  We just need to run the opcode decoder, and
+          // handle the events of AsyncRequests at the points of the FIFO they were pushed at.
+          // This keeps them deterministic without the CPU thread waiting for the GPU thread.
+          while (true)
           {
+            // See comment in SyncGPU. The write_ptr is also read before the events, so that
+            // events pushed after it was read have a fence at or after it.
+            u8* seen_ptr = s_video_buffer_seen_ptr;
+            u8* write_ptr = s_video_buffer_write_ptr;
+            const u8* fence = AsyncRequests::GetInstance()->PullEvents(seen_ptr);
+            if (fence && fence < write_ptr)
+              write_ptr = const_cast<u8*>(fence);
+            if (write_ptr <= seen_ptr)
+              break;
+
             s_video_buffer_read_ptr =
                 OpcodeDecoder::Run(DataReader(s_video_buffer_read_ptr, write_ptr), nullptr, false);
 
@@ -452,6 +482,7 @@ void FlushGpu()
   if (!param.bCPUThread || s_use_deterministic_gpu_thread)
     return;
 
+  TRACE_SCOPE("Fifo::FlushGpu");
   s_gpu_mainloop.Wait();
 }
 
@@ -470,8 +501,9 @@ void RunGpu()
 {
   const SConfig& param = SConfig::GetInstance();
 
-  // wake up GPU thread
-  if (param.bCPUThread && !s_use_deterministic_gpu_thread)
+  // wake up GPU thread. In deterministic GPU thread mode it only decodes what the CPU thread has
+  // preprocessed, so this is safe there too, and needed for the events of AsyncRequests.
+  if (param.bCPUThread)
   {
     s_gpu_mainloop.Wakeup();
   }
@@ -590,6 +622,11 @@ bool UseDeterministicGPUThread()
   return s_use_deterministic_gpu_thread;
 }
 
+const u8* GetPreprocessedFifoEnd()
+{
+  return s_use_deterministic_gpu_thread ? s_video_buffer_write_ptr.load() : nullptr;
+}
+
 /* This function checks the emulated CPU - GPU distance and may wake up the GPU,
  * or block the CPU if required. It should be called by the CPU thread regularly.
  * @ticks The gone emulated CPU time.
@@ -616,7 +653,10 @@ static int WaitForGpuThread(int ticks)
 
   // Wait for GPU
   if (now >= param.iSyncGpuMaxDistance)
+  {
+    TRACE_SCOPE("Fifo::WaitForGpuThread");
     s_sync_wakeup_event.Wait();
+  }
 
   return GPU_TIME_SLOT_SIZE;
 }
@@ -18,6 +18,9 @@ void DoState(PointerWrap& f);
 void PauseAndLock(bool doLock, bool unpauseOnUnlock);
 void UpdateWantDeterminism(bool want);
 bool UseDeterministicGPUThread();
+// In deterministic GPU thread mode, the end of the FIFO data the CPU thread has preprocessed and
+// handed to the GPU thread, otherwise nullptr. AsyncRequests fences its events with it.
+const u8* GetPreprocessedFifoEnd();
 
 // Used for diagnostics.
 enum class SyncGPUReason
@@ -27,10 +30,11 @@ enum class SyncGPUReason
   EFBPoke,
   PerfQuery,
   BBox,
-  Swap,
   AuxSpace,
 };
-// In deterministic GPU thread mode this waits for the GPU to be done with pending work.
+// In deterministic GPU thread mode this waits for the GPU to be done with pending work. Only
+// needed when the CPU thread looks at state of the GPU thread, as the events of AsyncRequests are
+// already ordered with the FIFO data.
 void SyncGPU(SyncGPUReason reason, bool may_move_read_ptr = true);
 
 void PushFifoAuxBuffer(const void* ptr, size_t size);
@@ -44,6 +48,8 @@ void ExitGpuLoop();
 void EmulatorState(bool running);
 bool AtBreakpoint();
 void ResetVideoBuffer();
+// Changes every time data in the video buffer is moved or discarded.
+u32 GetVideoBufferGeneration();
 void SetRendering(bool bEnabled);
 bool WillSkipCurrentFrame();
 
@@ -0,0 +1,53 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoCommon/Foveation.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "VideoCommon/VR.h"
+#include "VideoCommon/VideoConfig.h"
+
+namespace Foveation
+{
+// Distances from the lens centre, as a fraction of the way to the farthest edge of the eye
+// buffer, past which the tiles are shaded at 2x2 and 4x4. Corners are past 1.
+static constexpr float LOW_RADII[] = {0.7f, 1.0f};
+static constexpr float HIGH_RADII[] = {0.5f, 0.8f};
+
+bool IsEnabled()
+{
+  return g_has_hmd && g_ActiveConfig.iFoveation != VR_FOVEATION_OFF;
+}
+
+std::vector<u8> GenerateRateMap(u32 width, u32 height, u32 layers, int level)
+{
+  std::vector<u8> map(static_cast<size_t>(width) * height * layers, RATE_FULL);
+  if (level == VR_FOVEATION_OFF || width == 0 || height == 0)
+    return map;
+
+  const float* radii = level == VR_FOVEATION_HIGH ? HIGH_RADII : LOW_RADII;
+  auto iter = map.begin();
+  for (u32 layer = 0; layer < layers; layer++)
+  {
+    float center_x, center_y;
+    VR_GetLensCenter(std::min<int>(layer, 1), &center_x, &center_y);
+    const float extent_x = std::max(center_x, 1.0f - center_x);
+    const float extent_y = std::max(center_y, 1.0f - center_y);
+
+    for (u32 y = 0; y < height; y++)
+    {
+      const float dy = ((y + 0.5f) / height - center_y) / extent_y;
+      for (u32 x = 0; x < width; x++)
+      {
+        const float dx = ((x + 0.5f) / width - center_x) / extent_x;
+        const float distance = std::sqrt(dx * dx + dy * dy);
+        *iter++ = distance < radii[0] ? RATE_FULL : distance < radii[1] ? RATE_2X2 : RATE_4X4;
+      }
+    }
+  }
+  return map;
+}
+}  // namespace Foveation
@@ -0,0 +1,33 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+// Fixed foveated rendering shades the edges of the VR eye buffers at a coarser rate than their
+// centre. The lenses magnify the middle of each eye buffer and squeeze its edges, so the detail
+// shaded at full rate there mostly never reaches the display.
+//
+// The eye buffers are split in tiles, and each tile gets the rate of its distance from the lens
+// centre. Backends apply the map with a shading rate image where the GPU has one.
+
+#pragma once
+
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace Foveation
+{
+enum ShadingRate : u8
+{
+  RATE_FULL = 0,
+  RATE_2X2,
+  RATE_4X4,
+  NUM_RATES
+};
+
+bool IsEnabled();
+
+// Returns the rate of each tile of the eye buffers, which are width by height tiles. Rows start
+// at the bottom, and the layers, one for each eye, follow each other.
+std::vector<u8> GenerateRateMap(u32 width, u32 height, u32 layers, int level);
+}  // namespace Foveation
@@ -0,0 +1,99 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoCommon/FramePacer.h"
+
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+#include "Common/CommonTypes.h"
+#include "Common/Logging/Trace.h"
+#include "Common/Timer.h"
+#include "Core/ConfigManager.h"
+#include "Core/Core.h"
+#include "Core/HW/SystemTimers.h"
+#include "VideoCommon/VideoConfig.h"
+
+// Frames further apart than this in emulated time, such as around loading screens, start a new
+// schedule rather than being paced. 100 ms is below 10 fps.
+static constexpr u64 MAX_FRAME_INTERVAL = 100000;
+
+// Sleeps can overshoot by about a millisecond, so the last part of a precise wait spins.
+static constexpr u64 PRECISE_SPIN_TIME = 1500;
+
+// With a fixed refresh rate, V-Sync holds the frame until the next refresh anyway. Presenting a
+// little early keeps a sleep overshooting from pushing the frame to the refresh after that.
+static constexpr u64 FIXED_REFRESH_SLACK = 2000;
+
+// The schedule moves this fraction of the way towards the arrival of each early frame. Frames
+// are then held back by no more than their jitter, rather than by however early the first frame
+// of the schedule was.
+static constexpr u64 SCHEDULE_CORRECTION_SHIFT = 3;
+
+// Weight of the latest present in the smoothed statistics
+static constexpr double STATISTICS_WEIGHT = 1.0 / 16.0;
+
+static void SleepUntil(u64 target, bool precise)
+{
+  const u64 margin = precise ? PRECISE_SPIN_TIME : FIXED_REFRESH_SLACK;
+  const u64 now = Common::Timer::GetTimeUs();
+  if (target > now + margin)
+    std::this_thread::sleep_for(std::chrono::microseconds(target - now - margin));
+
+  if (precise)
+  {
+    while (Common::Timer::GetTimeUs() < target)
+      std::this_thread::yield();
+  }
+}
+
+void FramePacer::WaitForPresent(u64 ticks)
+{
+  const u64 last_ticks = m_last_ticks;
+  m_last_ticks = ticks;
+
+  const int mode = g_ActiveConfig.iFramePacing;
+  const float speed = SConfig::GetInstance().m_EmulationSpeed;
+  if (mode == FRAME_PACING_OFF || speed <= 0.0f || Core::GetIsThrottlerTempDisabled() ||
+      ticks <= last_ticks)
+  {
+    m_last_target = 0;
+    return;
+  }
+
+  const u64 now = Common::Timer::GetTimeUs();
+  const u64 interval = static_cast<u64>(static_cast<double>(ticks - last_ticks) * 1000000.0 /
+                                        SystemTimers::GetTicksPerSecond() / speed);
+  const u64 target = m_last_target + interval;
+
+  // Late frames are presented right away, as are frames so early that the schedule must have
+  // fallen behind the emulation, and the schedule restarts from them.
+  if (m_last_target == 0 || interval > MAX_FRAME_INTERVAL || target <= now ||
+      target - now > interval)
+  {
+    m_last_target = now;
+    return;
+  }
+
+  m_last_target = target - ((target - now) >> SCHEDULE_CORRECTION_SHIFT);
+
+  TRACE_SCOPE("FramePacer::WaitForPresent");
+  SleepUntil(target, mode == FRAME_PACING_VARIABLE_REFRESH);
+}
+
+void FramePacer::EndPresent()
+{
+  const u64 now = Common::Timer::GetTimeUs();
+  const u64 interval = now - m_last_present;
+  m_last_present = now;
+  if (interval > MAX_FRAME_INTERVAL)
+    return;
+
+  if (m_present_interval == 0.0)
+    m_present_interval = static_cast<double>(interval);
+  const double deviation = std::abs(static_cast<double>(interval) - m_present_interval);
+  m_present_interval += (static_cast<double>(interval) - m_present_interval) * STATISTICS_WEIGHT;
+  m_present_jitter += (deviation - m_present_jitter) * STATISTICS_WEIGHT;
+}
@@ -0,0 +1,50 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+// Spaces out the presents of the renderer by the emulated time between their frames.
+//
+// The throttle keeps emulation at the right speed on average, but frames still reach the renderer
+// early or late by however long the GPU thread took to catch up. With V-Sync on a fixed refresh
+// display, that shows as a frame repeated now and then. On a variable refresh rate display, which
+// shows each frame as soon as it's presented, every frame is on screen for a different time.
+//
+// The pacer holds a frame back until its present is due, which is the time of the last present
+// plus the emulated time between the two frames. Frames which are late are presented right away,
+// and the schedule restarts from there.
+
+#pragma once
+
+#include "Common/CommonTypes.h"
+
+enum FramePacingMode
+{
+  FRAME_PACING_OFF = 0,
+  // Presents a little early, and lets V-Sync put the frame on the right refresh.
+  FRAME_PACING_FIXED_REFRESH,
+  // Presents at the exact time, since the display follows the presents.
+  FRAME_PACING_VARIABLE_REFRESH,
+};
+
+class FramePacer
+{
+public:
+  // Called right before the backend presents the frame copied at the given CoreTiming ticks.
+  // Sleeps until its present is due.
+  void WaitForPresent(u64 ticks);
+
+  // Called once the present has returned.
+  void EndPresent();
+
+  // Smoothed time between presents, and how much they deviate from it, in milliseconds.
+  double GetPresentInterval() const { return m_present_interval / 1000.0; }
+  double GetPresentJitter() const { return m_present_jitter / 1000.0; }
+
+private:
+  u64 m_last_ticks = 0;
+  // Host time at which the last frame was due, in microseconds
+  u64 m_last_target = 0;
+  u64 m_last_present = 0;
+  double m_present_interval = 0.0;
+  double m_present_jitter = 0.0;
+};
@@ -0,0 +1,151 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoCommon/FrameProfiler.h"
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/Logging/Trace.h"
+#include "Common/StringUtil.h"
+
+namespace FrameProfiler
+{
+static constexpr size_t MAX_FRAMES = 600;
+
+// Width of the bars in the overlay for a full frame, in characters.
+static constexpr double OVERLAY_BAR_WIDTH = 40.0;
+
+static std::mutex s_frames_lock;
+static bool s_enabled = false;
+// End of each recorded frame.
+static std::deque<u64> s_frame_ends;
+
+bool IsEnabled()
+{
+  std::lock_guard<std::mutex> guard(s_frames_lock);
+  return s_enabled;
+}
+
+void SetEnabled(bool enabled)
+{
+  std::lock_guard<std::mutex> guard(s_frames_lock);
+  if (enabled == s_enabled)
+    return;
+
+  s_enabled = enabled;
+  if (enabled)
+  {
+    Trace::BeginRecording();
+    s_frame_ends.clear();
+    s_frame_ends.push_back(Trace::GetTimestamp());
+  }
+  else
+  {
+    Trace::EndRecording();
+  }
+}
+
+void EndFrame()
+{
+  std::lock_guard<std::mutex> guard(s_frames_lock);
+  if (!s_enabled)
+    return;
+
+  s_frame_ends.push_back(Trace::GetTimestamp());
+  if (s_frame_ends.size() > MAX_FRAMES)
+    s_frame_ends.pop_front();
+}
+
+std::string GetOverlayText()
+{
+  u64 frame_start, frame_end;
+  {
+    std::lock_guard<std::mutex> guard(s_frames_lock);
+    if (s_frame_ends.size() < 2)
+      return "";
+
+    frame_start = s_frame_ends[s_frame_ends.size() - 2];
+    frame_end = s_frame_ends.back();
+  }
+
+  struct Node
+  {
+    const char* name;
+    u32 depth;
+    u64 first_start;
+    u64 total_time;
+    u32 count;
+  };
+
+  const double frame_time = static_cast<double>(frame_end - frame_start);
+  std::string text = StringFromFormat("Frame profile: %.2f ms\n", frame_time / 1000000.0);
+
+  for (const Trace::ThreadEvents& thread : Trace::CollectEvents(frame_start))
+  {
+    // Merge every scope which ran in the frame by name and depth, and clip them to the frame.
+    std::vector<Node> nodes;
+    for (const Trace::Event& event : thread.events)
+    {
+      if (event.instant || event.start >= frame_end || event.end == frame_start)
+        continue;
+
+      const u64 start = std::max(event.start, frame_start);
+      const u64 time = std::min(event.end, frame_end) - start;
+      auto iter = std::find_if(nodes.begin(), nodes.end(), [&event](const Node& node) {
+        return node.depth == event.depth && node.name == event.name;
+      });
+      if (iter == nodes.end())
+      {
+        nodes.push_back({event.name, event.depth, start, time, 1});
+      }
+      else
+      {
+        iter->first_start = std::min(iter->first_start, start);
+        iter->total_time += time;
+        iter->count++;
+      }
+    }
+
+    if (nodes.empty())
+      continue;
+
+    // Parents start before their children, which gives a depth-first order.
+    std::sort(nodes.begin(), nodes.end(), [](const Node& a, const Node& b) {
+      return a.first_start != b.first_start ? a.first_start < b.first_start : a.depth < b.depth;
+    });
+
+    text += thread.thread_name + "\n";
+    for (const Node& node : nodes)
+    {
+      const int indent = 2 + 2 * static_cast<int>(std::min<u32>(node.depth, 8));
+      const size_t bar_length =
+          static_cast<size_t>(node.total_time / frame_time * OVERLAY_BAR_WIDTH + 0.5);
+      text += StringFromFormat("%*s%-*s %7.2f ms %5ux %s\n", indent, "", 40 - indent, node.name,
+                               node.total_time / 1000000.0, node.count,
+                               std::string(bar_length, '#').c_str());
+    }
+  }
+
+  return text;
+}
+
+bool WriteChromeTrace(const std::string& path)
+{
+  u64 since;
+  {
+    std::lock_guard<std::mutex> guard(s_frames_lock);
+    if (s_frame_ends.empty())
+      return false;
+
+    since = s_frame_ends.front();
+  }
+
+  return Trace::WriteChromeTrace(path, since);
+}
+}  // namespace FrameProfiler
@@ -0,0 +1,29 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+// Per-frame view of the trace scopes (see Common/Logging/Trace.h). The renderer marks frame
+// boundaries, so that the scopes of the last frame can be shown on screen, and the buffered frames
+// exported as a Chrome trace.
+
+#pragma once
+
+#include <string>
+
+namespace FrameProfiler
+{
+bool IsEnabled();
+
+// Records trace events for as long as profiling is enabled. Stopping keeps the recording, so that
+// it can still be exported.
+void SetEnabled(bool enabled);
+
+// Called by the renderer once per presented frame.
+void EndFrame();
+
+// Text chart of where the time of the last frame went, per thread and scope.
+std::string GetOverlayText();
+
+// Writes the scopes of all buffered frames in the Chrome trace event format.
+bool WriteChromeTrace(const std::string& path);
+}  // namespace FrameProfiler
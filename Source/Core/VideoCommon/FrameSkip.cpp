@@ -0,0 +1,122 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoCommon/FrameSkip.h"
+
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/Timer.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/ConfigManager.h"
+#include "Core/Core.h"
+#include "Core/HW/VideoInterface.h"
+#include "VideoCommon/BoundingBox.h"
+#include "VideoCommon/Fifo.h"
+
+namespace FrameSkip
+{
+namespace
+{
+struct FrameInfo
+{
+  u32 draws = 0;
+  // The number of draws before the last EFB copy to a texture.
+  u32 draws_before_copy = 0;
+  bool draw_result_read = false;
+};
+
+FrameInfo s_current_frame;
+FrameInfo s_previous_frame;
+
+bool s_fast_forward_skipping = false;
+// Host time in microseconds from which the next frame is shown.
+u64 s_next_shown_frame = 0;
+
+bool IsFastForwardSkippingEnabled()
+{
+  const SConfig& config = SConfig::GetInstance();
+  if (!Core::GetIsThrottlerTempDisabled() && config.m_EmulationSpeed > 0.0f)
+    return false;
+
+  // The frame skip setting has the frames skipped by Movie, and skipping frames desyncs movies.
+  return config.m_FrameSkip == 0 && !Core::WantsDeterminism() &&
+         Config::Get(Config::MAIN_FAST_FORWARD_FRAME_SKIP);
+}
+
+// Shows about as many frames per second as at full speed, however fast the emulation runs. At
+// twice the speed every other frame is skipped, at three times two frames out of three, and so on.
+void UpdateFastForwardSkipping()
+{
+  if (!IsFastForwardSkippingEnabled())
+  {
+    if (s_fast_forward_skipping)
+    {
+      s_fast_forward_skipping = false;
+      Fifo::SetRendering(true);
+    }
+    return;
+  }
+
+  const u64 now = Common::Timer::GetTimeUs();
+  const u64 interval = 1000000 / VideoInterface::GetTargetRefreshRate();
+  if (s_fast_forward_skipping && now < s_next_shown_frame)
+  {
+    Fifo::SetRendering(false);
+    return;
+  }
+
+  // Frames shown late restart the schedule, rather than being followed by several shown frames.
+  if (!s_fast_forward_skipping || now - s_next_shown_frame >= interval)
+    s_next_shown_frame = now + interval;
+  else
+    s_next_shown_frame += interval;
+  s_fast_forward_skipping = true;
+  Fifo::SetRendering(true);
+}
+}  // Anonymous namespace
+
+void Init()
+{
+  s_current_frame = {};
+  s_previous_frame = {};
+  if (s_fast_forward_skipping)
+  {
+    s_fast_forward_skipping = false;
+    Fifo::SetRendering(true);
+  }
+}
+
+bool ShouldSkipDraw()
+{
+  const u32 draw = s_current_frame.draws++;
+  if (!Fifo::WillSkipCurrentFrame())
+    return false;
+
+  if (BoundingBox::active || s_previous_frame.draw_result_read ||
+      s_current_frame.draw_result_read)
+  {
+    return false;
+  }
+
+  return draw >= s_previous_frame.draws_before_copy;
+}
+
+void OnEFBCopyToTexture()
+{
+  s_current_frame.draws_before_copy = s_current_frame.draws;
+}
+
+void OnDrawResultRead()
+{
+  s_current_frame.draw_result_read = true;
+}
+
+void EndFrame()
+{
+  s_previous_frame = s_current_frame;
+  s_current_frame = {};
+
+  UpdateFastForwardSkipping();
+}
+}  // namespace FrameSkip
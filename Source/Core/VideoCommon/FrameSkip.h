@@ -0,0 +1,32 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+// Skipping frames, whether at the fixed rate of the frame skip setting or, while fast-forwarding,
+// at the rate picked here, only drops their presentation and draws. The rest of the frame is still
+// emulated, since the game may use what it draws: in textures copied out of the EFB, in EFB and
+// perf query reads from the CPU, and in the bounding box.
+//
+// Which draws feed those is only known once the frame is done, so the skipper speculates that a
+// frame looks like the one before it. The draws up to the last EFB copy to a texture in the
+// previous frame are done, and every draw is done while the bounding box is active or once the
+// CPU has read results of draws in this frame or the previous one. The rest are dropped before
+// the vertex loader.
+
+#pragma once
+
+namespace FrameSkip
+{
+void Init();
+
+// Called by the opcode decoder for each draw, on the GPU thread.
+bool ShouldSkipDraw();
+
+void OnEFBCopyToTexture();
+// EFB peeks, perf queries and bounding box reads.
+void OnDrawResultRead();
+
+// Called at the end of each frame, whether it was skipped or not. Picks whether the next frame is
+// skipped while fast-forwarding.
+void EndFrame();
+}  // namespace FrameSkip
@@ -9,6 +9,8 @@
 #include <memory>
 #include <tuple>
 
+#include "Common/Hash.h"
+#include "Core/HW/Memmap.h"
 #include "VideoCommon/RenderBase.h"
 #include "VideoCommon/VR.h"
 #include "VideoCommon/VideoConfig.h"
@@ -22,6 +24,8 @@ FramebufferManagerBase::VirtualXFBListType
 std::array<const XFBSourceBase*, FramebufferManagerBase::MAX_VIRTUAL_XFB>
     FramebufferManagerBase::m_overlappingXFBArray;
 
+bool FramebufferManagerBase::s_real_xfb_source = false;
+
 unsigned int FramebufferManagerBase::s_last_xfb_width = 1;
 unsigned int FramebufferManagerBase::s_last_xfb_height = 1;
 
@@ -47,10 +51,21 @@ const XFBSourceBase* const* FramebufferManagerBase::GetXFBSource(u32 xfbAddr, u3
   if (!g_ActiveConfig.bUseXFB)
     return nullptr;
 
-  if (g_ActiveConfig.bUseRealXFB)
-    return GetRealXFBSource(xfbAddr, fbWidth, fbHeight, xfbCountP);
-  else
+  s_real_xfb_source = false;
+  if (!g_ActiveConfig.bUseRealXFB)
     return GetVirtualXFBSource(xfbAddr, fbWidth, fbHeight, xfbCountP);
+
+  // Present the copies of the EFB directly, unless the CPU has overwritten them in RAM since.
+  if (g_ActiveConfig.bSkipXFBCopyToRam && !IsVirtualXFBOverwritten(xfbAddr, fbWidth, fbHeight))
+  {
+    const XFBSourceBase* const* sources =
+        GetVirtualXFBSource(xfbAddr, fbWidth, fbHeight, xfbCountP);
+    if (sources && *xfbCountP > 0)
+      return sources;
+  }
+
+  s_real_xfb_source = true;
+  return GetRealXFBSource(xfbAddr, fbWidth, fbHeight, xfbCountP);
 }
 
 const XFBSourceBase* const* FramebufferManagerBase::GetRealXFBSource(u32 xfbAddr, u32 fbWidth,
@@ -123,7 +138,7 @@ FramebufferManagerBase::GetVirtualXFBSource(u32 xfbAddr, u32 fbWidth, u32 fbHeig
 void FramebufferManagerBase::CopyToXFB(u32 xfbAddr, u32 fbStride, u32 fbHeight,
                                        const EFBRectangle& sourceRc, float Gamma)
 {
-  if (g_ActiveConfig.bUseRealXFB)
+  if (g_ActiveConfig.bUseRealXFB && !g_ActiveConfig.bSkipXFBCopyToRam)
   {
     if (g_framebuffer_manager)
       g_framebuffer_manager->CopyToRealXFB(xfbAddr, fbStride, fbHeight, sourceRc, Gamma);
@@ -194,6 +209,9 @@ void FramebufferManagerBase::CopyToVirtualXFB(u32 xfbAddr, u32 fbStride, u32 fbH
   // keep stale XFB data from being used
   ReplaceVirtualXFB();
 
+  if (g_ActiveConfig.bUseRealXFB)
+    ProtectVirtualXFB(&*vxfb);
+
   // Copy EFB data to XFB and restore render target again
   vxfb->xfbSource->CopyEFB(Gamma);
 }
@@ -253,9 +271,48 @@ void FramebufferManagerBase::ReplaceVirtualXFB()
   }
 }
 
+void FramebufferManagerBase::ProtectVirtualXFB(VirtualXFB* vxfb)
+{
+  const u32 size = 2 * vxfb->xfbWidth * vxfb->xfbHeight;
+  vxfb->ramWriteToken = 0;
+  vxfb->ramHash = 0;
+  if (Memory::IsDirtyPageTrackingEnabled())
+    vxfb->ramWriteToken = Memory::ProtectRange(vxfb->xfbAddr, size);
+
+  const u8* ptr = Memory::GetPointer(vxfb->xfbAddr);
+  if (vxfb->ramWriteToken == 0 && ptr)
+    vxfb->ramHash = GetHash64(ptr, size, 0);
+}
+
+bool FramebufferManagerBase::IsVirtualXFBOverwritten(u32 xfbAddr, u32 fbWidth, u32 fbHeight)
+{
+  const u32 srcLower = xfbAddr;
+  const u32 srcUpper = xfbAddr + 2 * fbWidth * fbHeight;
+
+  for (const VirtualXFB& vxfb : m_virtualXFBList)
+  {
+    const u32 size = 2 * vxfb.xfbWidth * vxfb.xfbHeight;
+    if (!AddressRangesOverlap(srcLower, srcUpper, vxfb.xfbAddr, vxfb.xfbAddr + size))
+      continue;
+
+    if (vxfb.ramWriteToken != 0)
+    {
+      if (Memory::IsModifiedSince(vxfb.xfbAddr, size, vxfb.ramWriteToken))
+        return true;
+      continue;
+    }
+
+    const u8* ptr = Memory::GetPointer(vxfb.xfbAddr);
+    if (!ptr || GetHash64(ptr, size, 0) != vxfb.ramHash)
+      return true;
+  }
+
+  return false;
+}
+
 int FramebufferManagerBase::ScaleToVirtualXfbWidth(int x, const TargetRectangle& target_rectangle)
 {
-  if (g_ActiveConfig.RealXFBEnabled())
+  if (g_ActiveConfig.RealXFBEnabled() && !g_ActiveConfig.bSkipXFBCopyToRam)
     return x;
 
   return x * target_rectangle.GetWidth() / s_last_xfb_width;
@@ -263,7 +320,7 @@ int FramebufferManagerBase::ScaleToVirtualXfbWidth(int x, const TargetRectangle&
 
 int FramebufferManagerBase::ScaleToVirtualXfbHeight(int y, const TargetRectangle& target_rectangle)
 {
-  if (g_ActiveConfig.RealXFBEnabled())
+  if (g_ActiveConfig.RealXFBEnabled() && !g_ActiveConfig.bSkipXFBCopyToRam)
     return y;
 
   return y * target_rectangle.GetHeight() / s_last_xfb_height;
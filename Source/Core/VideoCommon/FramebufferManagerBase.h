@@ -60,6 +60,10 @@ public:
   static int ScaleToVirtualXfbWidth(int x, const TargetRectangle& target_rectangle);
   static int ScaleToVirtualXfbHeight(int y, const TargetRectangle& target_rectangle);
 
+  // Whether the sources returned by the last GetXFBSource were decoded from emulated memory, rather
+  // than being copies of the EFB. Backends draw them differently.
+  static bool IsRealXFBSource() { return s_real_xfb_source; }
+
   static unsigned int GetEFBLayers() { return m_EFBLayers; }
   virtual std::pair<u32, u32> GetTargetSize() const = 0;
 
@@ -72,6 +76,11 @@ protected:
     u32 xfbWidth = 0;
     u32 xfbHeight = 0;
 
+    // Used to notice CPU writes to the XFB in RAM when real XFB copies skip it. The write token is
+    // used with dirty page tracking, and the hash of the memory otherwise.
+    u64 ramWriteToken = 0;
+    u64 ramHash = 0;
+
     std::unique_ptr<XFBSourceBase> xfbSource;
   };
 
@@ -87,6 +96,9 @@ private:
 
   static void ReplaceVirtualXFB();
 
+  static void ProtectVirtualXFB(VirtualXFB* vxfb);
+  static bool IsVirtualXFBOverwritten(u32 xfbAddr, u32 fbWidth, u32 fbHeight);
+
   // TODO: merge these virtual funcs, they are nearly all the same
   virtual void CopyToRealXFB(u32 xfbAddr, u32 fbStride, u32 fbHeight, const EFBRectangle& sourceRc,
                              float Gamma = 1.0f) = 0;
@@ -103,6 +115,8 @@ private:
 
   static std::array<const XFBSourceBase*, MAX_VIRTUAL_XFB> m_overlappingXFBArray;
 
+  static bool s_real_xfb_source;
+
   static unsigned int s_last_xfb_width;
   static unsigned int s_last_xfb_height;
 };
@@ -20,7 +20,8 @@ constexpr std::array<const char*, 4> primitives_d3d = {{"point", "line", "triang
 
 bool geometry_shader_uid_data::IsPassthrough() const
 {
-  const bool stereo = g_ActiveConfig.iStereoMode > 0;
+  // With instanced stereo, the vertex shader already takes care of the layers.
+  const bool stereo = g_ActiveConfig.iStereoMode > 0 && !g_ActiveConfig.UseInstancedStereo();
   const bool wireframe = g_ActiveConfig.bWireFrame;
   return primitive_type >= static_cast<u32>(PrimitiveType::Triangles) && !stereo && !wireframe;
 }
@@ -56,12 +57,15 @@ ShaderCode GenerateGeometryShaderCode(APIType ApiType, const ShaderHostConfig& h
   const bool msaa = host_config.msaa;
   const bool ssaa = host_config.ssaa;
   const bool stereo = host_config.stereo;
+  // The vertex shader has already offset the vertices, and is drawn once per layer.
+  const bool instanced_stereo = host_config.UseInstancedStereo();
   const PrimitiveType primitive_type = static_cast<PrimitiveType>(uid_data->primitive_type);
   const unsigned primitive_type_index = static_cast<unsigned>(uid_data->primitive_type);
   const unsigned vertex_in = std::min(static_cast<unsigned>(primitive_type_index) + 1, 3u);
   unsigned vertex_out = primitive_type == PrimitiveType::TriangleStrip ? 3 : 4;
 
-  const unsigned int layers = host_config.more_layers * 2 + (int)(stereo) + 1;
+  const unsigned int layers =
+      instanced_stereo ? 1 : host_config.more_layers * 2 + (int)(stereo) + 1;
 
   if (wireframe)
     vertex_out++;
@@ -69,7 +73,7 @@ ShaderCode GenerateGeometryShaderCode(APIType ApiType, const ShaderHostConfig& h
   if (ApiType == APIType::OpenGL || ApiType == APIType::Vulkan)
   {
     // Insert layout parameters
-    if (host_config.backend_gs_instancing)
+    if (host_config.backend_gs_instancing && !instanced_stereo)
     {
       out.Write("layout(%s, invocations = %d) in;\n", primitives_ogl[primitive_type_index],
                 layers);
@@ -109,6 +113,8 @@ ShaderCode GenerateGeometryShaderCode(APIType ApiType, const ShaderHostConfig& h
     out.Write("VARYING_LOCATION(0) in VertexData {\n");
     GenerateVSOutputMembers<ShaderCode>(out, ApiType, uid_data->numTexGens, pixel_lighting,
                                         GetInterpolationQualifier(msaa, ssaa, true, true));
+    if (instanced_stereo)
+      out.Write("\tflat int layer;\n");
     out.Write("} vs[%d];\n", vertex_in);
 
     out.Write("VARYING_LOCATION(0) out VertexData {\n");
@@ -202,7 +208,9 @@ ShaderCode GenerateGeometryShaderCode(APIType ApiType, const ShaderHostConfig& h
   {
     // If the GPU supports invocation we don't need a for loop and can simply use the
     // invocation identifier to determine which layer we're rendering.
-    if (host_config.backend_gs_instancing)
+    if (instanced_stereo)
+      out.Write("\tint eye = vs[0].layer;\n");
+    else if (host_config.backend_gs_instancing)
       out.Write("\tint eye = InstanceID;\n");
     else
       out.Write("\tfor (int eye = 0; eye < %d; ++eye) {\n", layers);
@@ -232,7 +240,12 @@ ShaderCode GenerateGeometryShaderCode(APIType ApiType, const ShaderHostConfig& h
     out.Write("\tVS_OUTPUT f = o[i];\n");
   }
 
-  if (host_config.vr)
+  if (instanced_stereo)
+  {
+    out.Write("\tps.layer = eye;\n");
+    out.Write("\tgl_Layer = eye;\n");
+  }
+  else if (host_config.vr)
   {
     // Select the output layer
     out.Write("\tps.layer = eye;\n");
@@ -323,7 +336,8 @@ ShaderCode GenerateGeometryShaderCode(APIType ApiType, const ShaderHostConfig& h
 
   EndPrimitive(out, host_config, uid_data, ApiType, wireframe, pixel_lighting);
 
-  if ((stereo || host_config.more_layers) && !host_config.backend_gs_instancing)
+  if ((stereo || host_config.more_layers) && !host_config.backend_gs_instancing &&
+      !instanced_stereo)
     out.Write("\t}\n");
 
   out.Write("}\n");
@@ -7,12 +7,17 @@
 #include <SOIL/SOIL.h>
 #include <algorithm>
 #include <cinttypes>
+#include <condition_variable>
+#include <cstdlib>
 #include <cstring>
+#include <deque>
 #include <memory>
 #include <mutex>
+#include <png.h>
 #include <string>
 #include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 #include <xxhash.h>
@@ -31,6 +36,7 @@
 #include "Core/Config/GraphicsSettings.h"
 #include "Core/ConfigManager.h"
 #include "VideoCommon/OnScreenDisplay.h"
+#include "VideoCommon/TexturePack.h"
 #include "VideoCommon/VideoConfig.h"
 
 static std::unordered_map<std::string, std::string> s_textureMap;
@@ -40,9 +46,33 @@ static std::mutex s_textureCacheAquireMutex;  // for high priority access
 static Common::Flag s_textureCacheAbortLoading;
 static bool s_check_native_format;
 static bool s_check_new_format;
+// Set if the game has a texture pack, which is then used instead of the texture directory.
+static std::shared_ptr<TexturePack::PackReader> s_pack;
 
 static std::thread s_prefetcher;
 
+// Custom textures which weren't prefetched are loaded by a few background threads when they are
+// first used, instead of stalling the video thread.
+struct LoadRequest
+{
+  std::string base_filename;
+  u32 width;
+  u32 height;
+};
+static std::vector<std::thread> s_loader_threads;
+static std::deque<LoadRequest> s_load_queue;
+static std::mutex s_load_queue_mutex;
+static std::condition_variable s_load_queue_cv;
+static bool s_stop_loading = false;
+// The following are guarded by s_textureCacheMutex.
+static std::unordered_set<std::string> s_pending_loads;
+static std::unordered_set<std::string> s_failed_loads;
+static u64 s_use_counter = 0;
+static size_t s_cache_budget = 0;  // 0 if textures are never evicted
+
+// SOIL isn't thread safe.
+static std::mutex s_soil_mutex;
+
 static const std::string s_format_prefix = "tex1_";
 
 HiresTexture::Level::Level()
@@ -69,9 +99,12 @@ void HiresTexture::Shutdown()
     s_textureCacheAbortLoading.Set();
     s_prefetcher.join();
   }
+  StopLoaderThreads();
 
   s_textureMap.clear();
   s_textureCache.clear();
+  s_failed_loads.clear();
+  s_pack.reset();
 }
 
 void HiresTexture::Update()
@@ -81,11 +114,14 @@ void HiresTexture::Update()
     s_textureCacheAbortLoading.Set();
     s_prefetcher.join();
   }
+  StopLoaderThreads();
+  s_failed_loads.clear();
 
   if (!g_ActiveConfig.bHiresTextures)
   {
     s_textureMap.clear();
     s_textureCache.clear();
+    s_pack.reset();
     return;
   }
 
@@ -95,33 +131,33 @@ void HiresTexture::Update()
   }
 
   const std::string& game_id = SConfig::GetInstance().GetGameID();
-  const std::string texture_directory = GetTextureDirectory(game_id);
-  std::vector<std::string> extensions{
-      ".png", ".bmp", ".tga", ".dds",
-      ".jpg"  // Why not? Could be useful for large photo-like textures
-  };
-
-  std::vector<std::string> filenames =
-      Common::DoFileSearch({texture_directory}, extensions, /*recursive*/ true);
-
   const std::string code = game_id + "_";
-
-  for (auto& rFilename : filenames)
-  {
-    std::string FileName;
-    SplitPath(rFilename, nullptr, &FileName, nullptr);
-
-    if (FileName.substr(0, code.length()) == code)
+  const auto add_texture = [&code](const std::string& name, const std::string& path) {
+    if (name.substr(0, code.length()) == code)
     {
-      s_textureMap[FileName] = rFilename;
+      s_textureMap[name] = path;
       s_check_native_format = true;
     }
 
-    if (FileName.substr(0, s_format_prefix.length()) == s_format_prefix)
+    if (name.substr(0, s_format_prefix.length()) == s_format_prefix)
     {
-      s_textureMap[FileName] = rFilename;
+      s_textureMap[name] = path;
       s_check_new_format = true;
     }
+  };
+
+  s_textureMap.clear();
+  s_pack = TexturePack::PackReader::Open(GetTexturePackPath(game_id));
+  if (s_pack)
+  {
+    // The mip levels are part of the pack entries, so only the base names are added.
+    for (u32 i = 0; i < s_pack->GetTextureCount(); i++)
+      add_texture(s_pack->GetTextureName(i), "");
+  }
+  else
+  {
+    for (const auto& entry : FindTextureFiles(GetTextureDirectory(game_id)))
+      add_texture(entry.first, entry.second);
   }
 
   if (g_ActiveConfig.bCacheHiresTextures)
@@ -143,18 +179,127 @@ void HiresTexture::Update()
     s_textureCacheAbortLoading.Clear();
     s_prefetcher = std::thread(Prefetch);
   }
+
+  if (g_ActiveConfig.bAsyncHiresTextures)
+    StartLoaderThreads();
 }
 
-void HiresTexture::Prefetch()
+static size_t GetMaxCacheSize()
 {
-  Common::SetCurrentThreadName("Prefetcher");
+  if (g_ActiveConfig.iHiresTextureCacheSize > 0)
+    return static_cast<size_t>(g_ActiveConfig.iHiresTextureCacheSize) * 1024 * 1024;
 
-  size_t size_sum = 0;
   size_t sys_mem = Common::MemPhysical();
   size_t recommended_min_mem = 2 * size_t(1024 * 1024 * 1024);
   // keep 2GB memory for system stability if system RAM is 4GB+ - use half of memory in other cases
-  size_t max_mem =
-      (sys_mem / 2 < recommended_min_mem) ? (sys_mem / 2) : (sys_mem - recommended_min_mem);
+  return (sys_mem / 2 < recommended_min_mem) ? (sys_mem / 2) : (sys_mem - recommended_min_mem);
+}
+
+void HiresTexture::StartLoaderThreads()
+{
+  // When everything is prefetched anyway, evicting textures would only make them load again.
+  s_cache_budget = g_ActiveConfig.bCacheHiresTextures ? 0 : GetMaxCacheSize();
+
+  s_stop_loading = false;
+  const u32 num_threads = std::max(1u, std::min(4u, std::thread::hardware_concurrency() / 2));
+  for (u32 i = 0; i < num_threads; i++)
+    s_loader_threads.emplace_back(LoaderThread);
+}
+
+void HiresTexture::StopLoaderThreads()
+{
+  if (s_loader_threads.empty())
+    return;
+
+  {
+    std::lock_guard<std::mutex> lk(s_load_queue_mutex);
+    s_stop_loading = true;
+    s_load_queue.clear();
+  }
+  s_load_queue_cv.notify_all();
+  for (std::thread& thread : s_loader_threads)
+    thread.join();
+  s_loader_threads.clear();
+
+  std::lock_guard<std::mutex> lk(s_textureCacheMutex);
+  s_pending_loads.clear();
+}
+
+void HiresTexture::LoaderThread()
+{
+  Common::SetCurrentThreadName("Custom Texture Loader");
+
+  while (true)
+  {
+    LoadRequest request;
+    {
+      std::unique_lock<std::mutex> lk(s_load_queue_mutex);
+      s_load_queue_cv.wait(lk, [] { return s_stop_loading || !s_load_queue.empty(); });
+      if (s_stop_loading)
+        return;
+
+      request = std::move(s_load_queue.front());
+      s_load_queue.pop_front();
+    }
+
+    std::shared_ptr<HiresTexture> texture =
+        Load(request.base_filename, request.width, request.height);
+
+    {
+      // try to get this mutex first, so the video thread is allow to get the real mutex faster
+      std::unique_lock<std::mutex> lk(s_textureCacheAquireMutex);
+    }
+    std::lock_guard<std::mutex> lk(s_textureCacheMutex);
+    s_pending_loads.erase(request.base_filename);
+    if (!texture)
+    {
+      // Don't retry every time the texture is used.
+      s_failed_loads.insert(request.base_filename);
+      continue;
+    }
+
+    texture->m_last_use = ++s_use_counter;
+    s_textureCache[request.base_filename] = std::move(texture);
+    EvictLeastRecentlyUsed();
+  }
+}
+
+void HiresTexture::EvictLeastRecentlyUsed()
+{
+  if (s_cache_budget == 0)
+    return;
+
+  size_t total_size = 0;
+  for (const auto& entry : s_textureCache)
+    total_size += entry.second->GetDataSize();
+  if (total_size <= s_cache_budget)
+    return;
+
+  // Go down to 3/4 of the budget, so that this doesn't need to run for every new texture.
+  std::vector<decltype(s_textureCache)::iterator> entries;
+  entries.reserve(s_textureCache.size());
+  for (auto iter = s_textureCache.begin(); iter != s_textureCache.end(); ++iter)
+    entries.push_back(iter);
+  std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) {
+    return a->second->m_last_use < b->second->m_last_use;
+  });
+
+  for (const auto& iter : entries)
+  {
+    if (total_size <= s_cache_budget / 4 * 3)
+      break;
+
+    total_size -= iter->second->GetDataSize();
+    s_textureCache.erase(iter);
+  }
+}
+
+void HiresTexture::Prefetch()
+{
+  Common::SetCurrentThreadName("Prefetcher");
+
+  size_t size_sum = 0;
+  const size_t max_mem = GetMaxCacheSize();
   u32 starttime = Common::Timer::GetTimeMs();
   for (const auto& entry : s_textureMap)
   {
@@ -237,7 +382,8 @@ std::string HiresTexture::GenBaseName(const u8* texture, size_t texture_size, co
                             (u32)(tex_hash ^ tlut_hash), (u16)format);
     if (s_textureMap.find(name) != s_textureMap.end())
     {
-      if (g_ActiveConfig.bConvertHiresTextures)
+      // Textures can't be renamed inside of a pack.
+      if (g_ActiveConfig.bConvertHiresTextures && !s_pack)
         convert = true;
       else
         return name;
@@ -391,7 +537,7 @@ u32 HiresTexture::CalculateMipCount(u32 width, u32 height)
 std::shared_ptr<HiresTexture> HiresTexture::Search(const u8* texture, size_t texture_size,
                                                    const u8* tlut, size_t tlut_size, u32 width,
                                                    u32 height, TextureFormat format,
-                                                   bool has_mipmaps)
+                                                   bool has_mipmaps, std::string* pending_name)
 {
   std::string base_filename =
       GenBaseName(texture, texture_size, tlut, tlut_size, width, height, format, has_mipmaps);
@@ -402,9 +548,33 @@ std::shared_ptr<HiresTexture> HiresTexture::Search(const u8* texture, size_t tex
   auto iter = s_textureCache.find(base_filename);
   if (iter != s_textureCache.end())
   {
+    iter->second->m_last_use = ++s_use_counter;
     return iter->second;
   }
 
+  if (!s_loader_threads.empty())
+  {
+    if (s_textureMap.find(base_filename) == s_textureMap.end() ||
+        s_failed_loads.count(base_filename))
+    {
+      return nullptr;
+    }
+
+    if (s_pending_loads.insert(base_filename).second)
+    {
+      {
+        // The most recently requested textures are the most likely to be on screen right now.
+        std::lock_guard<std::mutex> queue_lk(s_load_queue_mutex);
+        s_load_queue.push_front({base_filename, width, height});
+      }
+      s_load_queue_cv.notify_one();
+    }
+
+    if (pending_name)
+      *pending_name = std::move(base_filename);
+    return nullptr;
+  }
+
   std::shared_ptr<HiresTexture> ptr(Load(base_filename, width, height));
 
   if (ptr && g_ActiveConfig.bCacheHiresTextures)
@@ -415,12 +585,68 @@ std::shared_ptr<HiresTexture> HiresTexture::Search(const u8* texture, size_t tex
   return ptr;
 }
 
+bool HiresTexture::IsLoadPending(const std::string& base_filename)
+{
+  std::lock_guard<std::mutex> lk(s_textureCacheMutex);
+  return s_pending_loads.count(base_filename) != 0;
+}
+
 std::unique_ptr<HiresTexture> HiresTexture::Load(const std::string& base_filename, u32 width,
                                                  u32 height)
+{
+  if (s_pack)
+    return LoadFromPack(s_pack, base_filename);
+
+  return LoadFromFiles(s_textureMap, base_filename, width, height);
+}
+
+std::unique_ptr<HiresTexture>
+HiresTexture::LoadFromPack(const std::shared_ptr<TexturePack::PackReader>& pack,
+                           const std::string& base_filename)
+{
+  const TexturePack::PackEntry* entry = pack->FindTexture(base_filename);
+  if (!entry)
+    return nullptr;
+
+  // The pack keeps compressed textures as they are, so the backend has to support them.
+  const auto format = static_cast<AbstractTextureFormat>(entry->format);
+  if ((format == AbstractTextureFormat::BPTC &&
+       !g_ActiveConfig.backend_info.bSupportsBPTCTextures) ||
+      (format != AbstractTextureFormat::RGBA8 && format != AbstractTextureFormat::BPTC &&
+       !g_ActiveConfig.backend_info.bSupportsST3CTextures))
+  {
+    return nullptr;
+  }
+
+  // Can't use make_unique due to private constructor.
+  std::unique_ptr<HiresTexture> ret = std::unique_ptr<HiresTexture>(new HiresTexture());
+  ret->m_pack = pack;
+  for (u32 i = 0; i < entry->num_levels; i++)
+  {
+    const TexturePack::PackLevel& pack_level = pack->GetLevel(*entry, i);
+
+    // The data is owned by the mapping, not the level.
+    Level level;
+    level.data = ImageDataPointer(const_cast<u8*>(pack->GetLevelData(pack_level)),
+                                  [](unsigned char*) {});
+    level.format = format;
+    level.width = pack_level.width;
+    level.height = pack_level.height;
+    level.row_length = pack_level.row_length;
+    level.data_size = pack_level.size;
+    ret->m_levels.push_back(std::move(level));
+  }
+
+  return ret;
+}
+
+std::unique_ptr<HiresTexture>
+HiresTexture::LoadFromFiles(const std::unordered_map<std::string, std::string>& texture_map,
+                            const std::string& base_filename, u32 width, u32 height)
 {
   // We need to have a level 0 custom texture to even consider loading.
-  auto filename_iter = s_textureMap.find(base_filename);
-  if (filename_iter == s_textureMap.end())
+  auto filename_iter = texture_map.find(base_filename);
+  if (filename_iter == texture_map.end())
     return nullptr;
 
   // Try to load level 0 (and any mipmaps) from a DDS file.
@@ -437,8 +663,8 @@ std::unique_ptr<HiresTexture> HiresTexture::Load(const std::string& base_filenam
     if (mip_level != 0)
       filename += StringFromFormat("_mip%u", mip_level);
 
-    filename_iter = s_textureMap.find(filename);
-    if (filename_iter == s_textureMap.end())
+    filename_iter = texture_map.find(filename);
+    if (filename_iter == texture_map.end())
       break;
 
     // Try loading DDS textures first, that way we maintain compression of DXT formats.
@@ -525,14 +751,50 @@ std::unique_ptr<HiresTexture> HiresTexture::Load(const std::string& base_filenam
   return ret;
 }
 
+#ifdef PNG_SIMPLIFIED_READ_SUPPORTED
+static bool LoadPNGTexture(HiresTexture::Level& level, const std::vector<u8>& buffer)
+{
+  png_image png = {};
+  png.version = PNG_IMAGE_VERSION;
+  if (!png_image_begin_read_from_memory(&png, buffer.data(), buffer.size()))
+    return false;
+
+  png.format = PNG_FORMAT_RGBA;
+  // Allocated with malloc, as SOIL_free_image_data is a plain free().
+  u8* data = static_cast<u8*>(std::malloc(PNG_IMAGE_SIZE(png)));
+  if (!data || !png_image_finish_read(&png, nullptr, data, 0, nullptr))
+  {
+    std::free(data);
+    png_image_free(&png);
+    return false;
+  }
+
+  level.width = png.width;
+  level.height = png.height;
+  level.format = AbstractTextureFormat::RGBA8;
+  level.data = HiresTexture::ImageDataPointer(data, SOIL_free_image_data);
+  level.row_length = level.width;
+  level.data_size = static_cast<size_t>(level.row_length) * 4 * level.height;
+  return true;
+}
+#endif
+
 bool HiresTexture::LoadTexture(Level& level, const std::vector<u8>& buffer)
 {
+#ifdef PNG_SIMPLIFIED_READ_SUPPORTED
+  // Unlike SOIL, libpng can be used from several loader threads at once.
+  if (LoadPNGTexture(level, buffer))
+    return true;
+#endif
+
   int channels;
   int width;
   int height;
 
+  std::unique_lock<std::mutex> lk(s_soil_mutex);
   u8* data = SOIL_load_image_from_memory(buffer.data(), static_cast<int>(buffer.size()), &width,
                                          &height, &channels, SOIL_LOAD_RGBA);
+  lk.unlock();
   if (!data)
     return false;
 
@@ -557,6 +819,36 @@ std::string HiresTexture::GetTextureDirectory(const std::string& game_id)
   return texture_directory;
 }
 
+std::string HiresTexture::GetTexturePackPath(const std::string& game_id)
+{
+  const std::string pack_path = File::GetUserPath(D_HIRESTEXTURES_IDX) + game_id + ".dtp";
+
+  // Same as for the directory, fall back to a region-free pack
+  if (!File::Exists(pack_path))
+    return File::GetUserPath(D_HIRESTEXTURES_IDX) + game_id.substr(0, 3) + ".dtp";
+
+  return pack_path;
+}
+
+std::unordered_map<std::string, std::string>
+HiresTexture::FindTextureFiles(const std::string& directory)
+{
+  std::vector<std::string> extensions{
+      ".png", ".bmp", ".tga", ".dds",
+      ".jpg"  // Why not? Could be useful for large photo-like textures
+  };
+
+  std::unordered_map<std::string, std::string> texture_map;
+  for (std::string& path : Common::DoFileSearch({directory}, extensions, /*recursive*/ true))
+  {
+    std::string name;
+    SplitPath(path, nullptr, &name, nullptr);
+    texture_map[name] = std::move(path);
+  }
+
+  return texture_map;
+}
+
 HiresTexture::~HiresTexture()
 {
 #if defined(_MSC_VER) && _MSC_VER <= 1800
@@ -571,3 +863,11 @@ AbstractTextureFormat HiresTexture::GetFormat() const
 {
   return m_levels.at(0).format;
 }
+
+size_t HiresTexture::GetDataSize() const
+{
+  size_t size = 0;
+  for (const Level& level : m_levels)
+    size += level.data_size;
+  return size;
+}
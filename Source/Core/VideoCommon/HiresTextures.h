@@ -6,6 +6,7 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -13,6 +14,11 @@
 
 enum class TextureFormat;
 
+namespace TexturePack
+{
+class PackReader;
+}
+
 class HiresTexture
 {
 public:
@@ -26,9 +32,14 @@ public:
   static void Update();
   static void Shutdown();
 
+  // With asynchronous loading, textures which aren't in memory yet are queued for one of the
+  // loader threads and nullptr is returned. pending_name is then set to the texture's name, so that
+  // the native texture can be used until IsLoadPending returns false for it.
   static std::shared_ptr<HiresTexture> Search(const u8* texture, size_t texture_size,
                                               const u8* tlut, size_t tlut_size, u32 width,
-                                              u32 height, TextureFormat format, bool has_mipmaps);
+                                              u32 height, TextureFormat format, bool has_mipmaps,
+                                              std::string* pending_name = nullptr);
+  static bool IsLoadPending(const std::string& base_filename);
 
   static std::string GenBaseName(const u8* texture, size_t texture_size, const u8* tlut,
                                  size_t tlut_size, u32 width, u32 height, TextureFormat format,
@@ -36,9 +47,22 @@ public:
 
   static u32 CalculateMipCount(u32 width, u32 height);
 
+  // Maps the names of all custom texture images in directory and its subdirectories to their paths.
+  static std::unordered_map<std::string, std::string>
+  FindTextureFiles(const std::string& directory);
+  // Loads a texture and its mipmaps from the images in texture_map, see FindTextureFiles.
+  static std::unique_ptr<HiresTexture>
+  LoadFromFiles(const std::unordered_map<std::string, std::string>& texture_map,
+                const std::string& base_filename, u32 width, u32 height);
+
+  static std::string GetTextureDirectory(const std::string& game_id);
+  // A texture pack is used instead of the texture directory if there is one, see TexturePack.h.
+  static std::string GetTexturePackPath(const std::string& game_id);
+
   ~HiresTexture();
 
   AbstractTextureFormat GetFormat() const;
+  size_t GetDataSize() const;
   struct Level
   {
     Level();
@@ -55,12 +79,21 @@ public:
 private:
   static std::unique_ptr<HiresTexture> Load(const std::string& base_filename, u32 width,
                                             u32 height);
+  static std::unique_ptr<HiresTexture>
+  LoadFromPack(const std::shared_ptr<TexturePack::PackReader>& pack,
+               const std::string& base_filename);
   static bool LoadDDSTexture(HiresTexture* tex, const std::string& filename);
   static bool LoadDDSTexture(Level& level, const std::string& filename);
   static bool LoadTexture(Level& level, const std::vector<u8>& buffer);
   static void Prefetch();
-
-  static std::string GetTextureDirectory(const std::string& game_id);
+  static void LoaderThread();
+  static void StartLoaderThreads();
+  static void StopLoaderThreads();
+  static void EvictLeastRecentlyUsed();
 
   HiresTexture() {}
+  // Value of the use counter when this texture was last returned by Search, for the LRU eviction.
+  u64 m_last_use = 0;
+  // The levels of textures loaded from a pack point into its mapping.
+  std::shared_ptr<TexturePack::PackReader> m_pack;
 };
@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include <cstddef>
+#include <limits>
 
 #include "Common/Common.h"
 #include "Common/CommonTypes.h"
@@ -12,74 +13,95 @@
 #include "VideoCommon/VideoConfig.h"
 
 // Init
-u16* IndexGenerator::index_buffer_current;
-u16* IndexGenerator::BASEIptr;
+u8* IndexGenerator::index_buffer_current;
+u8* IndexGenerator::BASEIptr;
 u32 IndexGenerator::base_index;
+u32 IndexGenerator::index_size = sizeof(u16);
 
-static const u16 s_primitive_restart = UINT16_MAX;
+// The largest index is reserved for primitive restart (ogl + dx11 + vulkan)
+template <typename T>
+static constexpr T s_primitive_restart = std::numeric_limits<T>::max();
 
-static u16* (*primitive_table[8])(u16*, u32, u32);
+static u16* (*primitive_table_16[8])(u16*, u32, u32);
+static u32* (*primitive_table_32[8])(u32*, u32, u32);
+
+template <typename T, bool pr>
+void IndexGenerator::InitPrimitiveTable(T* (**table)(T*, u32, u32))
+{
+  table[OpcodeDecoder::GX_DRAW_QUADS] = AddQuads<T, pr>;
+  table[OpcodeDecoder::GX_DRAW_QUADS_2] = AddQuads_nonstandard<T, pr>;
+  table[OpcodeDecoder::GX_DRAW_TRIANGLES] = AddList<T, pr>;
+  table[OpcodeDecoder::GX_DRAW_TRIANGLE_STRIP] = AddStrip<T, pr>;
+  table[OpcodeDecoder::GX_DRAW_TRIANGLE_FAN] = AddFan<T, pr>;
+  table[OpcodeDecoder::GX_DRAW_LINES] = AddLineList<T>;
+  table[OpcodeDecoder::GX_DRAW_LINE_STRIP] = AddLineStrip<T>;
+  table[OpcodeDecoder::GX_DRAW_POINTS] = AddPoints<T>;
+}
 
 void IndexGenerator::Init()
 {
   if (g_Config.backend_info.bSupportsPrimitiveRestart)
   {
-    primitive_table[OpcodeDecoder::GX_DRAW_QUADS] = AddQuads<true>;
-    primitive_table[OpcodeDecoder::GX_DRAW_QUADS_2] = AddQuads_nonstandard<true>;
-    primitive_table[OpcodeDecoder::GX_DRAW_TRIANGLES] = AddList<true>;
-    primitive_table[OpcodeDecoder::GX_DRAW_TRIANGLE_STRIP] = AddStrip<true>;
-    primitive_table[OpcodeDecoder::GX_DRAW_TRIANGLE_FAN] = AddFan<true>;
+    InitPrimitiveTable<u16, true>(primitive_table_16);
+    InitPrimitiveTable<u32, true>(primitive_table_32);
   }
   else
   {
-    primitive_table[OpcodeDecoder::GX_DRAW_QUADS] = AddQuads<false>;
-    primitive_table[OpcodeDecoder::GX_DRAW_QUADS_2] = AddQuads_nonstandard<false>;
-    primitive_table[OpcodeDecoder::GX_DRAW_TRIANGLES] = AddList<false>;
-    primitive_table[OpcodeDecoder::GX_DRAW_TRIANGLE_STRIP] = AddStrip<false>;
-    primitive_table[OpcodeDecoder::GX_DRAW_TRIANGLE_FAN] = AddFan<false>;
+    InitPrimitiveTable<u16, false>(primitive_table_16);
+    InitPrimitiveTable<u32, false>(primitive_table_32);
   }
-  primitive_table[OpcodeDecoder::GX_DRAW_LINES] = &AddLineList;
-  primitive_table[OpcodeDecoder::GX_DRAW_LINE_STRIP] = &AddLineStrip;
-  primitive_table[OpcodeDecoder::GX_DRAW_POINTS] = &AddPoints;
+
+  // The backends read the index size back when allocating and binding the index buffer, so it
+  // must not change while they are running.
+  index_size = g_Config.Use32BitIndices() ? sizeof(u32) : sizeof(u16);
 }
 
-void IndexGenerator::Start(u16* Indexptr)
+void IndexGenerator::Start(void* Indexptr)
 {
-  index_buffer_current = Indexptr;
-  BASEIptr = Indexptr;
+  index_buffer_current = static_cast<u8*>(Indexptr);
+  BASEIptr = static_cast<u8*>(Indexptr);
   base_index = 0;
 }
 
 void IndexGenerator::AddIndices(int primitive, u32 numVerts)
 {
-  index_buffer_current = primitive_table[primitive](index_buffer_current, numVerts, base_index);
+  if (index_size == sizeof(u32))
+  {
+    index_buffer_current = reinterpret_cast<u8*>(primitive_table_32[primitive](
+        reinterpret_cast<u32*>(index_buffer_current), numVerts, base_index));
+  }
+  else
+  {
+    index_buffer_current = reinterpret_cast<u8*>(primitive_table_16[primitive](
+        reinterpret_cast<u16*>(index_buffer_current), numVerts, base_index));
+  }
   base_index += numVerts;
 }
 
 // Triangles
-template <bool pr>
-__forceinline u16* IndexGenerator::WriteTriangle(u16* Iptr, u32 index1, u32 index2, u32 index3)
+template <typename T, bool pr>
+__forceinline T* IndexGenerator::WriteTriangle(T* Iptr, u32 index1, u32 index2, u32 index3)
 {
   *Iptr++ = index1;
   *Iptr++ = index2;
   *Iptr++ = index3;
   if (pr)
-    *Iptr++ = s_primitive_restart;
+    *Iptr++ = s_primitive_restart<T>;
   return Iptr;
 }
 
-template <bool pr>
-u16* IndexGenerator::AddList(u16* Iptr, u32 const numVerts, u32 index)
+template <typename T, bool pr>
+T* IndexGenerator::AddList(T* Iptr, u32 const numVerts, u32 index)
 {
   for (u32 i = 2; i < numVerts; i += 3)
   {
-    Iptr = WriteTriangle<pr>(Iptr, index + i - 2, index + i - 1, index + i);
+    Iptr = WriteTriangle<T, pr>(Iptr, index + i - 2, index + i - 1, index + i);
   }
   return Iptr;
 }
 
-template <bool pr>
-u16* IndexGenerator::AddStrip(u16* Iptr, u32 const numVerts, u32 index)
+template <typename T, bool pr>
+T* IndexGenerator::AddStrip(T* Iptr, u32 const numVerts, u32 index)
 {
   if (pr)
   {
@@ -87,14 +109,14 @@ u16* IndexGenerator::AddStrip(u16* Iptr, u32 const numVerts, u32 index)
     {
       *Iptr++ = index + i;
     }
-    *Iptr++ = s_primitive_restart;
+    *Iptr++ = s_primitive_restart<T>;
   }
   else
   {
     bool wind = false;
     for (u32 i = 2; i < numVerts; ++i)
     {
-      Iptr = WriteTriangle<pr>(Iptr, index + i - 2, index + i - !wind, index + i - wind);
+      Iptr = WriteTriangle<T, pr>(Iptr, index + i - 2, index + i - !wind, index + i - wind);
 
       wind ^= true;
     }
@@ -121,8 +143,8 @@ u16* IndexGenerator::AddStrip(u16* Iptr, u32 const numVerts, u32 index)
  * so we use 6 indices for 3 triangles
  */
 
-template <bool pr>
-u16* IndexGenerator::AddFan(u16* Iptr, u32 numVerts, u32 index)
+template <typename T, bool pr>
+T* IndexGenerator::AddFan(T* Iptr, u32 numVerts, u32 index)
 {
   u32 i = 2;
 
@@ -135,7 +157,7 @@ u16* IndexGenerator::AddFan(u16* Iptr, u32 numVerts, u32 index)
       *Iptr++ = index;
       *Iptr++ = index + i + 1;
       *Iptr++ = index + i + 2;
-      *Iptr++ = s_primitive_restart;
+      *Iptr++ = s_primitive_restart<T>;
     }
 
     for (; i + 2 <= numVerts; i += 2)
@@ -144,13 +166,13 @@ u16* IndexGenerator::AddFan(u16* Iptr, u32 numVerts, u32 index)
       *Iptr++ = index + i + 0;
       *Iptr++ = index;
       *Iptr++ = index + i + 1;
-      *Iptr++ = s_primitive_restart;
+      *Iptr++ = s_primitive_restart<T>;
     }
   }
 
   for (; i < numVerts; ++i)
   {
-    Iptr = WriteTriangle<pr>(Iptr, index, index + i - 1, index + i);
+    Iptr = WriteTriangle<T, pr>(Iptr, index, index + i - 1, index + i);
   }
   return Iptr;
 }
@@ -172,8 +194,8 @@ u16* IndexGenerator::AddFan(u16* Iptr, u32 numVerts, u32 index)
  * A simple triangle has to be rendered for three vertices.
  * ZWW do this for sun rays
  */
-template <bool pr>
-u16* IndexGenerator::AddQuads(u16* Iptr, u32 numVerts, u32 index)
+template <typename T, bool pr>
+T* IndexGenerator::AddQuads(T* Iptr, u32 numVerts, u32 index)
 {
   u32 i = 3;
   for (; i < numVerts; i += 4)
@@ -184,33 +206,34 @@ u16* IndexGenerator::AddQuads(u16* Iptr, u32 numVerts, u32 index)
       *Iptr++ = index + i - 1;
       *Iptr++ = index + i - 3;
       *Iptr++ = index + i - 0;
-      *Iptr++ = s_primitive_restart;
+      *Iptr++ = s_primitive_restart<T>;
     }
     else
     {
-      Iptr = WriteTriangle<pr>(Iptr, index + i - 3, index + i - 2, index + i - 1);
-      Iptr = WriteTriangle<pr>(Iptr, index + i - 3, index + i - 1, index + i - 0);
+      Iptr = WriteTriangle<T, pr>(Iptr, index + i - 3, index + i - 2, index + i - 1);
+      Iptr = WriteTriangle<T, pr>(Iptr, index + i - 3, index + i - 1, index + i - 0);
     }
   }
 
   // three vertices remaining, so render a triangle
   if (i == numVerts)
   {
-    Iptr =
-        WriteTriangle<pr>(Iptr, index + numVerts - 3, index + numVerts - 2, index + numVerts - 1);
+    Iptr = WriteTriangle<T, pr>(Iptr, index + numVerts - 3, index + numVerts - 2,
+                                index + numVerts - 1);
   }
   return Iptr;
 }
 
-template <bool pr>
-u16* IndexGenerator::AddQuads_nonstandard(u16* Iptr, u32 numVerts, u32 index)
+template <typename T, bool pr>
+T* IndexGenerator::AddQuads_nonstandard(T* Iptr, u32 numVerts, u32 index)
 {
   WARN_LOG(VIDEO, "Non-standard primitive drawing command GL_DRAW_QUADS_2");
-  return AddQuads<pr>(Iptr, numVerts, index);
+  return AddQuads<T, pr>(Iptr, numVerts, index);
 }
 
 // Lines
-u16* IndexGenerator::AddLineList(u16* Iptr, u32 numVerts, u32 index)
+template <typename T>
+T* IndexGenerator::AddLineList(T* Iptr, u32 numVerts, u32 index)
 {
   for (u32 i = 1; i < numVerts; i += 2)
   {
@@ -222,7 +245,8 @@ u16* IndexGenerator::AddLineList(u16* Iptr, u32 numVerts, u32 index)
 
 // shouldn't be used as strips as LineLists are much more common
 // so converting them to lists
-u16* IndexGenerator::AddLineStrip(u16* Iptr, u32 numVerts, u32 index)
+template <typename T>
+T* IndexGenerator::AddLineStrip(T* Iptr, u32 numVerts, u32 index)
 {
   for (u32 i = 1; i < numVerts; ++i)
   {
@@ -233,7 +257,8 @@ u16* IndexGenerator::AddLineStrip(u16* Iptr, u32 numVerts, u32 index)
 }
 
 // Points
-u16* IndexGenerator::AddPoints(u16* Iptr, u32 numVerts, u32 index)
+template <typename T>
+T* IndexGenerator::AddPoints(T* Iptr, u32 numVerts, u32 index)
 {
   for (u32 i = 0; i != numVerts; ++i)
   {
@@ -244,6 +269,7 @@ u16* IndexGenerator::AddPoints(u16* Iptr, u32 numVerts, u32 index)
 
 u32 IndexGenerator::GetRemainingIndices()
 {
-  u32 max_index = 65534;  // -1 is reserved for primitive restart (ogl + dx11)
+  // -1 is reserved for primitive restart (ogl + dx11)
+  u32 max_index = index_size == sizeof(u32) ? std::numeric_limits<u32>::max() - 1 : 65534;
   return max_index - base_index;
 }
@@ -9,12 +9,14 @@
 #include "Common/Event.h"
 #include "Common/Flag.h"
 #include "Common/Logging/Log.h"
+#include "Core/ConfigManager.h"
 #include "Core/Host.h"
 #include "VideoCommon/AsyncRequests.h"
 #include "VideoCommon/BPStructs.h"
 #include "VideoCommon/CPMemory.h"
 #include "VideoCommon/CommandProcessor.h"
 #include "VideoCommon/Fifo.h"
+#include "VideoCommon/FrameSkip.h"
 #include "VideoCommon/GeometryShaderManager.h"
 #include "VideoCommon/IndexGenerator.h"
 #include "VideoCommon/OnScreenDisplay.h"
@@ -22,7 +24,9 @@
 #include "VideoCommon/PixelEngine.h"
 #include "VideoCommon/PixelShaderManager.h"
 #include "VideoCommon/RenderBase.h"
+#include "VideoCommon/StageTimers.h"
 #include "VideoCommon/TextureCacheBase.h"
+#include "VideoCommon/TextureHashPrefetcher.h"
 #include "VideoCommon/VertexLoaderManager.h"
 #include "VideoCommon/VertexShaderManager.h"
 #include "VideoCommon/VideoBackendBase.h"
@@ -56,8 +60,6 @@ void VideoBackendBase::Video_BeginField(u32 xfbAddr, u32 fbWidth, u32 fbStride,
 {
   if (m_initialized && g_ActiveConfig.bUseXFB && g_renderer)
   {
-    Fifo::SyncGPU(Fifo::SyncGPUReason::Swap);
-
     AsyncRequests::Event e;
     e.time = ticks;
     e.type = AsyncRequests::Event::SWAP_EVENT;
@@ -111,10 +113,20 @@ u32 VideoBackendBase::Video_GetQueryResult(PerfQueryType type)
     return 0;
   }
 
-  Fifo::SyncGPU(Fifo::SyncGPUReason::PerfQuery);
-
   AsyncRequests::Event e;
   e.time = 0;
+
+  // Asynchronous results only wait for the GPU thread to collect the completed queries by the
+  // next read.
+  if (PerfQueryBase::IsAsynchronous() && g_perf_query->HasCompleteResults())
+  {
+    e.type = AsyncRequests::Event::PERF_QUERY_POLL;
+    AsyncRequests::GetInstance()->PushEvent(e, false);
+    return g_perf_query->GetQueryResult(type);
+  }
+
+  Fifo::SyncGPU(Fifo::SyncGPUReason::PerfQuery);
+
   e.type = AsyncRequests::Event::PERF_QUERY;
 
   if (!g_perf_query->IsFlushed())
@@ -146,8 +158,6 @@ u16 VideoBackendBase::Video_GetBoundingBox(int index)
     return 0;
   }
 
-  Fifo::SyncGPU(Fifo::SyncGPUReason::BBox);
-
   AsyncRequests::Event e;
   u16 result;
   e.time = 0;
@@ -186,11 +196,12 @@ void VideoBackendBase::InitializeShared()
 
   CommandProcessor::Init();
   Fifo::Init();
+  FrameSkip::Init();
+  TextureHashPrefetcher::Init();
   OpcodeDecoder::Init();
   PixelEngine::Init();
   BPInit();
   VertexLoaderManager::Init();
-  IndexGenerator::Init();
   VertexShaderManager::Init();
   GeometryShaderManager::Init();
   PixelShaderManager::Init();
@@ -198,6 +209,11 @@ void VideoBackendBase::InitializeShared()
   g_Config.Refresh();
   g_Config.UpdateProjectionHack();
   UpdateActiveConfig();
+
+  // Depends on the index size setting.
+  IndexGenerator::Init();
+
+  StageTimers::SetEnabled(g_ActiveConfig.bStageTimers);
 }
 
 void VideoBackendBase::ShutdownShared()
@@ -209,7 +225,14 @@ void VideoBackendBase::ShutdownShared()
 
   m_initialized = false;
 
+  TextureHashPrefetcher::Shutdown();
   Fifo::Shutdown();
+
+  if (StageTimers::IsEnabled())
+  {
+    NOTICE_LOG(VIDEO, "%s", StageTimers::GetReport().c_str());
+    StageTimers::SetEnabled(false);
+  }
 }
 
 void VideoBackendBase::CleanupShared()
@@ -229,6 +252,10 @@ void VideoBackendBase::DoState(PointerWrap& p)
     p.SetMode(PointerWrap::MODE_VERIFY);
   }
 
+  // In dual core mode, this was done by the GPU thread when emulation was paused.
+  if (!SConfig::GetInstance().bCPUThread && g_texture_cache)
+    g_texture_cache->FlushEFBCopies();
+
   VideoCommon_DoState(p);
   p.DoMarker("VideoCommon");
 
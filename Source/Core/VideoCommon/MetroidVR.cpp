@@ -2,11 +2,20 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <array>
 #include <cmath>
+#include <cstddef>
 #include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "Common/Common.h"
+#include "Common/IniFile.h"
+#include "Common/Logging/Log.h"
 #include "Common/MathUtil.h"
+#include "Common/StringUtil.h"
+#include "Core/ConfigManager.h"
 #include "VideoCommon/BPFunctions.h"
 #include "VideoCommon/MetroidVR.h"
 #include "VideoCommon/VR.h"
@@ -52,6 +61,91 @@ int Round100(float x)
   return (int)floor(x * 100 + 0.5f);
 }
 
+namespace
+{
+// projection number (or ANY_PROJECTION), then Round100 of hfov, vfov, znear and zfar
+using LayerRuleKey = std::array<int, 5>;
+constexpr int ANY_PROJECTION = -1;
+
+struct LayerRuleKeyHash
+{
+  size_t operator()(const LayerRuleKey& key) const
+  {
+    size_t hash = 0;
+    for (int value : key)
+      hash = hash * 31 + std::hash<int>()(value);
+    return hash;
+  }
+};
+}  // namespace
+
+static std::unordered_map<LayerRuleKey, TMetroidLayer, LayerRuleKeyHash> s_layer_rules;
+
+void LoadVRLayerRules()
+{
+  s_layer_rules.clear();
+
+  std::vector<std::string> lines;
+  SConfig::GetInstance().LoadGameIni().GetLines("VRLayers", &lines);
+  if (lines.empty())
+    return;
+
+  std::unordered_map<std::string, TMetroidLayer> layers_by_name;
+  for (int i = 0; i < METROID_LAYER_COUNT; ++i)
+  {
+    const TMetroidLayer layer = static_cast<TMetroidLayer>(i);
+    layers_by_name.emplace(MetroidLayerName(layer), layer);
+  }
+
+  for (const std::string& line : lines)
+  {
+    const size_t equals = line.find('=');
+    const std::vector<std::string> values = SplitString(line.substr(0, equals), ',');
+    auto layer = equals == std::string::npos ?
+                     layers_by_name.end() :
+                     layers_by_name.find(StripSpaces(line.substr(equals + 1)));
+    if (values.size() != 5 || layer == layers_by_name.end())
+    {
+      WARN_LOG(VR, "Ignoring invalid VR layer rule: %s", line.c_str());
+      continue;
+    }
+
+    LayerRuleKey key;
+    bool success = true;
+    const std::string projection = StripSpaces(values[0]);
+    if (projection == "*")
+      key[0] = ANY_PROJECTION;
+    else
+      success &= TryParse(projection, &key[0]);
+    for (size_t i = 1; i < values.size(); ++i)
+    {
+      float value;
+      success &= TryParse(StripSpaces(values[i]), &value);
+      key[i] = success ? Round100(value) : 0;
+    }
+
+    if (success)
+      s_layer_rules.emplace(key, layer->second);
+    else
+      WARN_LOG(VR, "Ignoring invalid VR layer rule: %s", line.c_str());
+  }
+}
+
+TMetroidLayer GetVRLayerFromRules(int layer, float hfov, float vfov, float znear, float zfar)
+{
+  if (s_layer_rules.empty())
+    return METROID_UNKNOWN;
+
+  LayerRuleKey key{{layer, Round100(hfov), Round100(vfov), Round100(znear), Round100(zfar)}};
+  auto rule = s_layer_rules.find(key);
+  if (rule == s_layer_rules.end())
+  {
+    key[0] = ANY_PROJECTION;
+    rule = s_layer_rules.find(key);
+  }
+  return rule == s_layer_rules.end() ? METROID_UNKNOWN : rule->second;
+}
+
 const char* MetroidLayerName(TMetroidLayer layer)
 {
   switch (layer)
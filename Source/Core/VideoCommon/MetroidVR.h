@@ -125,6 +125,12 @@ TMetroidLayer GetZeldaTPGCLayer2D(int layer, float left, float right, float top,
 TMetroidLayer GetZeldaTPGCLayer(int layer, float hfov, float vfov, float znear, float zfar);
 TMetroidLayer GetNESLayer2D(int layer, float left, float right, float top, float bottom,
                             float znear, float zfar);
+// Games without a hand-written classifier can list their layers in the [VRLayers] section of their
+// game INI, one perspective projection per line:
+//   <projection number or *>, <hfov>, <vfov>, <znear>, <zfar> = <layer name>
+// where the angles are in degrees and all values are compared to two decimals.
+void LoadVRLayerRules();
+TMetroidLayer GetVRLayerFromRules(int layer, float hfov, float vfov, float znear, float zfar);
 void GetMetroidPrimeValues(bool* bStuckToHead, bool* bFullscreenLayer, bool* bHide, bool* bFlashing,
                            float* fScaleHack, float* fWidthHack, float* fHeightHack, float* fUpHack,
                            float* fRightHack, int* iTelescope);
@@ -17,6 +17,7 @@
 #include "VideoCommon/OpcodeDecoding.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
+#include "Common/Logging/Trace.h"
 #include "Common/MsgHandler.h"
 #include "Core/ARBruteForcer.h"
 #include "Core/ConfigManager.h"
@@ -27,8 +28,11 @@
 #include "VideoCommon/CPMemory.h"
 #include "VideoCommon/CommandProcessor.h"
 #include "VideoCommon/DataReader.h"
+#include "VideoCommon/DisplayListCache.h"
 #include "VideoCommon/Fifo.h"
+#include "VideoCommon/FrameSkip.h"
 #include "VideoCommon/Statistics.h"
+#include "VideoCommon/StageTimers.h"
 #include "VideoCommon/VR.h"
 #include "VideoCommon/VertexLoaderManager.h"
 #include "VideoCommon/VideoCommon.h"
@@ -41,8 +45,50 @@ namespace OpcodeDecoder
 {
 static bool s_bFifoErrorSeen = false;
 
+// The commands the decoder tells apart. Looking them up by command byte makes the dispatch a
+// single dense jump table, with every draw command (0x80 - 0xBF) in one case.
+enum class Command : u8
+{
+  Unknown,
+  Nop,
+  UnknownReset,
+  LoadCPReg,
+  LoadXFReg,
+  LoadIndexedXF,
+  CallDL,
+  UnknownMetrics,
+  InvalidateVertexCache,
+  LoadBPReg,
+  Draw,
+};
+
+struct CommandTable
+{
+  constexpr CommandTable() : commands()
+  {
+    commands[GX_NOP] = Command::Nop;
+    commands[GX_UNKNOWN_RESET] = Command::UnknownReset;
+    commands[GX_LOAD_CP_REG] = Command::LoadCPReg;
+    commands[GX_LOAD_XF_REG] = Command::LoadXFReg;
+    commands[GX_LOAD_INDX_A] = Command::LoadIndexedXF;
+    commands[GX_LOAD_INDX_B] = Command::LoadIndexedXF;
+    commands[GX_LOAD_INDX_C] = Command::LoadIndexedXF;
+    commands[GX_LOAD_INDX_D] = Command::LoadIndexedXF;
+    commands[GX_CMD_CALL_DL] = Command::CallDL;
+    commands[GX_CMD_UNKNOWN_METRICS] = Command::UnknownMetrics;
+    commands[GX_CMD_INVL_VC] = Command::InvalidateVertexCache;
+    commands[GX_LOAD_BP_REG] = Command::LoadBPReg;
+    for (u32 cmd_byte = 0x80; cmd_byte < 0xC0; cmd_byte++)
+      commands[cmd_byte] = Command::Draw;
+  }
+
+  Command commands[256];
+};
+static constexpr CommandTable s_command_table;
+
 static u32 InterpretDisplayList(u32 address, u32 size)
 {
+  TRACE_SCOPE("OpcodeDecoder::InterpretDisplayList");
   u8* startAddress;
 
   if (Fifo::UseDeterministicGPUThread())
@@ -58,7 +104,9 @@ static u32 InterpretDisplayList(u32 address, u32 size)
     // temporarily swap dl and non-dl (small "hack" for the stats)
     Statistics::SwapDL();
 
+    DisplayListCache::BeginDisplayList(address, size, startAddress);
     Run(DataReader(startAddress, startAddress + size), &cycles, true, true);
+    DisplayListCache::EndDisplayList();
     INCSTAT(stats.thisFrame.numDListsCalled);
 
     // un-swap
@@ -96,14 +144,15 @@ void Shutdown()
   {
     g_opcode_replay_frame = false;
     g_opcode_replay_log_frame = false;
-    timewarp_logentries.clear();
-    timewarp_logentries.resize(0);
+    ClearTimewarpLog();
   }
 }
 
 template <bool is_preprocess>
 u8* Run(DataReader src, u32* cycles, bool in_display_list, bool recursive_call)
 {
+  StageTimers::Scope stage_scope(is_preprocess ? StageTimers::Stage::Count :
+                                                 StageTimers::Stage::CommandProcessing);
   u32 totalCycles = 0;
   u8* opcodeStart;
 
@@ -124,7 +173,7 @@ u8* Run(DataReader src, u32* cycles, bool in_display_list, bool recursive_call)
   if (g_opcode_replay_log_frame && !g_opcode_replay_frame && !recursive_call &&
       (skipped_opcode_replay_count >= (int)g_ActiveConfig.iExtraVideoLoopsDivider))
   {
-    timewarp_logentries.push_back(TimewarpLogEntry{src, is_preprocess});
+    AddTimewarpLogEntry(src, is_preprocess);
 
     if (in_display_list)
     {
@@ -158,19 +207,18 @@ u8* Run(DataReader src, u32* cycles, bool in_display_list, bool recursive_call)
       goto end;
 
     u8 cmd_byte = src.Read<u8>();
-    int refarray;
-    switch (cmd_byte)
+    switch (s_command_table.commands[cmd_byte])
     {
-    case GX_NOP:
+    case Command::Nop:
       totalCycles += 6;  // Hm, this means that we scan over nop streams pretty slowly...
       break;
 
-    case GX_UNKNOWN_RESET:
+    case Command::UnknownReset:
       totalCycles += 6;  // Datel software uses this command
       DEBUG_LOG(VIDEO, "GX Reset?: %08x", cmd_byte);
       break;
 
-    case GX_LOAD_CP_REG:
+    case Command::LoadCPReg:
     {
       if (src.size() < 1 + 4)
         goto end;
@@ -183,7 +231,7 @@ u8* Run(DataReader src, u32* cycles, bool in_display_list, bool recursive_call)
     }
     break;
 
-    case GX_LOAD_XF_REG:
+    case Command::LoadXFReg:
     {
       if (src.size() < 4)
         goto end;
@@ -203,19 +251,10 @@ u8* Run(DataReader src, u32* cycles, bool in_display_list, bool recursive_call)
     }
     break;
 
-    case GX_LOAD_INDX_A:  // used for position matrices
-      refarray = 0xC;
-      goto load_indx;
-    case GX_LOAD_INDX_B:  // used for normal matrices
-      refarray = 0xD;
-      goto load_indx;
-    case GX_LOAD_INDX_C:  // used for postmatrices
-      refarray = 0xE;
-      goto load_indx;
-    case GX_LOAD_INDX_D:  // used for lights
-      refarray = 0xF;
-      goto load_indx;
-    load_indx:
+    case Command::LoadIndexedXF:
+    {
+      // A, B, C and D are used for position matrices, normal matrices, postmatrices and lights.
+      const int refarray = 0xC + ((cmd_byte - GX_LOAD_INDX_A) >> 3);
       if (src.size() < 4)
         goto end;
       totalCycles += 6;
@@ -223,9 +262,10 @@ u8* Run(DataReader src, u32* cycles, bool in_display_list, bool recursive_call)
         PreprocessIndexedXF(src.Read<u32>(), refarray);
       else
         LoadIndexedXF(src.Read<u32>(), refarray);
-      break;
+    }
+    break;
 
-    case GX_CMD_CALL_DL:
+    case Command::CallDL:
     {
       if (src.size() < 8)
         goto end;
@@ -247,18 +287,18 @@ u8* Run(DataReader src, u32* cycles, bool in_display_list, bool recursive_call)
     }
     break;
 
-    case GX_CMD_UNKNOWN_METRICS:  // zelda 4 swords calls it and checks the metrics registers after
-                                  // that
+    case Command::UnknownMetrics:  // zelda 4 swords calls it and checks the metrics registers after
+                                   // that
       totalCycles += 6;
       DEBUG_LOG(VIDEO, "GX 0x44: %08x", cmd_byte);
       break;
 
-    case GX_CMD_INVL_VC:  // Invalidate Vertex Cache
+    case Command::InvalidateVertexCache:
       totalCycles += 6;
       DEBUG_LOG(VIDEO, "Invalidate (vertex cache?)");
       break;
 
-    case GX_LOAD_BP_REG:
+    case Command::LoadBPReg:
       // In skipped_frame case: We have to let BP writes through because they set
       // tokens and stuff.  TODO: Call a much simplified LoadBPReg instead.
       {
@@ -279,8 +319,8 @@ u8* Run(DataReader src, u32* cycles, bool in_display_list, bool recursive_call)
       break;
 
     // draw primitives
-    default:
-      if ((cmd_byte & 0xC0) == 0x80)
+    case Command::Draw:
+      while (true)
       {
         // load vertices
         if (src.size() < 2)
@@ -289,7 +329,7 @@ u8* Run(DataReader src, u32* cycles, bool in_display_list, bool recursive_call)
         int bytes = VertexLoaderManager::RunVertices(
             cmd_byte & GX_VAT_MASK,  // Vertex loader index (0 - 7)
             (cmd_byte & GX_PRIMITIVE_MASK) >> GX_PRIMITIVE_SHIFT, num_vertices, src,
-            Fifo::WillSkipCurrentFrame(), is_preprocess);
+            !is_preprocess && FrameSkip::ShouldSkipDraw(), is_preprocess);
 
         if (bytes < 0)
           goto end;
@@ -298,17 +338,26 @@ u8* Run(DataReader src, u32* cycles, bool in_display_list, bool recursive_call)
 
         // 4 GPU ticks per vertex, 3 CPU ticks per GPU tick
         totalCycles += num_vertices * 4 * 3 + 6;
+
+        // Runs of draws with the same primitive and vertex format are common, so they are decoded
+        // here without going through the dispatch again. The FIFO recorder needs every command
+        // on its own.
+        if (g_bRecordFifoData || !src.size() || src.Peek<u8>() != cmd_byte)
+          break;
+        opcodeStart = src.GetPointer();
+        src.Skip<u8>();
       }
-      else
-      {
-        if (!s_bFifoErrorSeen && !g_ActiveConfig.bOpcodeWarningDisable)
-          CommandProcessor::HandleUnknownOpcode(cmd_byte, opcodeStart, is_preprocess, g_opcode_replay_frame,
-                                                in_display_list, recursive_call);
-        ERROR_LOG(VIDEO, "FIFO: Unknown Opcode(0x%02x @ %p, preprocessing = %s)", cmd_byte,
-                  opcodeStart, is_preprocess ? "yes" : "no");
-        s_bFifoErrorSeen = true;
-        totalCycles += 1;
-      }
+      break;
+
+    default:
+      if (!s_bFifoErrorSeen && !g_ActiveConfig.bOpcodeWarningDisable)
+        CommandProcessor::HandleUnknownOpcode(cmd_byte, opcodeStart, is_preprocess,
+                                              g_opcode_replay_frame, in_display_list,
+                                              recursive_call);
+      ERROR_LOG(VIDEO, "FIFO: Unknown Opcode(0x%02x @ %p, preprocessing = %s)", cmd_byte,
+                opcodeStart, is_preprocess ? "yes" : "no");
+      s_bFifoErrorSeen = true;
+      totalCycles += 1;
       break;
     }
 
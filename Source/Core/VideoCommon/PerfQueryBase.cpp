@@ -3,6 +3,8 @@
 // Refer to the license.txt file included.
 
 #include "VideoCommon/PerfQueryBase.h"
+#include <algorithm>
+#include <iterator>
 #include <memory>
 #include "VideoCommon/VideoConfig.h"
 
@@ -12,3 +14,79 @@ bool PerfQueryBase::ShouldEmulate()
 {
   return g_ActiveConfig.bPerfQueriesEnable;
 }
+
+bool PerfQueryBase::IsAsynchronous()
+{
+  return g_ActiveConfig.bPerfQueriesAsync;
+}
+
+bool PerfQueryBase::AreCurrentResultsComplete() const
+{
+  return m_query_count == m_dropped_queries + m_previous_queries;
+}
+
+bool PerfQueryBase::HasCompleteResults() const
+{
+  return m_has_complete_results || AreCurrentResultsComplete();
+}
+
+bool PerfQueryBase::ResetResults()
+{
+  const bool keep_queries = IsAsynchronous() && m_query_count != 0;
+  if (!keep_queries)
+  {
+    if (m_query_count == 0)
+    {
+      std::copy(std::begin(m_results), std::end(m_results), std::begin(m_complete_results));
+      m_has_complete_results = true;
+    }
+    m_dropped_queries = 0;
+    m_previous_queries = 0;
+  }
+  else if (AreCurrentResultsComplete())
+  {
+    // The queries before the reset are all done, only older ones are pending.
+    std::copy(std::begin(m_results), std::end(m_results), std::begin(m_complete_results));
+    m_has_complete_results = true;
+    m_dropped_queries += m_previous_queries;
+    m_previous_queries = 0;
+  }
+  else
+  {
+    m_dropped_queries += m_previous_queries;
+    m_previous_queries = m_query_count - m_dropped_queries;
+    std::copy(std::begin(m_results), std::end(m_results), std::begin(m_previous_results));
+  }
+
+  std::fill(std::begin(m_results), std::end(m_results), 0);
+  return !keep_queries;
+}
+
+void PerfQueryBase::AddResult(PerfQueryGroup group, u32 result)
+{
+  if (m_dropped_queries != 0)
+  {
+    m_dropped_queries--;
+  }
+  else if (m_previous_queries != 0)
+  {
+    m_previous_results[group] += result;
+    if (--m_previous_queries == 0)
+    {
+      std::copy(std::begin(m_previous_results), std::end(m_previous_results),
+                std::begin(m_complete_results));
+      m_has_complete_results = true;
+    }
+  }
+  else
+  {
+    m_results[group] += result;
+  }
+}
+
+u32 PerfQueryBase::GetResult(PerfQueryGroup group) const
+{
+  if (IsAsynchronous() && !AreCurrentResultsComplete() && m_has_complete_results)
+    return m_complete_results[group];
+  return m_results[group];
+}
@@ -29,7 +29,7 @@ enum PerfQueryGroup
 class PerfQueryBase
 {
 public:
-  PerfQueryBase() : m_query_count(0) {}
+  PerfQueryBase() : m_query_count(0), m_results{} {}
   virtual ~PerfQueryBase() {}
   // Checks if performance queries are enabled in the gameini configuration.
   // NOTE: Called from CPU+GPU thread
@@ -50,10 +50,40 @@ public:
   // True if there are no further pending query results
   // NOTE: Called from CPU thread
   virtual bool IsFlushed() const { return true; }
+  // Collects the results of the queries which have completed, without waiting for the others.
+  virtual void PollResults() {}
+
+  // With bPerfQueriesAsync, the counters are reported from the last results which have all of
+  // their queries completed, which are a frame or two old, so that reading them doesn't wait for
+  // the GPU. Only the first read has to wait.
+  static bool IsAsynchronous();
+  // True if GetQueryResult can return complete results without flushing.
+  // NOTE: Called from CPU thread
+  bool HasCompleteResults() const;
+
 protected:
+  // For backends: resets the counters for a reset by the game. Returns false if the pending
+  // queries have to be kept, which then count for the results before the reset.
+  bool ResetResults();
+  // For backends: adds the result of the oldest pending query.
+  void AddResult(PerfQueryGroup group, u32 result);
+  // For backends: the counter to report.
+  u32 GetResult(PerfQueryGroup group) const;
+
   // TODO: sloppy
   volatile u32 m_query_count;
   volatile u32 m_results[PQG_NUM_MEMBERS];
+
+private:
+  bool AreCurrentResultsComplete() const;
+
+  // With asynchronous results, the oldest pending queries may be from before the last reset.
+  // Those from before the reset before that are dropped.
+  u32 m_dropped_queries = 0;
+  u32 m_previous_queries = 0;
+  u32 m_previous_results[PQG_NUM_MEMBERS] = {};
+  volatile u32 m_complete_results[PQG_NUM_MEMBERS] = {};
+  volatile bool m_has_complete_results = false;
 };
 
 extern std::unique_ptr<PerfQueryBase> g_perf_query;
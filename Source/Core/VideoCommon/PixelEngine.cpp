@@ -6,7 +6,7 @@
 
 #include "VideoCommon/PixelEngine.h"
 
-#include <mutex>
+#include <atomic>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
@@ -98,12 +98,15 @@ static UPEAlphaModeConfReg m_AlphaModeConf;
 static UPEAlphaReadReg m_AlphaRead;
 static UPECtrlReg m_Control;
 
-static std::mutex s_token_finish_mutex;
+// The GPU thread raises tokens and finishes through these, without a lock, as games can set
+// hundreds of tokens per frame. Until the CPU thread has picked them up, there is only one event
+// scheduled, and later tokens overwrite the pending one, as games only look at the last token.
+// The token is written before the flags, and read after them.
 static u16 s_token;
-static u16 s_token_pending;
-static bool s_token_interrupt_pending;
-static bool s_finish_interrupt_pending;
-static bool s_event_raised;
+static std::atomic<u16> s_token_pending;
+static std::atomic<bool> s_token_interrupt_pending;
+static std::atomic<bool> s_finish_interrupt_pending;
+static std::atomic<bool> s_event_raised;
 
 static bool s_signal_token_interrupt;
 static bool s_signal_finish_interrupt;
@@ -126,10 +129,18 @@ void DoState(PointerWrap& p)
   p.DoPOD(m_Control);
 
   p.Do(s_token);
-  p.Do(s_token_pending);
-  p.Do(s_token_interrupt_pending);
-  p.Do(s_finish_interrupt_pending);
-  p.Do(s_event_raised);
+  u16 token_pending = s_token_pending;
+  bool token_interrupt_pending = s_token_interrupt_pending;
+  bool finish_interrupt_pending = s_finish_interrupt_pending;
+  bool event_raised = s_event_raised;
+  p.Do(token_pending);
+  p.Do(token_interrupt_pending);
+  p.Do(finish_interrupt_pending);
+  p.Do(event_raised);
+  s_token_pending = token_pending;
+  s_token_interrupt_pending = token_interrupt_pending;
+  s_finish_interrupt_pending = finish_interrupt_pending;
+  s_event_raised = event_raised;
 
   p.Do(s_signal_token_interrupt);
   p.Do(s_signal_finish_interrupt);
@@ -254,38 +265,34 @@ static void UpdateInterrupts()
 
 static void SetTokenFinish_OnMainThread(u64 userdata, s64 cyclesLate)
 {
-  std::unique_lock<std::mutex> lk(s_token_finish_mutex);
-  s_event_raised = false;
+  // Cleared first, so that anything raised from now on schedules another event.
+  s_event_raised.store(false);
 
-  s_token = s_token_pending;
+  const bool token_interrupt = s_token_interrupt_pending.exchange(false);
+  const bool finish_interrupt = s_finish_interrupt_pending.exchange(false);
+  s_token = s_token_pending.load();
 
-  if (s_token_interrupt_pending)
+  if (token_interrupt)
   {
-    s_token_interrupt_pending = false;
     s_signal_token_interrupt = true;
     UpdateInterrupts();
   }
 
-  if (s_finish_interrupt_pending)
+  if (finish_interrupt)
   {
-    s_finish_interrupt_pending = false;
     s_signal_finish_interrupt = true;
     UpdateInterrupts();
-    lk.unlock();
     Core::FrameUpdateOnCPUThread();
   }
 }
 
-// Raise the event handler above on the CPU thread.
-// s_token_finish_mutex must be locked.
+// Raise the event handler above on the CPU thread, unless it already is.
 // THIS IS EXECUTED FROM VIDEO THREAD
 static void RaiseEvent()
 {
-  if (s_event_raised)
+  if (s_event_raised.exchange(true))
     return;
 
-  s_event_raised = true;
-
   CoreTiming::FromThread from = CoreTiming::FromThread::NON_CPU;
   if (!SConfig::GetInstance().bCPUThread || Fifo::UseDeterministicGPUThread())
     from = CoreTiming::FromThread::CPU;
@@ -298,10 +305,9 @@ void SetToken(const u16 token, const bool interrupt)
 {
   DEBUG_LOG(PIXELENGINE, "VIDEO Backend raises INT_CAUSE_PE_TOKEN (btw, token: %04x)", token);
 
-  std::lock_guard<std::mutex> lk(s_token_finish_mutex);
-
-  s_token_pending = token;
-  s_token_interrupt_pending |= interrupt;
+  s_token_pending.store(token);
+  if (interrupt)
+    s_token_interrupt_pending.store(true);
 
   RaiseEvent();
 }
@@ -312,9 +318,7 @@ void SetFinish()
 {
   DEBUG_LOG(PIXELENGINE, "VIDEO Set Finish");
 
-  std::lock_guard<std::mutex> lk(s_token_finish_mutex);
-
-  s_finish_interrupt_pending |= true;
+  s_finish_interrupt_pending.store(true);
 
   RaiseEvent();
 }
@@ -16,6 +16,7 @@
 #include "VideoCommon/DriverDetails.h"
 #include "VideoCommon/LightingShaderGen.h"
 #include "VideoCommon/NativeVertexFormat.h"
+#include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexLoaderManager.h"
 #include "VideoCommon/VideoCommon.h"
 #include "VideoCommon/VideoConfig.h"
@@ -324,12 +325,44 @@ PixelShaderUid GetPixelShaderUid()
 
 void ClearUnusedPixelShaderUidBits(APIType ApiType, PixelShaderUid* uid)
 {
+  static ShaderUidMergeCounter<PixelShaderUid> s_merge_counter;
+  const PixelShaderUid raw_uid = *uid;
   pixel_shader_uid_data* uid_data = uid->GetUidData<pixel_shader_uid_data>();
 
   // OpenGL and Vulkan convert implicitly normalized color outputs to their uint representation.
   // Therefore, it is not necessary to use a uint output on these backends.
   if (ApiType != APIType::D3D)
     uid_data->uint_output = 0;
+
+  // The projection and range settings are only read when fog is enabled.
+  if (uid_data->fog_fsel == 0)
+  {
+    uid_data->fog_proj = 0;
+    uid_data->fog_RangeBaseEnabled = 0;
+  }
+
+  // Same condition as skip_ztexture in GeneratePixelShaderCode.
+  if (!uid_data->per_pixel_depth && uid_data->fog_fsel == 0)
+    uid_data->ztex_op = ZTEXTURE_DISABLE;
+
+  // Where the depth test happens only matters for the depth we write, and for whether a failing
+  // alpha test still needs to be evaluated.
+  if (!uid_data->per_pixel_depth)
+  {
+    uid_data->early_ztest = 0;
+    if (uid_data->Pretest != AlphaTest::FAIL)
+      uid_data->late_ztest = 0;
+  }
+
+  // Stages only read their texture coordinate for texturing and indirect texturing.
+  for (unsigned int n = 0; n <= uid_data->genMode_numtevstages; n++)
+  {
+    auto& stage = uid_data->stagehash[n];
+    if (!stage.tevorders_enable && !stage.hasindstage)
+      stage.tevorders_texcoord = 0;
+  }
+
+  stats.numPixelShaderUidsMerged = s_merge_counter.Add(raw_uid, *uid);
 }
 
 void WritePixelShaderCommonHeader(ShaderCode& out, APIType ApiType, u32 num_texgens,
@@ -162,5 +162,6 @@ ShaderCode GeneratePixelShaderCode(APIType ApiType, const ShaderHostConfig& host
                                    const pixel_shader_uid_data* uid_data);
 void WritePixelShaderCommonHeader(ShaderCode& out, APIType ApiType, u32 num_texgens,
                                   bool per_pixel_lighting, bool bounding_box);
+// Zeroes the bits that don't affect the generated code, so equivalent UIDs share a shader.
 void ClearUnusedPixelShaderUidBits(APIType ApiType, PixelShaderUid* uid);
 PixelShaderUid GetPixelShaderUid();
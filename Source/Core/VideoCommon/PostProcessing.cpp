@@ -2,6 +2,7 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <sstream>
 #include <string>
 
@@ -11,6 +12,7 @@
 #include "Common/FileUtil.h"
 #include "Common/IniFile.h"
 #include "Common/Logging/Log.h"
+#include "Common/MathUtil.h"
 #include "Common/StringUtil.h"
 
 #include "VideoCommon/PostProcessing.h"
@@ -18,6 +20,9 @@
 
 static const char s_default_shader[] = "void main() { SetOutput(Sample()); }\n";
 
+// Smallest output scale of a pass, a sixteenth of the width and height of the output
+static constexpr float MIN_PASS_OUTPUT_SCALE = 1.0f / 16.0f;
+
 PostProcessingShaderImplementation::PostProcessingShaderImplementation()
 {
   m_timer.Start();
@@ -109,11 +114,14 @@ void PostProcessingShaderConfiguration::LoadOptions(const std::string& code)
   size_t configuration_end = code.find(config_end_delimiter);
 
   m_options.clear();
+  m_passes.clear();
+  m_intermediate_target_count = 0;
   m_any_options_dirty = true;
 
   if (configuration_start == std::string::npos || configuration_end == std::string::npos)
   {
     // Issue loading configuration or there isn't one.
+    m_passes.push_back({"main", 1.0f, {{RenderPass::INPUT_COLOR_BUFFER, 0}}, 0});
     return;
   }
 
@@ -176,6 +184,12 @@ void PostProcessingShaderConfiguration::LoadOptions(const std::string& code)
 
   for (const auto& it : option_strings)
   {
+    if (it.m_type == "Pass")
+    {
+      LoadPass(it.m_options);
+      continue;
+    }
+
     ConfigurationOption option;
     option.m_dirty = true;
 
@@ -247,6 +261,115 @@ void PostProcessingShaderConfiguration::LoadOptions(const std::string& code)
     }
     m_options[option.m_option_name] = option;
   }
+
+  if (m_passes.empty())
+    m_passes.push_back({"main", 1.0f, {{RenderPass::INPUT_COLOR_BUFFER, 0}}, 0});
+  AssignIntermediateTargets();
+}
+
+// Inputs are "ColorBuffer", "PreviousPass", or "PassN" for the output of the earlier pass N.
+static bool ParsePassInput(const std::string& value, u32 pass_index,
+                           PostProcessingShaderConfiguration::RenderPass::Input* input)
+{
+  using RenderPass = PostProcessingShaderConfiguration::RenderPass;
+  if (value == "ColorBuffer" || (value == "PreviousPass" && pass_index == 0))
+  {
+    *input = {RenderPass::INPUT_COLOR_BUFFER, 0};
+    return true;
+  }
+  if (value == "PreviousPass")
+  {
+    *input = {RenderPass::INPUT_PASS_OUTPUT, pass_index - 1};
+    return true;
+  }
+
+  u32 source_pass;
+  if (value.compare(0, 4, "Pass") != 0 || !TryParse(value.substr(4), &source_pass) ||
+      source_pass >= pass_index)
+  {
+    return false;
+  }
+  *input = {RenderPass::INPUT_PASS_OUTPUT, source_pass};
+  return true;
+}
+
+void PostProcessingShaderConfiguration::LoadPass(
+    const std::vector<std::pair<std::string, std::string>>& keys)
+{
+  const u32 index = static_cast<u32>(m_passes.size());
+  RenderPass::Input previous_pass;
+  ParsePassInput("PreviousPass", index, &previous_pass);
+
+  RenderPass pass = {"main", 1.0f, {}, 0};
+  for (const auto& key : keys)
+  {
+    if (key.first == "EntryPoint")
+    {
+      pass.m_entry_point = key.second;
+    }
+    else if (key.first == "OutputScale")
+    {
+      TryParse(key.second, &pass.m_output_scale);
+      pass.m_output_scale = MathUtil::Clamp(pass.m_output_scale, MIN_PASS_OUTPUT_SCALE, 1.0f);
+    }
+    else if (key.first.compare(0, 5, "Input") == 0)
+    {
+      u32 input_index;
+      RenderPass::Input input;
+      if (!TryParse(key.first.substr(5), &input_index) || input_index >= MAX_PASS_INPUTS ||
+          !ParsePassInput(key.second, index, &input))
+      {
+        ERROR_LOG(VIDEO, "Invalid %s of pass %u in post-processing shader %s", key.first.c_str(),
+                  index, m_current_shader.c_str());
+        continue;
+      }
+
+      // Inputs which aren't given read the previous pass.
+      if (pass.m_inputs.size() <= input_index)
+        pass.m_inputs.resize(input_index + 1, previous_pass);
+      pass.m_inputs[input_index] = input;
+    }
+  }
+
+  if (pass.m_inputs.empty())
+    pass.m_inputs.push_back(previous_pass);
+  m_passes.push_back(std::move(pass));
+}
+
+void PostProcessingShaderConfiguration::AssignIntermediateTargets()
+{
+  // The last pass reading the output of each pass
+  std::vector<size_t> last_reader(m_passes.size());
+  for (size_t i = 0; i < m_passes.size(); i++)
+  {
+    last_reader[i] = i;
+    for (const RenderPass::Input& input : m_passes[i].m_inputs)
+    {
+      if (input.m_type == RenderPass::INPUT_PASS_OUTPUT)
+        last_reader[input.m_pass_index] = i;
+    }
+  }
+
+  struct Target
+  {
+    float scale;
+    // The target can be written again by the passes after this one.
+    size_t last_reader;
+  };
+  std::vector<Target> targets;
+  for (size_t i = 0; i + 1 < m_passes.size(); i++)
+  {
+    RenderPass& pass = m_passes[i];
+    auto iter = std::find_if(targets.begin(), targets.end(), [&pass, i](const Target& target) {
+      return target.scale == pass.m_output_scale && target.last_reader < i;
+    });
+    if (iter == targets.end())
+      iter = targets.insert(targets.end(), {pass.m_output_scale, 0});
+
+    iter->last_reader = last_reader[i];
+    pass.m_output_target = static_cast<u32>(iter - targets.begin());
+  }
+  m_intermediate_target_count = static_cast<u32>(targets.size());
 }
 
 void PostProcessingShaderConfiguration::LoadOptionsConfiguration()
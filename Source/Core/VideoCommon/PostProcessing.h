@@ -48,6 +48,36 @@ public:
 
   typedef std::map<std::string, ConfigurationOption> ConfigMap;
 
+  // A pass of the shader, declared with a [Pass] section in the configuration. Shaders without
+  // any are a single pass running main() on the color buffer.
+  struct RenderPass
+  {
+    enum InputType
+    {
+      INPUT_COLOR_BUFFER = 0,
+      INPUT_PASS_OUTPUT,
+    };
+
+    struct Input
+    {
+      InputType m_type;
+      // Index of an earlier pass, for INPUT_PASS_OUTPUT
+      u32 m_pass_index;
+    };
+
+    // Function of the shader code run by the pass
+    std::string m_entry_point;
+    // Size of the output relative to the final output. The last pass always renders to the
+    // final output.
+    float m_output_scale;
+    std::vector<Input> m_inputs;
+    // Intermediate texture the output goes to. Passes whose outputs have the same scale share
+    // the texture once nothing reads from it anymore.
+    u32 m_output_target;
+  };
+
+  static constexpr u32 MAX_PASS_INPUTS = 4;
+
   PostProcessingShaderConfiguration() : m_current_shader("") {}
   virtual ~PostProcessingShaderConfiguration() {}
   // Loads the configuration with a shader
@@ -63,6 +93,11 @@ public:
   const ConfigMap& GetOptions() const { return m_options; }
   ConfigMap& GetOptions() { return m_options; }
   const ConfigurationOption& GetOption(const std::string& option) { return m_options[option]; }
+  const std::vector<RenderPass>& GetPasses() const { return m_passes; }
+  u32 GetIntermediateTargetCount() const { return m_intermediate_target_count; }
+  bool IsMultiPass() const { return m_passes.size() > 1; }
+  // Parses the options and passes from the configuration block of the shader code
+  void LoadOptions(const std::string& code);
   // For updating option's values
   void SetOptionf(const std::string& option, int index, float value);
   void SetOptioni(const std::string& option, int index, s32 value);
@@ -72,8 +107,11 @@ private:
   bool m_any_options_dirty;
   std::string m_current_shader;
   ConfigMap m_options;
+  std::vector<RenderPass> m_passes;
+  u32 m_intermediate_target_count = 0;
 
-  void LoadOptions(const std::string& code);
+  void LoadPass(const std::vector<std::pair<std::string, std::string>>& keys);
+  void AssignIntermediateTargets();
   void LoadOptionsConfiguration();
 };
 
@@ -19,12 +19,15 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include <array>
 #include <cinttypes>
 #include <cmath>
+#include <cstring>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <tuple>
+#include <utility>
 
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
@@ -33,6 +36,8 @@
 #include "Common/FileUtil.h"
 #include "Common/Flag.h"
 #include "Common/Logging/Log.h"
+#include "Common/Logging/Trace.h"
+#include "Common/Metrics.h"
 #include "Common/MsgHandler.h"
 #include "Common/Profiler.h"
 #include "Common/StringUtil.h"
@@ -56,13 +61,18 @@
 #include "VideoCommon/CPMemory.h"
 #include "VideoCommon/CommandProcessor.h"
 #include "VideoCommon/Debugger.h"
+#include "VideoCommon/DisplayListCache.h"
+#include "VideoCommon/DynamicResolution.h"
 #include "VideoCommon/FPSCounter.h"
+#include "VideoCommon/FrameProfiler.h"
+#include "VideoCommon/FrameSkip.h"
 #include "VideoCommon/FramebufferManagerBase.h"
 #include "VideoCommon/ImageWrite.h"
 #include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/PixelShaderManager.h"
 #include "VideoCommon/PostProcessing.h"
 #include "VideoCommon/ShaderGenCommon.h"
+#include "VideoCommon/StageTimers.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/TextureCacheBase.h"
 #include "VideoCommon/TextureDecoder.h"
@@ -80,6 +90,10 @@ static int OSDTime;
 
 std::unique_ptr<Renderer> g_renderer;
 
+static Metrics::Counter s_frames("dolphin_video_frames_total", "Frames the game rendered.");
+static Metrics::Counter s_draw_calls("dolphin_video_draw_calls_total",
+                                     "Draw calls made by the video backend.");
+
 // The maximum depth that is written to the depth buffer should never exceed this value.
 // This is necessary because we use a 2^24 divisor for all our depth values to prevent
 // floating-point round-trip errors. However the console GPU doesn't ever write a value
@@ -111,8 +125,28 @@ Renderer::Renderer(int backbuffer_width, int backbuffer_height)
   m_last_host_config_bits = ShaderHostConfig::GetCurrent().bits;
 }
 
+// Profiling follows the overlay setting. The recording is saved once it is turned off again, or
+// when emulation stops.
+static void UpdateFrameProfiler(bool enabled)
+{
+  if (enabled == FrameProfiler::IsEnabled())
+    return;
+
+  FrameProfiler::SetEnabled(enabled);
+  if (enabled)
+    return;
+
+  const std::string path = File::GetUserPath(D_DUMP_IDX) + "FrameProfile_" +
+                           SConfig::GetInstance().GetGameID() + ".json";
+  if (File::CreateFullPath(path) && FrameProfiler::WriteChromeTrace(path))
+    OSD::AddMessage("Frame profile saved to " + path);
+  else
+    ERROR_LOG(VIDEO, "Failed to save frame profile to %s", path.c_str());
+}
+
 Renderer::~Renderer()
 {
+  UpdateFrameProfiler(false);
   ShutdownFrameDumping();
   if (m_frame_dump_thread.joinable())
     m_frame_dump_thread.join();
@@ -152,7 +186,8 @@ int Renderer::EFBToScaledX(int x) const
   switch (g_ActiveConfig.iEFBScale)
   {
   case SCALE_AUTO:  // fractional
-    return FramebufferManagerBase::ScaleToVirtualXfbWidth(x, m_target_rectangle);
+    return FramebufferManagerBase::ScaleToVirtualXfbWidth(x, m_target_rectangle) *
+           m_dynamic_resolution_steps / DynamicResolution::SCALE_STEPS;
 
   default:
     return x * (int)m_efb_scale_numeratorX / (int)m_efb_scale_denominatorX;
@@ -164,7 +199,8 @@ int Renderer::EFBToScaledY(int y) const
   switch (g_ActiveConfig.iEFBScale)
   {
   case SCALE_AUTO:  // fractional
-    return FramebufferManagerBase::ScaleToVirtualXfbHeight(y, m_target_rectangle);
+    return FramebufferManagerBase::ScaleToVirtualXfbHeight(y, m_target_rectangle) *
+           m_dynamic_resolution_steps / DynamicResolution::SCALE_STEPS;
 
   default:
     return y * (int)m_efb_scale_numeratorY / (int)m_efb_scale_denominatorY;
@@ -275,6 +311,21 @@ bool Renderer::CalculateTargetSize()
   if (m_last_efb_scale > SCALE_AUTO_INTEGRAL)
     std::tie(new_efb_width, new_efb_height) = CalculateTargetScale(EFB_WIDTH, EFB_HEIGHT);
 
+  // The dynamic resolution scales whatever the internal resolution setting gave.
+  if (!g_ActiveConfig.bDynamicResolution)
+    m_dynamic_resolution.Reset();
+  m_dynamic_resolution_steps = m_dynamic_resolution.GetScaleSteps();
+  if (m_dynamic_resolution_steps != DynamicResolution::SCALE_STEPS)
+  {
+    const int steps = m_dynamic_resolution_steps;
+    new_efb_width = std::max(new_efb_width * steps / DynamicResolution::SCALE_STEPS, 1);
+    new_efb_height = std::max(new_efb_height * steps / DynamicResolution::SCALE_STEPS, 1);
+    m_efb_scale_numeratorX *= steps;
+    m_efb_scale_numeratorY *= steps;
+    m_efb_scale_denominatorX *= DynamicResolution::SCALE_STEPS;
+    m_efb_scale_denominatorY *= DynamicResolution::SCALE_STEPS;
+  }
+
   if (new_efb_width != m_target_width || new_efb_height != m_target_height)
   {
     m_target_width = new_efb_width;
@@ -330,6 +381,55 @@ Renderer::ConvertStereoRectangle(const TargetRectangle& rc) const
   return std::make_tuple(left_rc, right_rc);
 }
 
+void Renderer::SetGPUFrameTimingEnabled(bool enabled)
+{
+  m_gpu_frame_timing_enabled.Set(enabled);
+  if (!enabled)
+  {
+    std::lock_guard<std::mutex> lk(m_gpu_frame_times_lock);
+    m_gpu_frame_times.clear();
+  }
+}
+
+std::vector<double> Renderer::TakeGPUFrameTimes()
+{
+  std::lock_guard<std::mutex> lk(m_gpu_frame_times_lock);
+  std::vector<double> times;
+  times.swap(m_gpu_frame_times);
+  return times;
+}
+
+bool Renderer::IsMeasuringGPUFrameTime() const
+{
+  return IsGPUFrameTimingEnabled() || g_ActiveConfig.bDynamicResolution;
+}
+
+bool Renderer::HasDynamicResolutionChanged() const
+{
+  return g_ActiveConfig.bDynamicResolution ?
+             m_dynamic_resolution.GetScaleSteps() != m_dynamic_resolution_steps :
+             m_dynamic_resolution_steps != DynamicResolution::SCALE_STEPS;
+}
+
+void Renderer::AddGPUFrameTime(double milliseconds)
+{
+  if (g_ActiveConfig.bDynamicResolution)
+  {
+    const u32 refresh_rate =
+        g_has_hmd ? static_cast<u32>(g_hmd_refresh_rate) : VideoInterface::GetTargetRefreshRate();
+    const double budget = 1000.0 / std::max(refresh_rate, 1u);
+    m_dynamic_resolution.AddFrameTime(milliseconds, budget,
+                                      g_ActiveConfig.fDynamicResolutionMin,
+                                      g_ActiveConfig.fDynamicResolutionMax);
+  }
+
+  if (!IsGPUFrameTimingEnabled())
+    return;
+
+  std::lock_guard<std::mutex> lk(m_gpu_frame_times_lock);
+  m_gpu_frame_times.push_back(milliseconds);
+}
+
 void Renderer::SaveScreenshot(const std::string& filename, bool wait_for_completion)
 {
   // We must not hold the lock while waiting for the screenshot to complete.
@@ -346,6 +446,48 @@ void Renderer::SaveScreenshot(const std::string& filename, bool wait_for_complet
   }
 }
 
+void Renderer::RequestFrameHash(std::function<void(u64)> callback)
+{
+  std::lock_guard<std::mutex> lk(m_screenshot_lock);
+  m_frame_hash_callback = std::move(callback);
+  m_frame_hash_request.Set();
+}
+
+// A difference hash: the frame is averaged down to 9x8 cells of luminance, and each bit tells
+// whether a cell is brighter than the next one in its row.
+static u64 ComputeFrameHash(const u8* data, int width, int height, int stride)
+{
+  constexpr int GRID_WIDTH = 9;
+  constexpr int GRID_HEIGHT = 8;
+  std::array<double, GRID_WIDTH * GRID_HEIGHT> luma{};
+  std::array<int, GRID_WIDTH * GRID_HEIGHT> pixels{};
+
+  for (int y = 0; y < height; ++y)
+  {
+    const u8* row = data + static_cast<ptrdiff_t>(y) * stride;
+    const int cell_row = y * GRID_HEIGHT / height * GRID_WIDTH;
+    for (int x = 0; x < width; ++x)
+    {
+      const int cell = cell_row + x * GRID_WIDTH / width;
+      luma[cell] += row[x * 4] * 0.299 + row[x * 4 + 1] * 0.587 + row[x * 4 + 2] * 0.114;
+      pixels[cell]++;
+    }
+  }
+
+  u64 hash = 0;
+  for (int y = 0; y < GRID_HEIGHT; ++y)
+  {
+    for (int x = 0; x < GRID_WIDTH - 1; ++x)
+    {
+      const int cell = y * GRID_WIDTH + x;
+      const double left = pixels[cell] ? luma[cell] / pixels[cell] : 0.0;
+      const double right = pixels[cell + 1] ? luma[cell + 1] / pixels[cell + 1] : 0.0;
+      hash = (hash << 1) | (left > right ? 1 : 0);
+    }
+  }
+  return hash;
+}
+
 bool Renderer::CheckForHostConfigChanges()
 {
   ShaderHostConfig new_host_config = ShaderHostConfig::GetCurrent();
@@ -370,12 +512,19 @@ void Renderer::DrawDebugText()
       {
         float speed = m_fps_counter.GetFPS() / 3.0f;
         int count = (int)ARBruteForcer::ch_map.size();
-        int remaining = (int)((count - ARBruteForcer::ch_current_position) / speed);
+        int remaining = (int)((count - ARBruteForcer::ch_current_position) /
+                              ARBruteForcer::ch_slice_count / speed);
         final_cyan += StringFromFormat("%0.0f/s, ETA: %d:%ds, %5.3f%%  %d/%d", speed, remaining / 60, remaining % 60, ARBruteForcer::ch_current_position * 100.0f / count, ARBruteForcer::ch_current_position, count);
       }
       else
       {
         final_cyan += StringFromFormat("FPS: %.2f", m_fps_counter.GetFPS());
+        if (g_ActiveConfig.iFramePacing != FRAME_PACING_OFF)
+        {
+          final_cyan += StringFromFormat(" - Present: %.2f ms, jitter %.2f ms",
+                                         m_frame_pacer.GetPresentInterval(),
+                                         m_frame_pacer.GetPresentJitter());
+        }
       }
     }
 
@@ -445,6 +594,11 @@ void Renderer::DrawDebugText()
       res_text = StringFromFormat("%dx", g_ActiveConfig.iEFBScale - 3);
       break;
     }
+    if (g_ActiveConfig.bDynamicResolution)
+    {
+      res_text += StringFromFormat(" (dynamic, %d%%)", m_dynamic_resolution_steps * 100 /
+                                                           DynamicResolution::SCALE_STEPS);
+    }
     const char* ar_text = "";
     switch (g_ActiveConfig.iAspectRatio)
     {
@@ -508,6 +662,12 @@ void Renderer::DrawDebugText()
   if (g_ActiveConfig.bOverlayProjStats)
     final_cyan += Statistics::ToStringProj();
 
+  if (g_ActiveConfig.bOverlayFrameProfile)
+    final_cyan += FrameProfiler::GetOverlayText();
+
+  if (g_ActiveConfig.bOverlayMetrics)
+    final_cyan += Metrics::FormatText();
+
   // and then the text
   RenderText(final_cyan, 20, 20, 0xFF00FFFF);
   RenderText(final_yellow, 20, 20, 0xFFFFFF00);
@@ -789,14 +949,30 @@ void Renderer::Swap(u32 xfbAddr, u32 fbWidth, u32 fbStride, u32 fbHeight, const
   VRCalculateIRPointer();
 
   // TODO: merge more generic parts into VideoCommon
-  SwapImpl(xfbAddr, fbWidth, fbStride, fbHeight, rc, ticks, Gamma);
+  {
+    TRACE_SCOPE("Renderer::Swap");
+    StageTimers::Scope stage_scope(StageTimers::Stage::Presentation);
+    SwapImpl(xfbAddr, fbWidth, fbStride, fbHeight, rc, ticks, Gamma);
+  }
+  DisplayListCache::Cleanup();
+  FrameSkip::EndFrame();
+
+  TRACE_INSTANT("Frame");
+  FrameProfiler::EndFrame();
+  UpdateFrameProfiler(g_ActiveConfig.bOverlayFrameProfile);
 
   if (m_xfb_written && !g_opcode_replay_frame)
+  {
     m_fps_counter.Update();
+    s_frames.Increment();
+  }
 
   frameCount++;
   GFX_DEBUGGER_PAUSE_AT(NEXT_FRAME, true);
 
+  s_draw_calls.Increment(stats.thisFrame.numDrawCalls);
+  Metrics::SampleFrame();
+
   // Begin new frame
   // Set default viewport and scissor, for the clear to work correctly
   // New frame
@@ -810,7 +986,7 @@ void Renderer::Swap(u32 xfbAddr, u32 fbWidth, u32 fbStride, u32 fbHeight, const
 
 bool Renderer::IsFrameDumping()
 {
-  if (m_screenshot_request.IsSet())
+  if (m_screenshot_request.IsSet() || m_frame_hash_request.IsSet())
     return true;
 
   if (SConfig::GetInstance().m_DumpFrames)
@@ -826,17 +1002,16 @@ void Renderer::ShutdownFrameDumping()
     return;
 
   FinishFrameData();
-  m_frame_dump_thread_running.Clear();
-  m_frame_dump_start.Set();
+  {
+    std::lock_guard<std::mutex> lk(m_frame_dump_lock);
+    m_frame_dump_thread_running.Clear();
+  }
+  m_frame_dump_cv.notify_all();
 }
 
 void Renderer::DumpFrameData(const u8* data, int w, int h, int stride, const AVIDump::Frame& state,
                              bool swap_upside_down)
 {
-  FinishFrameData();
-
-  m_frame_dump_config = FrameDumpConfig{data, w, h, stride, swap_upside_down, state};
-
   if (!m_frame_dump_thread_running.IsSet())
   {
     if (m_frame_dump_thread.joinable())
@@ -845,17 +1020,48 @@ void Renderer::DumpFrameData(const u8* data, int w, int h, int stride, const AVI
     m_frame_dump_thread = std::thread(&Renderer::RunFrameDumps, this);
   }
 
-  m_frame_dump_start.Set();
-  m_frame_dump_frame_running = true;
+  // The queue is in order, so once fewer frames than buffers are pending, the next buffer is free.
+  {
+    std::unique_lock<std::mutex> lk(m_frame_dump_lock);
+    m_frame_dump_cv.wait(lk, [this] { return m_frame_dump_pending < FRAME_DUMP_BUFFERS; });
+  }
+
+  std::vector<u8>& buffer = m_frame_dump_buffers[m_frame_dump_next_buffer];
+  m_frame_dump_next_buffer = (m_frame_dump_next_buffer + 1) % FRAME_DUMP_BUFFERS;
+  const size_t row_size = static_cast<size_t>(w) * 4;
+  buffer.resize(row_size * h);
+  for (int y = 0; y < h; y++)
+  {
+    const int src_y = swap_upside_down ? h - 1 - y : y;
+    std::memcpy(&buffer[y * row_size], data + static_cast<ptrdiff_t>(src_y) * stride, row_size);
+  }
+
+  FrameDumpConfig config{buffer.data(), w, h, static_cast<int>(row_size), state};
+  if (m_screenshot_request.TestAndClear())
+  {
+    std::lock_guard<std::mutex> lk(m_screenshot_lock);
+    config.screenshot_name = std::move(m_screenshot_name);
+    m_screenshot_name.clear();
+  }
+  if (m_frame_hash_request.TestAndClear())
+  {
+    std::lock_guard<std::mutex> lk(m_screenshot_lock);
+    config.hash_callback = std::move(m_frame_hash_callback);
+    m_frame_hash_callback = nullptr;
+  }
+
+  {
+    std::lock_guard<std::mutex> lk(m_frame_dump_lock);
+    m_frame_dump_queue.push_back(std::move(config));
+    m_frame_dump_pending++;
+  }
+  m_frame_dump_cv.notify_all();
 }
 
 void Renderer::FinishFrameData()
 {
-  if (!m_frame_dump_frame_running)
-    return;
-
-  m_frame_dump_done.Wait();
-  m_frame_dump_frame_running = false;
+  std::unique_lock<std::mutex> lk(m_frame_dump_lock);
+  m_frame_dump_cv.wait(lk, [this] { return m_frame_dump_pending == 0; });
 }
 
 void Renderer::RunFrameDumps()
@@ -876,32 +1082,35 @@ void Renderer::RunFrameDumps()
 
   while (true)
   {
-    m_frame_dump_start.Wait();
-    if (!m_frame_dump_thread_running.IsSet())
-      break;
-
-    auto config = m_frame_dump_config;
-
-    if (config.upside_down)
+    FrameDumpConfig config;
     {
-      config.data = config.data + (config.height - 1) * config.stride;
-      config.stride = -config.stride;
+      std::unique_lock<std::mutex> lk(m_frame_dump_lock);
+      m_frame_dump_cv.wait(lk, [this] {
+        return !m_frame_dump_queue.empty() || !m_frame_dump_thread_running.IsSet();
+      });
+      if (m_frame_dump_queue.empty())
+        break;
+
+      config = std::move(m_frame_dump_queue.front());
+      m_frame_dump_queue.pop_front();
     }
 
     // Save screenshot
-    if (m_screenshot_request.TestAndClear())
+    if (!config.screenshot_name.empty())
     {
-      std::lock_guard<std::mutex> lk(m_screenshot_lock);
-
-      if (TextureToPng(config.data, config.stride, m_screenshot_name, config.width, config.height,
-                       false))
-        OSD::AddMessage("Screenshot saved to " + m_screenshot_name);
+      if (TextureToPng(config.data, config.stride, config.screenshot_name, config.width,
+                       config.height, false))
+        OSD::AddMessage("Screenshot saved to " + config.screenshot_name);
 
-      // Reset settings
-      m_screenshot_name.clear();
       m_screenshot_completed.Set();
     }
 
+    if (config.hash_callback)
+    {
+      config.hash_callback(
+          ComputeFrameHash(config.data, config.width, config.height, config.stride));
+    }
+
     if (SConfig::GetInstance().m_DumpFrames)
     {
       if (!frame_dump_started)
@@ -926,7 +1135,11 @@ void Renderer::RunFrameDumps()
       }
     }
 
-    m_frame_dump_done.Set();
+    {
+      std::lock_guard<std::mutex> lk(m_frame_dump_lock);
+      m_frame_dump_pending--;
+    }
+    m_frame_dump_cv.notify_all();
   }
 
   if (frame_dump_started)
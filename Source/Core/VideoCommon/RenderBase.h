@@ -14,7 +14,11 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <condition_variable>
+#include <deque>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -28,7 +32,9 @@
 #include "Common/MathUtil.h"
 #include "VideoCommon/AVIDump.h"
 #include "VideoCommon/BPMemory.h"
+#include "VideoCommon/DynamicResolution.h"
 #include "VideoCommon/FPSCounter.h"
+#include "VideoCommon/FramePacer.h"
 #include "VideoCommon/RenderState.h"
 #include "VideoCommon/VideoCommon.h"
 
@@ -114,6 +120,22 @@ public:
 
   // Random utilities
   void SaveScreenshot(const std::string& filename, bool wait_for_completion);
+  // Passes a perceptual hash of the next frame to the callback, from the frame dumping thread.
+  // Similar frames get hashes differing in few bits. Much cheaper than saving a screenshot.
+  void RequestFrameHash(std::function<void(u64)> callback);
+
+  // GPU frame timing, used for benchmarking. While enabled, backends which support timestamp
+  // queries measure how long the GPU spent on each frame. Results arrive a few frames late, as
+  // they are only read back once the GPU is done with them.
+  void SetGPUFrameTimingEnabled(bool enabled);
+  bool IsGPUFrameTimingEnabled() const { return m_gpu_frame_timing_enabled.IsSet(); }
+  // Returns the GPU times (in milliseconds) of the frames completed since the last call.
+  std::vector<double> TakeGPUFrameTimes();
+  // True when the backend should time frames on the GPU, either for the timing above or for
+  // the dynamic resolution, which is fed from AddGPUFrameTime.
+  bool IsMeasuringGPUFrameTime() const;
+  // True when the dynamic resolution wants a new target size, which CalculateTargetSize applies.
+  bool HasDynamicResolutionChanged() const;
   void DrawDebugText();
 
   virtual void RenderText(const std::string& text, int left, int top, u32 color) = 0;
@@ -145,6 +167,9 @@ public:
   // Final surface changing
   // This is called when the surface is resized (WX) or the window changes (Android).
   virtual void ChangeSurface(void* new_surface_handle) {}
+  // Called by the UI thread when the window of the surface has been resized. It doesn't wait for
+  // the GPU thread, which picks the new size up when it next presents.
+  void ResizeSurface() { m_surface_resized.Set(); }
   bool UseVertexDepthRange() const;
 
 protected:
@@ -161,10 +186,14 @@ protected:
                      bool swap_upside_down = false);
   void FinishFrameData();
 
+  void AddGPUFrameTime(double milliseconds);
+
   Common::Flag m_screenshot_request;
   Common::Event m_screenshot_completed;
   std::mutex m_screenshot_lock;
   std::string m_screenshot_name;
+  Common::Flag m_frame_hash_request;
+  std::function<void(u64)> m_frame_hash_callback;
 public:
   bool m_aspect_wide = false;
 
@@ -181,6 +210,7 @@ protected:
   bool m_xfb_written = false;
 
   FPSCounter m_fps_counter;
+  FramePacer m_frame_pacer;
 
 public:
   std::unique_ptr<PostProcessingShaderImplementation> m_post_processor;
@@ -189,8 +219,9 @@ protected:
   static const float GX_MAX_DEPTH;
 
   Common::Flag m_surface_needs_change;
+  Common::Flag m_surface_resized;
   Common::Event m_surface_changed;
-  void* m_new_surface_handle = nullptr;
+  std::atomic<void*> m_new_surface_handle{nullptr};
 
   u32 m_last_host_config_bits = 0;
 
@@ -198,6 +229,14 @@ private:
   void RunFrameDumps();
   void ShutdownFrameDumping();
 
+  Common::Flag m_gpu_frame_timing_enabled;
+  std::mutex m_gpu_frame_times_lock;
+  std::vector<double> m_gpu_frame_times;
+
+  DynamicResolution m_dynamic_resolution;
+  // The scale steps the current target size was calculated with
+  int m_dynamic_resolution_steps = DynamicResolution::SCALE_STEPS;
+
   PEControl::PixelFormat m_prev_efb_format = PEControl::INVALID_FMT;
   unsigned int m_efb_scale_numeratorX = 1;
   unsigned int m_efb_scale_numeratorY = 1;
@@ -210,20 +249,30 @@ private:
 
   // frame dumping
   std::thread m_frame_dump_thread;
-  Common::Event m_frame_dump_start;
-  Common::Event m_frame_dump_done;
   Common::Flag m_frame_dump_thread_running;
   u32 m_frame_dump_image_counter = 0;
-  bool m_frame_dump_frame_running = false;
   struct FrameDumpConfig
   {
     const u8* data;
     int width;
     int height;
     int stride;
-    bool upside_down;
     AVIDump::Frame state;
-  } m_frame_dump_config;
+    // The requests which were pending when the frame was queued
+    std::string screenshot_name;
+    std::function<void(u64)> hash_callback;
+  };
+
+  // Frames are copied to one of these buffers, so that the backends can reuse their readback
+  // memory right away, and the GPU thread only waits for the encoder when all of them are queued.
+  static constexpr size_t FRAME_DUMP_BUFFERS = 3;
+  std::array<std::vector<u8>, FRAME_DUMP_BUFFERS> m_frame_dump_buffers;
+  size_t m_frame_dump_next_buffer = 0;
+  std::mutex m_frame_dump_lock;
+  std::condition_variable m_frame_dump_cv;
+  std::deque<FrameDumpConfig> m_frame_dump_queue;
+  // Queued frames, plus the one being dumped
+  size_t m_frame_dump_pending = 0;
 
   // NOTE: The methods below are called on the framedumping thread.
   bool StartFrameDumpToAVI(const FrameDumpConfig& config);
@@ -0,0 +1,81 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+// The objects a backend creates for the render states of RenderState.h, keyed by their packed
+// bits. Lookups go through a small direct-mapped table of recently used states first, which the
+// few states a frame switches between stay in, and only go to the hash map on a miss.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <unordered_map>
+
+#include "Common/CommonTypes.h"
+
+template <typename State, typename Object>
+class RenderStateCache
+{
+public:
+  using Key = decltype(State::hex);
+
+  // Returns nullptr if no object was inserted for the state. The pointer is only valid until the
+  // next call, as it may point into the front table.
+  const Object* Find(const State& state)
+  {
+    FrontEntry& front = m_front[GetFrontIndex(state.hex)];
+    if (front.valid && front.key == state.hex)
+      return &front.object;
+
+    const auto it = m_map.find(state.hex);
+    if (it == m_map.end())
+      return nullptr;
+
+    front = {state.hex, it->second, true};
+    return &front.object;
+  }
+
+  void Insert(const State& state, const Object& object)
+  {
+    m_map.emplace(state.hex, object);
+    m_front[GetFrontIndex(state.hex)] = {state.hex, object, true};
+  }
+
+  template <typename Function>
+  void ForEach(Function function)
+  {
+    for (auto& entry : m_map)
+      function(entry.second);
+  }
+
+  size_t Size() const { return m_map.size(); }
+
+  // Destroying the objects is up to the backend, see ForEach.
+  void Clear()
+  {
+    m_map.clear();
+    m_front = {};
+  }
+
+private:
+  static constexpr size_t FRONT_SIZE_BITS = 6;
+
+  struct FrontEntry
+  {
+    Key key;
+    Object object;
+    bool valid;
+  };
+
+  static size_t GetFrontIndex(Key key)
+  {
+    // Fibonacci hashing: the top bits of the product depend on all bits of the key, while the
+    // fields in the low bits of the packed states change the most.
+    return static_cast<size_t>((static_cast<u64>(key) * 0x9E3779B97F4A7C15ULL) >>
+                               (64 - FRONT_SIZE_BITS));
+  }
+
+  std::array<FrontEntry, size_t(1) << FRONT_SIZE_BITS> m_front{};
+  std::unordered_map<Key, Object> m_map;
+};
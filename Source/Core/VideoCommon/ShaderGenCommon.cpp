@@ -32,6 +32,9 @@ ShaderHostConfig ShaderHostConfig::GetCurrent()
   bits.backend_bitfield = g_ActiveConfig.backend_info.bSupportsBitfield;
   bits.backend_dynamic_sampler_indexing =
       g_ActiveConfig.backend_info.bSupportsDynamicSamplerIndexing;
+  bits.backend_vs_layer_output = g_ActiveConfig.backend_info.bSupportsVSLayerOutput;
+  bits.merged_draws = g_ActiveConfig.CanMergeMatrixChanges();
+  bits.backend_multi_draw_indirect = g_ActiveConfig.backend_info.bSupportsMultiDrawIndirect;
 
   bits.more_layers = 0;
   bits.vr = g_ActiveConfig.iStereoMode >= STEREO_OCULUS;
@@ -7,6 +7,7 @@
 #include <cstdarg>
 #include <cstring>
 #include <map>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -106,6 +107,32 @@ private:
   };
 };
 
+// Counts how many distinct UIDs became equal after their unused bits were cleared, i.e. how many
+// shaders did not have to be compiled.
+template <class Uid>
+class ShaderUidMergeCounter
+{
+public:
+  int Add(const Uid& raw_uid, const Uid& uid)
+  {
+    // Consecutive draws mostly use the same shader, so don't bother looking it up again.
+    if (!m_raw_uids.empty() && raw_uid == m_last_raw_uid)
+      return GetMergedCount();
+
+    m_last_raw_uid = raw_uid;
+    m_raw_uids.insert(raw_uid);
+    m_uids.insert(uid);
+    return GetMergedCount();
+  }
+
+  int GetMergedCount() const { return static_cast<int>(m_raw_uids.size() - m_uids.size()); }
+
+private:
+  std::set<Uid> m_raw_uids;
+  std::set<Uid> m_uids;
+  Uid m_last_raw_uid;
+};
+
 class ShaderCode : public ShaderGeneratorInterface
 {
 public:
@@ -178,11 +205,18 @@ union ShaderHostConfig
     u32 backend_reversed_depth_range : 1;
     u32 backend_bitfield : 1;
     u32 backend_dynamic_sampler_indexing : 1;
-    u32 pad : 10;
+    u32 backend_vs_layer_output : 1;
+    u32 merged_draws : 1;
+    u32 backend_multi_draw_indirect : 1;
+    u32 pad : 7;
 	u32 more_layers : 1;
 	u32 vr : 1;
   };
 
+  // Stereo layers are selected by the vertex shader from the instance index, instead of the
+  // geometry shader duplicating every primitive.
+  bool UseInstancedStereo() const { return stereo && backend_vs_layer_output; }
+
   static ShaderHostConfig GetCurrent();
 };
 
@@ -315,6 +349,8 @@ inline const char* GetInterpolationQualifier(bool msaa, bool ssaa,
 #define I_POSTTRANSFORMMATRICES "cpostmtx"
 #define I_PIXELCENTERCORRECTION "cpixelcenter"
 #define I_VIEWPORT_SIZE "cviewport"
+#define I_POSMTXBATCH "cposmtxbatch"
+#define I_POSMTXBATCHINFO "cposmtxbatchinfo"
 
 #define I_STEREOPARAMS "cstereo"
 #define I_LINEPTPARAMS "clinept"
@@ -334,6 +370,8 @@ static const char s_shader_uniforms[] = "\tuint    components;\n"
                                         "\tfloat4 " I_PIXELCENTERCORRECTION ";\n"
                                         "\tfloat2 " I_VIEWPORT_SIZE ";\n"
                                         "\tuint4   xfmem_pack1[8];\n"
+                                        "\tint4 " I_POSMTXBATCH "[16];\n"
+                                        "\tint4 " I_POSMTXBATCHINFO ";\n"
                                         "\t#define xfmem_texMtxInfo(i) (xfmem_pack1[(i)].x)\n"
                                         "\t#define xfmem_postMtxInfo(i) (xfmem_pack1[(i)].y)\n"
                                         "\t#define xfmem_color(i) (xfmem_pack1[(i)].z)\n"
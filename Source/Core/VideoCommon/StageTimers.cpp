@@ -0,0 +1,80 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoCommon/StageTimers.h"
+
+#include <array>
+#include <chrono>
+#include <cinttypes>
+
+#include "Common/StringUtil.h"
+
+namespace StageTimers
+{
+namespace
+{
+constexpr size_t NUM_STAGES = static_cast<size_t>(Stage::Count);
+
+constexpr std::array<const char*, NUM_STAGES> STAGE_NAMES = {
+    {"Command processing", "Vertex loading", "Texture decoding", "Shader generation", "Backend",
+     "Presentation"}};
+
+struct Total
+{
+  std::atomic<u64> nanoseconds{0};
+  std::atomic<u64> count{0};
+};
+
+std::array<Total, NUM_STAGES> s_totals;
+}
+
+std::atomic<bool> g_enabled{false};
+thread_local Scope* Scope::s_current = nullptr;
+
+u64 Scope::GetTimestamp()
+{
+  return static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              std::chrono::steady_clock::now().time_since_epoch())
+                              .count());
+}
+
+void SetEnabled(bool enabled)
+{
+  if (enabled && !IsEnabled())
+  {
+    for (Total& total : s_totals)
+    {
+      total.nanoseconds = 0;
+      total.count = 0;
+    }
+  }
+  g_enabled = enabled;
+}
+
+void AddTime(Stage stage, u64 nanoseconds)
+{
+  Total& total = s_totals[static_cast<size_t>(stage)];
+  total.nanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+  total.count.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::string GetReport()
+{
+  const u64 frames = s_totals[static_cast<size_t>(Stage::Presentation)].count;
+  u64 sum = 0;
+  for (const Total& total : s_totals)
+    sum += total.nanoseconds;
+
+  std::string report = StringFromFormat("Video stage times over %" PRIu64 " frames:\n", frames);
+  for (size_t i = 0; i < NUM_STAGES; i++)
+  {
+    const u64 nanoseconds = s_totals[i].nanoseconds;
+    report += StringFromFormat(
+        "  %-20s %10.1f ms %8.3f ms/frame %5.1f%% %12" PRIu64 " calls\n", STAGE_NAMES[i],
+        nanoseconds / 1e6, frames ? nanoseconds / 1e6 / frames : 0.0,
+        sum ? 100.0 * nanoseconds / sum : 0.0, static_cast<u64>(s_totals[i].count));
+  }
+  return report;
+}
+}  // namespace StageTimers
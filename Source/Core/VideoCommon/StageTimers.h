@@ -0,0 +1,83 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+// Totals of the time the GPU thread spends in the stages of the VideoCommon front end, reported
+// when the video backend shuts down. Running with the Null backend, which only runs the front end,
+// this separates the front end's overhead from that of real backends and their drivers. Time
+// spent in a stage nested in another one only counts for the inner stage.
+
+#pragma once
+
+#include <atomic>
+#include <string>
+
+#include "Common/CommonTypes.h"
+
+namespace StageTimers
+{
+enum class Stage
+{
+  CommandProcessing,
+  VertexLoading,
+  TextureDecoding,
+  ShaderGeneration,
+  Backend,
+  Presentation,
+  // Scopes of Count don't time anything.
+  Count
+};
+
+extern std::atomic<bool> g_enabled;
+
+inline bool IsEnabled()
+{
+  return g_enabled.load(std::memory_order_relaxed);
+}
+
+// Resets the totals when enabling.
+void SetEnabled(bool enabled);
+void AddTime(Stage stage, u64 nanoseconds);
+
+// The totals, with one presentation per frame.
+std::string GetReport();
+
+class Scope
+{
+public:
+  explicit Scope(Stage stage) : m_stage(IsEnabled() ? stage : Stage::Count)
+  {
+    if (m_stage != Stage::Count)
+    {
+      m_parent = s_current;
+      s_current = this;
+      m_start = GetTimestamp();
+    }
+  }
+
+  ~Scope()
+  {
+    if (m_stage != Stage::Count)
+    {
+      const u64 elapsed = GetTimestamp() - m_start;
+      AddTime(m_stage, elapsed - m_nested);
+      s_current = m_parent;
+      if (m_parent)
+        m_parent->m_nested += elapsed;
+    }
+  }
+
+  Scope(const Scope&) = delete;
+  Scope& operator=(const Scope&) = delete;
+
+private:
+  static u64 GetTimestamp();
+
+  static thread_local Scope* s_current;
+
+  Stage m_stage;
+  Scope* m_parent = nullptr;
+  u64 m_start = 0;
+  u64 m_nested = 0;
+};
+}  // namespace StageTimers
@@ -13,6 +13,9 @@
 
 Statistics stats;
 
+Metrics::Counter g_shader_compiles("dolphin_video_shader_compiles_total",
+                                   "Shaders compiled by the video backend.");
+
 void Statistics::ResetFrame()
 {
   prevFrame = thisFrame;
@@ -48,14 +51,20 @@ std::string Statistics::ToString()
   str += StringFromFormat("Textures created: %i\n", stats.numTexturesCreated);
   str += StringFromFormat("Textures uploaded: %i\n", stats.numTexturesUploaded);
   str += StringFromFormat("Textures alive: %i\n", stats.numTexturesAlive);
+  str += StringFromFormat("Textures reused from pool: %i\n", stats.numTexturesReused);
+  str += StringFromFormat("Texture pool evictions: %i\n", stats.numTexturePoolEvictions);
+  str += StringFromFormat("Texture pool size: %i KB\n", stats.texturePoolSizeKB);
   str += StringFromFormat("pshaders created: %i\n", stats.numPixelShadersCreated);
   str += StringFromFormat("pshaders alive: %i\n", stats.numPixelShadersAlive);
   str += StringFromFormat("vshaders created: %i\n", stats.numVertexShadersCreated);
   str += StringFromFormat("vshaders alive: %i\n", stats.numVertexShadersAlive);
+  str += StringFromFormat("pshader uids merged: %i\n", stats.numPixelShaderUidsMerged);
+  str += StringFromFormat("vshader uids merged: %i\n", stats.numVertexShaderUidsMerged);
   str += StringFromFormat("shaders changes: %i\n", stats.thisFrame.numShaderChanges);
   str += StringFromFormat("dlists called: %i\n", stats.thisFrame.numDListsCalled);
   str += StringFromFormat("Primitive joins: %i\n", stats.thisFrame.numPrimitiveJoins);
   str += StringFromFormat("Draw calls: %i\n", stats.thisFrame.numDrawCalls);
+  str += StringFromFormat("Ubershader draws: %i\n", stats.thisFrame.numUberShaderDraws);
   str += StringFromFormat("Primitives: %i\n", stats.thisFrame.numPrims);
   str += StringFromFormat("Primitives (DL): %i\n", stats.thisFrame.numDLPrims);
   str += StringFromFormat("XF loads: %i\n", stats.thisFrame.numXFLoads);
@@ -67,6 +76,9 @@ std::string Statistics::ToString()
   str += StringFromFormat("Vertex streamed: %i kB\n", stats.thisFrame.bytesVertexStreamed / 1024);
   str += StringFromFormat("Index streamed: %i kB\n", stats.thisFrame.bytesIndexStreamed / 1024);
   str += StringFromFormat("Uniform streamed: %i kB\n", stats.thisFrame.bytesUniformStreamed / 1024);
+  str += StringFromFormat("Texture streamed: %i kB\n", stats.thisFrame.bytesTextureStreamed / 1024);
+  str += StringFromFormat("Stream buffer waits: %i\n", stats.thisFrame.numStreamBufferWaits);
+  str += StringFromFormat("Stream buffer wraps: %i\n", stats.thisFrame.numStreamBufferWraps);
   str += StringFromFormat("Vertex Loaders: %i\n", stats.numVertexLoaders);
 
   std::string vertex_list = VertexLoaderManager::VertexLoadersToString();
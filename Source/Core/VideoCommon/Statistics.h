@@ -6,16 +6,24 @@
 
 #include <string>
 
+#include "Common/Metrics.h"
+
 struct Statistics
 {
   int numPixelShadersCreated;
   int numPixelShadersAlive;
   int numVertexShadersCreated;
   int numVertexShadersAlive;
+  // Distinct UIDs that ended up sharing a shader once their unused bits were cleared.
+  int numPixelShaderUidsMerged;
+  int numVertexShaderUidsMerged;
 
   int numTexturesCreated;
   int numTexturesUploaded;
   int numTexturesAlive;
+  int numTexturesReused;
+  int numTexturePoolEvictions;
+  int texturePoolSizeKB;
 
   int numVertexLoaders;
 
@@ -44,12 +52,16 @@ struct Statistics
 
     int numPrimitiveJoins;
     int numDrawCalls;
+    int numUberShaderDraws;
 
     int numDListsCalled;
 
     int bytesVertexStreamed;
     int bytesIndexStreamed;
     int bytesUniformStreamed;
+    int bytesTextureStreamed;
+    int numStreamBufferWaits;
+    int numStreamBufferWraps;
 
     int numTrianglesClipped;
     int numTrianglesIn;
@@ -72,6 +84,9 @@ struct Statistics
 
 extern Statistics stats;
 
+// Counted by the backends, where they compile a shader or, with OpenGL, a program.
+extern Metrics::Counter g_shader_compiles;
+
 #define STATISTICS
 
 #ifdef STATISTICS
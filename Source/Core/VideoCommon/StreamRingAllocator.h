@@ -0,0 +1,263 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+// Sub-allocates a persistently mapped stream buffer as a ring. The allocator only deals with
+// offsets, the backend owns the memory and the fences. Every fence added marks the position
+// the GPU will have reached once it is signaled, and space is only handed out again once the
+// fence covering it has been retired, either by the backend noticing it was signaled or by
+// Reserve() waiting for it as a last resort.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <utility>
+
+#include "Common/Align.h"
+#include "Common/Assert.h"
+#include "Common/CommonTypes.h"
+#include "VideoCommon/Statistics.h"
+
+struct StreamRingStatistics
+{
+  u64 reservations = 0;
+  u64 bytes_committed = 0;
+  // Space lost to alignment padding and to the end of the buffer being skipped on wraparound.
+  u64 bytes_wasted = 0;
+  u64 wraps = 0;
+  // Number of times the CPU had to block until the GPU was done with some of the buffer.
+  u64 fence_waits = 0;
+  size_t peak_bytes_in_flight = 0;
+};
+
+template <typename Fence>
+class StreamRingAllocator
+{
+public:
+  using FenceFunction = std::function<void(const Fence&)>;
+
+  // wait_fn blocks until a fence is signaled. release_fn, if set, is called once the allocator
+  // no longer needs a fence, so that backends which create fences themselves can delete them.
+  StreamRingAllocator(size_t size, FenceFunction wait_fn, FenceFunction release_fn = nullptr)
+      : m_size(size), m_wait_fn(std::move(wait_fn)), m_release_fn(std::move(release_fn))
+  {
+  }
+  ~StreamRingAllocator() { ReleaseFences(m_fences.end()); }
+
+  StreamRingAllocator(const StreamRingAllocator&) = delete;
+  StreamRingAllocator& operator=(const StreamRingAllocator&) = delete;
+
+  size_t GetSize() const { return m_size; }
+  size_t GetCurrentOffset() const { return m_offset; }
+  size_t GetUnfencedBytes() const { return m_unfenced_bytes; }
+  const StreamRingStatistics& GetStatistics() const { return m_statistics; }
+
+  // Forgets about all allocations, for when the backing memory has been replaced.
+  void Reset(size_t size)
+  {
+    ReleaseFences(m_fences.end());
+    m_size = size;
+    m_offset = 0;
+    m_gpu_position = 0;
+    m_last_reservation_size = 0;
+    m_unfenced_bytes = 0;
+  }
+
+  // Makes num_bytes bytes at an alignment-aligned GetCurrentOffset() available for writing.
+  // Without allow_wrap, only the space up to the end of the buffer is used. Without allow_wait,
+  // this never blocks, and fails instead if the GPU is still using the space.
+  bool Reserve(size_t num_bytes, size_t alignment, bool allow_wrap = true, bool allow_wait = true)
+  {
+    const size_t required_bytes = num_bytes + alignment;
+    if (required_bytes > m_size)
+      return false;
+
+    m_statistics.reservations++;
+
+    // Is the GPU behind or up to date with our current offset?
+    if (m_offset >= m_gpu_position)
+    {
+      if (required_bytes <= m_size - m_offset)
+      {
+        Place(num_bytes, alignment);
+        return true;
+      }
+
+      // Check for space at the start of the buffer. We use < here because we don't want
+      // m_offset to end up equal to m_gpu_position, which would mean the GPU has caught up.
+      if (allow_wrap && required_bytes < m_gpu_position)
+      {
+        Wrap();
+        Place(num_bytes, alignment);
+        return true;
+      }
+    }
+    else if (required_bytes < m_gpu_position - m_offset)
+    {
+      // Still behind the GPU, but there is enough space in between.
+      Place(num_bytes, alignment);
+      return true;
+    }
+
+    if (allow_wrap && allow_wait && WaitForClearSpace(required_bytes))
+    {
+      Place(num_bytes, alignment);
+      return true;
+    }
+
+    return false;
+  }
+
+  void Commit(size_t num_bytes)
+  {
+    _assert_(m_offset + num_bytes <= m_size);
+    _assert_(num_bytes <= m_last_reservation_size);
+
+    m_offset += num_bytes;
+    m_unfenced_bytes += num_bytes;
+    m_statistics.bytes_committed += num_bytes;
+    m_statistics.peak_bytes_in_flight =
+        std::max(m_statistics.peak_bytes_in_flight, GetBytesInFlight());
+  }
+
+  // Whether anything has been committed since the last fence was added.
+  bool NeedsFence() const
+  {
+    return m_offset != m_gpu_position && (m_fences.empty() || m_fences.back().second != m_offset);
+  }
+
+  // The fence must be signaled after the GPU is done with everything committed so far.
+  void AddFence(const Fence& fence)
+  {
+    m_fences.emplace_back(fence, m_offset);
+    m_unfenced_bytes = 0;
+  }
+
+  void OnFenceSignaled(const Fence& fence)
+  {
+    // The fence may be unknown, if it was not needed or if we were forced to wait already.
+    auto iter = std::find_if(m_fences.begin(), m_fences.end(),
+                             [&fence](const std::pair<Fence, size_t>& it) {
+                               return it.first == fence;
+                             });
+    if (iter == m_fences.end())
+      return;
+
+    // Fences before this one are implied to be signaled as well.
+    m_gpu_position = iter->second;
+    ReleaseFences(++iter);
+  }
+
+  // Retires fences for as long as is_signaled() returns true for them, oldest first. This lets
+  // backends which have to poll their fences reclaim space without ever blocking.
+  template <typename Predicate>
+  void RetireSignaledFences(Predicate is_signaled)
+  {
+    auto iter = m_fences.begin();
+    for (; iter != m_fences.end() && is_signaled(iter->first); ++iter)
+      m_gpu_position = iter->second;
+    ReleaseFences(iter);
+  }
+
+private:
+  size_t GetBytesInFlight() const
+  {
+    return m_offset >= m_gpu_position ? m_offset - m_gpu_position :
+                                        m_size - m_gpu_position + m_offset;
+  }
+
+  void Place(size_t num_bytes, size_t alignment)
+  {
+    // Assume an offset of zero is already aligned to a value larger than alignment.
+    const size_t aligned_offset = m_offset == 0 ? 0 : Common::AlignUp(m_offset, alignment);
+    m_statistics.bytes_wasted += aligned_offset - m_offset;
+    m_offset = aligned_offset;
+    m_last_reservation_size = num_bytes;
+  }
+
+  void Wrap()
+  {
+    m_statistics.bytes_wasted += m_size - m_offset;
+    m_statistics.wraps++;
+    INCSTAT(stats.thisFrame.numStreamBufferWraps);
+    m_offset = 0;
+  }
+
+  void ReleaseFences(typename std::deque<std::pair<Fence, size_t>>::iterator end)
+  {
+    if (m_release_fn)
+    {
+      for (auto iter = m_fences.begin(); iter != end; ++iter)
+        m_release_fn(iter->first);
+    }
+    m_fences.erase(m_fences.begin(), end);
+  }
+
+  // Waits for as many fences as needed to allocate num_bytes bytes from the buffer.
+  bool WaitForClearSpace(size_t num_bytes)
+  {
+    size_t new_offset = 0;
+    size_t new_gpu_position = 0;
+    auto iter = m_fences.begin();
+    for (; iter != m_fences.end(); ++iter)
+    {
+      // Would this fence bring us in line with the GPU? If nothing has been written since it
+      // was added, the whole buffer is free once it is signaled.
+      const size_t gpu_position = iter->second;
+      if (m_offset == gpu_position)
+      {
+        new_offset = 0;
+        new_gpu_position = 0;
+        break;
+      }
+
+      if (m_offset > gpu_position)
+      {
+        // We can wrap around to the start, behind the GPU, if there is enough space. We use >
+        // so that we don't line up with the GPU position.
+        if (gpu_position > num_bytes)
+        {
+          new_offset = 0;
+          new_gpu_position = gpu_position;
+          break;
+        }
+      }
+      else if (gpu_position - m_offset > num_bytes)
+      {
+        // Leave the offset as-is, but update the GPU position.
+        new_offset = m_offset;
+        new_gpu_position = gpu_position;
+        break;
+      }
+    }
+
+    if (iter == m_fences.end())
+      return false;
+
+    m_wait_fn(iter->first);
+    m_statistics.fence_waits++;
+    INCSTAT(stats.thisFrame.numStreamBufferWaits);
+
+    if (new_offset != m_offset)
+      Wrap();
+    m_gpu_position = new_gpu_position;
+    ReleaseFences(++iter);
+    return true;
+  }
+
+  size_t m_size;
+  size_t m_offset = 0;
+  size_t m_gpu_position = 0;
+  size_t m_last_reservation_size = 0;
+  size_t m_unfenced_bytes = 0;
+
+  // List of fences and the corresponding positions in the buffer
+  std::deque<std::pair<Fence, size_t>> m_fences;
+
+  FenceFunction m_wait_fn;
+  FenceFunction m_release_fn;
+  StreamRingStatistics m_statistics;
+};
@@ -8,6 +8,7 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "Common/Align.h"
 #include "Common/Assert.h"
@@ -15,8 +16,10 @@
 #include "Common/FileUtil.h"
 #include "Common/Hash.h"
 #include "Common/Logging/Log.h"
+#include "Common/Logging/Trace.h"
 #include "Common/MathUtil.h"
 #include "Common/MemoryUtil.h"
+#include "Common/Metrics.h"
 #include "Common/StringUtil.h"
 
 #include "Core/ConfigManager.h"
@@ -30,9 +33,12 @@
 #include "VideoCommon/HiresTextures.h"
 #include "VideoCommon/RenderBase.h"
 #include "VideoCommon/SamplerCommon.h"
+#include "VideoCommon/StageTimers.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/TextureCacheBase.h"
+#include "VideoCommon/TextureDecodeCache.h"
 #include "VideoCommon/TextureDecoder.h"
+#include "VideoCommon/TextureHashPrefetcher.h"
 #include "VideoCommon/VideoCommon.h"
 #include "VideoCommon/VideoConfig.h"
 
@@ -56,6 +62,14 @@ TextureCacheBase::TCacheEntry::~TCacheEntry()
     reference->references.erase(this);
 }
 
+// Write tracking is only enabled once it's used, as emulated memory is set up after the texture
+// cache is created. It needs fastmem, so this may keep failing, in which case everything is hashed.
+static bool UseWriteTracking()
+{
+  return g_ActiveConfig.bTextureWriteTracking && Memory::IsInitialized() &&
+         (Memory::IsDirtyPageTrackingEnabled() || Memory::EnableDirtyPageTracking(true));
+}
+
 void TextureCacheBase::CheckTempSize(size_t required_size)
 {
   if (required_size <= temp_size)
@@ -77,6 +91,7 @@ TextureCacheBase::TextureCacheBase()
                                      backup_config.texfmt_overlay_center);
 
   HiresTexture::Init();
+  UpdateDecodeCache();
 
   SetHash64Function();
 
@@ -85,6 +100,8 @@ TextureCacheBase::TextureCacheBase()
 
 void TextureCacheBase::Invalidate()
 {
+  FlushEFBCopies();
+
   InvalidateAllBindPoints();
   for (size_t i = 0; i < bound_textures.size(); ++i)
   {
@@ -99,6 +116,7 @@ void TextureCacheBase::Invalidate()
   textures_by_hash.clear();
 
   texture_pool.clear();
+  texture_pool_size = 0;
 }
 
 TextureCacheBase::~TextureCacheBase()
@@ -112,11 +130,19 @@ TextureCacheBase::~TextureCacheBase()
 void TextureCacheBase::OnConfigChanged(VideoConfig& config)
 {
   if (config.bHiresTextures != backup_config.hires_textures ||
-      config.bCacheHiresTextures != backup_config.cache_hires_textures)
+      config.bCacheHiresTextures != backup_config.cache_hires_textures ||
+      config.bAsyncHiresTextures != backup_config.async_hires_textures ||
+      config.iHiresTextureCacheSize != backup_config.hires_texture_cache_size)
   {
     HiresTexture::Update();
   }
 
+  if (config.bCacheDecodedTextures != backup_config.cache_decoded_textures)
+  {
+    SetBackupConfig(config);
+    UpdateDecodeCache();
+  }
+
   // TODO: Invalidating texcache is really stupid in some of these cases
   if (config.iSafeTextureCache_ColorSamples != backup_config.color_samples ||
       config.bTexFmtOverlayEnable != backup_config.texfmt_overlay ||
@@ -130,6 +156,12 @@ void TextureCacheBase::OnConfigChanged(VideoConfig& config)
                                        g_ActiveConfig.bTexFmtOverlayCenter);
   }
 
+  if (config.bTextureWriteTracking != backup_config.texture_write_tracking &&
+      !config.bTextureWriteTracking && Memory::IsInitialized())
+  {
+    Memory::EnableDirtyPageTracking(false);
+  }
+
   if ((config.iStereoMode > 0) != backup_config.stereo_3d ||
       config.bStereoEFBMonoDepth != backup_config.efb_mono_depth)
   {
@@ -143,6 +175,11 @@ void TextureCacheBase::OnConfigChanged(VideoConfig& config)
 
 void TextureCacheBase::Cleanup(int _frameCount)
 {
+  TextureHashPrefetcher::Cleanup();
+
+  // EFB copies are hashed below.
+  FlushEFBCopies();
+
   TexAddrCache::iterator iter = textures_by_address.begin();
   TexAddrCache::iterator tcend = textures_by_address.end();
   while (iter != tcend)
@@ -185,6 +222,12 @@ void TextureCacheBase::Cleanup(int _frameCount)
     }
   }
 
+  if (g_ActiveConfig.iHiresTextureVRAMBudget > 0)
+    EvictCustomTextures(_frameCount);
+
+  // Without a budget, unused textures are only kept for a few frames. With one, they are kept
+  // until the pool grows over it, which streaming games benefit from.
+  const bool pool_budget = g_ActiveConfig.iTexturePoolBudget > 0;
   TexPool::iterator iter2 = texture_pool.begin();
   TexPool::iterator tcend2 = texture_pool.end();
   while (iter2 != tcend2)
@@ -193,15 +236,52 @@ void TextureCacheBase::Cleanup(int _frameCount)
     {
       iter2->second.frameCount = _frameCount;
     }
-    if (_frameCount > TEXTURE_POOL_KILL_THRESHOLD + iter2->second.frameCount)
+    if (!pool_budget && _frameCount > TEXTURE_POOL_KILL_THRESHOLD + iter2->second.frameCount)
     {
-      iter2 = texture_pool.erase(iter2);
+      iter2 = EraseFromPool(iter2);
     }
     else
     {
       ++iter2;
     }
   }
+
+  if (pool_budget)
+    EvictFromPool();
+  SETSTAT(stats.texturePoolSizeKB, static_cast<int>(texture_pool_size / 1024));
+}
+
+bool TextureCacheBase::IsDeferringEFBCopies() const
+{
+  return g_ActiveConfig.bDeferEFBCopies && SupportsDeferredEFBCopies();
+}
+
+void TextureCacheBase::FlushEFBCopies()
+{
+  if (pending_efb_copy_ranges.empty())
+    return;
+
+  FlushPendingEFBCopies();
+  pending_efb_copy_ranges.clear();
+
+  for (TCacheEntry* entry : pending_efb_copy_entries)
+  {
+    u64 hash = entry->CalculateHash();
+    entry->SetHashes(hash, hash);
+  }
+  pending_efb_copy_entries.clear();
+}
+
+void TextureCacheBase::FlushEFBCopies(u32 address, u32 size)
+{
+  for (const auto& range : pending_efb_copy_ranges)
+  {
+    if (range.first < address + size && address < range.first + range.second)
+    {
+      FlushEFBCopies();
+      return;
+    }
+  }
 }
 
 bool TextureCacheBase::TCacheEntry::OverlapsMemoryRange(u32 range_address, u32 range_size) const
@@ -222,9 +302,32 @@ void TextureCacheBase::SetBackupConfig(const VideoConfig& config)
   backup_config.texfmt_overlay_center = config.bTexFmtOverlayCenter;
   backup_config.hires_textures = config.bHiresTextures;
   backup_config.cache_hires_textures = config.bCacheHiresTextures;
+  backup_config.async_hires_textures = config.bAsyncHiresTextures;
+  backup_config.hires_texture_cache_size = config.iHiresTextureCacheSize;
+  backup_config.cache_decoded_textures = config.bCacheDecodedTextures;
   backup_config.stereo_3d = config.iStereoMode > 0;
   backup_config.efb_mono_depth = config.bStereoEFBMonoDepth;
   backup_config.gpu_texture_decoding = config.bEnableGPUTextureDecoding;
+  backup_config.texture_write_tracking = config.bTextureWriteTracking;
+}
+
+void TextureCacheBase::UpdateDecodeCache()
+{
+  decode_cache.reset();
+  if (!backup_config.cache_decoded_textures)
+    return;
+
+  const std::string& game_id = SConfig::GetInstance().GetGameID();
+  if (game_id.empty())
+    return;
+
+  const std::string cache_dir = File::GetUserPath(D_CACHE_IDX);
+  if (!File::Exists(cache_dir))
+    File::CreateDir(cache_dir);
+
+  decode_cache = std::make_unique<TextureDecodeCache>(cache_dir + "textures-" + game_id + ".cache");
+  if (!decode_cache->IsOpen())
+    decode_cache.reset();
 }
 
 TextureCacheBase::TCacheEntry*
@@ -280,10 +383,9 @@ void TextureCacheBase::ScaleTextureCacheEntryTo(TextureCacheBase::TCacheEntry* e
                                           new_texture->GetConfig().GetRect());
     entry->texture.swap(new_texture);
 
-    auto config = new_texture->GetConfig();
     // At this point new_texture has the old texture in it,
     // we can potentially reuse this, so let's move it back to the pool
-    texture_pool.emplace(config, TexPoolEntry(std::move(new_texture)));
+    ReturnToPool(std::move(new_texture));
   }
   else
   {
@@ -462,9 +564,15 @@ static u32 CalculateLevelSize(u32 level_0_size, u32 level)
   return std::max(level_0_size >> level, 1u);
 }
 
+static Metrics::Counter s_texture_lookups("dolphin_video_texture_cache_lookups_total",
+                                          "Textures looked up in the texture cache.");
+static Metrics::Counter s_texture_misses("dolphin_video_texture_cache_misses_total",
+                                         "Texture lookups which had to decode the texture.");
+
 // Used by TextureCacheBase::Load
 TextureCacheBase::TCacheEntry* TextureCacheBase::ReturnEntry(unsigned int stage, TCacheEntry* entry)
 {
+  s_texture_lookups.Increment();
   entry->frameCount = FRAMECOUNT_INVALID;
   bound_textures[stage] = entry;
 
@@ -622,6 +730,8 @@ private:
 
 TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const u32 stage)
 {
+  TRACE_SCOPE("TextureCache::Load");
+
   // if this stage was not invalidated by changes to texture registers, keep the current texture
   if (IsValidBindPoint(stage) && bound_textures[stage])
   {
@@ -695,6 +805,10 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const u32 stage)
     return nullptr;
   }
 
+  // The texture may be the result of an EFB copy that hasn't been written to RAM yet.
+  if (!from_tmem)
+    FlushEFBCopies(address, texture_size + additional_mips_size);
+
   // If we are recording a FifoLog, keep track of what memory we read.
   // FifiRecorder does it's own memory modification tracking independant of the texture hashing
   // below.
@@ -712,8 +826,41 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const u32 stage)
         address);
     return nullptr;
   }
-  else
+
+  // With write tracking, the hash of an entry for the same memory can be reused as long as nothing
+  // was written to it since it was hashed.
+  u64 write_token = 0;
+  const bool write_tracking = !from_tmem && UseWriteTracking();
+  if (write_tracking)
+  {
+    auto range = textures_by_address.equal_range(address);
+    for (auto iter = range.first; iter != range.second; ++iter)
+    {
+      const TCacheEntry* entry = iter->second;
+      if (!entry->IsEfbCopy() && entry->base_hash_write_token != 0 &&
+          entry->size_in_bytes == texture_size &&
+          !Memory::IsModifiedSince(address, texture_size, entry->base_hash_write_token))
+      {
+        base_hash = entry->base_hash;
+        write_token = entry->base_hash_write_token;
+        break;
+      }
+    }
+  }
+  // The hash may also have been computed ahead of time while the FIFO was preprocessed.
+  if (write_tracking && write_token == 0)
+  {
+    TextureHashPrefetcher::GetHash(address, texture_size,
+                                   g_ActiveConfig.iSafeTextureCache_ColorSamples, &base_hash,
+                                   &write_token);
+  }
+  if (write_token == 0)
+  {
+    // Protect the memory before hashing it, so that no write in between is missed.
+    if (write_tracking)
+      write_token = Memory::ProtectRange(address, texture_size);
     base_hash = GetHash64(src_data, texture_size, g_ActiveConfig.iSafeTextureCache_ColorSamples);
+  }
 
   u32 palette_size = 0;
   if (isPaletteTexture)
@@ -824,6 +971,14 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const u32 stage)
           entry->native_levels >= tex_levels && entry->native_width == nativeW &&
           entry->native_height == nativeH)
       {
+        // Once its custom texture has finished loading, the native texture is recreated.
+        if (!entry->pending_hires_name.empty() &&
+            !HiresTexture::IsLoadPending(entry->pending_hires_name))
+        {
+          iter = InvalidateTexture(iter);
+          continue;
+        }
+
         entry = DoPartialTextureUpdates(iter->second, &texMem[tlutaddr], tlutfmt);
 
         return ReturnEntry(stage, entry);
@@ -872,7 +1027,9 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const u32 stage)
       TCacheEntry* entry = hash_iter->second;
       // All parameters, except the address, need to match here
       if (entry->format == full_format && entry->native_levels >= tex_levels &&
-          entry->native_width == nativeW && entry->native_height == nativeH)
+          entry->native_width == nativeW && entry->native_height == nativeH &&
+          (entry->pending_hires_name.empty() ||
+           HiresTexture::IsLoadPending(entry->pending_hires_name)))
       {
         entry = DoPartialTextureUpdates(hash_iter->second, &texMem[tlutaddr], tlutfmt);
 
@@ -890,10 +1047,11 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const u32 stage)
   }
 
   std::shared_ptr<HiresTexture> hires_tex;
+  std::string pending_hires_name;
   if (g_ActiveConfig.bHiresTextures)
   {
     hires_tex = HiresTexture::Search(src_data, texture_size, &texMem[tlutaddr], palette_size, width,
-                                     height, texformat, use_mipmaps);
+                                     height, texformat, use_mipmaps, &pending_hires_name);
 
     if (hires_tex)
     {
@@ -912,13 +1070,10 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const u32 stage)
   const u32 texLevels = hires_tex ? (u32)hires_tex->m_levels.size() : tex_levels;
 
   // We can decode on the GPU if it is a supported format and the flag is enabled.
-  // Currently we don't decode RGBA8 textures from Tmem, as that would require copying from both
-  // banks, and if we're doing an copy we may as well just do the whole thing on the CPU, since
-  // there's no conversion between formats. In the future this could be extended with a separate
-  // shader, however.
+  // RGBA8 textures from Tmem are split across both banks, so the halves of each block are copied
+  // back together first, and the result runs through the regular RGBA8 decoding shader.
   bool decode_on_gpu = !hires_tex && g_ActiveConfig.UseGPUTextureDecoding() &&
-                       g_texture_cache->SupportsGPUTextureDecode(texformat, tlutfmt) &&
-                       !(from_tmem && texformat == TextureFormat::RGBA8);
+                       g_texture_cache->SupportsGPUTextureDecode(texformat, tlutfmt);
 
   // create the entry/texture
   TextureConfig config;
@@ -946,11 +1101,30 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const u32 stage)
   // Initialized to null because only software loading uses this buffer
   u8* dst_buffer = nullptr;
 
+  // The decode cache is only safe to use if the hash covers the whole texture and palette, and the
+  // decoded data doesn't depend on anything else.
+  const bool use_decode_cache =
+      decode_cache && !hires_tex && !decode_on_gpu && !from_tmem &&
+      g_ActiveConfig.iSafeTextureCache_ColorSamples == 0 && !g_ActiveConfig.bTexFmtOverlayEnable;
+  TextureDecodeCache::Key decode_cache_key = {};
+  bool decode_cache_hit = false;
+
   if (!hires_tex && decode_on_gpu)
   {
     u32 row_stride = bytes_per_block * (expandedWidth / bsw);
-    g_texture_cache->DecodeTextureOnGPU(entry, 0, src_data, texture_size, texformat, width, height,
-                                        expandedWidth, expandedHeight, row_stride, tlut, tlutfmt);
+    const u8* gpu_src_data = src_data;
+    if (from_tmem && texformat == TextureFormat::RGBA8)
+    {
+      CheckTempSize(texture_size);
+      u8* src_data_gb =
+          &texMem[bpmem.tex[stage / 4].texImage2[stage % 4].tmem_odd * TMEM_LINE_SIZE];
+      TexDecoder_InterleaveRGBA8FromTmem(temp, src_data, src_data_gb, expandedWidth,
+                                         expandedHeight);
+      gpu_src_data = temp;
+    }
+    g_texture_cache->DecodeTextureOnGPU(entry, 0, gpu_src_data, texture_size, texformat, width,
+                                        height, expandedWidth, expandedHeight, row_stride, tlut,
+                                        tlutfmt);
   }
   else if (!hires_tex)
   {
@@ -975,13 +1149,31 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const u32 stage)
     CheckTempSize(total_texture_size);
     dst_buffer = temp;
 
-    if (!(texformat == TextureFormat::RGBA8 && from_tmem))
+    if (use_decode_cache)
+    {
+      decode_cache_key.hash = full_hash;
+      decode_cache_key.format =
+          static_cast<u32>(texformat) | (isPaletteTexture ? static_cast<u32>(tlutfmt) << 8 : 0);
+      decode_cache_key.width = static_cast<u16>(width);
+      decode_cache_key.height = static_cast<u16>(height);
+      decode_cache_key.levels = texLevels;
+      decode_cache_hit = decode_cache->Lookup(decode_cache_key, dst_buffer,
+                                              total_texture_size - mip_downsample_buffer_size) != 0;
+    }
+
+    if (decode_cache_hit)
     {
+      // All levels were read from the decode cache.
+    }
+    else if (!(texformat == TextureFormat::RGBA8 && from_tmem))
+    {
+      StageTimers::Scope stage_scope(StageTimers::Stage::TextureDecoding);
       TexDecoder_Decode(dst_buffer, src_data, expandedWidth, expandedHeight, texformat, tlut,
                         tlutfmt);
     }
     else
     {
+      StageTimers::Scope stage_scope(StageTimers::Stage::TextureDecoding);
       u8* src_data_gb =
           &texMem[bpmem.tex[stage / 4].texImage2[stage % 4].tmem_odd * TMEM_LINE_SIZE];
       TexDecoder_DecodeRGBA8FromTmem(dst_buffer, src_data, src_data_gb, expandedWidth,
@@ -1006,8 +1198,11 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const u32 stage)
   entry->SetGeneralParameters(address, texture_size, full_format);
   entry->SetDimensions(nativeW, nativeH, tex_levels);
   entry->SetHashes(base_hash, full_hash);
+  entry->base_hash_write_token = write_token;
   entry->is_efb_copy = false;
   entry->is_custom_tex = hires_tex != nullptr;
+  entry->custom_tex_size = hires_tex ? hires_tex->GetDataSize() : 0;
+  entry->pending_hires_name = std::move(pending_hires_name);
   entry->memory_stride = entry->BytesPerRow();
 
   std::string basename = "";
@@ -1062,8 +1257,12 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const u32 stage)
       {
         // No need to call CheckTempSize here, as the whole buffer is preallocated at the beginning
         size_t decoded_mip_size = expanded_mip_width * sizeof(u32) * expanded_mip_height;
-        TexDecoder_Decode(dst_buffer, mip_src_data, expanded_mip_width, expanded_mip_height,
-                          texformat, tlut, tlutfmt);
+        if (!decode_cache_hit)
+        {
+          StageTimers::Scope stage_scope(StageTimers::Stage::TextureDecoding);
+          TexDecoder_Decode(dst_buffer, mip_src_data, expanded_mip_width, expanded_mip_height,
+                            texformat, tlut, tlutfmt);
+        }
         entry->texture->Load(level, mip_width, mip_height, expanded_mip_width, dst_buffer,
                              decoded_mip_size);
 
@@ -1074,6 +1273,9 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const u32 stage)
 
       mip_src_data += mip_size;
     }
+
+    if (use_decode_cache && !decode_cache_hit)
+      decode_cache->Insert(decode_cache_key, temp, dst_buffer - temp);
   }
 
   entry->has_arbitrary_mips = arbitrary_mip_detector.HasArbitraryMipmaps(dst_buffer);
@@ -1088,6 +1290,7 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const u32 stage)
 
   INCSTAT(stats.numTexturesUploaded);
   SETSTAT(stats.numTexturesAlive, textures_by_address.size());
+  s_texture_misses.Increment();
 
   entry = DoPartialTextureUpdates(iter->second, &texMem[tlutaddr], tlutfmt);
 
@@ -1451,14 +1654,20 @@ void TextureCacheBase::CopyRenderTargetToTexture(u32 dstAddr, EFBCopyFormat dstF
 
   bool copy_to_ram = !g_ActiveConfig.bSkipEFBCopyToRam;
   bool copy_to_vram = true;
+  const bool deferred = copy_to_ram && IsDeferringEFBCopies();
 
   if (copy_to_ram)
   {
 	  EFBCopyParams format(srcFormat, dstFormat, is_depth_copy, isIntensity);
 	  CopyEFB(dst, format, tex_w, bytes_per_row, num_blocks_y, dstStride, gameSrcRect, scaleByHalf);
+	  if (deferred)
+	    pending_efb_copy_ranges.emplace_back(dstAddr, covered_range);
   }
   else
   {
+    // A deferred copy must not overwrite the memory cleared here later on.
+    FlushEFBCopies(dstAddr, covered_range);
+
     // Hack: Most games don't actually need the correct texture data in RAM
     //       and we can just keep a copy in VRAM. We zero the memory so we
     //       can check it hasn't changed before using our copy in VRAM.
@@ -1553,8 +1762,16 @@ void TextureCacheBase::CopyRenderTargetToTexture(u32 dstAddr, EFBCopyFormat dstF
 
       CopyEFBToCacheEntry(entry, is_depth_copy, gameSrcRect, scaleByHalf, cbufid, colmat);
 
-      u64 hash = entry->CalculateHash();
-      entry->SetHashes(hash, hash);
+      if (deferred)
+      {
+        entry->SetHashes(TEXHASH_INVALID, TEXHASH_INVALID);
+        pending_efb_copy_entries.push_back(entry);
+      }
+      else
+      {
+        u64 hash = entry->CalculateHash();
+        entry->SetHashes(hash, hash);
+      }
 
       if (g_ActiveConfig.bDumpEFBTarget)
       {
@@ -1590,7 +1807,8 @@ std::unique_ptr<AbstractTexture> TextureCacheBase::AllocateTexture(const Texture
   if (iter != texture_pool.end())
   {
     entry = std::move(iter->second.texture);
-    texture_pool.erase(iter);
+    EraseFromPool(iter);
+    INCSTAT(stats.numTexturesReused);
   }
   else
   {
@@ -1619,6 +1837,47 @@ TextureCacheBase::FindMatchingTextureFromPool(const TextureConfig& config)
   return matching_iter != range.second ? matching_iter : texture_pool.end();
 }
 
+void TextureCacheBase::ReturnToPool(std::unique_ptr<AbstractTexture> texture)
+{
+  const TextureConfig config = texture->GetConfig();
+  TexPoolEntry entry(std::move(texture));
+  entry.size_in_bytes = AbstractTexture::CalculateHostTextureSize(config);
+  texture_pool_size += entry.size_in_bytes;
+  texture_pool.emplace(config, std::move(entry));
+}
+
+TextureCacheBase::TexPool::iterator TextureCacheBase::EraseFromPool(TexPool::iterator iter)
+{
+  texture_pool_size -= iter->second.size_in_bytes;
+  return texture_pool.erase(iter);
+}
+
+void TextureCacheBase::EvictFromPool()
+{
+  const size_t budget = static_cast<size_t>(g_ActiveConfig.iTexturePoolBudget) * 1024 * 1024;
+  if (texture_pool_size <= budget)
+    return;
+
+  std::vector<TexPool::iterator> pooled_textures;
+  pooled_textures.reserve(texture_pool.size());
+  for (auto iter = texture_pool.begin(); iter != texture_pool.end(); ++iter)
+    pooled_textures.push_back(iter);
+
+  std::sort(pooled_textures.begin(), pooled_textures.end(),
+            [](const TexPool::iterator& a, const TexPool::iterator& b) {
+              return a->second.frameCount < b->second.frameCount;
+            });
+
+  for (const TexPool::iterator& iter : pooled_textures)
+  {
+    if (texture_pool_size <= budget)
+      break;
+
+    EraseFromPool(iter);
+    INCSTAT(stats.numTexturePoolEvictions);
+  }
+}
+
 TextureCacheBase::TexAddrCache::iterator
 TextureCacheBase::GetTexCacheIter(TextureCacheBase::TCacheEntry* entry)
 {
@@ -1660,6 +1919,10 @@ TextureCacheBase::InvalidateTexture(TexAddrCache::iterator iter)
 
   TCacheEntry* entry = iter->second;
 
+  pending_efb_copy_entries.erase(
+      std::remove(pending_efb_copy_entries.begin(), pending_efb_copy_entries.end(), entry),
+      pending_efb_copy_entries.end());
+
   if (entry->textures_by_hash_iter != textures_by_hash.end())
   {
     textures_by_hash.erase(entry->textures_by_hash_iter);
@@ -1678,12 +1941,44 @@ TextureCacheBase::InvalidateTexture(TexAddrCache::iterator iter)
     }
   }
 
-  auto config = entry->texture->GetConfig();
-  texture_pool.emplace(config, TexPoolEntry(std::move(entry->texture)));
+  ReturnToPool(std::move(entry->texture));
 
   return textures_by_address.erase(iter);
 }
 
+void TextureCacheBase::EvictCustomTextures(int frame_count)
+{
+  const size_t budget = static_cast<size_t>(g_ActiveConfig.iHiresTextureVRAMBudget) * 1024 * 1024;
+
+  size_t total_size = 0;
+  std::vector<TexAddrCache::iterator> custom_textures;
+  for (auto iter = textures_by_address.begin(); iter != textures_by_address.end(); ++iter)
+  {
+    if (iter->second->is_custom_tex && !iter->second->tmem_only)
+    {
+      total_size += iter->second->custom_tex_size;
+      custom_textures.push_back(iter);
+    }
+  }
+  if (total_size <= budget)
+    return;
+
+  std::sort(custom_textures.begin(), custom_textures.end(),
+            [](const TexAddrCache::iterator& a, const TexAddrCache::iterator& b) {
+              return a->second->frameCount < b->second->frameCount;
+            });
+
+  for (const TexAddrCache::iterator& iter : custom_textures)
+  {
+    // Textures which were used this frame are still needed.
+    if (total_size <= budget || iter->second->frameCount >= frame_count)
+      break;
+
+    total_size -= iter->second->custom_tex_size;
+    InvalidateTexture(iter);
+  }
+}
+
 u32 TextureCacheBase::TCacheEntry::BytesPerRow() const
 {
   const u32 blockW = TexDecoder_GetBlockWidthInTexels(format.texfmt);
@@ -1716,9 +2011,23 @@ void TextureCacheBase::TCacheEntry::SetEfbCopy(u32 stride)
   _assert_msg_(VIDEO, memory_stride >= BytesPerRow(), "Memory stride is too small");
 
   size_in_bytes = memory_stride * NumBlocksY();
+  hash_write_token = 0;
 }
 
 u64 TextureCacheBase::TCacheEntry::CalculateHash() const
+{
+  if (!UseWriteTracking())
+    return CalculateHashUntracked();
+
+  if (hash_write_token == 0 || Memory::IsModifiedSince(addr, size_in_bytes, hash_write_token))
+  {
+    hash_write_token = Memory::ProtectRange(addr, size_in_bytes);
+    tracked_hash = CalculateHashUntracked();
+  }
+  return tracked_hash;
+}
+
+u64 TextureCacheBase::TCacheEntry::CalculateHashUntracked() const
 {
   u8* ptr = Memory::GetPointer(addr);
   if (memory_stride == BytesPerRow())
@@ -8,9 +8,12 @@
 #include <bitset>
 #include <map>
 #include <memory>
+#include <string>
 #include <tuple>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "VideoCommon/AbstractTexture.h"
@@ -19,6 +22,7 @@
 #include "VideoCommon/TextureDecoder.h"
 #include "VideoCommon/VideoCommon.h"
 
+class TextureDecodeCache;
 struct VideoConfig;
 
 struct TextureAndTLUTFormat
@@ -84,6 +88,17 @@ public:
     bool tmem_only = false;           // indicates that this texture only exists in the tmem cache
     bool has_arbitrary_mips = false;  // indicates that the mips in this texture are arbitrary
                                       // content, aren't just downscaled
+    size_t custom_tex_size = 0;       // size of the custom texture data uploaded for this entry
+
+    // With write tracking, the tokens from Memory::ProtectRange for base_hash and for the result
+    // of CalculateHash, so that neither is recalculated until the memory is written to.
+    u64 base_hash_write_token = 0;
+    mutable u64 hash_write_token = 0;
+    mutable u64 tracked_hash = 0;
+
+    // Name of the custom texture which is still being loaded in the background. The native
+    // texture is used until then, and replaced once the custom texture is ready.
+    std::string pending_hires_name;
 
     unsigned int native_width,
         native_height;  // Texture dimensions from the GameCube's point of view
@@ -110,6 +125,8 @@ public:
       addr = _addr;
       size_in_bytes = _size;
       format = _format;
+      base_hash_write_token = 0;
+      hash_write_token = 0;
     }
 
     void SetDimensions(unsigned int _native_width, unsigned int _native_height,
@@ -144,6 +161,7 @@ public:
     u32 BytesPerRow() const;
 
     u64 CalculateHash() const;
+    u64 CalculateHashUntracked() const;
 
     u32 GetWidth() const { return texture->GetConfig().width; }
     u32 GetHeight() const { return texture->GetConfig().height; }
@@ -166,6 +184,12 @@ public:
                        u32 num_blocks_y, u32 memory_stride, const EFBRectangle& src_rect,
                        bool scale_by_half) = 0;
 
+  // Writes the EFB copies whose readback was deferred to RAM. This has to happen before the CPU
+  // reads them, so it is done at the PE finish/token sync points and when emulation pauses.
+  void FlushEFBCopies();
+  // Only flushes if one of the deferred copies overlaps the range.
+  void FlushEFBCopies(u32 address, u32 size);
+
   virtual bool CompileShaders() = 0;
   virtual void DeleteShaders() = 0;
 
@@ -200,6 +224,12 @@ public:
 protected:
   TextureCacheBase();
 
+  // Backends returning true here only queue the readback in CopyEFB while IsDeferringEFBCopies()
+  // is true, and write all queued copies to RAM in FlushPendingEFBCopies().
+  virtual bool SupportsDeferredEFBCopies() const { return false; }
+  virtual void FlushPendingEFBCopies() {}
+  bool IsDeferringEFBCopies() const;
+
   GC_ALIGNED16(u8* temp);
   size_t temp_size;
 
@@ -212,6 +242,7 @@ private:
   {
     std::unique_ptr<AbstractTexture> texture;
     int frameCount = FRAMECOUNT_INVALID;
+    size_t size_in_bytes = 0;
     TexPoolEntry(std::unique_ptr<AbstractTexture> tex) : texture(std::move(tex)) {}
   };
   using TexAddrCache = std::multimap<u32, TCacheEntry*>;
@@ -228,10 +259,15 @@ private:
 
   void DumpTexture(TCacheEntry* entry, std::string basename, unsigned int level, bool is_arbitrary);
   void CheckTempSize(size_t required_size);
+  void UpdateDecodeCache();
 
   TCacheEntry* AllocateCacheEntry(const TextureConfig& config);
   std::unique_ptr<AbstractTexture> AllocateTexture(const TextureConfig& config);
   TexPool::iterator FindMatchingTextureFromPool(const TextureConfig& config);
+  void ReturnToPool(std::unique_ptr<AbstractTexture> texture);
+  TexPool::iterator EraseFromPool(TexPool::iterator iter);
+  // Destroys the least recently returned textures while the pool exceeds its VRAM budget.
+  void EvictFromPool();
   TexAddrCache::iterator GetTexCacheIter(TCacheEntry* entry);
 
   // Return all possible overlapping textures. As addr+size of the textures is not
@@ -248,11 +284,23 @@ private:
   // Removes and unlinks texture from texture cache and returns it to the pool
   TexAddrCache::iterator InvalidateTexture(TexAddrCache::iterator t_iter);
 
+  // Invalidates the least recently used custom textures while they exceed the VRAM budget.
+  void EvictCustomTextures(int frame_count);
+
   TCacheEntry* ReturnEntry(unsigned int stage, TCacheEntry* entry);
 
   TexAddrCache textures_by_address;
   TexHashCache textures_by_hash;
   TexPool texture_pool;
+  size_t texture_pool_size = 0;
+
+  // Memory ranges of the deferred EFB copies, and the entries which can only be hashed once they
+  // have been written.
+  std::vector<std::pair<u32, u32>> pending_efb_copy_ranges;
+  std::vector<TCacheEntry*> pending_efb_copy_entries;
+
+  // Decoded textures from previous sessions, if bCacheDecodedTextures is enabled.
+  std::unique_ptr<TextureDecodeCache> decode_cache;
 
   // Backup configuration values
   struct BackupConfig
@@ -262,10 +310,14 @@ private:
     bool texfmt_overlay_center;
     bool hires_textures;
     bool cache_hires_textures;
+    bool async_hires_textures;
+    int hires_texture_cache_size;
+    bool cache_decoded_textures;
     bool copy_cache_enable;
     bool stereo_3d;
     bool efb_mono_depth;
     bool gpu_texture_decoding;
+    bool texture_write_tracking;
   };
   BackupConfig backup_config = {};
 };
@@ -0,0 +1,126 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoCommon/TextureDecodeCache.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+#include "Common/Version.h"
+
+namespace
+{
+constexpr u32 CACHE_MAGIC = 0x58455444;  // 'DTEX'
+constexpr u32 CACHE_VERSION = 1;
+
+struct Header
+{
+  u32 magic;
+  u32 version;
+  char scm_rev[40];
+};
+
+Header GetExpectedHeader()
+{
+  Header header = {};
+  header.magic = CACHE_MAGIC;
+  header.version = CACHE_VERSION;
+  // Null-terminator is intentionally not copied.
+  std::memcpy(header.scm_rev, Common::scm_rev_git_str.c_str(),
+              std::min(Common::scm_rev_git_str.size(), sizeof(header.scm_rev)));
+  return header;
+}
+}
+
+TextureDecodeCache::TextureDecodeCache(const std::string& filename)
+{
+  if (File::Exists(filename) && m_file.Open(filename, "r+b") && ReadIndex())
+  {
+    INFO_LOG(VIDEO, "Loaded %zu decoded textures from %s", m_entries.size(), filename.c_str());
+    return;
+  }
+
+  m_entries.clear();
+  if (!m_file.Open(filename, "w+b"))
+  {
+    ERROR_LOG(VIDEO, "Failed to create texture decode cache %s", filename.c_str());
+    return;
+  }
+  WriteHeader();
+}
+
+bool TextureDecodeCache::ReadIndex()
+{
+  const Header expected = GetExpectedHeader();
+  Header header;
+  if (!m_file.ReadBytes(&header, sizeof(header)) || std::memcmp(&header, &expected, sizeof(header)))
+    return false;
+
+  // Only the keys are read here. The data stays on disk until a texture is actually used.
+  const u64 file_size = m_file.GetSize();
+  u64 offset = sizeof(Header);
+  Key key;
+  u32 data_size;
+  while (offset + sizeof(key) + sizeof(data_size) <= file_size &&
+         m_file.ReadBytes(&key, sizeof(key)) && m_file.ReadBytes(&data_size, sizeof(data_size)))
+  {
+    const u64 data_offset = offset + sizeof(key) + sizeof(data_size);
+    if (data_offset + data_size > file_size)
+      break;
+
+    m_entries[key] = {data_offset, data_size};
+    offset = data_offset + data_size;
+    if (!m_file.Seek(offset, SEEK_SET))
+      break;
+  }
+
+  // Drop a truncated entry at the end, e.g. from a crash while writing it.
+  m_file.Clear();
+  m_end_offset = offset;
+  return true;
+}
+
+void TextureDecodeCache::WriteHeader()
+{
+  const Header header = GetExpectedHeader();
+  m_file.WriteBytes(&header, sizeof(header));
+  m_end_offset = sizeof(header);
+}
+
+size_t TextureDecodeCache::Lookup(const Key& key, u8* dst, size_t dst_size)
+{
+  auto iter = m_entries.find(key);
+  if (iter == m_entries.end() || iter->second.size > dst_size)
+    return 0;
+
+  if (!m_file.Seek(iter->second.offset, SEEK_SET) || !m_file.ReadBytes(dst, iter->second.size))
+  {
+    m_file.Clear();
+    m_entries.erase(iter);
+    return 0;
+  }
+
+  return iter->second.size;
+}
+
+void TextureDecodeCache::Insert(const Key& key, const u8* data, size_t data_size)
+{
+  if (!IsOpen() || m_entries.count(key))
+    return;
+
+  const u32 size = static_cast<u32>(data_size);
+  if (!m_file.Seek(m_end_offset, SEEK_SET) || !m_file.WriteBytes(&key, sizeof(key)) ||
+      !m_file.WriteBytes(&size, sizeof(size)) || !m_file.WriteBytes(data, size))
+  {
+    // Leave m_end_offset alone so that the partial entry gets overwritten by the next one.
+    m_file.Clear();
+    return;
+  }
+
+  m_entries[key] = {m_end_offset + sizeof(key) + sizeof(size), size};
+  m_end_offset += sizeof(key) + sizeof(size) + size;
+}
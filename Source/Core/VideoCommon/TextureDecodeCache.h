@@ -0,0 +1,76 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+
+#include "Common/CommonTypes.h"
+#include "Common/File.h"
+
+// Persistent store of CPU-decoded textures, keyed by the same hash the texture cache uses to tell
+// textures apart. Loading a texture that was decoded in an earlier session is then a single read
+// instead of a TexDecoder_Decode call per mip level.
+//
+// On disk format:
+// header{
+//   u32 'DTEX';
+//   u32 version;
+//   char scm_rev[40];
+// }
+// entry{
+//   Key key;
+//   u32 data_size;
+//   u8 data[data_size];  // RGBA8 levels, each at its block-aligned size, largest first
+// }
+class TextureDecodeCache
+{
+public:
+  struct Key
+  {
+    u64 hash;
+    u32 format;  // texture format | (tlut format << 8)
+    u16 width;
+    u16 height;
+    u32 levels;
+    u32 pad;
+
+    bool operator==(const Key& other) const
+    {
+      return hash == other.hash && format == other.format && width == other.width &&
+             height == other.height && levels == other.levels;
+    }
+  };
+
+  explicit TextureDecodeCache(const std::string& filename);
+
+  bool IsOpen() const { return m_file.IsOpen(); }
+  // Copies the decoded data for key into dst. Returns the number of bytes copied, or 0 if the key
+  // isn't in the cache or its data would not fit into dst_size bytes.
+  size_t Lookup(const Key& key, u8* dst, size_t dst_size);
+  void Insert(const Key& key, const u8* data, size_t data_size);
+
+  size_t GetNumEntries() const { return m_entries.size(); }
+
+private:
+  struct KeyHash
+  {
+    size_t operator()(const Key& key) const { return static_cast<size_t>(key.hash); }
+  };
+  struct Location
+  {
+    u64 offset;
+    u32 size;
+  };
+
+  bool ReadIndex();
+  void WriteHeader();
+
+  File::IOFile m_file;
+  std::unordered_map<Key, Location, KeyHash> m_entries;
+  // Where the next entry gets appended; anything past this is a partially written entry.
+  u64 m_end_offset = 0;
+};
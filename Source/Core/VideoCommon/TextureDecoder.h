@@ -102,6 +102,10 @@ void TexDecoder_Decode(u8* dst, const u8* src, int width, int height, TextureFor
                        const u8* tlut, TLUTFormat tlutfmt);
 void TexDecoder_DecodeRGBA8FromTmem(u8* dst, const u8* src_ar, const u8* src_gb, int width,
                                     int height);
+// Rebuilds the main memory layout of an RGBA8 texture from the two TMEM banks it was split across,
+// which only requires copying the AR and GB halves of each block next to each other.
+void TexDecoder_InterleaveRGBA8FromTmem(u8* dst, const u8* src_ar, const u8* src_gb, int width,
+                                        int height);
 void TexDecoder_DecodeTexel(u8* dst, const u8* src, int s, int t, int imageWidth,
                             TextureFormat texformat, const u8* tlut, TLUTFormat tlutfmt);
 void TexDecoder_DecodeTexelRGBA8FromTmem(u8* dst, const u8* src_ar, const u8* src_gb, int s, int t,
@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 
 #include "Common/CommonTypes.h"
 #include "Common/MsgHandler.h"
@@ -649,13 +650,34 @@ void TexDecoder_DecodeTexelRGBA8FromTmem(u8* dst, const u8* src_ar, const u8* sr
 void TexDecoder_DecodeRGBA8FromTmem(u8* dst, const u8* src_ar, const u8* src_gb, int width,
                                     int height)
 {
-  // TODO for someone who cares: Make this less slow!
-  for (int y = 0; y < height; ++y)
+  // Each 4x4 block takes 32 bytes in both banks, and the blocks are stored in row order.
+  for (int y = 0; y < height; y += 4)
   {
-    for (int x = 0; x < width; ++x)
+    for (int x = 0; x < width; x += 4, src_ar += 32, src_gb += 32)
     {
-      TexDecoder_DecodeTexelRGBA8FromTmem(dst, src_ar, src_gb, x, y, width - 1);
-      dst += 4;
+      for (int iy = 0; iy < 4; iy++)
+      {
+        u8* row = dst + ((y + iy) * width + x) * 4;
+        for (int ix = 0; ix < 4; ix++)
+        {
+          const int offset = (iy * 4 + ix) * 2;
+          row[ix * 4 + 0] = src_ar[offset + 1];  // R
+          row[ix * 4 + 1] = src_gb[offset];      // G
+          row[ix * 4 + 2] = src_gb[offset + 1];  // B
+          row[ix * 4 + 3] = src_ar[offset];      // A
+        }
+      }
     }
   }
 }
+
+void TexDecoder_InterleaveRGBA8FromTmem(u8* dst, const u8* src_ar, const u8* src_gb, int width,
+                                        int height)
+{
+  const int num_blocks = (width / 4) * (height / 4);
+  for (int i = 0; i < num_blocks; i++, dst += 64, src_ar += 32, src_gb += 32)
+  {
+    std::memcpy(dst, src_ar, 32);
+    std::memcpy(dst + 32, src_gb, 32);
+  }
+}
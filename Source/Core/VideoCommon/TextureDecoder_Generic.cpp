@@ -4,6 +4,11 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
+
+#ifdef _M_ARM_64
+#include <arm_neon.h>
+#endif
 
 #include "Common/CPUDetect.h"
 #include "Common/CommonTypes.h"
@@ -72,25 +77,28 @@ static inline u32 DecodePixel_Paletted(u16 pixel, TLUTFormat tlutfmt)
   }
 }
 
-static inline void DecodeBytes_C4(u32* dst, const u8* src, const u8* tlut_, TLUTFormat tlutfmt)
+// Decodes the whole TLUT up front, so that paletted texels only need a single lookup.
+static void DecodePalette(u32* palette, const u8* tlut_, TLUTFormat tlutfmt, int count)
 {
   const u16* tlut = (u16*)tlut_;
+  for (int i = 0; i < count; i++)
+    palette[i] = DecodePixel_Paletted(tlut[i], tlutfmt);
+}
+
+static inline void DecodeBytes_C4(u32* dst, const u8* src, const u32* palette)
+{
   for (int x = 0; x < 4; x++)
   {
     u8 val = src[x];
-    *dst++ = DecodePixel_Paletted(tlut[val >> 4], tlutfmt);
-    *dst++ = DecodePixel_Paletted(tlut[val & 0xF], tlutfmt);
+    *dst++ = palette[val >> 4];
+    *dst++ = palette[val & 0xF];
   }
 }
 
-static inline void DecodeBytes_C8(u32* dst, const u8* src, const u8* tlut_, TLUTFormat tlutfmt)
+static inline void DecodeBytes_C8(u32* dst, const u8* src, const u32* palette)
 {
-  const u16* tlut = (u16*)tlut_;
   for (int x = 0; x < 8; x++)
-  {
-    u8 val = src[x];
-    *dst++ = DecodePixel_Paletted(tlut[val], tlutfmt);
-  }
+    *dst++ = palette[src[x]];
 }
 
 static inline void DecodeBytes_C14X2(u32* dst, const u16* src, const u8* tlut_, TLUTFormat tlutfmt)
@@ -142,10 +150,8 @@ static inline void DecodeBytes_RGBA8(u32* dst, const u16* src, const u16* src2)
 #endif
 }
 
-static void DecodeDXTBlock(u32* dst, const DXTBlock* src, int pitch)
+static void DecodeDXTColors(u32* colors, const DXTBlock* src)
 {
-  // S3TC Decoder (Note: GCN decodes differently from PC so we can't use native support)
-  // Needs more speed.
   u16 c1 = Common::swap16(src->color1);
   u16 c2 = Common::swap16(src->color2);
   int blue1 = Convert5To8(c1 & 0x1F);
@@ -154,7 +160,6 @@ static void DecodeDXTBlock(u32* dst, const DXTBlock* src, int pitch)
   int green2 = Convert6To8((c2 >> 5) & 0x3F);
   int red1 = Convert5To8((c1 >> 11) & 0x1F);
   int red2 = Convert5To8((c2 >> 11) & 0x1F);
-  int colors[4];
   colors[0] = MakeRGBA(red1, green1, blue1, 255);
   colors[1] = MakeRGBA(red2, green2, blue2, 255);
   if (c1 > c2)
@@ -171,6 +176,13 @@ static void DecodeDXTBlock(u32* dst, const DXTBlock* src, int pitch)
     colors[2] = MakeRGBA((red1 + red2) / 2, (green1 + green2) / 2, (blue1 + blue2) / 2, 255);
     colors[3] = MakeRGBA((red1 + red2) / 2, (green1 + green2) / 2, (blue1 + blue2) / 2, 0);
   }
+}
+
+static void DecodeDXTBlock(u32* dst, const DXTBlock* src, int pitch)
+{
+  // S3TC Decoder (Note: GCN decodes differently from PC so we can't use native support)
+  u32 colors[4];
+  DecodeDXTColors(colors, src);
 
   for (int y = 0; y < 4; y++)
   {
@@ -184,6 +196,307 @@ static void DecodeDXTBlock(u32* dst, const DXTBlock* src, int pitch)
   }
 }
 
+#ifdef _M_ARM_64
+// NEON versions of the decoders. ASIMD is a mandatory part of ARMv8, but it is still checked
+// through cpu_info like the x64 instruction set extensions are.
+
+// Interleaves the channels of 8 texels and stores them as two rows of 4.
+static inline void StoreRGBA_NEON(u32* row0, u32* row1, uint8x8_t r, uint8x8_t g, uint8x8_t b,
+                                  uint8x8_t a)
+{
+  const uint8x8x2_t rg = vzip_u8(r, g);
+  const uint8x8x2_t ba = vzip_u8(b, a);
+  const uint16x4x2_t texels03 =
+      vzip_u16(vreinterpret_u16_u8(rg.val[0]), vreinterpret_u16_u8(ba.val[0]));
+  const uint16x4x2_t texels47 =
+      vzip_u16(vreinterpret_u16_u8(rg.val[1]), vreinterpret_u16_u8(ba.val[1]));
+  vst1q_u16((u16*)row0, vcombine_u16(texels03.val[0], texels03.val[1]));
+  vst1q_u16((u16*)row1, vcombine_u16(texels47.val[0], texels47.val[1]));
+}
+
+static void TexDecoder_DecodeImpl_C4_NEON(u32* dst, const u8* src, int width, int height,
+                                          const u8* tlut, TLUTFormat tlutfmt, int Wsteps8)
+{
+  // The 16 entry palette is exactly 64 bytes, so texels can be looked up with a table instruction.
+  u32 palette[16];
+  DecodePalette(palette, tlut, tlutfmt, 16);
+  uint8x16x4_t table;
+  for (int i = 0; i < 4; i++)
+    table.val[i] = vld1q_u8((const u8*)(palette + 4 * i));
+
+  static const u8 kExpandLo[16] = {0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3};
+  static const u8 kExpandHi[16] = {4, 4, 4, 4, 5, 5, 5, 5, 6, 6, 6, 6, 7, 7, 7, 7};
+  static const u8 kByteOffset[16] = {0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3};
+  const uint8x16_t expand_lo = vld1q_u8(kExpandLo);
+  const uint8x16_t expand_hi = vld1q_u8(kExpandHi);
+  const uint8x16_t byte_offset = vld1q_u8(kByteOffset);
+  for (int y = 0; y < height; y += 8)
+  {
+    for (int x = 0, yStep = (y / 8) * Wsteps8; x < width; x += 8, yStep++)
+    {
+      for (int iy = 0, xStep = 8 * yStep; iy < 8; iy++, xStep++)
+      {
+        u32 val;
+        std::memcpy(&val, src + 4 * xStep, sizeof(val));
+        const uint8x8_t r = vcreate_u8(val);
+        // The first texel of every byte is in the high nibble.
+        const uint8x8_t indices = vzip_u8(vshr_n_u8(r, 4), vand_u8(r, vdup_n_u8(0x0f))).val[0];
+        const uint8x16_t offsets = vcombine_u8(vshl_n_u8(indices, 2), vshl_n_u8(indices, 2));
+        const uint8x16_t lo = vaddq_u8(vqtbl1q_u8(offsets, expand_lo), byte_offset);
+        const uint8x16_t hi = vaddq_u8(vqtbl1q_u8(offsets, expand_hi), byte_offset);
+
+        u8* row = (u8*)(dst + (y + iy) * width + x);
+        vst1q_u8(row, vqtbl4q_u8(table, lo));
+        vst1q_u8(row + 16, vqtbl4q_u8(table, hi));
+      }
+    }
+  }
+}
+
+static void TexDecoder_DecodeImpl_I4_NEON(u32* dst, const u8* src, int width, int height)
+{
+  static const u8 kShuffle[16] = {0, 0, 0, 0, 8, 8, 8, 8, 1, 1, 1, 1, 9, 9, 9, 9};
+  const uint8x16_t mask0 = vld1q_u8(kShuffle);
+  const uint8x16_t mask1 = vaddq_u8(mask0, vdupq_n_u8(2));
+  const uint8x16_t mask2 = vaddq_u8(mask0, vdupq_n_u8(4));
+  const uint8x16_t mask3 = vaddq_u8(mask0, vdupq_n_u8(6));
+  for (int y = 0; y < height; y += 8)
+  {
+    for (int x = 0; x < width; x += 8)
+    {
+      for (int iy = 0; iy < 8; iy += 2, src += 8)
+      {
+        const uint8x8_t r = vld1_u8(src);
+        // Replicate both nibbles of every byte: (r & 0xf0) | (r >> 4) and (r << 4) | (r & 0x0f).
+        const uint8x8_t i1 = vsra_n_u8(vand_u8(r, vdup_n_u8(0xf0)), r, 4);
+        const uint8x8_t i2 = vsli_n_u8(r, r, 4);
+        const uint8x16_t base = vcombine_u8(i1, i2);
+
+        u8* row0 = (u8*)(dst + (y + iy) * width + x);
+        u8* row1 = (u8*)(dst + (y + iy + 1) * width + x);
+        vst1q_u8(row0, vqtbl1q_u8(base, mask0));
+        vst1q_u8(row0 + 16, vqtbl1q_u8(base, mask1));
+        vst1q_u8(row1, vqtbl1q_u8(base, mask2));
+        vst1q_u8(row1 + 16, vqtbl1q_u8(base, mask3));
+      }
+    }
+  }
+}
+
+static void TexDecoder_DecodeImpl_I8_NEON(u32* dst, const u8* src, int width, int height)
+{
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0; x < width; x += 8)
+    {
+      for (int iy = 0; iy < 4; iy++, src += 8)
+      {
+        const uint8x8_t i = vld1_u8(src);
+        const uint8x8x4_t texels = {{i, i, i, i}};
+        vst4_u8((u8*)(dst + (y + iy) * width + x), texels);
+      }
+    }
+  }
+}
+
+static void TexDecoder_DecodeImpl_IA4_NEON(u32* dst, const u8* src, int width, int height,
+                                           int Wsteps8)
+{
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0, yStep = (y / 4) * Wsteps8; x < width; x += 8, yStep++)
+    {
+      for (int iy = 0, xStep = 4 * yStep; iy < 4; iy++, xStep++)
+      {
+        const uint8x8_t r = vld1_u8(src + 8 * xStep);
+        const uint8x8_t a = vsra_n_u8(vand_u8(r, vdup_n_u8(0xf0)), r, 4);
+        const uint8x8_t l = vsli_n_u8(r, r, 4);
+        const uint8x8x4_t texels = {{l, l, l, a}};
+        vst4_u8((u8*)(dst + (y + iy) * width + x), texels);
+      }
+    }
+  }
+}
+
+static void TexDecoder_DecodeImpl_IA8_NEON(u32* dst, const u8* src, int width, int height)
+{
+  // Every texel is stored as (alpha, intensity).
+  static const u8 kShuffle[16] = {1, 1, 1, 0, 3, 3, 3, 2, 5, 5, 5, 4, 7, 7, 7, 6};
+  const uint8x16_t mask0 = vld1q_u8(kShuffle);
+  const uint8x16_t mask1 = vaddq_u8(mask0, vdupq_n_u8(8));
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0; x < width; x += 4)
+    {
+      for (int iy = 0; iy < 4; iy += 2, src += 16)
+      {
+        const uint8x16_t r = vld1q_u8(src);
+        vst1q_u8((u8*)(dst + (y + iy) * width + x), vqtbl1q_u8(r, mask0));
+        vst1q_u8((u8*)(dst + (y + iy + 1) * width + x), vqtbl1q_u8(r, mask1));
+      }
+    }
+  }
+}
+
+static void TexDecoder_DecodeImpl_RGB565_NEON(u32* dst, const u8* src, int width, int height)
+{
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0; x < width; x += 4)
+    {
+      for (int iy = 0; iy < 4; iy += 2, src += 16)
+      {
+        const uint16x8_t val = vreinterpretq_u16_u8(vrev16q_u8(vld1q_u8(src)));
+        const uint16x8_t r5 = vshrq_n_u16(val, 11);
+        const uint16x8_t g6 = vandq_u16(vshrq_n_u16(val, 5), vdupq_n_u16(0x3f));
+        const uint16x8_t b5 = vandq_u16(val, vdupq_n_u16(0x1f));
+        const uint8x8_t r = vmovn_u16(vorrq_u16(vshlq_n_u16(r5, 3), vshrq_n_u16(r5, 2)));
+        const uint8x8_t g = vmovn_u16(vorrq_u16(vshlq_n_u16(g6, 2), vshrq_n_u16(g6, 4)));
+        const uint8x8_t b = vmovn_u16(vorrq_u16(vshlq_n_u16(b5, 3), vshrq_n_u16(b5, 2)));
+        StoreRGBA_NEON(dst + (y + iy) * width + x, dst + (y + iy + 1) * width + x, r, g, b,
+                       vdup_n_u8(0xff));
+      }
+    }
+  }
+}
+
+static void TexDecoder_DecodeImpl_RGB5A3_NEON(u32* dst, const u8* src, int width, int height)
+{
+  const uint16x8_t kMask_x0f = vdupq_n_u16(0x0f);
+  const uint16x8_t kMask_x1f = vdupq_n_u16(0x1f);
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0; x < width; x += 4)
+    {
+      for (int iy = 0; iy < 4; iy += 2, src += 16)
+      {
+        const uint16x8_t val = vreinterpretq_u16_u8(vrev16q_u8(vld1q_u8(src)));
+        const uint16x8_t opaque = vtstq_u16(val, vdupq_n_u16(0x8000));
+
+        // Opaque texels are RGB555.
+        const uint16x8_t r5 = vandq_u16(vshrq_n_u16(val, 10), kMask_x1f);
+        const uint16x8_t g5 = vandq_u16(vshrq_n_u16(val, 5), kMask_x1f);
+        const uint16x8_t b5 = vandq_u16(val, kMask_x1f);
+        const uint16x8_t r8 = vorrq_u16(vshlq_n_u16(r5, 3), vshrq_n_u16(r5, 2));
+        const uint16x8_t g8 = vorrq_u16(vshlq_n_u16(g5, 3), vshrq_n_u16(g5, 2));
+        const uint16x8_t b8 = vorrq_u16(vshlq_n_u16(b5, 3), vshrq_n_u16(b5, 2));
+
+        // The others are ARGB3444.
+        const uint16x8_t a3 = vandq_u16(vshrq_n_u16(val, 12), vdupq_n_u16(0x07));
+        const uint16x8_t r4 = vandq_u16(vshrq_n_u16(val, 8), kMask_x0f);
+        const uint16x8_t g4 = vandq_u16(vshrq_n_u16(val, 4), kMask_x0f);
+        const uint16x8_t b4 = vandq_u16(val, kMask_x0f);
+        const uint16x8_t a = vorrq_u16(vorrq_u16(vshlq_n_u16(a3, 5), vshlq_n_u16(a3, 2)),
+                                       vshrq_n_u16(a3, 1));
+
+        StoreRGBA_NEON(dst + (y + iy) * width + x, dst + (y + iy + 1) * width + x,
+                       vmovn_u16(vbslq_u16(opaque, r8, vsliq_n_u16(r4, r4, 4))),
+                       vmovn_u16(vbslq_u16(opaque, g8, vsliq_n_u16(g4, g4, 4))),
+                       vmovn_u16(vbslq_u16(opaque, b8, vsliq_n_u16(b4, b4, 4))),
+                       vmovn_u16(vbslq_u16(opaque, vdupq_n_u16(0xff), a)));
+      }
+    }
+  }
+}
+
+static void TexDecoder_DecodeImpl_RGBA8_NEON(u32* dst, const u8* src, int width, int height)
+{
+  // A block is 16 (alpha, red) pairs followed by 16 (green, blue) pairs.
+  static const u8 kShuffle[16] = {1, 16, 17, 0, 3, 18, 19, 2, 5, 20, 21, 4, 7, 22, 23, 6};
+  const uint8x16_t mask0 = vld1q_u8(kShuffle);
+  const uint8x16_t mask1 = vaddq_u8(mask0, vdupq_n_u8(8));
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0; x < width; x += 4, src += 64)
+    {
+      for (int iy = 0; iy < 4; iy += 2)
+      {
+        const uint8x16x2_t table = {{vld1q_u8(src + 8 * iy), vld1q_u8(src + 32 + 8 * iy)}};
+        vst1q_u8((u8*)(dst + (y + iy) * width + x), vqtbl2q_u8(table, mask0));
+        vst1q_u8((u8*)(dst + (y + iy + 1) * width + x), vqtbl2q_u8(table, mask1));
+      }
+    }
+  }
+}
+
+static void DecodeDXTBlock_NEON(u32* dst, const DXTBlock* src, int pitch)
+{
+  u32 colors[4];
+  DecodeDXTColors(colors, src);
+  const uint8x16_t table = vld1q_u8((const u8*)colors);
+
+  // Moves the 2-bit index of every texel in a row to the bottom of its four bytes, the first
+  // texel being in the top bits.
+  static const s8 kShift[16] = {-6, -6, -6, -6, -4, -4, -4, -4, -2, -2, -2, -2, 0, 0, 0, 0};
+  static const u8 kByteOffset[16] = {0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3};
+  const int8x16_t shift = vld1q_s8(kShift);
+  const uint8x16_t byte_offset = vld1q_u8(kByteOffset);
+  for (int y = 0; y < 4; y++)
+  {
+    const uint8x16_t indices = vandq_u8(vshlq_u8(vdupq_n_u8(src->lines[y]), shift), vdupq_n_u8(3));
+    vst1q_u8((u8*)dst, vqtbl1q_u8(table, vsliq_n_u8(byte_offset, indices, 2)));
+    dst += pitch;
+  }
+}
+
+static void TexDecoder_DecodeImpl_CMPR_NEON(u32* dst, const u8* src, int width, int height)
+{
+  for (int y = 0; y < height; y += 8)
+  {
+    for (int x = 0; x < width; x += 8)
+    {
+      const DXTBlock* blocks = (const DXTBlock*)src;
+      DecodeDXTBlock_NEON(dst + y * width + x, &blocks[0], width);
+      DecodeDXTBlock_NEON(dst + y * width + x + 4, &blocks[1], width);
+      DecodeDXTBlock_NEON(dst + (y + 4) * width + x, &blocks[2], width);
+      DecodeDXTBlock_NEON(dst + (y + 4) * width + x + 4, &blocks[3], width);
+      src += 4 * sizeof(DXTBlock);
+    }
+  }
+}
+
+// Returns false for the formats which don't have a NEON version.
+static bool TexDecoder_DecodeImpl_NEON(u32* dst, const u8* src, int width, int height,
+                                       TextureFormat texformat, const u8* tlut, TLUTFormat tlutfmt)
+{
+  const int Wsteps8 = (width + 7) / 8;
+
+  switch (texformat)
+  {
+  case TextureFormat::C4:
+    TexDecoder_DecodeImpl_C4_NEON(dst, src, width, height, tlut, tlutfmt, Wsteps8);
+    return true;
+  case TextureFormat::I4:
+    TexDecoder_DecodeImpl_I4_NEON(dst, src, width, height);
+    return true;
+  case TextureFormat::I8:
+    TexDecoder_DecodeImpl_I8_NEON(dst, src, width, height);
+    return true;
+  case TextureFormat::IA4:
+    TexDecoder_DecodeImpl_IA4_NEON(dst, src, width, height, Wsteps8);
+    return true;
+  case TextureFormat::IA8:
+    TexDecoder_DecodeImpl_IA8_NEON(dst, src, width, height);
+    return true;
+  case TextureFormat::RGB565:
+    TexDecoder_DecodeImpl_RGB565_NEON(dst, src, width, height);
+    return true;
+  case TextureFormat::RGB5A3:
+    TexDecoder_DecodeImpl_RGB5A3_NEON(dst, src, width, height);
+    return true;
+  case TextureFormat::RGBA8:
+    TexDecoder_DecodeImpl_RGBA8_NEON(dst, src, width, height);
+    return true;
+  case TextureFormat::CMPR:
+    TexDecoder_DecodeImpl_CMPR_NEON(dst, src, width, height);
+    return true;
+  default:
+    // C8 and C14X2 are palette lookups, which the scalar code already does as well as NEON can.
+    return false;
+  }
+}
+#endif
+
 // JSD 01/06/11:
 // TODO: we really should ensure BOTH the source and destination addresses are aligned to 16-byte
 // boundaries to
@@ -198,17 +511,29 @@ static void DecodeDXTBlock(u32* dst, const DXTBlock* src, int pitch)
 void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, TextureFormat texformat,
                             const u8* tlut, TLUTFormat tlutfmt)
 {
+#ifdef _M_ARM_64
+  if (cpu_info.bASIMD &&
+      TexDecoder_DecodeImpl_NEON(dst, src, width, height, texformat, tlut, tlutfmt))
+  {
+    return;
+  }
+#endif
+
   const int Wsteps4 = (width + 3) / 4;
   const int Wsteps8 = (width + 7) / 8;
 
   switch (texformat)
   {
   case TextureFormat::C4:
+  {
+    u32 palette[16];
+    DecodePalette(palette, tlut, tlutfmt, 16);
     for (int y = 0; y < height; y += 8)
       for (int x = 0, yStep = (y / 8) * Wsteps8; x < width; x += 8, yStep++)
         for (int iy = 0, xStep = 8 * yStep; iy < 8; iy++, xStep++)
-          DecodeBytes_C4(dst + (y + iy) * width + x, src + 4 * xStep, tlut, tlutfmt);
-    break;
+          DecodeBytes_C4(dst + (y + iy) * width + x, src + 4 * xStep, palette);
+  }
+  break;
   case TextureFormat::I4:
   {
     // Reference C implementation:
@@ -256,11 +581,15 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
   }
   break;
   case TextureFormat::C8:
+  {
+    u32 palette[256];
+    DecodePalette(palette, tlut, tlutfmt, 256);
     for (int y = 0; y < height; y += 4)
       for (int x = 0, yStep = (y / 4) * Wsteps8; x < width; x += 8, yStep++)
         for (int iy = 0, xStep = 4 * yStep; iy < 4; iy++, xStep++)
-          DecodeBytes_C8((u32*)dst + (y + iy) * width + x, src + 8 * xStep, tlut, tlutfmt);
-    break;
+          DecodeBytes_C8((u32*)dst + (y + iy) * width + x, src + 8 * xStep, palette);
+  }
+  break;
   case TextureFormat::IA4:
   {
     for (int y = 0; y < height; y += 4)
@@ -0,0 +1,140 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoCommon/TextureHashPrefetcher.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "Common/Hash.h"
+#include "Common/ThreadPool.h"
+#include "Core/HW/Memmap.h"
+#include "VideoCommon/VideoConfig.h"
+
+namespace TextureHashPrefetcher
+{
+namespace
+{
+// Number of cleanups an unused hash survives.
+constexpr u32 MAX_AGE = 2;
+
+struct Entry
+{
+  u64 write_token;
+  u64 hash;
+  int samples;
+  u32 generation;
+  bool ready;
+};
+
+std::mutex s_lock;
+std::unordered_map<u64, Entry> s_entries;
+std::atomic<u32> s_generation{0};
+std::unique_ptr<Common::TaskGroup> s_tasks;
+
+u64 MakeKey(u32 address, u32 size)
+{
+  return (static_cast<u64>(address) << 32) | size;
+}
+
+void HashRange(u32 address, u32 size, int samples)
+{
+  const u8* ptr = Memory::GetPointer(address);
+  const u64 hash = ptr ? GetHash64(ptr, size, samples) : 0;
+
+  std::lock_guard<std::mutex> guard(s_lock);
+  auto iter = s_entries.find(MakeKey(address, size));
+  if (iter == s_entries.end())
+    return;
+  if (!ptr)
+  {
+    s_entries.erase(iter);
+    return;
+  }
+  iter->second.hash = hash;
+  iter->second.ready = true;
+}
+}
+
+void Init()
+{
+  s_generation = 0;
+  s_tasks = std::make_unique<Common::TaskGroup>();
+}
+
+void Shutdown()
+{
+  if (!s_tasks)
+    return;
+
+  s_tasks.reset();
+  std::lock_guard<std::mutex> guard(s_lock);
+  s_entries.clear();
+}
+
+void Prefetch(u32 address, u32 size)
+{
+  if (!s_tasks || !g_ActiveConfig.bTextureWriteTracking || !Memory::IsDirtyPageTrackingEnabled())
+    return;
+
+  const int samples = g_ActiveConfig.iSafeTextureCache_ColorSamples;
+  const u64 key = MakeKey(address, size);
+  {
+    std::lock_guard<std::mutex> guard(s_lock);
+    auto iter = s_entries.find(key);
+    if (iter != s_entries.end() && iter->second.samples == samples &&
+        !Memory::IsModifiedSince(address, size, iter->second.write_token))
+    {
+      iter->second.generation = s_generation;
+      return;
+    }
+
+    // Protecting the range before it is hashed makes sure that no write in between is missed.
+    const u64 write_token = Memory::ProtectRange(address, size);
+    if (write_token == 0)
+    {
+      if (iter != s_entries.end())
+        s_entries.erase(iter);
+      return;
+    }
+    s_entries[key] = {write_token, 0, samples, s_generation, false};
+  }
+  s_tasks->Schedule([address, size, samples] { HashRange(address, size, samples); });
+}
+
+bool GetHash(u32 address, u32 size, int samples, u64* hash, u64* write_token)
+{
+  std::lock_guard<std::mutex> guard(s_lock);
+  auto iter = s_entries.find(MakeKey(address, size));
+  if (iter == s_entries.end() || !iter->second.ready || iter->second.samples != samples)
+    return false;
+
+  if (Memory::IsModifiedSince(address, size, iter->second.write_token))
+  {
+    s_entries.erase(iter);
+    return false;
+  }
+
+  *hash = iter->second.hash;
+  *write_token = iter->second.write_token;
+  iter->second.generation = s_generation;
+  return true;
+}
+
+void Cleanup()
+{
+  const u32 generation = ++s_generation;
+
+  std::lock_guard<std::mutex> guard(s_lock);
+  for (auto iter = s_entries.begin(); iter != s_entries.end();)
+  {
+    if (generation - iter->second.generation > MAX_AGE)
+      iter = s_entries.erase(iter);
+    else
+      ++iter;
+  }
+}
+}
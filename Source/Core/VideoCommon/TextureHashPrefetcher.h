@@ -0,0 +1,29 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include "Common/CommonTypes.h"
+
+// Hashes textures on the shared thread pool as soon as the FIFO preprocessor sees their address
+// being set, so that the texture cache usually finds the hash of a texture ready when it is bound.
+// Prefetched hashes are only valid while memory write tracking says the range is unmodified, so
+// this does nothing without write tracking, and it only sees commands in the deterministic
+// dual core mode, where the CPU thread preprocesses the FIFO.
+namespace TextureHashPrefetcher
+{
+void Init();
+void Shutdown();
+
+// Called from the CPU thread when the FIFO preprocessor sets the address of a texture.
+void Prefetch(u32 address, u32 size);
+
+// Called from the GPU thread. Returns true and the hash and write token of the range if a
+// prefetched hash is ready, was computed with the same number of samples, and the memory
+// wasn't written to since.
+bool GetHash(u32 address, u32 size, int samples, u64* hash, u64* write_token);
+
+// Drops the hashes that haven't been used for a few frames.
+void Cleanup();
+}
@@ -0,0 +1,261 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoCommon/TexturePack.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include <xxhash.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "Common/Align.h"
+#include "Common/CommonTypes.h"
+#include "Common/File.h"
+#include "Common/Logging/Log.h"
+#include "Common/StringUtil.h"
+#include "VideoCommon/TextureConfig.h"
+
+namespace TexturePack
+{
+// Texture data is aligned in the file, and thereby in memory, which some drivers upload faster.
+static constexpr u64 DATA_ALIGNMENT = 64;
+
+static u64 GetMinimumDataSize(AbstractTextureFormat format, u32 row_length, u32 height)
+{
+  const u64 blocks = static_cast<u64>((row_length + 3) / 4) * ((height + 3) / 4);
+  switch (format)
+  {
+  case AbstractTextureFormat::RGBA8:
+    return static_cast<u64>(row_length) * height * 4;
+  case AbstractTextureFormat::DXT1:
+    return blocks * 8;
+  default:
+    return blocks * 16;
+  }
+}
+
+PackReader::PackReader(const u8* data, u64 size)
+    : m_data(data), m_size(size), m_header(reinterpret_cast<const PackHeader*>(data))
+{
+}
+
+PackReader::~PackReader()
+{
+#ifdef _WIN32
+  UnmapViewOfFile(m_data);
+#else
+  munmap(const_cast<u8*>(m_data), static_cast<size_t>(m_size));
+#endif
+}
+
+std::unique_ptr<PackReader> PackReader::Open(const std::string& path)
+{
+#ifdef _WIN32
+  HANDLE file = CreateFileW(UTF8ToUTF16(path).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+    return nullptr;
+
+  LARGE_INTEGER file_size;
+  HANDLE mapping = nullptr;
+  if (GetFileSizeEx(file, &file_size) && file_size.QuadPart >= static_cast<LONGLONG>(sizeof(PackHeader)))
+    mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  // The view keeps the file open.
+  CloseHandle(file);
+  if (!mapping)
+    return nullptr;
+
+  void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  CloseHandle(mapping);
+  if (!data)
+    return nullptr;
+  const u64 size = static_cast<u64>(file_size.QuadPart);
+#else
+  const int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+    return nullptr;
+
+  struct stat file_info;
+  void* data = MAP_FAILED;
+  if (fstat(fd, &file_info) == 0 && file_info.st_size >= static_cast<off_t>(sizeof(PackHeader)))
+    data = mmap(nullptr, static_cast<size_t>(file_info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+  // The mapping keeps the file open.
+  close(fd);
+  if (data == MAP_FAILED)
+    return nullptr;
+  const u64 size = static_cast<u64>(file_info.st_size);
+#endif
+
+  std::unique_ptr<PackReader> reader(new PackReader(static_cast<const u8*>(data), size));
+  if (!reader->ReadIndex())
+  {
+    ERROR_LOG(VIDEO, "Invalid texture pack \"%s\"", path.c_str());
+    return nullptr;
+  }
+
+  return reader;
+}
+
+bool PackReader::ReadIndex()
+{
+  const PackHeader& header = *m_header;
+  if (header.magic != PACK_MAGIC || header.version != PACK_VERSION)
+    return false;
+
+  if (header.index_offset % alignof(PackEntry) != 0 || header.index_offset > m_size ||
+      header.index_size > m_size - header.index_offset)
+  {
+    return false;
+  }
+
+  const u64 tables_size = static_cast<u64>(header.num_textures) * sizeof(PackEntry) +
+                          static_cast<u64>(header.num_levels) * sizeof(PackLevel);
+  if (tables_size > header.index_size)
+    return false;
+
+  const u8* index = m_data + header.index_offset;
+  const auto* entries = reinterpret_cast<const PackEntry*>(index);
+  const auto* levels = reinterpret_cast<const PackLevel*>(entries + header.num_textures);
+  const u64 names_size = header.index_size - tables_size;
+
+  for (u32 i = 0; i < header.num_textures; i++)
+  {
+    const PackEntry& entry = entries[i];
+    if (static_cast<u64>(entry.name_offset) + entry.name_length > names_size ||
+        entry.num_levels == 0 ||
+        static_cast<u64>(entry.first_level) + entry.num_levels > header.num_levels ||
+        entry.format > static_cast<u16>(AbstractTextureFormat::BPTC))
+    {
+      return false;
+    }
+
+    const auto format = static_cast<AbstractTextureFormat>(entry.format);
+    for (u32 j = entry.first_level; j < entry.first_level + entry.num_levels; j++)
+    {
+      const PackLevel& level = levels[j];
+      if (level.offset > m_size || level.size > m_size - level.offset ||
+          level.row_length < level.width ||
+          level.size < GetMinimumDataSize(format, level.row_length, level.height))
+      {
+        return false;
+      }
+    }
+  }
+
+  m_entries = entries;
+  m_levels = levels;
+  m_names = reinterpret_cast<const char*>(index + tables_size);
+  return true;
+}
+
+std::string PackReader::GetTextureName(u32 index) const
+{
+  const PackEntry& entry = m_entries[index];
+  return std::string(m_names + entry.name_offset, entry.name_length);
+}
+
+const PackEntry* PackReader::FindTexture(const std::string& name) const
+{
+  const PackEntry* begin = m_entries;
+  const PackEntry* end = m_entries + m_header->num_textures;
+  const u64 hash = XXH64(name.data(), name.size(), 0);
+
+  auto iter = std::lower_bound(begin, end, hash,
+                               [](const PackEntry& entry, u64 h) { return entry.name_hash < h; });
+  for (; iter != end && iter->name_hash == hash; ++iter)
+  {
+    if (iter->name_length == name.size() &&
+        std::memcmp(m_names + iter->name_offset, name.data(), name.size()) == 0)
+    {
+      return iter;
+    }
+  }
+
+  return nullptr;
+}
+
+PackWriter::PackWriter(File::IOFile file) : m_file(std::move(file))
+{
+}
+
+std::unique_ptr<PackWriter> PackWriter::Create(const std::string& path)
+{
+  File::IOFile file(path, "wb");
+  if (!file)
+    return nullptr;
+
+  return std::unique_ptr<PackWriter>(new PackWriter(std::move(file)));
+}
+
+bool PackWriter::AddTexture(const std::string& name, const std::vector<HiresTexture::Level>& levels)
+{
+  if (levels.empty())
+    return false;
+
+  PackEntry entry;
+  entry.name_hash = XXH64(name.data(), name.size(), 0);
+  entry.name_offset = static_cast<u32>(m_names.size());
+  entry.name_length = static_cast<u32>(name.size());
+  entry.first_level = static_cast<u32>(m_levels.size());
+  entry.num_levels = static_cast<u16>(levels.size());
+  entry.format = static_cast<u16>(levels[0].format);
+
+  for (const HiresTexture::Level& level : levels)
+  {
+    PackLevel pack_level;
+    pack_level.offset = Common::AlignUp(m_position, DATA_ALIGNMENT);
+    pack_level.size = static_cast<u32>(level.data_size);
+    pack_level.width = level.width;
+    pack_level.height = level.height;
+    pack_level.row_length = level.row_length;
+
+    // Seeking past the end leaves the padding zeroed.
+    if (!m_file.Seek(pack_level.offset, SEEK_SET) ||
+        !m_file.WriteBytes(level.data.get(), level.data_size))
+    {
+      return false;
+    }
+
+    m_position = pack_level.offset + level.data_size;
+    m_levels.push_back(pack_level);
+  }
+
+  m_entries.push_back(entry);
+  m_names += name;
+  return true;
+}
+
+bool PackWriter::Finish()
+{
+  std::sort(m_entries.begin(), m_entries.end(),
+            [](const PackEntry& a, const PackEntry& b) { return a.name_hash < b.name_hash; });
+
+  PackHeader header;
+  header.magic = PACK_MAGIC;
+  header.version = PACK_VERSION;
+  header.num_textures = static_cast<u32>(m_entries.size());
+  header.num_levels = static_cast<u32>(m_levels.size());
+  header.index_offset = Common::AlignUp(m_position, alignof(PackEntry));
+  header.index_size = m_entries.size() * sizeof(PackEntry) + m_levels.size() * sizeof(PackLevel) +
+                      m_names.size();
+
+  return m_file.Seek(header.index_offset, SEEK_SET) &&
+         m_file.WriteArray(m_entries.data(), m_entries.size()) &&
+         m_file.WriteArray(m_levels.data(), m_levels.size()) &&
+         m_file.WriteBytes(m_names.data(), m_names.size()) && m_file.Seek(0, SEEK_SET) &&
+         m_file.WriteArray(&header, 1) && m_file.Close();
+}
+}  // namespace TexturePack
@@ -0,0 +1,108 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+// Texture packs bake a directory of custom textures into a single file, which is memory-mapped
+// instead of searching the directory and decoding every image when a game boots. Textures are
+// stored exactly as they are uploaded, so block-compressed DDS textures (BC1/BC2/BC3/BC7) keep
+// their compression and mip chains, and all other images are stored decoded to RGBA8.
+//
+// The file starts with a PackHeader, followed by the texture data. The index at the end holds a
+// PackEntry for every texture, sorted by the hash of its name, then the PackLevel table and the
+// names the entries refer to.
+//
+// To create new texture packs, use PackWriter (or UICommon::ConvertTexturePack).
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/File.h"
+#include "VideoCommon/HiresTextures.h"
+
+namespace TexturePack
+{
+static constexpr u32 PACK_MAGIC = 0x4B505444;  // "DTPK" (byteswapped to little endian)
+static constexpr u32 PACK_VERSION = 1;
+
+struct PackHeader  // 32 bytes
+{
+  u32 magic;
+  u32 version;
+  u32 num_textures;
+  u32 num_levels;
+  u64 index_offset;
+  u64 index_size;
+};
+
+struct PackEntry  // 24 bytes
+{
+  u64 name_hash;    // XXH64 of the name, with seed 0
+  u32 name_offset;  // from the start of the names
+  u32 name_length;
+  u32 first_level;  // into the level table
+  u16 num_levels;
+  u16 format;  // AbstractTextureFormat
+};
+
+struct PackLevel  // 24 bytes
+{
+  u64 offset;  // from the start of the file
+  u32 size;
+  u32 width;
+  u32 height;
+  u32 row_length;
+};
+
+class PackReader
+{
+public:
+  static std::unique_ptr<PackReader> Open(const std::string& path);
+  ~PackReader();
+
+  u32 GetTextureCount() const { return m_header->num_textures; }
+  std::string GetTextureName(u32 index) const;
+  // Returns nullptr if there is no texture with this name in the pack.
+  const PackEntry* FindTexture(const std::string& name) const;
+  const PackLevel& GetLevel(const PackEntry& entry, u32 level) const
+  {
+    return m_levels[entry.first_level + level];
+  }
+  const u8* GetLevelData(const PackLevel& level) const { return m_data + level.offset; }
+
+private:
+  PackReader(const u8* data, u64 size);
+  // Checks that the whole index is consistent, so that nothing needs to be checked later.
+  bool ReadIndex();
+
+  const u8* m_data;
+  u64 m_size;
+  const PackHeader* m_header;
+  const PackEntry* m_entries = nullptr;
+  const PackLevel* m_levels = nullptr;
+  const char* m_names = nullptr;
+};
+
+class PackWriter
+{
+public:
+  static std::unique_ptr<PackWriter> Create(const std::string& path);
+
+  // The texture data is written right away, only the index is kept in memory.
+  bool AddTexture(const std::string& name, const std::vector<HiresTexture::Level>& levels);
+  // Writes the index and the header. The pack can't be used before this is called.
+  bool Finish();
+
+private:
+  explicit PackWriter(File::IOFile file);
+
+  File::IOFile m_file;
+  u64 m_position = sizeof(PackHeader);
+  std::vector<PackEntry> m_entries;
+  std::vector<PackLevel> m_levels;
+  std::string m_names;
+};
+}  // namespace TexturePack
@@ -26,6 +26,8 @@ PixelShaderUid GetPixelShaderUid()
       (!g_ActiveConfig.bFastDepthCalc && bpmem.zmode.testenable && !uid_data->early_depth) ||
       (bpmem.zmode.testenable && bpmem.genMode.zfreeze);
   uid_data->uint_output = bpmem.blendmode.UseLogicOp();
+  uid_data->alpha_test = bpmem.alpha_test.TestResult() != AlphaTest::PASS;
+  uid_data->fog = !g_ActiveConfig.bDisableFog && bpmem.fog.c_proj_fsel.fsel != 0;
   return out;
 }
 
@@ -54,8 +56,9 @@ ShaderCode GenPixelShader(APIType ApiType, const ShaderHostConfig& host_config,
   const u32 numTexgen = uid_data->num_texgens;
   ShaderCode out;
 
-  out.Write("// Pixel UberShader for %u texgens%s%s\n", numTexgen,
-            early_depth ? ", early-depth" : "", per_pixel_depth ? ", per-pixel depth" : "");
+  out.Write("// Pixel UberShader for %u texgens%s%s%s%s\n", numTexgen,
+            early_depth ? ", early-depth" : "", per_pixel_depth ? ", per-pixel depth" : "",
+            uid_data->alpha_test ? ", alpha test" : "", uid_data->fog ? ", fog" : "");
   WritePixelShaderCommonHeader(out, ApiType, numTexgen, per_pixel_lighting, bounding_box);
   WriteUberShaderCommonHeader(out, ApiType, host_config);
   if (per_pixel_lighting)
@@ -1084,28 +1087,31 @@ ShaderCode GenPixelShader(APIType ApiType, const ShaderHostConfig& host_config,
       out.Write("  depth = float(zbuffer_zCoord) / 16777216.0;\n");
   }
 
-  out.Write("  // Alpha Test\n"
-            "  if (bpmem_alphaTest != 0u) {\n"
-            "    bool comp0 = alphaCompare(TevResult.a, " I_ALPHA ".r, %s);\n",
-            BitfieldExtract("bpmem_alphaTest", AlphaTest().comp0).c_str());
-  out.Write("    bool comp1 = alphaCompare(TevResult.a, " I_ALPHA ".g, %s);\n",
-            BitfieldExtract("bpmem_alphaTest", AlphaTest().comp1).c_str());
-  out.Write("\n"
-            "    // These if statements are written weirdly to work around intel and qualcom bugs "
-            "with handling booleans.\n"
-            "    switch (%s) {\n",
-            BitfieldExtract("bpmem_alphaTest", AlphaTest().logic).c_str());
-  out.Write("    case 0u: // AND\n"
-            "      if (comp0 && comp1) break; else discard; break;\n"
-            "    case 1u: // OR\n"
-            "      if (comp0 || comp1) break; else discard; break;\n"
-            "    case 2u: // XOR\n"
-            "      if (comp0 != comp1) break; else discard; break;\n"
-            "    case 3u: // XNOR\n"
-            "      if (comp0 == comp1) break; else discard; break;\n"
-            "    }\n"
-            "  }\n"
-            "\n");
+  if (uid_data->alpha_test)
+  {
+    out.Write("  // Alpha Test\n"
+              "  if (bpmem_alphaTest != 0u) {\n"
+              "    bool comp0 = alphaCompare(TevResult.a, " I_ALPHA ".r, %s);\n",
+              BitfieldExtract("bpmem_alphaTest", AlphaTest().comp0).c_str());
+    out.Write("    bool comp1 = alphaCompare(TevResult.a, " I_ALPHA ".g, %s);\n",
+              BitfieldExtract("bpmem_alphaTest", AlphaTest().comp1).c_str());
+    out.Write("\n"
+              "    // These if statements are written weirdly to work around intel and qualcom "
+              "bugs with handling booleans.\n"
+              "    switch (%s) {\n",
+              BitfieldExtract("bpmem_alphaTest", AlphaTest().logic).c_str());
+    out.Write("    case 0u: // AND\n"
+              "      if (comp0 && comp1) break; else discard; break;\n"
+              "    case 1u: // OR\n"
+              "      if (comp0 || comp1) break; else discard; break;\n"
+              "    case 2u: // XOR\n"
+              "      if (comp0 != comp1) break; else discard; break;\n"
+              "    case 3u: // XNOR\n"
+              "      if (comp0 == comp1) break; else discard; break;\n"
+              "    }\n"
+              "  }\n"
+              "\n");
+  }
 
   // =========
   // Dithering
@@ -1122,63 +1128,67 @@ ShaderCode GenPixelShader(APIType ApiType, const ShaderHostConfig& host_config,
   //    Fog
   // =========
 
-  // FIXME: Fog is implemented the same as ShaderGen, but ShaderGen's fog is all hacks.
-  //        Should be fixed point, and should not make guesses about Range-Based adjustments.
-  out.Write("  // Fog\n"
-            "  uint fog_function = %s;\n",
-            BitfieldExtract("bpmem_fogParam3", FogParam3().fsel).c_str());
-  out.Write("  if (fog_function != 0u) {\n"
-            "    // TODO: This all needs to be converted from float to fixed point\n"
-            "    float ze;\n"
-            "    if (%s == 0u) {\n",
-            BitfieldExtract("bpmem_fogParam3", FogParam3().proj).c_str());
-  out.Write("      // perspective\n"
-            "      // ze = A/(B - (Zs >> B_SHF)\n"
-            "      ze = (" I_FOGF "[1].x * 16777216.0) / float(" I_FOGI ".y - (zCoord >> " I_FOGI
-            ".w));\n"
-            "    } else {\n"
-            "      // orthographic\n"
-            "      // ze = a*Zs    (here, no B_SHF)\n"
-            "      ze = " I_FOGF "[1].x * float(zCoord) / 16777216.0;\n"
-            "    }\n"
-            "\n"
-            "    if (bool(%s)) {\n",
-            BitfieldExtract("bpmem_fogRangeBase", FogRangeParams::RangeBase().Enabled).c_str());
-  out.Write("      // x_adjust = sqrt((x-center)^2 + k^2)/k\n"
-            "      // ze *= x_adjust\n"
-            "      // TODO Instead of this theoretical calculation, we should use the\n"
-            "      //      coefficient table given in the fog range BP registers!\n"
-            "      float x_adjust = (2.0 * (rawpos.x / " I_FOGF "[0].y)) - 1.0 - " I_FOGF
-            "[0].x; \n"
-            "      x_adjust = sqrt(x_adjust * x_adjust + " I_FOGF "[0].z * " I_FOGF
-            "[0].z) / " I_FOGF "[0].z;\n"
-            "      ze *= x_adjust;\n"
-            "    }\n"
-            "\n"
-            "    float fog = clamp(ze - " I_FOGF "[1].z, 0.0, 1.0);\n"
-            "\n"
-            "    if (fog_function > 3u) {\n"
-            "      switch (fog_function) {\n"
-            "      case 4u:\n"
-            "        fog = 1.0 - exp2(-8.0 * fog);\n"
-            "        break;\n"
-            "      case 5u:\n"
-            "        fog = 1.0 - exp2(-8.0 * fog * fog);\n"
-            "        break;\n"
-            "      case 6u:\n"
-            "        fog = exp2(-8.0 * (1.0 - fog));\n"
-            "        break;\n"
-            "      case 7u:\n"
-            "        fog = 1.0 - fog;\n"
-            "        fog = exp2(-8.0 * fog * fog);\n"
-            "        break;\n"
-            "      }\n"
-            "    }\n"
-            "\n"
-            "    int ifog = iround(fog * 256.0);\n"
-            "    TevResult.rgb = (TevResult.rgb * (256 - ifog) + " I_FOGCOLOR ".rgb * ifog) >> 8;\n"
-            "  }\n"
-            "\n");
+  if (uid_data->fog)
+  {
+    // FIXME: Fog is implemented the same as ShaderGen, but ShaderGen's fog is all hacks.
+    //        Should be fixed point, and should not make guesses about Range-Based adjustments.
+    out.Write("  // Fog\n"
+              "  uint fog_function = %s;\n",
+              BitfieldExtract("bpmem_fogParam3", FogParam3().fsel).c_str());
+    out.Write("  if (fog_function != 0u) {\n"
+              "    // TODO: This all needs to be converted from float to fixed point\n"
+              "    float ze;\n"
+              "    if (%s == 0u) {\n",
+              BitfieldExtract("bpmem_fogParam3", FogParam3().proj).c_str());
+    out.Write("      // perspective\n"
+              "      // ze = A/(B - (Zs >> B_SHF)\n"
+              "      ze = (" I_FOGF "[1].x * 16777216.0) / float(" I_FOGI ".y - (zCoord >> " I_FOGI
+              ".w));\n"
+              "    } else {\n"
+              "      // orthographic\n"
+              "      // ze = a*Zs    (here, no B_SHF)\n"
+              "      ze = " I_FOGF "[1].x * float(zCoord) / 16777216.0;\n"
+              "    }\n"
+              "\n"
+              "    if (bool(%s)) {\n",
+              BitfieldExtract("bpmem_fogRangeBase", FogRangeParams::RangeBase().Enabled).c_str());
+    out.Write("      // x_adjust = sqrt((x-center)^2 + k^2)/k\n"
+              "      // ze *= x_adjust\n"
+              "      // TODO Instead of this theoretical calculation, we should use the\n"
+              "      //      coefficient table given in the fog range BP registers!\n"
+              "      float x_adjust = (2.0 * (rawpos.x / " I_FOGF "[0].y)) - 1.0 - " I_FOGF
+              "[0].x; \n"
+              "      x_adjust = sqrt(x_adjust * x_adjust + " I_FOGF "[0].z * " I_FOGF
+              "[0].z) / " I_FOGF "[0].z;\n"
+              "      ze *= x_adjust;\n"
+              "    }\n"
+              "\n"
+              "    float fog = clamp(ze - " I_FOGF "[1].z, 0.0, 1.0);\n"
+              "\n"
+              "    if (fog_function > 3u) {\n"
+              "      switch (fog_function) {\n"
+              "      case 4u:\n"
+              "        fog = 1.0 - exp2(-8.0 * fog);\n"
+              "        break;\n"
+              "      case 5u:\n"
+              "        fog = 1.0 - exp2(-8.0 * fog * fog);\n"
+              "        break;\n"
+              "      case 6u:\n"
+              "        fog = exp2(-8.0 * (1.0 - fog));\n"
+              "        break;\n"
+              "      case 7u:\n"
+              "        fog = 1.0 - fog;\n"
+              "        fog = exp2(-8.0 * fog * fog);\n"
+              "        break;\n"
+              "      }\n"
+              "    }\n"
+              "\n"
+              "    int ifog = iround(fog * 256.0);\n"
+              "    TevResult.rgb = (TevResult.rgb * (256 - ifog) + " I_FOGCOLOR
+              ".rgb * ifog) >> 8;\n"
+              "  }\n"
+              "\n");
+  }
 
   // D3D requires that the shader outputs be uint when writing to a uint render target for logic op.
   if (ApiType == APIType::D3D && uid_data->uint_output)
@@ -1290,7 +1300,15 @@ void EnumeratePixelShaderUids(const std::function<void(const PixelShaderUid&)>&
         for (u32 uint_output = 0; uint_output < 2; uint_output++)
         {
           puid->uint_output = uint_output;
-          callback(uid);
+          for (u32 alpha_test = 0; alpha_test < 2; alpha_test++)
+          {
+            puid->alpha_test = alpha_test;
+            for (u32 fog = 0; fog < 2; fog++)
+            {
+              puid->fog = fog;
+              callback(uid);
+            }
+          }
         }
       }
     }
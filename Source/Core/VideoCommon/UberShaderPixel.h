@@ -16,6 +16,10 @@ struct pixel_ubershader_uid_data
   u32 early_depth : 1;
   u32 per_pixel_depth : 1;
   u32 uint_output : 1;
+  // Whether the code for the alpha test and for fog is included at all. Both are usually set once
+  // per scene, and leaving them out saves weak GPUs the registers and branches they need.
+  u32 alpha_test : 1;
+  u32 fog : 1;
 
   u32 NumValues() const { return sizeof(pixel_ubershader_uid_data); }
 };
@@ -44,6 +44,9 @@ ShaderCode GenVertexShader(APIType ApiType, const ShaderHostConfig& host_config,
   out.Write(s_shader_uniforms);
   out.Write("};\n");
 
+  if (host_config.UseInstancedStereo())
+    WriteInstancedStereoUniforms(out);
+
   out.Write("struct VS_OUTPUT {\n");
   GenerateVSOutputMembers(out, ApiType, numTexgen, per_pixel_lighting, "");
   out.Write("};\n\n");
@@ -69,6 +72,8 @@ ShaderCode GenVertexShader(APIType ApiType, const ShaderHostConfig& host_config,
       out.Write("VARYING_LOCATION(0) out VertexData {\n");
       GenerateVSOutputMembers(out, ApiType, numTexgen, per_pixel_lighting,
                               GetInterpolationQualifier(msaa, ssaa, true, false));
+      if (host_config.UseInstancedStereo())
+        out.Write("\tflat int layer;\n");
       out.Write("} vs;\n");
     }
     else
@@ -102,6 +107,8 @@ ShaderCode GenVertexShader(APIType ApiType, const ShaderHostConfig& host_config,
     for (int i = 0; i < 8; ++i)
       out.Write("  float3 rawtex%d : TEXCOORD%d,\n", i, i);
     out.Write("  uint posmtx : BLENDINDICES,\n");
+    if (host_config.merged_draws)
+      out.Write("  uint vertex_id : SV_VertexID,\n");
     out.Write("  float4 rawpos : POSITION) {\n");
   }
 
@@ -118,29 +125,51 @@ ShaderCode GenVertexShader(APIType ApiType, const ShaderHostConfig& host_config,
             "float3 N0;\n"
             "float3 N1;\n"
             "float3 N2;\n"
-            "\n"
-            "if ((components & %uu) != 0u) {// VB_HAS_POSMTXIDX\n",
-            VB_HAS_POSMTXIDX);
-  out.Write("  // Vertex format has a per-vertex matrix\n"
-            "  int posidx = int(posmtx.r);\n"
-            "  P0 = " I_TRANSFORMMATRICES "[posidx];\n"
-            "  P1 = " I_TRANSFORMMATRICES "[posidx+1];\n"
-            "  P2 = " I_TRANSFORMMATRICES "[posidx+2];\n"
-            "\n"
-            "  int normidx = posidx >= 32 ? (posidx - 32) : posidx;\n"
-            "  N0 = " I_NORMALMATRICES "[normidx].xyz;\n"
-            "  N1 = " I_NORMALMATRICES "[normidx+1].xyz;\n"
-            "  N2 = " I_NORMALMATRICES "[normidx+2].xyz;\n"
-            "} else {\n"
-            "  // One shared matrix\n"
-            "  P0 = " I_POSNORMALMATRIX "[0];\n"
-            "  P1 = " I_POSNORMALMATRIX "[1];\n"
-            "  P2 = " I_POSNORMALMATRIX "[2];\n"
-            "  N0 = " I_POSNORMALMATRIX "[3].xyz;\n"
-            "  N1 = " I_POSNORMALMATRIX "[4].xyz;\n"
-            "  N2 = " I_POSNORMALMATRIX "[5].xyz;\n"
-            "}\n"
-            "\n"
+            "\n");
+  if (host_config.merged_draws)
+  {
+    // The shared matrix isn't used, formats without a per-vertex matrix pick the matrix of the
+    // merged draw they belong to.
+    out.Write("int posidx;\n"
+              "if ((components & %uu) != 0u) {// VB_HAS_POSMTXIDX\n"
+              "  posidx = int(posmtx.r);\n"
+              "} else {\n",
+              VB_HAS_POSMTXIDX);
+    WriteMergedDrawMatrixIndex(out, ApiType, host_config);
+    out.Write("}\n"
+              "P0 = " I_TRANSFORMMATRICES "[posidx];\n"
+              "P1 = " I_TRANSFORMMATRICES "[posidx+1];\n"
+              "P2 = " I_TRANSFORMMATRICES "[posidx+2];\n"
+              "\n"
+              "int normidx = posidx >= 32 ? (posidx - 32) : posidx;\n"
+              "N0 = " I_NORMALMATRICES "[normidx].xyz;\n"
+              "N1 = " I_NORMALMATRICES "[normidx+1].xyz;\n"
+              "N2 = " I_NORMALMATRICES "[normidx+2].xyz;\n");
+  }
+  else
+  {
+    out.Write("if ((components & %uu) != 0u) {// VB_HAS_POSMTXIDX\n", VB_HAS_POSMTXIDX);
+    out.Write("  // Vertex format has a per-vertex matrix\n"
+              "  int posidx = int(posmtx.r);\n"
+              "  P0 = " I_TRANSFORMMATRICES "[posidx];\n"
+              "  P1 = " I_TRANSFORMMATRICES "[posidx+1];\n"
+              "  P2 = " I_TRANSFORMMATRICES "[posidx+2];\n"
+              "\n"
+              "  int normidx = posidx >= 32 ? (posidx - 32) : posidx;\n"
+              "  N0 = " I_NORMALMATRICES "[normidx].xyz;\n"
+              "  N1 = " I_NORMALMATRICES "[normidx+1].xyz;\n"
+              "  N2 = " I_NORMALMATRICES "[normidx+2].xyz;\n"
+              "} else {\n"
+              "  // One shared matrix\n"
+              "  P0 = " I_POSNORMALMATRIX "[0];\n"
+              "  P1 = " I_POSNORMALMATRIX "[1];\n"
+              "  P2 = " I_POSNORMALMATRIX "[2];\n"
+              "  N0 = " I_POSNORMALMATRIX "[3].xyz;\n"
+              "  N1 = " I_POSNORMALMATRIX "[4].xyz;\n"
+              "  N2 = " I_POSNORMALMATRIX "[5].xyz;\n"
+              "}\n");
+  }
+  out.Write("\n"
             "float4 pos = float4(dot(P0, rawpos), dot(P1, rawpos), dot(P2, rawpos), 1.0);\n"
             "o.pos = float4(dot(" I_PROJECTION "[0], pos), dot(" I_PROJECTION
             "[1], pos), dot(" I_PROJECTION "[2], pos), dot(" I_PROJECTION "[3], pos));\n"
@@ -254,9 +283,14 @@ ShaderCode GenVertexShader(APIType ApiType, const ShaderHostConfig& host_config,
 
   if (ApiType == APIType::OpenGL || ApiType == APIType::Vulkan)
   {
+    if (host_config.UseInstancedStereo())
+      WriteInstancedStereoTransform(out, ApiType, host_config);
+
     if (host_config.backend_geometry_shaders || ApiType == APIType::Vulkan)
     {
       AssignVSOutputMembers(out, "vs", "o", numTexgen, per_pixel_lighting);
+      if (host_config.UseInstancedStereo())
+        out.Write("vs.layer = eye;\n");
     }
     else
     {
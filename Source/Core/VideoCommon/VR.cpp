@@ -12,13 +12,17 @@
 // clang-format on
 #endif
 
+#include <algorithm>
+
 #include "Common/Common.h"
 #include "Common/MathUtil.h"
+#include "Common/SeqLock.h"
 #include "Common/StringUtil.h"
 #include "Common/Timer.h"
 #include "Common/Logging/Log.h"
 #include "Core/ConfigManager.h"
 #include "Core/HW/WiimoteEmu/HydraTLayer.h"
+#include "VideoCommon/Fifo.h"
 #include "VideoCommon/OpcodeDecoding.h"
 #include "VideoCommon/VideoConfig.h"
 #include "VideoCommon/VR.h"
@@ -141,8 +145,6 @@ float g_openvr_ipd = 0.064f;
 
 u8 g_vr_reading_wiimote_accel[5] = {}, g_vr_reading_wiimote_ir[5] = {},
    g_vr_reading_wiimote_ext[5] = {};
-bool g_vr_has_ir = false;
-float g_vr_ir_x = 0, g_vr_ir_y = 0, g_vr_ir_z = 0;
 
 ControllerStyle vr_left_controller = CS_HYDRA_LEFT, vr_right_controller = CS_HYDRA_RIGHT;
 
@@ -1213,6 +1215,24 @@ void VR_GetFovTextureSize(int* width, int* height)
 #endif
 }
 
+void VR_GetLensCenter(int eye, float* x, float* y)
+{
+  *x = 0.5f;
+  *y = 0.5f;
+#if defined(OVR_MAJOR_VERSION)
+  // The projection of each eye is off centre, and its tangents say by how much.
+  if (g_has_rift || g_has_openvr)
+  {
+    const ovrFovPort& fov = g_eye_fov[eye];
+    if (fov.LeftTan + fov.RightTan > 0.0f && fov.UpTan + fov.DownTan > 0.0f)
+    {
+      *x = fov.LeftTan / (fov.LeftTan + fov.RightTan);
+      *y = fov.DownTan / (fov.UpTan + fov.DownTan);
+    }
+  }
+#endif
+}
+
 std::wstring VR_GetAudioDeviceId()
 {
 #if defined(OVR_PRODUCT_VERSION) && OVR_PRODUCT_VERSION >= 1
@@ -1635,63 +1655,103 @@ bool VR_ViveHapticPulse(int hands, int microseconds)
   return false;
 }
 
-float left_hand_old_velocity[3] = {}, left_hand_older_velocity[3] = {};
-float right_hand_old_velocity[3] = {}, right_hand_older_velocity[3] = {};
+#if defined(HAVE_OPENVR)
+// What the emulated Wiimote and Nunchuk are computed from. It is published by the video thread
+// once per pose update, so that the CPU thread neither queries the SDK nor reads the poses while
+// WaitGetPoses writes them, for every report.
+struct WiimoteHandPose
+{
+  bool found;
+  bool valid;
+  float pos[3];
+  // m.data[r * 3 + c] is row c, column r of mDeviceToAbsoluteTracking
+  Matrix33 m;
+  // world-space, in metres per second per second
+  float acc[3];
+};
+
+struct WiimotePoses
+{
+  WiimoteHandPose left, right;
+};
 
-bool VR_GetAccel(int index, bool sideways, bool has_extension, float* gx, float* gy, float* gz)
+static Common::SeqLock<WiimotePoses> s_wiimote_poses;
+static float s_old_velocity[2][3] = {}, s_older_velocity[2][3] = {};
+
+static void UpdateWiimoteHandPose(vr::TrackedDeviceIndex_t index, int hand, WiimoteHandPose* pose)
+{
+  pose->found = index < vr::k_unMaxTrackedDeviceCount;
+  pose->valid = pose->found && m_rTrackedDevicePose[index].bPoseIsValid;
+  if (!pose->valid)
+    return;
+
+  const vr::TrackedDevicePose_t& device_pose = m_rTrackedDevicePose[index];
+  for (int i = 0; i < 3; i++)
+    pose->pos[i] = device_pose.mDeviceToAbsoluteTracking.m[i][3];
+  for (int r = 0; r < 3; r++)
+    for (int c = 0; c < 3; c++)
+      pose->m.data[r * 3 + c] = device_pose.mDeviceToAbsoluteTracking.m[c][r];
+
+  // the velocity is known at each pose update, and acceleration is its change over two of them
+  const float dt = (float)(g_last_tracking_time - g_older_tracking_time);
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    const float velocity = device_pose.vVelocity.v[axis];
+    pose->acc[axis] = dt > 0 ? (velocity - s_older_velocity[hand][axis]) / dt : 0;
+    s_older_velocity[hand][axis] = s_old_velocity[hand][axis];
+    s_old_velocity[hand][axis] = velocity;
+  }
+}
+#endif
+
+void VR_UpdateWiimotePoses()
 {
 #if defined(HAVE_OPENVR)
-  if (g_has_openvr)
+  if (!g_has_openvr)
+    return;
+
+  // find the controllers for each hand, 100 = not found
+  vr::TrackedDeviceIndex_t left_hand = 100, right_hand = 100;
+  for (vr::TrackedDeviceIndex_t i = 0; i < vr::k_unMaxTrackedDeviceCount; ++i)
   {
-    // find the controllers for each hand, 100 = not found
-    vr::TrackedDeviceIndex_t left_hand = 100, right_hand = 100;
-    for (vr::TrackedDeviceIndex_t i = 0; i < vr::k_unMaxTrackedDeviceCount; ++i)
+    vr::ETrackedControllerRole hand = m_pHMD->GetControllerRoleForTrackedDeviceIndex(i);
+    if (hand == vr::TrackedControllerRole_LeftHand)
+      left_hand = i;
+    else if (hand == vr::TrackedControllerRole_RightHand)
+      right_hand = i;
+  }
+  for (vr::TrackedDeviceIndex_t i = 0; i < vr::k_unMaxTrackedDeviceCount; ++i)
+  {
+    vr::ETrackedDeviceClass kind = m_pHMD->GetTrackedDeviceClass(i);
+    if (kind == vr::TrackedDeviceClass_Controller)
     {
-      vr::ETrackedControllerRole hand = m_pHMD->GetControllerRoleForTrackedDeviceIndex(i);
-      if (hand == vr::TrackedControllerRole_LeftHand)
+      if (left_hand == 100 && i != right_hand)
         left_hand = i;
-      else if (hand == vr::TrackedControllerRole_RightHand)
+      else if (right_hand == 100 && i != left_hand)
         right_hand = i;
     }
-    for (vr::TrackedDeviceIndex_t i = 0; i < vr::k_unMaxTrackedDeviceCount; ++i)
-    {
-      vr::ETrackedDeviceClass kind = m_pHMD->GetTrackedDeviceClass(i);
-      if (kind == vr::TrackedDeviceClass_Controller)
-      {
-        if (left_hand == 100 && i != right_hand)
-          left_hand = i;
-        else if (right_hand == 100 && i != left_hand)
-          right_hand = i;
-      }
-    }
-    if (right_hand >= vr::k_unMaxTrackedDeviceCount ||
-        !m_rTrackedDevicePose[right_hand].bPoseIsValid)
+  }
+
+  WiimotePoses poses = {};
+  UpdateWiimoteHandPose(left_hand, 0, &poses.left);
+  UpdateWiimoteHandPose(right_hand, 1, &poses.right);
+  s_wiimote_poses.Store(poses);
+#endif
+}
+
+bool VR_GetAccel(int index, bool sideways, bool has_extension, float* gx, float* gy, float* gz)
+{
+#if defined(HAVE_OPENVR)
+  if (g_has_openvr)
+  {
+    const WiimotePoses poses = s_wiimote_poses.Load();
+    if (!poses.right.valid)
     {
       // NOTICE_LOG(VR, "invalid!");
       return false;
     }
-    float rx = m_rTrackedDevicePose[right_hand].mDeviceToAbsoluteTracking.m[0][3];
-    float ry = m_rTrackedDevicePose[right_hand].mDeviceToAbsoluteTracking.m[1][3];
-    float rz = m_rTrackedDevicePose[right_hand].mDeviceToAbsoluteTracking.m[2][3];
-    Matrix33 m;
-    for (int r = 0; r < 3; r++)
-      for (int c = 0; c < 3; c++)
-        m.data[r * 3 + c] = m_rTrackedDevicePose[right_hand].mDeviceToAbsoluteTracking.m[c][r];
-    float acc[3] = {};
-    float dt = (float)(g_last_tracking_time - g_older_tracking_time);
-    if (dt < 0.001f)
-    {
-      // NOTICE_LOG(VR, "too fast!");
-      // return false;
-    }
-    for (int axis = 0; axis < 3; ++axis)
-    {
-      acc[axis] =
-          (m_rTrackedDevicePose[right_hand].vVelocity.v[axis] - right_hand_older_velocity[axis]) /
-          dt;
-      right_hand_older_velocity[axis] = right_hand_old_velocity[axis];
-      right_hand_old_velocity[axis] = m_rTrackedDevicePose[right_hand].vVelocity.v[axis];
-    }
+    const Matrix33& m = poses.right.m;
+    const float* acc = poses.right.acc;
     // World-space accelerations need to be converted into accelerations relative to the Wiimote's
     // sensor.
     float rel_acc[3];
@@ -1708,7 +1768,7 @@ bool VR_GetAccel(int index, bool sideways, bool has_extension, float* gx, float*
     // If the left Vive controller is off, or an extension is plugged in then just
     // hold the right Vive sideways yourself. Otherwise in sideways mode
     // with no extension pitch is controlled by the angle between the Vive controllers.
-    if (sideways && !has_extension && left_hand != 100)
+    if (sideways && !has_extension && poses.left.found)
     {
       // Left vive controller's left side = front of wiimote
       // Right vive controller's right side = back of wiimote
@@ -1716,12 +1776,9 @@ bool VR_GetAccel(int index, bool sideways, bool has_extension, float* gx, float*
       // Right vive controller's face = top side of wiimote
 
       // angle between the controllers
-      float lx = m_rTrackedDevicePose[left_hand].mDeviceToAbsoluteTracking.m[0][3];
-      float ly = m_rTrackedDevicePose[left_hand].mDeviceToAbsoluteTracking.m[1][3];
-      float lz = m_rTrackedDevicePose[left_hand].mDeviceToAbsoluteTracking.m[2][3];
-      float x = rx - lx;
-      float y = ry - ly;
-      float z = rz - lz;
+      float x = poses.right.pos[0] - poses.left.pos[0];
+      float y = poses.right.pos[1] - poses.left.pos[1];
+      float z = poses.right.pos[2] - poses.left.pos[2];
       float dist = sqrtf(x * x + y * y + z * z);
       if (dist > 0)
       {
@@ -1769,9 +1826,6 @@ bool VR_GetAccel(int index, bool sideways, bool has_extension, float* gx, float*
       *gx -= rel_acc[0] / 9.8f;
       *gz += rel_acc[1] / 9.8f;
       *gy += rel_acc[2] / 9.8f;
-      // NOTICE_LOG(VR, "dt=%f", dt);
-      // NOTICE_LOG(VR, "gx=%f, gy=%f, gz=%f", -rel_acc[0] / 9.8f, rel_acc[2] / 9.8f, rel_acc[1] /
-      // 9.8f);
     }
     return true;
   }
@@ -1784,53 +1838,14 @@ bool VR_GetNunchuckAccel(int index, float* gx, float* gy, float* gz)
 #if defined(HAVE_OPENVR)
   if (g_has_openvr && index == 0)
   {
-    // find the controllers for each hand, 100 = not found
-    vr::TrackedDeviceIndex_t left_hand = 100, right_hand = 100;
-    for (vr::TrackedDeviceIndex_t i = 0; i < vr::k_unMaxTrackedDeviceCount; ++i)
-    {
-      vr::ETrackedControllerRole hand = m_pHMD->GetControllerRoleForTrackedDeviceIndex(i);
-      if (hand == vr::TrackedControllerRole_LeftHand)
-        left_hand = i;
-      else if (hand == vr::TrackedControllerRole_RightHand)
-        right_hand = i;
-    }
-    for (vr::TrackedDeviceIndex_t i = 0; i < vr::k_unMaxTrackedDeviceCount; ++i)
-    {
-      vr::ETrackedDeviceClass kind = m_pHMD->GetTrackedDeviceClass(i);
-      if (kind == vr::TrackedDeviceClass_Controller)
-      {
-        if (left_hand == 100 && i != right_hand)
-          left_hand = i;
-        else if (right_hand == 100 && i != left_hand)
-          right_hand = i;
-      }
-    }
-    if (left_hand >= vr::k_unMaxTrackedDeviceCount || !m_rTrackedDevicePose[left_hand].bPoseIsValid)
+    const WiimotePoses poses = s_wiimote_poses.Load();
+    if (!poses.left.valid)
     {
       // NOTICE_LOG(VR, "invalid!");
       return false;
     }
-    // float lx = m_rTrackedDevicePose[left_hand].mDeviceToAbsoluteTracking.m[0][3];
-    // float ly = m_rTrackedDevicePose[left_hand].mDeviceToAbsoluteTracking.m[1][3];
-    // float lz = m_rTrackedDevicePose[left_hand].mDeviceToAbsoluteTracking.m[2][3];
-    Matrix33 m;
-    for (int r = 0; r < 3; r++)
-      for (int c = 0; c < 3; c++)
-        m.data[r * 3 + c] = m_rTrackedDevicePose[left_hand].mDeviceToAbsoluteTracking.m[c][r];
-    float acc[3] = {};
-    float dt = (float)(g_last_tracking_time - g_older_tracking_time);
-    if (dt < 0.001f)
-    {
-      // NOTICE_LOG(VR, "too fast!");
-      // return false;
-    }
-    for (int axis = 0; axis < 3; ++axis)
-    {
-      acc[axis] =
-          (m_rTrackedDevicePose[left_hand].vVelocity.v[axis] - left_hand_older_velocity[axis]) / dt;
-      left_hand_older_velocity[axis] = left_hand_old_velocity[axis];
-      left_hand_old_velocity[axis] = m_rTrackedDevicePose[left_hand].vVelocity.v[axis];
-    }
+    const Matrix33& m = poses.left.m;
+    const float* acc = poses.left.acc;
     // World-space accelerations need to be converted into accelerations relative to the Nunchuk's
     // sensor.
     float rel_acc[3];
@@ -1858,16 +1873,38 @@ bool VR_GetNunchuckAccel(int index, float* gx, float* gy, float* gz)
   return false;
 }
 
+struct VRIRPointer
+{
+  bool valid;
+  float x, y, z;
+};
+static Common::SeqLock<VRIRPointer> s_ir_pointer;
+
+void VR_SetIR(bool valid, float x, float y, float z)
+{
+  s_ir_pointer.Store({valid, x, y, z});
+}
+
+bool VR_GetIRPointer(float* x, float* y, float* z)
+{
+  const VRIRPointer ir = s_ir_pointer.Load();
+  *x = ir.x;
+  *y = ir.y;
+  *z = ir.z;
+  return ir.valid;
+}
+
 bool VR_GetIR(int index, double* irx, double* iry, double* irz)
 {
 #if defined(HAVE_OPENVR)
   if (g_has_openvr)
   {
-    if (g_vr_has_ir)
+    float x, y, z;
+    if (VR_GetIRPointer(&x, &y, &z))
     {
-      *irx = g_vr_ir_x;
-      *iry = g_vr_ir_y;
-      *irz = g_vr_ir_z;
+      *irx = x;
+      *iry = y;
+      *irz = z;
       return true;
     }
   }
@@ -2259,6 +2296,39 @@ bool VR_PairViveControllers()
 #endif
 }
 
+void AddTimewarpLogEntry(const DataReader& src, bool is_preprocess)
+{
+  // Keep the log within its budget. Dropping the whole frame is safer than replaying part of it.
+  if (timewarp_logentries.size() >= MAX_TIMEWARP_LOG_ENTRIES)
+  {
+    ClearTimewarpLog();
+    g_opcode_replay_log_frame = false;
+    return;
+  }
+
+  if (timewarp_logentries.capacity() < MAX_TIMEWARP_LOG_ENTRIES)
+    timewarp_logentries.reserve(MAX_TIMEWARP_LOG_ENTRIES);
+  timewarp_logentries.push_back(
+      TimewarpLogEntry{src, Fifo::GetVideoBufferGeneration(), is_preprocess});
+}
+
+void ClearTimewarpLog()
+{
+  // clear() keeps the capacity, so logging the next frame doesn't allocate.
+  timewarp_logentries.clear();
+}
+
+// The log references the video buffer directly, so it can only be replayed while the FIFO data it
+// points at hasn't been moved or overwritten.
+static bool IsTimewarpLogReplayable()
+{
+  const u32 generation = Fifo::GetVideoBufferGeneration();
+  return std::all_of(timewarp_logentries.begin(), timewarp_logentries.end(),
+                     [generation](const TimewarpLogEntry& entry) {
+                       return entry.video_buffer_generation == generation;
+                     });
+}
+
 void OpcodeReplayBuffer()
 {
   // Opcode Replay Buffer Code.  This enables the capture of all the Video Opcodes that occur during
@@ -2369,6 +2439,9 @@ void OpcodeReplayBuffer()
         ++extra_video_loops_count;
         skipped_opcode_replay_count = 0;
 
+        if (!IsTimewarpLogReplayable())
+          ClearTimewarpLog();
+
         for (TimewarpLogEntry& entry : timewarp_logentries)
         {
           // VertexManager::s_pCurBufferPointer = s_pCurBufferPointer_log.at(i);
@@ -2425,16 +2498,14 @@ void OpcodeReplayBuffer()
       // s_pEndBufferPointer_log.resize(0);
       // s_pBaseBufferPointer_log.clear();
       // s_pBaseBufferPointer_log.resize(0);
-      timewarp_logentries.clear();
-      timewarp_logentries.resize(0);
+      ClearTimewarpLog();
     }
   }
   else
   {
     if (g_opcode_replay_enabled)
     {
-      timewarp_logentries.clear();
-      timewarp_logentries.resize(0);
+      ClearTimewarpLog();
     }
     g_opcode_replay_enabled = false;
     g_opcode_replay_log_frame = false;
@@ -2567,6 +2638,9 @@ void OpcodeReplayBufferInline()
     g_opcode_replay_frame = true;
     skipped_opcode_replay_count = 0;
 
+    if (!IsTimewarpLogReplayable())
+      extra_video_loops = 0;
+
     for (int num_extra_frames = 0; num_extra_frames < extra_video_loops; ++num_extra_frames)
     {
       for (TimewarpLogEntry& entry : timewarp_logentries)
@@ -2581,16 +2655,14 @@ void OpcodeReplayBufferInline()
         }
       }
     }
-    timewarp_logentries.clear();
-    timewarp_logentries.resize(0);
+    ClearTimewarpLog();
     g_opcode_replay_frame = false;
   }
   else
   {
     if (g_opcode_replay_enabled)
     {
-      timewarp_logentries.clear();
-      timewarp_logentries.resize(0);
+      ClearTimewarpLog();
     }
     g_opcode_replay_enabled = false;
     g_opcode_replay_log_frame = false;
@@ -31,6 +31,9 @@ const int DEFAULT_VR_EXTRA_VIDEO_LOOPS_DIVIDER = 0;
 #define VR_MIRROR_DISABLED 2
 #define VR_MIRROR_WARPED 3
 #define VR_MIRROR_BOTH 4
+#define VR_FOVEATION_OFF 0
+#define VR_FOVEATION_LOW 1
+#define VR_FOVEATION_HIGH 2
 
 #define OCULUS_BUTTON_A 1
 #define OCULUS_BUTTON_B 2
@@ -170,6 +173,8 @@ void VR_GetProjectionHalfTan(float& hmd_halftan);
 void VR_GetProjectionMatrices(Matrix44& left_eye, Matrix44& right_eye, float znear, float zfar);
 void VR_GetEyePos(float* posLeft, float* posRight);
 void VR_GetFovTextureSize(int* width, int* height);
+// Where the lens of the eye is centred on its eye buffer, from 0 to 1 starting at the bottom left
+void VR_GetLensCenter(int eye, float* x, float* y);
 
 std::wstring VR_GetAudioDeviceId();
 
@@ -182,6 +187,10 @@ bool VR_ViveHapticPulse(int hands, int microseconds);
 bool VR_GetAccel(int index, bool sideways, bool has_extension, float* gx, float* gy, float* gz);
 bool VR_GetNunchuckAccel(int index, float* gx, float* gy, float* gz);
 bool VR_GetIR(int index, double* irx, double* iry, double* irz);
+// called by the video thread whenever it got new poses from the SDK, and computed the IR pointer
+void VR_UpdateWiimotePoses();
+void VR_SetIR(bool valid, float x, float y, float z);
+bool VR_GetIRPointer(float* x, float* y, float* z);
 // called whenever the game reads the wiimote, to let us know which features they are reading
 void VR_UpdateWiimoteReportingMode(int index, u8 accel, u8 ir, u8 ext);
 
@@ -230,16 +239,19 @@ extern float g_current_fps, g_current_speed;
 // 4 Wiimotes + 1 Balance Board
 extern u8 g_vr_reading_wiimote_accel[5], g_vr_reading_wiimote_ir[5], g_vr_reading_wiimote_ext[5];
 
-extern bool g_vr_has_ir;
-extern float g_vr_ir_x, g_vr_ir_y, g_vr_ir_z;
-
 // Opcode Replay Buffer
+// Entries point at the FIFO data in place rather than holding copies of it. The log has a fixed
+// budget; once a frame exceeds it, that frame simply isn't replayed.
+const size_t MAX_TIMEWARP_LOG_ENTRIES = 4096;
 struct TimewarpLogEntry
 {
   DataReader timewarp_log;
+  u32 video_buffer_generation;
   bool is_preprocess_log;
 };
 extern std::vector<TimewarpLogEntry> timewarp_logentries;
+void AddTimewarpLogEntry(const DataReader& src, bool is_preprocess);
+void ClearTimewarpLog();
 extern bool g_opcode_replay_enabled;
 extern bool g_new_frame_just_rendered;
 extern bool g_first_pass;
@@ -435,7 +435,7 @@ void VRCalculateIRPointer()
     cs = VR_GetHydraStyle(1);
   if (cs != CS_WIIMOTE_IR)
   {
-    g_vr_has_ir = false;
+    VR_SetIR(false, 0, 0, 0);
     return;
   }
 
@@ -468,11 +468,9 @@ void VRCalculateIRPointer()
 
   // NOTICE_LOG(VR, "r=%8f, %8f, %8f       %8f     d=%8f, %8f, %8f     a=%8f, %8f, %8f", r[0], r[1],
   // r[2], rp[2]-r[2], d[0], d[1], d[2], aimpoint[0], aimpoint[1], aimpoint[2]);
-  g_vr_ir_x = aimpoint[0] * 2 - 1;
-  g_vr_ir_y = 1 - (aimpoint[1] * 2);
-  g_vr_ir_z = aimpoint[2];  // todo: currently always 0, but should be based on actual controller
-                            // distance from screen, not aimpoint
-  g_vr_has_ir = true;
+  // todo: z is currently always 0, but should be based on actual controller distance from screen,
+  // not aimpoint
+  VR_SetIR(true, aimpoint[0] * 2 - 1, 1 - (aimpoint[1] * 2), aimpoint[2]);
 }
 
 bool CalculateTrackingSpaceToViewSpaceMatrix(int kind, Matrix44& look_matrix)
@@ -64,7 +64,7 @@ void ResetView()
   if (!s_device)
     return;
 
-  s_device->UpdateInput();
+  s_device->Poll();
 
   for (int i = 0; i < 3; i++)
     s_initial_position[i] = (float)s_position_inputs[i]->State();
@@ -81,7 +81,7 @@ void GetTransformMatrix(Matrix44& mtx)
     return;
 
   // Make sure we have the most recent state available
-  s_device->UpdateInput();
+  s_device->Poll();
 
   float position[3], orientation[4];
 
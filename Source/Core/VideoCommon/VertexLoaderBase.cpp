@@ -120,7 +120,7 @@ std::string VertexLoaderBase::ToString() const
                                pos_mode[tex_mode[i]], pos_formats[m_VtxAttr.texCoord[i].Format]);
     }
   }
-  dest += StringFromFormat(" - %i v", m_numLoadedVertices);
+  dest += StringFromFormat(" - %i v", m_numLoadedVertices.load());
   return dest;
 }
 
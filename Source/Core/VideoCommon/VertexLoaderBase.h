@@ -5,6 +5,7 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <memory>
 #include <string>
 
@@ -66,6 +67,14 @@ public:
 
   virtual bool IsInitialized() = 0;
 
+  // Whether RunVertices() may be called on disjoint vertex ranges from several threads at once.
+  // Loaders that keep per-run state in the object itself must return false.
+  virtual bool CanRunInParallel() const { return false; }
+
+  // Whether any attribute is read through an array index, which makes the decoded vertices also
+  // depend on the contents of the vertex arrays. Checks the high bit of each 2-bit array field.
+  bool HasIndexedAttributes() const { return ((m_VtxDesc.Hex >> 9) & 0xAAAAAA) != 0; }
+
   // For debugging / profiling
   std::string ToString() const;
 
@@ -78,7 +87,7 @@ public:
 
   // used by VertexLoaderManager
   NativeVertexFormat* m_native_vertex_format = nullptr;
-  int m_numLoadedVertices = 0;
+  std::atomic<int> m_numLoadedVertices{0};
 
 protected:
   VertexLoaderBase(const TVtxDesc& vtx_desc, const VAT& vtx_attr);
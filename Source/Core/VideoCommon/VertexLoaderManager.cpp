@@ -3,9 +3,12 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <condition_variable>
+#include <cstring>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -13,21 +16,27 @@
 #include "Common/Assert.h"
 #include "Common/CommonFuncs.h"
 #include "Common/CommonTypes.h"
+#include "Common/Logging/Trace.h"
+#include "Common/Thread.h"
 #include "Core/ARBruteForcer.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/HW/Memmap.h"
+#include "Core/HideObjectEngine.h"
 
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/DataReader.h"
+#include "VideoCommon/DisplayListCache.h"
 #include "VideoCommon/IndexGenerator.h"
 #include "VideoCommon/NativeVertexFormat.h"
 #include "VideoCommon/Statistics.h"
+#include "VideoCommon/StageTimers.h"
 #include "VideoCommon/VR.h"
 #include "VideoCommon/VertexLoaderBase.h"
 #include "VideoCommon/VertexLoaderManager.h"
 #include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/VertexShaderManager.h"
+#include "VideoCommon/VideoConfig.h"
 
 namespace VertexLoaderManager
 {
@@ -48,6 +57,159 @@ static VertexLoaderMap s_vertex_loader_map;
 
 u8* cached_arraybases[12];
 
+namespace
+{
+// Splits large batches into chunks which are decoded by the JIT vertex loaders on several threads.
+// The GPU thread decodes the first chunk itself, and afterwards the last few vertices of the batch,
+// since those also update the zfreeze position cache and have to be written last.
+class ParallelVertexDecoder
+{
+public:
+  // Batches smaller than this aren't worth the cost of waking the workers.
+  static constexpr int MIN_VERTICES = 4096;
+
+  explicit ParallelVertexDecoder(u32 num_workers) : m_chunks(num_workers + 1)
+  {
+    for (u32 i = 0; i < num_workers; i++)
+      m_workers.emplace_back(&ParallelVertexDecoder::WorkerThread, this, i + 1);
+  }
+
+  ~ParallelVertexDecoder()
+  {
+    {
+      std::lock_guard<std::mutex> lk(m_mutex);
+      m_exit = true;
+    }
+    m_work_cv.notify_all();
+    for (std::thread& worker : m_workers)
+      worker.join();
+  }
+
+  size_t GetNumWorkers() const { return m_workers.size(); }
+  int Run(VertexLoaderBase* loader, DataReader src, DataReader dst, int count)
+  {
+    const int src_stride = loader->m_VertexSize;
+    const int dst_stride = loader->m_native_vtx_decl.stride;
+
+    // The last vertices are left to RunVertices() on this thread once everything else is done.
+    constexpr int TAIL_VERTICES = 3;
+    const int parallel_count = count - TAIL_VERTICES;
+    const int chunk_size = parallel_count / static_cast<int>(m_chunks.size());
+    u8* const src_end = src.GetPointer() + src.size();
+    u8* const dst_end = dst.GetPointer() + dst.size();
+
+    {
+      std::lock_guard<std::mutex> lk(m_mutex);
+      m_loader = loader;
+      int start = 0;
+      for (size_t i = 0; i < m_chunks.size(); i++)
+      {
+        Chunk& chunk = m_chunks[i];
+        chunk.start = start;
+        chunk.count = (i == m_chunks.size() - 1) ? parallel_count - start : chunk_size;
+        chunk.src = DataReader(src.GetPointer() + start * src_stride, src_end);
+        chunk.dst = DataReader(dst.GetPointer() + start * dst_stride, dst_end);
+        start += chunk.count;
+      }
+      m_pending = m_workers.size();
+      m_work_id++;
+    }
+    m_work_cv.notify_all();
+
+    RunChunk(0);
+
+    {
+      std::unique_lock<std::mutex> lk(m_mutex);
+      m_done_cv.wait(lk, [this] { return m_pending == 0; });
+    }
+
+    // Skipped vertices (index 0xFFFF) aren't written, which leaves gaps between the chunks.
+    int loaded = 0;
+    for (const Chunk& chunk : m_chunks)
+    {
+      if (loaded != chunk.start)
+      {
+        std::memmove(dst.GetPointer() + loaded * dst_stride,
+                     dst.GetPointer() + chunk.start * dst_stride, chunk.loaded * dst_stride);
+      }
+      loaded += chunk.loaded;
+    }
+
+    DataReader tail_src(src.GetPointer() + parallel_count * src_stride, src_end);
+    DataReader tail_dst(dst.GetPointer() + loaded * dst_stride, dst_end);
+    return loaded + loader->RunVertices(tail_src, tail_dst, TAIL_VERTICES);
+  }
+
+private:
+  struct Chunk
+  {
+    DataReader src;
+    DataReader dst;
+    int start = 0;
+    int count = 0;
+    int loaded = 0;
+  };
+
+  void RunChunk(size_t index)
+  {
+    TRACE_SCOPE("VertexLoader::RunVertices");
+    Chunk& chunk = m_chunks[index];
+    chunk.loaded = m_loader->RunVertices(chunk.src, chunk.dst, chunk.count);
+  }
+
+  void WorkerThread(size_t index)
+  {
+    Common::SetCurrentThreadName("Vertex loader worker");
+    Trace::SetThreadName("Vertex loader worker");
+
+    u64 last_work_id = 0;
+    std::unique_lock<std::mutex> lk(m_mutex);
+    while (true)
+    {
+      m_work_cv.wait(lk, [&] { return m_exit || m_work_id != last_work_id; });
+      if (m_exit)
+        return;
+
+      last_work_id = m_work_id;
+      lk.unlock();
+      RunChunk(index);
+      lk.lock();
+
+      if (--m_pending == 0)
+        m_done_cv.notify_one();
+    }
+  }
+
+  std::vector<Chunk> m_chunks;
+  std::vector<std::thread> m_workers;
+  VertexLoaderBase* m_loader = nullptr;
+
+  std::mutex m_mutex;
+  std::condition_variable m_work_cv;
+  std::condition_variable m_done_cv;
+  u64 m_work_id = 0;
+  size_t m_pending = 0;
+  bool m_exit = false;
+};
+}
+
+static std::unique_ptr<ParallelVertexDecoder> s_parallel_decoder;
+
+static int DecodeVertices(VertexLoaderBase* loader, DataReader src, DataReader dst, int count)
+{
+  if (count < ParallelVertexDecoder::MIN_VERTICES || !loader->CanRunInParallel())
+    return loader->RunVertices(src, dst, count);
+
+  const u32 num_workers = g_ActiveConfig.GetVertexLoaderThreads();
+  if (num_workers == 0)
+    return loader->RunVertices(src, dst, count);
+
+  if (!s_parallel_decoder || s_parallel_decoder->GetNumWorkers() != num_workers)
+    s_parallel_decoder = std::make_unique<ParallelVertexDecoder>(num_workers);
+
+  return s_parallel_decoder->Run(loader, src, dst, count);
+}
+
 void Init()
 {
   MarkAllDirty();
@@ -60,6 +222,9 @@ void Init()
 
 void Clear()
 {
+  s_parallel_decoder.reset();
+  DisplayListCache::Clear();
+
   std::lock_guard<std::mutex> lk(s_vertex_loader_map_lock);
   s_vertex_loader_map.clear();
   s_native_vertex_map.clear();
@@ -105,7 +270,7 @@ std::string VertexLoadersToString()
   for (const auto& map_entry : s_vertex_loader_map)
   {
     entry e = {map_entry.second->ToString(),
-               static_cast<u64>(map_entry.second->m_numLoadedVertices)};
+               static_cast<u64>(map_entry.second->m_numLoadedVertices.load())};
 
     total_size += e.text.size() + 1;
     entries.push_back(std::move(e));
@@ -258,6 +423,8 @@ int RunVertices(int vtx_attr_group, int primitive, int count, DataReader src, bo
   if (!count)
     return 0;
 
+  TRACE_SCOPE("VertexLoaderManager::RunVertices");
+
   SConfig& m_LocalCoreStartupParameter = SConfig::GetInstance();
 
   VertexLoaderBase* loader = RefreshLoader(vtx_attr_group, is_preprocess);
@@ -301,20 +468,8 @@ int RunVertices(int vtx_attr_group, int primitive, int count, DataReader src, bo
     return size;
 
   // Hide Objects Code code
-  if (!m_LocalCoreStartupParameter.hide_objects_updating)
-  {
-    m_LocalCoreStartupParameter.hide_objects_done = false;
-    for (const SkipEntry& entry : m_LocalCoreStartupParameter.object_removal_codes)
-    {
-      // Set lock so codes can be enabled/disabled in game without crashes.
-      if (!memcmp(src.GetPointer(), entry.data(), entry.size()))
-      {
-        // Data didn't match, try next object_removal_code
-        return size;
-      }
-    }
-  }
-  m_LocalCoreStartupParameter.hide_objects_done = true;
+  if (HideObjectEngine::IsObjectHidden(src.GetPointer(), size))
+    return size;
 
   // If the native vertex format changed, force a flush.
   if (loader->m_native_vertex_format != s_current_vtx_fmt ||
@@ -334,7 +489,21 @@ int RunVertices(int vtx_attr_group, int primitive, int count, DataReader src, bo
   DataReader dst = g_vertex_manager->PrepareForAdditionalData(
       primitive, count, loader->m_native_vtx_decl.stride, cullall);
 
-  count = loader->RunVertices(src, dst, count);
+  {
+    StageTimers::Scope stage_scope(StageTimers::Stage::VertexLoading);
+    const int cached_count =
+        DisplayListCache::LoadDraw(src.GetPointer(), loader, dst.GetPointer());
+    if (cached_count >= 0)
+    {
+      count = cached_count;
+      loader->m_numLoadedVertices += count;
+    }
+    else
+    {
+      count = DecodeVertices(loader, src, dst, count);
+      DisplayListCache::StoreDraw(src.GetPointer(), loader, dst.GetPointer(), count);
+    }
+  }
 
   IndexGenerator::AddIndices(primitive, count);
 
@@ -12,6 +12,8 @@
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
+#include "Common/Logging/Trace.h"
+#include "Common/Metrics.h"
 #include "Core/ConfigManager.h"
 
 #include "Core/ARBruteForcer.h"
@@ -19,6 +21,7 @@
 
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/BPStructs.h"
+#include "VideoCommon/ConstantManager.h"
 #include "VideoCommon/DataReader.h"
 #include "VideoCommon/Debugger.h"
 #include "VideoCommon/GeometryShaderManager.h"
@@ -29,6 +32,7 @@
 #include "VideoCommon/PixelShaderManager.h"
 #include "VideoCommon/RenderBase.h"
 #include "VideoCommon/SamplerCommon.h"
+#include "VideoCommon/StageTimers.h"
 #include "VideoCommon/TextureCacheBase.h"
 #include "VideoCommon/VertexLoaderManager.h"
 #include "VideoCommon/VertexShaderManager.h"
@@ -38,6 +42,9 @@
 
 std::unique_ptr<VertexManagerBase> g_vertex_manager;
 
+static Metrics::Counter s_flushes("dolphin_video_vertex_flushes_total",
+                                  "Batches of vertices flushed to the video backend.");
+
 // GX primitive -> RenderState primitive, no primitive restart
 constexpr std::array<PrimitiveType, 8> primitive_from_gx = {
     PrimitiveType::Triangles,  // GX_DRAW_QUADS
@@ -276,6 +283,9 @@ void VertexManagerBase::Flush()
   if (m_is_flushed)
     return;
 
+  TRACE_SCOPE("VertexManager::Flush");
+  s_flushes.Increment();
+
   // loading a state will invalidate BP, so check for it
   g_video_backend->CheckInvalidState();
 
@@ -383,7 +393,12 @@ void VertexManagerBase::Flush()
     m_zslope.dirty = false;
   }
 
-  if (!m_cull_all)
+  // Layers VR hides, like HUDs in split-screen or the skybox, would be drawn with a zeroed
+  // projection and cover no pixels, so don't send them to the backend at all. Replaying vertex
+  // data matches the constants to the draws of the logged frame, so it needs every draw.
+  const bool skip_hidden_layer =
+      VertexShaderManager::m_layer_hidden && !g_ActiveConfig.bReplayVertexData;
+  if (!m_cull_all && !skip_hidden_layer)
   {
     // set the rest of the global constants
     GeometryShaderManager::SetConstants();
@@ -391,7 +406,10 @@ void VertexManagerBase::Flush()
 
     if (PerfQueryBase::ShouldEmulate())
       g_perf_query->EnableQuery(bpmem.zcontrol.early_ztest ? PQG_ZCOMP_ZCOMPLOC : PQG_ZCOMP);
-    g_vertex_manager->vFlush();
+    {
+      StageTimers::Scope stage_scope(StageTimers::Stage::Backend);
+      g_vertex_manager->vFlush();
+    }
     if (PerfQueryBase::ShouldEmulate())
       g_perf_query->DisableQuery(bpmem.zcontrol.early_ztest ? PQG_ZCOMP_ZCOMPLOC : PQG_ZCOMP);
   }
@@ -405,6 +423,50 @@ void VertexManagerBase::Flush()
 
   m_is_flushed = true;
   m_cull_all = false;
+  m_posmtx_changes.clear();
+}
+
+bool VertexManagerBase::MergePosNormalMatrixChange(u32 old_index, u32 new_index)
+{
+  // Nothing is pending, so there is nothing to flush.
+  if (m_is_flushed)
+    return true;
+
+  if (!g_ActiveConfig.CanMergeMatrixChanges() || m_cull_all)
+    return false;
+
+  // The pending vertices carry their own matrix index and don't use the shared one.
+  if (VertexLoaderManager::g_current_components & VB_HAS_POSMTXIDX)
+    return true;
+
+  const u32 first_vertex = IndexGenerator::GetNumVerts();
+  const u32 first_index = IndexGenerator::GetIndexLen();
+  if (m_posmtx_changes.empty())
+    m_posmtx_changes.push_back({0, 0, old_index});
+
+  // No vertices were drawn with the previous index.
+  if (m_posmtx_changes.back().first_vertex == first_vertex)
+  {
+    m_posmtx_changes.back().index = new_index;
+    return true;
+  }
+
+  if (m_posmtx_changes.size() == MAX_POSMTX_BATCH)
+    return false;
+
+  m_posmtx_changes.push_back({first_vertex, first_index, new_index});
+  return true;
+}
+
+u32 VertexManagerBase::GetPosMatrixIndex(u32 vertex) const
+{
+  u32 index = g_main_cp_state.matrix_index_a.PosNormalMtxIdx;
+  for (const PosMatrixChange& change : m_posmtx_changes)
+  {
+    if (vertex >= change.first_vertex)
+      index = change.index;
+  }
+  return index;
 }
 
 int VertexManagerBase::GetNumberOfVertices()
@@ -434,8 +496,8 @@ void VertexManagerBase::CalculateZSlope(NativeVertexFormat* format)
     return;
   }
 
-  // Global matrix ID.
-  u32 mtxIdx = g_main_cp_state.matrix_index_a.PosNormalMtxIdx;
+  // Global matrix ID, of the last vertex if matrix changes were merged into this draw.
+  u32 mtxIdx = GetPosMatrixIndex(IndexGenerator::GetNumVerts() - 1);
   const PortableVertexDeclaration vert_decl = format->GetVertexDeclaration();
 
   // Make sure the buffer contains at least 3 vertices.
@@ -76,6 +76,21 @@ public:
 
   int GetNumberOfVertices();
 
+  // With Config::GFX_HACK_MERGE_MATRIX_CHANGES, vertices drawn with different position/normal
+  // matrix indices share one draw, and the vertex shader picks the matrix by vertex ID.
+  struct PosMatrixChange
+  {
+    u32 first_vertex;  // since the start of the buffer
+    u32 first_index;   // into the index buffer, for backends which draw every change separately
+    u32 index;         // PosNormalMtxIdx
+  };
+  // Returns false if the pending vertices have to be flushed before the index can change.
+  bool MergePosNormalMatrixChange(u32 old_index, u32 new_index);
+  // Empty if no changes were merged into the pending draw.
+  const std::vector<PosMatrixChange>& GetPosMatrixChanges() const { return m_posmtx_changes; }
+  // Vertex ID the vertex shader sees for the first vertex in the buffer.
+  virtual u32 GetVertexIDBase() const { return 0; }
+
 protected:
   virtual void vDoState(PointerWrap& p) {}
   virtual void ResetBuffer(u32 stride) = 0;
@@ -100,7 +115,10 @@ protected:
   PrimitiveType m_current_primitive_type = PrimitiveType::Points;
 
 private:
+  u32 GetPosMatrixIndex(u32 vertex) const;
+
   bool m_is_flushed = true;
+  std::vector<PosMatrixChange> m_posmtx_changes;
   size_t m_flush_count_4_3 = 0;
   size_t m_flush_count_anamorphic = 0;
 
@@ -11,6 +11,7 @@
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/LightingShaderGen.h"
 #include "VideoCommon/NativeVertexFormat.h"
+#include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexLoaderManager.h"
 #include "VideoCommon/VertexShaderGen.h"
 #include "VideoCommon/VideoCommon.h"
@@ -86,6 +87,90 @@ VertexShaderUid GetVertexShaderUid()
   return out;
 }
 
+void ClearUnusedVertexShaderUidBits(APIType api_type, VertexShaderUid* uid)
+{
+  static ShaderUidMergeCounter<VertexShaderUid> s_merge_counter;
+  const VertexShaderUid raw_uid = *uid;
+  vertex_shader_uid_data* uid_data = uid->GetUidData<vertex_shader_uid_data>();
+
+  bool has_regular_texgen = false;
+  for (unsigned int i = 0; i < uid_data->numTexGens; ++i)
+  {
+    auto& texinfo = uid_data->texMtxInfo[i];
+    switch (texinfo.texgentype)
+    {
+    case XF_TEXGEN_EMBOSS_MAP:
+    case XF_TEXGEN_COLOR_STRGBC0:
+    case XF_TEXGEN_COLOR_STRGBC1:
+      // These don't transform the input coordinate, so its source doesn't matter.
+      texinfo.sourcerow = XF_SRCGEOM_INROW;
+      texinfo.inputform = XF_TEXINPUT_AB11;
+      break;
+    case XF_TEXGEN_REGULAR:
+      has_regular_texgen = true;
+      break;
+    }
+  }
+
+  // Dual texture transforms are only applied to regular texgens.
+  if (!has_regular_texgen)
+    uid_data->dualTexTrans_enabled = 0;
+
+  stats.numVertexShaderUidsMerged = s_merge_counter.Add(raw_uid, *uid);
+}
+
+void WriteInstancedStereoUniforms(ShaderCode& out)
+{
+  // The stereo parameters live in the geometry shader constants, which are bound in any case.
+  out.Write("UBO_BINDING(std140, 3) uniform GSBlock {\n"
+            "\tfloat4 " I_STEREOPARAMS ";\n"
+            "\tfloat4 " I_LINEPTPARAMS ";\n"
+            "\tint4 " I_TEXOFFSET ";\n"
+            "};\n");
+}
+
+void WriteInstancedStereoTransform(ShaderCode& out, APIType api_type,
+                                   const ShaderHostConfig& host_config)
+{
+  out.Write("int eye = %s;\n", api_type == APIType::Vulkan ? "gl_InstanceIndex" : "gl_InstanceID");
+
+  // These are the same offsets GeometryShaderGen applies, see there for details.
+  if (host_config.vr)
+  {
+    out.Write("o.clipPos.x += " I_STEREOPARAMS "[eye] - " I_STEREOPARAMS
+              "[eye+2] * o.clipPos.w;\n");
+    out.Write("o.pos.x += " I_STEREOPARAMS "[eye] - " I_STEREOPARAMS "[eye+2] * o.pos.w;\n");
+  }
+  else
+  {
+    out.Write("float hoffset = (eye == 0) ? " I_STEREOPARAMS ".x : " I_STEREOPARAMS ".y;\n");
+    out.Write("o.pos.x += hoffset * (o.pos.w - " I_STEREOPARAMS ".z);\n");
+  }
+
+  out.Write("gl_Layer = eye;\n");
+}
+
+void WriteMergedDrawMatrixIndex(ShaderCode& out, APIType api_type,
+                                const ShaderHostConfig& host_config)
+{
+  // Every merged draw is a separate command of a multi-draw, see OGL::VertexManager.
+  if (host_config.backend_multi_draw_indirect && api_type == APIType::OpenGL)
+  {
+    out.Write("posidx = " I_POSMTXBATCH "[gl_DrawIDARB].y;\n");
+    return;
+  }
+
+  const char* vertex_id = api_type == APIType::Vulkan ?
+                              "gl_VertexIndex" :
+                              api_type == APIType::OpenGL ? "gl_VertexID" : "vertex_id";
+  out.Write("posidx = " I_POSMTXBATCH "[0].y;\n");
+  out.Write("for (int i = 1; i < " I_POSMTXBATCHINFO ".x; i++) {\n"
+            "  if (int(%s) - " I_POSMTXBATCHINFO ".y >= " I_POSMTXBATCH "[i].x)\n"
+            "    posidx = " I_POSMTXBATCH "[i].y;\n"
+            "}\n",
+            vertex_id);
+}
+
 ShaderCode GenerateVertexShaderCode(APIType api_type, const ShaderHostConfig& host_config,
                                     const vertex_shader_uid_data* uid_data)
 {
@@ -107,6 +192,9 @@ ShaderCode GenerateVertexShaderCode(APIType api_type, const ShaderHostConfig& ho
   out.Write(s_shader_uniforms);
   out.Write("};\n");
 
+  if (host_config.UseInstancedStereo())
+    WriteInstancedStereoUniforms(out);
+
   out.Write("struct VS_OUTPUT {\n");
   GenerateVSOutputMembers(out, api_type, uid_data->numTexGens, per_pixel_lighting, "");
   out.Write("};\n");
@@ -144,6 +232,8 @@ ShaderCode GenerateVertexShaderCode(APIType api_type, const ShaderHostConfig& ho
       out.Write("VARYING_LOCATION(0) out VertexData {\n");
       GenerateVSOutputMembers(out, api_type, uid_data->numTexGens, per_pixel_lighting,
                               GetInterpolationQualifier(msaa, ssaa, true, false));
+      if (host_config.UseInstancedStereo())
+        out.Write("\tflat int layer;\n");
       out.Write("} vs;\n");
     }
     else
@@ -191,15 +281,21 @@ ShaderCode GenerateVertexShaderCode(APIType api_type, const ShaderHostConfig& ho
     }
     if (uid_data->components & VB_HAS_POSMTXIDX)
       out.Write("  uint4 posmtx : BLENDINDICES,\n");
+    else if (host_config.merged_draws)
+      out.Write("  uint vertex_id : SV_VertexID,\n");
     out.Write("  float4 rawpos : POSITION) {\n");
   }
 
   out.Write("VS_OUTPUT o;\n");
 
   // transforms
-  if (uid_data->components & VB_HAS_POSMTXIDX)
+  if ((uid_data->components & VB_HAS_POSMTXIDX) || host_config.merged_draws)
   {
-    out.Write("int posidx = int(posmtx.r);\n");
+    out.Write("int posidx;\n");
+    if (uid_data->components & VB_HAS_POSMTXIDX)
+      out.Write("posidx = int(posmtx.r);\n");
+    else
+      WriteMergedDrawMatrixIndex(out, api_type, host_config);
     out.Write("float4 pos = float4(dot(" I_TRANSFORMMATRICES
               "[posidx], rawpos), dot(" I_TRANSFORMMATRICES
               "[posidx+1], rawpos), dot(" I_TRANSFORMMATRICES "[posidx+2], rawpos), 1);\n");
@@ -496,9 +592,14 @@ ShaderCode GenerateVertexShaderCode(APIType api_type, const ShaderHostConfig& ho
 
   if (api_type == APIType::OpenGL || api_type == APIType::Vulkan)
   {
+    if (host_config.UseInstancedStereo())
+      WriteInstancedStereoTransform(out, api_type, host_config);
+
     if (host_config.backend_geometry_shaders || api_type == APIType::Vulkan)
     {
       AssignVSOutputMembers(out, "vs", "o", uid_data->numTexGens, per_pixel_lighting);
+      if (host_config.UseInstancedStereo())
+        out.Write("vs.layer = eye;\n");
     }
     else
     {
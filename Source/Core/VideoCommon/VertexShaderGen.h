@@ -65,5 +65,17 @@ struct vertex_shader_uid_data
 typedef ShaderUid<vertex_shader_uid_data> VertexShaderUid;
 
 VertexShaderUid GetVertexShaderUid();
+// Zeroes the bits that don't affect the generated code, so equivalent UIDs share a shader.
+void ClearUnusedVertexShaderUidBits(APIType api_type, VertexShaderUid* uid);
 ShaderCode GenerateVertexShaderCode(APIType api_type, const ShaderHostConfig& host_config,
                                     const vertex_shader_uid_data* uid_data);
+
+// Shared with the vertex ubershader, for ShaderHostConfig::UseInstancedStereo().
+void WriteInstancedStereoUniforms(ShaderCode& out);
+// Offsets o.pos for the eye given by the instance index, and selects its layer.
+void WriteInstancedStereoTransform(ShaderCode& out, APIType api_type,
+                                   const ShaderHostConfig& host_config);
+// Sets posidx to the matrix of the merged draw the vertex belongs to, for
+// ShaderHostConfig::merged_draws. D3D shaders need a vertex_id input.
+void WriteMergedDrawMatrixIndex(ShaderCode& out, APIType api_type,
+                                const ShaderHostConfig& host_config);
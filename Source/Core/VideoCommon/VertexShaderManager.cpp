@@ -2,6 +2,8 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <array>
 #include <cfloat>
 #include <cmath>
 #include <cstring>
@@ -43,10 +45,11 @@ static bool bTexMatricesChanged[2], bPosNormalMatrixChanged, bProjectionChanged,
     bFreeLookChanged, bFrameChanged;
 static bool bTexMtxInfoChanged, bLightingConfigChanged;
 static BitSet32 nMaterialsChanged;
-static int nTransformMatricesChanged[2];      // min,max
-static int nNormalMatricesChanged[2];         // min,max
-static int nPostTransformMatricesChanged[2];  // min,max
-static int nLightsChanged[2];                 // min,max
+// One bit per matrix or light, so that only the ones written to are converted again.
+static BitSet64 nTransformMatricesChanged;      // 64 matrices of 4 floats
+static BitSet64 nNormalMatricesChanged;         // 32 matrices of 3 floats
+static BitSet64 nPostTransformMatricesChanged;  // 64 matrices of 4 floats
+static BitSet64 nLightsChanged;                 // 8 lights of 16 words
 
 static Matrix44 s_viewportCorrection;
 static Matrix33 s_viewRotationMatrix;
@@ -60,6 +63,7 @@ VertexShaderConstants VertexShaderManager::constants;
 std::vector<VertexShaderConstants> VertexShaderManager::constants_replay;
 float4 VertexShaderManager::constants_eye_projection[2][4];
 bool VertexShaderManager::m_layer_on_top;
+bool VertexShaderManager::m_layer_hidden;
 
 bool VertexShaderManager::dirty;
 
@@ -496,7 +500,7 @@ void LogProj(float p[])
       break;
     case 0:
     default:
-      g_metroid_layer = METROID_UNKNOWN;
+      g_metroid_layer = GetVRLayerFromRules(debug_projNum, hfov, vfov, n, f);
       break;
     }
 
@@ -748,14 +752,10 @@ static void ViewportCorrectionMatrix(Matrix44& result)
 void VertexShaderManager::Init()
 {
   // Initialize state tracking variables
-  nTransformMatricesChanged[0] = -1;
-  nTransformMatricesChanged[1] = -1;
-  nNormalMatricesChanged[0] = -1;
-  nNormalMatricesChanged[1] = -1;
-  nPostTransformMatricesChanged[0] = -1;
-  nPostTransformMatricesChanged[1] = -1;
-  nLightsChanged[0] = -1;
-  nLightsChanged[1] = -1;
+  nTransformMatricesChanged = BitSet64(0);
+  nNormalMatricesChanged = BitSet64(0);
+  nPostTransformMatricesChanged = BitSet64(0);
+  nLightsChanged = BitSet64(0);
   nMaterialsChanged = BitSet32(0);
   bTexMatricesChanged[0] = false;
   bTexMatricesChanged[1] = false;
@@ -766,6 +766,7 @@ void VertexShaderManager::Init()
   bLightingConfigChanged = false;
 
   m_layer_on_top = false;
+  m_layer_hidden = false;
 
   std::memset(&xfmem, 0, sizeof(xfmem));
   constants = {};
@@ -788,6 +789,7 @@ void VertexShaderManager::Init()
     g_game_camera_pos[i] = totalpos[i] = oldpos[i] = 0;
   }
   s_had_skybox = false;
+  LoadVRLayerRules();
 
   dirty = true;
 }
@@ -808,47 +810,43 @@ void VertexShaderManager::SetConstants()
 {
   static bool temp_skybox = false;
   bool position_changed = false, skybox_changed = false;
-  if (nTransformMatricesChanged[0] >= 0)
+  if (nTransformMatricesChanged)
   {
-    int startn = nTransformMatricesChanged[0] / 4;
-    int endn = (nTransformMatricesChanged[1] + 3) / 4;
-    memcpy(constants.transformmatrices[startn].data(), &xfmem.posMatrices[startn * 4],
-           (endn - startn) * sizeof(float4));
+    for (int i : nTransformMatricesChanged)
+    {
+      memcpy(constants.transformmatrices[i].data(), &xfmem.posMatrices[i * 4], sizeof(float4));
+    }
     dirty = true;
-    nTransformMatricesChanged[0] = nTransformMatricesChanged[1] = -1;
+    nTransformMatricesChanged = BitSet64(0);
     position_changed = true;
   }
 
-  if (nNormalMatricesChanged[0] >= 0)
+  if (nNormalMatricesChanged)
   {
-    int startn = nNormalMatricesChanged[0] / 3;
-    int endn = (nNormalMatricesChanged[1] + 2) / 3;
-    for (int i = startn; i < endn; i++)
+    for (int i : nNormalMatricesChanged)
     {
       memcpy(constants.normalmatrices[i].data(), &xfmem.normalMatrices[3 * i], 12);
     }
     dirty = true;
-    nNormalMatricesChanged[0] = nNormalMatricesChanged[1] = -1;
+    nNormalMatricesChanged = BitSet64(0);
   }
 
-  if (nPostTransformMatricesChanged[0] >= 0)
+  if (nPostTransformMatricesChanged)
   {
-    int startn = nPostTransformMatricesChanged[0] / 4;
-    int endn = (nPostTransformMatricesChanged[1] + 3) / 4;
-    memcpy(constants.posttransformmatrices[startn].data(), &xfmem.postMatrices[startn * 4],
-           (endn - startn) * sizeof(float4));
+    for (int i : nPostTransformMatricesChanged)
+    {
+      memcpy(constants.posttransformmatrices[i].data(), &xfmem.postMatrices[i * 4],
+             sizeof(float4));
+    }
     dirty = true;
-    nPostTransformMatricesChanged[0] = nPostTransformMatricesChanged[1] = -1;
+    nPostTransformMatricesChanged = BitSet64(0);
   }
 
-  if (nLightsChanged[0] >= 0)
+  if (nLightsChanged)
   {
     // TODO: Outdated comment
     // lights don't have a 1 to 1 mapping, the color component needs to be converted to 4 floats
-    int istart = nLightsChanged[0] / 0x10;
-    int iend = (nLightsChanged[1] + 15) / 0x10;
-
-    for (int i = istart; i < iend; ++i)
+    for (int i : nLightsChanged)
     {
       const Light& light = xfmem.lights[i];
       VertexShaderConstants::Light& dstlight = constants.lights[i];
@@ -891,7 +889,7 @@ void VertexShaderManager::SetConstants()
     }
     dirty = true;
 
-    nLightsChanged[0] = nLightsChanged[1] = -1;
+    nLightsChanged = BitSet64(0);
   }
 
   for (int i : nMaterialsChanged)
@@ -921,6 +919,34 @@ void VertexShaderManager::SetConstants()
     position_changed = true;
   }
 
+  if (g_ActiveConfig.CanMergeMatrixChanges())
+  {
+    const auto& changes = g_vertex_manager->GetPosMatrixChanges();
+    std::array<int4, MAX_POSMTX_BATCH> batch = {};
+    int4 batch_info = {1, 0, 0, 0};
+    if (changes.empty())
+    {
+      batch[0][1] = g_main_cp_state.matrix_index_a.PosNormalMtxIdx;
+    }
+    else
+    {
+      for (size_t i = 0; i < changes.size(); i++)
+      {
+        batch[i][0] = static_cast<s32>(changes[i].first_vertex);
+        batch[i][1] = static_cast<s32>(changes[i].index);
+      }
+      batch_info[0] = static_cast<s32>(changes.size());
+      batch_info[1] = static_cast<s32>(g_vertex_manager->GetVertexIDBase());
+    }
+
+    if (batch != constants.posmtxbatch || batch_info != constants.posmtxbatchinfo)
+    {
+      constants.posmtxbatch = batch;
+      constants.posmtxbatchinfo = batch_info;
+      dirty = true;
+    }
+  }
+
   if (bTexMatricesChanged[0])
   {
     bTexMatricesChanged[0] = false;
@@ -1068,6 +1094,79 @@ void VertexShaderManager::SetViewportConstants()
   g_renderer->SetViewport();
 }
 
+// free look * leaning back * head position * head rotation: the part of the VR view which only
+// depends on the pose, the free look camera and the scale. Games can change projection thousands
+// of times per frame, while these change once per VR frame at most, so the product is cached.
+static const Matrix44& GetVRPoseMatrix(bool stuck_to_head, bool is_skybox, float units_per_metre)
+{
+  struct PoseInputs
+  {
+    float rotation[16];
+    float position[3];
+    float free_look[3];
+    float units_per_metre;
+    float lean_back_angle;
+    u32 flags;
+  };
+  static PoseInputs s_cached_inputs;
+  static Matrix44 s_cached_matrix;
+  static bool s_cached = false;
+
+  if (stuck_to_head)
+  {
+    static Matrix44 identity = [] {
+      Matrix44 matrix;
+      Matrix44::LoadIdentity(matrix);
+      return matrix;
+    }();
+    return identity;
+  }
+
+  if (g_ActiveConfig.bOrientationTracking)
+    VR_UpdateHeadTrackingIfNeeded();
+
+  PoseInputs inputs;
+  std::memset(&inputs, 0, sizeof(inputs));
+  if (g_ActiveConfig.bOrientationTracking)
+    std::memcpy(inputs.rotation, g_head_tracking_matrix.data, sizeof(inputs.rotation));
+  if (g_ActiveConfig.bPositionTracking && !is_skybox)
+    std::memcpy(inputs.position, g_head_tracking_position, sizeof(inputs.position));
+  if (!is_skybox)
+    std::memcpy(inputs.free_look, s_fViewTranslationVector, sizeof(inputs.free_look));
+  inputs.units_per_metre = units_per_metre;
+  inputs.lean_back_angle = g_ActiveConfig.fLeanBackAngle;
+  inputs.flags = (g_ActiveConfig.bOrientationTracking ? 1 : 0) |
+                 (g_ActiveConfig.bPositionTracking ? 2 : 0) | (is_skybox ? 4 : 0);
+
+  if (s_cached && !std::memcmp(&inputs, &s_cached_inputs, sizeof(inputs)))
+    return s_cached_matrix;
+
+  Matrix44 rotation_matrix;
+  if (g_ActiveConfig.bOrientationTracking)
+    rotation_matrix = g_head_tracking_matrix;
+  else
+    Matrix44::LoadIdentity(rotation_matrix);
+
+  Matrix33 pitch_matrix33;
+  Matrix33::RotateX(pitch_matrix33, DEGREES_TO_RADIANS(g_ActiveConfig.fLeanBackAngle));
+  Matrix44 lean_back_matrix;
+  lean_back_matrix = pitch_matrix33;
+
+  Matrix44 head_position_matrix, free_look_matrix;
+  float pos[3];
+  for (int i = 0; i < 3; ++i)
+    pos[i] = inputs.position[i] * units_per_metre;
+  Matrix44::Translate(head_position_matrix, pos);
+  for (int i = 0; i < 3; ++i)
+    pos[i] = inputs.free_look[i] * units_per_metre;
+  Matrix44::Translate(free_look_matrix, pos);
+
+  s_cached_matrix = free_look_matrix * lean_back_matrix * head_position_matrix * rotation_matrix;
+  s_cached_inputs = inputs;
+  s_cached = true;
+  return s_cached_matrix;
+}
+
 void VertexShaderManager::SetProjectionConstants()
 {
   // Transformations must be applied in the following order for VR:
@@ -1086,6 +1185,7 @@ void VertexShaderManager::SetProjectionConstants()
   // First, identify any special layers and hacks
 
   m_layer_on_top = false;
+  m_layer_hidden = false;
   bool bFullscreenLayer = g_ActiveConfig.bHudFullscreen && xfmem.projection.type != GX_PERSPECTIVE;
   bool bFlashing = (debug_projNum - 1) == g_ActiveConfig.iSelectedLayer;
   bool bStuckToHead = false, bHide = false;
@@ -1275,6 +1375,7 @@ void VertexShaderManager::SetProjectionConstants()
     memset(constants.projection.data(), 0, 4 * 16);
     memset(constants_eye_projection[0], 0, 2 * 4 * 16);
     memset(GeometryShaderManager::constants.stereoparams.data(), 0, 4 * 4);
+    m_layer_hidden = true;
     return;
   }
   // don't do anything fancy for rendering to a texture
@@ -1565,34 +1666,16 @@ void VertexShaderManager::SetProjectionConstants()
     }
 
     // VR Headtracking and leaning back compensation
-    Matrix44 rotation_matrix;
-    Matrix44 lean_back_matrix;
+    const Matrix44& pose_matrix = GetVRPoseMatrix(bStuckToHead, g_is_skybox, UnitsPerMetre);
     Matrix44 camera_pitch_matrix;
     if (bStuckToHead)
     {
-      Matrix44::LoadIdentity(rotation_matrix);
-      Matrix44::LoadIdentity(lean_back_matrix);
       Matrix44::LoadIdentity(camera_pitch_matrix);
     }
     else
     {
-      // head tracking
-      if (g_ActiveConfig.bOrientationTracking)
-      {
-        VR_UpdateHeadTrackingIfNeeded();
-        rotation_matrix = g_head_tracking_matrix;
-      }
-      else
-      {
-        Matrix44::LoadIdentity(rotation_matrix);
-      }
-
       Matrix33 pitch_matrix33;
-
-      // leaning back
-      float extra_pitch = -g_ActiveConfig.fLeanBackAngle;
-      Matrix33::RotateX(pitch_matrix33, -DEGREES_TO_RADIANS(extra_pitch));
-      lean_back_matrix = pitch_matrix33;
+      float extra_pitch;
 
       // camera pitch
       if ((g_ActiveConfig.bStabilizePitch || g_ActiveConfig.bStabilizeRoll ||
@@ -1665,32 +1748,14 @@ void VertexShaderManager::SetProjectionConstants()
     }
 
     // Position matrices
-    Matrix44 head_position_matrix, free_look_matrix, camera_forward_matrix, camera_position_matrix;
+    Matrix44 camera_forward_matrix, camera_position_matrix;
     if (bStuckToHead || g_is_skybox)
     {
-      Matrix44::LoadIdentity(head_position_matrix);
-      Matrix44::LoadIdentity(free_look_matrix);
       Matrix44::LoadIdentity(camera_position_matrix);
     }
     else
     {
       float pos[3];
-      // head tracking
-      if (g_ActiveConfig.bPositionTracking)
-      {
-        for (int i = 0; i < 3; ++i)
-          pos[i] = g_head_tracking_position[i] * UnitsPerMetre;
-        Matrix44::Translate(head_position_matrix, pos);
-      }
-      else
-      {
-        Matrix44::LoadIdentity(head_position_matrix);
-      }
-
-      // freelook camera position
-      for (int i = 0; i < 3; ++i)
-        pos[i] = s_fViewTranslationVector[i] * UnitsPerMetre;
-      Matrix44::Translate(free_look_matrix, pos);
 
       // camera position stabilisation
       if (g_ActiveConfig.bStabilizeX || g_ActiveConfig.bStabilizeY || g_ActiveConfig.bStabilizeZ)
@@ -1730,8 +1795,8 @@ void VertexShaderManager::SetProjectionConstants()
         Matrix44::Translate(camera_forward_matrix, pos);
       }
 
-      look_matrix = camera_forward_matrix * camera_position_matrix * camera_pitch_matrix *
-                    free_look_matrix * lean_back_matrix * head_position_matrix * rotation_matrix;
+      look_matrix =
+          camera_forward_matrix * camera_position_matrix * camera_pitch_matrix * pose_matrix;
     }
     else
     // if (xfmem.projection.type != GX_PERSPECTIVE || g_viewport_type == VIEW_HUD_ELEMENT ||
@@ -1965,8 +2030,8 @@ void VertexShaderManager::SetProjectionConstants()
       Matrix44::Scale(scale_matrix, scale);
       Matrix44::Translate(position_matrix, position);
 	  
-	  look_matrix = scale_matrix * hud_matrix * position_matrix * camera_position_matrix * camera_pitch_matrix *
-		  free_look_matrix * lean_back_matrix * head_position_matrix * rotation_matrix;
+	  look_matrix = scale_matrix * hud_matrix * position_matrix * camera_position_matrix *
+		  camera_pitch_matrix * pose_matrix;
     }
 
     // N64 games give us coordinates that were already transformed into clip space
@@ -2056,6 +2121,7 @@ void VertexShaderManager::SetProjectionConstants()
     if (bHideLeft && (bHideRight || !(g_ActiveConfig.iStereoMode > 0)))
     {
       memset(final_matrix_left.data, 0, 16 * sizeof(final_matrix_left.data[0]));
+      m_layer_hidden = true;
     }
     if (bHideRight)
     {
@@ -2401,6 +2467,20 @@ void VertexShaderManager::LockSkybox()
 
 //#pragma optimize("", on)
 
+// The slots of slot_size words in [region_start, region_end) that overlap [start, end).
+static BitSet64 ChangedSlots(int start, int end, int region_start, int region_end, int slot_size)
+{
+  start = std::max(start, region_start);
+  end = std::min(end, region_end);
+  if (start >= end)
+    return BitSet64(0);
+
+  const int first = (start - region_start) / slot_size;
+  const int last = (end - region_start + slot_size - 1) / slot_size;
+  const u64 high = last >= 64 ? ~0ull : (1ull << last) - 1;
+  return BitSet64(high & ~((1ull << first) - 1));
+}
+
 void VertexShaderManager::InvalidateXFRange(int start, int end)
 {
   if (((u32)start >= (u32)g_main_cp_state.matrix_index_a.PosNormalMtxIdx * 4 &&
@@ -2437,94 +2517,29 @@ void VertexShaderManager::InvalidateXFRange(int start, int end)
     bTexMatricesChanged[1] = true;
   }
 
-  if (start < XFMEM_POSMATRICES_END)
-  {
-    if (nTransformMatricesChanged[0] == -1)
-    {
-      nTransformMatricesChanged[0] = start;
-      nTransformMatricesChanged[1] = end > XFMEM_POSMATRICES_END ? XFMEM_POSMATRICES_END : end;
-    }
-    else
-    {
-      if (nTransformMatricesChanged[0] > start)
-        nTransformMatricesChanged[0] = start;
-
-      if (nTransformMatricesChanged[1] < end)
-        nTransformMatricesChanged[1] = end > XFMEM_POSMATRICES_END ? XFMEM_POSMATRICES_END : end;
-    }
-  }
-
-  if (start < XFMEM_NORMALMATRICES_END && end > XFMEM_NORMALMATRICES)
-  {
-    int _start = start < XFMEM_NORMALMATRICES ? 0 : start - XFMEM_NORMALMATRICES;
-    int _end = end < XFMEM_NORMALMATRICES_END ? end - XFMEM_NORMALMATRICES :
-                                                XFMEM_NORMALMATRICES_END - XFMEM_NORMALMATRICES;
-
-    if (nNormalMatricesChanged[0] == -1)
-    {
-      nNormalMatricesChanged[0] = _start;
-      nNormalMatricesChanged[1] = _end;
-    }
-    else
-    {
-      if (nNormalMatricesChanged[0] > _start)
-        nNormalMatricesChanged[0] = _start;
-
-      if (nNormalMatricesChanged[1] < _end)
-        nNormalMatricesChanged[1] = _end;
-    }
-  }
-
-  if (start < XFMEM_POSTMATRICES_END && end > XFMEM_POSTMATRICES)
-  {
-    int _start = start < XFMEM_POSTMATRICES ? XFMEM_POSTMATRICES : start - XFMEM_POSTMATRICES;
-    int _end = end < XFMEM_POSTMATRICES_END ? end - XFMEM_POSTMATRICES :
-                                              XFMEM_POSTMATRICES_END - XFMEM_POSTMATRICES;
-
-    if (nPostTransformMatricesChanged[0] == -1)
-    {
-      nPostTransformMatricesChanged[0] = _start;
-      nPostTransformMatricesChanged[1] = _end;
-    }
-    else
-    {
-      if (nPostTransformMatricesChanged[0] > _start)
-        nPostTransformMatricesChanged[0] = _start;
-
-      if (nPostTransformMatricesChanged[1] < _end)
-        nPostTransformMatricesChanged[1] = _end;
-    }
-  }
-
-  if (start < XFMEM_LIGHTS_END && end > XFMEM_LIGHTS)
-  {
-    int _start = start < XFMEM_LIGHTS ? XFMEM_LIGHTS : start - XFMEM_LIGHTS;
-    int _end = end < XFMEM_LIGHTS_END ? end - XFMEM_LIGHTS : XFMEM_LIGHTS_END - XFMEM_LIGHTS;
-
-    if (nLightsChanged[0] == -1)
-    {
-      nLightsChanged[0] = _start;
-      nLightsChanged[1] = _end;
-    }
-    else
-    {
-      if (nLightsChanged[0] > _start)
-        nLightsChanged[0] = _start;
-
-      if (nLightsChanged[1] < _end)
-        nLightsChanged[1] = _end;
-    }
-  }
+  nTransformMatricesChanged |=
+      ChangedSlots(start, end, XFMEM_POSMATRICES, XFMEM_POSMATRICES_END, 4);
+  nNormalMatricesChanged |=
+      ChangedSlots(start, end, XFMEM_NORMALMATRICES, XFMEM_NORMALMATRICES_END, 3);
+  nPostTransformMatricesChanged |=
+      ChangedSlots(start, end, XFMEM_POSTMATRICES, XFMEM_POSTMATRICES_END, 4);
+  nLightsChanged |= ChangedSlots(start, end, XFMEM_LIGHTS, XFMEM_LIGHTS_END, 0x10);
 }
 
 void VertexShaderManager::SetTexMatrixChangedA(u32 Value)
 {
   if (g_main_cp_state.matrix_index_a.Hex != Value)
   {
-    g_vertex_manager->Flush();
-    if (g_main_cp_state.matrix_index_a.PosNormalMtxIdx != (Value & 0x3f))
+    // Draws which only change the position matrix can be merged, the texture matrices can't.
+    const u32 old_index = g_main_cp_state.matrix_index_a.PosNormalMtxIdx;
+    if (((g_main_cp_state.matrix_index_a.Hex ^ Value) & ~0x3fu) != 0 ||
+        !g_vertex_manager->MergePosNormalMatrixChange(old_index, Value & 0x3f))
+    {
+      g_vertex_manager->Flush();
+      bTexMatricesChanged[0] = true;
+    }
+    if (old_index != (Value & 0x3f))
       bPosNormalMatrixChanged = true;
-    bTexMatricesChanged[0] = true;
     g_main_cp_state.matrix_index_a.Hex = Value;
   }
 }
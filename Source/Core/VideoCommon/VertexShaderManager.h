@@ -72,6 +72,9 @@ public:
   static std::vector<VertexShaderConstants> constants_replay;
   static float4 constants_eye_projection[2][4];
   static bool m_layer_on_top;
+  // Set when the projection of the current layer is zeroed to hide it from both eyes, so its
+  // draws can be skipped.
+  static bool m_layer_hidden;
   static bool dirty;
 };
 
@@ -88,6 +88,7 @@ VideoConfig::VideoConfig()
   bSRGB = false;
   bOverdrive = true;
   bHqDistortion = false;
+  iFoveation = VR_FOVEATION_OFF;
   bDisableNearClipping = true;
   bAutoPairViveControllers = false;
   bShowHands = false;
@@ -170,6 +171,7 @@ void VideoConfig::Refresh()
   else
     bVSync = Config::Get(Config::GFX_VSYNC);
   iAdapter = Config::Get(Config::GFX_ADAPTER);
+  iFramePacing = Config::Get(Config::GFX_FRAME_PACING);
 
   bWidescreenHack = Config::Get(Config::GFX_WIDESCREEN_HACK);
   const int aspect_ratio = Config::Get(Config::GFX_ASPECT_RATIO);
@@ -181,16 +183,26 @@ void VideoConfig::Refresh()
   bUseXFB = Config::Get(Config::GFX_USE_XFB);
   bUseRealXFB = Config::Get(Config::GFX_USE_REAL_XFB);
   iSafeTextureCache_ColorSamples = Config::Get(Config::GFX_SAFE_TEXTURE_CACHE_COLOR_SAMPLES);
+  bTextureWriteTracking = Config::Get(Config::GFX_TEXTURE_WRITE_TRACKING);
+  bDisplayListCache = Config::Get(Config::GFX_DISPLAY_LIST_CACHE);
+  bStageTimers = Config::Get(Config::GFX_STAGE_TIMERS);
   bShowFPS = Config::Get(Config::GFX_SHOW_FPS);
   bShowNetPlayPing = Config::Get(Config::GFX_SHOW_NETPLAY_PING);
   bShowNetPlayMessages = Config::Get(Config::GFX_SHOW_NETPLAY_MESSAGES);
   bLogRenderTimeToFile = Config::Get(Config::GFX_LOG_RENDER_TIME_TO_FILE);
   bOverlayStats = Config::Get(Config::GFX_OVERLAY_STATS);
   bOverlayProjStats = Config::Get(Config::GFX_OVERLAY_PROJ_STATS);
+  bOverlayFrameProfile = Config::Get(Config::GFX_OVERLAY_FRAME_PROFILE);
+  bOverlayMetrics = Config::Get(Config::GFX_OVERLAY_METRICS);
   bDumpTextures = Config::Get(Config::GFX_DUMP_TEXTURES);
   bHiresTextures = Config::Get(Config::GFX_HIRES_TEXTURES);
   bConvertHiresTextures = Config::Get(Config::GFX_CONVERT_HIRES_TEXTURES);
   bCacheHiresTextures = Config::Get(Config::GFX_CACHE_HIRES_TEXTURES);
+  bAsyncHiresTextures = Config::Get(Config::GFX_ASYNC_HIRES_TEXTURES);
+  iHiresTextureCacheSize = Config::Get(Config::GFX_HIRES_TEXTURE_CACHE_SIZE);
+  iHiresTextureVRAMBudget = Config::Get(Config::GFX_HIRES_TEXTURE_VRAM_BUDGET);
+  iTexturePoolBudget = Config::Get(Config::GFX_TEXTURE_POOL_BUDGET);
+  bCacheDecodedTextures = Config::Get(Config::GFX_CACHE_DECODED_TEXTURES);
   bDumpEFBTarget = Config::Get(Config::GFX_DUMP_EFB_TARGET);
   bDumpFramesAsImages = Config::Get(Config::GFX_DUMP_FRAMES_AS_IMAGES);
   bFreeLook = Config::Get(Config::GFX_FREE_LOOK);
@@ -201,6 +213,7 @@ void VideoConfig::Refresh()
   iBitrateKbps = Config::Get(Config::GFX_BITRATE_KBPS);
   bInternalResolutionFrameDumps = Config::Get(Config::GFX_INTERNAL_RESOLUTION_FRAME_DUMPS);
   bEnableGPUTextureDecoding = Config::Get(Config::GFX_ENABLE_GPU_TEXTURE_DECODING);
+  bUse32BitIndices = Config::Get(Config::GFX_USE_32BIT_INDICES);
   bEnablePixelLighting = Config::Get(Config::GFX_ENABLE_PIXEL_LIGHTING);
   bFastDepthCalc = Config::Get(Config::GFX_FAST_DEPTH_CALC);
 
@@ -222,6 +235,9 @@ void VideoConfig::Refresh()
       iEFBScale = iInternalResolution + (iInternalResolution >= 0) + (iInternalResolution > 1) + (iInternalResolution > 2);
 	}
   }
+  bDynamicResolution = Config::Get(Config::GFX_DYNAMIC_RESOLUTION) && !ARBruteForcer::ch_bruteforce;
+  fDynamicResolutionMin = Config::Get(Config::GFX_DYNAMIC_RESOLUTION_MIN);
+  fDynamicResolutionMax = Config::Get(Config::GFX_DYNAMIC_RESOLUTION_MAX);
 
   bTexFmtOverlayEnable = Config::Get(Config::GFX_TEXFMT_OVERLAY_ENABLE);
   bTexFmtOverlayCenter = Config::Get(Config::GFX_TEXFMT_OVERLAY_CENTER);
@@ -231,12 +247,14 @@ void VideoConfig::Refresh()
   bEnableValidationLayer = Config::Get(Config::GFX_ENABLE_VALIDATION_LAYER);
   bBackendMultithreading = Config::Get(Config::GFX_BACKEND_MULTITHREADING);
   iCommandBufferExecuteInterval = Config::Get(Config::GFX_COMMAND_BUFFER_EXECUTE_INTERVAL);
+  iFramesInFlight = Config::Get(Config::GFX_FRAMES_IN_FLIGHT);
   bShaderCache = Config::Get(Config::GFX_SHADER_CACHE);
   bBackgroundShaderCompiling = Config::Get(Config::GFX_BACKGROUND_SHADER_COMPILING);
   bDisableSpecializedShaders = Config::Get(Config::GFX_DISABLE_SPECIALIZED_SHADERS);
   bPrecompileUberShaders = Config::Get(Config::GFX_PRECOMPILE_UBER_SHADERS);
   iShaderCompilerThreads = Config::Get(Config::GFX_SHADER_COMPILER_THREADS);
   iShaderPrecompilerThreads = Config::Get(Config::GFX_SHADER_PRECOMPILER_THREADS);
+  iVertexLoaderThreads = Config::Get(Config::GFX_VERTEX_LOADER_THREADS);
 
   bZComploc = Config::Get(Config::GFX_SW_ZCOMPLOC);
   bZFreeze = Config::Get(Config::GFX_SW_ZFREEZE);
@@ -245,6 +263,7 @@ void VideoConfig::Refresh()
   bDumpTevTextureFetches = Config::Get(Config::GFX_SW_DUMP_TEV_TEX_FETCHES);
   drawStart = Config::Get(Config::GFX_SW_DRAW_START);
   drawEnd = Config::Get(Config::GFX_SW_DRAW_END);
+  iSWRasterizerThreads = Config::Get(Config::GFX_SW_RASTERIZER_THREADS);
 
   bForceFiltering = Config::Get(Config::GFX_ENHANCE_FORCE_FILTERING);
   iMaxAnisotropy = Config::Get(Config::GFX_ENHANCE_MAX_ANISOTROPY);
@@ -262,13 +281,19 @@ void VideoConfig::Refresh()
   iStereoDepthPercentage = Config::Get(Config::GFX_STEREO_DEPTH_PERCENTAGE);
 
   bEFBAccessEnable = Config::Get(Config::GFX_HACK_EFB_ACCESS_ENABLE);
+  bAsyncEFBPeeks = Config::Get(Config::GFX_HACK_ASYNC_EFB_PEEKS);
   bBBoxEnable = Config::Get(Config::GFX_HACK_BBOX_ENABLE);
   bBBoxPreferStencilImplementation =
       Config::Get(Config::GFX_HACK_BBOX_PREFER_STENCIL_IMPLEMENTATION);
+  bBBoxAsyncReadback = Config::Get(Config::GFX_HACK_BBOX_ASYNC_READBACK);
+  bPerfQueriesAsync = Config::Get(Config::GFX_HACK_PERF_QUERIES_ASYNC);
+  bMergeMatrixChanges = Config::Get(Config::GFX_HACK_MERGE_MATRIX_CHANGES);
   bForceProgressive = Config::Get(Config::GFX_HACK_FORCE_PROGRESSIVE);
   bEFBCopyEnable = Config::Get(Config::GFX_HACK_EFB_COPY_ENABLE);
   bEFBCopyClearDisable = Config::Get(Config::GFX_HACK_EFB_COPY_CLEAR_DISABLE);
   bSkipEFBCopyToRam = Config::Get(Config::GFX_HACK_SKIP_EFB_COPY_TO_RAM);
+  bSkipXFBCopyToRam = Config::Get(Config::GFX_HACK_SKIP_XFB_COPY_TO_RAM);
+  bDeferEFBCopies = Config::Get(Config::GFX_HACK_DEFER_EFB_COPIES);
   bCopyEFBScaled = Config::Get(Config::GFX_HACK_COPY_EFB_ENABLED);
   bEFBEmulateFormatChanges = Config::Get(Config::GFX_HACK_EFB_EMULATE_FORMAT_CHANGES);
   bVertexRounding = Config::Get(Config::GFX_HACK_VERTEX_ROUDING);
@@ -350,6 +375,7 @@ void VideoConfig::Refresh()
   bSRGB = Config::Get(Config::GLOBAL_VR_SRGB);
   bOverdrive = Config::Get(Config::GLOBAL_VR_OVERDRIVE);
   bHqDistortion = Config::Get(Config::GLOBAL_VR_HQ_DISTORTION);
+  iFoveation = Config::Get(Config::GLOBAL_VR_FOVEATION);
   bDisableNearClipping = Config::Get(Config::GLOBAL_VR_DISABLE_NEAR_CLIPPING);
   bAutoPairViveControllers = Config::Get(Config::GLOBAL_VR_AUTO_PAIR_VIVE_CONTROLLERS);
   bShowHands = Config::Get(Config::GLOBAL_VR_SHOW_HANDS);
@@ -584,6 +610,22 @@ u32 VideoConfig::GetShaderPrecompilerThreads() const
     return GetNumAutoShaderCompilerThreads();
 }
 
+u32 VideoConfig::GetVertexLoaderThreads() const
+{
+  if (iVertexLoaderThreads >= 0)
+    return static_cast<u32>(iVertexLoaderThreads);
+  else
+    return GetNumAutoShaderCompilerThreads();
+}
+
+u32 VideoConfig::GetSWRasterizerThreads() const
+{
+  if (iSWRasterizerThreads >= 0)
+    return static_cast<u32>(iSWRasterizerThreads);
+  else
+    return static_cast<u32>(std::max(cpu_info.num_cores - 1, 0));
+}
+
 bool VideoConfig::CanPrecompileUberShaders() const
 {
   // We don't want to precompile ubershaders if they're never going to be used.
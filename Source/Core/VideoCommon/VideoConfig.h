@@ -85,6 +85,7 @@ struct VideoConfig final
 
   // General
   bool bVSync;
+  int iFramePacing;  // FramePacingMode
   bool bWidescreenHack;
   int iAspectRatio;
   bool bCrop;  // Aspect ratio controls.
@@ -97,6 +98,9 @@ struct VideoConfig final
   bool bSSAA;
   int iEFBScale;
   int iInternalResolution;
+  bool bDynamicResolution;
+  float fDynamicResolutionMin;
+  float fDynamicResolutionMax;
   bool bForceFiltering;
   int iMaxAnisotropy;
   std::string sPostProcessingShader;
@@ -108,6 +112,8 @@ struct VideoConfig final
   bool bShowNetPlayMessages;
   bool bOverlayStats;
   bool bOverlayProjStats;
+  bool bOverlayFrameProfile;
+  bool bOverlayMetrics;
   bool bTexFmtOverlayEnable;
   bool bTexFmtOverlayCenter;
   bool bLogRenderTimeToFile;
@@ -121,6 +127,11 @@ struct VideoConfig final
   bool bHiresTextures;
   bool bConvertHiresTextures;
   bool bCacheHiresTextures;
+  bool bAsyncHiresTextures;
+  int iHiresTextureCacheSize;   // MB of decoded custom textures kept in RAM, 0 = automatic
+  int iHiresTextureVRAMBudget;  // MB of custom textures kept on the GPU, 0 = unlimited
+  int iTexturePoolBudget;       // MB of unused textures kept for reuse, 0 = only a few frames
+  bool bCacheDecodedTextures;
   bool bDumpEFBTarget;
   bool bDumpFramesAsImages;
   bool bUseFFV1;
@@ -131,21 +142,42 @@ struct VideoConfig final
   bool bFreeLook;
   bool bBorderlessFullscreen;
   bool bEnableGPUTextureDecoding;
+  // Lets batches grow past 65534 vertices, only applied when the backend is started.
+  bool bUse32BitIndices;
   int iBitrateKbps;
 
   // Hacks
   bool bEFBAccessEnable;
+  // Serve EFB peeks from a copy read back at the end of the previous frame, if supported.
+  bool bAsyncEFBPeeks;
   bool bPerfQueriesEnable;
   bool bBBoxEnable;
   bool bBBoxPreferStencilImplementation;  // OpenGL-only, to see how slow it is compared to SSBOs
+  // Return the last bounding box read back instead of waiting for the GPU, if supported.
+  bool bBBoxAsyncReadback;
+  // Return the perf counters of the last completed queries instead of waiting for the GPU.
+  bool bPerfQueriesAsync;
+  // Keep drawing into the same batch when only the position/normal matrix index changes.
+  bool bMergeMatrixChanges;
   bool bForceProgressive;
 
   bool bEFBCopyEnable;
   bool bEFBCopyClearDisable;
   bool bEFBEmulateFormatChanges;
   bool bSkipEFBCopyToRam;
+  // Real XFB copies are kept as textures at the internal resolution, and the XFB is only decoded
+  // from RAM once the CPU has written to it.
+  bool bSkipXFBCopyToRam;
+  // Only write EFB copies to RAM at the next sync point, on backends which support it.
+  bool bDeferEFBCopies;
   bool bCopyEFBScaled;
   int iSafeTextureCache_ColorSamples;
+  // Skip rehashing textures whose memory wasn't written to, uses fastmem's fault handler.
+  bool bTextureWriteTracking;
+  // Reuse the decoded vertices of display lists whose memory wasn't written to.
+  bool bDisplayListCache;
+  // Log the time spent in the VideoCommon front end stages at shutdown.
+  bool bStageTimers;
   ProjectionHackConfig phack;
   float fAspectRatioHackW, fAspectRatioHackH;
   bool bEnablePixelLighting;
@@ -204,6 +236,7 @@ struct VideoConfig final
   bool bSRGB;
   bool bOverdrive;
   bool bHqDistortion;
+  int iFoveation;
   bool bDisableNearClipping;
   bool bAutoPairViveControllers;
   bool bShowHands;
@@ -291,6 +324,10 @@ struct VideoConfig final
   bool bDumpObjects;
   bool bDumpTevStages;
   bool bDumpTevTextureFetches;
+  // Number of extra threads drawing the tiles of the EFB.
+  // 0 draws everything on the GPU thread.
+  // -1 uses an automatic number based on the CPU threads.
+  int iSWRasterizerThreads;
 
   // Enable API validation layers, currently only supported with Vulkan.
   bool bEnableValidationLayer;
@@ -302,6 +339,10 @@ struct VideoConfig final
   // Currently only supported with Vulkan.
   int iCommandBufferExecuteInterval;
 
+  // Number of command buffers the GPU thread can run ahead by, usually one per frame.
+  // Currently only supported with Vulkan, which clamps it to [2, 4].
+  int iFramesInFlight;
+
   // The following options determine the ubershader mode:
   //   No ubershaders:
   //     - bBackgroundShaderCompiling = false
@@ -328,6 +369,11 @@ struct VideoConfig final
   int iShaderCompilerThreads;
   int iShaderPrecompilerThreads;
 
+  // Number of extra threads used to decode large vertex batches with the JIT vertex loaders.
+  // 0 decodes everything on the GPU thread.
+  // -1 uses an automatic number based on the CPU threads.
+  int iVertexLoaderThreads;
+
   // Static config per API
   // TODO: Move this out of VideoConfig
   struct
@@ -367,6 +413,11 @@ struct VideoConfig final
     bool bSupportsBitfield;                // Needed by UberShaders, so must stay in VideoCommon
     bool bSupportsDynamicSamplerIndexing;  // Needed by UberShaders, so must stay in VideoCommon
     bool bSupportsBPTCTextures;
+    bool bSupportsVSLayerOutput;  // Needed by ShaderGen, so must stay in VideoCommon
+    bool bSupportsMergedDraws;    // Vertex shaders can tell merged draws apart by vertex ID
+    // Merged draws are issued as one indirect draw per matrix, told apart by draw ID instead.
+    bool bSupportsMultiDrawIndirect;
+    bool bSupports32BitIndices;
   } backend_info;
 
   // Utility
@@ -390,8 +441,19 @@ struct VideoConfig final
     return backend_info.bSupportsGPUTextureDecoding && bEnableGPUTextureDecoding;
   }
   bool UseVertexRounding() const { return bVertexRounding && iEFBScale != SCALE_1X; }
+  bool Use32BitIndices() const { return backend_info.bSupports32BitIndices && bUse32BitIndices; }
+  // Draws both eyes with one instanced draw, the vertex shader selecting the layer.
+  bool UseInstancedStereo() const { return iStereoMode > 0 && backend_info.bSupportsVSLayerOutput; }
+  // The VR camera and skybox tracking rewrite the shared matrix, which merged draws don't use.
+  bool CanMergeMatrixChanges() const
+  {
+    return bMergeMatrixChanges && backend_info.bSupportsMergedDraws &&
+           iStereoMode < STEREO_OCULUS;
+  }
   u32 GetShaderCompilerThreads() const;
   u32 GetShaderPrecompilerThreads() const;
+  u32 GetVertexLoaderThreads() const;
+  u32 GetSWRasterizerThreads() const;
   bool CanPrecompileUberShaders() const;
   bool CanBackgroundCompileShaders() const;
 };
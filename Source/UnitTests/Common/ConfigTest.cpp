@@ -0,0 +1,72 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>  // NOLINT
+
+#include "Common/Config/Config.h"
+
+class ConfigTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    Config::AddLayer(std::make_unique<Config::Layer>(Config::LayerType::Base));
+    Config::Init();
+  }
+  void TearDown() override { Config::Shutdown(); }
+};
+
+static const Config::ConfigInfo<int> TEST_INT{{Config::System::Main, "Test", "Int"}, 1};
+static const Config::ConfigInfo<std::string> TEST_STRING{{Config::System::Main, "Test", "String"},
+                                                          "default"};
+
+TEST_F(ConfigTest, GetFollowsChangesOfTheLayers)
+{
+  EXPECT_EQ(1, Config::Get(TEST_INT));
+  EXPECT_EQ(1, Config::Get(TEST_INT));
+
+  Config::SetBase(TEST_INT, 2);
+  EXPECT_EQ(2, Config::Get(TEST_INT));
+  Config::SetCurrent(TEST_INT, 3);
+  EXPECT_EQ(3, Config::Get(TEST_INT));
+  Config::GetLayer(Config::LayerType::CurrentRun)->DeleteKey(TEST_INT.location);
+  EXPECT_EQ(2, Config::Get(TEST_INT));
+
+  // Changed without going through Config::Set
+  Config::GetLayer(Config::LayerType::Base)->Set(TEST_INT, 4);
+  EXPECT_EQ(4, Config::Get(TEST_INT));
+}
+
+TEST_F(ConfigTest, GetFollowsAddedAndRemovedLayers)
+{
+  auto layer = std::make_unique<Config::Layer>(Config::LayerType::LocalGame);
+  layer->Set(TEST_INT, 5);
+  EXPECT_EQ(1, Config::Get(TEST_INT));
+  Config::AddLayer(std::move(layer));
+  EXPECT_EQ(5, Config::Get(TEST_INT));
+  Config::RemoveLayer(Config::LayerType::LocalGame);
+  EXPECT_EQ(1, Config::Get(TEST_INT));
+
+  Config::SetCurrent(TEST_INT, 6);
+  EXPECT_EQ(6, Config::Get(TEST_INT));
+  Config::ClearCurrentRunLayer();
+  EXPECT_EQ(1, Config::Get(TEST_INT));
+}
+
+TEST_F(ConfigTest, CopiesAndUncachedTypes)
+{
+  const Config::ConfigInfo<int> copy = TEST_INT;
+  EXPECT_EQ(1, Config::Get(TEST_INT));
+  EXPECT_EQ(1, Config::Get(copy));
+  Config::SetBase(TEST_INT, 7);
+  EXPECT_EQ(7, Config::Get(copy));
+  EXPECT_EQ(7, Config::Get(TEST_INT));
+
+  EXPECT_EQ("default", Config::Get(TEST_STRING));
+  Config::SetBase(TEST_STRING, std::string("changed"));
+  EXPECT_EQ("changed", Config::Get(TEST_STRING));
+}
@@ -0,0 +1,58 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Hash.h"
+
+static std::vector<u8> MakeData(size_t size)
+{
+  std::vector<u8> data(size);
+  for (size_t i = 0; i < data.size(); i++)
+    data[i] = static_cast<u8>(i * 2654435761U >> 24);
+  return data;
+}
+
+TEST(Hash, XXH3MatchesReference)
+{
+  SetHash64Function();
+  const std::vector<u8> data = MakeData(5000);
+
+  // Computed with XXH3_64bits() of xxHash 0.8, covering each of its length ranges.
+  const std::vector<std::pair<size_t, u64>> expected = {
+      {0, 0x2d06800538d394c2ULL},    {1, 0xc44bdff4074eecdbULL},    {3, 0xe14090f554a5ea90ULL},
+      {4, 0x2e8d078a566e9749ULL},    {8, 0xcd1c7f88482fcaefULL},    {9, 0xbfe43def699fa9e3ULL},
+      {16, 0x81e9eb8634460bb9ULL},   {17, 0x9998430fd0a655beULL},   {128, 0x75eca5c5d5594884ULL},
+      {129, 0xa05da42e7a4e4667ULL},  {240, 0x5eb2467c8c9e3969ULL},  {241, 0x2d431e984c441f15ULL},
+      {1024, 0xe99def1145f12936ULL}, {1025, 0x83cba9b371e4e7f4ULL}, {4096, 0x9bf67f8deff876aeULL},
+      {5000, 0xb9daede5f99f736eULL},
+  };
+  for (const auto& entry : expected)
+    EXPECT_EQ(entry.second, GetXXH3Hash64(data.data(), entry.first)) << "length " << entry.first;
+}
+
+TEST(Hash, UnsampledHashIsXXH3)
+{
+  SetHash64Function();
+  const std::vector<u8> data = MakeData(4096);
+
+  EXPECT_EQ(GetXXH3Hash64(data.data(), data.size()), GetHash64(data.data(), 4096, 0));
+  // Enough samples to cover every 64 bit word also hash everything.
+  EXPECT_EQ(GetXXH3Hash64(data.data(), data.size()), GetHash64(data.data(), 4096, 512));
+}
+
+TEST(Hash, SampledHashSkipsData)
+{
+  SetHash64Function();
+  std::vector<u8> data = MakeData(4096);
+  const u64 hash = GetHash64(data.data(), 4096, 16);
+
+  // Neither the CRC nor the MurmurHash3 variant samples the fourth 64 bit word.
+  data[24] ^= 0xFF;
+  EXPECT_EQ(hash, GetHash64(data.data(), 4096, 16));
+}
@@ -0,0 +1,129 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>  // NOLINT
+
+#include "Common/FileUtil.h"
+#include "Common/IniFile.h"
+
+namespace
+{
+class IniFileTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_directory = File::CreateTempDir();
+    m_path = m_directory + "/test.ini";
+  }
+
+  void TearDown() override { File::DeleteDirRecursively(m_directory); }
+
+  bool Load(IniFile* ini, const std::string& contents, bool keep_current_data = false)
+  {
+    return File::WriteStringToFile(contents, m_path) && ini->Load(m_path, keep_current_data);
+  }
+
+  std::string m_directory;
+  std::string m_path;
+};
+}  // namespace
+
+TEST_F(IniFileTest, ParsesKeysAndLines)
+{
+  IniFile ini;
+  ASSERT_TRUE(Load(&ini, "\xEF\xBB\xBF"
+                         "Ignored = before any section\r\n"
+                         "[Core]\r\n"
+                         "  CPUThread   =  True  \r\n"
+                         "GFXBackend = \"OGL\"\n"
+                         "Empty =\n"
+                         "Quote = \"\n"
+                         "= value without key\n"
+                         "\n"
+                         "[OnFrame] not part of the name\n"
+                         "$Infinite Health\n"
+                         "0x80001234:dword:0x00000001\n"
+                         "# comment\n"
+                         "+$Enabled\n"
+                         "[Broken\n"
+                         "Last = line without eol"));
+
+  std::string value;
+  EXPECT_FALSE(ini.Exists("Ignored", ""));
+  EXPECT_TRUE(ini.GetOrCreateSection("Core")->Get("CPUThread", &value));
+  EXPECT_EQ("True", value);
+  EXPECT_TRUE(ini.GetOrCreateSection("Core")->Get("GFXBackend", &value));
+  EXPECT_EQ("OGL", value);
+  EXPECT_TRUE(ini.Exists("Core", "Empty"));
+  EXPECT_TRUE(ini.GetOrCreateSection("Core")->Get("Quote", &value));
+  EXPECT_EQ("", value);
+  EXPECT_TRUE(ini.GetOrCreateSection("Core")->Get("", &value));
+  EXPECT_EQ("value without key", value);
+
+  std::vector<std::string> keys;
+  EXPECT_TRUE(ini.GetKeys("Core", &keys));
+  EXPECT_EQ((std::vector<std::string>{"CPUThread", "GFXBackend", "Empty", "Quote", ""}), keys);
+
+  // A section header without a ']' is dropped, so the last line belongs to OnFrame.
+  std::vector<std::string> lines;
+  EXPECT_TRUE(ini.GetLines("OnFrame", &lines, false));
+  EXPECT_EQ((std::vector<std::string>{"$Infinite Health", "0x80001234:dword:0x00000001",
+                                      "# comment", "+$Enabled"}),
+            lines);
+  EXPECT_TRUE(ini.Exists("OnFrame", "Last"));
+  EXPECT_FALSE(ini.GetOrCreateSection("Broken")->Exists("Last"));
+}
+
+TEST_F(IniFileTest, FindsSectionsCaseInsensitively)
+{
+  IniFile ini;
+  ASSERT_TRUE(Load(&ini, "[Video_Settings]\nA = 1\n[video_settings]\nB = 2\n"));
+  ASSERT_TRUE(Load(&ini, "[VIDEO_SETTINGS]\nA = 3\n[Other]\n", true));
+
+  EXPECT_EQ(2u, ini.GetSections().size());
+  EXPECT_EQ("Video_Settings", ini.GetSections().front().GetName());
+  int value = 0;
+  EXPECT_TRUE(ini.GetOrCreateSection("video_SETTINGS")->Get("A", &value));
+  EXPECT_EQ(3, value);
+  EXPECT_TRUE(ini.Exists("Video_Settings", "B"));
+
+  EXPECT_TRUE(ini.DeleteSection("VIDEO_settings"));
+  EXPECT_FALSE(ini.Exists("Video_Settings", "A"));
+  EXPECT_EQ(1u, ini.GetSections().size());
+
+  ASSERT_TRUE(Load(&ini, "[Core]\n"));
+  EXPECT_FALSE(ini.Exists("Other", "A"));
+  EXPECT_EQ(1u, ini.GetSections().size());
+}
+
+TEST_F(IniFileTest, CopiesHaveTheirOwnSections)
+{
+  IniFile ini;
+  ASSERT_TRUE(Load(&ini, "[Core]\nA = 1\n"));
+
+  IniFile copy = ini;
+  copy.GetOrCreateSection("core")->Set("A", 2);
+  copy.GetOrCreateSection("Video")->Set("B", 3);
+
+  int value = 0;
+  EXPECT_TRUE(ini.GetOrCreateSection("Core")->Get("A", &value));
+  EXPECT_EQ(1, value);
+  EXPECT_TRUE(copy.GetOrCreateSection("Core")->Get("A", &value));
+  EXPECT_EQ(2, value);
+  EXPECT_FALSE(ini.Exists("Video", "B"));
+
+  IniFile moved = std::move(copy);
+  EXPECT_TRUE(moved.Exists("Video", "B"));
+}
+
+TEST_F(IniFileTest, FailsOnMissingFiles)
+{
+  IniFile ini;
+  EXPECT_FALSE(ini.Load(m_directory + "/missing.ini"));
+}
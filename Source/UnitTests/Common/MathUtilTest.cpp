@@ -20,6 +20,43 @@ TEST(MathUtil, Clamp)
   EXPECT_EQ(0.0, MathUtil::Clamp(-1.0, 0.0, 2.0));
 }
 
+TEST(MathUtil, Matrix44Multiply)
+{
+  Matrix44 a, b;
+  for (int i = 0; i < 16; ++i)
+  {
+    a.data[i] = static_cast<float>(i + 1);
+    b.data[i] = static_cast<float>(16 - i) * 0.5f;
+  }
+
+  Matrix44 expected;
+  for (int i = 0; i < 4; ++i)
+  {
+    for (int j = 0; j < 4; ++j)
+    {
+      float sum = 0;
+      for (int k = 0; k < 4; ++k)
+        sum += a.data[i * 4 + k] * b.data[k * 4 + j];
+      expected.data[i * 4 + j] = sum;
+    }
+  }
+
+  Matrix44 result;
+  Matrix44::Multiply(a, b, result);
+  for (int i = 0; i < 16; ++i)
+    EXPECT_EQ(expected.data[i], result.data[i]);
+
+  // operator* multiplies the other way around (see Matrix44::Multiply)
+  result = b * a;
+  for (int i = 0; i < 16; ++i)
+    EXPECT_EQ(expected.data[i], result.data[i]);
+
+  // The result can be one of the operands
+  Matrix44::Multiply(a, b, a);
+  for (int i = 0; i < 16; ++i)
+    EXPECT_EQ(expected.data[i], a.data[i]);
+}
+
 TEST(MathUtil, IsQNAN)
 {
   EXPECT_TRUE(MathUtil::IsQNAN(std::numeric_limits<double>::quiet_NaN()));
@@ -0,0 +1,79 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>  // NOLINT
+
+#include "Common/FileUtil.h"
+#include "Common/Metrics.h"
+
+TEST(Metrics, PrometheusFormat)
+{
+  Metrics::Counter counter("test_events_total", "Events.");
+  Metrics::Gauge gauge("test_level", "Level.");
+  Metrics::Histogram histogram("test_time_seconds", "Time.", {0.5, 1.0});
+
+  counter.Increment();
+  counter.Increment(2);
+  gauge.Set(1.5);
+  histogram.Observe(0.25);
+  histogram.Observe(1.0);
+  histogram.Observe(4.0);
+
+  EXPECT_EQ(3u, counter.GetValue());
+  EXPECT_EQ((std::vector<u64>{1, 1, 1}), histogram.GetBucketCounts());
+  EXPECT_EQ("# HELP test_events_total Events.\n"
+            "# TYPE test_events_total counter\n"
+            "test_events_total 3\n"
+            "# HELP test_level Level.\n"
+            "# TYPE test_level gauge\n"
+            "test_level 1.5\n"
+            "# HELP test_time_seconds Time.\n"
+            "# TYPE test_time_seconds histogram\n"
+            "test_time_seconds_bucket{le=\"0.5\"} 1\n"
+            "test_time_seconds_bucket{le=\"1\"} 2\n"
+            "test_time_seconds_bucket{le=\"+Inf\"} 3\n"
+            "test_time_seconds_sum 5.25\n"
+            "test_time_seconds_count 3\n",
+            Metrics::FormatPrometheus());
+}
+
+TEST(Metrics, SamplesFrames)
+{
+  Metrics::Counter counter("test_draws_total", "Draws.");
+  Metrics::Histogram histogram("test_frame_seconds", "Frame time.", {0.1});
+  EXPECT_EQ((std::vector<std::string>{"test_draws_total", "test_frame_seconds_count",
+                                      "test_frame_seconds_sum"}),
+            Metrics::GetColumnNames());
+
+  const std::string path = File::CreateTempDir() + "/metrics.csv";
+  ASSERT_TRUE(Metrics::SetCSVPath(path));
+
+  for (size_t frame = 0; frame < Metrics::SAMPLE_RING_SIZE + 2; ++frame)
+  {
+    counter.Increment(frame < 2 ? 1 : 5);
+    histogram.Observe(0.5);
+    Metrics::SampleFrame();
+  }
+  EXPECT_EQ("Metrics:\n"
+            "test_draws_total: 3002 (+5)\n"
+            "test_frame_seconds: 602, mean 0.5\n",
+            Metrics::FormatText());
+
+  const std::vector<Metrics::FrameSample> frames = Metrics::GetRecentFrames();
+  ASSERT_EQ(Metrics::SAMPLE_RING_SIZE, frames.size());
+  EXPECT_EQ((std::vector<double>{7.0, 3.0, 1.5}), frames.front().values);
+  EXPECT_EQ((std::vector<double>{3002.0, 602.0, 301.0}), frames.back().values);
+
+  ASSERT_TRUE(Metrics::SetCSVPath(""));
+  std::string csv;
+  ASSERT_TRUE(File::ReadFileToString(path, csv));
+  const std::string header = "time_us,test_draws_total,test_frame_seconds_count,"
+                             "test_frame_seconds_sum\n";
+  EXPECT_EQ(header, csv.substr(0, header.size()));
+  EXPECT_EQ(",3002,602,301\n", csv.substr(csv.size() - 14));
+  File::DeleteDirRecursively(path.substr(0, path.rfind('/')));
+}
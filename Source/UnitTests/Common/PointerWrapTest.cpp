@@ -0,0 +1,120 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/ChunkFile.h"
+#include "Common/CommonTypes.h"
+
+namespace
+{
+struct TestState
+{
+  void DoState(PointerWrap& p)
+  {
+    p.Do(value);
+    p.Do(flag);
+    p.Do(name);
+    p.Do(words);
+    p.Do(names);
+    p.DoArray(memory.data(), static_cast<u32>(memory.size()));
+    p.DoMarker("TestState");
+  }
+
+  u32 value = 0;
+  bool flag = false;
+  std::string name;
+  std::vector<u16> words;
+  std::vector<std::string> names;
+  std::vector<u8> memory = std::vector<u8>(3 * 1024 * 1024);
+};
+
+TestState MakeState()
+{
+  TestState state;
+  state.value = 0x12345678;
+  state.flag = true;
+  state.name = "Dolphin";
+  state.words = {1, 2, 0xFFFF};
+  state.names = {"A", "", "BC"};
+  for (size_t i = 0; i < state.memory.size(); i++)
+    state.memory[i] = static_cast<u8>(i * 7);
+  return state;
+}
+}
+
+TEST(PointerWrap, GrowingWriterMatchesMeasuredWrite)
+{
+  TestState state = MakeState();
+
+  u8* ptr = nullptr;
+  PointerWrap measure(&ptr, PointerWrap::MODE_MEASURE);
+  state.DoState(measure);
+  std::vector<u8> measured(reinterpret_cast<size_t>(ptr));
+  ptr = measured.data();
+  PointerWrap write(&ptr, PointerWrap::MODE_WRITE);
+  state.DoState(write);
+
+  // More than the initial size of the buffer, so that it grows.
+  std::vector<u8> grown;
+  PointerWrap grow(&grown);
+  state.DoState(grow);
+  EXPECT_TRUE(grow.FinishWrite());
+  EXPECT_EQ(measured, grown);
+
+  // Writing again reuses the buffer.
+  PointerWrap rewrite(&grown);
+  state.DoState(rewrite);
+  EXPECT_TRUE(rewrite.FinishWrite());
+  EXPECT_EQ(measured, grown);
+}
+
+TEST(PointerWrap, ContainersRoundTrip)
+{
+  TestState state = MakeState();
+  std::vector<u8> buffer;
+  PointerWrap write(&buffer);
+  state.DoState(write);
+  ASSERT_TRUE(write.FinishWrite());
+
+  TestState loaded;
+  u8* ptr = buffer.data();
+  PointerWrap read(&ptr, PointerWrap::MODE_READ);
+  loaded.DoState(read);
+  EXPECT_EQ(PointerWrap::MODE_READ, read.GetMode());
+  EXPECT_EQ(buffer.data() + buffer.size(), ptr);
+  EXPECT_EQ(state.value, loaded.value);
+  EXPECT_EQ(state.flag, loaded.flag);
+  EXPECT_EQ(state.name, loaded.name);
+  EXPECT_EQ(state.words, loaded.words);
+  EXPECT_EQ(state.names, loaded.names);
+  EXPECT_EQ(state.memory, loaded.memory);
+}
+
+TEST(PointerWrap, VectorsKeepTheirFormat)
+{
+  std::vector<u16> words = {0x1122, 0x3344};
+  std::vector<u8> buffer;
+  PointerWrap p(&buffer);
+  p.Do(words);
+  ASSERT_TRUE(p.FinishWrite());
+
+  // The element count, followed by the elements.
+  const std::vector<u8> expected = {2, 0, 0, 0, 0x22, 0x11, 0x44, 0x33};
+  EXPECT_EQ(expected, buffer);
+}
+
+TEST(PointerWrap, AbortedWriteLeavesBufferEmpty)
+{
+  std::vector<u8> buffer;
+  PointerWrap p(&buffer);
+  u32 value = 1;
+  p.Do(value);
+  p.SetMode(PointerWrap::MODE_MEASURE);
+  EXPECT_FALSE(p.FinishWrite());
+  EXPECT_TRUE(buffer.empty());
+}
@@ -0,0 +1,66 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>  // NOLINT
+
+#include "Common/CommonTypes.h"
+#include "Common/SeqLock.h"
+
+namespace
+{
+struct Value
+{
+  u32 a;
+  u64 b;
+  u8 c;
+};
+}  // namespace
+
+TEST(SeqLock, StoreAndLoad)
+{
+  Common::SeqLock<Value> lock;
+  EXPECT_EQ(0u, lock.Load().a);
+
+  lock.Store({1, 2, 3});
+  const Value value = lock.Load();
+  EXPECT_EQ(1u, value.a);
+  EXPECT_EQ(2u, value.b);
+  EXPECT_EQ(3u, value.c);
+}
+
+TEST(SeqLock, ReadersNeverSeeTornValues)
+{
+  constexpr u32 ITERATIONS = 200000;
+  Common::SeqLock<Value> lock;
+  std::atomic<bool> done{false};
+  std::atomic<u32> torn{0};
+
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 3; i++)
+  {
+    readers.emplace_back([&] {
+      u32 last = 0;
+      while (!done.load())
+      {
+        const Value value = lock.Load();
+        if (value.b != value.a || value.c != static_cast<u8>(value.a) || value.a < last)
+          torn++;
+        last = value.a;
+      }
+    });
+  }
+
+  for (u32 i = 1; i <= ITERATIONS; i++)
+    lock.Store({i, i, static_cast<u8>(i)});
+  done.store(true);
+  for (std::thread& reader : readers)
+    reader.join();
+
+  EXPECT_EQ(0u, torn.load());
+  EXPECT_EQ(ITERATIONS, lock.Load().a);
+}
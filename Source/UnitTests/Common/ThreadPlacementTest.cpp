@@ -0,0 +1,55 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <gtest/gtest.h>
+
+#include "Common/ThreadPlacement.h"
+
+TEST(ThreadPlacement, SMTCoresUnderOneCache)
+{
+  // Four cores with two threads each.
+  const Common::ThreadPlacement placement =
+      Common::ChooseThreadPlacement({0x11, 0x22, 0x44, 0x88}, {0xff}, 0xff, true);
+  EXPECT_EQ(0x88u, placement.cpu_thread);
+  EXPECT_EQ(0x44u, placement.gpu_thread);
+  EXPECT_EQ(0x33u, placement.helpers);
+}
+
+TEST(ThreadPlacement, PrefersTheCacheWithMostPerformanceCores)
+{
+  // Two CCXs of four cores, with one core of the second one reported as slow.
+  const Common::ThreadPlacement placement = Common::ChooseThreadPlacement(
+      {0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80}, {0x0f, 0xf0}, 0x7f, true);
+  EXPECT_EQ(0x08u, placement.cpu_thread);
+  EXPECT_EQ(0x04u, placement.gpu_thread);
+  EXPECT_EQ(0xf3u, placement.helpers);
+}
+
+TEST(ThreadPlacement, HybridCPU)
+{
+  // Two performance cores with SMT, followed by four efficiency cores sharing the same cache.
+  const Common::ThreadPlacement placement =
+      Common::ChooseThreadPlacement({0x03, 0x0c, 0x10, 0x20, 0x40, 0x80}, {0xff}, 0x0f, true);
+  EXPECT_EQ(0x0cu, placement.cpu_thread);
+  EXPECT_EQ(0x03u, placement.gpu_thread);
+  EXPECT_EQ(0xf0u, placement.helpers);
+
+  // The single core mode only needs one core for both.
+  const Common::ThreadPlacement single_core =
+      Common::ChooseThreadPlacement({0x03, 0x0c, 0x10, 0x20, 0x40, 0x80}, {0xff}, 0x0f, false);
+  EXPECT_EQ(0x0cu, single_core.cpu_thread);
+  EXPECT_EQ(0x0cu, single_core.gpu_thread);
+  EXPECT_EQ(0xf3u, single_core.helpers);
+}
+
+TEST(ThreadPlacement, NotEnoughCores)
+{
+  // Nothing is left for the helpers.
+  Common::ThreadPlacement placement = Common::ChooseThreadPlacement({0x01, 0x02}, {}, 0, true);
+  EXPECT_EQ(0u, placement.cpu_thread | placement.gpu_thread | placement.helpers);
+
+  // Unknown topology.
+  placement = Common::ChooseThreadPlacement({}, {}, 0, true);
+  EXPECT_EQ(0u, placement.cpu_thread | placement.gpu_thread | placement.helpers);
+}
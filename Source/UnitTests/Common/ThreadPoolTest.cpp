@@ -0,0 +1,71 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/Event.h"
+#include "Common/ThreadPool.h"
+
+TEST(ThreadPool, RunsAllTasks)
+{
+  Common::ThreadPool pool(4);
+  std::atomic<int> count{0};
+  {
+    Common::TaskGroup group(pool);
+    for (int i = 0; i < 1000; i++)
+      group.Schedule([&count] { count++; });
+  }
+  EXPECT_EQ(1000, count);
+}
+
+TEST(ThreadPool, HigherPriorityRunsFirst)
+{
+  Common::Event start, done;
+  std::mutex order_lock;
+  std::vector<int> order;
+  const auto record = [&](int value) {
+    std::lock_guard<std::mutex> lk(order_lock);
+    order.push_back(value);
+  };
+  Common::ThreadPool pool(1);
+
+  // Keeps the only worker busy until all tasks are queued.
+  pool.Schedule([&start] { start.Wait(); });
+  pool.Schedule(
+      [&] {
+        record(2);
+        done.Set();
+      },
+      Common::TaskPriority::Low);
+  pool.Schedule([&] { record(0); }, Common::TaskPriority::High);
+  pool.Schedule([&] { record(1); });
+  start.Set();
+  done.Wait();
+
+  EXPECT_EQ(std::vector<int>({0, 1, 2}), order);
+}
+
+TEST(ThreadPool, WaitingInsideATask)
+{
+  // Each task waits for tasks of its own, which only works if waiting helps to run them.
+  Common::ThreadPool pool(2);
+  std::atomic<int> count{0};
+  {
+    Common::TaskGroup outer(pool);
+    for (int i = 0; i < 8; i++)
+    {
+      outer.Schedule([&] {
+        Common::TaskGroup inner(pool);
+        for (int j = 0; j < 8; j++)
+          inner.Schedule([&count] { count++; });
+        inner.Wait();
+      });
+    }
+  }
+  EXPECT_EQ(64, count);
+}
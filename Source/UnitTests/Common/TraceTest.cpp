@@ -0,0 +1,90 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>  // NOLINT
+
+#include "Common/FileUtil.h"
+#include "Common/Logging/Trace.h"
+
+static const Trace::ThreadEvents* FindThread(const std::vector<Trace::ThreadEvents>& threads,
+                                             const std::string& name)
+{
+  auto iter = std::find_if(threads.begin(), threads.end(), [&name](const auto& thread) {
+    return thread.thread_name == name;
+  });
+  return iter == threads.end() ? nullptr : &*iter;
+}
+
+TEST(Trace, RecordsOnlyWhileEnabled)
+{
+  Trace::SetThreadName("Main");
+  EXPECT_FALSE(Trace::IsEnabled());
+  {
+    TRACE_SCOPE("Ignored");
+  }
+
+  Trace::BeginRecording();
+  Trace::BeginRecording();
+  Trace::EndRecording();
+  EXPECT_TRUE(Trace::IsEnabled());
+  {
+    TRACE_SCOPE("Outer");
+    {
+      TRACE_SCOPE("Inner");
+    }
+  }
+  TRACE_INSTANT("Marker");
+  Trace::EndRecording();
+  EXPECT_FALSE(Trace::IsEnabled());
+
+  const auto threads = Trace::CollectEvents();
+  const Trace::ThreadEvents* thread = FindThread(threads, "Main");
+  ASSERT_NE(nullptr, thread);
+  ASSERT_EQ(3u, thread->events.size());
+  EXPECT_STREQ("Marker", thread->events[0].name);
+  EXPECT_TRUE(thread->events[0].instant);
+  EXPECT_STREQ("Outer", thread->events[1].name);
+  EXPECT_EQ(0u, thread->events[1].depth);
+  EXPECT_STREQ("Inner", thread->events[2].name);
+  EXPECT_EQ(1u, thread->events[2].depth);
+  EXPECT_LE(thread->events[1].start, thread->events[2].start);
+  EXPECT_GE(thread->events[1].end, thread->events[2].end);
+}
+
+TEST(Trace, WritesEventsOfAllThreads)
+{
+  Trace::SetThreadName("Main");
+  Trace::BeginRecording();
+  {
+    TRACE_SCOPE("Main scope");
+  }
+  std::thread worker([] {
+    Trace::SetThreadName("Worker");
+    TRACE_SCOPE("Worker scope");
+  });
+  worker.join();
+  TRACE_INSTANT("Marker");
+  Trace::EndRecording();
+
+  const std::string directory = File::CreateTempDir();
+  const std::string path = directory + "/trace.json";
+  ASSERT_TRUE(Trace::WriteChromeTrace(path));
+
+  std::string json;
+  ASSERT_TRUE(File::ReadFileToString(path, json));
+  EXPECT_EQ(0u, json.find("{\"displayTimeUnit\": \"ms\", \"traceEvents\": ["));
+  EXPECT_NE(std::string::npos, json.find("\"args\": {\"name\": \"Main\"}"));
+  EXPECT_NE(std::string::npos, json.find("\"args\": {\"name\": \"Worker\"}"));
+  EXPECT_NE(std::string::npos, json.find("{\"name\": \"Main scope\", \"ph\": \"X\""));
+  EXPECT_NE(std::string::npos, json.find("{\"name\": \"Worker scope\", \"ph\": \"X\""));
+  EXPECT_NE(std::string::npos, json.find("{\"name\": \"Marker\", \"ph\": \"i\""));
+  EXPECT_EQ(std::string::npos, json.find("Ignored"));
+  EXPECT_EQ(json.size() - 4, json.rfind("\n]}\n"));
+  File::DeleteDirRecursively(directory);
+}
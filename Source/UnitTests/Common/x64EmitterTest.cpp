@@ -85,7 +85,9 @@ class x64EmitterTest : public testing::Test
 protected:
   void SetUp() override
   {
-    memset(&cpu_info, 0x01, sizeof(cpu_info));
+    // Enable every feature. The flags come last, after the topology which can't be overwritten.
+    u8* const features = reinterpret_cast<u8*>(&cpu_info.bSSE);
+    memset(features, 0x01, reinterpret_cast<u8*>(&cpu_info + 1) - features);
 
     emitter.reset(new X64CodeBlock());
     emitter->AllocCodeSpace(4096);
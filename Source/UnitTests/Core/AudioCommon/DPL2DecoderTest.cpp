@@ -0,0 +1,60 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "AudioCommon/DPL2Decoder.h"
+
+static std::vector<float> GenerateInput(int num_samples)
+{
+  std::vector<float> input(num_samples * 2);
+  for (int i = 0; i < num_samples; i++)
+  {
+    input[i * 2] = 0.5f * std::sin(i * 0.01f) + 0.25f * std::sin(i * 0.3f);
+    input[i * 2 + 1] = 0.5f * std::sin(i * 0.013f) - 0.25f * std::sin(i * 0.7f);
+  }
+  return input;
+}
+
+static std::vector<float> Decode(std::vector<float> input, int chunk_size)
+{
+  const int num_samples = static_cast<int>(input.size() / 2);
+  std::vector<float> output(num_samples * 6);
+  DPL2Reset();
+  for (int i = 0; i < num_samples; i += chunk_size)
+  {
+    const int count = std::min(chunk_size, num_samples - i);
+    DPL2Decode(&input[i * 2], count, &output[i * 6]);
+  }
+  return output;
+}
+
+// Large calls go through the FFT filter of the LFE channel, small calls through the direct one.
+TEST(DPL2Decoder, OutputDoesNotDependOnCallSize)
+{
+  const std::vector<float> input = GenerateInput(4000);
+  const std::vector<float> reference = Decode(input, 16);
+
+  for (int chunk_size : {1, 127, 128, 600, 4000})
+  {
+    const std::vector<float> output = Decode(input, chunk_size);
+    for (size_t i = 0; i < reference.size(); i++)
+      ASSERT_NEAR(reference[i], output[i], 1e-5f) << "chunk size " << chunk_size << ", at " << i;
+  }
+}
+
+TEST(DPL2Decoder, LFEIsLowpassed)
+{
+  std::vector<float> input(8000);
+  for (size_t i = 0; i < input.size(); i++)
+    input[i] = (i / 2) % 2 ? 0.5f : -0.5f;
+
+  const std::vector<float> output = Decode(input, 512);
+  for (size_t i = 3; i < output.size(); i += 6)
+    EXPECT_NEAR(0.0f, output[i], 1e-3f) << "at sample " << i / 6;
+}
@@ -2,7 +2,9 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <array>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -185,3 +187,74 @@ TEST(DSPAccelerator, CurrentAddressSkips)
   accelerator.TestRead();
   EXPECT_EQ(accelerator.GetCurrentAddress(), 0x00000013u);
 }
+
+// Reads from a pattern in memory, and loops like AX does.
+class LoopingAccelerator : public DSP::Accelerator
+{
+public:
+  void Setup(u16 format, u32 start, u32 end, u32 current)
+  {
+    SetSampleFormat(format);
+    SetStartAddress(start);
+    SetEndAddress(end);
+    SetCurrentAddress(current);
+    SetPredScale(0x32);
+    SetYn1(100);
+    SetYn2(-100);
+  }
+
+  u32 exceptions = 0;
+
+protected:
+  void OnEndException() override
+  {
+    exceptions++;
+    SetPredScale(0x15);
+    SetYn2(GetYn2());
+  }
+  u8 ReadMemory(u32 address) override { return static_cast<u8>(address * 0x9d + (address >> 3)); }
+  void WriteMemory(u32 address, u8 value) override {}
+};
+
+TEST(DSPAccelerator, ReadSamplesMatchesReads)
+{
+  std::array<s16, 16> coefs;
+  for (size_t i = 0; i < coefs.size(); ++i)
+    coefs[i] = static_cast<s16>(i * 0x321 - 0x1800);
+
+  for (u16 format : {0x00, 0x0A, 0x19})
+  {
+    for (u32 end : {0x1000u, 0x1010u, 0x1011u, 0x1027u})
+    {
+      for (u32 current : {0xff2u, 0xff9u, 0x1000u})
+      {
+        LoopingAccelerator single;
+        LoopingAccelerator block;
+        single.Setup(format, 0x802, end, current);
+        block.Setup(format, 0x802, end, current);
+
+        std::vector<s16> expected(5000);
+        for (s16& sample : expected)
+          sample = static_cast<s16>(single.Read(coefs.data()));
+
+        // Blocks of varying sizes, like the resampler asks for.
+        std::vector<s16> samples(expected.size());
+        for (size_t i = 0, size = 1; i < samples.size(); size = size % 97 + 1)
+        {
+          const u32 count = static_cast<u32>(std::min(size, samples.size() - i));
+          const u32 read = block.ReadSamples(coefs.data(), &samples[i], count);
+          ASSERT_GE(read, 1u);
+          ASSERT_LE(read, count);
+          i += read;
+        }
+
+        EXPECT_EQ(expected, samples);
+        EXPECT_EQ(single.exceptions, block.exceptions);
+        EXPECT_EQ(single.GetCurrentAddress(), block.GetCurrentAddress());
+        EXPECT_EQ(single.GetYn1(), block.GetYn1());
+        EXPECT_EQ(single.GetYn2(), block.GetYn2());
+        EXPECT_EQ(single.GetPredScale(), block.GetPredScale());
+      }
+    }
+  }
+}
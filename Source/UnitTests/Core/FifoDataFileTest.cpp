@@ -0,0 +1,117 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>  // NOLINT
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Core/FifoPlayer/FifoDataFile.h"
+
+namespace
+{
+class FifoDataFileTest : public testing::TestWithParam<bool>
+{
+protected:
+  void SetUp() override
+  {
+    m_directory = File::CreateTempDir();
+    m_path = m_directory + "/recording.dff";
+
+    for (u32 i = 0; i < 3; i++)
+    {
+      FifoFrameInfo frame;
+      frame.fifoData.resize(64 * 1024);
+      for (size_t j = 0; j < frame.fifoData.size(); j++)
+        frame.fifoData[j] = static_cast<u8>((j % 16) * (i + 1));
+      frame.fifoStart = 0x100 * i;
+      frame.fifoEnd = 0x100 * i + 0x80;
+
+      // The same texture in every frame, at two addresses in the last one.
+      frame.memoryUpdates.push_back(MakeUpdate(0x1000, 0x20, 4096, 7));
+      frame.memoryUpdates.push_back(MakeUpdate(0x8000 + i, 0x40, 100 + i, static_cast<u8>(i)));
+      if (i == 2)
+        frame.memoryUpdates.push_back(MakeUpdate(0x3000, 0x60, 4096, 7));
+      m_frames.push_back(std::move(frame));
+    }
+  }
+
+  void TearDown() override { File::DeleteDirRecursively(m_directory); }
+
+  static MemoryUpdate MakeUpdate(u32 address, u32 fifo_position, size_t size, u8 seed)
+  {
+    MemoryUpdate update;
+    update.address = address;
+    update.fifoPosition = fifo_position;
+    update.type = MemoryUpdate::TEXTURE_MAP;
+    update.data.resize(size);
+    for (size_t i = 0; i < size; i++)
+      update.data[i] = static_cast<u8>(i * seed);
+    return update;
+  }
+
+  void ExpectFramesLoaded()
+  {
+    std::unique_ptr<FifoDataFile> file = FifoDataFile::Load(m_path, false);
+    ASSERT_NE(nullptr, file);
+    ASSERT_EQ(m_frames.size(), file->GetFrameCount());
+    for (u32 i = 0; i < file->GetFrameCount(); i++)
+    {
+      const FifoFrameInfo& frame = file->GetFrame(i);
+      EXPECT_EQ(m_frames[i].fifoData, frame.fifoData);
+      EXPECT_EQ(m_frames[i].fifoStart, frame.fifoStart);
+      EXPECT_EQ(m_frames[i].fifoEnd, frame.fifoEnd);
+      ASSERT_EQ(m_frames[i].memoryUpdates.size(), frame.memoryUpdates.size());
+      for (size_t j = 0; j < frame.memoryUpdates.size(); j++)
+      {
+        EXPECT_EQ(m_frames[i].memoryUpdates[j].address, frame.memoryUpdates[j].address);
+        EXPECT_EQ(m_frames[i].memoryUpdates[j].fifoPosition, frame.memoryUpdates[j].fifoPosition);
+        EXPECT_EQ(m_frames[i].memoryUpdates[j].type, frame.memoryUpdates[j].type);
+        EXPECT_EQ(m_frames[i].memoryUpdates[j].data, frame.memoryUpdates[j].data);
+      }
+    }
+  }
+
+  std::string m_directory;
+  std::string m_path;
+  std::vector<FifoFrameInfo> m_frames;
+};
+}
+
+TEST_P(FifoDataFileTest, SpooledFramesAreSaved)
+{
+  const bool compress = GetParam();
+  u64 memory_size = 0;
+  {
+    FifoDataFile file;
+    file.AddFrame(m_frames[0]);
+    ASSERT_TRUE(file.StartSpooling(m_directory + "/spool.tmp", compress));
+    file.AddFrame(m_frames[1]);
+    file.AddFrame(m_frames[2]);
+    EXPECT_EQ(m_frames.size(), file.GetFrameCount());
+    ASSERT_TRUE(file.Save(m_path));
+
+    FifoDataFile memory_file;
+    for (const FifoFrameInfo& frame : m_frames)
+      memory_file.AddFrame(frame);
+    ASSERT_TRUE(memory_file.Save(m_directory + "/memory.dff"));
+    memory_size = File::GetSize(m_directory + "/memory.dff");
+  }
+  EXPECT_FALSE(File::Exists(m_directory + "/spool.tmp"));
+
+  // The texture at the second address isn't stored again, and compression shrinks everything
+  // but the texture memory, which isn't compressed.
+  const u64 size = File::GetSize(m_path);
+  if (compress)
+    EXPECT_LT(size - FifoDataFile::TEX_MEM_SIZE, (memory_size - FifoDataFile::TEX_MEM_SIZE) / 4);
+  else
+    EXPECT_EQ(memory_size - 2 * 4096, size);
+
+  ExpectFramesLoaded();
+}
+
+INSTANTIATE_TEST_CASE_P(Compression, FifoDataFileTest, testing::Bool());
@@ -0,0 +1,136 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>  // NOLINT
+
+#include "Common/CommonTypes.h"
+#include "Common/File.h"
+#include "Common/FileUtil.h"
+#include "Core/Movie.h"
+#include "Core/MovieFile.h"
+
+using namespace Movie;
+
+namespace
+{
+class MovieFileTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_directory = File::CreateTempDir();
+    m_path = m_directory + "/movie.dtm";
+
+    // 8 byte inputs which rarely change, with only the first 200 KiB having known boundaries
+    m_input.resize(400 * 1024);
+    for (size_t i = 0; i < m_input.size(); i++)
+      m_input[i] = static_cast<u8>(i % 8 == 0 ? i / 4096 : (i % 8) * 3);
+    for (u64 offset = 0; offset < 200 * 1024; offset += DTM_CHUNK_SIZE + 64)
+      m_starts.push_back({offset, offset / 64, offset / 8, offset / 1024});
+
+    std::memset(&m_header, 0, sizeof(m_header));
+    m_header.filetype[0] = 'D';
+    m_header.filetype[1] = 'T';
+    m_header.filetype[2] = 'M';
+    m_header.filetype[3] = 0x1A;
+    m_header.frameCount = 1234;
+  }
+
+  void TearDown() override { File::DeleteDirRecursively(m_directory); }
+
+  bool Write()
+  {
+    File::IOFile file(m_path, "wb");
+    return WriteChunkedDTM(file, m_header, m_input.size(), m_starts,
+                           [this](u64 offset, u8* data, size_t size) {
+                             std::memcpy(data, m_input.data() + offset, size);
+                             return true;
+                           });
+  }
+
+  std::unique_ptr<DTMInputReader> Open()
+  {
+    DTMHeader header;
+    File::IOFile file(m_path, "rb");
+    if (!file.ReadArray(&header, 1))
+      return nullptr;
+    EXPECT_EQ(DTM_VERSION_CHUNKED, header.version);
+    EXPECT_EQ(m_header.frameCount, header.frameCount);
+    return DTMInputReader::Open(m_path, header);
+  }
+
+  std::string m_directory;
+  std::string m_path;
+  DTMHeader m_header;
+  std::vector<u8> m_input;
+  std::vector<DTMChunkStart> m_starts;
+};
+}  // namespace
+
+TEST_F(MovieFileTest, RoundTrip)
+{
+  ASSERT_TRUE(Write());
+  std::unique_ptr<DTMInputReader> reader = Open();
+  ASSERT_NE(nullptr, reader);
+  EXPECT_EQ(m_input.size(), reader->GetInputSize());
+  EXPECT_LT(File::GetSize(m_path), m_input.size() / 2);
+
+  // The known starts are kept, and the rest of the input is split.
+  const std::vector<DTMChunkEntry>& chunks = reader->GetChunks();
+  ASSERT_LT(m_starts.size(), chunks.size());
+  for (size_t i = 0; i < m_starts.size(); i++)
+    EXPECT_EQ(m_starts[i].input_offset, chunks[i].start.input_offset);
+  EXPECT_EQ(DTM_UNKNOWN_FRAME, chunks.back().start.frame);
+
+  std::vector<u8> input(m_input.size());
+  ASSERT_TRUE(reader->Read(0, input.data(), input.size()));
+  EXPECT_EQ(m_input, input);
+
+  // Reads across chunks, and backwards
+  for (u64 offset : {u64(300 * 1024), u64(DTM_CHUNK_SIZE - 3), u64(5)})
+  {
+    std::vector<u8> block(DTM_CHUNK_SIZE + 100);
+    ASSERT_TRUE(reader->Read(offset, block.data(), block.size()));
+    EXPECT_EQ(0, std::memcmp(m_input.data() + offset, block.data(), block.size()));
+  }
+
+  u8 byte;
+  EXPECT_FALSE(reader->Read(m_input.size(), &byte, 1));
+}
+
+TEST_F(MovieFileTest, FindChunkForFrame)
+{
+  ASSERT_TRUE(Write());
+  std::unique_ptr<DTMInputReader> reader = Open();
+  ASSERT_NE(nullptr, reader);
+
+  EXPECT_EQ(0u, reader->FindChunkForFrame(0).input_offset);
+  EXPECT_EQ(m_starts[1].input_offset, reader->FindChunkForFrame(m_starts[1].frame).input_offset);
+  EXPECT_EQ(m_starts[1].input_offset,
+            reader->FindChunkForFrame(m_starts[2].frame - 1).input_offset);
+  EXPECT_EQ(m_starts.back().input_count, reader->FindChunkForFrame(~0ULL - 1).input_count);
+}
+
+TEST_F(MovieFileTest, DetectsCorruption)
+{
+  ASSERT_TRUE(Write());
+  {
+    File::IOFile file(m_path, "r+b");
+    u8 byte;
+    ASSERT_TRUE(file.Seek(sizeof(DTMHeader) + 16, SEEK_SET) && file.ReadBytes(&byte, 1));
+    byte ^= 0x55;
+    ASSERT_TRUE(file.Seek(sizeof(DTMHeader) + 16, SEEK_SET) && file.WriteBytes(&byte, 1));
+  }
+
+  std::unique_ptr<DTMInputReader> reader = Open();
+  ASSERT_NE(nullptr, reader);
+  std::vector<u8> input(64);
+  EXPECT_FALSE(reader->Read(0, input.data(), input.size()));
+  EXPECT_TRUE(reader->Read(200 * 1024, input.data(), input.size()));
+}
@@ -0,0 +1,132 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <array>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <gtest/gtest.h>  // NOLINT
+
+#include "InputCommon/ControlReference/ExpressionParser.h"
+#include "InputCommon/ControllerInterface/Device.h"
+
+using namespace ciface::ExpressionParser;
+
+namespace
+{
+class TestDevice final : public ciface::Core::Device
+{
+public:
+  class TestInput final : public Input
+  {
+  public:
+    TestInput(std::string name, const ControlState* state) : m_name(std::move(name)), m_state(state)
+    {
+    }
+    std::string GetName() const override { return m_name; }
+    ControlState GetState() const override { return *m_state; }
+
+  private:
+    std::string m_name;
+    const ControlState* m_state;
+  };
+
+  TestDevice()
+  {
+    SetId(0);
+    AddInput(new TestInput("A", &states[0]));
+    AddInput(new TestInput("B", &states[1]));
+    AddInput(new TestInput("C", &states[2]));
+  }
+  std::string GetName() const override { return "Device"; }
+  std::string GetSource() const override { return "Test"; }
+
+  std::array<ControlState, 3> states{};
+};
+
+class TestContainer final : public ciface::Core::DeviceContainer
+{
+public:
+  void Add(std::shared_ptr<ciface::Core::Device> device) { m_devices.push_back(device); }
+};
+
+class ExpressionParserTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_device = std::make_shared<TestDevice>();
+    m_container.Add(m_device);
+    m_default_device.FromDevice(m_device.get());
+  }
+
+  std::unique_ptr<Expression> Parse(const std::string& str)
+  {
+    auto result = ParseExpression(str);
+    EXPECT_EQ(ParseStatus::Successful, result.first) << str;
+    ControlFinder finder(m_container, m_default_device, true);
+    result.second->UpdateReferences(finder);
+    return std::move(result.second);
+  }
+
+  void SetStates(ControlState a, ControlState b, ControlState c)
+  {
+    m_device->states = {{a, b, c}};
+    m_device->Poll();
+  }
+
+  std::shared_ptr<TestDevice> m_device;
+  TestContainer m_container;
+  ciface::Core::DeviceQualifier m_default_device;
+};
+}  // namespace
+
+TEST_F(ExpressionParserTest, CompiledExpressionMatchesTree)
+{
+  const std::array<const char*, 7> expressions{{
+      "`A`", "`A` & `B`", "`A` | !`B`", "`A` + `B` + `C`", "!(`A` & (`B` | `C`))",
+      "`A` & `B` | `C`", "`Test/0/Device:B` + !`C`",
+  }};
+  const std::array<ControlState, 3> values{{0.0, 0.25, 1.0}};
+
+  for (const char* str : expressions)
+  {
+    const std::unique_ptr<Expression> expression = Parse(str);
+    const CompiledExpression compiled(*expression);
+    for (ControlState a : values)
+    {
+      for (ControlState b : values)
+      {
+        for (ControlState c : values)
+        {
+          SetStates(a, b, c);
+          EXPECT_DOUBLE_EQ(expression->GetValue(), compiled.GetValue()) << str;
+        }
+      }
+    }
+  }
+}
+
+TEST_F(ExpressionParserTest, UnboundControlsReadZero)
+{
+  SetStates(1.0, 1.0, 1.0);
+  const std::unique_ptr<Expression> expression = Parse("!`Missing` & `A`");
+  EXPECT_EQ(1, expression->CountNumControls());
+  EXPECT_DOUBLE_EQ(1.0, CompiledExpression(*expression).GetValue());
+  EXPECT_DOUBLE_EQ(0.0, CompiledExpression().GetValue());
+}
+
+TEST_F(ExpressionParserTest, DeepExpressions)
+{
+  std::string str = "`A`";
+  for (int i = 0; i < 40; i++)
+    str = "`B` | (`C` & (" + str + "))";
+
+  const std::unique_ptr<Expression> expression = Parse(str);
+  const CompiledExpression compiled(*expression);
+  SetStates(0.75, 0.25, 0.5);
+  EXPECT_DOUBLE_EQ(0.5, compiled.GetValue());
+  EXPECT_DOUBLE_EQ(expression->GetValue(), compiled.GetValue());
+}
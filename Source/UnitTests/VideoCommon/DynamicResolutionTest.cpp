@@ -0,0 +1,87 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <gtest/gtest.h>  // NOLINT
+
+#include "VideoCommon/DynamicResolution.h"
+
+namespace
+{
+constexpr double BUDGET = 1000.0 / 90.0;
+
+// Adds frames until the scale changes, returning how many were needed.
+int FramesUntilChange(DynamicResolution* dynamic_resolution, double milliseconds, float min_scale,
+                      float max_scale)
+{
+  for (int frames = 1; frames <= 1000; frames++)
+  {
+    if (dynamic_resolution->AddFrameTime(milliseconds, BUDGET, min_scale, max_scale))
+      return frames;
+  }
+  return -1;
+}
+}
+
+TEST(DynamicResolution, ShrinksByThePixelCost)
+{
+  // At twice the budget, the pixel count has to be less than half.
+  DynamicResolution dynamic_resolution;
+  EXPECT_EQ(8, FramesUntilChange(&dynamic_resolution, BUDGET * 2, 0.25f, 1.0f));
+  EXPECT_EQ(10, dynamic_resolution.GetScaleSteps());
+}
+
+TEST(DynamicResolution, ShrinksAtLeastOneStep)
+{
+  DynamicResolution dynamic_resolution;
+  FramesUntilChange(&dynamic_resolution, BUDGET * 0.92, 0.25f, 1.0f);
+  EXPECT_EQ(DynamicResolution::SCALE_STEPS - 1, dynamic_resolution.GetScaleSteps());
+}
+
+TEST(DynamicResolution, ClampsToTheMinimum)
+{
+  DynamicResolution dynamic_resolution;
+  FramesUntilChange(&dynamic_resolution, BUDGET * 10, 0.5f, 1.0f);
+  EXPECT_EQ(0.5f, dynamic_resolution.GetScale());
+  EXPECT_EQ(-1, FramesUntilChange(&dynamic_resolution, BUDGET * 10, 0.5f, 1.0f));
+}
+
+TEST(DynamicResolution, GrowsOneStepAfterSettling)
+{
+  DynamicResolution dynamic_resolution;
+  FramesUntilChange(&dynamic_resolution, BUDGET * 10, 0.5f, 1.0f);
+
+  // The two windows after a change are ignored.
+  EXPECT_EQ(24, FramesUntilChange(&dynamic_resolution, BUDGET * 0.1, 0.5f, 1.0f));
+  EXPECT_EQ(9, dynamic_resolution.GetScaleSteps());
+}
+
+TEST(DynamicResolution, HoldsNearTheBudget)
+{
+  // Between the growing and shrinking thresholds nothing changes.
+  DynamicResolution dynamic_resolution;
+  FramesUntilChange(&dynamic_resolution, BUDGET * 10, 0.5f, 1.0f);
+  EXPECT_EQ(-1, FramesUntilChange(&dynamic_resolution, BUDGET * 0.8, 0.5f, 1.0f));
+  EXPECT_EQ(8, dynamic_resolution.GetScaleSteps());
+}
+
+TEST(DynamicResolution, Reset)
+{
+  DynamicResolution dynamic_resolution;
+  FramesUntilChange(&dynamic_resolution, BUDGET * 10, 0.5f, 1.0f);
+  dynamic_resolution.Reset();
+  EXPECT_EQ(1.0f, dynamic_resolution.GetScale());
+}
+
+TEST(DynamicResolution, ScaleLimit)
+{
+  // The limit lowers the maximum, but not the minimum.
+  DynamicResolution dynamic_resolution;
+  DynamicResolution::SetScaleLimit(0.75f);
+  FramesUntilChange(&dynamic_resolution, BUDGET * 0.1, 0.5f, 1.0f);
+  EXPECT_EQ(0.75f, dynamic_resolution.GetScale());
+  DynamicResolution::SetScaleLimit(0.25f);
+  FramesUntilChange(&dynamic_resolution, BUDGET * 0.1, 0.5f, 1.0f);
+  EXPECT_EQ(0.5f, dynamic_resolution.GetScale());
+  DynamicResolution::SetScaleLimit(1.0f);
+}
@@ -0,0 +1,48 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <vector>
+
+#include <gtest/gtest.h>  // NOLINT
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/Foveation.h"
+#include "VideoCommon/VR.h"
+
+TEST(Foveation, OffIsFullRate)
+{
+  const std::vector<u8> map = Foveation::GenerateRateMap(8, 6, 2, VR_FOVEATION_OFF);
+  ASSERT_EQ(8u * 6u * 2u, map.size());
+  for (u8 rate : map)
+    EXPECT_EQ(Foveation::RATE_FULL, rate);
+}
+
+TEST(Foveation, RateDropsTowardsTheEdges)
+{
+  // Without an HMD, the lenses are centred on the eye buffers.
+  const u32 size = 16;
+  for (int level : {VR_FOVEATION_LOW, VR_FOVEATION_HIGH})
+  {
+    const std::vector<u8> map = Foveation::GenerateRateMap(size, size, 2, level);
+    ASSERT_EQ(size * size * 2, map.size());
+    for (u32 layer = 0; layer < 2; layer++)
+    {
+      const u8* tiles = map.data() + layer * size * size;
+      EXPECT_EQ(Foveation::RATE_FULL, tiles[(size / 2) * size + size / 2]);
+      EXPECT_EQ(Foveation::RATE_4X4, tiles[0]);
+      EXPECT_EQ(Foveation::RATE_4X4, tiles[size * size - 1]);
+
+      // Rates only get coarser going from the centre to the right edge.
+      for (u32 x = size / 2 + 1; x < size; x++)
+        EXPECT_LE(tiles[(size / 2) * size + x - 1], tiles[(size / 2) * size + x]);
+    }
+  }
+
+  // High foveation shades more of the eye buffer at a coarser rate.
+  const std::vector<u8> low = Foveation::GenerateRateMap(size, size, 1, VR_FOVEATION_LOW);
+  const std::vector<u8> high = Foveation::GenerateRateMap(size, size, 1, VR_FOVEATION_HIGH);
+  for (size_t i = 0; i < low.size(); i++)
+    EXPECT_LE(low[i], high[i]);
+  EXPECT_NE(low, high);
+}
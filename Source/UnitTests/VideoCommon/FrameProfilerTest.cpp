@@ -0,0 +1,82 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <string>
+
+#include <gtest/gtest.h>  // NOLINT
+
+#include "Common/FileUtil.h"
+#include "Common/Logging/Trace.h"
+#include "VideoCommon/FrameProfiler.h"
+
+class FrameProfilerTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    FrameProfiler::SetEnabled(true);
+    Trace::SetThreadName("Test thread");
+  }
+  void TearDown() override { FrameProfiler::SetEnabled(false); }
+};
+
+TEST_F(FrameProfilerTest, NothingIsRecordedWhenDisabled)
+{
+  FrameProfiler::SetEnabled(false);
+  {
+    TRACE_SCOPE("Disabled");
+  }
+  FrameProfiler::SetEnabled(true);
+  FrameProfiler::EndFrame();
+
+  EXPECT_EQ(std::string::npos, FrameProfiler::GetOverlayText().find("Disabled"));
+}
+
+TEST_F(FrameProfilerTest, ShowsNestedScopesOfTheLastFrame)
+{
+  {
+    TRACE_SCOPE("Previous");
+  }
+  FrameProfiler::EndFrame();
+
+  {
+    TRACE_SCOPE("Outer");
+    for (int i = 0; i < 3; i++)
+    {
+      TRACE_SCOPE("Inner");
+    }
+  }
+  FrameProfiler::EndFrame();
+
+  const std::string text = FrameProfiler::GetOverlayText();
+  EXPECT_EQ(std::string::npos, text.find("Previous"));
+  const size_t thread = text.find("Test thread\n");
+  const size_t outer = text.find("  Outer ");
+  const size_t inner = text.find("    Inner ");
+  ASSERT_NE(std::string::npos, thread);
+  ASSERT_NE(std::string::npos, outer);
+  ASSERT_NE(std::string::npos, inner);
+  EXPECT_LT(thread, outer);
+  EXPECT_LT(outer, inner);
+  EXPECT_NE(std::string::npos, text.find("3x", inner));
+}
+
+TEST_F(FrameProfilerTest, OnlyExportsRecordedFrames)
+{
+  FrameProfiler::SetEnabled(false);
+  FrameProfiler::SetEnabled(true);
+  {
+    TRACE_SCOPE("Traced");
+  }
+  FrameProfiler::EndFrame();
+
+  const std::string directory = File::CreateTempDir();
+  const std::string path = directory + "/trace.json";
+  ASSERT_TRUE(FrameProfiler::WriteChromeTrace(path));
+
+  std::string json;
+  ASSERT_TRUE(File::ReadFileToString(path, json));
+  EXPECT_NE(std::string::npos, json.find("{\"name\": \"Traced\", \"ph\": \"X\""));
+  File::DeleteDirRecursively(directory);
+}
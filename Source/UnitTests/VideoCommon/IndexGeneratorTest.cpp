@@ -0,0 +1,87 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <array>
+#include <vector>
+
+#include <gtest/gtest.h>  // NOLINT
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/IndexGenerator.h"
+#include "VideoCommon/OpcodeDecoding.h"
+#include "VideoCommon/VideoConfig.h"
+
+class IndexGeneratorTest : public testing::TestWithParam<bool>
+{
+protected:
+  void SetUp() override
+  {
+    g_Config.backend_info.bSupportsPrimitiveRestart = true;
+    g_Config.backend_info.bSupports32BitIndices = true;
+    g_Config.bUse32BitIndices = GetParam();
+    IndexGenerator::Init();
+    IndexGenerator::Start(m_buffer.data());
+  }
+
+  void TearDown() override
+  {
+    g_Config.backend_info.bSupports32BitIndices = false;
+    g_Config.bUse32BitIndices = false;
+    IndexGenerator::Init();
+  }
+
+  // Reads the generated indices back, whatever their size.
+  std::vector<u32> GetIndices() const
+  {
+    std::vector<u32> indices(IndexGenerator::GetIndexLen());
+    for (size_t i = 0; i < indices.size(); i++)
+    {
+      if (IndexGenerator::GetIndexSize() == sizeof(u32))
+        indices[i] = m_buffer[i];
+      else
+        indices[i] = reinterpret_cast<const u16*>(m_buffer.data())[i];
+    }
+    return indices;
+  }
+
+  u32 Restart() const
+  {
+    return IndexGenerator::GetIndexSize() == sizeof(u32) ? 0xFFFFFFFF : 0xFFFF;
+  }
+
+  std::array<u32, 64> m_buffer{};
+};
+
+TEST_P(IndexGeneratorTest, IndexSize)
+{
+  EXPECT_EQ(GetParam() ? 4u : 2u, IndexGenerator::GetIndexSize());
+}
+
+TEST_P(IndexGeneratorTest, StripWithPrimitiveRestart)
+{
+  IndexGenerator::AddIndices(OpcodeDecoder::GX_DRAW_TRIANGLE_STRIP, 4);
+  IndexGenerator::AddIndices(OpcodeDecoder::GX_DRAW_TRIANGLE_STRIP, 3);
+
+  EXPECT_EQ(7u, IndexGenerator::GetNumVerts());
+  EXPECT_EQ((std::vector<u32>{0, 1, 2, 3, Restart(), 4, 5, 6, Restart()}), GetIndices());
+}
+
+TEST_P(IndexGeneratorTest, QuadsWithPrimitiveRestart)
+{
+  IndexGenerator::AddIndices(OpcodeDecoder::GX_DRAW_QUADS, 4);
+
+  EXPECT_EQ((std::vector<u32>{1, 2, 0, 3, Restart()}), GetIndices());
+}
+
+TEST_P(IndexGeneratorTest, RemainingIndices)
+{
+  IndexGenerator::AddIndices(OpcodeDecoder::GX_DRAW_POINTS, 10);
+
+  if (GetParam())
+    EXPECT_LT(65534u, IndexGenerator::GetRemainingIndices());
+  else
+    EXPECT_EQ(65534u - 10u, IndexGenerator::GetRemainingIndices());
+}
+
+INSTANTIATE_TEST_CASE_P(IndexSizes, IndexGeneratorTest, testing::Bool());
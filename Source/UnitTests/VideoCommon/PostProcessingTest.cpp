@@ -0,0 +1,82 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>  // NOLINT
+
+#include "VideoCommon/PostProcessing.h"
+
+using RenderPass = PostProcessingShaderConfiguration::RenderPass;
+
+TEST(PostProcessing, ShaderWithoutPassesIsOnePass)
+{
+  PostProcessingShaderConfiguration config;
+  config.LoadOptions("void main() { SetOutput(Sample()); }\n");
+
+  const std::vector<RenderPass>& passes = config.GetPasses();
+  ASSERT_EQ(1u, passes.size());
+  EXPECT_FALSE(config.IsMultiPass());
+  EXPECT_EQ("main", passes[0].m_entry_point);
+  ASSERT_EQ(1u, passes[0].m_inputs.size());
+  EXPECT_EQ(RenderPass::INPUT_COLOR_BUFFER, passes[0].m_inputs[0].m_type);
+  EXPECT_EQ(0u, config.GetIntermediateTargetCount());
+}
+
+TEST(PostProcessing, PassesAndInputs)
+{
+  PostProcessingShaderConfiguration config;
+  config.LoadOptions("/*\n[configuration]\n"
+                     "[OptionBool]\nGUIName = Enable\nOptionName = ENABLE\nDefaultValue = true\n"
+                     "[Pass]\nEntryPoint = Bright\nOutputScale = 0.5\n"
+                     "[Pass]\nEntryPoint = Blur\nOutputScale = 0.001\n"
+                     "[Pass]\nEntryPoint = Combine\nInput0 = ColorBuffer\nInput2 = Pass0\n"
+                     "Input9 = Pass1\nInput3 = Pass2\n"
+                     "[/configuration]\n*/\n");
+
+  EXPECT_EQ(1u, config.GetOptions().size());
+  const std::vector<RenderPass>& passes = config.GetPasses();
+  ASSERT_EQ(3u, passes.size());
+  EXPECT_EQ("Bright", passes[0].m_entry_point);
+  EXPECT_EQ(0.5f, passes[0].m_output_scale);
+  ASSERT_EQ(1u, passes[0].m_inputs.size());
+  EXPECT_EQ(RenderPass::INPUT_COLOR_BUFFER, passes[0].m_inputs[0].m_type);
+
+  // The scale is clamped, and the input defaults to the previous pass.
+  EXPECT_EQ(1.0f / 16.0f, passes[1].m_output_scale);
+  ASSERT_EQ(1u, passes[1].m_inputs.size());
+  EXPECT_EQ(RenderPass::INPUT_PASS_OUTPUT, passes[1].m_inputs[0].m_type);
+  EXPECT_EQ(0u, passes[1].m_inputs[0].m_pass_index);
+
+  // Input1 wasn't given, and the inputs out of range or reading later passes are dropped.
+  ASSERT_EQ(3u, passes[2].m_inputs.size());
+  EXPECT_EQ(RenderPass::INPUT_COLOR_BUFFER, passes[2].m_inputs[0].m_type);
+  EXPECT_EQ(RenderPass::INPUT_PASS_OUTPUT, passes[2].m_inputs[1].m_type);
+  EXPECT_EQ(1u, passes[2].m_inputs[1].m_pass_index);
+  EXPECT_EQ(RenderPass::INPUT_PASS_OUTPUT, passes[2].m_inputs[2].m_type);
+  EXPECT_EQ(0u, passes[2].m_inputs[2].m_pass_index);
+}
+
+TEST(PostProcessing, IntermediateTargetsAreShared)
+{
+  // Pass 2 can reuse the target of pass 0 once pass 1 has read it, but not the target of pass 1,
+  // which pass 4 still reads.
+  PostProcessingShaderConfiguration config;
+  config.LoadOptions("[configuration]\n"
+                     "[Pass]\nEntryPoint = A\nOutputScale = 0.5\n"
+                     "[Pass]\nEntryPoint = B\nOutputScale = 0.5\n"
+                     "[Pass]\nEntryPoint = C\nOutputScale = 0.5\n"
+                     "[Pass]\nEntryPoint = D\nOutputScale = 0.25\nInput0 = Pass2\n"
+                     "[Pass]\nEntryPoint = E\nInput0 = Pass1\nInput1 = Pass3\n"
+                     "[/configuration]\n");
+
+  const std::vector<RenderPass>& passes = config.GetPasses();
+  ASSERT_EQ(5u, passes.size());
+  EXPECT_EQ(0u, passes[0].m_output_target);
+  EXPECT_EQ(1u, passes[1].m_output_target);
+  EXPECT_EQ(0u, passes[2].m_output_target);
+  EXPECT_EQ(2u, passes[3].m_output_target);
+  EXPECT_EQ(3u, config.GetIntermediateTargetCount());
+}
@@ -0,0 +1,57 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <gtest/gtest.h>  // NOLINT
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/RenderState.h"
+#include "VideoCommon/RenderStateCache.h"
+
+TEST(RenderStateCache, FindsInsertedStates)
+{
+  RenderStateCache<SamplerState, u32> cache;
+  SamplerState state;
+  state.hex = 0;
+  EXPECT_EQ(nullptr, cache.Find(state));
+
+  // More states than the front table has entries, so some of them share one.
+  for (u32 i = 0; i < 1000; i++)
+  {
+    state.hex = static_cast<u64>(i) << 7;
+    cache.Insert(state, i);
+  }
+  EXPECT_EQ(1000u, cache.Size());
+
+  for (u32 pass = 0; pass < 2; pass++)
+  {
+    for (u32 i = 0; i < 1000; i++)
+    {
+      state.hex = static_cast<u64>(i) << 7;
+      const u32* object = cache.Find(state);
+      ASSERT_NE(nullptr, object);
+      EXPECT_EQ(i, *object);
+    }
+  }
+
+  state.hex = 1;
+  EXPECT_EQ(nullptr, cache.Find(state));
+}
+
+TEST(RenderStateCache, ClearForgetsFrontEntries)
+{
+  RenderStateCache<BlendingState, u32> cache;
+  BlendingState state;
+  state.hex = 0;
+  state.blendenable = 1;
+  cache.Insert(state, 1);
+  ASSERT_NE(nullptr, cache.Find(state));
+
+  u32 destroyed = 0;
+  cache.ForEach([&](u32& object) { destroyed += object; });
+  EXPECT_EQ(1u, destroyed);
+
+  cache.Clear();
+  EXPECT_EQ(nullptr, cache.Find(state));
+  EXPECT_EQ(0u, cache.Size());
+}
@@ -0,0 +1,126 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <vector>
+
+#include <gtest/gtest.h>  // NOLINT
+
+#include "VideoCommon/StreamRingAllocator.h"
+
+class StreamRingAllocatorTest : public testing::Test
+{
+protected:
+  StreamRingAllocatorTest()
+      : m_ring(1024, [this](const int& fence) { m_waited.push_back(fence); },
+               [this](const int& fence) { m_released.push_back(fence); })
+  {
+  }
+
+  void Write(size_t num_bytes, size_t alignment = 1)
+  {
+    ASSERT_TRUE(m_ring.Reserve(num_bytes, alignment));
+    m_ring.Commit(num_bytes);
+  }
+
+  // Declared first, as the allocator releases its remaining fences when it is destroyed.
+  std::vector<int> m_waited;
+  std::vector<int> m_released;
+  StreamRingAllocator<int> m_ring;
+};
+
+TEST_F(StreamRingAllocatorTest, AlignsReservations)
+{
+  Write(10);
+  ASSERT_TRUE(m_ring.Reserve(16, 16));
+  EXPECT_EQ(16u, m_ring.GetCurrentOffset());
+  m_ring.Commit(16);
+
+  EXPECT_EQ(2u, m_ring.GetStatistics().reservations);
+  EXPECT_EQ(26u, m_ring.GetStatistics().bytes_committed);
+  EXPECT_EQ(6u, m_ring.GetStatistics().bytes_wasted);
+  EXPECT_EQ(32u, m_ring.GetStatistics().peak_bytes_in_flight);
+}
+
+TEST_F(StreamRingAllocatorTest, OnlyFencesNewData)
+{
+  EXPECT_FALSE(m_ring.NeedsFence());
+  Write(100);
+  EXPECT_TRUE(m_ring.NeedsFence());
+  EXPECT_EQ(100u, m_ring.GetUnfencedBytes());
+  m_ring.AddFence(1);
+  EXPECT_FALSE(m_ring.NeedsFence());
+  EXPECT_EQ(0u, m_ring.GetUnfencedBytes());
+}
+
+TEST_F(StreamRingAllocatorTest, WrapsBehindSignaledFences)
+{
+  Write(600);
+  m_ring.AddFence(1);
+  Write(300);
+  m_ring.AddFence(2);
+  m_ring.OnFenceSignaled(1);
+  EXPECT_EQ(std::vector<int>{1}, m_released);
+
+  // The GPU is done with the first 600 bytes, so this must not wait.
+  ASSERT_TRUE(m_ring.Reserve(200, 1, true, false));
+  EXPECT_EQ(0u, m_ring.GetCurrentOffset());
+  EXPECT_TRUE(m_waited.empty());
+  EXPECT_EQ(1u, m_ring.GetStatistics().wraps);
+  EXPECT_EQ(124u, m_ring.GetStatistics().bytes_wasted);
+}
+
+TEST_F(StreamRingAllocatorTest, WaitsForTheOldestSufficientFence)
+{
+  Write(300);
+  m_ring.AddFence(1);
+  Write(300);
+  m_ring.AddFence(2);
+  Write(300);
+  m_ring.AddFence(3);
+
+  EXPECT_FALSE(m_ring.Reserve(400, 1, true, false));
+  EXPECT_FALSE(m_ring.Reserve(400, 1, false, true));
+  EXPECT_TRUE(m_waited.empty());
+
+  ASSERT_TRUE(m_ring.Reserve(400, 1));
+  EXPECT_EQ(0u, m_ring.GetCurrentOffset());
+  EXPECT_EQ(std::vector<int>{2}, m_waited);
+  EXPECT_EQ((std::vector<int>{1, 2}), m_released);
+  EXPECT_EQ(1u, m_ring.GetStatistics().fence_waits);
+}
+
+TEST_F(StreamRingAllocatorTest, RetiresSignaledFencesInOrder)
+{
+  for (int fence = 1; fence <= 3; fence++)
+  {
+    Write(300);
+    m_ring.AddFence(fence);
+  }
+
+  m_ring.RetireSignaledFences([](const int& fence) { return fence != 2; });
+  EXPECT_EQ(std::vector<int>{1}, m_released);
+
+  // Only the first 300 bytes are free, so the rest of the buffer is used up first.
+  ASSERT_TRUE(m_ring.Reserve(100, 1, true, false));
+  EXPECT_EQ(900u, m_ring.GetCurrentOffset());
+  m_ring.Commit(100);
+  ASSERT_TRUE(m_ring.Reserve(200, 1, true, false));
+  EXPECT_EQ(0u, m_ring.GetCurrentOffset());
+  m_ring.Commit(200);
+  EXPECT_FALSE(m_ring.Reserve(200, 1, true, false));
+}
+
+TEST_F(StreamRingAllocatorTest, ReleasesFencesOnReset)
+{
+  Write(300);
+  m_ring.AddFence(1);
+  Write(300);
+  m_ring.AddFence(2);
+
+  m_ring.Reset(2048);
+  EXPECT_EQ((std::vector<int>{1, 2}), m_released);
+  EXPECT_EQ(2048u, m_ring.GetSize());
+  EXPECT_EQ(0u, m_ring.GetCurrentOffset());
+  EXPECT_FALSE(m_ring.NeedsFence());
+}
@@ -0,0 +1,108 @@
+// Copyright 2018 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <cstdlib>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/File.h"
+#include "Common/FileUtil.h"
+#include "VideoCommon/HiresTextures.h"
+#include "VideoCommon/TexturePack.h"
+
+namespace
+{
+HiresTexture::Level MakeLevel(AbstractTextureFormat format, u32 width, u32 height, size_t size,
+                              u8 fill)
+{
+  HiresTexture::Level level;
+  u8* data = static_cast<u8*>(std::malloc(size));
+  std::memset(data, fill, size);
+  level.data = HiresTexture::ImageDataPointer(data, [](unsigned char* ptr) { std::free(ptr); });
+  level.format = format;
+  level.width = width;
+  level.height = height;
+  level.row_length = width;
+  level.data_size = size;
+  return level;
+}
+
+class TexturePackTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_directory = File::CreateTempDir();
+    m_path = m_directory + "/test.dtp";
+  }
+  void TearDown() override { File::DeleteDirRecursively(m_directory); }
+
+  std::string m_directory;
+  std::string m_path;
+};
+}  // namespace
+
+TEST_F(TexturePackTest, RoundTrip)
+{
+  std::vector<HiresTexture::Level> rgba;
+  rgba.push_back(MakeLevel(AbstractTextureFormat::RGBA8, 8, 4, 8 * 4 * 4, 0x11));
+  rgba.push_back(MakeLevel(AbstractTextureFormat::RGBA8, 4, 2, 4 * 2 * 4, 0x22));
+  std::vector<HiresTexture::Level> bc1;
+  bc1.push_back(MakeLevel(AbstractTextureFormat::DXT1, 16, 16, 4 * 4 * 8, 0x33));
+
+  std::unique_ptr<TexturePack::PackWriter> writer = TexturePack::PackWriter::Create(m_path);
+  ASSERT_TRUE(writer);
+  ASSERT_TRUE(writer->AddTexture("tex1_8x4_m_0123456789abcdef_6", rgba));
+  ASSERT_TRUE(writer->AddTexture("tex1_16x16_fedcba9876543210_14", bc1));
+  ASSERT_TRUE(writer->Finish());
+  writer.reset();
+
+  std::unique_ptr<TexturePack::PackReader> reader = TexturePack::PackReader::Open(m_path);
+  ASSERT_TRUE(reader);
+  EXPECT_EQ(2u, reader->GetTextureCount());
+  EXPECT_EQ(nullptr, reader->FindTexture("tex1_8x4_m_0123456789abcdef"));
+
+  const TexturePack::PackEntry* entry = reader->FindTexture("tex1_8x4_m_0123456789abcdef_6");
+  ASSERT_NE(nullptr, entry);
+  EXPECT_EQ(static_cast<u16>(AbstractTextureFormat::RGBA8), entry->format);
+  ASSERT_EQ(2u, entry->num_levels);
+  for (u32 i = 0; i < entry->num_levels; i++)
+  {
+    const TexturePack::PackLevel& level = reader->GetLevel(*entry, i);
+    EXPECT_EQ(rgba[i].width, level.width);
+    EXPECT_EQ(rgba[i].height, level.height);
+    EXPECT_EQ(rgba[i].row_length, level.row_length);
+    ASSERT_EQ(rgba[i].data_size, level.size);
+    EXPECT_EQ(0, std::memcmp(rgba[i].data.get(), reader->GetLevelData(level), level.size));
+  }
+
+  entry = reader->FindTexture("tex1_16x16_fedcba9876543210_14");
+  ASSERT_NE(nullptr, entry);
+  EXPECT_EQ(static_cast<u16>(AbstractTextureFormat::DXT1), entry->format);
+  ASSERT_EQ(1u, entry->num_levels);
+  const TexturePack::PackLevel& level = reader->GetLevel(*entry, 0);
+  EXPECT_EQ(0, std::memcmp(bc1[0].data.get(), reader->GetLevelData(level), level.size));
+}
+
+TEST_F(TexturePackTest, RejectsTruncatedPack)
+{
+  std::vector<HiresTexture::Level> levels;
+  levels.push_back(MakeLevel(AbstractTextureFormat::RGBA8, 4, 4, 4 * 4 * 4, 0x44));
+
+  std::unique_ptr<TexturePack::PackWriter> writer = TexturePack::PackWriter::Create(m_path);
+  ASSERT_TRUE(writer);
+  ASSERT_TRUE(writer->AddTexture("tex1_4x4_0123456789abcdef_6", levels));
+  ASSERT_TRUE(writer->Finish());
+  writer.reset();
+
+  {
+    File::IOFile file(m_path, "r+b");
+    ASSERT_TRUE(file.Resize(file.GetSize() - 1));
+  }
+  EXPECT_EQ(nullptr, TexturePack::PackReader::Open(m_path));
+}